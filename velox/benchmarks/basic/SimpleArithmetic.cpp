@@ -62,6 +62,27 @@ struct MultiplyNullOutputFunction {
   }
 };
 
+// Multiply that also provides callBatch() for flat inputs without nulls.
+template <typename T>
+struct MultiplyBatchFunction {
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  call(TInput& result, const TInput& a, const TInput& b) {
+    result = functions::multiply(a, b);
+  }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = functions::multiply(a[i], b[i]);
+    }
+  }
+};
+
 // Checked vs. Unchecked Arithmetic.
 template <typename T>
 struct PlusFunction {
@@ -91,6 +112,8 @@ class SimpleArithmeticBenchmark
         {"multiply_nullable_output"});
     registerFunction<MultiplyNullOutputFunction, double, double, double>(
         {"multiply_null_output"});
+    registerFunction<MultiplyBatchFunction, double, double, double>(
+        {"multiply_batch"});
 
     registerFunction<PlusFunction, int64_t, int64_t, int64_t>({"plus"});
     registerFunction<CheckedPlusFunction, int64_t, int64_t, int64_t>(
@@ -218,6 +241,20 @@ BENCHMARK(multiplyOutputAlwaysNullSmall) {
 
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK(multiplyNoBatchSmall) {
+  benchmark->runSmall("multiply(a, b)");
+}
+
+BENCHMARK_RELATIVE(multiplyBatchSmall) {
+  benchmark->runSmall("multiply_batch(a, b)");
+}
+
+BENCHMARK(multiplyBatchHalfNullSmall) {
+  benchmark->runSmall("multiply_batch(a, half_null)");
+}
+
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK(plusUncheckedSmall) {
   benchmark->runSmall("plus(c, d)");
 }
@@ -275,6 +312,20 @@ BENCHMARK(multiplyOutputAlwaysNullMedium) {
 
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK(multiplyNoBatchMedium) {
+  benchmark->runMedium("multiply(a, b)");
+}
+
+BENCHMARK_RELATIVE(multiplyBatchMedium) {
+  benchmark->runMedium("multiply_batch(a, b)");
+}
+
+BENCHMARK(multiplyBatchHalfNullMedium) {
+  benchmark->runMedium("multiply_batch(a, half_null)");
+}
+
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK(plusUncheckedMedium) {
   benchmark->runMedium("plus(c, d)");
 }
@@ -332,6 +383,20 @@ BENCHMARK(multiplyOutputAlwaysNullLarge) {
 
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK(multiplyNoBatchLarge) {
+  benchmark->runLarge("multiply(a, b)");
+}
+
+BENCHMARK_RELATIVE(multiplyBatchLarge) {
+  benchmark->runLarge("multiply_batch(a, b)");
+}
+
+BENCHMARK(multiplyBatchHalfNullLarge) {
+  benchmark->runLarge("multiply_batch(a, half_null)");
+}
+
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK(plusUncheckedLarge) {
   benchmark->runLarge("plus(c, d)");
 }
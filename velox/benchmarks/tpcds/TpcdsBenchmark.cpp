@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <gflags/gflags.h>
+
+#include "velox/benchmarks/tpcds/TpcdsBenchmark.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/Split.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/parse/TypeResolver.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+void ensureTaskCompletion(exec::Task* task) {
+  // ASSERT_TRUE requires a function with return type void.
+  ASSERT_TRUE(waitForTaskCompletion(task));
+}
+
+void printResults(const std::vector<RowVectorPtr>& results, std::ostream& out) {
+  out << "Results:" << std::endl;
+  bool printType = true;
+  for (const auto& vector : results) {
+    // Print RowType only once.
+    if (printType) {
+      out << vector->type()->asRow().toString() << std::endl;
+      printType = false;
+    }
+    for (vector_size_t i = 0; i < vector->size(); ++i) {
+      out << vector->toString(i) << std::endl;
+    }
+  }
+}
+
+// Prints the spill metrics of the plan nodes that spilled.
+void printSpillStats(const TaskStats& taskStats, std::ostream& out) {
+  const auto planStats = toPlanStats(taskStats);
+  std::map<core::PlanNodeId, const PlanNodeStats*> spilledNodes;
+  for (const auto& [planNodeId, stats] : planStats) {
+    if (stats.spilledBytes > 0) {
+      spilledNodes.emplace(planNodeId, &stats);
+    }
+  }
+  if (spilledNodes.empty()) {
+    out << "Spilled: none" << std::endl;
+    return;
+  }
+  for (const auto& [planNodeId, stats] : spilledNodes) {
+    out << fmt::format(
+               "Spilled -- {}: input {}, {} in {} rows, {} partitions, "
+               "{} files",
+               planNodeId,
+               succinctBytes(stats->spilledInputBytes),
+               succinctBytes(stats->spilledBytes),
+               stats->spilledRows,
+               stats->spilledPartitions,
+               stats->spilledFiles)
+        << std::endl;
+  }
+}
+} // namespace
+
+DEFINE_double(scale_factor, 1, "TPC-DS scale factor of the generated data");
+DEFINE_int32(
+    run_query_verbose,
+    -1,
+    "Run a given query and print execution statistics");
+DEFINE_bool(
+    include_custom_stats,
+    false,
+    "Include custom statistics along with execution statistics");
+DEFINE_bool(include_results, false, "Include results in the output");
+DEFINE_int32(num_drivers, 4, "Number of drivers");
+DEFINE_int32(
+    num_splits_per_table,
+    16,
+    "Number of splits each table is generated in");
+DEFINE_int32(num_repeats, 1, "Number of times to run each query");
+DEFINE_string(
+    spill_path,
+    "",
+    "Directory for spill files. If set, enables spilling of all the "
+    "operators that support it");
+DEFINE_int32(
+    query_memory_gb,
+    0,
+    "If non-0, GB of memory for the query, above which the memory arbitrator "
+    "spills operators if spilling is enabled.");
+
+class TpcdsBenchmark {
+ public:
+  void initialize() {
+    memory::MemoryManagerOptions options;
+    if (FLAGS_query_memory_gb) {
+      memory::SharedArbitrator::registerFactory();
+      options.arbitratorKind = "SHARED";
+      options.arbitratorCapacity =
+          static_cast<int64_t>(FLAGS_query_memory_gb) << 30;
+    }
+    memory::MemoryManager::testingSetInstance(options);
+    functions::prestosql::registerAllScalarFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions();
+    window::prestosql::registerAllWindowFunctions();
+    parse::registerTypeResolver();
+    filesystems::registerLocalFileSystem();
+
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                kTpcdsConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(tpcdsConnector);
+  }
+
+  void shutdown() {
+    connector::unregisterConnector(kTpcdsConnectorId);
+  }
+
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> run(
+      const TpcdsPlan& tpcdsPlan) {
+    int32_t repeat = 0;
+    try {
+      for (;;) {
+        CursorParameters params;
+        params.maxDrivers = FLAGS_num_drivers;
+        params.planNode = tpcdsPlan.plan;
+        if (!FLAGS_spill_path.empty()) {
+          params.spillDirectory = FLAGS_spill_path;
+          for (const auto* config :
+               {core::QueryConfig::kSpillEnabled,
+                core::QueryConfig::kAggregationSpillEnabled,
+                core::QueryConfig::kJoinSpillEnabled,
+                core::QueryConfig::kOrderBySpillEnabled,
+                core::QueryConfig::kWindowSpillEnabled,
+                core::QueryConfig::kTopNRowNumberSpillEnabled}) {
+            params.queryConfigs[config] = "true";
+          }
+        }
+
+        bool noMoreSplits = false;
+        auto addSplits = [&](exec::Task* task) {
+          if (!noMoreSplits) {
+            for (const auto& [planNodeId, table] : tpcdsPlan.scanTables) {
+              for (auto i = 0; i < FLAGS_num_splits_per_table; ++i) {
+                task->addSplit(
+                    planNodeId,
+                    exec::Split(
+                        std::make_shared<connector::tpcds::TpcdsConnectorSplit>(
+                            kTpcdsConnectorId,
+                            FLAGS_num_splits_per_table,
+                            i)));
+              }
+              task->noMoreSplits(planNodeId);
+            }
+          }
+          noMoreSplits = true;
+        };
+        auto result = readCursor(params, addSplits);
+        ensureTaskCompletion(result.first->task().get());
+        if (++repeat >= FLAGS_num_repeats) {
+          return result;
+        }
+      }
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Query terminated with: " << e.what();
+      return {nullptr, std::vector<RowVectorPtr>()};
+    }
+  }
+
+  void runMain(std::ostream& out) {
+    if (FLAGS_run_query_verbose == -1) {
+      folly::runBenchmarks();
+      return;
+    }
+    const auto queryPlan = queryBuilder_->getQueryPlan(FLAGS_run_query_verbose);
+    auto [cursor, actualResults] = run(queryPlan);
+    if (!cursor) {
+      LOG(ERROR) << "Query terminated with error. Exiting";
+      exit(1);
+    }
+    auto task = cursor->task();
+    ensureTaskCompletion(task.get());
+    if (FLAGS_include_results) {
+      printResults(actualResults, out);
+      out << std::endl;
+    }
+    const auto stats = task->taskStats();
+    out << fmt::format(
+               "Execution time: {}",
+               succinctMillis(
+                   stats.executionEndTimeMs - stats.executionStartTimeMs))
+        << std::endl;
+    out << fmt::format(
+               "Splits total: {}, finished: {}",
+               stats.numTotalSplits,
+               stats.numFinishedSplits)
+        << std::endl;
+    printSpillStats(stats, out);
+    out << printPlanWithStats(
+               *queryPlan.plan, stats, FLAGS_include_custom_stats)
+        << std::endl;
+  }
+
+  TpcdsPlan getQueryPlan(int queryId) const {
+    return queryBuilder_->getQueryPlan(queryId);
+  }
+
+  void setQueryBuilder(std::unique_ptr<TpcdsQueryBuilder> queryBuilder) {
+    queryBuilder_ = std::move(queryBuilder);
+  }
+
+ private:
+  // Must match the connector id used by PlanBuilder::tpcdsTableScan().
+  static constexpr const char* kTpcdsConnectorId = "test-tpcds";
+
+  std::unique_ptr<TpcdsQueryBuilder> queryBuilder_;
+};
+
+TpcdsBenchmark benchmark;
+
+BENCHMARK(q3) {
+  benchmark.run(benchmark.getQueryPlan(3));
+}
+
+BENCHMARK(q27) {
+  benchmark.run(benchmark.getQueryPlan(27));
+}
+
+BENCHMARK(q67) {
+  benchmark.run(benchmark.getQueryPlan(67));
+}
+
+BENCHMARK(q98) {
+  benchmark.run(benchmark.getQueryPlan(98));
+}
+
+void tpcdsBenchmarkMain() {
+  benchmark.initialize();
+  benchmark.setQueryBuilder(
+      std::make_unique<TpcdsQueryBuilder>(FLAGS_scale_factor));
+  benchmark.runMain(std::cout);
+  benchmark.setQueryBuilder(nullptr);
+  benchmark.shutdown();
+}
@@ -30,6 +30,15 @@ namespace facebook::velox {
 // expected entry, we get ~2% false positives. 'hashInput' determines
 // if the value added or checked needs to be hashed. If this is false,
 // we assume that the input is already a 64 bit hash number.
+//
+// A split block filter sets 8 bits in a block of 256 bits, one in each
+// 32 bit lane, like the Bloom filters of Parquet. The high 32 bits of the
+// hash number select the block and the low 32 bits multiplied by a
+// different odd constant per lane select the bit in each lane. The lanes
+// are computed and tested with fixed 8 iteration loops that compile to
+// SIMD instructions. This has fewer false positives than the 64 bit groups
+// at the same size and one cache line miss per probe. The serialized form
+// starts with a version that tells the two layouts apart.
 template <typename Allocator = std::allocator<uint64_t>>
 class BloomFilter {
  public:
@@ -37,11 +46,19 @@ class BloomFilter {
   explicit BloomFilter(const Allocator& allocator) : bits_{allocator} {}
 
   // Prepares 'this' for use with an expected 'capacity'
-  // entries. Drops any prior content.
-  void reset(int32_t capacity) {
+  // entries. Drops any prior content. Uses 256 bit blocks if 'splitBlock' is
+  // true and 64 bit groups otherwise.
+  void reset(int32_t capacity, bool splitBlock = false) {
     bits_.clear();
+    version_ = splitBlock ? kBloomFilterV2 : kBloomFilterV1;
     // 2 bytes per value.
-    bits_.resize(std::max<int32_t>(4, bits::nextPowerOfTwo(capacity) / 4));
+    const auto numWords =
+        std::max<int32_t>(4, bits::nextPowerOfTwo(capacity) / 4);
+    bits_.resize(numWords);
+  }
+
+  bool isSplitBlock() const {
+    return version_ == kBloomFilterV2;
   }
 
   bool isSet() const {
@@ -52,20 +69,50 @@ class BloomFilter {
   // Input is hashed uint64_t value, optional hash function is
   // folly::hasher<InputType>()(value).
   void insert(uint64_t value) {
-    set(bits_.data(), bits_.size(), value);
+    if (isSplitBlock()) {
+      setBlock(bits_.data(), bits_.size() / kBlockWords, value);
+    } else {
+      set(bits_.data(), bits_.size(), value);
+    }
   }
 
   // Input is hashed uint64_t value, optional hash function is
   // folly::hasher<InputType>()(value).
   bool mayContain(uint64_t value) const {
+    if (isSplitBlock()) {
+      return testBlock(bits_.data(), bits_.size() / kBlockWords, value);
+    }
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Sets bit i of 'result' to mayContain(hashes[i]) for 'numHashes' hashes.
+  // Requires isSet(). Prefetches the words of the hashes a few positions
+  // ahead so that the cache misses of consecutive probes overlap.
+  void mayContain(const uint64_t* hashes, int32_t numHashes, uint64_t* result)
+      const {
+    constexpr int32_t kPrefetchDistance = 8;
+    for (auto i = 0; i < numHashes; ++i) {
+      if (i + kPrefetchDistance < numHashes) {
+        __builtin_prefetch(wordFor(hashes[i + kPrefetchDistance]));
+      }
+      bits::setBit(result, i, mayContain(hashes[i]));
+    }
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
-    VELOX_USER_CHECK_EQ(kBloomFilterV1, version);
+    VELOX_USER_CHECK(
+        version == kBloomFilterV1 || version == kBloomFilterV2,
+        "Unsupported bloom filter version: {}",
+        version);
     auto size = stream.read<int32_t>();
+    if (bits_.size() == 0) {
+      version_ = version;
+    } else if (size != 0) {
+      VELOX_USER_CHECK_EQ(
+          version_, version, "Cannot merge bloom filters of different layouts");
+    }
     bits_.resize(size);
     auto bitsdata =
         reinterpret_cast<const uint64_t*>(serialized + stream.offset());
@@ -89,7 +136,7 @@ class BloomFilter {
 
   void serialize(char* output) const {
     common::OutputByteStream stream(output);
-    stream.appendOne(kBloomFilterV1);
+    stream.appendOne(version_);
     stream.appendOne((int32_t)bits_.size());
     for (auto bit : bits_) {
       stream.appendOne(bit);
@@ -127,7 +174,76 @@ class BloomFilter {
     return mask == (bloom[index] & mask);
   }
 
-  const int8_t kBloomFilterV1 = 1;
+  static constexpr int8_t kBloomFilterV1 = 1;
+  // Split block layout.
+  static constexpr int8_t kBloomFilterV2 = 2;
+
+  static constexpr int32_t kBlockWords = 4;
+  static constexpr int32_t kBlockLanes = 8;
+
+  // Odd constants that select the bit in each 32 bit lane of a block. Same as
+  // the salts of the Parquet split block Bloom filter.
+  static constexpr uint32_t kSalts[kBlockLanes] = {
+      0x47b6137bU,
+      0x44974d91U,
+      0x8824ad5bU,
+      0xa2b7289dU,
+      0x705495c7U,
+      0x2df1424bU,
+      0x9efc4947U,
+      0x5c6bfb31U};
+
+  // Sets 'mask' to the 4 words of a block with 1 bit set in each 32 bit
+  // lane.
+  inline static void blockMask(uint64_t hashCode, uint64_t* mask) {
+    const auto key = static_cast<uint32_t>(hashCode);
+    uint32_t lanes[kBlockLanes];
+    for (auto i = 0; i < kBlockLanes; ++i) {
+      lanes[i] = 1U << ((key * kSalts[i]) >> 27);
+    }
+    for (auto i = 0; i < kBlockWords; ++i) {
+      mask[i] = lanes[2 * i] | (static_cast<uint64_t>(lanes[2 * i + 1]) << 32);
+    }
+  }
+
+  // Uses the high 32 bits of the hash code as block index. 'numBlocks' must
+  // be a power of 2.
+  inline static uint32_t blockIndex(uint32_t numBlocks, uint64_t hashCode) {
+    return (hashCode >> 32) & (numBlocks - 1);
+  }
+
+  inline static void
+  setBlock(uint64_t* bloom, int32_t numBlocks, uint64_t hashCode) {
+    uint64_t mask[kBlockWords];
+    blockMask(hashCode, mask);
+    auto* block = bloom + blockIndex(numBlocks, hashCode) * kBlockWords;
+    for (auto i = 0; i < kBlockWords; ++i) {
+      block[i] |= mask[i];
+    }
+  }
+
+  inline static bool
+  testBlock(const uint64_t* bloom, int32_t numBlocks, uint64_t hashCode) {
+    uint64_t mask[kBlockWords];
+    blockMask(hashCode, mask);
+    const auto* block = bloom + blockIndex(numBlocks, hashCode) * kBlockWords;
+    uint64_t missing = 0;
+    for (auto i = 0; i < kBlockWords; ++i) {
+      missing |= mask[i] & ~block[i];
+    }
+    return missing == 0;
+  }
+
+  // Returns the first word probed for 'hashCode'.
+  const uint64_t* wordFor(uint64_t hashCode) const {
+    if (isSplitBlock()) {
+      return bits_.data() +
+          blockIndex(bits_.size() / kBlockWords, hashCode) * kBlockWords;
+    }
+    return bits_.data() + bloomIndex(bits_.size(), hashCode);
+  }
+
+  int8_t version_{kBloomFilterV1};
   std::vector<uint64_t, Allocator> bits_;
 };
 
@@ -168,6 +168,16 @@ void registerVeloxMetrics() {
   DEFINE_METRIC(
       kMetricMemoryCacheNumAgedOutEntries, facebook::velox::StatType::SUM);
 
+  // Number of loaded AsyncDataCache entries that the cache policy did not
+  // admit, since last counter retrieval.
+  DEFINE_METRIC(
+      kMetricMemoryCacheNumNotAdmitted, facebook::velox::StatType::SUM);
+
+  // Number of hits on AsyncDataCache entries that the cache policy did not
+  // admit, since last counter retrieval.
+  DEFINE_METRIC(
+      kMetricMemoryCacheNumNotAdmittedHits, facebook::velox::StatType::SUM);
+
   /// ================== SsdCache Counters ==================
 
   // Number of regions currently cached by SSD.
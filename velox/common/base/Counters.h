@@ -218,6 +218,12 @@ constexpr folly::StringPiece kMetricMemoryCacheNumAllocClocks{
 constexpr folly::StringPiece kMetricMemoryCacheNumAgedOutEntries{
     "velox.memory_cache_num_aged_out_entries"};
 
+constexpr folly::StringPiece kMetricMemoryCacheNumNotAdmitted{
+    "velox.memory_cache_num_not_admitted"};
+
+constexpr folly::StringPiece kMetricMemoryCacheNumNotAdmittedHits{
+    "velox.memory_cache_num_not_admitted_hits"};
+
 constexpr folly::StringPiece kMetricSsdCacheCachedRegions{
     "velox.ssd_cache_cached_regions"};
 
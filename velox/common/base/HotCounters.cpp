@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/HotCounters.h"
+
+#include <fmt/format.h>
+#include <mutex>
+#include <unordered_set>
+
+namespace facebook::velox {
+namespace {
+struct Registry {
+  std::mutex mutex;
+  // The first counter of each live thread.
+  std::unordered_set<std::atomic<int64_t>*> threads;
+  // Sum of the counters of the exited threads.
+  HotCounters::Values exited{};
+};
+
+Registry& registry() {
+  static auto* registry = new Registry();
+  return *registry;
+}
+} // namespace
+
+HotCounters::ThreadCounters::ThreadCounters() {
+  auto& state = registry();
+  std::lock_guard<std::mutex> l(state.mutex);
+  state.threads.insert(values.data());
+}
+
+HotCounters::ThreadCounters::~ThreadCounters() {
+  auto& state = registry();
+  std::lock_guard<std::mutex> l(state.mutex);
+  for (auto i = 0; i < kNumCounters; ++i) {
+    state.exited[i] += values[i].load(std::memory_order_relaxed);
+  }
+  state.threads.erase(values.data());
+}
+
+// static
+HotCounters::Values HotCounters::read() {
+  auto& state = registry();
+  std::lock_guard<std::mutex> l(state.mutex);
+  auto result = state.exited;
+  for (auto* values : state.threads) {
+    for (auto i = 0; i < kNumCounters; ++i) {
+      result[i] += values[i].load(std::memory_order_relaxed);
+    }
+  }
+  return result;
+}
+
+// static
+void HotCounters::reset() {
+  auto& state = registry();
+  std::lock_guard<std::mutex> l(state.mutex);
+  state.exited.fill(0);
+  for (auto* values : state.threads) {
+    for (auto i = 0; i < kNumCounters; ++i) {
+      values[i].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+// static
+std::string_view HotCounters::name(HotCounter counter) {
+  switch (counter) {
+    case HotCounter::kHashTableProbe:
+      return "hashTableProbe";
+    case HotCounter::kHashTableTagLoad:
+      return "hashTableTagLoad";
+    case HotCounter::kHashTableRowLoad:
+      return "hashTableRowLoad";
+    case HotCounter::kHashTableHit:
+      return "hashTableHit";
+    case HotCounter::kDecodeFlat:
+      return "decodeFlat";
+    case HotCounter::kDecodeConstant:
+      return "decodeConstant";
+    case HotCounter::kDecodeWrapped:
+      return "decodeWrapped";
+    case HotCounter::kDecodeNestedWrapper:
+      return "decodeNestedWrapper";
+    case HotCounter::kPeelSuccess:
+      return "peelSuccess";
+    case HotCounter::kPeelFailure:
+      return "peelFailure";
+    case HotCounter::kSelectiveFastPath:
+      return "selectiveFastPath";
+    case HotCounter::kSelectiveSlowPath:
+      return "selectiveSlowPath";
+    case HotCounter::kNumCounters:
+      break;
+  }
+  return "unknown";
+}
+
+// static
+std::string HotCounters::toString() {
+  auto values = read();
+  std::string out;
+  for (auto i = 0; i < kNumCounters; ++i) {
+    if (values[i] != 0) {
+      out += fmt::format(
+          "{}: {}\n", name(static_cast<HotCounter>(i)), values[i]);
+    }
+  }
+  return out;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace facebook::velox {
+
+/// Fine-grained event counters for hot loops, e.g. the probe chain length of a
+/// hash table or how often a decoder takes its fast path. These are too
+/// costly to keep in production builds. The VELOX_HOT_COUNTER_ADD and
+/// VELOX_HOT_COUNTER_INC macros that update them compile to nothing unless
+/// VELOX_ENABLE_HOT_COUNTERS is defined. The CMake option of the same name
+/// defines it.
+enum class HotCounter : int32_t {
+  /// Rows looked up in hash table probes.
+  kHashTableProbe,
+  /// Tag vector loads in hash table probes and inserts. Divided by
+  /// kHashTableProbe, this approximates the probe chain length in buckets.
+  kHashTableTagLoad,
+  /// Rows loaded for a tag match in hash table probes.
+  kHashTableRowLoad,
+  /// Hash table probes that found a matching row. kHashTableRowLoad minus
+  /// this is the number of tag false positives.
+  kHashTableHit,
+  /// DecodedVector::decode() of a flat or other non-wrapped vector.
+  kDecodeFlat,
+  /// DecodedVector::decode() of a constant vector.
+  kDecodeConstant,
+  /// DecodedVector::decode() of a dictionary or sequence vector.
+  kDecodeWrapped,
+  /// Wrappers below the top one that DecodedVector combines indices of.
+  kDecodeNestedWrapper,
+  /// Successful and failed PeeledEncoding::peel().
+  kPeelSuccess,
+  kPeelFailure,
+  /// Selective reader decodes that take the bulk fast path and the row by row
+  /// path.
+  kSelectiveFastPath,
+  kSelectiveSlowPath,
+  kNumCounters
+};
+
+class HotCounters {
+ public:
+  static constexpr int32_t kNumCounters =
+      static_cast<int32_t>(HotCounter::kNumCounters);
+
+  using Values = std::array<int64_t, kNumCounters>;
+
+  /// Adds 'value' to 'counter' for the calling thread. Use the macros below
+  /// instead of calling this directly from hot paths.
+  static void add(HotCounter counter, int64_t value) {
+    auto& count = threadCounters().values[static_cast<int32_t>(counter)];
+    // Only the owning thread writes, so a load and store suffice.
+    count.store(
+        count.load(std::memory_order_relaxed) + value,
+        std::memory_order_relaxed);
+  }
+
+  /// Returns the sum of the counters of all threads, including exited ones.
+  static Values read();
+
+  /// Sets all counters of all threads to 0. Counts added concurrently may be
+  /// kept.
+  static void reset();
+
+  static std::string_view name(HotCounter counter);
+
+  /// Returns the non-zero counters, one 'name: value' per line.
+  static std::string toString();
+
+ private:
+  struct ThreadCounters {
+    ThreadCounters();
+    ~ThreadCounters();
+
+    std::array<std::atomic<int64_t>, kNumCounters> values{};
+  };
+
+  static ThreadCounters& threadCounters() {
+    thread_local ThreadCounters counters;
+    return counters;
+  }
+};
+
+} // namespace facebook::velox
+
+#ifdef VELOX_ENABLE_HOT_COUNTERS
+#define VELOX_HOT_COUNTER_ADD(counter, value) \
+  ::facebook::velox::HotCounters::add(        \
+      ::facebook::velox::HotCounter::counter, (value))
+#else
+#define VELOX_HOT_COUNTER_ADD(counter, value)
+#endif
+
+#define VELOX_HOT_COUNTER_INC(counter) VELOX_HOT_COUNTER_ADD(counter, 1)
@@ -169,6 +169,10 @@ void PeriodicStatsReporter::reportCacheStats() {
       kMetricMemoryCacheNumAgedOutEntries, deltaCacheStats.numAgedOut);
   REPORT_IF_NOT_ZERO(
       kMetricMemoryCacheSumEvictScore, deltaCacheStats.sumEvictScore);
+  REPORT_IF_NOT_ZERO(
+      kMetricMemoryCacheNumNotAdmitted, deltaCacheStats.numNotAdmitted);
+  REPORT_IF_NOT_ZERO(
+      kMetricMemoryCacheNumNotAdmittedHits, deltaCacheStats.numNotAdmittedHit);
 
   // SSD cache snapshot stats.
   if (cacheStats.ssdStats != nullptr) {
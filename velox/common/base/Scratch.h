@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "velox/common/base/RawVector.h"
 
 /// A utility for reusable scoped temporary scratch areas.
@@ -160,4 +162,125 @@ class ScratchPtr {
   char padding_[inlineSize == 0 ? 0 : simd::kPadding];
 };
 
+/// A bump pointer arena for temporaries that do not outlive a batch of
+/// processing, e.g. one evaluation of an expression. Allocations are not
+/// individually freed nor accounted in a MemoryPool. They are released all at
+/// once by rewind() or reset(). The memory is kept for reuse by the next
+/// batch. Each allocation is followed by simd::kPadding bytes to allow writing
+/// at full SIMD width at its end. Not thread safe.
+class ScratchArena {
+ public:
+  static constexpr int64_t kMinChunkSize = 64 << 10;
+
+  /// A position in the arena. Rewinding to a mark releases the allocations
+  /// made after it.
+  struct Mark {
+    int32_t chunk{0};
+    int64_t offset{0};
+
+    bool isStart() const {
+      return chunk == 0 && offset == 0;
+    }
+  };
+
+  ScratchArena() = default;
+  ScratchArena(const ScratchArena& other) = delete;
+  void operator=(const ScratchArena& other) = delete;
+
+  ~ScratchArena() {
+    trim();
+  }
+
+  /// Returns uninitialized space for 'size' elements of T. The space is valid
+  /// until the arena is rewound to a mark from before this call.
+  template <typename T>
+  T* allocate(int64_t size) {
+    return reinterpret_cast<T*>(allocateBytes(size * sizeof(T), alignof(T)));
+  }
+
+  /// Returns 'bytes' of uninitialized space aligned at 'alignment'.
+  char* allocateBytes(int64_t bytes, int32_t alignment = sizeof(void*)) {
+    VELOX_DCHECK_LE(alignment, alignof(std::max_align_t));
+    const auto needed = bytes + simd::kPadding;
+    for (; current_ < static_cast<int32_t>(chunks_.size());
+         ++current_, offset_ = 0) {
+      const auto start = bits::roundUp(offset_, alignment);
+      if (start + needed <= chunks_[current_].size) {
+        offset_ = start + bytes;
+        return chunks_[current_].data + start;
+      }
+    }
+    const int64_t chunkSize = std::max<int64_t>(
+        bits::nextPowerOfTwo(needed),
+        chunks_.empty() ? kMinChunkSize : 2 * chunks_.back().size);
+    chunks_.push_back(
+        {reinterpret_cast<char*>(::malloc(chunkSize)), chunkSize});
+    VELOX_CHECK_NOT_NULL(chunks_.back().data);
+    retainedSize_ += chunkSize;
+    current_ = chunks_.size() - 1;
+    offset_ = bytes;
+    return chunks_.back().data;
+  }
+
+  /// Returns the current position.
+  Mark mark() const {
+    return {current_, offset_};
+  }
+
+  /// Releases the allocations made after 'mark'. Marks must be rewound in the
+  /// reverse order in which they were taken.
+  void rewind(const Mark& mark) {
+    VELOX_DCHECK(
+        mark.chunk < current_ ||
+        (mark.chunk == current_ && mark.offset <= offset_));
+    current_ = mark.chunk;
+    offset_ = mark.offset;
+  }
+
+  /// Releases all allocations. If the last batch needed more than one chunk,
+  /// the chunks are replaced by one chunk of their combined size so that the
+  /// next batch of the same size fits in one chunk.
+  void reset() {
+    current_ = 0;
+    offset_ = 0;
+    if (chunks_.size() > 1) {
+      const auto size = retainedSize_;
+      trim();
+      chunks_.push_back({reinterpret_cast<char*>(::malloc(size)), size});
+      VELOX_CHECK_NOT_NULL(chunks_.back().data);
+      retainedSize_ = size;
+    }
+  }
+
+  /// Frees all memory. All allocations are released.
+  void trim() {
+    for (auto& chunk : chunks_) {
+      ::free(chunk.data);
+    }
+    chunks_.clear();
+    current_ = 0;
+    offset_ = 0;
+    retainedSize_ = 0;
+  }
+
+  /// Returns the total size of the chunks held.
+  int64_t retainedSize() const {
+    return retainedSize_;
+  }
+
+ private:
+  struct Chunk {
+    char* data;
+    int64_t size;
+  };
+
+  std::vector<Chunk> chunks_;
+  // Index in 'chunks_' of the chunk being allocated from. 0 if there are no
+  // chunks.
+  int32_t current_{0};
+  // Offset of the first free byte in 'chunks_[current_]'.
+  int64_t offset_{0};
+  int64_t retainedSize_{0};
+};
+
 } // namespace facebook::velox
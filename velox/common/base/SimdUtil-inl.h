@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <cstring>
 #include <numeric>
 
 #if XSIMD_WITH_NEON
@@ -1436,4 +1437,43 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename A>
+inline size_t findSubstring(
+    std::string_view haystack,
+    std::string_view needle,
+    const A&) {
+  constexpr size_t kBatch = xsimd::batch<uint8_t, A>::size;
+  const auto size = needle.size();
+  if (size == 0) {
+    return 0;
+  }
+  if (haystack.size() < size) {
+    return std::string_view::npos;
+  }
+  const auto first = xsimd::broadcast<uint8_t, A>(needle[0]);
+  const auto last = xsimd::broadcast<uint8_t, A>(needle[size - 1]);
+  const auto* data = reinterpret_cast<const uint8_t*>(haystack.data());
+  size_t offset = 0;
+  // Positions 'offset' to 'offset' + kBatch - 1 are candidates if the bytes up
+  // to the end of the needle at the last candidate are in range.
+  for (; offset + kBatch + size - 1 <= haystack.size(); offset += kBatch) {
+    auto matches = toBitMask(
+        (xsimd::batch<uint8_t, A>::load_unaligned(data + offset) == first) &
+        (xsimd::batch<uint8_t, A>::load_unaligned(data + offset + size - 1) ==
+         last));
+    while (matches) {
+      const auto position = offset + __builtin_ctzll(matches);
+      if (size <= 2 ||
+          memcmp(
+              haystack.data() + position + 1, needle.data() + 1, size - 2) ==
+              0) {
+        return position;
+      }
+      matches &= matches - 1;
+    }
+  }
+  const auto position = haystack.substr(offset).find(needle);
+  return position == std::string_view::npos ? position : offset + position;
+}
+
 } // namespace facebook::velox::simd
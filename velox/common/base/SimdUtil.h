@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 
@@ -497,6 +498,17 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+// Returns the offset of the first occurrence of 'needle' in 'haystack' or
+// std::string_view::npos if there is none. Compares the first and the last
+// byte of 'needle' at a batch of positions at a time and checks the rest only
+// at the positions where both match. Does not read past the end of either
+// argument.
+template <typename A = xsimd::default_arch>
+inline size_t findSubstring(
+    std::string_view haystack,
+    std::string_view needle,
+    const A& = {});
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
@@ -18,6 +18,8 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <atomic>
+#include <memory>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/compression/Compression.h"
@@ -42,6 +44,37 @@ using GetSpillDirectoryPathCB = std::function<std::string_view()>;
 /// bytes exceed the set limit.
 using UpdateAndCheckSpillLimitCB = std::function<void(uint64_t)>;
 
+/// A remote tier for the spill files of a task, e.g. on S3 or HDFS. The spill
+/// files are written to the local spill directory first. The finished ones
+/// are moved to 'directory' through velox::FileSystem while the local spill
+/// files of the task take more than 'localWatermarkBytes'. Shared by the
+/// spill configs of the task.
+struct SpillRemoteTier {
+  SpillRemoteTier(
+      std::string _directory,
+      uint64_t _localWatermarkBytes,
+      folly::Executor* _executor)
+      : directory(std::move(_directory)),
+        localWatermarkBytes(_localWatermarkBytes),
+        executor(_executor) {}
+
+  /// The remote directory for the spill files of the task.
+  const std::string directory;
+
+  const uint64_t localWatermarkBytes;
+
+  /// Executor for moving the files. If nullptr, the files are moved on the
+  /// spilling thread.
+  folly::Executor* const executor; // Not owned.
+
+  /// Bytes of the spill files of the task written to the local spill
+  /// directory and not moved to 'directory'.
+  std::atomic<uint64_t> localBytes{0};
+
+  /// Number of spill files moved to 'directory'.
+  std::atomic<uint64_t> numMovedFiles{0};
+};
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig() = default;
@@ -138,5 +171,36 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If true, spill data whose columns all have a fixed width is written in
+  /// a row-major layout and memory mapped on read. Used by aggregation and
+  /// order by spilling.
+  bool rowFormatEnabled{false};
+
+  /// If true and 'executor' is set, the spill files are written on 'executor'
+  /// while the spilling thread serializes the next buffer.
+  bool asyncWriteEnabled{false};
+
+  /// If true, the string columns with few distinct values are spilled as
+  /// dictionaries.
+  bool dictionaryEncodingEnabled{false};
+
+  /// The max number of sorted spill files to merge at once. 0 means no limit.
+  uint32_t mergeFanIn{0};
+
+  /// If true, the spill files are written with checksums that are verified on
+  /// read.
+  bool checksumEnabled{false};
+
+  /// If true, the codec of each serialized page is picked by the page
+  /// contents. See PrestoVectorSerde::PrestoOptions::adaptiveCompression.
+  bool adaptiveCompression{false};
+
+  /// CPU budget in nanoseconds per input byte of the ZSTD compression of
+  /// string pages with 'adaptiveCompression'. 0 means no limit.
+  float compressionMaxNanosPerByte{0};
+
+  /// Optional remote tier for the spill files.
+  std::shared_ptr<SpillRemoteTier> remoteTier;
 };
 } // namespace facebook::velox::common
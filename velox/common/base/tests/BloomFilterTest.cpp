@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/BloomFilter.h"
+#include "velox/common/base/tests/GTestUtils.h"
 
 #include <folly/Hash.h>
 #include <folly/Random.h>
@@ -90,3 +91,47 @@ TEST_F(BloomFilterTest, merge) {
 
   EXPECT_EQ(bloom.serializedSize(), merge.serializedSize());
 }
+
+TEST_F(BloomFilterTest, splitBlock) {
+  constexpr int32_t kSize = 1024;
+  BloomFilter bloom;
+  bloom.reset(kSize, /*splitBlock=*/true);
+  ASSERT_TRUE(bloom.isSplitBlock());
+  std::vector<uint64_t> hashes;
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(folly::hasher<int32_t>()(i));
+    hashes.push_back(folly::hasher<int32_t>()(i));
+    hashes.push_back(folly::hasher<int32_t>()(i + kSize));
+  }
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_TRUE(bloom.mayContain(folly::hasher<int32_t>()(i)));
+    numFalsePositives += bloom.mayContain(folly::hasher<int32_t>()(i + kSize));
+  }
+  EXPECT_GT(2, 100 * numFalsePositives / kSize);
+
+  // Probing a batch gives the same results as probing one at a time.
+  std::vector<uint64_t> contained(bits::nwords(hashes.size()));
+  bloom.mayContain(hashes.data(), hashes.size(), contained.data());
+  for (auto i = 0; i < hashes.size(); ++i) {
+    EXPECT_EQ(bits::isBitSet(contained.data(), i), bloom.mayContain(hashes[i]));
+  }
+
+  // The layout survives serialization.
+  std::string data;
+  data.resize(bloom.serializedSize());
+  bloom.serialize(data.data());
+  BloomFilter deserialized;
+  deserialized.merge(data.data());
+  ASSERT_TRUE(deserialized.isSplitBlock());
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_TRUE(deserialized.mayContain(folly::hasher<int32_t>()(i)));
+  }
+
+  // Filters of different layouts cannot be merged.
+  BloomFilter other;
+  other.reset(kSize);
+  VELOX_ASSERT_THROW(
+      other.merge(data.data()),
+      "Cannot merge bloom filters of different layouts");
+}
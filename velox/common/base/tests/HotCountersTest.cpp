@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/HotCounters.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace facebook::velox::test {
+namespace {
+
+int64_t count(HotCounter counter) {
+  return HotCounters::read()[static_cast<int32_t>(counter)];
+}
+
+TEST(HotCountersTest, threads) {
+  HotCounters::reset();
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 4; ++i) {
+    threads.emplace_back([]() {
+      for (auto j = 0; j < 1'000; ++j) {
+        HotCounters::add(HotCounter::kHashTableProbe, 2);
+      }
+    });
+  }
+  HotCounters::add(HotCounter::kPeelSuccess, 1);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // The exited threads are counted.
+  EXPECT_EQ(8'000, count(HotCounter::kHashTableProbe));
+  EXPECT_EQ(1, count(HotCounter::kPeelSuccess));
+  EXPECT_EQ(0, count(HotCounter::kPeelFailure));
+  EXPECT_EQ(
+      "hashTableProbe: 8000\npeelSuccess: 1\n", HotCounters::toString());
+
+  HotCounters::reset();
+  EXPECT_EQ(0, count(HotCounter::kHashTableProbe));
+  EXPECT_EQ(0, count(HotCounter::kPeelSuccess));
+}
+
+TEST(HotCountersTest, macros) {
+  HotCounters::reset();
+  int32_t evaluated = 0;
+  VELOX_HOT_COUNTER_INC(kDecodeFlat);
+  VELOX_HOT_COUNTER_ADD(kDecodeWrapped, ++evaluated);
+#ifdef VELOX_ENABLE_HOT_COUNTERS
+  EXPECT_EQ(1, count(HotCounter::kDecodeFlat));
+  EXPECT_EQ(1, count(HotCounter::kDecodeWrapped));
+  EXPECT_EQ(1, evaluated);
+#else
+  // The macros compile to nothing, including their arguments.
+  EXPECT_EQ(0, count(HotCounter::kDecodeFlat));
+  EXPECT_EQ(0, count(HotCounter::kDecodeWrapped));
+  EXPECT_EQ(0, evaluated);
+#endif
+}
+
+} // namespace
+} // namespace facebook::velox::test
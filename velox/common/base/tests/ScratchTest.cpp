@@ -72,3 +72,42 @@ TEST(ScratchTest, large) {
   }
   EXPECT_EQ(0, scratch.retainedSize());
 }
+
+TEST(ScratchTest, arena) {
+  ScratchArena arena;
+  EXPECT_EQ(0, arena.retainedSize());
+  EXPECT_TRUE(arena.mark().isStart());
+
+  auto* ints = arena.allocate<int32_t>(1000);
+  std::fill(ints, ints + 1000, -1);
+  auto* chars = arena.allocate<char>(3);
+  auto* longs = arena.allocate<int64_t>(100);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(longs) % alignof(int64_t));
+  EXPECT_LE(ints + 1000, reinterpret_cast<int32_t*>(chars));
+  EXPECT_LT(chars + 3, reinterpret_cast<char*>(longs));
+  EXPECT_EQ(ScratchArena::kMinChunkSize, arena.retainedSize());
+
+  // Rewinding to a mark reuses the space allocated after it.
+  const auto mark = arena.mark();
+  auto* first = arena.allocate<int64_t>(10);
+  arena.rewind(mark);
+  EXPECT_EQ(first, arena.allocate<int64_t>(10));
+
+  // An allocation larger than the chunk size gets its own chunk.
+  auto* large = arena.allocate<char>(ScratchArena::kMinChunkSize);
+  std::fill(large, large + ScratchArena::kMinChunkSize, 1);
+  const auto retained = arena.retainedSize();
+  EXPECT_LT(2 * ScratchArena::kMinChunkSize, retained);
+
+  // The chunks are combined into one on reset.
+  arena.reset();
+  EXPECT_TRUE(arena.mark().isStart());
+  EXPECT_EQ(retained, arena.retainedSize());
+  arena.allocate<char>(ScratchArena::kMinChunkSize);
+  arena.allocate<int32_t>(1000);
+  EXPECT_EQ(retained, arena.retainedSize());
+  EXPECT_EQ(0, arena.mark().chunk);
+
+  arena.trim();
+  EXPECT_EQ(0, arena.retainedSize());
+}
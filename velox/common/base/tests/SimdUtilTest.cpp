@@ -453,6 +453,34 @@ TEST_F(SimdUtilTest, memEqualUnsafe) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+TEST_F(SimdUtilTest, findSubstring) {
+  std::string haystack;
+  for (auto i = 0; i < 200; ++i) {
+    haystack += static_cast<char>('a' + i % 7);
+  }
+  auto check = [&](std::string_view text, std::string_view needle) {
+    ASSERT_EQ(simd::findSubstring(text, needle), text.find(needle))
+        << text << " / " << needle;
+  };
+  const std::string_view text = haystack;
+  for (auto size = 0; size < text.size(); size += 13) {
+    for (auto start = 0; start + size < text.size(); start += 29) {
+      check(text, text.substr(start, size));
+      check(text.substr(start), text.substr(start, size));
+    }
+  }
+  // Matches at the very end, first and last character matching but not the
+  // middle, no match, and needles longer than the text.
+  haystack[199] = 'z';
+  check(haystack, "gz");
+  check(haystack, "z");
+  check(haystack, "abxdefg");
+  check(haystack, "ax");
+  check("abc", "abcd");
+  check("", "a");
+  check("abc", "");
+}
+
 TEST_F(SimdUtilTest, memcpyTime) {
   constexpr int64_t kMaxMove = 128;
   constexpr int64_t kSize = (128 << 20) + kMaxMove;
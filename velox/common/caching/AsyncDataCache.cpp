@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/CachePolicy.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/caching/SsdFile.h"
@@ -24,6 +25,10 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/process/Timeline.h"
+#include "velox/common/time/Timer.h"
+
+#include <folly/futures/Future.h>
 
 namespace facebook::velox::cache {
 
@@ -42,11 +47,14 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
   VELOX_CHECK(isExclusive());
   numPins_ = 1;
   std::unique_ptr<folly::SharedPromise<bool>> promise;
+  CachePriority priority;
   {
     std::lock_guard<std::mutex> l(shard_->mutex());
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
+    shard_->admitLocked(this);
+    priority = priority_;
   }
   if (promise != nullptr) {
     promise->setValue(true);
@@ -67,6 +75,7 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
 
   auto* ssdCache = shard_->cache()->ssdCache();
   if ((ssdCache != nullptr) && (ssdFile_ == nullptr)) {
+    ssdCache->groupStats().recordPriority(groupId_, priority);
     if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
       ssdSaveable_ = true;
       shard_->cache()->possibleSsdSave(size_);
@@ -145,6 +154,18 @@ std::string AsyncDataCacheEntry::toString() const {
       numPins_);
 }
 
+CacheShard::CacheShard(
+    AsyncDataCache* cache,
+    double maxWriteRatio,
+    std::unique_ptr<CachePolicy> policy)
+    : cache_(cache),
+      maxWriteRatio_(maxWriteRatio),
+      policy_(
+          policy != nullptr ? std::move(policy)
+                            : std::make_unique<DefaultCachePolicy>()) {}
+
+CacheShard::~CacheShard() = default;
+
 std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   std::unique_ptr<AsyncDataCacheEntry> newEntry;
   if (freeEntries_.empty()) {
@@ -159,11 +180,13 @@ std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
 CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
-    folly::SemiFuture<bool>* wait) {
+    folly::SemiFuture<bool>* wait,
+    const std::shared_ptr<CacheQuota>& quota) {
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++eventCounter_;
+    policy_->recordAccess(key);
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto* foundEntry = it->second;
@@ -185,6 +208,13 @@ CachePin CacheShard::findOrCreate(
           ++numHit_;
           hitBytes_ += foundEntry->size();
         }
+        if (foundEntry->notAdmitted_) {
+          foundEntry->notAdmitted_ = false;
+          ++numNotAdmittedHit_;
+        }
+        if (quota != nullptr && quota->priority() > foundEntry->priority_) {
+          foundEntry->priority_ = quota->priority();
+        }
         ++foundEntry->numPins_;
         CachePin pin;
         pin.setEntry(foundEntry);
@@ -222,6 +252,12 @@ CachePin CacheShard::findOrCreate(
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
+    entryToInit->notAdmitted_ = false;
+    if (quota != nullptr) {
+      entryToInit->quota_ = quota;
+      entryToInit->priority_ = quota->priority();
+      quota->add(size);
+    }
   }
   return initEntry(key, entryToInit);
 }
@@ -245,6 +281,20 @@ bool CacheShard::exists(RawFileCacheKey key) const {
   return false;
 }
 
+void CacheShard::admitLocked(AsyncDataCacheEntry* entry) {
+  const bool quotaExceeded =
+      entry->quota_ != nullptr && entry->quota_->exceeded();
+  if (!quotaExceeded && policy_->admit(*entry)) {
+    return;
+  }
+  if (quotaExceeded) {
+    entry->quota_->incrementNotAdmitted();
+  }
+  entry->makeEvictable();
+  entry->notAdmitted_ = true;
+  ++numNotAdmitted_;
+}
+
 CachePin CacheShard::initEntry(
     RawFileCacheKey key,
     AsyncDataCacheEntry* entry) {
@@ -291,6 +341,7 @@ bool CoalescedLoad::loadOrFuture(
 
   // Outside of 'mutex_'.
   try {
+    process::Timeline::ScopedEvent timelineEvent("io", "CoalescedLoad");
     const auto pins = loadData(/*prefetch=*/wait == nullptr);
     for (const auto& pin : pins) {
       auto* entry = pin.checkedEntry();
@@ -331,7 +382,30 @@ std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
   return entry->movePromise();
 }
 
+int32_t CacheShard::scoreLocked(
+    const AsyncDataCacheEntry& entry,
+    AccessTime now) const {
+  // Low priority entries age 4x faster and high priority ones 4x slower.
+  constexpr int64_t kPriorityFactor = 4;
+  const int64_t score = policy_->score(entry.accessStats_, entry.size_, now);
+  switch (entry.priority_) {
+    case CachePriority::kLow:
+      return std::min<int64_t>(
+          score * kPriorityFactor, std::numeric_limits<int32_t>::max() - 1);
+    case CachePriority::kNormal:
+      return score;
+    case CachePriority::kHigh:
+      return score / kPriorityFactor;
+  }
+  VELOX_UNREACHABLE();
+}
+
 void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
+  if (entry->quota_ != nullptr) {
+    entry->quota_->add(-static_cast<int64_t>(entry->size_));
+    entry->quota_.reset();
+  }
+  entry->priority_ = CachePriority::kNormal;
   if (entry->key_.fileNum.hasValue()) {
     const auto it = entryMap_.find(
         RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset});
@@ -407,7 +481,7 @@ uint64_t CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           (score = scoreLocked(*candidate, now)) >= evictionThreshold_)) {
         if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
@@ -426,7 +500,6 @@ uint64_t CacheShard::evict(
         tinyEvicted += candidate->tinyData_.size();
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
-        candidate->size_ = 0;
 
         removeEntryLocked(candidate);
         emptySlots_.push_back(entryIndex);
@@ -486,7 +559,7 @@ void CacheShard::calibrateThreshold() {
   evictionThreshold_ = percentile<int32_t>(
       [&]() -> int32_t {
         AsyncDataCacheEntry* element = iter->get();
-        int32_t score = element ? element->score(now) : 0;
+        int32_t score = element ? scoreLocked(*element, now) : 0;
         if (entryIndex + step >= entries_.size()) {
           entryIndex = (entryIndex + step) % entries_.size();
           iter = entries_.begin() + entryIndex;
@@ -535,7 +608,24 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numWaitExclusive += numWaitExclusive_;
   stats.numAgedOut += numAgedOut_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numNotAdmitted += numNotAdmitted_;
+  stats.numNotAdmittedHit += numNotAdmittedHit_;
   stats.allocClocks += allocClocks_;
+  stats.policy = policy_->name();
+}
+
+void CacheShard::appendScoredKeys(std::vector<ScoredKey>& keys) {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto now = accessTime();
+  for (const auto& entry : entries_) {
+    if (!entry || !entry->key_.fileNum.hasValue() || entry->isExclusive()) {
+      continue;
+    }
+    keys.push_back(ScoredKey{
+        RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset},
+        entry->size_,
+        scoreLocked(*entry, now)});
+  }
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
@@ -621,6 +711,9 @@ CacheStats CacheStats::operator-(CacheStats& other) const {
   result.numAgedOut = numAgedOut - other.numAgedOut;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numNotAdmitted = numNotAdmitted - other.numNotAdmitted;
+  result.numNotAdmittedHit = numNotAdmittedHit - other.numNotAdmittedHit;
+  result.policy = policy;
   if (ssdStats != nullptr && other.ssdStats != nullptr) {
     result.ssdStats =
         std::make_shared<SsdCacheStats>(*ssdStats - *other.ssdStats);
@@ -642,11 +735,17 @@ AsyncDataCache::AsyncDataCache(
       ssdCache_(std::move(ssdCache)),
       cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
+    shards_.push_back(std::make_unique<CacheShard>(
+        this,
+        opts_.maxWriteRatio,
+        opts_.policyFactory ? opts_.policyFactory() : nullptr));
   }
 }
 
-AsyncDataCache::~AsyncDataCache() = default;
+AsyncDataCache::~AsyncDataCache() {
+  stopSsdWarmUp_ = true;
+  testingWaitForSsdWarmUp();
+}
 
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
@@ -656,6 +755,9 @@ std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
   auto cache =
       std::make_shared<AsyncDataCache>(options, allocator, std::move(ssdCache));
   allocator->registerCache(cache);
+  if (cache->ssdCache_ != nullptr && options.ssdWarmUpBytes > 0) {
+    cache->startSsdWarmUp();
+  }
   return cache;
 }
 
@@ -676,6 +778,13 @@ AsyncDataCache** AsyncDataCache::getInstancePtr() {
 }
 
 void AsyncDataCache::shutdown() {
+  stopSsdWarmUp_ = true;
+  if (ssdWarmUp_.valid()) {
+    std::move(ssdWarmUp_).wait();
+  }
+  if (ssdCache_ != nullptr && opts_.ssdWarmUpBytes > 0) {
+    ssdCache_->writeHotSet(hotKeys(opts_.ssdWarmUpBytes));
+  }
   for (auto& shard : shards_) {
     shard->shutdown();
   }
@@ -684,6 +793,169 @@ void AsyncDataCache::shutdown() {
   }
 }
 
+namespace {
+// Bytes loaded by one task of the background SSD warm-up on the SSD executor.
+constexpr uint64_t kSsdWarmUpChunkBytes = 8 << 20;
+} // namespace
+
+void AsyncDataCache::startSsdWarmUp() {
+  auto [promise, future] = folly::makePromiseContract<uint64_t>();
+  ssdWarmUp_ = std::move(future);
+  ssdCache_->executor()->add([this, promise = std::move(promise)]() mutable {
+    std::shared_ptr<SsdWarmUpState> state;
+    try {
+      state = std::make_shared<SsdWarmUpState>(makeSsdWarmUpState(
+          opts_.ssdWarmUpBytes, opts_.ssdWarmUpBytesPerSec));
+    } catch (const std::exception& e) {
+      VELOX_CACHE_LOG(WARNING) << "SSD cache warm-up failed: " << e.what();
+      promise.setValue(0);
+      return;
+    }
+    continueSsdWarmUp(std::move(state), std::move(promise));
+  });
+}
+
+void AsyncDataCache::continueSsdWarmUp(
+    std::shared_ptr<SsdWarmUpState> state,
+    folly::Promise<uint64_t> promise) {
+  bool hasMore;
+  try {
+    hasMore = loadSsdWarmUpEntries(*state, kSsdWarmUpChunkBytes);
+  } catch (const std::exception& e) {
+    VELOX_CACHE_LOG(WARNING) << "SSD cache warm-up failed: " << e.what();
+    hasMore = false;
+  }
+  if (!hasMore) {
+    VELOX_CACHE_LOG(INFO) << "Loaded " << succinctBytes(state->bytesLoaded)
+                          << " from SSD cache in warm-up";
+    promise.setValue(state->bytesLoaded);
+    return;
+  }
+
+  auto* executor = ssdCache_->executor();
+  const auto delayUs = ssdWarmUpDelayUs(*state);
+  auto next = [this, state = std::move(state), promise = std::move(promise)](
+                  auto&&...) mutable {
+    continueSsdWarmUp(std::move(state), std::move(promise));
+  };
+  if (delayUs == 0) {
+    executor->add(std::move(next));
+    return;
+  }
+  // The rate limit is kept by scheduling the next chunk after a delay, not by
+  // sleeping on the executor, which also runs the SSD cache writes.
+  folly::futures::sleep(std::chrono::microseconds(delayUs))
+      .via(executor)
+      .thenValue(std::move(next));
+}
+
+AsyncDataCache::SsdWarmUpState AsyncDataCache::makeSsdWarmUpState(
+    uint64_t maxBytes,
+    uint64_t bytesPerSec) {
+  VELOX_CHECK_NOT_NULL(ssdCache_);
+  SsdWarmUpState state;
+  state.keys = ssdCache_->warmUpKeys(maxBytes);
+  state.maxBytes = maxBytes;
+  state.bytesPerSec = bytesPerSec;
+  state.startTimeUs = getCurrentTimeMicro();
+  return state;
+}
+
+bool AsyncDataCache::loadSsdWarmUpEntries(
+    SsdWarmUpState& state,
+    uint64_t maxBytes) {
+  const auto endBytes = std::min(state.maxBytes, state.bytesLoaded + maxBytes);
+  while (state.nextKey < state.keys.size()) {
+    if (stopSsdWarmUp_ || state.bytesLoaded >= state.maxBytes) {
+      return false;
+    }
+    if (state.bytesLoaded >= endBytes) {
+      return true;
+    }
+    const auto& key = state.keys[state.nextKey++];
+    const RawFileCacheKey rawKey{key.fileNum.id(), key.offset};
+    auto& ssdFile = ssdCache_->file(rawKey.fileNum);
+    std::vector<SsdPin> ssdPins;
+    ssdPins.push_back(ssdFile.find(rawKey));
+    if (ssdPins.back().empty()) {
+      continue;
+    }
+    std::vector<CachePin> pins;
+    try {
+      pins.push_back(
+          findOrCreate(rawKey, ssdPins.back().run().entrySize(), nullptr));
+      if (pins.back().empty() || !pins.back().entry()->isExclusive()) {
+        continue;
+      }
+      ssdFile.load(ssdPins, pins);
+    } catch (const std::exception& e) {
+      // Typically out of cache space. The entry is dropped with its pin.
+      VELOX_CACHE_LOG(WARNING)
+          << "Stopping SSD cache warm-up after error: " << e.what();
+      return false;
+    }
+    auto* entry = pins.back().checkedEntry();
+    entry->setPrefetch();
+    entry->setExclusiveToShared(false);
+    state.bytesLoaded += entry->size();
+  }
+  return false;
+}
+
+// static
+uint64_t AsyncDataCache::ssdWarmUpDelayUs(const SsdWarmUpState& state) {
+  if (state.bytesPerSec == 0) {
+    return 0;
+  }
+  const uint64_t targetUs = state.bytesLoaded * 1'000'000 / state.bytesPerSec;
+  const uint64_t elapsedUs = getCurrentTimeMicro() - state.startTimeUs;
+  return targetUs > elapsedUs ? targetUs - elapsedUs : 0;
+}
+
+uint64_t AsyncDataCache::warmUpFromSsd(
+    uint64_t maxBytes,
+    uint64_t bytesPerSec) {
+  auto state = makeSsdWarmUpState(maxBytes, bytesPerSec);
+  while (loadSsdWarmUpEntries(state, kSsdWarmUpChunkBytes)) {
+    const auto delayUs = ssdWarmUpDelayUs(state);
+    if (delayUs > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(delayUs)); // NOLINT
+    }
+  }
+  VELOX_CACHE_LOG(INFO) << "Loaded " << succinctBytes(state.bytesLoaded)
+                        << " from SSD cache in warm-up";
+  return state.bytesLoaded;
+}
+
+void AsyncDataCache::testingWaitForSsdWarmUp() {
+  if (ssdWarmUp_.valid()) {
+    std::move(ssdWarmUp_).wait();
+  }
+}
+
+std::vector<RawFileCacheKey> AsyncDataCache::hotKeys(uint64_t maxBytes) {
+  std::vector<CacheShard::ScoredKey> scoredKeys;
+  for (auto& shard : shards_) {
+    shard->appendScoredKeys(scoredKeys);
+  }
+  std::sort(
+      scoredKeys.begin(),
+      scoredKeys.end(),
+      [](const auto& left, const auto& right) {
+        return left.score < right.score;
+      });
+  std::vector<RawFileCacheKey> keys;
+  uint64_t bytes = 0;
+  for (const auto& scoredKey : scoredKeys) {
+    if (bytes >= maxBytes) {
+      break;
+    }
+    bytes += scoredKey.size;
+    keys.push_back(scoredKey.key);
+  }
+  return keys;
+}
+
 void CacheShard::shutdown() {
   entries_.clear();
   freeEntries_.clear();
@@ -692,9 +964,10 @@ void CacheShard::shutdown() {
 CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
-    folly::SemiFuture<bool>* wait) {
+    folly::SemiFuture<bool>* wait,
+    const std::shared_ptr<CacheQuota>& quota) {
   const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
-  return shards_[shard]->findOrCreate(key, size, wait);
+  return shards_[shard]->findOrCreate(key, size, wait, quota);
 }
 
 void AsyncDataCache::makeEvictable(RawFileCacheKey key) {
@@ -27,6 +27,7 @@
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CacheQuota.h"
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
@@ -42,6 +43,7 @@ namespace facebook::velox::cache {
   FB_LOG_EVERY_MS(severity, ms) << VELOX_CACHE_LOG_PREFIX
 
 class AsyncDataCache;
+class CachePolicy;
 class CacheShard;
 class SsdCache;
 struct SsdCacheStats;
@@ -253,6 +255,19 @@ class AsyncDataCacheEntry {
     groupId_ = groupId;
   }
 
+  TrackingId trackingId() const {
+    return trackingId_;
+  }
+
+  uint64_t groupId() const {
+    return groupId_;
+  }
+
+  /// The highest priority of the queries that have created or hit 'this'.
+  CachePriority priority() const {
+    return priority_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -335,6 +350,17 @@ class AsyncDataCacheEntry {
   // True if this should be saved to SSD.
   std::atomic<bool> ssdSaveable_{false};
 
+  // True if the CachePolicy of 'shard_' did not admit 'this' and 'this' has
+  // not been hit since. Set and cleared under the shard mutex.
+  bool notAdmitted_{false};
+
+  // Quota of the query that created 'this'. Charged with 'size_' while 'this'
+  // is in the cache. Set and cleared under the shard mutex.
+  std::shared_ptr<CacheQuota> quota_;
+
+  // See priority(). Set under the shard mutex.
+  CachePriority priority_{CachePriority::kNormal};
+
   friend class CacheShard;
   friend class CachePin;
 };
@@ -535,6 +561,14 @@ struct CacheStats {
   /// Sum of scores of evicted entries. This serves to infer an average
   /// lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  /// Number of loaded entries that the CachePolicy did not admit.
+  int64_t numNotAdmitted{0};
+  /// Number of hits on entries that were not admitted. A high ratio of this to
+  /// 'numNotAdmitted' means that the admission is too strict.
+  int64_t numNotAdmittedHit{0};
+
+  /// Name of the CachePolicy of the shards.
+  std::string policy;
 
   /// Ssd cache stats that include both snapshot and cumulative stats.
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
@@ -550,14 +584,20 @@ struct CacheStats {
 /// and other housekeeping.
 class CacheShard {
  public:
-  CacheShard(AsyncDataCache* cache, double maxWriteRatio)
-      : cache_(cache), maxWriteRatio_(maxWriteRatio) {}
+  /// Uses DefaultCachePolicy if 'policy' is nullptr.
+  CacheShard(
+      AsyncDataCache* cache,
+      double maxWriteRatio,
+      std::unique_ptr<CachePolicy> policy = nullptr);
+
+  ~CacheShard();
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
       RawFileCacheKey key,
       uint64_t size,
-      folly::SemiFuture<bool>* readyFuture);
+      folly::SemiFuture<bool>* readyFuture,
+      const std::shared_ptr<CacheQuota>& quota = nullptr);
 
   /// Marks the cache entry with given cache 'key' as immediate evictable.
   void makeEvictable(RawFileCacheKey key);
@@ -573,6 +613,11 @@ class CacheShard {
     return mutex_;
   }
 
+  /// Makes 'entry' immediately evictable if the CachePolicy does not admit it
+  /// or its CacheQuota is exceeded. Called when 'entry' is loaded. Must be
+  /// called inside mutex().
+  void admitLocked(AsyncDataCacheEntry* entry);
+
   /// Release any resources that consume memory from this 'CacheShard' for a
   /// graceful shutdown. The shard will no longer be valid after this call.
   void shutdown();
@@ -599,6 +644,16 @@ class CacheShard {
   /// Adds the stats of 'this' to 'stats'.
   void updateStats(CacheStats& stats);
 
+  /// A cached key with its entry size and retention score.
+  struct ScoredKey {
+    RawFileCacheKey key;
+    int32_t size;
+    int32_t score;
+  };
+
+  /// Appends the keys of the loaded entries of 'this' to 'keys'.
+  void appendScoredKeys(std::vector<ScoredKey>& keys);
+
   /// Appends a batch of non-saved SSD savable entries in 'this' to
   /// 'pins'. This may have to be called several times since this keeps
   /// limits on the batch to write at one time. The savable entries
@@ -626,6 +681,10 @@ class CacheShard {
 
   void calibrateThreshold();
 
+  // Returns the retention score of 'entry' from 'policy_', scaled by the
+  // priority of 'entry'.
+  int32_t scoreLocked(const AsyncDataCacheEntry& entry, AccessTime now) const;
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -642,6 +701,8 @@ class CacheShard {
 
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
+  // Decides admission and eviction order. Accessed under 'mutex_'.
+  const std::unique_ptr<CachePolicy> policy_;
 
   mutable std::mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
@@ -677,6 +738,10 @@ class CacheShard {
   // Cumulative sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Cumulative count of entries not admitted by 'policy_'.
+  uint64_t numNotAdmitted_{0};
+  // Cumulative count of hits on entries not admitted by 'policy_'.
+  uint64_t numNotAdmittedHit_{0};
   // Tracker of cumulative time spent in allocating/freeing MemoryAllocator
   // space for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -710,6 +775,19 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// Makes the admission and eviction policy of each cache shard, e.g.
+    /// TinyLfuCachePolicy. DefaultCachePolicy is used if not set.
+    std::function<std::unique_ptr<CachePolicy>()> policyFactory;
+
+    /// If non-zero and there is an SSD cache, up to this many bytes of the
+    /// hottest SSD cache entries are loaded into memory in the background
+    /// after startup. The memory hot set is recorded at shutdown for the
+    /// warm-up of the next start.
+    uint64_t ssdWarmUpBytes{0};
+
+    /// Max rate of the background warm-up. 0 means unlimited.
+    uint64_t ssdWarmUpBytesPerSec{256 << 20};
   };
 
   AsyncDataCache(
@@ -736,6 +814,18 @@ class AsyncDataCache : public memory::Cache {
   /// shutdown. The cache will no longer be valid after this call.
   void shutdown();
 
+  /// Loads up to 'maxBytes' of SSD cache entries into memory, first the memory
+  /// hot set recorded by the previous shutdown, then the entries of the SSD
+  /// regions with the highest scores. Loads at most 'bytesPerSec' per second
+  /// if non-zero. Returns the number of bytes loaded. The loaded entries are
+  /// marked as prefetched, i.e. their first use is not counted as a hit.
+  /// Waits for the rate limit on the calling thread. The background warm-up
+  /// started by create() waits off the SSD executor instead.
+  uint64_t warmUpFromSsd(uint64_t maxBytes, uint64_t bytesPerSec = 0);
+
+  /// Waits for the background warm-up started by create() to finish.
+  void testingWaitForSsdWarmUp();
+
   /// Calls 'allocate' until this returns true. Returns true if
   /// allocate returns true. and Tries to evict at least 'numPages' of
   /// cache after each failed call to 'allocate'.  May pause to wait
@@ -763,11 +853,14 @@ class AsyncDataCache : public memory::Cache {
   /// future that is realized when the pin is no longer exclusive. When
   /// the future is realized, the caller may retry findOrCreate().
   /// runtime error with code kNoCacheSpace if there is no space to create the
-  /// new entry after evicting any unpinned content.
+  /// new entry after evicting any unpinned content. A new entry is charged to
+  /// 'quota' and gets its priority. A hit raises the priority of the entry to
+  /// that of 'quota'.
   CachePin findOrCreate(
       RawFileCacheKey key,
       uint64_t size,
-      folly::SemiFuture<bool>* waitFuture = nullptr);
+      folly::SemiFuture<bool>* waitFuture = nullptr,
+      const std::shared_ptr<CacheQuota>& quota = nullptr);
 
   /// Marks the cache entry with given cache 'key' as immediate evictable.
   void makeEvictable(RawFileCacheKey key);
@@ -821,14 +914,15 @@ class AsyncDataCache : public memory::Cache {
   /// Looks up a pin for each in 'keys' and skips all loading or loaded pins.
   /// Calls processPin for each exclusive pin. processPin must move its argument
   /// if it wants to use it afterwards. sizeFunc(i) returns the size of the ith
-  /// item in 'keys'.
+  /// item in 'keys'. New entries are charged to 'quota'.
   template <typename SizeFunc, typename ProcessPin>
   void makePins(
       const std::vector<RawFileCacheKey>& keys,
       const SizeFunc& sizeFunc,
-      const ProcessPin& processPin) {
+      const ProcessPin& processPin,
+      const std::shared_ptr<CacheQuota>& quota = nullptr) {
     for (auto i = 0; i < keys.size(); ++i) {
-      auto pin = findOrCreate(keys[i], sizeFunc(i), nullptr);
+      auto pin = findOrCreate(keys[i], sizeFunc(i), nullptr, quota);
       if (pin.empty() || pin.checkedEntry()->isShared()) {
         continue;
       }
@@ -874,6 +968,44 @@ class AsyncDataCache : public memory::Cache {
   // Waits a pseudorandom delay times 'counter'.
   void backoff(int32_t counter);
 
+  // Progress of a warm-up from SSD.
+  struct SsdWarmUpState {
+    std::vector<FileCacheKey> keys;
+    // Index in 'keys' of the next entry to load.
+    size_t nextKey{0};
+    uint64_t maxBytes{0};
+    uint64_t bytesPerSec{0};
+    uint64_t startTimeUs{0};
+    uint64_t bytesLoaded{0};
+  };
+
+  // Starts a warm-up with the options in 'opts_' on the executor of
+  // 'ssdCache_'. The entries are loaded in chunks, one executor task per
+  // chunk.
+  void startSsdWarmUp();
+
+  // Loads a chunk of the background warm-up and schedules the next one on the
+  // executor of 'ssdCache_', after a delay if the rate limit requires it.
+  // Fulfills 'promise' with the loaded bytes when the warm-up is done.
+  void continueSsdWarmUp(
+      std::shared_ptr<SsdWarmUpState> state,
+      folly::Promise<uint64_t> promise);
+
+  SsdWarmUpState makeSsdWarmUpState(uint64_t maxBytes, uint64_t bytesPerSec);
+
+  // Loads the entries of 'state' until 'maxBytes' more are loaded. Returns
+  // false if the warm-up is done: all keys are loaded, 'state.maxBytes' is
+  // reached, the cache shuts down or an entry does not fit.
+  bool loadSsdWarmUpEntries(SsdWarmUpState& state, uint64_t maxBytes);
+
+  // Returns the time to wait before loading more of 'state' to stay within
+  // 'state.bytesPerSec'.
+  static uint64_t ssdWarmUpDelayUs(const SsdWarmUpState& state);
+
+  // Returns the keys of up to 'maxBytes' of the entries with the best
+  // retention scores, best first.
+  std::vector<RawFileCacheKey> hotKeys(uint64_t maxBytes);
+
   const Options opts_;
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
@@ -894,6 +1026,12 @@ class AsyncDataCache : public memory::Cache {
   // Approximate counter tracking new entries that could be saved to SSD.
   tsan_atomic<uint64_t> ssdSaveable_{0};
 
+  // Set at shutdown to stop the background warm-up.
+  std::atomic_bool stopSsdWarmUp_{false};
+  // Completion of the background warm-up. Empty if none was started.
+  folly::SemiFuture<uint64_t> ssdWarmUp_{
+      folly::SemiFuture<uint64_t>::makeEmpty()};
+
   CacheStats stats_;
 
   std::function<void(const AsyncDataCacheEntry&)> verifyHook_;
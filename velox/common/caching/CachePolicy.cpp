@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CachePolicy.h"
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+
+FrequencySketch::FrequencySketch(uint32_t numCounters)
+    : width_(bits::nextPowerOfTwo(std::max<uint32_t>(numCounters, 64))),
+      sampleSize_(10 * width_),
+      counters_(kDepth * width_, 0) {}
+
+void FrequencySketch::increment(uint64_t hash) {
+  bool incremented = false;
+  for (auto row = 0; row < kDepth; ++row) {
+    auto& counter = counters_[index(hash, row)];
+    if (counter < kMaxCount) {
+      ++counter;
+      incremented = true;
+    }
+  }
+  if (incremented && ++numIncrements_ >= sampleSize_) {
+    age();
+  }
+}
+
+uint8_t FrequencySketch::estimate(uint64_t hash) const {
+  uint8_t count = kMaxCount;
+  for (auto row = 0; row < kDepth; ++row) {
+    count = std::min(count, counters_[index(hash, row)]);
+  }
+  return count;
+}
+
+void FrequencySketch::age() {
+  for (auto& counter : counters_) {
+    counter >>= 1;
+  }
+  numIncrements_ /= 2;
+}
+
+void TinyLfuCachePolicy::recordAccess(RawFileCacheKey key) {
+  sketch_.increment(hashKey(key));
+}
+
+bool TinyLfuCachePolicy::admit(const AsyncDataCacheEntry& entry) {
+  // Prefetched entries are loaded ahead of a known use and would be lost
+  // before the use if not admitted.
+  if (entry.isPrefetch()) {
+    return true;
+  }
+  const auto& key = entry.key();
+  return sketch_.estimate(
+             hashKey(RawFileCacheKey{key.fileNum.id(), key.offset})) >=
+      minAdmitFrequency_;
+}
+
+int32_t TinyLfuCachePolicy::score(
+    const AccessStats& stats,
+    uint64_t size,
+    AccessTime now) const {
+  if (!stats.lastUse || stats.numUses > 0) {
+    return stats.score(now, size);
+  }
+  const int64_t score = static_cast<int64_t>(now - stats.lastUse) *
+      kProbationWeight;
+  return std::min<int64_t>(score, std::numeric_limits<int32_t>::max() - 1);
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "velox/common/caching/AsyncDataCache.h"
+
+namespace facebook::velox::cache {
+
+/// Decides which entries of a CacheShard are retained after their first use
+/// and in which order unpinned entries are evicted. Each CacheShard owns its
+/// own instance and calls it under the shard mutex, so implementations do not
+/// need to be thread-safe.
+class CachePolicy {
+ public:
+  virtual ~CachePolicy() = default;
+
+  /// Name used in CacheStats to tell apart the stats of different policies.
+  virtual std::string name() const = 0;
+
+  /// Records a lookup of 'key', whether it is a hit or a miss.
+  virtual void recordAccess(RawFileCacheKey /*key*/) {}
+
+  /// Returns true if 'entry', which has just been loaded, should be retained
+  /// in the cache. An entry that is not admitted is still returned to the
+  /// caller but is the first candidate for eviction once unpinned. A hit
+  /// before the eviction retains it as usual.
+  virtual bool admit(const AsyncDataCacheEntry& /*entry*/) {
+    return true;
+  }
+
+  /// Retention score of an entry with 'stats' and 'size'. A higher number
+  /// means less worth retaining. See AccessStats::score().
+  virtual int32_t score(const AccessStats& stats, uint64_t size, AccessTime now)
+      const {
+    return stats.score(now, size);
+  }
+};
+
+/// The policy of AsyncDataCache if none is configured. Admits every entry and
+/// evicts by AccessStats::score().
+class DefaultCachePolicy : public CachePolicy {
+ public:
+  std::string name() const override {
+    return "default";
+  }
+};
+
+/// Approximate count of accesses per key in a recent window. This is a count
+/// min sketch of 4 bit counters. All counters are halved after a number of
+/// increments proportional to the size, so that old accesses fade out.
+class FrequencySketch {
+ public:
+  /// 'numCounters' is rounded up to a power of 2.
+  explicit FrequencySketch(uint32_t numCounters);
+
+  void increment(uint64_t hash);
+
+  /// Returns the approximate number of increments of 'hash' in the window.
+  /// Never less than the actual number.
+  uint8_t estimate(uint64_t hash) const;
+
+ private:
+  static constexpr int32_t kDepth = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  uint32_t index(uint64_t hash, int32_t row) const {
+    // Double hashing for the row index.
+    const uint64_t step = (hash >> 32) | 1;
+    return row * width_ + ((hash + row * step) & (width_ - 1));
+  }
+
+  // Halves all counters.
+  void age();
+
+  const uint32_t width_;
+  // Increments after which the counters are halved.
+  const uint64_t sampleSize_;
+  std::vector<uint8_t> counters_;
+  uint64_t numIncrements_{0};
+};
+
+/// TinyLFU admission with segmented LRU eviction. A new entry is admitted if
+/// its key has been looked up at least 'minAdmitFrequency' times in the recent
+/// window of the frequency sketch. This keeps one-off scans from flushing the
+/// working set. Entries that have been hit at least once are in the protected
+/// segment and the others in the probation segment. Probation entries age
+/// 'kProbationWeight' times faster.
+class TinyLfuCachePolicy : public CachePolicy {
+ public:
+  /// 'numCounters' is the size of the frequency sketch. This should be a few
+  /// times the number of entries of a shard.
+  explicit TinyLfuCachePolicy(
+      uint32_t numCounters = 1 << 16,
+      uint8_t minAdmitFrequency = 2)
+      : sketch_(numCounters), minAdmitFrequency_(minAdmitFrequency) {}
+
+  std::string name() const override {
+    return "tinylfu";
+  }
+
+  void recordAccess(RawFileCacheKey key) override;
+
+  bool admit(const AsyncDataCacheEntry& entry) override;
+
+  int32_t score(const AccessStats& stats, uint64_t size, AccessTime now)
+      const override;
+
+ private:
+  static constexpr int32_t kProbationWeight = 4;
+
+  static uint64_t hashKey(RawFileCacheKey key) {
+    return std::hash<RawFileCacheKey>()(key);
+  }
+
+  FrequencySketch sketch_;
+  const uint8_t minAdmitFrequency_;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheQuota.h"
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+
+std::string cachePriorityName(CachePriority priority) {
+  switch (priority) {
+    case CachePriority::kLow:
+      return "low";
+    case CachePriority::kNormal:
+      return "normal";
+    case CachePriority::kHigh:
+      return "high";
+  }
+  VELOX_UNREACHABLE();
+}
+
+CachePriority cachePriorityFromName(std::string_view name) {
+  if (name == "low") {
+    return CachePriority::kLow;
+  }
+  if (name == "normal") {
+    return CachePriority::kNormal;
+  }
+  if (name == "high") {
+    return CachePriority::kHigh;
+  }
+  VELOX_USER_FAIL("Invalid cache priority: {}", name);
+}
+
+} // namespace facebook::velox::cache
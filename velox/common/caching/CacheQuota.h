@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace facebook::velox::cache {
+
+/// Priority of the cache entries of a query. Low priority entries are evicted
+/// before normal ones and high priority entries after. File groups read only
+/// by low priority queries are not saved to SSD.
+enum class CachePriority : int8_t { kLow = 0, kNormal = 1, kHigh = 2 };
+
+std::string cachePriorityName(CachePriority priority);
+
+/// Parses "low", "normal" or "high". Throws a user error for other values.
+CachePriority cachePriorityFromName(std::string_view name);
+
+/// AsyncDataCache usage of a query. The cache entries created by the query
+/// share it. Entries that bring the cached bytes of the query to 'maxBytes' or
+/// more are not admitted, i.e. they are returned to the query but are the
+/// first to be evicted once unpinned. Thread-safe.
+class CacheQuota {
+ public:
+  /// 'maxBytes' of 0 means no limit.
+  CacheQuota(CachePriority priority, uint64_t maxBytes)
+      : priority_(priority), maxBytes_(maxBytes) {}
+
+  CachePriority priority() const {
+    return priority_;
+  }
+
+  uint64_t maxBytes() const {
+    return maxBytes_;
+  }
+
+  /// Size of the cache entries created for the query that are still in cache.
+  int64_t usedBytes() const {
+    return usedBytes_;
+  }
+
+  bool exceeded() const {
+    return maxBytes_ > 0 && usedBytes_ >= static_cast<int64_t>(maxBytes_);
+  }
+
+  /// Number of entries not admitted because of exceeding the quota.
+  uint64_t numNotAdmitted() const {
+    return numNotAdmitted_;
+  }
+
+  void add(int64_t bytes) {
+    usedBytes_ += bytes;
+  }
+
+  void incrementNotAdmitted() {
+    ++numNotAdmitted_;
+  }
+
+ private:
+  const CachePriority priority_;
+  const uint64_t maxBytes_;
+  std::atomic<int64_t> usedBytes_{0};
+  std::atomic<uint64_t> numNotAdmitted_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -16,11 +16,18 @@
 
 #pragma once
 
+#include <algorithm>
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/common/caching/CacheQuota.h"
 #include "velox/common/caching/ScanTracker.h"
 
 namespace facebook::velox::cache {
 
-// Dummy implementation of SsdCache admission stats.
+// Dummy implementation of SsdCache admission stats. Only tracks the cache
+// priority of the queries that read each file group.
 class FileGroupStats {
  public:
   // Records ScanTracker::recordReference at group level
@@ -43,9 +50,32 @@ class FileGroupStats {
       uint64_t /*groupId*/,
       int32_t /*numStripes*/) {}
 
+  // Records that a query of 'priority' has loaded data of 'groupId'.
+  void recordPriority(uint64_t groupId, CachePriority priority) {
+    {
+      auto priorities = groupPriorities_.rlock();
+      auto it = priorities->find(groupId);
+      if (it != priorities->end() && it->second >= priority) {
+        return;
+      }
+    }
+    auto priorities = groupPriorities_.wlock();
+    auto& groupPriority =
+        priorities->try_emplace(groupId, priority).first->second;
+    groupPriority = std::max(groupPriority, priority);
+  }
+
+  // Returns the highest priority recorded for 'groupId' or kNormal if none.
+  CachePriority groupPriority(uint64_t groupId) const {
+    auto priorities = groupPriorities_.rlock();
+    auto it = priorities->find(groupId);
+    return it == priorities->end() ? CachePriority::kNormal : it->second;
+  }
+
   // Returns true if groupId, trackingId qualify the data to be cached to SSD.
-  bool shouldSaveToSsd(uint64_t /*groupId*/, TrackingId /*trackingId*/) const {
-    return true;
+  // Groups read only by low priority queries are not saved.
+  bool shouldSaveToSsd(uint64_t groupId, TrackingId /*trackingId*/) const {
+    return groupPriority(groupId) != CachePriority::kLow;
   }
 
   // Updates the SSD selection criteria. 'ssdsize' is the capacity,
@@ -58,6 +88,10 @@ class FileGroupStats {
   std::string toString(uint64_t /*cacheBytes*/) {
     return "<dummy FileGroupStats>";
   }
+
+ private:
+  folly::Synchronized<folly::F14FastMap<uint64_t, CachePriority>>
+      groupPriorities_;
 };
 
 } // namespace facebook::velox::cache
@@ -22,7 +22,9 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <numeric>
 
 using facebook::velox::common::testutil::TestValue;
@@ -66,7 +68,8 @@ SsdCache::SsdCache(const Config& config)
         config.disableFileCow,
         config.checksumEnabled,
         checksumReadVerificationEnabled,
-        executor_);
+        executor_,
+        config.compressionKind);
     files_.push_back(std::make_unique<SsdFile>(fileConfig));
   }
 }
@@ -185,6 +188,89 @@ std::string SsdCache::toString() const {
   return out.str();
 }
 
+void SsdCache::writeHotSet(const std::vector<RawFileCacheKey>& keys) {
+  const auto path = hotSetFilePath();
+  std::ofstream out(
+      path,
+      std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!out.is_open()) {
+    VELOX_SSD_CACHE_LOG(WARNING) << "Failed to open hot set file " << path;
+    return;
+  }
+  out.write(kHotSetMagic, strlen(kHotSetMagic));
+  for (const auto& key : keys) {
+    const auto name = fileIds().string(key.fileNum);
+    if (name.empty()) {
+      continue;
+    }
+    const int32_t nameSize = name.size();
+    out.write(reinterpret_cast<const char*>(&nameSize), sizeof(nameSize));
+    out.write(name.data(), nameSize);
+    out.write(reinterpret_cast<const char*>(&key.offset), sizeof(key.offset));
+  }
+  out.close();
+  if (out.fail()) {
+    VELOX_SSD_CACHE_LOG(WARNING) << "Failed to write hot set file " << path;
+    std::filesystem::remove(path);
+    return;
+  }
+  VELOX_SSD_CACHE_LOG(INFO) << "Recorded " << keys.size()
+                            << " keys in hot set file " << path;
+}
+
+std::vector<FileCacheKey> SsdCache::readHotSet() const {
+  std::vector<FileCacheKey> keys;
+  std::ifstream in(
+      hotSetFilePath(), std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open()) {
+    return keys;
+  }
+  char magic[4];
+  in.read(magic, sizeof(magic));
+  if (!in.good() || strncmp(magic, kHotSetMagic, sizeof(magic)) != 0) {
+    VELOX_SSD_CACHE_LOG(WARNING)
+        << "Ignoring invalid hot set file " << hotSetFilePath();
+    return keys;
+  }
+  std::string name;
+  for (;;) {
+    int32_t nameSize;
+    in.read(reinterpret_cast<char*>(&nameSize), sizeof(nameSize));
+    // No valid file has names longer than a page.
+    if (!in.good() || nameSize <= 0 || nameSize > 4096) {
+      break;
+    }
+    name.resize(nameSize);
+    in.read(name.data(), nameSize);
+    uint64_t offset;
+    in.read(reinterpret_cast<char*>(&offset), sizeof(offset));
+    if (!in.good()) {
+      break;
+    }
+    keys.push_back(FileCacheKey{StringIdLease(fileIds(), name), offset});
+  }
+  return keys;
+}
+
+std::vector<FileCacheKey> SsdCache::warmUpKeys(uint64_t maxBytes) {
+  std::vector<FileCacheKey> keys;
+  folly::F14FastSet<RawFileCacheKey> seen;
+  auto addKey = [&](FileCacheKey& key) {
+    if (seen.insert(RawFileCacheKey{key.fileNum.id(), key.offset}).second) {
+      keys.push_back(std::move(key));
+    }
+  };
+  for (auto& key : readHotSet()) {
+    addKey(key);
+  }
+  for (auto& file : files_) {
+    for (auto& key : file->hotKeys(maxBytes / numShards_)) {
+      addKey(key);
+    }
+  }
+  return keys;
+}
+
 void SsdCache::shutdown() {
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -214,6 +300,7 @@ void SsdCache::testingDeleteFiles() {
   for (auto& file : files_) {
     file->testingDeleteFile();
   }
+  std::filesystem::remove(hotSetFilePath());
 }
 
 void SsdCache::testingDeleteCheckpoints() {
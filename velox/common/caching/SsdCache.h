@@ -37,7 +37,9 @@ class SsdCache {
         uint64_t _checkpointIntervalBytes = 0,
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
-        bool _checksumReadVerificationEnabled = false)
+        bool _checksumReadVerificationEnabled = false,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -45,7 +47,8 @@ class SsdCache {
           disableFileCow(_disableFileCow),
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          compressionKind(_compressionKind){};
 
     std::string filePrefix;
     uint64_t maxBytes;
@@ -67,15 +70,20 @@ class SsdCache {
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
 
+    /// Compression of the entries written to SSD, e.g. LZ4 or ZSTD. Entries
+    /// that do not get smaller are stored uncompressed.
+    common::CompressionKind compressionKind{common::CompressionKind_NONE};
+
     std::string toString() const {
       return fmt::format(
-          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
+          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}, compression {}",
           numShards,
           succinctBytes(maxBytes),
           succinctBytes(checkpointIntervalBytes),
           (disableFileCow ? "DISABLED" : "ENABLED"),
           (checksumEnabled ? "ENABLED" : "DISABLED"),
-          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"));
+          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"),
+          common::compressionKindToString(compressionKind));
     }
   };
 
@@ -134,6 +142,20 @@ class SsdCache {
     return *groupStats_;
   }
 
+  folly::Executor* executor() const {
+    return executor_;
+  }
+
+  /// Records 'keys', the hot set of the memory cache, in a file next to the
+  /// cache files. Read by warmUpKeys() after a restart.
+  void writeHotSet(const std::vector<RawFileCacheKey>& keys);
+
+  /// Returns the keys to load for a warm-up of the memory cache. These are the
+  /// keys recorded by writeHotSet() followed by up to 'maxBytes' of the keys
+  /// in the hottest regions of each shard. There are no duplicates. The keys
+  /// may have been evicted since.
+  std::vector<FileCacheKey> warmUpKeys(uint64_t maxBytes);
+
   /// Stops writing to the cache files and waits for pending writes to finish.
   /// If checkpointing is on, makes a checkpoint.
   void shutdown();
@@ -162,11 +184,22 @@ class SsdCache {
   void testingWaitForWriteToFinish();
 
  private:
+  // Magic number at the start of the hot set file.
+  static constexpr const char* kHotSetMagic = "HOT1";
+
   void checkNotShutdownLocked() {
     VELOX_CHECK(
         !shutdown_, "Unexpected write after SSD cache has been shutdown");
   }
 
+  std::string hotSetFilePath() const {
+    return filePrefix_ + ".hotset";
+  }
+
+  // Returns the keys recorded by writeHotSet(). Returns an empty vector if
+  // there is no hot set file or the file is not valid.
+  std::vector<FileCacheKey> readHotSet() const;
+
   const std::string filePrefix_;
   const int32_t numShards_;
   // Stats for selecting entries to save from AsyncDataCache.
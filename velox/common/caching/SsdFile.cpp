@@ -17,12 +17,15 @@
 #include "velox/common/caching/SsdFile.h"
 
 #include <folly/Executor.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/process/TraceContext.h"
 
 #include <fcntl.h>
@@ -83,6 +86,58 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
   }
 }
 
+// Returns an IOBuf chain over the data of 'entry' without copying.
+std::unique_ptr<folly::IOBuf> wrapEntry(const AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    return folly::IOBuf::wrapBuffer(entry.tinyData(), entry.size());
+  }
+  std::unique_ptr<folly::IOBuf> chain;
+  const auto& data = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = data.runAt(i);
+    const auto size = std::min<int64_t>(bytesLeft, run.numBytes());
+    auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), size);
+    if (chain == nullptr) {
+      chain = std::move(buffer);
+    } else {
+      chain->prependChain(std::move(buffer));
+    }
+    bytesLeft -= size;
+  }
+  return chain;
+}
+
+// Returns the data of 'entry' compressed with 'codec' or nullptr if this does
+// not make it smaller.
+std::unique_ptr<folly::IOBuf> compressEntry(
+    const AsyncDataCacheEntry& entry,
+    folly::io::Codec& codec) {
+  auto compressed = codec.compress(wrapEntry(entry).get());
+  if (compressed->computeChainDataLength() >= entry.size()) {
+    return nullptr;
+  }
+  compressed->coalesce();
+  return compressed;
+}
+
+// Copies 'data' into the memory of 'entry'.
+void copyToEntry(const folly::IOBuf& data, AsyncDataCacheEntry& entry) {
+  folly::io::Cursor cursor(&data);
+  if (entry.tinyData() != nullptr) {
+    cursor.pull(entry.tinyData(), entry.size());
+    return;
+  }
+  const auto& allocation = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < allocation.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = allocation.runAt(i);
+    const auto size = std::min<int64_t>(bytesLeft, run.numBytes());
+    cursor.pull(run.data<char>(), size);
+    bytesLeft -= size;
+  }
+}
+
 // Returns the number of entries in a cache 'entry'.
 uint32_t numIoVectorsFromEntry(AsyncDataCacheEntry& entry) {
   if (entry.tinyData() != nullptr) {
@@ -134,6 +189,7 @@ SsdFile::SsdFile(const Config& config)
       checksumEnabled_(config.checksumEnabled),
       checksumReadVerificationEnabled_(
           config.checksumEnabled && config.checksumReadVerificationEnabled),
+      compressionKind_(config.compressionKind),
       shardId_(config.shardId),
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
       executor_(config.executor) {
@@ -157,6 +213,10 @@ SsdFile::SsdFile(const Config& config)
   if (disableFileCow_) {
     disableCow(fd_);
   }
+  if (compressionKind_ != common::CompressionKind_NONE) {
+    // Throws if the compression kind is not supported.
+    common::compressionKindToCodec(compressionKind_);
+  }
 
   readFile_ = std::make_unique<LocalReadFile>(fd_);
   const uint64_t size = lseek(fd_, 0, SEEK_END);
@@ -232,11 +292,11 @@ CoalesceIoStats SsdFile::load(
   for (auto i = 0; i < pins.size(); ++i) {
     const auto runSize = ssdPins[i].run().size();
     auto* entry = pins[i].checkedEntry();
-    if (FOLLY_UNLIKELY(runSize < entry->size())) {
+    if (FOLLY_UNLIKELY(ssdPins[i].run().entrySize() < entry->size())) {
       ++stats_.readSsdErrors;
       VELOX_FAIL(
           "IOERR: SSD cache cache entry {} short than requested range {}",
-          succinctBytes(runSize),
+          succinctBytes(ssdPins[i].run().entrySize()),
           succinctBytes(entry->size()));
     }
     totalPayloadBytes += entry->size();
@@ -245,30 +305,83 @@ CoalesceIoStats SsdFile::load(
     stats_.bytesRead += entry->size();
   }
 
+  // Compressed entries are read and decompressed one by one. The others are
+  // read with coalesced IO.
+  const bool hasCompressed = std::any_of(
+      ssdPins.begin(), ssdPins.end(), [](const SsdPin& ssdPin) {
+        return ssdPin.run().compressed();
+      });
+  std::vector<CachePin> uncompressedPins;
+  std::vector<uint64_t> uncompressedOffsets;
+  CoalesceIoStats compressedStats;
+  if (hasCompressed) {
+    for (auto i = 0; i < pins.size(); ++i) {
+      const auto run = ssdPins[i].run();
+      if (run.compressed()) {
+        loadCompressed(run, *pins[i].checkedEntry());
+        ++compressedStats.numIos;
+        compressedStats.payloadBytes += pins[i].checkedEntry()->size();
+      } else {
+        uncompressedPins.push_back(pins[i]);
+        uncompressedOffsets.push_back(run.offset());
+      }
+    }
+  }
+  const auto& pinsToRead = hasCompressed ? uncompressedPins : pins;
+
+  // With io_uring, the coalesced reads are collected and submitted together
+  // after readPins() returns.
+  auto* ioUring = IoUring::instance();
+  std::vector<IoUring::Read> ioUringReads;
+
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
-  const auto stats = readPins(
-      pins,
-      totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
-      // Max ranges in one preadv call. Longest gap + longest cache entry are
-      // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
-      // of 1000 is safe.
-      900,
-      [&](int32_t index) { return ssdPins[index].run().offset(); },
-      [&](const std::vector<CachePin>& /*pins*/,
-          int32_t /*begin*/,
-          int32_t /*end*/,
-          uint64_t offset,
-          const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
-      });
+  CoalesceIoStats stats;
+  if (!pinsToRead.empty()) {
+    stats = readPins(
+        pinsToRead,
+        totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
+        // Max ranges in one preadv call. Longest gap + longest cache entry
+        // are under 12 ranges. If a system has a limit of 1K ranges, coalesce
+        // limit of 1000 is safe.
+        900,
+        [&](int32_t index) {
+          return hasCompressed ? uncompressedOffsets[index]
+                               : ssdPins[index].run().offset();
+        },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          if (ioUring != nullptr) {
+            ioUringReads.push_back({fd_, offset, buffers});
+          } else {
+            read(offset, buffers);
+          }
+        });
+  }
+  stats.numIos += compressedStats.numIos;
+  stats.payloadBytes += compressedStats.payloadBytes;
+
+  if (!ioUringReads.empty()) {
+    process::TraceContext trace("SsdFile::read");
+    auto results =
+        folly::collectAll(ioUring->preadv(std::move(ioUringReads))).get();
+    for (auto& result : results) {
+      if (result.hasException()) {
+        ++stats_.readSsdErrors;
+        result.throwUnlessValue();
+      }
+    }
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
     auto* entry = pins[i].checkedEntry();
     auto ssdRun = ssdPins[i].run();
-    if (ssdRun.size() == entry->size()) {
+    if (ssdRun.entrySize() == entry->size()) {
       maybeVerifyChecksum(*entry, ssdRun);
     }
   }
@@ -282,8 +395,31 @@ void SsdFile::read(
   readFile_->preadv(offset, buffers);
 }
 
+void SsdFile::loadCompressed(const SsdRun& run, AsyncDataCacheEntry& entry) {
+  process::TraceContext trace("SsdFile::loadCompressed");
+  auto compressed = folly::IOBuf::create(run.size());
+  readFile_->pread(run.offset(), run.size(), compressed->writableData());
+  compressed->append(run.size());
+  std::unique_ptr<folly::IOBuf> uncompressed;
+  try {
+    uncompressed = common::compressionKindToCodec(compressionKind_)
+                       ->uncompress(compressed.get(), run.uncompressedSize());
+  } catch (const std::exception& e) {
+    ++stats_.readSsdCorruptions;
+    VELOX_FAIL(
+        "IOERR: Corrupt compressed SSD cache entry - File: {}, Offset: {}, Size: {}: {}",
+        fileName_,
+        run.offset(),
+        run.size(),
+        e.what());
+  }
+  VELOX_CHECK_EQ(
+      uncompressed->computeChainDataLength(), run.uncompressedSize());
+  copyToEntry(*uncompressed, entry);
+}
+
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<uint32_t>& entrySizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -298,13 +434,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < entrySizes.size(); ++next) {
+      if (entrySizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= entrySizes[next];
+      toWrite += entrySizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -379,14 +514,27 @@ void SsdFile::write(std::vector<CachePin>& pins) {
   // Sorts the pins by their file/offset. In this way what is adjacent in
   // storage is likely adjacent on SSD.
   std::sort(pins.begin(), pins.end());
-  for (const auto& pin : pins) {
-    auto* entry = pin.checkedEntry();
+  // The compressed data of 'pins', nullptr for entries stored uncompressed,
+  // and the sizes of the entries on SSD.
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed(pins.size());
+  std::vector<uint32_t> entrySizes(pins.size());
+  // Codecs are not thread safe, so each write makes its own.
+  auto codec = compressionKind_ != common::CompressionKind_NONE
+      ? common::compressionKindToCodec(compressionKind_)
+      : nullptr;
+  for (auto i = 0; i < pins.size(); ++i) {
+    auto* entry = pins[i].checkedEntry();
     VELOX_CHECK_NULL(entry->ssdFile());
+    if (codec != nullptr) {
+      compressed[i] = compressEntry(*entry, *codec);
+    }
+    entrySizes[i] = compressed[i] != nullptr ? compressed[i]->length()
+                                             : entry->size();
   }
 
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
-    auto space = getSpace(pins, writeIndex);
+    auto space = getSpace(entrySizes, writeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       ++stats_.writeSsdDropped;
@@ -400,8 +548,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     std::vector<iovec> writeIovecs;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      const auto numIovecs = numIoVectorsFromEntry(*entry);
+      const auto entrySize = entrySizes[i];
+      const auto numIovecs =
+          compressed[i] != nullptr ? 1 : numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
         // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
@@ -418,7 +567,12 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       if (writeLength + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, writeIovecs);
+      if (compressed[i] != nullptr) {
+        writeIovecs.push_back(
+            {compressed[i]->writableData(), compressed[i]->length()});
+      } else {
+        addEntryToIovecs(*entry, writeIovecs);
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
@@ -440,16 +594,24 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto* entry = pins[i].checkedEntry();
         VELOX_CHECK_NULL(entry->ssdFile());
         entry->setSsdFile(this, offset);
-        const auto size = entry->size();
+        const auto size = entrySizes[i];
+        const uint32_t uncompressedSize =
+            compressed[i] != nullptr ? entry->size() : 0;
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
         uint32_t checksum = 0;
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
+        const SsdRun run(offset, size, checksum, uncompressedSize);
+        entries_[std::move(key)] = run;
         if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size, checksum));
+          verifyWrite(*entry, run);
+        }
+        if (run.compressed()) {
+          ++stats_.entriesCompressed;
+          stats_.bytesCompressedFrom += uncompressedSize;
+          stats_.bytesCompressedTo += size;
         }
         offset += size;
         ++stats_.entriesWritten;
@@ -496,8 +658,22 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   process::TraceContext trace("SsdFile::verifyWrite");
   auto testData = std::make_unique<char[]>(entry.size());
-  const auto rc = ::pread(fd_, testData.get(), entry.size(), ssdRun.offset());
-  VELOX_CHECK_EQ(rc, entry.size());
+  if (ssdRun.compressed()) {
+    auto compressed = folly::IOBuf::create(ssdRun.size());
+    const auto rc = ::pread(
+        fd_, compressed->writableData(), ssdRun.size(), ssdRun.offset());
+    VELOX_CHECK_EQ(rc, ssdRun.size());
+    compressed->append(ssdRun.size());
+    auto uncompressed =
+        common::compressionKindToCodec(compressionKind_)
+            ->uncompress(compressed.get(), ssdRun.uncompressedSize());
+    VELOX_CHECK_EQ(uncompressed->computeChainDataLength(), entry.size());
+    folly::io::Cursor(uncompressed.get()).pull(testData.get(), entry.size());
+  } else {
+    const auto rc =
+        ::pread(fd_, testData.get(), entry.size(), ssdRun.offset());
+    VELOX_CHECK_EQ(rc, entry.size());
+  }
   if (entry.tinyData() != nullptr) {
     if (::memcmp(testData.get(), entry.tinyData(), entry.size()) != 0) {
       VELOX_FAIL("bad read back");
@@ -521,6 +697,33 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   }
 }
 
+std::vector<FileCacheKey> SsdFile::hotKeys(uint64_t maxBytes) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  const auto scores = tracker_.copyScores();
+  std::vector<std::vector<const FileCacheKey*>> regionKeys(numRegions_);
+  for (const auto& [key, run] : entries_) {
+    regionKeys[regionIndex(run.offset())].push_back(&key);
+  }
+  std::vector<int32_t> regions(numRegions_);
+  std::iota(regions.begin(), regions.end(), 0);
+  std::sort(regions.begin(), regions.end(), [&](int32_t left, int32_t right) {
+    return scores[left] > scores[right];
+  });
+
+  std::vector<FileCacheKey> keys;
+  uint64_t bytes = 0;
+  for (const auto region : regions) {
+    for (const auto* key : regionKeys[region]) {
+      if (bytes >= maxBytes) {
+        return keys;
+      }
+      bytes += entries_.at(*key).entrySize();
+      keys.push_back(*key);
+    }
+  }
+  return keys;
+}
+
 void SsdFile::updateStats(SsdCacheStats& stats) const {
   // Lock only in tsan build. Incrementing the counters has no synchronized
   // semantics.
@@ -552,6 +755,9 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.writeCheckpointErrors += stats_.writeCheckpointErrors;
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
+  stats.entriesCompressed += stats_.entriesCompressed;
+  stats.bytesCompressedFrom += stats_.bytesCompressedFrom;
+  stats.bytesCompressedTo += stats_.bytesCompressedTo;
 }
 
 void SsdFile::testingClear() {
@@ -754,14 +960,23 @@ void SsdFile::checkpoint(bool force) {
       state.open(checkpointPath, std::ios_base::out | std::ios_base::trunc);
       // The checkpoint state file contains:
       // int32_t The 4 bytes of checkpoint version,
+      // int32_t compression kind if the version has compression,
       // int32_t maxRegions,
       // int32_t numRegions,
       // regionScores from the 'tracker_',
       // {fileId, fileName} pairs,
       // kMapMarker,
-      // {fileId, offset, SSdRun} triples,
+      // {fileId, offset, SSdRun} triples, followed by the uncompressed size
+      // if the version has compression,
       // kEndMarker.
-      state.write(checkpointVersion().data(), sizeof(int32_t));
+      const auto version = checkpointVersion();
+      const bool hasCompression =
+          isCompressionEnabledOnCheckpointVersion(version);
+      state.write(version.data(), sizeof(int32_t));
+      if (hasCompression) {
+        const int32_t compressionKind = compressionKind_;
+        state.write(asChar(&compressionKind), sizeof(compressionKind));
+      }
       state.write(asChar(&maxRegions_), sizeof(maxRegions_));
       state.write(asChar(&numRegions_), sizeof(numRegions_));
 
@@ -792,6 +1007,10 @@ void SsdFile::checkpoint(bool force) {
           const auto checksum = pair.second.checksum();
           state.write(asChar(&checksum), sizeof(checksum));
         }
+        if (hasCompression) {
+          const auto uncompressedSize = pair.second.uncompressedSize();
+          state.write(asChar(&uncompressedSize), sizeof(uncompressedSize));
+        }
       }
     } catch (const std::exception& e) {
       fileSync->close();
@@ -964,6 +1183,22 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
         shardId_);
     return;
   }
+  // Checkpoints without compression have only uncompressed entries, which
+  // can be read with any compression setting.
+  const auto checkpointHasCompression =
+      isCompressionEnabledOnCheckpointVersion(std::string(versionMagic, 4));
+  if (checkpointHasCompression) {
+    const auto compressionKind = readNumber<int32_t>(state);
+    if (compressionKind != compressionKind_) {
+      VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+          "Starting shard {} without checkpoint: the checkpoint was made with compression {} but compression is {}.",
+          shardId_,
+          common::compressionKindToString(
+              static_cast<common::CompressionKind>(compressionKind)),
+          common::compressionKindToString(compressionKind_));
+      return;
+    }
+  }
 
   const auto maxRegions = readNumber<int32_t>(state);
   VELOX_CHECK_EQ(
@@ -1005,7 +1240,11 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     if (checkpoinHasChecksum) {
       checksum = readNumber<uint32_t>(state);
     }
-    const auto run = SsdRun(fileBits, checksum);
+    uint32_t uncompressedSize = 0;
+    if (checkpointHasCompression) {
+      uncompressedSize = readNumber<uint32_t>(state);
+    }
+    const auto run = SsdRun(fileBits, checksum, uncompressedSize);
     // Check that the recovered entry does not fall in an evicted region.
     if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
       // The file may have a different id on restore.
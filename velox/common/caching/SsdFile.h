@@ -18,6 +18,7 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 
 #include <gflags/gflags.h>
@@ -29,21 +30,32 @@ namespace facebook::velox::cache {
 
 /// A 64 bit word describing a SSD cache entry in an SsdFile. The low 23 bits
 /// are the size, for a maximum entry size of 8MB. The high bits are the offset.
+/// The size is the number of bytes on SSD. If the entry is stored compressed,
+/// 'uncompressedSize' is the size of the cache entry, otherwise it is 0.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
   SsdRun() : fileBits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum)
-      : fileBits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      uint32_t checksum,
+      uint32_t uncompressedSize = 0)
+      : fileBits_((offset << kSizeBits) | ((size - 1))),
+        checksum_(checksum),
+        uncompressedSize_(uncompressedSize) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_NE(size, 0);
     VELOX_CHECK_LE(size, 1 << kSizeBits);
+    VELOX_CHECK_LE(uncompressedSize, 1 << kSizeBits);
   }
 
-  SsdRun(uint64_t fileBits, uint32_t checksum)
-      : fileBits_(fileBits), checksum_(checksum) {}
+  SsdRun(uint64_t fileBits, uint32_t checksum, uint32_t uncompressedSize = 0)
+      : fileBits_(fileBits),
+        checksum_(checksum),
+        uncompressedSize_(uncompressedSize) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
@@ -51,10 +63,12 @@ class SsdRun {
   void operator=(const SsdRun& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    uncompressedSize_ = other.uncompressedSize_;
   }
   void operator=(SsdRun&& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    uncompressedSize_ = other.uncompressedSize_;
   }
 
   uint64_t offset() const {
@@ -70,6 +84,22 @@ class SsdRun {
     return checksum_;
   }
 
+  /// Returns true if the entry is stored compressed.
+  bool compressed() const {
+    return uncompressedSize_ != 0;
+  }
+
+  /// Returns the size of the uncompressed entry if the entry is compressed, 0
+  /// otherwise.
+  uint32_t uncompressedSize() const {
+    return uncompressedSize_;
+  }
+
+  /// Returns the size of the cache entry after decompression, if any.
+  uint32_t entrySize() const {
+    return compressed() ? uncompressedSize_ : size();
+  }
+
   /// Returns raw bits for offset and size for serialization.
   uint64_t fileBits() const {
     return fileBits_;
@@ -79,6 +109,7 @@ class SsdRun {
   // Contains the file offset and size.
   uint64_t fileBits_;
   uint32_t checksum_;
+  uint32_t uncompressedSize_{0};
 };
 
 /// Represents an SsdFile entry that is planned for load or being loaded. This
@@ -162,6 +193,9 @@ struct SsdCacheStats {
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
     readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
+    bytesCompressedFrom = tsanAtomicValue(other.bytesCompressedFrom);
+    bytesCompressedTo = tsanAtomicValue(other.bytesCompressedTo);
   }
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
@@ -190,6 +224,10 @@ struct SsdCacheStats {
     result.readSsdErrors = readSsdErrors - other.readSsdErrors;
     result.readCheckpointErrors =
         readCheckpointErrors - other.readCheckpointErrors;
+    result.entriesCompressed = entriesCompressed - other.entriesCompressed;
+    result.bytesCompressedFrom =
+        bytesCompressedFrom - other.bytesCompressedFrom;
+    result.bytesCompressedTo = bytesCompressedTo - other.bytesCompressedTo;
     return result;
   }
 
@@ -220,6 +258,11 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdCorruptions{0};
+  /// Number of entries written compressed and their sizes before and after
+  /// compression.
+  tsan_atomic<uint64_t> entriesCompressed{0};
+  tsan_atomic<uint64_t> bytesCompressedFrom{0};
+  tsan_atomic<uint64_t> bytesCompressedTo{0};
 };
 
 /// A shard of SsdCache. Corresponds to one file on SSD. The data backed by each
@@ -239,7 +282,9 @@ class SsdFile {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -248,7 +293,8 @@ class SsdFile {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          compressionKind(_compressionKind){};
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -274,6 +320,10 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
+
+    /// Compression of the entries written to SSD. Entries that do not get
+    /// smaller are stored uncompressed.
+    common::CompressionKind compressionKind;
   };
 
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
@@ -334,6 +384,12 @@ class SsdFile {
   /// Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
+  /// Returns the keys of cached entries in descending order of the score of
+  /// their region, up to 'maxBytes' worth of uncompressed entry size. The
+  /// scores survive restarts through the checkpoint. Used for warming up the
+  /// memory cache.
+  std::vector<FileCacheKey> hotKeys(uint64_t maxBytes) const;
+
   /// Remove cached entries of files in the fileNum set 'filesToRemove'. If
   /// successful, return true, and 'filesRetained' contains entries that should
   /// not be removed, ex., from pinned regions. Otherwise, return false and
@@ -406,8 +462,13 @@ class SsdFile {
   static constexpr int kMaxErasedSizePct = 50;
 
   // The first 4 bytes of a checkpoint file contains version string to indicate
-  // if checksum write is enabled or not.
+  // if checksum write and compression are enabled or not. Checkpoints with
+  // compression have the compression kind after the version and the
+  // uncompressed size after each entry.
   std::string checkpointVersion() const {
+    if (compressionKind_ != common::CompressionKind_NONE) {
+      return checksumEnabled_ ? "CPT4" : "CPT3";
+    }
     return checksumEnabled_ ? "CPT2" : "CPT1";
   }
 
@@ -422,9 +483,12 @@ class SsdFile {
   // if there is no space. The space does not necessarily cover all the pins, so
   // multiple calls starting at the first unwritten pin may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<uint32_t>& entrySizes,
       int32_t begin);
 
+  // Reads the compressed 'run' and decompresses it into 'entry'.
+  void loadCompressed(const SsdRun& run, AsyncDataCacheEntry& entry);
+
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
@@ -487,7 +551,13 @@ class SsdFile {
   // Returns true if checksum write is enabled for the given version.
   static bool isChecksumEnabledOnCheckpointVersion(
       const std::string& checkpointVersion) {
-    return checkpointVersion == "CPT2";
+    return checkpointVersion == "CPT2" || checkpointVersion == "CPT4";
+  }
+
+  // Returns true if compression is enabled for the given version.
+  static bool isCompressionEnabledOnCheckpointVersion(
+      const std::string& checkpointVersion) {
+    return checkpointVersion == "CPT3" || checkpointVersion == "CPT4";
   }
 
   static constexpr const char* kLogExtension = ".log";
@@ -508,6 +578,9 @@ class SsdFile {
   // If true, checksum read verification from SSD is enabled.
   const bool checksumReadVerificationEnabled_;
 
+  // Compression of the entries written to SSD.
+  const common::CompressionKind compressionKind_;
+
   // Shard index within 'cache_'.
   const int32_t shardId_;
 
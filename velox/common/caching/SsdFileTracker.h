@@ -76,7 +76,7 @@ class SsdFileTracker {
   /// Exports a copy of the scores. Tsan will report an error if a
   /// pointer to atomics is passed to write(). Therefore copy the
   /// atomics into non-atomics before writing.
-  std::vector<double> copyScores() {
+  std::vector<double> copyScores() const {
     std::vector<double> scores(regionScores_.size());
     for (auto i = 0; i < scores.size(); ++i) {
       scores[i] = tsanAtomicValue(regionScores_[i]);
@@ -19,35 +19,38 @@
 namespace facebook::velox {
 
 uint64_t StringIdMap::id(std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = stringToId_.find(string);
-  if (it != stringToId_.end()) {
+  auto& shard = this->shard(string);
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto it = shard.stringToId.find(string);
+  if (it != shard.stringToId.end()) {
     return it->second;
   }
   return kNoId;
 }
 
 void StringIdMap::release(uint64_t id) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = idToEntry_.find(id);
-  if (it != idToEntry_.end()) {
+  auto& shard = this->shard(id);
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto it = shard.idToEntry.find(id);
+  if (it != shard.idToEntry.end()) {
     VELOX_CHECK_LT(
         0, it->second.numInUse, "Extra release of id in StringIdMap");
     if (--it->second.numInUse == 0) {
       pinnedSize_ -= it->second.string.size();
-      auto strIter = stringToId_.find(it->second.string);
-      VELOX_DCHECK(strIter != stringToId_.end());
-      stringToId_.erase(strIter);
-      idToEntry_.erase(it);
+      auto strIter = shard.stringToId.find(it->second.string);
+      VELOX_DCHECK(strIter != shard.stringToId.end());
+      shard.stringToId.erase(strIter);
+      shard.idToEntry.erase(it);
     }
   }
 }
 
 void StringIdMap::addReference(uint64_t id) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = idToEntry_.find(id);
+  auto& shard = this->shard(id);
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto it = shard.idToEntry.find(id);
   VELOX_CHECK(
-      it != idToEntry_.end(),
+      it != shard.idToEntry.end(),
       "Trying to add a reference to id {} that is not in StringIdMap",
       id);
 
@@ -55,11 +58,12 @@ void StringIdMap::addReference(uint64_t id) {
 }
 
 uint64_t StringIdMap::makeId(std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
-  auto it = stringToId_.find(string);
-  if (it != stringToId_.end()) {
-    auto entry = idToEntry_.find(it->second);
-    VELOX_CHECK(entry != idToEntry_.end());
+  auto& shard = this->shard(string);
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto it = shard.stringToId.find(string);
+  if (it != shard.stringToId.end()) {
+    auto entry = shard.idToEntry.find(it->second);
+    VELOX_CHECK(entry != shard.idToEntry.end());
     if (++entry->second.numInUse == 1) {
       pinnedSize_ += entry->second.string.size();
     }
@@ -67,20 +71,39 @@ uint64_t StringIdMap::makeId(std::string_view string) {
   }
   Entry entry;
   entry.string = string;
+  const uint64_t shardIndex = &shard - shards_.data();
   // Check that we do not use an id twice. In practice this never
   // happens because the int64 counter would have to wrap around for
   // this. Even if this happened, the time spent in the loop would
   // have a low cap since the number of mappings would in practice
   // be in the 100K range.
   do {
-    entry.id = ++lastId_;
-  } while (idToEntry_.find(entry.id) != idToEntry_.end());
+    entry.id = ++shard.lastId * kNumShards + shardIndex;
+  } while (entry.id == kNoId ||
+           shard.idToEntry.find(entry.id) != shard.idToEntry.end());
   entry.numInUse = 1;
   pinnedSize_ += string.size();
   auto id = entry.id;
-  idToEntry_[id] = std::move(entry);
-  stringToId_[string] = id;
-  return lastId_;
+  shard.idToEntry[id] = std::move(entry);
+  shard.stringToId[string] = id;
+  return id;
+}
+
+std::string StringIdMap::string(uint64_t id) {
+  auto& shard = this->shard(id);
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto it = shard.idToEntry.find(id);
+  return it == shard.idToEntry.end() ? "" : it->second.string;
+}
+
+void StringIdMap::testingReset() {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    shard.stringToId.clear();
+    shard.idToEntry.clear();
+    shard.lastId = 0;
+  }
+  pinnedSize_ = 0;
 }
 
 } // namespace facebook::velox
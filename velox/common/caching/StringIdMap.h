@@ -16,14 +16,22 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <string_view>
 
 #include <folly/container/F14Map.h>
+#include <folly/lang/Align.h>
 
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox {
 
+/// Assigns ids to strings and counts the uses of each mapping. The mappings
+/// are split into shards by the hash of the string, each with its own mutex,
+/// so that threads working on different strings do not contend. The shard of
+/// a mapping is encoded in the low bits of its id, so that the operations on
+/// an id lock only that shard.
 class StringIdMap {
  public:
   static constexpr uint64_t kNoId = ~0UL;
@@ -57,33 +65,41 @@ class StringIdMap {
 
   // Returns a copy of the string associated with id or empty string if id has
   // no string.
-  std::string string(uint64_t id) {
-    std::lock_guard<std::mutex> l(mutex_);
-    auto it = idToEntry_.find(id);
-    return it == idToEntry_.end() ? "" : it->second.string;
-  }
+  std::string string(uint64_t id);
 
   // Resets StringIdMap.
-  void testingReset() {
-    std::lock_guard<std::mutex> l(mutex_);
-    stringToId_.clear();
-    idToEntry_.clear();
-    lastId_ = 0;
-    pinnedSize_ = 0;
-  }
+  void testingReset();
 
  private:
+  static constexpr int32_t kNumShards = 16;
+
   struct Entry {
     std::string string;
     uint64_t id;
     uint32_t numInUse{};
   };
 
-  std::mutex mutex_;
-  folly::F14FastMap<std::string, uint64_t> stringToId_;
-  folly::F14FastMap<uint64_t, Entry> idToEntry_;
-  uint64_t lastId_{0};
-  uint64_t pinnedSize_{0};
+  struct alignas(folly::hardware_destructive_interference_size) Shard {
+    std::mutex mutex;
+    folly::F14FastMap<std::string, uint64_t> stringToId;
+    folly::F14FastMap<uint64_t, Entry> idToEntry;
+    uint64_t lastId{0};
+  };
+
+  // Returns the shard of 'string'. The shard is taken from the middle bits of
+  // the hash, which the F14 maps of the shard do not use for the bucket or
+  // the tag.
+  Shard& shard(std::string_view string) {
+    const uint64_t hash = folly::hasher<std::string_view>()(string);
+    return shards_[(hash >> 32) % kNumShards];
+  }
+
+  Shard& shard(uint64_t id) {
+    return shards_[id % kNumShards];
+  }
+
+  std::array<Shard, kNumShards> shards_;
+  std::atomic<uint64_t> pinnedSize_{0};
 };
 
 // Keeps a string-id association live for the duration of this.
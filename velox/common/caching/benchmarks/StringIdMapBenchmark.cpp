@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <thread>
+
+#include "velox/common/caching/StringIdMap.h"
+
+/// Measures StringIdMap under contention. Each thread repeatedly takes and
+/// drops leases on file names, like split opens and cache key builds do. Half
+/// of the names stay pinned so that their mappings are found and half are
+/// created and erased on every use.
+
+using namespace facebook::velox;
+
+namespace {
+
+constexpr int32_t kNumStrings = 1'024;
+constexpr int32_t kLeasesPerThread = 100'000;
+
+const std::vector<std::string>& names() {
+  static const auto* names = [] {
+    auto* result = new std::vector<std::string>();
+    for (auto i = 0; i < kNumStrings; ++i) {
+      result->push_back(fmt::format("/warehouse/table/part-{}.orc", i));
+    }
+    return result;
+  }();
+  return *names;
+}
+
+void run(int32_t numThreads) {
+  folly::BenchmarkSuspender suspender;
+  StringIdMap map;
+  std::vector<StringIdLease> pinned;
+  for (auto i = 0; i < kNumStrings; i += 2) {
+    pinned.emplace_back(map, names()[i]);
+  }
+  suspender.dismiss();
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      uint64_t sum = 0;
+      for (auto j = 0; j < kLeasesPerThread; ++j) {
+        StringIdLease lease(map, names()[(i * 7 + j) % kNumStrings]);
+        StringIdLease copy(lease);
+        sum += copy.id();
+      }
+      folly::doNotOptimizeAway(sum);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+BENCHMARK(threads1) {
+  run(1);
+}
+
+BENCHMARK(threads8) {
+  run(8);
+}
+
+BENCHMARK(threads32) {
+  run(32);
+}
+
+BENCHMARK(threads96) {
+  run(96);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
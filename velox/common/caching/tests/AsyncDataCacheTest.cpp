@@ -17,6 +17,7 @@
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/Semaphore.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/CachePolicy.h"
 #include "velox/common/caching/CacheTTLController.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
@@ -1146,6 +1147,46 @@ TEST_P(AsyncDataCacheTest, shutdown) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, ssdWarmUp) {
+  constexpr uint64_t kRamBytes = 32 << 20;
+  constexpr uint64_t kSsdBytes = 64UL << 20;
+  // With a rate limit, the chunks of the warm-up after the first are
+  // scheduled on the SSD executor after a delay.
+  for (const uint64_t bytesPerSec : {0UL, 64UL << 20}) {
+    SCOPED_TRACE(fmt::format("bytesPerSec {}", bytesPerSec));
+    AsyncDataCache::Options options;
+    options.ssdWarmUpBytes = kRamBytes / 2;
+    options.ssdWarmUpBytesPerSec = bytesPerSec;
+    initializeCache(kRamBytes, kSsdBytes, kSsdBytes * 10, options);
+    cache_->testingWaitForSsdWarmUp();
+    if (bytesPerSec == 0) {
+      // Nothing to warm up from on the first start.
+      ASSERT_EQ(cache_->refreshStats().ssdStats->entriesRead, 0);
+    }
+
+    loadLoop(0, kSsdBytes);
+    waitForSsdWriteToFinish(cache_->ssdCache());
+    ASSERT_GT(cache_->ssdCache()->stats().entriesCached, 0);
+
+    // Restart. The shutdown records the memory hot set and the SSD
+    // checkpoint. The new cache loads entries from SSD in the background.
+    initializeCache(kRamBytes, kSsdBytes, kSsdBytes * 10, options);
+    cache_->testingWaitForSsdWarmUp();
+    const auto stats = cache_->refreshStats();
+    ASSERT_GT(stats.ssdStats->entriesRead, 0);
+    ASSERT_GT(stats.numPrefetch, 0);
+    for (const auto* entry : cache_->testingCacheEntries()) {
+      if (entry == nullptr || entry->size() == 0) {
+        continue;
+      }
+      ASSERT_TRUE(entry->isPrefetch());
+      ASSERT_NE(entry->ssdFile(), nullptr);
+      checkContents(*entry);
+    }
+    cache_->ssdCache()->testingDeleteCheckpoints();
+  }
+}
+
 DEBUG_ONLY_TEST_P(AsyncDataCacheTest, shrinkWithSsdWrite) {
   constexpr uint64_t kRamBytes = 128UL << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
@@ -1356,6 +1397,167 @@ TEST_P(AsyncDataCacheTest, ssdWriteOptions) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, tinyLfuPolicy) {
+  constexpr uint64_t kRamBytes = 16UL << 20;
+  constexpr int kDataSize = 4096;
+  AsyncDataCache::Options options;
+  options.policyFactory = []() {
+    return std::make_unique<TinyLfuCachePolicy>();
+  };
+  initializeCache(kRamBytes, 0, 0, options);
+  ASSERT_EQ(cache_->refreshStats().policy, "tinylfu");
+
+  auto loadEntry = [&](uint64_t offset) {
+    auto pin = newEntry(offset, kDataSize);
+    EXPECT_FALSE(pin.empty());
+    pin.entry()->setPrefetch(false);
+    pin.entry()->setExclusiveToShared(false);
+    return pin;
+  };
+
+  // The first access of 'offset' is not admitted. The entry is returned but is
+  // immediately evictable.
+  auto pin = loadEntry(0);
+  ASSERT_EQ(pin.entry()->testingAccessStats().lastUse, 0);
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numNotAdmitted, 1);
+  ASSERT_EQ(stats.numNotAdmittedHit, 0);
+
+  // A hit before eviction retains the entry.
+  {
+    auto hitPin = cache_->findOrCreate(
+        RawFileCacheKey{filenames_[0].id(), 0}, kDataSize, nullptr);
+    ASSERT_FALSE(hitPin.empty());
+    ASSERT_NE(hitPin.entry()->testingAccessStats().lastUse, 0);
+  }
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numNotAdmitted, 1);
+  ASSERT_EQ(stats.numNotAdmittedHit, 1);
+  pin.clear();
+
+  // An entry that is evicted and loaded again is admitted the second time.
+  pin = loadEntry(kDataSize);
+  pin.clear();
+  cache_->testingClear();
+  pin = loadEntry(kDataSize);
+  ASSERT_NE(pin.entry()->testingAccessStats().lastUse, 0);
+  ASSERT_EQ(cache_->refreshStats().numNotAdmitted, 2);
+  pin.clear();
+
+  // Prefetched entries are always admitted.
+  pin = newEntry(2 * kDataSize, kDataSize);
+  pin.entry()->setExclusiveToShared(false);
+  ASSERT_NE(pin.entry()->testingAccessStats().lastUse, 0);
+  ASSERT_EQ(cache_->refreshStats().numNotAdmitted, 2);
+}
+
+TEST_P(AsyncDataCacheTest, cacheQuota) {
+  constexpr uint64_t kRamBytes = 16UL << 20;
+  constexpr int kDataSize = 4096;
+  initializeCache(kRamBytes);
+  auto quota = std::make_shared<CacheQuota>(CachePriority::kLow, 3 * kDataSize);
+
+  auto loadEntry = [&](uint64_t offset,
+                       const std::shared_ptr<CacheQuota>& entryQuota) {
+    auto pin = cache_->findOrCreate(
+        RawFileCacheKey{filenames_[0].id(), offset},
+        kDataSize,
+        nullptr,
+        entryQuota);
+    EXPECT_FALSE(pin.empty());
+    EXPECT_TRUE(pin.entry()->isExclusive());
+    pin.entry()->setExclusiveToShared(false);
+    return pin;
+  };
+
+  // The entries up to the quota are admitted. The one that reaches the quota
+  // is returned but not admitted.
+  std::vector<CachePin> pins;
+  for (auto i = 0; i < 3; ++i) {
+    pins.push_back(loadEntry(i * kDataSize, quota));
+    ASSERT_EQ(pins.back().entry()->priority(), CachePriority::kLow);
+  }
+  ASSERT_EQ(quota->usedBytes(), 3 * kDataSize);
+  ASSERT_TRUE(quota->exceeded());
+  ASSERT_EQ(quota->numNotAdmitted(), 1);
+  ASSERT_EQ(cache_->refreshStats().numNotAdmitted, 1);
+
+  // A hit by a query of higher priority raises the priority of the entry.
+  auto highQuota = std::make_shared<CacheQuota>(CachePriority::kHigh, 0);
+  {
+    auto hitPin = cache_->findOrCreate(
+        RawFileCacheKey{filenames_[0].id(), 0}, kDataSize, nullptr, highQuota);
+    ASSERT_TRUE(hitPin.entry()->isShared());
+    ASSERT_EQ(hitPin.entry()->priority(), CachePriority::kHigh);
+  }
+  ASSERT_EQ(highQuota->usedBytes(), 0);
+  ASSERT_EQ(quota->usedBytes(), 3 * kDataSize);
+
+  // Entries without a quota are not charged.
+  pins.push_back(loadEntry(10 * kDataSize, nullptr));
+  ASSERT_EQ(pins.back().entry()->priority(), CachePriority::kNormal);
+  ASSERT_EQ(quota->usedBytes(), 3 * kDataSize);
+
+  // Evicted entries release their quota.
+  pins.clear();
+  cache_->testingClear();
+  ASSERT_EQ(quota->usedBytes(), 0);
+  ASSERT_FALSE(quota->exceeded());
+  pins.push_back(loadEntry(0, quota));
+  ASSERT_EQ(quota->usedBytes(), kDataSize);
+  ASSERT_EQ(quota->numNotAdmitted(), 1);
+}
+
+TEST(CacheQuotaTest, priorityNames) {
+  for (auto priority :
+       {CachePriority::kLow, CachePriority::kNormal, CachePriority::kHigh}) {
+    ASSERT_EQ(cachePriorityFromName(cachePriorityName(priority)), priority);
+  }
+  VELOX_ASSERT_THROW(
+      cachePriorityFromName("urgent"), "Invalid cache priority: urgent");
+}
+
+TEST(FileGroupStatsTest, priority) {
+  FileGroupStats stats;
+  ASSERT_EQ(stats.groupPriority(1), CachePriority::kNormal);
+  ASSERT_TRUE(stats.shouldSaveToSsd(1, TrackingId()));
+
+  stats.recordPriority(1, CachePriority::kLow);
+  ASSERT_EQ(stats.groupPriority(1), CachePriority::kLow);
+  ASSERT_FALSE(stats.shouldSaveToSsd(1, TrackingId()));
+
+  // A group read by any query of normal or higher priority is saved.
+  stats.recordPriority(1, CachePriority::kHigh);
+  stats.recordPriority(1, CachePriority::kLow);
+  ASSERT_EQ(stats.groupPriority(1), CachePriority::kHigh);
+  ASSERT_TRUE(stats.shouldSaveToSsd(1, TrackingId()));
+  ASSERT_TRUE(stats.shouldSaveToSsd(2, TrackingId()));
+}
+
+TEST(FrequencySketchTest, basic) {
+  FrequencySketch sketch(1024);
+  std::vector<uint64_t> hashes;
+  for (auto i = 0; i < 100; ++i) {
+    hashes.push_back(bits::hashMix(i, 1234));
+  }
+  for (auto i = 0; i < hashes.size(); ++i) {
+    for (auto j = 0; j < i % 10; ++j) {
+      sketch.increment(hashes[i]);
+    }
+  }
+  // The estimate is never less than the actual count.
+  for (auto i = 0; i < hashes.size(); ++i) {
+    ASSERT_GE(sketch.estimate(hashes[i]), i % 10);
+  }
+  // The counters saturate and age.
+  for (auto i = 0; i < 100'000; ++i) {
+    sketch.increment(hashes[0]);
+    sketch.increment(bits::hashMix(i, 5678));
+  }
+  ASSERT_GT(sketch.estimate(hashes[0]), sketch.estimate(hashes[1]));
+  ASSERT_LE(sketch.estimate(hashes[0]), 15);
+}
+
 // TODO: add concurrent fuzzer test.
 
 INSTANTIATE_TEST_SUITE_P(
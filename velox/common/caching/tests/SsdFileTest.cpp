@@ -63,7 +63,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
@@ -74,7 +75,8 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        disableFileCow);
+        disableFileCow,
+        compressionKind);
   }
 
   void initializeSsdFile(
@@ -82,7 +84,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -90,7 +93,9 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         disableFileCow,
         checksumEnabled,
-        checksumReadVerificationEnabled);
+        checksumReadVerificationEnabled,
+        nullptr, // executor
+        compressionKind);
     ssdFile_ = std::make_unique<SsdFile>(config);
   }
 
@@ -468,6 +473,55 @@ TEST_F(SsdFileTest, checkpoint) {
   EXPECT_EQ(numEntriesFound, 0);
 }
 
+TEST_F(SsdFileTest, compression) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = 2 * SsdFile::kRegionSize;
+  FLAGS_ssd_verify_write = true;
+  initializeCache(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      common::CompressionKind_ZSTD);
+
+  for (auto startOffset = 0; startOffset <= kSsdSize - SsdFile::kRegionSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 16 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+    }
+    readAndCheckPins(pins);
+  }
+  const auto stats = ssdFile_->testingStats();
+  EXPECT_GT(stats.entriesCompressed, 0);
+  EXPECT_LT(stats.bytesCompressedTo, stats.bytesCompressedFrom);
+  EXPECT_EQ(stats.readSsdCorruptions, 0);
+
+  // Recover from the checkpoint and read back the compressed entries.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      common::CompressionKind_ZSTD);
+  for (auto startOffset = 0; startOffset <= kSsdSize - SsdFile::kRegionSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 16 * kMB);
+    readAndCheckPins(pins);
+  }
+
+  // A checkpoint written with a different compression is not recovered.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, true);
+  EXPECT_TRUE(ssdFile_->find(RawFileCacheKey{fileName_.id(), 0}).empty());
+}
+
 TEST_F(SsdFileTest, fileCorruption) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
@@ -16,6 +16,8 @@
 
 #include "velox/common/caching/StringIdMap.h"
 
+#include <thread>
+
 #include "gtest/gtest.h"
 
 using namespace facebook::velox;
@@ -53,3 +55,50 @@ TEST(StringIdMapTest, rehash) {
     EXPECT_EQ(ids[i].id(), StringIdLease(map, name).id());
   }
 }
+
+TEST(StringIdMapTest, concurrent) {
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumStrings = 1'000;
+  StringIdMap map;
+  std::vector<std::string> names;
+  for (auto i = 0; i < kNumStrings; ++i) {
+    names.push_back(fmt::format("filename_{}", i));
+  }
+  std::vector<StringIdLease> pinned;
+  for (auto i = 0; i < kNumStrings; i += 2) {
+    pinned.emplace_back(map, names[i]);
+  }
+
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto repeat = 0; repeat < 20; ++repeat) {
+        for (auto j = i; j < kNumStrings; j += kNumThreads) {
+          StringIdLease lease(map, names[j]);
+          EXPECT_EQ(lease.id(), map.id(names[j]));
+          EXPECT_EQ(names[j], map.string(lease.id()));
+          StringIdLease copy(lease);
+          if (j % 2 == 0) {
+            EXPECT_EQ(pinned[j / 2].id(), lease.id());
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  int64_t pinnedSize = 0;
+  for (auto i = 0; i < kNumStrings; ++i) {
+    if (i % 2 == 0) {
+      pinnedSize += names[i].size();
+      EXPECT_EQ(pinned[i / 2].id(), map.id(names[i]));
+    } else {
+      EXPECT_EQ(StringIdMap::kNoId, map.id(names[i]));
+    }
+  }
+  EXPECT_EQ(pinnedSize, map.pinnedSize());
+  pinned.clear();
+  EXPECT_EQ(0, map.pinnedSize());
+}
@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -209,6 +210,20 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  auto* ioUring = IoUring::instance();
+  if (ioUring == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  return ioUring->preadv({fd_, offset, buffers});
+}
+
+bool LocalReadFile::hasPreadvAsync() const {
+  return IoUring::instance() != nullptr;
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
@@ -245,6 +245,14 @@ class LocalReadFile final : public ReadFile {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  /// Reads through io_uring if enabled by --velox_io_uring. Otherwise reads
+  /// synchronously.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
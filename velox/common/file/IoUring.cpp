@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <folly/String.h>
+#include <folly/portability/SysUio.h>
+#include <glog/logging.h>
+
+#include <cstring>
+
+#include "velox/common/base/Exceptions.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define VELOX_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+DEFINE_bool(
+    velox_io_uring,
+    false,
+    "Use io_uring for asynchronous local file reads, e.g. SSD cache loads");
+
+namespace facebook::velox {
+
+// The part of a read that is covered by one submission queue entry. This is
+// the user data of the entry.
+struct IoUring::Chunk {
+  Request* request;
+  // Begin and end index in Request::iovecs.
+  size_t begin;
+  size_t end;
+  // File offset and number of bytes not read yet. A short read advances
+  // these and the iovecs and is resubmitted.
+  uint64_t offset;
+  uint64_t remaining;
+};
+
+struct IoUring::Request {
+  int32_t fd;
+  // All iovecs of the read. Each submission queue entry covers a contiguous
+  // subrange of at most IOV_MAX iovecs.
+  std::vector<struct iovec> iovecs;
+  std::vector<Chunk> chunks;
+
+  std::atomic<int32_t> numPending{0};
+  std::atomic<uint64_t> bytesRead{0};
+  // The first error returned by any of the entries, as a negative errno.
+  std::atomic<int32_t> error{0};
+  folly::Promise<uint64_t> promise;
+};
+
+namespace {
+
+// Destination of skipped ranges. The contents are never looked at, so
+// concurrent reads into it are harmless. Aligned to allow O_DIRECT reads.
+alignas(4096) char droppedBytes[64 << 10];
+
+} // namespace
+
+// static
+std::unique_ptr<IoUring::Request> IoUring::makeRequest(Read& read) {
+  auto request = std::make_unique<Request>();
+  request->fd = read.fd;
+  for (const auto& range : read.buffers) {
+    if (range.data() == nullptr) {
+      auto skipSize = range.size();
+      while (skipSize > 0) {
+        const auto bytes = std::min<size_t>(sizeof(droppedBytes), skipSize);
+        request->iovecs.push_back({droppedBytes, bytes});
+        skipSize -= bytes;
+      }
+    } else {
+      request->iovecs.push_back({range.data(), range.size()});
+    }
+  }
+
+  uint64_t offset = read.offset;
+  for (size_t begin = 0; begin < request->iovecs.size(); begin += IOV_MAX) {
+    const auto end =
+        std::min<size_t>(begin + IOV_MAX, request->iovecs.size());
+    uint64_t size = 0;
+    for (auto i = begin; i < end; ++i) {
+      size += request->iovecs[i].iov_len;
+    }
+    request->chunks.push_back({request.get(), begin, end, offset, size});
+    offset += size;
+  }
+  request->numPending = request->chunks.size();
+  return request;
+}
+
+// static
+IoUring* IoUring::instance() {
+  if (!FLAGS_velox_io_uring) {
+    return nullptr;
+  }
+  static std::unique_ptr<IoUring> ring = create();
+  return ring.get();
+}
+
+#ifdef VELOX_HAS_IO_URING
+
+// static
+bool IoUring::completeChunk(Chunk* chunk, int32_t result) {
+  auto* request = chunk->request;
+  if (result == -EAGAIN || result == -EINTR) {
+    return true;
+  }
+  if (result < 0) {
+    int32_t expected = 0;
+    request->error.compare_exchange_strong(expected, result);
+  } else {
+    request->bytesRead += result;
+    if (result > 0 && static_cast<uint64_t>(result) < chunk->remaining) {
+      // Short read. Skip the bytes read and read the rest. A read of 0 bytes
+      // is the end of the file.
+      chunk->offset += result;
+      chunk->remaining -= result;
+      for (uint64_t bytes = result; bytes > 0;) {
+        auto& iovec = request->iovecs[chunk->begin];
+        if (bytes < iovec.iov_len) {
+          iovec.iov_base = static_cast<char*>(iovec.iov_base) + bytes;
+          iovec.iov_len -= bytes;
+          break;
+        }
+        bytes -= iovec.iov_len;
+        ++chunk->begin;
+      }
+      return true;
+    }
+  }
+  if (--request->numPending > 0) {
+    return false;
+  }
+  std::unique_ptr<Request> deleter(request);
+  if (request->error != 0) {
+    request->promise.setException(std::runtime_error(fmt::format(
+        "io_uring read failed: {}", folly::errnoStr(-request->error))));
+  } else {
+    request->promise.setValue(request->bytesRead.load());
+  }
+  return false;
+}
+
+namespace {
+
+template <typename T>
+T* ringPointer(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+void* mapRing(int32_t fd, size_t size, off_t offset) {
+  void* ptr = ::mmap(
+      nullptr,
+      size,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      fd,
+      offset);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+} // namespace
+
+// static
+std::unique_ptr<IoUring> IoUring::create() {
+  struct io_uring_params params {};
+  const int32_t fd = ::syscall(__NR_io_uring_setup, kQueueDepth, &params);
+  if (fd < 0) {
+    LOG(WARNING) << "io_uring_setup failed, using synchronous reads: "
+                 << folly::errnoStr(errno);
+    return nullptr;
+  }
+  // Without IORING_FEAT_NODROP a completion that does not fit in the
+  // completion queue is lost and its read would never finish. The number of
+  // entries in flight is kept below the completion queue size, but an older
+  // kernel is not trusted with that either.
+  if (!(params.features & IORING_FEAT_NODROP)) {
+    LOG(WARNING) << "io_uring lacks IORING_FEAT_NODROP, using synchronous "
+                 << "reads";
+    ::close(fd);
+    return nullptr;
+  }
+
+  std::unique_ptr<IoUring> ring(new IoUring());
+  ring->ringFd_ = fd;
+  ring->sqRingSize_ =
+      params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->cqRingSize_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (singleMmap) {
+    ring->sqRingSize_ = ring->cqRingSize_ =
+        std::max(ring->sqRingSize_, ring->cqRingSize_);
+  }
+  ring->sqRing_ = mapRing(fd, ring->sqRingSize_, IORING_OFF_SQ_RING);
+  ring->cqRing_ = singleMmap
+      ? ring->sqRing_
+      : mapRing(fd, ring->cqRingSize_, IORING_OFF_CQ_RING);
+  ring->sqesSize_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  ring->sqes_ = mapRing(fd, ring->sqesSize_, IORING_OFF_SQES);
+  if (ring->sqRing_ == nullptr || ring->cqRing_ == nullptr ||
+      ring->sqes_ == nullptr) {
+    LOG(WARNING) << "Mapping io_uring queues failed, using synchronous reads: "
+                 << folly::errnoStr(errno);
+    return nullptr;
+  }
+
+  ring->sqHead_ = ringPointer<uint32_t>(ring->sqRing_, params.sq_off.head);
+  ring->sqTail_ = ringPointer<uint32_t>(ring->sqRing_, params.sq_off.tail);
+  ring->sqMask_ =
+      *ringPointer<uint32_t>(ring->sqRing_, params.sq_off.ring_mask);
+  ring->sqEntries_ =
+      *ringPointer<uint32_t>(ring->sqRing_, params.sq_off.ring_entries);
+  ring->sqArray_ = ringPointer<uint32_t>(ring->sqRing_, params.sq_off.array);
+  ring->cqHead_ = ringPointer<uint32_t>(ring->cqRing_, params.cq_off.head);
+  ring->cqTail_ = ringPointer<uint32_t>(ring->cqRing_, params.cq_off.tail);
+  ring->cqMask_ =
+      *ringPointer<uint32_t>(ring->cqRing_, params.cq_off.ring_mask);
+  ring->cqEntries_ =
+      *ringPointer<uint32_t>(ring->cqRing_, params.cq_off.ring_entries);
+  ring->cqes_ = ringPointer<void>(ring->cqRing_, params.cq_off.cqes);
+
+  auto* rawRing = ring.get();
+  ring->reaper_ = std::thread([rawRing]() { rawRing->reapCompletions(); });
+  return ring;
+}
+
+IoUring::~IoUring() {
+  if (reaper_.joinable()) {
+    // Wake up the reaper with a no-op whose completion it does not forward.
+    std::lock_guard<std::mutex> l(submitMutex_);
+    stopping_ = true;
+    ++numInFlight_;
+    addEntryLocked(IORING_OP_NOP, -1, nullptr, 0, 0, 0);
+    submitLocked();
+  }
+  if (reaper_.joinable()) {
+    reaper_.join();
+  }
+  if (sqes_ != nullptr) {
+    ::munmap(sqes_, sqesSize_);
+  }
+  if (cqRing_ != nullptr && cqRing_ != sqRing_) {
+    ::munmap(cqRing_, cqRingSize_);
+  }
+  if (sqRing_ != nullptr) {
+    ::munmap(sqRing_, sqRingSize_);
+  }
+  if (ringFd_ >= 0) {
+    ::close(ringFd_);
+  }
+}
+
+folly::SemiFuture<uint64_t> IoUring::preadv(Read read) {
+  std::vector<Read> reads;
+  reads.push_back(std::move(read));
+  return std::move(preadv(std::move(reads))[0]);
+}
+
+std::vector<folly::SemiFuture<uint64_t>> IoUring::preadv(
+    std::vector<Read> reads) {
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  futures.reserve(reads.size());
+  std::vector<std::unique_ptr<Request>> requests;
+  requests.reserve(reads.size());
+  for (auto& read : reads) {
+    auto request = makeRequest(read);
+    if (request->chunks.empty()) {
+      futures.push_back(folly::makeSemiFuture<uint64_t>(0));
+      continue;
+    }
+    futures.push_back(request->promise.getSemiFuture());
+    requests.push_back(std::move(request));
+  }
+
+  std::unique_lock<std::mutex> l(submitMutex_);
+  for (auto& request : requests) {
+    // Ownership passes to the completion of the last entry.
+    addRequestLocked(request.release(), l);
+  }
+  submitLocked();
+  return futures;
+}
+
+uint32_t IoUring::freeEntriesLocked() const {
+  return sqEntries_ - (*sqTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE));
+}
+
+void IoUring::addRequestLocked(
+    Request* request,
+    std::unique_lock<std::mutex>& lock) {
+  for (auto& chunk : request->chunks) {
+    // Each entry in flight may produce a completion. Keeping them within the
+    // completion queue size means that the completion queue never overflows.
+    if (numInFlight_ >= cqEntries_) {
+      submitLocked();
+      entriesCompleted_.wait(
+          lock, [&]() { return numInFlight_ < cqEntries_; });
+    }
+    ++numInFlight_;
+    addChunkLocked(&chunk);
+  }
+}
+
+void IoUring::addChunkLocked(Chunk* chunk) {
+  addEntryLocked(
+      IORING_OP_READV,
+      chunk->request->fd,
+      chunk->request->iovecs.data() + chunk->begin,
+      chunk->end - chunk->begin,
+      chunk->offset,
+      reinterpret_cast<uint64_t>(chunk));
+}
+
+void IoUring::addEntryLocked(
+    uint8_t opcode,
+    int32_t fd,
+    const struct iovec* iovecs,
+    uint32_t numIovecs,
+    uint64_t offset,
+    uint64_t userData) {
+  if (freeEntriesLocked() == 0) {
+    submitLocked();
+  }
+  const auto tail = *sqTail_;
+  const auto index = tail & sqMask_;
+  auto* sqe = static_cast<struct io_uring_sqe*>(sqes_) + index;
+  std::memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uint64_t>(iovecs);
+  sqe->len = numIovecs;
+  sqe->off = offset;
+  sqe->user_data = userData;
+  sqArray_[index] = index;
+  __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+  ++numUnsubmitted_;
+}
+
+void IoUring::submitLocked() {
+  while (numUnsubmitted_ > 0) {
+    const auto submitted = ::syscall(
+        __NR_io_uring_enter, ringFd_, numUnsubmitted_, 0, 0, nullptr, 0);
+    if (submitted < 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+        std::this_thread::yield();
+        continue;
+      }
+      VELOX_FAIL("io_uring_enter failed: {}", folly::errnoStr(errno));
+    }
+    numUnsubmitted_ -= submitted;
+  }
+}
+
+void IoUring::reapCompletions() {
+  for (;;) {
+    auto head = *cqHead_;
+    const auto tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+      if (stopping_) {
+        return;
+      }
+      const auto rc = ::syscall(
+          __NR_io_uring_enter,
+          ringFd_,
+          0,
+          1,
+          IORING_ENTER_GETEVENTS,
+          nullptr,
+          0);
+      if (rc < 0 && errno != EINTR) {
+        LOG(ERROR) << "io_uring_enter failed waiting for completions: "
+                   << folly::errnoStr(errno);
+      }
+      continue;
+    }
+    // Short reads are resubmitted in the place of their completed entry, so
+    // that they do not count against 'numInFlight_' twice.
+    std::vector<Chunk*> resubmits;
+    uint32_t numCompleted = 0;
+    for (; head != tail; ++head) {
+      const auto* cqe =
+          static_cast<struct io_uring_cqe*>(cqes_) + (head & cqMask_);
+      auto* chunk = reinterpret_cast<Chunk*>(cqe->user_data);
+      if (chunk != nullptr && completeChunk(chunk, cqe->res)) {
+        resubmits.push_back(chunk);
+      } else {
+        ++numCompleted;
+      }
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+
+    {
+      std::lock_guard<std::mutex> l(submitMutex_);
+      numInFlight_ -= numCompleted;
+      for (auto* chunk : resubmits) {
+        addChunkLocked(chunk);
+      }
+      if (!resubmits.empty()) {
+        submitLocked();
+      }
+    }
+    entriesCompleted_.notify_all();
+  }
+}
+
+#else
+
+// static
+std::unique_ptr<IoUring> IoUring::create() {
+  LOG(WARNING) << "io_uring is not supported on this platform";
+  return nullptr;
+}
+
+IoUring::~IoUring() = default;
+
+folly::SemiFuture<uint64_t> IoUring::preadv(Read /*read*/) {
+  VELOX_UNSUPPORTED("io_uring is not supported on this platform");
+}
+
+std::vector<folly::SemiFuture<uint64_t>> IoUring::preadv(
+    std::vector<Read> /*reads*/) {
+  VELOX_UNSUPPORTED("io_uring is not supported on this platform");
+}
+
+void IoUring::addRequestLocked(
+    Request* /*request*/,
+    std::unique_lock<std::mutex>& /*lock*/) {
+  VELOX_UNREACHABLE();
+}
+
+void IoUring::addChunkLocked(Chunk* /*chunk*/) {
+  VELOX_UNREACHABLE();
+}
+
+void IoUring::addEntryLocked(
+    uint8_t /*opcode*/,
+    int32_t /*fd*/,
+    const struct iovec* /*iovecs*/,
+    uint32_t /*numIovecs*/,
+    uint64_t /*offset*/,
+    uint64_t /*userData*/) {
+  VELOX_UNREACHABLE();
+}
+
+uint32_t IoUring::freeEntriesLocked() const {
+  VELOX_UNREACHABLE();
+}
+
+void IoUring::submitLocked() {
+  VELOX_UNREACHABLE();
+}
+
+void IoUring::reapCompletions() {
+  VELOX_UNREACHABLE();
+}
+
+#endif
+
+} // namespace facebook::velox
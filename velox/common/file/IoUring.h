@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct iovec;
+
+DECLARE_bool(velox_io_uring);
+
+namespace facebook::velox {
+
+/// Asynchronous reads of local files through a process-wide Linux io_uring.
+/// The ring is talked to with raw syscalls, so that there is no dependency on
+/// liburing. Submissions from any thread go to the same submission queue and a
+/// dedicated thread reaps completions and fulfills the returned futures. The
+/// number of entries in flight is capped at the completion queue size, so
+/// submitters block while the ring is full. Short reads are resubmitted for
+/// the remaining bytes.
+///
+/// Enabled by --velox_io_uring. instance() returns nullptr if the flag is off
+/// or the kernel does not support io_uring with IORING_FEAT_NODROP, in which
+/// case callers use the synchronous pread path.
+class IoUring {
+ public:
+  /// A vectored read of 'buffers' from 'fd' starting at 'offset'. The buffers
+  /// are filled left to right. A buffer with nullptr data causes its size
+  /// worth of bytes to be skipped, as in ReadFile::preadv().
+  struct Read {
+    int32_t fd;
+    uint64_t offset;
+    std::vector<folly::Range<char*>> buffers;
+  };
+
+  /// Returns the process-wide ring or nullptr if io_uring is disabled or not
+  /// available.
+  static IoUring* instance();
+
+  ~IoUring();
+
+  /// Submits 'read' and returns the number of bytes read. The buffers must
+  /// stay live until the returned future is complete.
+  folly::SemiFuture<uint64_t> preadv(Read read);
+
+  /// Submits all of 'reads' with a single io_uring_enter call, up to the size
+  /// of the submission queue per call. Returns a future per read in the order
+  /// of 'reads'.
+  std::vector<folly::SemiFuture<uint64_t>> preadv(std::vector<Read> reads);
+
+ private:
+  struct Request;
+  struct Chunk;
+
+  // Number of submission queue entries.
+  static constexpr uint32_t kQueueDepth = 256;
+
+  // Converts 'read' into iovecs and submission queue entries.
+  static std::unique_ptr<Request> makeRequest(Read& read);
+
+  // Records 'result' of the submission queue entry of 'chunk'. Returns true if
+  // 'chunk' must be resubmitted to read the rest after a short read or a
+  // retryable error. Otherwise fulfills and frees the request of 'chunk' after
+  // its last entry.
+  static bool completeChunk(Chunk* chunk, int32_t result);
+
+  // Sets up the ring. Returns nullptr on failure.
+  static std::unique_ptr<IoUring> create();
+
+  IoUring() = default;
+
+  // Adds the submission queue entries for 'request'. Waits on 'lock', which
+  // holds 'submitMutex_', while 'cqEntries_' entries are in flight.
+  void addRequestLocked(Request* request, std::unique_lock<std::mutex>& lock);
+
+  // Adds the submission queue entry for 'chunk'. Must be called with
+  // 'submitMutex_' held.
+  void addChunkLocked(Chunk* chunk);
+
+  // Adds one submission queue entry, submitting the queued entries first if
+  // the queue is full. Must be called with 'submitMutex_' held.
+  void addEntryLocked(
+      uint8_t opcode,
+      int32_t fd,
+      const struct iovec* iovecs,
+      uint32_t numIovecs,
+      uint64_t offset,
+      uint64_t userData);
+
+  // Returns the number of free entries in the submission queue. Must be called
+  // with 'submitMutex_' held.
+  uint32_t freeEntriesLocked() const;
+
+  // Submits the queued entries to the kernel. Must be called with
+  // 'submitMutex_' held.
+  void submitLocked();
+
+  // Body of 'reaper_'. Waits for completions and fulfills requests.
+  void reapCompletions();
+
+  int32_t ringFd_{-1};
+
+  void* sqRing_{nullptr};
+  size_t sqRingSize_{0};
+  void* cqRing_{nullptr};
+  size_t cqRingSize_{0};
+  void* sqes_{nullptr};
+  size_t sqesSize_{0};
+
+  // Pointers into the mapped rings.
+  uint32_t* sqHead_{nullptr};
+  uint32_t* sqTail_{nullptr};
+  uint32_t sqMask_{0};
+  uint32_t sqEntries_{0};
+  uint32_t* sqArray_{nullptr};
+  uint32_t* cqHead_{nullptr};
+  uint32_t* cqTail_{nullptr};
+  uint32_t cqMask_{0};
+  uint32_t cqEntries_{0};
+  void* cqes_{nullptr};
+
+  // Serializes writes to the submission queue.
+  std::mutex submitMutex_;
+  // Number of entries added to the submission queue but not yet submitted.
+  uint32_t numUnsubmitted_{0};
+  // Number of entries added whose completion has not been reaped. Guarded by
+  // 'submitMutex_'.
+  uint32_t numInFlight_{0};
+  // Signaled when the reaper has reaped completions.
+  std::condition_variable entriesCompleted_;
+
+  std::atomic_bool stopping_{false};
+  std::thread reaper_;
+};
+
+} // namespace facebook::velox
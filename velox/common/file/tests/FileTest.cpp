@@ -15,10 +15,12 @@
  */
 
 #include <fcntl.h>
+#include <folly/ScopeGuard.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -337,6 +339,71 @@ TEST_P(LocalFileTest, rmdir) {
   EXPECT_NO_THROW(localFs->rmdir(tempFolder->getPath()));
 }
 
+TEST_P(LocalFileTest, preadvAsyncIoUring) {
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  {
+    LocalWriteFile writeFile(filename, false, false);
+    writeData(&writeFile);
+    writeFile.close();
+  }
+  LocalReadFile readFile(filename);
+  ASSERT_FALSE(readFile.hasPreadvAsync());
+
+  FLAGS_velox_io_uring = true;
+  SCOPE_EXIT {
+    FLAGS_velox_io_uring = false;
+  };
+  if (IoUring::instance() == nullptr) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  ASSERT_TRUE(readFile.hasPreadvAsync());
+
+  char head[12];
+  char middle[4];
+  char tail[7];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)500000),
+      folly::Range<char*>(middle, sizeof(middle)),
+      folly::Range<char*>(
+          nullptr,
+          (char*)(uint64_t)(15 + kOneMB - 500000 - sizeof(head) -
+                            sizeof(middle) - sizeof(tail))),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(15 + kOneMB, readFile.preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+
+  // Batch of reads submitted together. There are more reads than fit in the
+  // completion queue.
+  std::vector<std::vector<char>> data(2'000, std::vector<char>(10));
+  const int32_t fd = ::open(filename.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  std::vector<IoUring::Read> reads;
+  for (auto i = 0; i < data.size(); ++i) {
+    reads.push_back(
+        {fd,
+         static_cast<uint64_t>(i * 100),
+         {folly::Range<char*>(data[i].data(), data[i].size())}});
+  }
+  auto futures = IoUring::instance()->preadv(std::move(reads));
+  for (auto i = 0; i < futures.size(); ++i) {
+    ASSERT_EQ(std::move(futures[i]).get(), 10);
+    const std::string expected = i == 0 ? "aaaaabbbbb" : std::string(10, 'c');
+    ASSERT_EQ(std::string(data[i].data(), data[i].size()), expected);
+  }
+
+  // A read past the end of the file returns the bytes up to the end.
+  char end[20];
+  auto future = IoUring::instance()->preadv(
+      {fd, 15 + kOneMB - 5, {folly::Range<char*>(end, sizeof(end))}});
+  ASSERT_EQ(std::move(future).get(), 5);
+  ASSERT_EQ(std::string_view(end, 5), "ddddd");
+  ::close(fd);
+}
+
 TEST_P(LocalFileTest, fileNotFound) {
   auto tempFolder = exec::test::TempDirectoryPath::create(useFaultyFs_);
   auto path = fmt::format("{}/file", tempFolder->getPath());
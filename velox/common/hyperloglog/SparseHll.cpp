@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/hyperloglog/SparseHll.h"
+
+#include <algorithm>
+
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -88,6 +91,31 @@ bool SparseHll::insertHash(uint64_t hash) {
   return overLimit();
 }
 
+bool SparseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  if (numHashes == 0) {
+    return overLimit();
+  }
+  std::vector<uint32_t> newEntries(numHashes);
+  for (auto i = 0; i < numHashes; ++i) {
+    newEntries[i] = encode(
+        computeIndex(hashes[i], kIndexBitLength),
+        numberOfLeadingZeros(hashes[i], kIndexBitLength));
+  }
+  // Entries with the same index are ordered by value, so the last entry of
+  // each run of equal indices has the largest value.
+  std::sort(newEntries.begin(), newEntries.end());
+  int32_t numDistinct = 0;
+  for (auto i = 0; i < numHashes; ++i) {
+    if (i + 1 < numHashes &&
+        decodeIndex(newEntries[i]) == decodeIndex(newEntries[i + 1])) {
+      continue;
+    }
+    newEntries[numDistinct++] = newEntries[i];
+  }
+  mergeWith(numDistinct, newEntries.data());
+  return overLimit();
+}
+
 int64_t SparseHll::cardinality() const {
   // Estimate the cardinality using linear counting over the theoretical
   // 2^kIndexBitLength buckets available due to the fact that we're
@@ -237,11 +265,35 @@ void SparseHll::verify() const {
 }
 
 void SparseHll::toDense(DenseHll& denseHll) const {
+  toDense(entries_.size(), entries_.data(), denseHll);
+}
+
+// static
+void SparseHll::toDense(const char* serialized, DenseHll& denseHll) {
+  auto stream = initializeInputStream(serialized);
+
+  auto size = stream.read<int16_t>();
+  toDense(
+      size,
+      reinterpret_cast<const uint32_t*>(serialized + stream.offset()),
+      denseHll);
+}
+
+// static
+void SparseHll::toDense(
+    size_t size,
+    const uint32_t* entries,
+    DenseHll& denseHll) {
   auto indexBitLength = denseHll.indexBitLength();
 
-  for (auto i = 0; i < entries_.size(); i++) {
-    auto entry = entries_[i];
-    auto index = entry >> (32 - indexBitLength);
+  // The entries are sorted by their 26-bit index, so the entries that map to
+  // the same dense bucket are next to each other. Only the largest value of
+  // each such run is inserted.
+  int32_t runIndex = -1;
+  int8_t runValue = 0;
+  for (auto i = 0; i < size; i++) {
+    auto entry = entries[i];
+    int32_t index = entry >> (32 - indexBitLength);
     auto shiftedValue = entry << indexBitLength;
     auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
 
@@ -253,7 +305,17 @@ void SparseHll::toDense(DenseHll& denseHll) const {
       zeros = bits + decodeValue(entry);
     }
 
-    denseHll.insert(index, zeros + 1);
+    if (index != runIndex) {
+      if (runIndex >= 0) {
+        denseHll.insert(runIndex, runValue);
+      }
+      runIndex = index;
+      runValue = 0;
+    }
+    runValue = std::max<int8_t>(runValue, zeros + 1);
+  }
+  if (runIndex >= 0) {
+    denseHll.insert(runIndex, runValue);
   }
 }
 
@@ -40,6 +40,12 @@ class SparseHll {
   /// Returns true if soft memory limit has been reached. False, otherwise.
   bool insertHash(uint64_t hash);
 
+  /// Inserts 'numHashes' hashes at once. The new entries are sorted and
+  /// merged with the existing ones in one pass instead of being inserted one
+  /// at a time. Returns true if soft memory limit has been reached. False,
+  /// otherwise.
+  bool insertHashes(const uint64_t* hashes, int32_t numHashes);
+
   int64_t cardinality() const;
 
   /// Returns cardinality estimate from the specified serialized digest.
@@ -65,6 +71,10 @@ class SparseHll {
   /// Merges state into provided instance of DenseHll.
   void toDense(DenseHll& denseHll) const;
 
+  /// Merges the state of a serialized instance into 'denseHll' without
+  /// deserializing it first.
+  static void toDense(const char* serialized, DenseHll& denseHll);
+
   /// Returns current memory usage.
   int32_t inMemorySize() const;
 
@@ -81,6 +91,9 @@ class SparseHll {
  private:
   void mergeWith(size_t otherSize, const uint32_t* otherEntries);
 
+  static void
+  toDense(size_t size, const uint32_t* entries, DenseHll& denseHll);
+
   /// A list of observed buckets. Each entry is a 32 bit integer encoding 26-bit
   /// bucket and 6-bit value (number of zeros in the input hash after the bucket
   /// + 1).
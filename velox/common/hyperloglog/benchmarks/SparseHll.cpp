@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/hyperloglog/SparseHll.h"
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "velox/common/memory/HashStringAllocator.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+using namespace facebook::velox;
+
+namespace {
+
+template <typename T>
+uint64_t hashOne(T value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// A benchmark for SparseHll inserts and the conversion to DenseHll.
+//
+// Compares inserting hashes one at a time with SparseHll::insertHash, which
+// shifts the sorted entries on every new bucket, to inserting them in one
+// batch with SparseHll::insertHashes. Also measures merging serialized sparse
+// digests into a DenseHll, which is what a final approx_distinct aggregation
+// does for groups that became dense.
+class SparseHllBenchmark {
+ public:
+  explicit SparseHllBenchmark(memory::MemoryPool* pool) : pool_(pool) {
+    for (auto i = 0; i < 8'000; ++i) {
+      hashes_.push_back(hashOne(i));
+    }
+    HashStringAllocator allocator(pool_);
+    for (auto i = 0; i < 100; ++i) {
+      common::hll::SparseHll hll(&allocator);
+      hll.insertHashes(hashes_.data() + i * 50, 2'000);
+      std::string serialized;
+      serialized.resize(hll.serializedSize());
+      hll.serialize(kIndexBitLength, serialized.data());
+      serializedHlls_.push_back(std::move(serialized));
+    }
+  }
+
+  void insert(int32_t numHashes, bool batch) {
+    folly::BenchmarkSuspender suspender;
+    HashStringAllocator allocator(pool_);
+    common::hll::SparseHll hll(&allocator);
+    suspender.dismiss();
+
+    if (batch) {
+      hll.insertHashes(hashes_.data(), numHashes);
+    } else {
+      for (auto i = 0; i < numHashes; ++i) {
+        hll.insertHash(hashes_[i]);
+      }
+    }
+    folly::doNotOptimizeAway(hll.cardinality());
+  }
+
+  void toDense() {
+    folly::BenchmarkSuspender suspender;
+    HashStringAllocator allocator(pool_);
+    common::hll::DenseHll hll(kIndexBitLength, &allocator);
+    suspender.dismiss();
+
+    for (const auto& serialized : serializedHlls_) {
+      common::hll::SparseHll::toDense(serialized.data(), hll);
+    }
+    folly::doNotOptimizeAway(hll.cardinality());
+  }
+
+ private:
+  static constexpr int8_t kIndexBitLength = 11;
+
+  memory::MemoryPool* pool_;
+  std::vector<uint64_t> hashes_;
+  std::vector<std::string> serializedHlls_;
+};
+
+} // namespace
+
+std::unique_ptr<SparseHllBenchmark> benchmark;
+
+BENCHMARK(insertHash1K) {
+  benchmark->insert(1'000, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes1K) {
+  benchmark->insert(1'000, true);
+}
+
+BENCHMARK(insertHash8K) {
+  benchmark->insert(8'000, false);
+}
+
+BENCHMARK_RELATIVE(insertHashes8K) {
+  benchmark->insert(8'000, true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(toDenseSerialized) {
+  benchmark->toDense();
+}
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+
+  memory::MemoryManager::initialize({});
+  auto rootPool = memory::memoryManager()->addRootPool();
+  auto pool = rootPool->addLeafChild("bm");
+  benchmark = std::make_unique<SparseHllBenchmark>(pool.get());
+
+  folly::runBenchmarks();
+  return 0;
+}
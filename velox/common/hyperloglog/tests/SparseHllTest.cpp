@@ -144,6 +144,28 @@ TEST_F(SparseHllTest, highCardinality) {
   ASSERT_EQ(1'000, SparseHll::cardinality(serialized.data()));
 }
 
+TEST_F(SparseHllTest, insertHashes) {
+  SparseHll expected{&allocator_};
+  SparseHll sparseHll{&allocator_};
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 1'000; i++) {
+    hashes.push_back(hashOne(i % 700));
+    expected.insertHash(hashes.back());
+  }
+  // Inserts in batches that overlap the existing entries.
+  ASSERT_FALSE(sparseHll.insertHashes(hashes.data(), 0));
+  ASSERT_FALSE(sparseHll.insertHashes(hashes.data(), 300));
+  ASSERT_FALSE(sparseHll.insertHashes(hashes.data() + 300, 700));
+
+  sparseHll.verify();
+  ASSERT_EQ(expected.cardinality(), sparseHll.cardinality());
+  ASSERT_EQ(serialize(11, expected), serialize(11, sparseHll));
+
+  SparseHll limited{&allocator_};
+  limited.setSoftMemoryLimit(4 * 100);
+  ASSERT_TRUE(limited.insertHashes(hashes.data(), hashes.size()));
+}
+
 namespace {
 template <typename T>
 std::vector<T> sequence(T start, T end) {
@@ -207,6 +229,13 @@ TEST_P(SparseHllToDenseTest, toDense) {
   sparseHll.toDense(denseHll);
   ASSERT_EQ(denseHll.cardinality(), expectedHll.cardinality());
   ASSERT_EQ(serialize(denseHll), serialize(expectedHll));
+
+  std::string serializedSparse;
+  serializedSparse.resize(sparseHll.serializedSize());
+  sparseHll.serialize(indexBitLength, serializedSparse.data());
+  DenseHll fromSerialized{indexBitLength, &allocator_};
+  SparseHll::toDense(serializedSparse.data(), fromSerialized);
+  ASSERT_EQ(serialize(fromSerialized), serialize(expectedHll));
 }
 
 TEST_P(SparseHllToDenseTest, testNumberOfZeros) {
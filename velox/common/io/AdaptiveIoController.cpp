@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/AdaptiveIoController.h"
+
+#include <algorithm>
+
+namespace facebook::velox::io {
+
+// static
+ReaderOptions AdaptiveIoController::adapt(
+    const ReaderOptions& options,
+    const StoragePerformance& performance) {
+  ReaderOptions adapted(options);
+  const auto estimate = performance.estimate();
+  if (!estimate.has_value()) {
+    return adapted;
+  }
+  const double breakEven = estimate->latencyMicros * estimate->bytesPerMicro;
+  const auto distance = static_cast<int32_t>(std::clamp<double>(
+      breakEven, kMinCoalesceDistance, kMaxCoalesceDistance));
+  adapted.setMaxCoalesceDistance(distance);
+  // Round to whole 64K so that quanta map to whole pages.
+  constexpr int64_t kQuantumGranularity = 64 << 10;
+  int64_t quantum = static_cast<int64_t>(distance) * kQuantumLatencies;
+  quantum = (quantum + kQuantumGranularity - 1) / kQuantumGranularity *
+      kQuantumGranularity;
+  quantum = std::max<int64_t>(quantum, kMinLoadQuantum);
+  adapted.setLoadQuantum(
+      static_cast<int32_t>(std::min<int64_t>(quantum, options.loadQuantum())));
+  return adapted;
+}
+
+} // namespace facebook::velox::io
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/io/IoStatistics.h"
+#include "velox/common/io/Options.h"
+
+namespace facebook::velox::io {
+
+/// Chooses the coalesce distance and load quantum of reads from a storage
+/// system from its StoragePerformance. Reading a gap between two ranges costs
+/// gap / throughput while issuing a separate read costs the latency, so ranges
+/// are coalesced if the gap is under latency * throughput. Loads of
+/// kQuantumLatencies times that distance spend at most about 1 /
+/// kQuantumLatencies of their time in latency.
+class AdaptiveIoController {
+ public:
+  static constexpr int32_t kMinCoalesceDistance = 8 << 10;
+  static constexpr int32_t kMaxCoalesceDistance = 16 << 20;
+  static constexpr int32_t kMinLoadQuantum = 1 << 20;
+  static constexpr int32_t kQuantumLatencies = 4;
+
+  /// Returns 'options' with the coalesce distance and load quantum chosen from
+  /// 'performance'. The load quantum stays at most the one in 'options', which
+  /// bounds the size of cache entries and read buffers. Returns 'options'
+  /// unchanged if 'performance' has no estimate.
+  static ReaderOptions adapt(
+      const ReaderOptions& options,
+      const StoragePerformance& performance);
+};
+
+} // namespace facebook::velox::io
@@ -15,13 +15,118 @@
  */
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <atomic>
 #include <utility>
 
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
 #include "velox/common/io/IoStatistics.h"
 
 namespace facebook::velox::io {
 
+void LatencyHistogram::record(uint64_t micros) {
+  // Bucket i holds latencies in [2^(i-1), 2^i).
+  const int32_t bucket = std::min<int32_t>(
+      micros == 0 ? 0 : 64 - __builtin_clzll(micros), kNumBuckets - 1);
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const {
+  const uint64_t total = count_;
+  if (total == 0) {
+    return 0;
+  }
+  const auto threshold = static_cast<uint64_t>(total * percentile / 100);
+  uint64_t sum = 0;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    sum += buckets_[i].load(std::memory_order_relaxed);
+    if (sum > threshold) {
+      return 1UL << i;
+    }
+  }
+  return 1UL << (kNumBuckets - 1);
+}
+
+// static
+StoragePerformance& StoragePerformance::forPath(std::string_view path) {
+  static folly::Synchronized<
+      folly::F14FastMap<std::string, std::unique_ptr<StoragePerformance>>>
+      models;
+  const std::string fileSystem(fileSystemOf(path));
+  {
+    auto readModels = models.rlock();
+    auto it = readModels->find(fileSystem);
+    if (it != readModels->end()) {
+      return *it->second;
+    }
+  }
+  auto writeModels = models.wlock();
+  auto& model = (*writeModels)[fileSystem];
+  if (model == nullptr) {
+    model = std::make_unique<StoragePerformance>();
+  }
+  return *model;
+}
+
+// static
+std::string_view StoragePerformance::fileSystemOf(std::string_view path) {
+  const auto pos = path.find("://");
+  if (pos == std::string_view::npos || pos == 0) {
+    return "file";
+  }
+  return path.substr(0, pos);
+}
+
+void StoragePerformance::record(uint64_t bytes, uint64_t micros) {
+  const double x = bytes;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  weight_ = weight_ * kDecay + 1;
+  sumX_ = sumX_ * kDecay + x;
+  sumY_ = sumY_ * kDecay + y;
+  sumXX_ = sumXX_ * kDecay + x * x;
+  sumXY_ = sumXY_ * kDecay + x * y;
+  ++numSamples_;
+}
+
+uint64_t StoragePerformance::numSamples() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numSamples_;
+}
+
+std::optional<StoragePerformance::Estimate> StoragePerformance::estimate()
+    const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numSamples_ < kMinSamples) {
+    return std::nullopt;
+  }
+  const double varianceX = weight_ * sumXX_ - sumX_ * sumX_;
+  // Sizes that differ by less than about 1% of their magnitude do not
+  // separate latency from transfer time.
+  if (varianceX <= 1e-4 * weight_ * sumXX_) {
+    return std::nullopt;
+  }
+  const double slope = (weight_ * sumXY_ - sumX_ * sumY_) / varianceX;
+  if (slope <= 0) {
+    return std::nullopt;
+  }
+  const double intercept = (sumY_ - slope * sumX_) / weight_;
+  return Estimate{std::max(intercept, 0.0), 1 / slope};
+}
+
+void StoragePerformance::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  weight_ = 0;
+  sumX_ = 0;
+  sumY_ = 0;
+  sumXX_ = 0;
+  sumXY_ = 0;
+  numSamples_ = 0;
+}
+
 uint64_t IoStatistics::rawBytesRead() const {
   return rawBytesRead_.load(std::memory_order_relaxed);
 }
@@ -111,6 +216,8 @@ void IoStatistics::merge(const IoStatistics& other) {
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  adaptiveCoalesceDistance_.merge(other.adaptiveCoalesceDistance_);
+  adaptiveLoadQuantum_.merge(other.adaptiveLoadQuantum_);
   std::lock_guard<std::mutex> l(operationStatsMutex_);
   for (auto& item : other.operationStats_) {
     operationStats_[item.first].merge(item.second);
@@ -16,10 +16,13 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <folly/dynamic.h>
@@ -89,6 +92,72 @@ class IoCounter {
   std::atomic<uint64_t> max_{0};
 };
 
+/// Histogram of latencies in microseconds with power of 2 buckets. Lock free.
+/// Used for estimating latency percentiles, e.g. for sending a hedged request
+/// when a storage read takes longer than most.
+class LatencyHistogram {
+ public:
+  void record(uint64_t micros);
+
+  uint64_t count() const {
+    return count_;
+  }
+
+  /// Returns the upper bound of the bucket of the 'percentile' (0 - 100)
+  /// latency or 0 if nothing is recorded.
+  uint64_t percentile(double percentile) const;
+
+ private:
+  static constexpr int32_t kNumBuckets = 40;
+
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+  std::atomic<uint64_t> count_{0};
+};
+
+/// Model of the read performance of a storage system fitted from samples of
+/// read size and elapsed time as 'micros = latency + bytes / throughput'. The
+/// fit is a least squares line over exponentially decayed samples so that it
+/// follows changes in the storage. Thread-safe.
+class StoragePerformance {
+ public:
+  struct Estimate {
+    /// Fixed cost of a read.
+    double latencyMicros;
+    double bytesPerMicro;
+  };
+
+  /// Returns the process-wide model for the file system of 'path'.
+  static StoragePerformance& forPath(std::string_view path);
+
+  /// Returns the scheme of 'path', e.g. 's3' for 's3://bucket/key', or 'file'
+  /// if 'path' has no scheme.
+  static std::string_view fileSystemOf(std::string_view path);
+
+  void record(uint64_t bytes, uint64_t micros);
+
+  uint64_t numSamples() const;
+
+  /// Returns the fitted latency and throughput or std::nullopt if there are
+  /// fewer than kMinSamples samples or their sizes are too uniform to tell
+  /// latency from transfer time.
+  std::optional<Estimate> estimate() const;
+
+  void clear();
+
+ private:
+  static constexpr double kDecay = 0.99;
+  static constexpr uint64_t kMinSamples = 20;
+
+  mutable std::mutex mutex_;
+  // Decayed sums over samples of x = bytes and y = micros.
+  double weight_{0};
+  double sumX_{0};
+  double sumY_{0};
+  double sumXX_{0};
+  double sumXY_{0};
+  uint64_t numSamples_{0};
+};
+
 class IoStatistics {
  public:
   uint64_t rawBytesRead() const;
@@ -125,6 +194,14 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& adaptiveCoalesceDistance() {
+    return adaptiveCoalesceDistance_;
+  }
+
+  IoCounter& adaptiveLoadQuantum() {
+    return adaptiveLoadQuantum_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -168,6 +245,11 @@ class IoStatistics {
   // or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Coalesce distances and load quanta chosen by AdaptiveIoController, one
+  // sample per file.
+  IoCounter adaptiveCoalesceDistance_;
+  IoCounter adaptiveLoadQuantum_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
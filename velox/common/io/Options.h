@@ -16,8 +16,13 @@
 
 #pragma once
 
+#include "velox/common/io/PrefetchBudget.h"
 #include "velox/common/memory/Memory.h"
 
+namespace facebook::velox::cache {
+class CacheQuota;
+}
+
 namespace facebook::velox::io {
 
 constexpr uint64_t DEFAULT_AUTO_PRELOAD_SIZE =
@@ -77,6 +82,9 @@ class ReaderOptions {
     prefetchRowGroups_ = other.prefetchRowGroups_;
     loadQuantum_ = other.loadQuantum_;
     noCacheRetention_ = other.noCacheRetention_;
+    adaptiveIoTuning_ = other.adaptiveIoTuning_;
+    cacheQuota_ = other.cacheQuota_;
+    prefetchBudget_ = other.prefetchBudget_;
     return *this;
   }
 
@@ -163,6 +171,41 @@ class ReaderOptions {
     noCacheRetention_ = noCacheRetention;
   }
 
+  bool adaptiveIoTuning() const {
+    return adaptiveIoTuning_;
+  }
+
+  /// If true, the load quantum and maximum coalesce distance are chosen from
+  /// the observed latency and throughput of the file system of the file. The
+  /// configured load quantum is then an upper bound. See
+  /// AdaptiveIoController.
+  ReaderOptions& setAdaptiveIoTuning(bool adaptiveIoTuning) {
+    adaptiveIoTuning_ = adaptiveIoTuning;
+    return *this;
+  }
+
+  const std::shared_ptr<cache::CacheQuota>& cacheQuota() const {
+    return cacheQuota_;
+  }
+
+  /// Sets the quota to which cache entries created by the reader are charged.
+  ReaderOptions& setCacheQuota(std::shared_ptr<cache::CacheQuota> quota) {
+    cacheQuota_ = std::move(quota);
+    return *this;
+  }
+
+  const std::shared_ptr<PrefetchBudget>& prefetchBudget() const {
+    return prefetchBudget_;
+  }
+
+  /// Sets the budget that bounds the bytes the reader loads ahead of the
+  /// unit being read. If not set, only prefetchRowGroups() bounds the
+  /// lookahead.
+  ReaderOptions& setPrefetchBudget(std::shared_ptr<PrefetchBudget> budget) {
+    prefetchBudget_ = std::move(budget);
+    return *this;
+  }
+
  protected:
   velox::memory::MemoryPool* memoryPool_;
   uint64_t autoPreloadLength_;
@@ -172,5 +215,8 @@ class ReaderOptions {
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
   bool noCacheRetention_{false};
+  bool adaptiveIoTuning_{false};
+  std::shared_ptr<cache::CacheQuota> cacheQuota_;
+  std::shared_ptr<PrefetchBudget> prefetchBudget_;
 };
 } // namespace facebook::velox::io
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace facebook::velox::io {
+
+/// Bounds the bytes that readers load ahead of their consumers. One budget is
+/// shared by all the readers of a scan driver, including the readers of the
+/// splits it preloads, so that reading ahead within and across splits does
+/// not grow memory with the number of open files. Thread-safe.
+class PrefetchBudget {
+ public:
+  explicit PrefetchBudget(uint64_t maxBytes) : maxBytes_(maxBytes) {}
+
+  /// Reserves 'bytes' and returns true if they fit in the budget. Returns
+  /// false and reserves nothing otherwise.
+  bool tryReserve(uint64_t bytes) {
+    auto reserved = reservedBytes_.load();
+    do {
+      if (reserved + bytes > maxBytes_) {
+        return false;
+      }
+    } while (!reservedBytes_.compare_exchange_weak(reserved, reserved + bytes));
+    return true;
+  }
+
+  /// Returns 'bytes' reserved by a previous successful tryReserve().
+  void release(uint64_t bytes) {
+    reservedBytes_ -= bytes;
+  }
+
+  uint64_t maxBytes() const {
+    return maxBytes_;
+  }
+
+  uint64_t reservedBytes() const {
+    return reservedBytes_;
+  }
+
+ private:
+  const uint64_t maxBytes_;
+  std::atomic<uint64_t> reservedBytes_{0};
+};
+
+} // namespace facebook::velox::io
@@ -468,6 +468,22 @@ void HashStringAllocator::free(Header* header) {
   } while (headerToFree != nullptr);
 }
 
+HashStringAllocator::Header* HashStringAllocator::compact(
+    Header* header,
+    int32_t size,
+    int32_t numReserveBytes) {
+  if (!header->isContinued()) {
+    return header;
+  }
+  VELOX_CHECK_GE(size, 0);
+  VELOX_CHECK_GE(numReserveBytes, 0);
+  auto* compacted = allocate(size + numReserveBytes);
+  auto stream = prepareRead(header, size);
+  stream.readBytes(compacted->begin(), size);
+  free(header);
+  return compacted;
+}
+
 // static
 int64_t HashStringAllocator::offset(Header* header, Position position) {
   static const int64_t kOutOfRange = -1;
@@ -300,6 +300,14 @@ class HashStringAllocator : public StreamArena {
   /// kContinued set) to the free list.
   void free(Header* header);
 
+  /// Copies the first 'size' payload bytes of the possibly multi-part
+  /// allocation starting at 'header' into a single contiguous block with
+  /// 'numReserveBytes' of space after them and frees 'header' with its
+  /// continuations. Returns the new block, or 'header' if it is not
+  /// continued. Positions in the old allocation are invalidated. Used to
+  /// defragment allocations that are extended in many small increments.
+  Header* compact(Header* header, int32_t size, int32_t numReserveBytes = 0);
+
   /// Returns a lower bound on bytes available without growing 'this'. This is
   /// the sum of free block sizes minus size of pointer for each. We subtract
   /// the pointer because in the worst case we would have one allocation that
@@ -51,6 +51,8 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.capacity = options.allocatorCapacity;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numNumaNodes = options.numNumaNodes;
+    mmapOptions.pinThreadsToNumaNode = options.pinThreadsToNumaNode;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -73,7 +75,12 @@ std::unique_ptr<MemoryArbitrator> createArbitrator(
        .memoryReclaimWaitMs = options.memoryReclaimWaitMs,
        .globalArbitrationEnabled = options.globalArbitrationEnabled,
        .arbitrationStateCheckCb = options.arbitrationStateCheckCb,
-       .checkUsageLeak = options.checkUsageLeak});
+       .checkUsageLeak = options.checkUsageLeak,
+       .backgroundArbitrationIntervalMs =
+           options.backgroundArbitrationIntervalMs,
+       .backgroundArbitrationFreeCapacityRatio =
+           options.backgroundArbitrationFreeCapacityRatio,
+       .lowPriorityPauseMs = options.lowPriorityPauseMs});
 }
 
 std::vector<std::shared_ptr<MemoryPool>> createSharedLeafMemoryPools(
@@ -99,6 +106,8 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      memoryPoolThreadCacheBytes_(options.memoryPoolThreadCacheBytes),
+      memoryPoolAllocationSampleBytes_(options.memoryPoolAllocationSampleBytes),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       poolGrowCb_([&](MemoryPool* pool, uint64_t targetBytes) {
         return growPool(pool, targetBytes);
@@ -119,7 +128,10 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
               .trackUsage = options.trackDefaultUsage,
               .debugEnabled = options.debugEnabled,
               .coreOnAllocationFailureEnabled =
-                  options.coreOnAllocationFailureEnabled})},
+                  options.coreOnAllocationFailureEnabled,
+              .threadCacheBytes = options.memoryPoolThreadCacheBytes,
+              .allocationSampleBytes =
+                  options.memoryPoolAllocationSampleBytes})},
       spillPool_{addLeafPool("__sys_spilling__")},
       sharedLeafPools_(createSharedLeafMemoryPools(*sysRoot_)) {
   VELOX_CHECK_NOT_NULL(allocator_);
@@ -139,6 +151,7 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
 }
 
 MemoryManager::~MemoryManager() {
+  arbitrator_->shutdown();
   if (pools_.size() != 0) {
     const auto errMsg = fmt::format(
         "pools_.size() != 0 ({} vs {}). There are unexpected alive memory "
@@ -226,6 +239,8 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.trackUsage = true;
   options.debugEnabled = debugEnabled_;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.threadCacheBytes = memoryPoolThreadCacheBytes_;
+  options.allocationSampleBytes = memoryPoolAllocationSampleBytes_;
 
   std::unique_lock guard{mutex_};
   if (pools_.find(poolName) != pools_.end()) {
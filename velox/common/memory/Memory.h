@@ -81,6 +81,14 @@ struct MemoryManagerOptions {
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
+  /// If non-zero, the thread-safe leaf memory pools serve small allocations
+  /// from per-thread caches. See MemoryPool::Options::threadCacheBytes.
+  int32_t memoryPoolThreadCacheBytes{0};
+
+  /// If non-zero, the memory pools sample their allocations to make heap
+  /// profiles. See MemoryPool::Options::allocationSampleBytes.
+  int64_t memoryPoolAllocationSampleBytes{0};
+
   /// ================== 'MemoryAllocator' settings ==================
   /// Specifies the max memory allocation capacity in bytes enforced by
   /// MemoryAllocator, default unlimited.
@@ -121,6 +129,18 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t maxMallocBytes{3072};
 
+  /// Number of NUMA nodes with their own size classes and arenas. 1 disables
+  /// NUMA awareness and 0 uses the number of nodes of the host.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  int32_t numNumaNodes{1};
+
+  /// If true, pins the threads that allocate memory to the CPUs of their NUMA
+  /// node. Only applies if there is more than one NUMA node.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool pinThreadsToNumaNode{false};
+
   /// The memory allocations with size smaller than this threshold check the
   /// capacity with local sharded counter to reduce the lock contention on the
   /// global allocation counter. The sharded local counters reserve/release
@@ -181,6 +201,18 @@ struct MemoryManagerOptions {
   /// memory pools.
   bool globalArbitrationEnabled{false};
 
+  /// If non-zero, the interval in milliseconds of the background arbitration
+  /// which reclaims memory ahead of the predicted memory growth of the
+  /// queries to keep 'backgroundArbitrationFreeCapacityRatio' of the
+  /// arbitrator capacity free.
+  uint64_t backgroundArbitrationIntervalMs{0};
+
+  double backgroundArbitrationFreeCapacityRatio{0.1};
+
+  /// If non-zero, the max time in milliseconds a query waits for memory while
+  /// a query of higher priority runs before the arbitration fails.
+  uint64_t lowPriorityPauseMs{0};
+
   /// Provided by the query system to validate the state after a memory pool
   /// enters arbitration if not null. For instance, Prestissimo provides
   /// callback to check if a memory arbitration request is issued from a driver
@@ -315,6 +347,8 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const int32_t memoryPoolThreadCacheBytes_;
+  const int64_t memoryPoolAllocationSampleBytes_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
@@ -93,6 +93,23 @@ class MemoryArbitrator {
     /// TODO: deprecate this flag after all the existing memory leak use cases
     /// have been fixed.
     bool checkUsageLeak{true};
+
+    /// If non-zero, the arbitrator checks the free capacity and the memory
+    /// growth of the query memory pools every this many milliseconds in a
+    /// background thread. If the free capacity is predicted to fall below
+    /// 'backgroundArbitrationFreeCapacityRatio' of the capacity by the next
+    /// check, it reclaims the difference ahead of the arbitration requests,
+    /// spilling the fastest growing queries first.
+    uint64_t backgroundArbitrationIntervalMs{0};
+
+    /// The ratio of the capacity that background arbitration keeps free.
+    double backgroundArbitrationFreeCapacityRatio{0.1};
+
+    /// If non-zero, a query that fails to get memory while a query of higher
+    /// MemoryReclaimer::priority() runs is paused for up to this many
+    /// milliseconds instead of failing or aborting another query. It retries
+    /// whenever memory is returned to the arbitrator.
+    uint64_t lowPriorityPauseMs{0};
   };
 
   using Factory = std::function<std::unique_ptr<MemoryArbitrator>(
@@ -251,6 +268,11 @@ class MemoryArbitrator {
   /// Returns the debug string of this memory arbitrator.
   virtual std::string toString() const = 0;
 
+  /// Invoked by the memory manager on destruction to stop the background
+  /// work of this memory arbitrator, if any, before checking for leaked
+  /// memory pools.
+  virtual void shutdown() {}
+
  protected:
   explicit MemoryArbitrator(const Config& config)
       : capacity_(config.capacity),
@@ -391,6 +413,13 @@ class MemoryReclaimer {
   /// error exposure.
   virtual void abort(MemoryPool* pool, const std::exception_ptr& error);
 
+  /// Returns the priority of the query of a root memory pool in memory
+  /// arbitration. The arbitrator spills and aborts the queries of lower
+  /// priority first and never aborts a query to grow one of lower priority.
+  virtual int32_t priority() const {
+    return 0;
+  }
+
  protected:
   MemoryReclaimer() = default;
 };
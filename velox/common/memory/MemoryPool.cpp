@@ -16,13 +16,18 @@
 
 #include "velox/common/memory/MemoryPool.h"
 
+#include <folly/Random.h>
+#include <folly/container/F14Map.h>
 #include <signal.h>
+#include <cmath>
+#include <fstream>
 #include <set>
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/StackTrace.h"
 #include "velox/common/testutil/TestValue.h"
 
 #include <re2/re2.h>
@@ -33,6 +38,8 @@ using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::memory {
 namespace {
+std::atomic<uint64_t> nextPoolId{0};
+
 // Check if memory operation is allowed and increment the named stats.
 #define CHECK_AND_INC_MEM_OP_STATS(stats)                             \
   do {                                                                \
@@ -161,6 +168,14 @@ std::string capacityToString(int64_t capacity) {
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     leakCheckDbg();                    \
   }
+#define SAMPLE_ALLOC(...)                           \
+  if (FOLLY_UNLIKELY(allocationSampleBytes_ > 0)) { \
+    sampleAlloc(__VA_ARGS__);                       \
+  }
+#define SAMPLE_FREE(...)                            \
+  if (FOLLY_UNLIKELY(allocationSampleBytes_ > 0)) { \
+    sampleFree(__VA_ARGS__);                        \
+  }
 } // namespace
 
 std::string MemoryPool::Stats::toString() const {
@@ -222,8 +237,12 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
-      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
+      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      threadCacheBytes_(options.threadCacheBytes),
+      allocationSampleBytes_(options.allocationSampleBytes) {
   VELOX_CHECK(!isRoot() || !isLeaf());
+  VELOX_CHECK_GE(threadCacheBytes_, 0);
+  VELOX_CHECK_GE(allocationSampleBytes_, 0);
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
   MemoryAllocator::alignmentCheck(0, alignment_);
@@ -407,6 +426,22 @@ size_t MemoryPool::preferredSize(size_t size) {
   return lower * 2;
 }
 
+char* MemoryPool::allocateHugePageAligned(
+    MachinePageCount numPages,
+    ContiguousAllocation& out) {
+  const auto pagesInHugePage = AllocationTraits::numPagesInHugePage();
+  if (numPages < pagesInHugePage) {
+    allocateContiguous(numPages, out);
+    return out.data<char>();
+  }
+  numPages = bits::roundUp(numPages, pagesInHugePage);
+  allocateContiguous(numPages + pagesInHugePage, out);
+  auto range = out.hugePageRange();
+  VELOX_CHECK(range.has_value());
+  VELOX_CHECK_GE(range->size(), AllocationTraits::pageBytes(numPages));
+  return range->data();
+}
+
 MemoryPoolImpl::MemoryPoolImpl(
     MemoryManager* memoryManager,
     const std::string& name,
@@ -425,8 +460,15 @@ MemoryPoolImpl::MemoryPoolImpl(
       reclaimer_(std::move(reclaimer)),
       // The memory manager sets the capacity through grow() according to the
       // actually used memory arbitration policy.
-      capacity_(parent_ != nullptr ? kMaxMemory : 0) {
+      capacity_(parent_ != nullptr ? kMaxMemory : 0),
+      id_(nextPoolId++),
+      useThreadCache_(
+          isLeaf() && trackUsage_ && threadSafe_ && !debugEnabled_ &&
+          allocationSampleBytes_ == 0 && threadCacheBytes_ > 0) {
   VELOX_CHECK(options.threadSafe || isLeaf());
+  if (allocationSampleBytes_ > 0) {
+    bytesUntilSample_ = nextSampleInterval();
+  }
   VELOX_CHECK(
       isRoot() || (destructionCb_ == nullptr && growCapacityCb_ == nullptr),
       "Only root memory pool allows to set destruction and capacity grow callbacks: {}",
@@ -434,6 +476,9 @@ MemoryPoolImpl::MemoryPoolImpl(
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
+  if (useThreadCache_) {
+    flushThreadCaches();
+  }
   DEBUG_LEAK_CHECK();
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
@@ -491,6 +536,9 @@ MemoryPool::Stats MemoryPoolImpl::statsLocked() const {
 void* MemoryPoolImpl::allocate(int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto alignedSize = sizeAlign(size);
+  if (useThreadCache(alignedSize)) {
+    return allocateThreadCached(alignedSize);
+  }
   reserve(alignedSize);
   void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
@@ -503,6 +551,7 @@ void* MemoryPoolImpl::allocate(int64_t size) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  SAMPLE_ALLOC(buffer, size);
   return buffer;
 }
 
@@ -510,6 +559,11 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto size = sizeEach * numEntries;
   const auto alignedSize = sizeAlign(size);
+  if (useThreadCache(alignedSize)) {
+    void* buffer = allocateThreadCached(alignedSize);
+    ::memset(buffer, 0, size);
+    return buffer;
+  }
   reserve(alignedSize);
   void* buffer = allocator_->allocateZeroFilled(alignedSize);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
@@ -523,12 +577,21 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  SAMPLE_ALLOC(buffer, size);
   return buffer;
 }
 
 void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto alignedNewSize = sizeAlign(newSize);
+  if (useThreadCache(alignedNewSize)) {
+    void* newP = allocateThreadCached(alignedNewSize);
+    if (p != nullptr) {
+      ::memcpy(newP, p, std::min(size, newSize));
+      free(p, size);
+    }
+    return newP;
+  }
   reserve(alignedNewSize);
 
   void* newP = allocator_->allocateBytes(alignedNewSize, alignment_);
@@ -543,6 +606,7 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(newP, newSize);
+  SAMPLE_ALLOC(newP, newSize);
   if (p != nullptr) {
     ::memcpy(newP, p, std::min(size, newSize));
     free(p, size);
@@ -553,11 +617,184 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
 void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const auto alignedSize = sizeAlign(size);
+  if (useThreadCache(alignedSize)) {
+    freeThreadCached(p, alignedSize);
+    return;
+  }
   DEBUG_RECORD_FREE(p, size);
+  SAMPLE_FREE(p);
   allocator_->freeBytes(p, alignedSize);
   release(alignedSize);
 }
 
+struct MemoryPoolImpl::ThreadCache {
+  explicit ThreadCache(MemoryPoolImpl* _pool) : pool(_pool) {}
+
+  // Returns the cached memory to the allocator and the reservation to 'pool'.
+  // Invoked with 'mutex' held when the thread exits or 'pool' is destroyed,
+  // whichever comes first.
+  void flushLocked() {
+    if (pool == nullptr) {
+      return;
+    }
+    int64_t bytes = reservedBytes;
+    for (int32_t i = 0; i < kNumThreadCacheClasses; ++i) {
+      const int64_t classSize = kMinThreadCachedSize << i;
+      for (auto* block : freeBlocks[i]) {
+        pool->allocator_->freeBytes(block, classSize);
+        bytes += classSize;
+      }
+      freeBlocks[i].clear();
+    }
+    reservedBytes = 0;
+    cachedBytes = 0;
+    if (bytes > 0) {
+      pool->release(bytes);
+    }
+    pool = nullptr;
+  }
+
+  // Serializes the flushes by the thread and by the pool. The other fields
+  // are only accessed by the thread while 'pool' is alive.
+  std::mutex mutex;
+  // Null after the cache is flushed.
+  MemoryPoolImpl* pool;
+  // Bytes reserved from 'pool' by the thread and not used by any allocation.
+  int64_t reservedBytes{0};
+  // Total size of 'freeBlocks'.
+  int64_t cachedBytes{0};
+  // Freed blocks by size class.
+  std::array<std::vector<void*>, kNumThreadCacheClasses> freeBlocks;
+};
+
+// static
+int32_t MemoryPoolImpl::threadCacheClass(int64_t size) {
+  const uint64_t classSize =
+      bits::nextPowerOfTwo(std::max(size, kMinThreadCachedSize));
+  return bits::countLeadingZeros<uint64_t>(kMinThreadCachedSize) -
+      bits::countLeadingZeros(classSize);
+}
+
+MemoryPoolImpl::ThreadCache& MemoryPoolImpl::threadCache() {
+  struct ThreadCaches {
+    ~ThreadCaches() {
+      for (auto& [id, cache] : caches) {
+        std::lock_guard<std::mutex> l(cache->mutex);
+        cache->flushLocked();
+      }
+    }
+
+    // Drops the flushed caches of destroyed pools.
+    void maybePrune() {
+      if (caches.size() < pruneSize) {
+        return;
+      }
+      for (auto it = caches.begin(); it != caches.end();) {
+        std::lock_guard<std::mutex> l(it->second->mutex);
+        if (it->second->pool == nullptr) {
+          it = caches.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      pruneSize = std::max<size_t>(16, caches.size() * 2);
+    }
+
+    folly::F14FastMap<uint64_t, std::shared_ptr<ThreadCache>> caches;
+    size_t pruneSize{16};
+  };
+  thread_local ThreadCaches threadCaches;
+
+  auto it = threadCaches.caches.find(id_);
+  if (FOLLY_LIKELY(it != threadCaches.caches.end())) {
+    return *it->second;
+  }
+  threadCaches.maybePrune();
+  auto cache = std::make_shared<ThreadCache>(this);
+  {
+    std::lock_guard<std::mutex> l(threadCachesMutex_);
+    // Drops the caches flushed by exited threads.
+    threadCaches_.erase(
+        std::remove_if(
+            threadCaches_.begin(),
+            threadCaches_.end(),
+            [](const auto& threadCache) {
+              std::lock_guard<std::mutex> cacheLock(threadCache->mutex);
+              return threadCache->pool == nullptr;
+            }),
+        threadCaches_.end());
+    threadCaches_.push_back(cache);
+  }
+  return *threadCaches.caches.emplace(id_, std::move(cache)).first->second;
+}
+
+void* MemoryPoolImpl::allocateThreadCached(int64_t alignedSize) {
+  const auto sizeClass = threadCacheClass(alignedSize);
+  const int64_t classSize = kMinThreadCachedSize << sizeClass;
+  auto& cache = threadCache();
+  auto& blocks = cache.freeBlocks[sizeClass];
+  if (!blocks.empty()) {
+    void* buffer = blocks.back();
+    blocks.pop_back();
+    cache.cachedBytes -= classSize;
+    return buffer;
+  }
+  if (cache.reservedBytes < classSize) {
+    const int64_t quantum = std::max<int64_t>(threadCacheBytes_, classSize);
+    try {
+      reserve(quantum);
+      cache.reservedBytes += quantum;
+    } catch (const VeloxRuntimeError& e) {
+      // Near the capacity limit, only reserve for this allocation.
+      if (e.errorCode() != error_code::kMemCapExceeded ||
+          quantum == classSize) {
+        throw;
+      }
+      reserve(classSize);
+      cache.reservedBytes += classSize;
+    }
+  }
+  void* buffer = allocator_->allocateBytes(classSize, alignment_);
+  if (FOLLY_UNLIKELY(buffer == nullptr)) {
+    handleAllocationFailure(fmt::format(
+        "{} failed with {} from {} {}",
+        __FUNCTION__,
+        succinctBytes(alignedSize),
+        toString(),
+        allocator_->getAndClearFailureMessage()));
+  }
+  cache.reservedBytes -= classSize;
+  return buffer;
+}
+
+void MemoryPoolImpl::freeThreadCached(void* p, int64_t alignedSize) {
+  const auto sizeClass = threadCacheClass(alignedSize);
+  const int64_t classSize = kMinThreadCachedSize << sizeClass;
+  auto& cache = threadCache();
+  if (cache.cachedBytes + classSize <= threadCacheBytes_) {
+    cache.freeBlocks[sizeClass].push_back(p);
+    cache.cachedBytes += classSize;
+    return;
+  }
+  allocator_->freeBytes(p, classSize);
+  cache.reservedBytes += classSize;
+  // Keeps one quantum of unused reservation for the next allocations.
+  if (cache.reservedBytes > 2 * threadCacheBytes_) {
+    const int64_t freeable = cache.reservedBytes - threadCacheBytes_;
+    cache.reservedBytes = threadCacheBytes_;
+    release(freeable);
+  }
+}
+
+void MemoryPoolImpl::flushThreadCaches() {
+  std::lock_guard<std::mutex> l(threadCachesMutex_);
+  for (auto& cache : threadCaches_) {
+    std::lock_guard<std::mutex> cacheLock(cache->mutex);
+    cache->flushLocked();
+  }
+  threadCaches_.clear();
+}
+
 void MemoryPoolImpl::allocateNonContiguous(
     MachinePageCount numPages,
     Allocation& out,
@@ -571,6 +808,7 @@ void MemoryPoolImpl::allocateNonContiguous(
       "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
       this);
   DEBUG_RECORD_FREE(out);
+  SAMPLE_FREE(out);
   if (!allocator_->allocateNonContiguous(
           numPages,
           out,
@@ -591,6 +829,7 @@ void MemoryPoolImpl::allocateNonContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  SAMPLE_ALLOC(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -599,6 +838,7 @@ void MemoryPoolImpl::allocateNonContiguous(
 void MemoryPoolImpl::freeNonContiguous(Allocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   DEBUG_RECORD_FREE(allocation);
+  SAMPLE_FREE(allocation);
   const int64_t freedBytes = allocator_->freeNonContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(freedBytes);
@@ -622,6 +862,7 @@ void MemoryPoolImpl::allocateContiguous(
   }
   VELOX_CHECK_GT(numPages, 0);
   DEBUG_RECORD_FREE(out);
+  SAMPLE_FREE(out);
   if (!allocator_->allocateContiguous(
           numPages,
           nullptr,
@@ -643,6 +884,7 @@ void MemoryPoolImpl::allocateContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  SAMPLE_ALLOC(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -652,6 +894,7 @@ void MemoryPoolImpl::freeContiguous(ContiguousAllocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const int64_t bytesToFree = allocation.size();
   DEBUG_RECORD_FREE(allocation);
+  SAMPLE_FREE(allocation);
   allocator_->freeContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(bytesToFree);
@@ -678,6 +921,9 @@ void MemoryPoolImpl::growContiguous(
   if (FOLLY_UNLIKELY(debugEnabled_)) {
     recordGrowDbg(allocation.data(), allocation.size());
   }
+  if (FOLLY_UNLIKELY(allocationSampleBytes_ > 0)) {
+    sampleGrow(allocation.data(), allocation.size());
+  }
 }
 
 int64_t MemoryPoolImpl::capacity() const {
@@ -722,7 +968,9 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .threadCacheBytes = threadCacheBytes_,
+          .allocationSampleBytes = allocationSampleBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -1232,6 +1480,142 @@ void MemoryPoolImpl::leakCheckDbg() {
   VELOX_FAIL(buf.str());
 }
 
+int64_t MemoryPoolImpl::nextSampleInterval() const {
+  // Exponentially distributed intervals make each allocated byte equally
+  // likely to be sampled, which is what pprof assumes to scale the samples.
+  const double uniform = folly::Random::randDouble01();
+  return 1 +
+      static_cast<int64_t>(-std::log1p(-uniform) * allocationSampleBytes_);
+}
+
+void MemoryPoolImpl::sampleAlloc(const void* addr, uint64_t size) {
+  VELOX_CHECK_GT(allocationSampleBytes_, 0);
+  if (bytesUntilSample_.fetch_sub(size) > static_cast<int64_t>(size)) {
+    return;
+  }
+  bytesUntilSample_ = nextSampleInterval();
+  // Skips the frame of this function.
+  process::StackTrace callStack(1);
+  std::lock_guard<std::mutex> l(samplesMutex_);
+  auto& totals = allocatedSamples_[callStack.getStack()];
+  ++totals.numAllocated;
+  totals.allocatedBytes += size;
+  if (liveSamples_.emplace(addr, LiveSample{size, callStack.getStack()})
+          .second) {
+    ++numLiveSamples_;
+  }
+}
+
+void MemoryPoolImpl::sampleAlloc(const Allocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  sampleAlloc(allocation.runAt(0).data(), allocation.byteSize());
+}
+
+void MemoryPoolImpl::sampleAlloc(const ContiguousAllocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  sampleAlloc(allocation.data(), allocation.size());
+}
+
+void MemoryPoolImpl::sampleFree(const void* addr) {
+  VELOX_CHECK_GT(allocationSampleBytes_, 0);
+  if (numLiveSamples_ == 0 || addr == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(samplesMutex_);
+  if (liveSamples_.erase(addr) != 0) {
+    --numLiveSamples_;
+  }
+}
+
+void MemoryPoolImpl::sampleFree(const Allocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  sampleFree(allocation.runAt(0).data());
+}
+
+void MemoryPoolImpl::sampleFree(const ContiguousAllocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  sampleFree(allocation.data());
+}
+
+void MemoryPoolImpl::sampleGrow(const void* addr, uint64_t newSize) {
+  VELOX_CHECK_GT(allocationSampleBytes_, 0);
+  if (numLiveSamples_ == 0 || addr == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(samplesMutex_);
+  auto it = liveSamples_.find(addr);
+  if (it != liveSamples_.end()) {
+    it->second.size = newSize;
+  }
+}
+
+void MemoryPoolImpl::collectSamples(SampleMap& totals) const {
+  {
+    std::lock_guard<std::mutex> l(samplesMutex_);
+    for (const auto& [callStack, allocated] : allocatedSamples_) {
+      auto& total = totals[callStack];
+      total.numAllocated += allocated.numAllocated;
+      total.allocatedBytes += allocated.allocatedBytes;
+    }
+    for (const auto& [addr, sample] : liveSamples_) {
+      auto& total = totals[sample.callStack];
+      ++total.numInUse;
+      total.inUseBytes += sample.size;
+    }
+  }
+  visitChildren([&](MemoryPool* child) {
+    toImpl(child)->collectSamples(totals);
+    return true;
+  });
+}
+
+std::string MemoryPoolImpl::heapProfile() const {
+  SampleMap totals;
+  collectSamples(totals);
+  SampleTotals sum;
+  for (const auto& [callStack, total] : totals) {
+    sum.numInUse += total.numInUse;
+    sum.inUseBytes += total.inUseBytes;
+    sum.numAllocated += total.numAllocated;
+    sum.allocatedBytes += total.allocatedBytes;
+  }
+  std::stringstream out;
+  out << fmt::format(
+      "heap profile: {}: {} [{}: {}] @ heap_v2/{}\n",
+      sum.numInUse,
+      sum.inUseBytes,
+      sum.numAllocated,
+      sum.allocatedBytes,
+      allocationSampleBytes_);
+  for (const auto& [callStack, total] : totals) {
+    out << fmt::format(
+        "{}: {} [{}: {}] @",
+        total.numInUse,
+        total.inUseBytes,
+        total.numAllocated,
+        total.allocatedBytes);
+    for (auto* frame : callStack) {
+      out << fmt::format(" {}", frame);
+    }
+    out << "\n";
+  }
+  // pprof maps the addresses to symbols with the mappings of the process.
+  out << "\nMAPPED_LIBRARIES:\n";
+  std::ifstream maps("/proc/self/maps");
+  if (maps.is_open()) {
+    out << maps.rdbuf();
+  }
+  return out.str();
+}
+
 void MemoryPoolImpl::handleAllocationFailure(
     const std::string& failureMessage) {
   if (coreOnAllocationFailureEnabled_) {
@@ -18,11 +18,13 @@
 
 #include <array>
 #include <atomic>
+#include <map>
 #include <memory>
 #include <optional>
 #include <queue>
 
 #include <fmt/format.h>
+#include <folly/container/F14Map.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -160,6 +162,23 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// If non-zero, a thread-safe leaf memory pool serves the small
+    /// allocate() and free() calls of each thread from a cache of that
+    /// thread. A thread reserves memory from the pool in quanta of this many
+    /// bytes and keeps up to this many bytes of freed blocks for reuse, so
+    /// most small allocations neither take the pool lock nor call the
+    /// allocator. The used bytes of the pool then include the cached blocks
+    /// and the unused reservation of the threads. Applies to all the child
+    /// pools and is ignored in debug mode.
+    int32_t threadCacheBytes{0};
+
+    /// If non-zero, the leaf memory pools record the call stack of about one
+    /// allocation per this many allocated bytes. The sampled allocations
+    /// that are not freed yet are exported by MemoryPoolImpl::heapProfile().
+    /// Applies to all the child pools. There is no overhead besides a branch
+    /// when this is zero.
+    int64_t allocationSampleBytes{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -293,6 +312,17 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
       MachinePageCount increment,
       ContiguousAllocation& allocation) = 0;
 
+  /// Makes a contiguous allocation of at least 'numPages' in 'out' and
+  /// returns the start of a range of 'numPages' in it that begins on a huge
+  /// page boundary, so that the huge page advice of the allocator covers the
+  /// whole range. Allocates up to one huge page more than requested for the
+  /// alignment. Allocations smaller than a huge page are not aligned and
+  /// start at 'out.data()'. Used for large randomly accessed structures like
+  /// hash tables, where TLB misses dominate the cost of a probe.
+  char* allocateHugePageAligned(
+      MachinePageCount numPages,
+      ContiguousAllocation& out);
+
   /// Rounds up to a power of 2 >= size, or to a size halfway between
   /// two consecutive powers of two, i.e 8, 12, 16, 24, 32, .... This
   /// coincides with JEMalloc size classes.
@@ -537,6 +567,8 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const int32_t threadCacheBytes_;
+  const int64_t allocationSampleBytes_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -576,6 +608,10 @@ class MemoryPoolImpl : public MemoryPool {
   /// otherwise false.
   using GrowCapacityCallback = std::function<bool(MemoryPool*, uint64_t)>;
 
+  /// The largest allocate() size served from the thread caches of a pool
+  /// with Options::threadCacheBytes set.
+  static constexpr int64_t kMaxThreadCachedSize = 4096;
+
   MemoryPoolImpl(
       MemoryManager* manager,
       const std::string& name,
@@ -725,6 +761,13 @@ class MemoryPoolImpl : public MemoryPool {
     debugPoolNameRegex() = regex;
   }
 
+  /// Returns a heap profile of the sampled allocations of this pool and its
+  /// descendants in the legacy text format read by pprof. The in-use columns
+  /// cover the sampled allocations that are not freed and the allocated
+  /// columns all the sampled allocations. Has no samples unless
+  /// Options::allocationSampleBytes is set.
+  std::string heapProfile() const;
+
  private:
   uint64_t shrink(uint64_t targetBytes = 0) override;
 
@@ -992,6 +1035,75 @@ class MemoryPoolImpl : public MemoryPool {
 
   void handleAllocationFailure(const std::string& failureMessage);
 
+  // Totals of the sampled allocations with the same call stack.
+  struct SampleTotals {
+    int64_t numInUse{0};
+    int64_t inUseBytes{0};
+    int64_t numAllocated{0};
+    int64_t allocatedBytes{0};
+  };
+
+  // Maps a call stack to the totals of its sampled allocations.
+  using SampleMap = std::map<std::vector<void*>, SampleTotals>;
+
+  // Invoked on each allocation if Options::allocationSampleBytes is set.
+  // Records the call stack of the allocation if the sampling interval has
+  // passed.
+  void sampleAlloc(const void* addr, uint64_t size);
+
+  void sampleAlloc(const Allocation& allocation);
+
+  void sampleAlloc(const ContiguousAllocation& allocation);
+
+  // Invoked on each free if Options::allocationSampleBytes is set. Removes
+  // the sample of 'addr' if any.
+  void sampleFree(const void* addr);
+
+  void sampleFree(const Allocation& allocation);
+
+  void sampleFree(const ContiguousAllocation& allocation);
+
+  // Accounts for ContiguousAllocation size change in growContiguous().
+  void sampleGrow(const void* addr, uint64_t newSize);
+
+  // Returns the number of bytes to allocate before taking the next sample.
+  int64_t nextSampleInterval() const;
+
+  // Adds the samples of this pool and its descendants to 'totals'.
+  void collectSamples(SampleMap& totals) const;
+
+  // The smallest size class of the thread caches. The allocations served from
+  // the thread caches are rounded up to a power of two size class.
+  static constexpr int64_t kMinThreadCachedSize = 16;
+  static constexpr int32_t kNumThreadCacheClasses = 9;
+  static_assert(
+      (kMinThreadCachedSize << (kNumThreadCacheClasses - 1)) ==
+      kMaxThreadCachedSize);
+
+  // The small allocations and freed blocks of one thread from a pool with
+  // 'useThreadCache_' set.
+  struct ThreadCache;
+
+  // Returns the size class in the thread caches of an allocation of aligned
+  // 'size'.
+  static int32_t threadCacheClass(int64_t size);
+
+  FOLLY_ALWAYS_INLINE bool useThreadCache(int64_t alignedSize) const {
+    return useThreadCache_ && alignedSize > 0 &&
+        alignedSize <= kMaxThreadCachedSize;
+  }
+
+  // Returns the cache of the calling thread, creating it on first use.
+  ThreadCache& threadCache();
+
+  void* allocateThreadCached(int64_t alignedSize);
+
+  void freeThreadCached(void* p, int64_t alignedSize);
+
+  // Invoked on destruction to return the cached memory of all the threads to
+  // the allocator and their reservations to this pool.
+  void flushThreadCaches();
+
   MemoryManager* const manager_;
   MemoryAllocator* const allocator_;
   const GrowCapacityCallback growCapacityCb_;
@@ -1061,6 +1173,41 @@ class MemoryPoolImpl : public MemoryPool {
 
   // Map from address to 'AllocationRecord'.
   std::unordered_map<uint64_t, AllocationRecord> debugAllocRecords_;
+
+  // The number of bytes to allocate before the next allocation sample.
+  std::atomic<int64_t> bytesUntilSample_{0};
+
+  // The number of entries in 'liveSamples_'. Lets frees skip the lookup if
+  // there are no samples.
+  std::atomic<int64_t> numLiveSamples_{0};
+
+  // Protects 'liveSamples_' and 'allocatedSamples_'.
+  mutable std::mutex samplesMutex_;
+
+  // The call stack and size of each sampled allocation that is not freed.
+  struct LiveSample {
+    uint64_t size;
+    std::vector<void*> callStack;
+  };
+  folly::F14FastMap<const void*, LiveSample> liveSamples_;
+
+  // The totals of all the sampled allocations by call stack.
+  SampleMap allocatedSamples_;
+
+  // Identifies this pool in the thread caches of the threads. Unlike the
+  // address, it is never reused by a later pool.
+  const uint64_t id_;
+
+  // True if the small allocations of this leaf pool are served from the
+  // thread caches.
+  const bool useThreadCache_;
+
+  // Protects 'threadCaches_'.
+  std::mutex threadCachesMutex_;
+
+  // The thread caches of this pool. The threads reference them from thread
+  // local storage.
+  std::vector<std::shared_ptr<ThreadCache>> threadCaches_;
 };
 
 /// An Allocator backed by a memory pool for STL containers.
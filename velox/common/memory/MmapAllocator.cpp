@@ -22,6 +22,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/memory/Numa.h"
 
 namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
@@ -34,17 +35,28 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      numNumaNodes_(
+          options.numNumaNodes > 0 ? options.numNumaNodes : numa::numNodes()),
+      pinThreadsToNumaNode_(options.pinThreadsToNumaNode && numNumaNodes_ > 1),
+      numNodeAllocations_(numNumaNodes_) {
+  VELOX_CHECK_GE(options.numNumaNodes, 0);
+  for (int32_t node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, numNumaNodes_ > 1 ? node : -1));
+    }
   }
 
   if (useMmapArena_) {
     const auto arenaSizeBytes = bits::roundUp(
         AllocationTraits::pageBytes(capacity_) / options.mmapArenaCapacityRatio,
         AllocationTraits::kPageSize);
-    managedArenas_ = std::make_unique<ManagedMmapArenas>(
-        std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes));
+    for (int32_t node = 0; node < numNumaNodes_; ++node) {
+      managedArenas_.push_back(std::make_unique<ManagedMmapArenas>(
+          std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes),
+          numNumaNodes_ > 1 ? node : -1));
+    }
   }
 }
 
@@ -90,6 +102,9 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
 
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
+  const auto node = allocationNode();
+  ++numNodeAllocations_[node];
+  auto* sizeClasses = nodeSizeClasses(node);
   MachinePageCount newMapsNeeded = 0;
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
@@ -97,7 +112,7 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
+          success = sizeClasses[sizeMix.sizeIndices[i]]->allocate(
               sizeMix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
@@ -182,8 +197,7 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
     return numFreed;
   }
 
-  for (auto i = 0; i < sizeClasses_.size(); ++i) {
-    auto& sizeClass = sizeClasses_[i];
+  for (auto& sizeClass : sizeClasses_) {
     int32_t pages = 0;
     uint64_t clocks = 0;
     {
@@ -195,7 +209,7 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
       const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClass->unitSize()));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
     numFreed += pages;
@@ -250,7 +264,7 @@ bool MmapAllocator::allocateContiguousImpl(
     useHugePages(allocation, false);
     if (useMmapArena_) {
       std::lock_guard<std::mutex> l(arenaMutex_);
-      managedArenas_->free(allocation.data(), allocation.maxSize());
+      freeToArenas(allocation.data(), allocation.maxSize());
     } else {
       if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
         VELOX_MEM_LOG(ERROR) << "munmap got " << folly::errnoStr(errno)
@@ -325,9 +339,11 @@ bool MmapAllocator::allocateContiguousImpl(
   if (testingHasInjectedFailure(InjectedFailure::kMmap)) {
     data = nullptr;
   } else {
+    const auto node = allocationNode();
     if (useMmapArena_) {
       std::lock_guard<std::mutex> l(arenaMutex_);
-      data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
+      data = managedArenas_[node]->allocate(
+          AllocationTraits::pageBytes(maxPages));
     } else {
       data = ::mmap(
           nullptr,
@@ -336,6 +352,10 @@ bool MmapAllocator::allocateContiguousImpl(
           MAP_PRIVATE | MAP_ANONYMOUS,
           -1,
           0);
+      if (data != MAP_FAILED && numNumaNodes_ > 1) {
+        numa::setPreferredNode(
+            data, AllocationTraits::pageBytes(maxPages), node);
+      }
     }
   }
   if (data == nullptr || data == MAP_FAILED) {
@@ -372,7 +392,7 @@ void MmapAllocator::freeContiguousImpl(ContiguousAllocation& allocation) {
   useHugePages(allocation, false);
   if (useMmapArena_) {
     std::lock_guard<std::mutex> l(arenaMutex_);
-    managedArenas_->free(allocation.data(), allocation.maxSize());
+    freeToArenas(allocation.data(), allocation.maxSize());
   } else {
     if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
       VELOX_MEM_LOG(ERROR) << "munmap returned " << folly::errnoStr(errno)
@@ -496,6 +516,33 @@ void MmapAllocator::markAllMapped(const Allocation& allocation) {
   }
 }
 
+int32_t MmapAllocator::allocationNode() {
+  if (numNumaNodes_ == 1) {
+    return 0;
+  }
+  const auto node = numa::currentNode();
+  if (pinThreadsToNumaNode_) {
+    // A thread is pinned once, to the node it runs on at its first allocation
+    // from any MmapAllocator.
+    thread_local bool pinned{false};
+    if (!pinned) {
+      pinned = true;
+      numa::pinThreadToNode(node);
+    }
+  }
+  return node % numNumaNodes_;
+}
+
+void MmapAllocator::freeToArenas(void* data, uint64_t bytes) {
+  for (auto& arenas : managedArenas_) {
+    if (managedArenas_.size() == 1 || arenas->contains(data)) {
+      arenas->free(data, bytes);
+      return;
+    }
+  }
+  VELOX_FAIL("{} is not in the MmapArenas of the allocator", data);
+}
+
 MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   MachinePageCount numAway = 0;
   for (int32_t i = sizeClasses_.size() - 1; i >= 0; --i) {
@@ -508,7 +555,10 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -537,6 +587,9 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode >= 0) {
+    numa::setPreferredNode(address_, byteSize_, numaNode);
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -588,6 +641,15 @@ ClassPageCount MmapAllocator::SizeClass::checkConsistency(
   return count;
 }
 
+ClassPageCount MmapAllocator::SizeClass::numAllocatedPages() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  ClassPageCount count = 0;
+  for (int i = 0; i < pageBitmapSize_; ++i) {
+    count += __builtin_popcountll(pageAllocated_[i]);
+  }
+  return count;
+}
+
 std::string MmapAllocator::SizeClass::toString() const {
   std::stringstream out;
   int count = 0;
@@ -965,8 +1027,21 @@ std::string MmapAllocator::toString() const {
                     capacity() - AllocationTraits::pageBytes(numAllocated())))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
       << " external mapped pages " << numExternalMapped_ << std::endl;
-  for (auto& sizeClass : sizeClasses_) {
-    out << sizeClass->toString() << std::endl;
+  const auto numSizeClasses = sizeClassSizes_.size();
+  for (int32_t node = 0; node < numNumaNodes_; ++node) {
+    if (numNumaNodes_ > 1) {
+      MachinePageCount numPages = 0;
+      for (auto i = 0; i < numSizeClasses; ++i) {
+        const auto& sizeClass = sizeClasses_[node * numSizeClasses + i];
+        numPages += sizeClass->numAllocatedPages() * sizeClass->unitSize();
+      }
+      out << "NUMA node " << node << ": allocations "
+          << numNodeAllocations_[node] << " allocated pages " << numPages
+          << std::endl;
+    }
+    for (auto i = 0; i < numSizeClasses; ++i) {
+      out << sizeClasses_[node * numSizeClasses + i]->toString() << std::endl;
+    }
   }
   out << "]";
   return out.str();
@@ -49,6 +49,12 @@ using ClassPageCount = int32_t;
 /// mmap of the requested size (ContiguousAllocation). Small contiguous memory
 /// allocations less than 3/4 of smallest size class are still delegated to
 /// malloc.
+///
+/// With more than one NUMA node, each node has its own size classes and arenas
+/// whose memory is preferably backed by the node. Allocations are served from
+/// the node of the CPU that runs the allocating thread. Frees go to the node
+/// that owns the address. Each node can hold the whole capacity, so the
+/// capacity is shared between the nodes.
 class MmapAllocator : public MemoryAllocator {
  public:
   struct Options {
@@ -78,6 +84,16 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// Number of NUMA nodes with their own size classes and arenas. 1 disables
+    /// NUMA awareness. 0 uses the number of nodes of the host. Each node
+    /// reserves address space for the whole capacity.
+    int32_t numNumaNodes = 1;
+
+    /// If true and there is more than one NUMA node, pins each thread to the
+    /// CPUs of the node it runs on at its first allocation, so that driver
+    /// threads keep using the memory of their node.
+    bool pinThreadsToNumaNode = false;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -151,6 +167,10 @@ class MmapAllocator : public MemoryAllocator {
     return numMallocBytes_.readFull();
   }
 
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
+  }
+
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
@@ -166,7 +186,8 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // The memory is preferably backed by 'numaNode' if it is not negative.
+    SizeClass(size_t capacity, MachinePageCount unitSize, int32_t numaNode);
 
     ~SizeClass();
 
@@ -207,6 +228,9 @@ class MmapAllocator : public MemoryAllocator {
     // size class page boundary.
     bool isInRange(uint8_t* ptr) const;
 
+    // Returns the number of allocated class pages.
+    ClassPageCount numAllocatedPages() const;
+
     std::string toString() const;
 
    private:
@@ -370,6 +394,19 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the NUMA node to allocate from for the calling thread. Pins the
+  // thread to the node at its first call if 'pinThreadsToNumaNode_' is set.
+  int32_t allocationNode();
+
+  // Returns the size classes of 'node'.
+  std::unique_ptr<SizeClass>* nodeSizeClasses(int32_t node) {
+    return &sizeClasses_[node * sizeClassSizes_.size()];
+  }
+
+  // Frees an allocation made from 'managedArenas_'. Must be called under
+  // 'arenaMutex_'.
+  void freeToArenas(void* data, uint64_t bytes);
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -406,8 +443,17 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  const int32_t numNumaNodes_;
+
+  const bool pinThreadsToNumaNode_;
+
+  // The size classes of all NUMA nodes. The classes of node 'n' start at 'n' *
+  // 'sizeClassSizes_.size()'.
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
+  // Number of non-contiguous allocations made from each NUMA node.
+  std::vector<std::atomic<uint64_t>> numNodeAllocations_;
+
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
@@ -415,9 +461,10 @@ class MmapAllocator : public MemoryAllocator {
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
 
   // Allocations that are larger than largest size classes will be delegated to
-  // ManagedMmapArenas, to avoid calling mmap on every allocation.
+  // ManagedMmapArenas, to avoid calling mmap on every allocation. One per NUMA
+  // node.
   std::mutex arenaMutex_;
-  std::unique_ptr<ManagedMmapArenas> managedArenas_;
+  std::vector<std::unique_ptr<ManagedMmapArenas>> managedArenas_;
 
   std::shared_ptr<Cache> cache_;
 };
@@ -36,7 +36,9 @@ class MmapArena {
   /// MmapArena capacity should be multiple of kMinGrainSizeBytes.
   static constexpr uint64_t kMinGrainSizeBytes = 1024 * 1024; // 1M
 
-  explicit MmapArena(size_t capacityBytes);
+  /// If 'numaNode' is not negative, the memory of the arena is preferably
+  /// backed by that NUMA node.
+  explicit MmapArena(size_t capacityBytes, int32_t numaNode = -1);
   ~MmapArena();
 
   void* allocate(uint64_t bytes);
@@ -124,12 +126,18 @@ class MmapArena {
 /// fragmentation happens.
 class ManagedMmapArenas {
  public:
-  explicit ManagedMmapArenas(uint64_t singleArenaCapacity);
+  /// The arenas are preferably backed by 'numaNode' if it is not negative.
+  explicit ManagedMmapArenas(
+      uint64_t singleArenaCapacity,
+      int32_t numaNode = -1);
 
   void* allocate(uint64_t bytes);
 
   void free(void* address, uint64_t bytes);
 
+  /// True if 'address' is in one of the arenas of 'this'.
+  bool contains(void* address) const;
+
   const std::map<uintptr_t, std::shared_ptr<MmapArena>>& arenas() const {
     return arenas_;
   }
@@ -138,6 +146,8 @@ class ManagedMmapArenas {
   // Capacity in bytes for a single MmapArena managed by this.
   const uint64_t singleArenaCapacity_;
 
+  const int32_t numaNode_;
+
   // A sorted list of MmapArena by its initial address
   std::map<uintptr_t, std::shared_ptr<MmapArena>> arenas_;
 
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/Numa.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+#include <folly/Conv.h>
+#include <glog/logging.h>
+
+namespace facebook::velox::memory::numa {
+namespace {
+// From linux/mempolicy.h.
+constexpr int kMpolPreferred = 1;
+
+std::string readSysFile(const std::string& path) {
+  std::ifstream in(path);
+  std::stringstream contents;
+  contents << in.rdbuf();
+  auto result = contents.str();
+  while (!result.empty() && (result.back() == '\n' || result.back() == ' ')) {
+    result.pop_back();
+  }
+  return result;
+}
+
+std::string nodeCpuListPath(int32_t node) {
+  return fmt::format("/sys/devices/system/node/node{}/cpulist", node);
+}
+
+struct Topology {
+  Topology() {
+#ifdef __linux__
+    const auto nodes =
+        parseList(readSysFile("/sys/devices/system/node/online"));
+    if (!nodes.empty()) {
+      numNodes = nodes.back() + 1;
+    }
+    for (auto node : nodes) {
+      for (auto cpu : parseList(readSysFile(nodeCpuListPath(node)))) {
+        if (cpu >= static_cast<int32_t>(cpuToNode.size())) {
+          cpuToNode.resize(cpu + 1, 0);
+        }
+        cpuToNode[cpu] = node;
+      }
+    }
+#endif
+  }
+
+  int32_t numNodes{1};
+  std::vector<int32_t> cpuToNode;
+};
+
+const Topology& topology() {
+  static const Topology topology;
+  return topology;
+}
+} // namespace
+
+int32_t numNodes() {
+  return topology().numNodes;
+}
+
+int32_t currentNode() {
+#ifdef __linux__
+  const auto& cpuToNode = topology().cpuToNode;
+  const auto cpu = ::sched_getcpu();
+  if (cpu >= 0 && cpu < static_cast<int32_t>(cpuToNode.size())) {
+    return cpuToNode[cpu];
+  }
+#endif
+  return 0;
+}
+
+bool setPreferredNode(void* address, size_t bytes, int32_t node) {
+#ifdef __linux__
+  if (node < 0 || node >= 64) {
+    return false;
+  }
+  const unsigned long nodeMask = 1UL << node;
+  return ::syscall(
+             SYS_mbind,
+             address,
+             bytes,
+             kMpolPreferred,
+             &nodeMask,
+             sizeof(nodeMask) * 8,
+             0) == 0;
+#else
+  return false;
+#endif
+}
+
+bool pinThreadToNode(int32_t node) {
+#ifdef __linux__
+  const auto cpus = parseList(readSysFile(nodeCpuListPath(node)));
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+  if (::sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+    LOG(WARNING) << "Failed to pin thread to NUMA node " << node;
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::vector<int32_t> parseList(std::string_view list) {
+  std::vector<int32_t> result;
+  size_t begin = 0;
+  while (begin < list.size()) {
+    auto end = list.find(',', begin);
+    if (end == std::string_view::npos) {
+      end = list.size();
+    }
+    const auto range = list.substr(begin, end - begin);
+    const auto dash = range.find('-');
+    const auto first =
+        folly::tryTo<int32_t>(range.substr(0, std::min(dash, range.size())));
+    const auto last = dash == std::string_view::npos
+        ? first
+        : folly::tryTo<int32_t>(range.substr(dash + 1));
+    if (!first.hasValue() || !last.hasValue() || first.value() < 0 ||
+        last.value() < first.value()) {
+      return {};
+    }
+    for (auto i = first.value(); i <= last.value(); ++i) {
+      result.push_back(i);
+    }
+    begin = end + 1;
+  }
+  return result;
+}
+
+} // namespace facebook::velox::memory::numa
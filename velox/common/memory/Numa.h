@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/// Minimal NUMA support for the memory allocators. The topology is read from
+/// /sys/devices/system/node on Linux. Other platforms have a single node and
+/// the binding and pinning functions are no-ops that return false.
+namespace facebook::velox::memory::numa {
+
+/// Number of NUMA nodes of the host. 1 if the topology is not known.
+int32_t numNodes();
+
+/// The NUMA node of the CPU that runs the calling thread. 0 if not known.
+int32_t currentNode();
+
+/// Makes 'node' the preferred node of the physical pages backing
+/// ['address', 'address' + 'bytes'). 'address' must be page aligned. Returns
+/// false if the kernel rejects the policy, e.g. if 'node' does not exist.
+bool setPreferredNode(void* address, size_t bytes, int32_t node);
+
+/// Restricts the calling thread to the CPUs of 'node'. Returns false on
+/// failure.
+bool pinThreadToNode(int32_t node);
+
+/// Parses a CPU or node list like "0-3,8,10-11" as found in sysfs. Returns an
+/// empty vector if 'list' is malformed.
+std::vector<int32_t> parseList(std::string_view list);
+
+} // namespace facebook::velox::memory::numa
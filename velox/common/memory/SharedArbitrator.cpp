@@ -85,6 +85,9 @@ void sortCandidatesByReclaimableUsedCapacity(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -93,6 +96,17 @@ void sortCandidatesByReclaimableUsedCapacity(
       &candidates);
 }
 
+void sortCandidatesByGrowth(
+    std::vector<SharedArbitrator::Candidate>& candidates) {
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const SharedArbitrator::Candidate& lhs,
+         const SharedArbitrator::Candidate& rhs) {
+        return lhs.growthBytes > rhs.growthBytes;
+      });
+}
+
 void sortCandidatesByUsage(
     std::vector<SharedArbitrator::Candidate>& candidates) {
   std::sort(
@@ -100,28 +114,43 @@ void sortCandidatesByUsage(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reservedBytes > rhs.reservedBytes;
       });
 }
 
-// Finds the candidate with the largest capacity. For 'requestor', the
-// capacity for comparison including its current capacity and the capacity to
-// grow.
+int32_t poolPriority(const MemoryPool& pool) {
+  const auto* reclaimer = pool.reclaimer();
+  return reclaimer == nullptr ? 0 : reclaimer->priority();
+}
+
+// Finds the candidate with the largest capacity among the candidates of the
+// lowest priority. For 'requestor', the capacity for comparison including its
+// current capacity and the capacity to grow.
 const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
     MemoryPool* requestor,
     uint64_t targetBytes,
     const std::vector<SharedArbitrator::Candidate>& candidates) {
   VELOX_CHECK(!candidates.empty());
+  int32_t minPriority = candidates[0].priority;
+  for (const auto& candidate : candidates) {
+    minPriority = std::min(minPriority, candidate.priority);
+  }
   int32_t candidateIdx{-1};
   int64_t maxCapacity{-1};
   for (int32_t i = 0; i < candidates.size(); ++i) {
+    if (candidates[i].priority != minPriority) {
+      continue;
+    }
     const bool isCandidate = candidates[i].pool == requestor;
     // For capacity comparison, the requestor's capacity should include both its
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    if (candidateIdx == -1) {
+      candidateIdx = i;
       maxCapacity = capacity;
       continue;
     }
@@ -147,19 +176,30 @@ const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
 SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
     : MemoryArbitrator(config),
       freeReservedCapacity_(reservedCapacity_),
-      freeNonReservedCapacity_(capacity_ - freeReservedCapacity_) {
+      freeNonReservedCapacity_(capacity_ - freeReservedCapacity_),
+      backgroundArbitrationIntervalMs_(config.backgroundArbitrationIntervalMs),
+      backgroundArbitrationFreeCapacityRatio_(
+          config.backgroundArbitrationFreeCapacityRatio),
+      lowPriorityPauseMs_(config.lowPriorityPauseMs) {
   VELOX_CHECK_EQ(kind_, config.kind);
+  VELOX_CHECK_GE(backgroundArbitrationFreeCapacityRatio_, 0);
+  VELOX_CHECK_LE(backgroundArbitrationFreeCapacityRatio_, 1);
+  if (backgroundArbitrationIntervalMs_ > 0) {
+    backgroundThread_ = std::thread([this]() { backgroundArbitrationLoop(); });
+  }
 }
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}] PRIORITY[{}]]",
       pool->root()->name(),
       succinctBytes(reclaimableBytes),
-      succinctBytes(freeBytes));
+      succinctBytes(freeBytes),
+      priority);
 }
 
 SharedArbitrator::~SharedArbitrator() {
+  shutdown();
   if (freeNonReservedCapacity_ + freeReservedCapacity_ != capacity_) {
     const std::string errMsg = fmt::format(
         "Unexpected free capacity leak in arbitrator: freeNonReservedCapacity_[{}] + freeReservedCapacity_[{}] != capacity_[{}])\\n{}",
@@ -186,7 +226,9 @@ void SharedArbitrator::getCandidateStats(
         {freeCapacityOnly ? 0 : reclaimableUsedCapacity(*pool, selfCandidate),
          reclaimableFreeCapacity(*pool, selfCandidate),
          pool->reservedBytes(),
-         pool.get()});
+         pool.get(),
+         0,
+         poolPriority(*pool)});
   }
 }
 
@@ -251,6 +293,10 @@ uint64_t SharedArbitrator::growCapacity(
   } catch (const VeloxRuntimeError&) {
     reservedBytes = 0;
   }
+  if (backgroundArbitrationIntervalMs_ > 0) {
+    poolGrowths_[pool] =
+        PoolGrowth{pool->weak_from_this(), pool->reservedBytes(), 0};
+  }
   return reservedBytes;
 }
 
@@ -345,6 +391,121 @@ uint64_t SharedArbitrator::testingNumRequests() const {
   return numRequests_;
 }
 
+uint64_t SharedArbitrator::testingRunBackgroundArbitration() {
+  return runBackgroundArbitration();
+}
+
+uint64_t SharedArbitrator::testingNumLowPriorityPauses() const {
+  return numLowPriorityPauses_;
+}
+
+uint64_t SharedArbitrator::testingNumBackgroundArbitrations() const {
+  return numBackgroundArbitrations_;
+}
+
+void SharedArbitrator::shutdown() {
+  {
+    std::lock_guard<std::mutex> l(backgroundMutex_);
+    stopBackground_ = true;
+  }
+  backgroundCv_.notify_all();
+  if (backgroundThread_.joinable()) {
+    backgroundThread_.join();
+  }
+}
+
+void SharedArbitrator::backgroundArbitrationLoop() {
+  std::unique_lock<std::mutex> l(backgroundMutex_);
+  while (!backgroundCv_.wait_for(
+      l, std::chrono::milliseconds(backgroundArbitrationIntervalMs_), [&]() {
+        return stopBackground_;
+      })) {
+    l.unlock();
+    try {
+      runBackgroundArbitration();
+    } catch (const std::exception& e) {
+      VELOX_MEM_LOG(ERROR) << "Background memory arbitration failed: "
+                           << e.what();
+    }
+    l.lock();
+  }
+}
+
+uint64_t SharedArbitrator::runBackgroundArbitration() {
+  // NOTE: the last reference to a pool might be released by this function so
+  // 'pools' must be destroyed without holding 'mutex_'.
+  std::vector<std::shared_ptr<MemoryPool>> pools;
+  std::unordered_map<MemoryPool*, int64_t> poolGrowthBytes;
+  int64_t predictedFreeCapacity;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    predictedFreeCapacity = freeNonReservedCapacity_ + freeReservedCapacity_;
+    for (auto it = poolGrowths_.begin(); it != poolGrowths_.end();) {
+      auto pool = it->second.pool.lock();
+      if (pool == nullptr) {
+        it = poolGrowths_.erase(it);
+        continue;
+      }
+      auto& growth = it->second;
+      const int64_t reservedBytes = pool->reservedBytes();
+      growth.growthBytes =
+          (growth.growthBytes + reservedBytes - growth.lastReservedBytes) / 2;
+      growth.lastReservedBytes = reservedBytes;
+      // A pool that grows into its free capacity does not take free capacity
+      // from the arbitrator.
+      predictedFreeCapacity -= std::max<int64_t>(
+          0, growth.growthBytes - static_cast<int64_t>(pool->freeBytes()));
+      poolGrowthBytes.emplace(pool.get(), growth.growthBytes);
+      pools.push_back(std::move(pool));
+      ++it;
+    }
+  }
+  const int64_t freeCapacityWatermark =
+      capacity_ * backgroundArbitrationFreeCapacityRatio_;
+  if (pools.empty() || predictedFreeCapacity >= freeCapacityWatermark) {
+    return 0;
+  }
+  const uint64_t targetBytes = freeCapacityWatermark - predictedFreeCapacity;
+
+  uint64_t freedBytes{0};
+  {
+    ArbitrationOperation op(targetBytes, pools);
+    ScopedArbitration scopedArbitration(this, &op);
+    std::lock_guard<std::shared_mutex> exclusiveLock(arbitrationLock_);
+    getCandidateStats(&op);
+    for (auto& candidate : op.candidates) {
+      candidate.growthBytes = poolGrowthBytes[candidate.pool];
+    }
+    freedBytes = reclaimFreeMemoryFromCandidates(&op, targetBytes, false);
+    if (freedBytes < targetBytes) {
+      // Spills the fastest growing queries before they run out of capacity.
+      sortCandidatesByGrowth(op.candidates);
+      for (const auto& candidate : op.candidates) {
+        if (candidate.growthBytes <= 0) {
+          break;
+        }
+        if (candidate.reclaimableBytes == 0) {
+          continue;
+        }
+        freedBytes += reclaim(candidate.pool, targetBytes - freedBytes, false);
+        if (freedBytes >= targetBytes) {
+          break;
+        }
+      }
+    }
+    if (freedBytes > 0) {
+      incrementFreeCapacity(freedBytes);
+    }
+  }
+  if (freedBytes > 0) {
+    ++numBackgroundArbitrations_;
+    VELOX_MEM_LOG(INFO) << "Background arbitration reclaimed "
+                        << succinctBytes(freedBytes) << " with target of "
+                        << succinctBytes(targetBytes);
+  }
+  return freedBytes;
+}
+
 bool SharedArbitrator::growCapacity(
     MemoryPool* pool,
     const std::vector<std::shared_ptr<MemoryPool>>& candidatePools,
@@ -451,43 +612,87 @@ bool SharedArbitrator::runLocalArbitration(
 
 bool SharedArbitrator::runGlobalArbitration(ArbitrationOperation* op) {
   incrementGlobalArbitrationCount();
-  const std::chrono::steady_clock::time_point globalArbitrationStartTime =
-      std::chrono::steady_clock::now();
-  std::lock_guard<std::shared_mutex> exclusiveLock(arbitrationLock_);
-  TestValue::adjust(
-      "facebook::velox::memory::SharedArbitrator::runGlobalArbitration", this);
-  op->globalArbitrationLockWaitTimeUs =
-      std::chrono::duration_cast<std::chrono::microseconds>(
-          std::chrono::steady_clock::now() - globalArbitrationStartTime)
-          .count();
-  checkIfAborted(op);
+  const auto pauseDeadline = std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(lowPriorityPauseMs_);
+  for (;;) {
+    uint64_t freeCapacityVersion;
+    {
+      const std::chrono::steady_clock::time_point globalArbitrationStartTime =
+          std::chrono::steady_clock::now();
+      std::lock_guard<std::shared_mutex> exclusiveLock(arbitrationLock_);
+      TestValue::adjust(
+          "facebook::velox::memory::SharedArbitrator::runGlobalArbitration",
+          this);
+      op->globalArbitrationLockWaitTimeUs +=
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - globalArbitrationStartTime)
+              .count();
+      checkIfAborted(op);
+
+      if (maybeGrowFromSelf(op)) {
+        return true;
+      }
 
-  if (maybeGrowFromSelf(op)) {
-    return true;
+      if (arbitrateMemory(op)) {
+        return true;
+      }
+
+      if (!shouldPause(op, pauseDeadline)) {
+        int32_t attempts = 0;
+        VELOX_CHECK(!op->requestRoot->aborted());
+        if (handleOOM(op)) {
+          ++attempts;
+          if (arbitrateMemory(op)) {
+            return true;
+          }
+        }
+        VELOX_MEM_LOG(ERROR)
+            << "Failed to arbitrate sufficient memory for memory pool "
+            << op->requestRoot->name() << ", request "
+            << succinctBytes(op->targetBytes) << " after " << attempts
+            << " attempts, Arbitrator state: " << toString();
+        updateArbitrationFailureStats();
+        return false;
+      }
+      std::lock_guard<std::mutex> l(mutex_);
+      freeCapacityVersion = freeCapacityVersion_;
+    }
+    ++numLowPriorityPauses_;
+    VELOX_MEM_LOG(INFO) << "Pausing memory pool " << op->requestRoot->name()
+                        << " for queries of higher priority, request "
+                        << succinctBytes(op->targetBytes);
+    pause(freeCapacityVersion, pauseDeadline);
   }
+}
 
-  int32_t attempts = 0;
-  for (;; ++attempts) {
-    if (arbitrateMemory(op)) {
+bool SharedArbitrator::shouldPause(
+    const ArbitrationOperation* op,
+    std::chrono::steady_clock::time_point deadline) const {
+  if (lowPriorityPauseMs_ == 0 || op->requestRoot->aborted() ||
+      std::chrono::steady_clock::now() >= deadline) {
+    return false;
+  }
+  const auto priority = poolPriority(*op->requestRoot);
+  for (const auto& candidate : op->candidates) {
+    if (candidate.priority > priority) {
       return true;
     }
-    if (attempts > 0) {
-      break;
-    }
-    VELOX_CHECK(!op->requestRoot->aborted());
-    if (!handleOOM(op)) {
-      break;
-    }
   }
-  VELOX_MEM_LOG(ERROR)
-      << "Failed to arbitrate sufficient memory for memory pool "
-      << op->requestRoot->name() << ", request "
-      << succinctBytes(op->targetBytes) << " after " << attempts
-      << " attempts, Arbitrator state: " << toString();
-  updateArbitrationFailureStats();
   return false;
 }
 
+void SharedArbitrator::pause(
+    uint64_t freeCapacityVersion,
+    std::chrono::steady_clock::time_point deadline) {
+  // Retries periodically to also catch memory freed inside the other pools.
+  constexpr std::chrono::milliseconds kMaxPauseInterval{1'000};
+  std::unique_lock<std::mutex> l(mutex_);
+  freeCapacityCv_.wait_until(
+      l,
+      std::min(deadline, std::chrono::steady_clock::now() + kMaxPauseInterval),
+      [&]() { return freeCapacityVersion_ != freeCapacityVersion; });
+}
+
 void SharedArbitrator::getGrowTargets(
     ArbitrationOperation* op,
     uint64_t& maxGrowTarget,
@@ -800,6 +1005,10 @@ void SharedArbitrator::incrementFreeCapacity(uint64_t bytes) {
 }
 
 void SharedArbitrator::incrementFreeCapacityLocked(uint64_t bytes) {
+  if (lowPriorityPauseMs_ > 0) {
+    ++freeCapacityVersion_;
+    freeCapacityCv_.notify_all();
+  }
   incrementFreeReservedCapacityLocked(bytes);
   freeNonReservedCapacity_ += bytes;
   if (FOLLY_UNLIKELY(
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <thread>
+
 #include "velox/common/memory/MemoryArbitrator.h"
 
 #include "velox/common/base/Counters.h"
@@ -64,12 +67,19 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   std::string toString() const final;
 
+  void shutdown() final;
+
   /// The candidate memory pool stats used by arbitration.
   struct Candidate {
     int64_t reclaimableBytes{0};
     int64_t freeBytes{0};
     int64_t reservedBytes{0};
     MemoryPool* pool;
+    /// The predicted memory growth of 'pool' by the next background
+    /// arbitration.
+    int64_t growthBytes{0};
+    /// The MemoryReclaimer::priority() of 'pool'.
+    int32_t priority{0};
 
     std::string toString() const;
   };
@@ -79,6 +89,17 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   uint64_t testingNumRequests() const;
 
+  /// Runs one background arbitration round for testing and returns the
+  /// reclaimed bytes.
+  uint64_t testingRunBackgroundArbitration();
+
+  /// The number of background arbitration rounds that reclaimed memory.
+  uint64_t testingNumBackgroundArbitrations() const;
+
+  /// The number of times an arbitration request was paused for a query of
+  /// higher priority.
+  uint64_t testingNumLowPriorityPauses() const;
+
   /// Operator level runtime stats that are reported during a shared arbitration
   /// attempt.
   static inline const std::string kMemoryArbitrationWallNanos{
@@ -349,6 +370,39 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   void updateArbitrationRequestStats();
   void updateArbitrationFailureStats();
 
+  // Returns true if the request of 'op' can be paused after failing to get
+  // memory. This is the case if 'lowPriorityPauseMs_' is set, 'deadline' has
+  // not passed and a query of higher priority than the requestor runs.
+  bool shouldPause(
+      const ArbitrationOperation* op,
+      std::chrono::steady_clock::time_point deadline) const;
+
+  // Waits until memory is returned to the arbitrator after
+  // 'freeCapacityVersion' was taken, or until 'deadline'.
+  void pause(
+      uint64_t freeCapacityVersion,
+      std::chrono::steady_clock::time_point deadline);
+
+  // The memory growth of a query memory pool observed by the background
+  // arbitration.
+  struct PoolGrowth {
+    std::weak_ptr<MemoryPool> pool;
+    int64_t lastReservedBytes{0};
+    // Smoothed growth of the reserved bytes per background arbitration
+    // interval.
+    int64_t growthBytes{0};
+  };
+
+  // Runs background arbitration every 'backgroundArbitrationIntervalMs_' until
+  // destruction.
+  void backgroundArbitrationLoop();
+
+  // Updates the memory growth of the query memory pools. If the free capacity
+  // is predicted to fall below the watermark by the next run, reclaims the
+  // difference from free capacity first and then by spilling the fastest
+  // growing candidates. Returns the reclaimed bytes.
+  uint64_t runBackgroundArbitration();
+
   // Lock used to protect the arbitrator state.
   mutable std::mutex mutex_;
   tsan_atomic<uint64_t> freeReservedCapacity_{0};
@@ -378,5 +432,29 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   tsan_atomic<uint64_t> numNonReclaimableAttempts_{0};
   tsan_atomic<uint64_t> numReserves_{0};
   tsan_atomic<uint64_t> numReleases_{0};
+
+  const uint64_t backgroundArbitrationIntervalMs_;
+  const double backgroundArbitrationFreeCapacityRatio_;
+
+  // The query memory pools for background arbitration, keyed by the pool.
+  // Protected by 'mutex_'.
+  std::unordered_map<MemoryPool*, PoolGrowth> poolGrowths_;
+  tsan_atomic<uint64_t> numBackgroundArbitrations_{0};
+
+  // Wakes up 'backgroundThread_' to stop.
+  std::mutex backgroundMutex_;
+  std::condition_variable backgroundCv_;
+  bool stopBackground_{false};
+  std::thread backgroundThread_;
+
+  const uint64_t lowPriorityPauseMs_;
+
+  // Incremented whenever memory is returned to the arbitrator. Protected by
+  // 'mutex_'.
+  uint64_t freeCapacityVersion_{0};
+  // Wakes up the requests paused for higher priority queries when memory is
+  // returned to the arbitrator. Used with 'mutex_'.
+  std::condition_variable freeCapacityCv_;
+  tsan_atomic<uint64_t> numLowPriorityPauses_{0};
 };
 } // namespace facebook::velox::memory
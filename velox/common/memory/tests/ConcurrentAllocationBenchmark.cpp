@@ -38,6 +38,15 @@ DEFINE_uint32(
     memory_allocation_type,
     0,
     "The type of memory allocation. 0 is small allocation, 1 non-contiguous allocation");
+DEFINE_bool(
+    shared_memory_pool,
+    false,
+    "If true, all the memory threads allocate from the same leaf memory pool");
+DEFINE_int32(
+    memory_pool_thread_cache_bytes,
+    0,
+    "If non-zero, the leaf memory pools serve small allocations from per "
+    "thread caches with this many bytes of reservation and freed blocks");
 DEFINE_uint32(
     num_runs,
     32,
@@ -50,15 +59,14 @@ namespace {
 class MemoryOperator {
  public:
   MemoryOperator(
-      MemoryManager* memoryManager,
+      std::shared_ptr<MemoryPool> pool,
       uint64_t maxMemory,
       uint64_t allocationSize,
       uint32_t maxOps)
       : maxMemory_(maxMemory),
         allocationBytes_(allocationSize),
         maxOps_(maxOps),
-        pool_(memoryManager->addLeafPool(
-            fmt::format("MemoryOperator{}", poolId_++))) {
+        pool_(std::move(pool)) {
     rng_.seed(1234);
   }
 
@@ -98,8 +106,6 @@ class MemoryOperator {
 
   void freeNonContiguousAllocation(NonContiguousAllocation& allocation);
 
-  static inline int32_t poolId_{0};
-
   const uint64_t maxMemory_;
   const size_t allocationBytes_;
   const uint32_t allocationType_{FLAGS_memory_allocation_type};
@@ -210,6 +216,8 @@ class MemoryAllocationBenchMark {
     uint64_t allocationBytes;
     uint32_t numThreads;
     uint32_t numOpsPerThread;
+    bool sharedPool;
+    int32_t threadCacheBytes;
   };
 
   explicit MemoryAllocationBenchMark(const Options& options)
@@ -218,11 +226,14 @@ class MemoryAllocationBenchMark {
     switch (options_.allocatorType) {
       case Type::kMmap: {
         manager_ = std::make_shared<MemoryManager>(MemoryManagerOptions{
-            .allocatorCapacity = maxMemory, .useMmapAllocator = true});
+            .memoryPoolThreadCacheBytes = options_.threadCacheBytes,
+            .allocatorCapacity = maxMemory,
+            .useMmapAllocator = true});
       } break;
       case Type::kMalloc:
-        manager_ = std::make_shared<MemoryManager>(
-            MemoryManagerOptions{.allocatorCapacity = maxMemory});
+        manager_ = std::make_shared<MemoryManager>(MemoryManagerOptions{
+            .memoryPoolThreadCacheBytes = options_.threadCacheBytes,
+            .allocatorCapacity = maxMemory});
         break;
       default:
         VELOX_USER_FAIL(
@@ -256,11 +267,17 @@ void MemoryAllocationBenchMark::run() {
   operators.reserve(options_.numThreads);
   uint64_t runTimeUs{0};
   uint64_t clockCount{0};
+  std::shared_ptr<MemoryPool> sharedPool;
+  if (options_.sharedPool) {
+    sharedPool = manager_->addLeafPool("MemoryOperatorShared");
+  }
   {
     MicrosecondTimer clock(&runTimeUs);
     for (int i = 0; i < options_.numThreads; ++i) {
       auto memOp = std::make_unique<MemoryOperator>(
-          manager_.get(),
+          options_.sharedPool
+              ? sharedPool
+              : manager_->addLeafPool(fmt::format("MemoryOperator{}", i)),
           options_.maxMemory / options_.numThreads,
           options_.allocationBytes,
           options_.numOpsPerThread);
@@ -304,6 +321,8 @@ int main(int argc, char* argv[]) {
       ? MemoryAllocationBenchMark::Type::kMalloc
       : MemoryAllocationBenchMark::Type::kMmap;
   options.numOpsPerThread = FLAGS_num_allocations_per_thread;
+  options.sharedPool = FLAGS_shared_memory_pool;
+  options.threadCacheBytes = FLAGS_memory_pool_thread_cache_bytes;
   auto benchmark = std::make_unique<MemoryAllocationBenchMark>(options);
   for (int i = 0; i < FLAGS_num_runs; ++i) {
     benchmark->run();
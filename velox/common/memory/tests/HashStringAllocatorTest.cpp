@@ -289,6 +289,63 @@ TEST_F(HashStringAllocatorTest, multipart) {
   allocator_->checkConsistency();
 }
 
+TEST_F(HashStringAllocatorTest, compact) {
+  // Leaves small free blocks between allocations so that a growing write is
+  // made of many small parts.
+  std::vector<HSA::Header*> blocks;
+  for (auto i = 0; i < 200; ++i) {
+    blocks.push_back(allocate(HSA::kMinAlloc));
+  }
+  for (auto i = 0; i < blocks.size(); i += 2) {
+    allocator_->free(blocks[i]);
+  }
+
+  Multipart data;
+  for (auto i = 0; i < 50; ++i) {
+    auto chars = randomString(10);
+    ByteOutputStream stream(allocator_.get());
+    if (data.start.isSet()) {
+      allocator_->extendWrite(data.current, stream);
+    } else {
+      data.start = allocator_->newWrite(stream, HSA::kMinAlloc);
+    }
+    stream.appendStringView(chars);
+    data.current = allocator_->finishWrite(stream, 0).second;
+    data.reference.insert(data.reference.end(), chars.begin(), chars.end());
+  }
+  ASSERT_TRUE(data.start.header->isContinued());
+  ASSERT_EQ(
+      data.reference.size(), HSA::offset(data.start.header, data.current));
+
+  auto* compacted =
+      allocator_->compact(data.start.header, data.reference.size(), 100);
+  ASSERT_FALSE(compacted->isContinued());
+  ASSERT_GE(compacted->size(), data.reference.size() + 100);
+  data.start = {compacted, compacted->begin()};
+  checkMultipart(data);
+  allocator_->checkConsistency();
+
+  // A single block is returned as is.
+  ASSERT_EQ(compacted, allocator_->compact(compacted, 10));
+
+  // The compacted block can be extended in place.
+  data.current = HSA::Position::atOffset(compacted, data.reference.size());
+  ByteOutputStream stream(allocator_.get());
+  allocator_->extendWrite(data.current, stream);
+  auto chars = randomString(50);
+  stream.appendStringView(chars);
+  allocator_->finishWrite(stream, 0);
+  data.reference.insert(data.reference.end(), chars.begin(), chars.end());
+  ASSERT_FALSE(compacted->isContinued());
+  checkAndFree(data);
+
+  for (auto i = 1; i < blocks.size(); i += 2) {
+    allocator_->free(blocks[i]);
+  }
+  allocator_->checkConsistency();
+  allocator_->checkEmpty();
+}
+
 TEST_F(HashStringAllocatorTest, mixedMultipart) {
   // Create multi-part allocation with a mix of block allocated from Arena and
   // MemoryPool.
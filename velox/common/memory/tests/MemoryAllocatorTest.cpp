@@ -20,6 +20,7 @@
 #include "velox/common/memory/MallocAllocator.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/common/memory/MmapArena.h"
+#include "velox/common/memory/Numa.h"
 #include "velox/common/testutil/TestValue.h"
 
 #include <fmt/format.h>
@@ -474,6 +475,53 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorNuma) {
+  if (!useMmap_) {
+    return;
+  }
+  for (bool useMmapArena : {false, true}) {
+    SCOPED_TRACE(fmt::format("useMmapArena {}", useMmapArena));
+    MmapAllocator::Options options;
+    options.capacity = kCapacityBytes;
+    options.useMmapArena = useMmapArena;
+    // The binding to a node that the host does not have is ignored.
+    options.numNumaNodes = 2;
+    auto allocator = std::make_shared<MmapAllocator>(options);
+    ASSERT_EQ(allocator->numNumaNodes(), 2);
+
+    std::vector<Allocation> allocations(4);
+    for (auto& allocation : allocations) {
+      ASSERT_TRUE(allocator->allocateNonContiguous(100, allocation));
+    }
+    ContiguousAllocation contiguous;
+    const auto numLargePages = allocator->largestSizeClass() * 2;
+    ASSERT_TRUE(
+        allocator->allocateContiguous(numLargePages, nullptr, contiguous));
+    ASSERT_EQ(allocator->numAllocated(), 4 * 100 + numLargePages);
+    ASSERT_TRUE(allocator->checkConsistency());
+    const auto description = allocator->toString();
+    ASSERT_NE(description.find("NUMA node 0"), std::string::npos);
+    ASSERT_NE(description.find("NUMA node 1"), std::string::npos);
+
+    for (auto& allocation : allocations) {
+      allocator->freeNonContiguous(allocation);
+    }
+    allocator->freeContiguous(contiguous);
+    ASSERT_EQ(allocator->numAllocated(), 0);
+    ASSERT_TRUE(allocator->checkConsistency());
+  }
+
+  EXPECT_EQ(
+      numa::parseList("0-3,8,10-11"),
+      (std::vector<int32_t>{0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(numa::parseList("1"), std::vector<int32_t>{1});
+  EXPECT_TRUE(numa::parseList("").empty());
+  EXPECT_TRUE(numa::parseList("3-1").empty());
+  EXPECT_TRUE(numa::parseList("a").empty());
+  EXPECT_GE(numa::numNodes(), 1);
+  EXPECT_LT(numa::currentNode(), numa::numNodes());
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
@@ -989,6 +989,37 @@ TEST_P(MemoryPoolTest, contiguousAllocate) {
   }
 }
 
+TEST_P(MemoryPoolTest, hugePageAlignedAllocate) {
+  auto manager = getMemoryManager();
+  auto pool = manager->addLeafPool("hugePageAlignedAllocate");
+  const auto pagesInHugePage = AllocationTraits::numPagesInHugePage();
+  ContiguousAllocation allocation;
+
+  // Small allocations are not padded.
+  auto* data = pool->allocateHugePageAligned(10, allocation);
+  ASSERT_EQ(data, allocation.data<char>());
+  ASSERT_EQ(allocation.numPages(), 10);
+
+  for (auto numPages :
+       {pagesInHugePage, 3 * pagesInHugePage + 1, 8 * pagesInHugePage}) {
+    SCOPED_TRACE(fmt::format("numPages: {}", numPages));
+    data = pool->allocateHugePageAligned(numPages, allocation);
+    ASSERT_EQ(
+        reinterpret_cast<uintptr_t>(data) % AllocationTraits::kHugePageSize, 0);
+    ASSERT_GE(data, allocation.data<char>());
+    ASSERT_LE(
+        data + AllocationTraits::pageBytes(numPages),
+        allocation.data<char>() + allocation.size());
+    ASSERT_LE(
+        allocation.numPages(),
+        bits::roundUp(numPages, pagesInHugePage) + pagesInHugePage);
+    ASSERT_EQ(pool->usedBytes(), allocation.size());
+    std::memset(data, 1, AllocationTraits::pageBytes(numPages));
+  }
+  pool->freeContiguous(allocation);
+  ASSERT_EQ(pool->usedBytes(), 0);
+}
+
 TEST_P(MemoryPoolTest, contiguousAllocateExceedLimit) {
   const auto memCapacity = (int64_t)(AllocationTraits::pageBytes(1 << 10));
   setupMemory(
@@ -2390,6 +2421,115 @@ TEST_P(MemoryPoolTest, concurrentUpdatesToTheSamePool) {
   ASSERT_EQ(root->stats().usedBytes, 0);
 }
 
+TEST_P(MemoryPoolTest, threadCache) {
+  if (!isLeafThreadSafe_) {
+    return;
+  }
+  constexpr int32_t kThreadCacheBytes = 64 * KB;
+  setupMemory(
+      {.debugEnabled = false,
+       .memoryPoolThreadCacheBytes = kThreadCacheBytes,
+       .allocatorCapacity = kDefaultCapacity,
+       .arbitratorCapacity = kDefaultCapacity,
+       .arbitratorReservedCapacity = 1LL << 30});
+  auto root = getMemoryManager()->addRootPool("threadCache");
+  auto pool = root->addLeafChild("threadCache", true);
+
+  // The first allocation reserves a quantum for the thread.
+  void* buffer = pool->allocate(100);
+  ASSERT_EQ(pool->usedBytes(), kThreadCacheBytes);
+  pool->free(buffer, 100);
+  ASSERT_EQ(pool->usedBytes(), kThreadCacheBytes);
+  // The freed block is reused for an allocation of the same size class.
+  ASSERT_EQ(pool->allocate(120), buffer);
+  ::memset(buffer, 0xff, 120);
+  pool->free(buffer, 120);
+  auto* zeroFilled =
+      static_cast<const char*>(pool->allocateZeroFilled(1, 110));
+  ASSERT_EQ(zeroFilled, buffer);
+  for (int32_t i = 0; i < 110; ++i) {
+    ASSERT_EQ(zeroFilled[i], 0);
+  }
+  pool->free(buffer, 110);
+
+  // Larger allocations bypass the cache.
+  const int64_t largeSize = MemoryPoolImpl::kMaxThreadCachedSize + 1;
+  void* largeBuffer = pool->allocate(largeSize);
+  ASSERT_GT(pool->usedBytes(), kThreadCacheBytes + largeSize);
+  pool->free(largeBuffer, largeSize);
+  ASSERT_EQ(pool->usedBytes(), kThreadCacheBytes);
+
+  // Another thread has its own cache which is returned on thread exit.
+  std::thread([&]() {
+    void* threadBuffer = pool->allocate(1'000);
+    EXPECT_EQ(pool->usedBytes(), 2 * kThreadCacheBytes);
+    pool->free(threadBuffer, 1'000);
+  }).join();
+  ASSERT_EQ(pool->usedBytes(), kThreadCacheBytes);
+
+  // Frees beyond the cached bytes return the unused reservation to the pool.
+  constexpr int32_t kNumBuffers = 1'000;
+  std::vector<void*> buffers;
+  for (int32_t i = 0; i < kNumBuffers; ++i) {
+    buffers.push_back(pool->allocate(KB));
+  }
+  ASSERT_GE(pool->usedBytes(), kNumBuffers * KB);
+  ASSERT_LE(pool->usedBytes(), kNumBuffers * KB + 2 * kThreadCacheBytes);
+  for (auto* allocated : buffers) {
+    pool->free(allocated, KB);
+  }
+  ASSERT_LE(pool->usedBytes(), 3 * kThreadCacheBytes);
+
+  // The cached memory is returned on pool destruction.
+  pool.reset();
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
+TEST_P(MemoryPoolTest, allocationSampling) {
+  setupMemory(
+      {.debugEnabled = false,
+       .memoryPoolAllocationSampleBytes = 1,
+       .allocatorCapacity = kDefaultCapacity,
+       .arbitratorCapacity = kDefaultCapacity,
+       .arbitratorReservedCapacity = 1LL << 30});
+  auto root = getMemoryManager()->addRootPool("allocationSampling");
+  auto* rootImpl = static_cast<MemoryPoolImpl*>(root.get());
+  auto pool = root->addLeafChild("allocationSampling", isLeafThreadSafe_);
+  auto otherPool = root->addLeafChild("other", isLeafThreadSafe_);
+
+  // A sample interval of one byte samples every allocation.
+  void* first = pool->allocate(1000);
+  void* second = pool->allocate(2000);
+  void* third = otherPool->allocate(3000);
+  ContiguousAllocation contiguous;
+  pool->allocateContiguous(4, contiguous);
+  pool->free(second, 2000);
+  auto profile = rootImpl->heapProfile();
+  ASSERT_EQ(
+      profile.find(fmt::format(
+          "heap profile: 3: {} [4: {}] @ heap_v2/1\n",
+          1000 + 3000 + contiguous.size(),
+          1000 + 2000 + 3000 + contiguous.size())),
+      0)
+      << profile;
+  ASSERT_NE(profile.find("\nMAPPED_LIBRARIES:\n"), std::string::npos);
+  // The profile of a leaf only has its own samples.
+  profile = static_cast<MemoryPoolImpl*>(otherPool.get())->heapProfile();
+  ASSERT_EQ(profile.find("heap profile: 1: 3000 [1: 3000] @ heap_v2/1\n"), 0)
+      << profile;
+
+  pool->free(first, 1000);
+  otherPool->free(third, 3000);
+  pool->freeContiguous(contiguous);
+  profile = rootImpl->heapProfile();
+  ASSERT_EQ(
+      profile.find(fmt::format(
+          "heap profile: 0: 0 [4: {}] @ heap_v2/1\n",
+          1000 + 2000 + 3000 + AllocationTraits::pageBytes(4))),
+      0)
+      << profile;
+}
+
 TEST_P(MemoryPoolTest, concurrentUpdateToSharedPools) {
   // under some conditions bug.
   constexpr int64_t kMaxMemory = 10 * GB;
@@ -104,6 +104,11 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
       memory::MemoryReclaimer::abort(pool, error);
     }
 
+    int32_t priority() const override {
+      auto task = task_.lock();
+      return task == nullptr ? 0 : task->priority_.load();
+    }
+
    private:
     std::weak_ptr<MockTask> task_;
   };
@@ -146,6 +151,10 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
     error_ = error;
   }
 
+  void setPriority(int32_t priority) {
+    priority_ = priority;
+  }
+
  private:
   inline static std::atomic<int64_t> poolId_{0};
   std::shared_ptr<MemoryPool> root_;
@@ -153,6 +162,7 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
   std::vector<std::shared_ptr<MemoryPool>> pools_;
   std::vector<std::shared_ptr<MockMemoryOperator>> ops_;
   std::exception_ptr error_{nullptr};
+  std::atomic<int32_t> priority_{0};
 };
 
 class MockMemoryOperator {
@@ -426,7 +436,10 @@ class MockSharedArbitrationTest : public testing::Test {
       uint64_t memoryPoolReserveCapacity = kMemoryPoolReservedCapacity,
       uint64_t memoryPoolTransferCapacity = kMemoryPoolTransferCapacity,
       std::function<void(MemoryPool&)> arbitrationStateCheckCb = nullptr,
-      bool globalArtbitrationEnabled = true) {
+      bool globalArtbitrationEnabled = true,
+      uint64_t backgroundArbitrationIntervalMs = 0,
+      double backgroundArbitrationFreeCapacityRatio = 0.1,
+      uint64_t lowPriorityPauseMs = 0) {
     MemoryManagerOptions options;
     options.allocatorCapacity = memoryCapacity;
     options.arbitratorReservedCapacity = reservedMemoryCapacity;
@@ -438,6 +451,10 @@ class MockSharedArbitrationTest : public testing::Test {
     options.globalArbitrationEnabled = globalArtbitrationEnabled;
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
     options.checkUsageLeak = true;
+    options.backgroundArbitrationIntervalMs = backgroundArbitrationIntervalMs;
+    options.backgroundArbitrationFreeCapacityRatio =
+        backgroundArbitrationFreeCapacityRatio;
+    options.lowPriorityPauseMs = lowPriorityPauseMs;
     manager_ = std::make_unique<MemoryManager>(options);
     ASSERT_EQ(manager_->arbitrator()->kind(), arbitratorKind);
     arbitrator_ = static_cast<SharedArbitrator*>(manager_->arbitrator());
@@ -2261,6 +2278,109 @@ TEST_F(MockSharedArbitrationTest, arbitrateWithMemoryReclaim) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, backgroundArbitration) {
+  const uint64_t memoryCapacity = 256 * MB;
+  // The background thread does not run during the test, which runs the
+  // background arbitration explicitly.
+  setupMemory(
+      memoryCapacity,
+      0,
+      0,
+      0,
+      kMemoryPoolTransferCapacity,
+      nullptr,
+      true,
+      3'600'000,
+      0.25);
+  auto* growingOp = addMemoryOp();
+  auto* stableOp = addMemoryOp();
+  ASSERT_EQ(arbitrator_->testingRunBackgroundArbitration(), 0);
+
+  const int allocateSize = 8 * MB;
+  while (growingOp->pool()->usedBytes() < 160 * MB) {
+    growingOp->allocate(allocateSize);
+  }
+  while (stableOp->pool()->usedBytes() < 32 * MB) {
+    stableOp->allocate(allocateSize);
+  }
+  // The predicted growth exceeds the free capacity, so the background
+  // arbitration spills the fastest growing query.
+  ASSERT_GT(arbitrator_->testingRunBackgroundArbitration(), 0);
+  ASSERT_EQ(arbitrator_->testingNumBackgroundArbitrations(), 1);
+  ASSERT_EQ(growingOp->reclaimer()->stats().numReclaims, 1);
+  ASSERT_LT(growingOp->pool()->usedBytes(), 160 * MB);
+  ASSERT_EQ(stableOp->reclaimer()->stats().numReclaims, 0);
+  ASSERT_EQ(stableOp->pool()->usedBytes(), 32 * MB);
+  ASSERT_GE(arbitrator_->stats().freeCapacityBytes, memoryCapacity / 4);
+
+  // No more growth is predicted.
+  ASSERT_EQ(arbitrator_->testingRunBackgroundArbitration(), 0);
+  ASSERT_EQ(arbitrator_->testingNumBackgroundArbitrations(), 1);
+}
+
+TEST_F(MockSharedArbitrationTest, priorityBasedAbort) {
+  const uint64_t memoryCapacity = 256 * MB;
+  setupMemory(memoryCapacity, 0, 0, 0);
+  auto lowTask = addTask();
+  auto* lowOp = addMemoryOp(lowTask, false);
+  auto highTask = addTask();
+  highTask->setPriority(1);
+  auto* highOp = addMemoryOp(highTask, false);
+  lowOp->allocate(96 * MB);
+  highOp->allocate(128 * MB);
+
+  // The requestor has the largest capacity but the query of lower priority is
+  // aborted.
+  highOp->allocate(64 * MB);
+  ASSERT_TRUE(lowTask->pool()->aborted());
+  ASSERT_NE(lowTask->error(), nullptr);
+  ASSERT_FALSE(highTask->pool()->aborted());
+  ASSERT_EQ(highTask->error(), nullptr);
+  ASSERT_EQ(arbitrator_->testingNumLowPriorityPauses(), 0);
+
+  // A query is not aborted for one of lower priority.
+  lowTask = addTask();
+  lowOp = addMemoryOp(lowTask, false);
+  VELOX_ASSERT_THROW(lowOp->allocate(128 * MB), "Exceeded memory pool cap");
+  ASSERT_FALSE(highTask->pool()->aborted());
+}
+
+TEST_F(MockSharedArbitrationTest, lowPriorityPause) {
+  const uint64_t memoryCapacity = 256 * MB;
+  setupMemory(
+      memoryCapacity,
+      0,
+      0,
+      0,
+      kMemoryPoolTransferCapacity,
+      nullptr,
+      true,
+      0,
+      0.1,
+      60'000);
+  auto lowTask = addTask();
+  auto* lowOp = addMemoryOp(lowTask, false);
+  auto highTask = addTask();
+  highTask->setPriority(1);
+  auto* highOp = addMemoryOp(highTask, false);
+  highOp->allocate(200 * MB);
+
+  // The query of lower priority waits for memory instead of failing.
+  std::thread lowThread([&]() { lowOp->allocate(96 * MB); });
+  while (arbitrator_->testingNumLowPriorityPauses() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  ASSERT_FALSE(lowTask->pool()->aborted());
+  ASSERT_FALSE(highTask->pool()->aborted());
+
+  // Resumes when the query of higher priority finishes.
+  highOp->freeAll();
+  highTask.reset();
+  lowThread.join();
+  ASSERT_EQ(lowTask->error(), nullptr);
+  ASSERT_GE(lowOp->pool()->usedBytes(), 96 * MB);
+}
+
 TEST_F(MockSharedArbitrationTest, arbitrateBySelfMemoryReclaim) {
   const std::vector<bool> isLeafReclaimables = {true, false};
   for (const auto isLeafReclaimable : isLeafReclaimables) {
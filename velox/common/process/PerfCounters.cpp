@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+#endif
+
+namespace facebook::velox::process {
+
+#ifdef __linux__
+namespace {
+
+// The perf_event group of the counters of a thread. Closed when the thread
+// exits.
+class ThreadPerfEvents {
+ public:
+  static constexpr int32_t kNumEvents = 4;
+
+  ThreadPerfEvents() {
+    const std::array<std::pair<uint32_t, uint64_t>, kNumEvents> events{
+        {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+         {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+         {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+         {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}}};
+    for (auto i = 0; i < kNumEvents; ++i) {
+      fds_[i] = open(events[i].first, events[i].second, i == 0 ? -1 : fds_[0]);
+      if (fds_[i] < 0) {
+        closeAll();
+        return;
+      }
+    }
+  }
+
+  ~ThreadPerfEvents() {
+    closeAll();
+  }
+
+  bool read(PerfCounts& counts) const {
+    if (fds_[0] < 0) {
+      return false;
+    }
+    // The layout for PERF_FORMAT_GROUP: the number of events followed by
+    // their values in the order they were added to the group.
+    std::array<uint64_t, 1 + kNumEvents> values;
+    const ssize_t size = sizeof(values);
+    if (::read(fds_[0], values.data(), size) != size ||
+        values[0] != kNumEvents) {
+      return false;
+    }
+    counts.cycles = values[1];
+    counts.instructions = values[2];
+    counts.llcMisses = values[3];
+    counts.branchMisses = values[4];
+    return true;
+  }
+
+ private:
+  static int open(uint32_t type, uint64_t config, int groupFd) {
+    struct perf_event_attr attr;
+    ::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Counts the calling thread on any CPU.
+    return static_cast<int>(
+        ::syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+  }
+
+  void closeAll() {
+    for (auto& fd : fds_) {
+      if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+      }
+    }
+  }
+
+  std::array<int, kNumEvents> fds_{-1, -1, -1, -1};
+};
+} // namespace
+
+bool readThreadPerfCounts(PerfCounts& counts) {
+  thread_local ThreadPerfEvents events;
+  return events.read(counts);
+}
+#else
+bool readThreadPerfCounts(PerfCounts& /*counts*/) {
+  return false;
+}
+#endif
+
+} // namespace facebook::velox::process
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace facebook::velox::process {
+
+/// Hardware event counts of a thread from Linux perf_event. Only user space
+/// events are counted.
+struct PerfCounts {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  uint64_t llcMisses{0};
+  uint64_t branchMisses{0};
+
+  PerfCounts operator-(const PerfCounts& other) const {
+    return {
+        cycles - other.cycles,
+        instructions - other.instructions,
+        llcMisses - other.llcMisses,
+        branchMisses - other.branchMisses};
+  }
+};
+
+/// Reads the hardware counters of the calling thread into 'counts'. The
+/// counters are opened as one perf_event group on the first call in each
+/// thread and stay open until the thread exits, so that a read is a single
+/// read(2) system call. Returns false if the counters are not available, e.g.
+/// not on Linux, in a VM without a PMU or if forbidden by
+/// /proc/sys/kernel/perf_event_paranoid.
+bool readThreadPerfCounts(PerfCounts& counts);
+
+} // namespace facebook::velox::process
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Timeline.h"
+
+#include <chrono>
+
+#include <fmt/format.h>
+#include <folly/json.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::process {
+
+namespace {
+struct ThreadTimeline {
+  Timeline* timeline{nullptr};
+  int32_t pid{0};
+  int32_t tid{0};
+};
+
+thread_local ThreadTimeline threadTimeline;
+} // namespace
+
+Timeline::Timeline(int32_t capacity) : capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0);
+}
+
+void Timeline::add(Event event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() < capacity_) {
+    events_.push_back(std::move(event));
+  } else {
+    events_[numAdded_ % capacity_] = std::move(event);
+  }
+  ++numAdded_;
+}
+
+std::vector<Timeline::Event> Timeline::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<Event> events;
+  events.reserve(events_.size());
+  const auto first = events_.size() < capacity_ ? 0 : numAdded_ % capacity_;
+  for (auto i = 0; i < events_.size(); ++i) {
+    events.push_back(events_[(first + i) % events_.size()]);
+  }
+  return events;
+}
+
+uint64_t Timeline::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numAdded_ - events_.size();
+}
+
+std::string Timeline::toChromeTrace() const {
+  folly::dynamic traceEvents = folly::dynamic::array;
+  for (const auto& event : events()) {
+    // A complete event with a start and a duration.
+    folly::dynamic traceEvent = folly::dynamic::object;
+    traceEvent["name"] = event.name;
+    traceEvent["cat"] = event.category;
+    traceEvent["ph"] = "X";
+    traceEvent["ts"] = event.startUs;
+    traceEvent["dur"] = event.durationUs;
+    traceEvent["pid"] = event.pid;
+    traceEvent["tid"] = event.tid;
+    traceEvents.push_back(std::move(traceEvent));
+  }
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  return folly::toJson(trace);
+}
+
+// static
+uint64_t Timeline::nowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::high_resolution_clock::now().time_since_epoch())
+      .count();
+}
+
+// static
+Timeline* Timeline::current() {
+  return threadTimeline.timeline;
+}
+
+Timeline::ScopedThread::ScopedThread(
+    Timeline* timeline,
+    int32_t pid,
+    int32_t tid)
+    : timeline_(timeline) {
+  if (timeline_ == nullptr) {
+    return;
+  }
+  prevTimeline_ = threadTimeline.timeline;
+  prevPid_ = threadTimeline.pid;
+  prevTid_ = threadTimeline.tid;
+  threadTimeline = {timeline_, pid, tid};
+}
+
+Timeline::ScopedThread::~ScopedThread() {
+  if (timeline_ != nullptr) {
+    threadTimeline = {prevTimeline_, prevPid_, prevTid_};
+  }
+}
+
+Timeline::ScopedEvent::ScopedEvent(
+    const char* category,
+    std::string_view name,
+    std::string_view detail)
+    : timeline_(threadTimeline.timeline), category_(category) {
+  if (timeline_ == nullptr) {
+    return;
+  }
+  name_ = detail.empty() ? std::string(name)
+                         : fmt::format("{}.{}", name, detail);
+  startUs_ = nowMicros();
+}
+
+Timeline::ScopedEvent::~ScopedEvent() {
+  if (timeline_ == nullptr) {
+    return;
+  }
+  timeline_->add(
+      {category_,
+       std::move(name_),
+       threadTimeline.pid,
+       threadTimeline.tid,
+       startUs_,
+       nowMicros() - startUs_});
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Records timed intervals, e.g. the runs of the Drivers of a Task, operator
+/// calls, blocked waits and IO, in a fixed size ring buffer. The buffer keeps
+/// the last 'capacity' intervals. The intervals can be exported in the Chrome
+/// trace event format, which chrome://tracing and Perfetto display as a
+/// timeline with a row per 'pid' and 'tid' of the intervals. Thread safe.
+class Timeline {
+ public:
+  struct Event {
+    /// Static string naming the kind of interval, e.g. "operator".
+    const char* category{nullptr};
+    std::string name;
+    /// The process and thread of the interval in the trace. A Task uses the
+    /// pipeline and Driver ids.
+    int32_t pid{0};
+    int32_t tid{0};
+    uint64_t startUs{0};
+    uint64_t durationUs{0};
+  };
+
+  explicit Timeline(int32_t capacity);
+
+  /// Adds 'event'. Replaces the oldest event if full.
+  void add(Event event);
+
+  /// Returns the events in the order they were added.
+  std::vector<Event> events() const;
+
+  /// Number of events replaced by newer ones.
+  uint64_t numDropped() const;
+
+  /// Returns the events as a JSON trace in the Chrome trace event format.
+  std::string toChromeTrace() const;
+
+  /// The time used for Event::startUs.
+  static uint64_t nowMicros();
+
+  /// Returns the timeline set for the calling thread by ScopedThread. nullptr
+  /// if none.
+  static Timeline* current();
+
+  /// Sets 'timeline' as the timeline of the calling thread with 'pid' and
+  /// 'tid' for the events added by ScopedEvent. Restores the previous setting
+  /// on destruction. No-op if 'timeline' is nullptr.
+  class ScopedThread {
+   public:
+    ScopedThread(Timeline* timeline, int32_t pid, int32_t tid);
+
+    ~ScopedThread();
+
+   private:
+    Timeline* const timeline_;
+    Timeline* prevTimeline_{nullptr};
+    int32_t prevPid_{0};
+    int32_t prevTid_{0};
+  };
+
+  /// Adds an event for its lifetime to the timeline of the calling thread.
+  /// The name is 'name' followed by '.' and 'detail' if 'detail' is not empty.
+  /// No-op without a timeline, so it costs a thread local read when tracing
+  /// is off.
+  class ScopedEvent {
+   public:
+    ScopedEvent(
+        const char* category,
+        std::string_view name,
+        std::string_view detail = {});
+
+    ~ScopedEvent();
+
+   private:
+    Timeline* const timeline_;
+    const char* const category_;
+    std::string name_;
+    uint64_t startUs_{0};
+  };
+
+ private:
+  const int32_t capacity_;
+
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+  // Number of events added. The next event goes to 'numAdded_ % capacity_'.
+  uint64_t numAdded_{0};
+};
+
+} // namespace facebook::velox::process
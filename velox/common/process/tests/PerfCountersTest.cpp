@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(PerfCountersTest, threadCounts) {
+  PerfCounts start;
+  if (!readThreadPerfCounts(start)) {
+    GTEST_SKIP() << "perf_event counters are not available";
+  }
+  volatile uint64_t sum = 0;
+  for (auto i = 0; i < 1'000'000; ++i) {
+    sum = sum + i;
+  }
+  PerfCounts end;
+  ASSERT_TRUE(readThreadPerfCounts(end));
+  const auto delta = end - start;
+  ASSERT_GT(delta.cycles, 0);
+  ASSERT_GE(delta.instructions, 1'000'000);
+
+  // Each thread has its own counters, which start when first read.
+  std::thread([&]() {
+    PerfCounts other;
+    ASSERT_TRUE(readThreadPerfCounts(other));
+    ASSERT_LT(other.instructions, delta.instructions);
+  }).join();
+}
+} // namespace
+} // namespace facebook::velox::process
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/Timeline.h"
+
+#include <fmt/format.h>
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(TimelineTest, ringBuffer) {
+  Timeline timeline(4);
+  for (uint64_t i = 0; i < 6; ++i) {
+    timeline.add({"test", fmt::format("event{}", i), 1, 2, 100 + i, 10});
+  }
+  ASSERT_EQ(timeline.numDropped(), 2);
+  auto events = timeline.events();
+  ASSERT_EQ(events.size(), 4);
+  for (auto i = 0; i < events.size(); ++i) {
+    ASSERT_EQ(events[i].name, fmt::format("event{}", i + 2));
+    ASSERT_EQ(events[i].startUs, 102 + i);
+  }
+}
+
+TEST(TimelineTest, scopedEvent) {
+  {
+    // Without a timeline of the thread ScopedEvent is a no-op.
+    Timeline::ScopedEvent event("test", "noTimeline");
+  }
+  ASSERT_EQ(Timeline::current(), nullptr);
+
+  Timeline timeline(16);
+  {
+    Timeline::ScopedThread scopedThread(&timeline, 3, 7);
+    ASSERT_EQ(Timeline::current(), &timeline);
+    Timeline::ScopedEvent outer("driver", "run");
+    {
+      Timeline::ScopedThread nullThread(nullptr, 0, 0);
+      ASSERT_EQ(Timeline::current(), &timeline);
+      Timeline::ScopedEvent inner("operator", "Values", "getOutput");
+    }
+  }
+  ASSERT_EQ(Timeline::current(), nullptr);
+
+  auto events = timeline.events();
+  ASSERT_EQ(events.size(), 2);
+  ASSERT_EQ(events[0].name, "Values.getOutput");
+  ASSERT_STREQ(events[0].category, "operator");
+  ASSERT_EQ(events[1].name, "run");
+  for (const auto& event : events) {
+    ASSERT_EQ(event.pid, 3);
+    ASSERT_EQ(event.tid, 7);
+  }
+  ASSERT_LE(events[1].startUs, events[0].startUs);
+  ASSERT_LE(
+      events[0].startUs + events[0].durationUs,
+      events[1].startUs + events[1].durationUs);
+}
+
+TEST(TimelineTest, chromeTrace) {
+  Timeline timeline(8);
+  timeline.add({"blocked", "kWaitForExchange", 0, 1, 1'000, 250});
+  auto trace = folly::parseJson(timeline.toChromeTrace());
+  ASSERT_EQ(trace["displayTimeUnit"], "ms");
+  const auto& events = trace["traceEvents"];
+  ASSERT_EQ(events.size(), 1);
+  ASSERT_EQ(events[0]["name"], "kWaitForExchange");
+  ASSERT_EQ(events[0]["cat"], "blocked");
+  ASSERT_EQ(events[0]["ph"], "X");
+  ASSERT_EQ(events[0]["ts"].asInt(), 1'000);
+  ASSERT_EQ(events[0]["dur"].asInt(), 250);
+  ASSERT_EQ(events[0]["pid"].asInt(), 0);
+  ASSERT_EQ(events[0]["tid"].asInt(), 1);
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/serialization/BinarySerialization.h"
+
+#include <folly/Varint.h>
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+namespace {
+
+constexpr uint8_t kVersion = 1;
+
+enum Tag : uint8_t {
+  kNull,
+  kFalse,
+  kTrue,
+  kInt,
+  kDouble,
+  // A string that is not in the string table, followed by its size and bytes.
+  // Adds the string to the table.
+  kString,
+  // A string in the string table, followed by its index.
+  kStringRef,
+  kArray,
+  kObject,
+  // An array or object that is added to the value table after it is read.
+  kDefine,
+  // An array or object in the value table, followed by its index.
+  kValueRef,
+};
+
+// Returns true if 'left' and 'right' have the same types and values. Unlike
+// folly::dynamic::operator==, does not consider 1 and 1.0 equal.
+bool strictEquals(const folly::dynamic& left, const folly::dynamic& right) {
+  if (left.type() != right.type()) {
+    return false;
+  }
+  switch (left.type()) {
+    case folly::dynamic::ARRAY:
+      if (left.size() != right.size()) {
+        return false;
+      }
+      for (auto i = 0; i < left.size(); ++i) {
+        if (!strictEquals(left[i], right[i])) {
+          return false;
+        }
+      }
+      return true;
+    case folly::dynamic::OBJECT:
+      if (left.size() != right.size()) {
+        return false;
+      }
+      for (const auto& [key, value] : left.items()) {
+        auto* other = right.get_ptr(key);
+        if (other == nullptr || !strictEquals(value, *other)) {
+          return false;
+        }
+      }
+      return true;
+    default:
+      return left == right;
+  }
+}
+
+// Identifies an array or object by its content.
+struct SubtreeKey {
+  uint64_t hash;
+  const folly::dynamic* value;
+};
+
+struct SubtreeKeyHasher {
+  size_t operator()(const SubtreeKey& key) const {
+    return key.hash;
+  }
+};
+
+struct SubtreeKeyEqual {
+  bool operator()(const SubtreeKey& left, const SubtreeKey& right) const {
+    return left.hash == right.hash && strictEquals(*left.value, *right.value);
+  }
+};
+
+template <typename T>
+using SubtreeMap =
+    folly::F14FastMap<SubtreeKey, T, SubtreeKeyHasher, SubtreeKeyEqual>;
+
+class Encoder {
+ public:
+  std::string encode(const folly::dynamic& value) {
+    countSubtrees(value);
+    out_.push_back(kVersion);
+    write(value);
+    return std::move(out_);
+  }
+
+ private:
+  static bool isSubtree(const folly::dynamic& value) {
+    return (value.isArray() || value.isObject()) && !value.empty();
+  }
+
+  // Returns the hash of 'value' and counts the occurrences of the non-empty
+  // arrays and objects in 'value' by content.
+  uint64_t countSubtrees(const folly::dynamic& value) {
+    uint64_t hash;
+    if (value.isArray()) {
+      hash = kArray;
+      for (const auto& element : value) {
+        hash = folly::hash::hash_128_to_64(hash, countSubtrees(element));
+      }
+    } else if (value.isObject()) {
+      // The order of the items of an object is not defined, so their hashes
+      // are combined with a commutative operation.
+      uint64_t itemsHash = 0;
+      for (const auto& [key, item] : value.items()) {
+        itemsHash +=
+            folly::hash::hash_128_to_64(key.hash(), countSubtrees(item));
+      }
+      hash = folly::hash::hash_128_to_64(kObject, itemsHash);
+    } else {
+      return folly::hash::hash_128_to_64(value.type(), value.hash());
+    }
+    if (!value.empty()) {
+      hashes_[&value] = hash;
+      ++counts_[SubtreeKey{hash, &value}];
+    }
+    return hash;
+  }
+
+  void write(const folly::dynamic& value) {
+    switch (value.type()) {
+      case folly::dynamic::NULLT:
+        out_.push_back(kNull);
+        return;
+      case folly::dynamic::BOOL:
+        out_.push_back(value.asBool() ? kTrue : kFalse);
+        return;
+      case folly::dynamic::INT64:
+        out_.push_back(kInt);
+        writeVarint(folly::encodeZigZag(value.asInt()));
+        return;
+      case folly::dynamic::DOUBLE: {
+        out_.push_back(kDouble);
+        const double number = value.asDouble();
+        out_.append(reinterpret_cast<const char*>(&number), sizeof(number));
+        return;
+      }
+      case folly::dynamic::STRING:
+        writeString(value.stringPiece());
+        return;
+      case folly::dynamic::ARRAY:
+      case folly::dynamic::OBJECT:
+        break;
+    }
+
+    if (isSubtree(value)) {
+      const SubtreeKey key{hashes_.at(&value), &value};
+      if (counts_.at(key) > 1) {
+        auto it = defined_.find(key);
+        if (it != defined_.end()) {
+          out_.push_back(kValueRef);
+          writeVarint(it->second);
+          return;
+        }
+        out_.push_back(kDefine);
+        writeContainer(value);
+        // The index is assigned after the content is written, as the decoder
+        // adds the value to its table after reading it.
+        defined_.emplace(key, defined_.size());
+        return;
+      }
+    }
+    writeContainer(value);
+  }
+
+  void writeContainer(const folly::dynamic& value) {
+    if (value.isArray()) {
+      out_.push_back(kArray);
+      writeVarint(value.size());
+      for (const auto& element : value) {
+        write(element);
+      }
+      return;
+    }
+    out_.push_back(kObject);
+    writeVarint(value.size());
+    for (const auto& [key, item] : value.items()) {
+      VELOX_CHECK(
+          key.isString(),
+          "Binary serialization supports only string keys: {}",
+          key.typeName());
+      writeString(key.stringPiece());
+      write(item);
+    }
+  }
+
+  void writeString(folly::StringPiece string) {
+    const std::string_view view(string.data(), string.size());
+    auto it = strings_.find(view);
+    if (it != strings_.end()) {
+      out_.push_back(kStringRef);
+      writeVarint(it->second);
+      return;
+    }
+    out_.push_back(kString);
+    writeVarint(view.size());
+    out_.append(view);
+    strings_.emplace(std::string(view), strings_.size());
+  }
+
+  void writeVarint(uint64_t value) {
+    uint8_t buffer[folly::kMaxVarintLength64];
+    const auto size = folly::encodeVarint(value, buffer);
+    out_.append(reinterpret_cast<const char*>(buffer), size);
+  }
+
+  std::string out_;
+  folly::F14FastMap<std::string, uint32_t> strings_;
+  folly::F14FastMap<const folly::dynamic*, uint64_t> hashes_;
+  SubtreeMap<int32_t> counts_;
+  SubtreeMap<uint32_t> defined_;
+};
+
+class Decoder {
+ public:
+  explicit Decoder(std::string_view data) : data_(data) {}
+
+  folly::dynamic decode() {
+    VELOX_CHECK(
+        !data_.empty() && data_[0] == kVersion,
+        "Unsupported binary serialization version");
+    position_ = 1;
+    auto value = read();
+    VELOX_CHECK_EQ(
+        position_, data_.size(), "Trailing bytes in binary serialization");
+    return value;
+  }
+
+ private:
+  folly::dynamic read() {
+    const auto tag = readByte();
+    switch (tag) {
+      case kNull:
+        return nullptr;
+      case kFalse:
+        return false;
+      case kTrue:
+        return true;
+      case kInt:
+        return folly::decodeZigZag(readVarint());
+      case kDouble: {
+        double number;
+        memcpy(&number, readBytes(sizeof(number)).data(), sizeof(number));
+        return number;
+      }
+      case kString:
+      case kStringRef:
+        return std::string(readString(tag));
+      case kArray:
+      case kObject:
+        return readContainer(tag);
+      case kDefine: {
+        auto value = readContainer(readByte());
+        values_.push_back(value);
+        return value;
+      }
+      case kValueRef: {
+        const auto index = readVarint();
+        VELOX_CHECK_LT(index, values_.size(), "Bad value reference");
+        return values_[index];
+      }
+      default:
+        VELOX_FAIL("Bad tag in binary serialization: {}", tag);
+    }
+  }
+
+  folly::dynamic readContainer(uint8_t tag) {
+    const auto size = readVarint();
+    if (tag == kArray) {
+      auto array = folly::dynamic::array();
+      for (uint64_t i = 0; i < size; ++i) {
+        array.push_back(read());
+      }
+      return array;
+    }
+    VELOX_CHECK(tag == kObject, "Expected an array or object");
+    folly::dynamic object = folly::dynamic::object;
+    for (uint64_t i = 0; i < size; ++i) {
+      auto key = readString(readByte());
+      object.insert(std::string(key), read());
+    }
+    return object;
+  }
+
+  // Returns a view of a string in 'data_'.
+  std::string_view readString(uint8_t tag) {
+    if (tag == kStringRef) {
+      const auto index = readVarint();
+      VELOX_CHECK_LT(index, strings_.size(), "Bad string reference");
+      return strings_[index];
+    }
+    VELOX_CHECK(tag == kString, "Expected a string");
+    const auto string = readBytes(readVarint());
+    strings_.push_back(string);
+    return string;
+  }
+
+  uint8_t readByte() {
+    return readBytes(1)[0];
+  }
+
+  std::string_view readBytes(uint64_t size) {
+    VELOX_CHECK_LE(
+        size, data_.size() - position_, "Truncated binary serialization");
+    const auto bytes = data_.substr(position_, size);
+    position_ += size;
+    return bytes;
+  }
+
+  uint64_t readVarint() {
+    folly::ByteRange range(
+        reinterpret_cast<const uint8_t*>(data_.data()) + position_,
+        data_.size() - position_);
+    const auto begin = range.begin();
+    auto value = folly::tryDecodeVarint(range);
+    VELOX_CHECK(value.hasValue(), "Bad varint in binary serialization");
+    position_ += range.begin() - begin;
+    return value.value();
+  }
+
+  const std::string_view data_;
+  size_t position_{0};
+  std::vector<std::string_view> strings_;
+  std::vector<folly::dynamic> values_;
+};
+
+} // namespace
+
+std::string serializeBinary(const folly::dynamic& value) {
+  return Encoder().encode(value);
+}
+
+folly::dynamic deserializeBinary(std::string_view data) {
+  return Decoder(data).decode();
+}
+
+} // namespace facebook::velox
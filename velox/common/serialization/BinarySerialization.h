@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <folly/dynamic.h>
+
+namespace facebook::velox {
+
+/// Encodes the folly::dynamic form of an ISerializable, e.g. a plan fragment,
+/// in a compact binary format that decodes faster than JSON text. Values are
+/// tagged with one byte, integers and sizes are varints and doubles are
+/// copied as is. Each distinct string is written once and referenced by its
+/// index afterwards, so the keys of the serialized objects and repeated names
+/// cost one or two bytes. Arrays and objects that appear more than once, such
+/// as the serialized form of a type or of a repeated expression, are written
+/// once and referenced afterwards.
+///
+/// Example:
+///   auto binary = serializeBinary(plan->serialize());
+///   auto copy = ISerializable::deserialize<core::PlanNode>(
+///       deserializeBinary(binary), pool);
+std::string serializeBinary(const folly::dynamic& value);
+
+/// Decodes a value encoded with serializeBinary(). Throws if 'data' is not a
+/// valid encoding.
+folly::dynamic deserializeBinary(std::string_view data);
+
+} // namespace facebook::velox
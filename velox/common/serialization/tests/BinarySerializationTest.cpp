@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/serialization/BinarySerialization.h"
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace ::facebook::velox;
+
+namespace {
+
+// Returns true if 'lhs' and 'rhs' are equal and have the same types, e.g. 1
+// and 1.0 are different.
+bool strictEquals(const folly::dynamic& lhs, const folly::dynamic& rhs) {
+  if (lhs.type() != rhs.type()) {
+    return false;
+  }
+  if (lhs.isArray()) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    for (auto i = 0; i < lhs.size(); ++i) {
+      if (!strictEquals(lhs[i], rhs[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (lhs.isObject()) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    for (const auto& [key, value] : lhs.items()) {
+      auto* other = rhs.get_ptr(key);
+      if (other == nullptr || !strictEquals(value, *other)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return lhs == rhs;
+}
+
+void testRoundTrip(const folly::dynamic& value) {
+  auto copy = deserializeBinary(serializeBinary(value));
+  ASSERT_TRUE(strictEquals(value, copy))
+      << folly::toJson(value) << " vs " << folly::toJson(copy);
+}
+
+TEST(BinarySerializationTest, scalars) {
+  testRoundTrip(nullptr);
+  testRoundTrip(true);
+  testRoundTrip(false);
+  testRoundTrip(0);
+  testRoundTrip(1);
+  testRoundTrip(-1);
+  testRoundTrip(std::numeric_limits<int64_t>::max());
+  testRoundTrip(std::numeric_limits<int64_t>::min());
+  testRoundTrip(1.0);
+  testRoundTrip(-0.5);
+  testRoundTrip("");
+  testRoundTrip("velox");
+  testRoundTrip(std::string("a\0b", 3));
+}
+
+TEST(BinarySerializationTest, nested) {
+  folly::dynamic type = folly::dynamic::object("name", "Type")(
+      "type", "ROW")("names", folly::dynamic::array("a", "b"))(
+      "cTypes",
+      folly::dynamic::array(
+          folly::dynamic::object("name", "Type")("type", "BIGINT"),
+          folly::dynamic::object("name", "Type")("type", "BIGINT")));
+
+  // The same type appears several times and at different depths.
+  folly::dynamic plan = folly::dynamic::object("name", "ProjectNode")(
+      "id", "1")("outputType", type)(
+      "sources",
+      folly::dynamic::array(folly::dynamic::object("name", "ValuesNode")(
+          "id", "0")("outputType", type)("repeatTimes", 1)(
+          "parallelizable", false)("ratio", 1.0)));
+  plan["projections"] = folly::dynamic::array(type, type, type);
+  plan["empty"] = folly::dynamic::array();
+  plan["emptyObject"] = folly::dynamic::object();
+  testRoundTrip(plan);
+
+  // Repeated subtrees are written once.
+  folly::dynamic copies = folly::dynamic::array();
+  for (auto i = 0; i < 100; ++i) {
+    copies.push_back(type);
+  }
+  EXPECT_LT(serializeBinary(copies).size(), 2 * serializeBinary(type).size());
+  testRoundTrip(copies);
+
+  // Equal values of different types are not merged.
+  testRoundTrip(folly::dynamic::array(
+      folly::dynamic::array(1, 2),
+      folly::dynamic::array(1.0, 2.0),
+      folly::dynamic::array(1, 2)));
+}
+
+TEST(BinarySerializationTest, corrupt) {
+  folly::dynamic value = folly::dynamic::object("name", "Dot")("radius", 10)(
+      "colors", folly::dynamic::array("red", "blue"));
+  const auto binary = serializeBinary(value);
+  for (auto size = 0; size < binary.size(); ++size) {
+    VELOX_ASSERT_THROW(
+        deserializeBinary(std::string_view(binary.data(), size)), "");
+  }
+  VELOX_ASSERT_THROW(deserializeBinary(binary + "x"), "");
+}
+
+} // namespace
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/theta/ThetaSketch.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "velox/common/base/IOUtils.h"
+
+namespace facebook::velox::common::theta {
+namespace {
+constexpr int8_t kVersion = 1;
+constexpr int32_t kHeaderSize = 14;
+
+struct Header {
+  int8_t lgK;
+  uint64_t theta;
+  int32_t numHashes;
+};
+
+Header readHeader(StringView serialized) {
+  VELOX_USER_CHECK_GE(
+      serialized.size(), kHeaderSize, "Invalid theta sketch: too short");
+  InputByteStream stream(serialized.data());
+  const auto version = stream.read<int8_t>();
+  VELOX_USER_CHECK_EQ(
+      version, kVersion, "Unsupported theta sketch version: {}", version);
+  Header header;
+  header.lgK = stream.read<int8_t>();
+  ThetaSketch::checkLgK(header.lgK);
+  header.theta = stream.read<uint64_t>();
+  VELOX_USER_CHECK(
+      header.theta > 0 && header.theta <= ThetaSketch::kMaxTheta,
+      "Invalid theta sketch: theta out of range");
+  header.numHashes = stream.read<int32_t>();
+  VELOX_USER_CHECK(
+      header.numHashes >= 0 &&
+          serialized.size() ==
+              kHeaderSize + header.numHashes * sizeof(uint64_t),
+      "Invalid theta sketch: size does not match the number of hashes");
+  return header;
+}
+
+// Sets 'hashes' to the hashes of a serialized sketch. Throws a user error if
+// they are not sorted below 'header.theta'. The hashes follow the 14 byte
+// header and the serialized sketch itself has no alignment, so they are
+// copied out instead of being read in place.
+template <typename Vector>
+void readHashes(StringView serialized, const Header& header, Vector& hashes) {
+  hashes.resize(header.numHashes);
+  if (header.numHashes > 0) {
+    std::memcpy(
+        hashes.data(),
+        serialized.data() + kHeaderSize,
+        header.numHashes * sizeof(uint64_t));
+  }
+  for (auto i = 0; i < header.numHashes; ++i) {
+    VELOX_USER_CHECK(
+        hashes[i] < header.theta && (i == 0 || hashes[i - 1] < hashes[i]),
+        "Invalid theta sketch: hashes are not sorted below theta");
+  }
+}
+
+void writeSketch(
+    int8_t lgK,
+    uint64_t theta,
+    const uint64_t* hashes,
+    int32_t numHashes,
+    char* output) {
+  OutputByteStream stream(output);
+  stream.appendOne(kVersion);
+  stream.appendOne(lgK);
+  stream.appendOne(theta);
+  stream.appendOne(numHashes);
+  if (numHashes > 0) {
+    stream.append(
+        reinterpret_cast<const char*>(hashes), numHashes * sizeof(uint64_t));
+  }
+}
+
+double estimate(int64_t numHashes, uint64_t theta) {
+  if (theta == ThetaSketch::kMaxTheta) {
+    return numHashes;
+  }
+  return numHashes * (static_cast<double>(ThetaSketch::kMaxTheta) / theta);
+}
+
+// Sets 'result' to the hashes below 'theta' in the result of 'operation' on
+// the sorted 'left' and 'right' hashes.
+template <typename Vector>
+void applySetOperation(
+    ThetaSketch::SetOperation operation,
+    const uint64_t* left,
+    size_t numLeft,
+    const uint64_t* right,
+    size_t numRight,
+    uint64_t theta,
+    Vector& result) {
+  const auto leftEnd = std::lower_bound(left, left + numLeft, theta);
+  const auto rightEnd = std::lower_bound(right, right + numRight, theta);
+  result.clear();
+  auto output = std::back_inserter(result);
+  switch (operation) {
+    case ThetaSketch::SetOperation::kUnion:
+      std::set_union(left, leftEnd, right, rightEnd, output);
+      break;
+    case ThetaSketch::SetOperation::kIntersection:
+      std::set_intersection(left, leftEnd, right, rightEnd, output);
+      break;
+    case ThetaSketch::SetOperation::kDifference:
+      std::set_difference(left, leftEnd, right, rightEnd, output);
+      break;
+  }
+}
+
+// Keeps the 2^lgK smallest of the sorted 'hashes' and lowers 'theta' to the
+// smallest hash removed.
+template <typename Vector>
+void trim(int8_t lgK, Vector& hashes, uint64_t& theta) {
+  const size_t k = 1 << lgK;
+  if (hashes.size() > k) {
+    theta = hashes[k];
+    hashes.resize(k);
+  }
+}
+} // namespace
+
+ThetaSketch::ThetaSketch(int8_t lgK, HashStringAllocator* allocator)
+    : lgK_{lgK}, hashes_{StlAllocator<uint64_t>(allocator)} {
+  checkLgK(lgK);
+}
+
+ThetaSketch::ThetaSketch(
+    StringView serialized,
+    HashStringAllocator* allocator)
+    : hashes_{StlAllocator<uint64_t>(allocator)} {
+  const auto header = readHeader(serialized);
+  lgK_ = header.lgK;
+  theta_ = header.theta;
+  readHashes(serialized, header, hashes_);
+}
+
+void ThetaSketch::insertHash(uint64_t hash) {
+  hash >>= 1;
+  if (hash >= theta_) {
+    return;
+  }
+  hashes_.push_back(hash);
+  compacted_ = false;
+  // Compacts in batches of K hashes to amortize the sorting.
+  if (hashes_.size() >= (2 << lgK_)) {
+    compact();
+  }
+}
+
+double ThetaSketch::estimate() {
+  compact();
+  return theta::estimate(hashes_.size(), theta_);
+}
+
+// static
+double ThetaSketch::estimate(StringView serialized) {
+  const auto header = readHeader(serialized);
+  return theta::estimate(header.numHashes, header.theta);
+}
+
+void ThetaSketch::combine(SetOperation operation, ThetaSketch& other) {
+  compact();
+  other.compact();
+  theta_ = std::min(theta_, other.theta_);
+  if (operation != SetOperation::kDifference) {
+    lgK_ = std::min(lgK_, other.lgK_);
+  }
+  std::vector<uint64_t, StlAllocator<uint64_t>> result{
+      hashes_.get_allocator()};
+  applySetOperation(
+      operation,
+      hashes_.data(),
+      hashes_.size(),
+      other.hashes_.data(),
+      other.hashes_.size(),
+      theta_,
+      result);
+  hashes_ = std::move(result);
+  trim(lgK_, hashes_, theta_);
+}
+
+// static
+std::string ThetaSketch::combine(
+    SetOperation operation,
+    StringView left,
+    StringView right) {
+  const auto leftHeader = readHeader(left);
+  const auto rightHeader = readHeader(right);
+  auto theta = std::min(leftHeader.theta, rightHeader.theta);
+  const auto lgK = operation == SetOperation::kDifference
+      ? leftHeader.lgK
+      : std::min(leftHeader.lgK, rightHeader.lgK);
+  std::vector<uint64_t> leftHashes;
+  readHashes(left, leftHeader, leftHashes);
+  std::vector<uint64_t> rightHashes;
+  readHashes(right, rightHeader, rightHashes);
+  std::vector<uint64_t> hashes;
+  applySetOperation(
+      operation,
+      leftHashes.data(),
+      leftHashes.size(),
+      rightHashes.data(),
+      rightHashes.size(),
+      theta,
+      hashes);
+  trim(lgK, hashes, theta);
+
+  std::string serialized(kHeaderSize + hashes.size() * sizeof(uint64_t), '\0');
+  writeSketch(lgK, theta, hashes.data(), hashes.size(), serialized.data());
+  return serialized;
+}
+
+int32_t ThetaSketch::serializedSize() {
+  compact();
+  return kHeaderSize + hashes_.size() * sizeof(uint64_t);
+}
+
+void ThetaSketch::serialize(char* output) {
+  compact();
+  writeSketch(lgK_, theta_, hashes_.data(), hashes_.size(), output);
+}
+
+// static
+std::string ThetaSketch::serializeEmpty(int8_t lgK) {
+  checkLgK(lgK);
+  std::string serialized(kHeaderSize, '\0');
+  writeSketch(lgK, kMaxTheta, nullptr, 0, serialized.data());
+  return serialized;
+}
+
+// static
+void ThetaSketch::checkLgK(int64_t lgK) {
+  VELOX_USER_CHECK(
+      lgK >= kMinLgK && lgK <= kMaxLgK,
+      "Theta sketch lgK must be in [{}, {}] range: {}",
+      kMinLgK,
+      kMaxLgK,
+      lgK);
+}
+
+void ThetaSketch::compact() {
+  if (compacted_) {
+    return;
+  }
+  std::sort(hashes_.begin(), hashes_.end());
+  hashes_.erase(std::unique(hashes_.begin(), hashes_.end()), hashes_.end());
+  trim(lgK_, hashes_, theta_);
+  compacted_ = true;
+}
+
+} // namespace facebook::velox::common::theta
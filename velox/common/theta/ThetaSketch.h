@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/memory/HashStringAllocator.h"
+#include "velox/type/StringView.h"
+
+namespace facebook::velox::common::theta {
+
+/// Theta sketch for estimating the number of distinct values of a set and of
+/// the unions, intersections and differences of sets. The sketch keeps the
+/// 63-bit hashes of the values that are below a threshold 'theta'. Once more
+/// than K = 2^lgK hashes are kept, theta is lowered to keep only the K
+/// smallest. The number of distinct values is estimated by dividing the number
+/// of kept hashes by the fraction of the hash space below theta. The relative
+/// standard error is about 1 / sqrt(K).
+///
+/// Unlike HyperLogLog, sketches of different sets can be intersected and
+/// subtracted: the result keeps the hashes below the smaller theta that are
+/// in both sets or only in the first one.
+///
+/// Serialized format, little-endian:
+///   int8 version, int8 lgK, uint64 theta, int32 number of hashes,
+///   uint64 hashes sorted in ascending order.
+class ThetaSketch {
+ public:
+  static constexpr int8_t kMinLgK = 4;
+  static constexpr int8_t kMaxLgK = 20;
+  static constexpr int8_t kDefaultLgK = 12;
+
+  /// Theta of a sketch that has kept all the hashes it received.
+  static constexpr uint64_t kMaxTheta = 1ULL << 63;
+
+  ThetaSketch(int8_t lgK, HashStringAllocator* allocator);
+
+  /// Deserializes a sketch. Throws a user error if 'serialized' is not a
+  /// valid sketch.
+  ThetaSketch(StringView serialized, HashStringAllocator* allocator);
+
+  /// Adds the hash of a value. Only the top 63 bits are used.
+  void insertHash(uint64_t hash);
+
+  /// Returns the estimated number of distinct values.
+  double estimate();
+
+  /// Returns the estimated number of distinct values of a serialized sketch.
+  static double estimate(StringView serialized);
+
+  enum class SetOperation {
+    kUnion,
+    kIntersection,
+    /// The values of the first sketch that are not in the second one.
+    kDifference,
+  };
+
+  /// Sets this to the result of 'operation' on this and 'other'. The result
+  /// of a union or intersection keeps the smaller K of the two sketches.
+  void combine(SetOperation operation, ThetaSketch& other);
+
+  /// Returns the serialized result of 'operation' on two serialized sketches.
+  static std::string
+  combine(SetOperation operation, StringView left, StringView right);
+
+  int8_t lgK() const {
+    return lgK_;
+  }
+
+  uint64_t theta() const {
+    return theta_;
+  }
+
+  /// Returns the size of the serialized sketch.
+  int32_t serializedSize();
+
+  void serialize(char* output);
+
+  /// Returns an empty serialized sketch.
+  static std::string serializeEmpty(int8_t lgK);
+
+  /// Throws a user error if 'lgK' is out of the [kMinLgK, kMaxLgK] range.
+  static void checkLgK(int64_t lgK);
+
+ private:
+  // Sorts and deduplicates 'hashes_' and keeps at most K of them.
+  void compact();
+
+  int8_t lgK_;
+  uint64_t theta_{kMaxTheta};
+
+  // Hashes below 'theta_'. May be unsorted and have duplicates until the next
+  // compact().
+  std::vector<uint64_t, StlAllocator<uint64_t>> hashes_;
+
+  // True if 'hashes_' is sorted and has no duplicates.
+  bool compacted_{true};
+};
+
+} // namespace facebook::velox::common::theta
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/theta/ThetaSketch.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::common::theta;
+
+namespace {
+uint64_t hashOne(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+class ThetaSketchTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Returns a sketch of the values in [begin, end).
+  ThetaSketch makeSketch(int64_t begin, int64_t end, int8_t lgK = 12) {
+    ThetaSketch sketch(lgK, &allocator_);
+    for (auto i = begin; i < end; ++i) {
+      sketch.insertHash(hashOne(i));
+    }
+    return sketch;
+  }
+
+  std::string serialize(ThetaSketch& sketch) {
+    std::string serialized(sketch.serializedSize(), '\0');
+    sketch.serialize(serialized.data());
+    return serialized;
+  }
+
+  // Asserts that 'estimate' is within 3 standard errors of 'expected'.
+  static void assertEstimate(double expected, double estimate, int8_t lgK) {
+    const auto error = 3 / std::sqrt(1 << lgK);
+    ASSERT_NEAR(estimate, expected, expected * error + 1);
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  HashStringAllocator allocator_{pool_.get()};
+};
+
+TEST_F(ThetaSketchTest, exact) {
+  auto sketch = makeSketch(0, 1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    sketch.insertHash(hashOne(i % 17));
+  }
+  ASSERT_EQ(sketch.theta(), ThetaSketch::kMaxTheta);
+  ASSERT_EQ(sketch.estimate(), 1'000);
+
+  auto serialized = serialize(sketch);
+  ASSERT_EQ(ThetaSketch::estimate(StringView(serialized)), 1'000);
+  ASSERT_EQ(
+      ThetaSketch::estimate(StringView(ThetaSketch::serializeEmpty(12))), 0);
+}
+
+TEST_F(ThetaSketchTest, estimate) {
+  for (int8_t lgK : {8, 12, 16}) {
+    SCOPED_TRACE(fmt::format("lgK: {}", lgK));
+    auto sketch = makeSketch(0, 1'000'000, lgK);
+    ASSERT_LT(sketch.theta(), ThetaSketch::kMaxTheta);
+    assertEstimate(1'000'000, sketch.estimate(), lgK);
+
+    auto serialized = serialize(sketch);
+    ASSERT_EQ(serialized.size(), 14 + 8 * (1 << lgK));
+    ThetaSketch roundTrip(StringView(serialized), &allocator_);
+    ASSERT_EQ(roundTrip.lgK(), lgK);
+    ASSERT_EQ(roundTrip.theta(), sketch.theta());
+    ASSERT_EQ(roundTrip.estimate(), sketch.estimate());
+    ASSERT_EQ(ThetaSketch::estimate(StringView(serialized)), sketch.estimate());
+  }
+}
+
+TEST_F(ThetaSketchTest, setOperations) {
+  // Unions.
+  auto sketch = makeSketch(0, 300'000);
+  auto other = makeSketch(200'000, 500'000);
+  sketch.combine(ThetaSketch::SetOperation::kUnion, other);
+  assertEstimate(500'000, sketch.estimate(), 12);
+
+  // A union with a smaller K keeps the smaller K.
+  auto small = makeSketch(0, 2'000, 8);
+  sketch.combine(ThetaSketch::SetOperation::kUnion, small);
+  ASSERT_EQ(sketch.lgK(), 8);
+  assertEstimate(500'000, sketch.estimate(), 8);
+
+  // Intersections.
+  sketch = makeSketch(0, 300'000);
+  other = makeSketch(200'000, 500'000);
+  sketch.combine(ThetaSketch::SetOperation::kIntersection, other);
+  assertEstimate(100'000, sketch.estimate(), 10);
+
+  auto disjoint = makeSketch(1'000'000, 1'100'000);
+  sketch.combine(ThetaSketch::SetOperation::kIntersection, disjoint);
+  ASSERT_EQ(sketch.estimate(), 0);
+
+  // Differences.
+  sketch = makeSketch(0, 300'000);
+  other = makeSketch(200'000, 500'000);
+  sketch.combine(ThetaSketch::SetOperation::kDifference, other);
+  assertEstimate(200'000, sketch.estimate(), 10);
+
+  // Exact sketches give exact results.
+  sketch = makeSketch(0, 300);
+  other = makeSketch(200, 500);
+  sketch.combine(ThetaSketch::SetOperation::kIntersection, other);
+  ASSERT_EQ(sketch.estimate(), 100);
+  sketch = makeSketch(0, 300);
+  sketch.combine(ThetaSketch::SetOperation::kDifference, other);
+  ASSERT_EQ(sketch.estimate(), 200);
+}
+
+TEST_F(ThetaSketchTest, serializedSetOperations) {
+  using SetOperation = ThetaSketch::SetOperation;
+  for (auto operation :
+       {SetOperation::kUnion,
+        SetOperation::kIntersection,
+        SetOperation::kDifference}) {
+    auto sketch = makeSketch(0, 300'000);
+    auto other = makeSketch(200'000, 500'000, 10);
+    auto left = serialize(sketch);
+    auto right = serialize(other);
+    auto result = ThetaSketch::combine(
+        operation, StringView(left), StringView(right));
+
+    sketch.combine(operation, other);
+    ASSERT_EQ(result, serialize(sketch));
+  }
+}
+
+TEST_F(ThetaSketchTest, unalignedSerialized) {
+  auto sketch = makeSketch(0, 10'000, 8);
+  const auto serialized = serialize(sketch);
+  const auto expected = ThetaSketch::combine(
+      ThetaSketch::SetOperation::kUnion,
+      StringView(serialized),
+      StringView(serialized));
+  // Serialized sketches come at any offset in a string vector.
+  for (auto offset = 0; offset < sizeof(uint64_t); ++offset) {
+    SCOPED_TRACE(fmt::format("offset: {}", offset));
+    std::string buffer(offset, 'x');
+    buffer += serialized;
+    const StringView unaligned(buffer.data() + offset, serialized.size());
+
+    ThetaSketch roundTrip(unaligned, &allocator_);
+    ASSERT_EQ(serialize(roundTrip), serialized);
+    ASSERT_EQ(
+        ThetaSketch::combine(
+            ThetaSketch::SetOperation::kUnion, unaligned, unaligned),
+        expected);
+  }
+}
+
+TEST_F(ThetaSketchTest, invalid) {
+  VELOX_ASSERT_THROW(
+      ThetaSketch(3, &allocator_),
+      "Theta sketch lgK must be in [4, 20] range: 3");
+  VELOX_ASSERT_THROW(
+      ThetaSketch(StringView("abc"), &allocator_),
+      "Invalid theta sketch: too short");
+
+  auto sketch = makeSketch(0, 10);
+  auto serialized = serialize(sketch);
+  VELOX_ASSERT_THROW(
+      ThetaSketch(
+          StringView(serialized.data(), serialized.size() - 1), &allocator_),
+      "Invalid theta sketch: size does not match the number of hashes");
+  serialized[0] = 7;
+  VELOX_ASSERT_THROW(
+      ThetaSketch::estimate(StringView(serialized)),
+      "Unsupported theta sketch version: 7");
+}
+} // namespace
@@ -16,6 +16,8 @@
 
 #include "velox/connectors/Connector.h"
 
+#include <folly/hash/Hash.h>
+
 namespace facebook::velox::connector {
 namespace {
 std::unordered_map<std::string, std::shared_ptr<ConnectorFactory>>&
@@ -31,15 +33,34 @@ std::unordered_map<std::string, std::shared_ptr<Connector>>& connectors() {
 }
 } // namespace
 
+int32_t affinityNodeIndex(
+    const std::string& cacheAffinityKey,
+    const std::vector<std::string>& nodeIds) {
+  const auto keyHash = folly::hasher<std::string>()(cacheAffinityKey);
+  int32_t bestIndex = -1;
+  uint64_t bestWeight = 0;
+  for (auto i = 0; i < nodeIds.size(); ++i) {
+    const auto weight = folly::hash::hash_128_to_64(
+        keyHash, folly::hasher<std::string>()(nodeIds[i]));
+    if (bestIndex < 0 || weight > bestWeight) {
+      bestIndex = i;
+      bestWeight = weight;
+    }
+  }
+  return bestIndex;
+}
+
 bool DataSink::Stats::empty() const {
-  return numWrittenBytes == 0 && numWrittenFiles == 0 && spillStats.empty();
+  return numWrittenBytes == 0 && numWrittenFiles == 0 &&
+      writerCloseTimeUs == 0 && spillStats.empty();
 }
 
 std::string DataSink::Stats::toString() const {
   return fmt::format(
-      "numWrittenBytes {} numWrittenFiles {} {}",
+      "numWrittenBytes {} numWrittenFiles {} writerCloseTime {} {}",
       succinctBytes(numWrittenBytes),
       numWrittenFiles,
+      succinctMicros(writerCloseTimeUs),
       spillStats.toString());
 }
 
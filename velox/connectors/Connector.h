@@ -22,7 +22,9 @@
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/io/PrefetchBudget.h"
 #include "velox/core/ExpressionEvaluator.h"
+#include "velox/type/Subfield.h"
 #include "velox/vector/ComplexVector.h"
 
 #include <folly/Synchronized.h>
@@ -50,6 +52,17 @@ struct ConnectorSplit {
 
   std::unique_ptr<AsyncSource<DataSource>> dataSource;
 
+  /// True if Connector::prefetchMetadata() has been called for this split.
+  /// Set by the Task under its mutex.
+  bool metadataPrefetched{false};
+
+  /// Identifies the cached data the split reads, e.g. a file and a range of
+  /// its stripes. Splits with the same key are best read by the same worker
+  /// and Driver, so that they reuse the AsyncDataCache and SsdCache entries
+  /// of each other. Empty if the split has no affinity. See
+  /// QueryConfig::kSplitAffinityScheduling and affinityNodeIndex().
+  std::string cacheAffinityKey;
+
   explicit ConnectorSplit(
       const std::string& _connectorId,
       int64_t _splitWeight = 0)
@@ -57,15 +70,49 @@ struct ConnectorSplit {
 
   virtual ~ConnectorSplit() {}
 
+  /// Returns the bucket of a bucketed table that the split reads, or
+  /// std::nullopt if the table is not bucketed. In grouped execution, a split
+  /// added to a Task without a split group goes to the group of its bucket.
+  virtual std::optional<int32_t> bucketNumber() const {
+    return std::nullopt;
+  }
+
+  /// Returns a key that identifies the data the split reads if the data is
+  /// immutable, e.g. a file with a known modification time, std::nullopt
+  /// otherwise. Splits with the same key return the same rows for the same
+  /// scan. Used to cache the results of fragments by split, see
+  /// core::FragmentResultCacheNode.
+  virtual std::optional<std::string> resultCacheKey() const {
+    return std::nullopt;
+  }
+
   virtual std::string toString() const {
     return fmt::format("[split: {}]", connectorId);
   }
 };
 
+/// Returns the index in 'nodeIds' of the worker that should read the splits
+/// with 'cacheAffinityKey'. Uses rendezvous hashing, so a key goes to the same
+/// worker on every call and adding or removing a worker only moves the keys
+/// of that worker. For use by the coordinator when routing splits. Returns -1
+/// if 'nodeIds' is empty.
+int32_t affinityNodeIndex(
+    const std::string& cacheAffinityKey,
+    const std::vector<std::string>& nodeIds);
+
 class ColumnHandle : public ISerializable {
  public:
   virtual ~ColumnHandle() = default;
 
+  /// Returns a copy of 'this' that reads only 'subfields' of the column and may
+  /// prune the rest. The first element of each subfield names the column, by
+  /// its name in the scan output. Returns nullptr if the connector cannot
+  /// prune the column or 'this' already has required subfields.
+  virtual std::shared_ptr<ColumnHandle> withRequiredSubfields(
+      std::vector<common::Subfield> /*subfields*/) const {
+    return nullptr;
+  }
+
   folly::dynamic serialize() const override;
 
  protected:
@@ -145,6 +192,9 @@ class DataSink {
   struct Stats {
     uint64_t numWrittenBytes{0};
     uint32_t numWrittenFiles{0};
+    /// Wall time spent closing the file writers, which writes the file footers
+    /// and commits the files in storage.
+    uint64_t writerCloseTimeUs{0};
     common::SpillStats spillStats;
 
     bool empty() const;
@@ -171,6 +221,25 @@ class DataSink {
   virtual void abort() = 0;
 };
 
+/// An aggregate over the rows of a split that a DataSource may compute from
+/// file metadata instead of reading the rows. Used to push a partial
+/// aggregation without grouping keys into the scan.
+struct MetadataAggregate {
+  enum class Kind {
+    /// The number of rows. Has no column.
+    kCount,
+    /// The smallest non-null value of 'column'.
+    kMin,
+    /// The largest non-null value of 'column'.
+    kMax,
+  };
+
+  Kind kind;
+
+  /// The name of the aggregated column in the table. Empty for kCount.
+  std::string column;
+};
+
 class DataSource {
  public:
   static constexpr int64_t kUnknownRowSize = -1;
@@ -232,6 +301,18 @@ class DataSource {
     return kUnknownRowSize;
   }
 
+  /// Computes 'aggregates' over the rows of the split added by addSplit() that
+  /// pass the filters of the scan, from file metadata alone. Returns one value
+  /// per aggregate, a null value for a min or max over no values, and treats
+  /// the split as fully processed so that the next split can be added. Returns
+  /// std::nullopt if the metadata is missing or inexact or the filters cannot
+  /// be proven to pass all rows. The caller must then read the split with
+  /// next() and aggregate the rows itself.
+  virtual std::optional<std::vector<variant>> aggregateFromMetadata(
+      const std::vector<MetadataAggregate>& /*aggregates*/) {
+    return std::nullopt;
+  }
+
   /// Returns a Wave delegate that implements the Wave Operator
   /// interface for a GPU table scan. This should be called after
   /// construction and no other methods should be called on 'this'
@@ -243,6 +324,61 @@ class DataSource {
   }
 };
 
+/// Looks up the rows of a table by the values of their key columns. Used by
+/// the IndexLookupJoin operator to join a small input with a table that is
+/// sorted or indexed on the join keys, without scanning the table. Created by
+/// Connector::createIndexSource().
+class IndexSource {
+ public:
+  virtual ~IndexSource() = default;
+
+  /// The keys to look up. 'input' has one column per join key, in the order of
+  /// the key columns given to Connector::createIndexSource().
+  struct LookupRequest {
+    explicit LookupRequest(RowVectorPtr _input) : input(std::move(_input)) {}
+
+    RowVectorPtr input;
+  };
+
+  /// A batch of the rows found for a LookupRequest. Row i of 'output' has the
+  /// keys of row 'inputHits[i]' of the request input.
+  struct LookupResult {
+    LookupResult(BufferPtr _inputHits, RowVectorPtr _output)
+        : inputHits(std::move(_inputHits)), output(std::move(_output)) {
+      VELOX_CHECK_GE(
+          inputHits->size() / sizeof(vector_size_t), output->size());
+    }
+
+    vector_size_t size() const {
+      return output->size();
+    }
+
+    BufferPtr inputHits;
+    RowVectorPtr output;
+  };
+
+  /// Returns the rows found for one LookupRequest in batches.
+  class LookupResultIterator {
+   public:
+    virtual ~LookupResultIterator() = default;
+
+    /// Returns the next batch of at most 'size' rows. Returns nullptr if all
+    /// the rows have been returned. Returns std::nullopt and sets 'future' if
+    /// the lookup is in progress. The caller waits for 'future' before calling
+    /// next() again.
+    virtual std::optional<std::unique_ptr<LookupResult>> next(
+        vector_size_t size,
+        velox::ContinueFuture& future) = 0;
+  };
+
+  /// Starts the lookup of the keys in 'request'. A key may match any number
+  /// of rows. Keys with nulls match no rows.
+  virtual std::shared_ptr<LookupResultIterator> lookup(
+      const LookupRequest& request) = 0;
+
+  virtual std::unordered_map<std::string, RuntimeCounter> runtimeStats() = 0;
+};
+
 /// Collection of context data for use in a DataSource or DataSink. One instance
 /// of this per DataSource and DataSink. This may be passed between threads but
 /// methods must be invoked sequentially. Serializing use is the responsibility
@@ -303,6 +439,37 @@ class ConnectorQueryCtx {
     return cache_;
   }
 
+  /// Cache priority and quota of the query. nullptr if the query has the
+  /// default priority and no quota. See core::QueryCtx::cacheQuota().
+  const std::shared_ptr<cache::CacheQuota>& cacheQuota() const {
+    return cacheQuota_;
+  }
+
+  void setCacheQuota(std::shared_ptr<cache::CacheQuota> cacheQuota) {
+    cacheQuota_ = std::move(cacheQuota);
+  }
+
+  /// Bounds the bytes that the readers of the scan driver load ahead, shared
+  /// with the splits the driver preloads. nullptr if there is no bound. See
+  /// core::QueryConfig::kMaxPrefetchBytesPerDriver.
+  const std::shared_ptr<io::PrefetchBudget>& prefetchBudget() const {
+    return prefetchBudget_;
+  }
+
+  void setPrefetchBudget(std::shared_ptr<io::PrefetchBudget> prefetchBudget) {
+    prefetchBudget_ = std::move(prefetchBudget);
+  }
+
+  /// True if the readers reorder their filters by observed selectivity. See
+  /// core::QueryConfig::kAdaptiveFilterReorderingEnabled.
+  bool adaptiveFilterReorderingEnabled() const {
+    return adaptiveFilterReorderingEnabled_;
+  }
+
+  void setAdaptiveFilterReorderingEnabled(bool enabled) {
+    adaptiveFilterReorderingEnabled_ = enabled;
+  }
+
   /// This is a combination of task id and the scan's PlanNodeId. This is an id
   /// that allows sharing state between different threads of the same scan. This
   /// is used for locating a scanTracker, which tracks the read density of
@@ -334,6 +501,9 @@ class ConnectorQueryCtx {
   const common::SpillConfig* const spillConfig_;
   std::unique_ptr<core::ExpressionEvaluator> expressionEvaluator_;
   cache::AsyncDataCache* cache_;
+  std::shared_ptr<cache::CacheQuota> cacheQuota_;
+  std::shared_ptr<io::PrefetchBudget> prefetchBudget_;
+  bool adaptiveFilterReorderingEnabled_{true};
   const std::string scanId_;
   const std::string queryId_;
   const std::string taskId_;
@@ -369,6 +539,26 @@ class Connector {
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
       ConnectorQueryCtx* connectorQueryCtx) = 0;
 
+  /// Returns true if createIndexSource() is supported.
+  virtual bool supportsIndexLookup() const {
+    return false;
+  }
+
+  /// Returns an IndexSource that looks up the rows of 'tableHandle' by the
+  /// columns in 'keyType' and returns the columns in 'outputType'. The names
+  /// in both types are mapped to the columns of the table by 'columnHandles'.
+  virtual std::shared_ptr<IndexSource> createIndexSource(
+      const RowTypePtr& /*keyType*/,
+      const RowTypePtr& /*outputType*/,
+      const std::shared_ptr<ConnectorTableHandle>& /*tableHandle*/,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& /*columnHandles*/,
+      ConnectorQueryCtx* /*connectorQueryCtx*/) {
+    VELOX_UNSUPPORTED(
+        "Connector {} does not support index lookup", connectorId());
+  }
+
   /// Returns true if addSplit of DataSource can use 'dataSource' from
   /// ConnectorSplit in addSplit(). If so, TableScan can preload splits
   /// so that file opening and metadata operations are off the Driver'
@@ -377,6 +567,19 @@ class Connector {
     return false;
   }
 
+  /// Returns true if prefetchMetadata() does anything.
+  virtual bool supportsMetadataPrefetch() {
+    return false;
+  }
+
+  /// Starts reading the file metadata of 'splits' in the background so that
+  /// it is cached by the time the splits are opened. The reads of different
+  /// splits are issued concurrently. 'connectorQueryCtx' must stay live until
+  /// the reads are done, hence it is a shared_ptr.
+  virtual void prefetchMetadata(
+      const std::vector<std::shared_ptr<ConnectorSplit>>& /*splits*/,
+      const std::shared_ptr<ConnectorQueryCtx>& /*connectorQueryCtx*/) {}
+
   virtual std::unique_ptr<DataSink> createDataSink(
       RowTypePtr inputType,
       std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
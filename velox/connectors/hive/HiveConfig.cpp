@@ -120,6 +120,18 @@ std::optional<uint32_t> HiveConfig::s3MaxConnections() const {
       config_->get<uint32_t>(kS3MaxConnections));
 }
 
+uint64_t HiveConfig::s3ReadPartSize() const {
+  return config_->get<uint64_t>(kS3ReadPartSize, 0);
+}
+
+double HiveConfig::s3HedgedReadPercentile() const {
+  return config_->get<double>(kS3HedgedReadPercentile, 0);
+}
+
+uint32_t HiveConfig::s3HedgedReadMinDelayMs() const {
+  return config_->get<uint32_t>(kS3HedgedReadMinDelayMs, 20);
+}
+
 std::string HiveConfig::gcsEndpoint() const {
   return config_->get<std::string>(kGCSEndpoint, std::string(""));
 }
@@ -141,6 +153,19 @@ std::optional<std::string> HiveConfig::gcsMaxRetryTime() const {
       config_->get<std::string>(kGCSMaxRetryTime));
 }
 
+uint32_t HiveConfig::gcsReadThreads() const {
+  return config_->get<uint32_t>(kGCSReadThreads, 0);
+}
+
+std::optional<uint32_t> HiveConfig::gcsMaxConnections() const {
+  return static_cast<std::optional<std::uint32_t>>(
+      config_->get<uint32_t>(kGCSMaxConnections));
+}
+
+uint32_t HiveConfig::abfsReadThreads() const {
+  return config_->get<uint32_t>(kAbfsReadThreads, 0);
+}
+
 bool HiveConfig::isOrcUseColumnNames(const Config* session) const {
   return session->get<bool>(
       kOrcUseColumnNamesSession, config_->get<bool>(kOrcUseColumnNames, false));
@@ -176,6 +201,10 @@ int32_t HiveConfig::loadQuantum() const {
   return config_->get<int32_t>(kLoadQuantum, 8 << 20);
 }
 
+bool HiveConfig::adaptiveIoTuningEnabled() const {
+  return config_->get<bool>(kAdaptiveIoTuningEnabled, false);
+}
+
 int32_t HiveConfig::numCacheFileHandles() const {
   return config_->get<int32_t>(kNumCacheFileHandles, 20'000);
 }
@@ -250,6 +279,23 @@ uint64_t HiveConfig::sortWriterMaxOutputBytes(const Config* session) const {
       core::CapacityUnit::BYTE);
 }
 
+bool HiveConfig::partitionSortWrite(const Config* session) const {
+  return session->get<bool>(
+      kPartitionSortWriteSession,
+      config_->get<bool>(kPartitionSortWrite, false));
+}
+
+bool HiveConfig::parallelWriterClose(const Config* session) const {
+  return session->get<bool>(
+      kParallelWriterCloseSession,
+      config_->get<bool>(kParallelWriterClose, false));
+}
+
+bool HiveConfig::lazyLoadPrefetch(const Config* session) const {
+  return session->get<bool>(
+      kLazyLoadPrefetchSession, config_->get<bool>(kLazyLoadPrefetch, false));
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 1UL << 20);
 }
@@ -98,6 +98,20 @@ class HiveConfig {
   /// Maximum concurrent TCP connections for a single http client.
   static constexpr const char* kS3MaxConnections = "hive.s3.max-connections";
 
+  /// Reads larger than this are split into ranged GETs of this size that are
+  /// issued in parallel. 0 means no splitting.
+  static constexpr const char* kS3ReadPartSize = "hive.s3.read-part-size";
+
+  /// If not 0, a second GET is sent for a range when the first one takes
+  /// longer than this percentile of the recent GET latencies of the file
+  /// system. The first response to arrive is used.
+  static constexpr const char* kS3HedgedReadPercentile =
+      "hive.s3.hedged-read-percentile";
+
+  /// The minimum time a GET is waited for before it is hedged.
+  static constexpr const char* kS3HedgedReadMinDelayMs =
+      "hive.s3.hedged-read-min-delay-ms";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -113,6 +127,18 @@ class HiveConfig {
   /// The GCS maximum time allowed to retry transient errors.
   static constexpr const char* kGCSMaxRetryTime = "hive.gcs.max-retry-time";
 
+  /// Number of threads of the GCS file system that run asynchronous reads. 0
+  /// means reads are synchronous.
+  static constexpr const char* kGCSReadThreads = "hive.gcs.read-threads";
+
+  /// Maximum number of HTTP connections to GCS kept open for reuse. Defaults
+  /// to the number of read threads if they are set.
+  static constexpr const char* kGCSMaxConnections = "hive.gcs.max-connections";
+
+  /// Number of threads of the ABFS file system that run asynchronous reads. 0
+  /// means reads are synchronous.
+  static constexpr const char* kAbfsReadThreads = "hive.abfs.read-threads";
+
   /// Maps table field names to file field names using names, not indices.
   // TODO: remove hive_orc_use_column_names since it doesn't exist in presto,
   // right now this is only used for testing.
@@ -145,6 +171,12 @@ class HiveConfig {
   /// The total size in bytes for a direct coalesce request.
   static constexpr const char* kLoadQuantum = "load-quantum";
 
+  /// If true, the load quantum and max coalesce distance are chosen per file
+  /// system from the observed latency and throughput of reads. 'load-quantum'
+  /// is then an upper bound.
+  static constexpr const char* kAdaptiveIoTuningEnabled =
+      "adaptive-io-tuning-enabled";
+
   /// Maximum number of entries in the file handle cache.
   static constexpr const char* kNumCacheFileHandles = "num_cached_file_handles";
 
@@ -209,6 +241,26 @@ class HiveConfig {
   static constexpr const char* kSortWriterMaxOutputBytesSession =
       "sort_writer_max_output_bytes";
 
+  /// Whether a partitioned, non-bucketed table write buffers its input sorted
+  /// by partition and writes the partitions one file at a time on close,
+  /// instead of keeping one open file writer per partition.
+  static constexpr const char* kPartitionSortWrite = "partition-sort-write";
+  static constexpr const char* kPartitionSortWriteSession =
+      "partition_sort_write";
+
+  /// Whether a table write closes its file writers in parallel on the
+  /// connector's IO executor. Closing a writer writes the file footer and
+  /// commits the file in storage, e.g. completes an S3 multipart upload.
+  static constexpr const char* kParallelWriterClose = "parallel-writer-close";
+  static constexpr const char* kParallelWriterCloseSession =
+      "parallel_writer_close";
+
+  /// If true, the LazyVectors of a scan start loading on the executor of the
+  /// connector when an operator announces their loads with
+  /// LazyVector::prefetch(), e.g. FilterProject after evaluating its filter.
+  static constexpr const char* kLazyLoadPrefetch = "lazy-load-prefetch";
+  static constexpr const char* kLazyLoadPrefetchSession = "lazy_load_prefetch";
+
   static constexpr const char* kS3UseProxyFromEnv =
       "hive.s3.use-proxy-from-env";
 
@@ -252,6 +304,12 @@ class HiveConfig {
 
   std::optional<uint32_t> s3MaxConnections() const;
 
+  uint64_t s3ReadPartSize() const;
+
+  double s3HedgedReadPercentile() const;
+
+  uint32_t s3HedgedReadMinDelayMs() const;
+
   std::string gcsEndpoint() const;
 
   std::string gcsScheme() const;
@@ -262,6 +320,12 @@ class HiveConfig {
 
   std::optional<std::string> gcsMaxRetryTime() const;
 
+  uint32_t gcsReadThreads() const;
+
+  std::optional<uint32_t> gcsMaxConnections() const;
+
+  uint32_t abfsReadThreads() const;
+
   bool isOrcUseColumnNames(const Config* session) const;
 
   bool isFileColumnNamesReadAsLowerCase(const Config* session) const;
@@ -278,6 +342,8 @@ class HiveConfig {
 
   int32_t loadQuantum() const;
 
+  bool adaptiveIoTuningEnabled() const;
+
   int32_t numCacheFileHandles() const;
 
   bool isFileHandleCacheEnabled() const;
@@ -300,6 +366,12 @@ class HiveConfig {
 
   uint64_t sortWriterMaxOutputBytes(const Config* session) const;
 
+  bool partitionSortWrite(const Config* session) const;
+
+  bool parallelWriterClose(const Config* session) const;
+
+  bool lazyLoadPrefetch(const Config* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
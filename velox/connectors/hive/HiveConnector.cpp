@@ -18,6 +18,8 @@
 
 #include "velox/common/base/Fs.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/HiveDataSink.h"
 #include "velox/connectors/hive/HiveDataSource.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
@@ -34,6 +36,7 @@
 #ifdef VELOX_ENABLE_ABFS
 #include "velox/connectors/hive/storage_adapters/abfs/RegisterAbfsFileSystem.h" // @manual
 #endif
+#include "velox/dwio/common/ReaderFactory.h"
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 // Meta's buck build system needs this check.
@@ -41,6 +44,7 @@
 #include "velox/dwio/parquet/RegisterParquetReader.h" // @manual
 #include "velox/dwio/parquet/RegisterParquetWriter.h" // @manual
 #endif
+#include "velox/dwio/text/reader/TextReader.h"
 #include "velox/expression/FieldReference.h"
 
 #include <boost/lexical_cast.hpp>
@@ -91,6 +95,43 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       hiveConfig_);
 }
 
+void HiveConnector::prefetchMetadata(
+    const std::vector<std::shared_ptr<ConnectorSplit>>& splits,
+    const std::shared_ptr<ConnectorQueryCtx>& connectorQueryCtx) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  for (const auto& split : splits) {
+    auto hiveSplit = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+    if (!hiveSplit) {
+      continue;
+    }
+    executor_->add([this, hiveSplit, connectorQueryCtx]() {
+      try {
+        dwio::common::ReaderOptions readerOpts(
+            connectorQueryCtx->memoryPool());
+        configureReaderOptions(
+            readerOpts,
+            hiveConfig_,
+            connectorQueryCtx->sessionProperties(),
+            nullptr,
+            hiveSplit);
+        auto fileHandle = fileHandleFactory_.generate(hiveSplit->filePath);
+        auto input = createBufferedInput(
+            *fileHandle,
+            readerOpts,
+            connectorQueryCtx.get(),
+            std::make_shared<io::IoStatistics>(),
+            executor_);
+        dwio::common::getReaderFactory(readerOpts.fileFormat())
+            ->createReader(std::move(input), readerOpts);
+      } catch (const std::exception& e) {
+        // The split is opened again when read and reports the error then.
+        VLOG(1) << "Metadata prefetch of " << hiveSplit->filePath
+                << " failed: " << e.what();
+      }
+    });
+  }
+}
+
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
     RowTypePtr inputType,
     std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
@@ -105,7 +146,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      executor_);
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
@@ -133,6 +175,7 @@ void HiveConnectorFactory::initialize() {
     dwio::common::registerFileSinks();
     dwrf::registerDwrfReaderFactory();
     dwrf::registerDwrfWriterFactory();
+    text::registerTextReaderFactories();
 // Meta's buck build system needs this check.
 #ifdef VELOX_ENABLE_PARQUET
     parquet::registerParquetReaderFactory();
@@ -54,6 +54,17 @@ class HiveConnector : public Connector {
     return true;
   }
 
+  bool supportsMetadataPrefetch() override {
+    return executor_ != nullptr;
+  }
+
+  /// Opens a reader for each of 'splits' on 'executor_'. This reads and parses
+  /// the file footer, which is then found in the footer and data caches when
+  /// the split is read.
+  void prefetchMetadata(
+      const std::vector<std::shared_ptr<ConnectorSplit>>& splits,
+      const std::shared_ptr<ConnectorQueryCtx>& connectorQueryCtx) override;
+
   std::unique_ptr<DataSink> createDataSink(
       RowTypePtr inputType,
       std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
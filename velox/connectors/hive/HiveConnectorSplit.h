@@ -15,15 +15,22 @@
  */
 #pragma once
 
+#include <map>
 #include <optional>
 #include <unordered_map>
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileProperties.h"
 #include "velox/dwio/common/Options.h"
+#include "velox/dwio/common/Statistics.h"
 
 namespace facebook::velox::connector::hive {
 
 struct HiveConnectorSplit : public connector::ConnectorSplit {
+  /// Splits of a file whose starts are in the same range of this many bytes
+  /// have the same cache affinity key. This groups the splits that read
+  /// nearby stripes.
+  static constexpr uint64_t kCacheAffinityRangeBytes = 256 << 20;
+
   const std::string filePath;
   dwio::common::FileFormat fileFormat;
   const uint64_t start;
@@ -48,6 +55,17 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   /// the file handle.
   std::optional<FileProperties> properties;
 
+  /// Optional file-level column statistics provided by the coordinator, keyed
+  /// by column name. Together with the partition keys, these are tested
+  /// against the scan filters before the file is opened, so a split that no
+  /// row can pass is skipped without IO. Ignored unless 'fileRowCount' is set.
+  std::unordered_map<
+      std::string,
+      std::shared_ptr<dwio::common::ColumnStatistics>>
+      fileStatistics;
+  /// The number of rows in the file described by 'fileStatistics'.
+  std::optional<uint64_t> fileRowCount;
+
   HiveConnectorSplit(
       const std::string& connectorId,
       const std::string& _filePath,
@@ -74,7 +92,42 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
         extraFileInfo(_extraFileInfo),
         serdeParameters(_serdeParameters),
         infoColumns(_infoColumns),
-        properties(_properties) {}
+        properties(_properties) {
+    cacheAffinityKey =
+        fmt::format("{}:{}", filePath, start / kCacheAffinityRangeBytes);
+  }
+
+  std::optional<int32_t> bucketNumber() const override {
+    return tableBucketNumber;
+  }
+
+  /// Returns a key made of the file, the range, the modification time and the
+  /// values of the partition and info columns if the modification time is
+  /// known.
+  std::optional<std::string> resultCacheKey() const override {
+    if (!properties.has_value() ||
+        !properties->modificationTime.has_value()) {
+      return std::nullopt;
+    }
+    auto key = fmt::format(
+        "{}:{}:{}:{}:{}",
+        filePath,
+        start,
+        length,
+        properties->modificationTime.value(),
+        tableBucketNumber.value_or(-1));
+    const std::map<std::string, std::optional<std::string>> sortedKeys(
+        partitionKeys.begin(), partitionKeys.end());
+    for (const auto& [name, value] : sortedKeys) {
+      key += fmt::format(":{}={}", name, value.value_or("<null>"));
+    }
+    const std::map<std::string, std::string> sortedInfoColumns(
+        infoColumns.begin(), infoColumns.end());
+    for (const auto& [name, value] : sortedInfoColumns) {
+      key += fmt::format(":{}={}", name, value);
+    }
+    return key;
+  }
 
   std::string toString() const override {
     if (tableBucketNumber.has_value()) {
@@ -530,6 +530,7 @@ void configureReaderOptions(
   readerOptions.setLoadQuantum(hiveConfig->loadQuantum());
   readerOptions.setMaxCoalesceBytes(hiveConfig->maxCoalescedBytes());
   readerOptions.setMaxCoalesceDistance(hiveConfig->maxCoalescedDistanceBytes());
+  readerOptions.setAdaptiveIoTuning(hiveConfig->adaptiveIoTuningEnabled());
   readerOptions.setFileColumnNamesReadAsLowerCase(
       hiveConfig->isFileColumnNamesReadAsLowerCase(sessionProperties));
   readerOptions.setUseColumnNamesForColumnMapping(
@@ -540,6 +541,11 @@ void configureReaderOptions(
   readerOptions.setPrefetchRowGroups(hiveConfig->prefetchRowGroups());
   readerOptions.setNoCacheRetention(
       hiveConfig->cacheNoRetention(sessionProperties));
+  if (hiveSplit->properties.has_value() &&
+      hiveSplit->properties->modificationTime.has_value()) {
+    readerOptions.setFileModificationTime(
+        *hiveSplit->properties->modificationTime);
+  }
 
   if (readerOptions.fileFormat() != dwio::common::FileFormat::UNKNOWN) {
     VELOX_CHECK(
@@ -674,6 +680,216 @@ bool testFilters(
   return true;
 }
 
+bool testFiltersOnSplitMetadata(
+    const common::ScanSpec* scanSpec,
+    const HiveConnectorSplit& split,
+    const RowTypePtr& dataColumns,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle) {
+  for (const auto& child : scanSpec->children()) {
+    auto* filter = child->filter();
+    if (filter == nullptr) {
+      continue;
+    }
+    const auto& name = child->fieldName();
+    if (auto it = split.partitionKeys.find(name);
+        it != split.partitionKeys.end()) {
+      if (it->second.has_value()) {
+        auto handlesIter = partitionKeysHandle.find(name);
+        VELOX_CHECK(handlesIter != partitionKeysHandle.end());
+        if (!applyPartitionFilter(
+                handlesIter->second->dataType(), it->second.value(), filter)) {
+          VLOG(1) << "Skipping " << split.filePath
+                  << " based on the value of partition key " << name;
+          return false;
+        }
+      } else if (filter->isDeterministic() && !filter->testNull()) {
+        VLOG(1) << "Skipping " << split.filePath
+                << " because the filter testNull() failed for partition key "
+                << name;
+        return false;
+      }
+      continue;
+    }
+
+    if (!split.fileRowCount.has_value()) {
+      continue;
+    }
+    auto statsIter = split.fileStatistics.find(name);
+    if (statsIter == split.fileStatistics.end() ||
+        statsIter->second == nullptr) {
+      continue;
+    }
+    const auto index = dataColumns->getChildIdxIfExists(name);
+    if (!index.has_value()) {
+      continue;
+    }
+    if (!testFilter(
+            filter,
+            statsIter->second.get(),
+            split.fileRowCount.value(),
+            dataColumns->childAt(index.value()))) {
+      VLOG(1) << "Skipping " << split.filePath
+              << " based on file stats and filter for column " << name;
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+
+// Returns true if 'stats' prove that each of the 'totalRows' rows of a file
+// passes 'filter'. Only null tests and bigint ranges are proven.
+bool filterPassesAllRows(
+    const common::Filter& filter,
+    const dwio::common::ColumnStatistics* stats,
+    uint64_t totalRows) {
+  if (stats == nullptr || !filter.isDeterministic()) {
+    return false;
+  }
+  const auto numValues = stats->getNumberOfValues();
+  if (!numValues.has_value()) {
+    return false;
+  }
+  const bool hasNulls = numValues.value() < totalRows;
+  switch (filter.kind()) {
+    case common::FilterKind::kIsNull:
+      return numValues.value() == 0;
+    case common::FilterKind::kIsNotNull:
+      return !hasNulls;
+    case common::FilterKind::kBigintRange: {
+      if (hasNulls && !filter.testNull()) {
+        return false;
+      }
+      if (numValues.value() == 0) {
+        return true;
+      }
+      auto* intStats =
+          dynamic_cast<const dwio::common::IntegerColumnStatistics*>(stats);
+      if (intStats == nullptr || !intStats->getMinimum().has_value() ||
+          !intStats->getMaximum().has_value()) {
+        return false;
+      }
+      const auto& range = static_cast<const common::BigintRange&>(filter);
+      return range.lower() <= intStats->getMinimum().value() &&
+          intStats->getMaximum().value() <= range.upper();
+    }
+    default:
+      return false;
+  }
+}
+
+std::optional<variant> makeIntegerVariant(TypeKind kind, int64_t value) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return variant::create<TypeKind::TINYINT>(static_cast<int8_t>(value));
+    case TypeKind::SMALLINT:
+      return variant::create<TypeKind::SMALLINT>(static_cast<int16_t>(value));
+    case TypeKind::INTEGER:
+      return variant::create<TypeKind::INTEGER>(static_cast<int32_t>(value));
+    case TypeKind::BIGINT:
+      return variant::create<TypeKind::BIGINT>(value);
+    default:
+      return std::nullopt;
+  }
+}
+
+} // namespace
+
+std::optional<std::vector<variant>> aggregateFromFileStats(
+    const common::ScanSpec* scanSpec,
+    const dwio::common::Reader* reader,
+    const std::vector<MetadataAggregate>& aggregates,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle) {
+  const auto totalRows = reader->numberOfRows();
+  if (!totalRows.has_value()) {
+    return std::nullopt;
+  }
+  const auto& fileTypeWithId = reader->typeWithId();
+  const auto& rowType = reader->rowType();
+  for (const auto& child : scanSpec->children()) {
+    for (const auto& grandChild : child->children()) {
+      if (grandChild->hasFilter()) {
+        return std::nullopt;
+      }
+    }
+    auto* filter = child->filter();
+    if (filter == nullptr) {
+      continue;
+    }
+    const auto& name = child->fieldName();
+    auto iter = partitionKey.find(name);
+    if (iter != partitionKey.end() && iter->second.has_value()) {
+      auto handlesIter = partitionKeysHandle.find(name);
+      VELOX_CHECK(handlesIter != partitionKeysHandle.end());
+      if (!applyPartitionFilter(
+              handlesIter->second->dataType(), iter->second.value(), filter)) {
+        return std::nullopt;
+      }
+    } else if (iter != partitionKey.end() || !rowType->containsChild(name)) {
+      // All the values are null.
+      if (!filter->isDeterministic() || !filter->testNull()) {
+        return std::nullopt;
+      }
+    } else {
+      const auto& typeWithId = fileTypeWithId->childByName(name);
+      auto columnStats = reader->columnStatistics(typeWithId->id());
+      if (!filterPassesAllRows(*filter, columnStats.get(), totalRows.value())) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  std::vector<variant> results;
+  results.reserve(aggregates.size());
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.kind == MetadataAggregate::Kind::kCount) {
+      results.emplace_back(static_cast<int64_t>(totalRows.value()));
+      continue;
+    }
+    if (partitionKey.count(aggregate.column) != 0 ||
+        !rowType->containsChild(aggregate.column)) {
+      return std::nullopt;
+    }
+    const auto& typeWithId = fileTypeWithId->childByName(aggregate.column);
+    const auto kind = typeWithId->type()->kind();
+    if (typeWithId->type()->isDecimal()) {
+      return std::nullopt;
+    }
+    auto columnStats = reader->columnStatistics(typeWithId->id());
+    if (columnStats == nullptr ||
+        !columnStats->getNumberOfValues().has_value()) {
+      return std::nullopt;
+    }
+    if (columnStats->getNumberOfValues().value() == 0) {
+      results.push_back(variant::null(kind));
+      continue;
+    }
+    auto* intStats =
+        dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+            columnStats.get());
+    if (intStats == nullptr) {
+      return std::nullopt;
+    }
+    const auto value = aggregate.kind == MetadataAggregate::Kind::kMin
+        ? intStats->getMinimum()
+        : intStats->getMaximum();
+    if (!value.has_value()) {
+      return std::nullopt;
+    }
+    auto result = makeIntegerVariant(kind, value.value());
+    if (!result.has_value()) {
+      return std::nullopt;
+    }
+    results.push_back(std::move(result.value()));
+  }
+  return results;
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
@@ -92,6 +92,31 @@ bool testFilters(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle);
 
+/// Returns false if no row of 'split' can pass the filters in 'scanSpec',
+/// judging from the split's partition values and its optional file statistics
+/// only, without opening the file. 'dataColumns' gives the types of the
+/// columns that 'split.fileStatistics' describe.
+bool testFiltersOnSplitMetadata(
+    const common::ScanSpec* scanSpec,
+    const HiveConnectorSplit& split,
+    const RowTypePtr& dataColumns,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle);
+
+/// Computes 'aggregates' over the rows of the file read by 'reader' that pass
+/// the filters in 'scanSpec', from the file footer only. Returns std::nullopt
+/// if the row count or a needed column statistic is missing, if a min or max
+/// is over a non-integer column or a partition key, or if the statistics do
+/// not prove that every row passes the filters.
+std::optional<std::vector<variant>> aggregateFromFileStats(
+    const common::ScanSpec* scanSpec,
+    const dwio::common::Reader* reader,
+    const std::vector<MetadataAggregate>& aggregates,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
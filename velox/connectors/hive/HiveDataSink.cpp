@@ -16,10 +16,12 @@
 
 #include "velox/connectors/hive/HiveDataSink.h"
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
 #include "velox/connectors/hive/TableHandle.h"
@@ -357,7 +359,8 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* ioExecutor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -390,7 +393,8 @@ HiveDataSink::HiveDataSink(
                        : nullptr),
       writerFactory_(dwio::common::getWriterFactory(
           insertTableHandle_->tableStorageFormat())),
-      spillConfig_(connectorQueryCtx->spillConfig()) {
+      spillConfig_(connectorQueryCtx->spillConfig()),
+      ioExecutor_(ioExecutor) {
   if (isBucketed()) {
     VELOX_USER_CHECK_LT(
         bucketCount_, maxBucketCount(), "bucketCount exceeds the limit");
@@ -402,6 +406,7 @@ HiveDataSink::HiveDataSink(
       commitStrategyToString(commitStrategy_));
 
   if (!isBucketed()) {
+    maybeCreatePartitionSortBuffer();
     return;
   }
   const auto& sortedProperty = insertTableHandle_->bucketProperty()->sortedBy();
@@ -441,6 +446,16 @@ void HiveDataSink::appendData(RowVectorPtr input) {
     return;
   }
 
+  // Buffer the input to write the partitions one at a time on close.
+  if (partitionSortWrite()) {
+    for (column_index_t i = 0; i < input->childrenSize(); ++i) {
+      input->childAt(i)->loadedVector();
+    }
+    memory::NonReclaimableSectionGuard guard(&nonReclaimableSection_);
+    partitionSortBuffer_->addInput(input);
+    return;
+  }
+
   // Compute partition and bucket numbers.
   computePartitionAndBucketIds(input);
 
@@ -521,6 +536,7 @@ DataSink::Stats HiveDataSink::stats() const {
   }
 
   stats.numWrittenFiles = writers_.size();
+  stats.writerCloseTimeUs = writerCloseTimeUs_;
   for (int i = 0; i < writerInfo_.size(); ++i) {
     const auto& info = writerInfo_.at(i);
     VELOX_CHECK_NOT_NULL(info);
@@ -529,6 +545,10 @@ DataSink::Stats HiveDataSink::stats() const {
       stats.spillStats += *spillStats;
     }
   }
+  const auto partitionSortSpillStats = partitionSortSpillStats_.rlock();
+  if (!partitionSortSpillStats->empty()) {
+    stats.spillStats += *partitionSortSpillStats;
+  }
   return stats;
 }
 
@@ -578,6 +598,9 @@ void HiveDataSink::checkStateTransition(State oldState, State newState) {
 
 std::vector<std::string> HiveDataSink::close() {
   checkRunning();
+  if (partitionSortWrite()) {
+    writeSortedPartitions();
+  }
   state_ = State::kClosed;
   closeInternal();
 
@@ -624,17 +647,157 @@ void HiveDataSink::closeInternal() {
   TestValue::adjust(
       "facebook::velox::connector::hive::HiveDataSink::closeInternal", this);
 
+  if (partitionSortBuffer_ != nullptr) {
+    partitionSortBuffer_.reset();
+    partitionSortPool_->release();
+  }
+
+  // NOTE: the writers of a partition sort write are closed and released as
+  // soon as their partition is written.
   if (state_ == State::kClosed) {
+    closeWriters();
+  } else {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
+      WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
+      writers_[i]->abort();
+    }
+  }
+}
+
+void HiveDataSink::maybeCreatePartitionSortBuffer() {
+  if (!isPartitioned() || isBucketed() ||
+      !hiveConfig_->partitionSortWrite(
+          connectorQueryCtx_->sessionProperties())) {
+    return;
+  }
+  // Only the adjacency of equal partition keys matters, not their order.
+  const std::vector<CompareFlags> compareFlags(
+      partitionChannels_.size(),
+      {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue});
+  auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
+  partitionSortPool_ = connectorPool->addLeafChild(
+      fmt::format("{}.partition-sort", connectorPool->name()));
+  if (connectorPool->reclaimer() != nullptr) {
+    partitionSortPool_->setReclaimer(PartitionSortReclaimer::create(this));
+  }
+  partitionSortBuffer_ = std::make_unique<exec::SortBuffer>(
+      inputType_,
+      partitionChannels_,
+      compareFlags,
+      partitionSortPool_.get(),
+      &nonReclaimableSection_,
+      spillConfig_,
+      &partitionSortSpillStats_);
+}
+
+void HiveDataSink::writeSortedPartitions() {
+  VELOX_CHECK(partitionSortWrite());
+  memory::NonReclaimableSectionGuard guard(&nonReclaimableSection_);
+  partitionSortBuffer_->noMoreInput();
+
+  const auto* sessionProperties = connectorQueryCtx_->sessionProperties();
+  uint64_t maxOutputRows =
+      hiveConfig_->sortWriterMaxOutputRows(sessionProperties);
+  const auto rowSize = partitionSortBuffer_->estimateOutputRowSize();
+  if (rowSize.has_value() && rowSize.value() != 0) {
+    maxOutputRows = std::clamp<uint64_t>(
+        hiveConfig_->sortWriterMaxOutputBytes(sessionProperties) /
+            rowSize.value(),
+        1,
+        maxOutputRows);
+  }
+
+  std::optional<uint32_t> openIndex;
+  for (auto output = partitionSortBuffer_->getOutput(maxOutputRows);
+       output != nullptr;
+       output = partitionSortBuffer_->getOutput(maxOutputRows)) {
+    partitionIdGenerator_->run(output, partitionIds_);
+    vector_size_t begin = 0;
+    while (begin < output->size()) {
+      vector_size_t end = begin + 1;
+      while (end < output->size() &&
+             partitionIds_[end] == partitionIds_[begin]) {
+        ++end;
+      }
+      const auto partitionId = static_cast<uint32_t>(partitionIds_[begin]);
+      const auto index = ensureWriter(HiveWriterId{partitionId});
+      if (openIndex.has_value() && openIndex.value() != index) {
+        closeWriter(openIndex.value());
+      }
+      openIndex = index;
+      VELOX_CHECK_NOT_NULL(
+          writers_[index],
+          "Rows of partition {} are not adjacent in the sorted input",
+          partitionIdGenerator_->partitionName(partitionId));
+      write(
+          index,
+          begin == 0 && end == output->size()
+              ? output
+              : std::static_pointer_cast<RowVector>(
+                    output->slice(begin, end - begin)));
+      begin = end;
+    }
+  }
+
+  partitionSortBuffer_.reset();
+  partitionSortPool_->release();
+}
+
+void HiveDataSink::closeWriter(uint32_t index) {
+  {
+    MicrosecondTimer timer(&writerCloseTimeUs_);
+    WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+    writers_[index]->close();
+  }
+  writers_[index].reset();
+}
+
+void HiveDataSink::closeWriters() {
+  MicrosecondTimer timer(&writerCloseTimeUs_);
+  std::vector<uint32_t> openWriters;
+  for (auto i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] != nullptr) {
+      openWriters.push_back(i);
+    }
+  }
+  if (ioExecutor_ == nullptr || openWriters.size() < 2 ||
+      !hiveConfig_->parallelWriterClose(
+          connectorQueryCtx_->sessionProperties())) {
+    for (auto i : openWriters) {
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->close();
     }
-  } else {
-    for (int i = 0; i < writers_.size(); ++i) {
+    return;
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> closes;
+  closes.reserve(openWriters.size());
+  for (auto i : openWriters) {
+    closes.push_back(std::make_shared<AsyncSource<bool>>([this, i]() {
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
-      writers_[i]->abort();
+      writers_[i]->close();
+      return std::make_unique<bool>(true);
+    }));
+    ioExecutor_->add([close = closes.back()]() { close->prepare(); });
+  }
+  // The closes not yet started on 'ioExecutor_' run on this thread. All the
+  // closes are waited for, also on error, since they reference 'this'.
+  std::exception_ptr error;
+  for (auto& close : closes) {
+    try {
+      close->move();
+    } catch (const std::exception&) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
     }
   }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
 }
 
 uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
@@ -1035,4 +1198,56 @@ uint64_t HiveDataSink::WriterReclaimer::reclaim(
   }
   return reclaimedBytes;
 }
+
+std::unique_ptr<memory::MemoryReclaimer>
+HiveDataSink::PartitionSortReclaimer::create(HiveDataSink* dataSink) {
+  return std::unique_ptr<memory::MemoryReclaimer>(
+      new HiveDataSink::PartitionSortReclaimer(dataSink));
+}
+
+bool HiveDataSink::PartitionSortReclaimer::reclaimableBytes(
+    const memory::MemoryPool& pool,
+    uint64_t& reclaimableBytes) const {
+  VELOX_CHECK_EQ(pool.name(), dataSink_->partitionSortPool_->name());
+  reclaimableBytes = 0;
+  const auto& sortBuffer = dataSink_->partitionSortBuffer_;
+  if (sortBuffer == nullptr || !sortBuffer->canSpill()) {
+    return false;
+  }
+  reclaimableBytes = pool.usedBytes();
+  return true;
+}
+
+uint64_t HiveDataSink::PartitionSortReclaimer::reclaim(
+    memory::MemoryPool* pool,
+    uint64_t /*targetBytes*/,
+    uint64_t /*maxWaitMs*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK_EQ(pool->name(), dataSink_->partitionSortPool_->name());
+  const auto& sortBuffer = dataSink_->partitionSortBuffer_;
+  if (sortBuffer == nullptr || !sortBuffer->canSpill()) {
+    return 0;
+  }
+  if (dataSink_->nonReclaimableSection_) {
+    RECORD_METRIC_VALUE(kMetricMemoryNonReclaimableCount);
+    LOG(WARNING) << "Can't reclaim from hive partition sort pool "
+                 << pool->name() << " which is under non-reclaimable section, "
+                 << " reserved memory: "
+                 << succinctBytes(pool->reservedBytes());
+    ++stats.numNonReclaimableAttempts;
+    return 0;
+  }
+
+  return memory::MemoryReclaimer::run(
+      [&]() {
+        int64_t reclaimedBytes{0};
+        {
+          memory::ScopedReclaimedBytesRecorder recorder(pool, &reclaimedBytes);
+          sortBuffer->spill();
+          pool->release();
+        }
+        return reclaimedBytes;
+      },
+      stats);
+}
 } // namespace facebook::velox::connector::hive
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/SortBuffer.h"
 
 namespace facebook::velox::dwrf {
 class Writer;
@@ -419,7 +420,8 @@ class HiveDataSink : public DataSink {
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* ioExecutor = nullptr);
 
   static uint32_t maxBucketCount() {
     static const uint32_t kMaxBucketCount = 100'000;
@@ -483,10 +485,41 @@ class HiveDataSink : public DataSink {
     io::IoStatistics* const ioStats_;
   };
 
+  // Spills the rows buffered in 'partitionSortBuffer_' under memory pressure.
+  class PartitionSortReclaimer : public memory::MemoryReclaimer {
+   public:
+    static std::unique_ptr<memory::MemoryReclaimer> create(
+        HiveDataSink* dataSink);
+
+    bool reclaimableBytes(
+        const memory::MemoryPool& pool,
+        uint64_t& reclaimableBytes) const override;
+
+    uint64_t reclaim(
+        memory::MemoryPool* pool,
+        uint64_t targetBytes,
+        uint64_t maxWaitMs,
+        memory::MemoryReclaimer::Stats& stats) override;
+
+   private:
+    explicit PartitionSortReclaimer(HiveDataSink* dataSink)
+        : memory::MemoryReclaimer(), dataSink_(dataSink) {
+      VELOX_CHECK_NOT_NULL(dataSink_);
+    }
+
+    HiveDataSink* const dataSink_;
+  };
+
   FOLLY_ALWAYS_INLINE bool sortWrite() const {
     return !sortColumnIndices_.empty();
   }
 
+  // Returns true if the input is buffered sorted by partition and the
+  // partitions are written one at a time on close.
+  FOLLY_ALWAYS_INLINE bool partitionSortWrite() const {
+    return partitionSortBuffer_ != nullptr;
+  }
+
   // Returns true if the table is partitioned.
   FOLLY_ALWAYS_INLINE bool isPartitioned() const {
     return partitionIdGenerator_ != nullptr;
@@ -556,6 +589,21 @@ class HiveDataSink : public DataSink {
   // Invoked to write 'input' to the specified file writer.
   void write(size_t index, RowVectorPtr input);
 
+  // Creates 'partitionSortBuffer_' if the partition sort write is enabled for
+  // this table write.
+  void maybeCreatePartitionSortBuffer();
+
+  // Writes the rows of 'partitionSortBuffer_' partition by partition, closing
+  // the writer of each partition before creating the writer of the next.
+  void writeSortedPartitions();
+
+  // Closes and releases the writer at 'index' before the data sink closes.
+  void closeWriter(uint32_t index);
+
+  // Closes the open writers, in parallel on 'ioExecutor_' if
+  // parallelWriterClose() is set.
+  void closeWriters();
+
   void closeInternal();
 
   const RowTypePtr inputType_;
@@ -573,6 +621,8 @@ class HiveDataSink : public DataSink {
   const std::unique_ptr<core::PartitionFunction> bucketFunction_;
   const std::shared_ptr<dwio::common::WriterFactory> writerFactory_;
   const common::SpillConfig* const spillConfig_;
+  // Executor to close the writers on. May be nullptr.
+  folly::Executor* const ioExecutor_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
@@ -591,6 +641,8 @@ class HiveDataSink : public DataSink {
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
+  // Wall time spent closing the writers.
+  uint64_t writerCloseTimeUs_{0};
 
   // Below are structures updated when processing current input. partitionIds_
   // are indexed by the row of input_. partitionRows_, rawPartitionRows_ and
@@ -602,6 +654,13 @@ class HiveDataSink : public DataSink {
 
   // Reusable buffers for bucket id calculations.
   std::vector<uint32_t> bucketIds_;
+
+  // Buffers the input rows sorted by partition columns if partitionSortWrite()
+  // is true. The buffer spills to disk under memory pressure if spilling is
+  // enabled.
+  std::shared_ptr<memory::MemoryPool> partitionSortPool_;
+  folly::Synchronized<common::SpillStats> partitionSortSpillStats_;
+  std::unique_ptr<exec::SortBuffer> partitionSortBuffer_;
 };
 
 } // namespace facebook::velox::connector::hive
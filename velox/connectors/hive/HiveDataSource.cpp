@@ -163,6 +163,8 @@ HiveDataSource::HiveDataSource(
       infoColumns_,
       rowIndexColumn_,
       pool_);
+  scanSpec_->setEnableFilterReorder(
+      connectorQueryCtx->adaptiveFilterReorderingEnabled());
   if (remainingFilter) {
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
@@ -284,6 +286,8 @@ void HiveDataSource::addDynamicFilter(
     const std::shared_ptr<common::Filter>& filter) {
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
   fieldSpec.addFilter(*filter);
+  // Reorders the filters now so that the reader of the current split applies
+  // the new filter from its next batch on, ranked by its own selectivity.
   scanSpec_->resetCachedValues(true);
   if (splitReader_) {
     splitReader_->resetFilterCaches();
@@ -327,6 +331,23 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
         RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+  // Averages over the files opened by this data source.
+  if (const auto numFiles = ioStats_->adaptiveLoadQuantum().count()) {
+    res.insert(
+        {{"adaptiveCoalesceDistance",
+          RuntimeCounter(
+              ioStats_->adaptiveCoalesceDistance().sum() / numFiles,
+              RuntimeCounter::Unit::kBytes)},
+         {"adaptiveLoadQuantum",
+          RuntimeCounter(
+              ioStats_->adaptiveLoadQuantum().sum() / numFiles,
+              RuntimeCounter::Unit::kBytes)}});
+  }
+  if (numMetadataAggregatedSplits_ > 0) {
+    res.insert(
+        {"metadataAggregatedSplits",
+         RuntimeCounter(numMetadataAggregatedSplits_)});
+  }
   return res;
 }
 
@@ -338,6 +359,9 @@ void HiveDataSource::setFromDataSource(
   split_ = std::move(source->split_);
   runtimeStats_.skippedSplits += source->runtimeStats_.skippedSplits;
   runtimeStats_.skippedSplitBytes += source->runtimeStats_.skippedSplitBytes;
+  // The split reader may have added columns to 'scanSpec_' for its split. It
+  // removes them when destroyed.
+  splitReader_.reset();
   source->scanSpec_->moveAdaptationFrom(*scanSpec_);
   scanSpec_ = std::move(source->scanSpec_);
   splitReader_ = std::move(source->splitReader_);
@@ -355,6 +379,21 @@ int64_t HiveDataSource::estimatedRowSize() {
   return splitReader_->estimatedRowSize();
 }
 
+std::optional<std::vector<variant>> HiveDataSource::aggregateFromMetadata(
+    const std::vector<MetadataAggregate>& aggregates) {
+  VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
+  VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
+  if (remainingFilterExprSet_ != nullptr) {
+    return std::nullopt;
+  }
+  auto results = splitReader_->aggregateFromMetadata(aggregates);
+  if (results.has_value()) {
+    ++numMetadataAggregatedSplits_;
+    resetSplit();
+  }
+  return results;
+}
+
 vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
   filterRows_.resize(output_->size());
   for (auto fieldIndex : multiReferencedFields_) {
@@ -73,6 +73,9 @@ class HiveDataSource : public DataSource {
 
   int64_t estimatedRowSize() override;
 
+  std::optional<std::vector<variant>> aggregateFromMetadata(
+      const std::vector<MetadataAggregate>& aggregates) override;
+
   std::shared_ptr<wave::WaveDataSource> toWaveDataSource() override;
 
   using WaveDelegateHookFunction =
@@ -152,6 +155,8 @@ class HiveDataSource : public DataSource {
   dwio::common::RuntimeStatistics runtimeStats_;
   std::atomic<uint64_t> totalRemainingFilterTime_{0};
   uint64_t completedRows_ = 0;
+  // Number of splits answered by aggregateFromMetadata().
+  uint64_t numMetadataAggregatedSplits_ = 0;
 
   // Field indices referenced in both remaining filter and output type.  These
   // columns need to be materialized eagerly to avoid missing values in output.
@@ -138,12 +138,18 @@ void SplitReader::configureReaderOptions(
       hiveTableHandle_,
       hiveSplit_);
   baseReaderOpts_.setRandomSkip(std::move(randomSkip));
+  baseReaderOpts_.setCacheQuota(connectorQueryCtx_->cacheQuota());
+  baseReaderOpts_.setPrefetchBudget(connectorQueryCtx_->prefetchBudget());
 }
 
 void SplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats,
     const std::shared_ptr<HiveColumnHandle>& rowIndexColumn) {
+  if (checkIfSplitIsEmptyBeforeOpen(runtimeStats)) {
+    return;
+  }
+
   createReader();
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
@@ -163,6 +169,42 @@ uint64_t SplitReader::next(uint64_t size, VectorPtr& output) {
   return baseRowReader_->next(size, output, &mutation);
 }
 
+std::optional<std::vector<variant>> SplitReader::aggregateFromMetadata(
+    const std::vector<MetadataAggregate>& aggregates) const {
+  if (emptySplit_ || baseReader_ == nullptr || baseReaderOpts_.randomSkip()) {
+    return std::nullopt;
+  }
+  // The footer describes the whole file, so the split must read all of it.
+  const auto fileSize = hiveSplit_->properties.has_value()
+      ? hiveSplit_->properties->fileSize
+      : std::nullopt;
+  if (hiveSplit_->start != 0 ||
+      (hiveSplit_->length != std::numeric_limits<uint64_t>::max() &&
+       (!fileSize.has_value() ||
+        hiveSplit_->length < static_cast<uint64_t>(fileSize.value())))) {
+    return std::nullopt;
+  }
+  // The statistics have the file types, which must be the types the query
+  // reads.
+  const auto& fileType = baseReader_->rowType();
+  for (const auto& aggregate : aggregates) {
+    const auto tableIndex =
+        readerOutputType_->getChildIdxIfExists(aggregate.column);
+    const auto fileIndex = fileType->getChildIdxIfExists(aggregate.column);
+    if (tableIndex.has_value() && fileIndex.has_value() &&
+        !readerOutputType_->childAt(tableIndex.value())
+             ->equivalent(*fileType->childAt(fileIndex.value()))) {
+      return std::nullopt;
+    }
+  }
+  return aggregateFromFileStats(
+      scanSpec_.get(),
+      baseReader_.get(),
+      aggregates,
+      hiveSplit_->partitionKeys,
+      *partitionKeys_);
+}
+
 void SplitReader::resetFilterCaches() {
   if (baseRowReader_) {
     baseRowReader_->resetFilterCaches();
@@ -286,6 +328,17 @@ bool SplitReader::checkIfSplitIsEmpty(
   return emptySplit_;
 }
 
+bool SplitReader::checkIfSplitIsEmptyBeforeOpen(
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  if (!testFiltersOnSplitMetadata(
+          scanSpec_.get(), *hiveSplit_, readerOutputType_, *partitionKeys_)) {
+    ++runtimeStats.skippedSplits;
+    runtimeStats.skippedSplitBytes += hiveSplit_->length;
+    emptySplit_ = true;
+  }
+  return emptySplit_;
+}
+
 void SplitReader::createRowReader(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     const std::shared_ptr<HiveColumnHandle>& rowIndexColumn) {
@@ -303,6 +356,12 @@ void SplitReader::createRowReader(
       std::move(metadataFilter),
       ROW(std::move(columnNames), std::move(columnTypes)),
       hiveSplit_);
+  if (executor_ != nullptr &&
+      hiveConfig_->lazyLoadPrefetch(connectorQueryCtx_->sessionProperties())) {
+    // The executor belongs to the connector and outlives the reader.
+    baseRowReaderOpts_.setDecodingExecutor(
+        std::shared_ptr<folly::Executor>(std::shared_ptr<void>(), executor_));
+  }
   // NOTE: we firstly reset the finished 'baseRowReader_' of previous split
   // before setting up for the next one to avoid doubling the peak memory usage.
   baseRowReader_.reset();
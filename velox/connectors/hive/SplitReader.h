@@ -33,6 +33,7 @@ class ScanSpec;
 
 namespace facebook::velox::connector {
 class ConnectorQueryCtx;
+struct MetadataAggregate;
 } // namespace facebook::velox::connector
 
 namespace facebook::velox::dwio::common {
@@ -96,6 +97,13 @@ class SplitReader {
 
   virtual uint64_t next(uint64_t size, VectorPtr& output);
 
+  /// Computes 'aggregates' over the rows of the split from the file metadata.
+  /// Returns std::nullopt if the split covers only part of the file, rows are
+  /// sampled or the metadata does not give the exact values. Called after
+  /// prepareSplit().
+  virtual std::optional<std::vector<variant>> aggregateFromMetadata(
+      const std::vector<MetadataAggregate>& aggregates) const;
+
   void resetFilterCaches();
 
   bool emptySplit() const;
@@ -125,6 +133,12 @@ class SplitReader {
   /// This function needs to be called after baseReader_ is created.
   bool checkIfSplitIsEmpty(dwio::common::RuntimeStatistics& runtimeStats);
 
+  /// Checks if the split can be skipped from its partition key values and the
+  /// file statistics carried by the split, before the file is opened. Sets
+  /// emptySplit_ and updates 'runtimeStats' if so.
+  bool checkIfSplitIsEmptyBeforeOpen(
+      dwio::common::RuntimeStatistics& runtimeStats);
+
   /// Create the dwio::common::RowReader object baseRowReader_, which owns the
   /// ColumnReaders that will be used to read the data
   void createRowReader(
@@ -51,6 +51,26 @@ HiveColumnHandle::ColumnType HiveColumnHandle::columnTypeFromName(
   return nameColumnTypes.at(name);
 }
 
+std::shared_ptr<ColumnHandle> HiveColumnHandle::withRequiredSubfields(
+    std::vector<common::Subfield> subfields) const {
+  if (columnType_ != ColumnType::kRegular || !requiredSubfields_.empty()) {
+    return nullptr;
+  }
+  // The subfields are rooted at the output name, which may be an alias.
+  std::vector<common::Subfield> required;
+  required.reserve(subfields.size());
+  for (const auto& subfield : subfields) {
+    std::vector<std::unique_ptr<common::Subfield::PathElement>> path;
+    path.push_back(std::make_unique<common::Subfield::NestedField>(name_));
+    for (auto i = 1; i < subfield.path().size(); ++i) {
+      path.push_back(subfield.path()[i]->clone());
+    }
+    required.emplace_back(std::move(path));
+  }
+  return std::make_shared<HiveColumnHandle>(
+      name_, columnType_, dataType_, hiveType_, std::move(required));
+}
+
 folly::dynamic HiveColumnHandle::serialize() const {
   folly::dynamic obj = ColumnHandle::serializeBase("HiveColumnHandle");
   obj["hiveColumnHandleName"] = name_;
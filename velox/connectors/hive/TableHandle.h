@@ -94,6 +94,9 @@ class HiveColumnHandle : public ColumnHandle {
     return requiredSubfields_;
   }
 
+  std::shared_ptr<ColumnHandle> withRequiredSubfields(
+      std::vector<common::Subfield> subfields) const override;
+
   bool isPartitionKey() const {
     return columnType_ == ColumnType::kPartitionKey;
   }
@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/String.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/file/tests/FaultyFileSystem.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/time/Timer.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+#ifdef VELOX_ENABLE_PARQUET
+#define VELOX_CACHED_SCAN_FORMATS "dwrf,parquet"
+#else
+#define VELOX_CACHED_SCAN_FORMATS "dwrf"
+#endif
+
+DEFINE_string(
+    formats,
+    VELOX_CACHED_SCAN_FORMATS,
+    "Comma separated file formats to benchmark");
+DEFINE_int32(num_files, 8, "Number of generated files of each format");
+DEFINE_int32(rows_per_file, 1'000'000, "Number of rows of each file");
+DEFINE_int32(num_columns, 16, "Number of columns of the generated files");
+DEFINE_int32(
+    read_columns,
+    4,
+    "Number of columns to read, evenly spaced over the columns of the file");
+DEFINE_double(null_ratio, 0.1, "Fraction of nulls of the generated values");
+DEFINE_int64(seed, 1, "Seed of the generated data");
+DEFINE_int32(num_drivers, 4, "Number of drivers");
+DEFINE_int32(num_splits_per_file, 2, "Number of splits per file");
+DEFINE_int32(num_io_threads, 8, "Threads for speculative IO");
+DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
+DEFINE_int32(cache_gb, 4, "GB of memory cache");
+DEFINE_string(ssd_path, "", "Directory for local SSD cache");
+DEFINE_int32(ssd_cache_gb, 0, "Size of local SSD cache in GB");
+DEFINE_int32(
+    storage_latency_us,
+    5'000,
+    "Latency of each read from storage in microseconds");
+DEFINE_int32(
+    storage_throughput_mb,
+    100,
+    "Throughput of each read from storage in MB/s");
+DEFINE_int64(
+    max_coalesced_bytes,
+    128 << 20,
+    "Maximum size of single coalesced IO");
+DEFINE_int32(
+    max_coalesced_distance_bytes,
+    512 << 10,
+    "Maximum distance in bytes in which coalesce will combine requests");
+
+/// Measures scans of DWRF and Parquet files through the memory and SSD
+/// caches, with reads from storage slowed down to model remote storage.
+/// Each storage read waits --storage_latency_us plus its size divided by
+/// --storage_throughput_mb. Reads of the SSD cache are not slowed down.
+///
+/// The files are generated from --seed so that runs with the same flags
+/// scan the same bytes. Each format is scanned cold, with empty caches, then
+/// from the SSD cache, if configured, with an empty memory cache, then warm
+/// from the memory cache. For each scan, reports the share of bytes read
+/// from memory, SSD and storage, the number and average size of the storage
+/// reads with the share of bytes read over the requested ranges to measure
+/// coalescing, and the time the drivers waited for IO.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::tests::utils;
+
+namespace {
+
+// IO issued to storage through the faulty file system.
+struct StorageStats {
+  std::atomic<uint64_t> numReads{0};
+  std::atomic<uint64_t> readBytes{0};
+  std::atomic<uint64_t> delayUs{0};
+};
+
+class CachedScanBenchmark {
+ public:
+  void initialize() {
+    memory::MemoryManagerOptions options;
+    options.useMmapAllocator = true;
+    options.allocatorCapacity = static_cast<int64_t>(FLAGS_cache_gb) << 30;
+    options.useMmapArena = true;
+    options.mmapArenaCapacityRatio = 1;
+    memory::MemoryManager::testingSetInstance(options);
+    std::unique_ptr<cache::SsdCache> ssdCache;
+    if (FLAGS_ssd_cache_gb) {
+      constexpr int32_t kNumSsdShards = 16;
+      cacheExecutor_ =
+          std::make_unique<folly::IOThreadPoolExecutor>(kNumSsdShards);
+      const cache::SsdCache::Config config(
+          FLAGS_ssd_path,
+          static_cast<uint64_t>(FLAGS_ssd_cache_gb) << 30,
+          kNumSsdShards,
+          cacheExecutor_.get());
+      ssdCache = std::make_unique<cache::SsdCache>(config);
+    }
+    cache_ = cache::AsyncDataCache::create(
+        memory::memoryManager()->allocator(), std::move(ssdCache));
+    cache::AsyncDataCache::setInstance(cache_.get());
+    pool_ = memory::memoryManager()->addLeafPool();
+
+    filesystems::registerLocalFileSystem();
+    registerFaultyFileSystem();
+    ioExecutor_ =
+        std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+    faultyFileSystem()->setExecutor(ioExecutor_.get());
+    faultyFileSystem()->setFileInjectionHook(
+        [this](FaultFileOperation* op) { delayStorageRead(op); });
+
+    std::unordered_map<std::string, std::string> configs;
+    configs[connector::hive::HiveConfig::kMaxCoalescedBytes] =
+        std::to_string(FLAGS_max_coalesced_bytes);
+    configs[connector::hive::HiveConfig::kMaxCoalescedDistanceBytes] =
+        std::to_string(FLAGS_max_coalesced_distance_bytes);
+    connector::registerConnector(
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(
+                kHiveConnectorId,
+                std::make_shared<core::MemConfig>(std::move(configs)),
+                ioExecutor_.get()));
+
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    const std::vector<TypePtr> kTypes = {
+        BIGINT(), DOUBLE(), VARCHAR(), INTEGER()};
+    for (auto i = 0; i < FLAGS_num_columns; ++i) {
+      names.push_back(fmt::format("c{}", i));
+      types.push_back(kTypes[i % kTypes.size()]);
+    }
+    fileType_ = ROW(std::move(names), std::move(types));
+
+    names.clear();
+    types.clear();
+    const auto stride =
+        std::max(1, FLAGS_num_columns / std::max(1, FLAGS_read_columns));
+    for (auto i = 0; i < FLAGS_num_columns; i += stride) {
+      if (names.size() == FLAGS_read_columns) {
+        break;
+      }
+      names.push_back(fileType_->nameOf(i));
+      types.push_back(fileType_->childAt(i));
+    }
+    readType_ = ROW(std::move(names), std::move(types));
+  }
+
+  void shutdown() {
+    connector::unregisterConnector(kHiveConnectorId);
+    cache_->shutdown();
+  }
+
+  void run(dwio::common::FileFormat format) {
+    const auto files = writeFiles(format);
+    runScan(format, files, "cold", [&]() {
+      cache_->testingClear();
+      if (auto* ssdCache = cache_->ssdCache()) {
+        ssdCache->testingClear();
+      }
+    });
+    if (auto* ssdCache = cache_->ssdCache()) {
+      runScan(format, files, "ssd", [&]() {
+        cache_->saveToSsd();
+        while (ssdCache->writeInProgress()) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        cache_->testingClear();
+      });
+    }
+    runScan(format, files, "warm", []() {});
+  }
+
+ private:
+  // Sleeps for the time the storage modeled by the flags takes to serve
+  // 'op'.
+  void delayStorageRead(FaultFileOperation* op) {
+    uint64_t bytes = 0;
+    if (op->type == FaultFileOperation::Type::kRead) {
+      bytes = static_cast<FaultFileReadOperation*>(op)->length;
+    } else if (op->type == FaultFileOperation::Type::kReadv) {
+      for (const auto& buffer :
+           static_cast<FaultFileReadvOperation*>(op)->buffers) {
+        bytes += buffer.size();
+      }
+    } else {
+      return;
+    }
+    const uint64_t delayUs = FLAGS_storage_latency_us +
+        bytes * 1'000'000 / (static_cast<uint64_t>(FLAGS_storage_throughput_mb)
+                             << 20);
+    ++storageStats_.numReads;
+    storageStats_.readBytes += bytes;
+    storageStats_.delayUs += delayUs;
+    std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+  }
+
+  // Writes the files of 'format' and returns their paths.
+  std::vector<std::string> writeFiles(dwio::common::FileFormat format) {
+    auto directory = TempDirectoryPath::create();
+    for (auto i = 0; i < FLAGS_num_files; ++i) {
+      VectorFuzzer::Options opts;
+      opts.vectorSize = 10'000;
+      opts.nullRatio = FLAGS_null_ratio;
+      opts.stringLength = 20;
+      opts.stringVariableLength = true;
+      VectorFuzzer fuzzer(opts, pool_.get(), FLAGS_seed + i);
+      std::vector<RowVectorPtr> vectors;
+      for (auto rows = 0; rows < FLAGS_rows_per_file;
+           rows += opts.vectorSize) {
+        vectors.push_back(fuzzer.fuzzInputFlatRow(fileType_));
+      }
+      AssertQueryBuilder(PlanBuilder()
+                             .values(vectors)
+                             .tableWrite(directory->getPath(), format)
+                             .planNode())
+          .copyResults(pool_.get());
+    }
+    auto files = filesystems::getFileSystem(directory->getPath(), nullptr)
+                     ->list(directory->getPath());
+    VELOX_CHECK_EQ(files.size(), FLAGS_num_files);
+    directories_.push_back(std::move(directory));
+    return files;
+  }
+
+  // Calls 'prepare' to set up the caches and scans 'files' through storage
+  // with latency.
+  void runScan(
+      dwio::common::FileFormat format,
+      const std::vector<std::string>& files,
+      const std::string& label,
+      std::function<void()> prepare) {
+    prepare();
+    storageStats_.numReads = 0;
+    storageStats_.readBytes = 0;
+    storageStats_.delayUs = 0;
+
+    core::PlanNodeId scanId;
+    CursorParameters params;
+    params.planNode =
+        PlanBuilder().tableScan(readType_).capturePlanNodeId(scanId).planNode();
+    params.maxDrivers = FLAGS_num_drivers;
+    params.queryConfigs[core::QueryConfig::kMaxSplitPreloadPerDriver] =
+        std::to_string(FLAGS_split_preload_per_driver);
+
+    uint64_t wallMicros = 0;
+    uint64_t numRows = 0;
+    std::shared_ptr<Task> task;
+    {
+      MicrosecondTimer timer(&wallMicros);
+      auto cursor = TaskCursor::create(params);
+      task = cursor->task();
+      for (const auto& file : files) {
+        for (auto& split : HiveConnectorTestBase::makeHiveConnectorSplits(
+                 FaultyFileSystem::scheme() + file,
+                 FLAGS_num_splits_per_file,
+                 format)) {
+          task->addSplit(scanId, Split(std::move(split)));
+        }
+      }
+      task->noMoreSplits(scanId);
+      while (cursor->moveNext()) {
+        numRows += cursor->current()->size();
+      }
+      VELOX_CHECK(waitForTaskCompletion(task.get()));
+    }
+
+    const auto planStats = toPlanStats(task->taskStats());
+    const auto& stats = planStats.at(scanId).customStats;
+    auto sum = [&](const std::string& name) -> int64_t {
+      auto it = stats.find(name);
+      return it == stats.end() ? 0 : it->second.sum;
+    };
+    auto percent = [](int64_t part, int64_t total) {
+      return total == 0 ? 0.0 : 100.0 * part / total;
+    };
+    const auto ramBytes = sum("ramReadBytes");
+    const auto ssdBytes = sum("localReadBytes");
+    const auto storageBytes = sum("storageReadBytes");
+    const auto totalBytes = ramBytes + ssdBytes + storageBytes;
+    const auto numStorageReads = storageStats_.numReads.load();
+    const auto ioWait = stats.find("ioWaitNanos");
+
+    std::cout << fmt::format(
+                     "{} {}: {} rows in {}",
+                     dwio::common::toString(format),
+                     label,
+                     numRows,
+                     succinctMicros(wallMicros))
+              << std::endl
+              << fmt::format(
+                     "  hits: memory {:.1f}%, ssd {:.1f}%, storage {:.1f}% "
+                     "of {}",
+                     percent(ramBytes, totalBytes),
+                     percent(ssdBytes, totalBytes),
+                     percent(storageBytes, totalBytes),
+                     succinctBytes(totalBytes))
+              << std::endl
+              << fmt::format(
+                     "  storage: {} reads of {} on average, {:.1f}% overread, "
+                     "{} modeled delay",
+                     numStorageReads,
+                     succinctBytes(
+                         numStorageReads == 0
+                             ? 0
+                             : storageStats_.readBytes / numStorageReads),
+                     percent(sum("overreadBytes"), storageStats_.readBytes),
+                     succinctMicros(storageStats_.delayUs))
+              << std::endl
+              << fmt::format(
+                     "  io wait per driver: {} average, {} max, prefetch {}",
+                     succinctNanos(
+                         ioWait == stats.end() || ioWait->second.count == 0
+                             ? 0
+                             : ioWait->second.sum / ioWait->second.count),
+                     succinctNanos(
+                         ioWait == stats.end() ? 0 : ioWait->second.max),
+                     succinctBytes(sum("prefetchBytes")))
+              << std::endl;
+  }
+
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  RowTypePtr fileType_;
+  RowTypePtr readType_;
+  std::vector<std::shared_ptr<TempDirectoryPath>> directories_;
+  StorageStats storageStats_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  CachedScanBenchmark benchmark;
+  benchmark.initialize();
+  std::vector<std::string> formats;
+  folly::split(',', FLAGS_formats, formats);
+  for (const auto& format : formats) {
+    benchmark.run(dwio::common::toFileFormat(format));
+  }
+  benchmark.shutdown();
+  return 0;
+}
@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <algorithm>
+#include <deque>
+
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+
+constexpr uint64_t kReadBatchSize = 10'000;
+
+template <TypeKind Kind>
+void appendValue(
+    const BaseVector& vector,
+    vector_size_t row,
+    std::string& out) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  auto value = vector.as<SimpleVector<T>>()->valueAt(row);
+  if constexpr (std::is_same_v<T, StringView>) {
+    const uint32_t size = value.size();
+    out.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.append(value.data(), size);
+  } else if constexpr (std::is_same_v<T, bool>) {
+    out.push_back(value ? 1 : 0);
+  } else {
+    if constexpr (std::is_floating_point_v<T>) {
+      // Make NaNs and zeros with different bit patterns equal, as in SQL
+      // comparisons.
+      if (std::isnan(value)) {
+        value = std::numeric_limits<T>::quiet_NaN();
+      } else if (value == 0) {
+        value = 0;
+      }
+    }
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+bool isIntegerKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t integerAt(const BaseVector& vector, vector_size_t row) {
+  switch (vector.typeKind()) {
+    case TypeKind::TINYINT:
+      return vector.as<SimpleVector<int8_t>>()->valueAt(row);
+    case TypeKind::SMALLINT:
+      return vector.as<SimpleVector<int16_t>>()->valueAt(row);
+    case TypeKind::INTEGER:
+      return vector.as<SimpleVector<int32_t>>()->valueAt(row);
+    case TypeKind::BIGINT:
+      return vector.as<SimpleVector<int64_t>>()->valueAt(row);
+    default:
+      VELOX_UNREACHABLE("Unexpected type {}", vector.type()->toString());
+  }
+}
+
+struct EqualityDeleteCache {
+  folly::F14FastMap<std::string, std::shared_ptr<const EqualityDeleteSet>>
+      sets;
+  // Cached delete file paths in insertion order, used for eviction.
+  std::deque<std::string> paths;
+  // Sum of EqualityDeleteSet::retainedBytes() over 'sets'.
+  uint64_t retainedBytes{0};
+};
+
+folly::Synchronized<EqualityDeleteCache>& equalityDeleteCache() {
+  static folly::Synchronized<EqualityDeleteCache> cache;
+  return cache;
+}
+
+} // namespace
+
+EqualityDeleteSet::EqualityDeleteSet(const RowVectorPtr& keys)
+    : keyType_(asRowType(keys->type())) {
+  for (const auto& type : keyType_->children()) {
+    VELOX_CHECK(
+        type->isPrimitiveType(),
+        "Iceberg equality delete column must be of primitive type: {}",
+        type->toString());
+  }
+
+  if (tryInitArrayMode(keys)) {
+    return;
+  }
+
+  const std::vector<VectorPtr>& columns = keys->children();
+  std::string key;
+  for (vector_size_t row = 0; row < keys->size(); ++row) {
+    key.clear();
+    serializeRow(columns, row, key);
+    if (serializedKeys_.insert(key).second) {
+      retainedBytes_ += sizeof(std::string) + key.capacity();
+    }
+  }
+  numKeys_ = serializedKeys_.size();
+}
+
+bool EqualityDeleteSet::tryInitArrayMode(const RowVectorPtr& keys) {
+  if (keyType_->size() != 1 || !isIntegerKind(keyType_->childAt(0)->kind())) {
+    return false;
+  }
+
+  const auto& column = *keys->childAt(0);
+  bool hasValue = false;
+  for (vector_size_t row = 0; row < keys->size(); ++row) {
+    if (column.isNullAt(row)) {
+      hasNullKey_ = true;
+      continue;
+    }
+    const auto value = integerAt(column, row);
+    if (!hasValue) {
+      minKey_ = value;
+      maxKey_ = value;
+      hasValue = true;
+    } else {
+      minKey_ = std::min(minKey_, value);
+      maxKey_ = std::max(maxKey_, value);
+    }
+  }
+
+  // Computed in unsigned arithmetic so that the full int64_t range does not
+  // overflow.
+  const uint64_t range =
+      static_cast<uint64_t>(maxKey_) - static_cast<uint64_t>(minKey_);
+  if (hasValue && range >= kMaxArrayRange) {
+    return false;
+  }
+
+  arrayMode_ = true;
+  if (hasValue) {
+    keyBits_.resize(bits::nwords(range + 1));
+    for (vector_size_t row = 0; row < keys->size(); ++row) {
+      if (!column.isNullAt(row)) {
+        bits::setBit(keyBits_.data(), integerAt(column, row) - minKey_);
+      }
+    }
+    numKeys_ = bits::countBits(keyBits_.data(), 0, range + 1);
+    retainedBytes_ = keyBits_.size() * sizeof(uint64_t);
+  }
+  numKeys_ += hasNullKey_ ? 1 : 0;
+  return true;
+}
+
+// static
+void EqualityDeleteSet::serializeRow(
+    const std::vector<VectorPtr>& columns,
+    vector_size_t row,
+    std::string& out) {
+  for (const auto& column : columns) {
+    if (column->isNullAt(row)) {
+      out.push_back(0);
+      continue;
+    }
+    out.push_back(1);
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        appendValue, column->typeKind(), *column, row, out);
+  }
+}
+
+void EqualityDeleteSet::markDeleted(
+    const std::vector<VectorPtr>& keyColumns,
+    vector_size_t numRows,
+    uint64_t* deletedRows) const {
+  VELOX_CHECK_EQ(keyColumns.size(), keyType_->size());
+  if (numKeys_ == 0) {
+    return;
+  }
+
+  if (arrayMode_) {
+    const auto& column = *keyColumns[0];
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      if (column.isNullAt(row)) {
+        if (hasNullKey_) {
+          bits::setBit(deletedRows, row);
+        }
+        continue;
+      }
+      const auto value = integerAt(column, row);
+      if (value >= minKey_ && value <= maxKey_ &&
+          bits::isBitSet(keyBits_.data(), value - minKey_)) {
+        bits::setBit(deletedRows, row);
+      }
+    }
+    return;
+  }
+
+  std::string key;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    key.clear();
+    serializeRow(keyColumns, row, key);
+    if (serializedKeys_.contains(key)) {
+      bits::setBit(deletedRows, row);
+    }
+  }
+}
+
+// static
+std::shared_ptr<const EqualityDeleteSet> EqualityDeleteFileReader::read(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId) {
+  VELOX_CHECK(deleteFile.content == FileContent::kEqualityDeletes);
+  {
+    auto cache = equalityDeleteCache().rlock();
+    auto it = cache->sets.find(deleteFile.filePath);
+    if (it != cache->sets.end()) {
+      return it->second;
+    }
+  }
+
+  // Concurrent readers of the same file may both read it. The first one to
+  // finish populates the cache.
+  auto deleteSet = readFile(
+      deleteFile,
+      fileHandleFactory,
+      connectorQueryCtx,
+      executor,
+      hiveConfig,
+      ioStats,
+      connectorId);
+
+  // A set larger than the whole cache is used by this split only.
+  if (deleteSet->retainedBytes() > kMaxCachedBytes) {
+    return deleteSet;
+  }
+
+  auto cache = equalityDeleteCache().wlock();
+  auto [it, inserted] = cache->sets.emplace(deleteFile.filePath, deleteSet);
+  if (!inserted) {
+    return it->second;
+  }
+  cache->paths.push_back(deleteFile.filePath);
+  cache->retainedBytes += deleteSet->retainedBytes();
+  while (cache->retainedBytes > kMaxCachedBytes) {
+    auto oldest = cache->sets.find(cache->paths.front());
+    cache->retainedBytes -= oldest->second->retainedBytes();
+    cache->sets.erase(oldest);
+    cache->paths.pop_front();
+  }
+  return deleteSet;
+}
+
+// static
+void EqualityDeleteFileReader::clearCache() {
+  auto cache = equalityDeleteCache().wlock();
+  cache->sets.clear();
+  cache->paths.clear();
+  cache->retainedBytes = 0;
+}
+
+// static
+size_t EqualityDeleteFileReader::cacheSize() {
+  return equalityDeleteCache().rlock()->sets.size();
+}
+
+// static
+std::shared_ptr<const EqualityDeleteSet> EqualityDeleteFileReader::readFile(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId) {
+  auto* pool = connectorQueryCtx->memoryPool();
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile.filePath,
+      deleteFile.fileFormat,
+      0,
+      deleteFile.fileSizeInBytes);
+
+  // The delete file schema is not known upfront. Read it from the file.
+  dwio::common::ReaderOptions deleteReaderOpts(pool);
+  configureReaderOptions(
+      deleteReaderOpts,
+      hiveConfig,
+      connectorQueryCtx->sessionProperties(),
+      nullptr,
+      deleteSplit);
+
+  auto deleteFileHandle = fileHandleFactory->generate(deleteFile.filePath);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandle, deleteReaderOpts, connectorQueryCtx, ioStats, executor);
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  const auto& deleteFileSchema = deleteReader->rowType();
+  const auto keyType = resolveKeyType(
+      deleteFile, deleteFileSchema, deleteReader->fieldIds());
+
+  // Only the equality delete columns are read.
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addAllChildFields(*keyType);
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      deleteRowReaderOpts,
+      {},
+      scanSpec,
+      nullptr,
+      deleteFileSchema,
+      deleteSplit);
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
+
+  auto keys = BaseVector::create<RowVector>(keyType, 0, pool);
+  VectorPtr batch = BaseVector::create(keyType, 0, pool);
+  while (deleteRowReader->next(kReadBatchSize, batch) > 0) {
+    const auto numRows = batch->size();
+    if (numRows == 0) {
+      continue;
+    }
+    batch->loadedVector();
+    const auto offset = keys->size();
+    keys->resize(offset + numRows);
+    keys->copy(batch.get(), offset, 0, numRows);
+  }
+
+  return std::make_shared<const EqualityDeleteSet>(keys);
+}
+
+// static
+RowTypePtr EqualityDeleteFileReader::resolveKeyType(
+    const IcebergDeleteFile& deleteFile,
+    const RowTypePtr& fileType,
+    const std::optional<std::vector<int32_t>>& fileFieldIds) {
+  const auto& equalityFieldIds = deleteFile.equalityFieldIds;
+  if (equalityFieldIds.empty() ||
+      (!fileFieldIds.has_value() &&
+       equalityFieldIds.size() == fileType->size())) {
+    return fileType;
+  }
+
+  VELOX_USER_CHECK(
+      fileFieldIds.has_value(),
+      "Iceberg equality delete file {} has {} columns but {} equality field "
+      "ids and no field ids to resolve them",
+      deleteFile.filePath,
+      fileType->size(),
+      equalityFieldIds.size());
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (const auto fieldId : equalityFieldIds) {
+    auto it = std::find(fileFieldIds->begin(), fileFieldIds->end(), fieldId);
+    VELOX_USER_CHECK(
+        it != fileFieldIds->end(),
+        "Iceberg equality field id {} is not in delete file {}",
+        fieldId,
+        deleteFile.filePath);
+    const auto index = it - fileFieldIds->begin();
+    names.push_back(fileType->nameOf(index));
+    types.push_back(fileType->childAt(index));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
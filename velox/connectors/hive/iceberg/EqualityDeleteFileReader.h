@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Set.h>
+#include <memory>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// The set of deleted keys read from one Iceberg equality delete file. A base
+/// file row is deleted if its values in the delete columns are equal to the
+/// values of any row in the delete file. Nulls compare equal to nulls.
+///
+/// A single integer key whose value range is small enough is stored as a
+/// bitmap indexed by 'value - min', similar to the array mode of the hash
+/// table. Other keys are serialized and kept in a hash set. The set does not
+/// reference any memory pool so that it can outlive the query that read it.
+class EqualityDeleteSet {
+ public:
+  /// Builds the set from the rows of 'keys'. The children of 'keys' must be
+  /// loaded and of primitive types, as required by the Iceberg spec.
+  explicit EqualityDeleteSet(const RowVectorPtr& keys);
+
+  /// Names and types of the delete columns.
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  /// Number of distinct deleted keys.
+  size_t size() const {
+    return numKeys_;
+  }
+
+  /// Approximate number of bytes of memory held by the set.
+  uint64_t retainedBytes() const {
+    return retainedBytes_;
+  }
+
+  /// Sets the bit in 'deletedRows' for each of the first 'numRows' rows whose
+  /// values in 'keyColumns' match a deleted key. 'keyColumns' are loaded base
+  /// file columns in the order of keyType().
+  void markDeleted(
+      const std::vector<VectorPtr>& keyColumns,
+      vector_size_t numRows,
+      uint64_t* deletedRows) const;
+
+ private:
+  // Maximum number of bits in the bitmap used for a single integer key.
+  static constexpr int64_t kMaxArrayRange = 1 << 22;
+
+  bool tryInitArrayMode(const RowVectorPtr& keys);
+
+  static void serializeRow(
+      const std::vector<VectorPtr>& columns,
+      vector_size_t row,
+      std::string& out);
+
+  const RowTypePtr keyType_;
+  size_t numKeys_{0};
+  uint64_t retainedBytes_{0};
+
+  // Set if the key is a single integer column with a small value range.
+  bool arrayMode_{false};
+  int64_t minKey_{0};
+  int64_t maxKey_{0};
+  bool hasNullKey_{false};
+  std::vector<uint64_t> keyBits_;
+
+  // Serialized keys. Used when not in array mode.
+  folly::F14FastSet<std::string> serializedKeys_;
+};
+
+/// Reads Iceberg equality delete files into EqualityDeleteSet. The sets are
+/// cached by delete file path since delete files are immutable and the same
+/// delete file usually applies to all the splits of a snapshot. The cache is
+/// bounded by the retained bytes of the sets and evicts the oldest first.
+///
+/// The delete columns are the ones whose field ids are in 'equalityFieldIds'.
+/// Field ids are taken from the file, e.g. the Parquet field_id. A file
+/// without field ids must contain exactly the delete columns.
+class EqualityDeleteFileReader {
+ public:
+  /// Returns the deleted keys in 'deleteFile', reading the file if it is not
+  /// in the cache.
+  static std::shared_ptr<const EqualityDeleteSet> read(
+      const IcebergDeleteFile& deleteFile,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::string& connectorId);
+
+  /// Drops all cached delete sets.
+  static void clearCache();
+
+  /// Returns the number of cached delete sets.
+  static size_t cacheSize();
+
+ private:
+  // Maximum retained bytes of the delete sets kept in the cache.
+  static constexpr uint64_t kMaxCachedBytes = 256 << 20;
+
+  static std::shared_ptr<const EqualityDeleteSet> readFile(
+      const IcebergDeleteFile& deleteFile,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::string& connectorId);
+
+  // Returns the delete columns of a delete file of type 'fileType' whose
+  // top-level columns have 'fileFieldIds'.
+  static RowTypePtr resolveKeyType(
+      const IcebergDeleteFile& deleteFile,
+      const RowTypePtr& fileType,
+      const std::optional<std::vector<int32_t>>& fileFieldIds);
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include <algorithm>
+
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
@@ -50,10 +52,34 @@ IcebergSplitReader::IcebergSplitReader(
       baseReadOffset_(0),
       splitOffset_(0) {}
 
+IcebergSplitReader::~IcebergSplitReader() {
+  if (extraKeyNames_.empty()) {
+    return;
+  }
+  // The row reader references the children of 'scanSpec_' that are removed
+  // below.
+  baseRowReader_.reset();
+  for (const auto& name : extraKeyNames_) {
+    if (std::find(addedKeySpecs_.begin(), addedKeySpecs_.end(), name) !=
+        addedKeySpecs_.end()) {
+      scanSpec_->removeChild(name);
+    } else {
+      auto* childSpec = scanSpec_->childByName(name);
+      childSpec->setProjectOut(false);
+      childSpec->setChannel(common::ScanSpec::kNoChannel);
+    }
+  }
+  scanSpec_->resetCachedValues(false);
+}
+
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats,
     const std::shared_ptr<HiveColumnHandle>& rowIndexColumn) {
+  if (checkIfSplitIsEmptyBeforeOpen(runtimeStats)) {
+    return;
+  }
+
   createReader();
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
@@ -61,15 +87,41 @@ void IcebergSplitReader::prepareSplit(
     return;
   }
 
-  createRowReader(metadataFilter, rowIndexColumn);
-
   std::shared_ptr<const HiveIcebergSplit> icebergSplit =
       std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
+  const auto& deleteFiles = icebergSplit->deleteFiles;
+
+  // The equality delete files are read first since their columns may have to
+  // be added to 'scanSpec_' before the row reader is made.
+  equalityDeleteSets_.clear();
+  equalityDeleteChannels_.clear();
+  for (const auto& deleteFile : deleteFiles) {
+    if (deleteFile.content == FileContent::kEqualityDeletes &&
+        deleteFile.recordCount > 0) {
+      addEqualityDeleteSet(EqualityDeleteFileReader::read(
+          deleteFile,
+          fileHandleFactory_,
+          connectorQueryCtx_,
+          executor_,
+          hiveConfig_,
+          ioStats_,
+          hiveSplit_->connectorId));
+    }
+  }
+  if (!equalityDeleteSets_.empty()) {
+    auto names = readerOutputType_->names();
+    auto types = readerOutputType_->children();
+    names.insert(names.end(), extraKeyNames_.begin(), extraKeyNames_.end());
+    types.insert(types.end(), extraKeyTypes_.begin(), extraKeyTypes_.end());
+    equalityDeleteInputType_ = ROW(std::move(names), std::move(types));
+  }
+
+  createRowReader(metadataFilter, rowIndexColumn);
+
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
   positionalDeleteFileReaders_.clear();
 
-  const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
     if (deleteFile.content == FileContent::kPositionalDeletes) {
       if (deleteFile.recordCount > 0) {
@@ -86,12 +138,93 @@ void IcebergSplitReader::prepareSplit(
                 splitOffset_,
                 hiveSplit_->connectorId));
       }
-    } else {
+    } else if (deleteFile.content != FileContent::kEqualityDeletes) {
       VELOX_NYI();
     }
   }
 }
 
+void IcebergSplitReader::addEqualityDeleteSet(
+    std::shared_ptr<const EqualityDeleteSet> deleteSet) {
+  if (deleteSet->size() == 0) {
+    return;
+  }
+
+  // The delete columns are matched to the base file columns by name. They must
+  // be read even if they are not part of the query output.
+  const auto& keyType = deleteSet->keyType();
+  std::vector<column_index_t> channels;
+  channels.reserve(keyType->size());
+  for (auto i = 0; i < keyType->size(); ++i) {
+    const auto& name = keyType->nameOf(i);
+    const auto& type = keyType->childAt(i);
+    auto channel = readerOutputType_->getChildIdxIfExists(name);
+    if (!channel.has_value()) {
+      channels.push_back(addExtraKeyColumn(name, type));
+      continue;
+    }
+    VELOX_CHECK(
+        readerOutputType_->childAt(channel.value())->equivalent(*type),
+        "Type mismatch for Iceberg equality delete column {}: {} vs. {}",
+        name,
+        readerOutputType_->childAt(channel.value())->toString(),
+        type->toString());
+    channels.push_back(channel.value());
+  }
+  equalityDeleteSets_.push_back(std::move(deleteSet));
+  equalityDeleteChannels_.push_back(std::move(channels));
+}
+
+column_index_t IcebergSplitReader::addExtraKeyColumn(
+    const std::string& name,
+    const TypePtr& type) {
+  for (auto i = 0; i < extraKeyNames_.size(); ++i) {
+    if (extraKeyNames_[i] == name) {
+      VELOX_CHECK(
+          extraKeyTypes_[i]->equivalent(*type),
+          "Type mismatch for Iceberg equality delete column {}: {} vs. {}",
+          name,
+          extraKeyTypes_[i]->toString(),
+          type->toString());
+      return readerOutputType_->size() + i;
+    }
+  }
+
+  const auto& fileType = baseReader_->rowType();
+  if (auto fileIdx = fileType->getChildIdxIfExists(name)) {
+    VELOX_CHECK(
+        fileType->childAt(*fileIdx)->equivalent(*type),
+        "Type mismatch for Iceberg equality delete column {}: {} vs. {}",
+        name,
+        fileType->childAt(*fileIdx)->toString(),
+        type->toString());
+  }
+
+  const column_index_t channel =
+      readerOutputType_->size() + extraKeyNames_.size();
+  if (auto* childSpec = scanSpec_->childByName(name)) {
+    // A filter-only column.
+    VELOX_CHECK(!childSpec->projectOut());
+    childSpec->setProjectOut(true);
+    childSpec->setChannel(channel);
+  } else {
+    scanSpec_->addFieldRecursively(name, *type, channel);
+    addedKeySpecs_.push_back(name);
+  }
+  extraKeyNames_.push_back(name);
+  extraKeyTypes_.push_back(type);
+  return channel;
+}
+
+std::optional<std::vector<variant>> IcebergSplitReader::aggregateFromMetadata(
+    const std::vector<MetadataAggregate>& aggregates) const {
+  // The data file statistics include the deleted rows.
+  if (!positionalDeleteFileReaders_.empty() || !equalityDeleteSets_.empty()) {
+    return std::nullopt;
+  }
+  return SplitReader::aggregateFromMetadata(aggregates);
+}
+
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
@@ -118,10 +251,76 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
     mutation.deletedRows = deleteBitmap_->as<uint64_t>();
   }
 
-  auto rowsScanned = baseRowReader_->next(size, output, &mutation);
-  baseReadOffset_ += rowsScanned;
+  if (equalityDeleteSets_.empty()) {
+    auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+    baseReadOffset_ += rowsScanned;
+    return rowsScanned;
+  }
 
+  // Read into a separate vector so that the dictionary wrapped result below is
+  // never passed back to the row reader.
+  if (!equalityDeleteInput_) {
+    equalityDeleteInput_ = BaseVector::create(
+        equalityDeleteInputType_, 0, connectorQueryCtx_->memoryPool());
+  }
+  auto rowsScanned =
+      baseRowReader_->next(size, equalityDeleteInput_, &mutation);
+  baseReadOffset_ += rowsScanned;
+  output = applyEqualityDeletes(equalityDeleteInput_);
   return rowsScanned;
 }
 
+VectorPtr IcebergSplitReader::applyEqualityDeletes(const VectorPtr& input) {
+  auto* pool = connectorQueryCtx_->memoryPool();
+  auto rowVector = std::dynamic_pointer_cast<RowVector>(input);
+  VELOX_CHECK_NOT_NULL(rowVector);
+
+  const auto numRows = rowVector->size();
+  vector_size_t numDeleted = 0;
+  if (numRows > 0) {
+    const auto numBytes = bits::nbytes(numRows);
+    dwio::common::ensureCapacity<int8_t>(
+        equalityDeleteBitmap_, numBytes, pool);
+    auto* deletedRows = equalityDeleteBitmap_->asMutable<uint64_t>();
+    std::memset(deletedRows, 0, numBytes);
+
+    std::vector<VectorPtr> keyColumns;
+    for (size_t i = 0; i < equalityDeleteSets_.size(); ++i) {
+      keyColumns.clear();
+      for (auto channel : equalityDeleteChannels_[i]) {
+        keyColumns.push_back(
+            BaseVector::loadedVectorShared(rowVector->childAt(channel)));
+      }
+      equalityDeleteSets_[i]->markDeleted(keyColumns, numRows, deletedRows);
+    }
+    numDeleted = bits::countBits(deletedRows, 0, numRows);
+  }
+
+  if (numDeleted == 0 && extraKeyNames_.empty()) {
+    return input;
+  }
+
+  // The extra delete columns are after the output columns and are dropped.
+  std::vector<VectorPtr> children(
+      rowVector->children().begin(),
+      rowVector->children().begin() + readerOutputType_->size());
+  const auto numRemaining = numRows - numDeleted;
+  if (numDeleted > 0) {
+    auto indices = allocateIndices(numRemaining, pool);
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    vector_size_t numPassed = 0;
+    bits::forEachUnsetBit(
+        equalityDeleteBitmap_->as<uint64_t>(),
+        0,
+        numRows,
+        [&](vector_size_t row) { rawIndices[numPassed++] = row; });
+    for (auto& child : children) {
+      child =
+          BaseVector::wrapInDictionary(nullptr, indices, numRemaining, child);
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool, readerOutputType_, nullptr, numRemaining, std::move(children));
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -39,7 +40,7 @@ class IcebergSplitReader : public SplitReader {
       folly::Executor* executor,
       const std::shared_ptr<common::ScanSpec>& scanSpec);
 
-  ~IcebergSplitReader() override = default;
+  ~IcebergSplitReader() override;
 
   void prepareSplit(
       std::shared_ptr<common::MetadataFilter> metadataFilter,
@@ -48,7 +49,23 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  std::optional<std::vector<variant>> aggregateFromMetadata(
+      const std::vector<MetadataAggregate>& aggregates) const override;
+
  private:
+  // Registers 'deleteSet' to be applied to the rows of this split.
+  void addEqualityDeleteSet(std::shared_ptr<const EqualityDeleteSet> deleteSet);
+
+  // Makes 'scanSpec_' read the delete column 'name' of 'type', which is not in
+  // 'readerOutputType_', and returns its channel.
+  column_index_t addExtraKeyColumn(
+      const std::string& name,
+      const TypePtr& type);
+
+  // Returns 'input' without the rows that match any of the equality delete
+  // sets and without the extra delete columns.
+  VectorPtr applyEqualityDeletes(const VectorPtr& input);
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -59,5 +76,24 @@ class IcebergSplitReader : public SplitReader {
   std::list<std::unique_ptr<PositionalDeleteFileReader>>
       positionalDeleteFileReaders_;
   BufferPtr deleteBitmap_;
+
+  // Deleted keys from the equality delete files of the split and, for each,
+  // the channels of the delete columns in 'equalityDeleteInputType_'.
+  std::vector<std::shared_ptr<const EqualityDeleteSet>> equalityDeleteSets_;
+  std::vector<std::vector<column_index_t>> equalityDeleteChannels_;
+  // Delete columns that are not in 'readerOutputType_', e.g. for count(*).
+  // They are read into the channels after the output columns and are not
+  // returned.
+  std::vector<std::string> extraKeyNames_;
+  std::vector<TypePtr> extraKeyTypes_;
+  // The subset of 'extraKeyNames_' that had no child in 'scanSpec_'. The
+  // children are removed when the split is done. The others are filter-only
+  // columns and are projected out for this split only.
+  std::vector<std::string> addedKeySpecs_;
+  // 'readerOutputType_' followed by the extra delete columns.
+  RowTypePtr equalityDeleteInputType_;
+  // Base file rows before equality deletes are applied.
+  VectorPtr equalityDeleteInput_;
+  BufferPtr equalityDeleteBitmap_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
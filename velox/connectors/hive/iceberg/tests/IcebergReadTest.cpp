@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -92,6 +95,90 @@ class HiveIcebergTest : public HiveConnectorTestBase {
         makeNotInList(deleteRowsVec) + ")";
   }
 
+  // Reads 'splitCount' base files that all share one equality delete file on
+  // c0 containing 'deleteValues'.
+  void assertEqualityDeletes(
+      const std::vector<int64_t>& deleteValues,
+      int32_t splitCount = 1) {
+    std::string duckdbSql = deleteValues.empty()
+        ? "SELECT * FROM tmp"
+        : getQuery({deleteValues});
+    assertEqualityDeletes(deleteValues, splitCount, tableScanNode(), duckdbSql);
+  }
+
+  // Returns a count(*) over a scan that returns no columns and has
+  // 'subfieldFilters'.
+  core::PlanNodePtr countStarNode(
+      const std::vector<std::string>& subfieldFilters = {}) {
+    return PlanBuilder(pool_.get())
+        .tableScan(ROW({}, {}), subfieldFilters, "", rowType_)
+        .singleAggregation({}, {"count(*)"})
+        .planNode();
+  }
+
+  // Reads a base file with an equality delete file that has more columns than
+  // equality field ids and no field ids.
+  void assertUnresolvedEqualityFieldIds() {
+    EqualityDeleteFileReader::clearCache();
+    auto dataFilePaths = writeDataFile(1, rowCount);
+
+    auto deleteFilePath = TempFilePath::create();
+    writeToFile(
+        deleteFilePath->getPath(),
+        makeRowVector(
+            {"c0", "c1"},
+            {makeFlatVector<int64_t>({1, 2}),
+             makeFlatVector<int64_t>({3, 4})}));
+    auto path = deleteFilePath->getPath();
+    IcebergDeleteFile deleteFile(
+        FileContent::kEqualityDeletes,
+        path,
+        fileFomat_,
+        2,
+        testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+        {1});
+
+    VELOX_ASSERT_THROW(
+        AssertQueryBuilder(tableScanNode())
+            .split(makeIcebergSplit(dataFilePaths[0]->getPath(), {deleteFile}))
+            .copyResults(pool()),
+        "no field ids to resolve them");
+  }
+
+  // Same as above but runs 'plan' over the base files.
+  void assertEqualityDeletes(
+      const std::vector<int64_t>& deleteValues,
+      int32_t splitCount,
+      const core::PlanNodePtr& plan,
+      const std::string& duckdbSql) {
+    EqualityDeleteFileReader::clearCache();
+    auto dataFilePaths = writeDataFile(splitCount, rowCount);
+
+    auto deleteFilePath = TempFilePath::create();
+    writeToFile(
+        deleteFilePath->getPath(),
+        makeRowVector({"c0"}, {makeFlatVector<int64_t>(deleteValues)}));
+    auto path = deleteFilePath->getPath();
+    IcebergDeleteFile deleteFile(
+        FileContent::kEqualityDeletes,
+        path,
+        fileFomat_,
+        deleteValues.size(),
+        testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+        {1});
+
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    for (const auto& dataFilePath : dataFilePaths) {
+      splits.emplace_back(
+          makeIcebergSplit(dataFilePath->getPath(), {deleteFile}));
+    }
+
+    HiveConnectorTestBase::assertQuery(plan, splits, duckdbSql);
+    ASSERT_EQ(
+        EqualityDeleteFileReader::cacheSize(), deleteValues.empty() ? 0 : 1);
+    EqualityDeleteFileReader::clearCache();
+  }
+
   const static int rowCount = 20000;
 
  private:
@@ -347,4 +434,55 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
       deletedRows, getQuery(deletedRows), splitCount, numPrefetchSplits);
 }
 
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  // Small key range, looked up in a bitmap.
+  assertEqualityDeletes({0, 1, 2, 3});
+  assertEqualityDeletes({0, 9999, 10000, 19999});
+  assertEqualityDeletes(makeRandomDeleteRows(rowCount));
+  // Keys that don't exist in the base file.
+  assertEqualityDeletes({-5, 20000, 29999});
+  // Large key range, looked up by hash.
+  assertEqualityDeletes({-1'000'000'000, 10, 10002, 1'000'000'000});
+  // Delete all rows.
+  assertEqualityDeletes(makeSequenceRows(rowCount));
+  // Empty delete file.
+  assertEqualityDeletes({});
+}
+
+// All splits share the same equality delete file, which is read only once.
+TEST_F(HiveIcebergTest, equalityDeletesMultipleSplits) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  assertEqualityDeletes({1, 2, 3, 4, 10000}, 10);
+}
+
+// The delete column is read for the equality deletes but not returned by the
+// scan.
+TEST_F(HiveIcebergTest, equalityDeletesOnNonOutputColumn) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  const std::vector<int64_t> deleteValues = {0, 1, 2, 10000, 19999};
+  const auto query = getQuery({deleteValues});
+
+  assertEqualityDeletes(
+      deleteValues,
+      3,
+      countStarNode(),
+      "SELECT count(*) FROM (" + query + ")");
+
+  // A filter-only delete column.
+  assertEqualityDeletes(
+      deleteValues,
+      3,
+      countStarNode({"c0 > 5"}),
+      "SELECT count(*) FROM (" + query + " AND c0 > 5)");
+}
+
+// A delete file with more columns than equality field ids can only be read if
+// the file has field ids.
+TEST_F(HiveIcebergTest, equalityDeleteFileWithoutFieldIds) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  assertUnresolvedEqualityFieldIds();
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
@@ -17,8 +17,12 @@
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsFileSystem.h"
 
 #include <azure/storage/blobs/blob_client.hpp>
+#include <azure/storage/blobs/blob_container_client.hpp>
 #include <fmt/format.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <glog/logging.h>
 
 #include "velox/common/file/File.h"
@@ -43,6 +47,11 @@ class AbfsConfig {
     return abfsAccount.connectionString(config_->get(key).value());
   }
 
+  uint32_t readThreads() const {
+    return config_->get<uint32_t>(
+        connector::hive::HiveConfig::kAbfsReadThreads, 0);
+  }
+
  private:
   const Config* config_;
 };
@@ -60,6 +69,17 @@ class AbfsReadFile::Impl {
             connectStr, abfsAccount.fileSystem(), fileName_));
   }
 
+  Impl(
+      const std::string& path,
+      const BlobContainerClient& containerClient,
+      std::shared_ptr<folly::Executor> executor)
+      : executor_(std::move(executor)) {
+    auto abfsAccount = AbfsAccount(path);
+    fileName_ = abfsAccount.filePath();
+    fileClient_ =
+        std::make_unique<BlobClient>(containerClient.GetBlobClient(fileName_));
+  }
+
   void initialize(const FileOptions& options) {
     if (options.fileSize.has_value()) {
       VELOX_CHECK_GE(
@@ -96,20 +116,22 @@ class AbfsReadFile::Impl {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const {
     size_t length = 0;
-    auto size = buffers.size();
+    size_t maxGap = 0;
     for (auto& range : buffers) {
       length += range.size();
+      if (!range.data()) {
+        maxGap = std::max(maxGap, range.size());
+      }
     }
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
+    // Reads the ranges from the response directly and the gaps into a scratch
+    // buffer.
+    auto response = download(offset, length);
+    std::string gap(maxGap, 0);
     for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
+      auto* position = range.data() ? range.data() : gap.data();
+      response.Value.BodyStream->ReadToCount(
+          reinterpret_cast<uint8_t*>(position), range.size());
     }
-
     return length;
   }
 
@@ -117,15 +139,54 @@ class AbfsReadFile::Impl {
       folly::Range<const common::Region*> regions,
       folly::Range<folly::IOBuf*> iobufs) const {
     VELOX_CHECK_EQ(regions.size(), iobufs.size());
+    if (executor_ == nullptr || regions.size() <= 1) {
+      for (size_t i = 0; i < regions.size(); ++i) {
+        const auto& region = regions[i];
+        auto& output = iobufs[i];
+        output = folly::IOBuf(folly::IOBuf::CREATE, region.length);
+        pread(region.offset, region.length, output.writableData());
+        output.append(region.length);
+      }
+      return;
+    }
+    // Reads the regions in parallel.
+    std::vector<folly::Future<folly::Unit>> reads;
+    reads.reserve(regions.size());
     for (size_t i = 0; i < regions.size(); ++i) {
       const auto& region = regions[i];
       auto& output = iobufs[i];
       output = folly::IOBuf(folly::IOBuf::CREATE, region.length);
-      pread(region.offset, region.length, output.writableData());
       output.append(region.length);
+      reads.push_back(folly::via(executor_.get(), [this, region, &output]() {
+        preadInternal(
+            region.offset,
+            region.length,
+            reinterpret_cast<char*>(output.writableData()));
+      }));
+    }
+    for (auto& result : folly::collectAll(std::move(reads)).get()) {
+      result.throwUnlessValue();
     }
   }
 
+  // Runs preadv on 'executor_'. 'self' keeps this alive until the read is
+  // done.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      std::shared_ptr<const Impl> self,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const {
+    return folly::via(
+               executor_.get(),
+               [self = std::move(self), offset, buffers]() {
+                 return self->preadv(offset, buffers);
+               })
+        .semi();
+  }
+
+  bool hasPreadvAsync() const {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const {
     return length_;
   }
@@ -147,7 +208,9 @@ class AbfsReadFile::Impl {
   }
 
  private:
-  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+  Azure::Response<Models::DownloadBlobResult> download(
+      uint64_t offset,
+      uint64_t length) const {
     // Read the desired range of bytes.
     Azure::Core::Http::HttpRange range;
     range.Offset = offset;
@@ -156,13 +219,19 @@ class AbfsReadFile::Impl {
     Azure::Storage::Blobs::DownloadBlobOptions blob;
     blob.Range = range;
 
-    auto response = fileClient_->Download(blob);
+    return fileClient_->Download(blob);
+  }
+
+  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    auto response = download(offset, length);
     response.Value.BodyStream->ReadToCount(
         reinterpret_cast<uint8_t*>(position), length);
   }
 
   std::string fileName_;
   std::unique_ptr<BlobClient> fileClient_;
+  // Runs the asynchronous reads. nullptr if reads are synchronous.
+  const std::shared_ptr<folly::Executor> executor_;
 
   int64_t length_ = -1;
 };
@@ -173,6 +242,13 @@ AbfsReadFile::AbfsReadFile(
   impl_ = std::make_shared<Impl>(path, connectStr);
 }
 
+AbfsReadFile::AbfsReadFile(
+    const std::string& path,
+    const BlobContainerClient& containerClient,
+    std::shared_ptr<folly::Executor> executor) {
+  impl_ = std::make_shared<Impl>(path, containerClient, std::move(executor));
+}
+
 void AbfsReadFile::initialize(const FileOptions& options) {
   return impl_->initialize(options);
 }
@@ -198,6 +274,19 @@ void AbfsReadFile::preadv(
   return impl_->preadv(regions, iobufs);
 }
 
+folly::SemiFuture<uint64_t> AbfsReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (!impl_->hasPreadvAsync()) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  return impl_->preadvAsync(impl_, offset, buffers);
+}
+
+bool AbfsReadFile::hasPreadvAsync() const {
+  return impl_->hasPreadvAsync();
+}
+
 uint64_t AbfsReadFile::size() const {
   return impl_->size();
 }
@@ -222,6 +311,11 @@ class AbfsFileSystem::Impl {
  public:
   explicit Impl(const Config* config) : abfsConfig_(config) {
     LOG(INFO) << "Init Azure Blob file system";
+    if (const auto readThreads = abfsConfig_.readThreads(); readThreads > 0) {
+      ioExecutor_ = std::make_shared<folly::IOThreadPoolExecutor>(
+          readThreads,
+          std::make_shared<folly::NamedThreadFactory>("AbfsRead"));
+    }
   }
 
   ~Impl() {
@@ -233,9 +327,37 @@ class AbfsFileSystem::Impl {
     return abfsConfig_.connectionString(path);
   }
 
+  // Returns the client of the container of 'path'. The files of a container
+  // share the HTTP pipeline of its client and thus its connections.
+  std::shared_ptr<BlobContainerClient> containerClient(
+      const std::string& path) {
+    auto abfsAccount = AbfsAccount(path);
+    auto connectStr = connectionString(path);
+    auto key = fmt::format("{}\n{}", connectStr, abfsAccount.fileSystem());
+    auto clients = containerClients_.wlock();
+    auto it = clients->find(key);
+    if (it == clients->end()) {
+      it = clients
+               ->emplace(
+                   key,
+                   std::make_shared<BlobContainerClient>(
+                       BlobContainerClient::CreateFromConnectionString(
+                           connectStr, abfsAccount.fileSystem())))
+               .first;
+    }
+    return it->second;
+  }
+
+  std::shared_ptr<folly::Executor> ioExecutor() const {
+    return ioExecutor_;
+  }
+
  private:
   const AbfsConfig abfsConfig_;
   std::shared_ptr<folly::Executor> ioExecutor_;
+  folly::Synchronized<
+      folly::F14FastMap<std::string, std::shared_ptr<BlobContainerClient>>>
+      containerClients_;
 };
 
 AbfsFileSystem::AbfsFileSystem(const std::shared_ptr<const Config>& config)
@@ -250,8 +372,9 @@ std::string AbfsFileSystem::name() const {
 std::unique_ptr<ReadFile> AbfsFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
+  const std::string file(path);
   auto abfsfile = std::make_unique<AbfsReadFile>(
-      std::string(path), impl_->connectionString(std::string(path)));
+      file, *impl_->containerClient(file), impl_->ioExecutor());
   abfsfile->initialize(options);
   return abfsfile;
 }
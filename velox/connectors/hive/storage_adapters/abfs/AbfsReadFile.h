@@ -19,11 +19,23 @@
 #include "velox/common/file/File.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsUtil.h"
 
+namespace Azure::Storage::Blobs {
+class BlobContainerClient;
+}
+
 namespace facebook::velox::filesystems::abfs {
 class AbfsReadFile final : public ReadFile {
  public:
   explicit AbfsReadFile(const std::string& path, const std::string& connectStr);
 
+  /// Reads 'path' through the HTTP pipeline of 'containerClient', which is
+  /// shared with the other files of the container. If 'executor' is set,
+  /// preadvAsync runs on it and the regions of preadv are read in parallel.
+  AbfsReadFile(
+      const std::string& path,
+      const Azure::Storage::Blobs::BlobContainerClient& containerClient,
+      std::shared_ptr<folly::Executor> executor);
+
   void initialize(const FileOptions& options);
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buf)
@@ -39,6 +51,12 @@ class AbfsReadFile final : public ReadFile {
       folly::Range<const common::Region*> regions,
       folly::Range<folly::IOBuf*> iobufs) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
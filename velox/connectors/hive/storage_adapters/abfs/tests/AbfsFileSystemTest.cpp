@@ -246,6 +246,31 @@ TEST_F(AbfsFileSystemTest, multipleThreadsWithReadFile) {
   }
 }
 
+TEST_F(AbfsFileSystemTest, readFileAsync) {
+  auto hiveConfig = AbfsFileSystemTest::hiveConfig(
+      {{"fs.azure.account.key.test.dfs.core.windows.net",
+        azuriteServer->connectionStr()},
+       {"hive.abfs.read-threads", "4"}});
+  AbfsFileSystem abfs{hiveConfig};
+  auto readFile = abfs.openFileForRead(fullFilePath);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+
+  char buff1[10];
+  char buff2[10];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(buff1, 10),
+      folly::Range<char*>(nullptr, kOneMB - 5),
+      folly::Range<char*>(buff2, 10)};
+  ASSERT_EQ(readFile->preadvAsync(0, buffers).get(), 10 + kOneMB - 5 + 10);
+  ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), "aaaaabbbbb");
+  ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), "cccccddddd");
+
+  // Files of the same container share the container client.
+  auto otherFile = abfs.openFileForRead(fullFilePath);
+  readData(otherFile.get());
+}
+
 TEST_F(AbfsFileSystemTest, missingFile) {
   auto hiveConfig = AbfsFileSystemTest::hiveConfig(
       {{"fs.azure.account.key.test.dfs.core.windows.net",
@@ -23,6 +23,9 @@
 #include "velox/core/QueryConfig.h"
 
 #include <fmt/format.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -65,8 +68,12 @@ inline void checkGCSStatus(
 
 class GCSReadFile final : public ReadFile {
  public:
-  GCSReadFile(const std::string& path, std::shared_ptr<gcs::Client> client)
-      : client_(std::move(client)) {
+  // 'executor' runs the asynchronous reads. If nullptr, reads are synchronous.
+  GCSReadFile(
+      const std::string& path,
+      std::shared_ptr<gcs::Client> client,
+      std::shared_ptr<folly::Executor> executor = nullptr)
+      : client_(std::move(client)), executor_(std::move(executor)) {
     // assumption it's a proper path
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
   }
@@ -121,18 +128,68 @@ class GCSReadFile final : public ReadFile {
     for (const auto range : buffers) {
       length += range.size();
     }
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
+    gcs::ObjectReadStream stream = openStream(offset, length);
     for (auto range : buffers) {
       if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
+        stream.read(range.data(), range.size());
+      } else {
+        stream.ignore(range.size());
+      }
+      if (!stream) {
+        checkGCSStatus(
+            stream.status(), "Failed to get read object", bucket_, key_);
       }
-      resultOffset += range.size();
     }
+    bytesRead_ += length;
     return length;
   }
 
+  // Reads the regions in parallel on 'executor_' if set.
+  void preadv(
+      folly::Range<const common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs) const override {
+    if (executor_ == nullptr || regions.size() <= 1) {
+      ReadFile::preadv(regions, iobufs);
+      return;
+    }
+    VELOX_CHECK_EQ(regions.size(), iobufs.size());
+    std::vector<folly::Future<folly::Unit>> reads;
+    reads.reserve(regions.size());
+    for (size_t i = 0; i < regions.size(); ++i) {
+      const auto& region = regions[i];
+      auto& output = iobufs[i];
+      output = folly::IOBuf(folly::IOBuf::CREATE, region.length);
+      output.append(region.length);
+      reads.push_back(folly::via(executor_.get(), [this, region, &output]() {
+        preadInternal(
+            region.offset,
+            region.length,
+            reinterpret_cast<char*>(output.writableData()));
+      }));
+    }
+    for (auto& result : folly::collectAll(std::move(reads)).get()) {
+      result.throwUnlessValue();
+    }
+  }
+
+  // Runs preadv on 'executor_'. The file must stay alive until the returned
+  // future is complete.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (executor_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    return folly::via(
+               executor_.get(),
+               [this, offset, buffers]() { return preadv(offset, buffers); })
+        .semi();
+  }
+
+  bool hasPreadvAsync() const override {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -159,22 +216,27 @@ class GCSReadFile final : public ReadFile {
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    gcs::ObjectReadStream stream = client_->ReadObject(
-        bucket_, key_, gcs::ReadRange(offset, offset + length));
+    gcs::ObjectReadStream stream = openStream(offset, length);
+    stream.read(position, length);
     if (!stream) {
       checkGCSStatus(
-          stream.status(), "Failed to get GCS object", bucket_, key_);
+          stream.status(), "Failed to get read object", bucket_, key_);
     }
+    bytesRead_ += length;
+  }
 
-    stream.read(position, length);
+  gcs::ObjectReadStream openStream(uint64_t offset, uint64_t length) const {
+    gcs::ObjectReadStream stream = client_->ReadObject(
+        bucket_, key_, gcs::ReadRange(offset, offset + length));
     if (!stream) {
       checkGCSStatus(
-          stream.status(), "Failed to get read object", bucket_, key_);
+          stream.status(), "Failed to get GCS object", bucket_, key_);
     }
-    bytesRead_ += length;
+    return stream;
   }
 
   std::shared_ptr<gcs::Client> client_;
+  const std::shared_ptr<folly::Executor> executor_;
   std::string bucket_;
   std::string key_;
   std::atomic<int64_t> length_ = -1;
@@ -290,6 +352,19 @@ class GCSFileSystem::Impl {
           gcs::LimitedTimeRetryPolicy(retry_time).clone());
     }
 
+    const auto readThreads = hiveConfig_->gcsReadThreads();
+    const auto maxConnections = hiveConfig_->gcsMaxConnections();
+    if (maxConnections.has_value()) {
+      options.set<gcs::ConnectionPoolSizeOption>(maxConnections.value());
+    } else if (readThreads > 0) {
+      options.set<gcs::ConnectionPoolSizeOption>(readThreads);
+    }
+    if (readThreads > 0 && executor_ == nullptr) {
+      executor_ = std::make_shared<folly::IOThreadPoolExecutor>(
+          readThreads,
+          std::make_shared<folly::NamedThreadFactory>("GCSRead"));
+    }
+
     auto endpointOverride = hiveConfig_->gcsEndpoint();
     if (!endpointOverride.empty()) {
       options.set<gcs::RestEndpointOption>(scheme + "://" + endpointOverride);
@@ -310,9 +385,16 @@ class GCSFileSystem::Impl {
     return client_;
   }
 
+  // Runs the asynchronous reads of the files. nullptr if reads are
+  // synchronous.
+  std::shared_ptr<folly::Executor> getExecutor() const {
+    return executor_;
+  }
+
  private:
   const std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<gcs::Client> client_;
+  std::shared_ptr<folly::IOThreadPoolExecutor> executor_;
 };
 
 GCSFileSystem::GCSFileSystem(std::shared_ptr<const Config> config)
@@ -328,7 +410,8 @@ std::unique_ptr<ReadFile> GCSFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSReadFile>(gcspath, impl_->getClient());
+  auto gcsfile = std::make_unique<GCSReadFile>(
+      gcspath, impl_->getClient(), impl_->getExecutor());
   gcsfile->initialize(options);
   return gcsfile;
 }
@@ -211,6 +211,42 @@ TEST_F(GCSFileSystemTest, readFile) {
   ASSERT_EQ(std::string_view(buff3, sizeof(buff3)), kLoremIpsum.substr(80, 30));
 }
 
+TEST_F(GCSFileSystemTest, readFileAsync) {
+  const std::string gcsFile =
+      gcsURI(preexistingBucketName(), preexistingObjectName());
+  std::unordered_map<std::string, std::string> config(
+      testGcsOptions()->values());
+  config["hive.gcs.read-threads"] = "4";
+  filesystems::GCSFileSystem gcfs(
+      std::make_shared<const core::MemConfig>(std::move(config)));
+  gcfs.initializeClient();
+  auto readFile = gcfs.openFileForRead(gcsFile);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+
+  char buff1[10];
+  char buff2[20];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(buff1, 10),
+      folly::Range<char*>(nullptr, 20),
+      folly::Range<char*>(buff2, 20)};
+  ASSERT_EQ(readFile->preadvAsync(5, buffers).get(), 10 + 20 + 20);
+  ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), kLoremIpsum.substr(5, 10));
+  ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), kLoremIpsum.substr(35, 20));
+
+  // The regions are read in parallel.
+  std::vector<common::Region> regions = {{0, 10}, {100, 20}, {50, 5}};
+  std::vector<folly::IOBuf> iobufs(regions.size());
+  readFile->preadv(
+      {regions.data(), regions.size()}, {iobufs.data(), iobufs.size()});
+  for (auto i = 0; i < regions.size(); ++i) {
+    ASSERT_EQ(
+        std::string_view(
+            reinterpret_cast<const char*>(iobufs[i].data()),
+            iobufs[i].length()),
+        kLoremIpsum.substr(regions[i].offset, regions[i].length));
+  }
+}
+
 TEST_F(GCSFileSystemTest, writeAndReadFile) {
   const std::string newFile = "readWriteFile.txt";
   const std::string gcsFile = gcsURI(preexistingBucketName(), newFile);
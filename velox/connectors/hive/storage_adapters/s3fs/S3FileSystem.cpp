@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 #include "velox/common/file/File.h"
+#include "velox/common/io/IoStatistics.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
@@ -25,11 +26,15 @@
 
 #include <fmt/format.h>
 #include <glog/logging.h>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <memory>
 #include <stdexcept>
 
 #include <aws/core/Aws.h>
 #include <aws/core/auth/AWSCredentialsProviderChain.h>
+#include <aws/core/http/HttpRequest.h>
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/utils/logging/ConsoleLogSystem.h>
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
@@ -70,11 +75,44 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// Like AwsWriteableStreamFactory but keeps 'buffer' live for the duration of
+// the request. Used for hedged requests that may complete after the read that
+// issued them has returned.
+Aws::IOStreamFactory AwsOwnedStreamFactory(
+    std::shared_ptr<std::string> buffer) {
+  return [buffer = std::move(buffer)]() {
+    return Aws::New<StringViewStream>("", buffer->data(), buffer->size());
+  };
+}
+
+uint64_t nowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Read settings shared by the files of a S3FileSystem.
+struct S3ReadOptions {
+  // See HiveConfig::kS3ReadPartSize.
+  uint64_t partSize{0};
+  // See HiveConfig::kS3HedgedReadPercentile.
+  double hedgePercentile{0};
+  // See HiveConfig::kS3HedgedReadMinDelayMs.
+  uint64_t hedgeMinDelayMicros{0};
+  // Latencies of completed GETs of the file system.
+  std::shared_ptr<io::LatencyHistogram> latencies;
+  // Number of GETs sent because the first GET of a range was slow.
+  std::shared_ptr<std::atomic<uint64_t>> numHedgedReads;
+};
+
 // TODO: Implement retry on failure.
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      S3ReadOptions readOptions = {})
+      : client_(client), readOptions_(std::move(readOptions)) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -165,25 +203,205 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
-  // The assumption here is that "position" has space for at least "length"
-  // bytes.
-  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    // Read the desired range of bytes.
-    Aws::S3::Model::GetObjectRequest request;
-    Aws::S3::Model::GetObjectResult result;
+  // Number of latencies recorded before reads are hedged.
+  static constexpr uint64_t kMinHedgeSamples = 100;
+
+  // An in-flight ranged GET.
+  struct PendingGet {
+    uint64_t offset;
+    uint64_t length;
+    char* position;
+    uint64_t startMicros;
+    // Receives the data of a hedged read. nullptr if the GET writes to
+    // 'position' directly.
+    std::shared_ptr<std::string> buffer;
+    // Set to abort the transfer. Checked by the SDK while the GET runs.
+    std::shared_ptr<std::atomic_bool> cancelled;
+    Aws::S3::Model::GetObjectOutcomeCallable outcome;
+  };
 
+  Aws::S3::Model::GetObjectRequest makeRequest(
+      uint64_t offset,
+      uint64_t length) const {
+    Aws::S3::Model::GetObjectRequest request;
     request.SetBucket(awsString(bucket_));
     request.SetKey(awsString(key_));
     std::stringstream ss;
     ss << "bytes=" << offset << "-" << offset + length - 1;
     request.SetRange(awsString(ss.str()));
-    request.SetResponseStreamFactory(
-        AwsWriteableStreamFactory(position, length));
-    auto outcome = client_->GetObject(request);
+    return request;
+  }
+
+  // Starts a GET of 'length' bytes at 'offset'. If 'owned' is true, reads into
+  // a buffer owned by the request. Otherwise reads into 'position'.
+  PendingGet startGet(
+      uint64_t offset,
+      uint64_t length,
+      char* position,
+      bool owned) const {
+    PendingGet get{
+        offset,
+        length,
+        position,
+        nowMicros(),
+        nullptr,
+        std::make_shared<std::atomic_bool>(false),
+        {}};
+    auto request = makeRequest(offset, length);
+    if (owned) {
+      get.buffer = std::make_shared<std::string>(length, 0);
+      request.SetResponseStreamFactory(AwsOwnedStreamFactory(get.buffer));
+    } else {
+      request.SetResponseStreamFactory(
+          AwsWriteableStreamFactory(position, length));
+    }
+    request.SetContinueRequestHandler(
+        [cancelled = get.cancelled](const Aws::Http::HttpRequest*) {
+          return !cancelled->load();
+        });
+    get.outcome = client_->GetObjectCallable(request);
+    return get;
+  }
+
+  // Returns how long a GET is waited for before it is hedged or std::nullopt
+  // if reads are not hedged.
+  std::optional<uint64_t> hedgeDelayMicros() const {
+    if (readOptions_.hedgePercentile <= 0 || !readOptions_.latencies ||
+        readOptions_.latencies->count() < kMinHedgeSamples) {
+      return std::nullopt;
+    }
+    return std::max(
+        readOptions_.hedgeMinDelayMicros,
+        readOptions_.latencies->percentile(readOptions_.hedgePercentile));
+  }
+
+  void recordLatency(uint64_t startMicros) const {
+    if (readOptions_.latencies) {
+      readOptions_.latencies->record(nowMicros() - startMicros);
+    }
+  }
+
+  // Waits for 'get' and throws if it failed. Copies the data of a GET into
+  // an owned buffer to its position.
+  void completeGet(PendingGet& get) const {
+    auto outcome = get.outcome.get();
     VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+    recordLatency(get.startMicros);
+    if (get.buffer) {
+      memcpy(get.position, get.buffer->data(), get.length);
+    }
+  }
+
+  // Waits for 'get'. If it takes longer than 'hedgeDelay', sends a second GET
+  // for the same range and uses the first response to arrive.
+  void finishGet(PendingGet& get, std::optional<uint64_t> hedgeDelay) const {
+    if (hedgeDelay.has_value()) {
+      const auto waited = nowMicros() - get.startMicros;
+      if (waited >= *hedgeDelay ||
+          get.outcome.wait_for(std::chrono::microseconds(
+              *hedgeDelay - waited)) != std::future_status::ready) {
+        finishHedged(get);
+        return;
+      }
+    }
+    completeGet(get);
+  }
+
+  // Sends a second GET for the range of the slow 'get' into a buffer of its
+  // own and uses the first successful response. 'get' writes into its
+  // position directly, so the data is copied only if the second GET wins.
+  // The losing GET is cancelled.
+  void finishHedged(PendingGet& get) const {
+    ++*readOptions_.numHedgedReads;
+    auto hedge = startGet(get.offset, get.length, get.position, true);
+    constexpr auto kPollInterval = std::chrono::milliseconds(1);
+    for (;;) {
+      if (get.outcome.wait_for(kPollInterval) == std::future_status::ready) {
+        auto outcome = get.outcome.get();
+        if (outcome.IsSuccess()) {
+          recordLatency(get.startMicros);
+          // The hedged GET reads into its own buffer and is not waited for.
+          hedge.cancelled->store(true);
+          return;
+        }
+        // The hedged GET may still succeed.
+        completeGet(hedge);
+        return;
+      }
+      if (hedge.outcome.wait_for(std::chrono::milliseconds(0)) ==
+          std::future_status::ready) {
+        auto outcome = hedge.outcome.get();
+        if (outcome.IsSuccess()) {
+          recordLatency(hedge.startMicros);
+          // Stops the first GET from writing into its position before the
+          // data of the hedged GET is copied there.
+          get.cancelled->store(true);
+          get.outcome.wait();
+          memcpy(get.position, hedge.buffer->data(), get.length);
+          return;
+        }
+        // The first GET may still succeed.
+        completeGet(get);
+        return;
+      }
+    }
+  }
+
+  // Cancels the GETs of 'gets' that are still in flight and waits for them
+  // to end. The GETs write into the buffer of the read, which the caller may
+  // free once the read throws.
+  static void cancelGets(std::vector<PendingGet>& gets) {
+    for (auto& get : gets) {
+      if (get.outcome.valid()) {
+        get.cancelled->store(true);
+      }
+    }
+    for (auto& get : gets) {
+      if (get.outcome.valid()) {
+        get.outcome.wait();
+      }
+    }
+  }
+
+  // The assumption here is that "position" has space for at least "length"
+  // bytes. Splits reads longer than 'readOptions_.partSize' into parts read
+  // in parallel.
+  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    const auto hedgeDelay = hedgeDelayMicros();
+    const auto partSize = readOptions_.partSize;
+    if (!hedgeDelay.has_value() && (partSize == 0 || length <= partSize)) {
+      // Read the desired range of bytes.
+      auto request = makeRequest(offset, length);
+      request.SetResponseStreamFactory(
+          AwsWriteableStreamFactory(position, length));
+      const auto startMicros = nowMicros();
+      auto outcome = client_->GetObject(request);
+      VELOX_CHECK_AWS_OUTCOME(
+          outcome, "Failed to get S3 object", bucket_, key_);
+      recordLatency(startMicros);
+      return;
+    }
+    const auto step = partSize == 0 ? length : partSize;
+    std::vector<PendingGet> gets;
+    try {
+      for (uint64_t partOffset = 0; partOffset < length; partOffset += step) {
+        gets.push_back(startGet(
+            offset + partOffset,
+            std::min(step, length - partOffset),
+            position + partOffset,
+            false));
+      }
+      for (auto& get : gets) {
+        finishGet(get, hedgeDelay);
+      }
+    } catch (...) {
+      cancelGets(gets);
+      throw;
+    }
   }
 
   Aws::S3::S3Client* client_;
+  const S3ReadOptions readOptions_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -569,6 +787,13 @@ class S3FileSystem::Impl {
         clientConfig,
         Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
         hiveConfig_->s3UseVirtualAddressing());
+
+    readOptions_.partSize = hiveConfig_->s3ReadPartSize();
+    readOptions_.hedgePercentile = hiveConfig_->s3HedgedReadPercentile();
+    readOptions_.hedgeMinDelayMicros =
+        hiveConfig_->s3HedgedReadMinDelayMs() * 1000UL;
+    readOptions_.latencies = std::make_shared<io::LatencyHistogram>();
+    readOptions_.numHedgedReads = std::make_shared<std::atomic<uint64_t>>(0);
     ++fileSystemCount;
   }
 
@@ -651,9 +876,14 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  const S3ReadOptions& readOptions() const {
+    return readOptions_;
+  }
+
  private:
   std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  S3ReadOptions readOptions_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -665,11 +895,16 @@ std::string S3FileSystem::getLogLevelName() const {
   return impl_->getLogLevelName();
 }
 
+uint64_t S3FileSystem::numHedgedReads() const {
+  return *impl_->readOptions().numHedgedReads;
+}
+
 std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file, impl_->s3Client(), impl_->readOptions());
   s3file->initialize(options);
   return s3file;
 }
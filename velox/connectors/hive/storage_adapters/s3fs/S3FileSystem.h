@@ -72,6 +72,10 @@ class S3FileSystem : public FileSystem {
 
   std::string getLogLevelName() const;
 
+  /// Number of GETs sent because the first GET of a range took longer than
+  /// the hedging threshold. See HiveConfig::kS3HedgedReadPercentile.
+  uint64_t numHedgedReads() const;
+
  protected:
   class Impl;
   std::shared_ptr<Impl> impl_;
@@ -60,6 +60,55 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelPartsAndHedgedReads) {
+  const char* bucketName = "parts";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  {
+    auto hiveConfig =
+        minioServer_->hiveConfig({{"hive.s3.read-part-size", "65536"}});
+    filesystems::S3FileSystem s3fs(hiveConfig);
+    auto readFile = s3fs.openFileForRead(s3File);
+    readData(readFile.get());
+    ASSERT_EQ(s3fs.numHedgedReads(), 0);
+  }
+  {
+    // Hedges every read that is slower than the median after the first 100.
+    auto hiveConfig = minioServer_->hiveConfig(
+        {{"hive.s3.read-part-size", "65536"},
+         {"hive.s3.hedged-read-percentile", "50"},
+         {"hive.s3.hedged-read-min-delay-ms", "0"}});
+    filesystems::S3FileSystem s3fs(hiveConfig);
+    auto readFile = s3fs.openFileForRead(s3File);
+    for (auto i = 0; i < 100; ++i) {
+      ASSERT_EQ(readFile->pread(0, 10), "aaaaabbbbb");
+    }
+    for (auto i = 0; i < 10; ++i) {
+      readData(readFile.get());
+    }
+  }
+  {
+    // The parts past the end of the file fail. The read throws only after
+    // the parts still in flight have stopped writing into the buffer.
+    auto hiveConfig =
+        minioServer_->hiveConfig({{"hive.s3.read-part-size", "65536"}});
+    filesystems::S3FileSystem s3fs(hiveConfig);
+    auto readFile = s3fs.openFileForRead(s3File);
+    const auto length = readFile->size() + 16 * 65536;
+    for (auto i = 0; i < 10; ++i) {
+      auto buffer = std::make_unique<char[]>(length);
+      VELOX_ASSERT_THROW(
+          readFile->pread(0, length, buffer.get()), "Failed to get S3 object");
+    }
+  }
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     const std::unordered_map<std::string, std::string> config(
@@ -15,6 +15,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <thread>
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
 #include "velox/common/base/tests/GTestUtils.h"
@@ -463,6 +464,35 @@ TEST_F(HiveConnectorTest, makeScanSpec_prunedMapNonNullMapKey) {
   ASSERT_TRUE(c0->childByName("c0c0")->isConstant());
 }
 
+TEST_F(HiveConnectorTest, addFilterResetsSelectivity) {
+  auto rowType = ROW({{"c0", BIGINT()}, {"c1", BIGINT()}});
+  SubfieldFilters filters;
+  filters.emplace(Subfield("c0"), std::make_unique<BigintRange>(0, 100, false));
+  filters.emplace(Subfield("c1"), std::make_unique<BigintRange>(0, 100, false));
+  auto scanSpec =
+      makeScanSpec(rowType, {}, filters, nullptr, {}, {}, nullptr, pool_.get());
+  scanSpec->newRead();
+
+  // Records 'numIn' rows of which 'numOut' pass, taking at least 1ms.
+  auto recordSelectivity = [](ScanSpec& spec, int numIn, int numOut) {
+    SelectivityTimer timer(spec.selectivity(), numIn);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    spec.selectivity().addOutput(numOut);
+  };
+  auto* c0 = scanSpec->childByName("c0");
+  auto* c1 = scanSpec->childByName("c1");
+  recordSelectivity(*c0, 100, 100);
+  recordSelectivity(*c1, 100, 0);
+  scanSpec->resetCachedValues(true);
+  ASSERT_EQ(scanSpec->children()[0]->fieldName(), "c1");
+
+  // A dynamic filter on c0 has no history yet and is tried first.
+  c0->addFilter(BigintRange(0, 10, false));
+  ASSERT_EQ(c0->selectivity().numIn(), 0);
+  scanSpec->resetCachedValues(true);
+  ASSERT_EQ(scanSpec->children()[0]->fieldName(), "c0");
+}
+
 TEST_F(HiveConnectorTest, extractFiltersFromRemainingFilter) {
   auto queryCtx = core::QueryCtx::create();
   exec::SimpleExpressionEvaluator evaluator(queryCtx.get(), pool_.get());
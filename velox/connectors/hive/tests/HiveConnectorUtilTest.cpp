@@ -17,11 +17,13 @@
 #include <gtest/gtest.h>
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
+#include "velox/common/file/File.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/core/Config.h"
+#include "velox/dwio/common/ReaderFactory.h"
 
 namespace facebook::velox::connector {
 
@@ -212,4 +214,68 @@ TEST_F(HiveConnectorUtilTest, configureRowReaderOptions) {
   ASSERT_EQ(nodes[0].expression, "[1,3]");
 }
 
+TEST_F(HiveConnectorUtilTest, aggregateFromFileStats) {
+  auto data = makeRowVector(
+      {"c0", "c1", "c2"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row + 5; }),
+       makeAllNullFlatVector<int32_t>(100),
+       makeFlatVector<std::string>(
+           100, [](auto row) { return fmt::format("s{}", row); })});
+  auto file = exec::test::TempFilePath::create();
+  writeToFile(file->getPath(), data);
+
+  ReaderOptions readerOptions(pool_.get());
+  readerOptions.setFileFormat(FileFormat::DWRF);
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<LocalReadFile>(file->getPath()), *pool_);
+  auto reader = getReaderFactory(FileFormat::DWRF)
+                    ->createReader(std::move(input), readerOptions);
+
+  const std::unordered_map<std::string, std::optional<std::string>>
+      partitionKeys;
+  const std::unordered_map<std::string, std::shared_ptr<hive::HiveColumnHandle>>
+      partitionKeysHandle;
+  const std::vector<MetadataAggregate> aggregates = {
+      {MetadataAggregate::Kind::kCount, ""},
+      {MetadataAggregate::Kind::kMin, "c0"},
+      {MetadataAggregate::Kind::kMax, "c0"},
+      {MetadataAggregate::Kind::kMax, "c1"}};
+  auto aggregate = [&](const common::ScanSpec& spec,
+                       const std::vector<MetadataAggregate>& aggregates) {
+    return hive::aggregateFromFileStats(
+        &spec, reader.get(), aggregates, partitionKeys, partitionKeysHandle);
+  };
+
+  common::ScanSpec spec("<root>");
+  spec.addAllChildFields(*data->type());
+  auto results = aggregate(spec, aggregates);
+  ASSERT_TRUE(results.has_value());
+  ASSERT_EQ(results->size(), 4);
+  EXPECT_EQ(results->at(0), variant(static_cast<int64_t>(100)));
+  EXPECT_EQ(results->at(1), variant(static_cast<int64_t>(5)));
+  EXPECT_EQ(results->at(2), variant(static_cast<int64_t>(104)));
+  EXPECT_TRUE(results->at(3).isNull());
+
+  // The stats prove that all rows pass.
+  spec.childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(0, 1'000, false));
+  spec.childByName("c1")->setFilter(std::make_unique<common::IsNull>());
+  results = aggregate(spec, aggregates);
+  ASSERT_TRUE(results.has_value());
+  EXPECT_EQ(results->at(0), variant(static_cast<int64_t>(100)));
+
+  // Some rows may fail the filter.
+  spec.childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(10, 1'000, false));
+  EXPECT_FALSE(aggregate(spec, aggregates).has_value());
+  spec.childByName("c0")->setFilter(nullptr);
+  spec.childByName("c1")->setFilter(std::make_unique<common::IsNotNull>());
+  EXPECT_FALSE(aggregate(spec, aggregates).has_value());
+  spec.childByName("c1")->setFilter(nullptr);
+
+  // Minimums of strings are not taken from the stats.
+  EXPECT_FALSE(
+      aggregate(spec, {{MetadataAggregate::Kind::kMin, "c2"}}).has_value());
+}
+
 } // namespace facebook::velox::connector
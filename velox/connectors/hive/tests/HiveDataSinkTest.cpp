@@ -485,8 +485,9 @@ TEST_F(HiveDataSinkTest, basic) {
   ASSERT_TRUE(stats.empty()) << stats.toString();
   ASSERT_EQ(
       stats.toString(),
-      "numWrittenBytes 0B numWrittenFiles 0 spillRuns[0] spilledInputBytes[0B] "
-      "spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] "
+      "numWrittenBytes 0B numWrittenFiles 0 writerCloseTime 0us "
+      "spillRuns[0] spilledInputBytes[0B] spilledBytes[0B] spilledRows[0] "
+      "spilledPartitions[0] spilledFiles[0] "
       "spillFillTimeUs[0us] spillSortTime[0us] spillSerializationTime[0us] "
       "spillWrites[0] spillFlushTime[0us] spillWriteTime[0us] "
       "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
@@ -533,8 +534,9 @@ TEST_F(HiveDataSinkTest, basicBucket) {
   ASSERT_TRUE(stats.empty()) << stats.toString();
   ASSERT_EQ(
       stats.toString(),
-      "numWrittenBytes 0B numWrittenFiles 0 spillRuns[0] spilledInputBytes[0B] "
-      "spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] "
+      "numWrittenBytes 0B numWrittenFiles 0 writerCloseTime 0us "
+      "spillRuns[0] spilledInputBytes[0B] spilledBytes[0B] spilledRows[0] "
+      "spilledPartitions[0] spilledFiles[0] "
       "spillFillTimeUs[0us] spillSortTime[0us] spillSerializationTime[0us] "
       "spillWrites[0] spillFlushTime[0us] spillWriteTime[0us] "
       "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
@@ -621,6 +623,91 @@ TEST_F(HiveDataSinkTest, abort) {
   }
 }
 
+TEST_F(HiveDataSinkTest, partitionSortWrite) {
+  constexpr int32_t kNumPartitions = 20;
+  const auto outputDirectory = TempDirectoryPath::create();
+  connectorSessionProperties_->setValue(
+      HiveConfig::kPartitionSortWriteSession, "true");
+
+  const auto rowType = ROW({"c0", "c1"}, {BIGINT(), INTEGER()});
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(100, [i](auto row) { return i * 100 + row; }),
+         makeFlatVector<int32_t>(
+             100, [](auto row) { return row % kNumPartitions; })}));
+  }
+  auto dataSink = createDataSink(
+      rowType,
+      outputDirectory->getPath(),
+      dwio::common::FileFormat::DWRF,
+      {"c1"});
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  // The input is buffered until close.
+  ASSERT_EQ(dataSink->stats().numWrittenBytes, 0);
+
+  const auto partitions = dataSink->close();
+  ASSERT_EQ(partitions.size(), kNumPartitions);
+  ASSERT_EQ(dataSink->stats().numWrittenFiles, kNumPartitions);
+
+  createDuckDbTable(vectors);
+  const auto filePaths = listFiles(outputDirectory->getPath());
+  ASSERT_EQ(filePaths.size(), kNumPartitions);
+  for (const auto& filePath : filePaths) {
+    // The partition directory is named c1=<partition key>.
+    const auto partition = fs::path(filePath).parent_path().filename().string();
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits{
+        makeHiveConnectorSplit(filePath)};
+    HiveConnectorTestBase::assertQuery(
+        PlanBuilder().tableScan(ROW({"c0"}, {BIGINT()})).planNode(),
+        splits,
+        fmt::format("SELECT c0 FROM tmp WHERE {}", partition));
+  }
+}
+
+TEST_F(HiveDataSinkTest, parallelWriterClose) {
+  constexpr int32_t kNumPartitions = 20;
+  const auto outputDirectory = TempDirectoryPath::create();
+  connectorSessionProperties_->setValue(
+      HiveConfig::kParallelWriterCloseSession, "true");
+
+  const auto rowType = ROW({"c0", "c1"}, {BIGINT(), INTEGER()});
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(100, [i](auto row) { return i * 100 + row; }),
+         makeFlatVector<int32_t>(
+             100, [](auto row) { return row % kNumPartitions; })}));
+  }
+  auto dataSink = std::make_shared<HiveDataSink>(
+      rowType,
+      createHiveInsertTableHandle(
+          rowType,
+          outputDirectory->getPath(),
+          dwio::common::FileFormat::DWRF,
+          {"c1"}),
+      connectorQueryCtx_.get(),
+      CommitStrategy::kNoCommit,
+      connectorConfig_,
+      spillExecutor_.get());
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  ASSERT_EQ(dataSink->stats().writerCloseTimeUs, 0);
+
+  const auto partitions = dataSink->close();
+  ASSERT_EQ(partitions.size(), kNumPartitions);
+  const auto stats = dataSink->stats();
+  ASSERT_EQ(stats.numWrittenFiles, kNumPartitions);
+  ASSERT_GT(stats.writerCloseTimeUs, 0);
+
+  ASSERT_EQ(listFiles(outputDirectory->getPath()).size(), kNumPartitions);
+}
+
 TEST_F(HiveDataSinkTest, memoryReclaim) {
   const int numBatches = 200;
   auto vectors = createVectors(500, 200);
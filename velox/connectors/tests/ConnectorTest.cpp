@@ -49,6 +49,34 @@ class TestConnector : public connector::Connector {
 
 } // namespace
 
+TEST_F(ConnectorTest, affinityNodeIndex) {
+  ASSERT_EQ(-1, affinityNodeIndex("file:0", {}));
+  std::vector<std::string> nodeIds;
+  for (auto i = 0; i < 10; ++i) {
+    nodeIds.push_back(fmt::format("node-{}", i));
+  }
+  std::vector<int32_t> indices;
+  std::vector<int32_t> numKeys(nodeIds.size());
+  for (auto i = 0; i < 1'000; ++i) {
+    const auto key = fmt::format("file{}:0", i);
+    indices.push_back(affinityNodeIndex(key, nodeIds));
+    ASSERT_EQ(indices.back(), affinityNodeIndex(key, nodeIds));
+    ++numKeys[indices.back()];
+  }
+  for (auto count : numKeys) {
+    ASSERT_GT(count, 0);
+  }
+
+  // Removing a node moves only the keys of that node.
+  nodeIds.erase(nodeIds.begin() + 3);
+  for (auto i = 0; i < 1'000; ++i) {
+    const auto index = affinityNodeIndex(fmt::format("file{}:0", i), nodeIds);
+    if (indices[i] != 3) {
+      ASSERT_EQ(indices[i] < 3 ? indices[i] : indices[i] - 1, index);
+    }
+  }
+}
+
 TEST_F(ConnectorTest, getAllConnectors) {
   const int32_t numConnectors = 10;
   for (int32_t i = 0; i < numConnectors; i++) {
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include <folly/init/Init.h>
+#include "gtest/gtest.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+
+namespace {
+
+using namespace facebook::velox;
+using namespace facebook::velox::connector::tpcds;
+
+using facebook::velox::exec::test::PlanBuilder;
+using facebook::velox::tpcds::Table;
+
+class TpcdsConnectorTest : public exec::test::OperatorTestBase {
+ public:
+  const std::string kTpcdsConnectorId = "test-tpcds";
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    window::prestosql::registerAllWindowFunctions();
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                kTpcdsConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(tpcdsConnector);
+  }
+
+  void TearDown() override {
+    connector::unregisterConnector(kTpcdsConnectorId);
+    OperatorTestBase::TearDown();
+  }
+
+  exec::Split makeTpcdsSplit(size_t totalParts = 1, size_t partNumber = 0)
+      const {
+    return exec::Split(std::make_shared<TpcdsConnectorSplit>(
+        kTpcdsConnectorId, totalParts, partNumber));
+  }
+
+  std::vector<exec::Split> makeTpcdsSplits(size_t totalParts) const {
+    std::vector<exec::Split> splits;
+    for (size_t i = 0; i < totalParts; ++i) {
+      splits.push_back(makeTpcdsSplit(totalParts, i));
+    }
+    return splits;
+  }
+
+  RowVectorPtr getResults(
+      const core::PlanNodePtr& planNode,
+      std::vector<exec::Split>&& splits) {
+    return exec::test::AssertQueryBuilder(planNode)
+        .splits(std::move(splits))
+        .copyResults(pool());
+  }
+};
+
+// First rows of "date_dim".
+TEST_F(TpcdsConnectorTest, simple) {
+  auto plan = PlanBuilder()
+                  .tpcdsTableScan(
+                      Table::TBL_DATE_DIM,
+                      {"d_date_sk", "d_date", "d_year", "d_moy", "d_dom"})
+                  .limit(0, 3, false)
+                  .planNode();
+
+  auto output = getResults(plan, {makeTpcdsSplit()});
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>({2'415'022, 2'415'023, 2'415'024}),
+      makeFlatVector<int32_t>({-25'566, -25'565, -25'564}, DATE()),
+      makeFlatVector<int32_t>({1900, 1900, 1900}),
+      makeFlatVector<int32_t>({1, 1, 1}),
+      makeFlatVector<int32_t>({2, 3, 4}),
+  });
+  test::assertEqualVectors(expected, output);
+}
+
+TEST_F(TpcdsConnectorTest, unknownColumn) {
+  EXPECT_THROW(
+      {
+        PlanBuilder()
+            .tpcdsTableScan(Table::TBL_ITEM, {"does_not_exist"})
+            .planNode();
+      },
+      VeloxUserError);
+}
+
+// Ensures that all tables produce getRowCount() rows and the same data
+// regardless of the number of splits they are generated in.
+TEST_F(TpcdsConnectorTest, multipleSplits) {
+  constexpr double kScaleFactor = 0.01;
+  for (const auto table : tpcds::tables) {
+    if (table == Table::TBL_CUSTOMER_DEMOGRAPHICS) {
+      // Fixed size cross product of its attributes, too large for this test.
+      continue;
+    }
+    SCOPED_TRACE(std::string(tpcds::toTableName(table)));
+    auto plan = PlanBuilder()
+                    .tpcdsTableScan(
+                        table,
+                        std::vector<std::string>(
+                            tpcds::getTableSchema(table)->names()),
+                        kScaleFactor)
+                    .planNode();
+
+    auto expected = getResults(plan, {makeTpcdsSplit()});
+    EXPECT_EQ(tpcds::getRowCount(table, kScaleFactor), expected->size());
+    for (const auto numSplits : {2, 7}) {
+      auto output = getResults(plan, makeTpcdsSplits(numSplits));
+      test::assertEqualVectors(expected, output);
+    }
+  }
+}
+
+// Runs the plans of TpcdsQueryBuilder on a small scale factor. The selective
+// filters of some queries may leave no rows at this scale, so only the plans
+// are checked to run to completion.
+TEST_F(TpcdsConnectorTest, queries) {
+  exec::test::TpcdsQueryBuilder builder(0.01);
+  for (const auto queryId : exec::test::TpcdsQueryBuilder::getQueryIds()) {
+    SCOPED_TRACE(fmt::format("q{}", queryId));
+    const auto tpcdsPlan = builder.getQueryPlan(queryId);
+    exec::test::AssertQueryBuilder queryBuilder(tpcdsPlan.plan);
+    for (const auto& [planNodeId, table] : tpcdsPlan.scanTables) {
+      queryBuilder.splits(planNodeId, makeTpcdsSplits(2));
+    }
+    auto output = queryBuilder.maxDrivers(2).copyResults(pool());
+    EXPECT_EQ(*tpcdsPlan.plan->outputType(), *output->type());
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::Init init{&argc, &argv, false};
+  return RUN_ALL_TESTS();
+}
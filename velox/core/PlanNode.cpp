@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/container/F14Set.h>
+#include <folly/json.h>
 
 #include "velox/common/encode/Base64.h"
 #include "velox/core/PlanNode.h"
@@ -227,7 +228,7 @@ bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
   // TODO: Add spilling for aggregations over distinct inputs.
   // https://github.com/facebookincubator/velox/issues/7454
   for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
+    if (aggregate.distinct && !dedupsDistinctInputs(queryConfig)) {
       return false;
     }
   }
@@ -237,6 +238,36 @@ bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
       queryConfig.aggregationSpillEnabled();
 }
 
+bool AggregationNode::dedupsDistinctInputs(
+    const QueryConfig& queryConfig) const {
+  if (!queryConfig.hashAggregationDistinctDedup() || !isSingle() ||
+      aggregates_.empty() || !preGroupedKeys_.empty() ||
+      !globalGroupingSets_.empty() || groupId_.has_value()) {
+    return false;
+  }
+  std::optional<folly::F14FastSet<std::string>> distinctInputs;
+  for (const auto& aggregate : aggregates_) {
+    if (!aggregate.distinct || aggregate.mask != nullptr ||
+        !aggregate.sortingKeys.empty() || aggregate.call->inputs().empty()) {
+      return false;
+    }
+    folly::F14FastSet<std::string> inputs;
+    for (const auto& input : aggregate.call->inputs()) {
+      auto field = TypedExprs::asFieldAccess(input);
+      if (field == nullptr) {
+        return false;
+      }
+      inputs.insert(field->name());
+    }
+    if (!distinctInputs.has_value()) {
+      distinctInputs = std::move(inputs);
+    } else if (inputs != distinctInputs.value()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void AggregationNode::addDetails(std::stringstream& stream) const {
   stream << stepName(step_) << " ";
 
@@ -1057,11 +1088,17 @@ void HashJoinNode::addDetails(std::stringstream& stream) const {
   if (nullAware_) {
     stream << ", null aware";
   }
+  if (useHashTableCache_) {
+    stream << ", hash table cache";
+  }
 }
 
 folly::dynamic HashJoinNode::serialize() const {
   auto obj = serializeBase();
   obj["nullAware"] = nullAware_;
+  if (useHashTableCache_) {
+    obj["useHashTableCache"] = true;
+  }
   return obj;
 }
 
@@ -1081,6 +1118,9 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
 
   auto outputType = deserializeRowType(obj["outputType"]);
 
+  const bool useHashTableCache = obj.count("useHashTableCache") != 0 &&
+      obj["useHashTableCache"].asBool();
+
   return std::make_shared<HashJoinNode>(
       deserializePlanNodeId(obj),
       joinTypeFromName(obj["joinType"].asString()),
@@ -1090,7 +1130,8 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
       filter,
       sources[0],
       sources[1],
-      outputType);
+      outputType,
+      useHashTableCache);
 }
 
 folly::dynamic MergeJoinNode::serialize() const {
@@ -1210,6 +1251,107 @@ PlanNodePtr NestedLoopJoinNode::create(
       outputType);
 }
 
+IndexLookupJoinNode::IndexLookupJoinNode(
+    const PlanNodeId& id,
+    JoinType joinType,
+    const std::vector<FieldAccessTypedExprPtr>& leftKeys,
+    const std::vector<FieldAccessTypedExprPtr>& rightKeys,
+    PlanNodePtr left,
+    std::shared_ptr<const TableScanNode> lookupSource,
+    RowTypePtr outputType)
+    : PlanNode(id),
+      joinType_(joinType),
+      leftKeys_(leftKeys),
+      rightKeys_(rightKeys),
+      sources_({std::move(left)}),
+      lookupSource_(std::move(lookupSource)),
+      outputType_(std::move(outputType)) {
+  VELOX_USER_CHECK(
+      core::isInnerJoin(joinType_) || core::isLeftJoin(joinType_),
+      "{} unsupported, IndexLookupJoin only supports inner and left join",
+      joinTypeName(joinType_));
+  VELOX_USER_CHECK_NOT_NULL(lookupSource_);
+  VELOX_USER_CHECK(
+      !leftKeys_.empty(), "IndexLookupJoin requires at least one join key");
+  VELOX_USER_CHECK_EQ(
+      leftKeys_.size(),
+      rightKeys_.size(),
+      "IndexLookupJoin requires the same number of join keys on both sides");
+
+  const auto& leftType = sources_[0]->outputType();
+  const auto& rightType = lookupSource_->outputType();
+  for (auto i = 0; i < leftKeys_.size(); ++i) {
+    VELOX_USER_CHECK(
+        leftType->containsChild(leftKeys_[i]->name()),
+        "Left side join key not found in left side output: {}",
+        leftKeys_[i]->name());
+    VELOX_USER_CHECK(
+        rightType->containsChild(rightKeys_[i]->name()),
+        "Right side join key not found in lookup source output: {}",
+        rightKeys_[i]->name());
+    VELOX_USER_CHECK_EQ(
+        leftKeys_[i]->type()->kind(),
+        rightKeys_[i]->type()->kind(),
+        "Join key types on the left and right sides must match");
+  }
+  for (const auto& name : outputType_->names()) {
+    const bool leftContains = leftType->containsChild(name);
+    const bool rightContains = rightType->containsChild(name);
+    VELOX_USER_CHECK(
+        !(leftContains && rightContains),
+        "Duplicate column name found on join's left and right sides: {}",
+        name);
+    VELOX_USER_CHECK(
+        leftContains || rightContains,
+        "Join's output column not found in either left or right sides: {}",
+        name);
+  }
+}
+
+void IndexLookupJoinNode::addDetails(std::stringstream& stream) const {
+  stream << joinTypeName(joinType_) << " ";
+  for (auto i = 0; i < leftKeys_.size(); ++i) {
+    if (i > 0) {
+      stream << " AND ";
+    }
+    stream << leftKeys_[i]->name() << "=" << rightKeys_[i]->name();
+  }
+  stream << ", lookup table: " << lookupSource_->tableHandle()->toString();
+}
+
+folly::dynamic IndexLookupJoinNode::serialize() const {
+  auto obj = PlanNode::serialize();
+  obj["joinType"] = joinTypeName(joinType_);
+  obj["leftKeys"] = ISerializable::serialize(leftKeys_);
+  obj["rightKeys"] = ISerializable::serialize(rightKeys_);
+  obj["lookupSource"] = lookupSource_->serialize();
+  obj["outputType"] = outputType_->serialize();
+  return obj;
+}
+
+// static
+PlanNodePtr IndexLookupJoinNode::create(
+    const folly::dynamic& obj,
+    void* context) {
+  auto sources = deserializeSources(obj, context);
+  VELOX_CHECK_EQ(1, sources.size());
+
+  auto leftKeys = deserializeFields(obj["leftKeys"], context);
+  auto rightKeys = deserializeFields(obj["rightKeys"], context);
+  auto lookupSource = std::dynamic_pointer_cast<const TableScanNode>(
+      TableScanNode::create(obj["lookupSource"], context));
+  auto outputType = deserializeRowType(obj["outputType"]);
+
+  return std::make_shared<IndexLookupJoinNode>(
+      deserializePlanNodeId(obj),
+      joinTypeFromName(obj["joinType"].asString()),
+      std::move(leftKeys),
+      std::move(rightKeys),
+      sources[0],
+      std::move(lookupSource),
+      outputType);
+}
+
 AssignUniqueIdNode::AssignUniqueIdNode(
     const PlanNodeId& id,
     const std::string& idName,
@@ -1960,6 +2102,56 @@ PlanNodePtr EnforceSingleRowNode::create(
       deserializePlanNodeId(obj), deserializeSingleSource(obj, context));
 }
 
+FragmentResultCacheNode::FragmentResultCacheNode(
+    const PlanNodeId& id,
+    PlanNodePtr source)
+    : PlanNode(id), sources_{std::move(source)} {
+  auto node = sources_[0];
+  while (std::dynamic_pointer_cast<const FilterNode>(node) != nullptr ||
+         std::dynamic_pointer_cast<const ProjectNode>(node) != nullptr) {
+    node = node->sources()[0];
+  }
+  tableScanNode_ = std::dynamic_pointer_cast<const TableScanNode>(node);
+  VELOX_USER_CHECK_NOT_NULL(
+      tableScanNode_,
+      "The source of FragmentResultCacheNode must be a TableScanNode followed "
+      "by FilterNodes and ProjectNodes: {}",
+      sources_[0]->toString(false, true));
+}
+
+std::string FragmentResultCacheNode::fingerprint() const {
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  std::string fingerprint;
+  for (const PlanNode* node = sources_[0].get();;
+       node = node->sources()[0].get()) {
+    auto obj = node->serialize();
+    obj.erase("id");
+    obj.erase("sources");
+    fingerprint += folly::json::serialize(obj, opts);
+    if (node->sources().empty()) {
+      return fingerprint;
+    }
+  }
+}
+
+void FragmentResultCacheNode::addDetails(
+    std::stringstream& /* stream */) const {
+  // Nothing to add.
+}
+
+folly::dynamic FragmentResultCacheNode::serialize() const {
+  return PlanNode::serialize();
+}
+
+// static
+PlanNodePtr FragmentResultCacheNode::create(
+    const folly::dynamic& obj,
+    void* context) {
+  return std::make_shared<FragmentResultCacheNode>(
+      deserializePlanNodeId(obj), deserializeSingleSource(obj, context));
+}
+
 // static
 std::string PartitionedOutputNode::kindString(Kind kind) {
   switch (kind) {
@@ -2007,6 +2199,10 @@ void PartitionedOutputNode::addDetails(std::stringstream& stream) const {
   if (replicateNullsAndAny_) {
     stream << " replicate nulls and any";
   }
+
+  if (skewReplicaGroupSize_ > 1) {
+    stream << " spread skewed partitions over " << skewReplicaGroupSize_;
+  }
 }
 
 folly::dynamic PartitionedOutputNode::serialize() const {
@@ -2017,6 +2213,7 @@ folly::dynamic PartitionedOutputNode::serialize() const {
   obj["replicateNullsAndAny"] = replicateNullsAndAny_;
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
   obj["outputType"] = outputType_->serialize();
+  obj["skewReplicaGroupSize"] = skewReplicaGroupSize_;
   return obj;
 }
 
@@ -2024,6 +2221,10 @@ folly::dynamic PartitionedOutputNode::serialize() const {
 PlanNodePtr PartitionedOutputNode::create(
     const folly::dynamic& obj,
     void* context) {
+  int32_t skewReplicaGroupSize = 0;
+  if (obj.count("skewReplicaGroupSize")) {
+    skewReplicaGroupSize = obj["skewReplicaGroupSize"].asInt();
+  }
   return std::make_shared<PartitionedOutputNode>(
       deserializePlanNodeId(obj),
       stringToKind(obj["kind"].asString()),
@@ -2033,7 +2234,8 @@ PlanNodePtr PartitionedOutputNode::create(
       ISerializable::deserialize<PartitionFunctionSpec>(
           obj["partitionFunctionSpec"], context),
       deserializeRowType(obj["outputType"]),
-      deserializeSingleSource(obj, context));
+      deserializeSingleSource(obj, context),
+      skewReplicaGroupSize);
 }
 
 TopNNode::TopNNode(
@@ -2229,8 +2431,11 @@ void PlanNode::registerSerDe() {
   registry.Register("ExchangeNode", ExchangeNode::create);
   registry.Register("ExpandNode", ExpandNode::create);
   registry.Register("FilterNode", FilterNode::create);
+  registry.Register(
+      "FragmentResultCacheNode", FragmentResultCacheNode::create);
   registry.Register("GroupIdNode", GroupIdNode::create);
   registry.Register("HashJoinNode", HashJoinNode::create);
+  registry.Register("IndexLookupJoinNode", IndexLookupJoinNode::create);
   registry.Register("MergeExchangeNode", MergeExchangeNode::create);
   registry.Register("MergeJoinNode", MergeJoinNode::create);
   registry.Register("NestedLoopJoinNode", NestedLoopJoinNode::create);
@@ -613,6 +613,13 @@ class AggregationNode : public PlanNode {
 
   bool canSpill(const QueryConfig& queryConfig) const override;
 
+  /// Returns true if the aggregates over distinct inputs are computed by
+  /// de-duplicating the grouping keys and the inputs in a hash table and
+  /// aggregating the rows new to it. Requires a single aggregation where all
+  /// aggregates are distinct over the same input columns without masks or
+  /// sorting keys. See QueryConfig::kHashAggregationDistinctDedup.
+  bool dedupsDistinctInputs(const QueryConfig& queryConfig) const;
+
   bool isFinal() const {
     return step_ == Step::kFinal;
   }
@@ -912,7 +919,7 @@ class GroupIdNode : public PlanNode {
     return aggregationInputs_;
   }
 
-  const std::string& groupIdName() {
+  const std::string& groupIdName() const {
     return groupIdName_;
   }
 
@@ -1209,7 +1216,8 @@ class PartitionedOutputNode : public PlanNode {
       bool replicateNullsAndAny,
       PartitionFunctionSpecPtr partitionFunctionSpec,
       RowTypePtr outputType,
-      PlanNodePtr source)
+      PlanNodePtr source,
+      int32_t skewReplicaGroupSize = 0)
       : PlanNode(id),
         kind_(kind),
         sources_{{std::move(source)}},
@@ -1217,8 +1225,17 @@ class PartitionedOutputNode : public PlanNode {
         numPartitions_(numPartitions),
         replicateNullsAndAny_(replicateNullsAndAny),
         partitionFunctionSpec_(std::move(partitionFunctionSpec)),
-        outputType_(std::move(outputType)) {
+        outputType_(std::move(outputType)),
+        skewReplicaGroupSize_(skewReplicaGroupSize) {
     VELOX_USER_CHECK_GT(numPartitions, 0);
+    VELOX_USER_CHECK_GE(skewReplicaGroupSize_, 0);
+    VELOX_USER_CHECK_LE(skewReplicaGroupSize_, numPartitions_);
+    if (skewReplicaGroupSize_ > 1) {
+      VELOX_USER_CHECK(
+          isPartitioned() && !replicateNullsAndAny_,
+          "Skewed partitions can only be spread for hash partitioned output "
+          "without replicated nulls");
+    }
     if (numPartitions == 1) {
       VELOX_USER_CHECK(
           keys_.empty(),
@@ -1321,6 +1338,18 @@ class PartitionedOutputNode : public PlanNode {
     return replicateNullsAndAny_;
   }
 
+  /// Returns the number of destinations the rows of a skewed partition are
+  /// spread across, 0 or 1 if partitions are never spread. The rows of
+  /// partition 'p' then go to destinations p, p + 1, ..., p + size - 1 modulo
+  /// the number of partitions, round-robin, after the partition turns out to
+  /// receive many times its share of the rows. Only valid if the consumer
+  /// does not need all rows of a key at one destination, e.g. a partial
+  /// aggregation, or a join probe whose build side is replicated across each
+  /// group of destinations.
+  int32_t skewReplicaGroupSize() const {
+    return skewReplicaGroupSize_;
+  }
+
   const PartitionFunctionSpecPtr& partitionFunctionSpecPtr() const {
     return partitionFunctionSpec_;
   }
@@ -1347,6 +1376,7 @@ class PartitionedOutputNode : public PlanNode {
   const bool replicateNullsAndAny_;
   const PartitionFunctionSpecPtr partitionFunctionSpec_;
   const RowTypePtr outputType_;
+  const int32_t skewReplicaGroupSize_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -1575,7 +1605,8 @@ class HashJoinNode : public AbstractJoinNode {
       TypedExprPtr filter,
       PlanNodePtr left,
       PlanNodePtr right,
-      RowTypePtr outputType)
+      RowTypePtr outputType,
+      bool useHashTableCache = false)
       : AbstractJoinNode(
             id,
             joinType,
@@ -1585,7 +1616,8 @@ class HashJoinNode : public AbstractJoinNode {
             std::move(left),
             std::move(right),
             std::move(outputType)),
-        nullAware_{nullAware} {
+        nullAware_{nullAware},
+        useHashTableCache_{useHashTableCache} {
     if (nullAware) {
       VELOX_USER_CHECK(
           isNullAwareSupported(joinType),
@@ -1599,6 +1631,14 @@ class HashJoinNode : public AbstractJoinNode {
             "Null-aware right semi project join doesn't support extra filter");
       }
     }
+    if (useHashTableCache) {
+      VELOX_USER_CHECK(
+          !nullAware && (isInnerJoin() || isLeftJoin() ||
+                         isLeftSemiFilterJoin() || isLeftSemiProjectJoin() ||
+                         isAntiJoin()),
+          "Hash table cache is not supported for {} join",
+          joinTypeName(joinType));
+    }
   }
 
   std::string_view name() const override {
@@ -1611,13 +1651,22 @@ class HashJoinNode : public AbstractJoinNode {
     // the build-side rows for filter evaluation which is not supported under
     // spilling.
     return !(isAntiJoin() && nullAware_ && filter() != nullptr) &&
-        queryConfig.joinSpillEnabled();
+        !useHashTableCache_ && queryConfig.joinSpillEnabled();
   }
 
   bool isNullAware() const {
     return nullAware_;
   }
 
+  /// True if the build side is broadcast and the tasks of the query that run
+  /// this join in the same process share one hash table. The first task
+  /// builds the table and the others probe it instead of building their own.
+  /// Disables spilling. Not supported for null-aware joins and for the join
+  /// types that record which build rows were probed.
+  bool useHashTableCache() const {
+    return useHashTableCache_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1626,6 +1675,7 @@ class HashJoinNode : public AbstractJoinNode {
   void addDetails(std::stringstream& stream) const override;
 
   const bool nullAware_;
+  const bool useHashTableCache_;
 };
 
 /// Represents inner/outer/semi/anti merge joins. Translates to an
@@ -1658,6 +1708,13 @@ class MergeJoinNode : public AbstractJoinNode {
     return "MergeJoin";
   }
 
+  /// Semi joins do not spill. Their output depends on how the matching right
+  /// rows are split in batches, which changes when the rows are read back
+  /// from spill.
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return (isInnerJoin() || isLeftJoin()) && queryConfig.joinSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1722,6 +1779,68 @@ class NestedLoopJoinNode : public PlanNode {
   const RowTypePtr outputType_;
 };
 
+/// Joins each row of the left input with the rows of the table of
+/// 'lookupSource' that have the same values in 'rightKeys'. The table is not
+/// scanned. Batches of left keys are looked up in a connector::IndexSource of
+/// the connector of the table instead. This suits a small left input joined
+/// with a large table that is sorted or indexed on 'rightKeys'. The only
+/// source is the left input. 'lookupSource' does not run and takes no
+/// splits. Supports inner and left joins.
+class IndexLookupJoinNode : public PlanNode {
+ public:
+  IndexLookupJoinNode(
+      const PlanNodeId& id,
+      JoinType joinType,
+      const std::vector<FieldAccessTypedExprPtr>& leftKeys,
+      const std::vector<FieldAccessTypedExprPtr>& rightKeys,
+      PlanNodePtr left,
+      std::shared_ptr<const TableScanNode> lookupSource,
+      RowTypePtr outputType);
+
+  const std::vector<PlanNodePtr>& sources() const override {
+    return sources_;
+  }
+
+  const RowTypePtr& outputType() const override {
+    return outputType_;
+  }
+
+  std::string_view name() const override {
+    return "IndexLookupJoin";
+  }
+
+  JoinType joinType() const {
+    return joinType_;
+  }
+
+  const std::vector<FieldAccessTypedExprPtr>& leftKeys() const {
+    return leftKeys_;
+  }
+
+  /// The key columns of 'lookupSource'.
+  const std::vector<FieldAccessTypedExprPtr>& rightKeys() const {
+    return rightKeys_;
+  }
+
+  const std::shared_ptr<const TableScanNode>& lookupSource() const {
+    return lookupSource_;
+  }
+
+  folly::dynamic serialize() const override;
+
+  static PlanNodePtr create(const folly::dynamic& obj, void* context);
+
+ private:
+  void addDetails(std::stringstream& stream) const override;
+
+  const JoinType joinType_;
+  const std::vector<FieldAccessTypedExprPtr> leftKeys_;
+  const std::vector<FieldAccessTypedExprPtr> rightKeys_;
+  const std::vector<PlanNodePtr> sources_;
+  const std::shared_ptr<const TableScanNode> lookupSource_;
+  const RowTypePtr outputType_;
+};
+
 // Represents the 'SortBy' node in the plan.
 class OrderByNode : public PlanNode {
  public:
@@ -1995,6 +2114,50 @@ class EnforceSingleRowNode : public PlanNode {
   const std::vector<PlanNodePtr> sources_;
 };
 
+/// Passes through the output of its source, a TableScanNode followed only by
+/// FilterNodes and ProjectNodes, and caches it by split. The output for a
+/// split is reused by later queries with the same fragment if the split
+/// identifies immutable data, see ConnectorSplit::resultCacheKey(). The
+/// fragment must be deterministic. The planner adds this node to opt in, e.g.
+/// for the scans of dashboard queries that run the same subqueries over the
+/// same partitions.
+class FragmentResultCacheNode : public PlanNode {
+ public:
+  FragmentResultCacheNode(const PlanNodeId& id, PlanNodePtr source);
+
+  const RowTypePtr& outputType() const override {
+    return sources_[0]->outputType();
+  }
+
+  const std::vector<PlanNodePtr>& sources() const override {
+    return sources_;
+  }
+
+  /// The TableScanNode at the bottom of the fragment.
+  const std::shared_ptr<const TableScanNode>& tableScanNode() const {
+    return tableScanNode_;
+  }
+
+  /// Returns a string that is the same for fragments that produce the same
+  /// output for a split. Differs from toString() in not depending on plan
+  /// node IDs.
+  std::string fingerprint() const;
+
+  std::string_view name() const override {
+    return "FragmentResultCache";
+  }
+
+  folly::dynamic serialize() const override;
+
+  static PlanNodePtr create(const folly::dynamic& obj, void* context);
+
+ private:
+  void addDetails(std::stringstream& stream) const override;
+
+  const std::vector<PlanNodePtr> sources_;
+  std::shared_ptr<const TableScanNode> tableScanNode_;
+};
+
 /// Adds a new column named `idName` at the end of the input columns
 /// with unique int64_t value per input row.
 ///
@@ -2135,8 +2298,7 @@ class WindowNode : public PlanNode {
     // No partitioning keys means the whole input is one big partition. In this
     // case, spilling is not helpful because we need to have a full partition in
     // memory to produce results.
-    return !partitionKeys_.empty() && !inputsSorted_ &&
-        queryConfig.windowSpillEnabled();
+    return !partitionKeys_.empty() && queryConfig.windowSpillEnabled();
   }
 
   const RowTypePtr& inputType() const {
@@ -95,17 +95,45 @@ class QueryConfig {
   static constexpr const char* kExprEvalSimplified =
       "expression.eval_simplified";
 
+  /// Whether to evaluate trees of arithmetic and comparison functions over
+  /// flat fixed-width inputs with fused kernels that do not materialize the
+  /// intermediate results. False by default.
+  static constexpr const char* kExprFusedKernelsEnabled =
+      "expression.fused_kernels_enabled";
+
   /// Whether to track CPU usage for individual expressions (supported by call
   /// and cast expressions). False by default. Can be expensive when processing
   /// small batches, e.g. < 10K rows.
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// If > 0, one in so many batches evaluated by an expression set is profiled:
+  /// each node of the expression tree records CPU time and the time spent
+  /// peeling encodings as if kExprTrackCpuUsage was set. Filter and project
+  /// operators then report the statistics of their expression trees in
+  /// OperatorStats::exprStats. 0 disables sampling.
+  static constexpr const char* kExprProfileSamplingInterval =
+      "expression.profile_sampling_interval";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// If not zero, one in this many addInput() and getOutput() calls of each
+  /// operator is measured with hardware performance counters. The cycles,
+  /// instructions, last level cache misses and branch misses of the sampled
+  /// calls are added to the runtime stats of the operator. Has no effect if
+  /// perf_event counters are not available. 0 disables sampling.
+  static constexpr const char* kOperatorPerfCounterSamplingInterval =
+      "operator_perf_counter_sampling_interval";
+
+  /// If not zero, each task keeps a timeline of the last this many Driver
+  /// runs, operator calls, blocked waits, cache loads and spill writes, which
+  /// Task::timelineChromeTrace() returns in the Chrome trace event format. 0
+  /// disables the timeline.
+  static constexpr const char* kTaskTimelineCapacity = "task_timeline_capacity";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -125,11 +153,39 @@ class QueryConfig {
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
+  /// If true, Exchange returns the values of fixed-width columns without
+  /// nulls as views on the received pages instead of copying them. Each
+  /// page is then returned as a separate batch and is kept alive for as long
+  /// as its vectors are referenced.
+  static constexpr const char* kExchangeZeroCopyDeserialization =
+      "exchange.zero_copy_deserialization";
+
   /// Maximum size in bytes to accumulate among all sources of the merge
   /// exchange. Enforced approximately, not strictly.
   static constexpr const char* kMaxMergeExchangeBufferSize =
       "merge_exchange.max_buffer_size";
 
+  /// Number of merge exchange sources that get their next page deserialized
+  /// on the query executor ahead of time. The sources with the fewest rows
+  /// left before they need a new page go first. Each source has at most one
+  /// page deserialized ahead. 0 deserializes the pages on the driver thread
+  /// when the sources run out of rows.
+  static constexpr const char* kMergeExchangePrefetchSources =
+      "merge_exchange.prefetch_sources";
+
+  /// If true, the drivers of a MarkDistinct or RowNumber with keys share one
+  /// hash table, so that the input of these does not need to be partitioned
+  /// by the keys across the drivers. RowNumber does not spill in this mode.
+  static constexpr const char* kSharedHashTableEnabled =
+      "shared_hash_table_enabled";
+
+  /// If true, an aggregation over a GroupId first aggregates the input of the
+  /// GroupId over all its grouping keys. The GroupId then replicates the
+  /// partial results instead of the input rows, and the aggregation merges
+  /// them. Applies to aggregations without masks, sorting and distinct.
+  static constexpr const char* kGroupingSetsPreAggregationEnabled =
+      "grouping_sets_pre_aggregation_enabled";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
@@ -142,17 +198,87 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If not zero, a partial aggregation with grouping keys estimates the
+  /// number of groups in this many first input rows with a HyperLogLog sketch
+  /// of the keys before adding them to its hash table. If the estimate is at
+  /// least kAbandonPartialAggregationMinPct % of the rows, the aggregation is
+  /// abandoned right away and the rows pass through without a hash table.
+  static constexpr const char* kAbandonPartialAggregationSketchRows =
+      "abandon_partial_aggregation_sketch_rows";
+
+  /// If true, a partial aggregation with grouping keys flushes its groups
+  /// when an input batch has no groups in common with the groups already in
+  /// the hash table, as is the case for input clustered on the grouping keys.
+  /// The earlier groups are then unlikely to get more rows and flushing them
+  /// bounds the hash table size.
+  static constexpr const char* kPartialAggregationClusteredFlush =
+      "partial_aggregation_clustered_flush";
+
+  /// A partial aggregation with grouping keys flushes its groups when the
+  /// memory reserved by the query exceeds this percentage of the max query
+  /// memory capacity. The flushed groups go downstream as intermediate results
+  /// instead of making the memory arbitrator spill other operators. 0
+  /// disables this.
+  static constexpr const char* kPartialAggregationFlushQueryMemoryPct =
+      "partial_aggregation_flush_query_memory_pct";
+
+  /// If true, the drivers of a single or final hash aggregation merge their
+  /// groups after all input is received. With grouping keys, each driver hashes
+  /// its groups into one partition per driver and then merges one partition
+  /// of all the drivers and produces its output. The input of such an
+  /// aggregation does not need to be partitioned on the grouping keys. For a
+  /// global aggregation, each driver aggregates a share of the input and the
+  /// last driver to finish merges the accumulators of the others into a
+  /// single output row.
+  static constexpr const char* kHashAggregationPartitionedMerge =
+      "hash_aggregation_partitioned_merge";
+
+  /// If true, a single aggregation where all aggregates are over the same
+  /// distinct inputs first de-duplicates the grouping keys and the inputs in
+  /// a hash table and then aggregates the rows new to it without keeping a
+  /// set of inputs per group. Both hash tables spill like a regular
+  /// aggregation.
+  static constexpr const char* kHashAggregationDistinctDedup =
+      "hash_aggregation_distinct_dedup";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
   static constexpr const char* kAbandonPartialTopNRowNumberMinPct =
       "abandon_partial_topn_row_number_min_pct";
 
+  /// If true, aggregate window functions over frames whose start moves
+  /// combine the intermediate states of a segment tree over the partition
+  /// instead of aggregating all the rows of each frame.
+  static constexpr const char* kWindowAggregateSegmentTreeEnabled =
+      "window_aggregate_segment_tree_enabled";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
+  /// Maximum number of bytes a partitioned output buffer writes to files in
+  /// the spill directory of the task instead of blocking the producers once
+  /// it holds max_output_buffer_size bytes. The pages that no consumer has
+  /// fetched yet are spilled and read back when they are fetched. 0 disables
+  /// spilling, as does a task without a spill directory.
+  static constexpr const char* kMaxOutputBufferSpillBytes =
+      "max_output_buffer_spill_bytes";
+
+  /// If true, PartitionedOutput picks the compression codec of each page by
+  /// the type of its columns and the observed compression instead of using
+  /// the codec of the OutputBufferManager. The pages can only be read by
+  /// Velox.
+  static constexpr const char* kShuffleAdaptiveCompression =
+      "shuffle_adaptive_compression";
+
+  /// Maximum CPU cost in nanoseconds per input byte of the ZSTD compression
+  /// of string pages with shuffle_adaptive_compression. More expensive string
+  /// pages are compressed with LZ4. 0 means no limit.
+  static constexpr const char* kShuffleCompressionMaxNanosPerByte =
+      "shuffle_compression_max_nanos_per_byte";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -172,19 +298,34 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If true, TableScan and HashProbe try fractions of their output batch
+  /// size down to 1/16 at runtime and keep the one with the least CPU time
+  /// per row in the rest of their pipeline. The picked size is reported in
+  /// the 'adaptiveOutputBatchRows' runtime stat of the operator.
+  static constexpr const char* kAdaptiveOutputBatchSize =
+      "adaptive_output_batch_size";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
   static constexpr const char* kTableScanGetOutputTimeLimitMs =
       "table_scan_getoutput_time_limit_ms";
 
+  /// If true, a TableScan followed by a Project, with an optional Filter in
+  /// between, reads only the subfields of its ROW columns that the Project
+  /// and Filter dereference. Applies to columns that are not otherwise used
+  /// as a whole and have no required subfields in the plan.
+  static constexpr const char* kTableScanSubfieldPruningEnabled =
+      "table_scan_subfield_pruning_enabled";
+
   /// If false, the 'group by' code is forced to use generic hash mode
   /// hashtable.
   static constexpr const char* kHashAdaptivityEnabled =
       "hash_adaptivity_enabled";
 
   /// If true, the conjunction expression can reorder inputs based on the time
-  /// taken to calculate them.
+  /// taken to calculate them. Table scans likewise reorder the filters pushed
+  /// into the file readers.
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
       "adaptive_filter_reordering_enabled";
 
@@ -238,6 +379,14 @@ class QueryConfig {
   /// io and cpu resources.
   static constexpr const char* kMaxSpillLevel = "max_spill_level";
 
+  /// When a spilled hash join restores its next spilled partition, it also
+  /// restores the other spilled partitions of the same spill level as long as
+  /// their total spilled size stays within this many bytes, so that several
+  /// small partitions are joined in one pass. 0 restores one partition at a
+  /// time.
+  static constexpr const char* kJoinSpillRestoreMergeBytes =
+      "join_spill_restore_merge_bytes";
+
   /// The max allowed spill file size. If it is zero, then there is no limit.
   static constexpr const char* kMaxSpillFileSize = "max_spill_file_size";
 
@@ -262,6 +411,54 @@ class QueryConfig {
   static constexpr const char* kSpillFileCreateConfig =
       "spill_file_create_config";
 
+  /// If true, the spill data of aggregation and order by whose columns all
+  /// have a fixed width is written uncompressed in a row-major layout and
+  /// memory mapped on read instead of being serialized as PrestoPages.
+  static constexpr const char* kSpillRowFormatEnabled =
+      "spill_row_format_enabled";
+
+  /// If true and the spill executor is set, a spill writer writes a buffer to
+  /// its file on the spill executor while it serializes the next one. The
+  /// spilling thread waits for the previous write before issuing the next, so
+  /// there is at most one write in flight per spill partition.
+  static constexpr const char* kSpillAsyncWriteEnabled =
+      "spill_async_write_enabled";
+
+  /// If true, the string columns of a spill write buffer with few distinct
+  /// values are written as dictionaries, so each distinct value is written
+  /// once per buffer instead of once per row.
+  static constexpr const char* kSpillDictionaryEncodingEnabled =
+      "spill_dictionary_encoding_enabled";
+
+  /// The max number of sorted spill files that order by and window merge at
+  /// once. If the spilled data has more files, they are first merged in
+  /// groups of this many files into larger files, in parallel on the spill
+  /// executor if it is set. 0 means no limit.
+  static constexpr const char* kSpillMergeFanIn = "spill_merge_fan_in";
+
+  /// If true, spill files are written with CRC32 checksums that are verified
+  /// on read, so that a corrupt or truncated spill file fails the query
+  /// instead of producing wrong results.
+  static constexpr const char* kSpillChecksumEnabled = "spill_checksum_enabled";
+
+  /// If true, a hash join that needed recursive spilling records the number
+  /// of spill partition bits it used in a process-wide history keyed by the
+  /// plan of the join. The next run of the same plan starts spilling with that
+  /// many partition bits instead of repartitioning its spilled data again.
+  static constexpr const char* kSpillHistoryEnabled = "spill_history_enabled";
+
+  /// If true, the spill writer picks the codec of each serialized page
+  /// instead of using spill_compression_codec for all of them. See
+  /// shuffle_adaptive_compression.
+  static constexpr const char* kSpillAdaptiveCompression =
+      "spill_adaptive_compression";
+
+  /// Maximum CPU cost in nanoseconds per input byte of the ZSTD compression
+  /// of string pages with spill_adaptive_compression. More expensive string
+  /// pages are compressed with LZ4. 0 means no limit.
+  static constexpr const char* kSpillCompressionMaxNanosPerByte =
+      "spill_compression_max_nanos_per_byte";
+
   /// Default offset spill start partition bit.
   static constexpr const char* kSpillStartPartitionBit =
       "spiller_start_partition_bit";
@@ -321,11 +518,40 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// The maximum size in bytes of a Bloom filter that the hash build makes
+  /// from the build side keys for the hash probe to push down to the probe
+  /// side table scan. Bloom filters are made for integer keys that have no
+  /// exact dynamic filter, e.g. because they have too many distinct values.
+  /// 0 disables these filters.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The minimum number of table entries per thread that makes the rehash
+  /// of a growing aggregation hash table run in parallel on the query
+  /// executor. 0 disables the parallel rehash.
+  static constexpr const char* kMinTableRowsForParallelAggregationRehash =
+      "min_table_rows_for_parallel_aggregation_rehash";
+
+  /// A build side key of an inner or left hash join with at least this many
+  /// rows is a skewed key. The probe rows with skewed keys are shared among
+  /// the HashProbe operators of the join so that the output of these keys is
+  /// not produced by one Driver only. 0 disables the detection. Does not apply
+  /// if spilling is enabled for the join.
+  static constexpr const char* kJoinSkewedKeyMinRows =
+      "join_skewed_key_min_rows";
+
+  /// If true, the build side of a nested loop join stores its BIGINT, INTEGER
+  /// and SMALLINT columns as BiasVectors with narrower values when the range
+  /// of the values allows. The probe side decompresses one build vector at a
+  /// time.
+  static constexpr const char* kNestedLoopJoinBuildCompression =
+      "nested_loop_join_build_compression";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -342,6 +568,13 @@ class QueryConfig {
   static constexpr const char* kEnableExpressionEvaluationCache =
       "enable_expression_evaluation_cache";
 
+  /// If true, the Driver returns the output of an operator to the vector pool
+  /// of the operator after the next operator has consumed it, so that the
+  /// operator can reuse its memory for the next batch. Requires
+  /// kEnableExpressionEvaluationCache.
+  static constexpr const char* kOperatorOutputRecycleEnabled =
+      "operator_output_recycle_enabled";
+
   // For a given shared subexpression, the maximum distinct sets of inputs we
   // cache results for. Lambdas can call the same expression with different
   // inputs many times, causing the results we cache to explode in size. Putting
@@ -349,16 +582,138 @@ class QueryConfig {
   static constexpr const char* kMaxSharedSubexprResultsCached =
       "max_shared_subexpr_results_cached";
 
+  /// Maximum number of distinct values of its input column for which a
+  /// deterministic function over a single string column keeps its results
+  /// across batches. Helps functions like regexp_extract over low cardinality
+  /// columns. 0 disables the cache.
+  static constexpr const char* kExprValueCacheMaxEntries =
+      "expression.value_cache_max_entries";
+
+  /// Maximum number of bytes retained by the cached results of one expression.
+  /// The cache is cleared when it exceeds this size.
+  static constexpr const char* kExprValueCacheMaxBytes =
+      "expression.value_cache_max_bytes";
+
+  /// Maximum number of bytes of parsed JSON documents that json_extract,
+  /// json_extract_scalar and json_size keep per thread, so that several calls
+  /// on the same column parse each document once. 0 disables the cache.
+  static constexpr const char* kJsonDocumentCacheMaxBytes =
+      "json.document_cache_max_bytes";
+
   /// Maximum number of splits to preload. Set to 0 to disable preloading.
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// Target time in ms that a TableScan driver waits for its next split to be
+  /// ready. If not zero, the number of splits preloaded per driver adapts
+  /// between 1 and max_split_preload_per_driver: it grows when getting a split
+  /// ready takes longer than the target and shrinks while splits are ready
+  /// well within it. The depth is also capped by the memory the query pool can
+  /// still reserve. Zero preloads a fixed max_split_preload_per_driver splits.
+  static constexpr const char* kSplitPreloadTargetWaitMs =
+      "split_preload_target_wait_ms";
+
+  /// Maximum number of splits per driver beyond the preloaded ones for which
+  /// only the file metadata is prefetched. This warms the footer cache of the
+  /// connector for queues of many small files. Set to 0 to disable.
+  static constexpr const char* kMaxSplitMetadataPrefetchPerDriver =
+      "max_split_metadata_prefetch_per_driver";
+
+  /// Maximum number of bytes that the readers of a TableScan driver load ahead
+  /// of the row group or stripe being read. The bound is shared by the split
+  /// being read and the preloaded splits of the driver. Applies to readers
+  /// that load ahead on an IO executor. Set to 0 for no bound.
+  static constexpr const char* kMaxPrefetchBytesPerDriver =
+      "max_prefetch_bytes_per_driver";
+
+  /// Maximum number of batches that an ArrowStream operator fetches from its
+  /// ArrowArrayStream and imports ahead of the driver on the query executor.
+  /// Set to 0 to call the stream on the driver thread.
+  static constexpr const char* kArrowStreamPrefetchBatches =
+      "arrow_stream_prefetch_batches";
+
+  /// If true, the Task gives a TableScan Driver a queued split with the same
+  /// ConnectorSplit::cacheAffinityKey as its previous split if there is one,
+  /// else a split whose key no other Driver reads. A split of another
+  /// Driver's key is taken only if there is no other choice. This improves
+  /// the reuse of cached data over handing out splits in arrival order.
+  static constexpr const char* kSplitAffinityScheduling =
+      "split_affinity_scheduling";
+
+  /// Priority of the AsyncDataCache entries of the query: "low", "normal" or
+  /// "high". Low priority entries are evicted first and are not saved to SSD
+  /// unless a higher priority query reads the same file group.
+  static constexpr const char* kCachePriority = "cache_priority";
+
+  /// Maximum bytes of AsyncDataCache entries created by the query. Entries
+  /// beyond the quota are still read but are the first to be evicted. 0 means
+  /// no limit.
+  static constexpr const char* kCacheQuotaBytes = "cache_quota_bytes";
+
+  /// Maximum serialized bytes of the output of a split that a
+  /// FragmentResultCache operator stores in the AsyncDataCache. The output of
+  /// larger splits is not cached.
+  static constexpr const char* kFragmentResultCacheMaxEntryBytes =
+      "fragment_result_cache_max_entry_bytes";
+
+  /// Priority of the query in memory arbitration. Under memory pressure the
+  /// queries of lower priority are spilled and aborted first, and a query is
+  /// never aborted to make room for one of lower priority.
+  static constexpr const char* kQueryMemoryPriority = "query_memory_priority";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// Relative share of the executor time the drivers of the query get from a
+  /// fair share exec::DriverScheduler when competing with other queries. Has
+  /// no effect without such a scheduler.
+  static constexpr const char* kDriverSchedulerWeight =
+      "driver_scheduler_weight";
+
+  /// If not zero, a driver whose operator blocks waiting for a producer, a
+  /// consumer or a split waits on thread for up to this many microseconds for
+  /// the operator to unblock before going off thread. Short waits then do not
+  /// pay for the re-enqueue and the cache misses of resuming on another
+  /// thread. If it is zero, a blocked driver always goes off thread.
+  static constexpr const char* kDriverBlockingWaitInPlaceUs =
+      "driver_blocking_wait_in_place_us";
+
+  /// If not zero, the maximum number of drivers a pipeline that reads table
+  /// scan splits can grow to while it runs. A driver is added when the queue
+  /// of splits is deeper than the number of running drivers and the executor
+  /// has idle threads. The added drivers finish when the queue runs empty.
+  /// Pipelines with a hash join probe qualify only if
+  /// kHashProbeFinishEarlyOnEmptyBuild is false. If it is zero, a pipeline
+  /// keeps the number of drivers it started with.
+  static constexpr const char* kMaxDynamicDriversPerPipeline =
+      "max_dynamic_drivers_per_pipeline";
+
+  /// Maximum number of bytes to use for the normalized key in prefix-sort. Use
+  /// 0 to disable prefix-sort.
+  static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
+      "prefixsort_normalized_key_max_bytes";
+
+  /// Minimum number of rows to use prefix-sort. The default value has been
+  /// derived using micro-benchmarking.
+  static constexpr const char* kPrefixSortMinRows = "prefixsort_min_rows";
+
+  /// If true, TopN and TopNRowNumber keep the normalized-key prefix of the
+  /// sorting keys next to each heap entry so that most heap comparisons are
+  /// word compares over fixed width bytes. The prefix size is capped by
+  /// 'prefixsort_normalized_key_max_bytes'.
+  static constexpr const char* kTopNPrefixSortEnabled =
+      "topn_prefix_sort_enabled";
+
+  /// Minimum number of non-sorting columns for OrderBy to store its scalar
+  /// payload columns in per-column chunks outside of the rows, so that sorting
+  /// and spilling touch only the sorting keys. Use 0 to keep all columns in
+  /// the rows.
+  static constexpr const char* kOrderByColumnarPayloadMinColumns =
+      "order_by_columnar_payload_min_columns";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
@@ -382,6 +737,29 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t abandonPartialAggregationSketchRows() const {
+    return get<int32_t>(kAbandonPartialAggregationSketchRows, 0);
+  }
+
+  bool partialAggregationClusteredFlush() const {
+    return get<bool>(kPartialAggregationClusteredFlush, false);
+  }
+
+  int32_t partialAggregationFlushQueryMemoryPct() const {
+    const auto pct = get<int32_t>(kPartialAggregationFlushQueryMemoryPct, 0);
+    VELOX_USER_CHECK_GE(pct, 0);
+    VELOX_USER_CHECK_LE(pct, 100);
+    return pct;
+  }
+
+  bool hashAggregationPartitionedMerge() const {
+    return get<bool>(kHashAggregationPartitionedMerge, false);
+  }
+
+  bool hashAggregationDistinctDedup() const {
+    return get<bool>(kHashAggregationDistinctDedup, false);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -390,6 +768,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinPct, 80);
   }
 
+  bool windowAggregateSegmentTreeEnabled() const {
+    return get<bool>(kWindowAggregateSegmentTreeEnabled, true);
+  }
+
   uint64_t maxSpillRunRows() const {
     static constexpr uint64_t kDefault = 12UL << 20;
     return get<uint64_t>(kMaxSpillRunRows, kDefault);
@@ -411,6 +793,14 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  bool shuffleAdaptiveCompression() const {
+    return get<bool>(kShuffleAdaptiveCompression, false);
+  }
+
+  double shuffleCompressionMaxNanosPerByte() const {
+    return get<double>(kShuffleCompressionMaxNanosPerByte, 0);
+  }
+
   /// Returns the maximum size in bytes for the task's buffered output.
   ///
   /// The producer Drivers are blocked when the buffered size exceeds
@@ -421,6 +811,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
   }
 
+  uint64_t maxOutputBufferSpillBytes() const {
+    return get<uint64_t>(kMaxOutputBufferSpillBytes, 0);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
@@ -431,11 +825,27 @@ class QueryConfig {
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
   }
 
+  bool exchangeZeroCopyDeserialization() const {
+    return get<bool>(kExchangeZeroCopyDeserialization, false);
+  }
+
   uint64_t maxMergeExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 128UL << 20;
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
   }
 
+  uint32_t mergeExchangePrefetchSources() const {
+    return get<uint32_t>(kMergeExchangePrefetchSources, 0);
+  }
+
+  bool sharedHashTableEnabled() const {
+    return get<bool>(kSharedHashTableEnabled, false);
+  }
+
+  bool groupingSetsPreAggregationEnabled() const {
+    return get<bool>(kGroupingSetsPreAggregationEnabled, false);
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -449,10 +859,18 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  bool adaptiveOutputBatchSize() const {
+    return get<bool>(kAdaptiveOutputBatchSize, false);
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
 
+  bool tableScanSubfieldPruningEnabled() const {
+    return get<bool>(kTableScanSubfieldPruningEnabled, false);
+  }
+
   bool hashAdaptivityEnabled() const {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
@@ -491,6 +909,10 @@ class QueryConfig {
     return get<bool>(kExprEvalSimplified, false);
   }
 
+  bool exprFusedKernelsEnabled() const {
+    return get<bool>(kExprFusedKernelsEnabled, false);
+  }
+
   /// Returns true if spilling is enabled.
   bool spillEnabled() const {
     return get<bool>(kSpillEnabled, false);
@@ -542,6 +964,10 @@ class QueryConfig {
     return get<int32_t>(kMaxSpillLevel, 1);
   }
 
+  uint64_t joinSpillRestoreMergeBytes() const {
+    return get<uint64_t>(kJoinSpillRestoreMergeBytes, 0);
+  }
+
   /// Returns the start partition bit which is used with
   /// 'kJoinSpillPartitionBits' or 'kAggregationSpillPartitionBits' together to
   /// calculate the spilling partition number for join spill or aggregation
@@ -602,6 +1028,38 @@ class QueryConfig {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
 
+  bool spillRowFormatEnabled() const {
+    return get<bool>(kSpillRowFormatEnabled, false);
+  }
+
+  bool spillAsyncWriteEnabled() const {
+    return get<bool>(kSpillAsyncWriteEnabled, false);
+  }
+
+  bool spillDictionaryEncodingEnabled() const {
+    return get<bool>(kSpillDictionaryEncodingEnabled, false);
+  }
+
+  uint32_t spillMergeFanIn() const {
+    return get<uint32_t>(kSpillMergeFanIn, 0);
+  }
+
+  bool spillChecksumEnabled() const {
+    return get<bool>(kSpillChecksumEnabled, false);
+  }
+
+  bool spillHistoryEnabled() const {
+    return get<bool>(kSpillHistoryEnabled, false);
+  }
+
+  bool spillAdaptiveCompression() const {
+    return get<bool>(kSpillAdaptiveCompression, false);
+  }
+
+  double spillCompressionMaxNanosPerByte() const {
+    return get<double>(kSpillCompressionMaxNanosPerByte, 0);
+  }
+
   /// Returns the minimal available spillable memory reservation in percentage
   /// of the current memory usage. Suppose the current memory usage size of M,
   /// available memory reservation size of N and min reservation percentage of
@@ -667,10 +1125,22 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  uint32_t exprProfileSamplingInterval() const {
+    return get<uint32_t>(kExprProfileSamplingInterval, 0);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  uint32_t operatorPerfCounterSamplingInterval() const {
+    return get<uint32_t>(kOperatorPerfCounterSamplingInterval, 0);
+  }
+
+  uint32_t taskTimelineCapacity() const {
+    return get<uint32_t>(kTaskTimelineCapacity, 0);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -684,10 +1154,26 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, true);
   }
 
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint32_t minTableRowsForParallelAggregationRehash() const {
+    return get<uint32_t>(kMinTableRowsForParallelAggregationRehash, 0);
+  }
+
+  uint64_t joinSkewedKeyMinRows() const {
+    return get<uint64_t>(kJoinSkewedKeyMinRows, 0);
+  }
+
+  bool nestedLoopJoinBuildCompression() const {
+    return get<bool>(kNestedLoopJoinBuildCompression, false);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -696,6 +1182,10 @@ class QueryConfig {
     return get<bool>(kEnableExpressionEvaluationCache, true);
   }
 
+  bool operatorOutputRecycleEnabled() const {
+    return get<bool>(kOperatorOutputRecycleEnabled, false);
+  }
+
   uint32_t maxSharedSubexprResultsCached() const {
     // 10 was chosen as a default as there are cases where a shared
     // subexpression can be called in 2 different places and a particular
@@ -712,14 +1202,91 @@ class QueryConfig {
     return get<uint32_t>(kMaxSharedSubexprResultsCached, 10);
   }
 
+  uint32_t exprValueCacheMaxEntries() const {
+    return get<uint32_t>(kExprValueCacheMaxEntries, 0);
+  }
+
+  uint64_t exprValueCacheMaxBytes() const {
+    return get<uint64_t>(kExprValueCacheMaxBytes, 1 << 20);
+  }
+
+  uint64_t jsonDocumentCacheMaxBytes() const {
+    return get<uint64_t>(kJsonDocumentCacheMaxBytes, 4 << 20);
+  }
+
   int32_t maxSplitPreloadPerDriver() const {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  uint64_t splitPreloadTargetWaitMs() const {
+    return get<uint64_t>(kSplitPreloadTargetWaitMs, 0);
+  }
+
+  int32_t maxSplitMetadataPrefetchPerDriver() const {
+    return get<int32_t>(kMaxSplitMetadataPrefetchPerDriver, 0);
+  }
+
+  uint64_t maxPrefetchBytesPerDriver() const {
+    return get<uint64_t>(kMaxPrefetchBytesPerDriver, 0);
+  }
+
+  uint32_t arrowStreamPrefetchBatches() const {
+    return get<uint32_t>(kArrowStreamPrefetchBatches, 0);
+  }
+
+  bool splitAffinityScheduling() const {
+    return get<bool>(kSplitAffinityScheduling, false);
+  }
+
+  std::string cachePriority() const {
+    return get<std::string>(kCachePriority, "normal");
+  }
+
+  uint64_t cacheQuotaBytes() const {
+    return get<uint64_t>(kCacheQuotaBytes, 0);
+  }
+
+  uint64_t fragmentResultCacheMaxEntryBytes() const {
+    static constexpr uint64_t kDefault = 16UL << 20;
+    return get<uint64_t>(kFragmentResultCacheMaxEntryBytes, kDefault);
+  }
+
+  int32_t queryMemoryPriority() const {
+    return get<int32_t>(kQueryMemoryPriority, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  int32_t driverSchedulerWeight() const {
+    return get<int32_t>(kDriverSchedulerWeight, 1);
+  }
+
+  uint32_t driverBlockingWaitInPlaceUs() const {
+    return get<uint32_t>(kDriverBlockingWaitInPlaceUs, 0);
+  }
+
+  uint32_t maxDynamicDriversPerPipeline() const {
+    return get<uint32_t>(kMaxDynamicDriversPerPipeline, 0);
+  }
+
+  uint32_t prefixSortNormalizedKeyMaxBytes() const {
+    return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
+  }
+
+  uint32_t prefixSortMinRows() const {
+    return get<uint32_t>(kPrefixSortMinRows, 130);
+  }
+
+  bool topNPrefixSortEnabled() const {
+    return get<bool>(kTopNPrefixSortEnabled, false);
+  }
+
+  uint32_t orderByColumnarPayloadMinColumns() const {
+    return get<uint32_t>(kOrderByColumnarPayloadMinColumns, 0);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
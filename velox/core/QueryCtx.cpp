@@ -16,6 +16,7 @@
 
 #include "velox/core/QueryCtx.h"
 #include "velox/common/base/SpillConfig.h"
+#include "velox/common/base/SuccinctPrinter.h"
 
 namespace facebook::velox::core {
 
@@ -56,6 +57,18 @@ QueryCtx::QueryCtx(
       pool_(std::move(pool)),
       queryConfig_{std::move(queryConfig)} {
   initPool(queryId);
+  initCacheQuota();
+}
+
+void QueryCtx::initCacheQuota() {
+  const auto priority =
+      cache::cachePriorityFromName(queryConfig_.cachePriority());
+  const auto quotaBytes = queryConfig_.cacheQuotaBytes();
+  if (priority == cache::CachePriority::kNormal && quotaBytes == 0) {
+    cacheQuota_ = nullptr;
+    return;
+  }
+  cacheQuota_ = std::make_shared<cache::CacheQuota>(priority, quotaBytes);
 }
 
 /*static*/ std::string QueryCtx::generatePoolName(const std::string& queryId) {
@@ -84,6 +97,48 @@ void QueryCtx::updateSpilledBytesAndCheckLimit(uint64_t bytes) {
   }
 }
 
+std::string QueryResourceUsage::Snapshot::toString() const {
+  return fmt::format(
+      "cpu {}, memory peak {} average {}, read memory {} ssd {} storage {}, "
+      "spilled {}, exchange input {} output {}",
+      succinctNanos(cpuNanos),
+      succinctBytes(peakMemoryBytes),
+      succinctBytes(averageMemoryBytes),
+      succinctBytes(ramReadBytes),
+      succinctBytes(ssdReadBytes),
+      succinctBytes(storageReadBytes),
+      succinctBytes(spilledBytes),
+      succinctBytes(exchangeInputBytes),
+      succinctBytes(exchangeOutputBytes));
+}
+
+QueryResourceUsage::Snapshot QueryResourceUsage::snapshot() const {
+  Snapshot snapshot;
+  snapshot.cpuNanos = cpuNanos_.load(std::memory_order_relaxed);
+  const auto numMemorySamples =
+      numMemorySamples_.load(std::memory_order_relaxed);
+  if (numMemorySamples > 0) {
+    snapshot.averageMemoryBytes =
+        memorySampleBytes_.load(std::memory_order_relaxed) / numMemorySamples;
+  }
+  snapshot.ramReadBytes = ramReadBytes_.load(std::memory_order_relaxed);
+  snapshot.ssdReadBytes = ssdReadBytes_.load(std::memory_order_relaxed);
+  snapshot.storageReadBytes =
+      storageReadBytes_.load(std::memory_order_relaxed);
+  snapshot.exchangeInputBytes =
+      exchangeInputBytes_.load(std::memory_order_relaxed);
+  snapshot.exchangeOutputBytes =
+      exchangeOutputBytes_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+QueryResourceUsage::Snapshot QueryCtx::resourceUsageSnapshot() const {
+  auto snapshot = resourceUsage_.snapshot();
+  snapshot.peakMemoryBytes = pool_->peakBytes();
+  snapshot.spilledBytes = numSpilledBytes_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
 std::unique_ptr<memory::MemoryReclaimer> QueryCtx::MemoryReclaimer::create(
     QueryCtx* queryCtx,
     memory::MemoryPool* pool) {
@@ -108,6 +163,14 @@ uint64_t QueryCtx::MemoryReclaimer::reclaim(
   return memory::MemoryReclaimer::reclaim(pool, targetBytes, maxWaitMs, stats);
 }
 
+int32_t QueryCtx::MemoryReclaimer::priority() const {
+  auto queryCtx = ensureQueryCtx();
+  if (queryCtx == nullptr) {
+    return 0;
+  }
+  return queryCtx->queryConfig().queryMemoryPriority();
+}
+
 bool QueryCtx::checkUnderArbitration(ContinueFuture* future) {
   VELOX_CHECK_NOT_NULL(future);
   std::lock_guard<std::mutex> l(mutex_);
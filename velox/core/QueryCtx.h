@@ -18,6 +18,7 @@
 
 #include <folly/Executor.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/common/base/Scratch.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/core/QueryConfig.h"
@@ -26,6 +27,74 @@
 
 namespace facebook::velox::core {
 
+/// Running totals of the resources used by the tasks of a query in this
+/// process. Updated by drivers and operators with relaxed atomic adds and read
+/// with QueryCtx::resourceUsageSnapshot(), which is cheap enough to be polled
+/// by a scheduler for admission control or billing while the query runs.
+class QueryResourceUsage {
+ public:
+  struct Snapshot {
+    /// Thread CPU time of the drivers of the query.
+    uint64_t cpuNanos{0};
+    /// Peak memory of the query pool.
+    uint64_t peakMemoryBytes{0};
+    /// Average of the memory of the query pool sampled at the end of each
+    /// driver run.
+    uint64_t averageMemoryBytes{0};
+    /// Bytes read by table scans from the memory cache, the SSD cache and
+    /// storage.
+    uint64_t ramReadBytes{0};
+    uint64_t ssdReadBytes{0};
+    uint64_t storageReadBytes{0};
+    /// Bytes written to spill files.
+    uint64_t spilledBytes{0};
+    /// Serialized bytes received by exchanges and sent by partitioned
+    /// outputs.
+    uint64_t exchangeInputBytes{0};
+    uint64_t exchangeOutputBytes{0};
+
+    std::string toString() const;
+  };
+
+  void addCpuNanos(uint64_t nanos) {
+    cpuNanos_.fetch_add(nanos, std::memory_order_relaxed);
+  }
+
+  void addMemorySample(uint64_t bytes) {
+    memorySampleBytes_.fetch_add(bytes, std::memory_order_relaxed);
+    numMemorySamples_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void
+  addReadBytes(uint64_t ramBytes, uint64_t ssdBytes, uint64_t storageBytes) {
+    ramReadBytes_.fetch_add(ramBytes, std::memory_order_relaxed);
+    ssdReadBytes_.fetch_add(ssdBytes, std::memory_order_relaxed);
+    storageReadBytes_.fetch_add(storageBytes, std::memory_order_relaxed);
+  }
+
+  void addExchangeInputBytes(uint64_t bytes) {
+    exchangeInputBytes_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void addExchangeOutputBytes(uint64_t bytes) {
+    exchangeOutputBytes_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  /// Returns the totals. 'peakMemoryBytes' and 'spilledBytes' are not tracked
+  /// here and are left 0.
+  Snapshot snapshot() const;
+
+ private:
+  std::atomic<uint64_t> cpuNanos_{0};
+  std::atomic<uint64_t> memorySampleBytes_{0};
+  std::atomic<uint64_t> numMemorySamples_{0};
+  std::atomic<uint64_t> ramReadBytes_{0};
+  std::atomic<uint64_t> ssdReadBytes_{0};
+  std::atomic<uint64_t> storageReadBytes_{0};
+  std::atomic<uint64_t> exchangeInputBytes_{0};
+  std::atomic<uint64_t> exchangeOutputBytes_{0};
+};
+
 class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
  public:
   ~QueryCtx() {
@@ -59,6 +128,13 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
     return cache_;
   }
 
+  /// The AsyncDataCache priority and byte quota of the query from
+  /// QueryConfig::kCachePriority and kCacheQuotaBytes. nullptr if the priority
+  /// is normal and there is no quota.
+  const std::shared_ptr<cache::CacheQuota>& cacheQuota() const {
+    return cacheQuota_;
+  }
+
   folly::Executor* executor() const {
     return executor_;
     ;
@@ -85,6 +161,7 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   void testingOverrideConfigUnsafe(
       std::unordered_map<std::string, std::string>&& values) {
     this->queryConfig_.testingOverrideConfigUnsafe(std::move(values));
+    initCacheQuota();
   }
 
   // Overrides the previous connector-specific configuration. Note that this
@@ -113,6 +190,16 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   /// exceeds the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Returns the accumulator of the resources used by the query, updated by
+  /// its drivers and operators.
+  QueryResourceUsage& resourceUsage() {
+    return resourceUsage_;
+  }
+
+  /// Returns the resources used by the query so far. Thread-safe and does not
+  /// take locks besides reading the peak memory of the query pool.
+  QueryResourceUsage::Snapshot resourceUsageSnapshot() const;
+
   void testingOverrideMemoryPool(std::shared_ptr<memory::MemoryPool> pool) {
     pool_ = std::move(pool);
   }
@@ -154,6 +241,9 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
         uint64_t maxWaitMs,
         memory::MemoryReclaimer::Stats& stats) override;
 
+    /// Returns QueryConfig::queryMemoryPriority() of the query.
+    int32_t priority() const override;
+
    protected:
     MemoryReclaimer(
         const std::shared_ptr<QueryCtx>& queryCtx,
@@ -187,6 +277,9 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
     }
   }
 
+  // Sets 'cacheQuota_' from 'queryConfig_'.
+  void initCacheQuota();
+
   // Setup the memory reclaimer for arbitration if user provided memory pool
   // hasn't set it.
   void maybeSetReclaimer();
@@ -205,7 +298,9 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
       connectorSessionProperties_;
   std::shared_ptr<memory::MemoryPool> pool_;
   QueryConfig queryConfig_;
+  std::shared_ptr<cache::CacheQuota> cacheQuota_;
   std::atomic<uint64_t> numSpilledBytes_{0};
+  QueryResourceUsage resourceUsage_;
 
   mutable std::mutex mutex_;
   // Indicates if this query is under memory arbitration or not.
@@ -328,6 +423,13 @@ class ExecCtx {
     return exprEvalCacheEnabled_;
   }
 
+  /// Returns the arena for temporaries of expression evaluation. The
+  /// allocations made during the evaluation of a batch are released when the
+  /// EvalCtx of the batch is destroyed.
+  ScratchArena& scratchArena() {
+    return scratchArena_;
+  }
+
  private:
   // Pool for all Buffers for this thread.
   memory::MemoryPool* const pool_;
@@ -340,6 +442,7 @@ class ExecCtx {
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
   std::unique_ptr<VectorPool> vectorPool_;
+  ScratchArena scratchArena_;
 };
 
 } // namespace facebook::velox::core
@@ -42,6 +42,16 @@ struct udf_is_deterministic<
     util::detail::void_t<decltype(T::is_deterministic)>>
     : std::integral_constant<bool, T::is_deterministic> {};
 
+// Functions are not commutative unless specified explicitly.
+template <class T, class = void>
+struct udf_is_commutative : std::false_type {};
+
+template <class T>
+struct udf_is_commutative<
+    T,
+    util::detail::void_t<decltype(T::is_commutative)>>
+    : std::integral_constant<bool, T::is_commutative> {};
+
 // Most functions are producing ASCII results for ASCII inputs, but we assume
 // they are not unless specified explicitly.
 template <class T, class = void>
@@ -386,6 +396,7 @@ class ISimpleFunctionMetadata {
   virtual TypePtr tryResolveReturnType() const = 0;
   virtual std::string getName() const = 0;
   virtual bool isDeterministic() const = 0;
+  virtual bool isCommutative() const = 0;
   virtual bool defaultNullBehavior() const = 0;
   virtual uint32_t priority() const = 0;
   virtual const std::shared_ptr<exec::FunctionSignature> signature() const = 0;
@@ -458,6 +469,10 @@ class SimpleFunctionMetadata : public ISimpleFunctionMetadata {
     return udf_is_deterministic<Fun>();
   }
 
+  bool isCommutative() const final {
+    return udf_is_commutative<Fun>();
+  }
+
   bool defaultNullBehavior() const final {
     return defaultNullBehavior_;
   }
@@ -665,6 +680,7 @@ class UDFHolder {
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
 
   // Check which flavor of the call() method is provided by the UDF object. UDFs
   // are required to provide at least one of the following methods:
@@ -680,6 +696,7 @@ class UDFHolder {
   //
   // - bool|void callAscii(...)
   // - void initialize(...)
+  // - void callBatch(out*, const arg*..., int32_t size)
 
   // call():
   static constexpr bool udf_has_call_return_bool = util::has_method<
@@ -779,6 +796,17 @@ class UDFHolder {
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callBatch(): computes 'size' results at once from arrays of non-null
+  // arguments. Used instead of call() for flat inputs without nulls. Allows
+  // simple loops that the compiler can vectorize.
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      void,
+      exec_return_type*,
+      const exec_arg_type<TArgs>*...,
+      int32_t>::value;
+
   // initialize():
   static constexpr bool udf_has_initialize = util::has_method<
       Fun,
@@ -940,6 +968,14 @@ class UDFHolder {
     }
   }
 
+  FOLLY_ALWAYS_INLINE void callBatch(
+      exec_return_type* out,
+      const typename exec_resolver<TArgs>::in_type*... args,
+      int32_t size) {
+    static_assert(udf_has_callBatch);
+    instance_.callBatch(out, args..., size);
+  }
+
   // Helper functions to handle void vs bool return type.
 
   FOLLY_ALWAYS_INLINE Status callImpl(
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "folly/io/Cursor.h"
+#include "velox/common/io/AdaptiveIoController.h"
 #include "velox/dwio/common/BufferedInput.h"
 
 DEFINE_bool(wsVRLoad, false, "Use WS VRead API to load");
@@ -29,6 +30,24 @@ namespace facebook::velox::dwio::common {
 
 static_assert(std::is_move_constructible<BufferedInput>());
 
+// static
+io::ReaderOptions BufferedInput::adaptReaderOptions(
+    const io::ReaderOptions& options,
+    const ReadFileInputStream& input,
+    IoStatistics* ioStats) {
+  if (!options.adaptiveIoTuning()) {
+    return options;
+  }
+  auto adapted =
+      io::AdaptiveIoController::adapt(options, input.storagePerformance());
+  if (ioStats != nullptr) {
+    ioStats->adaptiveCoalesceDistance().increment(
+        adapted.maxCoalesceDistance());
+    ioStats->adaptiveLoadQuantum().increment(adapted.loadQuantum());
+  }
+  return adapted;
+}
+
 namespace {
 void copyIOBufToMemory(folly::IOBuf&& iobuf, folly::Range<char*> allocated) {
   folly::io::Cursor cursor(&iobuf);
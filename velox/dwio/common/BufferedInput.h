@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/io/Options.h"
 #include "velox/common/memory/AllocationPool.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/StreamIdentifier.h"
@@ -144,6 +145,14 @@ class BufferedInput {
   virtual uint64_t nextFetchSize() const;
 
  protected:
+  // Returns 'options' with the load quantum and coalesce distance adapted to
+  // the storage of 'input' if 'options' enables adaptive IO tuning. Records
+  // the chosen values in 'ioStats' if not nullptr.
+  static io::ReaderOptions adaptReaderOptions(
+      const io::ReaderOptions& options,
+      const ReadFileInputStream& input,
+      IoStatistics* ioStats);
+
   const std::shared_ptr<ReadFileInputStream> input_;
   memory::MemoryPool* const pool_;
 
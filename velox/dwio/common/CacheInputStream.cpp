@@ -215,7 +215,8 @@ void CacheInputStream::loadSync(const Region& region) {
     folly::SemiFuture<bool> cacheLoadWait(false);
     cache::RawFileCacheKey key{fileNum_, region.offset};
     clearCachePin();
-    pin_ = cache_->findOrCreate(key, region.length, &cacheLoadWait);
+    pin_ = cache_->findOrCreate(
+        key, region.length, &cacheLoadWait, bufferedInput_->cacheQuota());
     if (pin_.empty()) {
       VELOX_CHECK(cacheLoadWait.valid());
       uint64_t waitUs{0};
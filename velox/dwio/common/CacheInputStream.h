@@ -51,6 +51,11 @@ class CacheInputStream : public SeekableInputStream {
   std::string getName() const override;
   size_t positionSize() override;
 
+  std::optional<CachedFileLocation> cachedFileLocation(
+      uint64_t streamOffset) const override {
+    return CachedFileLocation{cache_, fileNum_, region_.offset + streamOffset};
+  }
+
   /// Returns a copy of 'this', ranging over the same bytes. The clone is
   /// initially positioned at the position of 'this' and can be moved
   /// independently within 'region_'.  This is used for first caching a range of
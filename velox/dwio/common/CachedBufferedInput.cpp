@@ -385,10 +385,12 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
       std::vector<CacheRequest*> requests,
-      int32_t maxCoalesceDistance)
+      int32_t maxCoalesceDistance,
+      std::shared_ptr<cache::CacheQuota> quota)
       : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
         input_(std::move(input)),
-        maxCoalesceDistance_(maxCoalesceDistance) {}
+        maxCoalesceDistance_(maxCoalesceDistance),
+        quota_(std::move(quota)) {}
 
   std::vector<CachePin> loadData(bool prefetch) override {
     std::vector<CachePin> pins;
@@ -401,10 +403,14 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             pin.checkedEntry()->setPrefetch(true);
           }
           pins.push_back(std::move(pin));
-        });
+        },
+        quota_);
     if (pins.empty()) {
       return pins;
     }
+    // If the file reads asynchronously, the batches are read in parallel.
+    const bool readAsync = input_->hasReadAsync();
+    std::vector<folly::SemiFuture<uint64_t>> asyncReads;
     auto stats = cache::readPins(
         pins,
         maxCoalesceDistance_,
@@ -415,14 +421,24 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          if (readAsync) {
+            asyncReads.push_back(
+                input_->readAsync(buffers, offset, LogType::FILE));
+          } else {
+            input_->read(buffers, offset, LogType::FILE);
+          }
         });
+    for (auto& result : folly::collectAll(std::move(asyncReads)).get()) {
+      result.throwUnlessValue();
+    }
     updateStats(stats, prefetch, false);
     return pins;
   }
 
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
+  // The quota of the query to which new entries are charged. nullptr if none.
+  const std::shared_ptr<cache::CacheQuota> quota_;
 };
 
 // Represents a CoalescedLoad from local SSD cache.
@@ -477,7 +493,8 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        options_.maxCoalesceDistance(),
+        options_.cacheQuota());
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
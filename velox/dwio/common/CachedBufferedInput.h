@@ -77,7 +77,8 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(
+            adaptReaderOptions(readerOptions, *input_, ioStats_.get())) {}
 
   CachedBufferedInput(
       std::shared_ptr<ReadFileInputStream> input,
@@ -96,7 +97,8 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(
+            adaptReaderOptions(readerOptions, *input_, ioStats_.get())) {}
 
   ~CachedBufferedInput() override {
     for (auto& load : allCoalescedLoads_) {
@@ -148,6 +150,11 @@ class CachedBufferedInput : public BufferedInput {
     return cache_;
   }
 
+  /// The quota to which new cache entries are charged. nullptr if none.
+  const std::shared_ptr<cache::CacheQuota>& cacheQuota() const {
+    return options_.cacheQuota();
+  }
+
   /// Returns the CoalescedLoad that contains the correlated loads for 'stream'
   /// or nullptr if none. Returns nullptr on all but first call for 'stream'
   /// since the load is to be triggered by the first access.
@@ -16,6 +16,8 @@
 
 #include "velox/dwio/common/ColumnLoader.h"
 
+#include <algorithm>
+
 #include "velox/common/process/TraceContext.h"
 
 namespace facebook::velox::dwio::common {
@@ -42,16 +44,68 @@ static void scatter(RowSet rows, vector_size_t resultSize, VectorPtr* result) {
 }
 } // namespace
 
+ColumnLoader::~ColumnLoader() {
+  if (prefetch_) {
+    prefetch_->close();
+  }
+}
+
+bool ColumnLoader::prefetch(RowSet rows, vector_size_t resultSize) {
+  auto* executor = structReader_->prefetchExecutor();
+  if (executor == nullptr || prefetch_ != nullptr || rows.empty() ||
+      version_ != structReader_->numReads() ||
+      fieldReader_->fileType().type()->kind() == TypeKind::ROW) {
+    // Structs are loaded into vectors allocated by LazyVector::load().
+    return false;
+  }
+  prefetchRows_.assign(rows.begin(), rows.end());
+  prefetchResultSize_ = resultSize;
+  prefetch_ = std::make_shared<AsyncSource<VectorPtr>>([this]() {
+    auto values = std::make_unique<VectorPtr>();
+    read(prefetchRows_, nullptr, prefetchResultSize_, values.get());
+    return values;
+  });
+  structReader_->addPrefetch(prefetch_);
+  executor->add([prefetch = prefetch_]() { prefetch->prepare(); });
+  return true;
+}
+
 void ColumnLoader::loadInternal(
     RowSet rows,
     ValueHook* hook,
     vector_size_t resultSize,
     VectorPtr* result) {
-  process::TraceContext trace("ColumnLoader::loadInternal");
   VELOX_CHECK_EQ(
       version_,
       structReader_->numReads(),
       "Loading LazyVector after the enclosing reader has moved");
+  if (!prefetch_) {
+    read(rows, hook, resultSize, result);
+    return;
+  }
+  VELOX_CHECK_NULL(hook, "A prefetched LazyVector cannot load into a hook");
+  VELOX_CHECK_EQ(resultSize, prefetchResultSize_);
+  VELOX_CHECK(
+      std::includes(
+          prefetchRows_.begin(),
+          prefetchRows_.end(),
+          rows.begin(),
+          rows.end()),
+      "Loading rows of a LazyVector that were not prefetched");
+  // The prefetched values are at the positions of 'prefetchRows_', which
+  // include 'rows'.
+  auto values = prefetch_->move();
+  prefetch_.reset();
+  VELOX_CHECK_NOT_NULL(values);
+  *result = std::move(*values);
+}
+
+void ColumnLoader::read(
+    RowSet rows,
+    ValueHook* hook,
+    vector_size_t resultSize,
+    VectorPtr* result) {
+  process::TraceContext trace("ColumnLoader::loadInternal");
   auto offset = structReader_->lazyVectorReadOffset();
   auto incomingNulls = structReader_->nulls();
   auto outputRows = structReader_->outputRows();
@@ -30,6 +30,13 @@ class ColumnLoader : public velox::VectorLoader {
         fieldReader_(fieldReader),
         version_(version) {}
 
+  ~ColumnLoader() override;
+
+  /// Starts reading 'rows' on the prefetch executor of the struct reader, if
+  /// it has one. Returns false if the reader has no prefetch executor or has
+  /// moved.
+  bool prefetch(RowSet rows, vector_size_t resultSize) override;
+
  protected:
   void loadInternal(
       RowSet rows,
@@ -38,12 +45,24 @@ class ColumnLoader : public velox::VectorLoader {
       VectorPtr* result) override;
 
  private:
+  void read(
+      RowSet rows,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result);
+
   SelectiveStructColumnReaderBase* structReader_;
   SelectiveColumnReader* fieldReader_;
   // This is checked against the version of 'structReader' on load. If
   // these differ, 'structReader' has been advanced since the creation
   // of 'this' and 'this' is no longer loadable.
   const uint64_t version_;
+
+  // The values of 'prefetchRows_' being read on the prefetch executor. Also
+  // referenced by 'structReader_', which waits for the read before moving.
+  std::shared_ptr<AsyncSource<VectorPtr>> prefetch_;
+  std::vector<vector_size_t> prefetchRows_;
+  vector_size_t prefetchResultSize_{0};
 };
 
 } // namespace facebook::velox::dwio::common
@@ -1475,6 +1475,13 @@ class DirectRleColumnVisitor
       int32_t* filterHits,
       T* values,
       int32_t& numValues) {
+    if constexpr (hasFilter && !hasHook && TFilter::deterministic) {
+      if (delta == 0) {
+        processRepeated<scatter>(
+            value, numRows, scatterRows, filterHits, values, numValues);
+        return;
+      }
+    }
     if (sizeof(T) == 8) {
       constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
       for (auto i = 0; i < numRows; i += kWidth) {
@@ -1511,6 +1518,29 @@ class DirectRleColumnVisitor
         values,
         numValues);
   }
+
+ private:
+  // Processes 'numRows' rows of a run that repeats 'value'. The filter is
+  // evaluated once for the run and the rows either all pass or all fail.
+  template <bool scatter>
+  void processRepeated(
+      T value,
+      int32_t numRows,
+      const int32_t* scatterRows,
+      int32_t* filterHits,
+      T* values,
+      int32_t& numValues) {
+    if (velox::common::applyFilter(super::filter_, value)) {
+      const auto* begin =
+          (scatter ? scatterRows : super::rows_) + super::rowIndex_;
+      std::copy(begin, begin + numRows, filterHits + numValues);
+      if constexpr (!super::kFilterOnly) {
+        std::fill(values + numValues, values + numValues + numRows, value);
+      }
+      numValues += numRows;
+    }
+    super::rowIndex_ += numRows;
+  }
 };
 
 template <bool kEncodingHasNulls>
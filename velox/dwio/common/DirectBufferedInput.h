@@ -122,7 +122,8 @@ class DirectBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(
+            adaptReaderOptions(readerOptions, *input_, ioStats_.get())) {}
 
   ~DirectBufferedInput() override {
     for (auto& load : coalescedLoads_) {
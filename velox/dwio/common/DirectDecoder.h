@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/HotCounters.h"
 #include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
 
@@ -59,10 +60,12 @@ class DirectDecoder : public IntDecoder<isSigned> {
     if constexpr (!std::is_same_v<typename Visitor::DataType, int128_t>) {
       if (useFastPath &&
           dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+        VELOX_HOT_COUNTER_INC(kSelectiveFastPath);
         fastPath<hasNulls>(nulls, visitor);
         return;
       }
     }
+    VELOX_HOT_COUNTER_INC(kSelectiveSlowPath);
     int32_t current = visitor.start();
     this->template skip<hasNulls>(current, 0, nulls);
     const bool allowNulls = hasNulls && visitor.allowNulls();
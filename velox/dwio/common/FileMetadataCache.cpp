@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include "velox/common/base/BitUtil.h"
+
+DEFINE_uint64(
+    velox_file_metadata_cache_bytes,
+    0,
+    "Capacity of the process-wide cache of parsed DWRF, ORC and Parquet "
+    "footers. 0 disables the cache.");
+
+namespace facebook::velox::dwio::common {
+
+size_t FileMetadataCacheKeyHasher::operator()(
+    const FileMetadataCacheKey& key) const {
+  return bits::hashMix(
+      bits::hashMix(
+          std::hash<std::string>()(key.fileName),
+          bits::hashMix(key.fileSize, key.modificationTime)),
+      static_cast<uint64_t>(key.fileFormat));
+}
+
+// static
+FileMetadataCache& FileMetadataCache::instance() {
+  static FileMetadataCache cache;
+  return cache;
+}
+
+// static
+std::optional<FileMetadataCacheKey> FileMetadataCache::makeKey(
+    const ReadFile& file,
+    FileFormat fileFormat,
+    std::optional<int64_t> modificationTime) {
+  if (!enabled() || !modificationTime.has_value()) {
+    return std::nullopt;
+  }
+  auto fileName = std::string(file.getName());
+  // Files without a path, e.g. in memory files, have a placeholder name.
+  if (fileName.empty() || fileName[0] == '<') {
+    return std::nullopt;
+  }
+  return FileMetadataCacheKey{
+      std::move(fileName),
+      file.size(),
+      modificationTime.value(),
+      fileFormat};
+}
+
+std::shared_ptr<const void> FileMetadataCache::getOrLoad(
+    const FileMetadataCacheKey& key,
+    const Loader& loader) {
+  std::shared_ptr<folly::SharedPromise<std::shared_ptr<const void>>> promise;
+  folly::SemiFuture<std::shared_ptr<const void>> loadFuture =
+      folly::SemiFuture<std::shared_ptr<const void>>::makeEmpty();
+  {
+    auto state = state_.wlock();
+    auto it = state->entries.find(key);
+    if (it != state->entries.end()) {
+      ++numHits_;
+      state->lru.splice(state->lru.begin(), state->lru, it->second);
+      return it->second->value;
+    }
+    auto pendingIt = state->pending.find(key);
+    if (pendingIt != state->pending.end()) {
+      ++numWaits_;
+      loadFuture = pendingIt->second->getSemiFuture();
+    } else {
+      ++numMisses_;
+      promise = std::make_shared<
+          folly::SharedPromise<std::shared_ptr<const void>>>();
+      state->pending.emplace(key, promise);
+    }
+  }
+  if (loadFuture.valid()) {
+    return std::move(loadFuture).get();
+  }
+
+  Loaded loaded;
+  try {
+    loaded = loader();
+  } catch (const std::exception&) {
+    state_.wlock()->pending.erase(key);
+    promise->setException(
+        folly::exception_wrapper(std::current_exception()));
+    throw;
+  }
+  auto value = loaded.value;
+  {
+    auto state = state_.wlock();
+    state->pending.erase(key);
+    insertLocked(*state, key, std::move(loaded));
+  }
+  promise->setValue(value);
+  return value;
+}
+
+// static
+void FileMetadataCache::insertLocked(
+    State& state,
+    const FileMetadataCacheKey& key,
+    Loaded loaded) {
+  const uint64_t maxBytes = FLAGS_velox_file_metadata_cache_bytes;
+  if (loaded.bytes > maxBytes || state.entries.count(key) > 0) {
+    return;
+  }
+  while (!state.lru.empty() && state.bytes + loaded.bytes > maxBytes) {
+    evictLastLocked(state);
+  }
+  if (!reserveLocked(state, state.bytes + loaded.bytes)) {
+    return;
+  }
+  state.lru.push_front(Entry{key, std::move(loaded.value), loaded.bytes});
+  state.entries.emplace(key, state.lru.begin());
+  state.bytes += loaded.bytes;
+}
+
+// static
+void FileMetadataCache::evictLastLocked(State& state) {
+  auto& last = state.lru.back();
+  state.bytes -= last.bytes;
+  state.entries.erase(last.key);
+  state.lru.pop_back();
+}
+
+// static
+bool FileMetadataCache::reserveLocked(State& state, uint64_t bytes) {
+  if (state.pool == nullptr) {
+    return true;
+  }
+  const uint64_t available =
+      std::max<int64_t>(state.pool->availableReservation(), 0);
+  if (bytes <= available) {
+    return true;
+  }
+  return state.pool->maybeReserve(bytes - available);
+}
+
+// static
+void FileMetadataCache::clearLocked(State& state) {
+  state.entries.clear();
+  state.lru.clear();
+  state.bytes = 0;
+  if (state.pool != nullptr) {
+    state.pool->release();
+  }
+}
+
+void FileMetadataCache::setMemoryPool(
+    std::shared_ptr<memory::MemoryPool> pool) {
+  auto state = state_.wlock();
+  clearLocked(*state);
+  state->pool = std::move(pool);
+}
+
+void FileMetadataCache::clear() {
+  clearLocked(*state_.wlock());
+  numHits_ = 0;
+  numMisses_ = 0;
+  numWaits_ = 0;
+}
+
+} // namespace facebook::velox::dwio::common
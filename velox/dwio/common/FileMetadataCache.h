@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <folly/futures/SharedPromise.h>
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+
+#include "velox/common/file/File.h"
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/dwio/common/Options.h"
+
+DECLARE_uint64(velox_file_metadata_cache_bytes);
+
+namespace facebook::velox::dwio::common {
+
+/// Identifies a file in FileMetadataCache. Files are assumed to be immutable
+/// for a given size and modification time.
+struct FileMetadataCacheKey {
+  std::string fileName;
+  uint64_t fileSize;
+  int64_t modificationTime;
+  FileFormat fileFormat;
+
+  bool operator==(const FileMetadataCacheKey& other) const {
+    return fileSize == other.fileSize &&
+        modificationTime == other.modificationTime &&
+        fileFormat == other.fileFormat && fileName == other.fileName;
+  }
+};
+
+struct FileMetadataCacheKeyHasher {
+  size_t operator()(const FileMetadataCacheKey& key) const;
+};
+
+/// Process-wide LRU cache of parsed file footers, shared by the readers of all
+/// splits of a file. The capacity is --velox_file_metadata_cache_bytes, 0
+/// disables the cache. Concurrent loads of the same file are single-flight:
+/// the first caller parses the footer and the others wait for its result. If
+/// a memory pool is set, the cached bytes are reserved from it and footers
+/// that do not fit in the reservation are not cached.
+class FileMetadataCache {
+ public:
+  /// A parsed footer and its memory footprint.
+  struct Loaded {
+    std::shared_ptr<const void> value;
+    uint64_t bytes;
+  };
+
+  using Loader = std::function<Loaded()>;
+
+  static FileMetadataCache& instance();
+
+  static bool enabled() {
+    return FLAGS_velox_file_metadata_cache_bytes > 0;
+  }
+
+  /// Returns the key of 'file' or std::nullopt if the cache is disabled, the
+  /// file has no name, e.g. an in-memory file, or 'modificationTime' is not
+  /// known. The size alone does not tell a file from one rewritten in place
+  /// with the same size.
+  static std::optional<FileMetadataCacheKey> makeKey(
+      const ReadFile& file,
+      FileFormat fileFormat,
+      std::optional<int64_t> modificationTime);
+
+  /// Returns the footer of 'key', calling 'loader' if it is not cached and no
+  /// other thread is loading it. The format in 'key' determines the type of
+  /// the value. Errors of 'loader' are thrown to all callers waiting for the
+  /// same key.
+  template <typename T>
+  std::shared_ptr<const T> get(
+      const FileMetadataCacheKey& key,
+      const std::function<std::pair<std::shared_ptr<const T>, uint64_t>()>&
+          loader) {
+    return std::static_pointer_cast<const T>(getOrLoad(key, [&]() {
+      auto [value, bytes] = loader();
+      return Loaded{std::move(value), bytes};
+    }));
+  }
+
+  /// Sets the pool from which the memory of cached footers is reserved.
+  /// Clears the cache.
+  void setMemoryPool(std::shared_ptr<memory::MemoryPool> pool);
+
+  void clear();
+
+  uint64_t numHits() const {
+    return numHits_;
+  }
+
+  uint64_t numMisses() const {
+    return numMisses_;
+  }
+
+  /// Number of lookups that waited for a concurrent load of the same key.
+  uint64_t numWaits() const {
+    return numWaits_;
+  }
+
+  size_t numEntries() const {
+    return state_.rlock()->entries.size();
+  }
+
+  uint64_t bytes() const {
+    return state_.rlock()->bytes;
+  }
+
+ private:
+  struct Entry {
+    FileMetadataCacheKey key;
+    std::shared_ptr<const void> value;
+    uint64_t bytes;
+  };
+
+  struct State {
+    // Most recently used first.
+    std::list<Entry> lru;
+    folly::F14FastMap<
+        FileMetadataCacheKey,
+        std::list<Entry>::iterator,
+        FileMetadataCacheKeyHasher>
+        entries;
+    // Loads in progress.
+    folly::F14FastMap<
+        FileMetadataCacheKey,
+        std::shared_ptr<folly::SharedPromise<std::shared_ptr<const void>>>,
+        FileMetadataCacheKeyHasher>
+        pending;
+    uint64_t bytes{0};
+    // If set, holds a reservation of at least 'bytes'. The reservation is not
+    // shrunk on eviction since it is bounded by the capacity.
+    std::shared_ptr<memory::MemoryPool> pool;
+  };
+
+  std::shared_ptr<const void> getOrLoad(
+      const FileMetadataCacheKey& key,
+      const Loader& loader);
+
+  // Adds 'loaded' for 'key', evicting least recently used entries to stay
+  // within capacity and the reservation from the pool.
+  static void insertLocked(
+      State& state,
+      const FileMetadataCacheKey& key,
+      Loaded loaded);
+
+  static void evictLastLocked(State& state);
+
+  // Returns true if 'state.pool' is not set or has a reservation of at least
+  // 'bytes'.
+  static bool reserveLocked(State& state, uint64_t bytes);
+
+  static void clearLocked(State& state);
+
+  folly::Synchronized<State> state_;
+  std::atomic<uint64_t> numHits_{0};
+  std::atomic<uint64_t> numMisses_{0};
+  std::atomic<uint64_t> numWaits_{0};
+};
+
+} // namespace facebook::velox::dwio::common
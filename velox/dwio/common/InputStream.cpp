@@ -65,7 +65,8 @@ ReadFileInputStream::ReadFileInputStream(
     const MetricsLogPtr& metricsLog,
     IoStatistics* stats)
     : InputStream(readFile->getName(), metricsLog, stats),
-      readFile_(std::move(readFile)) {}
+      readFile_(std::move(readFile)),
+      storagePerformance_(io::StoragePerformance::forPath(getName())) {}
 
 void ReadFileInputStream::read(
     void* buf,
@@ -80,6 +81,7 @@ void ReadFileInputStream::read(
     MicrosecondTimer timer(&readTimeUs);
     readData = readFile_->pread(offset, length, buf);
   }
+  storagePerformance_.record(length, readTimeUs);
   if (stats_) {
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime(readTimeUs * 1'000);
@@ -101,7 +103,13 @@ void ReadFileInputStream::read(
     LogType logType) {
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
-  const auto size = readFile_->preadv(offset, buffers);
+  uint64_t readTimeUs{0};
+  uint64_t size;
+  {
+    MicrosecondTimer timer(&readTimeUs);
+    size = readFile_->preadv(offset, buffers);
+  }
+  storagePerformance_.record(bufferSize, readTimeUs);
   VELOX_CHECK_EQ(
       size,
       bufferSize,
@@ -138,9 +146,11 @@ void ReadFileInputStream::vread(
   logRead(regions[0].offset, length, purpose);
   auto readStartMicros = getCurrentTimeMicro();
   readFile_->preadv(regions, iobufs);
+  const auto readTimeUs = getCurrentTimeMicro() - readStartMicros;
+  storagePerformance_.record(length, readTimeUs);
   if (stats_) {
     stats_->incRawBytesRead(length);
-    stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
+    stats_->incTotalScanTime(readTimeUs * 1000);
   }
 }
 
@@ -176,8 +176,15 @@ class ReadFileInputStream final : public InputStream {
     return readFile_;
   }
 
+  /// Performance model of the file system of 'this'. Synchronous reads are
+  /// recorded in it.
+  const io::StoragePerformance& storagePerformance() const {
+    return storagePerformance_;
+  }
+
  private:
   std::shared_ptr<velox::ReadFile> readFile_;
+  io::StoragePerformance& storagePerformance_;
 };
 
 } // namespace facebook::velox::dwio::common
@@ -451,6 +451,7 @@ class ReaderOptions : public io::ReaderOptions {
     filePreloadThreshold_ = other.filePreloadThreshold_;
     fileColumnNamesReadAsLowerCase_ = other.fileColumnNamesReadAsLowerCase_;
     useColumnNamesForColumnMapping_ = other.useColumnNamesForColumnMapping_;
+    fileModificationTime_ = other.fileModificationTime_;
     return *this;
   }
 
@@ -464,8 +465,8 @@ class ReaderOptions : public io::ReaderOptions {
         footerEstimatedSize_(other.footerEstimatedSize_),
         filePreloadThreshold_(other.filePreloadThreshold_),
         fileColumnNamesReadAsLowerCase_(other.fileColumnNamesReadAsLowerCase_),
-        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_) {
-  }
+        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_),
+        fileModificationTime_(other.fileModificationTime_) {}
 
   /// Sets the format of the file, such as "rc" or "dwrf". The default is
   /// "dwrf".
@@ -521,6 +522,13 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the modification time of the file. Part of the key of the file in
+  /// FileMetadataCache.
+  ReaderOptions& setFileModificationTime(int64_t modificationTime) {
+    fileModificationTime_ = modificationTime;
+    return *this;
+  }
+
   ReaderOptions& setIOExecutor(std::shared_ptr<folly::Executor> executor) {
     ioExecutor_ = std::move(executor);
     return *this;
@@ -565,6 +573,10 @@ class ReaderOptions : public io::ReaderOptions {
     return ioExecutor_;
   }
 
+  std::optional<int64_t> fileModificationTime() const {
+    return fileModificationTime_;
+  }
+
   bool fileColumnNamesReadAsLowerCase() const {
     return fileColumnNamesReadAsLowerCase_;
   }
@@ -599,6 +611,7 @@ class ReaderOptions : public io::ReaderOptions {
   uint64_t filePreloadThreshold_{kDefaultFilePreloadThreshold};
   bool fileColumnNamesReadAsLowerCase_{false};
   bool useColumnNamesForColumnMapping_{false};
+  std::optional<int64_t> fileModificationTime_;
   std::shared_ptr<folly::Executor> ioExecutor_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 };
@@ -617,6 +630,11 @@ struct WriterOptions {
   std::optional<uint8_t> parquetWriteTimestampUnit;
   std::optional<uint8_t> zlibCompressionLevel;
   std::optional<uint8_t> zstdCompressionLevel;
+  /// If set, the file formats that support it encode the columns of each
+  /// batch in parallel on this executor with up to
+  /// 'encodingParallelismFactor' threads.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
 };
 
 } // namespace facebook::velox::dwio::common
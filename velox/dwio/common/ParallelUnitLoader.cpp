@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ParallelUnitLoader.h"
+
+#include <atomic>
+#include <numeric>
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/MeasureTime.h"
+
+using facebook::velox::dwio::common::measureTimeIfCallback;
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+class ParallelUnitLoader : public UnitLoader {
+ public:
+  ParallelUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      folly::Executor* executor,
+      uint32_t maxUnitsInFlight,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback,
+      std::shared_ptr<io::PrefetchBudget> budget)
+      : loadUnits_{std::move(loadUnits)},
+        executor_{executor},
+        maxUnitsInFlight_{maxUnitsInFlight},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+        budget_{std::move(budget)},
+        loads_(loadUnits_.size()),
+        loaded_(loadUnits_.size()),
+        reservedBytes_(loadUnits_.size(), 0) {
+    for (auto& loaded : loaded_) {
+      loaded = false;
+    }
+  }
+
+  ~ParallelUnitLoader() override {
+    for (uint32_t unit = 0; unit < loadUnits_.size(); ++unit) {
+      if (loads_[unit]) {
+        loads_[unit]->close();
+        loads_[unit].reset();
+      }
+      releaseBudget(unit);
+    }
+  }
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK(unit < loadUnits_.size(), "Unit out of range");
+
+    const uint32_t windowEnd = std::min<uint64_t>(
+        loadUnits_.size(), static_cast<uint64_t>(unit) + maxUnitsInFlight_);
+    for (uint32_t other = 0; other < loadUnits_.size(); ++other) {
+      if (other < unit || other >= windowEnd) {
+        release(other);
+      }
+    }
+
+    if (loads_[unit]) {
+      auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+      loads_[unit]->move();
+      loads_[unit].reset();
+    } else if (!loaded_[unit]) {
+      auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+      loadUnits_[unit]->load();
+      loaded_[unit] = true;
+    }
+    releaseBudget(unit);
+
+    for (uint32_t next = unit + 1; next < windowEnd; ++next) {
+      if (!schedule(next)) {
+        break;
+      }
+    }
+    return *loadUnits_[unit];
+  }
+
+  void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t /* rowCount */)
+      override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LT(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LE(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+ private:
+  // Starts loading 'unit' on 'executor_' unless it is loaded or loading.
+  // Returns false if 'unit' is neither and does not fit in 'budget_'.
+  bool schedule(uint32_t unit) {
+    if (loaded_[unit] || loads_[unit]) {
+      return true;
+    }
+    // getIoSize() runs on the calling thread, so that a unit can do the setup
+    // that is not safe to run off thread there.
+    const auto ioSize = loadUnits_[unit]->getIoSize();
+    if (budget_) {
+      if (!budget_->tryReserve(ioSize)) {
+        return false;
+      }
+      reservedBytes_[unit] = ioSize;
+    }
+    loads_[unit] = std::make_shared<AsyncSource<bool>>([this, unit]() {
+      loadUnits_[unit]->load();
+      loaded_[unit] = true;
+      return std::make_unique<bool>(true);
+    });
+    executor_->add([load = loads_[unit]]() { load->prepare(); });
+    return true;
+  }
+
+  // Returns the bytes reserved for loading 'unit' ahead to 'budget_'.
+  void releaseBudget(uint32_t unit) {
+    if (reservedBytes_[unit] > 0) {
+      budget_->release(reservedBytes_[unit]);
+      reservedBytes_[unit] = 0;
+    }
+  }
+
+  // Cancels a pending load of 'unit' or waits for a running one, then unloads
+  // 'unit' if it was loaded.
+  void release(uint32_t unit) {
+    if (loads_[unit]) {
+      loads_[unit]->close();
+      loads_[unit].reset();
+    }
+    if (loaded_[unit]) {
+      loadUnits_[unit]->unload();
+      loaded_[unit] = false;
+    }
+    releaseBudget(unit);
+  }
+
+  const std::vector<std::unique_ptr<LoadUnit>> loadUnits_;
+  folly::Executor* const executor_;
+  const uint32_t maxUnitsInFlight_;
+  const std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  const std::shared_ptr<io::PrefetchBudget> budget_;
+  // Loads scheduled on 'executor_' and not yet waited for, indexed by unit.
+  std::vector<std::shared_ptr<AsyncSource<bool>>> loads_;
+  // True for the units whose load() has completed. Set from 'executor_'.
+  std::vector<std::atomic_bool> loaded_;
+  // Bytes of 'budget_' reserved by the units started ahead, indexed by unit.
+  std::vector<uint64_t> reservedBytes_;
+};
+
+} // namespace
+
+ParallelUnitLoaderFactory::ParallelUnitLoaderFactory(
+    folly::Executor* executor,
+    uint32_t maxUnitsInFlight,
+    std::function<void(std::chrono::high_resolution_clock::duration)>
+        blockedOnIoCallback,
+    std::shared_ptr<io::PrefetchBudget> budget)
+    : executor_{executor},
+      maxUnitsInFlight_{maxUnitsInFlight},
+      blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+      budget_{std::move(budget)} {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(maxUnitsInFlight_, 0);
+}
+
+std::unique_ptr<UnitLoader> ParallelUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+    uint64_t rowsToSkip) {
+  const auto totalRows = std::accumulate(
+      loadUnits.cbegin(), loadUnits.cend(), 0UL, [](uint64_t sum, auto& unit) {
+        return sum + unit->getNumRows();
+      });
+  VELOX_CHECK_LE(
+      rowsToSkip,
+      totalRows,
+      "Can only skip up to the past-the-end row of the file.");
+  return std::make_unique<ParallelUnitLoader>(
+      std::move(loadUnits),
+      executor_,
+      maxUnitsInFlight_,
+      blockedOnIoCallback_,
+      budget_);
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include <folly/Executor.h>
+
+#include "velox/common/io/PrefetchBudget.h"
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Loads up to 'maxUnitsInFlight' units starting at the requested one on
+/// 'executor', so that the IO and the decoding setup of upcoming units overlap
+/// with the consumption of the current one. A requested unit that has not been
+/// started on the executor is loaded on the calling thread. Units that fall
+/// out of the window are unloaded. LoadUnit::getIoSize() is called on the
+/// calling thread before a unit is started. LoadUnit::load() of different
+/// units must be safe to run concurrently with each other and with the
+/// consumer. If 'budget' is set, a unit after the requested one is started
+/// only if its getIoSize() fits in 'budget', and the bytes stay reserved until
+/// the unit is requested or unloaded. The units are started in order, so a
+/// unit that does not fit also holds back the ones after it.
+class ParallelUnitLoaderFactory
+    : public velox::dwio::common::UnitLoaderFactory {
+ public:
+  ParallelUnitLoaderFactory(
+      folly::Executor* executor,
+      uint32_t maxUnitsInFlight,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback,
+      std::shared_ptr<io::PrefetchBudget> budget = nullptr);
+
+  ~ParallelUnitLoaderFactory() override = default;
+
+  std::unique_ptr<velox::dwio::common::UnitLoader> create(
+      std::vector<std::unique_ptr<velox::dwio::common::LoadUnit>> loadUnits,
+      uint64_t rowsToSkip) override;
+
+ private:
+  folly::Executor* const executor_;
+  const uint32_t maxUnitsInFlight_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  const std::shared_ptr<io::PrefetchBudget> budget_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/Mutation.h"
@@ -199,6 +200,16 @@ class Reader {
    */
   virtual const std::shared_ptr<const TypeWithId>& typeWithId() const = 0;
 
+  /**
+   * Get the field ids of the top-level columns, in the order of rowType().
+   * Formats that store field ids, e.g. Parquet files written for Iceberg,
+   * override this.
+   * @return field ids, or std::nullopt if the file has none
+   */
+  virtual std::optional<std::vector<int32_t>> fieldIds() const {
+    return std::nullopt;
+  }
+
   /**
    * Create row reader object to fetch the data.
    * @param options Row reader options describing the data to fetch
@@ -33,6 +33,13 @@ ScanSpec* ScanSpec::getOrCreateChild(const Subfield& subfield) {
       container->children_.push_back(std::make_unique<ScanSpec>(*element));
       auto* child = container->children_.back().get();
       container->childByFieldName_[child->fieldName()] = child;
+      {
+        // Readers made after this must see the new child.
+        std::lock_guard<std::mutex> l(container->mutex_);
+        if (!container->stableChildren_.empty()) {
+          container->stableChildren_.push_back(child);
+        }
+      }
       container = child;
     }
   }
@@ -153,13 +160,48 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
     }
     VELOX_CHECK(found);
   }
+  // Children that only 'this' has, e.g. columns added for a single split, are
+  // kept after the ones that have adaptation.
+  for (auto& child : children_) {
+    if (child) {
+      childByFieldName_[child->fieldName_] = child.get();
+      newChildren.push_back(std::move(child));
+    }
+  }
   children_ = std::move(newChildren);
+  auto ownStableChildren = std::move(stableChildren_);
   stableChildren_.clear();
   for (auto& otherChild : other.stableChildren_) {
     auto child = childByName(otherChild->fieldName_);
     VELOX_CHECK(child);
     stableChildren_.push_back(child);
   }
+  if (!stableChildren_.empty()) {
+    for (auto* child : ownStableChildren) {
+      if (!other.childByName(child->fieldName_)) {
+        stableChildren_.push_back(child);
+      }
+    }
+  }
+}
+
+void ScanSpec::removeChild(const std::string& name) {
+  auto* child = childByName(name);
+  VELOX_CHECK_NOT_NULL(child, "No child {} to remove", name);
+  childByFieldName_.erase(name);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stableChildren_.erase(
+        std::remove(stableChildren_.begin(), stableChildren_.end(), child),
+        stableChildren_.end());
+  }
+  children_.erase(
+      std::remove_if(
+          children_.begin(),
+          children_.end(),
+          [&](const auto& other) { return other.get() == child; }),
+      children_.end());
+  hasFilter_.reset();
 }
 
 namespace {
@@ -380,6 +422,7 @@ std::string ScanSpec::toString() const {
 
 void ScanSpec::addFilter(const Filter& filter) {
   filter_ = filter_ ? filter_->mergeWith(&filter) : filter.clone();
+  selectivity_ = SelectivityInfo();
 }
 
 ScanSpec* ScanSpec::addField(const std::string& name, column_index_t channel) {
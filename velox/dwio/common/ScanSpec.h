@@ -69,6 +69,9 @@ class ScanSpec {
     filter_ = std::move(filter);
   }
 
+  // Merges 'filter' into 'filter_'. Clears the selectivity history, which
+  // describes the previous filter, so that the next reorder() ranks the merged
+  // filter by its own selectivity.
   void addFilter(const Filter&);
 
   void setMaxArrayElementsCount(vector_size_t count) {
@@ -267,8 +270,13 @@ class ScanSpec {
     }
   }
 
+  // Enables or disables reordering the filters of 'this' and its descendants
+  // by their observed selectivity.
   void setEnableFilterReorder(bool enableFilterReorder) {
     enableFilterReorder_ = enableFilterReorder;
+    for (auto& child : children_) {
+      child->setEnableFilterReorder(enableFilterReorder);
+    }
   }
 
   // Returns the child which produces values for 'channel'. Throws if not found.
@@ -294,6 +302,10 @@ class ScanSpec {
       const Type&,
       column_index_t channel);
 
+  // Removes the child field 'name'. Undoes addField() for a column that is
+  // read for a single split only. No reader may be using the child.
+  void removeChild(const std::string& name);
+
   // Add a field for map key.
   ScanSpec* addMapKeyField();
 
@@ -16,12 +16,17 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/wrap/zero-copy-stream-wrapper.h"
 
+namespace facebook::velox::cache {
+class AsyncDataCache;
+}
+
 namespace facebook::velox::dwio::common {
 
 void printBuffer(std::ostream& out, const char* buffer, uint64_t length);
@@ -47,6 +52,15 @@ class PositionProvider {
  */
 class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
  public:
+  /// Location in AsyncDataCache of a byte of a stream that is read through
+  /// the cache.
+  struct CachedFileLocation {
+    cache::AsyncDataCache* cache;
+    uint64_t fileNum;
+    /// Offset in the file.
+    uint64_t offset;
+  };
+
   ~SeekableInputStream() override = default;
 
   virtual void seekToPosition(PositionProvider& position) = 0;
@@ -64,6 +78,14 @@ class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
   }
 
   void readFully(char* buffer, size_t bufferSize);
+
+  /// Returns the cache location of the byte at 'streamOffset', which is
+  /// relative to the start of 'this' as in ByteCount(), or std::nullopt if
+  /// 'this' does not read through AsyncDataCache.
+  virtual std::optional<CachedFileLocation> cachedFileLocation(
+      uint64_t /*streamOffset*/) const {
+    return std::nullopt;
+  }
 };
 
 /**
@@ -15,6 +15,9 @@
  */
 
 #pragma once
+
+#include <folly/Executor.h>
+
 #include "velox/common/base/RawVector.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/process/ProcessBase.h"
@@ -501,6 +504,12 @@ class SelectiveColumnReader {
     VELOX_UNREACHABLE("Only struct reader supports this method");
   }
 
+  // Sets the executor on which the LazyVectors of the children of a struct
+  // start loading when their consumer calls LazyVector::prefetch().
+  virtual void setPrefetchExecutor(folly::Executor* /*executor*/) {
+    VELOX_UNREACHABLE("Only struct reader supports this method");
+  }
+
  protected:
   template <typename T>
   void
@@ -32,6 +32,7 @@ void SelectiveStructColumnReaderBase::filterRowGroups(
 }
 
 uint64_t SelectiveStructColumnReaderBase::skip(uint64_t numValues) {
+  finishPrefetches();
   auto numNonNulls = formatData_->skipNulls(numValues);
   // 'readOffset_' of struct child readers is aligned with
   // 'readOffset_' of the struct. The child readers may have fewer
@@ -78,6 +79,13 @@ void SelectiveStructColumnReaderBase::fillOutputRowsFromMutation(
   }
 }
 
+void SelectiveStructColumnReaderBase::finishPrefetches() {
+  for (auto& prefetch : prefetches_) {
+    prefetch->close();
+  }
+  prefetches_.clear();
+}
+
 void SelectiveStructColumnReaderBase::next(
     uint64_t numValues,
     VectorPtr& result,
@@ -131,6 +139,7 @@ void SelectiveStructColumnReaderBase::read(
     vector_size_t offset,
     RowSet rows,
     const uint64_t* incomingNulls) {
+  finishPrefetches();
   numReads_ = scanSpec_->newRead();
   prepareRead<char>(offset, rows, incomingNulls);
   RowSet activeRows = rows;
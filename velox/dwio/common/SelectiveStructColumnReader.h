@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 
 namespace facebook::velox::dwio::common {
@@ -102,6 +103,23 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     fillMutatedOutputRows_ = value;
   }
 
+  /// Sets the executor on which the LazyVectors produced by 'this' start
+  /// loading when their consumer calls LazyVector::prefetch(). Null disables
+  /// prefetching.
+  void setPrefetchExecutor(folly::Executor* executor) final {
+    prefetchExecutor_ = executor;
+  }
+
+  folly::Executor* prefetchExecutor() const {
+    return prefetchExecutor_;
+  }
+
+  /// Registers a LazyVector load started on the prefetch executor. 'this'
+  /// waits for it before reading further.
+  void addPrefetch(std::shared_ptr<AsyncSource<VectorPtr>> prefetch) {
+    prefetches_.push_back(std::move(prefetch));
+  }
+
  protected:
   template <typename T, typename KeyNode, typename FormatData>
   friend class SelectiveFlatMapColumnReaderHelper;
@@ -138,6 +156,10 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 
   void fillOutputRowsFromMutation(vector_size_t size);
 
+  // Waits for the prefetches of the LazyVectors of the last read, which use
+  // the child readers, and drops their values if they were not loaded.
+  void finishPrefetches();
+
   const std::shared_ptr<const dwio::common::TypeWithId> requestedType_;
 
   std::vector<SelectiveColumnReader*> children_;
@@ -159,6 +181,11 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 
   bool fillMutatedOutputRows_ = false;
 
+  folly::Executor* prefetchExecutor_{nullptr};
+
+  // LazyVector loads in flight on 'prefetchExecutor_'.
+  std::vector<std::shared_ptr<AsyncSource<VectorPtr>>> prefetches_;
+
   // Context information obtained from ExceptionContext. Stored here
   // so that LazyVector readers under this can add this to their
   // ExceptionContext. Allows contextualizing reader errors to split
@@ -174,6 +201,11 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 struct SelectiveStructColumnReader : SelectiveStructColumnReaderBase {
   using SelectiveStructColumnReaderBase::SelectiveStructColumnReaderBase;
 
+  ~SelectiveStructColumnReader() override {
+    // Prefetched LazyVector loads use the child readers.
+    finishPrefetches();
+  }
+
   void addChild(std::unique_ptr<SelectiveColumnReader> child) {
     children_.push_back(child.get());
     childrenOwned_.push_back(std::move(child));
@@ -21,6 +21,7 @@
 
 #include <folly/logging/xlog.h>
 #include <lz4.h>
+#include <mutex>
 #include <snappy.h>
 #include <zlib.h>
 #include <zstd.h>
@@ -35,6 +36,19 @@ using memory::MemoryPool;
 
 namespace {
 
+struct DecompressionAccelerators {
+  std::mutex mutex;
+  std::unordered_map<
+      CompressionKind,
+      std::shared_ptr<DecompressionAccelerator>>
+      accelerators;
+};
+
+DecompressionAccelerators& decompressionAccelerators() {
+  static DecompressionAccelerators accelerators;
+  return accelerators;
+}
+
 class ZstdCompressor : public Compressor {
  public:
   explicit ZstdCompressor(int32_t level) : Compressor{level} {}
@@ -609,8 +623,118 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+// Returns the decompressor of chunks of 'kind' or nullptr for
+// CompressionKind_NONE.
+std::unique_ptr<Decompressor> createBlockDecompressor(
+    CompressionKind kind,
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo) {
+  switch (static_cast<int64_t>(kind)) {
+    case CompressionKind::CompressionKind_NONE:
+      return nullptr;
+    case CompressionKind::CompressionKind_ZLIB:
+      return std::make_unique<ZlibDecompressor>(
+          blockSize, options.format.zlib.windowBits, streamDebugInfo, false);
+    case CompressionKind::CompressionKind_GZIP:
+      return std::make_unique<ZlibDecompressor>(
+          blockSize, options.format.zlib.windowBits, streamDebugInfo, true);
+    case CompressionKind::CompressionKind_SNAPPY:
+      return std::make_unique<SnappyDecompressor>(blockSize, streamDebugInfo);
+    case CompressionKind::CompressionKind_LZO:
+      return std::make_unique<LzoDecompressor>(
+          blockSize,
+          options.format.lz4_lzo.isHadoopFrameFormat,
+          streamDebugInfo);
+    case CompressionKind::CompressionKind_LZ4:
+      return std::make_unique<Lz4Decompressor>(
+          blockSize,
+          options.format.lz4_lzo.isHadoopFrameFormat,
+          streamDebugInfo);
+    case CompressionKind::CompressionKind_ZSTD:
+      return std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
+    default:
+      DWIO_RAISE("Unknown compression codec ", kind);
+  }
+}
+
 } // namespace
 
+uint64_t Decompressor::decompressWithAccelerator(
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) {
+  if (accelerator_) {
+    auto future = accelerator_->submit(src, srcLength, dest, destLength);
+    if (future.has_value()) {
+      try {
+        return std::move(future.value()).get();
+      } catch (const std::exception& e) {
+        XLOG_FIRST_N(WARN, 10)
+            << "Decompression accelerator failed, decompressing in "
+            << "software: " << e.what();
+      }
+    }
+  }
+  return decompress(src, srcLength, dest, destLength);
+}
+
+SoftwareDecompressionAccelerator::SoftwareDecompressionAccelerator(
+    CompressionKind kind,
+    const CompressionOptions& options,
+    folly::Executor* executor)
+    : kind_(kind), options_(options), executor_(executor) {
+  VELOX_CHECK(
+      kind_ != CompressionKind::CompressionKind_NONE,
+      "Uncompressed streams are not decompressed");
+  VELOX_CHECK_NOT_NULL(executor_);
+}
+
+std::optional<folly::SemiFuture<uint64_t>>
+SoftwareDecompressionAccelerator::submit(
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) {
+  ++numJobs_;
+  return folly::via(
+             executor_,
+             [this, src, srcLength, dest, destLength]() {
+               auto decompressor = createBlockDecompressor(
+                   kind_,
+                   destLength,
+                   options_,
+                   "SoftwareDecompressionAccelerator");
+               return decompressor->decompress(
+                   src, srcLength, dest, destLength);
+             })
+      .semi();
+}
+
+void registerDecompressionAccelerator(
+    CompressionKind kind,
+    std::shared_ptr<DecompressionAccelerator> accelerator) {
+  VELOX_CHECK_NOT_NULL(accelerator);
+  auto& registry = decompressionAccelerators();
+  std::lock_guard<std::mutex> l(registry.mutex);
+  registry.accelerators[kind] = std::move(accelerator);
+}
+
+void unregisterDecompressionAccelerators() {
+  auto& registry = decompressionAccelerators();
+  std::lock_guard<std::mutex> l(registry.mutex);
+  registry.accelerators.clear();
+}
+
+std::shared_ptr<DecompressionAccelerator> getDecompressionAccelerator(
+    CompressionKind kind) {
+  auto& registry = decompressionAccelerators();
+  std::lock_guard<std::mutex> l(registry.mutex);
+  auto it = registry.accelerators.find(kind);
+  return it == registry.accelerators.end() ? nullptr : it->second;
+}
+
 std::unique_ptr<Compressor> createCompressor(
     CompressionKind kind,
     const CompressionOptions& options) {
@@ -651,33 +775,16 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     const Decrypter* decrypter,
     bool useRawDecompression,
     size_t compressedLength) {
-  std::unique_ptr<Decompressor> decompressor;
+  auto accelerator = getDecompressionAccelerator(kind);
   switch (static_cast<int64_t>(kind)) {
     case CompressionKind::CompressionKind_NONE:
       if (!decrypter) {
         return input;
       }
-      // decompressor remain as nullptr
       break;
     case CompressionKind::CompressionKind_ZLIB:
-      if (!decrypter) {
-        // When file is not encrypted, we can use zlib streaming codec to avoid
-        // copying data
-        return std::make_unique<ZlibDecompressionStream>(
-            std::move(input),
-            blockSize,
-            pool,
-            options.format.zlib.windowBits,
-            streamDebugInfo,
-            false,
-            useRawDecompression,
-            compressedLength);
-      }
-      decompressor = std::make_unique<ZlibDecompressor>(
-          blockSize, options.format.zlib.windowBits, streamDebugInfo, false);
-      break;
     case CompressionKind::CompressionKind_GZIP:
-      if (!decrypter) {
+      if (!decrypter && !accelerator) {
         // When file is not encrypted, we can use zlib streaming codec to avoid
         // copying data
         return std::make_unique<ZlibDecompressionStream>(
@@ -686,35 +793,19 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
             pool,
             options.format.zlib.windowBits,
             streamDebugInfo,
-            true,
+            kind == CompressionKind::CompressionKind_GZIP,
             useRawDecompression,
             compressedLength);
       }
-      decompressor = std::make_unique<ZlibDecompressor>(
-          blockSize, options.format.zlib.windowBits, streamDebugInfo, true);
-      break;
-    case CompressionKind::CompressionKind_SNAPPY:
-      decompressor =
-          std::make_unique<SnappyDecompressor>(blockSize, streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_LZO:
-      decompressor = std::make_unique<LzoDecompressor>(
-          blockSize,
-          options.format.lz4_lzo.isHadoopFrameFormat,
-          streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_LZ4:
-      decompressor = std::make_unique<Lz4Decompressor>(
-          blockSize,
-          options.format.lz4_lzo.isHadoopFrameFormat,
-          streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_ZSTD:
-      decompressor =
-          std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
       break;
     default:
-      DWIO_RAISE("Unknown compression codec ", kind);
+      break;
+  }
+  // The decompressor remains nullptr for CompressionKind_NONE.
+  auto decompressor =
+      createBlockDecompressor(kind, blockSize, options, streamDebugInfo);
+  if (decompressor) {
+    decompressor->setAccelerator(std::move(accelerator));
   }
   return std::make_unique<PagedInputStream>(
       std::move(input),
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <atomic>
+
+#include <folly/futures/Future.h>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/encryption/Encryption.h"
@@ -41,6 +45,35 @@ class Compressor {
   int32_t level_;
 };
 
+/// Decompresses blocks on a hardware accelerator such as Intel QAT or IAA.
+/// Velox does not link the accelerator libraries. Deployments that have them
+/// implement this interface and install it with
+/// registerDecompressionAccelerator(). Streams of the registered compression
+/// kind then submit each compressed chunk to the accelerator and decompress
+/// it in software if the accelerator declines or fails.
+///
+/// This is a synchronous hook: a stream waits for each chunk before it reads
+/// the next one, so one stream has at most one job in flight. The CPU is
+/// saved, not the latency. Jobs overlap only across the streams of
+/// concurrent readers. SoftwareDecompressionAccelerator is a reference
+/// implementation.
+class DecompressionAccelerator {
+ public:
+  virtual ~DecompressionAccelerator() = default;
+
+  /// Submits decompression of 'srcLength' bytes at 'src' into 'destLength'
+  /// bytes at 'dest'. Returns a future for the decompressed length or
+  /// std::nullopt if the job cannot be taken, e.g. because the device queues
+  /// are full. The buffers stay valid until the future completes. Called
+  /// concurrently by the streams of all readers, so that implementations can
+  /// batch the jobs they send to the device.
+  virtual std::optional<folly::SemiFuture<uint64_t>> submit(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) = 0;
+};
+
 class Decompressor {
  public:
   explicit Decompressor(uint64_t blockSize, const std::string& streamDebugInfo)
@@ -60,9 +93,27 @@ class Decompressor {
       char* dest,
       uint64_t destLength) = 0;
 
+  /// Same as decompress() but runs on the accelerator if one is set and
+  /// waits for it to finish. Falls back to decompress() if there is no
+  /// accelerator or it declines or fails the job.
+  uint64_t decompressWithAccelerator(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength);
+
+  void setAccelerator(std::shared_ptr<DecompressionAccelerator> accelerator) {
+    accelerator_ = std::move(accelerator);
+  }
+
+  const std::shared_ptr<DecompressionAccelerator>& accelerator() const {
+    return accelerator_;
+  }
+
  protected:
   int64_t blockSize_;
   const std::string streamDebugInfo_;
+  std::shared_ptr<DecompressionAccelerator> accelerator_;
 };
 
 struct CompressionOptions {
@@ -89,6 +140,50 @@ struct CompressionOptions {
   uint32_t compressionThreshold;
 };
 
+/// Reference DecompressionAccelerator that decompresses the chunks of 'kind'
+/// in software on 'executor'. Runs the accelerator path end to end without a
+/// device, e.g. in tests and benchmarks, and is the model for device
+/// implementations. 'options' must match the files being read.
+class SoftwareDecompressionAccelerator : public DecompressionAccelerator {
+ public:
+  SoftwareDecompressionAccelerator(
+      facebook::velox::common::CompressionKind kind,
+      const CompressionOptions& options,
+      folly::Executor* executor);
+
+  std::optional<folly::SemiFuture<uint64_t>> submit(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override;
+
+  /// Returns the number of jobs taken.
+  uint64_t numJobs() const {
+    return numJobs_;
+  }
+
+ private:
+  const facebook::velox::common::CompressionKind kind_;
+  const CompressionOptions options_;
+  folly::Executor* const executor_;
+  std::atomic<uint64_t> numJobs_{0};
+};
+
+/// Makes the decompressors created afterwards for 'kind' offload to
+/// 'accelerator'. Zlib and gzip streams are then decompressed a chunk at a
+/// time instead of through the streaming zlib decompressor. Replaces the
+/// accelerator registered for 'kind' before, if any.
+void registerDecompressionAccelerator(
+    facebook::velox::common::CompressionKind kind,
+    std::shared_ptr<DecompressionAccelerator> accelerator);
+
+/// Removes the accelerators of all compression kinds.
+void unregisterDecompressionAccelerators();
+
+/// Returns the accelerator registered for 'kind' or nullptr.
+std::shared_ptr<DecompressionAccelerator> getDecompressionAccelerator(
+    facebook::velox::common::CompressionKind kind);
+
 /**
  * Create a decompressor for the given compression kind.
  * @param kind The compression type to implement
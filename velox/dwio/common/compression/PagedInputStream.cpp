@@ -16,6 +16,14 @@
 
 #include "velox/dwio/common/compression/PagedInputStream.h"
 
+#include "velox/common/caching/FileIds.h"
+
+DEFINE_bool(
+    velox_cache_decompressed_chunks,
+    false,
+    "Keep decompressed chunks of streams read through AsyncDataCache in the "
+    "cache, so that later reads of the same chunk are not decompressed again.");
+
 namespace facebook::velox::dwio::common::compression {
 
 void PagedInputStream::prepareOutputBuffer(uint64_t uncompressedLength) {
@@ -130,6 +138,7 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
 
   // release previous decryption buffer
   decryptionBuffer_ = nullptr;
+  decompressedPin_.clear();
 
   if (state_ == State::HEADER || remainingLength_ == 0) {
     readHeader();
@@ -137,6 +146,10 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   if (state_ == State::END) {
     return false;
   }
+  if (state_ == State::START && !decrypter_ &&
+      readDecompressedChunk(data, size)) {
+    return true;
+  }
   if (inputBufferPtr_ == inputBufferPtrEnd_) {
     readBuffer(true);
   }
@@ -186,7 +199,9 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
       outputBufferPtr_ = nullptr;
     } else {
       prepareOutputBuffer(decompressedLength);
-      outputBufferLength_ = decompressor_->decompress(
+      // Waits for an accelerator to finish, so that chunks are decompressed
+      // one at a time.
+      outputBufferLength_ = decompressor_->decompressWithAccelerator(
           input,
           remainingLength_,
           outputBuffer_->data(),
@@ -196,6 +211,9 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
       }
       *size = static_cast<int32_t>(outputBufferLength_);
       outputBufferPtr_ = outputBuffer_->data() + outputBufferLength_;
+      if (!decrypter_) {
+        cacheDecompressedChunk();
+      }
     }
     // release decryption buffer
     decryptionBuffer_ = nullptr;
@@ -212,6 +230,116 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+std::optional<cache::RawFileCacheKey>
+PagedInputStream::decompressedChunkKey() {
+  if (!FLAGS_velox_cache_decompressed_chunks) {
+    return std::nullopt;
+  }
+  auto location = input_->cachedFileLocation(lastHeaderOffset_);
+  if (!location.has_value() || location->cache == nullptr) {
+    return std::nullopt;
+  }
+  if (!decompressedFileId_.hasValue()) {
+    decompressedFileId_ = StringIdLease(
+        fileIds(), fileIds().string(location->fileNum) + "#decompressed");
+  }
+  decompressedCache_ = location->cache;
+  return cache::RawFileCacheKey{decompressedFileId_.id(), location->offset};
+}
+
+bool PagedInputStream::readDecompressedChunk(
+    const void** data,
+    int32_t* size) {
+  const auto key = decompressedChunkKey();
+  if (!key.has_value() || !decompressedCache_->exists(key.value())) {
+    return false;
+  }
+  auto pin = decompressedCache_->findOrCreate(key.value(), 1, nullptr);
+  // The entry may have been evicted after exists() or be loading in another
+  // thread. An exclusive pin is a new empty entry, dropped by clearing it.
+  if (pin.empty() || pin.checkedEntry()->isExclusive()) {
+    return false;
+  }
+  auto* entry = pin.checkedEntry();
+
+  // Skip the compressed chunk.
+  const auto available = std::min(
+      static_cast<size_t>(inputBufferPtrEnd_ - inputBufferPtr_),
+      remainingLength_);
+  inputBufferPtr_ += available;
+  if (remainingLength_ > available) {
+    input_->SkipInt64(remainingLength_ - available);
+  }
+
+  const char* decompressed;
+  if (entry->tinyData() != nullptr) {
+    decompressed = entry->tinyData();
+  } else if (entry->data().numRuns() == 1) {
+    decompressed = entry->data().runAt(0).data<char>();
+  } else {
+    // The chunk is returned in one piece, so non-contiguous entries are
+    // copied.
+    prepareOutputBuffer(entry->size());
+    uint64_t offset = 0;
+    for (auto i = 0; i < entry->data().numRuns(); ++i) {
+      auto run = entry->data().runAt(i);
+      const auto bytes = std::min<uint64_t>(
+          run.numPages() * memory::AllocationTraits::kPageSize,
+          entry->size() - offset);
+      std::memcpy(outputBuffer_->data() + offset, run.data<char>(), bytes);
+      offset += bytes;
+    }
+    decompressed = outputBuffer_->data();
+  }
+  decompressedPin_ = std::move(pin);
+
+  if (data) {
+    *data = decompressed;
+  }
+  *size = entry->size();
+  outputBufferPtr_ = decompressed + *size;
+  outputBufferLength_ = 0;
+  remainingLength_ = 0;
+  state_ = State::HEADER;
+  bytesReturned_ += *size;
+  lastWindowSize_ = *size;
+  return true;
+}
+
+void PagedInputStream::cacheDecompressedChunk() {
+  const auto key = decompressedChunkKey();
+  if (!key.has_value() || outputBufferLength_ == 0) {
+    return;
+  }
+  try {
+    auto pin =
+        decompressedCache_->findOrCreate(key.value(), outputBufferLength_);
+    if (pin.empty() || !pin.checkedEntry()->isExclusive()) {
+      return;
+    }
+    auto* entry = pin.checkedEntry();
+    if (entry->tinyData() != nullptr) {
+      std::memcpy(entry->tinyData(), outputBuffer_->data(), entry->size());
+    } else {
+      uint64_t offset = 0;
+      for (auto i = 0; i < entry->data().numRuns(); ++i) {
+        auto run = entry->data().runAt(i);
+        const auto bytes = std::min<uint64_t>(
+            run.numPages() * memory::AllocationTraits::kPageSize,
+            entry->size() - offset);
+        std::memcpy(run.data<char>(), outputBuffer_->data() + offset, bytes);
+        offset += bytes;
+      }
+    }
+    // Decompressed chunks are not written to SSD, which keeps the compressed
+    // form.
+    entry->setExclusiveToShared(false);
+  } catch (const std::exception& e) {
+    // Typically out of cache space. The chunk is returned uncached.
+    VLOG(1) << "Failed to cache decompressed chunk: " << e.what();
+  }
+}
+
 void PagedInputStream::BackUp(int32_t count) {
   VELOX_CHECK_GE(count, 0);
   if (pendingSkip_ > 0) {
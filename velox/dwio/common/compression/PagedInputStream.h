@@ -16,9 +16,14 @@
 
 #pragma once
 
+#include <gflags/gflags.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
 
+DECLARE_bool(velox_cache_decompressed_chunks);
+
 namespace facebook::velox::dwio::common::compression {
 
 class PagedInputStream : public dwio::common::SeekableInputStream {
@@ -180,6 +185,30 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
  private:
   bool skipAllPending();
 
+  // Returns the cache key of the decompressed form of the chunk at
+  // 'lastHeaderOffset_' or std::nullopt if decompressed chunks are not cached
+  // for 'input_'.
+  std::optional<cache::RawFileCacheKey> decompressedChunkKey();
+
+  // Returns the current chunk from the cache of decompressed chunks if it is
+  // there. Skips the compressed chunk in 'input_'.
+  bool readDecompressedChunk(const void** data, int32_t* size);
+
+  // Adds the decompressed current chunk in 'outputBuffer_' to the cache.
+  void cacheDecompressedChunk();
+
+  // Cache of 'input_'. Set by decompressedChunkKey().
+  cache::AsyncDataCache* decompressedCache_{nullptr};
+
+  // File id of the decompressed chunks of the file of 'input_'. Distinct from
+  // the id of the file so that decompressed and compressed entries at the
+  // same offset do not collide.
+  StringIdLease decompressedFileId_;
+
+  // Pins the cache entry of the chunk being returned if it came from the
+  // cache of decompressed chunks.
+  cache::CachePin decompressedPin_;
+
   // Stream Debug Info
   const std::string streamDebugInfo_;
 };
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/synchronization/Baton.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/FileMetadataCache.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+class FileMetadataCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    FLAGS_velox_file_metadata_cache_bytes = 1000;
+    cache().clear();
+  }
+
+  void TearDown() override {
+    cache().setMemoryPool(nullptr);
+    cache().clear();
+  }
+
+  static FileMetadataCache& cache() {
+    return FileMetadataCache::instance();
+  }
+
+  static FileMetadataCacheKey makeKey(
+      const std::string& name,
+      int64_t modificationTime = 0) {
+    return FileMetadataCacheKey{
+        name, 100, modificationTime, FileFormat::PARQUET};
+  }
+
+  static std::shared_ptr<const int32_t> get(
+      const FileMetadataCacheKey& key,
+      int32_t value,
+      uint64_t bytes = 100) {
+    return cache().get<int32_t>(key, [&]() {
+      return std::make_pair(std::make_shared<const int32_t>(value), bytes);
+    });
+  }
+
+  gflags::FlagSaver flagSaver_;
+};
+
+TEST_F(FileMetadataCacheTest, basic) {
+  ASSERT_EQ(*get(makeKey("a"), 1), 1);
+  ASSERT_EQ(cache().numMisses(), 1);
+  ASSERT_EQ(*get(makeKey("a"), 2), 1);
+  ASSERT_EQ(cache().numHits(), 1);
+
+  // A different modification time is a different file.
+  ASSERT_EQ(*get(makeKey("a", 10), 3), 3);
+  ASSERT_EQ(cache().numEntries(), 2);
+  ASSERT_EQ(cache().bytes(), 200);
+
+  // Too large to cache.
+  ASSERT_EQ(*get(makeKey("large"), 4, 2000), 4);
+  ASSERT_EQ(cache().numEntries(), 2);
+
+  // Fills the cache and evicts the least recently used.
+  for (auto i = 0; i < 9; ++i) {
+    get(makeKey(fmt::format("f{}", i)), i);
+  }
+  ASSERT_EQ(cache().numEntries(), 10);
+  ASSERT_EQ(cache().bytes(), 1000);
+  ASSERT_EQ(*get(makeKey("a"), 5), 5);
+
+  VELOX_ASSERT_THROW(
+      cache().get<int32_t>(
+          makeKey("error"),
+          []() -> std::pair<std::shared_ptr<const int32_t>, uint64_t> {
+            VELOX_FAIL("load error");
+          }),
+      "load error");
+  ASSERT_EQ(*get(makeKey("error"), 6), 6);
+}
+
+TEST_F(FileMetadataCacheTest, makeKey) {
+  InMemoryReadFile file(std::string("data"));
+  ASSERT_FALSE(
+      FileMetadataCache::makeKey(file, FileFormat::DWRF, std::nullopt)
+          .has_value());
+  ASSERT_FALSE(
+      FileMetadataCache::makeKey(file, FileFormat::DWRF, 10).has_value());
+
+  class NamedFile : public InMemoryReadFile {
+   public:
+    NamedFile() : InMemoryReadFile(std::string("data")) {}
+
+    std::string getName() const override {
+      return "/data/file.dwrf";
+    }
+  };
+  NamedFile namedFile;
+  // Without a modification time, a file rewritten with the same size would
+  // get the footer of the old file.
+  ASSERT_FALSE(
+      FileMetadataCache::makeKey(namedFile, FileFormat::DWRF, std::nullopt)
+          .has_value());
+  auto key = FileMetadataCache::makeKey(namedFile, FileFormat::DWRF, 10);
+  ASSERT_TRUE(key.has_value());
+  ASSERT_EQ(key->fileName, "/data/file.dwrf");
+  ASSERT_EQ(key->fileSize, 4);
+  ASSERT_EQ(key->modificationTime, 10);
+
+  FLAGS_velox_file_metadata_cache_bytes = 0;
+  ASSERT_FALSE(
+      FileMetadataCache::makeKey(namedFile, FileFormat::DWRF, 10).has_value());
+}
+
+TEST_F(FileMetadataCacheTest, singleFlight) {
+  constexpr int32_t kNumThreads = 8;
+  folly::Baton<> loadBaton;
+  std::atomic<int32_t> numLoads{0};
+  std::vector<int32_t> results(kNumThreads);
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      results[i] = *cache().get<int32_t>(makeKey("shared"), [&]() {
+        ++numLoads;
+        loadBaton.wait();
+        return std::make_pair(std::make_shared<const int32_t>(11), 100);
+      });
+    });
+  }
+  while (cache().numMisses() + cache().numWaits() < kNumThreads) {
+    std::this_thread::yield();
+  }
+  loadBaton.post();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(numLoads, 1);
+  ASSERT_EQ(cache().numMisses(), 1);
+  ASSERT_EQ(cache().numWaits(), kNumThreads - 1);
+  for (auto result : results) {
+    ASSERT_EQ(result, 11);
+  }
+}
+
+TEST_F(FileMetadataCacheTest, memoryPool) {
+  auto pool = memory::memoryManager()->addLeafPool("FileMetadataCacheTest");
+  cache().setMemoryPool(pool);
+  get(makeKey("a"), 1);
+  get(makeKey("b"), 2);
+  ASSERT_EQ(cache().numEntries(), 2);
+  ASSERT_GE(pool->reservedBytes(), 200);
+  ASSERT_EQ(pool->usedBytes(), 0);
+
+  cache().clear();
+  ASSERT_EQ(pool->reservedBytes(), 0);
+}
+
+} // namespace
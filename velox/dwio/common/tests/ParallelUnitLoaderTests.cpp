@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/ManualExecutor.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/ParallelUnitLoader.h"
+#include "velox/dwio/common/tests/utils/UnitLoaderTestTools.h"
+
+using namespace ::testing;
+using facebook::velox::dwio::common::LoadUnit;
+using facebook::velox::dwio::common::ParallelUnitLoaderFactory;
+using facebook::velox::dwio::common::test::getUnitsLoadedWithFalse;
+using facebook::velox::dwio::common::test::LoadUnitMock;
+using facebook::velox::dwio::common::test::ReaderMock;
+using facebook::velox::io::PrefetchBudget;
+
+TEST(ParallelUnitLoaderTests, LoadsAhead) {
+  folly::ManualExecutor executor;
+  size_t blockedOnIoCount = 0;
+  ParallelUnitLoaderFactory factory(
+      &executor, 2, [&](auto) { ++blockedOnIoCount; });
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, false}));
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2, load(0)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  executor.drain(); // load(1) on the executor
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(7)); // Unit: 0, rows: 3-9
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, rows: 0-19, unload(0)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 2);
+
+  // Unit 2 was scheduled but not started, so it is loaded on this thread.
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, rows: 0-29, unload(1), load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+  EXPECT_EQ(blockedOnIoCount, 3);
+  executor.drain();
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  EXPECT_FALSE(readerMock.read(30)); // No more data
+}
+
+TEST(ParallelUnitLoaderTests, SeekReleasesUnitsOutsideWindow) {
+  folly::ManualExecutor executor;
+  ParallelUnitLoaderFactory factory(&executor, 2, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+
+  EXPECT_NO_THROW(readerMock.seek(10););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 1, rows: 0-2, load(1)
+  executor.drain(); // load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_NO_THROW(readerMock.seek(0););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2, load(0), unload(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_NO_THROW(readerMock.seek(30););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 2, rows: 0-2, unload(0,1), load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+}
+
+TEST(ParallelUnitLoaderTests, LoadsAheadWithinBudget) {
+  folly::ManualExecutor executor;
+  auto budget = std::make_shared<PrefetchBudget>(35);
+  ParallelUnitLoaderFactory factory(&executor, 4, nullptr, budget);
+  ReaderMock readerMock{{10, 10, 10, 10}, {10, 20, 30, 40}, factory, 0};
+
+  // Unit 1 fits in the budget, unit 2 does not.
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, load(0)
+  executor.drain(); // load(1)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(), std::vector<bool>({true, true, false, false}));
+  EXPECT_EQ(budget->reservedBytes(), 20);
+
+  // Reading unit 1 returns its bytes, so that unit 2 fits.
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 1, unload(0)
+  executor.drain(); // load(2)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(), std::vector<bool>({false, true, true, false}));
+  EXPECT_EQ(budget->reservedBytes(), 30);
+
+  // The budget is shared with other readers.
+  EXPECT_FALSE(budget->tryReserve(10));
+
+  // Unit 3 is larger than the budget and is loaded on demand.
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 2, unload(1)
+  executor.drain();
+  EXPECT_EQ(
+      readerMock.unitsLoaded(), std::vector<bool>({false, false, true, false}));
+  EXPECT_EQ(budget->reservedBytes(), 0);
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 3, unload(2), load(3)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(), std::vector<bool>({false, false, false, true}));
+  EXPECT_FALSE(readerMock.read(10));
+}
+
+TEST(ParallelUnitLoaderTests, LoadsOnThreadPool) {
+  folly::CPUThreadPoolExecutor executor(4);
+  ParallelUnitLoaderFactory factory(&executor, 3, nullptr);
+  std::vector<uint64_t> rowsPerUnit(20, 7);
+  std::vector<uint64_t> ioSizes(20, 0);
+  ReaderMock readerMock{rowsPerUnit, ioSizes, factory, 0};
+  uint64_t numReads = 0;
+  while (readerMock.read(5)) {
+    ++numReads;
+  }
+  // Each unit of 7 rows is read as 5 + 2.
+  EXPECT_EQ(numReads, 40);
+  auto unitsLoaded = readerMock.unitsLoaded();
+  EXPECT_TRUE(unitsLoaded.back());
+  EXPECT_EQ(std::count(unitsLoaded.begin(), unitsLoaded.end(), true), 1);
+}
+
+TEST(ParallelUnitLoaderTests, UnitOutOfRange) {
+  folly::ManualExecutor executor;
+  ParallelUnitLoaderFactory factory(&executor, 2, nullptr);
+  std::vector<std::atomic_bool> unitsLoaded(getUnitsLoadedWithFalse(1));
+  std::vector<std::unique_ptr<LoadUnit>> units;
+  units.push_back(std::make_unique<LoadUnitMock>(10, 0, unitsLoaded, 0));
+
+  auto unitLoader = factory.create(std::move(units), 0);
+  unitLoader->getLoadedUnit(0);
+  unitLoader->getLoadedUnit(0);
+  EXPECT_THAT(
+      [&]() { unitLoader->getLoadedUnit(1); },
+      Throws<facebook::velox::VeloxRuntimeError>(Property(
+          &facebook::velox::VeloxRuntimeError::message,
+          HasSubstr("Unit out of range"))));
+}
@@ -32,11 +32,29 @@ namespace facebook::velox::dwrf {
 constexpr folly::StringPiece WRITER_NAME_KEY{"orc.writer.name"};
 constexpr folly::StringPiece WRITER_VERSION_KEY{"orc.writer.version"};
 constexpr folly::StringPiece WRITER_HOSTNAME_KEY{"orc.writer.host"};
+// Prefix of the name of the footer metadata item with the statistics of each
+// stripe of a column in Config::STRIPE_KEY_INDEX_COLS. The name ends with the
+// index of the column. The value is a serialized proto::RowIndex with an
+// entry per stripe.
+constexpr folly::StringPiece STRIPE_KEY_INDEX_KEY_PREFIX{
+    "orc.stripe.key.index."};
 constexpr folly::StringPiece kDwioWriter{"dwio"};
 constexpr folly::StringPiece kPrestoWriter{"presto"};
 
 enum StripeCacheMode { NA = 0, INDEX = 1, FOOTER = 2, BOTH = 3 };
 
+/// What the writer optimizes for when it chooses between dictionary and
+/// direct encoding for a column at the end of the first stripe. kThreshold
+/// compares the fraction of distinct values to the key size thresholds. The
+/// others compare the estimated encoded sizes of both encodings, weighted by
+/// the cost of writing or reading each.
+enum class EncodingSelectionObjective {
+  kThreshold = 0,
+  kFileSize = 1,
+  kWriteCpu = 2,
+  kReadCpu = 3,
+};
+
 enum WriterVersion {
   ORIGINAL = 0, // all default versions including files written by Presto
   DWRF_4_9 = 1, // string stats collection uses text rather than string
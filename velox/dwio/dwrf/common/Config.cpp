@@ -21,6 +21,31 @@
 
 namespace facebook::velox::dwrf {
 
+namespace {
+
+std::string columnsToString(const std::vector<uint32_t>& val) {
+  return folly::join(",", val);
+}
+
+std::vector<uint32_t> columnsFromString(
+    const std::string& /* key */,
+    const std::string& val) {
+  std::vector<uint32_t> result;
+  if (!val.empty()) {
+    std::vector<folly::StringPiece> pieces;
+    folly::split(',', val, pieces, true);
+    for (const auto& p : pieces) {
+      const auto& trimmedCol = folly::trimWhitespace(p);
+      if (!trimmedCol.empty()) {
+        result.push_back(folly::to<uint32_t>(trimmedCol));
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace
+
 Config::Entry<WriterVersion> Config::WRITER_VERSION(
     "orc.writer.version",
     WriterVersion_CURRENT);
@@ -105,6 +130,16 @@ Config::Entry<uint32_t> Config::ENTROPY_STRING_THRESHOLD{
     "hive.exec.orc.entropy.string.threshold",
     20};
 
+Config::Entry<EncodingSelectionObjective> Config::ENCODING_SELECTION_OBJECTIVE{
+    "orc.encoding.selection.objective",
+    EncodingSelectionObjective::kThreshold};
+
+Config::Entry<const std::vector<uint32_t>> Config::STRIPE_KEY_INDEX_COLS(
+    "orc.stripe.key.index.cols",
+    {},
+    &columnsToString,
+    &columnsFromString);
+
 Config::Entry<uint32_t> Config::STRING_STATS_LIMIT(
     "hive.orc.string.stats.limit",
     64);
@@ -126,21 +161,8 @@ Config::Entry<bool> Config::MAP_FLAT_DICT_SHARE(
 Config::Entry<const std::vector<uint32_t>> Config::MAP_FLAT_COLS(
     "orc.map.flat.cols",
     {},
-    [](const std::vector<uint32_t>& val) { return folly::join(",", val); },
-    [](const std::string& /* key */, const std::string& val) {
-      std::vector<uint32_t> result;
-      if (!val.empty()) {
-        std::vector<folly::StringPiece> pieces;
-        folly::split(',', val, pieces, true);
-        for (const auto& p : pieces) {
-          const auto& trimmedCol = folly::trimWhitespace(p);
-          if (!trimmedCol.empty()) {
-            result.push_back(folly::to<uint32_t>(trimmedCol));
-          }
-        }
-      }
-      return result;
-    });
+    &columnsToString,
+    &columnsFromString);
 
 Config::Entry<const std::vector<std::vector<std::string>>>
     Config::MAP_FLAT_COLS_STRUCT_KEYS(
@@ -51,6 +51,13 @@ class Config : public common::ConfigBase<Config> {
   static Entry<uint32_t> ENTROPY_STRING_MIN_SAMPLES;
   static Entry<float> ENTROPY_STRING_DICT_SAMPLE_FRACTION;
   static Entry<uint32_t> ENTROPY_STRING_THRESHOLD;
+  static Entry<EncodingSelectionObjective> ENCODING_SELECTION_OBJECTIVE;
+  /// Top level columns, by index, for which the writer stores the statistics
+  /// of each stripe in the file footer. Readers skip the stripes in which a
+  /// filter on such a column cannot pass without reading them. Meant for the
+  /// sort keys of sorted files. Needs CREATE_INDEX. Encrypted columns are
+  /// ignored.
+  static Entry<const std::vector<uint32_t>> STRIPE_KEY_INDEX_COLS;
   static Entry<uint32_t> STRING_STATS_LIMIT;
   static Entry<bool> FLATTEN_MAP;
   static Entry<bool> MAP_FLAT_DISABLE_DICT_ENCODING;
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/HotCounters.h"
 #include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/StreamUtil.h"
@@ -65,9 +66,11 @@ class FloatingPointDecoder {
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     if (std::is_same_v<TFile, TRequested> &&
         dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      VELOX_HOT_COUNTER_INC(kSelectiveFastPath);
       fastPath<hasNulls>(nulls, visitor);
       return;
     }
+    VELOX_HOT_COUNTER_INC(kSelectiveSlowPath);
     int32_t current = visitor.start();
     skip<hasNulls>(current, 0, nulls);
     bool atEnd = false;
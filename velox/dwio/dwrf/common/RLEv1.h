@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/common/base/GTestMacros.h"
+#include "velox/common/base/HotCounters.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
@@ -261,9 +262,11 @@ class RleDecoderV1 : public dwio::common::IntDecoder<isSigned> {
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     skipPending();
     if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      VELOX_HOT_COUNTER_INC(kSelectiveFastPath);
       fastPath<hasNulls>(nulls, visitor);
       return;
     }
+    VELOX_HOT_COUNTER_INC(kSelectiveSlowPath);
     int32_t current = visitor.start();
     this->template skip<hasNulls>(current, 0, nulls);
     int32_t toSkip;
@@ -18,7 +18,10 @@
 
 #include <chrono>
 
+#include <folly/Conv.h>
+
 #include "velox/dwio/common/OnDemandUnitLoader.h"
+#include "velox/dwio/common/ParallelUnitLoader.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
@@ -166,6 +169,10 @@ void DwrfUnit::ensureDecoders() {
         flatMapContext,
         true); // isRoot
     selectiveColumnReader_->setIsTopLevel();
+    if (options_.getDecodingExecutor()) {
+      selectiveColumnReader_->setPrefetchExecutor(
+          options_.getDecodingExecutor().get());
+    }
     selectiveColumnReader_->setFillMutatedOutputRows(
         options_.getRowNumberColumnInfo().has_value());
   } else {
@@ -480,6 +487,65 @@ void DwrfRowReader::checkSkipStrides(uint64_t strideSize) {
   }
 }
 
+bool DwrfRowReader::skipStripeByKeyIndex(uint32_t stripe) {
+  if (!stripeKeyIndexes_.has_value()) {
+    loadStripeKeyIndexes();
+  }
+  if (stripeKeyIndexes_->empty()) {
+    return false;
+  }
+  const auto numRows = getReader().getFooter().stripes(stripe).numberOfRows();
+  StatsContext context(
+      getReader().getWriterName(), getReader().getWriterVersion());
+  for (const auto& keyIndex : *stripeKeyIndexes_) {
+    auto* filter = keyIndex.spec->filter();
+    if (!filter) {
+      continue;
+    }
+    auto stats = buildColumnStatisticsFromProto(
+        keyIndex.index.entry(stripe).statistics(), context);
+    if (!testFilter(filter, stats.get(), numRows, keyIndex.type)) {
+      VLOG(1) << "Drop stripe " << stripe << " on "
+              << keyIndex.spec->toString();
+      return true;
+    }
+  }
+  return false;
+}
+
+void DwrfRowReader::loadStripeKeyIndexes() {
+  stripeKeyIndexes_.emplace();
+  const auto& scanSpec = options_.getScanSpec();
+  const auto& footer = getReader().getFooter();
+  if (!scanSpec || footer.format() != DwrfFormat::kDwrf) {
+    return;
+  }
+  const auto& schema = getReader().getSchema();
+  const std::string prefix{STRIPE_KEY_INDEX_KEY_PREFIX};
+  for (auto i = 0; i < footer.metadataSize(); ++i) {
+    const auto item = footer.metadata(i);
+    if (item.name().compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    const auto column =
+        folly::tryTo<uint32_t>(item.name().substr(prefix.size()));
+    if (!column.hasValue() || column.value() >= schema->size()) {
+      continue;
+    }
+    auto* spec = scanSpec->childByName(schema->nameOf(column.value()));
+    if (!spec) {
+      continue;
+    }
+    proto::RowIndex index;
+    if (!index.ParseFromString(item.value()) ||
+        index.entry_size() != footer.stripesSize()) {
+      continue;
+    }
+    stripeKeyIndexes_->push_back(
+        {spec, schema->childAt(column.value()), std::move(index)});
+  }
+}
+
 void DwrfRowReader::readNext(
     uint64_t rowsToRead,
     const dwio::common::Mutation* mutation,
@@ -531,6 +597,14 @@ int64_t DwrfRowReader::nextRowNumber() {
   auto strideSize = getReader().getFooter().rowIndexStride();
   while (currentStripe_ < stripeCeiling_) {
     if (currentRowInStripe_ == 0) {
+      if (skipStripeByKeyIndex(currentStripe_)) {
+        auto numStripeRows =
+            getReader().getFooter().stripes(currentStripe_).numberOfRows();
+        if (strideSize > 0) {
+          skippedStrides_ += (numStripeRows + strideSize - 1) / strideSize;
+        }
+        goto advanceToNextStripe;
+      }
       if (getReader().randomSkip()) {
         auto numStripeRows =
             getReader().getFooter().stripes(currentStripe_).numberOfRows();
@@ -752,7 +826,8 @@ DwrfReader::DwrfReader(
           options.fileFormat() == FileFormat::ORC ? FileFormat::ORC
                                                   : FileFormat::DWRF,
           options.fileColumnNamesReadAsLowerCase(),
-          options.randomSkip())),
+          options.randomSkip(),
+          options.fileModificationTime())),
       options_(options) {
   // If we are not using column names to map table columns to file columns,
   // then we use indices. In that case we need to ensure the names completely
@@ -1072,7 +1147,22 @@ std::unique_ptr<dwio::common::RowReader> DwrfReader::createRowReader(
 
 std::unique_ptr<DwrfRowReader> DwrfReader::createDwrfRowReader(
     const RowReaderOptions& opts) const {
-  auto rowReader = std::make_unique<DwrfRowReader>(readerBase_, opts);
+  std::unique_ptr<DwrfRowReader> rowReader;
+  if (opts.getUnitLoaderFactory() || !options_.ioExecutor()) {
+    rowReader = std::make_unique<DwrfRowReader>(readerBase_, opts);
+  } else {
+    // Loads the next prefetchRowGroups() stripes on the IO executor while the
+    // current one is read. The column readers of a stripe are built on the
+    // calling thread and only the stripe IO runs on the executor.
+    auto parallelOpts = opts;
+    parallelOpts.setUnitLoaderFactory(
+        std::make_shared<dwio::common::ParallelUnitLoaderFactory>(
+            options_.ioExecutor().get(),
+            options_.prefetchRowGroups() + 1,
+            opts.getBlockedOnIoCallback(),
+            options_.prefetchBudget()));
+    rowReader = std::make_unique<DwrfRowReader>(readerBase_, parallelOpts);
+  }
   if (opts.getEagerFirstStripeLoad()) {
     // Load the first stripe on construction so that readers created in
     // background have a reader tree and can preload the first
@@ -165,6 +165,17 @@ class DwrfRowReader : public StrideIndexProvider,
   std::unique_ptr<dwio::common::UnitLoader> unitLoader_;
   DwrfUnit* currentUnit_;
 
+  // The statistics of each stripe of a column in Config::STRIPE_KEY_INDEX_COLS
+  // that has a ScanSpec.
+  struct StripeKeyIndex {
+    const common::ScanSpec* spec;
+    TypePtr type;
+    proto::RowIndex index;
+  };
+
+  // The stripe key indexes of the file. Set on first use.
+  std::optional<std::vector<StripeKeyIndex>> stripeKeyIndexes_;
+
   // internal methods
 
   std::optional<size_t> estimatedRowSizeHelper(
@@ -182,6 +193,12 @@ class DwrfRowReader : public StrideIndexProvider,
 
   void checkSkipStrides(uint64_t strideSize);
 
+  // Returns true if a filter on a column with a stripe key index cannot pass
+  // for any row of 'stripe'.
+  bool skipStripeByKeyIndex(uint32_t stripe);
+
+  void loadStripeKeyIndexes();
+
   void readNext(
       uint64_t rowsToRead,
       const dwio::common::Mutation*,
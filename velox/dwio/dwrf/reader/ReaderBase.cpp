@@ -19,6 +19,7 @@
 #include <fmt/format.h>
 
 #include "velox/common/process/TraceContext.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/Mutation.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -95,7 +96,8 @@ ReaderBase::ReaderBase(
     uint64_t filePreloadThreshold,
     FileFormat fileFormat,
     bool fileColumnNamesReadAsLowerCase,
-    std::shared_ptr<random::RandomSkipTracker> randomSkip)
+    std::shared_ptr<random::RandomSkipTracker> randomSkip,
+    std::optional<int64_t> fileModificationTime)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
@@ -168,23 +170,22 @@ ReaderBase::ReaderBase(
     input_->load(LogType::FOOTER);
   }
 
-  auto footerStream = input_->read(
-      fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
-  if (fileFormat == FileFormat::DWRF) {
-    auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
-    ProtoUtils::readProtoInto<proto::Footer>(
-        createDecompressedStream(std::move(footerStream), "File Footer"),
-        footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+  auto cacheKey = dwio::common::FileMetadataCache::makeKey(
+      *input_->getReadFile(), fileFormat, fileModificationTime);
+  if (cacheKey.has_value()) {
+    parsedFooter_ =
+        dwio::common::FileMetadataCache::instance().get<ParsedFooter>(
+            *cacheKey, [&]() {
+              auto footer = parseFooter(fileFormat, footerSize);
+              const uint64_t bytes = footer->arena->SpaceUsed();
+              return std::make_pair(std::move(footer), bytes);
+            });
   } else {
-    auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
-    ProtoUtils::readProtoInto<proto::orc::Footer>(
-        createDecompressedStream(std::move(footerStream), "File Footer"),
-        footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    parsedFooter_ = parseFooter(fileFormat, footerSize);
   }
+  footer_ = parsedFooter_->dwrfFooter != nullptr
+      ? std::make_unique<FooterWrapper>(parsedFooter_->dwrfFooter)
+      : std::make_unique<FooterWrapper>(parsedFooter_->orcFooter);
 
   schema_ = std::dynamic_pointer_cast<const RowType>(
       convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
@@ -225,6 +226,31 @@ ReaderBase::ReaderBase(
   handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
 }
 
+std::shared_ptr<const ReaderBase::ParsedFooter> ReaderBase::parseFooter(
+    FileFormat fileFormat,
+    uint64_t footerSize) {
+  auto parsed = std::make_shared<ParsedFooter>();
+  parsed->arena = std::make_unique<google::protobuf::Arena>();
+  auto footerStream = input_->read(
+      fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
+  if (fileFormat == FileFormat::DWRF) {
+    auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(
+        parsed->arena.get());
+    ProtoUtils::readProtoInto<proto::Footer>(
+        createDecompressedStream(std::move(footerStream), "File Footer"),
+        footer);
+    parsed->dwrfFooter = footer;
+  } else {
+    auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
+        parsed->arena.get());
+    ProtoUtils::readProtoInto<proto::orc::Footer>(
+        createDecompressedStream(std::move(footerStream), "File Footer"),
+        footer);
+    parsed->orcFooter = footer;
+  }
+  return parsed;
+}
+
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
   std::vector<uint64_t> rowsPerStripe;
   auto numStripes = getFooter().stripesSize();
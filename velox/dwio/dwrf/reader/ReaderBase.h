@@ -72,7 +72,8 @@ class ReaderBase {
           dwio::common::ReaderOptions::kDefaultFilePreloadThreshold,
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       bool fileColumnNamesReadAsLowerCase = false,
-      std::shared_ptr<random::RandomSkipTracker> randomSkip = nullptr);
+      std::shared_ptr<random::RandomSkipTracker> randomSkip = nullptr,
+      std::optional<int64_t> fileModificationTime = std::nullopt);
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -237,6 +238,19 @@ class ReaderBase {
   }
 
  private:
+  // A file footer parsed into its own arena, so that it can be shared by the
+  // readers of different splits through FileMetadataCache.
+  struct ParsedFooter {
+    std::unique_ptr<google::protobuf::Arena> arena;
+    const proto::Footer* dwrfFooter{nullptr};
+    const proto::orc::Footer* orcFooter{nullptr};
+  };
+
+  // Parses the footer of 'footerSize' bytes that precedes the post script.
+  std::shared_ptr<const ParsedFooter> parseFooter(
+      dwio::common::FileFormat fileFormat,
+      uint64_t footerSize);
+
   static std::shared_ptr<const Type> convertType(
       const FooterWrapper& footer,
       uint32_t index = 0,
@@ -245,6 +259,9 @@ class ReaderBase {
   memory::MemoryPool& pool_;
   std::unique_ptr<google::protobuf::Arena> arena_;
   std::unique_ptr<PostScript> postScript_;
+  // Owns the footer referenced by 'footer_' if the reader was created from a
+  // file.
+  std::shared_ptr<const ParsedFooter> parsedFooter_;
   std::unique_ptr<FooterWrapper> footer_ = nullptr;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
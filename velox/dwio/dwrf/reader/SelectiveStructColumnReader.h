@@ -86,6 +86,11 @@ struct SelectiveStructColumnReader : SelectiveStructColumnReaderBase {
       common::ScanSpec& scanSpec,
       bool isRoot = false);
 
+  ~SelectiveStructColumnReader() override {
+    // Prefetched LazyVector loads use the child readers.
+    finishPrefetches();
+  }
+
  private:
   void addChild(std::unique_ptr<SelectiveColumnReader> child) {
     children_.push_back(child.get());
@@ -3204,6 +3204,46 @@ TEST_F(ColumnWriterTest, IntegerDictionaryDictionaryEncodableWriterCtor) {
   testIntegerDictionaryEncodableWriterConstructor<int64_t>();
 }
 
+TEST_F(ColumnWriterTest, encodingSelectionObjective) {
+  struct TestCase {
+    EncodingSelectionObjective objective;
+    int32_t numDistinct;
+    bool keepDictionary;
+  };
+  // 1'000 values of 10 bytes. With 900 distinct values, the dictionary is a
+  // bit larger than the values. With 100, it is much smaller.
+  const std::vector<TestCase> testCases{
+      {EncodingSelectionObjective::kFileSize, 900, false},
+      {EncodingSelectionObjective::kWriteCpu, 900, false},
+      {EncodingSelectionObjective::kReadCpu, 900, true},
+      {EncodingSelectionObjective::kFileSize, 100, true},
+      {EncodingSelectionObjective::kWriteCpu, 100, true},
+      {EncodingSelectionObjective::kReadCpu, 100, true},
+  };
+  auto typeWithId = TypeWithId::create(VARCHAR(), 1);
+  for (const auto& testCase : testCases) {
+    SCOPED_TRACE(fmt::format(
+        "objective {}, {} distinct",
+        static_cast<int>(testCase.objective),
+        testCase.numDistinct));
+    auto vector = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), 1'000, pool_.get());
+    for (auto i = 0; i < vector->size(); ++i) {
+      const auto value = fmt::format("{:010}", i % testCase.numDistinct);
+      vector->set(i, StringView(value));
+    }
+
+    auto config = std::make_shared<Config>();
+    config->set(Config::ENCODING_SELECTION_OBJECTIVE, testCase.objective);
+    WriterContext context{config, memory::memoryManager()->addRootPool()};
+    context.initBuffer();
+    auto writer = BaseColumnWriter::create(context, *typeWithId);
+    writer->write(vector, common::Ranges::of(0, vector->size()));
+    writer->createIndexEntry();
+    ASSERT_EQ(writer->tryAbandonDictionaries(false), !testCase.keepDictionary);
+  }
+}
+
 std::string
 generateSomewhatRandomStringData(size_t /*unused*/, size_t i, size_t size) {
   return folly::to<std::string>(generateSomewhatRandomData(i, size, 0, 0));
@@ -22,6 +22,8 @@
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <folly/Random.h>
+#include <folly/ScopeGuard.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include "velox/common/compression/Compression.h"
 
@@ -285,6 +287,85 @@ TEST_P(CompressionTest, compressProtoBuf) {
   verifyProto(memSink, kind_, block, *pool_, ps, decrypter_);
 }
 
+namespace {
+// Declines every other job and fails the rest, so that all of them are
+// decompressed by the software fallback.
+class DecliningAccelerator
+    : public facebook::velox::dwio::common::compression::
+          DecompressionAccelerator {
+ public:
+  std::optional<folly::SemiFuture<uint64_t>> submit(
+      const char* /*src*/,
+      uint64_t /*srcLength*/,
+      char* /*dest*/,
+      uint64_t /*destLength*/) override {
+    if (numSubmits_++ % 2 == 0) {
+      return std::nullopt;
+    }
+    return folly::makeSemiFuture<uint64_t>(
+        std::runtime_error("Accelerator failure"));
+  }
+
+  int32_t numSubmits() const {
+    return numSubmits_;
+  }
+
+ private:
+  std::atomic<int32_t> numSubmits_{0};
+};
+} // namespace
+
+TEST_P(CompressionTest, decompressionAcceleratorFallback) {
+  namespace compression = facebook::velox::dwio::common::compression;
+  auto accelerator = std::make_shared<DecliningAccelerator>();
+  compression::registerDecompressionAccelerator(kind_, accelerator);
+  SCOPE_EXIT {
+    compression::unregisterDecompressionAccelerators();
+  };
+
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
+  constexpr uint64_t block = 128;
+  constexpr size_t size = 1024;
+  char testData[size];
+  std::memset(testData, 'a', size);
+  compressAndVerify(kind_, memSink, block, *pool_, testData, size, encrypter_);
+  decompressAndVerify(
+      memSink, kind_, block, testData, size, *pool_, decrypter_);
+  if (kind_ == CompressionKind_NONE) {
+    ASSERT_EQ(accelerator->numSubmits(), 0);
+  } else {
+    ASSERT_GT(accelerator->numSubmits(), 1);
+  }
+}
+
+TEST_P(CompressionTest, softwareDecompressionAccelerator) {
+  if (kind_ == CompressionKind_NONE) {
+    return;
+  }
+  namespace compression = facebook::velox::dwio::common::compression;
+  folly::CPUThreadPoolExecutor executor(2);
+  auto accelerator =
+      std::make_shared<compression::SoftwareDecompressionAccelerator>(
+          kind_, getDwrfOrcDecompressionOptions(kind_), &executor);
+  compression::registerDecompressionAccelerator(kind_, accelerator);
+  SCOPE_EXIT {
+    compression::unregisterDecompressionAccelerators();
+  };
+
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
+  constexpr uint64_t block = 128;
+  constexpr size_t size = 64 * 1024;
+  std::vector<char> testData(size);
+  for (auto i = 0; i < size; ++i) {
+    testData[i] = static_cast<char>('a' + (i / 3) % 7);
+  }
+  compressAndVerify(
+      kind_, memSink, block, *pool_, testData.data(), size, encrypter_);
+  decompressAndVerify(
+      memSink, kind_, block, testData.data(), size, *pool_, decrypter_);
+  ASSERT_GT(accelerator->numJobs(), 1);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     TestCompression,
     CompressionTest,
@@ -18,6 +18,7 @@
 #include <folly/Random.h>
 #include <folly/container/F14Map.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include "velox/common/io/AdaptiveIoController.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/dwio/common/Options.h"
@@ -186,3 +187,63 @@ TEST_F(DirectBufferedInputTest, basic) {
   // in one part.
   testLoads({{1000, 9000000}, {9010000, 1000000}}, 3);
 }
+
+namespace {
+// Records reads of 100KB to 5MB that take 1ms plus 1ms per MB.
+void recordSamples(io::StoragePerformance& performance) {
+  for (auto i = 1; i <= 50; ++i) {
+    const uint64_t bytes = i * 100'000;
+    performance.record(bytes, 1'000 + bytes / 1'000);
+  }
+}
+} // namespace
+
+TEST_F(DirectBufferedInputTest, storagePerformance) {
+  ASSERT_EQ(io::StoragePerformance::fileSystemOf("s3://bucket/key"), "s3");
+  ASSERT_EQ(io::StoragePerformance::fileSystemOf("/local/file"), "file");
+
+  io::StoragePerformance performance;
+  ASSERT_FALSE(performance.estimate().has_value());
+  // Same size reads do not tell latency from throughput.
+  for (auto i = 0; i < 50; ++i) {
+    performance.record(1'000'000, 2'000);
+  }
+  ASSERT_FALSE(performance.estimate().has_value());
+
+  performance.clear();
+  recordSamples(performance);
+  auto estimate = performance.estimate();
+  ASSERT_TRUE(estimate.has_value());
+  ASSERT_NEAR(estimate->latencyMicros, 1'000, 1);
+  ASSERT_NEAR(estimate->bytesPerMicro, 1'000, 1);
+
+  // Coalesces gaps up to the 1MB transferred in one latency and loads 4 times
+  // that, rounded to 64K.
+  auto adapted = io::AdaptiveIoController::adapt(*opts_, performance);
+  ASSERT_NEAR(adapted.maxCoalesceDistance(), 1'000'000, 1'000);
+  ASSERT_EQ(adapted.loadQuantum(), 62 << 16);
+
+  // The configured quantum is an upper bound.
+  opts_->setLoadQuantum(2 << 20);
+  adapted = io::AdaptiveIoController::adapt(*opts_, performance);
+  ASSERT_EQ(adapted.loadQuantum(), 2 << 20);
+}
+
+TEST_F(DirectBufferedInputTest, adaptiveIoTuning) {
+  auto& performance = io::StoragePerformance::forPath(file_->getName());
+  performance.clear();
+  recordSamples(performance);
+
+  makeInput();
+  ASSERT_EQ(ioStats_->adaptiveLoadQuantum().count(), 0);
+
+  opts_->setAdaptiveIoTuning(true);
+  makeInput();
+  ASSERT_EQ(ioStats_->adaptiveLoadQuantum().count(), 1);
+  ASSERT_EQ(ioStats_->adaptiveLoadQuantum().sum(), 62 << 16);
+  ASSERT_NEAR(ioStats_->adaptiveCoalesceDistance().sum(), 1'000'000, 1'000);
+
+  // Reads with the adapted options return the right data.
+  testLoads({{100, 100}, {500'000, 3'000'000}}, 1);
+  performance.clear();
+}
@@ -215,6 +215,24 @@ TEST_F(E2EFilterTest, integerDictionary) {
       true);
 }
 
+TEST_F(E2EFilterTest, integerRle) {
+  // Runs of repeated values are filtered once per run.
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint",
+      [&]() {
+        makeIntRle<int16_t>("short_val");
+        makeIntRle<int32_t>("int_val");
+        makeIntRle<int64_t>("long_val");
+      },
+      true,
+      {"short_val", "int_val", "long_val"},
+      20,
+      true,
+      true);
+}
+
 TEST_F(E2EFilterTest, byteRle) {
   testWithTypes(
       "tiny_val:tinyint,"
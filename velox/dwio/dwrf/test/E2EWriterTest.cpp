@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -945,6 +946,61 @@ TEST_F(E2EWriterTest, PartialStride) {
   ASSERT_EQ(true, reader->columnStatistics(1)->hasNull().value());
 }
 
+TEST_F(E2EWriterTest, parallelEncoding) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "bool_val:boolean,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "list_val:array<bigint>,"
+      "map_val:map<int, string>,"
+      "struct_val:struct<a:bigint, b:string>"
+      ">");
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 1'000, *leafPool_, nullptr, i));
+  }
+
+  auto writeFile = [&](std::shared_ptr<folly::Executor> executor) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::STRIPE_SIZE, 64 * 1024UL);
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = std::move(executor);
+    options.encodingParallelismFactor = 4;
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto expected = writeFile(nullptr);
+  const auto actual =
+      writeFile(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  ASSERT_EQ(expected, actual);
+
+  std::string_view data(actual.data(), actual.size());
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = std::make_unique<dwrf::DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(data), *leafPool_));
+  ASSERT_GT(reader->getNumberOfStripes(), 1);
+  ASSERT_EQ(reader->numberOfRows().value(), 10'000);
+}
+
 TEST_F(E2EWriterTest, OversizeRows) {
   auto pool = facebook::velox::memory::memoryManager()->addLeafPool();
 
@@ -2554,6 +2554,47 @@ TEST_F(TestReader, readStructWithWholeBatchFiltered) {
   }
 }
 
+TEST_F(TestReader, skipStripesByKeyIndex) {
+  // One stripe per batch with sorted keys.
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [i](auto row) { return i * 100 + row; }),
+        makeFlatVector<int32_t>(100, folly::identity),
+    }));
+  }
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::STRIPE_KEY_INDEX_COLS, {0});
+  auto [writer, reader] = createWriterReader(batches, pool(), config);
+  ASSERT_EQ(reader->getNumberOfStripes(), 4);
+  ASSERT_TRUE(reader->hasMetadataValue("orc.stripe.key.index.0"));
+  ASSERT_FALSE(reader->hasMetadataValue("orc.stripe.key.index.1"));
+
+  auto rowType = reader->rowType();
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType);
+  spec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(250, 260, false));
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createDwrfRowReader(rowReaderOpts);
+  auto result = BaseVector::create(rowType, 0, pool());
+  vector_size_t numRows = 0;
+  while (rowReader->next(1'000, result)) {
+    numRows += result->size();
+  }
+  ASSERT_EQ(numRows, 11);
+
+  // Only stripe 2 is loaded and filtered by its row group statistics.
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  ASSERT_EQ(stats.skippedStrides, 3);
+  ASSERT_FALSE(rowReader->stridesToSkip(0).has_value());
+  ASSERT_FALSE(rowReader->stridesToSkip(1).has_value());
+  ASSERT_TRUE(rowReader->stridesToSkip(2).has_value());
+  ASSERT_FALSE(rowReader->stridesToSkip(3).has_value());
+}
+
 TEST_F(TestReader, readStringDictionaryAsFlat) {
   std::vector<std::string> dictionary;
   for (int i = 0; i < 26; ++i) {
@@ -18,9 +18,13 @@
 #include <folly/String.h>
 #include <folly/compression/Compression.h>
 #include <folly/compression/Zlib.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MmapAllocator.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
@@ -834,6 +838,102 @@ TEST_F(DecompressionTest, testDelayedSkip) {
   ASSERT_THROW(result->Next(&data, &length), VeloxException);
 }
 
+namespace {
+// SeekableArrayInputStream that reports its bytes as cached in 'cache'.
+class CachedArrayInputStream : public SeekableArrayInputStream {
+ public:
+  CachedArrayInputStream(
+      const char* data,
+      uint64_t length,
+      uint64_t blockSize,
+      cache::AsyncDataCache* cache,
+      uint64_t fileNum)
+      : SeekableArrayInputStream(data, length, blockSize),
+        cache_(cache),
+        fileNum_(fileNum) {}
+
+  std::optional<CachedFileLocation> cachedFileLocation(
+      uint64_t streamOffset) const override {
+    return CachedFileLocation{cache_, fileNum_, streamOffset};
+  }
+
+ private:
+  cache::AsyncDataCache* const cache_;
+  const uint64_t fileNum_;
+};
+} // namespace
+
+TEST_F(DecompressionTest, cachedDecompressedChunks) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_cache_decompressed_chunks = true;
+  memory::MmapAllocator::Options options;
+  options.capacity = 64 << 20;
+  auto allocator = std::make_shared<memory::MmapAllocator>(options);
+  auto cache = cache::AsyncDataCache::create(allocator.get());
+  StringIdLease fileId(fileIds(), "cachedDecompressedChunks");
+
+  // A chunk larger than AsyncDataCacheEntry::kTinyDataSize and a small one.
+  constexpr int32_t kLargeSize = 40'000;
+  constexpr int32_t kSmallSize = 100;
+  std::vector<int32_t> values(kLargeSize / sizeof(int32_t));
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = i;
+  }
+  std::vector<char> compressed(2 * kLargeSize);
+  std::vector<size_t> chunkStarts;
+  size_t totalCompressed = 0;
+  for (auto chunkSize : {kLargeSize, kSmallSize}) {
+    auto ioBuf = folly::IOBuf::wrapBuffer(values.data(), chunkSize);
+    auto cbuf = getCodec(CodecType::ZSTD)->compress(ioBuf.get());
+    CompressBuffer::writeHeader(cbuf->length(), &compressed[totalCompressed]);
+    chunkStarts.push_back(totalCompressed + HEADER_SIZE);
+    memcpy(
+        &compressed[totalCompressed + HEADER_SIZE],
+        cbuf->data(),
+        cbuf->length());
+    totalCompressed += HEADER_SIZE + cbuf->length();
+  }
+
+  auto readAll = [&]() {
+    auto stream = createTestDecompressor(
+        CompressionKind_ZSTD,
+        std::make_unique<CachedArrayInputStream>(
+            compressed.data(), totalCompressed, 97, cache.get(), fileId.id()),
+        kLargeSize);
+    const void* data;
+    int32_t size;
+    for (auto chunkSize : {kLargeSize, kSmallSize}) {
+      ASSERT_TRUE(stream->Next(&data, &size));
+      ASSERT_EQ(size, chunkSize);
+      ASSERT_EQ(memcmp(data, values.data(), chunkSize), 0);
+    }
+    ASSERT_FALSE(stream->Next(&data, &size));
+  };
+
+  readAll();
+  ASSERT_EQ(cache->refreshStats().numEntries, 2);
+
+  // Corrupt the compressed data. The chunks now come from the cache without
+  // decompression.
+  for (auto start : chunkStarts) {
+    memset(&compressed[start], 0xAA, 10);
+  }
+  readAll();
+  ASSERT_EQ(cache->refreshStats().numEntries, 2);
+
+  // Without the flag the corrupt data is decompressed.
+  FLAGS_velox_cache_decompressed_chunks = false;
+  auto stream = createTestDecompressor(
+      CompressionKind_ZSTD,
+      std::make_unique<CachedArrayInputStream>(
+          compressed.data(), totalCompressed, 97, cache.get(), fileId.id()),
+      kLargeSize);
+  const void* data;
+  int32_t size;
+  ASSERT_THROW(stream->Next(&data, &size), VeloxException);
+  cache->shutdown();
+}
+
 void fillInput(char* buf, size_t size) {
   for (size_t i = 0; i < size; ++i) {
     buf[i] = folly::Random::rand32() % 26 + 'A';
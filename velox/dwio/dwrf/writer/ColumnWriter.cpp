@@ -15,10 +15,16 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+
+#include <deque>
+
+#include <folly/ScopeGuard.h>
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
+#include "velox/dwio/dwrf/writer/EncodingCostModel.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
 #include "velox/dwio/dwrf/writer/FlatMapColumnWriter.h"
 #include "velox/dwio/dwrf/writer/IntegerDictionaryEncoder.h"
@@ -35,7 +41,14 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  // The columns encoded in parallel can not share the SelectivityVector.
+  std::optional<SelectivityVector> localSelected;
+  if (context_.encodingInParallel()) {
+    localSelected.emplace(slice->size());
+  }
+  auto& selected = localSelected.has_value()
+      ? localSelected.value()
+      : context_.getSharedSelectivityVector(slice->size());
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -210,6 +223,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
             /*initialCapacity=*/16},
         dictionaryKeySizeThreshold_{
             getConfig(Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD)},
+        costModel_{getConfig(Config::ENCODING_SELECTION_OBJECTIVE)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
@@ -405,6 +419,9 @@ class IntegerColumnWriter : public BaseColumnWriter {
 
   // NOTE: This should be called *before* clearing the rows_ buffer.
   bool shouldKeepDictionary() const {
+    if (costModel_.enabled()) {
+      return useDictionaryByCost();
+    }
     // TODO(T91508412): Move the dictionary efficiency based decision into
     // dictionary encoder.
     auto totalElementCount = dictEncoder_.getTotalCount();
@@ -417,6 +434,26 @@ class IntegerColumnWriter : public BaseColumnWriter {
         dictionaryKeySizeThreshold_;
   }
 
+  // Returns the choice of 'costModel_' for the keys in 'dictEncoder_'.
+  bool useDictionaryByCost() const {
+    const bool useVInts = getConfig(Config::USE_VINTS);
+    uint64_t valueBytes = 0;
+    uint64_t keyBytes = 0;
+    for (uint32_t i = 0; i < dictEncoder_.size(); ++i) {
+      const uint64_t bytes = useVInts
+          ? EncodingCostModel::varintBytes(
+                ZigZag::encode(dictEncoder_.getKey(i)))
+          : sizeof(T);
+      keyBytes += bytes;
+      valueBytes += bytes * dictEncoder_.getCount(i);
+    }
+    return costModel_.useDictionary(
+        dictEncoder_.getTotalCount(),
+        valueBytes,
+        dictEncoder_.size(),
+        keyBytes);
+  }
+
   // Should be called only once per stripe for both flushing and abandoning
   // dictionary encoding.
   void populateStrides(
@@ -463,6 +500,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
   ChainedBuffer<uint32_t> rows_;
   size_t finalDictionarySize_;
   const float dictionaryKeySizeThreshold_;
+  const EncodingCostModel costModel_;
   const bool sort_;
   // This value could change if we are writing with low memory mode or if we
   // determine with the first stripe that the data is not fit for dictionary
@@ -807,6 +845,7 @@ class StringColumnWriter : public BaseColumnWriter {
             getConfig(Config::ENTROPY_STRING_MIN_SAMPLES),
             getConfig(Config::ENTROPY_STRING_DICT_SAMPLE_FRACTION),
             getConfig(Config::ENTROPY_STRING_THRESHOLD)},
+        costModel_{getConfig(Config::ENCODING_SELECTION_OBJECTIVE)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
@@ -1023,10 +1062,28 @@ class StringColumnWriter : public BaseColumnWriter {
 
   // NOTE: This should be called *before* clearing the rows_ buffer.
   bool shouldKeepDictionary() const {
+    if (costModel_.enabled()) {
+      return useDictionaryByCost();
+    }
     return rows_.size() != 0 &&
         encodingSelector_.useDictionary(dictEncoder_, rows_.size());
   }
 
+  // Returns the choice of 'costModel_' for the keys in 'dictEncoder_'. A
+  // value takes its bytes and the varint of its length in either encoding.
+  bool useDictionaryByCost() const {
+    uint64_t valueBytes = 0;
+    uint64_t keyBytes = 0;
+    for (uint32_t i = 0; i < dictEncoder_.size(); ++i) {
+      const auto size = dictEncoder_.getKey(i).size();
+      const uint64_t bytes = size + EncodingCostModel::varintBytes(size);
+      keyBytes += bytes;
+      valueBytes += bytes * dictEncoder_.getCount(i);
+    }
+    return costModel_.useDictionary(
+        rows_.size(), valueBytes, dictEncoder_.size(), keyBytes);
+  }
+
   // Should be called only once per stripe for both flushing and abandoning
   // dictionary encoding.
   void populateStrides(
@@ -1081,6 +1138,7 @@ class StringColumnWriter : public BaseColumnWriter {
   ChainedBuffer<uint32_t> rows_;
   size_t finalDictionarySize_;
   EntropyEncodingSelector encodingSelector_;
+  const EncodingCostModel costModel_;
   const bool sort_;
   // This value could change if we are writing with low memory mode or if we
   // determine with the first stripe that the data is not fit for dictionary
@@ -1611,26 +1669,105 @@ class StructColumnWriter : public BaseColumnWriter {
 
   void flush(
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
-      std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
-    BaseColumnWriter::flush(encodingFactory, encodingOverride);
-    for (auto& c : children_) {
-      c->flush(encodingFactory);
-    }
-  }
+      std::function<void(proto::ColumnEncoding&)> encodingOverride) override;
+
+  /// Makes the root writer encode and flush its children in parallel on the
+  /// encoding executor of the context, if any. Flat maps share dictionaries
+  /// and encryption shares the encrypters between the columns, so these stay
+  /// sequential.
+  void setupParallelEncoding();
 
  private:
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
+
+  // Flushes the children in parallel. The encodings are collected per child
+  // and added with 'encodingFactory' in the order of the children so that the
+  // file does not depend on the scheduling.
+  void flushChildrenInParallel(
+      std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory);
+
+  // Runs 'func' for each child on the encoding executor. Set for the root
+  // writer only.
+  std::unique_ptr<dwio::common::ParallelFor> parallelForOnChildren_;
 };
 
+void StructColumnWriter::setupParallelEncoding() {
+  VELOX_CHECK(isRoot());
+  auto* executor = context_.encodingExecutor();
+  if (executor == nullptr || context_.encodingParallelismFactor() <= 1 ||
+      children_.size() <= 1 || context_.getConfig(Config::FLATTEN_MAP) ||
+      context_.getEncryptionHandler().isEncrypted()) {
+    return;
+  }
+  parallelForOnChildren_ = std::make_unique<dwio::common::ParallelFor>(
+      executor,
+      0,
+      children_.size(),
+      context_.encodingParallelismFactor());
+}
+
+void StructColumnWriter::flush(
+    std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
+    std::function<void(proto::ColumnEncoding&)> encodingOverride) {
+  BaseColumnWriter::flush(encodingFactory, encodingOverride);
+  if (parallelForOnChildren_ != nullptr) {
+    flushChildrenInParallel(encodingFactory);
+    return;
+  }
+  for (auto& c : children_) {
+    c->flush(encodingFactory);
+  }
+}
+
+void StructColumnWriter::flushChildrenInParallel(
+    std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory) {
+  // A deque keeps the references returned to the child writers valid.
+  std::vector<std::deque<std::pair<uint32_t, proto::ColumnEncoding>>>
+      encodings(children_.size());
+  context_.setEncodingInParallel(true);
+  SCOPE_EXIT {
+    context_.setEncodingInParallel(false);
+  };
+  parallelForOnChildren_->execute([&](size_t i) {
+    auto& childEncodings = encodings[i];
+    children_[i]->flush([&](uint32_t nodeId) -> proto::ColumnEncoding& {
+      return childEncodings.emplace_back(nodeId, proto::ColumnEncoding{})
+          .second;
+    });
+  });
+  for (auto& childEncodings : encodings) {
+    for (auto& [nodeId, encoding] : childEncodings) {
+      encodingFactory(nodeId).Swap(&encoding);
+    }
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
-  if (ranges.size() > 0) {
+  if (ranges.size() > 0 && parallelForOnChildren_ != nullptr) {
+    // Lazy vectors are loaded sequentially since their readers may not be
+    // thread safe.
+    for (const auto& child : rowSlice->children()) {
+      child->loadedVector();
+    }
+    std::vector<uint64_t> rawSizes(children_.size());
+    context_.setEncodingInParallel(true);
+    SCOPE_EXIT {
+      context_.setEncodingInParallel(false);
+    };
+    parallelForOnChildren_->execute([&](size_t i) {
+      rawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+    });
+    for (const auto size : rawSizes) {
+      rawSize += size;
+    }
+  } else if (ranges.size() > 0) {
     for (size_t i = 0; i < children_.size(); ++i) {
       rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
     }
@@ -2057,6 +2194,9 @@ std::unique_ptr<BaseColumnWriter> BaseColumnWriter::create(
       for (int32_t i = 0; i < type.size(); ++i) {
         ret->children_.push_back(create(context, *type.childAt(i), sequence));
       }
+      if (ret->isRoot()) {
+        ret->setupParallelEncoding();
+      }
       return ret;
     }
     case TypeKind::MAP: {
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "velox/common/base/GTestMacros.h"
 #include "velox/dwio/common/OutputStream.h"
 #include "velox/dwio/dwrf/common/ByteRLE.h"
@@ -54,6 +56,13 @@ class ColumnWriter {
 
   virtual bool tryAbandonDictionaries(bool force) = 0;
 
+  /// Writes the statistics of the stripe being flushed for each top level
+  /// column in Config::STRIPE_KEY_INDEX_COLS to 'statsFactory(column)' and
+  /// starts the statistics of the next stripe.
+  virtual void writeStripeKeyStats(
+      const std::function<proto::ColumnStatistics&(uint32_t)>&
+      /* statsFactory */) {}
+
  protected:
   ColumnWriter(
       WriterContext& context,
@@ -82,6 +91,9 @@ class BaseColumnWriter : public ColumnWriter {
     // We cannot determine the physical size of columns/nodes until flush
     // time, yet we need to maintain and aggregate logical stats.
     fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
+    if (stripeStatsBuilder_) {
+      stripeStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
+    }
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
     recordPosition();
@@ -131,6 +143,18 @@ class BaseColumnWriter : public ColumnWriter {
     return size;
   }
 
+  void writeStripeKeyStats(
+      const std::function<proto::ColumnStatistics&(uint32_t)>& statsFactory)
+      override {
+    if (stripeStatsBuilder_) {
+      stripeStatsBuilder_->toProto(statsFactory(type_.column()));
+      stripeStatsBuilder_->reset();
+    }
+    for (auto& child : children_) {
+      child->writeStripeKeyStats(statsFactory);
+    }
+  }
+
   /// Determines whether dictionary is the right encoding to use when writing
   /// the first stripe. We will continue using the same decision for all
   /// subsequent stripes. Returns true if an encoding change is performed, false
@@ -172,6 +196,19 @@ class BaseColumnWriter : public ColumnWriter {
         StatisticsBuilderOptions::fromConfig(context.getConfigs());
     indexStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
     fileStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
+    if (isStripeKeyIndexColumn()) {
+      stripeStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
+    }
+  }
+
+  bool isStripeKeyIndexColumn() const {
+    if (type_.parent() == nullptr || type_.parent()->id() != 0 ||
+        context_.getEncryptionHandler().isEncrypted(id_)) {
+      return false;
+    }
+    const auto& columns = context_.getConfig(Config::STRIPE_KEY_INDEX_COLS);
+    return std::find(columns.begin(), columns.end(), type_.column()) !=
+        columns.end();
   }
 
   uint64_t writeNulls(const VectorPtr& slice, const common::Ranges& ranges) {
@@ -262,6 +299,9 @@ class BaseColumnWriter : public ColumnWriter {
   std::unique_ptr<IndexBuilder> indexBuilder_;
   std::unique_ptr<StatisticsBuilder> indexStatsBuilder_;
   std::unique_ptr<StatisticsBuilder> fileStatsBuilder_;
+  // Statistics of the current stripe. Set only for the columns in
+  // Config::STRIPE_KEY_INDEX_COLS.
+  std::unique_ptr<StatisticsBuilder> stripeStatsBuilder_;
   std::unique_ptr<ByteRleEncoder> present_;
   bool hasNull_ = false;
   // callback used to inject the logic that captures positions for flat map
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/dwrf/common/Common.h"
+
+namespace facebook::velox::dwrf {
+
+/// Chooses between dictionary and direct encoding for a column at the end of
+/// the first stripe. Estimates the bytes of both encodings before compression
+/// from what the dictionary encoder saw and weighs them by 'objective'.
+class EncodingCostModel {
+ public:
+  explicit EncodingCostModel(EncodingSelectionObjective objective)
+      : objective_{objective} {}
+
+  /// False if the writer decides with the key size thresholds.
+  bool enabled() const {
+    return objective_ != EncodingSelectionObjective::kThreshold;
+  }
+
+  /// Returns true if dictionary encoding is the better choice for
+  /// 'numValues' non-null values whose direct encoding takes 'valueBytes'
+  /// and whose dictionary has 'numKeys' keys taking 'keyBytes'.
+  bool useDictionary(
+      uint64_t numValues,
+      uint64_t valueBytes,
+      uint64_t numKeys,
+      uint64_t keyBytes) const {
+    if (numValues == 0) {
+      return false;
+    }
+    const auto dictionary = static_cast<double>(
+        keyBytes + numValues * varintBytes(numKeys == 0 ? 0 : numKeys - 1));
+    const auto direct = static_cast<double>(valueBytes);
+    switch (objective_) {
+      case EncodingSelectionObjective::kFileSize:
+        return dictionary <= direct;
+      case EncodingSelectionObjective::kWriteCpu:
+        // Hashing every value and encoding the dictionary at flush costs
+        // more than copying the values, so the dictionary has to save a lot.
+        return dictionary * kWriteCpuDictionaryCost <= direct;
+      case EncodingSelectionObjective::kReadCpu:
+        // Readers decode each key once, evaluate filters once per key and
+        // produce dictionary vectors, which pays for some extra bytes.
+        return dictionary <= direct * kReadCpuDictionaryBenefit;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  /// The bytes of 'value' as a varint.
+  static uint64_t varintBytes(uint64_t value) {
+    return (64 - __builtin_clzll(value | 1) + 6) / 7;
+  }
+
+ private:
+  static constexpr double kWriteCpuDictionaryCost = 2.0;
+  static constexpr double kReadCpuDictionaryBenefit = 1.25;
+
+  const EncodingSelectionObjective objective_;
+};
+
+} // namespace facebook::velox::dwrf
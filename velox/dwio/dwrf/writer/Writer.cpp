@@ -98,6 +98,10 @@ Writer::Writer(
     layoutPlanner_ = std::make_unique<LayoutPlanner>(*schema_);
   }
 
+  if (options.encodingExecutor != nullptr) {
+    context.setEncodingExecutor(
+        options.encodingExecutor, options.encodingParallelismFactor);
+  }
   if (options.columnWriterFactory == nullptr) {
     writer_ = BaseColumnWriter::create(writerBase_->getContext(), *schema_);
   } else {
@@ -423,6 +427,10 @@ void Writer::flushStripe(bool close) {
   writer_->flush([&](uint32_t nodeId) -> proto::ColumnEncoding& {
     return encodingManager.addEncodingToFooter(nodeId);
   });
+  writer_->writeStripeKeyStats(
+      [&](uint32_t column) -> proto::ColumnStatistics& {
+        return *stripeKeyIndexes_[column].add_entry()->mutable_statistics();
+      });
 
   // Collects the memory increment from flushing data to output streams.
   const auto postFlushStreamMemoryUsage =
@@ -655,6 +663,11 @@ void Writer::flushInternal(bool close) {
         }
       }
 
+      for (const auto& [column, index] : stripeKeyIndexes_) {
+        writerBase_->addUserMetadata(
+            std::string{STRIPE_KEY_INDEX_KEY_PREFIX} + std::to_string(column),
+            index.SerializeAsString());
+      }
       writerBase_->writeFooter(*schema_->type());
     }
 
@@ -820,6 +833,8 @@ dwrf::WriterOptions getDwrfOptions(const dwio::common::WriterOptions& options) {
   dwrfOptions.memoryPool = options.memoryPool;
   dwrfOptions.spillConfig = options.spillConfig;
   dwrfOptions.nonReclaimableSection = options.nonReclaimableSection;
+  dwrfOptions.encodingExecutor = options.encodingExecutor;
+  dwrfOptions.encodingParallelismFactor = options.encodingParallelismFactor;
   return dwrfOptions;
 }
 
@@ -18,6 +18,7 @@
 
 #include <iterator>
 #include <limits>
+#include <map>
 
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
@@ -51,6 +52,12 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// If set, the top level columns are encoded and flushed in parallel on
+  /// this executor with up to 'encodingParallelismFactor' threads, the
+  /// calling thread included. The file is the same as with sequential
+  /// encoding.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
 };
 
 class Writer : public dwio::common::Writer {
@@ -210,6 +217,9 @@ class Writer : public dwio::common::Writer {
   std::unique_ptr<DWRFFlushPolicy> flushPolicy_;
   std::unique_ptr<LayoutPlanner> layoutPlanner_;
   std::unique_ptr<ColumnWriter> writer_;
+  // For each column in Config::STRIPE_KEY_INDEX_COLS, the statistics of the
+  // stripes flushed so far. Added to the footer metadata on close.
+  std::map<uint32_t, proto::RowIndex> stripeKeyIndexes_;
 };
 
 class DwrfWriterFactory : public dwio::common::WriterFactory {
@@ -146,6 +146,7 @@ void WriterContext::releaseMemoryReservation() {
 
 void WriterContext::abort() {
   compressionBuffer_.reset();
+  extraCompressionBuffers_.clear();
   physicalSizeAggregators_.clear();
   streams_.clear();
   dictEncoders_.clear();
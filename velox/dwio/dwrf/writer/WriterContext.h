@@ -17,6 +17,10 @@
 #pragma once
 
 #include <limits>
+#include <mutex>
+
+#include <folly/Executor.h>
+
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -71,6 +75,7 @@ class WriterContext : public CompressionBufferPool {
   // flush policy evaluation and would be more accurate after flush.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     VELOX_CHECK(
         !hasStream(stream), "Stream already exists: {}", stream.toString());
 
@@ -143,6 +148,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     VELOX_CHECK(hasStream(stream));
     auto& collector = streams_.at(stream);
     collector.suppress();
@@ -251,8 +257,20 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Returns the compression buffer. When the columns are encoded in
+  /// parallel and the buffer is in use, returns an extra buffer.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    if (compressionBuffer_ == nullptr && encodingExecutor_ != nullptr) {
+      if (!extraCompressionBuffers_.empty()) {
+        compressionBuffer_ = std::move(extraCompressionBuffers_.back());
+        extraCompressionBuffers_.pop_back();
+      } else {
+        compressionBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
+            *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+      }
+    }
     VELOX_CHECK_NOT_NULL(compressionBuffer_);
     VELOX_CHECK_GE(compressionBuffer_->size(), size);
     return std::move(compressionBuffer_);
@@ -261,10 +279,43 @@ class WriterContext : public CompressionBufferPool {
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    if (compressionBuffer_ != nullptr && encodingExecutor_ != nullptr) {
+      extraCompressionBuffers_.push_back(std::move(buffer));
+      return;
+    }
     VELOX_CHECK_NULL(compressionBuffer_);
     compressionBuffer_ = std::move(buffer);
   }
 
+  /// Sets the executor on which the root writer encodes and flushes its
+  /// columns with up to 'parallelismFactor' threads, the calling thread
+  /// included.
+  void setEncodingExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelismFactor) {
+    encodingExecutor_ = std::move(executor);
+    encodingParallelismFactor_ = parallelismFactor;
+  }
+
+  folly::Executor* encodingExecutor() const {
+    return encodingExecutor_.get();
+  }
+
+  size_t encodingParallelismFactor() const {
+    return encodingParallelismFactor_;
+  }
+
+  /// True while the root writer encodes or flushes its columns in parallel.
+  /// The shared SelectivityVector must not be used then.
+  bool encodingInParallel() const {
+    return encodingInParallel_;
+  }
+
+  void setEncodingInParallel(bool inParallel) {
+    encodingInParallel_ = inParallel;
+  }
+
   void incrementNodeSize(uint32_t node, uint64_t size) {
     nodeSize_[node] += size;
   }
@@ -594,6 +645,7 @@ class WriterContext : public CompressionBufferPool {
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(decodedVectorPoolMutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -603,6 +655,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(decodedVectorPoolMutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -631,6 +684,8 @@ class WriterContext : public CompressionBufferPool {
       DataBufferHolder,
       dwio::common::StreamIdentifierHash>
       streams_;
+  // Serializes the changes to 'streams_' by columns encoded in parallel.
+  std::mutex streamsMutex_;
   folly::F14NodeMap<uint32_t, std::unique_ptr<PhysicalSizeAggregator>>
       physicalSizeAggregators_;
   folly::F14FastMap<
@@ -642,8 +697,14 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Compression buffers for the streams compressed at the same time as the
+  // one using 'compressionBuffer_' when the columns are encoded in parallel.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      extraCompressionBuffers_;
+  std::mutex compressionBufferMutex_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
+  std::mutex decodedVectorPoolMutex_;
   // Reusable SelectivityVector
   std::unique_ptr<velox::SelectivityVector> selectivityVector_;
 
@@ -657,6 +718,10 @@ class WriterContext : public CompressionBufferPool {
   bool checkLowMemoryMode_;
   bool lowMemoryMode_{false};
 
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  size_t encodingParallelismFactor_{0};
+  bool encodingInParallel_{false};
+
   /// stats
   uint32_t stripeIndex_{0};
   uint64_t fileRowCount_{0};
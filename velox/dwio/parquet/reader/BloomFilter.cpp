@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <thrift/protocol/TCompactProtocol.h>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+// static
+std::unique_ptr<BlockSplitBloomFilter> BlockSplitBloomFilter::read(
+    dwio::common::BufferedInput& input,
+    uint64_t offset) {
+  const uint64_t fileSize = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize, "Bloom filter offset is past end of file");
+
+  const uint64_t headerReadSize = std::min(kMaxHeaderSize, fileSize - offset);
+  std::vector<char> headerBuffer(headerReadSize);
+  auto stream =
+      input.read(offset, headerReadSize, dwio::common::LogType::HEADER);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      headerReadSize, stream.get(), headerBuffer.data(), bufferStart, bufferEnd);
+
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      headerBuffer.data(), headerReadSize);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  const uint64_t headerSize = header.read(&protocol);
+
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED) {
+    return nullptr;
+  }
+  const uint32_t numBytes = header.numBytes;
+  VELOX_CHECK(
+      numBytes >= kMinimumBytes && numBytes <= kMaximumBytes &&
+          numBytes % kBytesPerBlock == 0,
+      "Invalid Parquet Bloom filter size: {}",
+      numBytes);
+  VELOX_CHECK_LE(
+      offset + headerSize + numBytes,
+      fileSize,
+      "Bloom filter extends past end of file");
+
+  std::vector<uint32_t> words(numBytes / sizeof(uint32_t));
+  stream = input.read(
+      offset + headerSize, numBytes, dwio::common::LogType::HEADER);
+  bufferStart = nullptr;
+  bufferEnd = nullptr;
+  dwio::common::readBytes(
+      numBytes, stream.get(), words.data(), bufferStart, bufferEnd);
+  return std::make_unique<BlockSplitBloomFilter>(std::move(words));
+}
+
+BlockSplitBloomFilter::BlockSplitBloomFilter(std::vector<uint32_t> words)
+    : words_(std::move(words)),
+      numBlocks_(words_.size() / kBitsSetPerBlock) {
+  VELOX_CHECK_GT(numBlocks_, 0);
+}
+
+bool BlockSplitBloomFilter::mightContain(uint64_t hash) const {
+  const uint32_t blockIndex =
+      static_cast<uint32_t>(((hash >> 32) * numBlocks_) >> 32);
+  const uint32_t key = static_cast<uint32_t>(hash);
+  const uint32_t* block = words_.data() + blockIndex * kBitsSetPerBlock;
+  for (int32_t i = 0; i < kBitsSetPerBlock; ++i) {
+    const uint32_t mask = 1U << ((key * kSalt[i]) >> 27);
+    if ((block[i] & mask) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+uint64_t BlockSplitBloomFilter::hash(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BlockSplitBloomFilter::hash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BlockSplitBloomFilter::hash(folly::StringPiece value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <memory>
+#include <vector>
+
+#include "velox/dwio/common/BufferedInput.h"
+
+namespace facebook::velox::parquet {
+
+/// Reader side of the split block Bloom filter (SBBF) defined by the Parquet
+/// format. The filter is made of 32 byte blocks of eight 32 bit words. A value
+/// sets one bit in each word of the block selected by the upper half of its
+/// xxHash64 hash. Values are hashed in their plain encoding, i.e. the little
+/// endian bytes of fixed width types and the bytes without length for byte
+/// arrays.
+class BlockSplitBloomFilter {
+ public:
+  /// Reads the filter that starts at 'offset' in 'input'. Returns nullptr if
+  /// the filter uses an algorithm, hash or compression that is not supported.
+  static std::unique_ptr<BlockSplitBloomFilter> read(
+      dwio::common::BufferedInput& input,
+      uint64_t offset);
+
+  explicit BlockSplitBloomFilter(std::vector<uint32_t> words);
+
+  /// Returns false if the value with 'hash' is definitely not in the filter.
+  bool mightContain(uint64_t hash) const;
+
+  static uint64_t hash(int32_t value);
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(folly::StringPiece value);
+
+ private:
+  static constexpr int32_t kBitsSetPerBlock = 8;
+  static constexpr int32_t kBytesPerBlock = 32;
+  static constexpr uint32_t kMinimumBytes = kBytesPerBlock;
+  static constexpr uint32_t kMaximumBytes = 128 << 20;
+  // Upper bound on the size of the thrift BloomFilterHeader.
+  static constexpr uint64_t kMaxHeaderSize = 256;
+
+  static constexpr uint32_t kSalt[kBitsSetPerBlock] = {
+      0x47b6137bU,
+      0x44974d91U,
+      0x8824ad5bU,
+      0xa2b7289dU,
+      0x705495c7U,
+      0x2df1424bU,
+      0x9efc4947U,
+      0x5c6bfb31U};
+
+  const std::vector<uint32_t> words_;
+  const uint32_t numBlocks_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Nulls.h"
+
+namespace facebook::velox::parquet {
+
+// Decodes BYTE_STREAM_SPLIT: for N values of width W the page holds W streams
+// of N bytes, stream k holding byte k of each value. Values are transposed
+// back a batch at a time with loops of constant width that the compiler
+// vectorizes, and are then handed to the visitor one by one.
+class ByteStreamSplitDecoder {
+ public:
+  // 'byteWidth' is 4 or 8. 'isFloatingPoint' tells FLOAT and DOUBLE from
+  // INT32 and INT64, i.e. how the bytes convert to the visitor's data type.
+  ByteStreamSplitDecoder(
+      const char* start,
+      const char* end,
+      int32_t byteWidth,
+      bool isFloatingPoint)
+      : bufferStart_(start),
+        byteWidth_(byteWidth),
+        isFloatingPoint_(isFloatingPoint),
+        numValues_((end - start) / byteWidth) {
+    VELOX_CHECK(byteWidth == 4 || byteWidth == 8);
+    VELOX_CHECK_EQ(
+        (end - start) % byteWidth,
+        0,
+        "BYTE_STREAM_SPLIT data size is not a multiple of the value width");
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    position_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(
+            readValue<typename Visitor::DataType>(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  static constexpr int32_t kBatchSize = 64;
+
+  template <typename T>
+  T readValue() {
+    if (position_ >= batchEnd_) {
+      if (byteWidth_ == 4) {
+        decodeBatch<4>();
+      } else {
+        decodeBatch<8>();
+      }
+    }
+    const char* bytes = batch_ + (position_++ - batchBegin_) * byteWidth_;
+    if (byteWidth_ == 4) {
+      return isFloatingPoint_ ? static_cast<T>(load<float>(bytes))
+                              : static_cast<T>(load<int32_t>(bytes));
+    }
+    return isFloatingPoint_ ? static_cast<T>(load<double>(bytes))
+                            : static_cast<T>(load<int64_t>(bytes));
+  }
+
+  template <typename T>
+  static T load(const char* bytes) {
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+  }
+
+  // Transposes the values from 'position_' onwards into 'batch_'.
+  template <int32_t kWidth>
+  void decodeBatch() {
+    VELOX_CHECK_LT(
+        position_, numValues_, "Reading past the end of BYTE_STREAM_SPLIT");
+    const auto numValues =
+        std::min<int64_t>(kBatchSize, numValues_ - position_);
+    const char* streams = bufferStart_ + position_;
+    for (auto i = 0; i < numValues; ++i) {
+      for (auto byte = 0; byte < kWidth; ++byte) {
+        batch_[i * kWidth + byte] = streams[byte * numValues_ + i];
+      }
+    }
+    batchBegin_ = position_;
+    batchEnd_ = position_ + numValues;
+  }
+
+  const char* const bufferStart_;
+  const int32_t byteWidth_;
+  const bool isFloatingPoint_;
+  const int64_t numValues_;
+
+  // Index of the next value to read.
+  int64_t position_{0};
+  // The range of values transposed into 'batch_'.
+  int64_t batchBegin_{0};
+  int64_t batchEnd_{0};
+  char batch_[kBatchSize * sizeof(int64_t)];
+};
+
+} // namespace facebook::velox::parquet
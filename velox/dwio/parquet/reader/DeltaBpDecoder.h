@@ -43,6 +43,30 @@ class DeltaBpDecoder {
     }
   }
 
+  /// Decodes the next 'numValues' values into 'values'.
+  template <typename T>
+  void readValues(int32_t numValues, T* values) {
+    for (int32_t i = 0; i < numValues; ++i) {
+      values[i] = readLong();
+    }
+  }
+
+  /// Returns the number of values in the stream as given by its header.
+  uint64_t totalValueCount() const {
+    return totalValueCount_;
+  }
+
+  /// Returns the first byte after the encoded values. The last miniblock is
+  /// padded to full size, so this is only meaningful after all values have
+  /// been read. Used by encodings that store other data after a delta binary
+  /// packed stream.
+  const char* bufferEnd() const {
+    if (valuesRemainingCurrentMiniBlock_ == 0) {
+      return bufferStart_;
+    }
+    return bufferStart_ + bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+  }
+
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     int32_t current = visitor.start();
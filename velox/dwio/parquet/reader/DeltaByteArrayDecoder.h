@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
+
+namespace facebook::velox::parquet {
+
+// Decodes DELTA_BYTE_ARRAY, also known as incremental encoding: the length of
+// the prefix each value shares with the previous one as a DELTA_BINARY_PACKED
+// stream followed by the remaining suffixes as DELTA_LENGTH_BYTE_ARRAY. Each
+// value is rebuilt in place from its predecessor, so a value returned by
+// readString() is only valid until the next read or skip.
+class DeltaByteArrayDecoder {
+ public:
+  explicit DeltaByteArrayDecoder(const char* start) {
+    DeltaBpDecoder prefixDecoder(start);
+    prefixLengths_.resize(prefixDecoder.totalValueCount());
+    prefixDecoder.readValues(prefixLengths_.size(), prefixLengths_.data());
+    suffixDecoder_ = std::make_unique<DeltaLengthByteArrayDecoder>(
+        prefixDecoder.bufferEnd());
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  // Skipped values must still be rebuilt since the next value may share a
+  // prefix with them.
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    for (auto i = 0; i < numValues; ++i) {
+      readString();
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(prefixIndex_, prefixLengths_.size());
+    const auto prefixLength = prefixLengths_[prefixIndex_++];
+    VELOX_CHECK_LE(
+        static_cast<uint32_t>(prefixLength),
+        lastValue_.size(),
+        "Prefix length too large in DELTA_BYTE_ARRAY");
+    const auto suffix = suffixDecoder_->readString();
+    lastValue_.resize(prefixLength);
+    lastValue_.append(suffix.data(), suffix.size());
+    return folly::StringPiece(lastValue_);
+  }
+
+  std::vector<int32_t> prefixLengths_;
+  size_t prefixIndex_{0};
+  std::unique_ptr<DeltaLengthByteArrayDecoder> suffixDecoder_;
+  // The last value read, which holds the prefix of the next one.
+  std::string lastValue_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/Nulls.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+namespace facebook::velox::parquet {
+
+// Decodes DELTA_LENGTH_BYTE_ARRAY: the lengths of all values of the page as a
+// DELTA_BINARY_PACKED stream followed by the concatenated value bytes. The
+// lengths are decoded for the whole page on construction so that the values
+// can be read and skipped without going back to the bit packed stream.
+class DeltaLengthByteArrayDecoder {
+ public:
+  explicit DeltaLengthByteArrayDecoder(const char* start) {
+    DeltaBpDecoder lengthDecoder(start);
+    lengths_.resize(lengthDecoder.totalValueCount());
+    lengthDecoder.readValues(lengths_.size(), lengths_.data());
+    bufferStart_ = lengthDecoder.bufferEnd();
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(lengthIndex_ + numValues, lengths_.size());
+    int64_t numBytes = 0;
+    for (auto i = 0; i < numValues; ++i) {
+      numBytes += lengths_[lengthIndex_ + i];
+    }
+    lengthIndex_ += numValues;
+    bufferStart_ += numBytes;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(lengthIndex_, lengths_.size());
+    const auto length = lengths_[lengthIndex_++];
+    bufferStart_ += length;
+    return folly::StringPiece(bufferStart_ - length, length);
+  }
+
+ private:
+  std::vector<int32_t> lengths_;
+  size_t lengthIndex_{0};
+  const char* bufferStart_;
+};
+
+} // namespace facebook::velox::parquet
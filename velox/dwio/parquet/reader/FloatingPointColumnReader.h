@@ -45,6 +45,12 @@ class FloatingPointColumnReader
 
   uint64_t skip(uint64_t numValues) override;
 
+  bool hasBulkPath() const override {
+    // BYTE_STREAM_SPLIT values are decoded one at a time.
+    return base::hasBulkPath() &&
+        !this->formatData_->template as<ParquetData>().isByteStreamSplit();
+  }
+
   void read(vector_size_t offset, RowSet rows, const uint64_t* incomingNulls)
       override {
     using T = FloatingPointColumnReader<TData, TRequested>;
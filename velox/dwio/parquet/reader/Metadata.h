@@ -37,6 +37,13 @@ class ColumnChunkMetaDataPtr {
   /// Check the presence of the dictionary page offset in ColumnChunk metadata.
   bool hasDictionaryPageOffset() const;
 
+  /// Check the presence of the Bloom filter offset in ColumnChunk metadata.
+  bool hasBloomFilterOffset() const;
+
+  /// The byte offset from the beginning of the file to the Bloom filter.
+  /// Must check for its presence using hasBloomFilterOffset().
+  int64_t bloomFilterOffset() const;
+
   /// Return the ColumnChunk statistics.
   std::unique_ptr<dwio::common::ColumnStatistics> getColumnStatistics(
       const TypePtr type,
@@ -16,10 +16,68 @@
 
 #include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/dwio/common/BufferUtil.h"
 
 namespace facebook::velox::parquet {
 
+namespace {
+
+// Classifies up to 64 consecutive levels for one list level. Bit i describes
+// level i.
+struct LevelMasks {
+  // The level starts a new list.
+  uint64_t begins{0};
+  // The level is a present element of the current list.
+  uint64_t elements{0};
+  // The level's list is not null. Only meaningful at the begin bits.
+  uint64_t valid{0};
+};
+
+LevelMasks levelMasks(
+    const int16_t* definitionLevels,
+    const int16_t* repetitionLevels,
+    int32_t numLevels,
+    int16_t repeatedAncestorDefLevel,
+    int16_t defLevel,
+    int16_t repLevel) {
+  using Batch = xsimd::batch<int16_t>;
+  LevelMasks masks;
+  int32_t i = 0;
+  if (numLevels == 64) {
+    const Batch ancestor(repeatedAncestorDefLevel);
+    const Batch present(defLevel);
+    const Batch defined(static_cast<int16_t>(defLevel - 1));
+    const Batch repeat(repLevel);
+    for (; i < 64; i += Batch::size) {
+      const auto def = Batch::load_unaligned(definitionLevels + i);
+      const auto rep = Batch::load_unaligned(repetitionLevels + i);
+      const auto relevant = (def >= ancestor) & (rep <= repeat);
+      const auto begin = relevant & (rep < repeat);
+      const auto element =
+          (relevant & (rep == repeat)) | (begin & (def >= present));
+      masks.begins |= static_cast<uint64_t>(simd::toBitMask(begin)) << i;
+      masks.elements |= static_cast<uint64_t>(simd::toBitMask(element)) << i;
+      masks.valid |= static_cast<uint64_t>(simd::toBitMask(def >= defined))
+          << i;
+    }
+    return masks;
+  }
+  for (; i < numLevels; ++i) {
+    const auto def = definitionLevels[i];
+    const auto rep = repetitionLevels[i];
+    const bool relevant = def >= repeatedAncestorDefLevel && rep <= repLevel;
+    const bool begin = relevant && rep < repLevel;
+    const bool element = relevant && (!begin || def >= defLevel);
+    masks.begins |= static_cast<uint64_t>(begin) << i;
+    masks.elements |= static_cast<uint64_t>(element) << i;
+    masks.valid |= static_cast<uint64_t>(def >= defLevel - 1) << i;
+  }
+  return masks;
+}
+
+} // namespace
+
 int64_t NestedStructureDecoder::readOffsetsAndNulls(
     const uint8_t* definitionLevels,
     const uint8_t* repetitionLevels,
@@ -79,4 +137,51 @@ int64_t NestedStructureDecoder::readOffsetsAndNulls(
   return outputIndex;
 }
 
+int32_t NestedStructureDecoder::readLengthsAndNulls(
+    const int16_t* definitionLevels,
+    const int16_t* repetitionLevels,
+    int32_t numLevels,
+    int16_t repeatedAncestorDefLevel,
+    int16_t defLevel,
+    int16_t repLevel,
+    int32_t maxItems,
+    int32_t* lengths,
+    uint64_t* nulls,
+    int32_t nullsStartIndex) {
+  int32_t numLists = 0;
+  for (int32_t base = 0; base < numLevels; base += 64) {
+    const auto masks = levelMasks(
+        definitionLevels + base,
+        repetitionLevels + base,
+        std::min<int32_t>(64, numLevels - base),
+        repeatedAncestorDefLevel,
+        defLevel,
+        repLevel);
+    auto elements = masks.elements;
+    auto begins = masks.begins;
+    while (begins) {
+      const auto bit = __builtin_ctzll(begins);
+      const auto before = bits::lowMask(bit);
+      // Elements before the first list of the range have no list to go to.
+      if (numLists > 0) {
+        lengths[numLists - 1] += __builtin_popcountll(elements & before);
+      }
+      elements &= ~before;
+      VELOX_CHECK_LT(
+          numLists, maxItems, "Definition levels exceeded upper bound");
+      lengths[numLists] = 0;
+      if (nulls) {
+        bits::setNull(
+            nulls, nullsStartIndex + numLists, !((masks.valid >> bit) & 1));
+      }
+      ++numLists;
+      begins &= begins - 1;
+    }
+    if (numLists > 0) {
+      lengths[numLists - 1] += __builtin_popcountll(elements);
+    }
+  }
+  return numLists;
+}
+
 } // namespace facebook::velox::parquet
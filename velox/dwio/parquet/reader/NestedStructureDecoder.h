@@ -60,6 +60,38 @@ class NestedStructureDecoder {
       BufferPtr& nullsBuffer,
       memory::MemoryPool& pool);
 
+  /// Computes the lengths and nulls of the lists of one nested level from
+  /// the decoded levels of a leaf. Levels are classified 64 at a time with
+  /// SIMD compares and the list boundaries are found with bit scans instead
+  /// of one branch per level. Produces the same lists as Arrow's
+  /// DefRepLevelsToList for the level given by 'repeatedAncestorDefLevel',
+  /// 'defLevel' and 'repLevel'.
+  ///
+  /// @param definitionLevels The definition levels for the leaf level
+  /// @param repetitionLevels The repetition levels for the leaf level
+  /// @param numLevels The number of elements in definitionLevels and
+  /// repetitionLevels
+  /// @param repeatedAncestorDefLevel Definition levels below this belong to
+  /// empty or null ancestors and are skipped
+  /// @param defLevel The definition level at which a list element is present
+  /// @param repLevel The repetition level of this list
+  /// @param maxItems The capacity of 'lengths' and 'nulls'
+  /// @param lengths The output lengths of the lists
+  /// @param nulls The output nulls, 1 for a non-null list. May be nullptr.
+  /// @param nullsStartIndex The bit in 'nulls' of the first list
+  /// @return The number of lists.
+  static int32_t readLengthsAndNulls(
+      const int16_t* definitionLevels,
+      const int16_t* repetitionLevels,
+      int32_t numLevels,
+      int16_t repeatedAncestorDefLevel,
+      int16_t defLevel,
+      int16_t repLevel,
+      int32_t maxItems,
+      int32_t* lengths,
+      uint64_t* nulls,
+      int32_t nullsStartIndex);
+
  private:
   NestedStructureDecoder() {}
 };
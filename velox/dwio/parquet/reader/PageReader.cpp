@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
 
@@ -573,18 +574,17 @@ int32_t PageReader::getLengthsAndNulls(
           definitionLevels_.data() + begin, end - begin, info, &bits);
       break;
     case LevelMode::kList: {
-      arrow::DefRepLevelsToList(
+      return NestedStructureDecoder::readLengthsAndNulls(
           definitionLevels_.data() + begin,
           repetitionLevels_.data() + begin,
           end - begin,
-          info,
-          &bits,
-          lengths);
-      // Convert offsets to lengths.
-      for (auto i = 0; i < bits.values_read; ++i) {
-        lengths[i] = lengths[i + 1] - lengths[i];
-      }
-      break;
+          info.repeated_ancestor_def_level,
+          info.def_level,
+          info.rep_level,
+          maxItems,
+          lengths,
+          nulls,
+          nullsStartIndex);
     }
     case LevelMode::kStructOverLists: {
       DefRepLevelsToBitmap(
@@ -601,6 +601,13 @@ int32_t PageReader::getLengthsAndNulls(
 
 void PageReader::makeDecoder() {
   auto parquetType = type_->parquetType_.value();
+  directDecoder_.reset();
+  stringDecoder_.reset();
+  booleanDecoder_.reset();
+  deltaBpDecoder_.reset();
+  deltaLengthByteArrayDecoder_.reset();
+  deltaByteArrayDecoder_.reset();
+  byteStreamSplitDecoder_.reset();
   switch (encoding_) {
     case Encoding::RLE_DICTIONARY:
     case Encoding::PLAIN_DICTIONARY:
@@ -651,6 +658,44 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED(
+            "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      }
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(pageData_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY &&
+          !(parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY &&
+            type_->type()->isVarbinary())) {
+        VELOX_UNSUPPORTED(
+            "DELTA_BYTE_ARRAY decoder only supports BYTE_ARRAY and VARBINARY "
+            "FIXED_LEN_BYTE_ARRAY");
+      }
+      deltaByteArrayDecoder_ =
+          std::make_unique<DeltaByteArrayDecoder>(pageData_);
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+          byteStreamSplitDecoder_ = std::make_unique<ByteStreamSplitDecoder>(
+              pageData_,
+              pageData_ + encodedDataSize_,
+              parquetTypeBytes(parquetType),
+              parquetType == thrift::Type::FLOAT ||
+                  parquetType == thrift::Type::DOUBLE);
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports FLOAT, DOUBLE, INT32 "
+              "and INT64");
+      }
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
@@ -685,6 +730,12 @@ void PageReader::skip(int64_t numRows) {
     booleanDecoder_->skip(toSkip);
   } else if (deltaBpDecoder_) {
     deltaBpDecoder_->skip(toSkip);
+  } else if (deltaLengthByteArrayDecoder_) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (deltaByteArrayDecoder_) {
+    deltaByteArrayDecoder_->skip(toSkip);
+  } else if (byteStreamSplitDecoder_) {
+    byteStreamSplitDecoder_->skip(toSkip);
   } else {
     VELOX_FAIL("No decoder to skip");
   }
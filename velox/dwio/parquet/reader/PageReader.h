@@ -22,7 +22,10 @@
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -127,6 +130,10 @@ class PageReader {
     return encoding_ == thrift::Encoding::DELTA_BINARY_PACKED;
   }
 
+  bool isByteStreamSplit() const {
+    return encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT;
+  }
+
   /// Returns the range of repdefs for the top level rows covered by the last
   /// decoderepDefs().
   std::pair<int32_t, int32_t> repDefRange() const {
@@ -268,6 +275,9 @@ class PageReader {
       } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
         nullsFromFastPath = false;
         deltaBpDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+        nullsFromFastPath = false;
+        byteStreamSplitDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<true>(
             nulls, visitor, nullsFromFastPath);
@@ -278,6 +288,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
         deltaBpDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+        byteStreamSplitDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<false>(
             nulls, visitor, !this->type_->type()->isShortDecimal());
@@ -299,12 +311,22 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
       } else {
         nullsFromFastPath = false;
-        stringDecoder_->readWithVisitor<true>(nulls, visitor);
+        if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+          deltaLengthByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+        } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+          deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+        } else {
+          stringDecoder_->readWithVisitor<true>(nulls, visitor);
+        }
       }
     } else {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -479,6 +501,9 @@ class PageReader {
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
+  std::unique_ptr<ByteStreamSplitDecoder> byteStreamSplitDecoder_;
   // Add decoders for other encodings here.
 };
 
@@ -17,13 +17,14 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 
 namespace facebook::velox::parquet {
 
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_, pool());
+  return std::make_unique<ParquetData>(type, metaData_, pool(), input_);
 }
 
 void ParquetData::filterRowGroups(
@@ -75,9 +76,146 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   if (columnChunk.hasStatistics()) {
     auto columnStats =
         columnChunk.getColumnStatistics(type, rowGroup.numRows());
-    return testFilter(filter, columnStats.get(), rowGroup.numRows(), type);
+    if (!testFilter(filter, columnStats.get(), rowGroup.numRows(), type)) {
+      return false;
+    }
+  }
+  return bloomFilterMatches(rowGroupId, *filter);
+}
+
+namespace {
+
+// Returns the hashes of the values accepted by 'filter' in the plain encoding
+// of 'physicalType'. Returns std::nullopt if 'filter' is not a filter on a
+// small set of values or the values cannot be hashed for the given type.
+std::optional<std::vector<uint64_t>> filterValueHashes(
+    const common::Filter& filter,
+    thrift::Type::type physicalType) {
+  // Above this many values, probing the Bloom filter is not worth the IO.
+  constexpr size_t kMaxValues = 1'024;
+
+  std::vector<int64_t> bigints;
+  const folly::F14FastSet<std::string>* bytes = nullptr;
+  std::string singleBytes;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto* range = static_cast<const common::BigintRange*>(&filter);
+      if (!range->isSingleValue()) {
+        return std::nullopt;
+      }
+      bigints.push_back(range->lower());
+      break;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      bigints =
+          static_cast<const common::BigintValuesUsingHashTable*>(&filter)
+              ->values();
+      break;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      bigints = static_cast<const common::BigintValuesUsingBitmask*>(&filter)
+                    ->values();
+      break;
+    case common::FilterKind::kBytesRange: {
+      auto* range = static_cast<const common::BytesRange*>(&filter);
+      if (!range->isSingleValue()) {
+        return std::nullopt;
+      }
+      singleBytes = range->lower();
+      break;
+    }
+    case common::FilterKind::kBytesValues:
+      bytes = &static_cast<const common::BytesValues*>(&filter)->values();
+      break;
+    default:
+      return std::nullopt;
+  }
+
+  std::vector<uint64_t> hashes;
+  if (filter.kind() == common::FilterKind::kBytesRange ||
+      filter.kind() == common::FilterKind::kBytesValues) {
+    if (physicalType != thrift::Type::BYTE_ARRAY) {
+      return std::nullopt;
+    }
+    if (bytes == nullptr) {
+      hashes.push_back(BlockSplitBloomFilter::hash(singleBytes));
+      return hashes;
+    }
+    if (bytes->size() > kMaxValues) {
+      return std::nullopt;
+    }
+    hashes.reserve(bytes->size());
+    for (const auto& value : *bytes) {
+      hashes.push_back(BlockSplitBloomFilter::hash(value));
+    }
+    return hashes;
+  }
+
+  if (bigints.size() > kMaxValues) {
+    return std::nullopt;
+  }
+  hashes.reserve(bigints.size());
+  for (auto value : bigints) {
+    if (physicalType == thrift::Type::INT64) {
+      hashes.push_back(BlockSplitBloomFilter::hash(value));
+    } else if (physicalType == thrift::Type::INT32) {
+      // Values outside of the int32_t range cannot be in the column.
+      if (value >= std::numeric_limits<int32_t>::min() &&
+          value <= std::numeric_limits<int32_t>::max()) {
+        hashes.push_back(
+            BlockSplitBloomFilter::hash(static_cast<int32_t>(value)));
+      }
+    } else {
+      return std::nullopt;
+    }
+  }
+  return hashes;
+}
+
+} // namespace
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter) {
+  if (input_ == nullptr || filter.testNull() ||
+      !type_->parquetType_.has_value()) {
+    return true;
+  }
+  auto columnChunk =
+      fileMetaDataPtr_.rowGroup(rowGroupId).columnChunk(type_->column());
+  if (!columnChunk.hasBloomFilterOffset()) {
+    return true;
+  }
+  // Decimals and other logical types may be stored with a physical type whose
+  // plain encoding differs from the filter values.
+  if (type_->type()->isDecimal()) {
+    return true;
+  }
+  auto hashes = filterValueHashes(filter, type_->parquetType_.value());
+  if (!hashes.has_value()) {
+    return true;
+  }
+
+  // A row group is tested with the filter and with each metadata filter of
+  // the column, so its Bloom filter is read once and kept.
+  auto it = bloomFilters_.find(rowGroupId);
+  if (it == bloomFilters_.end()) {
+    it = bloomFilters_
+             .emplace(
+                 rowGroupId,
+                 BlockSplitBloomFilter::read(
+                     *input_, columnChunk.bloomFilterOffset()))
+             .first;
+  }
+  const auto& bloomFilter = it->second;
+  if (bloomFilter == nullptr) {
+    return true;
+  }
+  for (auto hash : hashes.value()) {
+    if (bloomFilter->mightContain(hash)) {
+      return true;
+    }
   }
-  return true;
+  return false;
 }
 
 void ParquetData::enqueueRowGroup(
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 
@@ -35,14 +38,18 @@ class ParquetParams : public dwio::common::FormatParams {
   ParquetParams(
       memory::MemoryPool& pool,
       dwio::common::ColumnReaderStatistics& stats,
-      const FileMetaDataPtr metaData)
-      : FormatParams(pool, stats), metaData_(metaData) {}
+      const FileMetaDataPtr metaData,
+      dwio::common::BufferedInput* input = nullptr)
+      : FormatParams(pool, stats), metaData_(metaData), input_(input) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const FileMetaDataPtr metaData_;
+  // Input for the whole file. Used for reading Bloom filters when filtering
+  // row groups. May be null.
+  dwio::common::BufferedInput* const input_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -51,10 +58,12 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      dwio::common::BufferedInput* input = nullptr)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
+        input_(input),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
@@ -179,6 +188,10 @@ class ParquetData : public dwio::common::FormatData {
     return reader_->isDeltaBinaryPacked();
   }
 
+  bool isByteStreamSplit() const {
+    return reader_->isByteStreamSplit();
+  }
+
   bool parentNullsInLeaves() const override {
     return true;
   }
@@ -191,14 +204,24 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  /// False if 'filter' only accepts specific non-null values and none of them
+  /// is in the Bloom filter of the column chunk of 'this' in 'rowGroupId'.
+  bool bloomFilterMatches(uint32_t rowGroupId, const common::Filter& filter);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const FileMetaDataPtr fileMetaDataPtr_;
+  dwio::common::BufferedInput* const input_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Bloom filters of the column chunks of this column by row group id. Read
+  // on first use, nullptr if the filter of the row group is not supported.
+  folly::F14FastMap<uint32_t, std::unique_ptr<BlockSplitBloomFilter>>
+      bloomFilters_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
@@ -19,6 +19,8 @@
 #include <boost/algorithm/string.hpp>
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/common/ParallelUnitLoader.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -75,6 +77,18 @@ class ReaderBase {
       int32_t currentGroup,
       StructColumnReader& reader);
 
+  /// Returns a unit loader with a unit per row group in 'groups' that loads
+  /// upcoming row groups in parallel, or nullptr if row groups are to be
+  /// loaded with scheduleRowGroups(). Uses the unit loader factory of
+  /// 'rowReaderOptions' if set and otherwise keeps prefetchRowGroups() + 1
+  /// row groups in flight on the IO executor of the reader options, if any,
+  /// within the prefetch budget of the reader options.
+  /// The streams of all of 'groups' are enqueued here, on the calling thread.
+  std::unique_ptr<dwio::common::UnitLoader> createUnitLoader(
+      const std::vector<uint32_t>& groups,
+      StructColumnReader& reader,
+      const dwio::common::RowReaderOptions& rowReaderOptions);
+
   /// Returns the uncompressed size for columns in 'type' and its children in
   /// row group.
   int64_t rowGroupUncompressedSize(
@@ -86,9 +100,18 @@ class ReaderBase {
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
  private:
-  // Reads and parses file footer.
+  // Reads and parses file footer. Takes the parsed footer from
+  // FileMetadataCache if it is there.
   void loadFileMetaData();
 
+  // Parses the footer from 'stream', which covers the last 'readSize' bytes of
+  // the file. Reads them if 'stream' is nullptr. Returns the footer and its
+  // estimated memory footprint.
+  std::pair<std::shared_ptr<const thrift::FileMetaData>, uint64_t>
+  parseFileMetaData(
+      std::unique_ptr<dwio::common::SeekableInputStream> stream,
+      uint64_t readSize);
+
   void initializeSchema();
 
   std::unique_ptr<ParquetTypeWithId> getParquetColumnInfo(
@@ -106,6 +129,10 @@ class ReaderBase {
       const std::vector<T>& children,
       bool fileColumnNamesReadAsLowerCase);
 
+  // Estimated ratio of the memory footprint of a parsed footer to its
+  // serialized size.
+  static constexpr uint64_t kParsedFooterSizeRatio = 4;
+
   memory::MemoryPool& pool_;
   const uint64_t footerEstimatedSize_;
   const uint64_t filePreloadThreshold_;
@@ -113,7 +140,7 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -147,8 +174,28 @@ void ReaderBase::loadFileMetaData() {
 
   std::unique_ptr<dwio::common::SeekableInputStream> stream;
   if (preloadFile) {
+    // Small files are read in one piece also if the footer is cached.
     stream = input_->loadCompleteFile();
-  } else {
+  }
+  auto cacheKey = dwio::common::FileMetadataCache::makeKey(
+      *input_->getReadFile(),
+      dwio::common::FileFormat::PARQUET,
+      options_.fileModificationTime());
+  if (!cacheKey.has_value()) {
+    fileMetaData_ = parseFileMetaData(std::move(stream), readSize).first;
+    return;
+  }
+  fileMetaData_ =
+      dwio::common::FileMetadataCache::instance().get<thrift::FileMetaData>(
+          *cacheKey,
+          [&]() { return parseFileMetaData(std::move(stream), readSize); });
+}
+
+std::pair<std::shared_ptr<const thrift::FileMetaData>, uint64_t>
+ReaderBase::parseFileMetaData(
+    std::unique_ptr<dwio::common::SeekableInputStream> stream,
+    uint64_t readSize) {
+  if (stream == nullptr) {
     stream = input_->read(
         fileLength_ - readSize, readSize, dwio::common::LogType::FOOTER);
   }
@@ -187,8 +234,9 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  return {std::move(fileMetaData), footerLength * kParsedFooterSizeRatio};
 }
 
 void ReaderBase::initializeSchema() {
@@ -703,6 +751,80 @@ void ReaderBase::scheduleRowGroups(
   }
 }
 
+namespace {
+
+// A row group whose streams are enqueued in 'input'. load() only does the IO,
+// so that it can run off the thread that owns the column readers.
+class ParquetUnit : public dwio::common::LoadUnit {
+ public:
+  ParquetUnit(
+      std::shared_ptr<dwio::common::BufferedInput> input,
+      bool needsLoad,
+      const thrift::RowGroup& rowGroup)
+      : input_{std::move(input)},
+        needsLoad_{needsLoad},
+        numRows_(rowGroup.num_rows),
+        ioSize_(
+            rowGroup.__isset.total_compressed_size
+                ? rowGroup.total_compressed_size
+                : rowGroup.total_byte_size) {}
+
+  void load() override {
+    VELOX_CHECK_NOT_NULL(input_, "Parquet row group cannot be reloaded");
+    if (needsLoad_) {
+      input_->load(dwio::common::LogType::STRIPE);
+      needsLoad_ = false;
+    }
+  }
+
+  void unload() override {
+    input_.reset();
+  }
+
+  uint64_t getNumRows() override {
+    return numRows_;
+  }
+
+  uint64_t getIoSize() override {
+    return ioSize_;
+  }
+
+ private:
+  std::shared_ptr<dwio::common::BufferedInput> input_;
+  bool needsLoad_;
+  const uint64_t numRows_;
+  const uint64_t ioSize_;
+};
+
+} // namespace
+
+std::unique_ptr<dwio::common::UnitLoader> ReaderBase::createUnitLoader(
+    const std::vector<uint32_t>& groups,
+    StructColumnReader& reader,
+    const dwio::common::RowReaderOptions& rowReaderOptions) {
+  auto factory = rowReaderOptions.getUnitLoaderFactory();
+  if (!factory && options_.ioExecutor()) {
+    factory = std::make_shared<dwio::common::ParallelUnitLoaderFactory>(
+        options_.ioExecutor().get(),
+        options_.prefetchRowGroups() + 1,
+        rowReaderOptions.getBlockedOnIoCallback(),
+        options_.prefetchBudget());
+  }
+  if (!factory) {
+    return nullptr;
+  }
+
+  std::vector<std::unique_ptr<dwio::common::LoadUnit>> units;
+  units.reserve(groups.size());
+  for (auto group : groups) {
+    auto input = reader.enqueueRowGroupStreams(group, input_);
+    const bool needsLoad = input != input_;
+    units.push_back(std::make_unique<ParquetUnit>(
+        std::move(input), needsLoad, fileMetaData_->row_groups[group]));
+  }
+  return factory->create(std::move(units), 0);
+}
+
 int64_t ReaderBase::rowGroupUncompressedSize(
     int32_t rowGroupIndex,
     const dwio::common::TypeWithId& type) const {
@@ -759,7 +881,10 @@ class ParquetRowReader::Impl {
       return; // TODO
     }
     ParquetParams params(
-        pool_, columnReaderStats_, readerBase_->fileMetaData());
+        pool_,
+        columnReaderStats_,
+        readerBase_->fileMetaData(),
+        &readerBase_->bufferedInput());
     auto columnSelector = std::make_shared<ColumnSelector>(
         ColumnSelector::apply(options_.getSelector(), readerBase_->schema()));
     requestedType_ = columnSelector->getSchemaWithId();
@@ -772,6 +897,10 @@ class ParquetRowReader::Impl {
         options_.getRowNumberColumnInfo().has_value());
 
     filterRowGroups();
+    unitLoader_ = readerBase_->createUnitLoader(
+        rowGroupIds_,
+        static_cast<StructColumnReader&>(*columnReader_),
+        options_);
     if (!rowGroupIds_.empty()) {
       // schedule prefetch of first row group right after reading the metadata.
       // This is usually on a split preload thread before the split goes to
@@ -885,10 +1014,14 @@ class ParquetRowReader::Impl {
     }
 
     auto nextRowGroupIndex = rowGroupIds_[nextRowGroupIdsIdx_];
-    readerBase_->scheduleRowGroups(
-        rowGroupIds_,
-        nextRowGroupIdsIdx_,
-        static_cast<StructColumnReader&>(*columnReader_));
+    if (unitLoader_) {
+      unitLoader_->getLoadedUnit(nextRowGroupIdsIdx_);
+    } else {
+      readerBase_->scheduleRowGroups(
+          rowGroupIds_,
+          nextRowGroupIdsIdx_,
+          static_cast<StructColumnReader&>(*columnReader_));
+    }
     currentRowGroupPtr_ = &rowGroups_[rowGroupIds_[nextRowGroupIdsIdx_]];
     rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
     currentRowInGroup_ = 0;
@@ -913,6 +1046,10 @@ class ParquetRowReader::Impl {
 
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
+  // Loads the row groups in 'rowGroupIds_' ahead of decoding. If nullptr, row
+  // groups are loaded by ReaderBase::scheduleRowGroups().
+  std::unique_ptr<dwio::common::UnitLoader> unitLoader_;
+
   std::shared_ptr<const dwio::common::TypeWithId> requestedType_;
 
   dwio::common::ColumnReaderStatistics columnReaderStats_;
@@ -978,6 +1115,21 @@ ParquetReader::typeWithId() const {
   return readerBase_->schemaWithId();
 }
 
+std::optional<std::vector<int32_t>> ParquetReader::fieldIds() const {
+  const auto& schema = readerBase_->thriftFileMetaData().schema;
+  const auto& root = *readerBase_->schemaWithId();
+  std::vector<int32_t> ids;
+  ids.reserve(root.size());
+  for (uint32_t i = 0; i < root.size(); ++i) {
+    const auto& element = schema[root.childAt(i)->id()];
+    if (!element.__isset.field_id) {
+      return std::nullopt;
+    }
+    ids.push_back(element.field_id);
+  }
+  return ids;
+}
+
 std::unique_ptr<dwio::common::RowReader> ParquetReader::createRowReader(
     const dwio::common::RowReaderOptions& options) const {
   return std::make_unique<ParquetRowReader>(readerBase_, options);
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/common/base/GTestMacros.h"
+#include "velox/common/base/HotCounters.h"
 #include "velox/common/base/Nulls.h"
 #include "velox/dwio/common/BitPackDecoder.h"
 #include "velox/dwio/common/DecoderUtil.h"
@@ -50,9 +51,11 @@ class RleBpDataDecoder : public facebook::velox::parquet::RleBpDecoder {
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      VELOX_HOT_COUNTER_INC(kSelectiveFastPath);
       fastPath<hasNulls>(nulls, visitor);
       return;
     }
+    VELOX_HOT_COUNTER_INC(kSelectiveSlowPath);
     int32_t current = visitor.start();
     skip<hasNulls>(current, 0, nulls);
     int32_t toSkip;
@@ -107,13 +107,23 @@ void StructColumnReader::read(
 std::shared_ptr<dwio::common::BufferedInput> StructColumnReader::loadRowGroup(
     uint32_t index,
     const std::shared_ptr<dwio::common::BufferedInput>& input) {
+  auto newInput = enqueueRowGroupStreams(index, input);
+  if (newInput != input) {
+    newInput->load(dwio::common::LogType::STRIPE);
+  }
+  return newInput;
+}
+
+std::shared_ptr<dwio::common::BufferedInput>
+StructColumnReader::enqueueRowGroupStreams(
+    uint32_t index,
+    const std::shared_ptr<dwio::common::BufferedInput>& input) {
   if (isRowGroupBuffered(index, *input)) {
     enqueueRowGroup(index, *input);
     return input;
   }
   auto newInput = input->clone();
   enqueueRowGroup(index, *newInput);
-  newInput->load(dwio::common::LogType::STRIPE);
   return newInput;
 }
 
@@ -49,6 +49,13 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       uint32_t index,
       const std::shared_ptr<dwio::common::BufferedInput>& input);
 
+  /// Like loadRowGroup() but does not load the new input. The caller loads the
+  /// returned input if it is not 'input'. Loading may happen on another
+  /// thread, since it does not touch the state of the column readers.
+  std::shared_ptr<dwio::common::BufferedInput> enqueueRowGroupStreams(
+      uint32_t index,
+      const std::shared_ptr<dwio::common::BufferedInput>& input);
+
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
   void advanceFieldReader(
@@ -90,6 +90,41 @@ BENCHMARK(randomDefs) {
   folly::doNotOptimizeAway(numCollections);
 }
 
+// Lengths and nulls for the inner lists of a nullable ARRAY<ARRAY<BIGINT>>
+// with 1 to 8 elements per list.
+BENCHMARK(nestedListLengths) {
+  folly::BenchmarkSuspender suspender;
+
+  constexpr int32_t kNumValues = 1'000'000;
+  std::vector<int16_t> defs(kNumValues);
+  std::vector<int16_t> reps(kNumValues);
+  for (auto i = 0; i < kNumValues;) {
+    const auto listSize = std::min<int32_t>(1 + rand() % 8, kNumValues - i);
+    for (auto j = 0; j < listSize; ++j, ++i) {
+      defs[i] = rand() % 10 == 0 ? 4 : 5;
+      reps[i] = j > 0 ? 2 : rand() % 2;
+    }
+  }
+  std::vector<int32_t> lengths(kNumValues);
+  std::vector<uint64_t> nulls(bits::nwords(kNumValues));
+
+  suspender.dismiss();
+
+  auto numLists = NestedStructureDecoder::readLengthsAndNulls(
+      defs.data(),
+      reps.data(),
+      kNumValues,
+      2,
+      4,
+      2,
+      kNumValues,
+      lengths.data(),
+      nulls.data(),
+      0);
+
+  folly::doNotOptimizeAway(numLists);
+}
+
 int main(int /*argc*/, char** /*argv*/) {
   memory::MemoryManager::initialize({});
   folly::runBenchmarks();
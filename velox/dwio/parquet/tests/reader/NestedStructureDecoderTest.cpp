@@ -266,3 +266,78 @@ TEST_F(NestedStructureDecoderTest, emptyRowAtEnd) {
   assertStructure(
       defs, reps, 4, 3, 2, expectedOffsets, expectedLengths, expectedNulls);
 }
+
+// ARRAY<ARRAY<INTEGER>> with the rows of firstLevelInTwo repeated 10 times so
+// that the levels span several 64 level words and end in a partial word.
+TEST_F(NestedStructureDecoderTest, lengthsAndNulls) {
+  const int16_t rowDefs[] = {5, 4, 5, 5, 4, 2, 5, 5, 5, 4, 2, 2,
+                             0, 2, 4, 2, 5, 5, 2, 5, 2, 5, 5, 2};
+  const int16_t rowReps[] = {0, 2, 1, 0, 2, 1, 1, 2, 0, 2, 1, 1,
+                             0, 0, 1, 1, 1, 0, 1, 1, 0, 1, 2, 0};
+  constexpr int32_t kNumRepeats = 10;
+  std::vector<int16_t> defs;
+  std::vector<int16_t> reps;
+  for (auto i = 0; i < kNumRepeats; ++i) {
+    defs.insert(defs.end(), std::begin(rowDefs), std::end(rowDefs));
+    reps.insert(reps.end(), std::begin(rowReps), std::end(rowReps));
+  }
+
+  auto assertLevel = [&](int16_t repeatedAncestorDefLevel,
+                         int16_t defLevel,
+                         int16_t repLevel,
+                         const std::vector<int32_t>& expectedLengths,
+                         const std::vector<bool>& expectedNulls) {
+    std::vector<int32_t> lengths(defs.size());
+    std::vector<uint64_t> nulls(bits::nwords(defs.size() + 1));
+    auto numLists = NestedStructureDecoder::readLengthsAndNulls(
+        defs.data(),
+        reps.data(),
+        defs.size(),
+        repeatedAncestorDefLevel,
+        defLevel,
+        repLevel,
+        defs.size(),
+        lengths.data(),
+        nulls.data(),
+        1);
+    ASSERT_EQ(numLists, expectedLengths.size() * kNumRepeats);
+    for (auto i = 0; i < numLists; ++i) {
+      const auto expected = i % expectedLengths.size();
+      ASSERT_EQ(lengths[i], expectedLengths[expected]) << i;
+      ASSERT_EQ(!bits::isBitSet(nulls.data(), i + 1), expectedNulls[expected])
+          << i;
+    }
+  };
+
+  // The outer lists.
+  assertLevel(
+      0,
+      2,
+      1,
+      {2, 3, 3, 0, 4, 3, 2, 1},
+      {false, false, false, true, false, false, false, false});
+  // The inner lists.
+  assertLevel(
+      2,
+      4,
+      2,
+      {2, 1, 2, 0, 2, 2, 0, 0, 0, 1, 0, 1, 1, 0, 1, 0, 2, 0},
+      {false,
+       false,
+       false,
+       true,
+       false,
+       false,
+       true,
+       true,
+       true,
+       false,
+       true,
+       false,
+       false,
+       true,
+       false,
+       true,
+       false,
+       true});
+}
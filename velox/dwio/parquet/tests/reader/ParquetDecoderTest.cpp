@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <optional>
+#include <random>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+// Writes pages the way the Arrow encoders in
+// velox/dwio/parquet/writer/arrow/Encoding.cpp do.
+class PageWriter {
+ public:
+  template <typename T>
+  void writeDeltaBinaryPacked(const std::vector<T>& values) {
+    using U = std::make_unsigned_t<T>;
+    constexpr uint32_t kValuesPerBlock = sizeof(T) == 4 ? 128 : 256;
+    constexpr uint32_t kMiniBlocks = 4;
+    constexpr uint32_t kValuesPerMiniBlock = kValuesPerBlock / kMiniBlocks;
+    writeVarint(kValuesPerBlock);
+    writeVarint(kMiniBlocks);
+    writeVarint(values.size());
+    writeZigZag(values.empty() ? 0 : values[0]);
+    for (size_t first = 1; first < values.size(); first += kValuesPerBlock) {
+      const auto last =
+          std::min<size_t>(first + kValuesPerBlock, values.size());
+      std::vector<U> deltas;
+      for (auto i = first; i < last; ++i) {
+        deltas.push_back(static_cast<U>(values[i]) - values[i - 1]);
+      }
+      const U minDelta = *std::min_element(
+          deltas.begin(), deltas.end(), [](U left, U right) {
+            return static_cast<T>(left) < static_cast<T>(right);
+          });
+      writeZigZag(static_cast<T>(minDelta));
+      const auto bitWidths = bytes_.size();
+      bytes_.resize(bytes_.size() + kMiniBlocks, 0);
+      for (size_t begin = 0; begin < deltas.size();
+           begin += kValuesPerMiniBlock) {
+        const auto end = std::min(begin + kValuesPerMiniBlock, deltas.size());
+        U maxDelta = 0;
+        for (auto i = begin; i < end; ++i) {
+          maxDelta = std::max<U>(maxDelta, deltas[i] - minDelta);
+        }
+        int32_t bitWidth = 0;
+        while (bitWidth < 64 && (maxDelta >> bitWidth) != 0) {
+          ++bitWidth;
+        }
+        bytes_[bitWidths + begin / kValuesPerMiniBlock] = bitWidth;
+        // The last mini block is padded with zeros to its full size.
+        for (auto i = begin; i < begin + kValuesPerMiniBlock; ++i) {
+          writeBits(i < end ? deltas[i] - minDelta : 0, bitWidth);
+        }
+      }
+    }
+  }
+
+  void writeDeltaLengthByteArray(const std::vector<std::string>& values) {
+    std::vector<int32_t> lengths;
+    for (const auto& value : values) {
+      lengths.push_back(value.size());
+    }
+    writeDeltaBinaryPacked(lengths);
+    for (const auto& value : values) {
+      bytes_.insert(bytes_.end(), value.begin(), value.end());
+    }
+  }
+
+  void writeDeltaByteArray(const std::vector<std::string>& values) {
+    std::vector<int32_t> prefixLengths;
+    std::vector<std::string> suffixes;
+    std::string previous;
+    for (const auto& value : values) {
+      size_t prefixLength = 0;
+      while (prefixLength < std::min(value.size(), previous.size()) &&
+             value[prefixLength] == previous[prefixLength]) {
+        ++prefixLength;
+      }
+      prefixLengths.push_back(prefixLength);
+      suffixes.push_back(value.substr(prefixLength));
+      previous = value;
+    }
+    writeDeltaBinaryPacked(prefixLengths);
+    writeDeltaLengthByteArray(suffixes);
+  }
+
+  template <typename T>
+  void writeByteStreamSplit(const std::vector<T>& values) {
+    const auto begin = bytes_.size();
+    bytes_.resize(begin + values.size() * sizeof(T));
+    for (size_t i = 0; i < values.size(); ++i) {
+      const auto* valueBytes = reinterpret_cast<const char*>(&values[i]);
+      for (size_t byte = 0; byte < sizeof(T); ++byte) {
+        bytes_[begin + byte * values.size() + i] = valueBytes[byte];
+      }
+    }
+  }
+
+  const char* data() const {
+    return bytes_.data();
+  }
+
+  const char* end() const {
+    return bytes_.data() + bytes_.size();
+  }
+
+  // Returns the page followed by padding, as the decoders may load a word
+  // past the end of the bit packed data.
+  std::vector<char> padded() const {
+    auto result = bytes_;
+    result.resize(result.size() + sizeof(uint64_t));
+    return result;
+  }
+
+ private:
+  void writeVarint(uint64_t value) {
+    do {
+      uint8_t byte = value & 0x7f;
+      value >>= 7;
+      bytes_.push_back(value ? byte | 0x80 : byte);
+    } while (value);
+  }
+
+  void writeZigZag(int64_t value) {
+    writeVarint((static_cast<uint64_t>(value) << 1) ^ (value >> 63));
+  }
+
+  void writeBits(uint64_t value, int32_t bitWidth) {
+    for (auto bit = 0; bit < bitWidth; ++bit, ++bitOffset_) {
+      if (bitOffset_ % 8 == 0) {
+        bytes_.push_back(0);
+      }
+      if ((value >> bit) & 1) {
+        bytes_.back() |= 1 << (bitOffset_ % 8);
+      }
+    }
+  }
+
+  std::vector<char> bytes_;
+  // Bits written by writeBits(). Mini blocks end on a byte boundary.
+  uint64_t bitOffset_{0};
+};
+
+// Visits 'rows' with the row and null handling of the non-dense
+// dwio::common::ColumnVisitor without a filter and records the values.
+template <typename T, typename Value>
+class RecordingVisitor {
+ public:
+  using DataType = T;
+  static constexpr bool dense = false;
+
+  RecordingVisitor(
+      const std::vector<int32_t>& rows,
+      bool allowNulls,
+      std::vector<std::optional<Value>>& values)
+      : rows_(rows), allowNulls_(allowNulls), values_(&values) {}
+
+  int32_t start() {
+    return rows_[0];
+  }
+
+  bool allowNulls() {
+    return allowNulls_;
+  }
+
+  template <typename V>
+  int32_t process(V value, bool& atEnd) {
+    if constexpr (std::is_same_v<V, folly::StringPiece>) {
+      values_->push_back(value.str());
+    } else {
+      values_->push_back(static_cast<Value>(value));
+    }
+    return next(atEnd);
+  }
+
+  int32_t processNull(bool& atEnd) {
+    values_->push_back(std::nullopt);
+    return next(atEnd);
+  }
+
+  // Records the nulls from the current row on and returns the number of
+  // non-null values up to the next non-null row to visit.
+  int32_t
+  checkAndSkipNulls(const uint64_t* nulls, int32_t& current, bool& atEnd) {
+    int32_t toSkip = 0;
+    for (;;) {
+      const auto row = rows_[rowIndex_];
+      toSkip += bits::countNonNulls(nulls, current, row);
+      current = row;
+      if (!bits::isBitNull(nulls, row)) {
+        return toSkip;
+      }
+      values_->push_back(std::nullopt);
+      if (++rowIndex_ == rows_.size()) {
+        atEnd = true;
+        return toSkip;
+      }
+    }
+  }
+
+ private:
+  int32_t next(bool& atEnd) {
+    const auto row = rows_[rowIndex_];
+    if (++rowIndex_ == rows_.size()) {
+      atEnd = true;
+      return 0;
+    }
+    return rows_[rowIndex_] - row - 1;
+  }
+
+  const std::vector<int32_t>& rows_;
+  const bool allowNulls_;
+  std::vector<std::optional<Value>>* values_;
+  size_t rowIndex_{0};
+};
+
+class ParquetDecoderTest : public testing::Test {
+ protected:
+  // Writes the non-null values of 'expected' with 'write', then decodes from
+  // 'makeDecoder' with and without nulls, for all rows, sparse rows and after
+  // skipping half of the page.
+  template <typename Decoder, typename T, typename Value>
+  void testRoundTrip(
+      const std::vector<std::optional<Value>>& expected,
+      std::function<void(PageWriter&, const std::vector<Value>&)> write,
+      std::function<std::unique_ptr<Decoder>(const char*, const char*)>
+          makeDecoder) {
+    std::vector<Value> values;
+    std::vector<std::optional<Value>> expectedNonNull;
+    const int32_t numRows = expected.size();
+    std::vector<uint64_t> nulls(bits::nwords(numRows), 0);
+    for (auto row = 0; row < numRows; ++row) {
+      if (expected[row].has_value()) {
+        values.push_back(expected[row].value());
+        expectedNonNull.push_back(expected[row]);
+        bits::setBit(nulls.data(), row);
+      }
+    }
+    PageWriter writer;
+    write(writer, values);
+    const auto page = writer.padded();
+    const auto pageEnd = page.data() + page.size() - sizeof(uint64_t);
+    auto decoderFactory = [&]() { return makeDecoder(page.data(), pageEnd); };
+
+    for (auto step : {1, 3, 100}) {
+      std::vector<int32_t> nonNullRows;
+      for (size_t row = step / 2; row < values.size(); row += step) {
+        nonNullRows.push_back(row);
+      }
+      testRows<Decoder, T, Value>(
+          decoderFactory, expectedNonNull, nonNullRows, nullptr, false, 0);
+      testRows<Decoder, T, Value>(
+          decoderFactory,
+          expectedNonNull,
+          nonNullRows,
+          nullptr,
+          false,
+          values.size() / 2);
+
+      std::vector<int32_t> rows;
+      for (auto row = step / 2; row < numRows; row += step) {
+        rows.push_back(row);
+      }
+      for (auto allowNulls : {false, true}) {
+        testRows<Decoder, T, Value>(
+            decoderFactory, expected, rows, nulls.data(), allowNulls, 0);
+        testRows<Decoder, T, Value>(
+            decoderFactory,
+            expected,
+            rows,
+            nulls.data(),
+            allowNulls,
+            numRows / 2);
+      }
+    }
+  }
+
+ private:
+  // Skips the values of the rows before 'skipRows' and visits the 'rows' from
+  // 'skipRows' on, relative to 'skipRows' as PageReader does.
+  template <typename Decoder, typename T, typename Value>
+  void testRows(
+      const std::function<std::unique_ptr<Decoder>()>& makeDecoder,
+      const std::vector<std::optional<Value>>& expected,
+      const std::vector<int32_t>& rows,
+      const uint64_t* nulls,
+      bool allowNulls,
+      int32_t skipRows) {
+    std::vector<int32_t> visitedRows;
+    for (auto row : rows) {
+      if (row >= skipRows) {
+        visitedRows.push_back(row - skipRows);
+      }
+    }
+    if (visitedRows.empty()) {
+      return;
+    }
+    auto decoder = makeDecoder();
+    decoder->skip(nulls ? bits::countNonNulls(nulls, 0, skipRows) : skipRows);
+    std::vector<uint64_t> visitedNulls;
+    if (nulls) {
+      visitedNulls.resize(bits::nwords(expected.size()), 0);
+      bits::copyBits(
+          nulls, skipRows, visitedNulls.data(), 0, expected.size() - skipRows);
+    }
+
+    std::vector<std::optional<Value>> values;
+    RecordingVisitor<T, Value> visitor(visitedRows, allowNulls, values);
+    if (nulls) {
+      decoder->template readWithVisitor<true>(visitedNulls.data(), visitor);
+    } else {
+      decoder->template readWithVisitor<false>(nullptr, visitor);
+    }
+    ASSERT_EQ(values.size(), visitedRows.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      ASSERT_EQ(values[i], expected[visitedRows[i] + skipRows])
+          << "row " << visitedRows[i] + skipRows << " skipRows " << skipRows
+          << " allowNulls " << allowNulls;
+    }
+  }
+};
+
+template <typename T>
+std::vector<std::optional<T>> withNulls(
+    int32_t numRows,
+    std::function<T(int32_t)> makeValue) {
+  std::vector<std::optional<T>> result;
+  for (auto row = 0; row < numRows; ++row) {
+    if (row % 7 == 3 || (row / 100) % 5 == 2) {
+      result.push_back(std::nullopt);
+    } else {
+      result.push_back(makeValue(row));
+    }
+  }
+  return result;
+}
+
+const std::vector<int32_t> kNumRows = {1, 33, 129, 257, 1'000, 5'000};
+
+TEST_F(ParquetDecoderTest, specExamples) {
+  // The DELTA_BINARY_PACKED example of the Parquet format specification.
+  PageWriter deltas;
+  deltas.writeDeltaBinaryPacked(std::vector<int32_t>{1, 2, 3, 4, 5});
+  EXPECT_EQ(
+      std::vector<char>(deltas.data(), deltas.end()),
+      (std::vector<char>{
+          '\x80', '\x01', '\x04', '\x05', '\x02', '\x02', 0, 0, 0, 0}));
+
+  PageWriter lengths;
+  lengths.writeDeltaLengthByteArray({"Hello", "World", "Foobar", "ABCDEF"});
+  auto page = lengths.padded();
+  DeltaLengthByteArrayDecoder lengthDecoder(page.data());
+  EXPECT_EQ(lengthDecoder.readString(), "Hello");
+  lengthDecoder.skip(1);
+  EXPECT_EQ(lengthDecoder.readString(), "Foobar");
+  EXPECT_EQ(lengthDecoder.readString(), "ABCDEF");
+}
+
+TEST_F(ParquetDecoderTest, deltaByteArray) {
+  std::mt19937 rng(1);
+  for (auto numRows : kNumRows) {
+    // Values share a random prefix with their predecessor. Some are empty.
+    std::string previous;
+    auto strings = withNulls<std::string>(numRows, [&](int32_t /*row*/) {
+      std::string value = previous.substr(0, rng() % (previous.size() + 1));
+      if (rng() % 11 == 0) {
+        value.clear();
+      }
+      const auto suffixLength = rng() % 12;
+      for (size_t i = 0; i < suffixLength; ++i) {
+        value.push_back('a' + rng() % 26);
+      }
+      previous = value;
+      return value;
+    });
+    testRoundTrip<DeltaLengthByteArrayDecoder, folly::StringPiece, std::string>(
+        strings,
+        [](PageWriter& writer, const std::vector<std::string>& values) {
+          writer.writeDeltaLengthByteArray(values);
+        },
+        [](const char* begin, const char* /*end*/) {
+          return std::make_unique<DeltaLengthByteArrayDecoder>(begin);
+        });
+    testRoundTrip<DeltaByteArrayDecoder, folly::StringPiece, std::string>(
+        strings,
+        [](PageWriter& writer, const std::vector<std::string>& values) {
+          writer.writeDeltaByteArray(values);
+        },
+        [](const char* begin, const char* /*end*/) {
+          return std::make_unique<DeltaByteArrayDecoder>(begin);
+        });
+  }
+}
+
+template <typename T>
+std::function<void(PageWriter&, const std::vector<T>&)> byteStreamSplit() {
+  return [](PageWriter& writer, const std::vector<T>& values) {
+    writer.writeByteStreamSplit(values);
+  };
+}
+
+std::function<std::unique_ptr<ByteStreamSplitDecoder>(const char*, const char*)>
+byteStreamSplitDecoder(int32_t byteWidth, bool isFloatingPoint) {
+  return [=](const char* begin, const char* end) {
+    return std::make_unique<ByteStreamSplitDecoder>(
+        begin, end, byteWidth, isFloatingPoint);
+  };
+}
+
+TEST_F(ParquetDecoderTest, byteStreamSplit) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> real(-1e6, 1e6);
+  for (auto numRows : kNumRows) {
+    auto floats =
+        withNulls<float>(numRows, [&](int32_t /*row*/) { return real(rng); });
+    auto doubles =
+        withNulls<double>(numRows, [&](int32_t /*row*/) { return real(rng); });
+    auto ints = withNulls<int32_t>(
+        numRows, [&](int32_t /*row*/) { return static_cast<int32_t>(rng()); });
+    auto longs = withNulls<int64_t>(numRows, [&](int32_t /*row*/) {
+      return static_cast<int64_t>(rng()) << 32 | rng();
+    });
+    testRoundTrip<ByteStreamSplitDecoder, float, float>(
+        floats, byteStreamSplit<float>(), byteStreamSplitDecoder(4, true));
+    testRoundTrip<ByteStreamSplitDecoder, double, double>(
+        doubles, byteStreamSplit<double>(), byteStreamSplitDecoder(8, true));
+    testRoundTrip<ByteStreamSplitDecoder, int32_t, int32_t>(
+        ints, byteStreamSplit<int32_t>(), byteStreamSplitDecoder(4, false));
+    testRoundTrip<ByteStreamSplitDecoder, int64_t, int64_t>(
+        longs, byteStreamSplit<int64_t>(), byteStreamSplitDecoder(8, false));
+    // FLOAT read into DOUBLE and INT32 into BIGINT.
+    testRoundTrip<ByteStreamSplitDecoder, double, float>(
+        floats, byteStreamSplit<float>(), byteStreamSplitDecoder(4, true));
+    testRoundTrip<ByteStreamSplitDecoder, int64_t, int32_t>(
+        ints, byteStreamSplit<int32_t>(), byteStreamSplitDecoder(4, false));
+  }
+}
+
+} // namespace
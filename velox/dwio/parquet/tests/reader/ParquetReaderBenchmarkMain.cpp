@@ -143,6 +143,11 @@ PARQUET_BENCHMARKS(BIGINT(), BigInt);
 PARQUET_BENCHMARKS(DOUBLE(), Double);
 PARQUET_BENCHMARKS_NO_FILTER(MAP(BIGINT(), BIGINT()), Map);
 PARQUET_BENCHMARKS_NO_FILTER(ARRAY(BIGINT()), List);
+PARQUET_BENCHMARKS_NO_FILTER(ARRAY(ARRAY(BIGINT())), ListOfList);
+PARQUET_BENCHMARKS_NO_FILTER(
+    ARRAY(ROW({"a", "b"}, {BIGINT(), DOUBLE()})),
+    ListOfStruct);
+PARQUET_BENCHMARKS_NO_FILTER(MAP(VARCHAR(), ARRAY(BIGINT())), MapOfList);
 
 // TODO: Add all data types
 
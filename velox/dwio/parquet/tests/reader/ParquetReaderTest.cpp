@@ -14,6 +14,12 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -61,6 +67,51 @@ class ParquetReaderTest : public ParquetTestBase {
     assertReadWithReaderAndFilters(
         std::move(reader), fileName, fileSchema, std::move(filters), expected);
   }
+
+  // Returns the thrift BloomFilterHeader and the bitset of a split block
+  // Bloom filter of 'numBytes' that contains 'hashes', as a writer lays them
+  // out in a file.
+  static std::string makeBloomFilter(
+      const std::vector<uint64_t>& hashes,
+      int32_t numBytes = 8 << 10) {
+    constexpr uint32_t kSalt[8] = {
+        0x47b6137bU,
+        0x44974d91U,
+        0x8824ad5bU,
+        0xa2b7289dU,
+        0x705495c7U,
+        0x2df1424bU,
+        0x9efc4947U,
+        0x5c6bfb31U};
+    std::vector<uint32_t> words(numBytes / sizeof(uint32_t));
+    const uint64_t numBlocks = words.size() / 8;
+    for (auto hash : hashes) {
+      const uint32_t block = ((hash >> 32) * numBlocks) >> 32;
+      const uint32_t key = hash;
+      for (auto i = 0; i < 8; ++i) {
+        words[block * 8 + i] |= 1U << ((key * kSalt[i]) >> 27);
+      }
+    }
+
+    thrift::BloomFilterHeader header;
+    header.__set_numBytes(numBytes);
+    thrift::BloomFilterAlgorithm algorithm;
+    algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+    header.__set_algorithm(algorithm);
+    thrift::BloomFilterHash hash;
+    hash.__set_XXHASH(thrift::XxHash());
+    header.__set_hash(hash);
+    thrift::BloomFilterCompression compression;
+    compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+    header.__set_compression(compression);
+
+    auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+    apache::thrift::protocol::TCompactProtocol protocol(buffer);
+    header.write(&protocol);
+    auto result = buffer->getBufferAsString();
+    result.append(reinterpret_cast<const char*>(words.data()), numBytes);
+    return result;
+  }
 };
 
 TEST_F(ParquetReaderTest, parseSample) {
@@ -1078,6 +1129,41 @@ TEST_F(ParquetReaderTest, prefetchRowGroups) {
   }
 }
 
+TEST_F(ParquetReaderTest, parallelRowGroupLoads) {
+  auto rowType = ROW({"id"}, {BIGINT()});
+  const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
+
+  auto readIds = [&](std::shared_ptr<folly::Executor> ioExecutor) {
+    facebook::velox::dwio::common::ReaderOptions readerOptions{
+        leafPool_.get()};
+    readerOptions.setFilePreloadThreshold(0);
+    readerOptions.setPrefetchRowGroups(2);
+    readerOptions.setIOExecutor(std::move(ioExecutor));
+    auto reader = createReader(sample, readerOptions);
+    EXPECT_EQ(reader->fileMetaData().numRowGroups(), 4);
+
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    std::vector<int64_t> ids;
+    VectorPtr result = BaseVector::create(rowType, 0, pool_.get());
+    while (rowReader->next(100, result) > 0) {
+      auto* column = result->as<RowVector>()->childAt(0)->loadedVector();
+      auto* values = column->as<SimpleVector<int64_t>>();
+      for (vector_size_t i = 0; i < values->size(); ++i) {
+        ids.push_back(values->valueAt(i));
+      }
+    }
+    return ids;
+  };
+
+  const auto expected = readIds(nullptr);
+  EXPECT_FALSE(expected.empty());
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  EXPECT_EQ(readIds(executor), expected);
+}
+
 TEST_F(ParquetReaderTest, testEmptyRowGroups) {
   // empty_row_groups.parquet contains empty row groups
   const std::string sample(getExampleFilePath("empty_row_groups.parquet"));
@@ -1181,3 +1267,182 @@ TEST_F(ParquetReaderTest, testV2PageWithZeroMaxDefRep) {
   assertReadWithReaderAndExpected(
       outputRowType, *rowReader, expected, *leafPool_);
 }
+
+TEST_F(ParquetReaderTest, bloomFilter) {
+  std::vector<uint64_t> hashes;
+  for (int64_t i = 0; i < 1'000; ++i) {
+    hashes.push_back(BlockSplitBloomFilter::hash(i * 7));
+  }
+  hashes.push_back(BlockSplitBloomFilter::hash(folly::StringPiece("velox")));
+
+  // Put the filter after some other bytes, like in a file.
+  std::string data = "PAR1";
+  data += makeBloomFilter(hashes);
+  data += "PAR1";
+
+  dwio::common::BufferedInput input(
+      std::make_shared<InMemoryReadFile>(data), *leafPool_);
+  auto bloomFilter = BlockSplitBloomFilter::read(input, 4);
+  ASSERT_NE(bloomFilter, nullptr);
+
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 7'000; ++i) {
+    const bool found =
+        bloomFilter->mightContain(BlockSplitBloomFilter::hash(i));
+    if (i % 7 == 0) {
+      ASSERT_TRUE(found) << i;
+    } else if (found) {
+      ++numFalsePositives;
+    }
+  }
+  ASSERT_LT(numFalsePositives, 60);
+
+  ASSERT_TRUE(bloomFilter->mightContain(
+      BlockSplitBloomFilter::hash(folly::StringPiece("velox"))));
+  // An int32_t value hashes differently than the same int64_t value.
+  ASSERT_NE(
+      BlockSplitBloomFilter::hash(static_cast<int32_t>(7)),
+      BlockSplitBloomFilter::hash(static_cast<int64_t>(7)));
+}
+
+TEST_F(ParquetReaderTest, bloomFilterSkipsRowGroups) {
+  // Three row groups of the even numbers in [0, 1998]. The middle one has
+  // 1001 in place of 1000. The statistics of all row groups admit 1001, so
+  // only the Bloom filters can tell the row groups without it.
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 3; ++i) {
+    batches.push_back(makeRowVector(
+        {"c0"}, {makeFlatVector<int64_t>(1'000, [&](auto row) {
+          return i == 1 && row == 500 ? 1'001 : row * 2;
+        })}));
+  }
+
+  auto sink = std::make_unique<MemorySink>(
+      1 << 20, dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  auto writer = createWriter(
+      std::move(sink),
+      [&]() {
+        return std::make_unique<LambdaFlushPolicy>(
+            kRowsInRowGroup, kBytesInRowGroup, [&]() { return true; });
+      },
+      rowType);
+  for (auto& batch : batches) {
+    writer->write(batch);
+  }
+  writer->close();
+  const std::string data(sinkPtr->data(), sinkPtr->size());
+
+  // The writer does not make Bloom filters. Put one per row group between the
+  // data and the footer and point the column chunks to them.
+  uint32_t footerLength;
+  std::memcpy(&footerLength, data.data() + data.size() - 8, sizeof(uint32_t));
+  const auto footerOffset = data.size() - 8 - footerLength;
+  std::string footer = data.substr(footerOffset, footerLength);
+  thrift::FileMetaData fileMetaData;
+  {
+    auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>(
+        reinterpret_cast<uint8_t*>(footer.data()), footerLength);
+    apache::thrift::protocol::TCompactProtocol protocol(buffer);
+    fileMetaData.read(&protocol);
+  }
+  ASSERT_EQ(fileMetaData.row_groups.size(), batches.size());
+  std::string dataWithBloomFilters = data.substr(0, footerOffset);
+  for (auto i = 0; i < batches.size(); ++i) {
+    auto* values = batches[i]->childAt(0)->asFlatVector<int64_t>();
+    std::vector<uint64_t> hashes;
+    for (auto row = 0; row < values->size(); ++row) {
+      hashes.push_back(BlockSplitBloomFilter::hash(values->valueAt(row)));
+    }
+    fileMetaData.row_groups[i].columns[0].meta_data.__set_bloom_filter_offset(
+        dataWithBloomFilters.size());
+    dataWithBloomFilters += makeBloomFilter(hashes);
+  }
+  {
+    auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+    apache::thrift::protocol::TCompactProtocol protocol(buffer);
+    fileMetaData.write(&protocol);
+    footer = buffer->getBufferAsString();
+  }
+  dataWithBloomFilters += footer;
+  footerLength = footer.size();
+  dataWithBloomFilters.append(
+      reinterpret_cast<const char*>(&footerLength), sizeof(uint32_t));
+  dataWithBloomFilters += "PAR1";
+
+  // Reads the rows with c0 = 1001 and returns the number of skipped row
+  // groups.
+  auto readSkippedRowGroups = [&](const std::string& fileData) {
+    ReaderOptions readerOptions{leafPool_.get()};
+    ParquetReader reader(
+        std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(fileData), *leafPool_),
+        readerOptions);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("c0")->setFilter(
+        std::make_unique<BigintRange>(1'001, 1'001, false));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader.createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(
+        rowType,
+        *rowReader,
+        makeRowVector({"c0"}, {makeFlatVector<int64_t>({1'001})}),
+        *leafPool_);
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.skippedStrides;
+  };
+  EXPECT_EQ(readSkippedRowGroups(data), 0);
+  EXPECT_EQ(readSkippedRowGroups(dataWithBloomFilters), 2);
+}
+
+TEST_F(ParquetReaderTest, footerCache) {
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  auto& footerCache = FileMetadataCache::instance();
+  footerCache.clear();
+
+  facebook::velox::dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  // Disabled by default.
+  createReader(sample, readerOptions);
+  ASSERT_EQ(footerCache.numEntries(), 0);
+  ASSERT_EQ(footerCache.numMisses(), 0);
+
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_file_metadata_cache_bytes = 1 << 20;
+  // Not cached without a modification time.
+  createReader(sample, readerOptions);
+  ASSERT_EQ(footerCache.numEntries(), 0);
+  ASSERT_EQ(footerCache.numMisses(), 0);
+
+  readerOptions.setFileModificationTime(1'000);
+  auto first = createReader(sample, readerOptions);
+  ASSERT_EQ(footerCache.numEntries(), 1);
+  ASSERT_EQ(footerCache.numMisses(), 1);
+  ASSERT_EQ(footerCache.numHits(), 0);
+
+  auto second = createReader(sample, readerOptions);
+  ASSERT_EQ(footerCache.numEntries(), 1);
+  ASSERT_EQ(footerCache.numHits(), 1);
+  ASSERT_EQ(first->fileMetaData().numRowGroups(), 2);
+  ASSERT_EQ(second->fileMetaData().numRowGroups(), 2);
+  ASSERT_EQ(second->numberOfRows(), 20ULL);
+
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+  auto rowReader = second->createRowReader(rowReaderOpts);
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+      makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+  });
+  assertReadWithReaderAndExpected(
+      sampleSchema(), *rowReader, expected, *leafPool_);
+
+  // A footer larger than the capacity is not cached.
+  footerCache.clear();
+  FLAGS_velox_file_metadata_cache_bytes = 1;
+  createReader(sample, readerOptions);
+  ASSERT_EQ(footerCache.numEntries(), 0);
+  footerCache.clear();
+}
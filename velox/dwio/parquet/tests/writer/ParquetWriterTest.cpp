@@ -135,6 +135,66 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, dictionaryInput) {
+  const auto schema = ROW({"c0", "c1"}, {VARCHAR(), BIGINT()});
+  const vector_size_t kBatchSize = 1'000;
+  const int kNumBatches = 3;
+  auto makeBase = [&]() {
+    return makeFlatVector<std::string>(
+        100, [](auto row) { return fmt::format("value{}", row); });
+  };
+  auto expected = makeRowVector(
+      {makeFlatVector<std::string>(
+           kBatchSize * kNumBatches,
+           [](auto row) { return fmt::format("value{}", row % 97); }),
+       makeFlatVector<int64_t>(
+           kBatchSize * kNumBatches, [](auto row) { return row; })});
+
+  // The batches share one dictionary, which is written as is, or each has its
+  // own, which makes the writer flatten them.
+  for (const bool sharedBase : {true, false}) {
+    SCOPED_TRACE(fmt::format("sharedBase {}", sharedBase));
+    auto base = makeBase();
+    std::vector<RowVectorPtr> batches;
+    for (auto i = 0; i < kNumBatches; ++i) {
+      auto indices = makeIndices(kBatchSize, [&](auto row) {
+        return (i * kBatchSize + row) % 97;
+      });
+      batches.push_back(makeRowVector(
+          {BaseVector::wrapInDictionary(
+               nullptr,
+               indices,
+               kBatchSize,
+               sharedBase ? base : makeBase()),
+           makeFlatVector<int64_t>(
+               kBatchSize, [&](auto row) { return i * kBatchSize + row; })}));
+    }
+
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto sinkPtr = sink.get();
+    facebook::velox::parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    for (const auto& batch : batches) {
+      writer->write(batch);
+    }
+    writer->close();
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    ASSERT_EQ(reader->numberOfRows(), kBatchSize * kNumBatches);
+    ASSERT_TRUE(reader->fileMetaData()
+                    .rowGroup(0)
+                    .columnChunk(0)
+                    .hasDictionaryPageOffset());
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+  }
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/parquet/writer/Writer.h"
+#include <arrow/array.h>
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
 #include <arrow/table.h>
@@ -22,6 +23,7 @@
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::parquet {
 
@@ -98,10 +100,12 @@ struct ArrowContext {
   std::unique_ptr<FileWriter> writer;
   std::shared_ptr<::arrow::Schema> schema;
   std::shared_ptr<WriterProperties> properties;
+  bool enableDictionary = true;
   uint64_t stagingRows = 0;
   int64_t stagingBytes = 0;
-  // columns, Arrays
-  std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
+  // Batches written since the last flush. They are exported to Arrow on flush
+  // so that the encoding of a column can be chosen over all its batches.
+  std::vector<RowVectorPtr> stagingBatches;
 };
 
 Compression::type getArrowParquetCompression(
@@ -213,6 +217,94 @@ std::shared_ptr<::arrow::Field> updateFieldNameRecursive(
   }
 }
 
+// Returns the base vector shared by 'columns' if they can be written as Arrow
+// dictionary arrays, so that the Parquet writer takes the dictionary as is
+// instead of flattening and re-hashing the values. All columns must be
+// dictionaries over the same flat string or binary base without nulls, and
+// the base must fit in a dictionary page. Returns nullptr otherwise.
+VectorPtr sharedDictionary(
+    const std::vector<VectorPtr>& columns,
+    int64_t dictionaryPageSizeLimit) {
+  VectorPtr base;
+  for (const auto& column : columns) {
+    if (column->encoding() != VectorEncoding::Simple::DICTIONARY) {
+      return nullptr;
+    }
+    if (base == nullptr) {
+      base = column->valueVector();
+    } else if (column->valueVector() != base) {
+      return nullptr;
+    }
+  }
+  if (base == nullptr || !base->isFlatEncoding() || base->mayHaveNulls()) {
+    return nullptr;
+  }
+  const auto kind = base->typeKind();
+  if (kind != TypeKind::VARCHAR && kind != TypeKind::VARBINARY) {
+    return nullptr;
+  }
+  if (base->estimateFlatSize() > dictionaryPageSizeLimit) {
+    return nullptr;
+  }
+  return base;
+}
+
+// Exports 'column' of the batches staged in 'context' as a chunked array of
+// 'type', or of dictionaries over 'type' if the batches share a dictionary.
+std::shared_ptr<::arrow::ChunkedArray> exportColumn(
+    const ArrowContext& context,
+    int32_t column,
+    const std::shared_ptr<::arrow::DataType>& type,
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
+  std::vector<VectorPtr> columns;
+  columns.reserve(context.stagingBatches.size());
+  for (const auto& batch : context.stagingBatches) {
+    columns.push_back(BaseVector::loadedVectorShared(batch->childAt(column)));
+  }
+
+  std::vector<std::shared_ptr<::arrow::Array>> arrays;
+  arrays.reserve(columns.size());
+  auto base = context.enableDictionary
+      ? sharedDictionary(
+            columns, context.properties->dictionary_pagesize_limit())
+      : nullptr;
+  if (base == nullptr) {
+    for (const auto& vector : columns) {
+      ArrowArray array;
+      exportToArrow(vector, array, pool, options);
+      PARQUET_ASSIGN_OR_THROW(
+          auto imported, ::arrow::ImportArray(&array, type));
+      arrays.push_back(std::move(imported));
+    }
+    return ::arrow::ChunkedArray::Make(std::move(arrays), type).ValueOrDie();
+  }
+
+  // Export the dictionary once and the indices of each batch on their own.
+  // The arrays then share one dictionary which the Parquet writer takes as the
+  // dictionary page, writing the indices as they are.
+  ArrowArray array;
+  exportToArrow(base, array, pool, options);
+  PARQUET_ASSIGN_OR_THROW(auto dictionary, ::arrow::ImportArray(&array, type));
+  auto dictionaryType = ::arrow::dictionary(::arrow::int32(), type);
+  for (const auto& vector : columns) {
+    auto indices = std::make_shared<FlatVector<int32_t>>(
+        pool,
+        INTEGER(),
+        vector->nulls(),
+        vector->size(),
+        vector->wrapInfo(),
+        std::vector<BufferPtr>{});
+    exportToArrow(indices, array, pool, options);
+    PARQUET_ASSIGN_OR_THROW(
+        auto arrowIndices, ::arrow::ImportArray(&array, ::arrow::int32()));
+    arrays.push_back(std::make_shared<::arrow::DictionaryArray>(
+        dictionaryType, arrowIndices, dictionary));
+  }
+  return ::arrow::ChunkedArray::Make(std::move(arrays), dictionaryType)
+      .ValueOrDie();
+}
+
 } // namespace
 
 Writer::Writer(
@@ -239,6 +331,7 @@ Writer::Writer(
       static_cast<TimestampUnit>(options.parquetWriteTimestampUnit);
   arrowContext_->properties =
       getArrowParquetWriterOptions(options, flushPolicy_);
+  arrowContext_->enableDictionary = options.enableDictionary;
   setMemoryReclaimers();
 }
 
@@ -271,23 +364,31 @@ void Writer::flush() {
     auto fields = arrowContext_->schema->fields();
     std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks;
     for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
-      auto dataType = fields.at(colIdx)->type();
-      auto chunk =
-          ::arrow::ChunkedArray::Make(
-              std::move(arrowContext_->stagingChunks.at(colIdx)), dataType)
-              .ValueOrDie();
-      chunks.push_back(chunk);
+      chunks.push_back(exportColumn(
+          *arrowContext_,
+          colIdx,
+          fields.at(colIdx)->type(),
+          generalPool_.get(),
+          options_));
     }
-    auto table = ::arrow::Table::Make(
-        arrowContext_->schema,
-        std::move(chunks),
-        static_cast<int64_t>(arrowContext_->stagingRows));
-    PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteTable(
-        *table, static_cast<int64_t>(flushPolicy_->rowsInRowGroup())));
-    PARQUET_THROW_NOT_OK(stream_->Flush());
-    for (auto& chunk : arrowContext_->stagingChunks) {
-      chunk.clear();
+    arrowContext_->stagingBatches.clear();
+
+    // The columns may be dictionary arrays while the file schema has their
+    // value types, so the row groups are written column by column instead of
+    // with WriteTable(), which requires the types to match.
+    const auto numRows = static_cast<int64_t>(arrowContext_->stagingRows);
+    const auto rowsInRowGroup = std::min<int64_t>(
+        flushPolicy_->rowsInRowGroup(),
+        arrowContext_->properties->max_row_group_length());
+    for (int64_t offset = 0; offset < numRows; offset += rowsInRowGroup) {
+      const auto size = std::min(rowsInRowGroup, numRows - offset);
+      PARQUET_THROW_NOT_OK(arrowContext_->writer->NewRowGroup(size));
+      for (const auto& chunk : chunks) {
+        PARQUET_THROW_NOT_OK(
+            arrowContext_->writer->WriteColumnChunk(chunk, offset, size));
+      }
     }
+    PARQUET_THROW_NOT_OK(stream_->Flush());
     arrowContext_->stagingRows = 0;
     arrowContext_->stagingBytes = 0;
   }
@@ -313,33 +414,24 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
-  ArrowArray array;
-  ArrowSchema schema;
-  exportToArrow(data, array, generalPool_.get(), options_);
-  exportToArrow(data, schema, options_);
-
-  // Convert the arrow schema to Schema and then update the column names based
-  // on schema_.
-  auto arrowSchema = ::arrow::ImportSchema(&schema).ValueOrDie();
-  common::testutil::TestValue::adjust(
-      "facebook::velox::parquet::Writer::write", arrowSchema.get());
-  std::vector<std::shared_ptr<::arrow::Field>> newFields;
-  auto childSize = schema_->size();
-  for (auto i = 0; i < childSize; i++) {
-    newFields.push_back(updateFieldNameRecursive(
-        arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
-  }
-
-  PARQUET_ASSIGN_OR_THROW(
-      auto recordBatch,
-      ::arrow::ImportRecordBatch(&array, ::arrow::schema(newFields)));
+  // The exported schema only depends on the type since dictionaries and
+  // constants are flattened, so it is made once.
   if (!arrowContext_->schema) {
-    arrowContext_->schema = recordBatch->schema();
-    for (int colIdx = 0; colIdx < arrowContext_->schema->num_fields();
-         colIdx++) {
-      arrowContext_->stagingChunks.push_back(
-          std::vector<std::shared_ptr<::arrow::Array>>());
+    ArrowSchema schema;
+    exportToArrow(data, schema, options_);
+
+    // Convert the arrow schema to Schema and then update the column names
+    // based on schema_.
+    auto arrowSchema = ::arrow::ImportSchema(&schema).ValueOrDie();
+    common::testutil::TestValue::adjust(
+        "facebook::velox::parquet::Writer::write", arrowSchema.get());
+    std::vector<std::shared_ptr<::arrow::Field>> newFields;
+    auto childSize = schema_->size();
+    for (auto i = 0; i < childSize; i++) {
+      newFields.push_back(updateFieldNameRecursive(
+          arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
     }
+    arrowContext_->schema = ::arrow::schema(newFields);
   }
 
   auto bytes = data->estimateFlatSize();
@@ -349,10 +441,13 @@ void Writer::write(const VectorPtr& data) {
     flush();
   }
 
-  for (int colIdx = 0; colIdx < recordBatch->num_columns(); colIdx++) {
-    arrowContext_->stagingChunks.at(colIdx).push_back(
-        recordBatch->column(colIdx));
+  auto rowVector = std::dynamic_pointer_cast<RowVector>(data);
+  if (rowVector == nullptr) {
+    VectorPtr flat = data;
+    BaseVector::flattenVector(flat);
+    rowVector = std::static_pointer_cast<RowVector>(flat);
   }
+  arrowContext_->stagingBatches.push_back(std::move(rowVector));
   arrowContext_->stagingRows += numRows;
   arrowContext_->stagingBytes += bytes;
 }
@@ -375,7 +470,7 @@ void Writer::close() {
   }
   PARQUET_THROW_NOT_OK(stream_->Close());
 
-  arrowContext_->stagingChunks.clear();
+  arrowContext_->stagingBatches.clear();
 }
 
 void Writer::abort() {
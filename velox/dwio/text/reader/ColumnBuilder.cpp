@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/ColumnBuilder.h"
+
+#include "velox/type/Conversions.h"
+#include "velox/type/TimestampConversion.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::text {
+
+ColumnBuilder::ColumnBuilder(TypePtr type, memory::MemoryPool* pool)
+    : type_(std::move(type)), pool_(pool) {
+  VELOX_USER_CHECK(
+      type_->isPrimitiveType() && !type_->isDecimal() &&
+          type_->kind() != TypeKind::HUGEINT &&
+          type_->kind() != TypeKind::UNKNOWN,
+      "Text files do not support columns of type {}",
+      type_->toString());
+}
+
+void ColumnBuilder::reset(vector_size_t size) {
+  vector_ = BaseVector::create(type_, size, pool_);
+  bits::fillBits(vector_->mutableRawNulls(), 0, size, bits::kNull);
+}
+
+void ColumnBuilder::setText(vector_size_t row, std::string_view text) {
+  VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(setTextTyped, type_->kind(), row, text);
+}
+
+template <TypeKind kKind>
+void ColumnBuilder::setTextTyped(vector_size_t row, std::string_view text) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  if constexpr (std::is_same_v<T, StringView>) {
+    set(row, StringView(text.data(), text.size()));
+  } else if constexpr (kKind == TypeKind::HUGEINT) {
+    VELOX_UNREACHABLE();
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    auto result = util::fromTimestampString(
+        text.data(), text.size(), util::TimestampParseMode::kPrestoCast);
+    if (!result.hasError()) {
+      set(row, result.value());
+    }
+  } else {
+    if constexpr (kKind == TypeKind::INTEGER) {
+      if (type_->isDate()) {
+        auto result = util::fromDateString(
+            text.data(), text.size(), util::ParseMode::kPrestoCast);
+        if (!result.hasError()) {
+          set<int32_t>(row, result.value());
+        }
+        return;
+      }
+    }
+    auto result = util::Converter<kKind>::tryCast(
+        folly::StringPiece(text.data(), text.size()));
+    if (!result.hasError()) {
+      set<T>(row, result.value());
+    }
+  }
+}
+
+void ColumnBuilder::setBool(vector_size_t row, bool value) {
+  if (type_->kind() == TypeKind::BOOLEAN) {
+    set(row, value);
+  } else {
+    setText(row, value ? "true" : "false");
+  }
+}
+
+void ColumnBuilder::setInt(vector_size_t row, int64_t value) {
+  switch (type_->kind()) {
+    case TypeKind::BIGINT:
+      set<int64_t>(row, value);
+      break;
+    case TypeKind::DOUBLE:
+      set<double>(row, value);
+      break;
+    default:
+      setText(row, std::to_string(value));
+  }
+}
+
+void ColumnBuilder::setDouble(vector_size_t row, double value) {
+  switch (type_->kind()) {
+    case TypeKind::REAL:
+      set<float>(row, value);
+      break;
+    case TypeKind::DOUBLE:
+      set<double>(row, value);
+      break;
+    default:
+      setText(row, fmt::format("{}", value));
+  }
+}
+
+} // namespace facebook::velox::text
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::text {
+
+/// Builds a flat vector of a scalar type from values read from text, e.g. the
+/// fields of a delimited text file or the values of JSON objects. A value that
+/// does not parse as the type is null, as in Hive.
+class ColumnBuilder {
+ public:
+  /// Throws if 'type' is not a supported scalar type.
+  ColumnBuilder(TypePtr type, memory::MemoryPool* pool);
+
+  /// Starts a vector of 'size' rows that are all null.
+  void reset(vector_size_t size);
+
+  /// Sets 'row' to the value parsed from 'text'.
+  void setText(vector_size_t row, std::string_view text);
+
+  void setBool(vector_size_t row, bool value);
+
+  void setInt(vector_size_t row, int64_t value);
+
+  void setDouble(vector_size_t row, double value);
+
+  /// Returns the vector built since reset().
+  VectorPtr finish() {
+    return std::move(vector_);
+  }
+
+  const TypePtr& type() const {
+    return type_;
+  }
+
+ private:
+  template <TypeKind kKind>
+  void setTextTyped(vector_size_t row, std::string_view text);
+
+  template <typename T>
+  void set(vector_size_t row, T value) {
+    vector_->asUnchecked<FlatVector<T>>()->set(row, value);
+  }
+
+  const TypePtr type_;
+  memory::MemoryPool* const pool_;
+  VectorPtr vector_;
+};
+
+} // namespace facebook::velox::text
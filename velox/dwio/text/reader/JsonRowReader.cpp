@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "velox/dwio/text/reader/TextRowReader.h"
+
+namespace facebook::velox::text {
+
+JsonRowReader::JsonRowReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& readerOptions,
+    const dwio::common::RowReaderOptions& options,
+    const RowTypePtr& fileType)
+    : TextRowReader(std::move(input), readerOptions, options, fileType) {
+  for (column_index_t i = 0; i < columns_.size(); ++i) {
+    if (columns_[i]) {
+      auto name = fileType_->nameOf(i);
+      std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+      columnIndices_.emplace(std::move(name), i);
+    }
+  }
+}
+
+void JsonRowReader::setValue(
+    ColumnBuilder& column,
+    vector_size_t row,
+    simdjson::dom::element value) {
+  switch (value.type()) {
+    case simdjson::dom::element_type::NULL_VALUE:
+      break;
+    case simdjson::dom::element_type::BOOL:
+      column.setBool(row, value.get_bool().value_unsafe());
+      break;
+    case simdjson::dom::element_type::INT64:
+      column.setInt(row, value.get_int64().value_unsafe());
+      break;
+    case simdjson::dom::element_type::UINT64:
+      column.setText(row, std::to_string(value.get_uint64().value_unsafe()));
+      break;
+    case simdjson::dom::element_type::DOUBLE:
+      column.setDouble(row, value.get_double().value_unsafe());
+      break;
+    case simdjson::dom::element_type::STRING:
+      column.setText(row, value.get_string().value_unsafe());
+      break;
+    case simdjson::dom::element_type::ARRAY:
+    case simdjson::dom::element_type::OBJECT:
+      column.setText(row, simdjson::minify(value));
+      break;
+  }
+}
+
+void JsonRowReader::parseLine(std::string_view line, vector_size_t row) {
+  if (line.find_first_not_of(" \t") == std::string_view::npos) {
+    return;
+  }
+  simdjson::dom::object object;
+  const auto error = parser_.parse(line.data(), line.size()).get(object);
+  VELOX_USER_CHECK(
+      !error,
+      "Line {} of the JSON file is not a valid JSON object: {}",
+      rowNumber_ + row,
+      simdjson::error_message(error));
+  for (const auto field : object) {
+    key_.assign(field.key.data(), field.key.size());
+    std::transform(key_.begin(), key_.end(), key_.begin(), ::tolower);
+    const auto it = columnIndices_.find(key_);
+    if (it != columnIndices_.end()) {
+      setValue(*columns_[it->second], row, field.value);
+    }
+  }
+}
+
+} // namespace facebook::velox::text
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/LineReader.h"
+
+#include <cstring>
+
+namespace facebook::velox::text {
+
+LineReader::LineReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    uint64_t start,
+    uint64_t length,
+    uint64_t loadQuantum)
+    : input_(std::move(input)),
+      fileSize_(input_->getInputStream()->getLength()),
+      end_(
+          length > fileSize_ - std::min(start, fileSize_) ? fileSize_
+                                                          : start + length),
+      loadQuantum_(loadQuantum),
+      // A split that does not start the file starts at the first line after
+      // its start. Its first byte is tested since it may end a line.
+      loadOffset_(start == 0 ? 0 : start - 1),
+      dataOffset_(loadOffset_),
+      skipPartialLine_(start != 0) {
+  VELOX_CHECK_GT(loadQuantum_, 0);
+  atEnd_ = start >= end_;
+}
+
+bool LineReader::next(std::string_view& line) {
+  if (lines_.empty() && !findLine()) {
+    return false;
+  }
+  const auto [begin, end] = lines_.front();
+  lines_.pop_front();
+  line = std::string_view(data_.data() + begin, end - begin);
+  return true;
+}
+
+uint64_t LineReader::numLinesAhead(uint64_t maxLines) {
+  while (lines_.size() < maxLines && findLine()) {
+  }
+  return std::min<uint64_t>(lines_.size(), maxLines);
+}
+
+bool LineReader::load() {
+  if (loadOffset_ >= fileSize_) {
+    return false;
+  }
+  const auto keep = lines_.empty() ? scanPos_ : lines_.front().first;
+  data_.erase(0, keep);
+  dataOffset_ += keep;
+  scanPos_ -= keep;
+  for (auto& line : lines_) {
+    line.first -= keep;
+    line.second -= keep;
+  }
+
+  const auto size = std::min(loadQuantum_, fileSize_ - loadOffset_);
+  auto stream = input_->enqueue({loadOffset_, size});
+  input_->load(dwio::common::LogType::STREAM);
+  data_.reserve(data_.size() + size);
+  const void* buffer;
+  int32_t bufferSize;
+  while (stream->Next(&buffer, &bufferSize)) {
+    data_.append(static_cast<const char*>(buffer), bufferSize);
+  }
+  loadOffset_ += size;
+  return true;
+}
+
+bool LineReader::skipPartialLine() {
+  skipPartialLine_ = false;
+  size_t searchPos = 0;
+  for (;;) {
+    const auto* newline = static_cast<const char*>(std::memchr(
+        data_.data() + searchPos, '\n', data_.size() - searchPos));
+    if (newline != nullptr) {
+      scanPos_ = newline - data_.data() + 1;
+      return true;
+    }
+    searchPos = data_.size();
+    if (!load()) {
+      return false;
+    }
+  }
+}
+
+bool LineReader::findLine() {
+  if (atEnd_) {
+    return false;
+  }
+  if (skipPartialLine_ && !skipPartialLine()) {
+    atEnd_ = true;
+    return false;
+  }
+  if (dataOffset_ + scanPos_ >= end_) {
+    atEnd_ = true;
+    return false;
+  }
+  // The file offset from which to search for the end of the line. 'data_'
+  // may move while loading.
+  auto searchOffset = dataOffset_ + scanPos_;
+  for (;;) {
+    const auto searchPos = searchOffset - dataOffset_;
+    const auto* newline = static_cast<const char*>(std::memchr(
+        data_.data() + searchPos, '\n', data_.size() - searchPos));
+    size_t lineEnd;
+    size_t next;
+    if (newline != nullptr) {
+      lineEnd = newline - data_.data();
+      next = lineEnd + 1;
+    } else {
+      searchOffset = dataOffset_ + data_.size();
+      if (load()) {
+        continue;
+      }
+      // The last line of the file may have no terminator.
+      if (scanPos_ == data_.size()) {
+        atEnd_ = true;
+        return false;
+      }
+      lineEnd = data_.size();
+      next = lineEnd;
+    }
+    if (lineEnd > scanPos_ && data_[lineEnd - 1] == '\r') {
+      --lineEnd;
+    }
+    lines_.emplace_back(scanPos_, lineEnd);
+    scanPos_ = next;
+    return true;
+  }
+}
+
+} // namespace facebook::velox::text
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <string_view>
+
+#include "velox/dwio/common/BufferedInput.h"
+
+namespace facebook::velox::text {
+
+/// Returns the lines of a split of a line-oriented text file. A line belongs to
+/// the split that contains its first byte. Lines end with '\n' or "\r\n". The
+/// file is read in ranges of 'loadQuantum' bytes through 'input', so that the
+/// ranges are cached if 'input' is backed by the AsyncDataCache.
+class LineReader {
+ public:
+  LineReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      uint64_t start,
+      uint64_t length,
+      uint64_t loadQuantum);
+
+  /// Sets 'line' to the next line of the split without its terminator and
+  /// returns true. Returns false at the end of the split. 'line' is valid
+  /// until the next call to next() or numLinesAhead().
+  bool next(std::string_view& line);
+
+  /// Returns how many of the next 'maxLines' lines are in the split. The
+  /// lines returned by the next as many calls to next() are all valid until
+  /// the following call.
+  uint64_t numLinesAhead(uint64_t maxLines);
+
+ private:
+  // Appends the next range of the file to 'data_' after dropping the bytes of
+  // the lines already returned. Returns false at the end of the file.
+  bool load();
+
+  // Adds the next line of the split to 'lines_'. Returns false at the end of
+  // the split.
+  bool findLine();
+
+  // Drops the partial line before the split start. Returns false if the
+  // split has no line.
+  bool skipPartialLine();
+
+  const std::unique_ptr<dwio::common::BufferedInput> input_;
+  const uint64_t fileSize_;
+  // The end of the split. A line that starts at or after this offset belongs
+  // to the next split.
+  const uint64_t end_;
+  const uint64_t loadQuantum_;
+
+  // The file offset of the next range to load.
+  uint64_t loadOffset_;
+  // The loaded bytes that are not returned yet. 'data_[0]' is at file offset
+  // 'dataOffset_'.
+  std::string data_;
+  uint64_t dataOffset_;
+  // The position in 'data_' after the last line found.
+  size_t scanPos_{0};
+  // The lines found and not returned yet as [begin, end) in 'data_'.
+  std::deque<std::pair<size_t, size_t>> lines_;
+  // True until the partial line before a split start is skipped.
+  bool skipPartialLine_;
+  bool atEnd_{false};
+};
+
+} // namespace facebook::velox::text
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include "velox/dwio/text/reader/TextRowReader.h"
+
+namespace facebook::velox::text {
+
+using dwio::common::FileFormat;
+
+TextReader::TextReader(
+    FileFormat format,
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options)
+    : format_(format),
+      options_(options),
+      input_(std::move(input)),
+      rowType_(options.fileSchema()),
+      typeWithId_(
+          rowType_ ? dwio::common::TypeWithId::create(rowType_) : nullptr) {
+  VELOX_CHECK(format_ == FileFormat::TEXT || format_ == FileFormat::JSON);
+  VELOX_USER_CHECK_NOT_NULL(
+      rowType_,
+      "Reading a {} file requires a file schema: {}",
+      dwio::common::toString(format_),
+      input_->getName());
+}
+
+std::unique_ptr<dwio::common::RowReader> TextReader::createRowReader(
+    const dwio::common::RowReaderOptions& options) const {
+  if (format_ == FileFormat::JSON) {
+    return std::make_unique<JsonRowReader>(
+        input_->clone(), options_, options, rowType_);
+  }
+  return std::make_unique<DelimitedRowReader>(
+      input_->clone(), options_, options, rowType_);
+}
+
+TextReaderFactory::TextReaderFactory(FileFormat format)
+    : ReaderFactory(format) {
+  VELOX_CHECK(format == FileFormat::TEXT || format == FileFormat::JSON);
+}
+
+void registerTextReaderFactories() {
+  dwio::common::registerReaderFactory(
+      std::make_shared<TextReaderFactory>(FileFormat::TEXT));
+  dwio::common::registerReaderFactory(
+      std::make_shared<TextReaderFactory>(FileFormat::JSON));
+}
+
+void unregisterTextReaderFactories() {
+  dwio::common::unregisterReaderFactory(FileFormat::TEXT);
+  dwio::common::unregisterReaderFactory(FileFormat::JSON);
+}
+
+} // namespace facebook::velox::text
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::text {
+
+/// Reads text files of the following formats, one row per line:
+///
+/// - TEXT: Hive TEXTFILE. The fields of a row are separated by the first of
+///   the SerDeOptions separators and match the file schema by position.
+/// - JSON: JSON lines. A row is a JSON object whose keys match the file schema
+///   by lowercase name.
+///
+/// The files have no schema and no statistics. The schema is the file schema
+/// of the ReaderOptions. Only columns of scalar types can be read.
+class TextReader : public dwio::common::Reader {
+ public:
+  TextReader(
+      dwio::common::FileFormat format,
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options);
+
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const RowTypePtr& rowType() const override {
+    return rowType_;
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+ private:
+  const dwio::common::FileFormat format_;
+  const dwio::common::ReaderOptions options_;
+  const std::unique_ptr<dwio::common::BufferedInput> input_;
+  const RowTypePtr rowType_;
+  const std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+};
+
+class TextReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  /// 'format' is TEXT or JSON.
+  explicit TextReaderFactory(dwio::common::FileFormat format);
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<TextReader>(
+        fileFormat(), std::move(input), options);
+  }
+};
+
+/// Registers the reader factories of the TEXT and JSON formats.
+void registerTextReaderFactories();
+
+void unregisterTextReaderFactories();
+
+} // namespace facebook::velox::text
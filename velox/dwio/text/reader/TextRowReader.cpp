@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextRowReader.h"
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/dwio/common/ScanSpec.h"
+
+namespace facebook::velox::text {
+
+TextRowReader::TextRowReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& readerOptions,
+    const dwio::common::RowReaderOptions& options,
+    const RowTypePtr& fileType)
+    : readerOptions_(readerOptions),
+      options_(options),
+      fileType_(fileType),
+      columns_(fileType_->size()),
+      pool_(readerOptions.memoryPool()),
+      lineReader_(
+          std::move(input),
+          options.getOffset(),
+          options.getLength(),
+          readerOptions.loadQuantum()),
+      headerLinesToSkip_(options.getOffset() == 0 ? options.getSkipRows() : 0) {
+  VELOX_CHECK_NOT_NULL(options_.getScanSpec());
+  VELOX_USER_CHECK(
+      !options_.getRowNumberColumnInfo().has_value(),
+      "Row number columns are not supported for text files");
+  for (const auto& childSpec : options_.getScanSpec()->children()) {
+    if (childSpec->isConstant()) {
+      continue;
+    }
+    const auto index = fileType_->getChildIdxIfExists(childSpec->fieldName());
+    VELOX_USER_CHECK(
+        index.has_value(),
+        "Column not found in the text file schema: {}",
+        childSpec->fieldName());
+    columns_[*index] = std::make_unique<ColumnBuilder>(
+        fileType_->childAt(*index), &pool_);
+  }
+}
+
+void TextRowReader::skipHeader() {
+  std::string_view line;
+  while (headerLinesToSkip_ > 0 && lineReader_.next(line)) {
+    --headerLinesToSkip_;
+  }
+  headerLinesToSkip_ = 0;
+}
+
+uint64_t TextRowReader::next(
+    uint64_t size,
+    VectorPtr& result,
+    const dwio::common::Mutation* mutation) {
+  skipHeader();
+  const vector_size_t numRows = lineReader_.numLinesAhead(size);
+  if (numRows == 0) {
+    return 0;
+  }
+  for (auto& column : columns_) {
+    if (column) {
+      column->reset(numRows);
+    }
+  }
+  std::string_view line;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    VELOX_CHECK(lineReader_.next(line));
+    parseLine(line, row);
+  }
+  std::vector<VectorPtr> children(columns_.size());
+  for (column_index_t i = 0; i < columns_.size(); ++i) {
+    children[i] = columns_[i] ? columns_[i]->finish()
+                              : BaseVector::createNullConstant(
+                                    fileType_->childAt(i), numRows, &pool_);
+  }
+  auto rows = std::make_shared<RowVector>(
+      &pool_, fileType_, nullptr, numRows, std::move(children));
+  result = projectColumns(rows, *options_.getScanSpec(), mutation);
+  rowNumber_ += numRows;
+  return numRows;
+}
+
+int64_t TextRowReader::nextRowNumber() {
+  skipHeader();
+  return lineReader_.numLinesAhead(1) > 0 ? rowNumber_ : kAtEnd;
+}
+
+int64_t TextRowReader::nextReadSize(uint64_t size) {
+  skipHeader();
+  const auto numRows = lineReader_.numLinesAhead(size);
+  return numRows > 0 ? numRows : kAtEnd;
+}
+
+DelimitedRowReader::DelimitedRowReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& readerOptions,
+    const dwio::common::RowReaderOptions& options,
+    const RowTypePtr& fileType)
+    : TextRowReader(std::move(input), readerOptions, options, fileType),
+      serDeOptions_(readerOptions_.serDeOptions()),
+      delimiter_(static_cast<char>(serDeOptions_.separators[0])) {
+  for (column_index_t i = 0; i < columns_.size(); ++i) {
+    if (columns_[i]) {
+      numFields_ = i + 1;
+    }
+  }
+}
+
+size_t DelimitedRowReader::findFieldEnd(std::string_view line, size_t begin)
+    const {
+  auto i = begin;
+  if (serDeOptions_.isEscaped) {
+    const auto escape = static_cast<char>(serDeOptions_.escapeChar);
+    for (; i < line.size(); ++i) {
+      if (line[i] == escape) {
+        ++i;
+      } else if (line[i] == delimiter_) {
+        return i;
+      }
+    }
+    return line.size();
+  }
+  using Batch = xsimd::batch<int8_t>;
+  const auto delimiters = Batch::broadcast(delimiter_);
+  for (; i + Batch::size <= line.size(); i += Batch::size) {
+    const auto bits = simd::toBitMask(
+        Batch::load_unaligned(
+            reinterpret_cast<const int8_t*>(line.data() + i)) == delimiters);
+    if (bits) {
+      return i + __builtin_ctz(bits);
+    }
+  }
+  for (; i < line.size(); ++i) {
+    if (line[i] == delimiter_) {
+      return i;
+    }
+  }
+  return line.size();
+}
+
+void DelimitedRowReader::setField(
+    column_index_t column,
+    vector_size_t row,
+    std::string_view text) {
+  if (!columns_[column] || text == serDeOptions_.nullString) {
+    return;
+  }
+  if (serDeOptions_.isEscaped) {
+    const auto escape = static_cast<char>(serDeOptions_.escapeChar);
+    if (text.find(escape) != std::string_view::npos) {
+      unescaped_.clear();
+      for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == escape && i + 1 < text.size()) {
+          ++i;
+        }
+        unescaped_.push_back(text[i]);
+      }
+      text = unescaped_;
+    }
+  }
+  columns_[column]->setText(row, text);
+}
+
+void DelimitedRowReader::parseLine(std::string_view line, vector_size_t row) {
+  const auto lastColumn = fileType_->size() - 1;
+  size_t begin = 0;
+  for (column_index_t i = 0; i < numFields_; ++i) {
+    const auto end = i == lastColumn && serDeOptions_.lastColumnTakesRest
+        ? line.size()
+        : findFieldEnd(line, begin);
+    setField(i, row, line.substr(begin, end - begin));
+    if (end == line.size()) {
+      break;
+    }
+    begin = end + 1;
+  }
+}
+
+} // namespace facebook::velox::text
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#if __has_include("simdjson/singleheader/simdjson.h")
+#include "simdjson/singleheader/simdjson.h"
+#else
+#include "simdjson.h"
+#endif
+
+#include "velox/dwio/common/Options.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/text/reader/ColumnBuilder.h"
+#include "velox/dwio/text/reader/LineReader.h"
+
+namespace facebook::velox::text {
+
+/// Reads the rows of a split of a text file with one row per line. Only the
+/// file columns read by the ScanSpec are parsed. The filters, constants and
+/// projection of the ScanSpec are applied to the parsed rows like in the other
+/// non-selective readers. Row numbers are relative to the start of the split
+/// since the lines before the split are not read.
+class TextRowReader : public dwio::common::RowReader {
+ public:
+  TextRowReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& readerOptions,
+      const dwio::common::RowReaderOptions& options,
+      const RowTypePtr& fileType);
+
+  uint64_t next(
+      uint64_t size,
+      VectorPtr& result,
+      const dwio::common::Mutation* mutation = nullptr) override;
+
+  int64_t nextRowNumber() override;
+
+  int64_t nextReadSize(uint64_t size) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& /*stats*/) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override {
+    return std::nullopt;
+  }
+
+ protected:
+  /// Sets the values of 'row' in 'columns_' from 'line'. The values that are
+  /// not set are null.
+  virtual void parseLine(std::string_view line, vector_size_t row) = 0;
+
+  const dwio::common::ReaderOptions readerOptions_;
+  const dwio::common::RowReaderOptions options_;
+  const RowTypePtr fileType_;
+  // Builders of the file columns that are read, by position in 'fileType_'.
+  // nullptr for the columns that are not read.
+  std::vector<std::unique_ptr<ColumnBuilder>> columns_;
+  // The number of rows returned so far.
+  int64_t rowNumber_{0};
+
+ private:
+  // Skips the header lines before the first row of the file.
+  void skipHeader();
+
+  memory::MemoryPool& pool_;
+  LineReader lineReader_;
+  uint64_t headerLinesToSkip_;
+};
+
+/// Reads Hive TEXTFILE. The fields of a line are separated by the field
+/// delimiter of the SerDeOptions and assigned to the file columns by position.
+/// Missing trailing fields are null, as are the fields equal to the null
+/// string.
+class DelimitedRowReader : public TextRowReader {
+ public:
+  DelimitedRowReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& readerOptions,
+      const dwio::common::RowReaderOptions& options,
+      const RowTypePtr& fileType);
+
+ protected:
+  void parseLine(std::string_view line, vector_size_t row) override;
+
+ private:
+  // Returns the position of the delimiter that ends the field starting at
+  // 'begin', or the size of 'line' for the last field.
+  size_t findFieldEnd(std::string_view line, size_t begin) const;
+
+  // Sets 'row' of 'column' from the text of a field.
+  void
+  setField(column_index_t column, vector_size_t row, std::string_view text);
+
+  const dwio::common::SerDeOptions& serDeOptions_;
+  const char delimiter_;
+  // The number of leading fields to split. The fields after the last column
+  // that is read are not looked at.
+  column_index_t numFields_{0};
+  // A buffer for unescaping a field.
+  std::string unescaped_;
+};
+
+/// Reads JSON lines. Each line is an object whose keys are matched to the file
+/// columns by lowercase name. Keys that are not columns are ignored and the
+/// columns that are not keys are null. Nested arrays and objects are read as
+/// their JSON text.
+class JsonRowReader : public TextRowReader {
+ public:
+  JsonRowReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& readerOptions,
+      const dwio::common::RowReaderOptions& options,
+      const RowTypePtr& fileType);
+
+ protected:
+  void parseLine(std::string_view line, vector_size_t row) override;
+
+ private:
+  void setValue(
+      ColumnBuilder& column,
+      vector_size_t row,
+      simdjson::dom::element value);
+
+  simdjson::dom::parser parser_;
+  // The columns that are read by lowercase name.
+  folly::F14FastMap<std::string, column_index_t> columnIndices_;
+  // A buffer for lowercasing a key.
+  std::string key_;
+};
+
+} // namespace facebook::velox::text
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/ColumnSelector.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/dwio/text/reader/TextReader.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+constexpr int32_t kNumRows = 1'000'000;
+constexpr int32_t kBatchSize = 10'000;
+
+// Writes the same rows as TEXT, JSON and DWRF files and reads them with and
+// without a filter.
+class TextReaderBenchmark {
+ public:
+  TextReaderBenchmark()
+      : rootPool_(memory::memoryManager()->addRootPool("TextReaderBenchmark")),
+        pool_(rootPool_->addLeafChild("leaf")),
+        rowType_(ROW({"c0", "c1", "c2"}, {BIGINT(), DOUBLE(), VARCHAR()})) {
+    auto c0 = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), kNumRows, pool_.get());
+    auto c1 = BaseVector::create<FlatVector<double>>(
+        DOUBLE(), kNumRows, pool_.get());
+    auto c2 = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), kNumRows, pool_.get());
+    std::ofstream text(textFile_->getPath(), std::ios::binary);
+    std::ofstream json(jsonFile_->getPath(), std::ios::binary);
+    for (auto i = 0; i < kNumRows; ++i) {
+      const int64_t key = i * 7919 % kNumRows;
+      const double value = i / 8.0;
+      const auto name = fmt::format("name_{}", i % 1'000);
+      c0->set(i, key);
+      c1->set(i, value);
+      c2->set(i, StringView(name));
+      text << fmt::format("{}\1{}\1{}\n", key, value, name);
+      json << fmt::format(
+          "{{\"c0\":{},\"c1\":{},\"c2\":\"{}\"}}\n", key, value, name);
+    }
+    writeDwrf(std::make_shared<RowVector>(
+        pool_.get(),
+        rowType_,
+        nullptr,
+        kNumRows,
+        std::vector<VectorPtr>{c0, c1, c2}));
+  }
+
+  // Reads all the rows of the file of 'format'. If 'filter' is true, only
+  // reads c2 of the rows with c0 < 1% of the rows.
+  void read(FileFormat format, bool filter) {
+    const auto& path = format == FileFormat::DWRF ? dwrfFile_->getPath()
+        : format == FileFormat::JSON              ? jsonFile_->getPath()
+                                                  : textFile_->getPath();
+    ReaderOptions readerOptions(pool_.get());
+    readerOptions.setFileFormat(format);
+    readerOptions.setFileSchema(rowType_);
+    auto reader = getReaderFactory(format)->createReader(
+        std::make_unique<BufferedInput>(
+            std::make_shared<LocalReadFile>(path), *pool_),
+        readerOptions);
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    if (filter) {
+      spec->addField("c2", 0);
+      spec->addField("c0", 1)->setProjectOut(false);
+      spec->childByName("c0")->setFilter(
+          std::make_unique<common::BigintRange>(0, kNumRows / 100, false));
+    } else {
+      spec->addAllChildFields(*rowType_);
+    }
+    RowReaderOptions options;
+    options.setScanSpec(spec);
+    options.select(std::make_shared<ColumnSelector>(rowType_));
+    auto rowReader = reader->createRowReader(options);
+    VectorPtr result;
+    uint64_t numRows = 0;
+    while (rowReader->next(kBatchSize, result) > 0) {
+      numRows += result->size();
+    }
+    folly::doNotOptimizeAway(numRows);
+  }
+
+ private:
+  void writeDwrf(const RowVectorPtr& rows) {
+    dwrf::WriterOptions options;
+    options.schema = rowType_;
+    auto writerPool = rootPool_->addAggregateChild("writer");
+    options.memoryPool = writerPool.get();
+    dwrf::Writer writer{
+        std::make_unique<WriteFileSink>(
+            std::make_unique<LocalWriteFile>(dwrfFile_->getPath(), true, false),
+            dwrfFile_->getPath()),
+        options};
+    writer.write(rows);
+    writer.close();
+  }
+
+  const std::shared_ptr<memory::MemoryPool> rootPool_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const RowTypePtr rowType_;
+  const std::shared_ptr<exec::test::TempFilePath> textFile_{
+      exec::test::TempFilePath::create()};
+  const std::shared_ptr<exec::test::TempFilePath> jsonFile_{
+      exec::test::TempFilePath::create()};
+  const std::shared_ptr<exec::test::TempFilePath> dwrfFile_{
+      exec::test::TempFilePath::create()};
+};
+
+std::unique_ptr<TextReaderBenchmark> benchmark;
+
+BENCHMARK(dwrfScan) {
+  benchmark->read(FileFormat::DWRF, false);
+}
+
+BENCHMARK_RELATIVE(textScan) {
+  benchmark->read(FileFormat::TEXT, false);
+}
+
+BENCHMARK_RELATIVE(jsonScan) {
+  benchmark->read(FileFormat::JSON, false);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(dwrfFilter) {
+  benchmark->read(FileFormat::DWRF, true);
+}
+
+BENCHMARK_RELATIVE(textFilter) {
+  benchmark->read(FileFormat::TEXT, true);
+}
+
+BENCHMARK_RELATIVE(jsonFilter) {
+  benchmark->read(FileFormat::JSON, true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  dwrf::registerDwrfReaderFactory();
+  text::registerTextReaderFactories();
+  benchmark = std::make_unique<TextReaderBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/text/reader/TextReader.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+class TextReaderTest : public testing::Test, public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+    text::registerTextReaderFactories();
+  }
+
+  static void TearDownTestCase() {
+    text::unregisterTextReaderFactories();
+  }
+
+  std::shared_ptr<exec::test::TempFilePath> writeFile(
+      const std::string& content) {
+    auto file = exec::test::TempFilePath::create();
+    std::ofstream out(file->getPath(), std::ios::binary);
+    out << content;
+    return file;
+  }
+
+  // Creates a row reader of the range [offset, offset + length) of 'path'.
+  // 'spec' reads all the columns of 'fileType' if not set.
+  std::unique_ptr<RowReader> makeRowReader(
+      const std::string& path,
+      FileFormat format,
+      const RowTypePtr& fileType,
+      std::shared_ptr<common::ScanSpec> spec = nullptr,
+      const SerDeOptions& serDeOptions = SerDeOptions(','),
+      uint64_t offset = 0,
+      uint64_t length = std::numeric_limits<uint64_t>::max(),
+      uint64_t skipRows = 0) {
+    if (!spec) {
+      spec = std::make_shared<common::ScanSpec>("<root>");
+      spec->addAllChildFields(*fileType);
+    }
+    ReaderOptions readerOptions(pool());
+    readerOptions.setFileSchema(fileType);
+    readerOptions.setSerDeOptions(serDeOptions);
+    // A small load quantum makes lines span loads.
+    readerOptions.setLoadQuantum(64);
+    auto reader = getReaderFactory(format)->createReader(
+        std::make_unique<BufferedInput>(
+            std::make_shared<LocalReadFile>(path), *pool()),
+        readerOptions);
+    RowReaderOptions options;
+    options.setScanSpec(spec);
+    options.range(offset, length);
+    options.setSkipRows(skipRows);
+    return reader->createRowReader(options);
+  }
+
+  RowVectorPtr readAll(RowReader& reader, uint64_t batchSize = 7) {
+    RowVectorPtr all;
+    VectorPtr batch;
+    while (reader.next(batchSize, batch) > 0) {
+      if (!all) {
+        all = BaseVector::create<RowVector>(batch->type(), 0, pool());
+      }
+      const auto offset = all->size();
+      all->resize(offset + batch->size());
+      all->copy(batch.get(), offset, 0, batch->size());
+    }
+    EXPECT_EQ(reader.nextReadSize(batchSize), RowReader::kAtEnd);
+    return all;
+  }
+};
+
+TEST_F(TextReaderTest, delimited) {
+  auto file = writeFile("1,a,1.5,true\n2,b,\\N,false\r\n3,,x\n4\n");
+  auto fileType = ROW(
+      {"c0", "c1", "c2", "c3"}, {BIGINT(), VARCHAR(), DOUBLE(), BOOLEAN()});
+  auto rowReader = makeRowReader(file->getPath(), FileFormat::TEXT, fileType);
+  auto expected = makeRowVector(
+      fileType->names(),
+      {makeFlatVector<int64_t>({1, 2, 3, 4}),
+       makeNullableFlatVector<StringView>({"a", "b", "", std::nullopt}),
+       makeNullableFlatVector<double>(
+           {1.5, std::nullopt, std::nullopt, std::nullopt}),
+       makeNullableFlatVector<bool>(
+           {true, false, std::nullopt, std::nullopt})});
+  test::assertEqualVectors(expected, readAll(*rowReader));
+}
+
+TEST_F(TextReaderTest, projectionAndFilter) {
+  std::string content;
+  for (auto i = 0; i < 100; ++i) {
+    content += fmt::format("{}|{}|the quick brown fox {}\n", i, i % 7, i);
+  }
+  auto file = writeFile(content);
+  auto fileType = ROW({"c0", "c1", "c2"}, {BIGINT(), INTEGER(), VARCHAR()});
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addField("c2", 0);
+  spec->addField("c1", 1)->setProjectOut(false);
+  spec->childByName("c1")->setFilter(
+      std::make_unique<common::BigintRange>(3, 3, false));
+  auto rowReader = makeRowReader(
+      file->getPath(), FileFormat::TEXT, fileType, spec, SerDeOptions('|'));
+  std::vector<std::string> strings;
+  for (auto i = 3; i < 100; i += 7) {
+    strings.push_back(fmt::format("the quick brown fox {}", i));
+  }
+  auto expected = makeRowVector({"c2"}, {makeFlatVector(strings)});
+  test::assertEqualVectors(expected, readAll(*rowReader));
+}
+
+TEST_F(TextReaderTest, splits) {
+  std::string content;
+  for (auto i = 0; i < 1'000; ++i) {
+    content += fmt::format("{}\t{}\n", i, std::string(i % 13, 'x'));
+  }
+  auto file = writeFile(content);
+  auto fileType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  SerDeOptions serDeOptions('\t');
+  for (uint64_t splitSize : {1, 100, 1'000, 3'333, 1'000'000}) {
+    SCOPED_TRACE(fmt::format("splitSize {}", splitSize));
+    std::vector<int64_t> values;
+    for (uint64_t offset = 0; offset < content.size(); offset += splitSize) {
+      auto rowReader = makeRowReader(
+          file->getPath(),
+          FileFormat::TEXT,
+          fileType,
+          nullptr,
+          serDeOptions,
+          offset,
+          splitSize);
+      if (auto rows = readAll(*rowReader, 100)) {
+        auto* c0 = rows->childAt(0)->asFlatVector<int64_t>();
+        for (auto i = 0; i < rows->size(); ++i) {
+          values.push_back(c0->valueAt(i));
+        }
+      }
+    }
+    ASSERT_EQ(values.size(), 1'000);
+    for (auto i = 0; i < values.size(); ++i) {
+      ASSERT_EQ(values[i], i);
+    }
+  }
+}
+
+TEST_F(TextReaderTest, headerAndSerDeOptions) {
+  auto file = writeFile("k,v\n1,a\\,b,c\nNULL,d\n");
+  auto fileType = ROW({"k", "v"}, {INTEGER(), VARCHAR()});
+  SerDeOptions serDeOptions(',');
+  serDeOptions.nullString = "NULL";
+  serDeOptions.isEscaped = true;
+  auto rowReader = makeRowReader(
+      file->getPath(),
+      FileFormat::TEXT,
+      fileType,
+      nullptr,
+      serDeOptions,
+      0,
+      std::numeric_limits<uint64_t>::max(),
+      1);
+  auto expected = makeRowVector(
+      fileType->names(),
+      {makeNullableFlatVector<int32_t>({1, std::nullopt}),
+       makeFlatVector<StringView>({"a,b", "d"})});
+  test::assertEqualVectors(expected, readAll(*rowReader));
+
+  serDeOptions.isEscaped = false;
+  serDeOptions.lastColumnTakesRest = true;
+  rowReader = makeRowReader(
+      file->getPath(),
+      FileFormat::TEXT,
+      fileType,
+      nullptr,
+      serDeOptions,
+      0,
+      std::numeric_limits<uint64_t>::max(),
+      1);
+  expected = makeRowVector(
+      fileType->names(),
+      {makeNullableFlatVector<int32_t>({1, std::nullopt}),
+       makeFlatVector<StringView>({"a\\,b,c", "d"})});
+  test::assertEqualVectors(expected, readAll(*rowReader));
+}
+
+TEST_F(TextReaderTest, jsonLines) {
+  auto file = writeFile(
+      "{\"C0\": 1, \"c1\": \"a\", \"c2\": 2.5, \"extra\": [1]}\n"
+      "{\"c1\": {\"x\": [1, 2]}, \"c2\": 3, \"c3\": \"2024-01-02\"}\n"
+      "\n"
+      "{\"c0\": null, \"c1\": true, \"c2\": \"abc\"}\n");
+  auto fileType =
+      ROW({"c0", "c1", "c2", "c3"}, {BIGINT(), VARCHAR(), DOUBLE(), DATE()});
+  auto rowReader = makeRowReader(file->getPath(), FileFormat::JSON, fileType);
+  auto expected = makeRowVector(
+      fileType->names(),
+      {makeNullableFlatVector<int64_t>(
+           {1, std::nullopt, std::nullopt, std::nullopt}),
+       makeNullableFlatVector<StringView>(
+           {"a", "{\"x\":[1,2]}", std::nullopt, "true"}),
+       makeNullableFlatVector<double>({2.5, 3, std::nullopt, std::nullopt}),
+       makeNullableFlatVector<int32_t>(
+           {std::nullopt, 19724, std::nullopt, std::nullopt}, DATE())});
+  test::assertEqualVectors(expected, readAll(*rowReader));
+
+  file = writeFile("{\"c0\": 1}\n[1, 2]\n");
+  rowReader = makeRowReader(file->getPath(), FileFormat::JSON, fileType);
+  VELOX_ASSERT_THROW(
+      readAll(*rowReader),
+      "Line 1 of the JSON file is not a valid JSON object");
+}
+
+TEST_F(TextReaderTest, unsupported) {
+  auto file = writeFile("1\n");
+  VELOX_ASSERT_THROW(
+      makeRowReader(
+          file->getPath(), FileFormat::TEXT, ROW({"c0"}, {ARRAY(BIGINT())})),
+      "Text files do not support columns of type ARRAY<BIGINT>");
+
+  ReaderOptions readerOptions(pool());
+  VELOX_ASSERT_THROW(
+      getReaderFactory(FileFormat::JSON)
+          ->createReader(
+              std::make_unique<BufferedInput>(
+                  std::make_shared<LocalReadFile>(file->getPath()), *pool()),
+              readerOptions),
+      "Reading a json file requires a file schema");
+}
+
+} // namespace
@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+
+#include <numeric>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -28,7 +31,9 @@ namespace {
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
-// to frameEnd boundaries at that row using singleGroup.
+// to frameEnd boundaries at that row using singleGroup. Frames with a fixed
+// start are aggregated incrementally. Other frames combine the intermediate
+// states of a segment tree over the rows of the output block.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -39,7 +44,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
       velox::memory::MemoryPool* pool,
       HashStringAllocator* stringAllocator,
       const core::QueryConfig& config)
-      : WindowFunction(resultType, pool, stringAllocator) {
+      : WindowFunction(resultType, pool, stringAllocator),
+        segmentTreeEnabled_(config.windowAggregateSegmentTreeEnabled()) {
     VELOX_USER_CHECK(
         !ignoreNulls, "Aggregate window functions do not support IGNORE NULLS");
     argTypes_.reserve(args.size());
@@ -90,6 +96,11 @@ class AggregateWindowFunction : public exec::WindowFunction {
         exec::RowContainer::initializedMask(kAccumulatorFlagsOffset),
         /* needed for out of line allocations */ kRowSizeOffset);
     singleGroupRowSize_ += aggregate_->accumulatorFixedWidthSize();
+    groupRowStride_ = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    if (segmentTreeEnabled_) {
+      intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
+    }
 
     // Construct the single row in the MemoryPool.
     singleGroupRowBufferPtr_ =
@@ -163,6 +174,16 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (segmentTreeEnabled_) {
+      fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
+      segmentTreeAggregation(
+          validRows,
+          frameMetadata.firstRow,
+          frameMetadata.lastRow,
+          rawFrameStarts,
+          rawFrameEnds,
+          resultOffset,
+          result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -345,6 +366,223 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Computes the aggregates of frames that do not share a start. Builds a
+  // segment tree over the rows [minFrame, maxFrame] of the block. A node of
+  // level 0 holds the intermediate state of kFanout consecutive rows and a
+  // node of level i + 1 combines kFanout consecutive nodes of level i. A frame
+  // of k rows then combines at most 2 * (kFanout - 1) nodes or rows per level,
+  // i.e. O(log k) intermediate states, instead of aggregating all its rows.
+  // The rows and nodes of a frame are added in their order in the partition,
+  // so that order sensitive aggregates see the rows in order.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    aggregate_->clear();
+    buildSegmentTree(maxFrame + 1 - minFrame);
+
+    const auto numFrames = validRows.countSelected();
+    auto* frameGroups = allocateGroups(numFrames, frameGroupsBuffer_);
+    frameGroups_.resize(numFrames);
+    for (auto i = 0; i < numFrames; ++i) {
+      frameGroups_[i] = frameGroups + i * groupRowStride_;
+    }
+    initializeGroups(frameGroups_);
+
+    leftRows_.clear();
+    leftRowGroups_.clear();
+    frameNodes_.clear();
+    frameNodeGroups_.clear();
+    rightRows_.clear();
+    rightRowGroups_.clear();
+    vector_size_t frame = 0;
+    validRows.applyToSelected([&](auto i) {
+      addFrame(
+          frameGroups_[frame++],
+          frameStartsVector[i] - minFrame,
+          frameEndsVector[i] - minFrame + 1);
+    });
+
+    // The rows before the first node of each frame, then the nodes, then the
+    // rows after the last node.
+    addRows(leftRows_, leftRowGroups_);
+    if (!frameNodes_.empty()) {
+      std::vector<VectorPtr> intermediate = {BaseVector::create(
+          intermediateType_, frameNodes_.size(), pool_)};
+      aggregate_->extractAccumulators(
+          frameNodes_.data(), frameNodes_.size(), &intermediate[0]);
+      SelectivityVector rows(frameNodes_.size());
+      aggregate_->addIntermediateResults(
+          frameNodeGroups_.data(), rows, intermediate, false);
+    }
+    addRows(rightRows_, rightRowGroups_);
+
+    if (!frameResults_) {
+      frameResults_ = BaseVector::create(result->type(), numFrames, pool_);
+    } else {
+      BaseVector::prepareForReuse(frameResults_, numFrames);
+    }
+    aggregate_->extractValues(frameGroups_.data(), numFrames, &frameResults_);
+    copyRanges_.clear();
+    frame = 0;
+    validRows.applyToSelected([&](auto i) {
+      copyRanges_.push_back({frame++, resultOffset + i, 1});
+    });
+    result->copyRanges(frameResults_.get(), copyRanges_);
+
+    aggregate_->destroy(folly::Range(frameGroups_.data(), numFrames));
+    for (auto& level : treeLevels_) {
+      aggregate_->destroy(folly::Range(level.data(), level.size()));
+    }
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
+  // Builds 'treeLevels_' over the first 'numRows' rows of 'argVectors_'. A
+  // level only has nodes that cover kFanout nodes or rows of the level below.
+  void buildSegmentTree(vector_size_t numRows) {
+    vector_size_t numNodes = 0;
+    treeLevels_.clear();
+    for (auto size = numRows / kFanout; size > 0; size /= kFanout) {
+      treeLevels_.emplace_back(size);
+      numNodes += size;
+    }
+    if (numNodes == 0) {
+      return;
+    }
+    auto* nodes = allocateGroups(numNodes, treeBuffer_);
+    for (auto& level : treeLevels_) {
+      for (auto& node : level) {
+        node = nodes;
+        nodes += groupRowStride_;
+      }
+      initializeGroups(level);
+    }
+
+    const auto& leaves = treeLevels_[0];
+    std::vector<char*> groups(leaves.size() * kFanout);
+    for (auto i = 0; i < groups.size(); ++i) {
+      groups[i] = leaves[i / kFanout];
+    }
+    SelectivityVector rows(groups.size());
+    aggregate_->addRawInput(groups.data(), rows, argVectors_, false);
+
+    for (auto level = 1; level < treeLevels_.size(); ++level) {
+      auto& children = treeLevels_[level - 1];
+      const auto& parents = treeLevels_[level];
+      const auto numChildren = parents.size() * kFanout;
+      groups.resize(numChildren);
+      for (auto i = 0; i < numChildren; ++i) {
+        groups[i] = parents[i / kFanout];
+      }
+      std::vector<VectorPtr> intermediate = {
+          BaseVector::create(intermediateType_, numChildren, pool_)};
+      aggregate_->extractAccumulators(
+          children.data(), numChildren, &intermediate[0]);
+      rows.resize(numChildren);
+      aggregate_->addIntermediateResults(
+          groups.data(), rows, intermediate, false);
+    }
+  }
+
+  // Adds the rows and nodes that cover the rows [begin, end) of the segment
+  // tree to 'group'. The rows before the first node go to 'leftRows_', the
+  // nodes to 'frameNodes_' and the rows after the last node to 'rightRows_'.
+  void addFrame(char* group, vector_size_t begin, vector_size_t end) {
+    // The [begin, end) ranges of the nodes after the last node of their
+    // level, by level. These are added after the nodes of the higher levels.
+    rightRanges_.clear();
+    // -1 is the level of the rows.
+    int32_t level = -1;
+    while (begin < end) {
+      const vector_size_t parentBegin = bits::roundUp(begin, kFanout);
+      const auto parentEnd = end / kFanout * kFanout;
+      if (level + 1 == treeLevels_.size() || parentBegin >= parentEnd) {
+        addUnits(group, level, begin, end, false);
+        break;
+      }
+      addUnits(group, level, begin, parentBegin, false);
+      rightRanges_.push_back({parentEnd, end});
+      begin = parentBegin / kFanout;
+      end = parentEnd / kFanout;
+      ++level;
+    }
+    for (auto i = rightRanges_.size(); i-- > 0;) {
+      addUnits(
+          group,
+          static_cast<int32_t>(i) - 1,
+          rightRanges_[i].first,
+          rightRanges_[i].second,
+          true);
+    }
+  }
+
+  // Adds the rows or nodes [begin, end) of 'level' to 'group'. Level -1 is
+  // the rows. 'right' is true for the rows after the last node of a frame.
+  void addUnits(
+      char* group,
+      int32_t level,
+      vector_size_t begin,
+      vector_size_t end,
+      bool right) {
+    if (level >= 0) {
+      for (auto i = begin; i < end; ++i) {
+        frameNodes_.push_back(treeLevels_[level][i]);
+        frameNodeGroups_.push_back(group);
+      }
+      return;
+    }
+    auto& rows = right ? rightRows_ : leftRows_;
+    auto& groups = right ? rightRowGroups_ : leftRowGroups_;
+    for (auto i = begin; i < end; ++i) {
+      rows.push_back(i);
+      groups.push_back(group);
+    }
+  }
+
+  // Adds 'rows' of 'argVectors_' to the aligned 'groups'.
+  void addRows(
+      const std::vector<vector_size_t>& rows,
+      std::vector<char*>& groups) {
+    if (rows.empty()) {
+      return;
+    }
+    auto indices = allocateIndices(rows.size(), pool_);
+    std::copy(rows.begin(), rows.end(), indices->asMutable<vector_size_t>());
+    std::vector<VectorPtr> args(argVectors_.size());
+    for (auto i = 0; i < argVectors_.size(); ++i) {
+      args[i] = argIndices_[i] == kConstantChannel
+          ? argVectors_[i]
+          : BaseVector::wrapInDictionary(
+                nullptr, indices, rows.size(), argVectors_[i]);
+    }
+    SelectivityVector allRows(rows.size());
+    aggregate_->addRawInput(groups.data(), allRows, args, false);
+  }
+
+  // Returns zeroed memory for 'numGroups' group rows of 'groupRowStride_'
+  // bytes from 'buffer', growing it if needed.
+  char* allocateGroups(vector_size_t numGroups, BufferPtr& buffer) {
+    const auto size = numGroups * groupRowStride_;
+    if (!buffer || buffer->capacity() < size) {
+      buffer = AlignedBuffer::allocate<char>(size, pool_);
+    }
+    auto* groups = buffer->asMutable<char>();
+    std::memset(groups, 0, size);
+    return groups;
+  }
+
+  void initializeGroups(std::vector<char*>& groups) {
+    indices_.resize(groups.size());
+    std::iota(indices_.begin(), indices_.end(), 0);
+    aggregate_->initializeNewGroups(groups.data(), indices_);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -393,6 +631,42 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
+
+  // The number of children of a segment tree node.
+  static constexpr vector_size_t kFanout = 16;
+
+  // True if frames that do not share a start are computed with a segment
+  // tree.
+  const bool segmentTreeEnabled_;
+
+  // The distance between consecutive group rows of the segment tree nodes and
+  // of the frames of a block. 'singleGroupRowSize_' rounded up to the
+  // accumulator alignment.
+  vector_size_t groupRowStride_;
+
+  TypePtr intermediateType_;
+
+  // The nodes of the segment tree over the rows of the current block by level
+  // and their memory.
+  std::vector<std::vector<char*>> treeLevels_;
+  BufferPtr treeBuffer_;
+
+  // The groups of the frames of the current block and their memory.
+  std::vector<char*> frameGroups_;
+  BufferPtr frameGroupsBuffer_;
+
+  // The rows and nodes to add to the groups of the frames of a block.
+  std::vector<vector_size_t> leftRows_;
+  std::vector<char*> leftRowGroups_;
+  std::vector<char*> frameNodes_;
+  std::vector<char*> frameNodeGroups_;
+  std::vector<vector_size_t> rightRows_;
+  std::vector<char*> rightRowGroups_;
+  std::vector<std::pair<vector_size_t, vector_size_t>> rightRanges_;
+
+  std::vector<vector_size_t> indices_;
+  std::vector<BaseVector::CopyRange> copyRanges_;
+  VectorPtr frameResults_;
 };
 
 } // namespace
@@ -426,7 +700,8 @@ void registerAggregateWindowFunction(const std::string& name) {
               pool,
               stringAllocator,
               config);
-        });
+        },
+        WindowFunction::Metadata{/*frameBoundedAccess=*/true});
   }
 }
 } // namespace facebook::velox::exec
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/ArrowStream.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Task.h"
 #include "velox/vector/arrow/Bridge.h"
 
 namespace facebook::velox::exec {
@@ -27,8 +29,15 @@ ArrowStream::ArrowStream(
           arrowStreamNode->outputType(),
           operatorId,
           arrowStreamNode->id(),
-          "ArrowStream") {
+          "ArrowStream"),
+      prefetchBatches_(driverCtx->queryConfig().arrowStreamPrefetchBatches()),
+      executor_(
+          prefetchBatches_ > 0 ? driverCtx->task->queryCtx()->executor()
+                               : nullptr) {
   arrowStream_ = arrowStreamNode->arrowStream();
+  if (executor_ != nullptr) {
+    prefetch_ = std::make_shared<Prefetch>();
+  }
 }
 
 ArrowStream::~ArrowStream() {
@@ -36,6 +45,64 @@ ArrowStream::~ArrowStream() {
 }
 
 RowVectorPtr ArrowStream::getOutput() {
+  if (prefetch_ == nullptr) {
+    uint64_t producerMicros{0};
+    RowVectorPtr batch;
+    {
+      MicrosecondTimer timer(&producerMicros);
+      batch = next();
+    }
+    updateStats(producerMicros);
+    if (batch == nullptr) {
+      finished_ = true;
+    }
+    return batch;
+  }
+
+  RowVectorPtr batch;
+  uint64_t producerMicros;
+  {
+    std::lock_guard<std::mutex> l(prefetch_->mutex);
+    producerMicros = prefetch_->producerMicros;
+    prefetch_->producerMicros = 0;
+    if (prefetch_->error != nullptr) {
+      std::rethrow_exception(prefetch_->error);
+    }
+    if (!prefetch_->batches.empty()) {
+      batch = std::move(prefetch_->batches.front());
+      prefetch_->batches.pop_front();
+      maybeStartPrefetchLocked();
+    } else if (prefetch_->atEnd) {
+      finished_ = true;
+    }
+  }
+  updateStats(producerMicros);
+  return batch;
+}
+
+BlockingReason ArrowStream::isBlocked(ContinueFuture* future) {
+  if (prefetch_ == nullptr) {
+    return BlockingReason::kNotBlocked;
+  }
+  std::lock_guard<std::mutex> l(prefetch_->mutex);
+  if (!prefetch_->batches.empty() || prefetch_->atEnd ||
+      prefetch_->error != nullptr) {
+    return BlockingReason::kNotBlocked;
+  }
+  maybeStartPrefetchLocked();
+  prefetch_->promises.emplace_back("ArrowStream::isBlocked");
+  *future = prefetch_->promises.back().getSemiFuture();
+  if (waitStartMicros_ == 0) {
+    waitStartMicros_ = getCurrentTimeMicro();
+  }
+  return BlockingReason::kWaitForProducer;
+}
+
+bool ArrowStream::isFinished() {
+  return finished_;
+}
+
+RowVectorPtr ArrowStream::next() {
   // Get Arrow array.
   struct ArrowArray arrowArray;
   if (arrowStream_->get_next(arrowStream_.get(), &arrowArray)) {
@@ -47,7 +114,6 @@ RowVectorPtr ArrowStream::getOutput() {
   }
   if (arrowArray.release == nullptr) {
     // End of Stream.
-    finished_ = true;
     return nullptr;
   }
 
@@ -70,8 +136,92 @@ RowVectorPtr ArrowStream::getOutput() {
       importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
 }
 
-bool ArrowStream::isFinished() {
-  return finished_;
+void ArrowStream::maybeStartPrefetchLocked() {
+  if (prefetch_->running || prefetch_->atEnd || prefetch_->closed ||
+      prefetch_->error != nullptr ||
+      prefetch_->batches.size() >= prefetchBatches_) {
+    return;
+  }
+  prefetch_->running = true;
+  executor_->add([this, state = prefetch_]() { prefetch(this, state); });
+}
+
+void ArrowStream::prefetch(
+    ArrowStream* op,
+    const std::shared_ptr<Prefetch>& state) {
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> l(state->mutex);
+      // 'op' may be destroyed once 'closed' is set.
+      if (state->closed || state->batches.size() >= op->prefetchBatches_) {
+        state->running = false;
+        return;
+      }
+      state->inProgress = true;
+    }
+
+    RowVectorPtr batch;
+    std::exception_ptr error;
+    uint64_t producerMicros{0};
+    {
+      MicrosecondTimer timer(&producerMicros);
+      try {
+        batch = op->next();
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+
+    std::vector<ContinuePromise> promises;
+    bool stop;
+    {
+      std::lock_guard<std::mutex> l(state->mutex);
+      state->producerMicros += producerMicros;
+      if (state->closed) {
+        // Frees the batch before close() returns and the pool goes away.
+        batch = nullptr;
+      } else if (error != nullptr) {
+        state->error = error;
+      } else if (batch == nullptr) {
+        state->atEnd = true;
+      } else {
+        state->batches.push_back(std::move(batch));
+      }
+      state->inProgress = false;
+      promises.swap(state->promises);
+      stop = state->closed || state->atEnd || state->error != nullptr;
+      if (stop) {
+        state->running = false;
+      }
+    }
+    state->inProgressCv.notify_all();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+    if (stop) {
+      return;
+    }
+  }
+}
+
+void ArrowStream::updateStats(uint64_t producerMicros) {
+  if (producerMicros == 0 && waitStartMicros_ == 0) {
+    return;
+  }
+  auto lockedStats = stats_.wlock();
+  if (producerMicros > 0) {
+    lockedStats->addRuntimeStat(
+        kProducerWallNanos,
+        RuntimeCounter(producerMicros * 1'000, RuntimeCounter::Unit::kNanos));
+  }
+  if (waitStartMicros_ > 0) {
+    lockedStats->addRuntimeStat(
+        kProducerWaitWallNanos,
+        RuntimeCounter(
+            (getCurrentTimeMicro() - waitStartMicros_) * 1'000,
+            RuntimeCounter::Unit::kNanos));
+    waitStartMicros_ = 0;
+  }
 }
 
 const char* ArrowStream::getError() const {
@@ -81,6 +231,20 @@ const char* ArrowStream::getError() const {
 }
 
 void ArrowStream::close() {
+  if (prefetch_ != nullptr) {
+    std::vector<ContinuePromise> promises;
+    {
+      std::unique_lock<std::mutex> l(prefetch_->mutex);
+      prefetch_->closed = true;
+      prefetch_->inProgressCv.wait(
+          l, [&]() { return !prefetch_->inProgress; });
+      prefetch_->batches.clear();
+      promises.swap(prefetch_->promises);
+    }
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  }
   if (arrowStream_->release) {
     arrowStream_->release(arrowStream_.get());
   }
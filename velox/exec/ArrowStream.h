@@ -13,6 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
 
@@ -20,8 +24,22 @@
 
 namespace facebook::velox::exec {
 
+/// Source operator that imports the Arrow arrays of an ArrowArrayStream. If
+/// the arrow_stream_prefetch_batches query config is not zero and the query
+/// has an executor, a task on the executor calls get_next and imports the
+/// arrays ahead of the driver, up to that many batches, and the driver blocks
+/// in isBlocked() only while the queue is empty. The task is the only caller
+/// of the stream while it runs, so calls to the stream stay serialized.
 class ArrowStream : public SourceOperator {
  public:
+  /// Wall time spent in get_next and importing the arrays, on the driver
+  /// thread or in the prefetch task.
+  static inline const std::string kProducerWallNanos{"producerWallNanos"};
+
+  /// Wall time the driver was blocked waiting for a prefetched batch.
+  static inline const std::string kProducerWaitWallNanos{
+      "producerWaitWallNanos"};
+
   ArrowStream(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -31,20 +49,63 @@ class ArrowStream : public SourceOperator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
   void close() override;
 
  private:
+  // State shared with the prefetch task. The task may still be queued on the
+  // executor after the operator is destroyed, so it holds a reference to
+  // this and checks 'closed' before touching the operator. It calls the
+  // stream with 'inProgress' set, which close() waits for.
+  struct Prefetch {
+    std::mutex mutex;
+    std::condition_variable inProgressCv;
+    std::deque<RowVectorPtr> batches;
+    std::exception_ptr error;
+    std::vector<ContinuePromise> promises;
+    uint64_t producerMicros{0};
+    // True if the task is scheduled or running.
+    bool running{false};
+    // True while the task calls the stream.
+    bool inProgress{false};
+    bool atEnd{false};
+    bool closed{false};
+  };
+
   /// Return last error in Arrow array stream.
   const char* getError() const;
 
+  // Returns the next batch of the stream or nullptr at end of stream.
+  RowVectorPtr next();
+
+  // Schedules the prefetch task if it is not running and the stream is not at
+  // end. Called with 'prefetch_->mutex' held.
+  void maybeStartPrefetchLocked();
+
+  // Body of the prefetch task. Fetches batches of 'op' until the queue is
+  // full, the stream ends or fails, or 'op' is closed. Static since 'op' may
+  // be destroyed by the time the task runs.
+  static void prefetch(ArrowStream* op, const std::shared_ptr<Prefetch>& state);
+
+  // Adds the producer time of the prefetch task and the time the driver
+  // waited for it to the runtime stats.
+  void updateStats(uint64_t producerMicros);
+
+  const uint32_t prefetchBatches_;
+  folly::Executor* const executor_;
+
   bool finished_ = false;
   std::shared_ptr<ArrowArrayStream> arrowStream_;
+
+  // Set if 'executor_' is set.
+  std::shared_ptr<Prefetch> prefetch_;
+
+  // Time in microseconds when the driver last blocked on an empty queue, 0 if
+  // not blocked.
+  uint64_t waitStartMicros_{0};
 };
 
 } // namespace facebook::velox::exec
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/BatchSizeTuner.h"
+
+#include <algorithm>
+
+namespace facebook::velox::exec {
+
+vector_size_t BatchSizeTuner::batchRows(vector_size_t maxRows) {
+  if (!converged_) {
+    maxUsefulShift_ = 0;
+    while (maxUsefulShift_ < kMaxShift &&
+           (maxRows >> (maxUsefulShift_ + 1)) >= kMinBatchRows) {
+      ++maxUsefulShift_;
+    }
+    if (shift_ > maxUsefulShift_) {
+      shift_ = maxUsefulShift_;
+    }
+  }
+  lastMaxRows_ = maxRows;
+  return currentBatchRows();
+}
+
+vector_size_t BatchSizeTuner::currentBatchRows() const {
+  return std::max<vector_size_t>(
+      std::min(lastMaxRows_, kMinBatchRows), lastMaxRows_ >> shift_);
+}
+
+bool BatchSizeTuner::recordOutput(
+    uint64_t runId,
+    uint64_t cpuNanos,
+    vector_size_t numRows) {
+  if (converged_) {
+    return false;
+  }
+  // The batch of 'numRows' is made at the shift before a possible move to the
+  // next trial below.
+  const auto batchShift = shift_;
+  // The time between the outputs of different runs includes time off thread
+  // and is not counted.
+  if (runId == pendingRunId_ && cpuNanos >= pendingCpuNanos_) {
+    trialRows_[pendingShift_] += pendingRows_;
+    trialNanos_[pendingShift_] += cpuNanos - pendingCpuNanos_;
+    if (pendingShift_ == shift_ && ++numTrialBatches_ >= kBatchesPerTrial) {
+      nextTrial();
+    }
+  }
+  pendingRunId_ = runId;
+  pendingCpuNanos_ = cpuNanos;
+  pendingRows_ = numRows;
+  pendingShift_ = batchShift;
+  return converged_;
+}
+
+void BatchSizeTuner::nextTrial() {
+  numTrialBatches_ = 0;
+  if (shift_ < maxUsefulShift_) {
+    ++shift_;
+    return;
+  }
+  int32_t best = -1;
+  for (auto i = 0; i <= kMaxShift; ++i) {
+    if (trialRows_[i] > 0 &&
+        (best < 0 || nanosPerRow(i) < nanosPerRow(best))) {
+      best = i;
+    }
+  }
+  shift_ = std::max(0, best);
+  converged_ = true;
+}
+
+uint64_t BatchSizeTuner::nanosPerRow(int32_t shift) const {
+  return trialRows_[shift] == 0 ? 0 : trialNanos_[shift] / trialRows_[shift];
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "velox/vector/TypeAliases.h"
+
+namespace facebook::velox::exec {
+
+/// Picks the output batch size of an operator at runtime. Smaller batches keep
+/// the columns the pipeline works on in the CPU cache but have more per batch
+/// overhead. The tuner tries the preferred batch size and halvings of it for a
+/// few batches each and measures the CPU time the Driver spends per output row
+/// between consecutive outputs of the operator. This covers the operator and
+/// the operators downstream of it in the pipeline. The batch size with the
+/// least cost per row is used for the rest of the operator's life. Not thread
+/// safe. Each Driver has its own operators and tuners.
+class BatchSizeTuner {
+ public:
+  /// Maximum number of halvings of the preferred batch size.
+  static constexpr int32_t kMaxShift = 4;
+
+  /// Number of batches measured per batch size.
+  static constexpr int32_t kBatchesPerTrial = 8;
+
+  /// Batch sizes below this are not tried.
+  static constexpr vector_size_t kMinBatchRows = 64;
+
+  /// Returns the number of rows of the next batch of at most 'maxRows'.
+  vector_size_t batchRows(vector_size_t maxRows);
+
+  /// Records that the operator returned a batch of 'numRows' in the Driver run
+  /// 'runId' when the CPU time of the thread was 'cpuNanos'. The time since
+  /// the previous batch of the same run is the cost of the previous batch.
+  /// Returns true if this completed the tuning.
+  bool recordOutput(uint64_t runId, uint64_t cpuNanos, vector_size_t numRows);
+
+  /// True when the batch size is picked.
+  bool converged() const {
+    return converged_;
+  }
+
+  /// Number of halvings of the preferred batch size in the current trial or,
+  /// after convergence, in the picked batch size.
+  int32_t shift() const {
+    return shift_;
+  }
+
+  /// The number of rows batchRows() returns for the last 'maxRows' at the
+  /// current shift().
+  vector_size_t currentBatchRows() const;
+
+  /// Average CPU nanos per row measured for 'shift'. 0 if not measured.
+  uint64_t nanosPerRow(int32_t shift) const;
+
+ private:
+  // Moves to the next trial or picks the batch size if there is no next
+  // trial.
+  void nextTrial();
+
+  int32_t shift_{0};
+  bool converged_{false};
+  vector_size_t lastMaxRows_{0};
+  // Largest shift that gives a batch size of at least kMinBatchRows for the
+  // last 'maxRows'.
+  int32_t maxUsefulShift_{kMaxShift};
+
+  // Batches, rows and CPU nanos measured per shift.
+  int32_t numTrialBatches_{0};
+  std::array<uint64_t, kMaxShift + 1> trialRows_{};
+  std::array<uint64_t, kMaxShift + 1> trialNanos_{};
+
+  // The last batch, whose cost is known when the next batch is returned.
+  uint64_t pendingRunId_{~0UL};
+  uint64_t pendingCpuNanos_{0};
+  vector_size_t pendingRows_{0};
+  int32_t pendingShift_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -349,6 +349,228 @@ void deserializeSwitch(
       deserializeOne, result.typeKind(), in, index, result);
 }
 
+// Batch serialization.
+template <TypeKind Kind>
+void serializeBatch(
+    const BaseVector& source,
+    folly::Range<const vector_size_t*> indices,
+    ByteOutputStream& out,
+    const ContainerRowSerdeOptions& options) {
+  for (auto index : indices) {
+    VELOX_DCHECK(
+        !source.isNullAt(index), "Null top-level values are not supported");
+    serializeOne<Kind>(source, index, out, options);
+  }
+}
+
+// Batch deserialization. Each of 'in' holds one value and the streams are
+// distinct, so that the values can be read level by level across the
+// streams while the reads from each stream stay in order.
+using StreamRange = folly::Range<ByteInputStream* const*>;
+
+void deserializeBatchSwitch(
+    StreamRange in,
+    folly::Range<const vector_size_t*> indices,
+    BaseVector& result);
+
+vector_size_t maxIndex(folly::Range<const vector_size_t*> indices) {
+  VELOX_DCHECK(!indices.empty());
+  return *std::max_element(indices.begin(), indices.end());
+}
+
+template <TypeKind Kind>
+void deserializeBatch(
+    StreamRange in,
+    folly::Range<const vector_size_t*> indices,
+    BaseVector& result) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  VELOX_CHECK_EQ(result.encoding(), VectorEncoding::Simple::FLAT);
+  auto* values = result.asUnchecked<FlatVector<T>>();
+  for (auto i = 0; i < in.size(); ++i) {
+    values->set(indices[i], in[i]->read<T>());
+  }
+}
+
+template <>
+void deserializeBatch<TypeKind::VARCHAR>(
+    StreamRange in,
+    folly::Range<const vector_size_t*> indices,
+    BaseVector& result) {
+  for (auto i = 0; i < in.size(); ++i) {
+    deserializeString(*in[i], indices[i], result);
+  }
+}
+
+template <>
+void deserializeBatch<TypeKind::VARBINARY>(
+    StreamRange in,
+    folly::Range<const vector_size_t*> indices,
+    BaseVector& result) {
+  for (auto i = 0; i < in.size(); ++i) {
+    deserializeString(*in[i], indices[i], result);
+  }
+}
+
+template <>
+void deserializeBatch<TypeKind::ROW>(
+    StreamRange in,
+    folly::Range<const vector_size_t*> indices,
+    BaseVector& result) {
+  const auto& type = result.type()->as<TypeKind::ROW>();
+  VELOX_CHECK_EQ(result.encoding(), VectorEncoding::Simple::ROW);
+  auto* row = result.asUnchecked<RowVector>();
+  const auto childrenSize = type.size();
+  VELOX_CHECK_EQ(childrenSize, row->childrenSize());
+  const auto numWords = bits::nwords(childrenSize);
+  std::vector<uint64_t> nulls(in.size() * numWords);
+  for (auto i = 0; i < in.size(); ++i) {
+    for (auto word = 0; word < numWords; ++word) {
+      nulls[i * numWords + word] = in[i]->read<uint64_t>();
+    }
+  }
+
+  const auto size = maxIndex(indices) + 1;
+  std::vector<ByteInputStream*> childIn;
+  std::vector<vector_size_t> childIndices;
+  for (auto child = 0; child < childrenSize; ++child) {
+    auto& childVector = *row->childAt(child);
+    if (childVector.size() < size) {
+      childVector.resize(size);
+    }
+    childIn.clear();
+    childIndices.clear();
+    for (auto i = 0; i < in.size(); ++i) {
+      if (bits::isBitSet(&nulls[i * numWords], child)) {
+        childVector.setNull(indices[i], true);
+      } else {
+        childIn.push_back(in[i]);
+        childIndices.push_back(indices[i]);
+      }
+    }
+    deserializeBatchSwitch(childIn, childIndices, childVector);
+  }
+  for (auto index : indices) {
+    result.setNull(index, false);
+  }
+}
+
+// The sizes and element null flags of a batch of arrays or maps.
+struct ArrayHeaders {
+  // Index of the first element of each array in the elements vector.
+  std::vector<vector_size_t> offsets;
+  std::vector<vector_size_t> sizes;
+  // The null flags of the elements of array i start at nulls[nullWords[i]].
+  std::vector<uint64_t> nulls;
+  std::vector<int32_t> nullWords;
+};
+
+// Reads the size and null flags of an array from each of 'in' and resizes
+// 'elements' once to append the elements of all the arrays.
+void readArrayHeaders(
+    StreamRange in,
+    BaseVector& elements,
+    ArrayHeaders& headers) {
+  headers.offsets.resize(in.size());
+  headers.sizes.resize(in.size());
+  headers.nullWords.resize(in.size());
+  headers.nulls.clear();
+  auto offset = elements.size();
+  for (auto i = 0; i < in.size(); ++i) {
+    const auto size = in[i]->read<int32_t>();
+    headers.offsets[i] = offset;
+    headers.sizes[i] = size;
+    headers.nullWords[i] = headers.nulls.size();
+    for (auto word = 0; word < bits::nwords(size); ++word) {
+      headers.nulls.push_back(in[i]->read<uint64_t>());
+    }
+    offset += size;
+  }
+  elements.resize(offset);
+}
+
+// Reads the elements of the arrays in 'headers'. The elements of one array
+// come from the same stream and are read one after another.
+template <TypeKind Kind>
+void readArrayElements(
+    StreamRange in,
+    const ArrayHeaders& headers,
+    BaseVector& elements) {
+  for (auto i = 0; i < in.size(); ++i) {
+    const auto* nulls = &headers.nulls[headers.nullWords[i]];
+    const auto offset = headers.offsets[i];
+    for (auto j = 0; j < headers.sizes[i]; ++j) {
+      if (bits::isBitSet(nulls, j)) {
+        elements.setNull(offset + j, true);
+      } else {
+        deserializeOne<Kind>(*in[i], offset + j, elements);
+      }
+    }
+  }
+}
+
+void readArrays(StreamRange in, BaseVector& elements, ArrayHeaders& headers) {
+  readArrayHeaders(in, elements, headers);
+  VELOX_DYNAMIC_TYPE_DISPATCH(
+      readArrayElements, elements.typeKind(), in, headers, elements);
+}
+
+template <>
+void deserializeBatch<TypeKind::ARRAY>(
+    StreamRange in,
+    folly::Range<const vector_size_t*> indices,
+    BaseVector& result) {
+  VELOX_CHECK_EQ(result.encoding(), VectorEncoding::Simple::ARRAY);
+  auto* array = result.asUnchecked<ArrayVector>();
+  const auto size = maxIndex(indices) + 1;
+  if (array->size() < size) {
+    array->resize(size);
+  }
+  ArrayHeaders headers;
+  readArrays(in, *array->elements(), headers);
+  for (auto i = 0; i < in.size(); ++i) {
+    array->setOffsetAndSize(indices[i], headers.offsets[i], headers.sizes[i]);
+    result.setNull(indices[i], false);
+  }
+}
+
+template <>
+void deserializeBatch<TypeKind::MAP>(
+    StreamRange in,
+    folly::Range<const vector_size_t*> indices,
+    BaseVector& result) {
+  VELOX_CHECK_EQ(result.encoding(), VectorEncoding::Simple::MAP);
+  auto* map = result.asUnchecked<MapVector>();
+  const auto size = maxIndex(indices) + 1;
+  if (map->size() < size) {
+    map->resize(size);
+  }
+  // The keys of a map are followed by its values in the stream, so all the
+  // keys are read before all the values.
+  ArrayHeaders keyHeaders;
+  readArrays(in, *map->mapKeys(), keyHeaders);
+  ArrayHeaders valueHeaders;
+  readArrays(in, *map->mapValues(), valueHeaders);
+  VELOX_CHECK(keyHeaders.sizes == valueHeaders.sizes);
+  VELOX_CHECK(keyHeaders.offsets == valueHeaders.offsets);
+  for (auto i = 0; i < in.size(); ++i) {
+    map->setOffsetAndSize(
+        indices[i], keyHeaders.offsets[i], keyHeaders.sizes[i]);
+    result.setNull(indices[i], false);
+  }
+}
+
+void deserializeBatchSwitch(
+    StreamRange in,
+    folly::Range<const vector_size_t*> indices,
+    BaseVector& result) {
+  VELOX_DCHECK_EQ(in.size(), indices.size());
+  if (in.empty()) {
+    return;
+  }
+  VELOX_DYNAMIC_TYPE_DISPATCH(
+      deserializeBatch, result.typeKind(), in, indices, result);
+}
+
 // Comparison of serialization and vector.
 std::optional<int32_t> compareSwitch(
     ByteInputStream& stream,
@@ -823,6 +1045,29 @@ void ContainerRowSerde::deserialize(
   deserializeSwitch(in, index, *result);
 }
 
+// static
+void ContainerRowSerde::serialize(
+    const BaseVector& source,
+    folly::Range<const vector_size_t*> indices,
+    ByteOutputStream& out,
+    const ContainerRowSerdeOptions& options) {
+  VELOX_DYNAMIC_TYPE_DISPATCH(
+      serializeBatch, source.typeKind(), source, indices, out, options);
+}
+
+// static
+void ContainerRowSerde::deserialize(
+    folly::Range<ByteInputStream*> in,
+    folly::Range<const vector_size_t*> indices,
+    BaseVector* result) {
+  VELOX_CHECK_EQ(in.size(), indices.size());
+  std::vector<ByteInputStream*> streams(in.size());
+  for (auto i = 0; i < in.size(); ++i) {
+    streams[i] = &in[i];
+  }
+  deserializeBatchSwitch(streams, indices, *result);
+}
+
 // static
 int32_t ContainerRowSerde::compare(
     ByteInputStream& left,
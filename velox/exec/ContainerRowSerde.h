@@ -37,9 +37,28 @@ class ContainerRowSerde {
       ByteOutputStream& out,
       const ContainerRowSerdeOptions& options);
 
+  /// Serializes the values of 'source' at 'indices' one after another into
+  /// 'out'. Same as calling serialize() for each index but with one type
+  /// dispatch for the batch. The values must not be null.
+  static void serialize(
+      const BaseVector& source,
+      folly::Range<const vector_size_t*> indices,
+      ByteOutputStream& out,
+      const ContainerRowSerdeOptions& options);
+
   static void
   deserialize(ByteInputStream& in, vector_size_t index, BaseVector* result);
 
+  /// Deserializes the value in each of 'in' into 'result' at the
+  /// corresponding position of 'indices'. Same as calling deserialize() for
+  /// each stream but the values are read level by level across the streams
+  /// with one type dispatch per level. The sizes of all the arrays or maps of
+  /// a level are read first and their elements vector is resized once.
+  static void deserialize(
+      folly::Range<ByteInputStream*> in,
+      folly::Range<const vector_size_t*> indices,
+      BaseVector* result);
+
   /// Returns < 0 if 'left' is less than 'right' at 'index', 0 if
   /// equal and > 0 otherwise. flags.nullHandlingMode can be only NullAsValue
   /// and support null-safe equal. Top level rows in right are not allowed to be
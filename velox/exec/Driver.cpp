@@ -21,9 +21,12 @@
 #include <gflags/gflags.h>
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/process/PerfCounters.h"
+#include "velox/common/process/ProcessBase.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/DriverScheduler.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Task.h"
 
@@ -123,6 +126,41 @@ std::string addContextOnException(
   return fmt::format("Operator: {}", op->toString());
 }
 
+
+// Adds the hardware counts of its lifetime to the runtime stats of 'op'. Does
+// nothing if 'op' is nullptr or the counters are not available.
+class OperatorPerfCounts {
+ public:
+  explicit OperatorPerfCounts(Operator* op) : op_(op) {
+    if (op_ != nullptr && !process::readThreadPerfCounts(start_)) {
+      op_ = nullptr;
+    }
+  }
+
+  ~OperatorPerfCounts() {
+    process::PerfCounts end;
+    if (op_ == nullptr || !process::readThreadPerfCounts(end)) {
+      return;
+    }
+    const auto delta = end - start_;
+    auto lockedStats = op_->stats().wlock();
+    lockedStats->addRuntimeStat("perfSampledCalls", RuntimeCounter(1));
+    lockedStats->addRuntimeStat(
+        "perfCycles", RuntimeCounter(static_cast<int64_t>(delta.cycles)));
+    lockedStats->addRuntimeStat(
+        "perfInstructions",
+        RuntimeCounter(static_cast<int64_t>(delta.instructions)));
+    lockedStats->addRuntimeStat(
+        "perfLlcMisses", RuntimeCounter(static_cast<int64_t>(delta.llcMisses)));
+    lockedStats->addRuntimeStat(
+        "perfBranchMisses",
+        RuntimeCounter(static_cast<int64_t>(delta.branchMisses)));
+  }
+
+ private:
+  Operator* op_;
+  process::PerfCounts start_;
+};
 } // namespace
 
 DriverCtx::DriverCtx(
@@ -150,7 +188,8 @@ velox::memory::MemoryPool* DriverCtx::addOperatorPool(
 }
 
 std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
-    int32_t operatorId) const {
+    int32_t operatorId,
+    const core::PlanNode* planNode) const {
   const auto& queryConfig = task->queryCtx()->queryConfig();
   if (!queryConfig.spillEnabled()) {
     return std::nullopt;
@@ -168,7 +207,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       [this](uint64_t bytes) {
         task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
       };
-  return common::SpillConfig(
+  common::SpillConfig spillConfig(
       std::move(getSpillDirPathCb),
       std::move(updateAndCheckSpillLimitCb),
       spillFilePrefix,
@@ -185,6 +224,21 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.spillCompressionKind(),
       queryConfig.spillFileCreateConfig());
+  spillConfig.rowFormatEnabled = queryConfig.spillRowFormatEnabled();
+  spillConfig.asyncWriteEnabled = queryConfig.spillAsyncWriteEnabled();
+  spillConfig.dictionaryEncodingEnabled =
+      queryConfig.spillDictionaryEncodingEnabled();
+  spillConfig.mergeFanIn = queryConfig.spillMergeFanIn();
+  spillConfig.checksumEnabled = queryConfig.spillChecksumEnabled();
+  spillConfig.adaptiveCompression = queryConfig.spillAdaptiveCompression();
+  spillConfig.compressionMaxNanosPerByte =
+      queryConfig.spillCompressionMaxNanosPerByte();
+  spillConfig.remoteTier = task->spillRemoteTier();
+  if (planNode != nullptr && queryConfig.spillHistoryEnabled()) {
+    spillConfig.numPartitionBits =
+        task->spillPartitionBitsLocked(*planNode, spillConfig.numPartitionBits);
+  }
+  return spillConfig;
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -221,6 +275,18 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
+          if (auto* timeline = task->timeline()) {
+            timeline->add(
+                {"blocked",
+                 fmt::format(
+                     "{}.{}",
+                     state->operator_->operatorType(),
+                     blockingReasonToString(state->reason_)),
+                 driver->driverCtx()->pipelineId,
+                 driver->driverCtx()->driverId,
+                 state->sinceMicros_,
+                 process::Timeline::nowMicros() - state->sinceMicros_});
+          }
         }
         VELOX_CHECK(!driver->state().suspended());
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -280,6 +346,14 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
+  if (auto scheduler = DriverScheduler::instance()) {
+    // Set before the scheduler can run 'driver' on another thread.
+    driver->scheduler_ = scheduler.get();
+    if (scheduler->enqueue(driver)) {
+      return;
+    }
+  }
+  driver->scheduler_ = nullptr;
   driver->task()->queryCtx()->executor()->add(
       [driver]() { Driver::run(driver); });
 }
@@ -290,10 +364,13 @@ void Driver::init(
   VELOX_CHECK_NULL(ctx_);
   ctx_ = std::move(ctx);
   cpuSliceMs_ = task()->driverCpuTimeSliceLimitMs();
+  blockingWaitInPlaceUs_ = ctx_->queryConfig().driverBlockingWaitInPlaceUs();
   VELOX_CHECK(operators_.empty());
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  perfCounterSamplingInterval_ =
+      ctx_->queryConfig().operatorPerfCounterSamplingInterval();
 }
 
 void Driver::initializeOperators() {
@@ -387,6 +464,8 @@ void Driver::enqueueInternal() {
   try {                                                                    \
     Operator::NonReclaimableSectionGuard nonReclaimableGuard(operatorPtr); \
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
+    process::Timeline::ScopedEvent timelineEvent(                          \
+        "operator", operatorPtr->operatorType(), operatorMethod);          \
     threadNumVeloxThrow() = 0;                                             \
     opCallStatus_.start(operatorId, operatorMethod);                       \
     ExceptionContextSetter exceptionContext(                               \
@@ -405,6 +484,17 @@ void Driver::enqueueInternal() {
         e.what());                                                         \
   }
 
+void Driver::noMoreOutputNeeded(int32_t operatorIndex) {
+  for (; numNoMoreOutputNeeded_ < operatorIndex; ++numNoMoreOutputNeeded_) {
+    auto* op = operators_[numNoMoreOutputNeeded_].get();
+    CALL_OPERATOR(
+        op->noMoreOutputNeeded(),
+        op,
+        numNoMoreOutputNeeded_,
+        kOpMethodNoMoreOutputNeeded);
+  }
+}
+
 void OpCallStatus::start(int32_t operatorId, const char* operatorMethod) {
   timeStartMs = getCurrentTimeMs();
   opId = operatorId;
@@ -474,7 +564,25 @@ CpuWallTiming Driver::processLazyTiming(
       timing.cpuNanos >= cpuDelta ? timing.cpuNanos - cpuDelta : 0};
 }
 
+Operator* Driver::perfSampledOperator(Operator* op, bool addInput) {
+  if (perfCounterSamplingInterval_ == 0) {
+    return nullptr;
+  }
+  const size_t index = 2 * op->operatorId() + (addInput ? 1 : 0);
+  if (index >= numUnsampledCalls_.size()) {
+    numUnsampledCalls_.resize(index + 1, 0);
+  }
+  if (++numUnsampledCalls_[index] < perfCounterSamplingInterval_) {
+    return nullptr;
+  }
+  numUnsampledCalls_[index] = 0;
+  return op;
+}
+
 bool Driver::shouldYield() const {
+  if (scheduler_ != nullptr && scheduler_->shouldYield(*this)) {
+    return true;
+  }
   if (cpuSliceMs_ == 0) {
     return false;
   }
@@ -485,10 +593,59 @@ bool Driver::checkUnderArbitration(ContinueFuture* future) {
   return task()->queryCtx()->checkUnderArbitration(future);
 }
 
+bool Driver::waitInPlace(
+    Operator* op,
+    BlockingReason reason,
+    ContinueFuture& future) {
+  if (blockingWaitInPlaceUs_ == 0) {
+    return false;
+  }
+  // Only waits for data and splits, which typically arrive soon in a busy
+  // pipeline. Yields must go off thread and the other waits, e.g. for memory
+  // arbitration or a join build, are too long to hold a thread for.
+  if (reason != BlockingReason::kWaitForProducer &&
+      reason != BlockingReason::kWaitForConsumer &&
+      reason != BlockingReason::kWaitForSplit) {
+    return false;
+  }
+  const uint64_t startMicros =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::high_resolution_clock::now().time_since_epoch())
+          .count();
+  if (!future.isReady()) {
+    future.wait(std::chrono::microseconds(blockingWaitInPlaceUs_));
+  }
+  // An error is propagated by going off thread as usual.
+  if (!future.isReady() || future.hasException()) {
+    op->stats().wlock()->addRuntimeStat(
+        "blockedWaitInPlaceMisses", RuntimeCounter(1));
+    return false;
+  }
+  op->recordBlockingTime(startMicros, reason);
+  op->stats().wlock()->addRuntimeStat(
+      "blockedWaitInPlaceTimes", RuntimeCounter(1));
+  future = ContinueFuture::makeEmpty();
+  return true;
+}
+
 StopReason Driver::runInternal(
     std::shared_ptr<Driver>& self,
     std::shared_ptr<BlockingState>& blockingState,
     RowVectorPtr& result) {
+  ++numRuns_;
+  // Charges the CPU time of this run and a sample of the query memory to the
+  // resource usage of the query.
+  const auto startCpuNanos = process::threadCpuNanos();
+  SCOPE_EXIT {
+    auto* queryCtx = task()->queryCtx().get();
+    queryCtx->resourceUsage().addCpuNanos(
+        process::threadCpuNanos() - startCpuNanos);
+    queryCtx->resourceUsage().addMemorySample(
+        queryCtx->pool()->reservedBytes());
+  };
+  process::Timeline::ScopedThread scopedTimeline(
+      task()->timeline(), ctx_->pipelineId, ctx_->driverId);
+  process::Timeline::ScopedEvent runEvent("driver", "run");
   const auto now = getCurrentTimeMicro();
   const auto queuedTimeUs = now - queueTimeStartUs_;
   // Update the next operator's queueTime.
@@ -591,8 +748,13 @@ StopReason Driver::runInternal(
             curOperatorId_,
             kOpMethodIsBlocked);
         if (blockingReason_ != BlockingReason::kNotBlocked) {
-          blockedOperatorId_ = curOperatorId_;
           checkIsBlockFutureValid(op, future);
+          if (waitInPlace(op, blockingReason_, future)) {
+            // Checks 'op' again.
+            ++i;
+            continue;
+          }
+          blockedOperatorId_ = curOperatorId_;
           blockingState = std::make_shared<BlockingState>(
               self, std::move(future), op, blockingReason_);
           guard.notThrown();
@@ -608,8 +770,12 @@ StopReason Driver::runInternal(
               curOperatorId_ + 1,
               kOpMethodIsBlocked);
           if (blockingReason_ != BlockingReason::kNotBlocked) {
-            blockedOperatorId_ = curOperatorId_ + 1;
             checkIsBlockFutureValid(nextOp, future);
+            if (waitInPlace(nextOp, blockingReason_, future)) {
+              ++i;
+              continue;
+            }
+            blockedOperatorId_ = curOperatorId_ + 1;
             blockingState = std::make_shared<BlockingState>(
                 self, std::move(future), nextOp, blockingReason_);
             guard.notThrown();
@@ -633,6 +799,7 @@ StopReason Driver::runInternal(
                   });
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
+              OperatorPerfCounts perfCounts(perfSampledOperator(op, false));
               CALL_OPERATOR(
                   intermediateResult = op->getOutput(),
                   op,
@@ -653,6 +820,12 @@ StopReason Driver::runInternal(
                   lockedStats->addOutputVector(
                       resultBytes, intermediateResult->size());
                 }
+                if (op->hasBatchSizeTuner()) {
+                  op->recordOutputBatch(
+                      numRuns_,
+                      process::threadCpuNanos(),
+                      intermediateResult->size());
+                }
               }
             }
             pushdownFilters(i);
@@ -671,11 +844,15 @@ StopReason Driver::runInternal(
                   "facebook::velox::exec::Driver::runInternal::addInput",
                   nextOp);
 
+              OperatorPerfCounts perfCounts(perfSampledOperator(nextOp, true));
               CALL_OPERATOR(
                   nextOp->addInput(intermediateResult),
                   nextOp,
                   curOperatorId_ + 1,
                   kOpMethodAddInput);
+              if (ctx_->queryConfig().operatorOutputRecycleEnabled()) {
+                op->recycleOutput(std::move(intermediateResult));
+              }
 
               // The next iteration will see if operators_[i + 1] has
               // output now that it got input.
@@ -699,8 +876,12 @@ StopReason Driver::runInternal(
                   curOperatorId_,
                   kOpMethodIsBlocked);
               if (blockingReason_ != BlockingReason::kNotBlocked) {
-                blockedOperatorId_ = curOperatorId_;
                 checkIsBlockFutureValid(op, future);
+                if (waitInPlace(op, blockingReason_, future)) {
+                  ++i;
+                  continue;
+                }
+                blockedOperatorId_ = curOperatorId_;
                 blockingState = std::make_shared<BlockingState>(
                     self, std::move(future), op, blockingReason_);
                 guard.notThrown();
@@ -726,6 +907,7 @@ StopReason Driver::runInternal(
                     nextOp,
                     curOperatorId_ + 1,
                     kOpMethodNoMoreInput);
+                noMoreOutputNeeded(i);
                 break;
               }
             }
@@ -741,6 +923,7 @@ StopReason Driver::runInternal(
                   auto selfDelta = processLazyTiming(*op, timing);
                   op->stats().wlock()->getOutputTiming.add(selfDelta);
                 });
+            OperatorPerfCounts perfCounts(perfSampledOperator(op, false));
             CALL_OPERATOR(
                 result = op->getOutput(),
                 op,
@@ -774,6 +957,7 @@ StopReason Driver::runInternal(
               curOperatorId_,
               kOpMethodIsFinished);
           if (finished) {
+            noMoreOutputNeeded(i);
             guard.notThrown();
             close();
             return StopReason::kAtEnd;
@@ -1117,6 +1301,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kYield";
     case BlockingReason::kWaitForArbitration:
       return "kWaitForArbitration";
+    case BlockingReason::kWaitForAggregationMerge:
+      return "kWaitForAggregationMerge";
   }
   VELOX_UNREACHABLE();
   return "";
@@ -33,6 +33,7 @@
 namespace facebook::velox::exec {
 
 class Driver;
+class DriverScheduler;
 class ExchangeClient;
 class Operator;
 struct OperatorStats;
@@ -128,6 +129,8 @@ struct ThreadState {
   uint64_t totalPauseTimeMs{0};
   /// Total off thread time (including blocked time and pause time).
   uint64_t totalOffThreadTimeMs{0};
+  /// Total on thread time, excluding the current run.
+  uint64_t totalOnThreadTimeMs{0};
 
   bool isOnThread() const {
     return thread != std::thread::id();
@@ -152,6 +155,7 @@ struct ThreadState {
     endExecTimeMs = getCurrentTimeMs();
     RECORD_HISTOGRAM_METRIC_VALUE(
         kMetricDriverExecTimeMs, (endExecTimeMs - startExecTimeMs));
+    totalOnThreadTimeMs += endExecTimeMs - startExecTimeMs;
     startExecTimeMs = 0;
     tid = 0;
   }
@@ -214,6 +218,9 @@ enum class BlockingReason {
   /// Operator is blocked waiting for its associated query memory arbitration to
   /// finish.
   kWaitForArbitration,
+  /// Hash aggregation operator is blocked waiting for its peers to finish
+  /// partitioning or merging their groups.
+  kWaitForAggregationMerge,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -292,8 +299,12 @@ struct DriverCtx {
       const core::PlanNodeId& planNodeId,
       const std::string& operatorType);
 
-  /// Builds the spill config for the operator with specified 'operatorId'.
-  std::optional<common::SpillConfig> makeSpillConfig(int32_t operatorId) const;
+  /// Builds the spill config for the operator with specified 'operatorId'. If
+  /// 'planNode' is set and QueryConfig::kSpillHistoryEnabled is true, the
+  /// number of partition bits comes from Task::spillPartitionBitsLocked().
+  std::optional<common::SpillConfig> makeSpillConfig(
+      int32_t operatorId,
+      const core::PlanNode* planNode = nullptr) const;
 };
 
 constexpr const char* kOpMethodNone = "";
@@ -303,6 +314,7 @@ constexpr const char* kOpMethodGetOutput = "getOutput";
 constexpr const char* kOpMethodAddInput = "addInput";
 constexpr const char* kOpMethodNoMoreInput = "noMoreInput";
 constexpr const char* kOpMethodIsFinished = "isFinished";
+constexpr const char* kOpMethodNoMoreOutputNeeded = "noMoreOutputNeeded";
 
 /// Same as the structure below, but does not have atomic members.
 /// Used to return the status from the struct with atomics.
@@ -377,6 +389,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
     return state_.execTimeMs();
   }
 
+  /// Returns the total time in ms this driver ran on thread, excluding the
+  /// current run.
+  uint64_t totalOnThreadTimeMs() const {
+    return state_.totalOnThreadTimeMs;
+  }
+
   bool isTerminated() const {
     return state_.isTerminated;
   }
@@ -396,6 +414,13 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// the memory arbiration finishes.
   bool checkUnderArbitration(ContinueFuture* future);
 
+  /// Waits on thread for up to QueryConfig::driverBlockingWaitInPlaceUs() for
+  /// 'future' on which 'op' is blocked for 'reason'. Returns true if 'future'
+  /// got fulfilled, in which case 'op' is not blocked on it anymore and the
+  /// driver continues on thread. Returns false if the driver should go off
+  /// thread.
+  bool waitInPlace(Operator* op, BlockingReason reason, ContinueFuture& future);
+
   void initializeOperatorStats(std::vector<OperatorStats>& stats);
 
   /// Close operators and add operator stats to the task.
@@ -477,6 +502,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   static void run(std::shared_ptr<Driver> self);
 
+  // Calls noMoreOutputNeeded() on the operators before 'operatorIndex' that
+  // have not been told yet. Called when the operator at 'operatorIndex'
+  // finished, e.g. a Limit that got all its rows, so that the operators
+  // feeding it can stop early.
+  void noMoreOutputNeeded(int32_t operatorIndex);
+
   StopReason runInternal(
       std::shared_ptr<Driver>& self,
       std::shared_ptr<BlockingState>& blockingState,
@@ -509,11 +540,23 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // but these do not bias the op's timing.
   CpuWallTiming processLazyTiming(Operator& op, const CpuWallTiming& timing);
 
+  // Returns 'op' if its next addInput() or getOutput() call is to be measured
+  // with hardware counters, nullptr otherwise.
+  Operator* perfSampledOperator(Operator* op, bool addInput);
+
   std::unique_ptr<DriverCtx> ctx_;
 
   // If not zero, specifies the driver cpu time slice.
   size_t cpuSliceMs_{0};
 
+  // If not zero, the time in us a blocked driver waits on thread before going
+  // off thread.
+  uint32_t blockingWaitInPlaceUs_{0};
+
+  // The scheduler that took 'this' at the last enqueue, nullptr if 'this' was
+  // added to the executor of its query.
+  DriverScheduler* scheduler_{nullptr};
+
   bool operatorsInitialized_{false};
 
   std::atomic_bool closed_{false};
@@ -535,13 +578,30 @@ class Driver : public std::enable_shared_from_this<Driver> {
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   size_t blockedOperatorId_{0};
 
+  // Number of leading operators that have been told that their output is no
+  // longer needed because a downstream operator finished early.
+  int32_t numNoMoreOutputNeeded_{0};
+
   bool trackOperatorCpuUsage_;
 
+  // See QueryConfig::kOperatorPerfCounterSamplingInterval.
+  uint32_t perfCounterSamplingInterval_{0};
+
+  // Number of addInput() and getOutput() calls per operator since the last
+  // sampled call. Indexed by 2 * operator id + 1 for addInput() and 2 *
+  // operator id for getOutput().
+  std::vector<uint32_t> numUnsampledCalls_;
+
+  // Number of runInternal() calls. Tells apart the CPU times of different runs
+  // for the batch size tuners of the operators.
+  uint64_t numRuns_{0};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
 
   friend struct DriverFactory;
+  friend class DriverScheduler;
 };
 
 using OperatorSupplier = std::function<
@@ -667,6 +727,13 @@ struct DriverFactory {
   /// based on this pipeline.
   std::vector<core::PlanNodeId> needsNestedLoopJoinBridges() const;
 
+  /// Returns true if drivers can be added to this pipeline while it runs, see
+  /// QueryConfig::kMaxDynamicDriversPerPipeline. This is so for ungrouped
+  /// pipelines that read splits of a table scan and only have operators that
+  /// do not depend on a fixed number of peers. Hash join probes qualify only
+  /// if QueryConfig::kHashProbeFinishEarlyOnEmptyBuild is off.
+  bool supportsDynamicDrivers(const core::QueryConfig& queryConfig) const;
+
   static std::vector<DriverAdapter> adapters;
 };
 
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverScheduler.h"
+
+#include <folly/concurrency/CacheLocality.h>
+
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Driver.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+std::shared_ptr<DriverScheduler>& instanceHolder() {
+  static std::shared_ptr<DriverScheduler> instance;
+  return instance;
+}
+} // namespace
+
+// static
+void DriverScheduler::setInstance(std::shared_ptr<DriverScheduler> scheduler) {
+  std::atomic_store(&instanceHolder(), std::move(scheduler));
+}
+
+// static
+std::shared_ptr<DriverScheduler> DriverScheduler::instance() {
+  return std::atomic_load(&instanceHolder());
+}
+
+// static
+void DriverScheduler::run(std::shared_ptr<Driver> driver) {
+  Driver::run(std::move(driver));
+}
+
+MultiLevelDriverScheduler::MultiLevelDriverScheduler(
+    folly::Executor* executor,
+    Options options)
+    : executor_(executor),
+      options_(std::move(options)),
+      numQueuedByLevel_(options_.levelThresholdsMs.size() + 1) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK(
+      std::is_sorted(
+          options_.levelThresholdsMs.begin(), options_.levelThresholdsMs.end()),
+      "Level thresholds must be ascending");
+  const int32_t numQueues = options_.numQueues > 0
+      ? options_.numQueues
+      : std::max<int32_t>(1, std::thread::hardware_concurrency());
+  for (auto i = 0; i < numQueues; ++i) {
+    auto queue = std::make_unique<Queue>();
+    queue->levels.resize(numLevels());
+    queue->passes.resize(numLevels(), 0);
+    queues_.push_back(std::move(queue));
+  }
+  for (auto& numQueued : numQueuedByLevel_) {
+    numQueued = 0;
+  }
+}
+
+int32_t MultiLevelDriverScheduler::level(uint64_t onThreadTimeMs) const {
+  const auto& thresholds = options_.levelThresholdsMs;
+  return std::upper_bound(
+             thresholds.begin(), thresholds.end(), onThreadTimeMs) -
+      thresholds.begin();
+}
+
+int64_t MultiLevelDriverScheduler::numQueued() const {
+  int64_t numQueued = 0;
+  for (const auto& count : numQueuedByLevel_) {
+    numQueued += count;
+  }
+  return numQueued;
+}
+
+bool MultiLevelDriverScheduler::enqueue(std::shared_ptr<Driver> driver) {
+  if (driver->task()->queryCtx()->executor() != executor_) {
+    return false;
+  }
+  const auto driverLevel = level(driver->totalOnThreadTimeMs());
+  auto queryShare = share(*driver);
+  auto& queue = *queues_[queueIndex()];
+  {
+    std::lock_guard<std::mutex> l(queue.mutex);
+    queue.levels[driverLevel].push_back(
+        {std::move(driver), std::move(queryShare)});
+    ++numQueuedByLevel_[driverLevel];
+  }
+  executor_->add([this]() { runNext(); });
+  return true;
+}
+
+bool MultiLevelDriverScheduler::shouldYield(const Driver& driver) const {
+  const auto execTimeMs = driver.execTimeMs();
+  if (execTimeMs < options_.minTimeSliceMs) {
+    return false;
+  }
+  const auto driverLevel = level(driver.totalOnThreadTimeMs() + execTimeMs);
+  for (auto i = 0; i < driverLevel; ++i) {
+    if (numQueuedByLevel_[i] > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<MultiLevelDriverScheduler::QueryShare>
+MultiLevelDriverScheduler::share(const Driver& driver) {
+  const auto& queryCtx = driver.task()->queryCtx();
+  std::lock_guard<std::mutex> l(sharesMutex_);
+  auto it = shares_.find(queryCtx.get());
+  // An expired entry is of a finished query at the same address.
+  if (it != shares_.end() && !it->second.queryCtx.expired()) {
+    return it->second.share;
+  }
+  for (it = shares_.begin(); it != shares_.end();) {
+    if (it->second.queryCtx.expired()) {
+      it = shares_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto queryShare = std::make_shared<QueryShare>(
+      std::max<int32_t>(1, queryCtx->queryConfig().driverSchedulerWeight()));
+  queryShare->weightedRunTimeUs = lastPickedRunTimeUs_.load();
+  shares_[queryCtx.get()] = ShareEntry{queryCtx, queryShare};
+  return queryShare;
+}
+
+int32_t MultiLevelDriverScheduler::queueIndex() const {
+  return folly::AccessSpreader<>::cachedCurrent(queues_.size());
+}
+
+std::optional<MultiLevelDriverScheduler::Entry> MultiLevelDriverScheduler::pick(
+    Queue& queue) {
+  int32_t pickedLevel = -1;
+  for (auto i = 0; i < queue.levels.size(); ++i) {
+    if (!queue.levels[i].empty() &&
+        (pickedLevel < 0 || queue.passes[i] < queue.passes[pickedLevel])) {
+      pickedLevel = i;
+    }
+  }
+  if (pickedLevel < 0) {
+    return std::nullopt;
+  }
+  // Empty levels do not save up picks for when Drivers arrive.
+  const auto pass = queue.passes[pickedLevel];
+  for (auto i = 0; i < queue.levels.size(); ++i) {
+    if (queue.levels[i].empty()) {
+      queue.passes[i] = std::max(queue.passes[i], pass);
+    }
+  }
+  queue.passes[pickedLevel] += 1UL << pickedLevel;
+
+  // Picks the first Driver of the query with the least weighted run time.
+  auto& entries = queue.levels[pickedLevel];
+  auto picked = entries.begin();
+  for (auto it = entries.begin() + 1; it != entries.end(); ++it) {
+    if (it->share->weightedRunTimeUs < picked->share->weightedRunTimeUs) {
+      picked = it;
+    }
+  }
+  Entry entry = std::move(*picked);
+  entries.erase(picked);
+  --numQueuedByLevel_[pickedLevel];
+
+  lastPickedRunTimeUs_ = entry.share->weightedRunTimeUs.load();
+  return entry;
+}
+
+void MultiLevelDriverScheduler::runNext() {
+  const auto ownIndex = queueIndex();
+  std::optional<Entry> entry;
+  // There is one task per queued Driver, so a Driver is found even if another
+  // task took the one that was in the first queue checked.
+  for (auto i = 0; !entry.has_value(); ++i) {
+    const auto index = (ownIndex + i) % queues_.size();
+    auto& queue = *queues_[index];
+    std::lock_guard<std::mutex> l(queue.mutex);
+    entry = pick(queue);
+    if (entry.has_value() && index != ownIndex) {
+      ++numSteals_;
+    }
+  }
+  const auto startUs = getCurrentTimeMicro();
+  run(std::move(entry->driver));
+  entry->share->weightedRunTimeUs +=
+      (getCurrentTimeMicro() - startUs) / entry->share->weight;
+}
+} // namespace facebook::velox::exec
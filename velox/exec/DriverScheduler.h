@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+
+#include <folly/Executor.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/core/QueryCtx.h"
+
+namespace facebook::velox::exec {
+
+class Driver;
+
+/// Decides the order in which enqueued Drivers run. Without a scheduler,
+/// Driver::enqueue adds each Driver to the executor of its query and Drivers
+/// run in submission order, also after yielding. A scheduler set with
+/// setInstance() takes the Drivers it accepts instead and runs them on
+/// executor threads in its own order. The scheduler must outlive the Drivers
+/// and executor tasks it has taken.
+class DriverScheduler {
+ public:
+  virtual ~DriverScheduler() = default;
+
+  /// Takes 'driver' to run it later. Returns false if 'driver' is not
+  /// scheduled by 'this', in which case it is added to the executor of its
+  /// query. Called with the Task mutex of 'driver' held.
+  virtual bool enqueue(std::shared_ptr<Driver> driver) = 0;
+
+  /// Returns true if 'driver', which is on thread and was enqueued through
+  /// 'this', should yield to let other Drivers run.
+  virtual bool shouldYield(const Driver& driver) const = 0;
+
+  /// Sets the process-wide scheduler. nullptr restores the default scheduling.
+  static void setInstance(std::shared_ptr<DriverScheduler> scheduler);
+
+  /// Returns the process-wide scheduler or nullptr if not set.
+  static std::shared_ptr<DriverScheduler> instance();
+
+ protected:
+  /// Runs 'driver' on the calling thread until it blocks, yields or finishes.
+  static void run(std::shared_ptr<Driver> driver);
+};
+
+/// A multi-level feedback queue scheduler. Drivers start at level 0 and move
+/// to the next level each time their total time on thread passes a level
+/// threshold, so that short running queries are not queued behind long running
+/// scans. Queued Drivers of lower levels are picked first but each level gets
+/// a share of the picks so that long running Drivers are not starved. Within a
+/// level, the Driver of the query with the least weighted run time is picked,
+/// where the weight of a query is QueryConfig::driverSchedulerWeight(). The
+/// Drivers are queued on per-core queues and a thread with an empty queue
+/// steals from the others. A running Driver yields after its time slice if a
+/// Driver of a lower level is queued.
+///
+/// Only schedules the Drivers of queries that run on 'executor'.
+class MultiLevelDriverScheduler : public DriverScheduler {
+ public:
+  struct Options {
+    /// Time on thread in ms after which a Driver moves to the next level.
+    /// There is one more level than thresholds.
+    std::vector<uint64_t> levelThresholdsMs{100, 1'000, 10'000, 60'000};
+
+    /// Minimum time in ms a Driver runs before yielding to a Driver of a lower
+    /// level.
+    uint64_t minTimeSliceMs{50};
+
+    /// Number of queues. 0 means one per hardware thread.
+    int32_t numQueues{0};
+  };
+
+  MultiLevelDriverScheduler(folly::Executor* executor, Options options);
+
+  bool enqueue(std::shared_ptr<Driver> driver) override;
+
+  bool shouldYield(const Driver& driver) const override;
+
+  /// Returns the level of a Driver that ran on thread for 'onThreadTimeMs'.
+  int32_t level(uint64_t onThreadTimeMs) const;
+
+  int32_t numLevels() const {
+    return options_.levelThresholdsMs.size() + 1;
+  }
+
+  /// Number of queued Drivers.
+  int64_t numQueued() const;
+
+  /// Number of Drivers taken from the queue of another thread.
+  uint64_t numSteals() const {
+    return numSteals_;
+  }
+
+ private:
+  // The scheduling state of a query.
+  struct QueryShare {
+    explicit QueryShare(int32_t _weight) : weight(_weight) {}
+
+    const int32_t weight;
+    // Run time of the Drivers of the query in us divided by 'weight'.
+    std::atomic<uint64_t> weightedRunTimeUs{0};
+  };
+
+  struct Entry {
+    std::shared_ptr<Driver> driver;
+    std::shared_ptr<QueryShare> share;
+  };
+
+  struct Queue {
+    std::mutex mutex;
+    // Queued Drivers by level.
+    std::vector<std::vector<Entry>> levels;
+    // The pass of each level in stride scheduling. The non-empty level with
+    // the lowest pass is picked and its pass is advanced by its stride. Lower
+    // levels have shorter strides and get more picks.
+    std::vector<uint64_t> passes;
+  };
+
+  // Returns the share of the query of 'driver'. Adds a share if there is none.
+  std::shared_ptr<QueryShare> share(const Driver& driver);
+
+  // Returns the index of the queue of the calling thread.
+  int32_t queueIndex() const;
+
+  // Removes the next Entry to run from 'queue'. Returns std::nullopt if
+  // 'queue' is empty.
+  std::optional<Entry> pick(Queue& queue);
+
+  // Runs the next queued Driver. There is one executor task per queued Driver.
+  void runNext();
+
+  folly::Executor* const executor_;
+  const Options options_;
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  // Number of queued Drivers per level over all queues.
+  std::vector<std::atomic<int64_t>> numQueuedByLevel_;
+  std::atomic<uint64_t> numSteals_{0};
+
+  std::mutex sharesMutex_;
+  struct ShareEntry {
+    std::weak_ptr<core::QueryCtx> queryCtx;
+    std::shared_ptr<QueryShare> share;
+  };
+  folly::F14FastMap<const core::QueryCtx*, ShareEntry> shares_;
+  // The weighted run time of the query of the last picked Driver, which is
+  // about the least of the queued queries. New queries start here so that
+  // they neither wait for nor get ahead of the running queries.
+  std::atomic<uint64_t> lastPickedRunTimeUs_{0};
+};
+} // namespace facebook::velox::exec
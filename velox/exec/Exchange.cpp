@@ -74,7 +74,8 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
     getSplits(&splitFuture_);
   }
 
-  const auto maxBytes = getSerde()->supportsAppendInDeserialize()
+  const auto maxBytes =
+      getSerde()->supportsAppendInDeserialize() && !zeroCopy_
       ? preferredOutputBatchBytes_
       : 1;
 
@@ -116,10 +117,14 @@ RowVectorPtr Exchange::getOutput() {
 
   uint64_t rawInputBytes{0};
   vector_size_t resultOffset = 0;
-  for (const auto& page : currentPages_) {
+  for (auto& page : currentPages_) {
     rawInputBytes += page->size();
 
     auto inputStream = page->prepareStreamForDeserialize();
+    if (zeroCopy_) {
+      // The vectors that are views on the page keep it alive.
+      options_.zeroCopyInput = std::shared_ptr<SerializedPage>(std::move(page));
+    }
 
     while (!inputStream.atEnd()) {
       getSerde()->deserialize(
@@ -129,6 +134,7 @@ RowVectorPtr Exchange::getOutput() {
   }
 
   currentPages_.clear();
+  options_.zeroCopyInput = nullptr;
 
   {
     auto lockedStats = stats_.wlock();
@@ -136,6 +142,8 @@ RowVectorPtr Exchange::getOutput() {
     lockedStats->rawInputPositions += result_->size();
     lockedStats->addInputVector(result_->estimateFlatSize(), result_->size());
   }
+  operatorCtx_->task()->queryCtx()->resourceUsage().addExchangeInputBytes(
+      rawInputBytes);
 
   return result_;
 }
@@ -51,6 +51,8 @@ class Exchange : public SourceOperator {
             operatorType),
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
+        zeroCopy_{
+            driverCtx->queryConfig().exchangeZeroCopyDeserialization()},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
         exchangeClient_{std::move(exchangeClient)} {
     options_.compressionKind =
@@ -94,6 +96,10 @@ class Exchange : public SourceOperator {
 
   const uint64_t preferredOutputBatchBytes_;
 
+  // True if the values of fixed-width columns are views on the pages, in
+  // which case each page is returned as a separate batch.
+  const bool zeroCopy_;
+
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
@@ -15,6 +15,8 @@
  */
 #include "velox/exec/ExchangeClient.h"
 
+#include <numeric>
+
 namespace facebook::velox::exec {
 
 void ExchangeClient::addRemoteTaskId(const std::string& taskId) {
@@ -164,9 +166,14 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
                 for (auto bytes : response.remainingBytes) {
                   VELOX_CHECK_GT(bytes, 0);
                 }
-                self->producingSources_.push(
+                const auto totalBytes = std::accumulate(
+                    response.remainingBytes.begin(),
+                    response.remainingBytes.end(),
+                    int64_t{0});
+                self->producingSources_.push_back(
                     {std::move(spec.source),
-                     std::move(response.remainingBytes)});
+                     std::move(response.remainingBytes),
+                     totalBytes});
               } else {
                 self->emptySources_.push(std::move(spec.source));
               }
@@ -197,24 +204,53 @@ ExchangeClient::pickSourcesToRequestLocked() {
   }
   int64_t availableSpace =
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
-  while (availableSpace > 0 && !producingSources_.empty()) {
-    auto& source = producingSources_.front().source;
-    int64_t requestBytes = 0;
-    for (auto bytes : producingSources_.front().remainingBytes) {
-      availableSpace -= bytes;
-      if (availableSpace < 0) {
+  if (availableSpace > 0 && !producingSources_.empty()) {
+    // The oldest source goes first, the others by their remaining bytes.
+    std::vector<int32_t> order(producingSources_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(
+        order.begin() + 1, order.end(), [&](auto left, auto right) {
+          return producingSources_[left].totalRemainingBytes <
+              producingSources_[right].totalRemainingBytes;
+        });
+    const auto credit = sourceCreditLocked();
+    bool anyRequested = false;
+    for (auto i : order) {
+      if (availableSpace <= 0) {
         break;
       }
-      requestBytes += bytes;
+      auto& producing = producingSources_[i];
+      int64_t requestBytes = 0;
+      for (auto bytes : producing.remainingBytes) {
+        if (bytes > availableSpace ||
+            (requestBytes > 0 && requestBytes + bytes > credit)) {
+          break;
+        }
+        availableSpace -= bytes;
+        requestBytes += bytes;
+      }
+      if (requestBytes == 0) {
+        if (i == 0) {
+          // Keep the space for the oldest source.
+          break;
+        }
+        continue;
+      }
+      VELOX_CHECK(producing.source->shouldRequestLocked());
+      requestSpecs.push_back({std::move(producing.source), requestBytes});
+      totalPendingBytes_ += requestBytes;
+      anyRequested = true;
     }
-    if (requestBytes == 0) {
-      VELOX_CHECK_LT(availableSpace, 0);
-      break;
+    if (anyRequested) {
+      producingSources_.erase(
+          std::remove_if(
+              producingSources_.begin(),
+              producingSources_.end(),
+              [](const auto& producing) {
+                return producing.source == nullptr;
+              }),
+          producingSources_.end());
     }
-    VELOX_CHECK(source->shouldRequestLocked());
-    requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
-    totalPendingBytes_ += requestBytes;
   }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
       !producingSources_.empty()) {
@@ -226,12 +262,16 @@ ExchangeClient::pickSourcesToRequestLocked() {
               << " bytes, exceeding capacity " << maxQueuedBytes_;
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    producingSources_.pop_front();
     totalPendingBytes_ += requestBytes;
   }
   return requestSpecs;
 }
 
+int64_t ExchangeClient::sourceCreditLocked() const {
+  return maxQueuedBytes_ / std::max<int64_t>(1, sources_.size());
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
@@ -109,10 +109,21 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   struct ProducingSource {
     std::shared_ptr<ExchangeSource> source;
     std::vector<int64_t> remainingBytes;
+    // Sum of 'remainingBytes'.
+    int64_t totalRemainingBytes;
   };
 
+  // Requests data from empty sources and from as many producing sources as fit
+  // in the available space. The source that has waited the longest is served
+  // first so that no source starves. The others are then served in order of
+  // how little they have left to produce, so that sources close to finishing
+  // drain first. Each source gets no more than its share of the queue
+  // capacity, see sourceCreditLocked(), unless its next page is larger.
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
+  // Maximum number of bytes to request from one producing source at a time.
+  int64_t sourceCreditLocked() const;
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   // Handy for ad-hoc logging.
@@ -130,9 +141,9 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // Total number of bytes in flight.
   int64_t totalPendingBytes_{0};
 
-  // A queue of sources that have returned non-empty response from the latest
-  // request.
-  std::queue<ProducingSource> producingSources_;
+  // Sources that have returned non-empty response from the latest request, in
+  // the order of the responses.
+  std::deque<ProducingSource> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
 };
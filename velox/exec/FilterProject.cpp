@@ -97,6 +97,35 @@ void FilterProject::initialize() {
       }
     }
   }
+
+  if (hasFilter_ && numExprs_ > 1) {
+    // Projections without conditionals load their fields for all the rows
+    // that pass the filter, so these loads can be announced ahead. Fields
+    // referenced by other projections may be loaded for fewer rows and
+    // identity projections may be loaded downstream.
+    const auto& inputType = filter_->sources()[0]->outputType();
+    std::unordered_set<column_index_t> excludedFields;
+    for (const auto& identity : identityProjections_) {
+      excludedFields.insert(identity.inputChannel);
+    }
+    std::unordered_set<column_index_t> prefetchFields;
+    for (auto i = 1; i < numExprs_; ++i) {
+      const auto& expr = exprs_->expr(i);
+      for (auto* field : expr->distinctFields()) {
+        const auto index = inputType->getChildIdx(field->name());
+        if (expr->hasConditionals()) {
+          excludedFields.insert(index);
+        } else {
+          prefetchFields.insert(index);
+        }
+      }
+    }
+    for (auto index : prefetchFields) {
+      if (excludedFields.count(index) == 0) {
+        prefetchFieldIndices_.push_back(index);
+      }
+    }
+  }
   filter_.reset();
   project_.reset();
 }
@@ -163,6 +192,7 @@ RowVectorPtr FilterProject::getOutput() {
     if (!allRowsSelected) {
       rows->setFromBits(filterEvalCtx_.selectedBits->as<uint64_t>(), size);
     }
+    prefetchFields(*rows);
     results = project(*rows, evalCtx);
   }
 
@@ -181,6 +211,15 @@ std::vector<VectorPtr> FilterProject::project(
   return results;
 }
 
+void FilterProject::prefetchFields(const SelectivityVector& rows) {
+  for (auto index : prefetchFieldIndices_) {
+    const auto& field = input_->childAt(index);
+    if (field->isLazy()) {
+      field->asUnchecked<LazyVector>()->prefetch(rows);
+    }
+  }
+}
+
 vector_size_t FilterProject::filter(
     EvalCtx& evalCtx,
     const SelectivityVector& allRows) {
@@ -54,6 +54,10 @@ class FilterProject : public Operator {
   void close() override {
     Operator::close();
     if (exprs_ != nullptr) {
+      const auto& config = operatorCtx_->driverCtx()->queryConfig();
+      if (config.exprProfileSamplingInterval() > 0) {
+        stats_.wlock()->exprStats = exprs_->statsTree();
+      }
       exprs_->clear();
     } else {
       VELOX_CHECK(!initialized_);
@@ -86,6 +90,10 @@ class FilterProject : public Operator {
   // updated.
   vector_size_t filter(EvalCtx& evalCtx, const SelectivityVector& allRows);
 
+  // Announces the loads of the lazy input fields in 'prefetchFieldIndices_'
+  // for 'rows' so that they can proceed while other fields are loaded.
+  void prefetchFields(const SelectivityVector& rows);
+
   // Evaluate projections on the specified rows and return the results.
   // pre-condition: !isIdentityProjection_
   std::vector<VectorPtr> project(
@@ -117,5 +125,10 @@ class FilterProject : public Operator {
   // will load c1 only for rows where f(c0) is true. However, c1 identity
   // projection needs all rows.
   std::vector<column_index_t> multiplyReferencedFieldIndices_;
+
+  // Indices of input fields that are loaded for all the rows that pass the
+  // filter, i.e. that are referenced only by projections without
+  // conditionals. Their lazy loads are announced after the filter.
+  std::vector<column_index_t> prefetchFieldIndices_;
 };
 } // namespace facebook::velox::exec
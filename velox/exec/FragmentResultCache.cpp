@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FragmentResultCache.h"
+
+#include <folly/ScopeGuard.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/exec/TableScan.h"
+
+namespace facebook::velox::exec {
+
+FragmentResultCache::FragmentResultCache(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::FragmentResultCacheNode>& planNode)
+    : Operator(
+          driverCtx,
+          planNode->outputType(),
+          operatorId,
+          planNode->id(),
+          "FragmentResultCache"),
+      tableScanNodeId_(planNode->tableScanNode()->id()),
+      maxEntryBytes_(
+          driverCtx->queryConfig().fragmentResultCacheMaxEntryBytes()),
+      cache_(cache::AsyncDataCache::getInstance()) {
+  isIdentityProjection_ = true;
+  if (cache_ != nullptr) {
+    fingerprintHash_ = folly::hasher<std::string>()(planNode->fingerprint());
+  }
+}
+
+void FragmentResultCache::initialize() {
+  Operator::initialize();
+  if (cache_ == nullptr) {
+    return;
+  }
+  auto* tableScan =
+      dynamic_cast<TableScan*>(driver()->findOperator(tableScanNodeId_));
+  VELOX_CHECK_NOT_NULL(
+      tableScan,
+      "FragmentResultCache must run in the pipeline of its TableScan");
+  tableScan->setResultCache(this);
+}
+
+bool FragmentResultCache::startSplit(const connector::ConnectorSplit& split) {
+  finishSplit();
+  const auto splitKey = split.resultCacheKey();
+  if (!splitKey.has_value()) {
+    return false;
+  }
+  // The StringIdMap keeps the key for as long as the entry is cached.
+  StringIdLease fileId(
+      fileIds(),
+      fmt::format("fragment:{:016x}:{}", fingerprintHash_, splitKey.value()));
+  const cache::RawFileCacheKey key{fileId.id(), 0};
+  if (cache_->exists(key)) {
+    auto pin = cache_->findOrCreate(key, 0, nullptr);
+    if (!pin.empty() && pin.entry()->isShared()) {
+      readCachedOutput(pin);
+      addRuntimeStat("fragmentResultCacheHits", RuntimeCounter(1));
+      return true;
+    }
+    // The entry was evicted or is being written by another Driver. An empty
+    // exclusive entry made by the lookup is dropped with 'pin'.
+  }
+  addRuntimeStat("fragmentResultCacheMisses", RuntimeCounter(1));
+  splitFileId_ = std::move(fileId);
+  splitOutput_ = std::make_unique<IOBufOutputStream>(*pool());
+  return false;
+}
+
+void FragmentResultCache::readCachedOutput(const cache::CachePin& pin) {
+  const auto* entry = pin.entry();
+  if (entry->size() == 0) {
+    // The split has no output.
+    return;
+  }
+  std::vector<ByteRange> ranges;
+  if (entry->tinyData() != nullptr) {
+    ranges.push_back(ByteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(entry->tinyData())),
+        entry->size(),
+        0});
+  } else {
+    int32_t remaining = entry->size();
+    const auto& data = entry->data();
+    for (auto i = 0; i < data.numRuns() && remaining > 0; ++i) {
+      const auto run = data.runAt(i);
+      const int32_t size = std::min<int64_t>(run.numBytes(), remaining);
+      ranges.push_back(ByteRange{run.data<uint8_t>(), size, 0});
+      remaining -= size;
+    }
+  }
+  ByteInputStream input(std::move(ranges));
+  while (!input.atEnd()) {
+    RowVectorPtr output;
+    VectorStreamGroup::read(&input, pool(), outputType_, &output);
+    cachedOutput_.push_back(std::move(output));
+  }
+}
+
+void FragmentResultCache::addInput(RowVectorPtr input) {
+  if (splitOutput_ != nullptr) {
+    input->loadedVector();
+    getVectorSerde()->createBatchSerializer(pool())->serialize(
+        input, splitOutput_.get());
+    if (static_cast<uint64_t>(splitOutput_->tellp()) > maxEntryBytes_) {
+      abandonSplit();
+    }
+  }
+  input_ = std::move(input);
+}
+
+RowVectorPtr FragmentResultCache::getOutput() {
+  if (input_ != nullptr) {
+    return std::move(input_);
+  }
+  if (cachedOutput_.empty()) {
+    return nullptr;
+  }
+  auto output = std::move(cachedOutput_.front());
+  cachedOutput_.pop_front();
+  return output;
+}
+
+void FragmentResultCache::noMoreInput() {
+  Operator::noMoreInput();
+  finishSplit();
+}
+
+void FragmentResultCache::finishSplit() {
+  if (splitOutput_ == nullptr) {
+    return;
+  }
+  auto guard = folly::makeGuard([&]() { abandonSplit(); });
+  const auto iobuf = splitOutput_->getIOBuf();
+  const auto size = iobuf->computeChainDataLength();
+  cache::CachePin pin;
+  try {
+    pin = cache_->findOrCreate({splitFileId_->id(), 0}, size, nullptr);
+  } catch (const VeloxRuntimeError&) {
+    // No space in the cache.
+    return;
+  }
+  if (pin.empty() || !pin.entry()->isExclusive()) {
+    // Another Driver cached the same split.
+    return;
+  }
+  auto* entry = pin.entry();
+  char* tinyData = entry->tinyData();
+  int32_t runIndex = 0;
+  uint64_t offset = 0;
+  for (const auto& range : *iobuf) {
+    if (tinyData != nullptr) {
+      std::memcpy(tinyData + offset, range.data(), range.size());
+      offset += range.size();
+      continue;
+    }
+    // Copies 'range' into the runs of the entry. 'offset' is the offset in
+    // the run at 'runIndex'.
+    uint64_t copied = 0;
+    while (copied < range.size()) {
+      const auto run = entry->data().runAt(runIndex);
+      const auto bytes =
+          std::min<uint64_t>(run.numBytes() - offset, range.size() - copied);
+      std::memcpy(run.data<char>() + offset, range.data() + copied, bytes);
+      copied += bytes;
+      offset += bytes;
+      if (offset == run.numBytes()) {
+        ++runIndex;
+        offset = 0;
+      }
+    }
+  }
+  // Not saved to SSD since lookups only go to memory.
+  entry->setExclusiveToShared(false);
+  addRuntimeStat("fragmentResultCacheStoredBytes", RuntimeCounter(size));
+}
+
+void FragmentResultCache::abandonSplit() {
+  splitOutput_.reset();
+  splitFileId_.reset();
+}
+
+void FragmentResultCache::close() {
+  abandonSplit();
+  cachedOutput_.clear();
+  Operator::close();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/memory/ByteStream.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Passes through the output of a fragment made of a TableScan followed by
+/// filters and projections, and caches the output of each split in the
+/// AsyncDataCache. The cache key is the fingerprint of the fragment and
+/// ConnectorSplit::resultCacheKey() of the split. On a hit the TableScan
+/// skips the split and 'this' returns the cached output instead. Does nothing
+/// if there is no AsyncDataCache. See core::FragmentResultCacheNode.
+class FragmentResultCache : public Operator {
+ public:
+  FragmentResultCache(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::FragmentResultCacheNode>& planNode);
+
+  void initialize() override;
+
+  bool preservesOrder() const override {
+    return true;
+  }
+
+  bool needsInput() const override {
+    return !noMoreInput_ && input_ == nullptr && cachedOutput_.empty();
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  void noMoreInput() override;
+
+  /// The output of the split being read is incomplete, so it is not cached.
+  void noMoreOutputNeeded() override {
+    abandonSplit();
+  }
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr && cachedOutput_.empty();
+  }
+
+  void close() override;
+
+  /// Called by the TableScan of the fragment before reading 'split'. Caches
+  /// the output of the previous split. Returns true if the output of 'split'
+  /// is cached, in which case the TableScan skips 'split' and 'this' returns
+  /// the cached output from getOutput(). Otherwise records the output of
+  /// 'split' to cache it.
+  bool startSplit(const connector::ConnectorSplit& split);
+
+  /// True if output read from the cache is yet to be returned. The TableScan
+  /// does not start another split until it is.
+  bool hasCachedOutput() const {
+    return !cachedOutput_.empty();
+  }
+
+ private:
+  // Stores the recorded output of the current split in the cache.
+  void finishSplit();
+
+  // Stops recording the output of the current split.
+  void abandonSplit();
+
+  // Reads the cached output of 'pin' into 'cachedOutput_'.
+  void readCachedOutput(const cache::CachePin& pin);
+
+  const core::PlanNodeId tableScanNodeId_;
+  const uint64_t maxEntryBytes_;
+  cache::AsyncDataCache* const cache_;
+
+  // Hash of core::FragmentResultCacheNode::fingerprint().
+  uint64_t fingerprintHash_{0};
+
+  // Identifies the cache entry of the current split in 'cache_' while its
+  // output is being recorded.
+  std::optional<StringIdLease> splitFileId_;
+  // The serialized output of the current split.
+  std::unique_ptr<IOBufOutputStream> splitOutput_;
+
+  // Output read from the cache, returned before reading more input.
+  std::deque<RowVectorPtr> cachedOutput_;
+};
+
+} // namespace facebook::velox::exec
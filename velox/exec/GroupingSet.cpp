@@ -60,6 +60,7 @@ GroupingSet::GroupingSet(
       isPartial_(isPartial),
       isRawInput_(isRawInput),
       queryConfig_(operatorCtx->task()->queryCtx()->queryConfig()),
+      executor_(operatorCtx->task()->queryCtx()->executor()),
       aggregates_(std::move(aggregates)),
       masks_(extractMaskChannels(aggregates_)),
       ignoreNullKeys_(ignoreNullKeys),
@@ -361,6 +362,10 @@ void GroupingSet::createHashTable() {
     table_ = HashTable<false>::createForAggregation(
         std::move(hashers_), accumulators(false), &pool_);
   }
+  if (executor_ != nullptr) {
+    table_->setParallelRehash(
+        executor_, queryConfig_.minTableRowsForParallelAggregationRehash());
+  }
 
   RowContainer& rows = *table_->rows();
   initializeAggregates(aggregates_, rows, false);
@@ -735,6 +740,10 @@ bool GroupingSet::getOutput(
   }
   VELOX_CHECK(!isDistinct());
 
+  if (partitionMerged_) {
+    return getMergedPartitionOutput(maxOutputRows, result);
+  }
+
   // @lint-ignore CLANGTIDY
   char* groups[maxOutputRows];
   const int32_t numGroups = table_
@@ -790,6 +799,212 @@ void GroupingSet::extractGroups(
   }
 }
 
+void GroupingSet::partitionGroups(int32_t numPartitions) {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK(!isGlobal_);
+  VELOX_CHECK(!hasSpilled());
+  VELOX_CHECK_GT(numPartitions, 0);
+  partitionedGroups_.clear();
+  partitionedGroups_.resize(numPartitions);
+  partitionedIntermediates_.clear();
+  partitionedIntermediates_.resize(numPartitions);
+  if (table_ == nullptr) {
+    return;
+  }
+
+  RowContainer& rows = *table_->rows();
+  const auto numKeys = rows.keyTypes().size();
+  constexpr int32_t kBatchSize = 1'000;
+  std::vector<char*> groups(kBatchSize);
+  std::vector<uint64_t> hashes(kBatchSize);
+  RowContainerIterator iterator;
+  while (const auto numGroups =
+             rows.listRows(&iterator, kBatchSize, groups.data())) {
+    const folly::Range<char**> batch(groups.data(), numGroups);
+    for (auto i = 0; i < numKeys; ++i) {
+      rows.hash(i, batch, i > 0, hashes.data());
+    }
+    for (auto i = 0; i < numGroups; ++i) {
+      partitionedGroups_[hashes[i] % numPartitions].push_back(groups[i]);
+    }
+  }
+
+  // The peers merge from these and never read the accumulators of 'this'. The
+  // partition this driver merges itself is dropped in mergePartition().
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    auto& partitionRows = partitionedGroups_[partition];
+    for (size_t i = 0; i < partitionRows.size(); i += kBatchSize) {
+      const auto numGroups =
+          std::min<size_t>(kBatchSize, partitionRows.size() - i);
+      partitionedIntermediates_[partition].push_back(extractIntermediateGroups(
+          folly::Range<char**>(partitionRows.data() + i, numGroups)));
+    }
+  }
+}
+
+RowVectorPtr GroupingSet::extractIntermediateGroups(
+    folly::Range<char**> groups) {
+  RowContainer& rows = *table_->rows();
+  const auto numGroups = groups.size();
+  const auto& keyTypes = rows.keyTypes();
+  std::vector<TypePtr> types;
+  std::vector<VectorPtr> children;
+  for (auto i = 0; i < keyTypes.size(); ++i) {
+    types.push_back(keyTypes[i]);
+    children.push_back(BaseVector::create(keyTypes[i], numGroups, &pool_));
+    rows.extractColumn(groups.data(), numGroups, i, children.back());
+  }
+  for (const auto& aggregate : aggregates_) {
+    types.push_back(aggregate.intermediateType);
+    children.push_back(
+        BaseVector::create(aggregate.intermediateType, numGroups, &pool_));
+    aggregate.function->extractAccumulators(
+        groups.data(), numGroups, &children.back());
+  }
+  return std::make_shared<RowVector>(
+      &pool_, ROW(std::move(types)), nullptr, numGroups, std::move(children));
+}
+
+void GroupingSet::mergePartition(
+    const std::vector<std::shared_ptr<GroupingSet>>& peers,
+    int32_t partition) {
+  VELOX_CHECK(!partitionMerged_);
+  VELOX_CHECK_LT(partition, partitionedGroups_.size());
+  // The peers only read their own partition of 'partitionedIntermediates_'.
+  mergedGroups_ = std::move(partitionedGroups_[partition]);
+  partitionedIntermediates_[partition].clear();
+  for (const auto& peer : peers) {
+    if (peer.get() == this) {
+      continue;
+    }
+    VELOX_CHECK_EQ(
+        peer->partitionedIntermediates_.size(),
+        partitionedIntermediates_.size());
+    for (const auto& groups : peer->partitionedIntermediates_[partition]) {
+      mergeGroups(groups);
+    }
+  }
+  partitionMerged_ = true;
+}
+
+void GroupingSet::mergeGroups(const RowVectorPtr& groups) {
+  if (!table_) {
+    createHashTable();
+  }
+  const auto numGroups = groups->size();
+
+  // Makes an input vector with the grouping keys in their input channels. The
+  // other channels are not read.
+  const auto& hashers = table_->hashers();
+  column_index_t numChannels = 0;
+  for (const auto& hasher : hashers) {
+    numChannels = std::max<column_index_t>(numChannels, hasher->channel() + 1);
+  }
+  std::vector<TypePtr> types(numChannels, UNKNOWN());
+  std::vector<VectorPtr> children(numChannels);
+  for (auto i = 0; i < hashers.size(); ++i) {
+    const auto channel = hashers[i]->channel();
+    types[channel] = hashers[i]->type();
+    children[channel] = groups->childAt(i);
+  }
+  for (auto& child : children) {
+    if (child == nullptr) {
+      child = BaseVector::createNullConstant(UNKNOWN(), numGroups, &pool_);
+    }
+  }
+  auto input = std::make_shared<RowVector>(
+      &pool_, ROW(std::move(types)), nullptr, numGroups, std::move(children));
+
+  activeRows_.resize(numGroups);
+  activeRows_.setAll();
+  table_->prepareForGroupProbe(
+      *lookup_,
+      input,
+      activeRows_,
+      ignoreNullKeys_,
+      BaseHashTable::kNoSpillInputStartPartitionBit);
+  VELOX_CHECK_EQ(lookup_->rows.size(), numGroups);
+  table_->groupProbe(*lookup_);
+
+  auto* newGroups = lookup_->hits.data();
+  for (const auto row : lookup_->newGroups) {
+    mergedGroups_.push_back(newGroups[row]);
+  }
+
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& function = aggregates_[i].function;
+    if (!lookup_->newGroups.empty()) {
+      function->initializeNewGroups(newGroups, lookup_->newGroups);
+    }
+    tempVectors_ = {groups->childAt(hashers.size() + i)};
+    function->addIntermediateResults(
+        newGroups, activeRows_, tempVectors_, false);
+  }
+  tempVectors_.clear();
+}
+
+void GroupingSet::prepareGlobalMerge() {
+  VELOX_CHECK(isGlobal_);
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK_NULL(sortedAggregations_);
+  if (!globalAggregationInitialized_) {
+    return;
+  }
+  auto* group = lookup_->hits[0];
+  std::vector<TypePtr> types;
+  std::vector<VectorPtr> children;
+  for (const auto& aggregate : aggregates_) {
+    VELOX_CHECK(!aggregate.distinct);
+    types.push_back(aggregate.intermediateType);
+    children.push_back(
+        BaseVector::create(aggregate.intermediateType, 1, &pool_));
+    aggregate.function->extractAccumulators(&group, 1, &children.back());
+  }
+  globalIntermediates_ = std::make_shared<RowVector>(
+      &pool_, ROW(std::move(types)), nullptr, 1, std::move(children));
+}
+
+void GroupingSet::mergeGlobalAggregation(const GroupingSet& peer) {
+  VELOX_CHECK(isGlobal_);
+  // The accumulators of 'this' are merged into directly.
+  globalIntermediates_ = nullptr;
+  if (peer.globalIntermediates_ == nullptr) {
+    return;
+  }
+  initializeGlobalAggregation();
+
+  auto* group = lookup_->hits[0];
+  activeRows_.resize(1);
+  activeRows_.setAll();
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    tempVectors_ = {peer.globalIntermediates_->childAt(i)};
+    aggregates_[i].function->addSingleGroupIntermediateResults(
+        group, activeRows_, tempVectors_, false);
+  }
+  tempVectors_.clear();
+}
+
+bool GroupingSet::getMergedPartitionOutput(
+    int32_t maxOutputRows,
+    const RowVectorPtr& result) {
+  const auto numGroups = std::min<size_t>(
+      maxOutputRows, mergedGroups_.size() - numMergedGroupsOutput_);
+  if (numGroups == 0) {
+    if (table_ != nullptr) {
+      table_->clear();
+    }
+    mergedGroups_.clear();
+    partitionedIntermediates_.clear();
+    return false;
+  }
+  extractGroups(
+      folly::Range<char**>(
+          mergedGroups_.data() + numMergedGroupsOutput_, numGroups),
+      result);
+  numMergedGroupsOutput_ += numGroups;
+  return true;
+}
+
 void GroupingSet::resetTable() {
   if (table_ != nullptr) {
     table_->clear();
@@ -1252,6 +1467,11 @@ void GroupingSet::abandonPartialAggregation() {
     }
   }
 
+  // The aggregation is abandoned before any input if HashAggregation
+  // estimates the number of groups from the first input.
+  if (table_ == nullptr) {
+    createHashTable();
+  }
   VELOX_CHECK_EQ(table_->rows()->numRows(), 0);
   intermediateRows_ = std::make_unique<RowContainer>(
       table_->rows()->keyTypes(),
@@ -148,6 +148,34 @@ class GroupingSet {
       RowContainerIterator& iterator,
       RowVectorPtr& result);
 
+  /// Splits the groups into 'numPartitions' partitions on the hash of the
+  /// grouping keys and extracts the keys and intermediate results of each
+  /// partition for the peers to merge. Used when the drivers of a single or
+  /// final aggregation merge their groups by partition. Must be called after
+  /// noMoreInput() and before the peers call mergePartition().
+  void partitionGroups(int32_t numPartitions);
+
+  /// Merges the groups in 'partition' of all 'peers' into 'this'. After this,
+  /// getOutput() returns only the groups of 'partition'. The groups of 'this'
+  /// in 'partition' stay in place, the groups of the peers are added from the
+  /// intermediate results extracted by their partitionGroups(), so that the
+  /// accumulators of a peer are only accessed by the peer. 'peers' includes
+  /// 'this' and may concurrently merge their own partitions.
+  void mergePartition(
+      const std::vector<std::shared_ptr<GroupingSet>>& peers,
+      int32_t partition);
+
+  /// Extracts the intermediate results of the global aggregation for a peer
+  /// to merge with mergeGlobalAggregation(). Must be called after
+  /// noMoreInput() and before the peer merges.
+  void prepareGlobalMerge();
+
+  /// Adds the intermediate results extracted by prepareGlobalMerge() of
+  /// 'peer' to the accumulators of 'this'. Used when the drivers of a single
+  /// or final global aggregation merge their results into one. The
+  /// accumulators of 'peer' are not accessed.
+  void mergeGlobalAggregation(const GroupingSet& peer);
+
   memory::MemoryPool& testingPool() const {
     return pool_;
   }
@@ -198,6 +226,21 @@ class GroupingSet {
   // spills enough to make output fit.
   void ensureOutputFits();
 
+  // Returns the keys followed by the intermediate results of the aggregates
+  // for 'groups' of 'table_'.
+  RowVectorPtr extractIntermediateGroups(folly::Range<char**> groups);
+
+  // Adds the keys and intermediate results in 'groups', as returned by
+  // extractIntermediateGroups() of a peer, to the hash table. Used by
+  // mergePartition().
+  void mergeGroups(const RowVectorPtr& groups);
+
+  // Returns the next batch of up to 'maxOutputRows' groups of
+  // 'mergedGroups_'. Returns false at end.
+  bool getMergedPartitionOutput(
+      int32_t maxOutputRows,
+      const RowVectorPtr& result);
+
   // Copies the grouping keys and aggregates for 'groups' into 'result' If
   // partial output, extracts the intermediate type for aggregates, final result
   // otherwise.
@@ -279,6 +322,8 @@ class GroupingSet {
   const bool isPartial_;
   const bool isRawInput_;
   const core::QueryConfig& queryConfig_;
+  // Executor for the parallel rehash of 'table_'.
+  folly::Executor* const executor_;
 
   std::vector<AggregateInfo> aggregates_;
   AggregationMasks masks_;
@@ -379,6 +424,26 @@ class GroupingSet {
   std::vector<char*> firstGroup_;
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
+
+  // Groups of 'table_' by partition. Set by partitionGroups().
+  std::vector<std::vector<char*>> partitionedGroups_;
+
+  // Keys and intermediate results of 'partitionedGroups_' by partition, in
+  // batches. Read by the peers in mergePartition().
+  std::vector<std::vector<RowVectorPtr>> partitionedIntermediates_;
+
+  // Intermediate results of the global aggregation, one column per
+  // aggregate. Set by prepareGlobalMerge() if there was input.
+  RowVectorPtr globalIntermediates_;
+
+  // True after mergePartition(). The output is then 'mergedGroups_'.
+  bool partitionMerged_{false};
+
+  // The groups of 'table_' in the merged partition.
+  std::vector<char*> mergedGroups_;
+
+  // Number of 'mergedGroups_' returned by getOutput() so far.
+  size_t numMergedGroupsOutput_{0};
 };
 
 } // namespace facebook::velox::exec
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/HashAggregation.h"
+#include <folly/ScopeGuard.h>
 #include <optional>
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
@@ -45,8 +47,16 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      flushClusteredInput_(
+          isPartialOutput_ && !isGlobal_ && !isDistinct_ &&
+          aggregationNode->preGroupedKeys().empty() &&
+          driverCtx->queryConfig().partialAggregationClusteredFlush()),
+      partialAggregationFlushQueryMemoryPct_(
+          driverCtx->queryConfig().partialAggregationFlushQueryMemoryPct()),
       maxPartialAggregationMemoryUsage_(
-          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()),
+      abandonPartialAggregationSketchRows_(
+          driverCtx->queryConfig().abandonPartialAggregationSketchRows()) {}
 
 void HashAggregation::initialize() {
   Operator::initialize();
@@ -87,6 +97,16 @@ void HashAggregation::initialize() {
     }
   }
 
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  if (aggregationNode_->dedupsDistinctInputs(queryConfig)) {
+    // 'groupingSet_' aggregates the rows new to 'distinctSet_', so its
+    // aggregates do not de-duplicate their inputs.
+    for (auto& info : aggregateInfos) {
+      info.distinct = false;
+    }
+    createDistinctSet(inputType, hashers);
+  }
+
   std::optional<column_index_t> groupIdChannel;
   if (aggregationNode_->groupId().has_value()) {
     groupIdChannel = outputType_->getChildIdxIfExists(
@@ -94,7 +114,9 @@ void HashAggregation::initialize() {
     VELOX_CHECK(groupIdChannel.has_value());
   }
 
-  groupingSet_ = std::make_unique<GroupingSet>(
+  partitionedMerge_ = usePartitionedMerge();
+
+  groupingSet_ = std::make_shared<GroupingSet>(
       inputType,
       std::move(hashers),
       std::move(preGroupedChannels),
@@ -109,9 +131,149 @@ void HashAggregation::initialize() {
       operatorCtx_.get(),
       &spillStats_);
 
+  if (abandonPartialAggregationSketchRows_ > 0 && isPartialOutput_ &&
+      !isGlobal_ && !isDistinct_) {
+    // 2KB of buckets with a standard error of 2.3%.
+    constexpr int8_t kSketchIndexBitLength = 12;
+    sketchAllocator_ = std::make_unique<HashStringAllocator>(pool());
+    keySketch_ = std::make_unique<common::hll::DenseHll>(
+        kSketchIndexBitLength, sketchAllocator_.get());
+    sketchHashers_ =
+        createVectorHashers(inputType, aggregationNode_->groupingKeys());
+  }
+
   aggregationNode_.reset();
 }
 
+void HashAggregation::createDistinctSet(
+    const RowTypePtr& inputType,
+    const std::vector<std::unique_ptr<VectorHasher>>& keyHashers) {
+  for (const auto& hasher : keyHashers) {
+    distinctChannels_.push_back(hasher->channel());
+  }
+  for (const auto& input : aggregationNode_->aggregates()[0].call->inputs()) {
+    const auto channel = exprToChannel(input.get(), inputType);
+    if (std::find(
+            distinctChannels_.begin(), distinctChannels_.end(), channel) ==
+        distinctChannels_.end()) {
+      distinctChannels_.push_back(channel);
+    }
+  }
+
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  std::vector<TypePtr> types;
+  for (const auto channel : distinctChannels_) {
+    hashers.push_back(
+        std::make_unique<VectorHasher>(inputType->childAt(channel), channel));
+    types.push_back(inputType->childAt(channel));
+  }
+  distinctType_ = ROW(std::move(types));
+  aggregationInputType_ = inputType;
+
+  // The spill files of 'distinctSet_' must not collide with those of
+  // 'groupingSet_'.
+  if (spillConfig_.has_value()) {
+    distinctSpillConfig_ = spillConfig_.value();
+    distinctSpillConfig_->fileNamePrefix += "_distinct";
+  }
+  // Null inputs are kept for the aggregates to see.
+  distinctSet_ = std::make_unique<GroupingSet>(
+      inputType,
+      std::move(hashers),
+      std::vector<column_index_t>{},
+      std::vector<AggregateInfo>{},
+      false,
+      false,
+      true,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      distinctSpillConfig_.has_value() ? &distinctSpillConfig_.value()
+                                       : nullptr,
+      &nonReclaimableSection_,
+      operatorCtx_.get(),
+      &spillStats_);
+}
+
+void HashAggregation::addDistinctInput(const RowVectorPtr& input) {
+  distinctSet_->addInput(input, false);
+  // After 'distinctSet_' has spilled, the rows new to it are known only when
+  // its spilled rows are read back by addSpilledDistinctInput().
+  if (distinctSet_->hasSpilled()) {
+    return;
+  }
+  const auto& newGroups = distinctSet_->hashLookup().newGroups;
+  if (newGroups.empty()) {
+    return;
+  }
+  if (newGroups.size() == input->size()) {
+    groupingSet_->addInput(input, false);
+    return;
+  }
+  auto indices = allocateIndices(newGroups.size(), pool());
+  std::copy(
+      newGroups.begin(), newGroups.end(), indices->asMutable<vector_size_t>());
+  groupingSet_->addInput(wrap(newGroups.size(), indices, input), false);
+}
+
+void HashAggregation::addSpilledDistinctInput() {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxRows = outputBatchRows();
+  if (distinctOutput_ != nullptr) {
+    VectorPtr output = std::move(distinctOutput_);
+    BaseVector::prepareForReuse(output, maxRows);
+    distinctOutput_ = std::static_pointer_cast<RowVector>(output);
+  } else {
+    distinctOutput_ = std::static_pointer_cast<RowVector>(
+        BaseVector::create(distinctType_, maxRows, pool()));
+  }
+
+  RowContainerIterator iterator;
+  if (!distinctSet_->getOutput(
+          maxRows,
+          queryConfig.preferredOutputBatchBytes(),
+          iterator,
+          distinctOutput_)) {
+    distinctSet_.reset();
+    distinctOutput_ = nullptr;
+    finishInput();
+    return;
+  }
+
+  // Places the columns of 'distinctOutput_' in their input channels. The
+  // other channels are not read.
+  const auto numRows = distinctOutput_->size();
+  std::vector<VectorPtr> children(aggregationInputType_->size());
+  for (auto i = 0; i < distinctChannels_.size(); ++i) {
+    children[distinctChannels_[i]] = distinctOutput_->childAt(i);
+  }
+  for (auto i = 0; i < children.size(); ++i) {
+    if (children[i] == nullptr) {
+      children[i] = BaseVector::createNullConstant(
+          aggregationInputType_->childAt(i), numRows, pool());
+    }
+  }
+  groupingSet_->addInput(
+      std::make_shared<RowVector>(
+          pool(), aggregationInputType_, nullptr, numRows, std::move(children)),
+      false);
+}
+
+bool HashAggregation::usePartitionedMerge() const {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  if (!queryConfig.hashAggregationPartitionedMerge() || isPartialOutput_ ||
+      isDistinct_ || spillConfig_.has_value() ||
+      !aggregationNode_->preGroupedKeys().empty() ||
+      !aggregationNode_->globalGroupingSets().empty()) {
+    return false;
+  }
+  for (const auto& aggregate : aggregationNode_->aggregates()) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
   VELOX_CHECK(isPartialOutput_ && !isGlobal_);
   return numInputRows_ > abandonPartialAggregationMinRows_ &&
@@ -128,7 +290,67 @@ void HashAggregation::addInput(RowVectorPtr input) {
     numInputRows_ += input->size();
     return;
   }
-  groupingSet_->addInput(input, mayPushdown_);
+  if (keySketch_ != nullptr) {
+    addSketchedInput(input);
+    return;
+  }
+  addInputToGroupingSet(input, mayPushdown_);
+}
+
+void HashAggregation::addSketchedInput(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  // The held inputs must not reference the reader of the producer, which
+  // moves on to the next batch.
+  input->loadedVector();
+  sketchRows_.resizeFill(numRows);
+  sketchHashes_.resize(numRows);
+  for (auto i = 0; i < sketchHashers_.size(); ++i) {
+    auto& hasher = sketchHashers_[i];
+    hasher->decode(*input->childAt(hasher->channel()), sketchRows_);
+    hasher->hash(sketchRows_, i > 0, sketchHashes_);
+  }
+  for (auto i = 0; i < numRows; ++i) {
+    keySketch_->insertHash(sketchHashes_[i]);
+  }
+  sketchedInputs_.push_back(input);
+  numSketchedRows_ += numRows;
+  numInputRows_ += numRows;
+  if (numSketchedRows_ >= abandonPartialAggregationSketchRows_) {
+    finishKeySketch();
+  }
+}
+
+void HashAggregation::finishKeySketch() {
+  VELOX_CHECK_NOT_NULL(keySketch_);
+  const auto sketchPct = numSketchedRows_ == 0
+      ? 0
+      : 100 * keySketch_->cardinality() / numSketchedRows_;
+  keySketch_.reset();
+  sketchAllocator_.reset();
+  sketchHashers_.clear();
+  addRuntimeStat("partialAggregationSketchPct", RuntimeCounter(sketchPct));
+  if (numSketchedRows_ > 0 && sketchPct >= abandonPartialAggregationMinPct_) {
+    abandonPartialAggregation();
+    return;
+  }
+  auto inputs = std::move(sketchedInputs_);
+  sketchedInputs_.clear();
+  numInputRows_ = 0;
+  for (const auto& input : inputs) {
+    addInputToGroupingSet(input, false);
+  }
+}
+
+void HashAggregation::addInputToGroupingSet(
+    const RowVectorPtr& input,
+    bool mayPushdown) {
+  const auto numGroupsBefore =
+      flushClusteredInput_ ? groupingSet_->numDistinct() : 0;
+  if (distinctSet_ != nullptr) {
+    addDistinctInput(input);
+  } else {
+    groupingSet_->addInput(input, mayPushdown);
+  }
   numInputRows_ += input->size();
 
   updateRuntimeStats();
@@ -144,6 +366,21 @@ void HashAggregation::addInput(RowVectorPtr input) {
     partialFull_ = true;
   }
 
+  if (isPartialOutput_ && !isGlobal_ && !partialFull_ &&
+      queryMemoryUnderPressure()) {
+    partialFull_ = true;
+    memoryPressureFlush_ = true;
+  }
+
+  // The groups that were in the table before 'input' are likely complete if
+  // 'input' hit none of them. The flush is only worth its overhead if these
+  // fill an output batch.
+  if (flushClusteredInput_ && !partialFull_ && !groupingSet_->hasSpilled() &&
+      numGroupsBefore >= outputBatchRows() && lastInputHitNewGroupsOnly()) {
+    partialFull_ = true;
+    clusteredInputFlush_ = true;
+  }
+
   if (isDistinct_) {
     newDistincts_ = !groupingSet_->hasSpilled() &&
         !groupingSet_->hashLookup().newGroups.empty();
@@ -160,6 +397,36 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+bool HashAggregation::queryMemoryUnderPressure() const {
+  if (partialAggregationFlushQueryMemoryPct_ == 0 ||
+      groupingSet_->numDistinct() == 0) {
+    return false;
+  }
+  const auto* queryPool = pool()->root();
+  return queryPool->reservedBytes() >
+      queryPool->maxCapacity() / 100 * partialAggregationFlushQueryMemoryPct_;
+}
+
+bool HashAggregation::lastInputHitNewGroupsOnly() {
+  const auto& lookup = groupingSet_->hashLookup();
+  if (lookup.newGroups.empty()) {
+    return false;
+  }
+  if (lookup.newGroups.size() == lookup.rows.size()) {
+    return true;
+  }
+  newGroupRows_.clear();
+  for (const auto row : lookup.newGroups) {
+    newGroupRows_.insert(lookup.hits[row]);
+  }
+  for (const auto row : lookup.rows) {
+    if (!newGroupRows_.contains(lookup.hits[row])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -188,6 +455,10 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  if (hashTableStats.hugePageBytes != 0) {
+    runtimeStats[BaseHashTable::kHugePageBytes] = RuntimeMetric(
+        hashTableStats.hugePageBytes, RuntimeCounter::Unit::kBytes);
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -215,12 +486,26 @@ void HashAggregation::resetPartialOutputIfNeed() {
     lockedStats->addRuntimeStat("flushTimes", RuntimeCounter(1));
     lockedStats->addRuntimeStat(
         "partialAggregationPct", RuntimeCounter(aggregationPct));
+    if (flushClusteredInput_) {
+      lockedStats->addRuntimeStat(
+          "clusteredFlushPct", RuntimeCounter(clusteredInputFlush_ ? 100 : 0));
+    }
+    if (memoryPressureFlush_) {
+      lockedStats->addRuntimeStat("memoryPressureFlushes", RuntimeCounter(1));
+    }
   }
   groupingSet_->resetTable();
   partialFull_ = false;
-  if (!finished_) {
+  if (memoryPressureFlush_) {
+    // Returns the memory of the table to the query.
+    pool()->release();
+  } else if (!finished_ && !clusteredInputFlush_) {
+    // A flush for clustered input is not a sign that the memory limit is too
+    // low.
     maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
   }
+  clusteredInputFlush_ = false;
+  memoryPressureFlush_ = false;
   numOutputRows_ = 0;
   numInputRows_ = 0;
 }
@@ -236,10 +521,7 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
       (aggregationPct > kPartialMinFinalPct &&
        maxPartialAggregationMemoryUsage_ >=
            maxExtendedPartialAggregationMemoryUsage_)) {
-    groupingSet_->abandonPartialAggregation();
-    pool()->release();
-    addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
-    abandonedPartialAggregation_ = true;
+    abandonPartialAggregation();
     return;
   }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
@@ -263,13 +545,24 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
           maxPartialAggregationMemoryUsage_, RuntimeCounter::Unit::kBytes));
 }
 
+void HashAggregation::abandonPartialAggregation() {
+  groupingSet_->abandonPartialAggregation();
+  pool()->release();
+  addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
+  abandonedPartialAggregation_ = true;
+}
+
 RowVectorPtr HashAggregation::getOutput() {
   if (finished_) {
     input_ = nullptr;
     return nullptr;
   }
   if (abandonedPartialAggregation_) {
-    if (noMoreInput_) {
+    if (input_ == nullptr && !sketchedInputs_.empty()) {
+      input_ = std::move(sketchedInputs_.front());
+      sketchedInputs_.erase(sketchedInputs_.begin());
+    }
+    if (noMoreInput_ && sketchedInputs_.empty()) {
       finished_ = true;
     }
     if (!input_) {
@@ -282,6 +575,15 @@ RowVectorPtr HashAggregation::getOutput() {
     return output_;
   }
 
+  if (distinctSet_ != nullptr && noMoreInput_) {
+    addSpilledDistinctInput();
+    return nullptr;
+  }
+
+  if (!finishPartitionedMerge()) {
+    return nullptr;
+  }
+
   // Produce results if one of the following is true:
   // - received no-more-input message;
   // - partial aggregation reached memory limit;
@@ -380,11 +682,159 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 }
 
 void HashAggregation::noMoreInput() {
+  if (keySketch_ != nullptr) {
+    finishKeySketch();
+  }
+  if (distinctSet_ != nullptr) {
+    distinctSet_->noMoreInput();
+    if (distinctSet_->hasSpilled()) {
+      // getOutput() adds the spilled rows of 'distinctSet_' to
+      // 'groupingSet_' before finishing its input.
+      Operator::noMoreInput();
+      return;
+    }
+    distinctSet_.reset();
+  }
+  finishInput();
+}
+
+void HashAggregation::finishInput() {
   updateEstimatedOutputRowSize();
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
+
+  if (partitionedMerge_) {
+    const auto numDrivers =
+        operatorCtx_->task()->numDrivers(operatorCtx_->driver());
+    if (numDrivers > 1) {
+      if (isGlobal_) {
+        groupingSet_->prepareGlobalMerge();
+        startGlobalMerge();
+      } else {
+        groupingSet_->partitionGroups(numDrivers);
+        startPartitionedMerge();
+      }
+    }
+  }
+}
+
+void HashAggregation::startGlobalMerge() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    mergeState_ = MergeState::kWaitForGlobalMerge;
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  // The peers extracted their intermediate results before the barrier and
+  // are blocked until 'promises' are realized.
+  for (auto& peer : peers) {
+    auto* aggregation =
+        dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(aggregation);
+    VELOX_CHECK_NOT_NULL(aggregation->groupingSet_);
+    groupingSet_->mergeGlobalAggregation(*aggregation->groupingSet_);
+  }
+  addRuntimeStat("numMergedGlobalAggregations", RuntimeCounter(peers.size()));
+}
+
+void HashAggregation::startPartitionedMerge() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    mergeState_ = MergeState::kWaitForPartition;
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  // The last driver to partition its groups assigns a partition to each
+  // driver. The peers are blocked until 'promises' are realized.
+  std::vector<HashAggregation*> aggregations{this};
+  std::vector<std::shared_ptr<GroupingSet>> groupingSets{groupingSet_};
+  for (auto& peer : peers) {
+    auto* aggregation =
+        dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(aggregation);
+    VELOX_CHECK_NOT_NULL(aggregation->groupingSet_);
+    aggregations.push_back(aggregation);
+    groupingSets.push_back(aggregation->groupingSet_);
+  }
+  for (auto i = 0; i < aggregations.size(); ++i) {
+    aggregations[i]->mergePeers_ = groupingSets;
+    aggregations[i]->mergePartition_ = i;
+  }
+  mergeState_ = MergeState::kMerge;
+}
+
+bool HashAggregation::finishPartitionedMerge() {
+  switch (mergeState_) {
+    case MergeState::kNone:
+      return true;
+    case MergeState::kWaitForPartition:
+    case MergeState::kWaitForMerge:
+    case MergeState::kWaitForGlobalMerge:
+      return false;
+    case MergeState::kMerge:
+      break;
+  }
+
+  groupingSet_->mergePartition(mergePeers_, mergePartition_);
+
+  // The groups of this driver are read by the peers until all of them have
+  // merged their partitions.
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    mergeState_ = MergeState::kWaitForMerge;
+    return false;
+  }
+  peers.clear();
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  mergePeers_.clear();
+  mergeState_ = MergeState::kNone;
+  return true;
+}
+
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (mergeState_ == MergeState::kNone || mergeState_ == MergeState::kMerge) {
+    return BlockingReason::kNotBlocked;
+  }
+  if (future_.valid()) {
+    *future = std::move(future_);
+    return BlockingReason::kWaitForAggregationMerge;
+  }
+  // The peers have finished.
+  if (mergeState_ == MergeState::kWaitForPartition) {
+    mergeState_ = MergeState::kMerge;
+  } else if (mergeState_ == MergeState::kWaitForGlobalMerge) {
+    // The last driver has merged the accumulators of this one.
+    finished_ = true;
+    mergeState_ = MergeState::kNone;
+  } else {
+    mergePeers_.clear();
+    mergeState_ = MergeState::kNone;
+  }
+  return BlockingReason::kNotBlocked;
 }
 
 bool HashAggregation::isFinished() {
@@ -403,7 +853,14 @@ void HashAggregation::reclaim(
 
   updateEstimatedOutputRowSize();
 
-  if (noMoreInput_) {
+  if (distinctSet_ != nullptr) {
+    // 'groupingSet_' has not started its output. 'distinctSet_' can only
+    // spill before it produces the rows new to it.
+    if (!noMoreInput_) {
+      distinctSet_->spill();
+    }
+    groupingSet_->spill();
+  } else if (noMoreInput_) {
     if (groupingSet_->hasSpilled()) {
       LOG(WARNING)
           << "Can't reclaim from aggregation operator which has spilled and is under output processing, pool "
@@ -438,6 +895,15 @@ void HashAggregation::close() {
   Operator::close();
 
   output_ = nullptr;
+  sketchedInputs_.clear();
+  keySketch_.reset();
+  sketchAllocator_.reset();
+  distinctOutput_ = nullptr;
+  distinctSet_.reset();
+  // On abort, the grouping sets of the peers may still be referenced from a
+  // partitioned merge. They must go before the memory pools of their
+  // operators.
+  mergePeers_.clear();
   groupingSet_.reset();
 }
 
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
+
+#include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
 
@@ -34,14 +37,13 @@ class HashAggregation : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_ && !partialFull_;
+    return !noMoreInput_ && !partialFull_ &&
+        (keySketch_ != nullptr || sketchedInputs_.empty());
   }
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -70,10 +72,84 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Adds the grouping keys of 'input' to 'keySketch_' and holds 'input' in
+  // 'sketchedInputs_'. Calls finishKeySketch() after
+  // 'abandonPartialAggregationSketchRows' rows.
+  void addSketchedInput(const RowVectorPtr& input);
+
+  // Abandons partial aggregation if the estimated number of groups of
+  // 'sketchedInputs_' is not much less than their number of rows. The held
+  // inputs are then passed through by getOutput(). Otherwise adds them to the
+  // hash table.
+  void finishKeySketch();
+
+  void addInputToGroupingSet(const RowVectorPtr& input, bool mayPushdown);
+
+  // Creates 'distinctSet_' on the grouping keys in 'keyHashers' and the
+  // inputs of the aggregates. See QueryConfig::kHashAggregationDistinctDedup.
+  void createDistinctSet(
+      const RowTypePtr& inputType,
+      const std::vector<std::unique_ptr<VectorHasher>>& keyHashers);
+
+  // Adds 'input' to 'distinctSet_' and the rows of 'input' new to it to
+  // 'groupingSet_'.
+  void addDistinctInput(const RowVectorPtr& input);
+
+  // Adds a batch of the rows of the spilled 'distinctSet_' that are new to it
+  // to 'groupingSet_'. Calls finishInput() after the last batch.
+  void addSpilledDistinctInput();
+
+  // Finishes the input of 'groupingSet_' after noMoreInput().
+  void finishInput();
+
+  // Returns true if all the rows of the last input added to 'groupingSet_'
+  // are in groups created by that input.
+  bool lastInputHitNewGroupsOnly();
+
+  // Returns true if the memory reserved by the query exceeds
+  // 'partialAggregationFlushQueryMemoryPct_' of its max capacity.
+  bool queryMemoryUnderPressure() const;
+
+  void abandonPartialAggregation();
+
   RowVectorPtr getDistinctOutput();
 
   void updateEstimatedOutputRowSize();
 
+  // State of the merge of the groups of all drivers by partition. See
+  // QueryConfig::kHashAggregationPartitionedMerge.
+  enum class MergeState {
+    // Not merging or merge is done.
+    kNone,
+    // Waiting for the peers to partition their groups.
+    kWaitForPartition,
+    // Ready to merge 'mergePartition_'.
+    kMerge,
+    // Waiting for the peers to merge their partitions.
+    kWaitForMerge,
+    // Waiting for the last driver of a global aggregation to merge the
+    // intermediate results of this driver into its own.
+    kWaitForGlobalMerge,
+  };
+
+  // Returns true if the drivers of this aggregation merge their groups by
+  // partition, or their accumulators for a global aggregation.
+  bool usePartitionedMerge() const;
+
+  // Waits for all peers of a global aggregation to finish their input. The
+  // last one merges the intermediate results of the peers into its own
+  // accumulators and produces the only output row. The peers finish without
+  // output.
+  void startGlobalMerge();
+
+  // Waits for all peers to partition their groups. The last one hands each
+  // peer a partition to merge.
+  void startPartitionedMerge();
+
+  // Merges 'mergePartition_' and waits for all peers to finish their merge.
+  // Returns true if the output of the merged partition can be produced.
+  bool finishPartitionedMerge();
+
   std::shared_ptr<const core::AggregationNode> aggregationNode_;
 
   const bool isPartialOutput_;
@@ -86,9 +162,16 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // True if a partial aggregation flushes its groups when an input has no
+  // groups in common with them. See
+  // QueryConfig::kPartialAggregationClusteredFlush.
+  const bool flushClusteredInput_;
+  // See QueryConfig::kPartialAggregationFlushQueryMemoryPct.
+  const int32_t partialAggregationFlushQueryMemoryPct_;
 
   int64_t maxPartialAggregationMemoryUsage_;
-  std::unique_ptr<GroupingSet> groupingSet_;
+  // Shared with the peers during a partitioned merge.
+  std::shared_ptr<GroupingSet> groupingSet_;
 
   // Size of a single output row estimated using
   // 'groupingSet_->estimateRowSize()'. If spilling, this value is set to max
@@ -96,11 +179,31 @@ class HashAggregation : public Operator {
   std::optional<int64_t> estimatedOutputRowSize_;
 
   bool partialFull_ = false;
+  // True if 'partialFull_' is set because of clustered input.
+  bool clusteredInputFlush_{false};
+  // True if 'partialFull_' is set because the query memory is under pressure.
+  bool memoryPressureFlush_{false};
+  // The groups created by the last input. Used by
+  // lastInputHitNewGroupsOnly().
+  folly::F14FastSet<char*> newGroupRows_;
   bool newDistincts_ = false;
   bool finished_ = false;
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
 
+  // Set while the grouping keys of the first input rows are sketched. See
+  // QueryConfig::kAbandonPartialAggregationSketchRows.
+  const int32_t abandonPartialAggregationSketchRows_;
+  std::unique_ptr<HashStringAllocator> sketchAllocator_;
+  std::unique_ptr<common::hll::DenseHll> keySketch_;
+  std::vector<std::unique_ptr<VectorHasher>> sketchHashers_;
+  raw_vector<uint64_t> sketchHashes_;
+  SelectivityVector sketchRows_;
+  // The inputs held back while sketching. Passed through by getOutput() if
+  // the aggregation is abandoned.
+  std::vector<RowVectorPtr> sketchedInputs_;
+  int64_t numSketchedRows_{0};
+
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
   bool mayPushdown_ = false;
@@ -114,6 +217,34 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // De-duplicates the grouping keys and the inputs of aggregates over
+  // distinct inputs. Only the rows new to it are added to 'groupingSet_'.
+  // Reset once all its rows are added. See
+  // QueryConfig::kHashAggregationDistinctDedup.
+  std::unique_ptr<GroupingSet> distinctSet_;
+  // The input channels of the columns of 'distinctSet_'.
+  std::vector<column_index_t> distinctChannels_;
+  RowTypePtr distinctType_;
+  RowTypePtr aggregationInputType_;
+  std::optional<common::SpillConfig> distinctSpillConfig_;
+  // Possibly reusable output vector of 'distinctSet_'.
+  RowVectorPtr distinctOutput_;
+
+  // True if the drivers merge their groups by partition after all input.
+  bool partitionedMerge_{false};
+
+  MergeState mergeState_{MergeState::kNone};
+
+  // Future for waiting on the peers in 'mergeState_'.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
+  // The grouping sets of all drivers, including this one. Set by the last
+  // driver to partition its groups.
+  std::vector<std::shared_ptr<GroupingSet>> mergePeers_;
+
+  // The partition of 'mergePeers_' this driver merges and outputs.
+  int32_t mergePartition_{0};
 };
 
 } // namespace facebook::velox::exec
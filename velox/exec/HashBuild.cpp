@@ -19,6 +19,7 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/SpillHistory.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
 
@@ -26,6 +27,9 @@ using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
 namespace {
+// Number of key hashes tracked by the skewed key summary of a HashBuild.
+constexpr int32_t kSkewedKeySummaryCapacity = 128;
+
 // Map HashBuild 'state' to the corresponding driver blocking reason.
 BlockingReason fromStateToBlockingReason(HashBuild::State state) {
   switch (state) {
@@ -45,6 +49,22 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
       VELOX_UNREACHABLE(HashBuild::stateName(state));
   }
 }
+
+// Returns the integer key of type 'kind' at 'offset' in 'row'.
+int64_t integerKeyAt(TypeKind kind, const char* row, int32_t offset) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return RowContainer::valueAt<int8_t>(row, offset);
+    case TypeKind::SMALLINT:
+      return RowContainer::valueAt<int16_t>(row, offset);
+    case TypeKind::INTEGER:
+      return RowContainer::valueAt<int32_t>(row, offset);
+    case TypeKind::BIGINT:
+      return RowContainer::valueAt<int64_t>(row, offset);
+    default:
+      VELOX_UNREACHABLE("Unexpected key type {}", mapTypeKindToName(kind));
+  }
+}
 } // namespace
 
 HashBuild::HashBuild(
@@ -58,7 +78,7 @@ HashBuild::HashBuild(
           joinNode->id(),
           "HashBuild",
           joinNode->canSpill(driverCtx->queryConfig())
-              ? driverCtx->makeSpillConfig(operatorId)
+              ? driverCtx->makeSpillConfig(operatorId, joinNode.get())
               : std::nullopt),
       joinNode_(std::move(joinNode)),
       joinType_{joinNode_->joinType()},
@@ -67,6 +87,7 @@ HashBuild::HashBuild(
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
+      skewedKeyMinRows_(driverCtx->queryConfig().joinSkewedKeyMinRows()),
       keyChannelMap_(joinNode_->rightKeys().size()) {
   VELOX_CHECK(pool()->trackUsage());
   VELOX_CHECK_NOT_NULL(joinBridge_);
@@ -112,9 +133,29 @@ HashBuild::HashBuild(
   }
 
   tableType_ = ROW(std::move(names), std::move(types));
+  if (joinNode_->useHashTableCache()) {
+    const auto& task = operatorCtx_->task();
+    cacheEntry_ = HashTableCache::instance().get(
+        task->queryCtx(),
+        planNodeId(),
+        operatorCtx_->driverCtx()->splitGroupId,
+        task->taskId());
+    if (cacheEntry_->isBuilder(task->taskId())) {
+      cachePool_ = cacheEntry_->pool();
+      VELOX_CHECK_NOT_NULL(cachePool_);
+    }
+  }
   setupTable();
   setupSpiller();
   stateCleared_ = false;
+
+  // The probe rows of skewed keys are not shared if the probe side may spill.
+  if (skewedKeyMinRows_ > 0 && !spillEnabled() && cacheEntry_ == nullptr &&
+      !nullAware_ && (isInnerJoin(joinType_) || isLeftJoin(joinType_))) {
+    skewedKeySummary_ = std::make_unique<
+        functions::ApproxMostFrequentStreamSummary<uint64_t>>();
+    skewedKeySummary_->setCapacity(kSkewedKeySummaryCapacity);
+  }
 }
 
 void HashBuild::initialize() {
@@ -142,6 +183,7 @@ void HashBuild::setupTable() {
   for (int i = numKeys; i < tableType_->size(); ++i) {
     dependentTypes.emplace_back(tableType_->childAt(i));
   }
+  auto* tablePool = cachePool_ != nullptr ? cachePool_.get() : pool();
   if (joinNode_->isRightJoin() || joinNode_->isFullJoin() ||
       joinNode_->isRightSemiProjectJoin()) {
     // Do not ignore null keys.
@@ -153,7 +195,7 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        tablePool);
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -173,7 +215,7 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool);
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -184,7 +226,7 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool);
     }
   }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
@@ -247,6 +289,16 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   spillChildVectors_.resize(spillType_->size());
 }
 
+void HashBuild::recordSpillHistory(const SpillPartitionId& partitionId) {
+  const auto* config = spillConfig();
+  const uint8_t numPartitionBits = partitionId.partitionBitOffset() +
+      config->numPartitionBits - config->startPartitionBit;
+  if (numPartitionBits > config->numPartitionBits) {
+    SpillHistory::instance().recordPartitionBits(
+        SpillHistory::fingerprint(*joinNode_), numPartitionBits);
+  }
+}
+
 bool HashBuild::isInputFromSpill() const {
   return spillInputReader_ != nullptr;
 }
@@ -381,6 +433,10 @@ void HashBuild::addInput(RowVectorPtr input) {
     return;
   }
 
+  if (skewedKeySummary_ != nullptr) {
+    addSkewedKeyInput();
+  }
+
   if (analyzeKeys_ && hashes_.size() < activeRows_.end()) {
     hashes_.resize(activeRows_.end());
   }
@@ -632,6 +688,9 @@ void HashBuild::noMoreInput() {
 }
 
 void HashBuild::noMoreInputInternal() {
+  if (maybeUseCachedTable(&future_)) {
+    return;
+  }
   if (!finishHashBuild()) {
     return;
   }
@@ -732,18 +791,44 @@ bool HashBuild::finishHashBuild() {
     spiller_->finishSpill(spillPartitions);
     removeEmptyPartitions(spillPartitions);
   }
+  if (!spillPartitions.empty() &&
+      operatorCtx_->driverCtx()->queryConfig().spillHistoryEnabled()) {
+    recordSpillHistory(spillPartitions.begin()->first);
+  }
 
   // TODO: re-enable parallel join build with spilling triggered after
   // https://github.com/facebookincubator/velox/issues/3567 is fixed.
   const bool allowParallelJoinBuild =
       !otherTables.empty() && spillPartitions.empty();
+  folly::Executor* buildExecutor = allowParallelJoinBuild
+      ? operatorCtx_->task()->queryCtx()->executor()
+      : nullptr;
+  std::shared_ptr<JoinBuildWorkQueue> buildWorkQueue;
+  if (buildExecutor != nullptr &&
+      numRows >= operatorCtx_->driverCtx()
+                     ->queryConfig()
+                     .minTableRowsForParallelJoinBuild()) {
+    // Continues the peers now so that they run the build work on their
+    // threads instead of waiting for the table.
+    buildWorkQueue = std::make_shared<JoinBuildWorkQueue>(buildExecutor);
+    buildExecutor = buildWorkQueue.get();
+    joinBridge_->setBuildWorkQueue(buildWorkQueue);
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+    promises.clear();
+  }
+  auto buildWorkQueueGuard = folly::makeGuard([&]() {
+    if (buildWorkQueue != nullptr) {
+      buildWorkQueue->close();
+    }
+  });
   CpuWallTiming timing;
   {
     CpuWallTimer cpuWallTimer{timing};
     table_->prepareJoinTable(
         std::move(otherTables),
-        allowParallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
-                               : nullptr,
+        buildExecutor,
         isInputFromSpill() ? spillConfig()->startPartitionBit
                            : BaseHashTable::kNoSpillInputStartPartitionBit);
   }
@@ -752,8 +837,24 @@ bool HashBuild::finishHashBuild() {
       RuntimeCounter(timing.wallNanos, RuntimeCounter::Unit::kNanos));
 
   addRuntimeStats();
-  joinBridge_->setHashTable(
-      std::move(table_), std::move(spillPartitions), joinHasNullKeys_);
+  if (cacheEntry_ != nullptr) {
+    VELOX_CHECK(spillPartitions.empty());
+    joinBridge_->setCachedHashTable(
+        cacheEntry_->setTable(std::move(table_), joinHasNullKeys_),
+        joinHasNullKeys_);
+  } else {
+    // The probe side does not push down filters while there is spilled data
+    // to restore or when it reads spilled input.
+    auto keyBloomFilters = spillPartitions.empty() && !isInputFromSpill()
+        ? makeBloomFilters()
+        : std::vector<std::shared_ptr<const common::Filter>>{};
+    joinBridge_->setHashTable(
+        std::move(table_),
+        std::move(spillPartitions),
+        joinHasNullKeys_,
+        findSkewedKeys(otherBuilds),
+        std::move(keyBloomFilters));
+  }
   if (spillEnabled()) {
     stateCleared_ = true;
   }
@@ -769,6 +870,44 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+bool HashBuild::maybeUseCachedTable(ContinueFuture* future) {
+  if (cacheEntry_ == nullptr || cachePool_ != nullptr) {
+    return false;
+  }
+  auto cached = cacheEntry_->tableOrFuture(future);
+  if (!cached.has_value()) {
+    if (future == nullptr) {
+      return false;
+    }
+    VELOX_CHECK(future->valid());
+    waitForCachedTable_ = true;
+    setState(State::kWaitForBuild);
+    return true;
+  }
+  if (cached->table != nullptr) {
+    joinBridge_->setCachedHashTable(
+        std::move(cached->table), cached->hasNullKeys);
+  } else if (!joinBridge_->usesCachedHashTable()) {
+    // The builder task failed or the table has been released by all its
+    // users. Build the table from the input of this task.
+    cacheEntry_.reset();
+    return false;
+  }
+  // NOTE: once a peer has handed the table over, this finishes even if the
+  // probe side has released it meanwhile.
+  stats_.wlock()->addRuntimeStat("hashTableCacheHits", RuntimeCounter(1));
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stateCleared_ = true;
+    table_.reset();
+  }
+  pool()->release();
+  // The rest of the input is not needed.
+  noMoreInput_ = true;
+  setState(State::kFinish);
+  return true;
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -900,6 +1039,139 @@ void HashBuild::processSpillInput() {
   noMoreInputInternal();
 }
 
+void HashBuild::addSkewedKeyInput() {
+  const auto& hashers = table_->hashers();
+  skewedKeyHashes_.resize(activeRows_.end());
+  for (auto i = 0; i < hashers.size(); ++i) {
+    hashers[i]->hash(activeRows_, i > 0, skewedKeyHashes_);
+  }
+  activeRows_.applyToSelected(
+      [&](auto row) { skewedKeySummary_->insert(skewedKeyHashes_[row]); });
+  numSkewedKeySummaryRows_ += activeRows_.countSelected();
+}
+
+std::shared_ptr<const SkewedKeyHashes> HashBuild::findSkewedKeys(
+    const std::vector<HashBuild*>& otherBuilds) const {
+  if (skewedKeySummary_ == nullptr) {
+    return nullptr;
+  }
+  functions::ApproxMostFrequentStreamSummary<uint64_t> summary;
+  summary.setCapacity(kSkewedKeySummaryCapacity);
+  uint64_t numRows{0};
+  std::string serialized;
+  auto addSummary = [&](const HashBuild& build) {
+    serialized.resize(build.skewedKeySummary_->serializedByteSize());
+    build.skewedKeySummary_->serialize(serialized.data());
+    summary.mergeSerialized(serialized.data());
+    numRows += build.numSkewedKeySummaryRows_;
+  };
+  addSummary(*this);
+  for (const auto* build : otherBuilds) {
+    addSummary(*build);
+  }
+
+  // The count of a hash in the summary exceeds its number of rows by at most
+  // 'numRows' / capacity, so that a skewed key has at least
+  // 'skewedKeyMinRows_' rows.
+  const uint64_t minCount =
+      skewedKeyMinRows_ + numRows / kSkewedKeySummaryCapacity;
+  auto skewedKeys = std::make_shared<SkewedKeyHashes>();
+  for (auto i = 0; i < summary.size(); ++i) {
+    if (static_cast<uint64_t>(summary.counts()[i]) >= minCount) {
+      skewedKeys->insert(summary.values()[i]);
+    }
+  }
+  if (skewedKeys->empty()) {
+    return nullptr;
+  }
+  stats_.wlock()->addRuntimeStat(
+      "skewedBuildKeys", RuntimeCounter(skewedKeys->size()));
+  return skewedKeys;
+}
+
+std::vector<std::shared_ptr<const common::Filter>>
+HashBuild::makeBloomFilters() const {
+  // Same join types as the dynamic filters of HashProbe.
+  if (!isInnerJoin(joinType_) && !isLeftSemiFilterJoin(joinType_) &&
+      !isRightSemiFilterJoin(joinType_) && !isRightSemiProjectJoin(joinType_)) {
+    return {};
+  }
+  const uint64_t maxBytes = operatorCtx_->driverCtx()
+                                ->queryConfig()
+                                .hashProbeBloomFilterPushdownMaxSize();
+  if (maxBytes == 0 || table_->numDistinct() == 0) {
+    return {};
+  }
+  const auto& hashers = table_->hashers();
+  std::vector<std::shared_ptr<const common::Filter>> filters(hashers.size());
+  bool hasFilter = false;
+  for (auto i = 0; i < hashers.size(); ++i) {
+    // Keys with an exact filter from VectorHasher::getFilter() do not need a
+    // Bloom filter.
+    if (table_->hashMode() != BaseHashTable::HashMode::kHash &&
+        hashers[i]->hasFilter()) {
+      continue;
+    }
+    filters[i] = makeBloomFilter(i, maxBytes);
+    hasFilter |= filters[i] != nullptr;
+  }
+  if (!hasFilter) {
+    return {};
+  }
+  return filters;
+}
+
+std::shared_ptr<const common::Filter> HashBuild::makeBloomFilter(
+    column_index_t keyIndex,
+    uint64_t maxBytes) const {
+  const auto kind = table_->hashers()[keyIndex]->typeKind();
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      break;
+    default:
+      return nullptr;
+  }
+
+  const auto numRows = table_->numDistinct();
+  if (numRows == 0 || numRows > std::numeric_limits<int32_t>::max()) {
+    return nullptr;
+  }
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(numRows);
+  if (bloomFilter->serializedSize() > maxBytes) {
+    return nullptr;
+  }
+
+  constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  for (auto* rowContainer : table_->allRows()) {
+    const auto column = rowContainer->columnAt(keyIndex);
+    RowContainerIterator iter;
+    while (const auto numListed =
+               rowContainer->listRows(&iter, kBatchSize, rows.data())) {
+      for (auto i = 0; i < numListed; ++i) {
+        if (RowContainer::isNullAt(rows[i], column)) {
+          continue;
+        }
+        const auto value = integerKeyAt(kind, rows[i], column.offset());
+        bloomFilter->insert(common::BigintValuesUsingBloomFilter::hash(value));
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+    }
+  }
+  if (min > max) {
+    return nullptr;
+  }
+  return std::make_shared<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), false);
+}
+
 void HashBuild::addRuntimeStats() {
   // Report range sizes and number of distinct values for the join keys.
   const auto& hashers = table_->hashers();
@@ -931,6 +1203,10 @@ void HashBuild::addRuntimeStats() {
     lockedStats->runtimeStats[BaseHashTable::kNumTombstones] =
         RuntimeMetric(hashTableStats.numTombstones);
   }
+  if (hashTableStats.hugePageBytes != 0) {
+    lockedStats->runtimeStats[BaseHashTable::kHugePageBytes] = RuntimeMetric(
+        hashTableStats.hugePageBytes, RuntimeCounter::Unit::kBytes);
+  }
 
   // Add max spilling level stats if spilling has been triggered.
   if (spiller_ != nullptr && spiller_->isAnySpilled()) {
@@ -946,6 +1222,8 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
     case State::kRunning:
       if (isInputFromSpill()) {
         processSpillInput();
+      } else if (!noMoreInput_) {
+        maybeUseCachedTable(nullptr);
       }
       break;
     case State::kYield:
@@ -963,6 +1241,15 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
       }
       break;
     case State::kWaitForBuild:
+      if (!future_.valid() && waitForCachedTable_) {
+        setRunning();
+        waitForCachedTable_ = false;
+        noMoreInputInternal();
+        break;
+      }
+      if (!future_.valid() && runBuildWorkOrWait()) {
+        break;
+      }
       [[fallthrough]];
     case State::kWaitForProbe:
       if (!future_.valid()) {
@@ -981,6 +1268,20 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
   return fromStateToBlockingReason(state_);
 }
 
+bool HashBuild::runBuildWorkOrWait() {
+  auto buildWorkQueue = joinBridge_->buildWorkQueue();
+  if (buildWorkQueue == nullptr) {
+    return false;
+  }
+  uint64_t numItems{0};
+  const bool wait = buildWorkQueue->runOrWait(&future_, numItems);
+  if (numItems > 0) {
+    stats_.wlock()->addRuntimeStat(
+        "joinBuildItemsRunByPeer", RuntimeCounter(numItems));
+  }
+  return wait;
+}
+
 bool HashBuild::isFinished() {
   return state_ == State::kFinish;
 }
@@ -1179,5 +1480,11 @@ void HashBuild::close() {
     spiller_.reset();
     table_.reset();
   }
+  if (cachePool_ != nullptr) {
+    // Lets the other tasks build their own tables if this task did not
+    // finish the cached one.
+    cacheEntry_->setFailed();
+  }
+  cacheEntry_.reset();
 }
 } // namespace facebook::velox::exec
@@ -17,12 +17,14 @@
 
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/Spiller.h"
 #include "velox/exec/UnorderedStreamReader.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/Expr.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -117,6 +119,10 @@ class HashBuild final : public Operator {
     return canReclaim();
   }
 
+  // Records the partition bits used by the spill level of 'partitionId' in
+  // SpillHistory if more than the configured bits.
+  void recordSpillHistory(const SpillPartitionId& partitionId);
+
   // Indicates if the input is read from spill data or not.
   bool isInputFromSpill() const;
 
@@ -202,6 +208,43 @@ class HashBuild final : public Operator {
   // will be added to the joined output.
   void removeInputRowsForAntiJoinFilter();
 
+  // Invoked by a task that does not build the cached table of a join with
+  // core::HashJoinNode::useHashTableCache() set. Hands the cached table over to
+  // the probe side and finishes if the table has been built. Returns true if
+  // the table is used or, if 'future' is not null, the operator waits for it
+  // in 'kWaitForBuild' state. Returns false if the table is not available and
+  // the operator builds its own.
+  bool maybeUseCachedTable(ContinueFuture* future);
+
+  // Invoked by a peer of the last HashBuild to finish while it builds the
+  // table. Runs the queued build work of the table and returns true if the
+  // operator waits for more in 'future_'. Returns false once the table is
+  // built.
+  bool runBuildWorkOrWait();
+
+  // Adds the keys of 'activeRows_' of the decoded input to
+  // 'skewedKeySummary_'.
+  void addSkewedKeyInput();
+
+  // Returns the hashes of the skewed keys in the key summaries of this and
+  // 'otherBuilds' or nullptr if there are none.
+  std::shared_ptr<const SkewedKeyHashes> findSkewedKeys(
+      const std::vector<HashBuild*>& otherBuilds) const;
+
+  // Returns a Bloom filter for each join key without an exact dynamic filter
+  // for HashProbe to push down, or an empty vector if there are none. An
+  // element is nullptr if its key has no Bloom filter. Invoked by the last
+  // builder on the merged table, so that the probe operators share the
+  // filters.
+  std::vector<std::shared_ptr<const common::Filter>> makeBloomFilters() const;
+
+  // Returns a Bloom filter over the values of the key at 'keyIndex' in
+  // 'table_', or nullptr if the key is not an integer, the filter would be
+  // larger than 'maxBytes' or all keys are null.
+  std::shared_ptr<const common::Filter> makeBloomFilter(
+      column_index_t keyIndex,
+      uint64_t maxBytes) const;
+
   void addRuntimeStats();
 
   // Indicates if this hash build operator is under non-reclaimable state or
@@ -223,6 +266,17 @@ class HashBuild final : public Operator {
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
+  // Set if the join shares its table with the other tasks of the query.
+  std::shared_ptr<HashTableCache::Entry> cacheEntry_;
+
+  // The pool of the table of 'cacheEntry_' if the task of this operator builds
+  // it. 'table_' is made in this pool instead of the operator pool.
+  std::shared_ptr<memory::MemoryPool> cachePool_;
+
+  // True while waiting in 'kWaitForBuild' state for the table of
+  // 'cacheEntry_' to be built by another task.
+  bool waitForCachedTable_{false};
+
   bool exceededMaxSpillLevelLimit_{false};
 
   State state_{State::kRunning};
@@ -266,6 +320,20 @@ class HashBuild final : public Operator {
   // Temporary space for hash numbers.
   raw_vector<uint64_t> hashes_;
 
+  // See QueryConfig::kJoinSkewedKeyMinRows.
+  const uint64_t skewedKeyMinRows_;
+
+  // Approximate counts of the most frequent key hashes of the input. Set if
+  // the join looks for skewed keys.
+  std::unique_ptr<functions::ApproxMostFrequentStreamSummary<uint64_t>>
+      skewedKeySummary_;
+
+  // Number of rows added to 'skewedKeySummary_'.
+  uint64_t numSkewedKeySummaryRows_{0};
+
+  // Temporary space for the key hashes added to 'skewedKeySummary_'.
+  raw_vector<uint64_t> skewedKeyHashes_;
+
   // Set of active rows during addInput().
   SelectivityVector activeRows_;
 
@@ -21,6 +21,80 @@ namespace {
 static const char* kSpillProbedFlagColumnName = "__probedFlag";
 }
 
+void JoinBuildWorkQueue::add(folly::Func func) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!closed_) {
+      items_.push_back(std::move(func));
+      promises = std::move(promises_);
+    }
+  }
+  if (func) {
+    // Closed. 'func' is left empty when queued.
+    func();
+    return;
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  if (executor_ != nullptr) {
+    executor_->add([weakQueue = weak_from_this()]() {
+      if (auto queue = weakQueue.lock()) {
+        queue->runOne();
+      }
+    });
+  }
+}
+
+bool JoinBuildWorkQueue::runOne() {
+  folly::Func func;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (items_.empty()) {
+      return false;
+    }
+    func = std::move(items_.front());
+    items_.pop_front();
+  }
+  func();
+  return true;
+}
+
+bool JoinBuildWorkQueue::runOrWait(ContinueFuture* future, uint64_t& numItems) {
+  for (;;) {
+    if (runOne()) {
+      ++numItems;
+      continue;
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!items_.empty()) {
+      continue;
+    }
+    if (closed_) {
+      return false;
+    }
+    promises_.emplace_back("JoinBuildWorkQueue::runOrWait");
+    *future = promises_.back().getSemiFuture();
+    return true;
+  }
+}
+
+void JoinBuildWorkQueue::close() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    // The builder has run all the work it is waiting for, so the items left
+    // are no-ops.
+    items_.clear();
+    closed_ = true;
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
 void HashJoinBridge::start() {
   std::lock_guard<std::mutex> l(mutex_);
   started_ = true;
@@ -36,7 +110,9 @@ void HashJoinBridge::addBuilder() {
 void HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
-    bool hasNullKeys) {
+    bool hasNullKeys,
+    std::shared_ptr<const SkewedKeyHashes> skewedKeyHashes,
+    std::vector<std::shared_ptr<const common::Filter>> keyBloomFilters) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
 
   auto spillPartitionIdSet = toSpillPartitionIdSet(spillPartitionSet);
@@ -65,13 +141,55 @@ void HashJoinBridge::setHashTable(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        std::move(restoringMergedPartitionIds_));
+    buildResult_->skewedKeyHashes = std::move(skewedKeyHashes);
+    buildResult_->keyBloomFilters = std::move(keyBloomFilters);
     restoringSpillPartitionId_.reset();
+    restoringMergedPartitionIds_.clear();
     promises = std::move(promises_);
   }
   notify(std::move(promises));
 }
 
+void HashJoinBridge::setCachedHashTable(
+    std::shared_ptr<BaseHashTable> table,
+    bool hasNullKeys) {
+  VELOX_CHECK_NOT_NULL(table, "setCachedHashTable called with null table");
+
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    if (usesCachedHashTable_) {
+      return;
+    }
+    VELOX_CHECK(!buildResult_.has_value());
+    VELOX_CHECK(spillPartitionSets_.empty());
+    usesCachedHashTable_ = true;
+    buildResult_ =
+        HashBuildResult(std::move(table), std::nullopt, {}, hasNullKeys);
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+bool HashJoinBridge::usesCachedHashTable() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return usesCachedHashTable_;
+}
+
+void HashJoinBridge::setBuildWorkQueue(
+    std::shared_ptr<JoinBuildWorkQueue> queue) {
+  std::lock_guard<std::mutex> l(mutex_);
+  buildWorkQueue_ = std::move(queue);
+}
+
+std::shared_ptr<JoinBuildWorkQueue> HashJoinBridge::buildWorkQueue() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return buildWorkQueue_;
+}
+
 void HashJoinBridge::setSpilledHashTable(SpillPartitionSet spillPartitionSet) {
   VELOX_CHECK(
       !spillPartitionSet.empty(), "Spilled table partitions can't be empty");
@@ -99,6 +217,7 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
 
     buildResult_ = HashBuildResult{};
     restoringSpillPartitionId_.reset();
+    restoringMergedPartitionIds_.clear();
     spillPartitions.swap(spillPartitionSets_);
     promises = std::move(promises_);
   }
@@ -123,7 +242,7 @@ std::optional<HashJoinBridge::HashBuildResult> HashJoinBridge::tableOrFuture(
   return std::nullopt;
 }
 
-bool HashJoinBridge::probeFinished() {
+bool HashJoinBridge::probeFinished(uint64_t maxRestoreMergeBytes) {
   std::vector<ContinuePromise> promises;
   bool hasSpillInput = false;
   {
@@ -143,10 +262,24 @@ bool HashJoinBridge::probeFinished() {
     if (!spillPartitionSets_.empty()) {
       hasSpillInput = true;
       restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
-      restoringSpillShards_ =
-          spillPartitionSets_.begin()->second->split(numBuilders_);
-      VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
+      auto partition = std::move(spillPartitionSets_.begin()->second);
       spillPartitionSets_.erase(spillPartitionSets_.begin());
+      // The partitions of the same spill level follow the first one. The
+      // partitions spilled while restoring the merged ones have a higher bit
+      // offset than all the pending ones, as with a single restored partition.
+      while (maxRestoreMergeBytes > 0 && !spillPartitionSets_.empty()) {
+        auto it = spillPartitionSets_.begin();
+        if (it->first.partitionBitOffset() !=
+                restoringSpillPartitionId_->partitionBitOffset() ||
+            partition->size() + it->second->size() > maxRestoreMergeBytes) {
+          break;
+        }
+        restoringMergedPartitionIds_.push_back(it->first);
+        partition->merge(std::move(*it->second));
+        spillPartitionSets_.erase(it);
+      }
+      restoringSpillShards_ = partition->split(numBuilders_);
+      VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
     }
     promises = std::move(promises_);
   }
@@ -185,6 +318,22 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   return SpillInput(std::move(spillShard));
 }
 
+void HashJoinBridge::addSkewedProbeInput(RowVectorPtr input) {
+  VELOX_CHECK_NOT_NULL(input);
+  std::lock_guard<std::mutex> l(mutex_);
+  skewedProbeInputs_.push_back(std::move(input));
+}
+
+RowVectorPtr HashJoinBridge::takeSkewedProbeInput() {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (skewedProbeInputs_.empty()) {
+    return nullptr;
+  }
+  auto input = std::move(skewedProbeInputs_.front());
+  skewedProbeInputs_.pop_front();
+  return input;
+}
+
 bool isLeftNullAwareJoinWithFilter(
     const std::shared_ptr<const core::HashJoinNode>& joinNode) {
   return (joinNode->isAntiJoin() || joinNode->isLeftSemiProjectJoin() ||
@@ -15,6 +15,11 @@
  */
 #pragma once
 
+#include <deque>
+
+#include <folly/Executor.h>
+#include <folly/container/F14Set.h>
+
 #include "velox/exec/HashTable.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/MemoryReclaimer.h"
@@ -26,6 +31,47 @@ namespace test {
 class HashJoinBridgeTestHelper;
 }
 
+/// Runs the work items of the merge of the build side tables on the build
+/// Drivers of a join. The last HashBuild to finish passes this as the executor
+/// of BaseHashTable::prepareJoinTable() and the peer HashBuild operators, which
+/// would otherwise wait for the table, run the queued items until close(). Each
+/// item is also scheduled on 'executor' if not null, so that the items run in
+/// parallel also without help from the peers. Thread safe.
+class JoinBuildWorkQueue
+    : public folly::Executor,
+      public std::enable_shared_from_this<JoinBuildWorkQueue> {
+ public:
+  explicit JoinBuildWorkQueue(folly::Executor* executor)
+      : executor_(executor) {}
+
+  /// Queues 'func' and wakes up the waiting helpers. Runs 'func' inline if
+  /// 'this' is closed.
+  void add(folly::Func func) override;
+
+  /// Runs the queued items on the calling thread and adds their number to
+  /// 'numItems'. Returns true and sets 'future' to wait for more items if
+  /// 'this' is not closed, otherwise returns false.
+  bool runOrWait(ContinueFuture* future, uint64_t& numItems);
+
+  /// Invoked when the table is built. Wakes up the waiting helpers.
+  void close();
+
+ private:
+  // Runs the next queued item. Returns false if there is none.
+  bool runOne();
+
+  folly::Executor* const executor_;
+
+  std::mutex mutex_;
+  std::deque<folly::Func> items_;
+  bool closed_{false};
+  std::vector<ContinuePromise> promises_;
+};
+
+/// Hashes of the skewed build side keys of a join. See
+/// QueryConfig::kJoinSkewedKeyMinRows.
+using SkewedKeyHashes = folly::F14FastSet<uint64_t>;
+
 /// Hands over a hash table from a multi-threaded build pipeline to a
 /// multi-threaded probe pipeline. This is owned by shared_ptr by all the build
 /// and probe Operator instances concerned. Corresponds to the Presto concept of
@@ -42,11 +88,28 @@ class HashJoinBridge : public JoinBridge {
   /// Invoked by the build operator to set the built hash table.
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
+  /// 'skewedKeyHashes' is set if the build side has skewed keys.
+  /// 'keyBloomFilters' are the Bloom filters on the join keys for the probe
+  /// side to push down, see HashBuildResult::keyBloomFilters.
   void setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
+      bool hasNullKeys,
+      std::shared_ptr<const SkewedKeyHashes> skewedKeyHashes = nullptr,
+      std::vector<std::shared_ptr<const common::Filter>> keyBloomFilters =
+          {});
+
+  /// Invoked by the build operators to set a table shared with the other tasks
+  /// of the query through HashTableCache. Unlike setHashTable(), this is
+  /// invoked by every build operator of a task that probes a table built by
+  /// another task and only the first call sets the table.
+  void setCachedHashTable(
+      std::shared_ptr<BaseHashTable> table,
       bool hasNullKeys);
 
+  /// True if setCachedHashTable() has been invoked.
+  bool usesCachedHashTable();
+
   /// Invoked by the probe operator to set the spilled hash table while the
   /// probing. The function puts the spilled table partitions into
   /// 'spillPartitionSets_' stack. This only applies if the disk spilling is
@@ -55,8 +118,16 @@ class HashJoinBridge : public JoinBridge {
 
   void setAntiJoinHasNullKeys();
 
+  /// Invoked by the last HashBuild to finish to share the work of building
+  /// the table with its peers. Replaces the queue of a previous build.
+  void setBuildWorkQueue(std::shared_ptr<JoinBuildWorkQueue> queue);
+
+  /// Returns the queue of the table being built, or nullptr if none.
+  std::shared_ptr<JoinBuildWorkQueue> buildWorkQueue();
+
   /// Represents the result of HashBuild operators: a hash table, an optional
-  /// restored spill partition id associated with the table, and the spilled
+  /// restored spill partition id associated with the table, the ids of the
+  /// other spill partitions restored together with it, and the spilled
   /// partitions while building the table if not empty. In case of an anti join,
   /// a build side entry with a null in a join key makes the join return
   /// nothing. In this case, HashBuild operators finishes early without
@@ -66,10 +137,12 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        std::vector<SpillPartitionId> _mergedPartitionIds = {})
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
+          mergedPartitionIds(std::move(_mergedPartitionIds)),
           spillPartitionIds(std::move(_spillPartitionIds)) {}
 
     HashBuildResult() : hasNullKeys(true) {}
@@ -77,7 +150,17 @@ class HashJoinBridge : public JoinBridge {
     bool hasNullKeys;
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
+    /// The spill partitions restored into 'table' together with
+    /// 'restoredPartitionId'. The probe side joins their probe rows as well.
+    std::vector<SpillPartitionId> mergedPartitionIds;
     SpillPartitionIdSet spillPartitionIds;
+    /// Set if the probe rows of some keys are to be shared among the probe
+    /// operators.
+    std::shared_ptr<const SkewedKeyHashes> skewedKeyHashes;
+    /// Bloom filters on the join keys made once by the last HashBuild. Empty
+    /// or one per key, with nullptr for keys that have none. The probe
+    /// operators clone these into their dynamic filters.
+    std::vector<std::shared_ptr<const common::Filter>> keyBloomFilters;
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -90,8 +173,10 @@ class HashJoinBridge : public JoinBridge {
   /// set one of the previously spilled partition to restore. The HashBuild
   /// operators will then build the next hash table from the selected spilled
   /// one. The function returns true if there is spill data to be restored by
-  /// HashBuild operators next.
-  bool probeFinished();
+  /// HashBuild operators next. If 'maxRestoreMergeBytes' is not 0, the next
+  /// spilled partitions of the same spill level are restored together with
+  /// the selected one while their total spilled size is within this limit.
+  bool probeFinished(uint64_t maxRestoreMergeBytes = 0);
 
   /// Contains the spill input for one HashBuild operator: a shard of previously
   /// spilled partition data. 'spillPartition' is null if there is no more spill
@@ -112,11 +197,27 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartition' will be set to null in the returned SpillInput.
   std::optional<SpillInput> spillInputOrFuture(ContinueFuture* future);
 
+  /// Invoked by a HashProbe operator to share 'input', which has probe rows of
+  /// skewed keys, with the other probe operators of the join.
+  void addSkewedProbeInput(RowVectorPtr input);
+
+  /// Returns the next shared probe input or nullptr if there is none. The
+  /// probe operators take the shared inputs after their own input and before
+  /// they finish. An operator that shares inputs thus finishes only after all
+  /// of them have been taken.
+  RowVectorPtr takeSkewedProbeInput();
+
  private:
   uint32_t numBuilders_{0};
 
   std::optional<HashBuildResult> buildResult_;
 
+  bool usesCachedHashTable_{false};
+
+  // Kept after close() since the built table may reference it as its build
+  // executor.
+  std::shared_ptr<JoinBuildWorkQueue> buildWorkQueue_;
+
   // restoringSpillPartitionXxx member variables are populated by the
   // bridge itself. When probe side finished processing, the bridge picks the
   // first partition from 'spillPartitionSets_', splits it into "even" shards
@@ -126,6 +227,9 @@ class HashJoinBridge : public JoinBridge {
   // If not null, set to the currently restoring spill partition id.
   std::optional<SpillPartitionId> restoringSpillPartitionId_;
 
+  // The ids of the spill partitions merged into the restoring one.
+  std::vector<SpillPartitionId> restoringMergedPartitionIds_;
+
   // If 'restoringSpillPartitionId_' is not null, this set to the restoring
   // spill partition data shards. Each shard is expected to have the same number
   // of spill files and will be processed by one of the HashBuild operator.
@@ -137,6 +241,9 @@ class HashJoinBridge : public JoinBridge {
   // memory and engages in recursive spilling.
   SpillPartitionSet spillPartitionSets_;
 
+  // The probe inputs shared by addSkewedProbeInput().
+  std::deque<RowVectorPtr> skewedProbeInputs_;
+
   friend test::HashJoinBridgeTestHelper;
 };
 
@@ -121,7 +121,7 @@ HashProbe::HashProbe(
           joinNode->id(),
           "HashProbe",
           joinNode->canSpill(driverCtx->queryConfig())
-              ? driverCtx->makeSpillConfig(operatorId)
+              ? driverCtx->makeSpillConfig(operatorId, joinNode.get())
               : std::nullopt),
       outputBatchSize_{outputBatchRows()},
       joinNode_(std::move(joinNode)),
@@ -131,6 +131,8 @@ HashProbe::HashProbe(
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
+      joinSpillRestoreMergeBytes_(
+          driverCtx->queryConfig().joinSpillRestoreMergeBytes()),
       filterResult_(1),
       outputTableRows_(outputBatchSize_) {
   VELOX_CHECK_NOT_NULL(joinBridge_);
@@ -266,9 +268,11 @@ void HashProbe::maybeSetupInputSpiller(
 }
 
 void HashProbe::maybeSetupSpillInputReader(
-    const std::optional<SpillPartitionId>& restoredPartitionId) {
+    const std::optional<SpillPartitionId>& restoredPartitionId,
+    const std::vector<SpillPartitionId>& mergedPartitionIds) {
   VELOX_CHECK_NULL(spillInputReader_);
   if (!restoredPartitionId.has_value()) {
+    VELOX_CHECK(mergedPartitionIds.empty());
     return;
   }
   // If 'restoredPartitionId' is not null, then 'table_' is built from the
@@ -278,9 +282,20 @@ void HashProbe::maybeSetupSpillInputReader(
   VELOX_CHECK(iter != spillPartitionSet_.end());
   auto partition = std::move(iter->second);
   VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
+  spillPartitionSet_.erase(iter);
+  for (const auto& mergedPartitionId : mergedPartitionIds) {
+    iter = spillPartitionSet_.find(mergedPartitionId);
+    VELOX_CHECK(iter != spillPartitionSet_.end());
+    partition->merge(std::move(*iter->second));
+    spillPartitionSet_.erase(iter);
+  }
+  if (!mergedPartitionIds.empty()) {
+    addRuntimeStat(
+        "spillRestoreMergedPartitions",
+        RuntimeCounter(mergedPartitionIds.size()));
+  }
   spillInputReader_ = partition->createUnorderedReader(
       spillConfig_->readBufferSize, pool(), &spillStats_);
-  spillPartitionSet_.erase(iter);
 }
 
 void HashProbe::asyncWaitForHashTable() {
@@ -310,8 +325,13 @@ void HashProbe::asyncWaitForHashTable() {
 
   table_ = std::move(hashBuildResult->table);
   VELOX_CHECK_NOT_NULL(table_);
+  if (!spillEnabled()) {
+    skewedKeyHashes_ = std::move(hashBuildResult->skewedKeyHashes);
+  }
 
-  maybeSetupSpillInputReader(hashBuildResult->restoredPartitionId);
+  maybeSetupSpillInputReader(
+      hashBuildResult->restoredPartitionId,
+      hashBuildResult->mergedPartitionIds);
   maybeSetupInputSpiller(hashBuildResult->spillPartitionIds);
   prepareTableSpill(hashBuildResult->restoredPartitionId);
 
@@ -331,11 +351,12 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
-    // push down.
+    // push down. Keys that have no exact filter, e.g. because there are too
+    // many distinct values or the table is in kHash mode, may get the Bloom
+    // filter made by HashBuild.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
@@ -350,10 +371,20 @@ void HashProbe::asyncWaitForHashTable() {
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      std::unique_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(nullAllowed);
+      }
+      if (!filter && !hashBuildResult->keyBloomFilters.empty() &&
+          hashBuildResult->keyBloomFilters[i] != nullptr) {
+        filter = hashBuildResult->keyBloomFilters[i]->clone(nullAllowed);
+        hasBloomDynamicFilters_ = true;
+      }
+      if (filter) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
@@ -386,7 +417,7 @@ void HashProbe::prepareForSpillRestore() {
     return;
   }
   // Notify the hash build operators to build the next hash table.
-  joinBridge_->probeFinished();
+  joinBridge_->probeFinished(joinSpillRestoreMergeBytes_);
 
   wakeupPeerOperators();
 
@@ -536,9 +567,11 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      !hasBloomDynamicFilters_) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -566,6 +599,61 @@ void HashProbe::addInput(RowVectorPtr input) {
     VELOX_CHECK_NULL(input_);
     return;
   }
+  if (skewedKeyHashes_ != nullptr) {
+    input = shareSkewedProbeRows(std::move(input));
+    if (input == nullptr) {
+      return;
+    }
+  }
+  probeInput(std::move(input));
+}
+
+RowVectorPtr HashProbe::shareSkewedProbeRows(RowVectorPtr input) {
+  const auto numInput = input->size();
+  skewedProbeRows_.resize(numInput);
+  skewedProbeRows_.setAll();
+  skewedProbeHashes_.resize(numInput);
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    const auto& key = input->childAt(hashers_[i]->channel())->loadedVector();
+    hashers_[i]->decode(*key, skewedProbeRows_);
+    hashers_[i]->hash(skewedProbeRows_, i > 0, skewedProbeHashes_);
+  }
+  BufferPtr skewedIndices = allocateIndices(numInput, pool());
+  BufferPtr otherIndices = allocateIndices(numInput, pool());
+  auto* rawSkewedIndices = skewedIndices->asMutable<vector_size_t>();
+  auto* rawOtherIndices = otherIndices->asMutable<vector_size_t>();
+  vector_size_t numSkewed{0};
+  vector_size_t numOther{0};
+  for (auto row = 0; row < numInput; ++row) {
+    if (skewedKeyHashes_->count(skewedProbeHashes_[row]) > 0) {
+      rawSkewedIndices[numSkewed++] = row;
+    } else {
+      rawOtherIndices[numOther++] = row;
+    }
+  }
+  if (numSkewed == 0) {
+    return input;
+  }
+  addRuntimeStat("sharedSkewedProbeRows", RuntimeCounter(numSkewed));
+
+  // A peer may probe the shared rows on another thread, so the lazy columns
+  // are loaded here.
+  std::vector<VectorPtr> children;
+  children.reserve(input->childrenSize());
+  for (const auto& child : input->children()) {
+    children.push_back(BaseVector::loadedVectorShared(child));
+  }
+  if (numOther == 0) {
+    joinBridge_->addSkewedProbeInput(std::make_shared<RowVector>(
+        pool(), input->type(), nullptr, numInput, std::move(children)));
+    return nullptr;
+  }
+  joinBridge_->addSkewedProbeInput(
+      wrap(numSkewed, std::move(skewedIndices), probeType_, children, pool()));
+  return wrap(numOther, std::move(otherIndices), probeType_, children, pool());
+}
+
+void HashProbe::probeInput(RowVectorPtr input) {
   input_ = std::move(input);
 
   // Reset passingInputRowsInitialized_ as input_ as changed.
@@ -673,7 +761,7 @@ void HashProbe::prepareOutput(vector_size_t size) {
     BaseVector::prepareForReuse(output, size);
     output_ = std::static_pointer_cast<RowVector>(output);
   } else {
-    output_ = BaseVector::create<RowVector>(outputType_, size, pool());
+    output_ = getResultVector(size);
   }
 }
 
@@ -904,6 +992,16 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
 
   clearIdentityProjectedOutput();
 
+  // Probes the rows shared by the peers before finishing, including the ones
+  // shared by this.
+  while (!input_ && !hasMoreInput() && skewedKeyHashes_ != nullptr) {
+    auto sharedInput = joinBridge_->takeSkewedProbeInput();
+    if (sharedInput == nullptr) {
+      break;
+    }
+    probeInput(std::move(sharedInput));
+  }
+
   if (!input_) {
     if (!hasMoreInput()) {
       if (needLastProbe() && lastProber_) {
@@ -928,7 +1026,7 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
         asyncWaitForHashTable();
       } else {
         if (lastProber_ && spillEnabled()) {
-          joinBridge_->probeFinished();
+          joinBridge_->probeFinished(joinSpillRestoreMergeBytes_);
           wakeupPeerOperators();
         }
         setState(ProbeOperatorState::kFinish);
@@ -958,7 +1056,7 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
   // there is no extra filter we can process each batch of input in one go.
   auto outputBatchSize = (isLeftSemiOrAntiJoinNoFilter || emptyBuildSide)
       ? inputSize
-      : outputBatchSize_;
+      : tunedOutputBatchRows(outputBatchSize_);
   auto mapping =
       initializeRowNumberMapping(outputRowMapping_, outputBatchSize, pool());
   outputTableRows_.resize(outputBatchSize);
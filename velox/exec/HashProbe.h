@@ -190,9 +190,12 @@ class HashProbe : public Operator {
   void maybeSetupInputSpiller(const SpillPartitionIdSet& spillPartitionIds);
 
   // If 'restoredSpillPartitionId' is set, then setup 'spillInputReader_' to
-  // read probe inputs from spilled data on disk.
+  // read probe inputs from spilled data on disk. The probe inputs of
+  // 'mergedPartitionIds', which are restored into the same table, are read
+  // by the same reader.
   void maybeSetupSpillInputReader(
-      const std::optional<SpillPartitionId>& restoredSpillPartitionId);
+      const std::optional<SpillPartitionId>& restoredSpillPartitionId,
+      const std::vector<SpillPartitionId>& mergedPartitionIds);
 
   // Prepares the table spill by checking the spill level limit, setting spill
   // partition bits and table spill type.
@@ -266,6 +269,13 @@ class HashProbe : public Operator {
   /// Decode join key inputs and populate 'nonNullInputRows_'.
   void decodeAndDetectNonNullKeys();
 
+  // Probes 'input', which is either from upstream or shared by a peer.
+  void probeInput(RowVectorPtr input);
+
+  // Shares the rows of 'input' with keys in 'skewedKeyHashes_' with the peer
+  // probe operators. Returns the other rows or nullptr if there are none.
+  RowVectorPtr shareSkewedProbeRows(RowVectorPtr input);
+
   // Invoked when there is no more input from either upstream task or spill
   // input. If there is remaining spilled data, then the last finished probe
   // operator is responsible for notifying the hash build operators to build the
@@ -315,6 +325,9 @@ class HashProbe : public Operator {
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
+  // See QueryConfig::kJoinSpillRestoreMergeBytes.
+  const uint64_t joinSpillRestoreMergeBytes_;
+
   ProbeOperatorState state_{ProbeOperatorState::kWaitForBuild};
 
   // Used for synchronization with the hash probe operators of the same pipeline
@@ -353,6 +366,10 @@ class HashProbe : public Operator {
   // down to the upstream operators.
   tsan_atomic<bool> hasGeneratedDynamicFilters_{false};
 
+  // True if some of the dynamic filters are Bloom filters. These pass false
+  // positives, so the join can not be replaced with them.
+  bool hasBloomDynamicFilters_{false};
+
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
@@ -365,6 +382,14 @@ class HashProbe : public Operator {
   // pipeline.
   std::shared_ptr<BaseHashTable> table_;
 
+  // Set if the probe rows of the skewed build side keys are shared among the
+  // probe operators. See QueryConfig::kJoinSkewedKeyMinRows.
+  std::shared_ptr<const SkewedKeyHashes> skewedKeyHashes_;
+
+  // Temporary space for finding the probe rows of 'skewedKeyHashes_'.
+  SelectivityVector skewedProbeRows_;
+  raw_vector<uint64_t> skewedProbeHashes_;
+
   // Indicates whether there was no input. Used for right semi join project.
   bool noInput_{true};
 
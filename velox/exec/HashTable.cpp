@@ -215,6 +215,7 @@ class ProbeState {
       }
       bucketOffset_ = table.nextBucketOffset(bucketOffset_);
       tagsInTable_ = table.loadTags(bucketOffset_);
+      VELOX_HOT_COUNTER_INC(kHashTableTagLoad);
       hits_ = simd::toBitMask(tagsInTable_ == wantedTags_);
     }
     // Throws here if we have looped through all the buckets in the table.
@@ -250,6 +251,7 @@ class ProbeState {
       bucketOffset_ = table.nextBucketOffset(bucketOffset_);
       tagsInTable_ = BaseHashTable::loadTags(
           reinterpret_cast<uint8_t*>(table.table_), bucketOffset_);
+      VELOX_HOT_COUNTER_INC(kHashTableTagLoad);
       hits_ = simd::toBitMask(tagsInTable_ == wantedTags_) & kFullMask;
     }
     // Throws here if we have looped through all the buckets in the table.
@@ -465,38 +467,25 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
     groupNormalizedKeyProbe(lookup);
     return;
   }
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
+  // Same batching as in joinProbe(). The tags seen by firstProbe() may be
+  // stale after an insert by an earlier row of the batch, so all but the
+  // first row of a batch recheck the tags.
+  ProbeState states[kPrefetchSize];
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   auto rows = lookup.rows.data();
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-
-    state1.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state2.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state3.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state4.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-
-    fullProbe<false>(lookup, state1, false);
-    fullProbe<false>(lookup, state2, true);
-    fullProbe<false>(lookup, state3, true);
-    fullProbe<false>(lookup, state4, true);
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    fullProbe<false>(lookup, state1, false);
+  for (; probeIndex < numProbes; probeIndex += kPrefetchSize) {
+    const int32_t batchSize = std::min(kPrefetchSize, numProbes - probeIndex);
+    for (int32_t i = 0; i < batchSize; ++i) {
+      int32_t row = rows[probeIndex + i];
+      states[i].preProbe(*this, lookup.hashes[row], row);
+    }
+    for (int32_t i = 0; i < batchSize; ++i) {
+      states[i].firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+    }
+    for (int32_t i = 0; i < batchSize; ++i) {
+      fullProbe<false>(lookup, states[i], i > 0);
+    }
   }
 }
 
@@ -587,6 +576,44 @@ void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+const vector_size_t* HashTable<ignoreNullKeys>::probeOrder(
+    HashLookup& lookup) const {
+  // Fewer rows per range do not make consecutive probes hit the same pages.
+  constexpr int32_t kMinRowsPerPartition = 4;
+  const uint64_t tableBytes = capacity_ * tableSlotSize();
+  const int32_t numRows = lookup.rows.size();
+  if (tableBytes < kMinPartitionedProbeBytes) {
+    return lookup.rows.data();
+  }
+  int64_t numPartitions = tableBytes / kProbePartitionBytes;
+  while (numPartitions > 1 && numPartitions * kMinRowsPerPartition > numRows) {
+    numPartitions /= 2;
+  }
+  if (numPartitions <= 1) {
+    return lookup.rows.data();
+  }
+  // A table is a power of two bytes, so the top bits of the bucket offset are
+  // the partition.
+  const int32_t shift = sizeBits_ - __builtin_ctzll(numPartitions);
+  const vector_size_t* rows = lookup.rows.data();
+  const uint64_t* hashes = lookup.hashes.data();
+  std::vector<int32_t> starts(numPartitions + 1, 0);
+  for (int32_t i = 0; i < numRows; ++i) {
+    ++starts[1 + (bucketOffset(hashes[rows[i]]) >> shift)];
+  }
+  for (int32_t i = 1; i <= numPartitions; ++i) {
+    starts[i] += starts[i - 1];
+  }
+  auto& partitionedRows = lookup.partitionedRows;
+  partitionedRows.resize(numRows);
+  for (int32_t i = 0; i < numRows; ++i) {
+    const auto row = rows[i];
+    partitionedRows[starts[bucketOffset(hashes[row]) >> shift]++] = row;
+  }
+  return partitionedRows.data();
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
@@ -599,36 +626,28 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
+  // Probes in batches of kPrefetchSize rows. The buckets of the whole batch
+  // are prefetched, then the tags of each bucket are compared with one SIMD
+  // compare, which prefetches the first matching row. Keys are compared only
+  // after that, so that the cache misses of a large table overlap. The hits
+  // are by row, so the rows may be probed in any order.
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    state2.firstProbe(*this, 0);
-    state3.firstProbe(*this, 0);
-    state4.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
-    fullProbe<true>(lookup, state2, false);
-    fullProbe<true>(lookup, state3, false);
-    fullProbe<true>(lookup, state4, false);
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
+  const vector_size_t* rows = probeOrder(lookup);
+  const uint64_t* hashes = lookup.hashes.data();
+  ProbeState states[kPrefetchSize];
+  for (; probeIndex < numProbes; probeIndex += kPrefetchSize) {
+    const int32_t batchSize = std::min(kPrefetchSize, numProbes - probeIndex);
+    for (int32_t i = 0; i < batchSize; ++i) {
+      int32_t row = rows[probeIndex + i];
+      states[i].preProbe(*this, hashes[row], row);
+    }
+    for (int32_t i = 0; i < batchSize; ++i) {
+      states[i].firstProbe(*this, 0);
+    }
+    for (int32_t i = 0; i < batchSize; ++i) {
+      fullProbe<true>(lookup, states[i], false);
+    }
   }
 }
 
@@ -678,7 +697,7 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = probeOrder(lookup);
   ProbeState states[kPrefetchSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
@@ -720,13 +739,35 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   // The total size is 8 bytes per slot, in groups of 16 slots with 16 bytes of
   // tags and 16 * 6 bytes of pointers and a padding of 16 bytes to round up the
   // cache line.
-  const auto numPages =
-      memory::AllocationTraits::numPages(size * tableSlotSize());
-  rows_->pool()->allocateContiguous(numPages, tableAllocation_);
-  table_ = tableAllocation_.data<char*>();
+  allocateTableMemory(byteSize);
   memset(table_, 0, capacity_ * sizeof(char*));
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::allocateTableMemory(uint64_t bytes) {
+  const auto numPages = memory::AllocationTraits::numPages(bytes);
+  if (bytes < kMinHugePageAlignedBytes) {
+    rows_->pool()->allocateContiguous(numPages, tableAllocation_);
+    table_ = tableAllocation_.data<char*>();
+    return;
+  }
+  table_ = reinterpret_cast<char**>(
+      rows_->pool()->allocateHugePageAligned(numPages, tableAllocation_));
+}
+
+template <bool ignoreNullKeys>
+int64_t HashTable<ignoreNullKeys>::hugePageBytes() const {
+  if (table_ == nullptr) {
+    return 0;
+  }
+  const auto begin = reinterpret_cast<uint64_t>(table_);
+  const auto end = begin + capacity_ * tableSlotSize();
+  constexpr auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
+  const auto alignedBegin = bits::roundUp(begin, kHugePageSize);
+  const auto alignedEnd = end / kHugePageSize * kHugePageSize;
+  return alignedEnd > alignedBegin ? alignedEnd - alignedBegin : 0;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::clear(bool freeTable) {
   if (otherTables_.size() > 0) {
@@ -871,17 +912,7 @@ bool HashTable<ignoreNullKeys>::canApplyParallelJoinBuild() const {
 }
 
 template <bool ignoreNullKeys>
-void HashTable<ignoreNullKeys>::parallelJoinBuild() {
-  process::TraceContext trace("HashTable::parallelJoinBuild");
-  TestValue::adjust(
-      "facebook::velox::exec::HashTable::parallelJoinBuild", rows_->pool());
-  VELOX_CHECK_LE(1 + otherTables_.size(), std::numeric_limits<uint8_t>::max());
-  const uint8_t numPartitions = 1 + otherTables_.size();
-  VELOX_CHECK_GT(
-      capacity_ / numPartitions,
-      minTableSizeForParallelJoinBuild_,
-      "Less than {} entries per partition for parallel build",
-      minTableSizeForParallelJoinBuild_);
+void HashTable<ignoreNullKeys>::setPartitionBounds(uint8_t numPartitions) {
   buildPartitionBounds_.resize(numPartitions + 1);
   // Pad the tail of buildPartitionBounds_ to max int.
   std::fill(
@@ -902,6 +933,21 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
         "Turn on VELOX_ENABLE_INT64_BUILD_PARTITION_BOUND to avoid integer overflow in buildPartitionBounds_");
   }
   buildPartitionBounds_.back() = sizeMask_ + 1;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::parallelJoinBuild() {
+  process::TraceContext trace("HashTable::parallelJoinBuild");
+  TestValue::adjust(
+      "facebook::velox::exec::HashTable::parallelJoinBuild", rows_->pool());
+  VELOX_CHECK_LE(1 + otherTables_.size(), std::numeric_limits<uint8_t>::max());
+  const uint8_t numPartitions = 1 + otherTables_.size();
+  VELOX_CHECK_GT(
+      capacity_ / numPartitions,
+      minTableSizeForParallelJoinBuild_,
+      "Less than {} entries per partition for parallel build",
+      minTableSizeForParallelJoinBuild_);
+  setPartitionBounds(numPartitions);
   std::vector<std::shared_ptr<AsyncSource<bool>>> partitionSteps;
   std::vector<std::shared_ptr<AsyncSource<bool>>> buildSteps;
   // rowPartitions are used in the async threads, so declare them before the
@@ -1059,6 +1105,148 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
   }
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::canApplyParallelRehash(
+    bool initNormalizedKeys) const {
+  if (isJoinBuild_ || buildExecutor_ == nullptr ||
+      minTableSizeForParallelRehash_ == 0) {
+    return false;
+  }
+  // The normalized keys and the value ids of the rows in kArray mode are
+  // recomputed on a single thread since the VectorHashers can change.
+  if (hashMode_ == HashMode::kArray || initNormalizedKeys) {
+    return false;
+  }
+  return capacity_ / 2 > minTableSizeForParallelRehash_;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::parallelRehash() {
+  process::TraceContext trace("HashTable::parallelRehash");
+  const uint8_t numPartitions = std::min<uint64_t>(
+      kMaxParallelRehashPartitions, capacity_ / minTableSizeForParallelRehash_);
+  setPartitionBounds(numPartitions);
+
+  // Lists the rows and then hashes and partitions disjoint ranges of them in
+  // parallel. The hashes are kept so that the insert steps do not recompute
+  // them.
+  const auto numRows = rows_->numRows();
+  auto* pool = rows_->pool();
+  auto rowsBuffer = AlignedBuffer::allocate<char*>(numRows, pool);
+  auto hashesBuffer = AlignedBuffer::allocate<uint64_t>(numRows, pool);
+  auto partitionsBuffer = AlignedBuffer::allocate<uint8_t>(numRows, pool);
+  auto* rows = rowsBuffer->asMutable<char*>();
+  auto* hashes = hashesBuffer->asMutable<uint64_t>();
+  auto* partitions = partitionsBuffer->asMutable<uint8_t>();
+  RowContainerIterator iter;
+  int64_t numListed = 0;
+  while (const auto numBatchRows = rows_->listRows(
+             &iter,
+             std::min<int64_t>(numRows - numListed, 1 << 20),
+             rows + numListed)) {
+    numListed += numBatchRows;
+  }
+  VELOX_CHECK_EQ(numListed, numRows);
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> partitionSteps;
+  std::vector<std::shared_ptr<AsyncSource<bool>>> insertSteps;
+  std::vector<std::vector<char*>> overflowPerPartition(numPartitions);
+  auto sync = folly::makeGuard([&]() {
+    // This is executed on returning path, possibly in unwinding, so must not
+    // throw.
+    std::exception_ptr error;
+    syncWorkItems(partitionSteps, error, offThreadBuildTiming_, true);
+    syncWorkItems(insertSteps, error, offThreadBuildTiming_, true);
+  });
+
+  const int64_t rowsPerStep = (numRows + numPartitions - 1) / numPartitions;
+  for (auto i = 0; i < numPartitions; ++i) {
+    const auto begin = std::min<int64_t>(numRows, i * rowsPerStep);
+    const auto end = std::min<int64_t>(numRows, begin + rowsPerStep);
+    partitionSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, begin, end, rows, hashes, partitions]() {
+          constexpr int32_t kBatch = 1024;
+          raw_vector<uint64_t> batchHashes(kBatch);
+          for (auto start = begin; start < end; start += kBatch) {
+            const auto batchSize = std::min<int64_t>(kBatch, end - start);
+            hashRows(
+                folly::Range<char**>(rows + start, batchSize),
+                false,
+                batchHashes);
+            for (auto j = 0; j < batchSize; ++j) {
+              hashes[start + j] = batchHashes[j];
+              partitions[start + j] = findPartition(
+                  bucketOffset(batchHashes[j]),
+                  buildPartitionBounds_.data(),
+                  buildPartitionBounds_.size());
+            }
+          }
+          return std::make_unique<bool>(true);
+        }));
+    buildExecutor_->add([step = partitionSteps.back()]() { step->prepare(); });
+  }
+  std::exception_ptr error;
+  syncWorkItems(partitionSteps, error, offThreadBuildTiming_);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  for (auto i = 0; i < numPartitions; ++i) {
+    insertSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, i, numRows, rows, hashes, partitions, &overflowPerPartition]() {
+          insertGroupByPartition(
+              i, numRows, rows, hashes, partitions, overflowPerPartition[i]);
+          return std::make_unique<bool>(true);
+        }));
+    buildExecutor_->add([step = insertSteps.back()]() { step->prepare(); });
+  }
+  syncWorkItems(insertSteps, error, offThreadBuildTiming_);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  raw_vector<uint64_t> overflowHashes;
+  for (auto& overflows : overflowPerPartition) {
+    overflowHashes.resize(overflows.size());
+    hashRows(
+        folly::Range<char**>(overflows.data(), overflows.size()),
+        false,
+        overflowHashes);
+    insertForGroupBy(
+        overflows.data(), overflowHashes.data(), overflows.size());
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::insertGroupByPartition(
+    uint8_t partition,
+    int64_t numRows,
+    char** rows,
+    const uint64_t* hashes,
+    const uint8_t* partitions,
+    std::vector<char*>& overflow) {
+  constexpr int32_t kBatch = 1024;
+  char* batchRows[kBatch];
+  uint64_t batchHashes[kBatch];
+  TableInsertPartitionInfo partitionInfo{
+      buildPartitionBounds_[partition],
+      buildPartitionBounds_[partition + 1],
+      overflow};
+  int32_t numBatchRows = 0;
+  for (int64_t i = 0; i < numRows; ++i) {
+    if (partitions[i] != partition) {
+      continue;
+    }
+    batchRows[numBatchRows] = rows[i];
+    batchHashes[numBatchRows] = hashes[i];
+    if (++numBatchRows == kBatch) {
+      insertForGroupBy(batchRows, batchHashes, numBatchRows, &partitionInfo);
+      numBatchRows = 0;
+    }
+  }
+  insertForGroupBy(batchRows, batchHashes, numBatchRows, &partitionInfo);
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::insertBatch(
     char** groups,
@@ -1080,7 +1268,8 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::insertForGroupBy(
     char** groups,
     uint64_t* hashes,
-    int32_t numGroups) {
+    int32_t numGroups,
+    TableInsertPartitionInfo* partitionInfo) {
   if (hashMode_ == HashMode::kArray) {
     for (auto i = 0; i < numGroups; ++i) {
       auto index = hashes[i];
@@ -1116,6 +1305,11 @@ void HashTable<ignoreNullKeys>::insertForGroupBy(
           break;
         }
         offset = nextBucketOffset(offset);
+        if (partitionInfo != nullptr && !partitionInfo->inRange(offset)) {
+          partitionInfo->addOverflow(groups[i]);
+          inserted = true;
+          break;
+        }
         tagsInTable =
             BaseHashTable::loadTags(reinterpret_cast<uint8_t*>(table_), offset);
       }
@@ -1282,6 +1476,10 @@ void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
     parallelJoinBuild();
     return;
   }
+  if (canApplyParallelRehash(initNormalizedKeys)) {
+    parallelRehash();
+    return;
+  }
   raw_vector<uint64_t> hashes;
   hashes.resize(kHashBatchSize);
   char* groups[kHashBatchSize];
@@ -1311,9 +1509,7 @@ void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
   TestValue::adjust("facebook::velox::exec::HashTable::setHashMode", &mode);
   if (mode == HashMode::kArray) {
     const auto bytes = capacity_ * tableSlotSize();
-    const auto numPages = memory::AllocationTraits::numPages(bytes);
-    rows_->pool()->allocateContiguous(numPages, tableAllocation_);
-    table_ = tableAllocation_.data<char*>();
+    allocateTableMemory(bytes);
     memset(table_, 0, bytes);
     hashMode_ = HashMode::kArray;
     rehash(true);
@@ -1584,8 +1780,10 @@ std::string HashTable<ignoreNullKeys>::toString() {
     int64_t occupied = 0;
     if (table_ && tableAllocation_.data() && tableAllocation_.size()) {
       // 'size_' and 'table_' may not be set if initializing.
-      uint64_t size = std::min<uint64_t>(
-          tableAllocation_.size() / sizeof(char*), capacity_);
+      const auto tableBytes = tableAllocation_.size() -
+          (reinterpret_cast<char*>(table_) - tableAllocation_.data<char>());
+      uint64_t size =
+          std::min<uint64_t>(tableBytes / sizeof(char*), capacity_);
       for (int32_t i = 0; i < size; ++i) {
         occupied += table_[i] != nullptr;
       }
@@ -1712,6 +1910,15 @@ void HashTable<ignoreNullKeys>::prepareJoinTable(
       }
     }
   }
+  // The table may outlive the build input, e.g. in the HashTableCache.
+  for (auto& hasher : hashers_) {
+    hasher->releaseDictionaryCaches();
+  }
+  for (auto& other : otherTables_) {
+    for (auto& hasher : other->hashers_) {
+      hasher->releaseDictionaryCaches();
+    }
+  }
   numDistinct_ = rows()->numRows();
   for (const auto& other : otherTables_) {
     numDistinct_ += other->rows()->numRows();
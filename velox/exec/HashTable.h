@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/HotCounters.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/exec/Operator.h"
@@ -95,6 +96,10 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// Scratch memory for joinProbe. 'rows' reordered by the range of the table
+  /// they hit.
+  raw_vector<vector_size_t> partitionedRows;
 };
 
 struct HashTableStats {
@@ -103,6 +108,8 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Bytes of the table in huge page aligned ranges.
+  int64_t hugePageBytes{0};
 };
 
 class BaseHashTable {
@@ -129,6 +136,19 @@ class BaseHashTable {
   static inline const std::string kNumRehashes{"hashtable.numRehashes"};
   static inline const std::string kNumDistinct{"hashtable.numDistinct"};
   static inline const std::string kNumTombstones{"hashtable.numTombstones"};
+  static inline const std::string kHugePageBytes{"hashtable.hugePageBytes"};
+
+  /// Tables of at least this size are allocated on huge page boundaries.
+  static constexpr uint64_t kMinHugePageAlignedBytes = 16 << 20;
+
+  /// Join probes into tables of at least this size visit the probe rows in
+  /// the order of the range of the table that they hit, so that consecutive
+  /// probes touch the same pages and the misses are mostly not TLB misses.
+  static constexpr uint64_t kMinPartitionedProbeBytes = 64 << 20;
+
+  /// The size of a range of the table in partitioned join probes. The same as
+  /// a huge page.
+  static constexpr uint64_t kProbePartitionBytes = 2 << 20;
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
@@ -267,6 +287,13 @@ class BaseHashTable {
       folly::Executor* executor = nullptr,
       int8_t spillInputStartPartitionBit = kNoSpillInputStartPartitionBit) = 0;
 
+  /// Makes the rehash of a growing group by table fill disjoint ranges of
+  /// buckets in parallel on 'executor' once each range has more than
+  /// 'minTableSizePerPartition' entries. 0 disables the parallel rehash.
+  virtual void setParallelRehash(
+      folly::Executor* executor,
+      uint32_t minTableSizePerPartition) = 0;
+
   /// Returns the memory footprint in bytes for any data structures
   /// owned by 'this'.
   virtual int64_t allocatedBytes() const = 0;
@@ -546,7 +573,11 @@ class HashTable : public BaseHashTable {
 
   HashTableStats stats() const override {
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        capacity_,
+        numRehashes_,
+        numDistinct_,
+        numTombstones_,
+        hugePageBytes()};
   }
 
   bool hasDuplicateKeys() const override {
@@ -578,6 +609,14 @@ class HashTable : public BaseHashTable {
       int8_t spillInputStartPartitionBit =
           kNoSpillInputStartPartitionBit) override;
 
+  void setParallelRehash(
+      folly::Executor* executor,
+      uint32_t minTableSizePerPartition) override {
+    VELOX_CHECK(!isJoinBuild_);
+    buildExecutor_ = executor;
+    minTableSizeForParallelRehash_ = minTableSizePerPartition;
+  }
+
   uint64_t hashTableSizeIncrease(int32_t numNewDistinct) const override {
     if (numDistinct_ + numNewDistinct > rehashSize()) {
       // If rehashed, the table adds size_ entries (i.e. doubles),
@@ -674,6 +713,9 @@ class HashTable : public BaseHashTable {
   static_assert(sizeof(Bucket) == 128);
   static constexpr uint64_t kBucketSize = sizeof(Bucket);
 
+  // The maximum number of threads for parallelRehash().
+  static constexpr uint64_t kMaxParallelRehashPartitions = 8;
+
   // Returns the bucket at byte offset 'offset' from 'table_'.
   Bucket* bucketAt(int64_t offset) const {
     VELOX_DCHECK_EQ(0, offset & (kBucketSize - 1));
@@ -742,6 +784,13 @@ class HashTable : public BaseHashTable {
   // a power of 2.
   void allocateTables(uint64_t size);
 
+  // Allocates 'bytes' for 'table_'. Large tables start on a huge page
+  // boundary so that random probes hit fewer TLB entries.
+  void allocateTableMemory(uint64_t bytes);
+
+  // Returns the bytes of 'table_' in huge page aligned ranges.
+  int64_t hugePageBytes() const;
+
   // 'initNormalizedKeys' is passed to 'rehash' --> 'rehash' --> 'insertBatch'.
   // If it's false and the table is in normalized keys mode,
   // the keys are retrieved from the row and the hash is made
@@ -775,8 +824,14 @@ class HashTable : public BaseHashTable {
   // Inserts 'numGroups' entries into 'this'. 'groups' point to
   // contents in a RowContainer owned by 'this'. 'hashes' are the hash
   // numbers or array indices (if kArray mode) for each
-  // group. 'groups' is expected to have no duplicate keys.
-  void insertForGroupBy(char** groups, uint64_t* hashes, int32_t numGroups);
+  // group. 'groups' is expected to have no duplicate keys. If not null,
+  // 'partitionInfo' limits the inserts to its range of the table like in
+  // insertForJoin.
+  void insertForGroupBy(
+      char** groups,
+      uint64_t* hashes,
+      int32_t numGroups,
+      TableInsertPartitionInfo* partitionInfo = nullptr);
 
   // Checks if we can apply parallel table build optimization for hash join.
   // The function returns true if all of the following conditions:
@@ -797,6 +852,36 @@ class HashTable : public BaseHashTable {
   // else.
   void parallelJoinBuild();
 
+  // Checks if the rehash of a group by table can be split into parallel
+  // inserts into disjoint ranges of the table. This requires the executor and
+  // the minimum size from setParallelRehash(), a table not in kArray mode,
+  // 'initNormalizedKeys' false and at least two ranges of more than the
+  // minimum size.
+  bool canApplyParallelRehash(bool initNormalizedKeys) const;
+
+  // Rehashes a group by table on up to kMaxParallelRehashPartitions threads
+  // using 'buildExecutor_'. The rows are hashed and assigned a range of
+  // buckets in parallel, then each thread inserts the rows of its range. The
+  // rows whose probe sequence runs past the end of their range are inserted
+  // sequentially after all else, like in parallelJoinBuild(). Since the rows
+  // of a group by table have distinct keys, the inserts do not compare keys.
+  void parallelRehash();
+
+  // Inserts the first 'numRows' of 'rows' whose entry in 'partitions' is
+  // 'partition' into 'this'. 'hashes' are the hashes of 'rows'. The rows that
+  // would have gone past the end of the partition are returned in 'overflow'.
+  void insertGroupByPartition(
+      uint8_t partition,
+      int64_t numRows,
+      char** rows,
+      const uint64_t* hashes,
+      const uint8_t* partitions,
+      std::vector<char*>& overflow);
+
+  // Sets 'buildPartitionBounds_' to 'numPartitions' ranges of about the same
+  // number of buckets.
+  void setPartitionBounds(uint8_t numPartitions);
+
   // Inserts the rows in 'partition' from this and 'otherTables' into 'this'.
   // The rows that would have gone past the end of the partition are returned in
   // 'overflow'.
@@ -841,6 +926,12 @@ class HashTable : public BaseHashTable {
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Returns the rows of 'lookup' in the order in which joinProbe visits them.
+  // If the table is at least kMinPartitionedProbeBytes, the rows are sorted
+  // into 'lookup.partitionedRows' by the kProbePartitionBytes range of the
+  // table that their hash falls in. Otherwise returns 'lookup.rows'.
+  const vector_size_t* probeOrder(HashLookup& lookup) const;
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -916,6 +1007,7 @@ class HashTable : public BaseHashTable {
   }
 
   void incrementProbes(int32_t n = 1) {
+    VELOX_HOT_COUNTER_ADD(kHashTableProbe, n);
     if (kTrackLoads) {
       VELOX_DCHECK_GT(n, 0);
       numProbes_ += n;
@@ -923,18 +1015,21 @@ class HashTable : public BaseHashTable {
   }
 
   void incrementTagLoads() const {
+    VELOX_HOT_COUNTER_INC(kHashTableTagLoad);
     if (kTrackLoads) {
       ++numTagLoads_;
     }
   }
 
   void incrementRowLoads() const {
+    VELOX_HOT_COUNTER_INC(kHashTableRowLoad);
     if (kTrackLoads) {
       ++numRowLoads_;
     }
   }
 
   void incrementHits() const {
+    VELOX_HOT_COUNTER_INC(kHashTableHit);
     if (kTrackLoads) {
       ++numHits_;
     }
@@ -999,12 +1094,16 @@ class HashTable : public BaseHashTable {
   // of cache line  size.
   raw_vector<PartitionBoundIndexType> buildPartitionBounds_;
 
-  // Executor for parallelizing hash join build. This may be the
-  // executor for Drivers. If this executor is indefinitely taken by
-  // other work, the thread of prepareJoinTable() will sequentially
-  // execute the parallel build steps.
+  // Executor for parallelizing hash join build or the rehash of a group by
+  // table. This may be the executor for Drivers. If this executor is
+  // indefinitely taken by other work, the thread of prepareJoinTable() or
+  // rehash() will sequentially execute the parallel build steps.
   folly::Executor* buildExecutor_{nullptr};
 
+  // The minimum number of table entries per partition for parallelRehash().
+  // 0 if the table is not rehashed in parallel.
+  uint32_t minTableSizeForParallelRehash_{0};
+
   //  Counts parallel build rows. Used for consistency check.
   std::atomic<int64_t> numParallelBuildRows_{0};
 
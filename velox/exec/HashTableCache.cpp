@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashTableCache.h"
+#include "velox/exec/MemoryReclaimer.h"
+
+namespace facebook::velox::exec {
+
+HashTableCache::Entry::Entry(
+    std::string key,
+    std::string builderTaskId,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : key_(std::move(key)),
+      builderTaskId_(std::move(builderTaskId)),
+      pool_(std::move(pool)) {}
+
+std::shared_ptr<BaseHashTable> HashTableCache::Entry::setTable(
+    std::unique_ptr<BaseHashTable> table,
+    bool hasNullKeys) {
+  VELOX_CHECK_NOT_NULL(table);
+  std::vector<ContinuePromise> promises;
+  std::shared_ptr<BaseHashTable> sharedTable;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_NOT_NULL(pool_);
+    // The deleter holds the pool so that the rows outlive the builder task.
+    sharedTable = std::shared_ptr<BaseHashTable>(
+        table.release(), [pool = pool_](BaseHashTable* hashTable) {
+          delete hashTable;
+        });
+    // A failed entry has been removed from the cache and its waiters build
+    // their own tables.
+    if (state_ == State::kFailed) {
+      return sharedTable;
+    }
+    VELOX_CHECK(state_ == State::kBuilding);
+    pool_.reset();
+    table_ = sharedTable;
+    hasNullKeys_ = hasNullKeys;
+    state_ = State::kBuilt;
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return sharedTable;
+}
+
+void HashTableCache::Entry::setFailed() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (state_ != State::kBuilding) {
+      return;
+    }
+    state_ = State::kFailed;
+    promises = std::move(promises_);
+  }
+  HashTableCache::instance().remove(key_, this);
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+std::optional<HashTableCache::Entry::CachedTable>
+HashTableCache::Entry::tableOrFuture(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  switch (state_) {
+    case State::kBuilt:
+      return CachedTable{table_.lock(), hasNullKeys_};
+    case State::kFailed:
+      return CachedTable{};
+    case State::kBuilding:
+      if (future != nullptr) {
+        promises_.emplace_back("HashTableCache::Entry::tableOrFuture");
+        *future = promises_.back().getSemiFuture();
+      }
+      return std::nullopt;
+  }
+  VELOX_UNREACHABLE();
+}
+
+// static
+HashTableCache& HashTableCache::instance() {
+  static HashTableCache cache;
+  return cache;
+}
+
+std::shared_ptr<HashTableCache::Entry> HashTableCache::get(
+    const std::shared_ptr<core::QueryCtx>& queryCtx,
+    const core::PlanNodeId& planNodeId,
+    uint32_t splitGroupId,
+    const std::string& taskId) {
+  auto key =
+      fmt::format("{}.{}.{}", queryCtx->queryId(), planNodeId, splitGroupId);
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.queryCtx.expired()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    return it->second.entry;
+  }
+  auto pool = queryCtx->pool()->addLeafChild(
+      fmt::format("hashTableCache.{}.{}", planNodeId, numPools_++),
+      true,
+      MemoryReclaimer::create());
+  auto entry = std::make_shared<Entry>(key, taskId, std::move(pool));
+  entries_.emplace(std::move(key), CacheEntry{queryCtx, entry});
+  return entry;
+}
+
+size_t HashTableCache::size() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return entries_.size();
+}
+
+void HashTableCache::remove(const std::string& key, const Entry* entry) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end() && it->second.entry.get() == entry) {
+    entries_.erase(it);
+  }
+}
+} // namespace facebook::velox::exec
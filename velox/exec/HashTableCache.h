@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/future/VeloxPromise.h"
+#include "velox/core/QueryCtx.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+/// Shares the hash table of a broadcast join build between the tasks of a
+/// query that run in the same process. Each of these tasks receives the full
+/// build side, so the first task to get the entry of a join builds the table
+/// and the others probe it instead of building their own. Used by HashBuild
+/// for joins with core::HashJoinNode::useHashTableCache() set. The probe side
+/// must not modify the table, so the join types that record probed rows are
+/// not supported.
+class HashTableCache {
+ public:
+  /// The table built by one task for the tasks of its query that run the same
+  /// join.
+  class Entry {
+   public:
+    Entry(
+        std::string key,
+        std::string builderTaskId,
+        std::shared_ptr<memory::MemoryPool> pool);
+
+    /// True if the table is built by the task with 'taskId'.
+    bool isBuilder(const std::string& taskId) const {
+      return taskId == builderTaskId_;
+    }
+
+    /// The pool of the table being built. The HashBuild operators of the
+    /// builder task make their tables in this pool, so the built table can
+    /// outlive the builder task. Null after the table is set.
+    const std::shared_ptr<memory::MemoryPool>& pool() const {
+      return pool_;
+    }
+
+    /// Invoked by the builder task to publish the built 'table'. Returns the
+    /// shared table, which keeps 'pool()' alive until the last user releases
+    /// it. The entry only references the table weakly.
+    std::shared_ptr<BaseHashTable> setTable(
+        std::unique_ptr<BaseHashTable> table,
+        bool hasNullKeys);
+
+    /// Invoked when the builder task finishes without setting the table. The
+    /// waiters build their own tables and the entry is removed from the
+    /// cache. No-op if the table was set. A table set after this is returned
+    /// by setTable() but not shared.
+    void setFailed();
+
+    struct CachedTable {
+      std::shared_ptr<BaseHashTable> table;
+      bool hasNullKeys{false};
+    };
+
+    /// Returns the built table, or a null table if the build failed or the
+    /// table has been released by all its users. Returns std::nullopt while
+    /// the table is being built and sets 'future' to wait for it if not null.
+    std::optional<CachedTable> tableOrFuture(ContinueFuture* future);
+
+   private:
+    enum class State { kBuilding, kBuilt, kFailed };
+
+    const std::string key_;
+    const std::string builderTaskId_;
+
+    std::mutex mutex_;
+    State state_{State::kBuilding};
+    std::shared_ptr<memory::MemoryPool> pool_;
+    std::weak_ptr<BaseHashTable> table_;
+    bool hasNullKeys_{false};
+    std::vector<ContinuePromise> promises_;
+  };
+
+  static HashTableCache& instance();
+
+  /// Returns the entry of the join 'planNodeId' in 'splitGroupId' of
+  /// 'queryCtx'. Makes a new entry with the task 'taskId' as the builder if
+  /// there is none.
+  std::shared_ptr<Entry> get(
+      const std::shared_ptr<core::QueryCtx>& queryCtx,
+      const core::PlanNodeId& planNodeId,
+      uint32_t splitGroupId,
+      const std::string& taskId);
+
+  /// Number of entries. Entries of finished queries are removed by the next
+  /// get().
+  size_t size() const;
+
+ private:
+  struct CacheEntry {
+    std::weak_ptr<core::QueryCtx> queryCtx;
+    std::shared_ptr<Entry> entry;
+  };
+
+  // Removes the entry for 'key' if it is 'entry'.
+  void remove(const std::string& key, const Entry* entry);
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, CacheEntry> entries_;
+  // Makes the names of the table pools unique.
+  uint64_t numPools_{0};
+};
+} // namespace facebook::velox::exec
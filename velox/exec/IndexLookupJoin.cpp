@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/IndexLookupJoin.h"
+
+#include "velox/exec/OperatorUtils.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+IndexLookupJoin::IndexLookupJoin(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::IndexLookupJoinNode>& joinNode)
+    : Operator(
+          driverCtx,
+          joinNode->outputType(),
+          operatorId,
+          joinNode->id(),
+          "IndexLookupJoin"),
+      joinType_(joinNode->joinType()),
+      tableHandle_(joinNode->lookupSource()->tableHandle()),
+      columnHandles_(joinNode->lookupSource()->assignments()),
+      lookupType_(joinNode->lookupSource()->outputType()),
+      connectorPool_(driverCtx->task->addConnectorPoolLocked(
+          planNodeId(),
+          driverCtx->pipelineId,
+          driverCtx->driverId,
+          operatorType(),
+          tableHandle_->connectorId())),
+      outputBatchSize_(outputBatchRows()),
+      joinNode_(joinNode) {}
+
+void IndexLookupJoin::initialize() {
+  Operator::initialize();
+  VELOX_CHECK_NOT_NULL(joinNode_);
+
+  const auto& inputType = joinNode_->sources()[0]->outputType();
+  const auto& leftKeys = joinNode_->leftKeys();
+  const auto& rightKeys = joinNode_->rightKeys();
+  std::vector<std::string> keyNames;
+  std::vector<TypePtr> keyTypes;
+  for (auto i = 0; i < leftKeys.size(); ++i) {
+    keyChannels_.push_back(inputType->getChildIdx(leftKeys[i]->name()));
+    keyNames.push_back(rightKeys[i]->name());
+    keyTypes.push_back(rightKeys[i]->type());
+  }
+  keyType_ = ROW(std::move(keyNames), std::move(keyTypes));
+
+  for (column_index_t i = 0; i < inputType->size(); ++i) {
+    const auto outIndex =
+        outputType_->getChildIdxIfExists(inputType->nameOf(i));
+    if (outIndex.has_value()) {
+      identityProjections_.emplace_back(i, outIndex.value());
+    }
+  }
+  for (column_index_t i = 0; i < lookupType_->size(); ++i) {
+    const auto outIndex =
+        outputType_->getChildIdxIfExists(lookupType_->nameOf(i));
+    if (outIndex.has_value()) {
+      lookupProjections_.emplace_back(i, outIndex.value());
+    }
+  }
+
+  auto connector = connector::getConnector(tableHandle_->connectorId());
+  VELOX_USER_CHECK(
+      connector->supportsIndexLookup(),
+      "Connector {} does not support index lookup",
+      tableHandle_->connectorId());
+  connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
+      tableHandle_->connectorId(), planNodeId(), connectorPool_);
+  indexSource_ = connector->createIndexSource(
+      keyType_,
+      lookupType_,
+      tableHandle_,
+      columnHandles_,
+      connectorQueryCtx_.get());
+  joinNode_.reset();
+}
+
+void IndexLookupJoin::addInput(RowVectorPtr input) {
+  // The input columns are wrapped in a dictionary for each batch of results,
+  // so lazy columns are loaded here.
+  for (const auto& child : input->children()) {
+    child->loadedVector();
+  }
+  input_ = std::move(input);
+
+  std::vector<VectorPtr> keys;
+  keys.reserve(keyChannels_.size());
+  for (const auto channel : keyChannels_) {
+    keys.push_back(input_->childAt(channel));
+  }
+  lookupResults_ =
+      indexSource_->lookup(connector::IndexSource::LookupRequest(
+          std::make_shared<RowVector>(
+              pool(), keyType_, nullptr, input_->size(), std::move(keys))));
+  if (isLeftJoin(joinType_)) {
+    inputMatched_.assign(bits::nwords(input_->size()), 0);
+  }
+}
+
+RowVectorPtr IndexLookupJoin::getOutput() {
+  if (input_ == nullptr) {
+    return nullptr;
+  }
+
+  if (lookupResults_ != nullptr) {
+    auto result = lookupResults_->next(outputBatchSize_, lookupFuture_);
+    if (!result.has_value()) {
+      return nullptr;
+    }
+    if (result.value() != nullptr) {
+      if (result.value()->size() == 0) {
+        return nullptr;
+      }
+      return makeOutput(*result.value());
+    }
+    lookupResults_ = nullptr;
+  }
+
+  RowVectorPtr output;
+  if (isLeftJoin(joinType_)) {
+    output = makeMissOutput();
+  }
+  input_ = nullptr;
+  return output;
+}
+
+RowVectorPtr IndexLookupJoin::makeOutput(
+    const connector::IndexSource::LookupResult& result) {
+  const auto size = result.size();
+  if (isLeftJoin(joinType_)) {
+    const auto* hits = result.inputHits->as<vector_size_t>();
+    for (auto i = 0; i < size; ++i) {
+      bits::setBit(inputMatched_.data(), hits[i]);
+    }
+  }
+
+  std::vector<VectorPtr> children(outputType_->size());
+  for (const auto& projection : identityProjections_) {
+    children[projection.outputChannel] = wrapChild(
+        size, result.inputHits, input_->childAt(projection.inputChannel));
+  }
+  for (const auto& projection : lookupProjections_) {
+    children[projection.outputChannel] =
+        result.output->childAt(projection.inputChannel);
+  }
+  return std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, size, std::move(children));
+}
+
+RowVectorPtr IndexLookupJoin::makeMissOutput() {
+  const auto numInput = input_->size();
+  const auto numMisses =
+      numInput - bits::countBits(inputMatched_.data(), 0, numInput);
+  if (numMisses == 0) {
+    return nullptr;
+  }
+
+  BufferPtr indices = allocateIndices(numMisses, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numOut = 0;
+  bits::forEachUnsetBit(inputMatched_.data(), 0, numInput, [&](auto row) {
+    rawIndices[numOut++] = row;
+  });
+
+  std::vector<VectorPtr> children(outputType_->size());
+  for (const auto& projection : identityProjections_) {
+    children[projection.outputChannel] = wrapChild(
+        numMisses, indices, input_->childAt(projection.inputChannel));
+  }
+  for (const auto& projection : lookupProjections_) {
+    children[projection.outputChannel] = BaseVector::createNullConstant(
+        outputType_->childAt(projection.outputChannel), numMisses, pool());
+  }
+  return std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, numMisses, std::move(children));
+}
+
+BlockingReason IndexLookupJoin::isBlocked(ContinueFuture* future) {
+  if (lookupFuture_.valid()) {
+    *future = std::move(lookupFuture_);
+    return BlockingReason::kWaitForConnector;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+void IndexLookupJoin::recordIndexSourceStats() {
+  const auto connectorStats = indexSource_->runtimeStats();
+  auto lockedStats = stats_.wlock();
+  for (const auto& [name, counter] : connectorStats) {
+    if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
+      lockedStats->runtimeStats.emplace(name, RuntimeMetric(counter.unit));
+    } else {
+      VELOX_CHECK_EQ(lockedStats->runtimeStats.at(name).unit, counter.unit);
+    }
+    lockedStats->runtimeStats.at(name).addValue(counter.value);
+  }
+}
+
+void IndexLookupJoin::close() {
+  if (indexSource_ != nullptr) {
+    recordIndexSourceStats();
+  }
+  lookupResults_.reset();
+  indexSource_.reset();
+  Operator::close();
+}
+} // namespace facebook::velox::exec
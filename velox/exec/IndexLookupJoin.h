@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/connectors/Connector.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Implements core::IndexLookupJoinNode. Each input batch is sent as one
+/// lookup to the connector::IndexSource of the table and the rows found are
+/// joined with the input as they arrive. For a left join, the input rows
+/// without a match are produced after all the rows found for their batch.
+class IndexLookupJoin : public Operator {
+ public:
+  IndexLookupJoin(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::IndexLookupJoinNode>& joinNode);
+
+  void initialize() override;
+
+  bool needsInput() const override {
+    return !noMoreInput_ && input_ == nullptr;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+  void close() override;
+
+ private:
+  // Returns the output for the rows of 'result' found for 'input_'.
+  RowVectorPtr makeOutput(
+      const connector::IndexSource::LookupResult& result);
+
+  // Returns the output for the rows of 'input_' without a match for a left
+  // join. Returns nullptr if there are none.
+  RowVectorPtr makeMissOutput();
+
+  // Adds the runtime stats of 'indexSource_' to the stats of 'this'.
+  void recordIndexSourceStats();
+
+  const core::JoinType joinType_;
+  const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
+  const std::
+      unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+          columnHandles_;
+  // The columns of the table returned by the lookups.
+  const RowTypePtr lookupType_;
+  memory::MemoryPool* const connectorPool_;
+  const vector_size_t outputBatchSize_;
+
+  std::shared_ptr<const core::IndexLookupJoinNode> joinNode_;
+
+  // Channels of the join keys in the input.
+  std::vector<column_index_t> keyChannels_;
+  // The key columns of the table with their names in the table.
+  RowTypePtr keyType_;
+  // Maps the channels of 'lookupType_' to the output channels.
+  std::vector<IdentityProjection> lookupProjections_;
+
+  std::shared_ptr<connector::ConnectorQueryCtx> connectorQueryCtx_;
+  std::shared_ptr<connector::IndexSource> indexSource_;
+
+  // The rows found for 'input_'. Null when they have all been returned.
+  std::shared_ptr<connector::IndexSource::LookupResultIterator>
+      lookupResults_;
+  ContinueFuture lookupFuture_{ContinueFuture::makeEmpty()};
+
+  // For a left join, one bit per row of 'input_' that is set if the row has
+  // a match.
+  std::vector<uint64_t> inputMatched_;
+};
+} // namespace facebook::velox::exec
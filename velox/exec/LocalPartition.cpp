@@ -57,7 +57,9 @@ std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
 
 void LocalExchangeQueue::addProducer() {
   queue_.withWLock([&](auto& /*queue*/) {
-    VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
+    VELOX_CHECK(
+        !noMoreProducers_ || pendingProducers_ > 0,
+        "addProducer called after all producers finished");
     ++pendingProducers_;
   });
 }
@@ -168,6 +170,10 @@ bool LocalExchangeQueue::isFinished() {
   return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
 }
 
+bool LocalExchangeQueue::isClosed() {
+  return queue_.withWLock([&](auto& /*queue*/) { return closed_; });
+}
+
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> memoryPromises;
@@ -260,25 +266,26 @@ LocalPartition::LocalPartition(
 }
 
 namespace {
-std::vector<BufferPtr> allocateIndexBuffers(
-    const std::vector<vector_size_t>& sizes,
-    memory::MemoryPool* pool) {
-  std::vector<BufferPtr> indexBuffers;
-  indexBuffers.reserve(sizes.size());
-  for (auto size : sizes) {
-    indexBuffers.push_back(allocateIndices(size, pool));
-  }
-  return indexBuffers;
-}
-
-std::vector<vector_size_t*> getRawIndices(
-    const std::vector<BufferPtr>& indexBuffers) {
-  std::vector<vector_size_t*> rawIndices;
-  rawIndices.reserve(indexBuffers.size());
-  for (auto& buffer : indexBuffers) {
-    rawIndices.emplace_back(buffer->asMutable<vector_size_t>());
-  }
-  return rawIndices;
+// Keeps the buffer with the indices of all partitions alive while a view of
+// the indices of one partition is referenced.
+struct IndicesReleaser {
+  explicit IndicesReleaser(const BufferPtr& indices) : indices_(indices) {}
+  void addRef() const {}
+  void release() const {}
+
+ private:
+  BufferPtr indices_;
+};
+
+// Returns a view of 'size' indices from 'offset' in 'indices'.
+BufferPtr sliceIndices(
+    const BufferPtr& indices,
+    vector_size_t offset,
+    vector_size_t size) {
+  return BufferView<IndicesReleaser>::create(
+      indices->as<uint8_t>() + offset * sizeof(vector_size_t),
+      size * sizeof(vector_size_t),
+      IndicesReleaser(indices));
 }
 
 RowVectorPtr
@@ -329,29 +336,33 @@ void LocalPartition::addInput(RowVectorPtr input) {
     return;
   }
 
+  // Sorts the rows by partition into a single buffer of indices. Each
+  // partition is a dictionary over the input with a view of its range of the
+  // indices, so a batch makes one allocation regardless of the number of
+  // partitions.
   const auto numInput = input->size();
-  std::vector<vector_size_t> maxIndex(numPartitions_, 0);
+  std::vector<vector_size_t> offsets(numPartitions_ + 1, 0);
   for (auto i = 0; i < numInput; ++i) {
-    ++maxIndex[partitions_[i]];
+    ++offsets[partitions_[i] + 1];
   }
-  auto indexBuffers = allocateIndexBuffers(maxIndex, pool());
-  auto rawIndices = getRawIndices(indexBuffers);
-
-  std::fill(maxIndex.begin(), maxIndex.end(), 0);
+  for (auto i = 0; i < numPartitions_; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+  auto indices = allocateIndices(numInput, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  std::vector<vector_size_t> nextIndex(offsets.begin(), offsets.end() - 1);
   for (auto i = 0; i < numInput; ++i) {
-    auto partition = partitions_[i];
-    rawIndices[partition][maxIndex[partition]] = i;
-    ++maxIndex[partition];
+    rawIndices[nextIndex[partitions_[i]]++] = i;
   }
 
   for (auto i = 0; i < numPartitions_; i++) {
-    auto partitionSize = maxIndex[i];
+    auto partitionSize = offsets[i + 1] - offsets[i];
     if (partitionSize == 0) {
       // Do not enqueue empty partitions.
       continue;
     }
-    auto partitionData =
-        wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
+    auto partitionData = wrapChildren(
+        input, partitionSize, sliceIndices(indices, offsets[i], partitionSize));
 
     ContinueFuture future;
     auto reason = queues_[i]->enqueue(partitionData, &future);
@@ -382,10 +393,16 @@ void LocalPartition::noMoreInput() {
 }
 
 bool LocalPartition::isFinished() {
-  if (!futures_.empty() || !noMoreInput_) {
+  if (!futures_.empty()) {
     return false;
   }
-
-  return true;
+  if (noMoreInput_) {
+    return true;
+  }
+  // The consumers of all the queues finished early, e.g. at a Limit, so the
+  // operators before 'this' need not produce more.
+  return std::all_of(queues_.begin(), queues_.end(), [](const auto& queue) {
+    return queue->isClosed();
+  });
 }
 } // namespace facebook::velox::exec
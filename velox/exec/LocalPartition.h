@@ -46,7 +46,9 @@ class LocalExchangeMemoryManager {
 /// Buffers data for a single partition produced by local exchange. Allows
 /// multiple producers to enqueue data and multiple consumers fetch data. Each
 /// producer must be registered with a call to 'addProducer'. 'noMoreProducers'
-/// must be called after all producers have been registered. A producer calls
+/// must be called after the initial producers have been registered. More
+/// producers may be added after that while some producers have not finished,
+/// e.g. when a pipeline gets drivers added at runtime. A producer calls
 /// 'enqueue' multiple time to put the data and calls 'noMoreData' when done.
 /// Consumers call 'next' repeatedly to fetch the data.
 class LocalExchangeQueue {
@@ -84,6 +86,10 @@ class LocalExchangeQueue {
 
   bool isFinished();
 
+  /// Returns true if the consumer closed the queue, e.g. because the
+  /// operators after it do not need more data.
+  bool isClosed();
+
   /// Drop remaining data from the queue and notify consumers and producers if
   /// called before all the data has been processed. No-op otherwise.
   void close();
@@ -124,6 +130,13 @@ class LocalExchange : public SourceOperator {
 
   bool isFinished() override;
 
+  /// Closes the exchange queue so that the producers stop.
+  void noMoreOutputNeeded() override {
+    if (queue_) {
+      queue_->close();
+    }
+  }
+
   /// Close exchange queue. If called before all data has been processed,
   /// notifies the producer that no more data is needed.
   void close() override {
@@ -15,10 +15,12 @@
  */
 #include "velox/exec/LocalPlanner.h"
 #include "velox/core/PlanFragment.h"
+#include "velox/exec/Aggregate.h"
 #include "velox/exec/ArrowStream.h"
 #include "velox/exec/AssignUniqueId.h"
 #include "velox/exec/CallbackSink.h"
 #include "velox/exec/EnforceSingleRow.h"
+#include "velox/exec/FragmentResultCache.h"
 #include "velox/exec/Exchange.h"
 #include "velox/exec/Expand.h"
 #include "velox/exec/FilterProject.h"
@@ -26,6 +28,7 @@
 #include "velox/exec/HashAggregation.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashProbe.h"
+#include "velox/exec/IndexLookupJoin.h"
 #include "velox/exec/Limit.h"
 #include "velox/exec/MarkDistinct.h"
 #include "velox/exec/Merge.h"
@@ -260,6 +263,147 @@ uint32_t maxDrivers(
   }
   return count;
 }
+
+/// Returns the nodes that compute 'aggregation' over 'groupId' by aggregating
+/// the input of 'groupId' over all its grouping keys first: a partial
+/// aggregation over the source of 'groupId', 'groupId' over the partial
+/// results and an intermediate or final aggregation with the ID of
+/// 'aggregation'. Every grouping set is then derived from the finest one and
+/// 'groupId' replicates one row per group instead of one per input row.
+/// Returns std::nullopt if 'aggregation' cannot be split.
+std::optional<std::vector<core::PlanNodePtr>> preAggregateGroupingSets(
+    const core::GroupIdNode& groupId,
+    const core::AggregationNode& aggregation) {
+  using Step = core::AggregationNode::Step;
+  if (!isRawInput(aggregation.step()) ||
+      !aggregation.preGroupedKeys().empty()) {
+    return std::nullopt;
+  }
+
+  std::unordered_set<std::string> groupingKeyOutputs;
+  for (const auto& info : groupId.groupingKeyInfos()) {
+    groupingKeyOutputs.insert(info.output);
+  }
+  for (const auto& key : aggregation.groupingKeys()) {
+    if (groupingKeyOutputs.count(key->name()) == 0 &&
+        key->name() != groupId.groupIdName()) {
+      return std::nullopt;
+    }
+  }
+
+  // The partial aggregation groups by the distinct inputs of the grouping
+  // keys.
+  std::vector<core::FieldAccessTypedExprPtr> partialKeys;
+  std::unordered_set<std::string> partialNames;
+  for (const auto& info : groupId.groupingKeyInfos()) {
+    if (partialNames.insert(info.input->name()).second) {
+      partialKeys.push_back(info.input);
+    }
+  }
+
+  std::unordered_set<std::string> aggregationInputs;
+  for (const auto& input : groupId.aggregationInputs()) {
+    aggregationInputs.insert(input->name());
+  }
+
+  const auto& aggregateNames = aggregation.aggregateNames();
+  std::vector<core::AggregationNode::Aggregate> partialAggregates;
+  std::vector<core::AggregationNode::Aggregate> finalAggregates;
+  std::vector<core::FieldAccessTypedExprPtr> intermediateColumns;
+  for (auto i = 0; i < aggregation.aggregates().size(); ++i) {
+    const auto& aggregate = aggregation.aggregates()[i];
+    if (aggregate.mask != nullptr || !aggregate.sortingKeys.empty() ||
+        aggregate.distinct || !partialNames.insert(aggregateNames[i]).second) {
+      return std::nullopt;
+    }
+    std::vector<TypePtr> rawInputTypes;
+    for (const auto& input : aggregate.call->inputs()) {
+      // The grouping keys are null in some of the grouping sets, so only the
+      // aggregation inputs of 'groupId' and constants have the same values
+      // in the source of 'groupId'.
+      if (auto* field =
+              dynamic_cast<const core::FieldAccessTypedExpr*>(input.get())) {
+        if (aggregationInputs.count(field->name()) == 0) {
+          return std::nullopt;
+        }
+      } else if (!dynamic_cast<const core::ConstantTypedExpr*>(input.get())) {
+        return std::nullopt;
+      }
+      rawInputTypes.push_back(input->type());
+    }
+
+    const auto& name = aggregate.call->name();
+    auto intermediateType = Aggregate::intermediateType(name, rawInputTypes);
+    core::AggregationNode::Aggregate partial;
+    partial.call = std::make_shared<core::CallTypedExpr>(
+        intermediateType, aggregate.call->inputs(), name);
+    partial.rawInputTypes = rawInputTypes;
+    partialAggregates.push_back(std::move(partial));
+
+    auto intermediateColumn = std::make_shared<core::FieldAccessTypedExpr>(
+        intermediateType, aggregateNames[i]);
+    core::AggregationNode::Aggregate merge;
+    merge.call = std::make_shared<core::CallTypedExpr>(
+        aggregate.call->type(),
+        std::vector<core::TypedExprPtr>{intermediateColumn},
+        name);
+    merge.rawInputTypes = std::move(rawInputTypes);
+    finalAggregates.push_back(std::move(merge));
+    intermediateColumns.push_back(std::move(intermediateColumn));
+  }
+
+  auto partialAggregation = std::make_shared<core::AggregationNode>(
+      fmt::format("{}.preAggregation", aggregation.id()),
+      Step::kPartial,
+      partialKeys,
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregateNames,
+      partialAggregates,
+      false, // ignoreNullKeys
+      groupId.sources()[0]);
+  auto partialGroupId = std::make_shared<core::GroupIdNode>(
+      groupId.id(),
+      groupId.groupingSets(),
+      groupId.groupingKeyInfos(),
+      intermediateColumns,
+      groupId.groupIdName(),
+      partialAggregation);
+  auto finalAggregation = std::make_shared<core::AggregationNode>(
+      aggregation.id(),
+      aggregation.step() == Step::kSingle ? Step::kFinal : Step::kIntermediate,
+      aggregation.groupingKeys(),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregateNames,
+      finalAggregates,
+      aggregation.globalGroupingSets(),
+      aggregation.groupId(),
+      aggregation.ignoreNullKeys(),
+      partialGroupId);
+  return std::vector<core::PlanNodePtr>{
+      partialAggregation, partialGroupId, finalAggregation};
+}
+
+/// Replaces the GroupId and aggregation pairs of 'planNodes' that
+/// preAggregateGroupingSets() can split.
+void preAggregateGroupingSets(std::vector<core::PlanNodePtr>& planNodes) {
+  for (auto i = 1; i < planNodes.size(); ++i) {
+    auto* groupId =
+        dynamic_cast<const core::GroupIdNode*>(planNodes[i - 1].get());
+    auto* aggregation =
+        dynamic_cast<const core::AggregationNode*>(planNodes[i].get());
+    if (groupId == nullptr || aggregation == nullptr) {
+      continue;
+    }
+    auto nodes = preAggregateGroupingSets(*groupId, *aggregation);
+    if (!nodes.has_value()) {
+      continue;
+    }
+    planNodes.erase(planNodes.begin() + i - 1, planNodes.begin() + i + 1);
+    planNodes.insert(planNodes.begin() + i - 1, nodes->begin(), nodes->end());
+    i += 1;
+  }
+}
+
 } // namespace detail
 
 // static
@@ -283,6 +427,12 @@ void LocalPlanner::plan(
 
   (*driverFactories)[0]->outputDriver = true;
 
+  if (queryConfig.groupingSetsPreAggregationEnabled()) {
+    for (auto& factory : *driverFactories) {
+      detail::preAggregateGroupingSets(factory->planNodes);
+    }
+  }
+
   if (planFragment.isGroupedExecution()) {
     determineGroupedExecutionPipelines(planFragment, *driverFactories);
     markMixedJoinBridges(*driverFactories);
@@ -403,6 +553,138 @@ bool eagerFlush(const core::PlanNode& node) {
   return eagerFlush(*node.sources()[0]);
 }
 
+// Sets 'path' to the column name followed by the struct members that 'expr'
+// dereferences and returns true. Returns false if 'expr' is not a column or a
+// chain of dereferences of a column.
+bool toSubfieldPath(
+    const core::TypedExprPtr& expr,
+    std::vector<std::string>& path) {
+  if (auto* field =
+          dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+    if (field->isInputColumn()) {
+      path = {field->name()};
+      return true;
+    }
+    if (!toSubfieldPath(field->inputs()[0], path)) {
+      return false;
+    }
+    path.push_back(field->name());
+    return true;
+  }
+  if (auto* dereference =
+          dynamic_cast<const core::DereferenceTypedExpr*>(expr.get())) {
+    if (!toSubfieldPath(dereference->inputs()[0], path)) {
+      return false;
+    }
+    path.push_back(dereference->name());
+    return true;
+  }
+  return false;
+}
+
+// The parts of a scan output column used by a consumer.
+struct ColumnAccess {
+  // True if the column is used as a whole.
+  bool whole{false};
+  // Paths of the subfields used, starting with the column name.
+  std::vector<std::vector<std::string>> paths;
+};
+
+// Adds the columns used by 'expr' to 'accesses'. Columns referenced inside a
+// lambda are used as a whole since lambda arguments may shadow them.
+void collectColumnAccesses(
+    const core::TypedExprPtr& expr,
+    bool inLambda,
+    std::unordered_map<std::string, ColumnAccess>& accesses) {
+  std::vector<std::string> path;
+  if (toSubfieldPath(expr, path)) {
+    auto& access = accesses[path[0]];
+    if (inLambda || path.size() == 1 ||
+        std::find(path.begin(), path.end(), "") != path.end()) {
+      access.whole = true;
+    } else {
+      access.paths.push_back(std::move(path));
+    }
+    return;
+  }
+  if (auto* lambda = dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    collectColumnAccesses(lambda->body(), true, accesses);
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collectColumnAccesses(input, inLambda, accesses);
+  }
+}
+
+// Returns the assignments of the scan at 'planNodes[scanIndex]' with the ROW
+// columns that the following Filter and Project only dereference restricted
+// to the dereferenced subfields. Returns std::nullopt if no column is pruned.
+std::optional<
+    std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>>
+pruneScanSubfields(
+    const core::TableScanNode& scanNode,
+    const std::vector<core::PlanNodePtr>& planNodes,
+    int32_t scanIndex) {
+  auto next = scanIndex + 1;
+  const core::FilterNode* filterNode = nullptr;
+  if (next < planNodes.size()) {
+    filterNode = dynamic_cast<const core::FilterNode*>(planNodes[next].get());
+    if (filterNode) {
+      ++next;
+    }
+  }
+  // Without a Project all the columns are passed on as a whole.
+  if (next >= planNodes.size()) {
+    return std::nullopt;
+  }
+  auto* projectNode =
+      dynamic_cast<const core::ProjectNode*>(planNodes[next].get());
+  if (!projectNode) {
+    return std::nullopt;
+  }
+
+  std::unordered_map<std::string, ColumnAccess> accesses;
+  if (filterNode) {
+    collectColumnAccesses(filterNode->filter(), false, accesses);
+  }
+  for (const auto& projection : projectNode->projections()) {
+    collectColumnAccesses(projection, false, accesses);
+  }
+
+  auto assignments = scanNode.assignments();
+  bool pruned = false;
+  const auto& outputType = scanNode.outputType();
+  for (auto i = 0; i < outputType->size(); ++i) {
+    if (!outputType->childAt(i)->isRow()) {
+      continue;
+    }
+    const auto& name = outputType->nameOf(i);
+    auto it = accesses.find(name);
+    if (it == accesses.end() || it->second.whole) {
+      continue;
+    }
+    std::vector<common::Subfield> subfields;
+    for (const auto& path : it->second.paths) {
+      std::vector<std::unique_ptr<common::Subfield::PathElement>> elements;
+      for (const auto& step : path) {
+        elements.push_back(
+            std::make_unique<common::Subfield::NestedField>(step));
+      }
+      subfields.emplace_back(std::move(elements));
+    }
+    auto handle = assignments.at(name)->withRequiredSubfields(
+        std::move(subfields));
+    if (handle) {
+      assignments[name] = std::move(handle);
+      pruned = true;
+    }
+  }
+  if (!pruned) {
+    return std::nullopt;
+  }
+  return assignments;
+}
+
 } // namespace
 
 std::shared_ptr<Driver> DriverFactory::createDriver(
@@ -450,8 +732,15 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto tableScanNode =
             std::dynamic_pointer_cast<const core::TableScanNode>(planNode)) {
-      operators.push_back(
-          std::make_unique<TableScan>(id, ctx.get(), tableScanNode));
+      std::optional<std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>>
+          columnHandles;
+      if (ctx->queryConfig().tableScanSubfieldPruningEnabled()) {
+        columnHandles = pruneScanSubfields(*tableScanNode, planNodes, i);
+      }
+      operators.push_back(std::make_unique<TableScan>(
+          id, ctx.get(), tableScanNode, std::move(columnHandles)));
     } else if (
         auto tableWriteNode =
             std::dynamic_pointer_cast<const core::TableWriteNode>(planNode)) {
@@ -492,6 +781,12 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
                 planNode)) {
       operators.push_back(
           std::make_unique<NestedLoopJoinProbe>(id, ctx.get(), joinNode));
+    } else if (
+        auto joinNode =
+            std::dynamic_pointer_cast<const core::IndexLookupJoinNode>(
+                planNode)) {
+      operators.push_back(
+          std::make_unique<IndexLookupJoin>(id, ctx.get(), joinNode));
     } else if (
         auto aggregationNode =
             std::dynamic_pointer_cast<const core::AggregationNode>(planNode)) {
@@ -576,6 +871,12 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
                 planNode)) {
       operators.push_back(
           std::make_unique<EnforceSingleRow>(id, ctx.get(), enforceSingleRow));
+    } else if (
+        auto fragmentResultCacheNode =
+            std::dynamic_pointer_cast<const core::FragmentResultCacheNode>(
+                planNode)) {
+      operators.push_back(std::make_unique<FragmentResultCache>(
+          id, ctx.get(), fragmentResultCacheNode));
     } else if (
         auto assignUniqueIdNode =
             std::dynamic_pointer_cast<const core::AssignUniqueIdNode>(
@@ -670,6 +971,47 @@ std::vector<core::PlanNodeId> DriverFactory::needsHashJoinBridges() const {
   return planNodeIds;
 }
 
+bool DriverFactory::supportsDynamicDrivers(
+    const core::QueryConfig& queryConfig) const {
+  if (groupedExecution || planNodes.empty() ||
+      !std::dynamic_pointer_cast<const core::TableScanNode>(
+          planNodes.front())) {
+    return false;
+  }
+  for (auto i = 1; i < planNodes.size(); ++i) {
+    const auto& node = planNodes[i];
+    if (std::dynamic_pointer_cast<const core::FilterNode>(node) ||
+        std::dynamic_pointer_cast<const core::ProjectNode>(node)) {
+      continue;
+    }
+    // A probe that finishes early on an empty build ends its driver while
+    // splits are queued. A driver added after that would produce to a local
+    // exchange or an output buffer that is already at end.
+    if (std::dynamic_pointer_cast<const core::HashJoinNode>(node)) {
+      if (queryConfig.hashProbeFinishEarlyOnEmptyBuild()) {
+        return false;
+      }
+      continue;
+    }
+    if (auto aggregation =
+            std::dynamic_pointer_cast<const core::AggregationNode>(node)) {
+      if (aggregation->step() == core::AggregationNode::Step::kPartial) {
+        continue;
+      }
+      return false;
+    }
+    if (i == planNodes.size() - 1 &&
+        std::dynamic_pointer_cast<const core::PartitionedOutputNode>(node)) {
+      continue;
+    }
+    return false;
+  }
+  // Local merges and merge joins have one source per producer driver and hash
+  // join bridges take no builders after start.
+  return consumerNode == nullptr ||
+      std::dynamic_pointer_cast<const core::LocalPartitionNode>(consumerNode);
+}
+
 std::vector<core::PlanNodeId> DriverFactory::needsNestedLoopJoinBridges()
     const {
   std::vector<core::PlanNodeId> planNodeIds;
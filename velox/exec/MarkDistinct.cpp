@@ -16,6 +16,7 @@
 
 #include "velox/exec/MarkDistinct.h"
 #include "velox/common/base/Range.h"
+#include "velox/exec/Task.h"
 #include "velox/vector/FlatVector.h"
 
 #include <algorithm>
@@ -43,17 +44,38 @@ MarkDistinct::MarkDistinct(
   // We will use result[0] for distinct mask output.
   resultProjections_.emplace_back(0, inputType->size());
 
-  groupingSet_ = GroupingSet::createForMarkDistinct(
-      inputType,
-      createVectorHashers(inputType, planNode->distinctKeys()),
-      operatorCtx_.get(),
-      &nonReclaimableSection_);
+  if (driverCtx->queryConfig().sharedHashTableEnabled()) {
+    auto table = operatorCtx_->task()->getOrCreateSharedHashTable(
+        driverCtx->splitGroupId, planNode->id(), [&]() {
+          return std::make_shared<SharedHashTable>(
+              inputType,
+              planNode->distinctKeys(),
+              std::vector<TypePtr>{},
+              pool());
+        });
+    sharedTableProber_ = std::make_unique<SharedHashTableProber>(
+        std::move(table), inputType, planNode->distinctKeys());
+  } else {
+    groupingSet_ = GroupingSet::createForMarkDistinct(
+        inputType,
+        createVectorHashers(inputType, planNode->distinctKeys()),
+        operatorCtx_.get(),
+        &nonReclaimableSection_);
+  }
 
   results_.resize(1);
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
-  groupingSet_->addInput(input, false /*mayPushdown*/);
+  if (sharedTableProber_) {
+    newGroups_.clear();
+    sharedTableProber_->groupProbe(input, [&](HashLookup& lookup) {
+      newGroups_.insert(
+          newGroups_.end(), lookup.newGroups.begin(), lookup.newGroups.end());
+    });
+  } else {
+    groupingSet_->addInput(input, false /*mayPushdown*/);
+  }
 
   input_ = std::move(input);
 }
@@ -79,7 +101,10 @@ RowVectorPtr MarkDistinct::getOutput() {
       results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
   bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
+  const auto& newGroups = sharedTableProber_
+      ? newGroups_
+      : groupingSet_->hashLookup().newGroups;
+  for (const auto i : newGroups) {
     bits::setBit(resultBits, i, true);
   }
   auto output = fillOutput(outputSize, nullptr);
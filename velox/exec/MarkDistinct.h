@@ -18,6 +18,7 @@
 
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/SharedHashTable.h"
 
 namespace facebook::velox::exec {
 
@@ -49,5 +50,12 @@ class MarkDistinct : public Operator {
  private:
   // TODO: Document spilling configuration in spilling.rst.
   std::unique_ptr<GroupingSet> groupingSet_;
+
+  // Used instead of 'groupingSet_' if QueryConfig::sharedHashTableEnabled()
+  // is set. Probes the table shared by all drivers of the plan node.
+  std::unique_ptr<SharedHashTableProber> sharedTableProber_;
+
+  // The rows of 'input_' that are new distinct keys in 'sharedTableProber_'.
+  std::vector<vector_size_t> newGroups_;
 };
 } // namespace facebook::velox::exec
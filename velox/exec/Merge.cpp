@@ -73,6 +73,27 @@ void Merge::initializeTreeOfLosers() {
       std::make_unique<TreeOfLosers<SourceStream>>(std::move(sourceCursors));
 }
 
+void Merge::prefetchSources() {
+  if (numPrefetchSources_ == 0) {
+    return;
+  }
+  std::vector<SourceStream*> streams = streams_;
+  const auto numPrefetch =
+      std::min<size_t>(numPrefetchSources_, streams.size());
+  std::partial_sort(
+      streams.begin(),
+      streams.begin() + numPrefetch,
+      streams.end(),
+      [](const SourceStream* left, const SourceStream* right) {
+        return left->numRemainingRows() < right->numRemainingRows();
+      });
+  for (size_t i = 0; i < numPrefetch; ++i) {
+    if (streams[i]->hasData()) {
+      streams[i]->source()->prefetch();
+    }
+  }
+}
+
 BlockingReason Merge::isBlocked(ContinueFuture* future) {
   TestValue::adjust("facebook::velox::exec::Merge::isBlocked", this);
 
@@ -139,6 +160,8 @@ RowVectorPtr Merge::getOutput() {
     }
   }
 
+  prefetchSources();
+
   for (;;) {
     auto stream = treeOfLosers_->next();
 
@@ -304,7 +327,16 @@ MergeExchange::MergeExchange(
           mergeExchangeNode->sortingKeys(),
           mergeExchangeNode->sortingOrders(),
           mergeExchangeNode->id(),
-          "MergeExchange") {}
+          "MergeExchange") {
+  numPrefetchSources_ =
+      driverCtx->queryConfig().mergeExchangePrefetchSources();
+}
+
+void MergeExchange::addRawInputBytes(uint64_t bytes) {
+  stats_.wlock()->rawInputBytes += bytes;
+  operatorCtx_->task()->queryCtx()->resourceUsage().addExchangeInputBytes(
+      bytes);
+}
 
 BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
   if (operatorCtx_->driverCtx()->driverId != 0) {
@@ -55,9 +55,18 @@ class Merge : public SourceOperator {
 
   std::vector<std::shared_ptr<MergeSource>> sources_;
 
+  /// Number of sources to call MergeSource::prefetch() on before merging. 0
+  /// disables the prefetch.
+  uint32_t numPrefetchSources_{0};
+
  private:
   void initializeTreeOfLosers();
 
+  // Calls MergeSource::prefetch() on the 'numPrefetchSources_' sources with
+  // the fewest rows left in their current batch. These are the sources that
+  // are likely to need their next batch first.
+  void prefetchSources();
+
   /// Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
@@ -108,6 +117,22 @@ class SourceStream final : public MergeStream {
     return !atEnd_;
   }
 
+  /// Returns the number of rows left in the current batch or the max value
+  /// if the source has been exhausted.
+  vector_size_t numRemainingRows() const {
+    if (atEnd_) {
+      return std::numeric_limits<vector_size_t>::max();
+    }
+    if (needData_ || data_ == nullptr) {
+      return 0;
+    }
+    return data_->size() - currentSourceRow_;
+  }
+
+  MergeSource* source() const {
+    return source_;
+  }
+
   /// Returns true if current source row is less then current source row in
   /// 'other'.
   bool operator<(const MergeStream& other) const override;
@@ -191,6 +216,10 @@ class MergeExchange : public Merge {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MergeExchangeNode>& orderByNode);
 
+  /// Records 'bytes' of serialized pages received from the remote sources in
+  /// the stats of 'this' and the resource usage of the query.
+  void addRawInputBytes(uint64_t bytes);
+
  protected:
   BlockingReason addMergeSources(ContinueFuture* future) override;
 
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/MergeJoin.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/Spiller.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
 
@@ -29,7 +31,10 @@ MergeJoin::MergeJoin(
           joinNode->outputType(),
           operatorId,
           joinNode->id(),
-          "MergeJoin"),
+          "MergeJoin",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       outputBatchSize_{static_cast<vector_size_t>(outputBatchRows())},
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()},
@@ -209,6 +214,50 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+namespace {
+bool hasNullKeys(
+    const RowVectorPtr& rowVector,
+    const std::vector<column_index_t>& keys,
+    vector_size_t index) {
+  for (auto key : keys) {
+    if (rowVector->childAt(key)->isNullAt(index)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the first row in ('start', 'end') for which 'isBefore' is false or
+// 'end' if there is none. 'isBefore' must be true for 'start' and for all
+// rows before a row for which it is true, as for the rows of sorted input
+// that are below a key. Probes rows at exponentially growing distances from
+// 'start' and then binary searches the last step, so that skipping n rows
+// takes O(log n) comparisons instead of n.
+template <typename TIsBefore>
+vector_size_t
+gallop(vector_size_t start, vector_size_t end, TIsBefore isBefore) {
+  vector_size_t low = start;
+  vector_size_t high = end;
+  for (vector_size_t step = 1; step < end - low; step *= 2) {
+    if (!isBefore(low + step)) {
+      high = low + step;
+      break;
+    }
+    low += step;
+  }
+  // 'isBefore' is true for 'low' and false for 'high' unless 'high' is 'end'.
+  while (high - low > 1) {
+    const auto middle = low + (high - low) / 2;
+    if (isBefore(middle)) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return high;
+}
+} // namespace
+
 bool MergeJoin::findEndOfMatch(
     Match& match,
     const RowVectorPtr& input,
@@ -222,11 +271,11 @@ bool MergeJoin::findEndOfMatch(
 
   auto numInput = input->size();
 
-  vector_size_t endIndex = 0;
-  while (endIndex < numInput &&
-         compare(keys, input, endIndex, keys, prevInput, prevIndex) == 0) {
-    ++endIndex;
-  }
+  const auto isInMatch = [&](vector_size_t index) {
+    return compare(keys, input, index, keys, prevInput, prevIndex) == 0;
+  };
+  const vector_size_t endIndex =
+      numInput > 0 && isInMatch(0) ? gallop(0, numInput, isInMatch) : 0;
 
   if (endIndex == numInput) {
     // Inputs are kept past getting a new batch of inputs. LazyVectors
@@ -449,11 +498,14 @@ bool MergeJoin::addToOutput() {
     leftStartIndex = leftMatch_->startIndex;
   }
 
-  size_t numLefts = leftMatch_->inputs.size();
-  for (size_t l = firstLeftBatch; l < numLefts; ++l) {
-    auto left = leftMatch_->inputs[l];
+  for (size_t l = firstLeftBatch;; ++l) {
+    auto left = matchBatch(*leftMatch_, l);
+    if (left == nullptr) {
+      break;
+    }
     auto leftStart = l == firstLeftBatch ? leftStartIndex : 0;
-    auto leftEnd = l == numLefts - 1 ? leftMatch_->endIndex : left->size();
+    auto leftEnd =
+        leftMatch_->isLastBatch(l) ? leftMatch_->endIndex : left->size();
 
     for (auto i = leftStart; i < leftEnd; ++i) {
       auto firstRightBatch =
@@ -466,12 +518,14 @@ bool MergeJoin::addToOutput() {
           ? rightMatch_->cursor->index
           : rightMatch_->startIndex;
 
-      auto numRights = rightMatch_->inputs.size();
-      for (size_t r = firstRightBatch; r < numRights; ++r) {
-        auto right = rightMatch_->inputs[r];
+      for (size_t r = firstRightBatch;; ++r) {
+        auto right = matchBatch(*rightMatch_, r);
+        if (right == nullptr) {
+          break;
+        }
         auto rightStart = r == firstRightBatch ? rightStartIndex : 0;
         auto rightEnd =
-            r == numRights - 1 ? rightMatch_->endIndex : right->size();
+            rightMatch_->isLastBatch(r) ? rightMatch_->endIndex : right->size();
 
         if (prepareOutput(left, right)) {
           output_->resize(outputSize_);
@@ -491,7 +545,21 @@ bool MergeJoin::addToOutput() {
           rightEnd = rightStart + 1;
         }
 
-        for (auto j = rightStart; j < rightEnd; ++j) {
+        auto j = rightStart;
+        if (filter_ == nullptr && !isRightFlattened_) {
+          // Without a filter, the matches of the left row are one range of
+          // right side dictionary indices.
+          const auto numRows =
+              std::min(rightEnd - j, outputBatchSize_ - outputSize_);
+          std::fill_n(rawLeftIndices_ + outputSize_, numRows, i);
+          std::iota(
+              rawRightIndices_ + outputSize_,
+              rawRightIndices_ + outputSize_ + numRows,
+              j);
+          outputSize_ += numRows;
+          j += numRows;
+        }
+        for (; j < rightEnd; ++j) {
           if (outputSize_ == outputBatchSize_) {
             // If we run out of space in the current output_, we will need to
             // produce a buffer and continue processing left later. In this
@@ -525,14 +593,7 @@ vector_size_t firstNonNull(
     const std::vector<column_index_t>& keys,
     vector_size_t start = 0) {
   for (auto i = start; i < rowVector->size(); ++i) {
-    bool hasNull = false;
-    for (auto key : keys) {
-      if (rowVector->childAt(key)->isNullAt(i)) {
-        hasNull = true;
-        break;
-      }
-    }
-    if (!hasNull) {
+    if (!hasNullKeys(rowVector, keys, i)) {
       return i;
     }
   }
@@ -550,6 +611,12 @@ RowVectorPtr MergeJoin::getOutput() {
 
   // TODO Finish early if ran out of data on either side of the join.
 
+  // Test-only spill path.
+  if (canSpill() && testingTriggerSpill(pool()->name())) {
+    Operator::ReclaimableSectionGuard guard(this);
+    memory::testingRunArbitration(pool());
+  }
+
   for (;;) {
     auto output = doGetOutput();
     if (output != nullptr && output->size() > 0) {
@@ -730,7 +797,22 @@ RowVectorPtr MergeJoin::doGetOutput() {
         addOutputRowForLeftJoin(input_, index_);
       }
 
-      ++index_;
+      if (isLeftJoin(joinType_)) {
+        ++index_;
+      } else {
+        // Skips the left rows below the right key. Rows with null keys are
+        // not skipped over since they can be anywhere in the sort order.
+        index_ = gallop(index_, input_->size(), [&](auto index) {
+          return !hasNullKeys(input_, leftKeys_, index) &&
+              compare(
+                  leftKeys_,
+                  input_,
+                  index,
+                  rightKeys_,
+                  rightInput_,
+                  rightIndex_) < 0;
+        });
+      }
       if (index_ == input_->size()) {
         // Ran out of rows on the left side.
         input_ = nullptr;
@@ -741,7 +823,18 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
     // Catch up rightInput_ with input_.
     while (compareResult > 0) {
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
+      const auto nextIndex =
+          gallop(rightIndex_, rightInput_->size(), [&](auto index) {
+            return !hasNullKeys(rightInput_, rightKeys_, index) &&
+                compare(
+                    leftKeys_,
+                    input_,
+                    index_,
+                    rightKeys_,
+                    rightInput_,
+                    index) > 0;
+          });
+      rightIndex_ = firstNonNull(rightInput_, rightKeys_, nextIndex);
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -753,10 +846,9 @@ RowVectorPtr MergeJoin::doGetOutput() {
     if (compareResult == 0) {
       // Found a match. Identify all rows on the left and right that have the
       // matching keys.
-      vector_size_t endIndex = index_ + 1;
-      while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
-        ++endIndex;
-      }
+      const auto endIndex = gallop(index_, input_->size(), [&](auto index) {
+        return compareLeft(index) == 0;
+      });
 
       if (endIndex == input_->size()) {
         // Matches continue in subsequent input. Load all lazies.
@@ -765,11 +857,10 @@ RowVectorPtr MergeJoin::doGetOutput() {
       leftMatch_ = Match{
           {input_}, index_, endIndex, endIndex < input_->size(), std::nullopt};
 
-      vector_size_t endRightIndex = rightIndex_ + 1;
-      while (endRightIndex < rightInput_->size() &&
-             compareRight(endRightIndex) == 0) {
-        ++endRightIndex;
-      }
+      const auto endRightIndex =
+          gallop(rightIndex_, rightInput_->size(), [&](auto index) {
+            return compareRight(index) == 0;
+          });
 
       rightMatch_ = Match{
           {rightInput_},
@@ -919,4 +1010,108 @@ bool MergeJoin::isFinished() {
   return noMoreInput_ && input_ == nullptr;
 }
 
+RowVectorPtr MergeJoin::matchBatch(Match& match, size_t batchIndex) {
+  if (match.spillPartition == nullptr ||
+      (match.numSpilledBatches.has_value() &&
+       batchIndex >= match.numSpilledBatches.value())) {
+    const auto inputIndex = batchIndex - match.numSpilledBatches.value_or(0);
+    return inputIndex < match.inputs.size() ? match.inputs[inputIndex]
+                                            : nullptr;
+  }
+
+  if (match.spillReader != nullptr && match.spilledBatchIndex == batchIndex) {
+    return match.spilledBatch;
+  }
+  if (batchIndex == 0) {
+    // Reads the spilled rows from the start. The partition is copied since
+    // the reader takes the files of the partition.
+    match.spillReader = SpillPartition(*match.spillPartition)
+                            .createUnorderedReader(
+                                spillConfig_->readBufferSize,
+                                pool(),
+                                &spillStats_);
+  } else {
+    VELOX_CHECK_NOT_NULL(match.spillReader);
+    VELOX_CHECK_EQ(match.spilledBatchIndex + 1, batchIndex);
+  }
+
+  // Reads into a new vector since the output may wrap the last batch read.
+  RowVectorPtr batch;
+  if (!match.spillReader->nextBatch(batch)) {
+    match.numSpilledBatches = batchIndex;
+    match.spillReader.reset();
+    match.spilledBatch.reset();
+    return matchBatch(match, batchIndex);
+  }
+  match.spilledBatch = batch;
+  match.spilledBatchIndex = batchIndex;
+  return batch;
+}
+
+void MergeJoin::spillMatch(Match& match) {
+  VELOX_CHECK(!match.cursor.has_value());
+  if (match.inputs.size() < 2) {
+    return;
+  }
+
+  Spiller spiller(
+      Spiller::Type::kHashJoinProbe,
+      asRowType(match.inputs[0]->type()),
+      HashBitRange{},
+      spillConfig(),
+      &spillStats_);
+  spiller.setPartitionsSpilled({0});
+  for (size_t i = 0; i < match.inputs.size() - 1; ++i) {
+    auto batch = match.inputs[i];
+    for (auto j = 0; j < batch->childrenSize(); ++j) {
+      batch->childAt(j)->loadedVector();
+    }
+    if (i == 0 && match.startIndex > 0) {
+      batch = std::static_pointer_cast<RowVector>(
+          batch->slice(match.startIndex, batch->size() - match.startIndex));
+    }
+    spiller.spill(0, batch);
+  }
+  SpillPartitionSet spillPartitionSet;
+  spiller.finishSpill(spillPartitionSet);
+  VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+  auto& spillPartition = spillPartitionSet.begin()->second;
+  if (match.spillPartition == nullptr) {
+    match.spillPartition = std::move(spillPartition);
+  } else {
+    match.spillPartition->merge(std::move(*spillPartition));
+  }
+  match.numSpilledBatches.reset();
+
+  match.inputs.erase(match.inputs.begin(), match.inputs.end() - 1);
+  match.startIndex = 0;
+}
+
+void MergeJoin::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (!leftMatch_.has_value()) {
+    // Nothing to spill.
+    return;
+  }
+  VELOX_CHECK(rightMatch_.has_value());
+
+  if (leftMatch_->cursor.has_value()) {
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING) << "Can't reclaim from merge join operator which is producing "
+                    "the output of a key match: "
+                 << pool()->name()
+                 << ", usage: " << succinctBytes(pool()->usedBytes())
+                 << ", reservation: "
+                 << succinctBytes(pool()->reservedBytes());
+    return;
+  }
+
+  spillMatch(leftMatch_.value());
+  spillMatch(rightMatch_.value());
+}
+
 } // namespace facebook::velox::exec
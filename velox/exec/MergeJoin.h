@@ -18,6 +18,7 @@
 
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spill.h"
 
 namespace facebook::velox::exec {
 
@@ -42,6 +43,15 @@ namespace facebook::velox::exec {
 /// Dictionaries for right projections are optimistically created; we start by
 /// wrapping the current right vector, but if the output happens to span more
 /// than one right vector, it gets copied and flattened.
+///
+/// If spilling is enabled, the memory arbitrator can reclaim the batches of a
+/// key match whose end has not been found yet. All batches of each side of
+/// the match but the last are spilled. The last batch stays in memory to find
+/// the end of the match and to continue the join after it. While the cross
+/// product is produced, the spilled left rows are read back once and the
+/// spilled right rows once per left row of the match, one batch at a time.
+/// Memory is not reclaimed while the output of a match is being produced.
+/// Semi joins do not spill.
 class MergeJoin : public Operator {
  public:
   MergeJoin(
@@ -61,10 +71,15 @@ class MergeJoin : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   void close() override {
     if (rightSource_) {
       rightSource_->close();
     }
+    leftMatch_.reset();
+    rightMatch_.reset();
     Operator::close();
   }
 
@@ -160,8 +175,41 @@ class MergeJoin : public Operator {
     void setCursor(size_t batchIndex, vector_size_t index) {
       cursor = Cursor{batchIndex, index};
     }
+
+    /// The spilled rows of the match, which precede the rows in 'inputs'. If
+    /// set, 'startIndex' is 0. The batches of the match are numbered from the
+    /// batches read back from spill, followed by 'inputs'.
+    std::unique_ptr<SpillPartition> spillPartition;
+
+    /// The number of batches 'spillPartition' is read back in. Set once all
+    /// of it has been read.
+    std::optional<size_t> numSpilledBatches;
+
+    /// Reads back 'spillPartition'. 'spilledBatch' is the last batch read and
+    /// 'spilledBatchIndex' its number.
+    std::unique_ptr<UnorderedStreamReader<BatchStream>> spillReader;
+    RowVectorPtr spilledBatch;
+    size_t spilledBatchIndex{0};
+
+    /// Returns true if 'batchIndex' is the number of the last batch.
+    bool isLastBatch(size_t batchIndex) const {
+      if (spillPartition != nullptr && !numSpilledBatches.has_value()) {
+        // 'batchIndex' is a spilled batch. The last batch is in 'inputs'.
+        return false;
+      }
+      return batchIndex + 1 == numSpilledBatches.value_or(0) + inputs.size();
+    }
   };
 
+  // Returns batch 'batchIndex' of 'match' or nullptr if there is none. The
+  // spilled batches are read in order: a spilled batch must be the last one
+  // returned, the one after it, or the first one, which starts reading the
+  // spilled rows over.
+  RowVectorPtr matchBatch(Match& match, size_t batchIndex);
+
+  // Spills the batches of 'match' but the last.
+  void spillMatch(Match& match);
+
   /// Given a partial set of rows with matching keys (match) finds all rows from
   /// the start of the 'input' batch that also have matching keys. Updates
   /// 'match' to include the newly identified rows. Returns true if found the
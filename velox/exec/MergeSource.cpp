@@ -17,6 +17,7 @@
 #include "velox/exec/MergeSource.h"
 
 #include <boost/circular_buffer.hpp>
+#include <deque>
 #include "velox/exec/Merge.h"
 #include "velox/vector/VectorStream.h"
 
@@ -124,6 +125,7 @@ class MergeExchangeSource : public MergeSource {
       memory::MemoryPool* pool,
       folly::Executor* executor)
       : mergeExchange_(mergeExchange),
+        executor_(executor),
         client_(std::make_shared<ExchangeClient>(
             mergeExchange->taskId(),
             destination,
@@ -137,6 +139,23 @@ class MergeExchangeSource : public MergeSource {
   BlockingReason next(RowVectorPtr& data, ContinueFuture* future) override {
     data.reset();
 
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (error_) {
+        std::rethrow_exception(error_);
+      }
+      if (!prefetched_.empty()) {
+        data = std::move(prefetched_.front());
+        prefetched_.pop_front();
+        return BlockingReason::kNotBlocked;
+      }
+      if (prefetching_) {
+        promises_.emplace_back("MergeExchangeSource::next");
+        *future = promises_.back().getSemiFuture();
+        return BlockingReason::kWaitForProducer;
+      }
+    }
+
     if (atEnd_ && !currentPage_) {
       return BlockingReason::kNotBlocked;
     }
@@ -154,20 +173,12 @@ class MergeExchangeSource : public MergeSource {
       }
     }
     if (!inputStream_.has_value()) {
-      mergeExchange_->stats().wlock()->rawInputBytes += currentPage_->size();
+      mergeExchange_->addRawInputBytes(currentPage_->size());
       inputStream_.emplace(currentPage_->prepareStreamForDeserialize());
     }
 
     if (!inputStream_->atEnd()) {
-      VectorStreamGroup::read(
-          &inputStream_.value(),
-          mergeExchange_->pool(),
-          mergeExchange_->outputType(),
-          &data);
-
-      auto lockedStats = mergeExchange_->stats().wlock();
-      lockedStats->addInputVector(data->estimateFlatSize(), data->size());
-      lockedStats->rawInputPositions += data->size();
+      readVector(&inputStream_.value(), data);
     }
 
     // Since VectorStreamGroup::read() may cause inputStream to be at end,
@@ -181,7 +192,76 @@ class MergeExchangeSource : public MergeSource {
     return BlockingReason::kNotBlocked;
   }
 
+  void prefetch() override {
+    if (executor_ == nullptr || client_ == nullptr || currentPage_ ||
+        atEnd_) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (prefetching_ || !prefetched_.empty() || closed_) {
+        return;
+      }
+    }
+
+    // Takes the next page only if the exchange client already has it. The
+    // page is deserialized on the executor while the merge consumes the rows
+    // of the other sources.
+    ContinueFuture future;
+    auto pages = client_->next(1, &atEnd_, &future);
+    VELOX_CHECK_LE(pages.size(), 1);
+    if (pages.empty()) {
+      return;
+    }
+    prefetching_ = true;
+    executor_->add([this, page = std::move(pages.front())]() mutable {
+      std::vector<RowVectorPtr> vectors;
+      std::exception_ptr error;
+      try {
+        mergeExchange_->addRawInputBytes(page->size());
+        auto inputStream = page->prepareStreamForDeserialize();
+        while (!inputStream.atEnd()) {
+          RowVectorPtr data;
+          readVector(&inputStream, data);
+          vectors.push_back(std::move(data));
+        }
+      } catch (const std::exception&) {
+        error = std::current_exception();
+      }
+      page.reset();
+
+      std::vector<ContinuePromise> promises;
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        error_ = error;
+        for (auto& vector : vectors) {
+          prefetched_.push_back(std::move(vector));
+        }
+        prefetching_ = false;
+        promises = std::move(promises_);
+      }
+      for (auto& promise : promises) {
+        promise.setValue();
+      }
+    });
+  }
+
   void close() override {
+    std::optional<ContinueFuture> pending;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      closed_ = true;
+      if (prefetching_) {
+        promises_.emplace_back("MergeExchangeSource::close");
+        pending = promises_.back().getSemiFuture();
+      }
+      prefetched_.clear();
+    }
+    // Waits for the deserialization in flight since it uses the pool and the
+    // stats of 'mergeExchange_'.
+    if (pending.has_value()) {
+      std::move(pending.value()).wait();
+    }
     if (client_) {
       client_->close();
       client_ = nullptr;
@@ -189,12 +269,38 @@ class MergeExchangeSource : public MergeSource {
   }
 
  private:
+  void readVector(ByteInputStream* inputStream, RowVectorPtr& data) {
+    VectorStreamGroup::read(
+        inputStream,
+        mergeExchange_->pool(),
+        mergeExchange_->outputType(),
+        &data);
+
+    auto lockedStats = mergeExchange_->stats().wlock();
+    lockedStats->addInputVector(data->estimateFlatSize(), data->size());
+    lockedStats->rawInputPositions += data->size();
+  }
+
   MergeExchange* const mergeExchange_;
+  folly::Executor* const executor_;
   std::shared_ptr<ExchangeClient> client_;
   std::optional<ByteInputStream> inputStream_;
   std::unique_ptr<SerializedPage> currentPage_;
   bool atEnd_ = false;
 
+  // Protects the state shared with the deserialization of a prefetched page
+  // on 'executor_'.
+  std::mutex mutex_;
+  // Vectors of the prefetched page that next() has not returned yet.
+  std::deque<RowVectorPtr> prefetched_;
+  // True while a prefetched page is being deserialized.
+  bool prefetching_{false};
+  bool closed_{false};
+  // Error from deserializing the prefetched page. Rethrown by next().
+  std::exception_ptr error_;
+  // Fulfilled when the prefetched page has been deserialized.
+  std::vector<ContinuePromise> promises_;
+
   BlockingReason enqueue(RowVectorPtr input, ContinueFuture* future) override {
     VELOX_FAIL();
   }
@@ -36,6 +36,11 @@ class MergeSource {
 
   virtual void close() = 0;
 
+  /// Starts preparing the next batch of the source ahead of the next() call
+  /// that returns it if the source supports it. Called by the consumer on
+  /// its own thread.
+  virtual void prefetch() {}
+
   // Factory methods to create MergeSources.
   static std::shared_ptr<MergeSource> createLocalMergeSource();
 
@@ -15,6 +15,7 @@
  */
 #include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/Task.h"
+#include "velox/vector/VectorCompression.h"
 
 namespace facebook::velox::exec {
 
@@ -50,7 +51,9 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild"),
+      compression_(driverCtx->queryConfig().nestedLoopJoinBuildCompression()) {
+}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -58,6 +61,12 @@ void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
     for (auto& child : input->children()) {
       child->loadedVector();
     }
+    // Do not keep large string buffers alive for a few strings.
+    input = std::static_pointer_cast<RowVector>(compactStrings(input, pool()));
+    if (compression_) {
+      input = std::static_pointer_cast<RowVector>(
+          compressIntegers(input, pool()));
+    }
     dataVectors_.emplace_back(std::move(input));
   }
 }
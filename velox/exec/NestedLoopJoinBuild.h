@@ -59,6 +59,9 @@ class NestedLoopJoinBuild : public Operator {
   }
 
  private:
+  // True if the integer columns of the input are stored compressed.
+  const bool compression_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
@@ -17,6 +17,7 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/vector/VectorCompression.h"
 
 namespace facebook::velox::exec {
 
@@ -29,6 +30,57 @@ bool needsBuildMismatch(core::JoinType joinType) {
   return isRightJoin(joinType) || isFullJoin(joinType);
 }
 
+// Adds the conjuncts of 'expr' to 'conjuncts'.
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<const core::CallTypedExpr*>& conjuncts) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return;
+  }
+  if (call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(call);
+}
+
+// Returns the channel in 'type' of the column 'expr' refers to or
+// std::nullopt if 'expr' is not a column of 'type'.
+std::optional<column_index_t> columnChannel(
+    const RowTypePtr& type,
+    const core::TypedExprPtr& expr) {
+  const auto* field =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  if (field == nullptr || !field->isInputColumn()) {
+    return std::nullopt;
+  }
+  return type->getChildIdxIfExists(field->name());
+}
+
+// Returns true if BaseVector::compare orders the values of 'type' the same way
+// as the comparison functions do. Excludes floating point types, where NaN
+// handling may differ, and custom types.
+bool supportsRangeJoin(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return type->isDecimal() || type->isDate() ||
+          type->name() == createScalarType(type->kind())->name();
+    default:
+      return false;
+  }
+}
+
 std::vector<IdentityProjection> extractProjections(
     const RowTypePtr& srcType,
     const RowTypePtr& destType) {
@@ -72,6 +124,10 @@ void NestedLoopJoinProbe::initialize() {
         joinNode_->joinCondition(),
         joinNode_->sources()[0]->outputType(),
         joinNode_->sources()[1]->outputType());
+    initializeRangeJoin(
+        joinNode_->joinCondition(),
+        joinNode_->sources()[0]->outputType(),
+        joinNode_->sources()[1]->outputType());
   }
 
   joinNode_.reset();
@@ -103,6 +159,9 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
           buildMatched_[i].resizeFill(buildVectors_.value()[i]->size(), false);
         }
       }
+      if (rangeJoin_.has_value()) {
+        prepareRangeJoin();
+      }
 
       setState(ProbeOperatorState::kRunning);
       return BlockingReason::kNotBlocked;
@@ -117,6 +176,7 @@ void NestedLoopJoinProbe::close() {
     joinCondition_->clear();
   }
   buildVectors_.reset();
+  currentBuildVector_.reset();
   Operator::close();
 }
 
@@ -149,7 +209,7 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
 
       while (output == nullptr && !hasProbedAllBuildData()) {
         output = getMismatchedOutput(
-            buildVectors_.value()[buildIndex_],
+            currentBuildVector(),
             buildMatched_[buildIndex_],
             buildOutMapping_,
             buildProjections_,
@@ -181,8 +241,10 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
-    const vector_size_t probeCnt = getNumProbeRows();
-    output = doMatch(probeCnt);
+    // doRangeMatch() advances 'probeRow_' by itself.
+    const vector_size_t probeCnt =
+        rangeJoin_.has_value() ? 0 : getNumProbeRows();
+    output = rangeJoin_.has_value() ? doRangeMatch() : doMatch(probeCnt);
     if (advanceProbeRows(probeCnt)) {
       if (!needsProbeMismatch(joinType_)) {
         finishProbeInput();
@@ -235,6 +297,108 @@ void NestedLoopJoinProbe::initializeFilter(
   filterInputType_ = ROW(std::move(names), std::move(types));
 }
 
+void NestedLoopJoinProbe::initializeRangeJoin(
+    const core::TypedExprPtr& filter,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  std::vector<const core::CallTypedExpr*> conjuncts;
+  flattenConjuncts(filter, conjuncts);
+
+  // The lower and upper bound build channels by probe channel.
+  std::map<
+      column_index_t,
+      std::pair<std::optional<column_index_t>, std::optional<column_index_t>>>
+      bounds;
+  auto addBound = [&](const core::TypedExprPtr& probe,
+                      const core::TypedExprPtr& build,
+                      bool lower) {
+    const auto probeChannel = columnChannel(probeType, probe);
+    const auto buildChannel = columnChannel(buildType, build);
+    if (!probeChannel.has_value() || !buildChannel.has_value()) {
+      return;
+    }
+    const auto& type = probeType->childAt(probeChannel.value());
+    if (!supportsRangeJoin(type) ||
+        !type->equivalent(*buildType->childAt(buildChannel.value()))) {
+      return;
+    }
+    auto& bound = lower ? bounds[probeChannel.value()].first
+                        : bounds[probeChannel.value()].second;
+    if (!bound.has_value()) {
+      bound = buildChannel;
+    }
+  };
+  for (const auto* call : conjuncts) {
+    const auto& inputs = call->inputs();
+    if (call->name() == "between" && inputs.size() == 3) {
+      addBound(inputs[0], inputs[1], true);
+      addBound(inputs[0], inputs[2], false);
+    } else if (
+        (call->name() == "gte" || call->name() == "gt") &&
+        inputs.size() == 2) {
+      addBound(inputs[0], inputs[1], true);
+      addBound(inputs[1], inputs[0], false);
+    } else if (
+        (call->name() == "lte" || call->name() == "lt") &&
+        inputs.size() == 2) {
+      addBound(inputs[0], inputs[1], false);
+      addBound(inputs[1], inputs[0], true);
+    }
+  }
+
+  // Prefers a probe column with both bounds.
+  for (const auto& [probeChannel, bound] : bounds) {
+    if (!bound.first.has_value()) {
+      continue;
+    }
+    if (!rangeJoin_.has_value() ||
+        (!rangeJoin_->highChannel.has_value() && bound.second.has_value())) {
+      rangeJoin_ = RangeJoin{probeChannel, bound.first.value(), bound.second};
+    }
+  }
+}
+
+void NestedLoopJoinProbe::prepareRangeJoin() {
+  const auto& buildVectors = buildVectors_.value();
+  rangeSortedRows_.resize(buildVectors.size());
+  rangeMaxHighRows_.resize(buildVectors.size());
+  for (auto i = 0; i < buildVectors.size(); ++i) {
+    const auto build = std::static_pointer_cast<RowVector>(
+        decompress(buildVectors[i], pool()));
+    const auto* low = build->childAt(rangeJoin_->lowChannel)->loadedVector();
+    auto& sortedRows = rangeSortedRows_[i];
+    sortedRows.reserve(build->size());
+    for (vector_size_t row = 0; row < build->size(); ++row) {
+      if (!low->isNullAt(row)) {
+        sortedRows.push_back(row);
+      }
+    }
+    std::sort(
+        sortedRows.begin(),
+        sortedRows.end(),
+        [&](vector_size_t left, vector_size_t right) {
+          return low->compare(low, left, right) < 0;
+        });
+
+    if (!rangeJoin_->highChannel.has_value()) {
+      continue;
+    }
+    const auto* high =
+        build->childAt(rangeJoin_->highChannel.value())->loadedVector();
+    auto& maxHighRows = rangeMaxHighRows_[i];
+    maxHighRows.resize(sortedRows.size());
+    vector_size_t maxHighRow = -1;
+    for (auto j = 0; j < sortedRows.size(); ++j) {
+      const auto row = sortedRows[j];
+      if (!high->isNullAt(row) &&
+          (maxHighRow < 0 || high->compare(high, row, maxHighRow) > 0)) {
+        maxHighRow = row;
+      }
+      maxHighRows[j] = maxHighRow;
+    }
+  }
+}
+
 RowVectorPtr NestedLoopJoinProbe::getMismatchedOutput(
     const RowVectorPtr& data,
     const SelectivityVector& matched,
@@ -331,6 +495,15 @@ void NestedLoopJoinProbe::beginBuildMismatch() {
   }
 }
 
+const RowVectorPtr& NestedLoopJoinProbe::currentBuildVector() {
+  if (currentBuildVector_ == nullptr || currentBuildIndex_ != buildIndex_) {
+    currentBuildVector_ = std::static_pointer_cast<RowVector>(
+        decompress(buildVectors_.value()[buildIndex_], pool()));
+    currentBuildIndex_ = buildIndex_;
+  }
+  return currentBuildVector_;
+}
+
 bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   VELOX_CHECK(!buildVectors_.has_value());
 
@@ -408,7 +581,7 @@ RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
       probeIndices_);
   projectChildren(
       projectedChildren,
-      buildVectors_.value()[buildIndex_],
+      currentBuildVector(),
       buildProjections,
       numOutputRows,
       buildIndices_);
@@ -445,7 +618,108 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       filterInputType_,
       filterProbeProjections_,
       filterBuildProjections_);
+  return evalJoinCondition(filterInput);
+}
+
+RowVectorPtr NestedLoopJoinProbe::doRangeMatch() {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_CHECK(!hasProbedAllBuildData());
+
+  const auto& sortedRows = rangeSortedRows_[buildIndex_];
+  const auto maxCandidates = static_cast<vector_size_t>(outputBatchSize_);
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, maxCandidates, pool());
+  auto rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, maxCandidates, pool());
+  vector_size_t numCandidates{0};
+  while (probeRow_ < input_->size() && numCandidates < maxCandidates) {
+    if (candidateEnd_ < 0) {
+      findRangeCandidates();
+    }
+    const auto numRows = std::min(
+        candidateEnd_ - candidateBegin_, maxCandidates - numCandidates);
+    std::fill(
+        rawProbeIndices.begin() + numCandidates,
+        rawProbeIndices.begin() + numCandidates + numRows,
+        probeRow_);
+    std::copy(
+        sortedRows.begin() + candidateBegin_,
+        sortedRows.begin() + candidateBegin_ + numRows,
+        rawBuildIndices.begin() + numCandidates);
+    numCandidates += numRows;
+    candidateBegin_ += numRows;
+    if (candidateBegin_ == candidateEnd_) {
+      candidateEnd_ = -1;
+      ++probeRow_;
+    }
+  }
+  if (numCandidates == 0) {
+    return nullptr;
+  }
+  stats_.wlock()->addRuntimeStat(
+      "numRangeJoinCandidates", RuntimeCounter(numCandidates));
+
+  std::vector<VectorPtr> filterChildren(filterInputType_->size());
+  projectChildren(
+      filterChildren,
+      input_,
+      filterProbeProjections_,
+      numCandidates,
+      probeIndices_);
+  projectChildren(
+      filterChildren,
+      currentBuildVector(),
+      filterBuildProjections_,
+      numCandidates,
+      buildIndices_);
+  return evalJoinCondition(std::make_shared<RowVector>(
+      pool(),
+      filterInputType_,
+      nullptr,
+      numCandidates,
+      std::move(filterChildren)));
+}
+
+void NestedLoopJoinProbe::findRangeCandidates() {
+  const auto& sortedRows = rangeSortedRows_[buildIndex_];
+  const auto& build = currentBuildVector();
+  const auto* probe = input_->childAt(rangeJoin_->probeChannel).get();
+  candidateBegin_ = 0;
+  candidateEnd_ = 0;
+  if (probe->isNullAt(probeRow_)) {
+    return;
+  }
+
+  // The rows up to 'candidateEnd_' have a lower bound <= the probe value.
+  const auto* low = build->childAt(rangeJoin_->lowChannel)->loadedVector();
+  candidateEnd_ = std::upper_bound(
+                      sortedRows.begin(),
+                      sortedRows.end(),
+                      probeRow_,
+                      [&](vector_size_t probeRow, vector_size_t buildRow) {
+                        return probe->compare(low, probeRow, buildRow) < 0;
+                      }) -
+      sortedRows.begin();
+  if (!rangeJoin_->highChannel.has_value()) {
+    return;
+  }
+
+  // The rows before 'candidateBegin_' have an upper bound < the probe value.
+  const auto* high =
+      build->childAt(rangeJoin_->highChannel.value())->loadedVector();
+  const auto& maxHighRows = rangeMaxHighRows_[buildIndex_];
+  candidateBegin_ = std::partition_point(
+                        maxHighRows.begin(),
+                        maxHighRows.begin() + candidateEnd_,
+                        [&](vector_size_t buildRow) {
+                          return buildRow < 0 ||
+                              high->compare(probe, buildRow, probeRow_) < 0;
+                        }) -
+      maxHighRows.begin();
+}
 
+RowVectorPtr NestedLoopJoinProbe::evalJoinCondition(
+    const RowVectorPtr& filterInput) {
   if (filterInputRows_.size() != filterInput->size()) {
     filterInputRows_.resizeFill(filterInput->size(), true);
   }
@@ -499,7 +773,7 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       probeOutMapping_);
   projectChildren(
       projectedChildren,
-      buildVectors_.value()[buildIndex_],
+      currentBuildVector(),
       buildProjections_,
       numOutputRows,
       buildOutMapping_);
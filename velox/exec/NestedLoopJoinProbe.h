@@ -56,8 +56,26 @@ class NestedLoopJoinProbe : public Operator {
       const RowTypePtr& leftType,
       const RowTypePtr& rightType);
 
+  // Looks for conjuncts of the join condition that bound a probe column by
+  // build columns, e.g. 'p BETWEEN b_start AND b_end' or 'p >= b_start'. If
+  // there is a lower bound, sets 'rangeJoin_' so that the join condition is
+  // evaluated only for the build rows that may be within the bounds.
+  void initializeRangeJoin(
+      const core::TypedExprPtr& filter,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  // Sorts the rows of each build vector by the lower bound column of
+  // 'rangeJoin_'.
+  void prepareRangeJoin();
+
   bool getBuildData(ContinueFuture* future);
 
+  // Returns the build vector at 'buildIndex_', decompressed if the build side
+  // compressed it. Keeps the decompressed vector until 'buildIndex_' moves to
+  // another build vector.
+  const RowVectorPtr& currentBuildVector();
+
   // Calculates the number of probe rows to match with the build side vectors
   // given the output batch size limit.
   vector_size_t getNumProbeRows() const;
@@ -82,6 +100,21 @@ class NestedLoopJoinProbe : public Operator {
   // buildMatched_ accordingly.
   RowVectorPtr doMatch(vector_size_t probeCnt);
 
+  // Range join counterpart of doMatch(). Evaluates joinCondition against the
+  // next output batch worth of probe and build row pairs that may be within
+  // the bounds of 'rangeJoin_'. Advances 'probeRow_' past the probe rows that
+  // have no more pairs with the build vector at 'buildIndex_'.
+  RowVectorPtr doRangeMatch();
+
+  // Sets 'candidateBegin_' and 'candidateEnd_' to the positions in
+  // 'rangeSortedRows_' of the build rows that may match 'probeRow_'.
+  void findRangeCandidates();
+
+  // Evaluates joinCondition against 'filterInput', whose rows are the pairs of
+  // rows in 'probeIndices_' and 'buildIndices_'. Returns the pairs that passed
+  // and updates probeMatched_ and buildMatched_ accordingly.
+  RowVectorPtr evalJoinCondition(const RowVectorPtr& filterInput);
+
   // Updates 'probeRow_' and 'buildIndex_' by advancing 'probeRow_' by probeCnt.
   // Returns true if 'buildIndex_' points to the end of 'buildData_'.
   bool advanceProbeRows(vector_size_t probeCnt);
@@ -157,9 +190,32 @@ class NestedLoopJoinProbe : public Operator {
   // Index into buildData_ for the build side vector to process on next call to
   // getOutput().
   size_t buildIndex_{0};
+  // The build vector at 'currentBuildIndex_', decompressed.
+  RowVectorPtr currentBuildVector_;
+  size_t currentBuildIndex_{0};
   std::vector<IdentityProjection> buildProjections_;
   BufferPtr buildIndices_;
 
+  // Range join state. Set if the join condition has a lower bound for a probe
+  // column given by a build column and possibly an upper bound.
+  struct RangeJoin {
+    column_index_t probeChannel;
+    column_index_t lowChannel;
+    std::optional<column_index_t> highChannel;
+  };
+  std::optional<RangeJoin> rangeJoin_;
+  // For each build vector, the rows with a non-null lower bound in the order
+  // of the lower bound.
+  std::vector<std::vector<vector_size_t>> rangeSortedRows_;
+  // For each build vector and position in 'rangeSortedRows_', the row with the
+  // largest upper bound up to and including the position, or -1 if these have
+  // only null upper bounds. Empty if there is no upper bound.
+  std::vector<std::vector<vector_size_t>> rangeMaxHighRows_;
+  // The positions in 'rangeSortedRows_' of the build rows that are left to
+  // pair with 'probeRow_'. 'candidateEnd_' is -1 if not yet found.
+  vector_size_t candidateBegin_{0};
+  vector_size_t candidateEnd_{-1};
+
   // Represents whether probe build rows have been matched.
   std::vector<SelectivityVector> buildMatched_;
   std::vector<IdentityProjection> filterBuildProjections_;
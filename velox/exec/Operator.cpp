@@ -53,7 +53,7 @@ OperatorCtx::createConnectorQueryCtx(
     const std::string& planNodeId,
     memory::MemoryPool* connectorPool,
     const common::SpillConfig* spillConfig) const {
-  return std::make_shared<connector::ConnectorQueryCtx>(
+  auto connectorQueryCtx = std::make_shared<connector::ConnectorQueryCtx>(
       pool_,
       connectorPool,
       driverCtx_->task->queryCtx()->connectorSessionProperties(connectorId),
@@ -65,6 +65,10 @@ OperatorCtx::createConnectorQueryCtx(
       taskId(),
       planNodeId,
       driverCtx_->driverId);
+  connectorQueryCtx->setCacheQuota(driverCtx_->task->queryCtx()->cacheQuota());
+  connectorQueryCtx->setAdaptiveFilterReorderingEnabled(
+      driverCtx_->queryConfig().adaptiveFilterReorderingEnabled());
+  return connectorQueryCtx;
 }
 
 Operator::Operator(
@@ -271,6 +275,40 @@ uint32_t Operator::outputBatchRows(
       queryConfig.preferredOutputBatchBytes() / rowSize, 1);
 }
 
+vector_size_t Operator::tunedOutputBatchRows(vector_size_t maxRows) {
+  if (FOLLY_UNLIKELY(!batchSizeTunerChecked_)) {
+    batchSizeTunerChecked_ = true;
+    if (operatorCtx_->driverCtx()->queryConfig().adaptiveOutputBatchSize()) {
+      batchSizeTuner_ = std::make_unique<BatchSizeTuner>();
+    }
+  }
+  if (batchSizeTuner_ == nullptr) {
+    return maxRows;
+  }
+  return batchSizeTuner_->batchRows(maxRows);
+}
+
+void Operator::recordOutputBatch(
+    uint64_t runId,
+    uint64_t cpuNanos,
+    vector_size_t numRows) {
+  VELOX_CHECK_NOT_NULL(batchSizeTuner_);
+  if (!batchSizeTuner_->recordOutput(runId, cpuNanos, numRows)) {
+    return;
+  }
+  const auto shift = batchSizeTuner_->shift();
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      "adaptiveOutputBatchRows",
+      RuntimeCounter(batchSizeTuner_->currentBatchRows()));
+  lockedStats->addRuntimeStat(
+      "adaptiveOutputBatchShift", RuntimeCounter(shift));
+  lockedStats->addRuntimeStat(
+      "adaptiveOutputBatchNanosPerRow",
+      RuntimeCounter(
+          batchSizeTuner_->nanosPerRow(shift), RuntimeCounter::Unit::kNanos));
+}
+
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
   uint64_t now =
       std::chrono::duration_cast<std::chrono::microseconds>(
@@ -288,6 +326,42 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+void Operator::recycleOutput(RowVectorPtr output) {
+  releaseOutputToRecycle();
+  outputToRecycle_ = std::move(output);
+}
+
+void Operator::releaseOutputToRecycle() {
+  if (outputToRecycle_ == nullptr) {
+    return;
+  }
+  VectorPtr vector = std::move(outputToRecycle_);
+  operatorCtx_->execCtx()->releaseVector(vector);
+}
+
+RowVectorPtr Operator::getResultVector(vector_size_t size) {
+  releaseOutputToRecycle();
+  return std::static_pointer_cast<RowVector>(
+      operatorCtx_->execCtx()->getVector(outputType_, size));
+}
+
+void Operator::recordVectorPoolStats() {
+  if (!operatorCtx_->hasExecCtx() ||
+      operatorCtx_->execCtx()->vectorPool() == nullptr) {
+    return;
+  }
+  const auto& poolStats = operatorCtx_->execCtx()->vectorPool()->stats();
+  if (poolStats.numReused == 0) {
+    return;
+  }
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      "vectorPoolReusedVectors", RuntimeCounter(poolStats.numReused));
+  lockedStats->addRuntimeStat(
+      "vectorPoolReusedBytes",
+      RuntimeCounter(poolStats.reusedBytes, RuntimeCounter::Unit::kBytes));
+}
+
 void Operator::recordSpillStats() {
   const auto lockedSpillStats = spillStats_.wlock();
   auto lockedStats = stats_.wlock();
@@ -494,6 +568,8 @@ void OperatorStats::add(const OperatorStats& other) {
     }
   }
 
+  addExprNodeStats(exprStats, other.exprStats);
+
   numDrivers += other.numDrivers;
   spilledInputBytes += other.spilledInputBytes;
   spilledBytes += other.spilledBytes;
@@ -531,6 +607,8 @@ void OperatorStats::clear() {
 
   runtimeStats.clear();
 
+  exprStats.clear();
+
   numDrivers = 0;
   spilledInputBytes = 0;
   spilledBytes = 0;
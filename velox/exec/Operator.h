@@ -18,9 +18,11 @@
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanNode.h"
+#include "velox/exec/BatchSizeTuner.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Spiller.h"
+#include "velox/expression/ExprStats.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::exec {
@@ -182,6 +184,11 @@ struct OperatorStats {
 
   std::unordered_map<std::string, RuntimeMetric> runtimeStats;
 
+  /// Statistics for each node of the expression trees evaluated by the
+  /// operator. Populated by filter and project operators if
+  /// QueryConfig::kExprProfileSamplingInterval is set.
+  std::vector<ExprNodeStats> exprStats;
+
   int numDrivers = 0;
 
   OperatorStats() = default;
@@ -259,6 +266,11 @@ class OperatorCtx {
 
   core::ExecCtx* execCtx() const;
 
+  /// True if execCtx() has been created.
+  bool hasExecCtx() const {
+    return execCtx_ != nullptr;
+  }
+
   /// Makes an extract of QueryCtx for use in a connector. 'planNodeId'
   /// is the id of the calling TableScan. This and the task id identify the scan
   /// for column access tracking. 'connectorPool' is an aggregate memory pool
@@ -406,6 +418,15 @@ class Operator : public BaseRuntimeStatWriter {
   /// @return nullptr or a non-empty output vector.
   virtual RowVectorPtr getOutput() = 0;
 
+  /// Hands 'output', a result of getOutput() that has been passed to the next
+  /// operator, back to 'this' so that getResultVector() can reuse its memory
+  /// for a later batch. Invoked by the Driver after addInput() of the next
+  /// operator if QueryConfig::operatorOutputRecycleEnabled() is true. The
+  /// next operator may still hold 'output', so 'output' is kept until the
+  /// next call to getResultVector() or recycleOutput() and is only recycled
+  /// if nothing else references it by then.
+  void recycleOutput(RowVectorPtr output);
+
   /// Returns kNotBlocked if 'this' is not prevented from
   /// advancing. Otherwise, returns a reason and sets 'future' to a
   /// future that will be realized when the reason is no longer present.
@@ -420,6 +441,13 @@ class Operator : public BaseRuntimeStatWriter {
   /// build side is empty.
   virtual bool isFinished() = 0;
 
+  /// Informs 'this' that the downstream operators of the pipeline will take no
+  /// more input, e.g. because a Limit got all its rows. Called by the Driver
+  /// at most once. Operators may release their input sources early, e.g. a
+  /// TableScan closes its data source and cancels its prefetches. The Driver
+  /// continues to call isFinished() until it returns true.
+  virtual void noMoreOutputNeeded() {}
+
   /// Returns single-column dynamically generated filters to be pushed down to
   /// upstream operators. Used to push down filters on join keys from broadcast
   /// hash join into probe-side table scan. Can also be used to push down TopN
@@ -465,6 +493,8 @@ class Operator : public BaseRuntimeStatWriter {
     input_ = nullptr;
     results_.clear();
     recordSpillStats();
+    outputToRecycle_ = nullptr;
+    recordVectorPoolStats();
     // Release the unused memory reservation on close.
     operatorCtx_->pool()->release();
   }
@@ -497,6 +527,21 @@ class Operator : public BaseRuntimeStatWriter {
 
   void recordBlockingTime(uint64_t start, BlockingReason reason);
 
+  /// True if the output batch size of 'this' is tuned at runtime. See
+  /// QueryConfig::kAdaptiveOutputBatchSize.
+  bool hasBatchSizeTuner() const {
+    return batchSizeTuner_ != nullptr;
+  }
+
+  /// Invoked by the Driver after getOutput() returned a batch of 'numRows'
+  /// in the Driver run 'runId' when the CPU time of the thread was
+  /// 'cpuNanos'. Records the picked batch size in the runtime stats once the
+  /// tuning completes.
+  void recordOutputBatch(
+      uint64_t runId,
+      uint64_t cpuNanos,
+      vector_size_t numRows);
+
   virtual std::string toString() const;
 
   /// Used in debug ednpoints.
@@ -742,6 +787,25 @@ class Operator : public BaseRuntimeStatWriter {
   uint32_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
+  /// Returns the number of rows for the next output batch of at most
+  /// 'maxRows'. If QueryConfig::kAdaptiveOutputBatchSize is set, this is a
+  /// fraction of 'maxRows' picked at runtime by the per row cost of the
+  /// pipeline, otherwise 'maxRows'. Operators that size their output batches
+  /// call this for each batch.
+  vector_size_t tunedOutputBatchRows(vector_size_t maxRows);
+
+  /// Returns a possibly recycled vector of 'outputType_' and 'size' for the
+  /// result of getOutput(). See recycleOutput().
+  RowVectorPtr getResultVector(vector_size_t size);
+
+  /// Invoked to record the reuse stats of the vector pool of the operator in
+  /// operator stats.
+  void recordVectorPoolStats();
+
+  // Moves 'outputToRecycle_' into the vector pool of the operator if it is
+  // not referenced elsewhere.
+  void releaseOutputToRecycle();
+
   /// Invoked to record spill stats in operator stats.
   virtual void recordSpillStats();
 
@@ -779,6 +843,15 @@ class Operator : public BaseRuntimeStatWriter {
 
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       dynamicFilters_;
+
+  /// The last output handed back by recycleOutput().
+  RowVectorPtr outputToRecycle_;
+
+ private:
+  // Set on the first tunedOutputBatchRows() if adaptive batch sizes are
+  // enabled.
+  std::unique_ptr<BatchSizeTuner> batchSizeTuner_;
+  bool batchSizeTunerChecked_{false};
 };
 
 /// Given a row type returns indices for the specified subset of columns.
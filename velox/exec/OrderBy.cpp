@@ -59,6 +59,13 @@ OrderBy::OrderBy(
     sortCompareFlags.push_back(
         fromSortOrderToCompareFlags(orderByNode->sortingOrders()[i]));
   }
+  const auto& queryConfig = driverCtx->queryConfig();
+  std::optional<PrefixSortConfig> prefixSortConfig;
+  if (queryConfig.prefixSortNormalizedKeyMaxBytes() > 0) {
+    prefixSortConfig.emplace(
+        queryConfig.prefixSortNormalizedKeyMaxBytes(),
+        queryConfig.prefixSortMinRows());
+  }
   sortBuffer_ = std::make_unique<SortBuffer>(
       outputType_,
       sortColumnIndices,
@@ -66,7 +73,9 @@ OrderBy::OrderBy(
       pool(),
       &nonReclaimableSection_,
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      &spillStats_);
+      &spillStats_,
+      prefixSortConfig,
+      queryConfig.orderByColumnarPayloadMinColumns());
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
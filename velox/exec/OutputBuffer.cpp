@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBuffer.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/core/QueryConfig.h"
+#include "velox/exec/SpillFile.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -80,6 +82,72 @@ std::string ArbitraryBuffer::toString() const {
       hasNoMoreData());
 }
 
+OutputBufferSpillFile::~OutputBufferSpillFile() {
+  file_.reset();
+  if (path_.empty()) {
+    return;
+  }
+  try {
+    auto fs = filesystems::getFileSystem(path_, nullptr);
+    fs->remove(path_);
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to remove output buffer spill file '" << path_
+               << "': " << e.what();
+  }
+}
+
+void OutputBufferSpillFile::write(
+    std::vector<std::unique_ptr<folly::IOBuf>> pages,
+    uint32_t id,
+    const std::string& pathPrefix,
+    const std::string& fileCreateConfig) {
+  std::string path;
+  std::exception_ptr error;
+  try {
+    auto writeFile = SpillWriteFile::create(id, pathPrefix, fileCreateConfig);
+    path = writeFile->path();
+    for (auto& page : pages) {
+      writeFile->write(std::move(page));
+    }
+    writeFile->finish();
+  } catch (const std::exception&) {
+    error = std::current_exception();
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!written_);
+    path_ = std::move(path);
+    error_ = error;
+    written_ = true;
+  }
+  writtenCv_.notify_all();
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+std::unique_ptr<folly::IOBuf> OutputBufferSpillFile::read(
+    uint64_t offset,
+    uint64_t size) {
+  ReadFile* file;
+  {
+    std::unique_lock<std::mutex> l(mutex_);
+    writtenCv_.wait(l, [&]() { return written_; });
+    if (error_ != nullptr) {
+      std::rethrow_exception(error_);
+    }
+    if (file_ == nullptr) {
+      auto fs = filesystems::getFileSystem(path_, nullptr);
+      file_ = fs->openFileForRead(path_);
+    }
+    file = file_.get();
+  }
+  auto iobuf = folly::IOBuf::create(size);
+  file->pread(offset, size, iobuf->writableData());
+  iobuf->append(size);
+  return iobuf;
+}
+
 void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
@@ -91,22 +159,45 @@ void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
 void DestinationBuffer::Stats::recordAcknowledge(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
-  const int64_t size = data.size();
-  bytesBuffered -= size;
+  recordSent(data.size(), numRows.value());
+}
+
+void DestinationBuffer::Stats::recordDelete(const SerializedPage& data) {
+  recordAcknowledge(data);
+}
+
+void DestinationBuffer::Stats::recordDelete(const SpilledPage& data) {
+  bytesSpilled -= data.size;
+  VELOX_DCHECK_GE(bytesSpilled, 0, "bytesSpilled must be non-negative");
+  --pagesSpilled;
+  VELOX_DCHECK_GE(pagesSpilled, 0, "pagesSpilled must be non-negative");
+  recordSent(data.size, data.numRows);
+}
+
+void DestinationBuffer::Stats::recordSpill(const SerializedPage& data) {
+  bytesSpilled += data.size();
+  ++pagesSpilled;
+}
+
+void DestinationBuffer::Stats::recordUnspill(const SerializedPage& data) {
+  bytesSpilled -= data.size();
+  VELOX_DCHECK_GE(bytesSpilled, 0, "bytesSpilled must be non-negative");
+  --pagesSpilled;
+  VELOX_DCHECK_GE(pagesSpilled, 0, "pagesSpilled must be non-negative");
+}
+
+void DestinationBuffer::Stats::recordSent(int64_t bytes, int64_t rows) {
+  bytesBuffered -= bytes;
   VELOX_DCHECK_GE(bytesBuffered, 0, "bytesBuffered must be non-negative");
-  rowsBuffered -= numRows.value();
+  rowsBuffered -= rows;
   VELOX_DCHECK_GE(rowsBuffered, 0, "rowsBuffered must be non-negative");
   --pagesBuffered;
   VELOX_DCHECK_GE(pagesBuffered, 0, "pagesBuffered must be non-negative");
-  bytesSent += size;
-  rowsSent += numRows.value();
+  bytesSent += bytes;
+  rowsSent += rows;
   ++pagesSent;
 }
 
-void DestinationBuffer::Stats::recordDelete(const SerializedPage& data) {
-  recordAcknowledge(data);
-}
-
 DestinationBuffer::Data DestinationBuffer::getData(
     uint64_t maxBytes,
     int64_t sequence,
@@ -130,6 +221,10 @@ DestinationBuffer::Data DestinationBuffer::getData(
       if (arbitraryBuffer) {
         arbitraryBuffer->getAvailablePageSizes(remainingBytes);
       }
+      if (sequence - sequence_ == data_.size()) {
+        bool atEnd = false;
+        appendSpilledPageSizes(remainingBytes, atEnd);
+      }
       if (!remainingBytes.empty()) {
         return {{}, std::move(remainingBytes), true};
       }
@@ -163,6 +258,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
         break;
       }
     }
+    sentSequence_ = std::max<int64_t>(sentSequence_, sequence_ + i);
   }
   bool atEnd = false;
   std::vector<int64_t> remainingBytes;
@@ -175,6 +271,9 @@ DestinationBuffer::Data DestinationBuffer::getData(
     }
     remainingBytes.push_back(data_[i]->size());
   }
+  if (!atEnd) {
+    appendSpilledPageSizes(remainingBytes, atEnd);
+  }
   if (!atEnd && arbitraryBuffer) {
     arbitraryBuffer->getAvailablePageSizes(remainingBytes);
   }
@@ -185,15 +284,129 @@ DestinationBuffer::Data DestinationBuffer::getData(
 }
 
 void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
+  // Pages behind spilled pages wait in 'tail_'.
+  auto& pages = spilled_.empty() ? data_ : tail_;
   // Drop duplicate end markers.
-  if (data == nullptr && !data_.empty() && data_.back() == nullptr) {
+  if (data == nullptr && !pages.empty() && pages.back() == nullptr) {
     return;
   }
 
   if (data != nullptr) {
     stats_.recordEnqueue(*data);
   }
-  data_.push_back(std::move(data));
+  pages.push_back(std::move(data));
+}
+
+size_t DestinationBuffer::firstUnsentIndex() const {
+  return std::min<size_t>(
+      std::max<int64_t>(0, sentSequence_ - sequence_), data_.size());
+}
+
+void DestinationBuffer::appendSpilledPageSizes(
+    std::vector<int64_t>& out,
+    bool& atEnd) const {
+  for (const auto& page : spilled_) {
+    out.push_back(page.size);
+  }
+  for (const auto& page : tail_) {
+    if (page == nullptr) {
+      atEnd = true;
+      break;
+    }
+    out.push_back(page->size());
+  }
+}
+
+int64_t DestinationBuffer::spillableBytes() const {
+  int64_t bytes = 0;
+  const auto& pages = spilled_.empty() ? data_ : tail_;
+  for (auto i = spilled_.empty() ? firstUnsentIndex() : 0; i < pages.size();
+       ++i) {
+    if (pages[i] != nullptr) {
+      bytes += pages[i]->size();
+    }
+  }
+  return bytes;
+}
+
+int64_t DestinationBuffer::spill(
+    const std::shared_ptr<OutputBufferSpillFile>& file,
+    uint64_t& fileOffset,
+    std::vector<std::unique_ptr<folly::IOBuf>>& out,
+    int64_t& numPages) {
+  numPages = 0;
+  auto& pages = spilled_.empty() ? data_ : tail_;
+  const auto first = spilled_.empty() ? firstUnsentIndex() : 0;
+  if (first == pages.size()) {
+    return 0;
+  }
+  const bool atEnd = pages.back() == nullptr;
+  const auto end = pages.size() - (atEnd ? 1 : 0);
+  if (end == first) {
+    return 0;
+  }
+  int64_t numBytes = 0;
+  for (auto i = first; i < end; ++i) {
+    const auto& page = pages[i];
+    spilled_.push_back(
+        {file, fileOffset, page->size(), page->numRows().value()});
+    fileOffset += page->size();
+    out.push_back(page->getIOBuf());
+    stats_.recordSpill(*page);
+    numBytes += page->size();
+    ++numPages;
+  }
+  pages.erase(pages.begin() + first, pages.end());
+  // The end marker follows the spilled pages.
+  if (atEnd) {
+    tail_.push_back(nullptr);
+  }
+  return numBytes;
+}
+
+std::vector<SpilledPage> DestinationBuffer::startUnspill(
+    int64_t sequence,
+    uint64_t maxBytes) {
+  if (spilled_.empty() || unspilling_) {
+    return {};
+  }
+  // 'data_' has no end marker while there are spilled pages.
+  uint64_t availableBytes = 0;
+  for (auto i = std::max<int64_t>(0, sequence - sequence_); i < data_.size();
+       ++i) {
+    availableBytes += data_[i]->size();
+  }
+  std::vector<SpilledPage> pages;
+  for (auto i = 0; i < spilled_.size() && availableBytes < maxBytes; ++i) {
+    pages.push_back(spilled_[i]);
+    availableBytes += spilled_[i].size;
+  }
+  unspilling_ = !pages.empty();
+  return pages;
+}
+
+int64_t DestinationBuffer::finishUnspill(
+    std::vector<std::shared_ptr<SerializedPage>> pages,
+    int64_t& numPages) {
+  VELOX_CHECK(unspilling_);
+  VELOX_CHECK_LE(pages.size(), spilled_.size());
+  unspilling_ = false;
+  numPages = 0;
+  int64_t numBytes = 0;
+  for (auto& page : pages) {
+    stats_.recordUnspill(*page);
+    numBytes += page->size();
+    ++numPages;
+    data_.push_back(std::move(page));
+    spilled_.pop_front();
+  }
+  if (spilled_.empty()) {
+    for (auto& page : tail_) {
+      data_.push_back(std::move(page));
+    }
+    tail_.clear();
+  }
+  return numBytes;
 }
 
 DataAvailable DestinationBuffer::getAndClearNotify() {
@@ -221,6 +434,7 @@ void DestinationBuffer::clearNotify() {
 void DestinationBuffer::finish() {
   VELOX_CHECK_NULL(notify_, "notify must be cleared before finish");
   VELOX_CHECK(data_.empty(), "data must be fetched before finish");
+  VELOX_CHECK(spilled_.empty(), "spilled data must be deleted before finish");
   stats_.finished = true;
 }
 
@@ -293,6 +507,18 @@ DestinationBuffer::deleteResults() {
     freed.push_back(std::move(data_[i]));
   }
   data_.clear();
+  for (const auto& page : spilled_) {
+    stats_.recordDelete(page);
+  }
+  spilled_.clear();
+  unspilling_ = false;
+  for (auto& page : tail_) {
+    if (page != nullptr) {
+      stats_.recordDelete(*page);
+      freed.push_back(std::move(page));
+    }
+  }
+  tail_.clear();
   return freed;
 }
 
@@ -303,7 +529,11 @@ DestinationBuffer::Stats DestinationBuffer::stats() const {
 std::string DestinationBuffer::toString() {
   std::stringstream out;
   out << "[available: " << data_.size() << ", " << "sequence: " << sequence_
-      << ", " << (notify_ ? "notify registered, " : "") << this << "]";
+      << ", " << (notify_ ? "notify registered, " : "");
+  if (!spilled_.empty()) {
+    out << "spilled: " << spilled_.size() << ", ";
+  }
+  out << this << "]";
   return out.str();
 }
 
@@ -332,6 +562,12 @@ OutputBuffer::OutputBuffer(
       kind_(kind),
       maxSize_(task_->queryCtx()->queryConfig().maxOutputBufferSize()),
       continueSize_((maxSize_ * kContinuePct) / 100),
+      maxSpillBytes_(
+          isPartitioned() && !task_->spillDirectory().empty()
+              ? task_->queryCtx()->queryConfig().maxOutputBufferSpillBytes()
+              : 0),
+      spillFileCreateConfig_(
+          task_->queryCtx()->queryConfig().spillFileCreateConfig()),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
       numDrivers_(numDrivers) {
@@ -432,6 +668,58 @@ void OutputBuffer::updateStatsWithFreedPagesLocked(
   VELOX_CHECK_GE(bufferedPages_, 0);
 }
 
+OutputBuffer::SpillRun OutputBuffer::maybeSpillLocked() {
+  SpillRun run;
+  if (maxSpillBytes_ == 0 || bufferedBytes_ <= maxSize_ ||
+      spilledBytes_ >= maxSpillBytes_) {
+    return run;
+  }
+  std::vector<std::pair<int64_t, int32_t>> candidates;
+  for (auto i = 0; i < buffers_.size(); ++i) {
+    if (buffers_[i] != nullptr) {
+      const auto bytes = buffers_[i]->spillableBytes();
+      if (bytes > 0) {
+        candidates.emplace_back(bytes, i);
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), std::greater<>());
+
+  uint64_t fileOffset = 0;
+  for (const auto& [bytes, destination] : candidates) {
+    if (bufferedBytes_ < continueSize_ ||
+        spilledBytes_ + bytes > maxSpillBytes_) {
+      break;
+    }
+    if (run.file == nullptr) {
+      run.file = std::make_shared<OutputBufferSpillFile>();
+    }
+    int64_t numPages;
+    const auto spilledBytes = buffers_[destination]->spill(
+        run.file, fileOffset, run.pages, numPages);
+    updateStatsWithFreedPagesLocked(numPages, spilledBytes);
+    spilledBytes_ += spilledBytes;
+    spilledPages_ += numPages;
+    totalSpilledBytes_ += spilledBytes;
+    totalSpilledPages_ += numPages;
+  }
+  if (!run.pages.empty()) {
+    run.fileId = numSpillFiles_++;
+  }
+  return run;
+}
+
+void OutputBuffer::writeSpillRun(SpillRun& run) {
+  if (run.pages.empty()) {
+    return;
+  }
+  run.file->write(
+      std::move(run.pages),
+      run.fileId,
+      fmt::format("{}/output-buffer", task_->getOrCreateSpillDirectory()),
+      spillFileCreateConfig_);
+}
+
 void OutputBuffer::updateTotalBufferedBytesMsLocked() {
   const auto nowMs = getCurrentTimeMs();
   if (bufferedBytes_ > 0) {
@@ -450,6 +738,7 @@ bool OutputBuffer::enqueue(
   VELOX_CHECK(
       task_->isRunning(), "Task is terminated, cannot add data to output.");
   std::vector<DataAvailable> dataAvailableCallbacks;
+  SpillRun spillRun;
   bool blocked = false;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -469,6 +758,7 @@ bool OutputBuffer::enqueue(
       case PartitionedOutputNode::Kind::kPartitioned:
         enqueuePartitionedOutputLocked(
             destination, std::move(data), dataAvailableCallbacks);
+        spillRun = maybeSpillLocked();
         break;
       default:
         VELOX_UNREACHABLE(PartitionedOutputNode::kindString(kind_));
@@ -485,6 +775,7 @@ bool OutputBuffer::enqueue(
   for (auto& callback : dataAvailableCallbacks) {
     callback.notify();
   }
+  writeSpillRun(spillRun);
 
   return blocked;
 }
@@ -680,6 +971,9 @@ bool OutputBuffer::deleteResults(int destination) {
       VLOG(1) << "Extra delete received for destination " << destination;
       return false;
     }
+    const auto spillStats = buffer->stats();
+    spilledBytes_ -= spillStats.bytesSpilled;
+    spilledPages_ -= spillStats.pagesSpilled;
     freed = buffer->deleteResults();
     dataAvailable = buffer->getAndClearNotify();
     buffer->finish();
@@ -714,6 +1008,7 @@ void OutputBuffer::getData(
   DestinationBuffer::Data data;
   std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
+  std::vector<SpilledPage> spilledPages;
   {
     std::lock_guard<std::mutex> l(mutex_);
 
@@ -726,21 +1021,82 @@ void OutputBuffer::getData(
     if (buffer) {
       freed = buffer->acknowledge(sequence, true);
       updateAfterAcknowledgeLocked(freed, promises);
-      data = buffer->getData(
-          maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
-    } else {
-      data.data.emplace_back(nullptr);
-      data.immediate = true;
-      VLOG(1) << "getData received after deleteResults for destination "
-              << destination << " and sequence " << sequence;
+      if (maxBytes > 0) {
+        spilledPages = buffer->startUnspill(sequence, maxBytes);
+      }
+    }
+    if (spilledPages.empty()) {
+      data = getDataLocked(
+          buffer, destination, maxBytes, sequence, notify, activeCheck);
+    }
+  }
+
+  std::exception_ptr error;
+  if (!spilledPages.empty()) {
+    // Reads the spilled pages outside of 'mutex_'.
+    std::vector<std::shared_ptr<SerializedPage>> pages;
+    pages.reserve(spilledPages.size());
+    try {
+      for (const auto& spilled : spilledPages) {
+        pages.push_back(std::make_shared<SerializedPage>(
+            spilled.file->read(spilled.offset, spilled.size),
+            nullptr,
+            spilled.numRows));
+      }
+    } catch (const std::exception&) {
+      error = std::current_exception();
+      pages.clear();
+    }
+    spilledPages.clear();
+
+    std::lock_guard<std::mutex> l(mutex_);
+    // The destination is deleted if its results were deleted meanwhile.
+    auto* buffer = buffers_[destination].get();
+    if (buffer) {
+      int64_t numPages;
+      const auto bytes = buffer->finishUnspill(std::move(pages), numPages);
+      if (numPages > 0) {
+        updateTotalBufferedBytesMsLocked();
+        bufferedBytes_ += bytes;
+        bufferedPages_ += numPages;
+        spilledBytes_ -= bytes;
+        spilledPages_ -= numPages;
+      }
+    }
+    if (error == nullptr) {
+      data = getDataLocked(
+          buffer, destination, maxBytes, sequence, notify, activeCheck);
     }
   }
   releaseAfterAcknowledge(freed, promises);
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
   if (data.immediate) {
     notify(std::move(data.data), sequence, std::move(data.remainingBytes));
   }
 }
 
+DestinationBuffer::Data OutputBuffer::getDataLocked(
+    DestinationBuffer* buffer,
+    int destination,
+    uint64_t maxBytes,
+    int64_t sequence,
+    const DataAvailableCallback& notify,
+    const DataConsumerActiveCheckCallback& activeCheck) {
+  DestinationBuffer::Data data;
+  if (buffer) {
+    data = buffer->getData(
+        maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
+  } else {
+    data.data.emplace_back(nullptr);
+    data.immediate = true;
+    VLOG(1) << "getData received after deleteResults for destination "
+            << destination << " and sequence " << sequence;
+  }
+  return data;
+}
+
 void OutputBuffer::terminate() {
   VELOX_CHECK(!task_->isRunning());
 
@@ -841,7 +1197,7 @@ OutputBuffer::Stats OutputBuffer::stats() {
 
   updateTotalBufferedBytesMsLocked();
 
-  return OutputBuffer::Stats(
+  OutputBuffer::Stats stats(
       kind_,
       noMoreBuffers_,
       atEnd_,
@@ -854,6 +1210,12 @@ OutputBuffer::Stats OutputBuffer::stats() {
       getAverageBufferTimeMsLocked(),
       countTopBuffers(bufferStats, numOutputBytes_),
       bufferStats);
+  stats.spilledBytes = spilledBytes_;
+  stats.spilledPages = spilledPages_;
+  stats.totalSpilledBytes = totalSpilledBytes_;
+  stats.totalSpilledPages = totalSpilledPages_;
+  stats.numSpillFiles = numSpillFiles_;
+  return stats;
 }
 
 } // namespace facebook::velox::exec
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <condition_variable>
+
+#include "velox/common/file/File.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ExchangeQueue.h"
 
@@ -90,6 +93,50 @@ class ArbitraryBuffer {
   std::deque<std::shared_ptr<SerializedPage>> pages_;
 };
 
+/// A file with pages spilled by an OutputBuffer. The pages of one file may
+/// belong to different destinations. The pages are assigned to the file under
+/// the OutputBuffer mutex and written by write() after the mutex is released,
+/// so that producers and consumers of other destinations do not wait for the
+/// disk. Reads wait for the write to finish. The file is removed when the last
+/// of its pages has been read back or deleted.
+class OutputBufferSpillFile {
+ public:
+  OutputBufferSpillFile() = default;
+
+  ~OutputBufferSpillFile();
+
+  /// Creates the file with 'id' under 'pathPrefix' and writes 'pages' back
+  /// to back. Called once. Throws and fails the pending reads if the write
+  /// fails.
+  void write(
+      std::vector<std::unique_ptr<folly::IOBuf>> pages,
+      uint32_t id,
+      const std::string& pathPrefix,
+      const std::string& fileCreateConfig);
+
+  /// Reads 'size' bytes at 'offset'. Waits for write() to finish first.
+  std::unique_ptr<folly::IOBuf> read(uint64_t offset, uint64_t size);
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable writtenCv_;
+  bool written_{false};
+  // Set if write() failed.
+  std::exception_ptr error_;
+  // Set by write().
+  std::string path_;
+  // Opened on first read.
+  std::unique_ptr<ReadFile> file_;
+};
+
+/// A page of a destination buffer that is kept in an OutputBufferSpillFile.
+struct SpilledPage {
+  std::shared_ptr<OutputBufferSpillFile> file;
+  uint64_t offset;
+  uint64_t size;
+  int64_t numRows;
+};
+
 class DestinationBuffer {
  public:
   /// The data transferred by the destination buffer has two phases:
@@ -104,6 +151,12 @@ class DestinationBuffer {
 
     void recordDelete(const SerializedPage& data);
 
+    void recordDelete(const SpilledPage& data);
+
+    void recordSpill(const SerializedPage& data);
+
+    void recordUnspill(const SerializedPage& data);
+
     bool finished{false};
 
     /// Number of buffered bytes / rows / pages.
@@ -115,6 +168,14 @@ class DestinationBuffer {
     int64_t bytesSent{0};
     int64_t rowsSent{0};
     int64_t pagesSent{0};
+
+    /// Number of buffered bytes / pages that are spilled to disk. Included in
+    /// 'bytesBuffered' and 'pagesBuffered'.
+    int64_t bytesSpilled{0};
+    int64_t pagesSpilled{0};
+
+   private:
+    void recordSent(int64_t bytes, int64_t rows);
   };
 
   void enqueue(std::shared_ptr<SerializedPage> data);
@@ -170,8 +231,38 @@ class DestinationBuffer {
       bool fromGetData);
 
   /// Removes all remaining data from the queue and returns the removed data.
+  /// Drops the spilled pages.
   std::vector<std::shared_ptr<SerializedPage>> deleteResults();
 
+  /// Returns the number of bytes of the pages that have not been returned by
+  /// getData() and can be spilled.
+  int64_t spillableBytes() const;
+
+  /// Moves the pages that have not been returned by getData() to 'file', to
+  /// be read back when they are fetched. Appends the data of the pages to
+  /// 'out', to be written to 'file' at 'fileOffset' and on, and advances
+  /// 'fileOffset' past them. Sets 'numPages' to the number of spilled pages
+  /// and returns their bytes. The pages enqueued after this are kept in
+  /// memory behind the spilled pages.
+  int64_t spill(
+      const std::shared_ptr<OutputBufferSpillFile>& file,
+      uint64_t& fileOffset,
+      std::vector<std::unique_ptr<folly::IOBuf>>& out,
+      int64_t& numPages);
+
+  /// Returns the spilled pages to read back so that the pages from
+  /// 'sequence' on have at least 'maxBytes'. The pages stay spilled until
+  /// finishUnspill(). Returns no pages if no pages are spilled or another
+  /// read back is in progress.
+  std::vector<SpilledPage> startUnspill(int64_t sequence, uint64_t maxBytes);
+
+  /// Replaces the first spilled pages with 'pages', read back from the pages
+  /// returned by startUnspill(). 'pages' is empty if the read failed. Sets
+  /// 'numPages' to the number of pages and returns their bytes.
+  int64_t finishUnspill(
+      std::vector<std::shared_ptr<SerializedPage>> pages,
+      int64_t& numPages);
+
   /// Returns and clears the notify callback, if any, along with arguments for
   /// the callback.
   DataAvailable getAndClearNotify();
@@ -187,9 +278,25 @@ class DestinationBuffer {
  private:
   void clearNotify();
 
+  // Returns the index in 'data_' of the first page not returned by getData().
+  size_t firstUnsentIndex() const;
+
+  // Appends the sizes of the spilled pages and the pages behind them to 'out'.
+  // Sets 'atEnd' if the pages are followed by the end marker.
+  void appendSpilledPageSizes(std::vector<int64_t>& out, bool& atEnd) const;
+
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
+  // The sequence number after the last page returned by getData().
+  int64_t sentSequence_ = 0;
+  // Pages that follow 'data_' and are spilled to disk.
+  std::deque<SpilledPage> spilled_;
+  // Pages enqueued after the pages in 'spilled_'. Moved to 'data_' when all
+  // of 'spilled_' is read back. Empty if 'spilled_' is empty.
+  std::vector<std::shared_ptr<SerializedPage>> tail_;
+  // True between startUnspill() and finishUnspill().
+  bool unspilling_{false};
   DataAvailableCallback notify_{nullptr};
   DataConsumerActiveCheckCallback aliveCheck_{nullptr};
   // The sequence number of the first item to pass to 'notify'.
@@ -254,6 +361,16 @@ class OutputBuffer {
     /// Stats of the OutputBuffer's destinations.
     std::vector<DestinationBuffer::Stats> buffersStats;
 
+    /// The bytes/pages currently spilled to disk. Not included in
+    /// 'bufferedBytes' and 'bufferedPages'.
+    int64_t spilledBytes{0};
+    int64_t spilledPages{0};
+
+    /// The total number of bytes/pages/files spilled by this output buffer.
+    int64_t totalSpilledBytes{0};
+    int64_t totalSpilledPages{0};
+    int64_t numSpillFiles{0};
+
     std::string toString() const;
   };
 
@@ -333,6 +450,23 @@ class OutputBuffer {
 
   void updateStatsWithFreedPagesLocked(int numPages, int64_t pageBytes);
 
+  // Pages taken out of the destination buffers by maybeSpillLocked(), to be
+  // written to 'file' after 'mutex_' is released.
+  struct SpillRun {
+    std::shared_ptr<OutputBufferSpillFile> file;
+    uint32_t fileId{0};
+    std::vector<std::unique_ptr<folly::IOBuf>> pages;
+  };
+
+  // Moves the unsent pages of the destinations with the most unsent bytes to
+  // a spill file until the buffered bytes are below 'continueSize_', if
+  // spilling is enabled and the buffered bytes are over 'maxSize_'. Returns
+  // the pages to write, none if nothing is spilled.
+  SpillRun maybeSpillLocked();
+
+  // Writes the pages of 'run', if any. Called without 'mutex_'.
+  void writeSpillRun(SpillRun& run);
+
   void updateTotalBufferedBytesMsLocked();
 
   int64_t getAverageBufferTimeMsLocked() const;
@@ -365,6 +499,16 @@ class OutputBuffer {
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
+  // Returns the data of 'buffer' for getData(). 'buffer' is nullptr if the
+  // results of 'destination' are deleted.
+  DestinationBuffer::Data getDataLocked(
+      DestinationBuffer* buffer,
+      int destination,
+      uint64_t maxBytes,
+      int64_t sequence,
+      const DataAvailableCallback& notify,
+      const DataConsumerActiveCheckCallback& activeCheck);
+
   std::string toStringLocked() const;
 
   FOLLY_ALWAYS_INLINE bool isBroadcast() const {
@@ -387,6 +531,11 @@ class OutputBuffer {
   // When 'totalSize_' goes below 'continueSize_', blocked producers are
   // resumed.
   const uint64_t continueSize_;
+  // Maximum bytes of pages on disk. Pages are spilled to the task's spill
+  // directory instead of blocking producers while below this. 0 if spilling
+  // is disabled. Only partitioned output spills.
+  const uint64_t maxSpillBytes_;
+  const std::string spillFileCreateConfig_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
 
   // Total number of drivers expected to produce results. This number will
@@ -412,6 +561,12 @@ class OutputBuffer {
   uint64_t numOutputBytes_{0};
   uint64_t numOutputRows_{0};
   uint64_t numOutputPages_{0};
+  // Bytes and pages in spill files, not included in 'bufferedBytes_'.
+  int64_t spilledBytes_{0};
+  int64_t spilledPages_{0};
+  uint64_t totalSpilledBytes_{0};
+  uint64_t totalSpilledPages_{0};
+  uint32_t numSpillFiles_{0};
   std::vector<ContinuePromise> promises_;
   // The next buffer index in 'buffers_' to load data from arbitrary buffer
   // which is only used by arbitrary output type.
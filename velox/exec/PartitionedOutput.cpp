@@ -29,7 +29,8 @@ BlockingReason Destination::advance(
     bool* atEnd,
     ContinueFuture* future,
     Scratch& scratch) {
-  if (rowIdx_ >= rows_.size()) {
+  const auto rows = batchRows();
+  if (rowIdx_ >= rows.size()) {
     *atEnd = true;
     return BlockingReason::kNotBlocked;
   }
@@ -42,8 +43,8 @@ BlockingReason Destination::advance(
 
   // Collect rows to serialize.
   bool shouldFlush = false;
-  while (rowIdx_ < rows_.size() && !shouldFlush) {
-    bytesInCurrent_ += sizes[rows_[rowIdx_]];
+  while (rowIdx_ < rows.size() && !shouldFlush) {
+    bytesInCurrent_ += sizes[rows[rowIdx_]];
     ++rowIdx_;
     ++rowsInCurrent_;
     shouldFlush =
@@ -54,16 +55,12 @@ BlockingReason Destination::advance(
   if (!current_) {
     current_ = std::make_unique<VectorStreamGroup>(pool_);
     auto rowType = asRowType(output->type());
-    serializer::presto::PrestoVectorSerde::PrestoOptions options;
-    options.compressionKind =
-        OutputBufferManager::getInstance().lock()->compressionKind();
-    options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
-    current_->createStreamTree(rowType, rowsInCurrent_, &options);
+    current_->createStreamTree(rowType, rowsInCurrent_, &serdeOptions_);
   }
   current_->append(
-      output, folly::Range(&rows_[firstRow], rowIdx_ - firstRow), scratch);
+      output, folly::Range(&rows[firstRow], rowIdx_ - firstRow), scratch);
   // Update output state variable.
-  if (rowIdx_ == rows_.size()) {
+  if (rowIdx_ == rows.size()) {
     *atEnd = true;
   }
   if (shouldFlush || (eagerFlush_ && rowsInCurrent_ > 0)) {
@@ -155,7 +152,8 @@ PartitionedOutput::PartitionedOutput(
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      skewReplicaGroupSize_(planNode->skewReplicaGroupSize()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -195,12 +193,28 @@ void PartitionedOutput::initializeInput(RowVectorPtr input) {
 void PartitionedOutput::initializeDestinations() {
   if (destinations_.empty()) {
     auto taskId = operatorCtx_->taskId();
+    const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+    serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions;
+    serdeOptions.compressionKind =
+        OutputBufferManager::getInstance().lock()->compressionKind();
+    serdeOptions.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+    serdeOptions.adaptiveCompression = queryConfig.shuffleAdaptiveCompression();
+    serdeOptions.maxCompressionNanosPerByte =
+        queryConfig.shuffleCompressionMaxNanosPerByte();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
-            auto lockedStats = stats_.wlock();
-            lockedStats->addOutputVector(bytes, rows);
-          }));
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          [&](uint64_t bytes, uint64_t rows) {
+            stats_.wlock()->addOutputVector(bytes, rows);
+            operatorCtx_->task()
+                ->queryCtx()
+                ->resourceUsage()
+                .addExchangeOutputBytes(bytes);
+          },
+          serdeOptions));
     }
   }
 }
@@ -275,18 +289,87 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
         }
       }
     } else {
-      if (singlePartition.has_value()) {
+      if (singlePartition.has_value() && skewReplicaGroupSize_ > 1) {
+        // All rows may be of a skewed partition.
+        partitions_.assign(numInput, singlePartition.value());
+        partitionRows();
+      } else if (singlePartition.has_value()) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
       } else {
-        for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
-        }
+        partitionRows();
       }
     }
   }
 }
 
+void PartitionedOutput::spreadSkewedPartitions() {
+  const auto numInput = input_->size();
+  if (partitionNumRows_.empty()) {
+    partitionNumRows_.resize(numDestinations_, 0);
+    nextReplica_.resize(numDestinations_);
+  }
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    const auto partition = partitions_[i];
+    ++partitionNumRows_[partition];
+    auto& replica = nextReplica_[partition];
+    if (replica.has_value()) {
+      partitions_[i] = (partition + replica.value()) % numDestinations_;
+      replica = (replica.value() + 1) % skewReplicaGroupSize_;
+    }
+  }
+  numPartitionedRows_ += numInput;
+
+  const auto minRows = std::max<uint64_t>(
+      kMinSkewedPartitionRows,
+      kSkewFactor * numPartitionedRows_ / numDestinations_);
+  int32_t numSkewed = 0;
+  for (auto i = 0; i < numDestinations_; ++i) {
+    if (!nextReplica_[i].has_value() && partitionNumRows_[i] >= minRows) {
+      nextReplica_[i] = 0;
+      ++numSkewed;
+    }
+  }
+  if (numSkewed > 0) {
+    addRuntimeStat(kSkewedPartitions, RuntimeCounter(numSkewed));
+  }
+}
+
+void PartitionedOutput::partitionRows() {
+  const auto numInput = input_->size();
+  if (skewReplicaGroupSize_ > 1) {
+    spreadSkewedPartitions();
+  }
+  partitionOffsets_.assign(numDestinations_ + 1, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++partitionOffsets_[partitions_[i] + 1];
+  }
+  for (auto i = 0; i < numDestinations_; ++i) {
+    partitionOffsets_[i + 1] += partitionOffsets_[i];
+  }
+
+  // Scatter the rows using the start of each partition as its write
+  // position. This shifts the offsets by one partition, which is undone
+  // below.
+  partitionedRows_.resize(numInput);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    partitionedRows_[partitionOffsets_[partitions_[i]]++] = i;
+  }
+  for (auto i = numDestinations_; i > 0; --i) {
+    partitionOffsets_[i] = partitionOffsets_[i - 1];
+  }
+  partitionOffsets_[0] = 0;
+
+  for (auto i = 0; i < numDestinations_; ++i) {
+    const auto begin = partitionOffsets_[i];
+    const auto end = partitionOffsets_[i + 1];
+    if (begin < end) {
+      destinations_[i]->setRows(folly::Range<const vector_size_t*>(
+          partitionedRows_.data() + begin, end - begin));
+    }
+  }
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
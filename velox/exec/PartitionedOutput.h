@@ -16,8 +16,10 @@
 #pragma once
 
 #include <folly/Random.h>
+#include <optional>
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/serializers/PrestoSerializer.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
@@ -27,26 +29,38 @@ class Destination {
  public:
   /// @param recordEnqueued Should be called to record each call to
   /// OutputBufferManager::enqueue. Takes number of bytes and rows.
+  /// @param serdeOptions Options of the serializers of the pages.
   Destination(
       const std::string& taskId,
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      const serializer::presto::PrestoVectorSerde::PrestoOptions& serdeOptions)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
         eagerFlush_(eagerFlush),
-        recordEnqueued_(std::move(recordEnqueued)) {
+        recordEnqueued_(std::move(recordEnqueued)),
+        serdeOptions_(serdeOptions) {
     setTargetSizePct();
   }
 
   // Resets the destination before starting a new batch.
   void beginBatch() {
     rows_.clear();
+    partitionRows_ = {};
     rowIdx_ = 0;
   }
 
+  /// Sets the rows of the batch to 'rows' instead of copying them. 'rows'
+  /// must stay valid until the batch is fully serialized and must not be
+  /// combined with addRow().
+  void setRows(folly::Range<const vector_size_t*> rows) {
+    VELOX_CHECK(rows_.empty());
+    partitionRows_ = rows;
+  }
+
   void addRow(vector_size_t row) {
     rows_.push_back(row);
   }
@@ -58,6 +72,7 @@ class Destination {
   }
 
   // Serializes row from 'output' till either 'maxBytes' have been serialized or
+  // all rows of the batch are serialized.
   BlockingReason advance(
       uint64_t maxBytes,
       const std::vector<vector_size_t>& sizes,
@@ -89,6 +104,14 @@ class Destination {
   void updateStats(Operator* op);
 
  private:
+  // Returns the rows of the current batch.
+  folly::Range<const vector_size_t*> batchRows() const {
+    if (!partitionRows_.empty()) {
+      return partitionRows_;
+    }
+    return folly::Range<const vector_size_t*>(rows_.data(), rows_.size());
+  }
+
   // Sets the next target size for flushing. This is called at the
   // start of each batch of output for the destination. The effect is
   // to make different destinations ready at slightly different times
@@ -107,6 +130,7 @@ class Destination {
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
+  const serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions_;
 
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
@@ -114,7 +138,11 @@ class Destination {
   vector_size_t rowsInCurrent_{0};
   raw_vector<vector_size_t> rows_;
 
-  // First index of 'rows_' that is not appended to 'current_'.
+  // Rows of the batch set by setRows(). Points into the rows of all
+  // destinations held by PartitionedOutput.
+  folly::Range<const vector_size_t*> partitionRows_;
+
+  // First index of the batch rows that is not appended to 'current_'.
   vector_size_t rowIdx_{0};
 
   // The current stream where the input is serialized to. This is cleared on
@@ -151,6 +179,15 @@ class PartitionedOutput : public Operator {
   // network MTU of 64K.
   static constexpr uint64_t kMinDestinationSize = 60 * 1024;
 
+  /// A partition is skewed if it received this many times the average
+  /// number of rows per partition and at least kMinSkewedPartitionRows rows.
+  static constexpr int32_t kSkewFactor = 4;
+  static constexpr uint64_t kMinSkewedPartitionRows = 100'000;
+
+  /// Runtime stat with the number of partitions whose rows are spread over
+  /// their replica group.
+  static inline const std::string kSkewedPartitions{"skewedPartitions"};
+
   PartitionedOutput(
       int32_t operatorId,
       DriverCtx* ctx,
@@ -205,6 +242,17 @@ class PartitionedOutput : public Operator {
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Sorts the rows of the input by partition into 'partitionedRows_' with one
+  // counting sort and sets the rows of each destination to its range. Avoids
+  // appending the rows to each destination one by one, which dominates when
+  // there are many destinations with few rows each per batch.
+  void partitionRows();
+
+  // Sends the rows of skewed partitions round-robin to the destinations of
+  // their replica group and adds the rows of the batch to the per partition
+  // counts. Called before the rows are sorted by partition.
+  void spreadSkewedPartitions();
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -219,6 +267,7 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  const int32_t skewReplicaGroupSize_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -233,6 +282,18 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // Rows of the input ordered by partition. Rows of partition 'i' are in
+  // [partitionOffsets_[i], partitionOffsets_[i + 1]).
+  raw_vector<vector_size_t> partitionedRows_;
+  std::vector<vector_size_t> partitionOffsets_;
+
+  // Number of rows per partition over all batches. Used to detect skew if
+  // 'skewReplicaGroupSize_' > 1.
+  std::vector<uint64_t> partitionNumRows_;
+  uint64_t numPartitionedRows_{0};
+  // Offset in the replica group of the next row of each partition. Set for
+  // skewed partitions only.
+  std::vector<std::optional<int32_t>> nextReplica_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
 };
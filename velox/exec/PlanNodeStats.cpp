@@ -66,6 +66,8 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
     }
   }
 
+  addExprNodeStats(exprStats, stats.exprStats);
+
   // Populating number of drivers for plan nodes with multiple operators is not
   // useful. Each operator could have been executed in different pipelines with
   // different number of drivers.
@@ -247,6 +249,11 @@ std::string printPlanWithStats(
             printCustomStats(stats.customStats, indentation + "   ", stream);
           }
         }
+
+        if (!stats.exprStats.empty()) {
+          stream << std::endl
+                 << printExprNodeStats(stats.exprStats, indentation + "   ");
+        }
       });
 }
 } // namespace facebook::velox::exec
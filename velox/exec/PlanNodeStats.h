@@ -100,6 +100,10 @@ struct PlanNodeStats {
   /// Operator-specific counters.
   std::unordered_map<std::string, RuntimeMetric> customStats;
 
+  /// Statistics for each node of the expression trees evaluated by the
+  /// operators. See OperatorStats::exprStats.
+  std::vector<ExprNodeStats> exprStats;
+
   /// Breakdown of stats by operator type.
   std::unordered_map<std::string, std::unique_ptr<PlanNodeStats>> operatorStats;
 
@@ -150,6 +154,9 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats);
 /// statistics per operator type.
 ///
 /// Note that input row counts and sizes are printed only for leaf plan nodes.
+/// Plan nodes that report expression statistics, see
+/// QueryConfig::kExprProfileSamplingInterval, also include the tree of
+/// expressions with statistics for each node.
 ///
 /// @param includeCustomStats If true, prints operator-specific counters.
 std::string printPlanWithStats(
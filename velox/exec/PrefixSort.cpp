@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/PrefixSort.h"
+#include "velox/exec/Operator.h"
 
 using namespace facebook::velox::exec::prefixsort;
 
@@ -43,6 +44,27 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefix + prefixSortLayout.prefixOffsets[index]);
 }
 
+// Strings in RowContainer may be multipart and are made contiguous before
+// encoding their prefix.
+template <>
+FOLLY_ALWAYS_INLINE void encodeRowColumn<StringView>(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const RowColumn& rowColumn,
+    char* const row,
+    char* const prefix) {
+  std::optional<StringView> value;
+  std::string storage;
+  if (RowContainer::isNullAt(row, rowColumn.nullByte(), rowColumn.nullMask())) {
+    value = std::nullopt;
+  } else {
+    value = HashStringAllocator::contiguousString(
+        *(reinterpret_cast<StringView*>(row + rowColumn.offset())), storage);
+  }
+  prefixSortLayout.encoders[index].encode(
+      value, prefix + prefixSortLayout.prefixOffsets[index]);
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
@@ -72,6 +94,73 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefix);
       return;
     }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      encodeRowColumn<StringView>(
+          prefixSortLayout, index, rowColumn, row, prefix);
+      return;
+    }
+    default:
+      VELOX_UNSUPPORTED(
+          "prefix-sort does not support type kind: {}",
+          mapTypeKindToName(typeKind));
+  }
+}
+
+template <typename T>
+FOLLY_ALWAYS_INLINE void encodeDecodedValue(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const DecodedVector& decoded,
+    vector_size_t row,
+    char* const prefix) {
+  std::optional<T> value;
+  if (decoded.isNullAt(row)) {
+    value = std::nullopt;
+  } else {
+    value = decoded.valueAt<T>(row);
+  }
+  prefixSortLayout.encoders[index].encode(
+      value, prefix + prefixSortLayout.prefixOffsets[index]);
+}
+
+FOLLY_ALWAYS_INLINE void extractDecodedValueToPrefix(
+    TypeKind typeKind,
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const DecodedVector& decoded,
+    vector_size_t row,
+    char* const prefix) {
+  switch (typeKind) {
+    case TypeKind::INTEGER: {
+      encodeDecodedValue<int32_t>(
+          prefixSortLayout, index, decoded, row, prefix);
+      return;
+    }
+    case TypeKind::BIGINT: {
+      encodeDecodedValue<int64_t>(
+          prefixSortLayout, index, decoded, row, prefix);
+      return;
+    }
+    case TypeKind::REAL: {
+      encodeDecodedValue<float>(prefixSortLayout, index, decoded, row, prefix);
+      return;
+    }
+    case TypeKind::DOUBLE: {
+      encodeDecodedValue<double>(prefixSortLayout, index, decoded, row, prefix);
+      return;
+    }
+    case TypeKind::TIMESTAMP: {
+      encodeDecodedValue<Timestamp>(
+          prefixSortLayout, index, decoded, row, prefix);
+      return;
+    }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      encodeDecodedValue<StringView>(
+          prefixSortLayout, index, decoded, row, prefix);
+      return;
+    }
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -121,9 +210,12 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
   const uint32_t numKeys = types.size();
   std::vector<uint32_t> prefixOffsets;
   std::vector<PrefixSortEncoder> encoders;
+  bool lastNormalizedKeyIsPrefix = false;
 
   // Calculate encoders and prefix-offsets, and stop the loop if a key that
-  // cannot be normalized is encountered.
+  // cannot be normalized is encountered. A key normalized to a prefix of its
+  // value is the last normalized key since equal prefixes do not order the
+  // keys after it.
   for (auto i = 0; i < numKeys; ++i) {
     if (normalizedKeySize > maxNormalizedKeySize) {
       break;
@@ -136,6 +228,10 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
           {compareFlags[i].ascending, compareFlags[i].nullsFirst});
       normalizedKeySize += encodedSize.value();
       numNormalizedKeys++;
+      if (PrefixSortEncoder::isPrefixEncoded(types[i]->kind())) {
+        lastNormalizedKeyIsPrefix = true;
+        break;
+      }
     } else {
       break;
     }
@@ -149,10 +245,11 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       numKeys,
       compareFlags,
       numNormalizedKeys == 0,
-      numNormalizedKeys < numKeys,
+      numNormalizedKeys < numKeys || lastNormalizedKeyIsPrefix,
       std::move(prefixOffsets),
       std::move(encoders),
-      padding};
+      padding,
+      lastNormalizedKeyIsPrefix};
 }
 
 FOLLY_ALWAYS_INLINE int PrefixSort::compareAllNormalizedKeys(
@@ -167,10 +264,13 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   if (result != 0) {
     return result;
   }
-  // If prefixes are equal, compare the left sort keys with rowContainer.
+  // If prefixes are equal, compare the left sort keys with rowContainer,
+  // starting with the last normalized key if only its prefix is normalized.
   char* leftAddress = getAddressFromPrefix(left);
   char* rightAddress = getAddressFromPrefix(right);
-  for (auto i = sortLayout_.numNormalizedKeys; i < sortLayout_.numKeys; ++i) {
+  const auto firstKey = sortLayout_.numNormalizedKeys -
+      (sortLayout_.lastNormalizedKeyIsPrefix ? 1 : 0);
+  for (auto i = firstKey; i < sortLayout_.numKeys; ++i) {
     result = rowContainer_->compare(
         leftAddress, rightAddress, i, sortLayout_.compareFlags[i]);
     if (result != 0) {
@@ -213,7 +313,7 @@ void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
   getAddressFromPrefix(prefix) = row;
 }
 
-void PrefixSort::sortInternal(std::vector<char*>& rows) {
+void PrefixSort::sortInternal(folly::Range<char**> rows) {
   const auto numRows = rows.size();
   const auto entrySize = sortLayout_.entrySize;
   memory::ContiguousAllocation prefixAllocation;
@@ -252,4 +352,124 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
   }
 }
 
+// static
+std::unique_ptr<PrefixSortRowComparator> PrefixSortRowComparator::create(
+    const RowTypePtr& rowType,
+    const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys,
+    const std::vector<core::SortOrder>& sortingOrders,
+    uint32_t maxNormalizedKeySize,
+    RowContainer* rowContainer,
+    RowComparator* comparator,
+    memory::MemoryPool* pool) {
+  std::vector<column_index_t> keyChannels;
+  std::vector<TypePtr> keyTypes;
+  std::vector<CompareFlags> compareFlags;
+  for (auto i = 0; i < sortingKeys.size(); ++i) {
+    const auto channel = exprToChannel(sortingKeys[i].get(), rowType);
+    VELOX_USER_CHECK_NE(
+        channel,
+        kConstantChannel,
+        "PrefixSortRowComparator doesn't allow constant comparison keys");
+    keyChannels.push_back(channel);
+    keyTypes.push_back(rowType->childAt(channel));
+    compareFlags.push_back(
+        {sortingOrders[i].isNullsFirst(), sortingOrders[i].isAscending(), false});
+  }
+  auto sortLayout = PrefixSortLayout::makeSortLayout(
+      keyTypes, compareFlags, maxNormalizedKeySize);
+  if (sortLayout.noNormalizedKeys) {
+    return nullptr;
+  }
+  keyChannels.resize(sortLayout.numNormalizedKeys);
+  return std::make_unique<PrefixSortRowComparator>(
+      std::move(keyChannels),
+      std::move(sortLayout),
+      rowContainer,
+      comparator,
+      pool);
+}
+
+PrefixSortRowComparator::PrefixSortRowComparator(
+    std::vector<column_index_t> keyChannels,
+    PrefixSortLayout sortLayout,
+    RowContainer* rowContainer,
+    RowComparator* comparator,
+    memory::MemoryPool* pool)
+    : keyChannels_(std::move(keyChannels)),
+      sortLayout_(std::move(sortLayout)),
+      rowContainer_(rowContainer),
+      comparator_(comparator),
+      entryPool_(pool),
+      inputPrefix_(sortLayout_.normalizedBufferSize / kAlignment) {
+  VELOX_CHECK(!sortLayout_.noNormalizedKeys);
+  VELOX_CHECK_EQ(keyChannels_.size(), sortLayout_.numNormalizedKeys);
+}
+
+char* PrefixSortRowComparator::newEntry() {
+  return entryPool_.allocateFixed(sortLayout_.entrySize, kAlignment);
+}
+
+void PrefixSortRowComparator::encodeRow(char* row, char* entry) {
+  for (auto i = 0; i < sortLayout_.numNormalizedKeys; ++i) {
+    extractRowColumnToPrefix(
+        rowContainer_->columnTypes()[keyChannels_[i]]->kind(),
+        sortLayout_,
+        i,
+        rowContainer_->columnAt(keyChannels_[i]),
+        row,
+        entry);
+  }
+  simd::memset(
+      entry + sortLayout_.normalizedBufferSize - sortLayout_.padding,
+      0,
+      sortLayout_.padding);
+  bitsSwapByWord((uint64_t*)entry, sortLayout_.normalizedBufferSize);
+  *reinterpret_cast<char**>(entry + sortLayout_.normalizedBufferSize) = row;
+}
+
+bool PrefixSortRowComparator::operator()(const char* lhs, const char* rhs) {
+  if (lhs == rhs) {
+    return false;
+  }
+  const auto result = compareByWord(
+      (uint64_t*)lhs, (uint64_t*)rhs, sortLayout_.normalizedBufferSize);
+  if (result != 0) {
+    return result < 0;
+  }
+  if (!sortLayout_.hasNonNormalizedKey) {
+    return false;
+  }
+  return (*comparator_)(rowAt(lhs), rowAt(rhs));
+}
+
+bool PrefixSortRowComparator::operator()(
+    const std::vector<DecodedVector>& decodedVectors,
+    vector_size_t index,
+    const char* rhs) {
+  auto* const prefix = reinterpret_cast<char*>(inputPrefix_.data());
+  for (auto i = 0; i < sortLayout_.numNormalizedKeys; ++i) {
+    extractDecodedValueToPrefix(
+        rowContainer_->columnTypes()[keyChannels_[i]]->kind(),
+        sortLayout_,
+        i,
+        decodedVectors[keyChannels_[i]],
+        index,
+        prefix);
+  }
+  simd::memset(
+      prefix + sortLayout_.normalizedBufferSize - sortLayout_.padding,
+      0,
+      sortLayout_.padding);
+  bitsSwapByWord(inputPrefix_.data(), sortLayout_.normalizedBufferSize);
+  const auto result = compareByWord(
+      inputPrefix_.data(), (uint64_t*)rhs, sortLayout_.normalizedBufferSize);
+  if (result != 0) {
+    return result < 0;
+  }
+  if (!sortLayout_.hasNonNormalizedKey) {
+    return false;
+  }
+  return (*comparator_)(decodedVectors, index, rowAt(rhs));
+}
+
 } // namespace facebook::velox::exec
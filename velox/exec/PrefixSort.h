@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/memory/AllocationPool.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/prefixsort/PrefixSortAlgorithm.h"
@@ -25,7 +26,7 @@ namespace facebook::velox::exec {
 namespace detail {
 
 FOLLY_ALWAYS_INLINE void stdSort(
-    std::vector<char*>& rows,
+    folly::Range<char**> rows,
     RowContainer* rowContainer,
     const std::vector<CompareFlags>& compareFlags) {
   std::sort(
@@ -56,10 +57,9 @@ struct PrefixSortConfig {
 };
 
 /// The layout of prefix-sort buffer, a prefix entry includes:
-/// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
-/// 3. the row address ptr point to RowContainer`s rows is added at the end of
+/// 1. normalized keys. A string key is normalized to its first
+/// PrefixSortEncoder::kStringPrefixSize bytes and is the last normalized key.
+/// 2. the row address ptr point to RowContainer`s rows is added at the end of
 /// prefix.
 struct PrefixSortLayout {
   /// Number of bytes to store a prefix, it equals to:
@@ -82,7 +82,9 @@ struct PrefixSortLayout {
   /// It equals to 'numNormalizedKeys == 0', a little faster.
   const bool noNormalizedKeys;
 
-  /// Whether the sort keys contains non-normalized key.
+  /// Whether the sort keys contains non-normalized key or the last normalized
+  /// key is a prefix of the value, i.e. equal prefixes need to be compared
+  /// with RowContainer.
   const bool hasNonNormalizedKey;
 
   /// Offsets of normalized keys, used to find write locations when
@@ -96,6 +98,10 @@ struct PrefixSortLayout {
   /// during ‘memcmp’
   const int32_t padding;
 
+  /// Whether the last normalized key is a prefix of the value, e.g. of a
+  /// string, so that equal prefixes compare the key again in full.
+  const bool lastNormalizedKeyIsPrefix;
+
   static PrefixSortLayout makeSortLayout(
       const std::vector<TypePtr>& types,
       const std::vector<CompareFlags>& compareFlags,
@@ -122,11 +128,9 @@ class PrefixSort {
   /// the normalized binary string.
   /// For keys can not normalized, we use RowContainer`s compare method to
   /// compare value.
-  /// For keys can part-normalized(Varchar, Row etc.), we will store the
-  /// normalized part and points to raw data in prefix, and custom the points
-  /// compare. The compare strategy will be defined in PrefixSortLayout as
-  /// follow-up, we treat this part as non-normalized until we implement all
-  /// fixed width types.
+  /// For keys can part-normalized(Varchar, Varbinary), we store the leading
+  /// bytes of the value in prefix and compare the key with RowContainer when
+  /// the prefixes are equal. Such a key ends the normalized keys.
   /// For complex types, e.g. ROW that can be converted to scalar types will be
   /// supported.
   /// 4. Extract the original row address ptr from prefixes (previously stored
@@ -140,7 +144,23 @@ class PrefixSort {
       RowContainer* rowContainer,
       const std::vector<CompareFlags>& compareFlags,
       const PrefixSortConfig& config) {
-    if (rowContainer->numRows() < config.threshold) {
+    sort(
+        folly::Range<char**>(rows.data(), rows.size()),
+        pool,
+        rowContainer,
+        compareFlags,
+        config);
+  }
+
+  /// Same as above but sorts an arbitrary subset of rows from 'rowContainer',
+  /// e.g. a spill run which is a subset of the rows in the container.
+  FOLLY_ALWAYS_INLINE static void sort(
+      folly::Range<char**> rows,
+      memory::MemoryPool* pool,
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      const PrefixSortConfig& config) {
+    if (static_cast<int64_t>(rows.size()) < config.threshold) {
       detail::stdSort(rows, rowContainer, compareFlags);
       return;
     }
@@ -159,7 +179,7 @@ class PrefixSort {
   }
 
  private:
-  void sortInternal(std::vector<char*>& rows);
+  void sortInternal(folly::Range<char**> rows);
 
   int compareAllNormalizedKeys(char* left, char* right);
 
@@ -176,4 +196,68 @@ class PrefixSort {
   const PrefixSortLayout sortLayout_;
   RowContainer* const rowContainer_;
 };
+
+/// Compares rows of a RowContainer by their normalized-key prefixes. Used by
+/// heap-based operators such as TopN and TopNRowNumber which keep an entry per
+/// heap element so that most comparisons are a few word compares over fixed
+/// width bytes instead of per-key RowContainer::compare calls. An entry has the
+/// same layout as a prefix in PrefixSort: normalized keys followed by the row
+/// address. Sort keys that can't be normalized are compared with 'comparator'
+/// when the prefixes are equal.
+class PrefixSortRowComparator {
+ public:
+  /// Returns nullptr if the first sorting key can't be normalized.
+  static std::unique_ptr<PrefixSortRowComparator> create(
+      const RowTypePtr& rowType,
+      const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys,
+      const std::vector<core::SortOrder>& sortingOrders,
+      uint32_t maxNormalizedKeySize,
+      RowContainer* rowContainer,
+      RowComparator* comparator,
+      memory::MemoryPool* pool);
+
+  PrefixSortRowComparator(
+      std::vector<column_index_t> keyChannels,
+      PrefixSortLayout sortLayout,
+      RowContainer* rowContainer,
+      RowComparator* comparator,
+      memory::MemoryPool* pool);
+
+  /// Allocates a new entry. The entry stays valid until clear() is called.
+  char* newEntry();
+
+  /// Encodes the sorting keys of 'row' into 'entry' and sets the row address
+  /// of 'entry' to 'row'.
+  void encodeRow(char* row, char* entry);
+
+  /// Returns the row address stored in 'entry'.
+  char* rowAt(const char* entry) const {
+    return *reinterpret_cast<char* const*>(
+        entry + sortLayout_.normalizedBufferSize);
+  }
+
+  /// Returns true if the row of 'lhs' entry < the row of 'rhs' entry.
+  bool operator()(const char* lhs, const char* rhs);
+
+  /// Returns true if decodedVectors[index] < the row of 'rhs' entry.
+  bool operator()(
+      const std::vector<DecodedVector>& decodedVectors,
+      vector_size_t index,
+      const char* rhs);
+
+  /// Frees all the entries.
+  void clear() {
+    entryPool_.clear();
+  }
+
+ private:
+  // Channels of the normalized keys in 'rowContainer_'.
+  const std::vector<column_index_t> keyChannels_;
+  const PrefixSortLayout sortLayout_;
+  RowContainer* const rowContainer_;
+  RowComparator* const comparator_;
+  memory::AllocationPool entryPool_;
+  // Reusable buffer for the normalized keys of an input row.
+  std::vector<uint64_t> inputPrefix_;
+};
 } // namespace facebook::velox::exec
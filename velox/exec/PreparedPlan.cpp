@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PreparedPlan.h"
+
+#include <mutex>
+
+#include "velox/exec/Operator.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+/// The input of the next execute(), shared by the InputNode and its
+/// operator.
+struct PreparedPlan::InputState {
+  RowVectorPtr input;
+  bool noMoreInput{false};
+  /// True if the operator asked for input and there was none, i.e. the last
+  /// input has passed through the output pipeline.
+  bool waiting{false};
+  std::vector<ContinuePromise> promises;
+
+  void notify() {
+    auto promises = std::move(this->promises);
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  }
+};
+
+namespace {
+
+class PreparedInput : public SourceOperator {
+ public:
+  PreparedInput(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const PreparedPlan::InputNode>& node)
+      : SourceOperator(
+            driverCtx,
+            node->outputType(),
+            operatorId,
+            node->id(),
+            "PreparedInput"),
+        state_(node->state()) {}
+
+  RowVectorPtr getOutput() override {
+    return std::move(state_->input);
+  }
+
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (state_->input != nullptr || state_->noMoreInput) {
+      return BlockingReason::kNotBlocked;
+    }
+    state_->waiting = true;
+    state_->promises.emplace_back("PreparedInput::isBlocked");
+    *future = state_->promises.back().getSemiFuture();
+    return BlockingReason::kWaitForProducer;
+  }
+
+  bool isFinished() override {
+    return state_->noMoreInput && state_->input == nullptr;
+  }
+
+ private:
+  const std::shared_ptr<PreparedPlan::InputState> state_;
+};
+
+class PreparedInputTranslator : public Operator::PlanNodeTranslator {
+ public:
+  std::unique_ptr<Operator> toOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const core::PlanNodePtr& node) override {
+    if (auto inputNode =
+            std::dynamic_pointer_cast<const PreparedPlan::InputNode>(node)) {
+      return std::make_unique<PreparedInput>(id, ctx, inputNode);
+    }
+    return nullptr;
+  }
+
+  std::optional<uint32_t> maxDrivers(const core::PlanNodePtr& node) override {
+    if (std::dynamic_pointer_cast<const PreparedPlan::InputNode>(node)) {
+      return 1;
+    }
+    return std::nullopt;
+  }
+};
+
+// Returns the InputNode at the leaf of the pipeline that ends in 'node'.
+// Throws if the pipeline has a node that keeps state across batches.
+std::shared_ptr<const PreparedPlan::InputNode> findInputNode(
+    const core::PlanNodePtr& node) {
+  if (auto inputNode =
+          std::dynamic_pointer_cast<const PreparedPlan::InputNode>(node)) {
+    return inputNode;
+  }
+  if (auto joinNode =
+          std::dynamic_pointer_cast<const core::HashJoinNode>(node)) {
+    const auto joinType = joinNode->joinType();
+    VELOX_USER_CHECK(
+        core::isInnerJoin(joinType) || core::isLeftJoin(joinType) ||
+            core::isLeftSemiFilterJoin(joinType) ||
+            core::isLeftSemiProjectJoin(joinType) ||
+            core::isAntiJoin(joinType),
+        "Unsupported join type in a prepared plan: {}",
+        core::joinTypeName(joinType));
+  } else {
+    VELOX_USER_CHECK(
+        std::dynamic_pointer_cast<const core::FilterNode>(node) ||
+            std::dynamic_pointer_cast<const core::ProjectNode>(node) ||
+            std::dynamic_pointer_cast<const core::UnnestNode>(node),
+        "Unsupported node in the output pipeline of a prepared plan: {}",
+        node->name());
+  }
+  VELOX_USER_CHECK(!node->sources().empty());
+  return findInputNode(node->sources()[0]);
+}
+} // namespace
+
+PreparedPlan::InputNode::InputNode(
+    const core::PlanNodeId& id,
+    RowTypePtr outputType)
+    : PlanNode(id),
+      outputType_(std::move(outputType)),
+      state_(std::make_shared<InputState>()) {}
+
+// static
+std::unique_ptr<PreparedPlan> PreparedPlan::create(
+    const core::PlanNodePtr& plan,
+    std::shared_ptr<core::QueryCtx> queryCtx) {
+  static std::once_flag registerFlag;
+  std::call_once(registerFlag, []() {
+    Operator::registerOperator(std::make_unique<PreparedInputTranslator>());
+  });
+  static std::atomic<uint64_t> numPlans{0};
+
+  auto inputNode = findInputNode(plan);
+  VELOX_USER_CHECK(
+      inputNode->state()->input == nullptr &&
+          !inputNode->state()->noMoreInput,
+      "The InputNode of a prepared plan may be used in one plan only");
+  auto task = Task::create(
+      fmt::format("prepared.{}", numPlans++),
+      core::PlanFragment{plan},
+      0,
+      std::move(queryCtx),
+      Task::ExecutionMode::kSerial);
+  return std::unique_ptr<PreparedPlan>(
+      new PreparedPlan(std::move(task), inputNode->state()));
+}
+
+PreparedPlan::PreparedPlan(
+    std::shared_ptr<Task> task,
+    std::shared_ptr<InputState> input)
+    : task_(std::move(task)), input_(std::move(input)) {}
+
+PreparedPlan::~PreparedPlan() {
+  input_->noMoreInput = true;
+  input_->notify();
+  try {
+    while (task_->isRunning()) {
+      ContinueFuture future = ContinueFuture::makeEmpty();
+      if (task_->next(&future) == nullptr && task_->isRunning()) {
+        if (!future.valid()) {
+          break;
+        }
+        future.wait();
+      }
+    }
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Error finishing prepared plan " << task_->taskId() << ": "
+                 << e.what();
+  }
+  if (task_->isRunning()) {
+    task_->requestCancel();
+  }
+}
+
+std::vector<RowVectorPtr> PreparedPlan::execute(RowVectorPtr input) {
+  VELOX_CHECK_NOT_NULL(input);
+  VELOX_CHECK(!input_->noMoreInput);
+  ++numExecutions_;
+  std::vector<RowVectorPtr> results;
+  if (!task_->isRunning()) {
+    return results;
+  }
+  input_->input = std::move(input);
+  input_->waiting = false;
+  input_->notify();
+  for (;;) {
+    ContinueFuture future = ContinueFuture::makeEmpty();
+    auto result = task_->next(&future);
+    if (result != nullptr) {
+      results.push_back(std::move(result));
+      continue;
+    }
+    if (!task_->isRunning() || (input_->waiting && input_->input == nullptr)) {
+      break;
+    }
+    // Waits for the Drivers that are blocked on other than the input, e.g.
+    // on memory arbitration.
+    VELOX_CHECK(future.valid());
+    future.wait();
+  }
+  // The input of an early finished plan is not consumed.
+  input_->input = nullptr;
+  return results;
+}
+
+} // namespace facebook::velox::exec
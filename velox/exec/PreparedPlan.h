@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/core/QueryCtx.h"
+
+namespace facebook::velox::exec {
+
+class Task;
+
+/// Runs a plan many times on small inputs without instantiating it for each
+/// run. The plan runs in a serial Task that lives as long as 'this'. Its
+/// Drivers, operators, memory pools, compiled expressions and the hash tables
+/// of its join builds are made on the first execute() and kept. Each
+/// execute() passes its input through the output pipeline and returns the
+/// results. The input is given by a PreparedPlan::InputNode at the leaf of the
+/// output pipeline.
+///
+/// The only per execution state of the operators is the batch being
+/// processed, so the output pipeline may only have InputNode, Filter,
+/// Project, Unnest and HashJoin nodes. The joins must be of a type that does
+/// not produce rows at the end of the probe input, i.e. inner, left, left semi
+/// and anti joins. The build sides of the joins and the rest of the plan run
+/// once and must not need splits. Not thread safe.
+class PreparedPlan {
+ public:
+  struct InputState;
+
+  /// The leaf of the output pipeline that produces the input of each
+  /// execute().
+  class InputNode : public core::PlanNode {
+   public:
+    InputNode(const core::PlanNodeId& id, RowTypePtr outputType);
+
+    const RowTypePtr& outputType() const override {
+      return outputType_;
+    }
+
+    const std::vector<core::PlanNodePtr>& sources() const override {
+      static const std::vector<core::PlanNodePtr> kEmptySources;
+      return kEmptySources;
+    }
+
+    std::string_view name() const override {
+      return "PreparedInput";
+    }
+
+    const std::shared_ptr<InputState>& state() const {
+      return state_;
+    }
+
+   private:
+    void addDetails(std::stringstream& /* stream */) const override {}
+
+    const RowTypePtr outputType_;
+    const std::shared_ptr<InputState> state_;
+  };
+
+  /// Prepares 'plan' for running in 'queryCtx'. Throws if 'plan' has no
+  /// InputNode at the leaf of its output pipeline or has nodes in the output
+  /// pipeline that keep state across batches.
+  static std::unique_ptr<PreparedPlan> create(
+      const core::PlanNodePtr& plan,
+      std::shared_ptr<core::QueryCtx> queryCtx);
+
+  /// Finishes the Task.
+  ~PreparedPlan();
+
+  /// Runs the plan on 'input' and returns the results. Returns no results
+  /// after the plan finished early, e.g. in an inner join with an empty build
+  /// side.
+  std::vector<RowVectorPtr> execute(RowVectorPtr input);
+
+  /// The Task that runs the plan.
+  const std::shared_ptr<Task>& task() const {
+    return task_;
+  }
+
+  /// Number of execute() calls.
+  uint64_t numExecutions() const {
+    return numExecutions_;
+  }
+
+ private:
+  PreparedPlan(std::shared_ptr<Task> task, std::shared_ptr<InputState> input);
+
+  const std::shared_ptr<Task> task_;
+  const std::shared_ptr<InputState> input_;
+  uint64_t numExecutions_{0};
+};
+
+} // namespace facebook::velox::exec
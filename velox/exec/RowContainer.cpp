@@ -39,6 +39,27 @@ static int32_t typeKindSize(TypeKind kind) {
   return VELOX_DYNAMIC_TYPE_DISPATCH(kindSize, kind);
 }
 
+// Returns true if a dependent column of 'kind' can be stored outside of the
+// rows.
+bool isColumnarKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
 #if defined(__has_feature)
 #if __has_feature(thread_sanitizer)
 __attribute__((__no_sanitize__("thread")))
@@ -140,7 +161,8 @@ RowContainer::RowContainer(
     bool hasProbedFlag,
     bool hasNormalizedKeys,
     memory::MemoryPool* pool,
-    std::shared_ptr<HashStringAllocator> stringAllocator)
+    std::shared_ptr<HashStringAllocator> stringAllocator,
+    bool columnarDependents)
     : keyTypes_(keyTypes),
       nullableKeys_(nullableKeys),
       isJoinBuild_(isJoinBuild),
@@ -149,7 +171,11 @@ RowContainer::RowContainer(
       rows_(pool),
       stringAllocator_(
           stringAllocator ? stringAllocator
-                          : std::make_shared<HashStringAllocator>(pool)) {
+                          : std::make_shared<HashStringAllocator>(pool)),
+      columnarData_(pool) {
+  VELOX_CHECK(
+      !columnarDependents || accumulators.empty(),
+      "Columnar dependents are not supported with accumulators");
   // Compute the layout of the payload row.  The row has keys, null flags,
   // accumulators, dependent fields. All fields are fixed width. If variable
   // width data is referenced, this is done with StringView(for VARCHAR) and
@@ -171,6 +197,11 @@ RowContainer::RowContainer(
   // build side, the pointer to the next row with the same key is after the
   // optional row size.
   //
+  // If 'columnarDependents' is true, the dependent fields of scalar types are
+  // not in the row. Their values are in per-column chunks addressed by a
+  // uint32_t row number that follows the dependent fields left in the row.
+  // Their null flags stay in the row.
+  //
   // In most cases, rows are prefixed with a normalized_key_t at index
   // -1, 8 bytes below the pointer. This space is reserved for a 64
   // bit unique digest of the keys for speeding up comparison. This
@@ -184,6 +215,7 @@ RowContainer::RowContainer(
   for (auto& type : keyTypes_) {
     typeKinds_.push_back(type->kind());
     types_.push_back(type);
+    columnarIndices_.push_back(-1);
     offsets_.push_back(offset);
     offset += typeKindSize(type->kind());
     nullOffsets_.push_back(nullOffset);
@@ -243,9 +275,22 @@ RowContainer::RowContainer(
     offset += accumulator.fixedWidthSize();
   }
   for (auto& type : dependentTypes) {
+    if (columnarDependents && isColumnarKind(type->kind())) {
+      const auto width = typeKindSize(type->kind());
+      columnarIndices_.push_back(columnarColumns_.size());
+      columnarColumns_.push_back({width, {}});
+      columnarRowSize_ += width;
+      offsets_.push_back(0);
+      continue;
+    }
+    columnarIndices_.push_back(-1);
     offsets_.push_back(offset);
     offset += typeKindSize(type->kind());
   }
+  if (!columnarColumns_.empty()) {
+    rowNumberOffset_ = offset;
+    offset += sizeof(uint32_t);
+  }
   if (isVariableWidth) {
     rowSizeOffset_ = offset;
     offset += sizeof(uint32_t);
@@ -294,11 +339,15 @@ char* RowContainer::newRow() {
   VELOX_DCHECK(mutable_, "Can't add row into an immutable row container");
   ++numRows_;
   char* row;
+  int64_t rowNumber = -1;
   if (firstFreeRow_) {
     row = firstFreeRow_;
     VELOX_CHECK(bits::isBitSet(row, freeFlagOffset_));
     firstFreeRow_ = nextFree(row);
     --numFreeRows_;
+    if (rowNumberOffset_) {
+      rowNumber = columnarRowNumber(row);
+    }
   } else {
     row = rows_.allocateFixed(fixedRowSize_ + normalizedKeySize_, alignment_) +
         normalizedKeySize_;
@@ -306,7 +355,35 @@ char* RowContainer::newRow() {
       ++numRowsWithNormalizedKey_;
     }
   }
-  return initializeRow(row, false /* reuse */);
+  initializeRow(row, false /* reuse */);
+  if (rowNumberOffset_) {
+    initializeColumnarValues(row, rowNumber);
+  }
+  return row;
+}
+
+void RowContainer::initializeColumnarValues(char* row, int64_t rowNumber) {
+  if (rowNumber >= 0) {
+    columnarRowNumber(row) = rowNumber;
+    for (auto i = keyTypes_.size(); i < types_.size(); ++i) {
+      if (columnarIndices_[i] >= 0) {
+        ::memset(
+            columnarValueAt(row, i),
+            0,
+            columnarColumns_[columnarIndices_[i]].width);
+      }
+    }
+    return;
+  }
+  if (numRowNumbers_ % kColumnarChunkRows == 0) {
+    for (auto& column : columnarColumns_) {
+      const auto bytes = kColumnarChunkRows * column.width;
+      auto* chunk = columnarData_.allocateFixed(bytes, alignof(int128_t));
+      ::memset(chunk, 0, bytes);
+      column.chunks.push_back(chunk);
+    }
+  }
+  columnarRowNumber(row) = numRowNumbers_++;
 }
 
 char* RowContainer::initializeRow(char* row, bool reuse) {
@@ -510,6 +587,10 @@ void RowContainer::store(
     vector_size_t index,
     char* row,
     int32_t column) {
+  if (isColumnar(column)) {
+    storeColumnar(decoded, index, row, column);
+    return;
+  }
   auto numKeys = keyTypes_.size();
   bool isKey = column < numKeys;
   if (isKey && !nullableKeys_) {
@@ -537,6 +618,53 @@ void RowContainer::store(
   }
 }
 
+void RowContainer::storeColumnar(
+    const DecodedVector& decoded,
+    vector_size_t index,
+    char* row,
+    int32_t column) {
+  const auto rowColumn = rowColumns_[column];
+  auto* value = columnarValueAt(row, column);
+  if (decoded.isNullAt(index)) {
+    row[rowColumn.nullByte()] |= rowColumn.nullMask();
+    ::memset(value, 0, columnarColumns_[columnarIndices_[column]].width);
+    return;
+  }
+  VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      storeColumnarValue, typeKinds_[column], decoded, index, row, value);
+}
+
+void RowContainer::extractColumnarColumn(
+    const char* const* rows,
+    folly::Range<const vector_size_t*> rowNumbers,
+    int32_t numRows,
+    int32_t columnIndex,
+    int32_t resultOffset,
+    const VectorPtr& result) const {
+  // Gathers the addresses of the values and extracts these as a column without
+  // null flags at offset 0. Null rows and null values get a null address,
+  // which extracts as null.
+  const auto column = rowColumns_[columnIndex];
+  raw_vector<const char*> values(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    const char* row;
+    if (rowNumbers.empty()) {
+      row = rows[i];
+    } else {
+      row = rowNumbers[i] >= 0 ? rows[rowNumbers[i]] : nullptr;
+    }
+    values[i] = row == nullptr || isNullAt(row, column)
+        ? nullptr
+        : columnarValueAt(row, columnIndex);
+  }
+  extractColumn(
+      values.data(),
+      numRows,
+      RowColumn(0, RowColumn::kNotNullOffset),
+      resultOffset,
+      result);
+}
+
 ByteInputStream RowContainer::prepareRead(const char* row, int32_t offset) {
   const auto& view = reinterpret_cast<const std::string_view*>(row + offset);
   // We set 'stream' to range over the ranges that start at the Header
@@ -644,6 +772,9 @@ void RowContainer::extractSerializedRows(
   // bytes (see typeKindSize). Variable-width columns are serialized as 4 bytes
   // of size followed by that many bytes.
 
+  VELOX_CHECK_EQ(
+      rowNumberOffset_, 0, "Columnar dependents cannot be serialized");
+
   // First, calculate total number of bytes needed to serialize all rows.
 
   size_t fixedWidthRowSize = 0;
@@ -712,6 +843,8 @@ void RowContainer::storeSerializedRow(
     vector_size_t index,
     char* row) {
   VELOX_CHECK(!vector.isNullAt(index));
+  VELOX_CHECK_EQ(
+      rowNumberOffset_, 0, "Columnar dependents cannot be serialized");
   auto serialized = vector.valueAt(index);
   size_t offset = 0;
 
@@ -775,14 +908,12 @@ void RowContainer::storeComplexType(
       reinterpret_cast<char*>(position.position), stream.size());
 }
 
-//   static
-int32_t RowContainer::compareStringAsc(
+// static
+int32_t RowContainer::compareNonInlineStringAsc(
     StringView left,
-    const DecodedVector& decoded,
-    vector_size_t index) {
+    StringView right) {
   std::string storage;
-  return HashStringAllocator::contiguousString(left, storage)
-      .compare(decoded.valueAt<StringView>(index));
+  return HashStringAllocator::contiguousString(left, storage).compare(right);
 }
 
 // static
@@ -798,7 +929,10 @@ int RowContainer::compareComplexType(
   return ContainerRowSerde::compare(stream, decoded, index, flags);
 }
 
-int32_t RowContainer::compareStringAsc(StringView left, StringView right) {
+// static
+int32_t RowContainer::compareNonInlineStringsAsc(
+    StringView left,
+    StringView right) {
   std::string leftStorage;
   std::string rightStorage;
   return HashStringAllocator::contiguousString(left, leftStorage)
@@ -872,6 +1006,7 @@ void RowContainer::hash(
     folly::Range<char**> rows,
     bool mix,
     uint64_t* result) {
+  VELOX_DCHECK(!isColumnar(column), "Columnar columns cannot be hashed");
   if (typeKinds_[column] == TypeKind::UNKNOWN) {
     for (auto i = 0; i < rows.size(); ++i) {
       result[i] = mix ? bits::hashMix(result[i], BaseVector::kNullHash)
@@ -904,6 +1039,11 @@ void RowContainer::clear() {
     }
   }
   rows_.clear();
+  columnarData_.clear();
+  for (auto& column : columnarColumns_) {
+    column.chunks.clear();
+  }
+  numRowNumbers_ = 0;
   if (!sharedStringAllocator) {
     if (checkFree_) {
       stringAllocator_->checkEmpty();
@@ -979,6 +1119,7 @@ std::optional<int64_t> RowContainer::estimateRowSize() const {
   }
   int64_t freeBytes = rows_.freeBytes() + fixedRowSize_ * numFreeRows_;
   int64_t usedSize = rows_.allocatedBytes() - freeBytes +
+      columnarData_.allocatedBytes() - columnarData_.freeBytes() +
       stringAllocator_->retainedSize() - stringAllocator_->freeSpace();
   int64_t rowSize = usedSize / numRows_;
   VELOX_CHECK_GT(
@@ -995,7 +1136,8 @@ int64_t RowContainer::sizeIncrement(
   int32_t needRows = std::max<int64_t>(0, numRows - numFreeRows_);
   int64_t needBytes =
       std::max<int64_t>(0, variableLengthBytes - stringAllocator_->freeSpace());
-  return bits::roundUp(needRows * fixedRowSize_, kAllocUnit) +
+  return bits::roundUp(
+             needRows * (fixedRowSize_ + columnarRowSize_), kAllocUnit) +
       bits::roundUp(needBytes, kAllocUnit);
 }
 
@@ -1157,7 +1299,7 @@ std::string RowContainer::toString(const char* row) const {
   auto vector = BaseVector::create<RowVector>(rowType, 1, pool());
 
   for (auto i = 0; i < rowType->size(); ++i) {
-    extractColumn(&row, 1, columnAt(i), 0, vector->childAt(i));
+    extractColumn(&row, 1, i, 0, vector->childAt(i));
   }
 
   return vector->toString(0);
@@ -1248,4 +1390,60 @@ bool RowComparator::operator()(
   }
   return false;
 }
+
+SortKeyComparator::SortKeyComparator(
+    RowContainer* container,
+    const std::vector<std::pair<column_index_t, CompareFlags>>& keys) {
+  keys_.reserve(keys.size());
+  for (const auto& [columnIndex, flags] : keys) {
+    addKey(container, columnIndex, flags);
+  }
+}
+
+SortKeyComparator::SortKeyComparator(
+    RowContainer* container,
+    const std::vector<CompareFlags>& flags) {
+  const auto numKeys =
+      flags.empty() ? container->keyTypes().size() : flags.size();
+  VELOX_CHECK_LE(numKeys, container->columnTypes().size());
+  keys_.reserve(numKeys);
+  for (auto i = 0; i < numKeys; ++i) {
+    addKey(container, i, flags.empty() ? CompareFlags() : flags[i]);
+  }
+}
+
+void SortKeyComparator::addKey(
+    RowContainer* container,
+    column_index_t columnIndex,
+    CompareFlags flags) {
+  const auto kind = container->columnTypes()[columnIndex]->kind();
+  Key key;
+  key.kind = kind;
+  key.columnIndex = columnIndex;
+  key.column = container->columnAt(columnIndex);
+  key.flags = flags;
+  key.container = container;
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      key.scalar = true;
+      key.compare =
+          VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(scalarCompareFunction, kind);
+      break;
+    default:
+      key.scalar = false;
+      key.compare = &compareOtherKey;
+      break;
+  }
+  keys_.push_back(key);
+}
 } // namespace facebook::velox::exec
@@ -230,6 +230,13 @@ class RowContainer {
   /// 'stringAllocator' allows sharing the variable length data arena with
   /// another RowContainer. This is needed for spilling where the same
   /// aggregates are used for reading one container and merging into another.
+  /// 'columnarDependents' stores the dependent columns of scalar types in
+  /// per-column chunks outside of the rows. The row keeps the keys, the null
+  /// flags and a row number that addresses the values in the chunks, so that
+  /// going over the keys of many rows does not bring the payload into cache.
+  /// The columnar columns can be stored, extracted and freed but not compared,
+  /// hashed or serialized, and columnAt() does not address their values. Not
+  /// supported with accumulators.
   RowContainer(
       const std::vector<TypePtr>& keyTypes,
       bool nullableKeys,
@@ -240,7 +247,8 @@ class RowContainer {
       bool hasProbedFlag,
       bool hasNormalizedKey,
       memory::MemoryPool* pool,
-      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr);
+      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr,
+      bool columnarDependents = false);
 
   /// Allocates a new row and initializes possible aggregates to null.
   char* newRow();
@@ -383,8 +391,8 @@ class RowContainer {
       const char* const* rows,
       int32_t numRows,
       int32_t columnIndex,
-      const VectorPtr& result) {
-    extractColumn(rows, numRows, columnAt(columnIndex), result);
+      const VectorPtr& result) const {
+    extractColumn(rows, numRows, columnIndex, 0, result);
   }
 
   /// Copies the values at 'columnIndex' into 'result' (starting at
@@ -395,7 +403,12 @@ class RowContainer {
       int32_t numRows,
       int32_t columnIndex,
       int32_t resultOffset,
-      const VectorPtr& result) {
+      const VectorPtr& result) const {
+    if (isColumnar(columnIndex)) {
+      extractColumnarColumn(
+          rows, {}, numRows, columnIndex, resultOffset, result);
+      return;
+    }
     extractColumn(rows, numRows, columnAt(columnIndex), resultOffset, result);
   }
 
@@ -411,7 +424,17 @@ class RowContainer {
       folly::Range<const vector_size_t*> rowNumbers,
       int32_t columnIndex,
       const vector_size_t resultOffset,
-      const VectorPtr& result) {
+      const VectorPtr& result) const {
+    if (isColumnar(columnIndex)) {
+      extractColumnarColumn(
+          rows,
+          rowNumbers,
+          rowNumbers.size(),
+          columnIndex,
+          resultOffset,
+          result);
+      return;
+    }
     extractColumn(
         rows, rowNumbers, columnAt(columnIndex), resultOffset, result);
   }
@@ -620,6 +643,12 @@ class RowContainer {
     return rowColumns_[index];
   }
 
+  /// Returns true if the values of column 'index' are stored in per-column
+  /// chunks outside of the rows. See 'columnarDependents' of the constructor.
+  bool isColumnar(int32_t index) const {
+    return rowNumberOffset_ != 0 && columnarIndices_[index] >= 0;
+  }
+
   /// Bit offset of the probed flag for a full or right outer join  payload.
   /// 0 if not applicable.
   int32_t probedFlagOffset() const {
@@ -657,7 +686,8 @@ class RowContainer {
       uint64_t* result);
 
   uint64_t allocatedBytes() const {
-    return rows_.allocatedBytes() + stringAllocator_->retainedSize();
+    return rows_.allocatedBytes() + columnarData_.allocatedBytes() +
+        stringAllocator_->retainedSize();
   }
 
   /// Returns the number of fixed size rows that can be allocated without
@@ -771,9 +801,22 @@ class RowContainer {
   std::string toString(const char* row) const;
 
  private:
+  friend class SortKeyComparator;
+
   // Offset of the pointer to the next free row on a free row.
   static constexpr int32_t kNextFreeOffset = 0;
 
+  // Number of rows in a chunk of a columnar column.
+  static constexpr int32_t kColumnarChunkRows = 1024;
+
+  // Values of a dependent column stored outside of the rows. The value of the
+  // row with row number 'n' is at chunks[n / kColumnarChunkRows] + (n %
+  // kColumnarChunkRows) * width.
+  struct ColumnarColumn {
+    int32_t width;
+    std::vector<char*> chunks;
+  };
+
   template <typename T>
   static inline T valueAt(const char* group, int32_t offset) {
     return *reinterpret_cast<const T*>(group + offset);
@@ -869,6 +912,60 @@ class RowContainer {
     return *reinterpret_cast<uint32_t*>(row + rowSizeOffset_);
   }
 
+  uint32_t& columnarRowNumber(char* row) {
+    VELOX_DCHECK(rowNumberOffset_);
+    return *reinterpret_cast<uint32_t*>(row + rowNumberOffset_);
+  }
+
+  // Returns the address of the value of the columnar column 'column' of
+  // 'row'.
+  char* columnarValueAt(const char* row, int32_t column) const {
+    const auto& data = columnarColumns_[columnarIndices_[column]];
+    const auto rowNumber =
+        *reinterpret_cast<const uint32_t*>(row + rowNumberOffset_);
+    return data.chunks[rowNumber / kColumnarChunkRows] +
+        (rowNumber % kColumnarChunkRows) * data.width;
+  }
+
+  // Gives 'row' its row number in the columnar chunks and zeroes its columnar
+  // values. 'rowNumber' is the number of a reused row or -1 for a new row.
+  void initializeColumnarValues(char* row, int64_t rowNumber);
+
+  // Copies the values of the columnar column 'columnIndex' like
+  // extractColumn(). 'rowNumbers' selects the rows from 'rows' if not empty.
+  void extractColumnarColumn(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t columnIndex,
+      int32_t resultOffset,
+      const VectorPtr& result) const;
+
+  // Stores the 'index'th value in 'decoded' as the value of the columnar column
+  // 'column' of 'row'.
+  void storeColumnar(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      char* row,
+      int32_t column);
+
+  template <TypeKind Kind>
+  inline void storeColumnarValue(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      char* row,
+      char* value) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    if constexpr (std::is_same_v<T, StringView>) {
+      RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
+      stringAllocator_->copyMultipart(decoded.valueAt<T>(index), value, 0);
+    } else if constexpr (std::is_same_v<T, int128_t>) {
+      HugeInt::serialize(decoded.valueAt<int128_t>(index), value);
+    } else {
+      *reinterpret_cast<T*>(value) = decoded.valueAt<T>(index);
+    }
+  }
+
   template <TypeKind Kind>
   inline void storeWithNulls(
       const DecodedVector& decoded,
@@ -1023,8 +1120,15 @@ class RowContainer {
       return compareComplexType(row, offset, decoded, index) == 0;
     }
     if constexpr (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
-      return compareStringAsc(
-                 valueAt<StringView>(row, offset), decoded, index) == 0;
+      const auto left = valueAt<StringView>(row, offset);
+      const auto right = decoded.valueAt<StringView>(index);
+      if (left.size() != right.size() || left.comparePrefix(right) != 0) {
+        return false;
+      }
+      if (left.isInline()) {
+        return left == right;
+      }
+      return compareNonInlineStringAsc(left, right) == 0;
     }
 
     using T = typename KindToFlatVector<Kind>::HashRowType;
@@ -1137,6 +1241,12 @@ class RowContainer {
     auto offset = column.offset();
 
     VELOX_DCHECK_LE(numRows + resultOffset, result->size());
+    // The non-null values are deserialized together so that the elements of
+    // arrays and maps are sized once for all rows.
+    std::vector<ByteInputStream> streams;
+    std::vector<vector_size_t> resultIndices;
+    streams.reserve(numRows);
+    resultIndices.reserve(numRows);
     for (int i = 0; i < numRows; ++i) {
       const char* row;
       if constexpr (useRowNumbers) {
@@ -1149,10 +1259,11 @@ class RowContainer {
       if (!row || isNullAt(row, nullByte, nullMask)) {
         result->setNull(resultIndex, true);
       } else {
-        auto stream = prepareRead(row, offset);
-        ContainerRowSerde::deserialize(stream, resultIndex, result.get());
+        streams.push_back(prepareRead(row, offset));
+        resultIndices.push_back(resultIndex);
       }
     }
+    ContainerRowSerde::deserialize(streams, resultIndices, result.get());
   }
 
   static void extractString(
@@ -1160,12 +1271,40 @@ class RowContainer {
       FlatVector<StringView>* values,
       vector_size_t index);
 
+  // Compares the inline prefixes first and reads the possibly multipart
+  // 'left' only if these are equal and 'left' is not inline.
   static int32_t compareStringAsc(
       StringView left,
       const DecodedVector& decoded,
-      vector_size_t index);
+      vector_size_t index) {
+    const auto right = decoded.valueAt<StringView>(index);
+    if (const auto result = left.comparePrefix(right)) {
+      return result;
+    }
+    if (left.isInline()) {
+      return left.compare(right);
+    }
+    return compareNonInlineStringAsc(left, right);
+  }
 
-  static int32_t compareStringAsc(StringView left, StringView right);
+  // Same as above for two values of the container, either of which may be
+  // multipart.
+  static int32_t compareStringAsc(StringView left, StringView right) {
+    if (const auto result = left.comparePrefix(right)) {
+      return result;
+    }
+    if (left.isInline() && right.isInline()) {
+      return left.compare(right);
+    }
+    return compareNonInlineStringsAsc(left, right);
+  }
+
+  // Compares a multipart 'left' of the container with a contiguous 'right'.
+  static int32_t compareNonInlineStringAsc(StringView left, StringView right);
+
+  // Compares 'left' and 'right' of the container, either of which may be
+  // multipart.
+  static int32_t compareNonInlineStringsAsc(StringView left, StringView right);
 
   int32_t compareComplexType(
       const char* row,
@@ -1208,7 +1347,9 @@ class RowContainer {
         continue;
       }
 
-      auto& view = valueAt<FieldType>(row, column.offset());
+      auto& view = isColumnar(column_index)
+          ? *reinterpret_cast<FieldType*>(columnarValueAt(row, column_index))
+          : valueAt<FieldType>(row, column.offset());
       if constexpr (std::is_same_v<FieldType, StringView>) {
         if (view.isInline()) {
           continue;
@@ -1295,8 +1436,23 @@ class RowContainer {
   char* firstFreeRow_ = nullptr;
   uint64_t numFreeRows_ = 0;
 
+  // Offset of the uint32_t row number that addresses the values of the
+  // columnar columns. 0 if there are no columnar columns.
+  int32_t rowNumberOffset_ = 0;
+  // Index into 'columnarColumns_' for each column in 'types_'. -1 if the
+  // column is stored in the row.
+  std::vector<int32_t> columnarIndices_;
+  std::vector<ColumnarColumn> columnarColumns_;
+  // Sum of the widths of the columnar columns.
+  int32_t columnarRowSize_ = 0;
+  // Number of row numbers given to rows. Row numbers of erased rows stay with
+  // the rows in the free list.
+  uint32_t numRowNumbers_ = 0;
+
   memory::AllocationPool rows_;
   std::shared_ptr<HashStringAllocator> stringAllocator_;
+  // Chunks of the columnar columns.
+  memory::AllocationPool columnarData_;
 
   int alignment_ = 1;
 };
@@ -1582,4 +1738,131 @@ class RowComparator {
   RowContainer* rowContainer_;
 };
 
+/// Compares rows stored in a RowContainer by a list of key columns. The type
+/// of each key is resolved once at construction to a function specialized
+/// for the type instead of dispatching on the type for every comparison.
+/// Meant for sort loops that compare the same keys many times.
+class SortKeyComparator {
+ public:
+  /// Compares by the key columns 'keys' of 'container' with their flags, in
+  /// order.
+  SortKeyComparator(
+      RowContainer* container,
+      const std::vector<std::pair<column_index_t, CompareFlags>>& keys);
+
+  /// Compares by the first 'flags.size()' columns of 'container' with
+  /// 'flags', or by all the key columns in ascending order with nulls first
+  /// if 'flags' is empty. Compares like RowContainer::compareRows().
+  SortKeyComparator(
+      RowContainer* container,
+      const std::vector<CompareFlags>& flags);
+
+  /// Returns 0 for equal, < 0 for left < right, > 0 otherwise.
+  int32_t compare(const char* left, const char* right) const {
+    for (const auto& key : keys_) {
+      if (auto result = key.compare(key, left, right)) {
+        return result;
+      }
+    }
+    return 0;
+  }
+
+  /// Sorts 'rows' with 'sorter', which is called with a begin and an end
+  /// iterator and a less than comparator, e.g. a lambda that calls
+  /// std::sort. If there is one key of a scalar type, the comparison is
+  /// inlined into the sort.
+  template <typename TSort>
+  void sort(folly::Range<char**> rows, TSort sorter) const {
+    if (keys_.size() == 1 && keys_[0].scalar) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          sortBySingleKey, keys_[0].kind, rows, sorter);
+      return;
+    }
+    sorter(
+        rows.begin(), rows.end(), [this](const char* left, const char* right) {
+          return compare(left, right) < 0;
+        });
+  }
+
+ private:
+  struct Key;
+  using CompareFunction =
+      int32_t (*)(const Key& key, const char* left, const char* right);
+
+  struct Key {
+    CompareFunction compare;
+    TypeKind kind;
+    // True if 'kind' is a scalar type that is compared with compareScalar().
+    bool scalar;
+    column_index_t columnIndex;
+    RowColumn column;
+    CompareFlags flags;
+    RowContainer* container;
+  };
+
+  template <TypeKind Kind>
+  FOLLY_ALWAYS_INLINE static int32_t compareScalar(
+      const char* left,
+      const char* right,
+      RowColumn column,
+      CompareFlags flags) {
+    const bool leftIsNull = RowContainer::isNullAt(left, column);
+    const bool rightIsNull = RowContainer::isNullAt(right, column);
+    if (FOLLY_UNLIKELY(leftIsNull || rightIsNull)) {
+      if (leftIsNull && rightIsNull) {
+        return 0;
+      }
+      return leftIsNull == flags.nullsFirst ? -1 : 1;
+    }
+
+    int32_t result;
+    if constexpr (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
+      result = RowContainer::compareStringAsc(
+          RowContainer::valueAt<StringView>(left, column.offset()),
+          RowContainer::valueAt<StringView>(right, column.offset()));
+    } else {
+      using T = typename KindToFlatVector<Kind>::HashRowType;
+      result = SimpleVector<T>::comparePrimitiveAsc(
+          RowContainer::valueAt<T>(left, column.offset()),
+          RowContainer::valueAt<T>(right, column.offset()));
+    }
+    return flags.ascending ? result : -result;
+  }
+
+  template <TypeKind Kind>
+  static int32_t compareScalarKey(
+      const Key& key,
+      const char* left,
+      const char* right) {
+    return compareScalar<Kind>(left, right, key.column, key.flags);
+  }
+
+  // Compares complex types through RowContainer::compare().
+  static int32_t
+  compareOtherKey(const Key& key, const char* left, const char* right) {
+    return key.container->compare(left, right, key.columnIndex, key.flags);
+  }
+
+  template <TypeKind Kind>
+  static CompareFunction scalarCompareFunction() {
+    return &compareScalarKey<Kind>;
+  }
+
+  template <TypeKind Kind, typename TSort>
+  void sortBySingleKey(folly::Range<char**> rows, TSort& sorter) const {
+    const auto column = keys_[0].column;
+    const auto flags = keys_[0].flags;
+    sorter(rows.begin(), rows.end(), [&](const char* left, const char* right) {
+      return compareScalar<Kind>(left, right, column, flags) < 0;
+    });
+  }
+
+  void addKey(
+      RowContainer* container,
+      column_index_t columnIndex,
+      CompareFlags flags);
+
+  std::vector<Key> keys_;
+};
+
 } // namespace facebook::velox::exec
@@ -16,9 +16,19 @@
 #include "velox/exec/RowNumber.h"
 #include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+bool useSharedHashTable(
+    const core::RowNumberNode& rowNumberNode,
+    const core::QueryConfig& queryConfig) {
+  return queryConfig.sharedHashTableEnabled() &&
+      !rowNumberNode.partitionKeys().empty();
+}
+} // namespace
+
 RowNumber::RowNumber(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -29,7 +39,8 @@ RowNumber::RowNumber(
           operatorId,
           rowNumberNode->id(),
           "RowNumber",
-          rowNumberNode->canSpill(driverCtx->queryConfig())
+          rowNumberNode->canSpill(driverCtx->queryConfig()) &&
+                  !useSharedHashTable(*rowNumberNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       limit_{rowNumberNode->limit()},
@@ -38,7 +49,16 @@ RowNumber::RowNumber(
   const auto& keys = rowNumberNode->partitionKeys();
   const auto numKeys = keys.size();
 
-  if (numKeys > 0) {
+  if (useSharedHashTable(*rowNumberNode, driverCtx->queryConfig())) {
+    auto table = operatorCtx_->task()->getOrCreateSharedHashTable(
+        driverCtx->splitGroupId, rowNumberNode->id(), [&]() {
+          return std::make_shared<SharedHashTable>(
+              inputType, keys, std::vector<TypePtr>{BIGINT()}, pool());
+        });
+    numRowsOffset_ = table->dependentOffset(0);
+    sharedTableProber_ = std::make_unique<SharedHashTableProber>(
+        std::move(table), inputType, keys);
+  } else if (numKeys > 0) {
     table_ = std::make_unique<HashTable<false>>(
         createVectorHashers(inputType, keys),
         std::vector<Accumulator>{},
@@ -70,10 +90,35 @@ RowNumber::RowNumber(
 void RowNumber::addInput(RowVectorPtr input) {
   const auto numInput = input->size();
 
-  if (table_) {
+  if (sharedTableProber_) {
+    // Computes the row numbers under the lock of each partition of the table
+    // since the other drivers update the same counts.
+    sharedRowNumbers_.resize(numInput);
+    sharedTableProber_->groupProbe(input, [&](HashLookup& lookup) {
+      for (auto i : lookup.newGroups) {
+        setNumRows(lookup.hits[i], 0);
+      }
+      for (auto row : lookup.rows) {
+        auto* partition = lookup.hits[row];
+        const auto rowNumber = numRows(partition) + 1;
+        if (limit_ && rowNumber > limit_) {
+          sharedRowNumbers_[row] = 0;
+          continue;
+        }
+        sharedRowNumbers_[row] = rowNumber;
+        setNumRows(partition, rowNumber);
+      }
+    });
+  } else if (table_) {
     ensureInputFits(input);
 
     if (inputSpiller_ != nullptr) {
+      if (limit_.has_value()) {
+        input = truncateSpillInput(input);
+        if (input == nullptr) {
+          return;
+        }
+      }
       spillInput(input, pool());
       return;
     }
@@ -115,6 +160,8 @@ void RowNumber::noMoreInput() {
   Operator::noMoreInput();
 
   if (inputSpiller_ != nullptr) {
+    // 'table_' may have the row counts of the last spill run.
+    table_->clear();
     inputSpiller_->finishSpill(spillInputPartitionSet_);
     removeEmptyPartitions(spillInputPartitionSet_);
     restoreNextSpillPartition();
@@ -255,6 +302,10 @@ RowVectorPtr RowNumber::getOutput() {
     return nullptr;
   }
 
+  if (sharedTableProber_) {
+    return getOutputForSharedTable();
+  }
+
   if (!table_) {
     // No partition keys.
     return getOutputForSinglePartition();
@@ -350,6 +401,46 @@ RowVectorPtr RowNumber::getOutputForSinglePartition() {
   return output;
 }
 
+RowVectorPtr RowNumber::getOutputForSharedTable() {
+  const auto numInput = input_->size();
+
+  BufferPtr mapping;
+  vector_size_t* rawMapping;
+  vector_size_t index = 0;
+  if (limit_) {
+    mapping = allocateIndices(numInput, pool());
+    rawMapping = mapping->asMutable<vector_size_t>();
+  }
+
+  FlatVector<int64_t>* rowNumbers = nullptr;
+  if (generateRowNumber_) {
+    rowNumbers = &getOrCreateRowNumberVector(numInput);
+  }
+
+  for (auto i = 0; i < numInput; ++i) {
+    const auto rowNumber = sharedRowNumbers_[i];
+    if (limit_) {
+      if (rowNumber == 0) {
+        // Exceeded the limit for this partition. Drop rows.
+        continue;
+      }
+      rawMapping[index++] = i;
+    }
+    if (generateRowNumber_) {
+      rowNumbers->set(i, rowNumber);
+    }
+  }
+
+  RowVectorPtr output;
+  if (!limit_) {
+    output = fillOutput(numInput, nullptr);
+  } else if (index > 0) {
+    output = fillOutput(index, mapping);
+  }
+  input_ = nullptr;
+  return output;
+}
+
 int64_t RowNumber::numRows(char* partition) {
   return *reinterpret_cast<int64_t*>(partition + numRowsOffset_);
 }
@@ -370,7 +461,12 @@ void RowNumber::reclaim(
   }
 
   if (inputSpiller_ != nullptr) {
-    // Already spilled.
+    // Already spilled. With a limit, 'table_' only counts the rows of the
+    // current spill run. Clearing it starts a new run.
+    if (limit_.has_value() && !noMoreInput_) {
+      table_->clear();
+      pool()->release();
+    }
     return;
   }
 
@@ -447,6 +543,50 @@ void RowNumber::spill() {
   }
 }
 
+RowVectorPtr RowNumber::truncateSpillInput(const RowVectorPtr& input) {
+  const auto numInput = input->size();
+  SelectivityVector rows(numInput);
+  table_->prepareForGroupProbe(
+      *lookup_,
+      input,
+      rows,
+      false,
+      BaseHashTable::kNoSpillInputStartPartitionBit);
+  table_->groupProbe(*lookup_);
+
+  // Initialize new partitions with zeros.
+  for (auto i : lookup_->newGroups) {
+    setNumRows(lookup_->hits[i], 0);
+  }
+
+  BufferPtr indices = allocateIndices(numInput, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numSpillRows = 0;
+  for (auto i = 0; i < numInput; ++i) {
+    auto* partition = lookup_->hits[i];
+    const auto numPartitionRows = numRows(partition);
+    if (numPartitionRows < limit_.value()) {
+      setNumRows(partition, numPartitionRows + 1);
+      rawIndices[numSpillRows++] = i;
+    }
+  }
+
+  if (numSpillRows < numInput) {
+    addRuntimeStat(
+        "spillTruncatedRows", RuntimeCounter(numInput - numSpillRows));
+  }
+  if (numSpillRows == 0) {
+    return nullptr;
+  }
+  if (numSpillRows == numInput) {
+    return input;
+  }
+  for (const auto& child : input->children()) {
+    child->loadedVector();
+  }
+  return wrap(numSpillRows, indices, input);
+}
+
 void RowNumber::spillInput(
     const RowVectorPtr& input,
     memory::MemoryPool* pool) {
@@ -18,6 +18,7 @@
 #include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/SharedHashTable.h"
 
 namespace facebook::velox::exec {
 
@@ -62,6 +63,12 @@ class RowNumber : public Operator {
 
   void spillInput(const RowVectorPtr& input, memory::MemoryPool* pool);
 
+  // Returns the rows of 'input' to spill when there is a limit: the rows that
+  // do not exceed 'limit_' for their partition among the rows spilled since
+  // 'table_' was last cleared. The other rows cannot be in the output. Returns
+  // nullptr if no row is left.
+  RowVectorPtr truncateSpillInput(const RowVectorPtr& input);
+
   void spill();
 
   void addSpillInput();
@@ -76,6 +83,8 @@ class RowNumber : public Operator {
 
   RowVectorPtr getOutputForSinglePartition();
 
+  RowVectorPtr getOutputForSharedTable();
+
   FlatVector<int64_t>& getOrCreateRowNumberVector(vector_size_t size);
 
   const std::optional<int32_t> limit_;
@@ -87,6 +96,14 @@ class RowNumber : public Operator {
   std::unique_ptr<HashLookup> lookup_;
   int32_t numRowsOffset_;
 
+  // Used instead of 'table_' if QueryConfig::sharedHashTableEnabled() is set.
+  // Probes the table shared by all drivers of the plan node.
+  std::unique_ptr<SharedHashTableProber> sharedTableProber_;
+
+  // The row number of each row of 'input_' computed by probing
+  // 'sharedTableProber_'. 0 for the rows that exceed 'limit_'.
+  std::vector<int64_t> sharedRowNumbers_;
+
   // Total number of input rows. Used when there are no partitioning keys and
   // therefore no hash table.
   int64_t numTotalInput_{0};
@@ -107,7 +124,10 @@ class RowNumber : public Operator {
 
   SpillPartitionSet spillHashTablePartitionSet_;
 
-  // Spiller for input received after spilling has been triggered.
+  // Spiller for input received after spilling has been triggered. With a
+  // limit, 'table_' counts the rows of each partition spilled by it since
+  // 'table_' was last cleared, so that each run of spilled input has at most
+  // 'limit_' rows per partition.
   std::unique_ptr<Spiller> inputSpiller_;
 
   // Used to restore previously spilled input.
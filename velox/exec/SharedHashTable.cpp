@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SharedHashTable.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+std::vector<column_index_t> keyChannels(
+    const RowTypePtr& inputType,
+    const std::vector<core::FieldAccessTypedExprPtr>& keys) {
+  std::vector<column_index_t> channels;
+  channels.reserve(keys.size());
+  for (const auto& key : keys) {
+    channels.push_back(inputType->getChildIdx(key->name()));
+  }
+  return channels;
+}
+} // namespace
+
+SharedHashTable::SharedHashTable(
+    const RowTypePtr& inputType,
+    const std::vector<core::FieldAccessTypedExprPtr>& keys,
+    const std::vector<TypePtr>& dependentTypes,
+    memory::MemoryPool* pool)
+    : numKeys_(keys.size()) {
+  VELOX_CHECK(!keys.empty());
+  partitions_.reserve(kNumPartitions);
+  for (auto i = 0; i < kNumPartitions; ++i) {
+    auto partition = std::make_unique<Partition>();
+    partition->table = std::make_unique<HashTable<false>>(
+        createVectorHashers(inputType, keys),
+        std::vector<Accumulator>{},
+        dependentTypes,
+        false, // allowDuplicates
+        false, // isJoinBuild
+        false, // hasProbedFlag
+        0, // minTableSizeForParallelJoinBuild
+        pool);
+    partition->lookup =
+        std::make_unique<HashLookup>(partition->table->hashers());
+    partitions_.push_back(std::move(partition));
+  }
+}
+
+void SharedHashTable::groupProbe(
+    int32_t partition,
+    const RowVectorPtr& input,
+    SelectivityVector& rows,
+    const std::function<void(HashLookup&)>& onGroups) {
+  auto& state = *partitions_[partition];
+  std::lock_guard<std::mutex> l(state.mutex);
+  state.table->prepareForGroupProbe(
+      *state.lookup,
+      input,
+      rows,
+      false, // ignoreNullKeys
+      BaseHashTable::kNoSpillInputStartPartitionBit);
+  state.table->groupProbe(*state.lookup);
+  onGroups(*state.lookup);
+}
+
+int32_t SharedHashTable::dependentOffset(column_index_t index) const {
+  return partitions_[0]->table->rows()->columnAt(numKeys_ + index).offset();
+}
+
+uint64_t SharedHashTable::numDistinct() const {
+  uint64_t numDistinct = 0;
+  for (const auto& partition : partitions_) {
+    std::lock_guard<std::mutex> l(partition->mutex);
+    numDistinct += partition->table->numDistinct();
+  }
+  return numDistinct;
+}
+
+SharedHashTableProber::SharedHashTableProber(
+    std::shared_ptr<SharedHashTable> table,
+    const RowTypePtr& inputType,
+    const std::vector<core::FieldAccessTypedExprPtr>& keys)
+    : table_(std::move(table)),
+      partitionFunction_(
+          SharedHashTable::kNumPartitions,
+          inputType,
+          keyChannels(inputType, keys)),
+      partitionRows_(SharedHashTable::kNumPartitions) {}
+
+void SharedHashTableProber::groupProbe(
+    const RowVectorPtr& input,
+    const std::function<void(HashLookup&)>& onGroups) {
+  const auto numInput = input->size();
+  partitionFunction_.partition(*input, partitions_);
+  for (auto& rows : partitionRows_) {
+    rows.resizeFill(numInput, false);
+  }
+  for (auto i = 0; i < numInput; ++i) {
+    partitionRows_[partitions_[i]].setValid(i, true);
+  }
+  for (auto partition = 0; partition < SharedHashTable::kNumPartitions;
+       ++partition) {
+    auto& rows = partitionRows_[partition];
+    rows.updateBounds();
+    if (!rows.hasSelections()) {
+      continue;
+    }
+    table_->groupProbe(partition, input, rows, onGroups);
+  }
+}
+
+} // namespace facebook::velox::exec
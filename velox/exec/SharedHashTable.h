@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+/// Hash table shared by all the drivers of a MarkDistinct or RowNumber
+/// pipeline, so that these do not need their input repartitioned by the
+/// keys. The table is split into kNumPartitions partitions by the hash of
+/// the keys. Each partition is a HashTable of its own and is probed under
+/// the lock of the partition, so the drivers only contend when they probe
+/// the same partition at the same time.
+class SharedHashTable {
+ public:
+  static constexpr int32_t kNumPartitions = 32;
+
+  /// Creates a table over 'keys' of 'inputType' with 'dependentTypes' in
+  /// the rows after the keys. The memory of the table comes from 'pool'.
+  SharedHashTable(
+      const RowTypePtr& inputType,
+      const std::vector<core::FieldAccessTypedExprPtr>& keys,
+      const std::vector<TypePtr>& dependentTypes,
+      memory::MemoryPool* pool);
+
+  /// Finds or creates the groups of 'rows' of 'input'. All of 'rows' must
+  /// be in 'partition'. Calls 'onGroups' under the lock of the partition with
+  /// the lookup of 'rows'. The lookup is only valid in 'onGroups'.
+  void groupProbe(
+      int32_t partition,
+      const RowVectorPtr& input,
+      SelectivityVector& rows,
+      const std::function<void(HashLookup&)>& onGroups);
+
+  /// Returns the offset of the dependent column 'index' in the rows of all
+  /// the partitions.
+  int32_t dependentOffset(column_index_t index) const;
+
+  /// Returns the number of distinct keys across all partitions.
+  uint64_t numDistinct() const;
+
+ private:
+  struct Partition {
+    std::mutex mutex;
+    std::unique_ptr<BaseHashTable> table;
+    std::unique_ptr<HashLookup> lookup;
+  };
+
+  const column_index_t numKeys_;
+  std::vector<std::unique_ptr<Partition>> partitions_;
+};
+
+/// Probes a SharedHashTable from one driver. Splits the input by partition
+/// of the shared table and keeps the reusable memory of the driver.
+class SharedHashTableProber {
+ public:
+  SharedHashTableProber(
+      std::shared_ptr<SharedHashTable> table,
+      const RowTypePtr& inputType,
+      const std::vector<core::FieldAccessTypedExprPtr>& keys);
+
+  /// Finds or creates the groups of all rows of 'input'. Calls 'onGroups'
+  /// once per partition that has rows of 'input', under the lock of the
+  /// partition. See SharedHashTable::groupProbe().
+  void groupProbe(
+      const RowVectorPtr& input,
+      const std::function<void(HashLookup&)>& onGroups);
+
+  const std::shared_ptr<SharedHashTable>& table() const {
+    return table_;
+  }
+
+ private:
+  const std::shared_ptr<SharedHashTable> table_;
+  HashPartitionFunction partitionFunction_;
+
+  // Reusable memory.
+  std::vector<uint32_t> partitions_;
+  std::vector<SelectivityVector> partitionRows_;
+};
+
+} // namespace facebook::velox::exec
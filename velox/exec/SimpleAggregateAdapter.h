@@ -157,6 +157,44 @@ class SimpleAggregateAdapter : public Aggregate {
   struct accumulator_is_aligned<T, std::void_t<decltype(T::is_aligned_)>>
       : std::integral_constant<bool, T::is_aligned_> {};
 
+  // Whether the accumulator defines addInputBatch() or not. If it is defined
+  // and the function has default null behavior and a single argument,
+  // addSingleGroupRawInput() passes flat input to
+  //     void AccumulatorType::addInputBatch(HashStringAllocator* allocator,
+  //                                         const T1* values,
+  //                                         const SelectivityVector& rows)
+  // in one call instead of calling addInput() once per row. 'rows' excludes
+  // the rows where the input is null.
+  template <typename T, typename = void>
+  struct accumulator_add_input_batch : std::false_type {};
+
+  template <typename T>
+  struct accumulator_add_input_batch<
+      T,
+      std::void_t<decltype(&T::addInputBatch)>> : std::true_type {};
+
+  // Whether the accumulator defines combineBatch() or not. Similar to
+  // addInputBatch(), addSingleGroupIntermediateResults() passes flat
+  // intermediate results to
+  //     void AccumulatorType::combineBatch(HashStringAllocator* allocator,
+  //                                        const IntermediateType* values,
+  //                                        const SelectivityVector& rows)
+  // if the function has default null behavior.
+  template <typename T, typename = void>
+  struct accumulator_combine_batch : std::false_type {};
+
+  template <typename T>
+  struct accumulator_combine_batch<T, std::void_t<decltype(&T::combineBatch)>>
+      : std::true_type {};
+
+  // Whether the values of T are stored as an array of T in flat vectors, which
+  // is required by addInputBatch() and combineBatch().
+  template <typename T>
+  struct is_batch_type
+      : std::integral_constant<
+            bool,
+            std::is_same_v<arg_type<T>, T> && !std::is_same_v<T, bool>> {};
+
   static constexpr bool aggregate_default_null_behavior_ =
       aggregate_default_null_behavior<FUNC>::value;
 
@@ -175,6 +213,14 @@ class SimpleAggregateAdapter : public Aggregate {
   static constexpr bool accumulator_is_aligned_ =
       accumulator_is_aligned<typename FUNC::AccumulatorType>::value;
 
+  static constexpr bool accumulator_add_input_batch_ =
+      aggregate_default_null_behavior_ && FUNC::InputType::size_ == 1 &&
+      accumulator_add_input_batch<typename FUNC::AccumulatorType>::value;
+
+  static constexpr bool accumulator_combine_batch_ =
+      aggregate_default_null_behavior_ &&
+      accumulator_combine_batch<typename FUNC::AccumulatorType>::value;
+
   bool isFixedSize() const override {
     return accumulator_is_fixed_size_;
   }
@@ -228,6 +274,23 @@ class SimpleAggregateAdapter : public Aggregate {
       inputDecoded_[i].decode(*args[i], rows);
     }
 
+    if constexpr (accumulator_add_input_batch_) {
+      using TInput = typename FUNC::InputType::template type_at<0>;
+      static_assert(
+          is_batch_type<TInput>::value,
+          "addInputBatch() requires a fixed-width input type");
+      if (addSingleGroupBatch<TInput>(
+              group,
+              inputDecoded_[0],
+              rows,
+              [&](auto* values, auto& batchRows) {
+                value<typename FUNC::AccumulatorType>(group)->addInputBatch(
+                    allocator_, values, batchRows);
+              })) {
+        return;
+      }
+    }
+
     addSingleGroupRawInputImpl(
         group, rows, std::make_index_sequence<FUNC::InputType::size_>{});
   }
@@ -280,6 +343,23 @@ class SimpleAggregateAdapter : public Aggregate {
       bool /* mayPushdown */) override {
     intermediateDecoded_.decode(*args[0], rows);
 
+    if constexpr (accumulator_combine_batch_) {
+      using TIntermediate = typename FUNC::IntermediateType;
+      static_assert(
+          is_batch_type<TIntermediate>::value,
+          "combineBatch() requires a fixed-width intermediate type");
+      if (addSingleGroupBatch<TIntermediate>(
+              group,
+              intermediateDecoded_,
+              rows,
+              [&](auto* values, auto& batchRows) {
+                value<typename FUNC::AccumulatorType>(group)->combineBatch(
+                    allocator_, values, batchRows);
+              })) {
+        return;
+      }
+    }
+
     addSingleGroupIntermediateResultsImpl(group, rows);
   }
 
@@ -368,6 +448,38 @@ class SimpleAggregateAdapter : public Aggregate {
   }
 
  private:
+  // Calls 'addBatch' with the values of 'decoded' and the non-null rows of
+  // 'rows' if 'decoded' is flat. Returns false without calling 'addBatch'
+  // otherwise.
+  template <typename T, typename TAddBatch>
+  bool addSingleGroupBatch(
+      char* group,
+      DecodedVector& decoded,
+      const SelectivityVector& rows,
+      TAddBatch addBatch) {
+    if (!decoded.isIdentityMapping()) {
+      return false;
+    }
+
+    const auto* batchRows = &rows;
+    if (decoded.mayHaveNulls()) {
+      batchRows_ = rows;
+      batchRows_.deselectNulls(decoded.nulls(&rows), rows.begin(), rows.end());
+      batchRows = &batchRows_;
+    }
+    if (!batchRows->hasSelections()) {
+      return true;
+    }
+
+    std::optional<RowSizeTracker<char, uint32_t>> tracker;
+    if constexpr (!accumulator_is_fixed_size_) {
+      tracker.emplace(group[rowSizeOffset_], *allocator_);
+    }
+    addBatch(decoded.data<T>(), *batchRows);
+    clearNull(group);
+    return true;
+  }
+
   template <std::size_t... Is>
   void addRawInputImpl(
       char** groups,
@@ -571,6 +683,9 @@ class SimpleAggregateAdapter : public Aggregate {
 
   std::vector<DecodedVector> inputDecoded_;
   DecodedVector intermediateDecoded_;
+
+  // Non-null rows passed to addInputBatch() or combineBatch().
+  SelectivityVector batchRows_;
 };
 
 } // namespace facebook::velox::exec
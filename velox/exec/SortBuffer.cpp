@@ -26,13 +26,16 @@ SortBuffer::SortBuffer(
     velox::memory::MemoryPool* pool,
     tsan_atomic<bool>* nonReclaimableSection,
     const common::SpillConfig* spillConfig,
-    folly::Synchronized<velox::common::SpillStats>* spillStats)
+    folly::Synchronized<velox::common::SpillStats>* spillStats,
+    const std::optional<PrefixSortConfig>& prefixSortConfig,
+    uint32_t columnarPayloadMinColumns)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
       nonReclaimableSection_(nonReclaimableSection),
       spillConfig_(spillConfig),
-      spillStats_(spillStats) {
+      spillStats_(spillStats),
+      prefixSortConfig_(prefixSortConfig) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -69,8 +72,20 @@ SortBuffer::SortBuffer(
     sortedSpillColumnNames.emplace_back(input->nameOf(i));
   }
 
+  const bool columnarPayload = columnarPayloadMinColumns > 0 &&
+      nonSortedColumnTypes.size() >= columnarPayloadMinColumns;
   data_ = std::make_unique<RowContainer>(
-      sortedColumnTypes, nonSortedColumnTypes, pool_);
+      sortedColumnTypes,
+      true, // nullableKeys
+      std::vector<Accumulator>{},
+      nonSortedColumnTypes,
+      false, // hasNext
+      false, // isJoinBuild
+      false, // hasProbedFlag
+      false, // hasNormalizedKey
+      pool_,
+      nullptr, // stringAllocator
+      columnarPayload);
   spillerStoreType_ =
       ROW(std::move(sortedSpillColumnNames), std::move(sortedSpillColumnTypes));
 }
@@ -112,19 +127,21 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
-        });
+    if (prefixSortConfig_.has_value()) {
+      PrefixSort::sort(
+          sortedRows_,
+          pool_,
+          data_.get(),
+          sortCompareFlags_,
+          prefixSortConfig_.value());
+    } else {
+      SortKeyComparator comparator(data_.get(), sortCompareFlags_);
+      comparator.sort(
+          folly::Range<char**>(sortedRows_.data(), sortedRows_.size()),
+          [](auto begin, auto end, const auto& less) {
+            std::sort(begin, end, less);
+          });
+    }
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -261,7 +278,8 @@ void SortBuffer::spillInput() {
         data_->keyTypes().size(),
         sortCompareFlags_,
         spillConfig_,
-        spillStats_);
+        spillStats_,
+        prefixSortConfig_);
   }
   spiller_->spill();
   data_->clear();
@@ -384,7 +402,12 @@ void SortBuffer::finishSpill() {
   SpillPartitionSet spillPartitionSet;
   spiller_->finishSpill(spillPartitionSet);
   VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
-  spillMerger_ = spillPartitionSet.begin()->second->createOrderedReader(
+  auto& spillPartition = spillPartitionSet.begin()->second;
+  if (spillConfig_->mergeFanIn > 0) {
+    spillPartition->mergeFiles(
+        spillConfig_->mergeFanIn, *spillConfig_, pool(), spillStats_);
+  }
+  spillMerger_ = spillPartition->createOrderedReader(
       spillConfig_->readBufferSize, pool(), spillStats_);
 }
 
@@ -19,6 +19,7 @@
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/Spill.h"
 #include "velox/vector/BaseVector.h"
@@ -27,7 +28,11 @@ namespace facebook::velox::exec {
 
 /// A utility class to accumulate data inside and output the sorted result.
 /// Spilling would be triggered if spilling is enabled and memory usage exceeds
-/// limit.
+/// limit. If 'prefixSortConfig' is set, the in-memory rows and the sorted spill
+/// runs are sorted with PrefixSort instead of std::sort. If there are at least
+/// 'columnarPayloadMinColumns' non-sorting columns and it is not 0, the scalar
+/// non-sorting columns are stored outside of the rows so that sorting and
+/// spilling touch only the sorting keys.
 class SortBuffer {
  public:
   SortBuffer(
@@ -37,7 +42,9 @@ class SortBuffer {
       velox::memory::MemoryPool* pool,
       tsan_atomic<bool>* nonReclaimableSection,
       const common::SpillConfig* spillConfig = nullptr,
-      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr);
+      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr,
+      const std::optional<PrefixSortConfig>& prefixSortConfig = std::nullopt,
+      uint32_t columnarPayloadMinColumns = 0);
 
   void addInput(const VectorPtr& input);
 
@@ -89,6 +96,7 @@ class SortBuffer {
   tsan_atomic<bool>* const nonReclaimableSection_;
   const common::SpillConfig* const spillConfig_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
+  const std::optional<PrefixSortConfig> prefixSortConfig_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SortShuffleWriter.h"
+
+#include <folly/lang/Bits.h>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/SpillFile.h"
+#include "velox/row/UnsafeRowFast.h"
+
+namespace facebook::velox::exec {
+namespace {
+using TRowSize = uint32_t;
+
+// Size of the reads from the run files in finish().
+constexpr uint64_t kReadBufferSize = 1 << 20;
+} // namespace
+
+SortShuffleWriter::SortShuffleWriter(
+    std::unique_ptr<core::PartitionFunction> partitionFunction,
+    uint32_t numPartitions,
+    Options options,
+    memory::MemoryPool* pool)
+    : partitionFunction_(std::move(partitionFunction)),
+      numPartitions_(numPartitions),
+      options_(std::move(options)),
+      pool_(pool) {
+  VELOX_CHECK_NOT_NULL(partitionFunction_);
+  VELOX_CHECK_GT(numPartitions_, 0);
+  VELOX_CHECK(!options_.dataFilePath.empty());
+  VELOX_CHECK(!options_.indexFilePath.empty());
+}
+
+SortShuffleWriter::~SortShuffleWriter() {
+  try {
+    removeRuns();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to remove shuffle spill runs: " << e.what();
+  }
+}
+
+void SortShuffleWriter::write(const RowVectorPtr& input) {
+  VELOX_CHECK(!finished_, "SortShuffleWriter is finished");
+  const auto numRows = input->size();
+  if (numRows == 0) {
+    return;
+  }
+
+  const auto singlePartition =
+      partitionFunction_->partition(*input, partitions_);
+  if (singlePartition.has_value()) {
+    partitions_.assign(numRows, singlePartition.value());
+  }
+  VELOX_CHECK_GE(partitions_.size(), numRows);
+
+  // Sorts the row numbers by partition with a counting sort. The rows of
+  // partition i are sortedRows_[partitionStarts_[i]...partitionStarts_[i +
+  // 1]).
+  partitionStarts_.assign(numPartitions_ + 1, 0);
+  for (auto row = 0; row < numRows; ++row) {
+    VELOX_DCHECK_LT(partitions_[row], numPartitions_);
+    ++partitionStarts_[partitions_[row] + 1];
+  }
+  for (auto i = 0; i < numPartitions_; ++i) {
+    partitionStarts_[i + 1] += partitionStarts_[i];
+  }
+  sortedRows_.resize(numRows);
+  {
+    std::vector<vector_size_t> cursors(
+        partitionStarts_.begin(), partitionStarts_.end() - 1);
+    for (auto row = 0; row < numRows; ++row) {
+      sortedRows_[cursors[partitions_[row]]++] = row;
+    }
+  }
+
+  row::UnsafeRowFast unsafeRow(input);
+  rowSizes_.resize(numRows);
+  if (auto fixedRowSize =
+          row::UnsafeRowFast::fixedRowSize(asRowType(input->type()))) {
+    std::fill(rowSizes_.begin(), rowSizes_.end(), fixedRowSize.value());
+  } else {
+    unsafeRow.rowSizes(0, numRows, rowSizes_.data());
+  }
+
+  // Lays out the rows in partition order. Each row is preceded by its size.
+  Batch batch;
+  batch.partitionOffsets.resize(numPartitions_ + 1);
+  rowOffsets_.resize(numRows);
+  uint64_t offset = 0;
+  for (auto partition = 0; partition < numPartitions_; ++partition) {
+    batch.partitionOffsets[partition] = offset;
+    for (auto i = partitionStarts_[partition];
+         i < partitionStarts_[partition + 1];
+         ++i) {
+      const auto row = sortedRows_[i];
+      rowOffsets_[row] = offset + sizeof(TRowSize);
+      offset += sizeof(TRowSize) + rowSizes_[row];
+    }
+  }
+  batch.partitionOffsets[numPartitions_] = offset;
+
+  batch.data = AlignedBuffer::allocate<char>(offset, pool_, 0);
+  auto* rawData = batch.data->asMutable<char>();
+  unsafeRow.serialize(0, numRows, rowOffsets_.data(), rawData);
+  for (auto row = 0; row < numRows; ++row) {
+    const auto size = folly::Endian::big(static_cast<TRowSize>(rowSizes_[row]));
+    memcpy(rawData + rowOffsets_[row] - sizeof(TRowSize), &size, sizeof(size));
+  }
+
+  bufferedBytes_ += offset;
+  batches_.push_back(std::move(batch));
+  if (bufferedBytes_ > options_.maxBufferedBytes) {
+    spill();
+  }
+}
+
+void SortShuffleWriter::spill() {
+  VELOX_CHECK(!finished_, "SortShuffleWriter is finished");
+  if (batches_.empty()) {
+    return;
+  }
+  VELOX_CHECK(
+      !options_.spillPathPrefix.empty(),
+      "SortShuffleWriter needs a spill path to spill");
+
+  auto file =
+      SpillWriteFile::create(runs_.size(), options_.spillPathPrefix, "");
+  Run run;
+  run.path = file->path();
+  run.partitionOffsets.resize(numPartitions_ + 1);
+  uint64_t offset = 0;
+  for (auto partition = 0; partition < numPartitions_; ++partition) {
+    run.partitionOffsets[partition] = offset;
+    for (const auto& batch : batches_) {
+      const auto begin = batch.partitionOffsets[partition];
+      const auto size = batch.partitionOffsets[partition + 1] - begin;
+      if (size > 0) {
+        offset += file->write(folly::IOBuf::wrapBuffer(
+            batch.data->as<char>() + begin, size));
+      }
+    }
+  }
+  run.partitionOffsets[numPartitions_] = offset;
+  file->finish();
+  runs_.push_back(std::move(run));
+
+  batches_.clear();
+  bufferedBytes_ = 0;
+}
+
+std::vector<uint64_t> SortShuffleWriter::finish() {
+  VELOX_CHECK(!finished_, "SortShuffleWriter is finished");
+  finished_ = true;
+
+  std::vector<std::unique_ptr<ReadFile>> runFiles;
+  for (const auto& run : runs_) {
+    runFiles.push_back(
+        filesystems::getFileSystem(run.path, nullptr)->openFileForRead(
+            run.path));
+  }
+
+  auto dataFile =
+      filesystems::getFileSystem(options_.dataFilePath, nullptr)
+          ->openFileForWrite(options_.dataFilePath);
+  std::string readBuffer;
+  std::vector<uint64_t> partitionSizes(numPartitions_, 0);
+  for (auto partition = 0; partition < numPartitions_; ++partition) {
+    for (auto i = 0; i < runs_.size(); ++i) {
+      auto begin = runs_[i].partitionOffsets[partition];
+      const auto end = runs_[i].partitionOffsets[partition + 1];
+      while (begin < end) {
+        const auto size = std::min(end - begin, kReadBufferSize);
+        readBuffer.resize(size);
+        dataFile->append(runFiles[i]->pread(begin, size, readBuffer.data()));
+        begin += size;
+      }
+      partitionSizes[partition] += end - runs_[i].partitionOffsets[partition];
+    }
+    for (const auto& batch : batches_) {
+      const auto begin = batch.partitionOffsets[partition];
+      const auto size = batch.partitionOffsets[partition + 1] - begin;
+      if (size > 0) {
+        dataFile->append(
+            std::string_view(batch.data->as<char>() + begin, size));
+        partitionSizes[partition] += size;
+      }
+    }
+  }
+  dataFile->close();
+  runFiles.clear();
+  batches_.clear();
+  bufferedBytes_ = 0;
+  removeRuns();
+
+  std::string index((numPartitions_ + 1) * sizeof(int64_t), '\0');
+  auto* rawIndex = reinterpret_cast<int64_t*>(index.data());
+  int64_t offset = 0;
+  rawIndex[0] = 0;
+  for (auto partition = 0; partition < numPartitions_; ++partition) {
+    offset += partitionSizes[partition];
+    rawIndex[partition + 1] = folly::Endian::big(offset);
+  }
+  auto indexFile =
+      filesystems::getFileSystem(options_.indexFilePath, nullptr)
+          ->openFileForWrite(options_.indexFilePath);
+  indexFile->append(index);
+  indexFile->close();
+  return partitionSizes;
+}
+
+void SortShuffleWriter::removeRuns() {
+  for (const auto& run : runs_) {
+    filesystems::getFileSystem(run.path, nullptr)->remove(run.path);
+  }
+  runs_.clear();
+}
+
+} // namespace facebook::velox::exec
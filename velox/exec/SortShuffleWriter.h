@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Writes the output of a Spark shuffle map task as one data file in which
+/// the rows of each reducer partition are next to each other, plus an index
+/// file with the offset of each partition in the data file, like Spark's
+/// sort-based shuffle.
+///
+/// Each input vector is sorted by partition with a counting sort of its row
+/// numbers and serialized in that order into one buffer, which records where
+/// each partition starts. The rows are serialized in the format read by
+/// serializer::spark::UnsafeRowVectorSerde: a 4-byte big-endian size followed
+/// by the UnsafeRow. When the buffered bytes exceed
+/// Options::maxBufferedBytes, the buffers are spilled to a run file with the
+/// ranges of each partition concatenated. finish() concatenates the ranges of
+/// each partition from all the runs and the remaining buffers into the data
+/// file.
+///
+/// The index file has numPartitions + 1 big-endian int64 offsets. Partition i
+/// is the bytes in [offsets[i], offsets[i + 1]) of the data file.
+class SortShuffleWriter {
+ public:
+  struct Options {
+    std::string dataFilePath;
+    std::string indexFilePath;
+
+    /// Prefix of the paths of the spill run files. The runs are removed by
+    /// finish().
+    std::string spillPathPrefix;
+
+    /// The serialized bytes buffered in memory before they are spilled to a
+    /// run file.
+    uint64_t maxBufferedBytes{64 << 20};
+  };
+
+  SortShuffleWriter(
+      std::unique_ptr<core::PartitionFunction> partitionFunction,
+      uint32_t numPartitions,
+      Options options,
+      memory::MemoryPool* pool);
+
+  ~SortShuffleWriter();
+
+  /// Partitions and serializes 'input'. Spills the buffered rows if they
+  /// exceed Options::maxBufferedBytes.
+  void write(const RowVectorPtr& input);
+
+  /// Writes the buffered rows to a run file and frees them. No-op if there
+  /// are no buffered rows.
+  void spill();
+
+  /// Writes the data and index files and removes the run files. Returns the
+  /// number of bytes of each partition in the data file.
+  std::vector<uint64_t> finish();
+
+  /// Returns the serialized bytes buffered in memory.
+  uint64_t bufferedBytes() const {
+    return bufferedBytes_;
+  }
+
+  /// Returns the number of run files spilled so far.
+  uint32_t numSpillRuns() const {
+    return runs_.size();
+  }
+
+ private:
+  // The serialized rows of one input vector, sorted by partition.
+  struct Batch {
+    BufferPtr data;
+    // Partition i is the bytes in [partitionOffsets[i],
+    // partitionOffsets[i + 1]) of 'data'.
+    std::vector<uint64_t> partitionOffsets;
+  };
+
+  // A spilled run, with the same layout as Batch.
+  struct Run {
+    std::string path;
+    std::vector<uint64_t> partitionOffsets;
+  };
+
+  // Removes the run files that were not removed by finish().
+  void removeRuns();
+
+  const std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  const uint32_t numPartitions_;
+  const Options options_;
+  memory::MemoryPool* const pool_;
+
+  std::vector<Batch> batches_;
+  uint64_t bufferedBytes_{0};
+  std::vector<Run> runs_;
+  bool finished_{false};
+
+  // Reusable buffers for write().
+  std::vector<uint32_t> partitions_;
+  std::vector<vector_size_t> partitionStarts_;
+  std::vector<vector_size_t> sortedRows_;
+  std::vector<vector_size_t> rowSizes_;
+  std::vector<size_t> rowOffsets_;
+};
+
+} // namespace facebook::velox::exec
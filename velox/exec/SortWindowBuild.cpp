@@ -241,7 +241,12 @@ void SortWindowBuild::noMoreInput() {
     SpillPartitionSet spillPartitionSet;
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
-    merge_ = spillPartitionSet.begin()->second->createOrderedReader(
+    auto& spillPartition = spillPartitionSet.begin()->second;
+    if (spillConfig_->mergeFanIn > 0) {
+      spillPartition->mergeFiles(
+          spillConfig_->mergeFanIn, *spillConfig_, pool_, spillStats_);
+    }
+    merge_ = spillPartition->createOrderedReader(
         spillConfig_->readBufferSize, pool_, spillStats_);
   } else {
     // At this point we have seen all the input rows. The operator is
@@ -253,6 +258,34 @@ void SortWindowBuild::noMoreInput() {
   }
 }
 
+bool SortWindowBuild::isSamePartition(
+    const char* row,
+    SpillMergeStream& next) {
+  CompareFlags compareFlags =
+      CompareFlags::equality(CompareFlags::NullHandlingMode::kNullAsValue);
+
+  for (auto i = 0; i < numPartitionKeys_; ++i) {
+    if (data_->compare(
+            row,
+            data_->columnAt(i),
+            next.decoded(i),
+            next.currentIndex(),
+            compareFlags)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+char* SortWindowBuild::storeSpilledRow(SpillMergeStream& next) {
+  auto* newRow = data_->newRow();
+  for (auto i = 0; i < inputChannels_.size(); ++i) {
+    data_->store(next.decoded(i), next.currentIndex(), newRow, i);
+  }
+  next.pop();
+  return newRow;
+}
+
 void SortWindowBuild::loadNextPartitionFromSpill() {
   sortedRows_.clear();
   data_->clear();
@@ -263,39 +296,46 @@ void SortWindowBuild::loadNextPartitionFromSpill() {
       break;
     }
 
-    bool newPartition = false;
-    if (!sortedRows_.empty()) {
-      CompareFlags compareFlags =
-          CompareFlags::equality(CompareFlags::NullHandlingMode::kNullAsValue);
-
-      for (auto i = 0; i < numPartitionKeys_; ++i) {
-        if (data_->compare(
-                sortedRows_.back(),
-                data_->columnAt(i),
-                next->decoded(i),
-                next->currentIndex(),
-                compareFlags)) {
-          newPartition = true;
-          break;
-        }
-      }
+    if (!sortedRows_.empty() && !isSamePartition(sortedRows_.back(), *next)) {
+      break;
     }
 
-    if (newPartition) {
+    sortedRows_.push_back(storeSpilledRow(*next));
+  }
+}
+
+void SortWindowBuild::loadPartialPartition(
+    WindowPartition& partition,
+    vector_size_t numRows) {
+  VELOX_CHECK_NOT_NULL(merge_);
+  VELOX_CHECK(partition.partial());
+  sortedRows_.clear();
+
+  bool complete = false;
+  while (partition.numRows() + sortedRows_.size() < numRows) {
+    auto next = merge_->next();
+    if (next == nullptr ||
+        (lastPartialRow_ != nullptr &&
+         !isSamePartition(lastPartialRow_, *next))) {
+      complete = true;
       break;
     }
+    lastPartialRow_ = storeSpilledRow(*next);
+    sortedRows_.push_back(lastPartialRow_);
+  }
 
-    auto* newRow = data_->newRow();
-    for (auto i = 0; i < inputChannels_.size(); ++i) {
-      data_->store(next->decoded(i), next->currentIndex(), newRow, i);
-    }
-    sortedRows_.push_back(newRow);
-    next->pop();
+  partition.addRows(sortedRows_);
+  if (complete) {
+    partition.setComplete();
   }
 }
 
 std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
   if (merge_ != nullptr) {
+    if (partialPartitionsEnabled_) {
+      return std::make_unique<WindowPartition>(
+          data_.get(), inversedInputChannels_, sortKeyInfo_);
+    }
     VELOX_CHECK(!sortedRows_.empty(), "No window partitions available")
     auto partition = folly::Range(sortedRows_.data(), sortedRows_.size());
     return std::make_unique<WindowPartition>(
@@ -322,6 +362,14 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
 
 bool SortWindowBuild::hasNextPartition() {
   if (merge_ != nullptr) {
+    if (partialPartitionsEnabled_) {
+      // The rows of the previous partition have all been processed. The rows
+      // of the next one are loaded by loadPartialPartition().
+      sortedRows_.clear();
+      data_->clear();
+      lastPartialRow_ = nullptr;
+      return merge_->next() != nullptr;
+    }
     loadNextPartitionFromSpill();
     return !sortedRows_.empty();
   }
@@ -55,6 +55,9 @@ class SortWindowBuild : public WindowBuild {
 
   std::unique_ptr<WindowPartition> nextPartition() override;
 
+  void loadPartialPartition(WindowPartition& partition, vector_size_t numRows)
+      override;
+
  private:
   void ensureInputFits(const RowVectorPtr& input);
 
@@ -76,6 +79,13 @@ class SortWindowBuild : public WindowBuild {
   // Reads next partition from spilled data into 'data_' and 'sortedRows_'.
   void loadNextPartitionFromSpill();
 
+  // Returns true if the row of 'next' has the same partition keys as 'row' of
+  // 'data_'.
+  bool isSamePartition(const char* row, SpillMergeStream& next);
+
+  // Stores the row of 'next' in 'data_' and moves 'next' to its next row.
+  char* storeSpilledRow(SpillMergeStream& next);
+
   const size_t numPartitionKeys_;
 
   // Compare flags for partition and sorting keys. Compare flags for partition
@@ -114,6 +124,9 @@ class SortWindowBuild : public WindowBuild {
 
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
+
+  // The last row added to the current partial partition.
+  char* lastPartialRow_{nullptr};
 };
 
 } // namespace facebook::velox::exec
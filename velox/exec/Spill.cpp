@@ -15,9 +15,11 @@
  */
 
 #include "velox/exec/Spill.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -76,7 +78,14 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    bool rowFormatEnabled,
+    std::shared_ptr<common::SpillRemoteTier> remoteTier,
+    folly::Executor* writeExecutor,
+    bool dictionaryEncodingEnabled,
+    bool checksumEnabled,
+    bool adaptiveCompression,
+    float compressionMaxNanosPerByte)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -87,6 +96,13 @@ SpillState::SpillState(
       writeBufferSize_(writeBufferSize),
       compressionKind_(compressionKind),
       fileCreateConfig_(fileCreateConfig),
+      rowFormatEnabled_(rowFormatEnabled),
+      remoteTier_(std::move(remoteTier)),
+      writeExecutor_(writeExecutor),
+      dictionaryEncodingEnabled_(dictionaryEncodingEnabled),
+      checksumEnabled_(checksumEnabled),
+      adaptiveCompression_(adaptiveCompression),
+      compressionMaxNanosPerByte_(compressionMaxNanosPerByte),
       pool_(pool),
       stats_(stats),
       partitionWriters_(maxPartitions_) {}
@@ -132,7 +148,14 @@ uint64_t SpillState::appendToPartition(
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        rowFormatEnabled_,
+        remoteTier_,
+        writeExecutor_,
+        dictionaryEncodingEnabled_,
+        checksumEnabled_,
+        adaptiveCompression_,
+        compressionMaxNanosPerByte_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -274,6 +297,153 @@ SpillPartition::createOrderedReader(
   return std::make_unique<TreeOfLosers<SpillMergeStream>>(std::move(streams));
 }
 
+namespace {
+// Merges the sorted 'files' into one sorted file with 'pathPrefix'.
+SpillFiles mergeSortedFiles(
+    SpillFiles files,
+    const std::string& pathPrefix,
+    const common::SpillConfig& spillConfig,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  constexpr vector_size_t kBatchRows = 1'024;
+  const auto type = files[0].type;
+  const auto numSortKeys = files[0].numSortKeys;
+  const auto sortFlags = files[0].sortFlags;
+  const auto compressionKind = files[0].compressionKind;
+  const auto rowFormat = files[0].rowFormat;
+  const auto checksum = files[0].checksum;
+
+  std::vector<std::unique_ptr<SpillMergeStream>> streams;
+  streams.reserve(files.size());
+  for (auto& fileInfo : files) {
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo, spillConfig.readBufferSize, pool, spillStats)));
+  }
+  files.clear();
+  TreeOfLosers<SpillMergeStream> merge(std::move(streams));
+
+  auto updateAndCheckSpillLimitCb = spillConfig.updateAndCheckSpillLimitCb;
+  SpillWriter writer(
+      type,
+      numSortKeys,
+      sortFlags,
+      compressionKind,
+      pathPrefix,
+      std::numeric_limits<uint64_t>::max(),
+      spillConfig.writeBufferSize,
+      spillConfig.fileCreateConfig,
+      updateAndCheckSpillLimitCb,
+      memory::spillMemoryPool(),
+      spillStats,
+      rowFormat,
+      nullptr,
+      nullptr,
+      false,
+      checksum);
+
+  RowVectorPtr output;
+  vector_size_t outputRow{0};
+  std::vector<const RowVector*> sources(kBatchRows);
+  std::vector<vector_size_t> sourceRows(kBatchRows);
+  vector_size_t numSources{0};
+  // Copies the rows in 'sources' to 'output' and writes 'output' once full
+  // or if 'last' is true.
+  auto copyRows = [&](bool last) {
+    if (output == nullptr) {
+      output = BaseVector::create<RowVector>(type, kBatchRows, pool);
+    }
+    if (numSources > 0) {
+      gatherCopy(output.get(), outputRow, numSources, sources, sourceRows);
+      outputRow += numSources;
+      numSources = 0;
+    }
+    if (outputRow == kBatchRows || (last && outputRow > 0)) {
+      output->resize(outputRow);
+      IndexRange range{0, outputRow};
+      writer.write(output, folly::Range<IndexRange*>(&range, 1));
+      output = nullptr;
+      outputRow = 0;
+    }
+  };
+  while (auto* stream = merge.next()) {
+    bool isEndOfBatch{false};
+    sources[numSources] = &stream->current();
+    sourceRows[numSources] = stream->currentIndex(&isEndOfBatch);
+    ++numSources;
+    // The rows must be copied out before 'stream' moves to its next batch.
+    if (isEndOfBatch || outputRow + numSources == kBatchRows) {
+      copyRows(false);
+    }
+    stream->pop();
+  }
+  copyRows(true);
+  return writer.finish();
+}
+} // namespace
+
+void SpillPartition::mergeFiles(
+    uint32_t fanIn,
+    const common::SpillConfig& spillConfig,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats) {
+  VELOX_CHECK_GT(fanIn, 1);
+  for (int level = 0; files_.size() > fanIn; ++level) {
+    const std::string spillDir(spillConfig.getSpillDirPathCb());
+    VELOX_CHECK(!spillDir.empty(), "Spill directory does not exist");
+    std::vector<std::shared_ptr<AsyncSource<SpillFiles>>> merges;
+    SpillFiles mergedFiles;
+    for (size_t start = 0; start < files_.size(); start += fanIn) {
+      const auto end = std::min<size_t>(start + fanIn, files_.size());
+      if (end - start == 1) {
+        mergedFiles.push_back(std::move(files_[start]));
+        continue;
+      }
+      SpillFiles group(
+          std::make_move_iterator(files_.begin() + start),
+          std::make_move_iterator(files_.begin() + end));
+      auto pathPrefix = fmt::format(
+          "{}/{}-merge-{}-{}-{}",
+          spillDir,
+          spillConfig.fileNamePrefix,
+          id_.partitionNumber(),
+          level,
+          merges.size());
+      merges.push_back(std::make_shared<AsyncSource<SpillFiles>>(
+          [group = std::move(group),
+           pathPrefix = std::move(pathPrefix),
+           &spillConfig,
+           pool,
+           spillStats]() mutable {
+            return std::make_unique<SpillFiles>(mergeSortedFiles(
+                std::move(group), pathPrefix, spillConfig, pool, spillStats));
+          }));
+      if (spillConfig.executor != nullptr && merges.size() > 1) {
+        spillConfig.executor->add(
+            [merge = merges.back()]() { merge->prepare(); });
+      }
+    }
+    files_.clear();
+
+    auto guard = folly::makeGuard([&]() {
+      for (auto& merge : merges) {
+        merge->close();
+      }
+    });
+    for (auto& merge : merges) {
+      auto files = merge->move();
+      for (auto& file : *files) {
+        mergedFiles.push_back(std::move(file));
+      }
+    }
+    files_ = std::move(mergedFiles);
+  }
+
+  size_ = 0;
+  for (const auto& file : files_) {
+    size_ += file.size;
+  }
+}
+
 uint32_t FileSpillMergeStream::id() const {
   return spillFile_->id();
 }
@@ -269,6 +269,16 @@ class SpillPartition {
     }
   }
 
+  /// Moves the files of 'other' into this, e.g. to restore several small
+  /// partitions of the same spill level together. The merged partition keeps
+  /// the id of this.
+  void merge(SpillPartition&& other) {
+    VELOX_CHECK_EQ(id_.partitionBitOffset(), other.id_.partitionBitOffset());
+    addFiles(std::move(other.files_));
+    other.files_.clear();
+    other.size_ = 0;
+  }
+
   const SpillPartitionId& id() const {
     return id_;
   }
@@ -310,6 +320,19 @@ class SpillPartition {
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* spillStats);
 
+  /// Invoked to merge the sorted files of this spill partition in groups of
+  /// up to 'fanIn' files into one sorted file per group until at most 'fanIn'
+  /// files are left. This bounds the number of streams that
+  /// createOrderedReader() merges. The groups are merged in parallel on the
+  /// executor of 'spillConfig' if it is set, and the merged files are written
+  /// to its spill directory. 'pool' is used to read the files. No-op if there
+  /// are at most 'fanIn' files.
+  void mergeFiles(
+      uint32_t fanIn,
+      const common::SpillConfig& spillConfig,
+      memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
   std::string toString() const;
 
  private:
@@ -332,7 +355,13 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'remoteTier' is set, the finished files may be moved to it.
+  /// If 'writeExecutor' is set, the file writes run on it. If
+  /// 'dictionaryEncodingEnabled' is true, the string columns with few distinct
+  /// values are written as dictionaries. If 'checksumEnabled' is true, the
+  /// files are written with checksums that are verified on read. If
+  /// 'adaptiveCompression' is true, the codec of each page is picked by its
+  /// contents within the CPU budget of 'compressionMaxNanosPerByte'.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -345,7 +374,14 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      bool rowFormatEnabled = false,
+      std::shared_ptr<common::SpillRemoteTier> remoteTier = nullptr,
+      folly::Executor* writeExecutor = nullptr,
+      bool dictionaryEncodingEnabled = false,
+      bool checksumEnabled = false,
+      bool adaptiveCompression = false,
+      float compressionMaxNanosPerByte = 0);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -440,6 +476,14 @@ class SpillState {
   const uint64_t writeBufferSize_;
   const common::CompressionKind compressionKind_;
   const std::string fileCreateConfig_;
+  // Writes fixed-width spill data in SpillRowLayout if true.
+  const bool rowFormatEnabled_;
+  const std::shared_ptr<common::SpillRemoteTier> remoteTier_;
+  folly::Executor* const writeExecutor_;
+  const bool dictionaryEncodingEnabled_;
+  const bool checksumEnabled_;
+  const bool adaptiveCompression_;
+  const float compressionMaxNanosPerByte_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
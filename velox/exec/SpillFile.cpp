@@ -15,8 +15,17 @@
  */
 
 #include "velox/exec/SpillFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <folly/container/F14Map.h>
+
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/process/Timeline.h"
+#include "velox/exec/RowContainer.h"
 
 namespace facebook::velox::exec {
 namespace {
@@ -26,8 +35,203 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// Max number of rows returned by one SpillReadFile::nextBatch() in row format.
+constexpr vector_size_t kMaxRowFormatBatchRows = 64 * 1024;
+
+bool isRowLayoutKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <TypeKind Kind>
+int32_t rowLayoutSize() {
+  return sizeof(typename KindToFlatVector<Kind>::HashRowType);
+}
+
+template <TypeKind Kind>
+void serializeRowLayoutColumn(
+    const DecodedVector& decoded,
+    const folly::Range<IndexRange*>& ranges,
+    column_index_t column,
+    int32_t offset,
+    int32_t rowSize,
+    char* out) {
+  using T = typename KindToFlatVector<Kind>::HashRowType;
+  const auto nullByte = RowContainer::nullByte(column);
+  const auto nullMask = RowContainer::nullMask(column);
+  char* row = out;
+  for (const auto& range : ranges) {
+    for (auto i = range.begin; i < range.begin + range.size; ++i) {
+      if (decoded.isNullAt(i)) {
+        row[nullByte] |= nullMask;
+      } else {
+        *reinterpret_cast<T*>(row + offset) = decoded.valueAt<T>(i);
+      }
+      row += rowSize;
+    }
+  }
+}
+
+// Wraps 'buffer' in an IOBuf that keeps 'buffer' alive.
+std::unique_ptr<folly::IOBuf> wrapBuffer(BufferPtr buffer) {
+  auto* data = buffer->asMutable<char>();
+  const auto size = buffer->size();
+  return folly::IOBuf::takeOwnership(
+      data,
+      size,
+      [](void* /*buf*/, void* userData) {
+        delete static_cast<BufferPtr*>(userData);
+      },
+      new BufferPtr(std::move(buffer)));
+}
+
+// Copies the spill file at 'localPath' to 'remotePath' in 'remoteDirectory'
+// and removes the local file.
+void moveSpillFile(
+    const std::string& localPath,
+    const std::string& remoteDirectory,
+    const std::string& remotePath,
+    const std::string& fileCreateConfig) {
+  constexpr uint64_t kCopyBufferSize = 8 << 20;
+  auto localFs = filesystems::getFileSystem(localPath, nullptr);
+  auto remoteFs = filesystems::getFileSystem(remotePath, nullptr);
+  remoteFs->mkdir(remoteDirectory);
+  auto input = localFs->openFileForRead(localPath);
+  auto output = remoteFs->openFileForWrite(
+      remotePath,
+      filesystems::FileOptions{
+          {{filesystems::FileOptions::kFileCreateConfig.toString(),
+            fileCreateConfig}},
+          nullptr,
+          std::nullopt});
+  const auto size = input->size();
+  std::string buffer;
+  for (uint64_t offset = 0; offset < size; offset += kCopyBufferSize) {
+    const auto length = std::min(kCopyBufferSize, size - offset);
+    buffer.resize(length);
+    input->pread(offset, length, buffer.data());
+    output->append(buffer);
+  }
+  output->close();
+  localFs->remove(localPath);
+}
+
+bool hasStringColumn(const RowType& type) {
+  for (const auto& child : type.children()) {
+    if (child->kind() == TypeKind::VARCHAR ||
+        child->kind() == TypeKind::VARBINARY) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Wraps the flat string columns of 'rows' with at most half as many distinct
+// values as rows in dictionaries over the column itself. Each row refers to
+// the first row with the same value, so that the serializer writes each
+// distinct value once.
+RowVectorPtr encodeStringDictionaries(
+    const RowVectorPtr& rows,
+    memory::MemoryPool* pool) {
+  const auto numRows = rows->size();
+  const vector_size_t maxDistinct = numRows / 2;
+  std::vector<VectorPtr> children = rows->children();
+  for (auto& child : children) {
+    if (child->typeKind() != TypeKind::VARCHAR &&
+        child->typeKind() != TypeKind::VARBINARY) {
+      continue;
+    }
+    const auto* flat = child->asFlatVector<StringView>();
+    if (flat == nullptr) {
+      continue;
+    }
+    auto indices = allocateIndices(numRows, pool);
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    folly::F14FastMap<StringView, vector_size_t> firstRows;
+    std::optional<vector_size_t> firstNullRow;
+    vector_size_t row = 0;
+    for (; row < numRows; ++row) {
+      if (flat->isNullAt(row)) {
+        if (!firstNullRow.has_value()) {
+          firstNullRow = row;
+        }
+        rawIndices[row] = firstNullRow.value();
+        continue;
+      }
+      rawIndices[row] =
+          firstRows.emplace(flat->valueAtFast(row), row).first->second;
+      if (firstRows.size() > maxDistinct) {
+        break;
+      }
+    }
+    if (row == numRows) {
+      child = BaseVector::wrapInDictionary(nullptr, indices, numRows, child);
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool, rows->type(), nullptr, numRows, std::move(children));
+}
 } // namespace
 
+// static
+bool SpillRowLayout::supports(const RowType& type) {
+  for (const auto& child : type.children()) {
+    if (!child->isPrimitiveType() || !isRowLayoutKind(child->kind())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+SpillRowLayout::SpillRowLayout(const RowType& type) {
+  VELOX_CHECK(supports(type), "Unsupported spill row type: {}", type);
+  int32_t offset = bits::nbytes(type.size());
+  for (const auto& child : type.children()) {
+    offsets_.push_back(offset);
+    offset += VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(rowLayoutSize, child->kind());
+  }
+  rowSize_ = std::max<int32_t>(offset, 1);
+}
+
+void SpillRowLayout::serialize(
+    const RowVector& input,
+    const folly::Range<IndexRange*>& ranges,
+    char* out) const {
+  VELOX_DCHECK_NULL(input.rawNulls());
+  vector_size_t numRows{0};
+  for (const auto& range : ranges) {
+    numRows += range.size;
+  }
+  std::memset(out, 0, static_cast<size_t>(numRows) * rowSize_);
+  DecodedVector decoded;
+  for (column_index_t i = 0; i < numColumns(); ++i) {
+    const auto& child = input.childAt(i);
+    decoded.decode(*child);
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        serializeRowLayoutColumn,
+        child->typeKind(),
+        decoded,
+        ranges,
+        i,
+        offsets_[i],
+        rowSize_,
+        out);
+  }
+}
+
 SpillInputStream::SpillInputStream(
     std::unique_ptr<ReadFile>&& file,
     uint64_t bufferSize,
@@ -172,7 +376,14 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    bool rowFormat,
+    std::shared_ptr<common::SpillRemoteTier> remoteTier,
+    folly::Executor* writeExecutor,
+    bool dictionaryEncoding,
+    bool checksum,
+    bool adaptiveCompression,
+    float compressionMaxNanosPerByte)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -183,13 +394,32 @@ SpillWriter::SpillWriter(
       fileCreateConfig_(fileCreateConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      rowLayout_(
+          rowFormat && SpillRowLayout::supports(*type)
+              ? std::make_optional<SpillRowLayout>(*type)
+              : std::nullopt),
+      dictionaryEncoding_(
+          dictionaryEncoding && !rowLayout_.has_value() &&
+          hasStringColumn(*type)),
+      checksum_(checksum),
+      adaptiveCompression_(adaptiveCompression),
+      compressionMaxNanosPerByte_(compressionMaxNanosPerByte),
+      remoteTier_(std::move(remoteTier)),
+      writeExecutor_(writeExecutor) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
 }
 
+SpillWriter::~SpillWriter() {
+  // The pending write refers to 'this' and 'currentFile_'.
+  if (pendingWrite_ != nullptr) {
+    pendingWrite_->close();
+  }
+}
+
 SpillWriteFile* SpillWriter::ensureFile() {
   if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
     closeFile();
@@ -207,6 +437,7 @@ void SpillWriter::closeFile() {
   if (currentFile_ == nullptr) {
     return;
   }
+  waitForPendingWrite();
   currentFile_->finish();
   updateSpilledFileStats(currentFile_->size());
   finishedFiles_.push_back(SpillFileInfo{
@@ -216,8 +447,44 @@ void SpillWriter::closeFile() {
       .size = currentFile_->size(),
       .numSortKeys = numSortKeys_,
       .sortFlags = sortCompareFlags_,
-      .compressionKind = compressionKind_});
+      .compressionKind = rowLayout_.has_value()
+          ? common::CompressionKind::CompressionKind_NONE
+          : compressionKind_,
+      .rowFormat = rowLayout_.has_value(),
+      .checksum = checksum_,
+      .rowChecksum = rowLayout_.has_value() ? rowChecksum_.checksum() : 0});
   currentFile_.reset();
+  rowChecksum_.reset();
+  if (remoteTier_ != nullptr) {
+    maybeMoveFile(finishedFiles_.back());
+  }
+}
+
+void SpillWriter::maybeMoveFile(SpillFileInfo& file) {
+  remoteTier_->localBytes += file.size;
+  if (remoteTier_->localBytes <= remoteTier_->localWatermarkBytes) {
+    return;
+  }
+
+  const auto localPath = file.path;
+  file.path = fmt::format(
+      "{}/{}",
+      remoteTier_->directory,
+      localPath.substr(localPath.find_last_of('/') + 1));
+  auto move = [tier = remoteTier_,
+               localPath,
+               remotePath = file.path,
+               size = file.size,
+               fileCreateConfig = fileCreateConfig_]() {
+    moveSpillFile(localPath, tier->directory, remotePath, fileCreateConfig);
+    tier->localBytes -= size;
+    ++tier->numMovedFiles;
+  };
+  if (remoteTier_->executor == nullptr) {
+    move();
+    return;
+  }
+  pendingMoves_.push_back(folly::via(remoteTier_->executor, move).semi());
 }
 
 size_t SpillWriter::numFinishedFiles() const {
@@ -225,45 +492,137 @@ size_t SpillWriter::numFinishedFiles() const {
 }
 
 uint64_t SpillWriter::flush() {
-  if (batch_ == nullptr) {
+  if (batch_ == nullptr && rowBatch_.empty() && dictionaryBatch_ == nullptr) {
     return 0;
   }
+  process::Timeline::ScopedEvent timelineEvent("spill", "write");
+
+  uint64_t flushTimeUs{0};
+  std::unique_ptr<folly::IOBuf> iobuf;
+  if (rowLayout_.has_value()) {
+    // The rows are already in their on-disk layout.
+    iobuf = rowBatch_.move();
+    if (checksum_) {
+      for (const auto& range : *iobuf) {
+        rowChecksum_.process_bytes(range.data(), range.size());
+      }
+    }
+  } else if (dictionaryBatch_ != nullptr) {
+    // Makes the serializer write the CRC32 of each page.
+    serializer::presto::PrestoOutputStreamListener listener;
+    IOBufOutputStream out(
+        *pool_,
+        checksum_ ? &listener : nullptr,
+        std::max<int64_t>(64 * 1024, dictionaryBatch_->estimateFlatSize()));
+    {
+      MicrosecondTimer timer(&flushTimeUs);
+      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+          kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+      getVectorSerde()
+          ->createBatchSerializer(pool_, &options)
+          ->serialize(encodeStringDictionaries(dictionaryBatch_, pool_), &out);
+    }
+    dictionaryBatch_.reset();
+    iobuf = out.getIOBuf();
+  } else {
+    serializer::presto::PrestoOutputStreamListener listener;
+    IOBufOutputStream out(
+        *pool_,
+        checksum_ ? &listener : nullptr,
+        std::max<int64_t>(64 * 1024, batch_->size()));
+    {
+      MicrosecondTimer timer(&flushTimeUs);
+      batch_->flush(&out);
+    }
+    batch_.reset();
+    iobuf = out.getIOBuf();
+  }
 
+  // The writes to a file are issued in order and the previous write must be
+  // done before the size check of ensureFile(). This also bounds the
+  // serialized data in flight to one buffer per writer.
+  waitForPendingWrite();
   auto* file = ensureFile();
   VELOX_CHECK_NOT_NULL(file);
 
-  IOBufOutputStream out(
-      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
-  uint64_t flushTimeUs{0};
-  {
-    MicrosecondTimer timer(&flushTimeUs);
-    batch_->flush(&out);
+  if (writeExecutor_ == nullptr) {
+    const auto writtenBytes = writeFile(file, std::move(iobuf), flushTimeUs);
+    updateAndCheckSpillLimitCb_(writtenBytes);
+    return writtenBytes;
   }
-  batch_.reset();
 
+  const auto writtenBytes = iobuf->computeChainDataLength();
+  updateAndCheckSpillLimitCb_(writtenBytes);
+  auto buffer =
+      std::make_shared<std::unique_ptr<folly::IOBuf>>(std::move(iobuf));
+  pendingWrite_ = std::make_shared<AsyncSource<uint64_t>>(
+      [this, file, buffer, flushTimeUs]() {
+        return std::make_unique<uint64_t>(
+            writeFile(file, std::move(*buffer), flushTimeUs));
+      });
+  writeExecutor_->add([write = pendingWrite_]() { write->prepare(); });
+  return writtenBytes;
+}
+
+uint64_t SpillWriter::writeFile(
+    SpillWriteFile* file,
+    std::unique_ptr<folly::IOBuf> iobuf,
+    uint64_t flushTimeUs) {
   uint64_t writeTimeUs{0};
   uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
   {
     MicrosecondTimer timer(&writeTimeUs);
     writtenBytes = file->write(std::move(iobuf));
   }
   updateWriteStats(writtenBytes, flushTimeUs, writeTimeUs);
-  updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
 }
 
+void SpillWriter::waitForPendingWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto write = std::move(pendingWrite_);
+  write->move();
+}
+
 uint64_t SpillWriter::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
   checkNotFinished();
 
   uint64_t timeUs{0};
+  if (rowLayout_.has_value()) {
+    {
+      MicrosecondTimer timer(&timeUs);
+      appendRows(rows, indices);
+    }
+    updateAppendStats(rows->size(), timeUs);
+    if (rowBatch_.chainLength() < writeBufferSize_) {
+      return 0;
+    }
+    return flush();
+  }
+
+  if (dictionaryEncoding_) {
+    {
+      MicrosecondTimer timer(&timeUs);
+      appendDictionaryRows(rows, indices);
+    }
+    updateAppendStats(rows->size(), timeUs);
+    if (dictionaryBatch_->estimateFlatSize() < writeBufferSize_) {
+      return 0;
+    }
+    return flush();
+  }
+
   {
     MicrosecondTimer timer(&timeUs);
     if (batch_ == nullptr) {
       serializer::presto::PrestoVectorSerde::PrestoOptions options = {
           kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+      options.adaptiveCompression = adaptiveCompression_;
+      options.maxCompressionNanosPerByte = compressionMaxNanosPerByte_;
       batch_ = std::make_unique<VectorStreamGroup>(pool_);
       batch_->createStreamTree(
           std::static_pointer_cast<const RowType>(rows->type()),
@@ -279,6 +638,39 @@ uint64_t SpillWriter::write(
   return flush();
 }
 
+void SpillWriter::appendDictionaryRows(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  if (dictionaryBatch_ == nullptr) {
+    dictionaryBatch_ = BaseVector::create<RowVector>(type_, 0, pool_);
+  }
+  vector_size_t offset = dictionaryBatch_->size();
+  std::vector<BaseVector::CopyRange> ranges;
+  ranges.reserve(indices.size());
+  for (const auto& range : indices) {
+    ranges.push_back({range.begin, offset, range.size});
+    offset += range.size;
+  }
+  dictionaryBatch_->resize(offset);
+  dictionaryBatch_->copyRanges(rows.get(), ranges);
+}
+
+void SpillWriter::appendRows(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  vector_size_t numRows{0};
+  for (const auto& range : indices) {
+    numRows += range.size;
+  }
+  if (numRows == 0) {
+    return;
+  }
+  auto buffer = AlignedBuffer::allocate<char>(
+      static_cast<size_t>(numRows) * rowLayout_->rowSize(), pool_);
+  rowLayout_->serialize(*rows, indices, buffer->asMutable<char>());
+  rowBatch_.append(wrapBuffer(std::move(buffer)));
+}
+
 void SpillWriter::updateAppendStats(
     uint64_t numRows,
     uint64_t serializationTimeUs) {
@@ -320,6 +712,10 @@ SpillFiles SpillWriter::finish() {
   auto finishGuard = folly::makeGuard([this]() { finished_ = true; });
 
   finishFile();
+  for (auto& move : pendingMoves_) {
+    std::move(move).get();
+  }
+  pendingMoves_.clear();
   return std::move(finishedFiles_);
 }
 
@@ -363,6 +759,9 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.numSortKeys,
       fileInfo.sortFlags,
       fileInfo.compressionKind,
+      fileInfo.rowFormat,
+      fileInfo.checksum,
+      fileInfo.rowChecksum,
       pool,
       stats));
 }
@@ -376,6 +775,9 @@ SpillReadFile::SpillReadFile(
     uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
+    bool rowFormat,
+    bool checksum,
+    uint32_t rowChecksum,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats)
     : id_(id),
@@ -385,19 +787,144 @@ SpillReadFile::SpillReadFile(
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
+      checksum_(checksum),
+      expectedRowChecksum_(rowChecksum),
       readOptions_{
           kDefaultUseLosslessTimestamp,
           compressionKind_,
           /*nullsFirst=*/true},
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      rowLayout_(
+          rowFormat ? std::make_optional<SpillRowLayout>(*type_)
+                    : std::nullopt),
+      maxBatchRows_(
+          rowFormat ? std::clamp<uint64_t>(
+                          bufferSize / rowLayout_->rowSize(),
+                          1,
+                          kMaxRowFormatBatchRows)
+                    : 0) {
+  if (rowLayout_.has_value()) {
+    openRows();
+    return;
+  }
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
+  checkFileSize(*file);
   input_ = std::make_unique<SpillInputStream>(
       std::move(file), bufferSize, pool_, stats_);
 }
 
+SpillReadFile::~SpillReadFile() {
+  if (mappedRows_ != nullptr) {
+    ::munmap(mappedRows_, size_);
+  }
+}
+
+void SpillReadFile::checkFileSize(const ReadFile& file) const {
+  if (checksum_ && file.size() != size_) {
+    VELOX_FAIL(
+        "Spill file {} has {} bytes instead of {}", path_, file.size(), size_);
+  }
+}
+
+void SpillReadFile::openRows() {
+  VELOX_CHECK_EQ(
+      size_ % rowLayout_->rowSize(),
+      0,
+      "Spill file {} does not hold whole rows",
+      path_);
+  auto fs = filesystems::getFileSystem(path_, nullptr);
+  rowFile_ = fs->openFileForRead(path_);
+  checkFileSize(*rowFile_);
+  if (size_ > 0 && dynamic_cast<LocalReadFile*>(rowFile_.get()) != nullptr) {
+    const std::string localPath(fs->extractPath(path_));
+    const auto fd = ::open(localPath.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      auto* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+      if (data != MAP_FAILED) {
+        ::madvise(data, size_, MADV_SEQUENTIAL);
+        mappedRows_ = static_cast<char*>(data);
+        rowFile_.reset();
+        return;
+      }
+    }
+  }
+  // Not a local file or the mapping failed. Read the rows into a buffer.
+  rowBuffer_ = AlignedBuffer::allocate<char>(
+      static_cast<size_t>(maxBatchRows_) * rowLayout_->rowSize(), pool_);
+}
+
+const char* SpillReadFile::nextRows(vector_size_t& numRows) {
+  const auto rowSize = rowLayout_->rowSize();
+  numRows = std::min<uint64_t>(maxBatchRows_, (size_ - rowOffset_) / rowSize);
+  const uint64_t numBytes = static_cast<uint64_t>(numRows) * rowSize;
+  const char* rows;
+  uint64_t readTimeUs{0};
+  if (mappedRows_ != nullptr) {
+    rows = mappedRows_ + rowOffset_;
+  } else {
+    MicrosecondTimer timer{&readTimeUs};
+    rowFile_->pread(rowOffset_, numBytes, rowBuffer_->asMutable<char>());
+    rows = rowBuffer_->as<char>();
+  }
+  rowOffset_ += numBytes;
+  if (checksum_) {
+    rowChecksum_.process_bytes(rows, numBytes);
+    if (rowOffset_ == size_ &&
+        rowChecksum_.checksum() != expectedRowChecksum_) {
+      VELOX_FAIL("Spill file {} has a wrong checksum", path_);
+    }
+  }
+
+  auto lockedStats = stats_->wlock();
+  lockedStats->spillReadBytes += numBytes;
+  lockedStats->spillReadTimeUs += readTimeUs;
+  ++(lockedStats->spillReads);
+  common::updateGlobalSpillReadStats(numBytes, readTimeUs);
+  return rows;
+}
+
+void SpillReadFile::readRows(RowVectorPtr& rowVector) {
+  vector_size_t numRows;
+  const auto* rows = nextRows(numRows);
+
+  uint64_t timeUs{0};
+  {
+    MicrosecondTimer timer{&timeUs};
+    const auto rowSize = rowLayout_->rowSize();
+    rows_.resize(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      rows_[i] = rows + static_cast<uint64_t>(i) * rowSize;
+    }
+    VectorPtr result = std::move(rowVector);
+    if (result == nullptr) {
+      result = BaseVector::create(type_, numRows, pool_);
+    } else {
+      BaseVector::prepareForReuse(result, numRows);
+    }
+    rowVector = std::static_pointer_cast<RowVector>(result);
+    for (column_index_t i = 0; i < rowLayout_->numColumns(); ++i) {
+      RowContainer::extractColumn(
+          rows_.data(),
+          numRows,
+          RowColumn(rowLayout_->offset(i), i),
+          rowVector->childAt(i));
+    }
+  }
+  stats_->wlock()->spillDeserializationTimeUs += timeUs;
+  common::updateGlobalSpillDeserializationTimeUs(timeUs);
+}
+
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
+  if (rowLayout_.has_value()) {
+    if (rowOffset_ >= size_) {
+      return false;
+    }
+    readRows(rowVector);
+    return true;
+  }
   if (input_->atEnd()) {
     return false;
   }
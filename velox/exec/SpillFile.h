@@ -17,7 +17,11 @@
 #pragma once
 
 #include <folly/container/F14Set.h>
+#include <folly/futures/Future.h>
+#include <folly/io/IOBufQueue.h>
 
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Crc.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -79,6 +83,46 @@ class SpillWriteFile {
   uint64_t size_{0};
 };
 
+/// Row-major layout of spill files of fixed-width columns. Each row starts
+/// with one null bit per column followed by the column values at fixed
+/// offsets, the same way RowContainer lays out fixed-width keys. The rows of
+/// a file are stored back to back without any framing or compression, so the
+/// reader maps the file into memory and extracts the columns with
+/// RowContainer::extractColumn() instead of deserializing a PrestoPage.
+class SpillRowLayout {
+ public:
+  /// Returns true if all columns of 'type' are fixed-width primitive types.
+  static bool supports(const RowType& type);
+
+  explicit SpillRowLayout(const RowType& type);
+
+  /// The byte size of one row.
+  int32_t rowSize() const {
+    return rowSize_;
+  }
+
+  /// The byte offset of the value of 'column' in a row. The null bit of
+  /// 'column' is bit 'column' of the row.
+  int32_t offset(column_index_t column) const {
+    return offsets_[column];
+  }
+
+  size_t numColumns() const {
+    return offsets_.size();
+  }
+
+  /// Writes the rows of 'input' in 'ranges' to 'out', which must have space
+  /// for all of them.
+  void serialize(
+      const RowVector& input,
+      const folly::Range<IndexRange*>& ranges,
+      char* out) const;
+
+ private:
+  std::vector<int32_t> offsets_;
+  int32_t rowSize_;
+};
+
 /// Records info of a finished spill file which is used for read.
 struct SpillFileInfo {
   uint32_t id;
@@ -89,6 +133,14 @@ struct SpillFileInfo {
   uint32_t numSortKeys;
   std::vector<CompareFlags> sortFlags;
   common::CompressionKind compressionKind;
+  /// True if the file is written in SpillRowLayout instead of PrestoPage
+  /// format.
+  bool rowFormat{false};
+  /// True if the file is written with checksums. Each PrestoPage of the file
+  /// carries the CRC32 of its data. A file in row format has its CRC32 in
+  /// 'rowChecksum'.
+  bool checksum{false};
+  uint32_t rowChecksum{0};
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
@@ -105,7 +157,18 @@ class SpillWriter {
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'rowFormat' is true and all columns of 'type'
+  /// have a fixed width, the files are written uncompressed in SpillRowLayout.
+  /// If 'remoteTier' is set, the finished files are moved to it while the
+  /// local spill files take more than its watermark. If 'writeExecutor' is
+  /// set, each buffer is written to the file on it while the caller
+  /// serializes the next one. There is at most one write in flight. If
+  /// 'dictionaryEncoding' is true and the files are not in row format, the
+  /// string columns of a write buffer with few distinct values are written as
+  /// dictionaries. If 'checksum' is true, the files are written with
+  /// checksums that SpillReadFile verifies. If 'adaptiveCompression' is true,
+  /// the codec of each page is picked by its contents as with
+  /// PrestoVectorSerde::PrestoOptions::adaptiveCompression.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -120,7 +183,16 @@ class SpillWriter {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      bool rowFormat = false,
+      std::shared_ptr<common::SpillRemoteTier> remoteTier = nullptr,
+      folly::Executor* writeExecutor = nullptr,
+      bool dictionaryEncoding = false,
+      bool checksum = false,
+      bool adaptiveCompression = false,
+      float compressionMaxNanosPerByte = 0);
+
+  ~SpillWriter();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -139,6 +211,7 @@ class SpillWriter {
   size_t numFinishedFiles() const;
 
   /// Finishes this file writer and returns the written spill files info.
+  /// Waits for the moves of the files to the remote tier if any.
   ///
   /// NOTE: we don't allow write to a spill writer after t
   SpillFiles finish();
@@ -161,10 +234,35 @@ class SpillWriter {
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
-  // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // Moves the finished 'file' to 'remoteTier_' if the local spill files take
+  // more than its watermark. Updates the path of 'file' to the remote one.
+  void maybeMoveFile(SpillFileInfo& file);
+
+  // Writes data from 'batch_' or 'rowBatch_' to the current output file.
+  // Returns the actual written size. If 'writeExecutor_' is set, the write
+  // runs on it after the previous one has finished.
   uint64_t flush();
 
+  // Writes 'iobuf' to 'file' and updates the write stats. 'flushTimeUs' is
+  // the time spent serializing 'iobuf'. Returns the written size.
+  uint64_t writeFile(
+      SpillWriteFile* file,
+      std::unique_ptr<folly::IOBuf> iobuf,
+      uint64_t flushTimeUs);
+
+  // Waits for 'pendingWrite_' if any. Throws if the write failed.
+  void waitForPendingWrite();
+
+  // Appends the rows of 'rows' in 'indices' to 'rowBatch_' in 'rowLayout_'.
+  void appendRows(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
+  // Copies the rows of 'rows' in 'indices' to the end of 'dictionaryBatch_'.
+  void appendDictionaryRows(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -195,8 +293,28 @@ class SpillWriter {
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+  // Set if the files are written in row format.
+  const std::optional<SpillRowLayout> rowLayout_;
+  // Rows buffered for write in row format.
+  folly::IOBufQueue rowBatch_{folly::IOBufQueue::cacheChainLength()};
+  // True if the string columns are dictionary encoded on write. The rows are
+  // then buffered in 'dictionaryBatch_' instead of 'batch_'.
+  const bool dictionaryEncoding_;
+  RowVectorPtr dictionaryBatch_;
+  const bool checksum_;
+  // CRC32 of the data written to 'currentFile_' in row format.
+  bits::Crc32 rowChecksum_;
+  const bool adaptiveCompression_;
+  const float compressionMaxNanosPerByte_;
   std::unique_ptr<SpillWriteFile> currentFile_;
   SpillFiles finishedFiles_;
+  const std::shared_ptr<common::SpillRemoteTier> remoteTier_;
+  // Moves of 'finishedFiles_' to 'remoteTier_' that are running on its
+  // executor.
+  std::vector<folly::SemiFuture<folly::Unit>> pendingMoves_;
+  folly::Executor* const writeExecutor_;
+  // The write to 'currentFile_' that is running on 'writeExecutor_'.
+  std::shared_ptr<AsyncSource<uint64_t>> pendingWrite_;
 };
 
 /// Input stream backed by spill file.
@@ -286,6 +404,8 @@ class SpillReadFile {
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats);
 
+  ~SpillReadFile();
+
   uint32_t id() const {
     return id_;
   }
@@ -300,6 +420,11 @@ class SpillReadFile {
 
   bool nextBatch(RowVectorPtr& rowVector);
 
+  /// True if the file is read from memory mapped rows in SpillRowLayout.
+  bool isMapped() const {
+    return mappedRows_ != nullptr;
+  }
+
   /// Returns the file size in bytes.
   uint64_t size() const {
     return size_;
@@ -319,9 +444,26 @@ class SpillReadFile {
       uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
+      bool rowFormat,
+      bool checksum,
+      uint32_t rowChecksum,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats);
 
+  // Throws if 'file' is not 'size_' bytes long.
+  void checkFileSize(const ReadFile& file) const;
+
+  // Maps the file into memory if it is on the local file system. Otherwise
+  // opens 'rowFile_' for reading rows into 'rowBuffer_'.
+  void openRows();
+
+  // Returns the next batch of rows in row format. Sets 'numRows' to the
+  // number of rows in the batch.
+  const char* nextRows(vector_size_t& numRows);
+
+  // Extracts the next batch of rows in row format into 'rowVector'.
+  void readRows(RowVectorPtr& rowVector);
+
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
   const uint32_t id_;
@@ -333,10 +475,29 @@ class SpillReadFile {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
+  // True if the file has checksums. See SpillFileInfo::checksum.
+  const bool checksum_;
+  const uint32_t expectedRowChecksum_;
+  // CRC32 of the rows read so far in row format.
+  bits::Crc32 rowChecksum_;
   const serializer::presto::PrestoVectorSerde::PrestoOptions readOptions_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
   std::unique_ptr<SpillInputStream> input_;
+
+  // Set if the file is in row format.
+  const std::optional<SpillRowLayout> rowLayout_;
+  // Max number of rows returned by one nextBatch() in row format.
+  const vector_size_t maxBatchRows_;
+  // The file mapped into memory in row format.
+  char* mappedRows_{nullptr};
+  // The file and the read buffer in row format if the file is not mapped.
+  std::unique_ptr<ReadFile> rowFile_;
+  BufferPtr rowBuffer_;
+  // Offset of the first unread row in row format.
+  uint64_t rowOffset_{0};
+  // Pointers to the rows of the current batch in row format.
+  std::vector<const char*> rows_;
 };
 } // namespace facebook::velox::exec
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SpillHistory.h"
+
+namespace facebook::velox::exec {
+
+// static
+SpillHistory& SpillHistory::instance() {
+  static SpillHistory history;
+  return history;
+}
+
+// static
+uint64_t SpillHistory::fingerprint(const core::PlanNode& planNode) {
+  return folly::hasher<std::string>()(
+      planNode.toString(/*detailed=*/true, /*recursive=*/true));
+}
+
+void SpillHistory::recordPartitionBits(
+    uint64_t fingerprint,
+    uint8_t numPartitionBits) {
+  auto locked = partitionBits_.wlock();
+  auto it = locked->find(fingerprint);
+  if (it != locked->end()) {
+    it->second = std::max(it->second, numPartitionBits);
+    return;
+  }
+  if (locked->size() >= kMaxEntries) {
+    locked->erase(locked->begin());
+  }
+  locked->emplace(fingerprint, numPartitionBits);
+}
+
+std::optional<uint8_t> SpillHistory::partitionBits(uint64_t fingerprint) const {
+  auto locked = partitionBits_.rlock();
+  auto it = locked->find(fingerprint);
+  if (it == locked->end()) {
+    return std::nullopt;
+  }
+  return std::min(it->second, kMaxPartitionBits);
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Remembers how many spill partition bits the hash joins run by this process
+/// needed, keyed by a fingerprint of the plan of the join. A join that spills
+/// recursively finds out how many partitions its build side needs one level
+/// at a time, rereading and rewriting its spilled data at each level. A
+/// repeated run of the same plan, e.g. a daily ETL job, starts with the
+/// partition bits of the earlier runs instead. Used by HashBuild and
+/// HashProbe with QueryConfig::kSpillHistoryEnabled set.
+class SpillHistory {
+ public:
+  /// The max number of partition bits a join starts with from the history.
+  static constexpr uint8_t kMaxPartitionBits = 6;
+
+  static SpillHistory& instance();
+
+  /// Returns the key of 'planNode' in the history. Plans that print the same
+  /// with their sources have the same key.
+  static uint64_t fingerprint(const core::PlanNode& planNode);
+
+  /// Records that the plan with 'fingerprint' used 'numPartitionBits' spill
+  /// partition bits over all its spill levels. Keeps the max of the recorded
+  /// values.
+  void recordPartitionBits(uint64_t fingerprint, uint8_t numPartitionBits);
+
+  /// Returns the number of partition bits recorded for 'fingerprint', capped
+  /// at kMaxPartitionBits, or std::nullopt if there is none.
+  std::optional<uint8_t> partitionBits(uint64_t fingerprint) const;
+
+  size_t size() const {
+    return partitionBits_.rlock()->size();
+  }
+
+  void clear() {
+    partitionBits_.wlock()->clear();
+  }
+
+ private:
+  // The max number of plans in the history. An arbitrary plan is dropped to
+  // make room for a new one.
+  static constexpr size_t kMaxEntries = 10'000;
+
+  folly::Synchronized<folly::F14FastMap<uint64_t, uint8_t>> partitionBits_;
+};
+} // namespace facebook::velox::exec
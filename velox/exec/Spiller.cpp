@@ -40,7 +40,8 @@ Spiller::Spiller(
     int32_t numSortingKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     const common::SpillConfig* spillConfig,
-    folly::Synchronized<common::SpillStats>* spillStats)
+    folly::Synchronized<common::SpillStats>* spillStats,
+    const std::optional<PrefixSortConfig>& prefixSortConfig)
     : Spiller(
           type,
           container,
@@ -55,10 +56,18 @@ Spiller::Spiller(
           std::numeric_limits<uint64_t>::max(),
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          spillConfig->rowFormatEnabled,
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
-          spillStats) {
+          spillConfig->remoteTier,
+          spillConfig->asyncWriteEnabled ? spillConfig->executor : nullptr,
+          spillConfig->dictionaryEncodingEnabled,
+          spillConfig->checksumEnabled,
+          spillConfig->adaptiveCompression,
+          spillConfig->compressionMaxNanosPerByte,
+          spillStats,
+          prefixSortConfig) {
   VELOX_CHECK_EQ(
       type_,
       Type::kOrderByInput,
@@ -90,9 +99,16 @@ Spiller::Spiller(
           std::numeric_limits<uint64_t>::max(),
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          spillConfig->rowFormatEnabled,
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->remoteTier,
+          spillConfig->asyncWriteEnabled ? spillConfig->executor : nullptr,
+          spillConfig->dictionaryEncodingEnabled,
+          spillConfig->checksumEnabled,
+          spillConfig->adaptiveCompression,
+          spillConfig->compressionMaxNanosPerByte,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
@@ -121,9 +137,16 @@ Spiller::Spiller(
           std::numeric_limits<uint64_t>::max(),
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          spillConfig->rowFormatEnabled,
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->remoteTier,
+          spillConfig->asyncWriteEnabled ? spillConfig->executor : nullptr,
+          spillConfig->dictionaryEncodingEnabled,
+          spillConfig->checksumEnabled,
+          spillConfig->adaptiveCompression,
+          spillConfig->compressionMaxNanosPerByte,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kAggregateOutput || type_ == Type::kOrderByOutput,
@@ -153,9 +176,16 @@ Spiller::Spiller(
           spillConfig->maxFileSize,
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          false,
           spillConfig->executor,
           0,
           spillConfig->fileCreateConfig,
+          spillConfig->remoteTier,
+          spillConfig->asyncWriteEnabled ? spillConfig->executor : nullptr,
+          spillConfig->dictionaryEncodingEnabled,
+          spillConfig->checksumEnabled,
+          spillConfig->adaptiveCompression,
+          spillConfig->compressionMaxNanosPerByte,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -186,9 +216,16 @@ Spiller::Spiller(
           spillConfig->maxFileSize,
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          false,
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->remoteTier,
+          spillConfig->asyncWriteEnabled ? spillConfig->executor : nullptr,
+          spillConfig->dictionaryEncodingEnabled,
+          spillConfig->checksumEnabled,
+          spillConfig->adaptiveCompression,
+          spillConfig->compressionMaxNanosPerByte,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
   VELOX_CHECK(isHashJoinTableSpillType(rowType_, joinType));
@@ -215,9 +252,16 @@ Spiller::Spiller(
           spillConfig->maxFileSize,
           spillConfig->writeBufferSize,
           spillConfig->compressionKind,
+          false,
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->remoteTier,
+          spillConfig->asyncWriteEnabled ? spillConfig->executor : nullptr,
+          spillConfig->dictionaryEncodingEnabled,
+          spillConfig->checksumEnabled,
+          spillConfig->adaptiveCompression,
+          spillConfig->compressionMaxNanosPerByte,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kRowNumber);
 }
@@ -236,10 +280,18 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
+    bool rowFormatEnabled,
     folly::Executor* executor,
     uint64_t maxSpillRunRows,
     const std::string& fileCreateConfig,
-    folly::Synchronized<common::SpillStats>* spillStats)
+    const std::shared_ptr<common::SpillRemoteTier>& remoteTier,
+    folly::Executor* writeExecutor,
+    bool dictionaryEncodingEnabled,
+    bool checksumEnabled,
+    bool adaptiveCompression,
+    float compressionMaxNanosPerByte,
+    folly::Synchronized<common::SpillStats>* spillStats,
+    const std::optional<PrefixSortConfig>& prefixSortConfig)
     : type_(type),
       container_(container),
       executor_(executor),
@@ -247,6 +299,7 @@ Spiller::Spiller(
       rowType_(std::move(rowType)),
       spillProbedFlag_(recordProbedFlag),
       maxSpillRunRows_(maxSpillRunRows),
+      prefixSortConfig_(prefixSortConfig),
       spillStats_(spillStats),
       state_(
           getSpillDirPathCb,
@@ -260,10 +313,18 @@ Spiller::Spiller(
           compressionKind,
           memory::spillMemoryPool(),
           spillStats,
-          fileCreateConfig) {
+          fileCreateConfig,
+          rowFormatEnabled,
+          remoteTier,
+          writeExecutor,
+          dictionaryEncodingEnabled,
+          checksumEnabled,
+          adaptiveCompression,
+          compressionMaxNanosPerByte) {
   TestValue::adjust("facebook::velox::exec::Spiller", this);
 
   VELOX_CHECK(!spillProbedFlag_ || type_ == Type::kHashJoinBuild);
+  VELOX_CHECK(!prefixSortConfig_.has_value() || type_ == Type::kOrderByInput);
   VELOX_CHECK_EQ(container_ == nullptr, type_ == Type::kHashJoinProbe);
   spillRuns_.reserve(state_.maxPartitions());
   for (int i = 0; i < state_.maxPartitions(); ++i) {
@@ -416,13 +477,21 @@ void Spiller::ensureSorted(SpillRun& run) {
   uint64_t sortTimeUs{0};
   {
     MicrosecondTimer timer(&sortTimeUs);
-    gfx::timsort(
-        run.rows.begin(),
-        run.rows.end(),
-        [&](const char* left, const char* right) {
-          return container_->compareRows(
-                     left, right, state_.sortCompareFlags()) < 0;
-        });
+    if (prefixSortConfig_.has_value()) {
+      PrefixSort::sort(
+          folly::Range<char**>(run.rows.data(), run.rows.size()),
+          memory::spillMemoryPool(),
+          container_,
+          state_.sortCompareFlags(),
+          prefixSortConfig_.value());
+    } else {
+      SortKeyComparator comparator(container_, state_.sortCompareFlags());
+      comparator.sort(
+          folly::Range<char**>(run.rows.data(), run.rows.size()),
+          [](auto begin, auto end, const auto& less) {
+            gfx::timsort(begin, end, less);
+          });
+    }
     run.sorted = true;
   }
 
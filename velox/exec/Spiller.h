@@ -18,6 +18,7 @@
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/exec/HashBitRange.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/RowContainer.h"
 
 namespace facebook::velox::exec {
@@ -63,7 +64,8 @@ class Spiller {
       const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
-  /// type == Type::kOrderByInput
+  /// type == Type::kOrderByInput. If 'prefixSortConfig' is set, the spill
+  /// runs are sorted with PrefixSort.
   Spiller(
       Type type,
       RowContainer* container,
@@ -71,7 +73,8 @@ class Spiller {
       int32_t numSortingKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       const common::SpillConfig* spillConfig,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      const std::optional<PrefixSortConfig>& prefixSortConfig = std::nullopt);
 
   /// type == Type::kAggregateOutput || type == Type::kOrderByOutput
   Spiller(
@@ -215,10 +218,18 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
+      bool rowFormatEnabled,
       folly::Executor* executor,
       uint64_t maxSpillRunRows,
       const std::string& fileCreateConfig,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      const std::shared_ptr<common::SpillRemoteTier>& remoteTier,
+      folly::Executor* writeExecutor,
+      bool dictionaryEncodingEnabled,
+      bool checksumEnabled,
+      bool adaptiveCompression,
+      float compressionMaxNanosPerByte,
+      folly::Synchronized<common::SpillStats>* spillStats,
+      const std::optional<PrefixSortConfig>& prefixSortConfig = std::nullopt);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
   // from row container starting at the offset pointed by 'startRowIter'.
@@ -329,6 +340,9 @@ class Spiller {
   const RowTypePtr rowType_;
   const bool spillProbedFlag_;
   const uint64_t maxSpillRunRows_;
+  // If set, sorts the spill runs with PrefixSort. Only used by
+  // 'kOrderByInput' spiller type.
+  const std::optional<PrefixSortConfig> prefixSortConfig_;
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
@@ -21,7 +21,9 @@ namespace facebook::velox::exec {
 
 struct Split {
   std::shared_ptr<velox::connector::ConnectorSplit> connectorSplit;
-  int32_t groupId{-1}; // Bucketed group id (-1 means 'none').
+  // Bucketed group id (-1 means 'none'). If 'none' in grouped execution, the
+  // Task derives the group from connectorSplit->bucketNumber() if set.
+  int32_t groupId{-1};
 
   Split() = default;
 
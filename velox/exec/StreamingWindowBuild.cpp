@@ -22,16 +22,33 @@ StreamingWindowBuild::StreamingWindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
-    tsan_atomic<bool>* nonReclaimableSection)
-    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection) {}
+    tsan_atomic<bool>* nonReclaimableSection,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection),
+      pool_(pool),
+      spillStats_(spillStats) {
+  VELOX_CHECK(spillConfig_ == nullptr || spillStats_ != nullptr);
+}
 
 void StreamingWindowBuild::buildNextPartition() {
+  if (!spilledRuns_.empty()) {
+    // The spilled rows are restored by nextPartition() once the rows of the
+    // previous partitions have been erased.
+    spilledPartitions_.emplace(
+        partitionStartRows_.size(), std::move(spilledRuns_));
+    spilledRuns_.clear();
+  }
   partitionStartRows_.push_back(sortedRows_.size());
   sortedRows_.insert(sortedRows_.end(), inputRows_.begin(), inputRows_.end());
   inputRows_.clear();
 }
 
 void StreamingWindowBuild::addInput(RowVectorPtr input) {
+  // Test-only spill path.
+  if (spillConfig_ != nullptr && testingTriggerSpill(pool_->name())) {
+    spill();
+  }
+
   for (auto i = 0; i < inputChannels_.size(); ++i) {
     decodedInputVectors_[i].decode(*input->childAt(inputChannels_[i]));
   }
@@ -43,24 +60,166 @@ void StreamingWindowBuild::addInput(RowVectorPtr input) {
       data_->store(decodedInputVectors_[col], row, newRow, col);
     }
 
-    if (previousRow_ != nullptr &&
-        compareRowsWithKeys(previousRow_, newRow, partitionKeyInfo_)) {
-      buildNextPartition();
+    const bool newPartition = previousRow_ == nullptr ||
+        compareRowsWithKeys(previousRow_, newRow, partitionKeyInfo_);
+    previousRow_ = newRow;
+
+    if (partialPartitionsEnabled_) {
+      if (newPartition) {
+        pendingPartitions_.emplace_back();
+      }
+      pendingPartitions_.back().push_back(newRow);
+      continue;
     }
 
+    if (newPartition && !inputRows_.empty()) {
+      buildNextPartition();
+    }
     inputRows_.push_back(newRow);
-    previousRow_ = newRow;
   }
 }
 
+void StreamingWindowBuild::spill() {
+  VELOX_CHECK_NOT_NULL(spillConfig_);
+
+  // Partial partitions hold only the rows in the frames being computed.
+  if (partialPartitionsEnabled_) {
+    return;
+  }
+
+  // Keep the last received row in memory as it is used to detect the start of
+  // the next partition. The rows of the completed partitions are either being
+  // output or about to be output by the Window operator, so they can't be
+  // spilled.
+  if (inputRows_.size() <= 1) {
+    return;
+  }
+  std::vector<char*> spillRows(inputRows_.begin(), inputRows_.end() - 1);
+
+  // The rows are already sorted. kOrderByOutput writes the given rows as a
+  // single run in the given order without sorting them, which is what a
+  // sorted input needs.
+  Spiller spiller(
+      Spiller::Type::kOrderByOutput,
+      data_.get(),
+      inputType_,
+      spillConfig_,
+      spillStats_);
+  spiller.spill(spillRows);
+  SpillPartitionSet spillPartitionSet;
+  spiller.finishSpill(spillPartitionSet);
+  VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+  spilledRuns_.push_back(std::move(spillPartitionSet.begin()->second));
+  spilled_ = true;
+
+  data_->eraseRows(folly::Range<char**>(spillRows.data(), spillRows.size()));
+  inputRows_.erase(inputRows_.begin(), inputRows_.end() - 1);
+  pool_->release();
+}
+
+void StreamingWindowBuild::restoreSpilledRows(vector_size_t partition) {
+  auto it = spilledPartitions_.find(partition);
+  if (it == spilledPartitions_.end()) {
+    return;
+  }
+  auto spilledRuns = std::move(it->second);
+  spilledPartitions_.erase(it);
+
+  // The spilled rows precede the in-memory rows of the partition.
+  std::vector<char*> restoredRows;
+  std::vector<DecodedVector> decodedVectors(inputChannels_.size());
+  for (auto& spilledRun : spilledRuns) {
+    auto reader = spilledRun->createUnorderedReader(
+        spillConfig_->readBufferSize, pool_, spillStats_);
+    RowVectorPtr batch;
+    while (reader->nextBatch(batch)) {
+      ensureRestoreFits(batch->size());
+      for (auto col = 0; col < batch->childrenSize(); ++col) {
+        decodedVectors[col].decode(*batch->childAt(col));
+      }
+      for (auto row = 0; row < batch->size(); ++row) {
+        char* newRow = data_->newRow();
+        for (auto col = 0; col < batch->childrenSize(); ++col) {
+          data_->store(decodedVectors[col], row, newRow, col);
+        }
+        restoredRows.push_back(newRow);
+      }
+    }
+    // Releases the read buffer and the files of the run.
+    spilledRun.reset();
+  }
+
+  sortedRows_.insert(
+      sortedRows_.begin() + partitionStartRows_[partition],
+      restoredRows.begin(),
+      restoredRows.end());
+  for (auto i = partition + 1; i < partitionStartRows_.size(); ++i) {
+    partitionStartRows_[i] += restoredRows.size();
+  }
+}
+
+void StreamingWindowBuild::ensureRestoreFits(vector_size_t numRows) {
+  // Reserves memory for a batch of restored rows at a time, so that the
+  // arbitrator can reclaim memory, e.g. by spilling the partition being
+  // accumulated, while the partition is restored.
+  const auto rowSize = data_->estimateRowSize();
+  if (!rowSize.has_value()) {
+    return;
+  }
+  memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
+  data_->pool()->maybeReserve(rowSize.value() * numRows);
+}
+
 void StreamingWindowBuild::noMoreInput() {
+  noMoreInput_ = true;
+  if (partialPartitionsEnabled_) {
+    return;
+  }
+
   buildNextPartition();
 
   // Help for last partition related calculations.
   partitionStartRows_.push_back(sortedRows_.size());
 }
 
+void StreamingWindowBuild::loadPartialPartition(
+    WindowPartition& partition,
+    vector_size_t numRows) {
+  VELOX_CHECK(partition.partial());
+  VELOX_CHECK(partitionStarted_);
+
+  auto& rows = pendingPartitions_.front();
+  const auto numNewRows = std::min<int64_t>(
+      std::max<int64_t>(numRows - partition.numRows(), 0), rows.size());
+  if (numNewRows == rows.size()) {
+    partition.addRows(rows);
+    rows.clear();
+  } else if (numNewRows > 0) {
+    partition.addRows(
+        std::vector<char*>(rows.begin(), rows.begin() + numNewRows));
+    rows.erase(rows.begin(), rows.begin() + numNewRows);
+  }
+
+  // The partition has all its rows once a row of the next partition or the
+  // end of input is received.
+  if (rows.empty() && (pendingPartitions_.size() > 1 || noMoreInput_)) {
+    partition.setComplete();
+  }
+}
+
 std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
+  if (partialPartitionsEnabled_) {
+    VELOX_CHECK(hasNextPartition(), "No window partitions available");
+    if (partitionStarted_) {
+      // The rows of the previous partition have all been added to it.
+      VELOX_CHECK(pendingPartitions_.front().empty());
+      pendingPartitions_.pop_front();
+    }
+    partitionStarted_ = true;
+    return std::make_unique<WindowPartition>(
+        data_.get(), inversedInputChannels_, sortKeyInfo_);
+  }
+
   VELOX_CHECK_GT(
       partitionStartRows_.size(), 0, "No window partitions available")
 
@@ -83,6 +242,8 @@ std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
     }
   }
 
+  restoreSpilledRows(currentPartition_);
+
   auto partitionSize = partitionStartRows_[currentPartition_ + 1] -
       partitionStartRows_[currentPartition_];
   auto partition = folly::Range(
@@ -94,6 +255,9 @@ std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
 }
 
 bool StreamingWindowBuild::hasNextPartition() {
+  if (partialPartitionsEnabled_) {
+    return pendingPartitions_.size() > (partitionStarted_ ? 1 : 0);
+  }
   return partitionStartRows_.size() > 0 &&
       currentPartition_ < int(partitionStartRows_.size() - 2);
 }
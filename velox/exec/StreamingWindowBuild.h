@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <deque>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/exec/Spiller.h"
 #include "velox/exec/WindowBuild.h"
 
 namespace facebook::velox::exec {
@@ -24,22 +29,42 @@ namespace facebook::velox::exec {
 /// {partition keys + order by keys}. The logic identifies partition changes
 /// when receiving input rows and splits out WindowPartitions for the Window
 /// operator to process.
+///
+/// If spilling is enabled, the rows of the partition that is still being
+/// accumulated can be spilled to disk in input order. The spilled rows are
+/// restored when the Window operator starts on that partition, after the rows
+/// of the previous partitions have been erased, so a single large partition
+/// doesn't pin memory that the arbitrator can reclaim while it is being
+/// accumulated. The rows are restored one spilled batch at a time, reserving
+/// memory for each batch. The whole partition is in memory once restored
+/// since the window functions may read any of its rows. Functions with
+/// bounded frames use partial partitions instead, which hold only the rows
+/// in the frames.
+///
+/// If partial partitions are enabled, the rows of a partition are streamed
+/// instead: nextPartition() returns a partial WindowPartition as soon as the
+/// first row of the partition is received, and loadPartialPartition() adds the
+/// rows received since. The Window operator then only holds the rows in the
+/// frames of the rows being computed, so memory is bounded by the frame size
+/// rather than by the partition size.
 class StreamingWindowBuild : public WindowBuild {
  public:
   StreamingWindowBuild(
       const std::shared_ptr<const core::WindowNode>& windowNode,
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
-      tsan_atomic<bool>* nonReclaimableSection);
+      tsan_atomic<bool>* nonReclaimableSection,
+      folly::Synchronized<common::SpillStats>* spillStats = nullptr);
 
   void addInput(RowVectorPtr input) override;
 
-  void spill() override {
-    VELOX_UNREACHABLE();
-  }
+  void spill() override;
 
   std::optional<common::SpillStats> spilledStats() const override {
-    return std::nullopt;
+    if (!spilled_) {
+      return std::nullopt;
+    }
+    return spillStats_->copy();
   }
 
   void noMoreInput() override;
@@ -48,7 +73,14 @@ class StreamingWindowBuild : public WindowBuild {
 
   std::unique_ptr<WindowPartition> nextPartition() override;
 
+  void loadPartialPartition(WindowPartition& partition, vector_size_t numRows)
+      override;
+
   bool needsInput() override {
+    if (partialPartitionsEnabled_) {
+      // No rows are pending past the partition being received.
+      return pendingPartitions_.size() <= 1;
+    }
     // No partitions are available or the currentPartition is the last available
     // one, so can consume input rows.
     return partitionStartRows_.size() == 0 ||
@@ -58,6 +90,17 @@ class StreamingWindowBuild : public WindowBuild {
  private:
   void buildNextPartition();
 
+  // Reads back the rows spilled from the partition at 'partition' in
+  // 'partitionStartRows_', if any, and inserts them before its rows in
+  // 'sortedRows_'.
+  void restoreSpilledRows(vector_size_t partition);
+
+  // Reserves memory for 'numRows' restored rows.
+  void ensureRestoreFits(vector_size_t numRows);
+
+  memory::MemoryPool* const pool_;
+  folly::Synchronized<common::SpillStats>* const spillStats_;
+
   // Vector of pointers to each input row in the data_ RowContainer.
   // Rows are erased from data_ when they are output from the
   // Window operator.
@@ -77,6 +120,29 @@ class StreamingWindowBuild : public WindowBuild {
   // Current partition being output. Used to construct WindowPartitions
   // during resetPartition.
   vector_size_t currentPartition_ = -1;
+
+  // The spilled runs of the partition being accumulated in spill order. Each
+  // run holds rows in input order that precede the rows in 'inputRows_'.
+  std::vector<std::unique_ptr<SpillPartition>> spilledRuns_;
+
+  // The spilled runs of the received partitions that have not been restored,
+  // keyed on the index of the partition in 'partitionStartRows_'.
+  folly::F14FastMap<vector_size_t, std::vector<std::unique_ptr<SpillPartition>>>
+      spilledPartitions_;
+
+  // True if any rows have been spilled.
+  bool spilled_{false};
+
+  // Used with partial partitions. The received rows that have not been added
+  // to a WindowPartition, one entry per partition in input order. The last
+  // entry is the partition being received unless 'noMoreInput_' is set.
+  std::deque<std::vector<char*>> pendingPartitions_;
+
+  // Used with partial partitions. True if the first entry of
+  // 'pendingPartitions_' has been returned by nextPartition().
+  bool partitionStarted_{false};
+
+  bool noMoreInput_{false};
 };
 
 } // namespace facebook::velox::exec
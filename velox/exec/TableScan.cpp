@@ -16,6 +16,7 @@
 #include "velox/exec/TableScan.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/FragmentResultCache.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
@@ -26,7 +27,10 @@ namespace facebook::velox::exec {
 TableScan::TableScan(
     int32_t operatorId,
     DriverCtx* driverCtx,
-    const std::shared_ptr<const core::TableScanNode>& tableScanNode)
+    const std::shared_ptr<const core::TableScanNode>& tableScanNode,
+    std::optional<std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>> columnHandles)
     : SourceOperator(
           driverCtx,
           tableScanNode->outputType(),
@@ -34,7 +38,9 @@ TableScan::TableScan(
           tableScanNode->id(),
           "TableScan"),
       tableHandle_(tableScanNode->tableHandle()),
-      columnHandles_(tableScanNode->assignments()),
+      columnHandles_(
+          columnHandles.has_value() ? std::move(*columnHandles)
+                                    : tableScanNode->assignments()),
       driverCtx_(driverCtx),
       connectorPool_(driverCtx_->task->addConnectorPoolLocked(
           planNodeId(),
@@ -44,6 +50,19 @@ TableScan::TableScan(
           tableHandle_->connectorId())),
       maxSplitPreloadPerDriver_(
           driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
+      splitPreloadTargetWaitMicros_(
+          driverCtx_->queryConfig().splitPreloadTargetWaitMs() * 1'000),
+      splitPreloadDepth_(
+          splitPreloadTargetWaitMicros_ == 0
+              ? maxSplitPreloadPerDriver_
+              : std::min(1, maxSplitPreloadPerDriver_)),
+      maxSplitMetadataPrefetchPerDriver_(
+          driverCtx_->queryConfig().maxSplitMetadataPrefetchPerDriver()),
+      prefetchBudget_(
+          driverCtx_->queryConfig().maxPrefetchBytesPerDriver() > 0
+              ? std::make_shared<io::PrefetchBudget>(
+                    driverCtx_->queryConfig().maxPrefetchBytesPerDriver())
+              : nullptr),
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
       getOutputTimeLimitMs_(
@@ -83,6 +102,9 @@ RowVectorPtr TableScan::getOutput() {
   const auto startTimeMs = getCurrentTimeMs();
   for (;;) {
     if (needNewSplit_) {
+      if (resultCache_ != nullptr && resultCache_->hasCachedOutput()) {
+        return nullptr;
+      }
       // Check if our Task needs us to yield or we've been running for too long
       // w/o producing a result. In this case we return with the Yield blocking
       // reason and an already fulfilled future.
@@ -109,7 +131,10 @@ RowVectorPtr TableScan::getOutput() {
           split,
           blockingFuture_,
           maxPreloadedSplits_,
-          splitPreloader_);
+          splitPreloader_,
+          maxMetadataPrefetchSplits_,
+          metadataPrefetcher_,
+          driverCtx_->driverId);
       if (blockingReason_ != BlockingReason::kNotBlocked) {
         return nullptr;
       }
@@ -119,18 +144,7 @@ RowVectorPtr TableScan::getOutput() {
         dynamicFilters_.clear();
         if (dataSource_) {
           curStatus_ = "getOutput: noMoreSplits_=1, updating stats_";
-          const auto connectorStats = dataSource_->runtimeStats();
-          auto lockedStats = stats_.wlock();
-          for (const auto& [name, counter] : connectorStats) {
-            if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
-              lockedStats->runtimeStats.emplace(
-                  name, RuntimeMetric(counter.unit));
-            } else {
-              VELOX_CHECK_EQ(
-                  lockedStats->runtimeStats.at(name).unit, counter.unit);
-            }
-            lockedStats->runtimeStats.at(name).addValue(counter.value);
-          }
+          addConnectorStats();
         }
         return nullptr;
       }
@@ -148,10 +162,24 @@ RowVectorPtr TableScan::getOutput() {
           connectorSplit->connectorId,
           "Got splits with different connector IDs");
 
+      if (resultCache_ != nullptr &&
+          resultCache_->startSplit(*connectorSplit)) {
+        curStatus_ = "getOutput: split output cached";
+        if (connectorSplit->dataSource != nullptr) {
+          connectorSplit->dataSource->close();
+        }
+        ++stats_.wlock()->numSplits;
+        driverCtx_->task->splitFinished(true, currentSplitWeight_);
+        needNewSplit_ = true;
+        // Returns so that the cached output is consumed before the next
+        // split.
+        return nullptr;
+      }
+
       if (dataSource_ == nullptr) {
         curStatus_ = "getOutput: creating dataSource_";
-        connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
-            connectorSplit->connectorId, planNodeId(), connectorPool_);
+        connectorQueryCtx_ =
+            createDataSourceQueryCtx(connectorSplit->connectorId);
         dataSource_ = connector_->createDataSource(
             outputType_,
             tableHandle_,
@@ -178,8 +206,12 @@ RowVectorPtr TableScan::getOutput() {
         ++numPreloadedSplits_;
         // The AsyncSource returns a unique_ptr to a shared_ptr. The unique_ptr
         // will be nullptr if there was a cancellation.
-        numReadyPreloadedSplits_ += connectorSplit->dataSource->hasValue();
+        const bool ready = connectorSplit->dataSource->hasValue();
+        numReadyPreloadedSplits_ += ready;
+        numMissedPreloadedSplits_ += !ready;
+        const auto waitStartMicros = getCurrentTimeMicro();
         auto preparedDataSource = connectorSplit->dataSource->move();
+        updateSplitPreloadDepth(getCurrentTimeMicro() - waitStartMicros);
         stats_.wlock()->getOutputTiming.add(
             connectorSplit->dataSource->prepareTiming());
         if (!preparedDataSource) {
@@ -192,11 +224,12 @@ RowVectorPtr TableScan::getOutput() {
         curStatus_ = "getOutput: adding split";
         const auto addSplitStartMicros = getCurrentTimeMicro();
         dataSource_->addSplit(connectorSplit);
+        const auto addSplitMicros = getCurrentTimeMicro() - addSplitStartMicros;
         stats_.wlock()->addRuntimeStat(
             "dataSourceAddSplitWallNanos",
             RuntimeCounter(
-                (getCurrentTimeMicro() - addSplitStartMicros) * 1'000,
-                RuntimeCounter::Unit::kNanos));
+                addSplitMicros * 1'000, RuntimeCounter::Unit::kNanos));
+        updateSplitPreloadDepth(addSplitMicros);
       }
       curStatus_ = "getOutput: updating stats_.numSplits";
       ++stats_.wlock()->numSplits;
@@ -223,7 +256,7 @@ RowVectorPtr TableScan::getOutput() {
          },
          &debugString_});
 
-    int readBatchSize = readBatchSize_;
+    int readBatchSize = tunedOutputBatchRows(readBatchSize_);
     if (maxFilteringRatio_ > 0) {
       readBatchSize = std::min(
           maxReadBatchSize_,
@@ -274,19 +307,55 @@ RowVectorPtr TableScan::getOutput() {
             "preloadedSplits", RuntimeCounter(numPreloadedSplits_));
         numPreloadedSplits_ = 0;
       }
+      if (numMetadataPrefetchedSplits_ > 0) {
+        lockedStats->addRuntimeStat(
+            "metadataPrefetchedSplits",
+            RuntimeCounter(numMetadataPrefetchedSplits_));
+        numMetadataPrefetchedSplits_ = 0;
+      }
       if (numReadyPreloadedSplits_ > 0) {
         lockedStats->addRuntimeStat(
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (numMissedPreloadedSplits_ > 0) {
+        lockedStats->addRuntimeStat(
+            "missedPreloadedSplits",
+            RuntimeCounter(numMissedPreloadedSplits_));
+        numMissedPreloadedSplits_ = 0;
+      }
     }
 
+    curStatus_ = "getOutput: reporting read bytes";
+    reportReadBytes(dataSource_->runtimeStats());
+
     curStatus_ = "getOutput: task->splitFinished";
     driverCtx_->task->splitFinished(true, currentSplitWeight_);
     needNewSplit_ = true;
   }
 }
 
+void TableScan::reportReadBytes(
+    const std::unordered_map<std::string, RuntimeCounter>& connectorStats) {
+  auto delta = [&](const char* name, int64_t& reported) -> uint64_t {
+    auto it = connectorStats.find(name);
+    if (it == connectorStats.end() || it->second.value <= reported) {
+      return 0;
+    }
+    const auto bytes = it->second.value - reported;
+    reported = it->second.value;
+    return bytes;
+  };
+  const auto ramBytes = delta("ramReadBytes", reportedRamReadBytes_);
+  const auto ssdBytes = delta("localReadBytes", reportedSsdReadBytes_);
+  const auto storageBytes =
+      delta("storageReadBytes", reportedStorageReadBytes_);
+  if (ramBytes + ssdBytes + storageBytes > 0) {
+    operatorCtx_->task()->queryCtx()->resourceUsage().addReadBytes(
+        ramBytes, ssdBytes, storageBytes);
+  }
+}
+
 void TableScan::preload(
     const std::shared_ptr<connector::ConnectorSplit>& split) {
   // The AsyncSource returns a unique_ptr to the shared_ptr of the
@@ -299,8 +368,7 @@ void TableScan::preload(
        table = tableHandle_,
        columns = columnHandles_,
        connector = connector_,
-       ctx = operatorCtx_->createConnectorQueryCtx(
-           split->connectorId, planNodeId(), connectorPool_),
+       ctx = createDataSourceQueryCtx(split->connectorId),
        task = operatorCtx_->task(),
        dynamicFilters = dynamicFilters_,
        split]() -> std::unique_ptr<connector::DataSource> {
@@ -328,6 +396,14 @@ void TableScan::preload(
       });
 }
 
+std::shared_ptr<connector::ConnectorQueryCtx>
+TableScan::createDataSourceQueryCtx(const std::string& connectorId) const {
+  auto connectorQueryCtx = operatorCtx_->createConnectorQueryCtx(
+      connectorId, planNodeId(), connectorPool_);
+  connectorQueryCtx->setPrefetchBudget(prefetchBudget_);
+  return connectorQueryCtx;
+}
+
 void TableScan::checkPreload() {
   auto* executor = connector_->executor();
   if (maxSplitPreloadPerDriver_ == 0 || !executor ||
@@ -336,7 +412,7 @@ void TableScan::checkPreload() {
   }
   if (dataSource_->allPrefetchIssued()) {
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
-        maxSplitPreloadPerDriver_;
+        splitPreloadDepth();
     if (!splitPreloader_) {
       splitPreloader_ =
           [executor,
@@ -349,6 +425,84 @@ void TableScan::checkPreload() {
             });
           };
     }
+    checkMetadataPrefetch();
+  }
+}
+
+void TableScan::updateSplitPreloadDepth(uint64_t waitMicros) {
+  if (splitPreloadTargetWaitMicros_ == 0 || maxSplitPreloadPerDriver_ == 0) {
+    return;
+  }
+  // Splits this many times in a row ready well within the target shrink the
+  // depth by one. A single slow split grows it by one.
+  constexpr int32_t kNumFastSplitsToShrink = 8;
+  if (waitMicros > splitPreloadTargetWaitMicros_) {
+    splitPreloadDepth_ =
+        std::min(splitPreloadDepth_ + 1, maxSplitPreloadPerDriver_);
+    numFastSplits_ = 0;
+  } else if (
+      waitMicros < splitPreloadTargetWaitMicros_ / 4 &&
+      ++numFastSplits_ >= kNumFastSplitsToShrink) {
+    splitPreloadDepth_ = std::max(splitPreloadDepth_ - 1, 1);
+    numFastSplits_ = 0;
+  }
+  stats_.wlock()->addRuntimeStat(
+      "splitPreloadDepth", RuntimeCounter(splitPreloadDepth_));
+}
+
+int32_t TableScan::splitPreloadDepth() const {
+  if (splitPreloadTargetWaitMicros_ == 0) {
+    return splitPreloadDepth_;
+  }
+  const auto* queryPool = connectorPool_->root();
+  // Assumes that a preloaded split takes as much memory as the ones being
+  // read. This overestimates while preloads are in flight, which only damps
+  // the growth of the depth.
+  const auto splitBytes = connectorPool_->usedBytes();
+  if (splitBytes <= 0 || queryPool->maxCapacity() == memory::kMaxMemory) {
+    return splitPreloadDepth_;
+  }
+  const int64_t numDrivers = driverCtx_->task->numDrivers(driverCtx_->driver);
+  const auto freeBytes = std::max<int64_t>(
+      0, queryPool->maxCapacity() - queryPool->reservedBytes());
+  return std::min<int64_t>(
+      splitPreloadDepth_, freeBytes / (splitBytes * numDrivers));
+}
+
+void TableScan::checkMetadataPrefetch() {
+  if (maxSplitMetadataPrefetchPerDriver_ == 0 ||
+      !connector_->supportsMetadataPrefetch()) {
+    return;
+  }
+  maxMetadataPrefetchSplits_ =
+      driverCtx_->task->numDrivers(driverCtx_->driver) *
+      maxSplitMetadataPrefetchPerDriver_;
+  if (!metadataPrefetcher_) {
+    metadataPrefetcher_ =
+        [this](const std::vector<std::shared_ptr<connector::ConnectorSplit>>&
+                   splits) {
+          // The reads may outlive the Task. The ConnectorQueryCtx holds the
+          // memory pool and is kept live by the connector until they finish.
+          connector_->prefetchMetadata(
+              splits,
+              operatorCtx_->createConnectorQueryCtx(
+                  splits[0]->connectorId, planNodeId(), connectorPool_));
+          numMetadataPrefetchedSplits_ += splits.size();
+        };
+  }
+}
+
+void TableScan::addConnectorStats() {
+  const auto connectorStats = dataSource_->runtimeStats();
+  reportReadBytes(connectorStats);
+  auto lockedStats = stats_.wlock();
+  for (const auto& [name, counter] : connectorStats) {
+    if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
+      lockedStats->runtimeStats.emplace(name, RuntimeMetric(counter.unit));
+    } else {
+      VELOX_CHECK_EQ(lockedStats->runtimeStats.at(name).unit, counter.unit);
+    }
+    lockedStats->runtimeStats.at(name).addValue(counter.value);
   }
 }
 
@@ -356,6 +510,31 @@ bool TableScan::isFinished() {
   return noMoreSplits_;
 }
 
+void TableScan::noMoreOutputNeeded() {
+  if (noMoreSplits_) {
+    return;
+  }
+  noMoreSplits_ = true;
+  dynamicFilters_.clear();
+  blockingFuture_ = ContinueFuture::makeEmpty();
+  blockingReason_ = BlockingReason::kNotBlocked;
+  if (!needNewSplit_) {
+    driverCtx_->task->splitFinished(true, currentSplitWeight_);
+    needNewSplit_ = true;
+  }
+  if (dataSource_) {
+    addConnectorStats();
+    // Destroying the data source cancels the loads it has scheduled ahead of
+    // the reads.
+    dataSource_.reset();
+  }
+  stats_.wlock()->addRuntimeStat("noMoreOutputNeeded", RuntimeCounter(1));
+  driverCtx_->task->noMoreOutputNeeded(
+      planNodeId(),
+      driverCtx_->splitGroupId,
+      driverCtx_->task->numDrivers(driverCtx_->driver));
+}
+
 void TableScan::addDynamicFilter(
     const core::PlanNodeId& producer,
     column_index_t outputChannel,
@@ -363,7 +542,14 @@ void TableScan::addDynamicFilter(
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
-  dynamicFilters_.emplace(outputChannel, filter);
+  // A filter on a column that already has one, e.g. a tighter TopN cutoff,
+  // is combined with the previous one.
+  auto it = dynamicFilters_.find(outputChannel);
+  if (it == dynamicFilters_.end()) {
+    dynamicFilters_.emplace(outputChannel, filter);
+  } else {
+    it->second = it->second->mergeWith(filter.get());
+  }
   stats_.wlock()->dynamicFilterStats.producerNodeIds.emplace(producer);
 }
 
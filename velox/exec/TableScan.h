@@ -20,12 +20,20 @@
 
 namespace facebook::velox::exec {
 
+class FragmentResultCache;
+
 class TableScan : public SourceOperator {
  public:
+  /// 'columnHandles' replace the assignments of 'tableScanNode' if set, e.g.
+  /// with handles that read fewer subfields.
   TableScan(
       int32_t operatorId,
       DriverCtx* driverCtx,
-      const std::shared_ptr<const core::TableScanNode>& tableScanNode);
+      const std::shared_ptr<const core::TableScanNode>& tableScanNode,
+      std::optional<std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>> columnHandles =
+          std::nullopt);
 
   folly::dynamic toJson() const override;
 
@@ -41,8 +49,21 @@ class TableScan : public SourceOperator {
 
   bool isFinished() override;
 
+  /// Finishes without reading the remaining splits. Closes the data source,
+  /// which cancels its prefetches, and the preloads of the queued splits once
+  /// all the Drivers of the scan stopped.
+  void noMoreOutputNeeded() override;
+
+  /// Dynamic filters are not taken if the output is cached since the output
+  /// would then depend on other operators.
   bool canAddDynamicFilter() const override {
-    return connector_->canAddDynamicFilter();
+    return resultCache_ == nullptr && connector_->canAddDynamicFilter();
+  }
+
+  /// Makes 'this' skip the splits whose output is in 'resultCache'. Called by
+  /// 'resultCache' when it is initialized.
+  void setResultCache(FragmentResultCache* resultCache) {
+    resultCache_ = resultCache;
   }
 
   void addDynamicFilter(
@@ -64,12 +85,41 @@ class TableScan : public SourceOperator {
   // of the Task's split queue for 'this' when getting splits.
   void checkPreload();
 
+  // Adapts 'splitPreloadDepth_' to the time it took to get the current split
+  // ready, 'waitMicros', if 'splitPreloadTargetWaitMicros_' is set.
+  void updateSplitPreloadDepth(uint64_t waitMicros);
+
+  // Returns the number of splits to preload per driver. This is
+  // 'splitPreloadDepth_' capped by the memory the query pool can still reserve
+  // if the depth is adaptive.
+  int32_t splitPreloadDepth() const;
+
+  // Sets 'maxMetadataPrefetchSplits_' and 'metadataPrefetcher_' if the
+  // connector supports prefetching file metadata. Called from checkPreload()
+  // once the preload of splits is set up.
+  void checkMetadataPrefetch();
+
   // Sets 'split->dataSource' to be an AsyncSource that makes a DataSource to
   // read 'split'. This source will be prepared in the background on the
   // executor of the connector. If the DataSource is needed before prepare is
   // done, it will be made when needed.
   void preload(const std::shared_ptr<connector::ConnectorSplit>& split);
 
+  // Adds the bytes read by 'dataSource_' from the caches and storage since
+  // the last call to the resource usage of the query. 'connectorStats' are
+  // the runtime stats of 'dataSource_'.
+  void reportReadBytes(
+      const std::unordered_map<std::string, RuntimeCounter>& connectorStats);
+
+  // Adds the runtime stats of 'dataSource_' to the stats of 'this' and
+  // reports the bytes it read.
+  void addConnectorStats();
+
+  // Returns a ConnectorQueryCtx for a DataSource of 'this' that shares
+  // 'prefetchBudget_' with the other DataSources of 'this'.
+  std::shared_ptr<connector::ConnectorQueryCtx> createDataSourceQueryCtx(
+      const std::string& connectorId) const;
+
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
   const std::
       unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
@@ -80,10 +130,17 @@ class TableScan : public SourceOperator {
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   int64_t currentSplitWeight_{0};
   bool needNewSplit_ = true;
+  // Bytes read by 'dataSource_' from the memory cache, the SSD cache and
+  // storage that have been added to the resource usage of the query.
+  int64_t reportedRamReadBytes_{0};
+  int64_t reportedSsdReadBytes_{0};
+  int64_t reportedStorageReadBytes_{0};
   std::shared_ptr<connector::Connector> connector_;
   std::shared_ptr<connector::ConnectorQueryCtx> connectorQueryCtx_;
   std::unique_ptr<connector::DataSource> dataSource_;
   bool noMoreSplits_ = false;
+  // Caches the output of the fragment that 'this' feeds by split. Not owned.
+  FragmentResultCache* resultCache_{nullptr};
   // Dynamic filters to add to the data source when it gets created.
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       dynamicFilters_;
@@ -92,6 +149,34 @@ class TableScan : public SourceOperator {
 
   const int32_t maxSplitPreloadPerDriver_{0};
 
+  // If not zero, the preload depth adapts to keep the wait for a split to be
+  // ready under this many microseconds.
+  const uint64_t splitPreloadTargetWaitMicros_{0};
+
+  // The current number of splits to preload per driver.
+  int32_t splitPreloadDepth_{0};
+
+  // Count of consecutive splits that were ready well within the target wait.
+  int32_t numFastSplits_{0};
+
+  const int32_t maxSplitMetadataPrefetchPerDriver_{0};
+
+  // Bounds the bytes loaded ahead by the DataSources of 'this', including the
+  // ones of preloaded splits. nullptr if the bytes are not bounded.
+  const std::shared_ptr<io::PrefetchBudget> prefetchBudget_;
+
+  int32_t maxMetadataPrefetchSplits_{0};
+
+  // Callback passed to getSplitOrFuture() for prefetching the file metadata of
+  // the splits queued after the preloaded ones. The lifetime is the lifetime of
+  // 'this'.
+  std::function<void(
+      const std::vector<std::shared_ptr<connector::ConnectorSplit>>&)>
+      metadataPrefetcher_{nullptr};
+
+  // Count of splits that had their metadata prefetched.
+  int32_t numMetadataPrefetchedSplits_{0};
+
   // Callback passed to getSplitOrFuture() for triggering async preload. The
   // callback's lifetime is the lifetime of 'this'. This callback can schedule
   // preloads on an executor. These preloads may outlive the Task and therefore
@@ -105,6 +190,9 @@ class TableScan : public SourceOperator {
   // Count of splits that finished preloading before being read.
   int32_t numReadyPreloadedSplits_{0};
 
+  // Count of preloaded splits that were not ready when needed.
+  int32_t numMissedPreloadedSplits_{0};
+
   int32_t readBatchSize_;
   int32_t maxReadBatchSize_;
 
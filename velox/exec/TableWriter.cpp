@@ -253,6 +253,12 @@ void TableWriter::updateStats(const connector::DataSink::Stats& stats) {
     }
     lockedStats->addRuntimeStat(
         "numWrittenFiles", RuntimeCounter(stats.numWrittenFiles));
+    if (stats.writerCloseTimeUs != 0) {
+      lockedStats->addRuntimeStat(
+          "writerCloseWallNanos",
+          RuntimeCounter(
+              stats.writerCloseTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
+    }
   }
   if (!stats.spillStats.empty()) {
     *spillStats_.wlock() += stats.spillStats;
@@ -16,6 +16,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <folly/executors/ThreadPoolExecutor.h>
 #include <string>
 
 #include "velox/common/base/Counters.h"
@@ -31,6 +32,8 @@
 #include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/SharedHashTable.h"
+#include "velox/exec/SpillHistory.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -175,6 +178,15 @@ void movePromisesOut(
   }
   from.clear();
 }
+
+// Returns true if 'executor' is a thread pool with idle threads. A pool that
+// starts its threads on demand counts the threads it has not started yet.
+bool hasIdleThreads(folly::Executor* executor) {
+  auto* threadPool = dynamic_cast<folly::ThreadPoolExecutor*>(executor);
+  return threadPool != nullptr &&
+      threadPool->getPoolStats().activeThreadCount <
+      threadPool->numThreads();
+}
 } // namespace
 
 std::string executionModeString(Task::ExecutionMode mode) {
@@ -304,6 +316,11 @@ Task::Task(
     VELOX_CHECK_NULL(
         dynamic_cast<const folly::InlineLikeExecutor*>(queryCtx_->executor()));
   }
+  const auto timelineCapacity =
+      queryCtx_->queryConfig().taskTimelineCapacity();
+  if (timelineCapacity > 0) {
+    timeline_ = std::make_unique<process::Timeline>(timelineCapacity);
+  }
 }
 
 Task::~Task() {
@@ -406,6 +423,15 @@ const std::string& Task::getOrCreateSpillDirectory() {
 }
 
 void Task::removeSpillDirectoryIfExists() {
+  if (spillRemoteTier_ != nullptr && spillRemoteTier_->numMovedFiles > 0) {
+    const auto& directory = spillRemoteTier_->directory;
+    try {
+      filesystems::getFileSystem(directory, nullptr)->rmdir(directory);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove remote spill directory '" << directory
+                 << "' for Task " << taskId() << ": " << e.what();
+    }
+  }
   if (spillDirectory_.empty() || !spillDirectoryCreated_) {
     return;
   }
@@ -823,6 +849,7 @@ void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
         Driver::enqueue(*it);
       }
     }
+    initDynamicDriversLocked();
   }
 
   // As some splits for grouped execution could have been added before the
@@ -1091,6 +1118,91 @@ std::vector<std::shared_ptr<Driver>> Task::createDriversLocked(
   return drivers;
 }
 
+void Task::initDynamicDriversLocked() {
+  const auto maxDrivers =
+      queryCtx_->queryConfig().maxDynamicDriversPerPipeline();
+  if (maxDrivers == 0 || isGroupedExecution()) {
+    return;
+  }
+  for (auto pipeline = 0; pipeline < driverFactories_.size(); ++pipeline) {
+    const auto& factory = driverFactories_[pipeline];
+    const auto maxPipelineDrivers = std::min(maxDrivers, factory->maxDrivers);
+    if (factory->numDrivers >= maxPipelineDrivers ||
+        !factory->supportsDynamicDrivers(queryCtx_->queryConfig())) {
+      continue;
+    }
+    auto& splitsState = getPlanNodeSplitsStateLocked(factory->leafNodeId());
+    splitsState.dynamicDriversPipelineId = pipeline;
+    splitsState.numInitialDrivers = factory->numDrivers;
+    splitsState.maxDynamicDrivers = maxPipelineDrivers;
+  }
+}
+
+void Task::maybeAddDynamicDriverLocked(SplitsState& splitsState) {
+  const auto pipeline = splitsState.dynamicDriversPipelineId;
+  if (pipeline < 0 || !isRunningLocked() || pauseRequested_) {
+    return;
+  }
+  auto& factory = driverFactories_[pipeline];
+  const auto numLiveDrivers =
+      factory->numDrivers - splitsState.numRetiredDrivers;
+  const auto& splitsStore = splitsState.groupSplitsStores[kUngroupedGroupId];
+  if (numLiveDrivers >= splitsState.maxDynamicDrivers ||
+      splitsStore.splits.size() <= numLiveDrivers ||
+      !hasIdleThreads(queryCtx_->executor())) {
+    return;
+  }
+
+  // Apart from the retired drivers, no driver of the pipeline gets to the end
+  // of its input while splits are queued. So the local exchange or the output
+  // buffer the pipeline produces to is not at end and the barriers of
+  // Task::allPeersFinished() are not complete and count the new driver as a
+  // peer.
+  const uint32_t driverId = factory->numDrivers;
+  auto self = shared_from_this();
+  auto driver = factory->createDriver(
+      std::make_unique<DriverCtx>(
+          self, driverId, pipeline, kUngroupedGroupId, driverId),
+      getExchangeClientLocked(pipeline),
+      [self](size_t i) {
+        return i < self->driverFactories_.size()
+            ? self->driverFactories_[i]->numTotalDrivers
+            : 0;
+      });
+  ++factory->numDrivers;
+  ++factory->numTotalDrivers;
+  ++numDriversUngrouped_;
+  ++numTotalDrivers_;
+  ++splitGroupStates_[kUngroupedGroupId].numRunningDrivers;
+  if (factory->needsPartitionedOutput() != nullptr) {
+    ++numDriversInPartitionedOutput_;
+    auto bufferManager = bufferManager_.lock();
+    VELOX_CHECK_NOT_NULL(bufferManager);
+    bufferManager->updateNumDrivers(taskId(), numDriversInPartitionedOutput_);
+  }
+  drivers_.push_back(driver);
+  ++numRunningDrivers_;
+  Driver::enqueue(driver);
+}
+
+bool Task::maybeRetireDynamicDriverLocked(SplitsState& splitsState) {
+  if (splitsState.dynamicDriversPipelineId < 0) {
+    return false;
+  }
+  const auto& splitsStore = splitsState.groupSplitsStores[kUngroupedGroupId];
+  if (!splitsStore.splits.empty() || splitsStore.noMoreSplits) {
+    return false;
+  }
+  const auto numLiveDrivers =
+      driverFactories_[splitsState.dynamicDriversPipelineId]->numDrivers -
+      splitsState.numRetiredDrivers;
+  if (numLiveDrivers <= splitsState.numInitialDrivers) {
+    return false;
+  }
+  ++splitsState.numRetiredDrivers;
+  return true;
+}
+
 // static
 void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   bool foundDriver = false;
@@ -1237,14 +1349,27 @@ bool Task::addSplitWithSequence(
 }
 
 void Task::addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split) {
+  if (split.hasConnectorSplit() && !split.hasGroup() &&
+      planFragment_.leafNodeRunsGroupedExecution(planNodeId)) {
+    // The split of a bucketed table goes to the group of its bucket. The same
+    // buckets of tables bucketed the same way then go to the same group, so
+    // that a join or aggregation on the bucketing keys runs one group at a
+    // time.
+    if (auto bucket = split.connectorSplit->bucketNumber()) {
+      VELOX_CHECK_GT(planFragment_.numSplitGroups, 0);
+      split.groupId = bucket.value() % planFragment_.numSplitGroups;
+    }
+  }
+
   bool isTaskRunning;
   std::unique_ptr<ContinuePromise> promise;
   {
     std::lock_guard<std::timed_mutex> l(mutex_);
     isTaskRunning = isRunningLocked();
     if (isTaskRunning) {
-      promise = addSplitLocked(
-          getPlanNodeSplitsStateLocked(planNodeId), std::move(split));
+      auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
+      promise = addSplitLocked(splitsState, std::move(split));
+      maybeAddDynamicDriverLocked(splitsState);
     }
   }
 
@@ -1447,16 +1572,85 @@ BlockingReason Task::getSplitOrFuture(
     exec::Split& split,
     ContinueFuture& future,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int32_t maxMetadataPrefetchSplits,
+    const ConnectorSplitsPrefetchFunc& prefetchMetadata,
+    int32_t driverId) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
-  return getSplitOrFutureLocked(
+  auto& splitsStore = splitsState.groupSplitsStores[splitGroupId];
+  // A retired driver gets no split, which finishes its table scan.
+  if (maybeRetireDynamicDriverLocked(splitsState)) {
+    return BlockingReason::kNotBlocked;
+  }
+  const bool useAffinity = driverId >= 0 && splitsState.sourceIsTableScan &&
+      queryCtx_->queryConfig().splitAffinityScheduling();
+  const auto reason = getSplitOrFutureLocked(
       splitsState.sourceIsTableScan,
-      splitsState.groupSplitsStores[splitGroupId],
+      splitsStore,
       split,
       future,
       maxPreloadSplits,
-      preload);
+      preload,
+      useAffinity ? driverId : -1);
+  if (reason == BlockingReason::kNotBlocked) {
+    maybeAddDynamicDriverLocked(splitsState);
+  }
+  if (maxMetadataPrefetchSplits > 0 && prefetchMetadata) {
+    prefetchSplitMetadataLocked(
+        splitsStore,
+        std::max(maxPreloadSplits, 0),
+        maxMetadataPrefetchSplits,
+        prefetchMetadata);
+  }
+  return reason;
+}
+
+void Task::noMoreOutputNeeded(
+    const core::PlanNodeId& planNodeId,
+    uint32_t splitGroupId,
+    int32_t numDrivers) {
+  std::vector<std::unique_ptr<AsyncSource<connector::DataSource>>> preloads;
+  {
+    std::lock_guard<std::timed_mutex> l(mutex_);
+    auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
+    auto& splitsStore = splitsState.groupSplitsStores[splitGroupId];
+    if (++splitsStore.numNoMoreOutputNeededDrivers < numDrivers) {
+      return;
+    }
+    for (auto& split : splitsStore.splits) {
+      auto& connectorSplit = split.connectorSplit;
+      if (connectorSplit && connectorSplit->dataSource) {
+        preloadingSplits_.erase(connectorSplit);
+        preloads.push_back(std::move(connectorSplit->dataSource));
+      }
+    }
+  }
+  // Closing waits for the preloads in progress, so do it outside of the lock.
+  for (auto& preload : preloads) {
+    preload->close();
+  }
+}
+
+void Task::prefetchSplitMetadataLocked(
+    SplitsStore& splitsStore,
+    int32_t firstSplit,
+    int32_t numSplits,
+    const ConnectorSplitsPrefetchFunc& prefetchMetadata) {
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (auto i = firstSplit;
+       i < splitsStore.splits.size() && i < firstSplit + numSplits;
+       ++i) {
+    auto& connectorSplit = splitsStore.splits[i].connectorSplit;
+    if (connectorSplit && !connectorSplit->metadataPrefetched &&
+        !connectorSplit->dataSource) {
+      connectorSplit->metadataPrefetched = true;
+      splits.push_back(connectorSplit);
+    }
+  }
+  if (!splits.empty()) {
+    prefetchMetadata(splits);
+  }
 }
 
 BlockingReason Task::getSplitOrFutureLocked(
@@ -1465,7 +1659,8 @@ BlockingReason Task::getSplitOrFutureLocked(
     exec::Split& split,
     ContinueFuture& future,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int32_t affinityDriverId) {
   if (splitsStore.splits.empty()) {
     if (splitsStore.noMoreSplits) {
       return BlockingReason::kNotBlocked;
@@ -1477,7 +1672,8 @@ BlockingReason Task::getSplitOrFutureLocked(
     return BlockingReason::kWaitForSplit;
   }
 
-  split = getSplitLocked(forTableScan, splitsStore, maxPreloadSplits, preload);
+  split = getSplitLocked(
+      forTableScan, splitsStore, maxPreloadSplits, preload, affinityDriverId);
   return BlockingReason::kNotBlocked;
 }
 
@@ -1485,7 +1681,8 @@ exec::Split Task::getSplitLocked(
     bool forTableScan,
     SplitsStore& splitsStore,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
+    const ConnectorSplitPreloadFunc& preload,
+    int32_t affinityDriverId) {
   int32_t readySplitIndex = -1;
   if (maxPreloadSplits > 0) {
     for (auto i = 0; i < splitsStore.splits.size() && i < maxPreloadSplits;
@@ -1498,16 +1695,30 @@ exec::Split Task::getSplitLocked(
       } else if (
           (readySplitIndex == -1) && (connectorSplit->dataSource->hasValue())) {
         readySplitIndex = i;
-        preloadingSplits_.erase(connectorSplit);
       }
     }
   }
+  if (affinityDriverId >= 0) {
+    const auto affinityIndex =
+        affinitySplitIndexLocked(splitsStore, affinityDriverId);
+    if (affinityIndex >= 0) {
+      readySplitIndex = affinityIndex;
+    }
+  }
   if (readySplitIndex == -1) {
     readySplitIndex = 0;
   }
   VELOX_CHECK(!splitsStore.splits.empty());
   auto split = std::move(splitsStore.splits[readySplitIndex]);
   splitsStore.splits.erase(splitsStore.splits.begin() + readySplitIndex);
+  // A split taken before its preload completes stays in 'preloadingSplits_'.
+  if (maxPreloadSplits > 0 && split.connectorSplit->dataSource &&
+      split.connectorSplit->dataSource->hasValue()) {
+    preloadingSplits_.erase(split.connectorSplit);
+  }
+  if (affinityDriverId >= 0) {
+    recordSplitAffinityLocked(splitsStore, affinityDriverId, split);
+  }
 
   --taskStats_.numQueuedSplits;
   ++taskStats_.numRunningSplits;
@@ -1526,6 +1737,61 @@ exec::Split Task::getSplitLocked(
   return split;
 }
 
+int32_t Task::affinitySplitIndexLocked(
+    const SplitsStore& splitsStore,
+    int32_t driverId) const {
+  const auto driverIt = splitsStore.driverAffinityKeys.find(driverId);
+  const std::string* lastKey =
+      driverIt == splitsStore.driverAffinityKeys.end() ? nullptr
+                                                       : &driverIt->second;
+  int32_t freeIndex = -1;
+  const int32_t numSplits = std::min<int32_t>(
+      splitsStore.splits.size(), kMaxAffinitySplitScan);
+  for (auto i = 0; i < numSplits; ++i) {
+    const auto& connectorSplit = splitsStore.splits[i].connectorSplit;
+    if (connectorSplit == nullptr) {
+      continue;
+    }
+    const auto& key = connectorSplit->cacheAffinityKey;
+    if (lastKey != nullptr && !key.empty() && key == *lastKey) {
+      return i;
+    }
+    if (freeIndex < 0 &&
+        (key.empty() || splitsStore.affinityKeyDrivers.count(key) == 0)) {
+      freeIndex = i;
+    }
+  }
+  return freeIndex;
+}
+
+void Task::recordSplitAffinityLocked(
+    SplitsStore& splitsStore,
+    int32_t driverId,
+    const exec::Split& split) {
+  if (split.connectorSplit == nullptr ||
+      split.connectorSplit->cacheAffinityKey.empty()) {
+    return;
+  }
+  const auto& key = split.connectorSplit->cacheAffinityKey;
+  auto& lastKey = splitsStore.driverAffinityKeys[driverId];
+  if (lastKey == key) {
+    ++taskStats_.numAffinityTableScanSplits;
+    return;
+  }
+  auto it = splitsStore.affinityKeyDrivers.find(key);
+  if (it != splitsStore.affinityKeyDrivers.end() && it->second != driverId) {
+    ++taskStats_.numStolenTableScanSplits;
+  }
+  // The previous key of the Driver is free for others unless taken since.
+  auto lastIt = splitsStore.affinityKeyDrivers.find(lastKey);
+  if (lastIt != splitsStore.affinityKeyDrivers.end() &&
+      lastIt->second == driverId) {
+    splitsStore.affinityKeyDrivers.erase(lastIt);
+  }
+  splitsStore.affinityKeyDrivers[key] = driverId;
+  lastKey = key;
+}
+
 void Task::splitFinished(bool fromTableScan, int64_t splitWeight) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   ++taskStats_.numFinishedSplits;
@@ -1781,6 +2047,22 @@ std::shared_ptr<HashJoinBridge> Task::getHashJoinBridge(
   return getJoinBridgeInternal<HashJoinBridge>(splitGroupId, planNodeId);
 }
 
+uint8_t Task::spillPartitionBitsLocked(
+    const core::PlanNode& planNode,
+    uint8_t numPartitionBits) {
+  auto it = spillPartitionBits_.find(planNode.id());
+  if (it != spillPartitionBits_.end()) {
+    return it->second;
+  }
+  const auto historyBits = SpillHistory::instance().partitionBits(
+      SpillHistory::fingerprint(planNode));
+  if (historyBits.has_value()) {
+    numPartitionBits = std::max(numPartitionBits, historyBits.value());
+  }
+  spillPartitionBits_.emplace(planNode.id(), numPartitionBits);
+  return numPartitionBits;
+}
+
 std::shared_ptr<HashJoinBridge> Task::getHashJoinBridgeLocked(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId) {
@@ -2116,6 +2398,10 @@ TaskStats Task::taskStats() const {
   return taskStats;
 }
 
+std::string Task::timelineChromeTrace() const {
+  return timeline_ == nullptr ? "" : timeline_->toChromeTrace();
+}
+
 bool Task::getLongRunningOpCalls(
     std::chrono::nanoseconds lockTimeout,
     size_t thresholdDurationMs,
@@ -2321,6 +2607,10 @@ folly::dynamic Task::toShortJson() const {
   return toShortJsonLocked();
 }
 
+std::string Task::heapProfile() const {
+  return static_cast<memory::MemoryPoolImpl*>(pool_.get())->heapProfile();
+}
+
 folly::dynamic Task::toJson() const {
   std::lock_guard<std::timed_mutex> l(mutex_);
   auto obj = toShortJsonLocked();
@@ -2409,6 +2699,17 @@ std::shared_ptr<MergeJoinSource> Task::getMergeJoinSource(
   return it->second;
 }
 
+std::shared_ptr<SharedHashTable> Task::getOrCreateSharedHashTable(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId,
+    const std::function<std::shared_ptr<SharedHashTable>()>& create) {
+  auto& table = splitGroupStates_[splitGroupId].sharedHashTables[planNodeId];
+  if (table == nullptr) {
+    table = create();
+  }
+  return table;
+}
+
 void Task::createLocalExchangeQueuesLocked(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "velox/common/process/Timeline.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
@@ -35,6 +36,9 @@ class NestedLoopJoinBridge;
 using ConnectorSplitPreloadFunc =
     std::function<void(const std::shared_ptr<connector::ConnectorSplit>&)>;
 
+using ConnectorSplitsPrefetchFunc = std::function<void(
+    const std::vector<std::shared_ptr<connector::ConnectorSplit>>&)>;
+
 class Task : public std::enable_shared_from_this<Task> {
  public:
   /// Threading mode the task is executed.
@@ -100,12 +104,45 @@ class Task : public std::enable_shared_from_this<Task> {
     spillDirectoryCreated_ = alreadyCreated;
   }
 
+  /// Specifies a remote directory, e.g. on S3 or HDFS, to which the finished
+  /// spill files of this task are moved while its local spill files take
+  /// more than 'localWatermarkBytes'. The files are moved on the spill
+  /// executor of the query if there is one. Must be called before the task
+  /// starts.
+  void setRemoteSpillDirectory(
+      const std::string& directory,
+      uint64_t localWatermarkBytes) {
+    spillRemoteTier_ = std::make_shared<common::SpillRemoteTier>(
+        directory, localWatermarkBytes, queryCtx_->spillExecutor());
+  }
+
+  /// Returns the remote tier of the spill files of this task or nullptr if
+  /// there is none.
+  const std::shared_ptr<common::SpillRemoteTier>& spillRemoteTier() const {
+    return spillRemoteTier_;
+  }
+
+  /// Returns the number of spill partition bits for the operators of
+  /// 'planNode': the bits recorded in SpillHistory for its plan if more than
+  /// 'numPartitionBits', else 'numPartitionBits'. The first call for a plan
+  /// node decides for all the drivers of the task, so that the build and
+  /// probe sides of a join partition alike. Not thread safe, e.g. must be
+  /// called from the Operator's constructor.
+  uint8_t spillPartitionBitsLocked(
+      const core::PlanNode& planNode,
+      uint8_t numPartitionBits);
+
   std::string toString() const;
 
   folly::dynamic toJson() const;
 
   folly::dynamic toShortJson() const;
 
+  /// Returns a pprof heap profile of the sampled allocations made by the
+  /// operators of this task. Has no samples unless the memory manager is
+  /// created with MemoryManagerOptions::memoryPoolAllocationSampleBytes.
+  std::string heapProfile() const;
+
   /// Returns universally unique identifier of the task.
   const std::string& uuid() const {
     return uuid_;
@@ -287,6 +324,17 @@ class Task : public std::enable_shared_from_this<Task> {
   /// structure.
   TaskStats taskStats() const;
 
+  /// Returns the timeline of the Driver runs, operator calls and waits of the
+  /// task. The pid and tid of the events are the pipeline and Driver ids.
+  /// nullptr if QueryConfig::taskTimelineCapacity() is 0.
+  process::Timeline* timeline() const {
+    return timeline_.get();
+  }
+
+  /// Returns timeline() in the Chrome trace event format for chrome://tracing
+  /// or Perfetto. Empty if there is no timeline.
+  std::string timelineChromeTrace() const;
+
   /// Information about an operator call that helps debugging stuck calls.
   struct OpCallInfo {
     size_t durationMs;
@@ -401,14 +449,32 @@ class Task : public std::enable_shared_from_this<Task> {
   /// that will complete when split becomes available or no-more-splits
   /// signal is received. If 'maxPreloadSplits' is given, ensures that
   /// so many of splits at the head of the queue are preloading. If
-  /// they are not, calls preload on them to start preload.
+  /// they are not, calls preload on them to start preload. If
+  /// 'maxMetadataPrefetchSplits' is given, calls 'prefetchMetadata' once with
+  /// the splits of the so many next queue positions after the preloaded ones
+  /// that have not had their metadata prefetched yet. 'driverId' is the
+  /// Driver of a TableScan, which gets splits by their cache affinity if
+  /// QueryConfig::kSplitAffinityScheduling is set.
   BlockingReason getSplitOrFuture(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
       exec::Split& split,
       ContinueFuture& future,
       int32_t maxPreloadSplits = 0,
-      const ConnectorSplitPreloadFunc& preload = nullptr);
+      const ConnectorSplitPreloadFunc& preload = nullptr,
+      int32_t maxMetadataPrefetchSplits = 0,
+      const ConnectorSplitsPrefetchFunc& prefetchMetadata = nullptr,
+      int32_t driverId = -1);
+
+  /// Called by a TableScan of 'planNodeId' whose output is no longer needed,
+  /// e.g. after a downstream Limit finished. Once 'numDrivers' Drivers of the
+  /// scan stopped, closes the preloading data sources of the splits still
+  /// queued for 'splitGroupId' so that they stop reading. The splits stay
+  /// queued and are read without preload if a Driver still gets them.
+  void noMoreOutputNeeded(
+      const core::PlanNodeId& planNodeId,
+      uint32_t splitGroupId,
+      int32_t numDrivers);
 
   void splitFinished(bool fromTableScan, int64_t splitWeight);
 
@@ -436,6 +502,14 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Returns the hash table shared by the drivers of 'planNodeId' in
+  /// 'splitGroupId'. The first caller creates it with 'create'. Called from
+  /// the operator constructors, which run under the task lock.
+  std::shared_ptr<SharedHashTable> getOrCreateSharedHashTable(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId,
+      const std::function<std::shared_ptr<SharedHashTable>()>& create);
+
   void createLocalExchangeQueuesLocked(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
@@ -699,6 +773,20 @@ class Task : public std::enable_shared_from_this<Task> {
   std::vector<std::shared_ptr<Driver>> createDriversLocked(
       uint32_t splitGroupId);
 
+  // Marks the pipelines that can get drivers added while they run. See
+  // QueryConfig::kMaxDynamicDriversPerPipeline.
+  void initDynamicDriversLocked();
+
+  // Adds and starts a driver for the pipeline that reads the splits of
+  // 'splitsState' if its queue of splits is deeper than its number of running
+  // drivers and the executor has idle threads.
+  void maybeAddDynamicDriverLocked(SplitsState& splitsState);
+
+  // Returns true if the driver asking for a split of 'splitsState' should
+  // finish because there are no queued splits and the pipeline runs more
+  // drivers than it started with.
+  bool maybeRetireDynamicDriverLocked(SplitsState& splitsState);
+
   // Returns time (ms) since the task execution started or zero, if not started.
   uint64_t timeSinceStartMsLocked() const;
 
@@ -848,15 +936,45 @@ class Task : public std::enable_shared_from_this<Task> {
       exec::Split& split,
       ContinueFuture& future,
       int32_t maxPreloadSplits,
-      const ConnectorSplitPreloadFunc& preload);
+      const ConnectorSplitPreloadFunc& preload,
+      int32_t affinityDriverId = -1);
 
   /// Returns next split from the store. The caller must ensure the store is not
-  /// empty.
+  /// empty. If 'affinityDriverId' is not negative, the split is picked by its
+  /// cache affinity for that Driver.
   exec::Split getSplitLocked(
       bool forTableScan,
       SplitsStore& splitsStore,
       int32_t maxPreloadSplits,
-      const ConnectorSplitPreloadFunc& preload);
+      const ConnectorSplitPreloadFunc& preload,
+      int32_t affinityDriverId = -1);
+
+  /// Maximum number of queued splits looked at for a split by affinity.
+  static constexpr int32_t kMaxAffinitySplitScan = 64;
+
+  /// Returns the index of the split in the first kMaxAffinitySplitScan splits
+  /// of 'splitsStore' with the cache affinity key of the last split of Driver
+  /// 'driverId', else of the first split whose key no other Driver reads.
+  /// Returns -1 if there is neither.
+  int32_t affinitySplitIndexLocked(
+      const SplitsStore& splitsStore,
+      int32_t driverId) const;
+
+  /// Records that Driver 'driverId' got 'split' for the affinity of the next
+  /// splits and updates the affinity stats.
+  void recordSplitAffinityLocked(
+      SplitsStore& splitsStore,
+      int32_t driverId,
+      const exec::Split& split);
+
+  /// Calls 'prefetchMetadata' on the connector splits at positions
+  /// ['firstSplit', 'firstSplit' + 'numSplits') of 'splitsStore' that have not
+  /// been prefetched or preloaded yet.
+  void prefetchSplitMetadataLocked(
+      SplitsStore& splitsStore,
+      int32_t firstSplit,
+      int32_t numSplits,
+      const ConnectorSplitsPrefetchFunc& prefetchMetadata);
 
   // Creates for the given split group and fills up the 'SplitGroupState'
   // structure, which stores inter-operator state (local exchange, bridges).
@@ -1042,6 +1160,8 @@ class Task : public std::enable_shared_from_this<Task> {
 
   std::vector<std::unique_ptr<DriverFactory>> driverFactories_;
   std::vector<std::shared_ptr<Driver>> drivers_;
+  // Set if QueryConfig::taskTimelineCapacity() is not 0.
+  std::unique_ptr<process::Timeline> timeline_;
   // When Drivers are closed by the Task, there is a chance that race and/or
   // bugs can cause such Drivers to be held forever, in turn holding a pointer
   // to the Task making it a zombie Tasks. This vector is used to keep track of
@@ -1159,6 +1279,13 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  // Set by setRemoteSpillDirectory().
+  std::shared_ptr<common::SpillRemoteTier> spillRemoteTier_;
+
+  // The spill partition bits of the plan nodes returned by
+  // spillPartitionBitsLocked().
+  folly::F14FastMap<core::PlanNodeId, uint8_t> spillPartitionBits_;
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
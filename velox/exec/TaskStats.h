@@ -61,6 +61,12 @@ struct TaskStats {
   int64_t runningTableScanSplitWeights{0};
   int64_t queuedTableScanSplitWeights{0};
 
+  /// Table scan splits given to a Driver that got a split with the same cache
+  /// affinity key before, and splits given to a Driver while another Driver
+  /// read their key. See QueryConfig::kSplitAffinityScheduling.
+  int32_t numAffinityTableScanSplits{0};
+  int32_t numStolenTableScanSplits{0};
+
   /// The subscript is given by each Operator's
   /// DriverCtx::pipelineId. This is a sum total reflecting fully
   /// processed Splits for Drivers of this pipeline.
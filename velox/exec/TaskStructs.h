@@ -25,6 +25,7 @@ class JoinBridge;
 class LocalExchangeMemoryManager;
 class MergeSource;
 class MergeJoinSource;
+class SharedHashTable;
 struct Split;
 
 /// Corresponds to Presto TaskState, needed for reporting query completion.
@@ -57,6 +58,14 @@ struct SplitsStore {
   bool noMoreSplits{false};
   /// Blocking promises given out when out of splits to distribute.
   std::vector<ContinuePromise> splitPromises;
+  /// The cache affinity key of the last split given to each Driver by driver
+  /// id and the Driver that last got a split of each key. Used with
+  /// QueryConfig::kSplitAffinityScheduling.
+  std::unordered_map<int32_t, std::string> driverAffinityKeys;
+  std::unordered_map<std::string, int32_t> affinityKeyDrivers;
+  /// Number of Drivers reading the splits whose output is no longer needed.
+  /// See Task::noMoreOutputNeeded().
+  int32_t numNoMoreOutputNeededDrivers{0};
 };
 
 /// Structure contains the current info on splits for a particular plan node.
@@ -73,6 +82,20 @@ struct SplitsState {
   /// Map split group id -> split store.
   std::unordered_map<uint32_t, SplitsStore> groupSplitsStores;
 
+  /// The pipeline that reads the splits if drivers can be added to it while
+  /// it runs, -1 otherwise. See QueryConfig::kMaxDynamicDriversPerPipeline.
+  int32_t dynamicDriversPipelineId{-1};
+
+  /// Number of drivers the pipeline started with. Drivers are retired down to
+  /// this number when the splits run out.
+  uint32_t numInitialDrivers{0};
+
+  /// Maximum number of running drivers of the pipeline.
+  uint32_t maxDynamicDrivers{0};
+
+  /// Number of drivers that finished early because there were no splits.
+  uint32_t numRetiredDrivers{0};
+
   /// We need these due to having promises in the structure.
   SplitsState() = default;
   SplitsState(SplitsState const&) = delete;
@@ -105,6 +128,11 @@ struct SplitGroupState {
   /// Map of local exchanges keyed on LocalPartition plan node ID.
   std::unordered_map<core::PlanNodeId, LocalExchangeState> localExchanges;
 
+  /// Map of hash tables shared by the drivers of a MarkDistinct or RowNumber
+  /// keyed on the plan node ID.
+  std::unordered_map<core::PlanNodeId, std::shared_ptr<SharedHashTable>>
+      sharedHashTables;
+
   /// Drivers created and still running for this split group.
   /// The split group is finished when this numbers reaches zero.
   uint32_t numRunningDrivers{0};
@@ -130,6 +158,7 @@ struct SplitGroupState {
     localMergeSources.clear();
     mergeJoinSources.clear();
     localExchanges.clear();
+    sharedHashTables.clear();
   }
 };
 
@@ -37,8 +37,20 @@ TopN::TopN(
           topNNode->sortingKeys(),
           topNNode->sortingOrders(),
           data_.get()),
-      topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {
+      prefixComparator_(
+          driverCtx->queryConfig().topNPrefixSortEnabled()
+              ? PrefixSortRowComparator::create(
+                    outputType_,
+                    topNNode->sortingKeys(),
+                    topNNode->sortingOrders(),
+                    driverCtx->queryConfig().prefixSortNormalizedKeyMaxBytes(),
+                    data_.get(),
+                    &comparator_,
+                    pool())
+              : nullptr),
+      topRows_(Compare{&comparator_, prefixComparator_.get()}),
+      decodedVectors_(outputType_->children().size()),
+      firstSortOrder_(topNNode->sortingOrders()[0]) {
   const auto numColumns{outputType_->children().size()};
   const auto numSortingKeys{topNNode->sortingKeys().size()};
   sortingKeyColumns_.reserve(numSortingKeys);
@@ -68,17 +80,27 @@ void TopN::addInput(RowVectorPtr input) {
   folly::F14FastMap<void*, vector_size_t> passedRows;
   for (auto row = 0; row < input->size(); ++row) {
     char* newRow = nullptr;
+    char* newEntry = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
+      if (prefixComparator_ != nullptr) {
+        newEntry = prefixComparator_->newEntry();
+      }
     } else {
-      char* topRow = topRows_.top();
+      char* topElement = topRows_.top();
 
-      if (!comparator_(decodedVectors_, row, topRow)) {
+      const bool isLess = prefixComparator_ != nullptr
+          ? (*prefixComparator_)(decodedVectors_, row, topElement)
+          : comparator_(decodedVectors_, row, topElement);
+      if (!isLess) {
         continue;
       }
       topRows_.pop();
       // Reuse the topRow's memory.
-      newRow = data_->initializeRow(topRow, true /* reuse */);
+      newRow = data_->initializeRow(rowAt(topElement), true /* reuse */);
+      if (prefixComparator_ != nullptr) {
+        newEntry = topElement;
+      }
     }
 
     data_->initializeFields(newRow);
@@ -86,7 +108,12 @@ void TopN::addInput(RowVectorPtr input) {
       data_->store(decodedVectors_[col], row, newRow, col);
     }
 
-    topRows_.push(newRow);
+    if (prefixComparator_ != nullptr) {
+      prefixComparator_->encodeRow(newRow, newEntry);
+      topRows_.push(newEntry);
+    } else {
+      topRows_.push(newRow);
+    }
     if (hasNonKeyColumn) {
       passedRows[newRow] = row;
     }
@@ -104,6 +131,79 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  maybeSetThresholdFilter();
+}
+
+void TopN::maybeSetThresholdFilter() {
+  if (topRows_.empty() || topRows_.size() < count_) {
+    return;
+  }
+  const auto channel = sortingKeyColumns_[0];
+  if (!thresholdChannelChecked_) {
+    thresholdChannelChecked_ = true;
+    const auto& type = outputType_->childAt(channel);
+    if (type->isDecimal()) {
+      return;
+    }
+    switch (type->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        break;
+      default:
+        return;
+    }
+    const auto channels =
+        operatorCtx_->driverCtx()->driver->canPushdownFilters(this, {channel});
+    if (channels.count(channel) == 0) {
+      return;
+    }
+    thresholdChannel_ = channel;
+  }
+  if (!thresholdChannel_.has_value()) {
+    return;
+  }
+
+  const char* row = rowAt(topRows_.top());
+  const auto column = data_->columnAt(channel);
+  if (RowContainer::isNullAt(row, column)) {
+    return;
+  }
+  int64_t value;
+  switch (outputType_->childAt(channel)->kind()) {
+    case TypeKind::TINYINT:
+      value = RowContainer::valueAt<int8_t>(row, column.offset());
+      break;
+    case TypeKind::SMALLINT:
+      value = RowContainer::valueAt<int16_t>(row, column.offset());
+      break;
+    case TypeKind::INTEGER:
+      value = RowContainer::valueAt<int32_t>(row, column.offset());
+      break;
+    default:
+      value = RowContainer::valueAt<int64_t>(row, column.offset());
+      break;
+  }
+
+  const bool ascending = firstSortOrder_.isAscending();
+  if (threshold_.has_value() &&
+      (ascending ? value >= threshold_.value() : value <= threshold_.value())) {
+    return;
+  }
+  threshold_ = value;
+  // The rows with the same first key may still make the top rows on the
+  // other keys, so the threshold itself passes. Nulls pass if they sort
+  // first.
+  const bool nullAllowed = firstSortOrder_.isNullsFirst();
+  if (ascending) {
+    dynamicFilters_[channel] = std::make_shared<common::BigintRange>(
+        std::numeric_limits<int64_t>::min(), value, nullAllowed);
+  } else {
+    dynamicFilters_[channel] = std::make_shared<common::BigintRange>(
+        value, std::numeric_limits<int64_t>::max(), nullAllowed);
+  }
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -138,7 +238,7 @@ void TopN::noMoreInput() {
   }
   rows_.resize(topRows_.size());
   for (auto i = rows_.size(); i > 0; --i) {
-    rows_[i - 1] = topRows_.top();
+    rows_[i - 1] = rowAt(topRows_.top());
     topRows_.pop();
   }
 
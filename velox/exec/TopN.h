@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/exec/Operator.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/RowContainer.h"
 
 namespace facebook::velox::exec {
@@ -44,6 +45,32 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Compares the elements of 'topRows_'. The elements are rows in 'data_' or
+  // entries of 'prefixComparator_' if it is set.
+  struct Compare {
+    RowComparator* comparator;
+    PrefixSortRowComparator* prefixComparator;
+
+    bool operator()(const char* lhs, const char* rhs) {
+      return prefixComparator != nullptr ? (*prefixComparator)(lhs, rhs)
+                                         : (*comparator)(lhs, rhs);
+    }
+  };
+
+  // Sets a dynamic filter on the first sorting key that passes only the
+  // values that may still make the top rows, e.g. key <= the key of the
+  // current last top row for an ascending key. The Driver pushes the filter
+  // into the source of the pipeline, e.g. a TableScan, which then skips the
+  // rows that cannot make the top rows. Only done for integer keys. Called
+  // after each addInput().
+  void maybeSetThresholdFilter();
+
+  // Returns the row in 'data_' for an element of 'topRows_'.
+  char* rowAt(char* element) const {
+    return prefixComparator_ != nullptr ? prefixComparator_->rowAt(element)
+                                        : element;
+  }
+
   const int32_t count_;
 
   bool finished_ = false;
@@ -61,12 +88,28 @@ class TopN : public Operator {
   // Once all inputs are available, we copy the final set of rows to the
   // vector (rows_) in correct order. We use this vector along with the
   // RowContainer to generate the TopN's output.
+  //
+  // If 'topn_prefix_sort_enabled' is set and the first sorting key can be
+  // normalized, topRows_ keeps entries of 'prefixComparator_' which store the
+  // normalized keys along with the row pointers.
   std::unique_ptr<RowContainer> data_;
   RowComparator comparator_;
-  std::priority_queue<char*, std::vector<char*>, RowComparator> topRows_;
+  std::unique_ptr<PrefixSortRowComparator> prefixComparator_;
+  std::priority_queue<char*, std::vector<char*>, Compare> topRows_;
   std::vector<char*> rows_;
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // The order of the first sorting key.
+  const core::SortOrder firstSortOrder_;
+
+  // True once maybeSetThresholdFilter() checked if the first sorting key can
+  // be filtered at the source.
+  bool thresholdChannelChecked_{false};
+  // The channel of the first sorting key if it can be filtered at the source.
+  std::optional<column_index_t> thresholdChannel_;
+  // The key of the last top row when the last threshold filter was set.
+  std::optional<int64_t> threshold_;
 };
 } // namespace facebook::velox::exec
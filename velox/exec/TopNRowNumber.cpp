@@ -140,6 +140,17 @@ TopNRowNumber::TopNRowNumber(
           node->sortingKeys(),
           node->sortingOrders(),
           data_.get()),
+      prefixComparator_(
+          driverCtx->queryConfig().topNPrefixSortEnabled()
+              ? PrefixSortRowComparator::create(
+                    inputType_,
+                    node->sortingKeys(),
+                    node->sortingOrders(),
+                    driverCtx->queryConfig().prefixSortNormalizedKeyMaxBytes(),
+                    data_.get(),
+                    &comparator_,
+                    pool())
+              : nullptr),
       decodedVectors_(inputType_->size()) {
   const auto& keys = node->partitionKeys();
   const auto numKeys = keys.size();
@@ -167,7 +178,8 @@ TopNRowNumber::TopNRowNumber(
     lookup_ = std::make_unique<HashLookup>(table_->hashers());
   } else {
     allocator_ = std::make_unique<HashStringAllocator>(pool());
-    singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+    singlePartition_ = std::make_unique<TopRows>(
+        allocator_.get(), comparator_, prefixComparator_.get());
   }
 
   if (generateRowNumber_) {
@@ -241,8 +253,8 @@ bool TopNRowNumber::abandonPartialEarly() const {
 
 void TopNRowNumber::initializeNewPartitions() {
   for (auto index : lookup_->newGroups) {
-    new (lookup_->hits[index] + partitionOffset_)
-        TopRows(table_->stringAllocator(), comparator_);
+    new (lookup_->hits[index] + partitionOffset_) TopRows(
+        table_->stringAllocator(), comparator_, prefixComparator_.get());
   }
 }
 
@@ -250,12 +262,19 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
   auto& topRows = partition.rows;
 
   char* newRow = nullptr;
+  char* newEntry = nullptr;
   if (topRows.size() < limit_) {
     newRow = data_->newRow();
+    if (prefixComparator_ != nullptr) {
+      newEntry = prefixComparator_->newEntry();
+    }
   } else {
-    char* topRow = topRows.top();
+    char* topElement = topRows.top();
 
-    if (!comparator_(decodedVectors_, index, topRow)) {
+    const bool isLess = prefixComparator_ != nullptr
+        ? (*prefixComparator_)(decodedVectors_, index, topElement)
+        : comparator_(decodedVectors_, index, topElement);
+    if (!isLess) {
       // Drop this input row.
       return;
     }
@@ -264,14 +283,22 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     topRows.pop();
 
     // Reuse the topRow's memory.
-    newRow = data_->initializeRow(topRow, true /* reuse */);
+    newRow = data_->initializeRow(rowAt(topElement), true /* reuse */);
+    if (prefixComparator_ != nullptr) {
+      newEntry = topElement;
+    }
   }
 
   for (auto col = 0; col < decodedVectors_.size(); ++col) {
     data_->store(decodedVectors_[col], index, newRow, col);
   }
 
-  topRows.push(newRow);
+  if (prefixComparator_ != nullptr) {
+    prefixComparator_->encodeRow(newRow, newEntry);
+    topRows.push(newEntry);
+  } else {
+    topRows.push(newRow);
+  }
 }
 
 void TopNRowNumber::noMoreInput() {
@@ -370,7 +397,7 @@ void TopNRowNumber::appendPartitionRows(
     if (rowNumbers) {
       rowNumbers->set(index, rowNumber--);
     }
-    outputRows_[index] = partition.rows.top();
+    outputRows_[index] = rowAt(partition.rows.top());
     partition.rows.pop();
   }
 }
@@ -421,8 +448,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
   VELOX_CHECK_GT(outputBatchSize_, 0);
 
   // Loop over partitions and emit sorted rows along with row numbers.
-  auto output =
-      BaseVector::create<RowVector>(outputType_, outputBatchSize_, pool());
+  auto output = getResultVector(outputBatchSize_);
   FlatVector<int64_t>* rowNumbers = nullptr;
   if (generateRowNumber_) {
     rowNumbers = output->children().back()->as<FlatVector<int64_t>>();
@@ -463,7 +489,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
   }
 
   if (offset == 0) {
-    data_->clear();
+    clearData();
     if (table_ != nullptr) {
       table_->clear();
     }
@@ -548,8 +574,7 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
   // dropping rows until the next partition starts.
   // We'll emit output every time we accumulate 'outputBatchSize_' rows.
 
-  auto output =
-      BaseVector::create<RowVector>(outputType_, outputBatchSize_, pool());
+  auto output = getResultVector(outputBatchSize_);
   FlatVector<int64_t>* rowNumbers = nullptr;
   if (generateRowNumber_) {
     rowNumbers = output->children().back()->as<FlatVector<int64_t>>();
@@ -734,7 +759,7 @@ void TopNRowNumber::spill() {
 
   spiller_->spill();
   table_->clear();
-  data_->clear();
+  clearData();
   pool()->release();
 }
 
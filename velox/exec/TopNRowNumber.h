@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
@@ -70,22 +71,43 @@ class TopNRowNumber : public Operator {
 
  private:
   // A priority queue to keep track of top 'limit' rows for a given partition.
+  // The elements are rows in 'data_' or entries of 'prefixComparator' if it
+  // is set.
   struct TopRows {
     struct Compare {
       RowComparator& comparator;
+      PrefixSortRowComparator* prefixComparator;
 
       bool operator()(const char* lhs, const char* rhs) {
-        return comparator(lhs, rhs);
+        return prefixComparator != nullptr ? (*prefixComparator)(lhs, rhs)
+                                           : comparator(lhs, rhs);
       }
     };
 
     std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
         rows;
 
-    TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
+    TopRows(
+        HashStringAllocator* allocator,
+        RowComparator& comparator,
+        PrefixSortRowComparator* prefixComparator)
+        : rows{{comparator, prefixComparator}, StlAllocator<char*>(allocator)} {}
   };
 
+  // Returns the row in 'data_' for an element of TopRows::rows.
+  char* rowAt(char* element) const {
+    return prefixComparator_ != nullptr ? prefixComparator_->rowAt(element)
+                                        : element;
+  }
+
+  // Clears 'data_' along with the prefix entries of its rows.
+  void clearData() {
+    data_->clear();
+    if (prefixComparator_ != nullptr) {
+      prefixComparator_->clear();
+    }
+  }
+
   void initializeNewPartitions();
 
   TopRows& partitionAt(char* group) {
@@ -197,6 +219,11 @@ class TopNRowNumber : public Operator {
 
   RowComparator comparator_;
 
+  // Set if 'topn_prefix_sort_enabled' is true and the first sorting key can be
+  // normalized. Keeps the normalized keys of the rows in TopRows next to the
+  // row pointers.
+  std::unique_ptr<PrefixSortRowComparator> prefixComparator_;
+
   std::vector<DecodedVector> decodedVectors_;
 
   bool finished_{false};
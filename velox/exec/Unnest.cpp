@@ -114,29 +114,41 @@ RowVectorPtr Unnest::getOutput() {
   const auto maxOutputSize = outputBatchRows();
 
   // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
-  vector_size_t numInput = 0;
+  // 'maxOutputSize'. The elements of a row that do not fit are produced by the
+  // next batches.
+  RowRange range{nextInputRow_, 0, nextElement_, 0};
   vector_size_t numElements = 0;
   for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
-    ++numInput;
-
-    if (numElements >= maxOutputSize) {
+    const auto begin = range.begin(row);
+    const auto rowElements = rawMaxSizes_[row] - begin;
+    ++range.size;
+    if (numElements + rowElements >= maxOutputSize) {
+      range.lastRowEnd = begin + maxOutputSize - numElements;
+      numElements = maxOutputSize;
       break;
     }
+    numElements += rowElements;
+    range.lastRowEnd = rawMaxSizes_[row];
   }
 
   if (numElements == 0) {
     // All arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextElement_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
+  auto output = generateOutput(range, numElements);
 
-  nextInputRow_ += numInput;
+  const auto lastRow = range.start + range.size - 1;
+  if (range.lastRowEnd < rawMaxSizes_[lastRow]) {
+    nextInputRow_ = lastRow;
+    nextElement_ = range.lastRowEnd;
+  } else {
+    nextInputRow_ = lastRow + 1;
+    nextElement_ = 0;
+  }
 
   if (nextInputRow_ >= size) {
     input_ = nullptr;
@@ -147,19 +159,30 @@ RowVectorPtr Unnest::getOutput() {
 }
 
 void Unnest::generateRepeatedColumns(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements,
     std::vector<VectorPtr>& outputs) {
+  if (range.size == 1) {
+    // All the output rows come from one input row, e.g. a part of a large
+    // array. Repeat the row with a constant instead of a dictionary.
+    for (const auto& projection : identityProjections_) {
+      outputs.at(projection.outputChannel) = BaseVector::wrapInConstant(
+          numElements, range.start, input_->childAt(projection.inputChannel));
+    }
+    return;
+  }
+
   // Create "indices" buffer to repeat rows as many times as there are elements
-  // in the array (or map) in unnestDecoded.
+  // in the array (or map) in unnestDecoded. Each row is one fill, which the
+  // compiler vectorizes.
   auto repeatedIndices = allocateIndices(numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
-      rawRepeatedIndices[index++] = row;
-    }
+  for (auto row = range.start; row < range.start + range.size; ++row) {
+    const auto numRepeats =
+        range.end(row, rawMaxSizes_[row]) - range.begin(row);
+    std::fill_n(rawRepeatedIndices + index, numRepeats, row);
+    index += numRepeats;
   }
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
@@ -174,55 +197,78 @@ void Unnest::generateRepeatedColumns(
 
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
+  auto& currentDecoded = unnestDecoded_[channel];
+  auto* currentSizes = rawSizes_[channel];
+  auto* currentOffsets = rawOffsets_[channel];
+  auto* currentIndices = rawIndices_[channel];
+  const auto rangeEnd = range.start + range.size;
+
+  // The output is a slice of the elements if the elements of consecutive rows
+  // are adjacent and no row is padded with nulls.
+  bool identityMapping = true;
+  vector_size_t baseOffset = -1;
+  vector_size_t index = 0;
+  for (auto row = range.start; row < rangeEnd && identityMapping; ++row) {
+    const auto begin = range.begin(row);
+    const auto end = range.end(row, rawMaxSizes_[row]);
+    if (begin == end) {
+      continue;
+    }
+    if (currentDecoded.isNullAt(row)) {
+      identityMapping = false;
+      break;
+    }
+    const auto offset = currentOffsets[currentIndices[row]];
+    if (baseOffset < 0) {
+      baseOffset = offset + begin;
+    }
+    if (offset + begin != baseOffset + index ||
+        currentSizes[currentIndices[row]] < end) {
+      identityMapping = false;
+    }
+    index += end - begin;
+  }
+  if (identityMapping) {
+    return {nullptr, nullptr, true, baseOffset};
+  }
+
   BufferPtr elementIndices = allocateIndices(numElements, pool());
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
   auto nulls = allocateNulls(numElements, pool());
   auto rawNulls = nulls->asMutable<uint64_t>();
 
-  auto& currentDecoded = unnestDecoded_[channel];
-  auto* currentSizes = rawSizes_[channel];
-  auto* currentOffsets = rawOffsets_[channel];
-  auto* currentIndices = rawIndices_[channel];
-
   // Make dictionary index for elements column since they may be out of order.
-  vector_size_t index = 0;
-  bool identityMapping = true;
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
+  index = 0;
+  for (auto row = range.start; row < rangeEnd; ++row) {
+    const auto begin = range.begin(row);
+    const auto end = range.end(row, rawMaxSizes_[row]);
 
     if (!currentDecoded.isNullAt(row)) {
       const auto offset = currentOffsets[currentIndices[row]];
       const auto unnestSize = currentSizes[currentIndices[row]];
+      const auto valuesEnd = std::max(begin, std::min(unnestSize, end));
 
-      if (index != offset || unnestSize < maxSize) {
-        identityMapping = false;
-      }
-
-      for (auto i = 0; i < unnestSize; i++) {
-        rawElementIndices[index++] = offset + i;
-      }
-
-      for (auto i = unnestSize; i < maxSize; ++i) {
-        bits::setNull(rawNulls, index++, true);
-      }
-    } else if (maxSize > 0) {
-      identityMapping = false;
+      std::iota(
+          rawElementIndices + index,
+          rawElementIndices + index + valuesEnd - begin,
+          offset + begin);
+      index += valuesEnd - begin;
 
-      for (auto i = 0; i < maxSize; ++i) {
-        bits::setNull(rawNulls, index++, true);
-      }
+      bits::fillBits(rawNulls, index, index + end - valuesEnd, bits::kNull);
+      index += end - valuesEnd;
+    } else {
+      bits::fillBits(rawNulls, index, index + end - begin, bits::kNull);
+      index += end - begin;
     }
   }
-  return {elementIndices, nulls, identityMapping};
+  return {elementIndices, nulls, false, 0};
 }
 
 VectorPtr Unnest::generateOrdinalityVector(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
   auto ordinalityVector =
       BaseVector::create<FlatVector<int64_t>>(BIGINT(), numElements, pool());
@@ -230,27 +276,27 @@ VectorPtr Unnest::generateOrdinalityVector(
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
   auto* rawOrdinality = ordinalityVector->mutableRawValues();
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-    std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-    rawOrdinality += maxSize;
+  for (auto row = range.start; row < range.start + range.size; ++row) {
+    const auto begin = range.begin(row);
+    const auto end = range.end(row, rawMaxSizes_[row]);
+    std::iota(rawOrdinality, rawOrdinality + end - begin, begin + 1);
+    rawOrdinality += end - begin;
   }
 
   return ordinalityVector;
 }
 
 RowVectorPtr Unnest::generateOutput(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
   std::vector<VectorPtr> outputs(outputType_->size());
-  generateRepeatedColumns(start, size, numElements, outputs);
+  generateRepeatedColumns(range, numElements, outputs);
 
   // Create unnest columns.
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto unnestChannelEncoding =
-        generateEncodingForChannel(channel, start, size, numElements);
+        generateEncodingForChannel(channel, range, numElements);
 
     auto& currentDecoded = unnestDecoded_[channel];
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
@@ -272,7 +318,7 @@ RowVectorPtr Unnest::generateOutput(
 
   if (withOrdinality_) {
     // Ordinality column is always at the end.
-    outputs.back() = generateOrdinalityVector(start, size, numElements);
+    outputs.back() = generateOrdinalityVector(range, numElements);
   }
 
   return std::make_shared<RowVector>(
@@ -283,7 +329,12 @@ VectorPtr Unnest::UnnestChannelEncoding::wrap(
     const VectorPtr& base,
     vector_size_t wrapSize) const {
   if (identityMapping) {
-    return base;
+    if (baseOffset == 0 && base->size() == wrapSize) {
+      return base;
+    }
+    // A zero-copy slice is as small as the output, so it does not have the
+    // large alphabet problem of the dictionary below.
+    return base->slice(baseOffset, wrapSize);
   }
 
   const auto result =
@@ -39,28 +39,51 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
-  // Generate output for 'size' input rows starting from 'start' input row.
+  // The input rows of one output batch. The first and the last row may be
+  // produced only in part, so that a row with more elements than fit in a
+  // batch is split across batches.
+  struct RowRange {
+    // First input row.
+    vector_size_t start;
+    // Number of input rows.
+    vector_size_t size;
+    // First output element of row 'start'.
+    vector_size_t firstRowBegin;
+    // End of the output elements of row 'start + size - 1'.
+    vector_size_t lastRowEnd;
+
+    // Returns the first output element of 'row'.
+    vector_size_t begin(vector_size_t row) const {
+      return row == start ? firstRowBegin : 0;
+    }
+
+    // Returns the end of the output elements of 'row', given the number of
+    // output rows 'maxSize' of a whole 'row'.
+    vector_size_t end(vector_size_t row, vector_size_t maxSize) const {
+      return row == start + size - 1 ? lastRowEnd : maxSize;
+    }
+  };
+
+  // Generate output for the input rows of 'range'.
   //
-  // @param start First input row to include in the output.
-  // @param size Number of input rows to include in the output.
-  // @param outputSize Pre-computed number of output rows.
-  RowVectorPtr generateOutput(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t outputSize);
+  // @param range Input rows to include in the output.
+  // @param numElements Pre-computed number of output rows.
+  RowVectorPtr generateOutput(const RowRange& range, vector_size_t numElements);
 
   // Invoked by generateOutput function above to generate the repeated output
   // columns.
   void generateRepeatedColumns(
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements,
       std::vector<VectorPtr>& outputs);
 
   struct UnnestChannelEncoding {
     BufferPtr indices;
     BufferPtr nulls;
+    // True if the output is the elements at 'baseOffset' and after, in order
+    // and without nulls.
     bool identityMapping;
+    vector_size_t baseOffset;
 
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
   };
@@ -69,14 +92,12 @@ class Unnest : public Operator {
   // Array or Map.
   const UnnestChannelEncoding generateEncodingForChannel(
       column_index_t channel,
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements);
 
   // Invoked by generateOutput for the ordinality column.
   VectorPtr generateOrdinalityVector(
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements);
 
   const bool withOrdinality_;
@@ -93,5 +114,8 @@ class Unnest : public Operator {
 
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // Number of output rows of 'nextInputRow_' produced by earlier batches.
+  vector_size_t nextElement_{0};
 };
 } // namespace facebook::velox::exec
@@ -68,6 +68,176 @@ uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
     return folly::hasher<T>()(decoded.valueAt<T>(index));
   }
 }
+
+void hashDecoded(
+    DecodedVector& decoded,
+    const SelectivityVector& rows,
+    uint64_t* hashes);
+
+// Sets 'hashes[row]' to the hash of 'vector' at 'row' for 'rows'.
+void hashVector(
+    const BaseVector& vector,
+    const SelectivityVector& rows,
+    uint64_t* hashes) {
+  DecodedVector decoded(vector, rows);
+  hashDecoded(decoded, rows, hashes);
+}
+
+template <TypeKind Kind>
+void hashScalars(
+    DecodedVector& decoded,
+    const SelectivityVector& rows,
+    uint64_t* hashes) {
+  rows.applyToSelected([&](vector_size_t row) {
+    hashes[row] = decoded.isNullAt(row) ? BaseVector::kNullHash
+                                        : hashOne<Kind>(decoded, row);
+  });
+}
+
+// Returns the rows of the elements of 'rows' of an array or map vector.
+template <typename TVector>
+SelectivityVector toElementRows(
+    const TVector& vector,
+    const SelectivityVector& rows,
+    vector_size_t numElements) {
+  auto* rawOffsets = vector.rawOffsets();
+  auto* rawSizes = vector.rawSizes();
+  SelectivityVector elementRows(numElements, false);
+  rows.applyToSelected([&](vector_size_t row) {
+    elementRows.setValidRange(
+        rawOffsets[row], rawOffsets[row] + rawSizes[row], true);
+  });
+  elementRows.updateBounds();
+  return elementRows;
+}
+
+// Hashes 'elements' in 'elementRows' and mixes the hashes of the elements of
+// each of 'rows' of an array or map vector into 'hashes[row]' like
+// hashValueAt(). 'elementHashes' is scratch indexed by element.
+template <typename TVector>
+void mixElementHashes(
+    const TVector& vector,
+    const SelectivityVector& rows,
+    const BaseVector& elements,
+    const SelectivityVector& elementRows,
+    std::vector<uint64_t>& elementHashes,
+    uint64_t* hashes) {
+  if (!elementRows.hasSelections()) {
+    return;
+  }
+  elementHashes.resize(elements.size());
+  hashVector(elements, elementRows, elementHashes.data());
+  auto* rawOffsets = vector.rawOffsets();
+  auto* rawSizes = vector.rawSizes();
+  rows.applyToSelected([&](vector_size_t row) {
+    const auto offset = rawOffsets[row];
+    auto hash = hashes[row];
+    for (auto i = 0; i < rawSizes[row]; ++i) {
+      hash = bits::commutativeHashMix(hash, elementHashes[offset + i]);
+    }
+    hashes[row] = hash;
+  });
+}
+
+// Sets 'hashes[row]' to the hash of a flat ROW, ARRAY or MAP vector for its
+// non-null 'rows'. Hashes each child vector for all of 'rows' at once instead
+// of making a virtual call per element.
+void hashComplexBase(
+    const BaseVector& base,
+    const SelectivityVector& rows,
+    uint64_t* hashes) {
+  rows.applyToSelected(
+      [&](vector_size_t row) { hashes[row] = BaseVector::kNullHash; });
+  std::vector<uint64_t> childHashes;
+  switch (base.typeKind()) {
+    case TypeKind::ARRAY: {
+      auto* array = base.asUnchecked<ArrayVector>();
+      const auto& elements = *array->elements();
+      const auto elementRows = toElementRows(*array, rows, elements.size());
+      mixElementHashes(
+          *array, rows, elements, elementRows, childHashes, hashes);
+      break;
+    }
+    case TypeKind::MAP: {
+      // Keys first, then values, like MapVector::hashValueAt().
+      auto* map = base.asUnchecked<MapVector>();
+      const auto& keys = *map->mapKeys();
+      const auto& values = *map->mapValues();
+      const auto elementRows = toElementRows(*map, rows, keys.size());
+      mixElementHashes(*map, rows, keys, elementRows, childHashes, hashes);
+      mixElementHashes(*map, rows, values, elementRows, childHashes, hashes);
+      break;
+    }
+    case TypeKind::ROW: {
+      auto* row = base.asUnchecked<RowVector>();
+      bool isFirst = true;
+      for (const auto& child : row->children()) {
+        if (!child) {
+          continue;
+        }
+        childHashes.resize(child->size());
+        hashVector(*child, rows, childHashes.data());
+        rows.applyToSelected([&](vector_size_t i) {
+          hashes[i] = isFirst ? childHashes[i]
+                              : bits::hashMix(hashes[i], childHashes[i]);
+        });
+        isFirst = false;
+      }
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE(
+          "Not a complex type: {}", mapTypeKindToName(base.typeKind()));
+  }
+}
+
+// Sets 'hashes[row]' to decoded.base()->hashValueAt(decoded.index(row)) for
+// 'rows', or kNullHash for null rows, without a virtual call per value.
+void hashDecoded(
+    DecodedVector& decoded,
+    const SelectivityVector& rows,
+    uint64_t* hashes) {
+  const auto* base = decoded.base();
+  switch (base->typeKind()) {
+    case TypeKind::ROW:
+    case TypeKind::ARRAY:
+    case TypeKind::MAP: {
+      // Hashes each distinct non-null base row once.
+      SelectivityVector baseRows(base->size(), false);
+      rows.applyToSelected([&](vector_size_t row) {
+        if (!decoded.isNullAt(row)) {
+          baseRows.setValid(decoded.index(row), true);
+        }
+      });
+      baseRows.updateBounds();
+      std::vector<uint64_t> baseHashes;
+      if (baseRows.hasSelections()) {
+        baseHashes.resize(base->size());
+        hashComplexBase(*base, baseRows, baseHashes.data());
+      }
+      rows.applyToSelected([&](vector_size_t row) {
+        hashes[row] = decoded.isNullAt(row)
+            ? BaseVector::kNullHash
+            : baseHashes[decoded.index(row)];
+      });
+      break;
+    }
+    case TypeKind::UNKNOWN:
+      rows.applyToSelected(
+          [&](vector_size_t row) { hashes[row] = BaseVector::kNullHash; });
+      break;
+    case TypeKind::OPAQUE:
+      rows.applyToSelected([&](vector_size_t row) {
+        hashes[row] = decoded.isNullAt(row)
+            ? BaseVector::kNullHash
+            : base->hashValueAt(decoded.index(row));
+      });
+      break;
+    default:
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          hashScalars, base->typeKind(), decoded, rows, hashes);
+  }
+}
 } // namespace
 
 template <TypeKind Kind>
@@ -83,21 +253,33 @@ void VectorHasher::hashValues(
     rows.applyToSelected([&](vector_size_t row) {
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
+  } else if constexpr (
+      Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
+      Kind == TypeKind::MAP) {
+    if (!mix) {
+      hashDecoded(decoded_, rows, result);
+      return;
+    }
+    complexHashes_.resize(rows.end());
+    hashDecoded(decoded_, rows, complexHashes_.data());
+    rows.applyToSelected([&](vector_size_t row) {
+      result[row] = bits::hashMix(result[row], complexHashes_[row]);
+    });
   } else if (
       !decoded_.isIdentityMapping() &&
-      rows.countSelected() > decoded_.base()->size()) {
-    cachedHashes_.resize(decoded_.base()->size());
-    std::fill(cachedHashes_.begin(), cachedHashes_.end(), kNullHash);
+      cachedHashes_.prepare(
+          *decoded_.base(), rows.countSelected(), kNullHash)) {
+    auto* hashes = cachedHashes_.values.data();
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
         result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
         return;
       }
       auto baseIndex = decoded_.index(row);
-      uint64_t hash = cachedHashes_[baseIndex];
+      uint64_t hash = hashes[baseIndex];
       if (hash == kNullHash) {
         hash = hashOne<Kind>(decoded_, row);
-        cachedHashes_[baseIndex] = hash;
+        hashes[baseIndex] = hash;
       }
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
@@ -250,7 +432,7 @@ bool VectorHasher::makeValueIdsDecoded(
   auto values = decoded_.data<T>();
   bool success = true;
 
-  if (rows.countSelected() <= decoded_.base()->size()) {
+  if (!cachedValueIds_.prepare(*decoded_.base(), rows.countSelected(), 0)) {
     // Cache is not beneficial in this case and we don't use them.
     auto* nulls = decoded_.nulls(&rows);
     rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
@@ -260,9 +442,6 @@ bool VectorHasher::makeValueIdsDecoded(
     return success;
   }
 
-  cachedHashes_.resize(decoded_.base()->size());
-  std::fill(cachedHashes_.begin(), cachedHashes_.end(), 0);
-
   int numCachedHashes = 0;
   rows.testSelected([&](vector_size_t row) INLINE_LAMBDA {
     if constexpr (mayHaveNulls) {
@@ -275,7 +454,7 @@ bool VectorHasher::makeValueIdsDecoded(
     }
 
     auto baseIndex = indices[row];
-    uint64_t& id = cachedHashes_[baseIndex];
+    uint64_t& id = cachedValueIds_.values[baseIndex];
 
     if (success) {
       if (id == 0) {
@@ -296,12 +475,47 @@ bool VectorHasher::makeValueIdsDecoded(
       }
     }
 
-    return success || numCachedHashes < cachedHashes_.size();
+    return success || numCachedHashes < cachedValueIds_.values.size();
   });
 
+  if (!success) {
+    // The ids change with the mapping that is set up for the new values.
+    cachedValueIds_.release();
+  }
   return success;
 }
 
+bool VectorHasher::BaseCache::prepare(
+    const BaseVector& base,
+    vector_size_t numRows,
+    uint64_t initial) {
+  const Buffer* baseValues =
+      base.isFlatEncoding() ? base.values().get() : nullptr;
+  if (baseValues != nullptr && baseValues == valuesBase.get() &&
+      base.size() == values.size()) {
+    return true;
+  }
+  valuesBase.reset();
+  // A dictionary over a base larger than the batch is worth caching if the
+  // base repeats, as the dictionaries of a scan do within a stripe.
+  if (numRows <= base.size() &&
+      (baseValues == nullptr || baseValues != lastLargeBaseValues)) {
+    lastLargeBaseValues = baseValues;
+    return false;
+  }
+  values.resize(base.size());
+  std::fill(values.begin(), values.end(), initial);
+  if (baseValues != nullptr) {
+    valuesBase = base.values();
+  }
+  return true;
+}
+
+void VectorHasher::releaseDictionaryCaches() {
+  cachedHashes_.release();
+  cachedValueIds_.release();
+}
+
 template <>
 bool VectorHasher::makeValueIdsDecoded<bool, true>(
     const SelectivityVector& rows,
@@ -635,6 +849,7 @@ void VectorHasher::copyStringToLocal(const UniqueValue* unique) {
 }
 
 void VectorHasher::setDistinctOverflow() {
+  cachedValueIds_.release();
   distinctOverflow_ = true;
   uniqueValues_.clear();
   uniqueValuesStorage_.clear();
@@ -642,6 +857,7 @@ void VectorHasher::setDistinctOverflow() {
 }
 
 void VectorHasher::setRangeOverflow() {
+  cachedValueIds_.release();
   rangeOverflow_ = true;
   hasRange_ = false;
 }
@@ -672,6 +888,18 @@ std::unique_ptr<common::Filter> VectorHasher::getFilter(
   }
 }
 
+bool VectorHasher::hasFilter() const {
+  switch (typeKind_) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !distinctOverflow_;
+    default:
+      return false;
+  }
+}
+
 namespace {
 template <typename T>
 // Adds 'reserve' to either end of the range between 'min' and 'max' while
@@ -783,6 +1011,7 @@ void VectorHasher::cardinality(
 }
 
 uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
+  cachedValueIds_.release();
   VELOX_CHECK_NE(
       typeKind_,
       TypeKind::BOOLEAN,
@@ -800,6 +1029,7 @@ uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
 uint64_t VectorHasher::enableValueRange(
     uint64_t multiplier,
     int32_t reservePct) {
+  cachedValueIds_.release();
   multiplier_ = multiplier;
   VELOX_CHECK_LE(0, reservePct);
   VELOX_CHECK(hasRange_);
@@ -829,6 +1059,7 @@ void VectorHasher::copyStatsFrom(const VectorHasher& other) {
 }
 
 void VectorHasher::merge(const VectorHasher& other) {
+  cachedValueIds_.release();
   if (typeKind_ == TypeKind::BOOLEAN) {
     return;
   }
@@ -244,11 +244,21 @@ class VectorHasher {
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
 
+  // Returns true if getFilter() returns a filter.
+  bool hasFilter() const;
+
   void resetStats() {
+    releaseDictionaryCaches();
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
   }
 
+  // Drops the value ids and hashes kept for the dictionary base of the last
+  // input and the reference to that base. Called when the input that 'this'
+  // has seen may be freed while 'this' lives on, e.g. once a join table is
+  // built.
+  void releaseDictionaryCaches();
+
   // Sets 'this' to range mode and adds 'reservePct' values to the
   // range, half below and half above, staying within bounds of the
   // data type. In this mode, hashed values become offsets from the
@@ -547,8 +557,45 @@ class VectorHasher {
   const TypePtr type_;
   const TypeKind typeKind_;
 
+  // Values computed per index in the dictionary base of the last input, kept
+  // while the next inputs wrap the same base, as the batches of a scan do
+  // within a stripe.
+  struct BaseCache {
+    // Returns true if the values for 'base' are to be looked up in 'values'
+    // for a batch of 'numRows'. Keeps the values of the previous batch if it
+    // had the same base. Otherwise sets the values to 'initial'.
+    bool
+    prepare(const BaseVector& base, vector_size_t numRows, uint64_t initial);
+
+    void release() {
+      valuesBase.reset();
+      lastLargeBaseValues = nullptr;
+    }
+
+    raw_vector<uint64_t> values;
+
+    // The values of the flat base that 'values' is for. Null if the values
+    // are only for the last batch. Holding the buffer keeps it from being
+    // reused for other values.
+    BufferPtr valuesBase;
+
+    // The values of the last dictionary base larger than its batch. Only
+    // compared to the next base, never accessed.
+    const Buffer* lastLargeBaseValues{nullptr};
+  };
+
   DecodedVector decoded_;
-  raw_vector<uint64_t> cachedHashes_;
+
+  // Hashes by index in the dictionary base of the last input. kNullHash if
+  // not computed.
+  BaseCache cachedHashes_;
+
+  // Scratch for the hashes of complex type values to mix into the result.
+  std::vector<uint64_t> complexHashes_;
+
+  // Value ids by index in the dictionary base of the last input. 0 if not
+  // computed.
+  BaseCache cachedValueIds_;
 
   // Single precomputed hash for constant partition keys.
   uint64_t precomputedHash_{0};
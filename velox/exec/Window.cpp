@@ -42,7 +42,7 @@ Window::Window(
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (windowNode->inputsSorted()) {
     windowBuild_ = std::make_unique<StreamingWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_);
+        windowNode, pool(), spillConfig, &nonReclaimableSection_, &spillStats_);
   } else {
     windowBuild_ = std::make_unique<SortWindowBuild>(
         windowNode, pool(), spillConfig, &nonReclaimableSection_, &spillStats_);
@@ -54,6 +54,7 @@ void Window::initialize() {
   VELOX_CHECK_NOT_NULL(windowNode_);
   createWindowFunctions();
   createPeerAndFrameBuffers();
+  setupPartialPartitions();
   windowNode_.reset();
 }
 
@@ -184,6 +185,14 @@ void Window::createWindowFunctions() {
 
     windowFrames_.push_back(
         createWindowFrame(windowNode_, windowNodeFunction.frame, inputType));
+
+    const auto metadata =
+        getWindowFunctionMetadata(windowNodeFunction.functionCall->name())
+            .value_or(WindowFunction::Metadata{});
+    functionUsesFrames_.push_back(metadata.usesFrames);
+    needsPeerGroups_ |= metadata.usesPeerGroups ||
+        (metadata.usesFrames &&
+         windowFrames_.back().type == core::WindowNode::WindowType::kRange);
   }
 }
 
@@ -237,6 +246,64 @@ void Window::createPeerAndFrameBuffers() {
   }
 }
 
+void Window::setupPartialPartitions() {
+  // Partitions of sorted input are streamed. Other partitions are only
+  // partial when restored from spill.
+  if (!spillConfig_.has_value() && !windowNode_->inputsSorted()) {
+    return;
+  }
+
+  // Returns false if the bound is not a constant number of rows.
+  auto addBound = [&](core::WindowNode::BoundType boundType,
+                      const std::optional<FrameChannelArg>& bound) {
+    switch (boundType) {
+      case core::WindowNode::BoundType::kCurrentRow:
+        return true;
+      case core::WindowNode::BoundType::kPreceding:
+        if (bound->index != kConstantChannel) {
+          return false;
+        }
+        maxPrecedingRows_ =
+            std::max(maxPrecedingRows_, bound->constant.value());
+        return true;
+      case core::WindowNode::BoundType::kFollowing:
+        if (bound->index != kConstantChannel) {
+          return false;
+        }
+        maxFollowingRows_ =
+            std::max(maxFollowingRows_, bound->constant.value());
+        return true;
+      default:
+        return false;
+    }
+  };
+
+  const auto& functions = windowNode_->windowFunctions();
+  for (auto i = 0; i < functions.size(); ++i) {
+    const auto metadata =
+        getWindowFunctionMetadata(functions[i].functionCall->name());
+    if (!metadata.has_value() || !metadata->frameBoundedAccess) {
+      return;
+    }
+    if (!metadata->usesFrames) {
+      continue;
+    }
+    const auto& frame = windowFrames_[i];
+    if (frame.type != core::WindowNode::WindowType::kRows ||
+        !addBound(frame.startType, frame.start) ||
+        !addBound(frame.endType, frame.end)) {
+      return;
+    }
+  }
+
+  // Larger offsets keep most of the partition in memory anyway.
+  constexpr int64_t kMaxPartialPartitionOffset = 1 << 20;
+  if (maxPrecedingRows_ <= kMaxPartialPartitionOffset &&
+      maxFollowingRows_ <= kMaxPartialPartitionOffset) {
+    windowBuild_->enablePartialPartitions();
+  }
+}
+
 void Window::noMoreInput() {
   Operator::noMoreInput();
   windowBuild_->noMoreInput();
@@ -246,6 +313,9 @@ void Window::callResetPartition() {
   partitionOffset_ = 0;
   peerStartRow_ = 0;
   peerEndRow_ = 0;
+  if (currentPartition_ != nullptr && currentPartition_->partial()) {
+    currentPartition_->removeProcessedRows(currentPartition_->numRows());
+  }
   currentPartition_ = nullptr;
   if (windowBuild_->hasNextPartition()) {
     currentPartition_ = windowBuild_->nextPartition();
@@ -485,14 +555,25 @@ void Window::computePeerAndFrameBuffers(
     rawFrameEnds.push_back(rawFrameEnd);
   }
 
-  std::tie(peerStartRow_, peerEndRow_) = currentPartition_->computePeerBuffers(
-      startRow, endRow, peerStartRow_, peerEndRow_, rawPeerStarts, rawPeerEnds);
+  if (needsPeerGroups_) {
+    std::tie(peerStartRow_, peerEndRow_) =
+        currentPartition_->computePeerBuffers(
+            startRow,
+            endRow,
+            peerStartRow_,
+            peerEndRow_,
+            rawPeerStarts,
+            rawPeerEnds);
+  }
 
   for (auto i = 0; i < numFuncs; i++) {
     const auto& windowFrame = windowFrames_[i];
     // Default all rows to have validFrames. The invalidity of frames is only
     // computed for k rows/range frames at a later point.
     validFrames_[i].resizeFill(numRows, true);
+    if (!functionUsesFrames_[i]) {
+      continue;
+    }
     updateFrameBounds(
         windowFrame,
         true,
@@ -563,6 +644,28 @@ void Window::callApplyForPartitionRows(
   partitionOffset_ += numRows;
 }
 
+vector_size_t Window::numRowsForProcessing(vector_size_t numOutputRows) {
+  if (!currentPartition_->partial()) {
+    return currentPartition_->numRows() - partitionOffset_;
+  }
+
+  // A row can be computed once the rows up to the end of its frame are loaded.
+  // A streamed partition may not have received these rows yet.
+  if (!currentPartition_->complete()) {
+    const auto numRows = std::min<int64_t>(
+        partitionOffset_ + numOutputRows + maxFollowingRows_,
+        std::numeric_limits<vector_size_t>::max());
+    windowBuild_->loadPartialPartition(*currentPartition_, numRows);
+  }
+  if (currentPartition_->complete()) {
+    return currentPartition_->numRows() - partitionOffset_;
+  }
+  return std::clamp<int64_t>(
+      currentPartition_->numRows() - maxFollowingRows_ - partitionOffset_,
+      0,
+      numOutputRows);
+}
+
 vector_size_t Window::callApplyLoop(
     vector_size_t numOutputRows,
     const RowVectorPtr& result) {
@@ -574,9 +677,9 @@ vector_size_t Window::callApplyLoop(
   // This function requires that the currentPartition_ is available for output.
   VELOX_DCHECK_NOT_NULL(currentPartition_);
   while (numOutputRowsLeft > 0) {
-    auto rowsForCurrentPartition =
-        currentPartition_->numRows() - partitionOffset_;
-    if (rowsForCurrentPartition <= numOutputRowsLeft) {
+    auto rowsForCurrentPartition = numRowsForProcessing(numOutputRowsLeft);
+    if (rowsForCurrentPartition <= numOutputRowsLeft &&
+        currentPartition_->complete()) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
       callApplyForPartitionRows(
@@ -593,15 +696,22 @@ vector_size_t Window::callApplyLoop(
         break;
       }
     } else {
-      // Current partition can fit only partially in the output buffer.
-      // Call apply for the rows that can fit in the buffer and break from
-      // outputting.
-      callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + numOutputRowsLeft,
-          resultIndex,
-          result);
-      numOutputRowsLeft = 0;
+      // Current partition can fit only partially in the output buffer, or
+      // only some of its rows can be computed until more input is received.
+      // Call apply for these rows and break from outputting.
+      const auto numRows =
+          std::min(rowsForCurrentPartition, numOutputRowsLeft);
+      if (numRows > 0) {
+        callApplyForPartitionRows(
+            partitionOffset_, partitionOffset_ + numRows, resultIndex, result);
+      }
+      if (currentPartition_->partial()) {
+        // Frames of the rows after 'partitionOffset_' start at or after this
+        // row.
+        currentPartition_->removeProcessedRows(
+            partitionOffset_ - maxPrecedingRows_);
+      }
+      numOutputRowsLeft -= numRows;
       break;
     }
   }
@@ -634,6 +744,9 @@ RowVectorPtr Window::getOutput() {
 
   // Compute the output values of window functions.
   auto numResultRows = callApplyLoop(numOutputRows, result);
+  if (numResultRows == 0) {
+    return nullptr;
+  }
   return numResultRows < numOutputRows
       ? std::dynamic_pointer_cast<RowVector>(result->slice(0, numResultRows))
       : result;
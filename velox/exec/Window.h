@@ -101,6 +101,17 @@ class Window : public Operator {
   // indices to send in window function apply invocations.
   void createPeerAndFrameBuffers();
 
+  // Lets 'windowBuild_' stream sorted partitions or restore spilled
+  // partitions in ranges of rows if all the functions read only the rows in
+  // frames with constant ROWS offsets.
+  // Sets 'maxPrecedingRows_' and 'maxFollowingRows_' from the offsets.
+  void setupPartialPartitions();
+
+  // Returns the number of rows of 'currentPartition_' from 'partitionOffset_'
+  // that can be computed. For a partial partition, loads enough rows for
+  // the frames of up to 'numOutputRows' rows first.
+  vector_size_t numRowsForProcessing(vector_size_t numOutputRows);
+
   // Compute the peer and frame buffers for rows between
   // startRow and endRow in the current partition.
   void computePeerAndFrameBuffers(vector_size_t startRow, vector_size_t endRow);
@@ -229,6 +240,18 @@ class Window : public Operator {
   // computePeerBuffers they are saved here.
   vector_size_t peerStartRow_ = 0;
   vector_size_t peerEndRow_ = 0;
+
+  // True if a function or a frame reads the peer groups.
+  bool needsPeerGroups_{false};
+
+  // True for the functions that read their frames. The frames of the other
+  // functions are not computed.
+  std::vector<bool> functionUsesFrames_;
+
+  // The largest offsets before and after the current row of the frames of
+  // the functions. Used to bound the rows of partial partitions.
+  int64_t maxPrecedingRows_{0};
+  int64_t maxFollowingRows_{0};
 };
 
 } // namespace facebook::velox::exec
@@ -70,6 +70,23 @@ class WindowBuild {
   // if called when no partition is available.
   virtual std::unique_ptr<WindowPartition> nextPartition() = 0;
 
+  // Lets nextPartition() return partial partitions for sorted input or for
+  // rows restored from spill, so that a partition does not need to fit in
+  // memory. The Window operator enables this when all its functions read only
+  // rows in frames bounded by constant ROWS offsets.
+  void enablePartialPartitions() {
+    partialPartitionsEnabled_ = true;
+  }
+
+  // Adds rows to the partial 'partition' returned by nextPartition() until it
+  // has 'numRows' rows. Marks 'partition' complete when its last row is
+  // added.
+  virtual void loadPartialPartition(
+      WindowPartition& /*partition*/,
+      vector_size_t /*numRows*/) {
+    VELOX_UNREACHABLE("{} has no partial partitions", typeid(*this).name());
+  }
+
   // Returns the average size of input rows in bytes stored in the
   // data container of the WindowBuild.
   std::optional<int64_t> estimateRowSize() {
@@ -113,6 +130,8 @@ class WindowBuild {
 
   // Number of input rows.
   vector_size_t numRows_ = 0;
+
+  bool partialPartitionsEnabled_{false};
 };
 
 } // namespace facebook::velox::exec
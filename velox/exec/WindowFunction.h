@@ -43,6 +43,26 @@ class WindowFunction {
 
   virtual ~WindowFunction() = default;
 
+  /// Properties of a window function that the Window operator uses to plan
+  /// the processing of a partition.
+  struct Metadata {
+    /// True if the function reads only the input rows in the frames of the
+    /// rows it computes and depends neither on peer rows nor on the size of
+    /// the partition. Such a function can process a partition whose rows are
+    /// read in ranges as the frame moves.
+    bool frameBoundedAccess{false};
+
+    /// False if the function reads neither the frame bounds nor the valid
+    /// frames passed to apply(), e.g. rank, row_number and lead. The Window
+    /// operator does not compute the frames of such functions.
+    bool usesFrames{true};
+
+    /// False if the function does not read the peer groups passed to apply().
+    /// The Window operator does not compute peer groups if no function and no
+    /// RANGE frame reads them.
+    bool usesPeerGroups{true};
+  };
+
   // Row number to use in WindowPartition::extractColumn to request a NULL
   // value.
   static constexpr vector_size_t kNullRow = -1;
@@ -149,16 +169,23 @@ using WindowFunctionFactory = std::function<std::unique_ptr<WindowFunction>(
 bool registerWindowFunction(
     const std::string& name,
     std::vector<FunctionSignaturePtr> signatures,
-    WindowFunctionFactory factory);
+    WindowFunctionFactory factory,
+    WindowFunction::Metadata metadata = {});
 
 /// Returns signatures of the window function with the specified name.
 /// Returns empty std::optional if function with that name is not found.
 std::optional<std::vector<FunctionSignaturePtr>> getWindowFunctionSignatures(
     const std::string& name);
 
+/// Returns the metadata of the window function with the specified name.
+/// Returns empty std::optional if function with that name is not found.
+std::optional<WindowFunction::Metadata> getWindowFunctionMetadata(
+    const std::string& name);
+
 struct WindowFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   WindowFunctionFactory factory;
+  WindowFunction::Metadata metadata;
 };
 
 using WindowFunctionMap = std::unordered_map<std::string, WindowFunctionEntry>;
@@ -24,6 +24,8 @@ WindowPartition::WindowPartition(
     const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
     : data_(data),
       partition_(rows),
+      partial_(false),
+      complete_(true),
       inputMapping_(inputMapping),
       sortKeyInfo_(sortKeyInfo) {
   for (int i = 0; i < inputMapping_.size(); i++) {
@@ -31,11 +33,54 @@ WindowPartition::WindowPartition(
   }
 }
 
+WindowPartition::WindowPartition(
+    RowContainer* data,
+    const std::vector<column_index_t>& inputMapping,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : data_(data),
+      partial_(true),
+      complete_(false),
+      inputMapping_(inputMapping),
+      sortKeyInfo_(sortKeyInfo) {
+  for (int i = 0; i < inputMapping_.size(); i++) {
+    columns_.emplace_back(data_->columnAt(inputMapping_[i]));
+  }
+}
+
+void WindowPartition::addRows(const std::vector<char*>& rows) {
+  VELOX_CHECK(partial_);
+  VELOX_CHECK(!complete_);
+  rows_.insert(rows_.end(), rows.begin(), rows.end());
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
+void WindowPartition::removeProcessedRows(vector_size_t row) {
+  VELOX_CHECK(partial_);
+  const auto numRemoved = std::min<vector_size_t>(
+      row - startRow_, partition_.size() - (complete_ ? 0 : 1));
+  if (numRemoved <= 0) {
+    return;
+  }
+  data_->eraseRows(folly::Range(rows_.data(), numRemoved));
+  rows_.erase(rows_.begin(), rows_.begin() + numRemoved);
+  partition_ = folly::Range(rows_.data(), rows_.size());
+  startRow_ += numRemoved;
+}
+
 void WindowPartition::extractColumn(
     int32_t columnIndex,
     folly::Range<const vector_size_t*> rowNumbers,
     vector_size_t resultOffset,
     const VectorPtr& result) const {
+  if (startRow_ > 0) {
+    rowNumbers_.resize(rowNumbers.size());
+    for (auto i = 0; i < rowNumbers.size(); ++i) {
+      // Negative row numbers stand for null values and are kept as is.
+      rowNumbers_[i] =
+          rowNumbers[i] < 0 ? rowNumbers[i] : rowNumbers[i] - startRow_;
+    }
+    rowNumbers = folly::Range(rowNumbers_.data(), rowNumbers_.size());
+  }
   RowContainer::extractColumn(
       partition_.data(),
       rowNumbers,
@@ -51,7 +96,7 @@ void WindowPartition::extractColumn(
     vector_size_t resultOffset,
     const VectorPtr& result) const {
   RowContainer::extractColumn(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       resultOffset,
@@ -64,7 +109,7 @@ void WindowPartition::extractNulls(
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -162,7 +207,7 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
       peerStart = i;
       peerEnd = i;
       while (peerEnd <= lastPartitionRow) {
-        if (peerCompare(partition_[peerStart], partition_[peerEnd])) {
+        if (peerCompare(rowAt(peerStart), rowAt(peerEnd))) {
           break;
         }
         peerEnd++;
@@ -175,82 +220,61 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
   return {peerStart, peerEnd};
 }
 
-// Searches for start[frameColumn] in orderByColumn.
-// The search could return the first or last row matching start[frameColumn].
-// If a matching row is not present, then the index of the first row greater
-// than value is returned if the rows are in ascending order. For descending,
-// first row smaller than value is returned.
-// The search starts with a binary search for a starting point that is the
-// largest value < frame bound or (smallest value > frame bound for
-// descending). After finding that point it does a sequential search for the
-// required value.
 vector_size_t WindowPartition::searchFrameValue(
-    bool firstMatch,
-    vector_size_t start,
-    vector_size_t end,
+    bool afterMatches,
+    vector_size_t hint,
     vector_size_t currentRow,
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
-  vector_size_t begin = start;
-  vector_size_t finish = end;
-  while (finish - begin >= 2) {
-    auto mid = (begin + finish) / 2;
-    auto compareResult = data_->compare(
-        partition_[mid], current, orderByColumn, frameColumn, flags);
-
-    if (compareResult >= 0) {
-      // Search in the first half of the column.
-      finish = mid;
-    } else {
-      // Search in the second half of the column.
-      begin = mid;
-    }
-  }
+  auto current = rowAt(currentRow);
+  // Returns true for the rows at or after the row searched for.
+  auto isAfter = [&](vector_size_t row) {
+    const auto result = data_->compare(
+        rowAt(row), current, orderByColumn, frameColumn, flags);
+    return afterMatches ? result > 0 : result >= 0;
+  };
 
-  return linearSearchFrameValue(
-      firstMatch, begin, end, currentRow, orderByColumn, frameColumn, flags);
-}
+  const int64_t first = startRow_;
+  const int64_t last = numRows();
+  const int64_t start = std::clamp<int64_t>(hint, first, last);
 
-vector_size_t WindowPartition::linearSearchFrameValue(
-    bool firstMatch,
-    vector_size_t start,
-    vector_size_t end,
-    vector_size_t currentRow,
-    column_index_t orderByColumn,
-    column_index_t frameColumn,
-    const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
-  for (vector_size_t i = start; i < end; ++i) {
-    auto compareResult = data_->compare(
-        partition_[i], current, orderByColumn, frameColumn, flags);
-
-    // The bound value was found. Return if firstMatch required.
-    // If the last match is required, then we need to find the first row that
-    // crosses the bound and return the prior row.
-    if (compareResult == 0) {
-      if (firstMatch) {
-        return i;
+  // Gallops from 'hint' towards the row, then binary searches the range
+  // [low, high] that contains it.
+  int64_t low;
+  int64_t high;
+  int64_t step = 1;
+  if (start < last && !isAfter(start)) {
+    low = start + 1;
+    for (;;) {
+      high = std::min(start + step, last);
+      if (high == last || isAfter(high)) {
+        break;
       }
+      low = high + 1;
+      step *= 2;
     }
-
-    // Bound is crossed. Last match needs the previous row.
-    // But for first row matches, this is the first
-    // row that has crossed, but not equals boundary (The equal boundary case
-    // is covered by the condition above). So the bound matches this row itself.
-    if (compareResult > 0) {
-      if (firstMatch) {
-        return i;
-      } else {
-        return i - 1;
+  } else {
+    high = start;
+    for (;;) {
+      low = std::max(start - step, first);
+      if (low == first || !isAfter(low)) {
+        break;
       }
+      high = low;
+      step *= 2;
     }
   }
 
-  // Return a row beyond the partition boundary. The logic to determine valid
-  // frames handles the out of bound and empty frames from this value.
-  return end == numRows() ? numRows() + 1 : -1;
+  while (low < high) {
+    const auto mid = low + (high - low) / 2;
+    if (isAfter(mid)) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return low;
 }
 
 void WindowPartition::updateKRangeFrameBounds(
@@ -265,12 +289,13 @@ void WindowPartition::updateKRangeFrameBounds(
   column_index_t orderByColumn = sortKeyInfo_[0].first;
   RowColumn frameRowColumn = columns_[frameColumn];
 
-  vector_size_t start = 0;
-  vector_size_t end;
+  // The frame values of consecutive rows are usually close, so each search
+  // starts at the bound found for the previous row.
+  vector_size_t hint = startRow;
   for (auto i = 0; i < numRows; i++) {
     auto currentRow = startRow + i;
     bool frameIsNull = RowContainer::isNullAt(
-        partition_[currentRow],
+        rowAt(currentRow),
         frameRowColumn.nullByte(),
         frameRowColumn.nullMask());
 
@@ -279,24 +304,31 @@ void WindowPartition::updateKRangeFrameBounds(
     if (frameIsNull) {
       rawFrameBounds[i] = rawPeerBounds[i];
     } else {
+      // Start bounds are the first row matching the frame value, or the first
+      // row after it. End bounds are the last row matching the frame value,
+      // or the last row before it.
+      hint = searchFrameValue(
+          !firstMatch,
+          hint,
+          currentRow,
+          orderByColumn,
+          inputMapping_[frameColumn],
+          flags);
+
       // If the search is for a preceding bound then rows between
       // [0, currentRow] are examined. For following bounds, rows between
       // [currentRow, numRows()) are checked.
-      if (isPreceding) {
-        start = 0;
-        end = currentRow + 1;
+      const auto start = isPreceding ? 0 : currentRow;
+      const auto end = isPreceding ? currentRow + 1 : this->numRows();
+      if (hint >= end) {
+        // Return a row beyond the partition boundary. The logic to determine
+        // valid frames handles the out of bound and empty frames from this
+        // value.
+        rawFrameBounds[i] = end == this->numRows() ? end + 1 : -1;
       } else {
-        start = currentRow;
-        end = partition_.size();
+        const auto bound = std::max(hint, start);
+        rawFrameBounds[i] = firstMatch ? bound : bound - 1;
       }
-      rawFrameBounds[i] = searchFrameValue(
-          firstMatch,
-          start,
-          end,
-          currentRow,
-          orderByColumn,
-          inputMapping_[frameColumn],
-          flags);
     }
   }
 }
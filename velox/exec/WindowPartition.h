@@ -19,8 +19,10 @@
 #include "velox/vector/BaseVector.h"
 
 /// Simple WindowPartition that builds over the RowContainer used for storing
-/// the input rows in the Window Operator. This works completely in-memory.
-/// TODO: This implementation will be revised for Spill to disk semantics.
+/// the input rows in the Window Operator. A partition is either fully in
+/// memory or partial. A partial partition holds a moving range of its rows
+/// and is used for streaming sorted input and for restoring large spilled
+/// partitions.
 
 namespace facebook::velox::exec {
 class WindowPartition {
@@ -42,11 +44,53 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo);
 
-  /// Returns the number of rows in the current WindowPartition.
+  /// Constructs a partial WindowPartition without rows. The rows are added
+  /// with addRows() as they are read and removed with removeProcessedRows()
+  /// once no frame needs them. Rows keep their positions in the partition,
+  /// so accessors take the same row numbers as for a full partition, but
+  /// only the rows in [firstRow(), numRows()) can be accessed.
+  WindowPartition(
+      RowContainer* data,
+      const std::vector<column_index_t>& inputMapping,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  /// Returns the number of rows in the current WindowPartition. For a partial
+  /// partition, these are the rows added so far, including the removed ones.
   vector_size_t numRows() const {
-    return partition_.size();
+    return startRow_ + partition_.size();
+  }
+
+  /// Returns true for a partial partition.
+  bool partial() const {
+    return partial_;
   }
 
+  /// Returns true if all the rows of the partition have been added.
+  bool complete() const {
+    return complete_;
+  }
+
+  /// Marks a partial partition as having all its rows.
+  void setComplete() {
+    VELOX_CHECK(partial_);
+    complete_ = true;
+  }
+
+  /// Returns the first row that has not been removed.
+  vector_size_t firstRow() const {
+    return startRow_;
+  }
+
+  /// Adds 'rows' at the end of a partial partition.
+  void addRows(const std::vector<char*>& rows);
+
+  /// Erases the rows before 'row' of a partial partition from the
+  /// RowContainer. The last row is kept until the partition is complete, so
+  /// that the WindowBuild can compare it with the next input row to find the
+  /// end of the partition.
+  void removeProcessedRows(vector_size_t row);
+
   /// Copies the values at 'columnIndex' into 'result' (starting at
   /// 'resultOffset') for the rows at positions in the 'rowNumbers'
   /// array from the partition input data.
@@ -128,24 +172,21 @@ class WindowPartition {
       vector_size_t* rawFrameBounds) const;
 
  private:
+  // Returns the row at position 'row' in the partition.
+  char* rowAt(vector_size_t row) const {
+    return partition_[row - startRow_];
+  }
+
   bool compareRowsWithSortKeys(const char* lhs, const char* rhs) const;
 
-  // Searches for 'currentRow[frameColumn]' in 'orderByColumn' of rows between
-  // 'start' and 'end' in the partition. 'firstMatch' specifies if first or last
-  // row is matched.
+  // Returns the first row of the partition ordered after
+  // 'currentRow[frameColumn]' in 'orderByColumn', or the first row ordered
+  // at or after it if 'afterMatches' is false. Returns numRows() if there is
+  // no such row. The search starts at 'hint' and gallops towards the row, so
+  // it takes time logarithmic in the distance from 'hint'.
   vector_size_t searchFrameValue(
-      bool firstMatch,
-      vector_size_t start,
-      vector_size_t end,
-      vector_size_t currentRow,
-      column_index_t orderByColumn,
-      column_index_t frameColumn,
-      const CompareFlags& flags) const;
-
-  vector_size_t linearSearchFrameValue(
-      bool firstMatch,
-      vector_size_t start,
-      vector_size_t end,
+      bool afterMatches,
+      vector_size_t hint,
       vector_size_t currentRow,
       column_index_t orderByColumn,
       column_index_t frameColumn,
@@ -170,8 +211,24 @@ class WindowPartition {
   // Window operator. The pointers are to rows from a RowContainer owned
   // by the operator. We can assume these are valid values for the lifetime
   // of WindowPartition.
+  // For a partial partition, this is a range of 'rows_'.
   folly::Range<char**> partition_;
 
+  const bool partial_;
+
+  bool complete_;
+
+  // The rows of a partial partition that have not been removed.
+  std::vector<char*> rows_;
+
+  // Position in the partition of the first row in 'partition_'. Non-zero only
+  // after rows are removed from a partial partition.
+  vector_size_t startRow_{0};
+
+  // Used to map the row numbers of extractColumn() to positions in
+  // 'partition_' after rows are removed from a partial partition.
+  mutable std::vector<vector_size_t> rowNumbers_;
+
   // Mapping from window input column -> index in data_. This is required
   // because the WindowBuild reorders data_ to place partition and sort keys
   // before other columns in data_. But the Window Operator and Function code
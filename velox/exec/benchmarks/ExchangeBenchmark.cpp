@@ -41,6 +41,18 @@ DEFINE_int64(
     "task-wide buffer in local exchange");
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
+DEFINE_int32(
+    fan_in_width,
+    512,
+    "Number of producer tasks in the fan-in exchange benchmark");
+DEFINE_int32(
+    fan_in_consumers,
+    4,
+    "Number of consumer tasks in the fan-in exchange benchmark");
+DEFINE_int32(
+    wait_in_place_us,
+    200,
+    "Value of driver_blocking_wait_in_place_us in the WaitInPlace benchmarks");
 
 /// Benchmarks repartition/exchange with different batch sizes,
 /// numbers of destinations and data type mixes.  Generates a plan
@@ -64,17 +76,21 @@ struct Counters {
   int64_t exchangeNanos{0};
   int64_t exchangeRows{0};
   int64_t exchangeBatches{0};
+  // Number of times an exchange operator got unblocked while its driver waited
+  // on thread.
+  int64_t waitsInPlace{0};
 
   std::string toString() {
     if (exchangeBatches == 0) {
       return "N/A";
     }
     return fmt::format(
-        "{}/s repartition={} exchange={} exchange batch={}",
+        "{}/s repartition={} exchange={} exchange batch={} waits in place={}",
         succinctBytes(bytes / (usec / 1.0e6)),
         succinctNanos(repartitionNanos),
         succinctNanos(exchangeNanos),
-        exchangeRows / exchangeBatches);
+        exchangeRows / exchangeBatches,
+        waitsInPlace);
   }
 };
 
@@ -105,20 +121,28 @@ class ExchangeBenchmark : public VectorTestBase {
     return vectors;
   }
 
+  /// Runs 'width' producer tasks that repartition 'vectors' to
+  /// 'numConsumers' consumer tasks, 'width' if 0.
   void run(
       std::vector<RowVectorPtr>& vectors,
       int32_t width,
       int32_t taskWidth,
-      Counters& counters) {
+      Counters& counters,
+      int32_t numConsumers = 0) {
+    if (numConsumers == 0) {
+      numConsumers = width;
+    }
     assert(!vectors.empty());
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+    configSettings_[core::QueryConfig::kDriverBlockingWaitInPlaceUs] =
+        fmt::format("{}", waitInPlaceUs_);
     auto iteration = ++iteration_;
     std::vector<std::shared_ptr<Task>> tasks;
     std::vector<std::string> leafTaskIds;
     auto leafPlan = exec::test::PlanBuilder()
                         .values(vectors, true)
-                        .partitionedOutput({"c0"}, width)
+                        .partitionedOutput({"c0"}, numConsumers)
                         .planNode();
 
     auto startMicros = getCurrentTimeMicro();
@@ -139,7 +163,7 @@ class ExchangeBenchmark : public VectorTestBase {
                        .planNode();
 
     std::vector<exec::Split> finalAggSplits;
-    for (int i = 0; i < width; i++) {
+    for (int i = 0; i < numConsumers; i++) {
       auto taskId = makeTaskId(iteration, "final-agg", i);
       finalAggSplits.push_back(
           exec::Split(std::make_shared<exec::RemoteConnectorSplit>(taskId)));
@@ -168,6 +192,7 @@ class ExchangeBenchmark : public VectorTestBase {
     int64_t exchangeNanos = 0;
     int64_t exchangeBatches = 0;
     int64_t exchangeRows = 0;
+    int64_t waitsInPlace = 0;
     for (auto& task : tasks) {
       auto stats = task->taskStats();
       for (auto& pipeline : stats.pipelineStats) {
@@ -182,6 +207,13 @@ class ExchangeBenchmark : public VectorTestBase {
             exchangeNanos +=
                 op.addInputTiming.cpuNanos + op.getOutputTiming.cpuNanos;
           }
+          if (op.operatorType == "PartitionedOutput" ||
+              op.operatorType == "Exchange") {
+            auto it = op.runtimeStats.find("blockedWaitInPlaceTimes");
+            if (it != op.runtimeStats.end()) {
+              waitsInPlace += it->second.sum;
+            }
+          }
         }
       }
     }
@@ -193,6 +225,7 @@ class ExchangeBenchmark : public VectorTestBase {
     counters.exchangeNanos += exchangeNanos;
     counters.exchangeRows += exchangeRows;
     counters.exchangeBatches += exchangeBatches;
+    counters.waitsInPlace += waitsInPlace;
   }
 
   void runLocal(
@@ -236,6 +269,9 @@ class ExchangeBenchmark : public VectorTestBase {
                   .config(
                       core::QueryConfig::kMaxLocalExchangeBufferSize,
                       fmt::format("{}", FLAGS_local_exchange_buffer_mb << 20))
+                  .config(
+                      core::QueryConfig::kDriverBlockingWaitInPlaceUs,
+                      fmt::format("{}", waitInPlaceUs_))
                   .maxDrivers(taskWidth)
                   .assertResults(expected);
           {
@@ -254,6 +290,7 @@ class ExchangeBenchmark : public VectorTestBase {
     std::vector<RuntimeMetric> waitConsumer;
     std::vector<RuntimeMetric> waitProducer;
     std::vector<int64_t> wallMs;
+    int64_t waitsInPlace = 0;
     for (auto& task : tasks) {
       auto taskStats = task->taskStats();
       wallMs.push_back(
@@ -264,6 +301,7 @@ class ExchangeBenchmark : public VectorTestBase {
       waitConsumer.push_back(runtimeStats["blockedWaitForConsumerWallNanos"]);
       totalConsumer += waitConsumer.back().sum;
       totalProducer += waitProducer.back().sum;
+      waitsInPlace += runtimeStats["blockedWaitInPlaceTimes"].sum;
     }
     printMax("Producer", totalProducer, waitProducer);
     printMax("Consumer", totalConsumer, waitConsumer);
@@ -272,6 +310,12 @@ class ExchangeBenchmark : public VectorTestBase {
     std::cout << "Wall ms: " << wallMs.back() << " / "
               << wallMs[wallMs.size() / 2] << " / " << wallMs.front()
               << std::endl;
+    std::cout << "Waits in place: " << waitsInPlace << std::endl;
+  }
+
+  /// Sets QueryConfig::kDriverBlockingWaitInPlaceUs for the next runs.
+  void setWaitInPlaceUs(int32_t waitInPlaceUs) {
+    waitInPlaceUs_ = waitInPlaceUs;
   }
 
  private:
@@ -336,6 +380,7 @@ class ExchangeBenchmark : public VectorTestBase {
   }
 
   std::unordered_map<std::string, std::string> configSettings_;
+  int32_t waitInPlaceUs_{0};
   // Serial number to differentiate consecutive benchmark repeats.
   static int32_t iteration_;
 };
@@ -350,6 +395,7 @@ void runBenchmarks() {
   std::vector<RowVectorPtr> flat50;
   std::vector<RowVectorPtr> deep50;
   std::vector<RowVectorPtr> struct1k;
+  std::vector<RowVectorPtr> fanIn1k;
 
   Counters flat10kCounters;
   Counters deep10kCounters;
@@ -357,6 +403,10 @@ void runBenchmarks() {
   Counters deep50Counters;
   Counters localFlat10kCounters;
   Counters struct1kCounters;
+  Counters fanInCounters;
+  Counters flat50WaitInPlaceCounters;
+  Counters fanInWaitInPlaceCounters;
+  Counters localFlat10kWaitInPlaceCounters;
 
   std::vector<std::string> flatNames = {"c0"};
   std::vector<TypePtr> flatTypes = {BIGINT()};
@@ -416,6 +466,7 @@ void runBenchmarks() {
   flat50 = bm->makeRows(flatType, 2000, 50, FLAGS_dict_pct);
   deep50 = bm->makeRows(deepType, 2000, 50, FLAGS_dict_pct);
   struct1k = bm->makeRows(structType, 100, 1000, FLAGS_dict_pct);
+  fanIn1k = bm->makeRows(flatType, 10, 1000, FLAGS_dict_pct);
 
   folly::addBenchmark(__FILE__, "exchangeFlat10k", [&]() {
     bm->run(flat10k, FLAGS_width, FLAGS_task_width, flat10kCounters);
@@ -442,18 +493,63 @@ void runBenchmarks() {
     return 1;
   });
 
+  // Many producers of small pages feeding a few consumers. Each consumer
+  // fetches from all 'fan_in_width' producers.
+  folly::addBenchmark(__FILE__, "exchangeFanIn", [&]() {
+    bm->run(
+        fanIn1k, FLAGS_fan_in_width, 1, fanInCounters, FLAGS_fan_in_consumers);
+    return 1;
+  });
+
   folly::addBenchmark(__FILE__, "localFlat10k", [&]() {
     bm->runLocal(
         flat10k, FLAGS_width, FLAGS_num_local_tasks, localFlat10kCounters);
     return 1;
   });
 
+  // The same as above with drivers waiting on thread for their exchanges to
+  // unblock instead of going off thread.
+  folly::addBenchmark(__FILE__, "exchangeFlat50WaitInPlace", [&]() {
+    bm->setWaitInPlaceUs(FLAGS_wait_in_place_us);
+    bm->run(flat50, FLAGS_width, FLAGS_task_width, flat50WaitInPlaceCounters);
+    bm->setWaitInPlaceUs(0);
+    return 1;
+  });
+
+  folly::addBenchmark(__FILE__, "exchangeFanInWaitInPlace", [&]() {
+    bm->setWaitInPlaceUs(FLAGS_wait_in_place_us);
+    bm->run(
+        fanIn1k,
+        FLAGS_fan_in_width,
+        1,
+        fanInWaitInPlaceCounters,
+        FLAGS_fan_in_consumers);
+    bm->setWaitInPlaceUs(0);
+    return 1;
+  });
+
+  folly::addBenchmark(__FILE__, "localFlat10kWaitInPlace", [&]() {
+    bm->setWaitInPlaceUs(FLAGS_wait_in_place_us);
+    bm->runLocal(
+        flat10k,
+        FLAGS_width,
+        FLAGS_num_local_tasks,
+        localFlat10kWaitInPlaceCounters);
+    bm->setWaitInPlaceUs(0);
+    return 1;
+  });
+
   folly::runBenchmarks();
   std::cout << "flat10k: " << flat10kCounters.toString() << std::endl
             << "flat50: " << flat50Counters.toString() << std::endl
             << "deep10k: " << deep10kCounters.toString() << std::endl
             << "deep50: " << deep50Counters.toString() << std::endl
-            << "struct1k: " << struct1kCounters.toString() << std::endl;
+            << "struct1k: " << struct1kCounters.toString() << std::endl
+            << "fanIn: " << fanInCounters.toString() << std::endl
+            << "flat50WaitInPlace: " << flat50WaitInPlaceCounters.toString()
+            << std::endl
+            << "fanInWaitInPlace: " << fanInWaitInPlaceCounters.toString()
+            << std::endl;
 }
 
 } // namespace
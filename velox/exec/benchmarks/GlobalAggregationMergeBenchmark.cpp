@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+/// Benchmark for the final step of a global aggregation over the intermediate
+/// results of many partial aggregations. The KllSketch states of
+/// approx_percentile and the HyperLogLog states of approx_distinct are merged
+/// either in one driver or in several drivers with
+/// QueryConfig::kHashAggregationPartitionedMerge, where the last driver merges
+/// the accumulators of the others.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::test;
+
+namespace {
+class GlobalAggregationMergeBenchmark : public VectorTestBase {
+ public:
+  // Returns 'numStates' intermediate results of approx_percentile and
+  // approx_distinct, each over 'rowsPerState' rows.
+  std::vector<RowVectorPtr> makeStates(
+      int32_t numStates,
+      int32_t rowsPerState) {
+    const auto numRows = numStates * rowsPerState;
+    auto data = makeRowVector(
+        {makeFlatVector<int32_t>(
+             numRows, [&](auto row) { return row / rowsPerState; }),
+         makeFlatVector<double>(
+             numRows, [](auto row) { return (row * 7'919) % 1'000'003; }),
+         makeFlatVector<int64_t>(numRows, [](auto row) { return row; })});
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .partialAggregation(
+                        {"c0"},
+                        {"approx_percentile(c1, 0.5)", "approx_distinct(c2)"})
+                    .project({"a0", "a1"})
+                    .planNode();
+    auto states = AssertQueryBuilder(plan).copyResults(pool_.get());
+
+    // Splits the states into batches of 100 for the drivers to share.
+    std::vector<RowVectorPtr> batches;
+    for (vector_size_t i = 0; i < states->size(); i += 100) {
+      batches.push_back(std::static_pointer_cast<RowVector>(
+          states->slice(i, std::min<vector_size_t>(100, states->size() - i))));
+    }
+    return batches;
+  }
+
+  // Compares one driver merging 'numDrivers' copies of the states with
+  // 'numDrivers' drivers that each merge one copy.
+  void makeBenchmark(
+      const std::string& name,
+      int32_t numStates,
+      int32_t rowsPerState) {
+    const auto states = makeStates(numStates, rowsPerState);
+    const std::vector<std::string> aggregates{
+        "approx_percentile(a0)", "approx_distinct(a1)"};
+    const std::vector<std::vector<TypePtr>> rawInputTypes{
+        {DOUBLE(), DOUBLE()}, {BIGINT()}};
+    for (auto numDrivers : {4, 16}) {
+      std::vector<RowVectorPtr> allStates;
+      for (auto i = 0; i < numDrivers; ++i) {
+        allStates.insert(allStates.end(), states.begin(), states.end());
+      }
+      auto singlePlan = PlanBuilder()
+                            .values(allStates)
+                            .finalAggregation({}, aggregates, rawInputTypes)
+                            .planNode();
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format("{}_x{}_single", name, numDrivers),
+          [singlePlan, this]() {
+            AssertQueryBuilder(singlePlan).copyResults(pool_.get());
+            return 1;
+          });
+
+      auto parallelPlan = PlanBuilder()
+                              .values(states, true)
+                              .finalAggregation({}, aggregates, rawInputTypes)
+                              .planNode();
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format("{}_x{}_merge", name, numDrivers),
+          [parallelPlan, numDrivers, this]() {
+            AssertQueryBuilder(parallelPlan)
+                .config(
+                    core::QueryConfig::kHashAggregationPartitionedMerge, "true")
+                .maxDrivers(numDrivers)
+                .copyResults(pool_.get());
+            return 1;
+          });
+    }
+  }
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  GlobalAggregationMergeBenchmark bm;
+  bm.makeBenchmark("States_1K", 1'000, 1'000);
+  bm.makeBenchmark("States_10K", 10'000, 100);
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -89,7 +89,11 @@ struct HashTableBenchmarkParams {
       distStr << fmt::format("{}%:{};", dist.first, dist.second);
     }
     title = fmt::format(
-        "{},probe:{},buildDist:{}", modeString, probeSize, distStr.str());
+        "{},size:{},probe:{},buildDist:{}",
+        modeString,
+        hashTableSize,
+        probeSize,
+        distStr.str());
     if (runErase) {
       title += ",withErase";
     }
@@ -539,6 +543,18 @@ int main(int argc, char** argv) {
     }
   }
 
+  // Tables over BaseHashTable::kMinPartitionedProbeBytes, where the probes are
+  // reordered by the range of the table they hit.
+  const auto largeHashTableSize = (8L << 20) - 3;
+  for (auto mode :
+       {BaseHashTable::HashMode::kNormalizedKey,
+        BaseHashTable::HashMode::kHash}) {
+    for (auto& dist : {keyRepeatDists[0], keyRepeatDists[9]}) {
+      params.emplace_back(HashTableBenchmarkParams(
+          mode, onlyKeyType, largeHashTableSize, probeRowSize, dist, false));
+    }
+  }
+
   for (auto& param : params) {
     folly::addBenchmark(__FILE__, param.title, [param, &bm, &results]() {
       combineResults(results, bm->run(param));
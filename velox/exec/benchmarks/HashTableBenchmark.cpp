@@ -34,6 +34,12 @@ DEFINE_int32(custom_key_spacing, 1, "Spacing between key values");
 
 DEFINE_int32(custom_num_ways, 10, "Number of build threads");
 
+DEFINE_int32(
+    custom_num_keys,
+    1,
+    "Number of BIGINT key columns in custom test. 4 or more keys with a large "
+    "key spacing make a kHash mode table");
+
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::test;
@@ -83,6 +89,24 @@ struct HashTableBenchmarkParams {
   // VectorHasher.
   int32_t keySpacing{1};
 
+  // Makes the build row and the key 'numKeys' BIGINT columns. Each key
+  // column has the same values, so the number of distinct keys does not
+  // change but the combined ranges overflow 64 bits and the table falls back
+  // to kHash mode with 4 or more keys.
+  HashTableBenchmarkParams& withBigintKeys(int32_t numBigintKeys) {
+    std::vector<std::string> names;
+    for (auto i = 0; i < numBigintKeys; ++i) {
+      names.push_back(fmt::format("k{}", i + 1));
+    }
+    buildType = ROW(
+        std::move(names), std::vector<TypePtr>(numBigintKeys, BIGINT()));
+    numKeys = numBigintKeys;
+    if (numBigintKeys >= 4) {
+      mode = BaseHashTable::HashMode::kHash;
+    }
+    return *this;
+  }
+
   std::string toString() const {
     return fmt::format(
         "{}: Rows={} Hit%={} NumProbes={}",
@@ -634,14 +658,30 @@ int main(int argc, char** argv) {
       HashTableBenchmarkParams("Hit32M", 32000000, 100),
       HashTableBenchmarkParams("Miss32M", 32000000, 5),
 
-      HashTableBenchmarkParams("Hit128M", 128000000, 100)};
+      HashTableBenchmarkParams("Hit128M", 128000000, 100),
+
+      // kHash mode tables. Use --custom_size with --custom_num_keys=4 for
+      // tables of up to 1B entries.
+      HashTableBenchmarkParams("HashHit1M", 1000000, 100, 1000)
+          .withBigintKeys(4),
+      HashTableBenchmarkParams("HashMiss1M", 1000000, 5, 1000)
+          .withBigintKeys(4),
+
+      HashTableBenchmarkParams("HashHit16M", 16000000, 100, 1000)
+          .withBigintKeys(4),
+      HashTableBenchmarkParams("HashMiss16M", 16000000, 5, 1000)
+          .withBigintKeys(4),
+
+      HashTableBenchmarkParams("HashHit64M", 64000000, 100, 1000)
+          .withBigintKeys(4)};
   if (FLAGS_custom_size != 0) {
     params.push_back(HashTableBenchmarkParams(
-        "Custom",
-        FLAGS_custom_size,
-        FLAGS_custom_hit_rate,
-        FLAGS_custom_key_spacing,
-        FLAGS_custom_num_ways));
+                         "Custom",
+                         FLAGS_custom_size,
+                         FLAGS_custom_hit_rate,
+                         FLAGS_custom_key_spacing,
+                         FLAGS_custom_num_ways)
+                         .withBigintKeys(FLAGS_custom_num_keys));
   }
 
   for (auto& param : params) {
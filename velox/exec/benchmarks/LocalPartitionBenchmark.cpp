@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+/// Benchmark for hash partitioning in a local exchange. The input is
+/// repartitioned on a bigint key into as many partitions as there are drivers
+/// and counted by a final aggregation in each driver. Compares flat and
+/// dictionary encoded inputs with small and large batches.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+class LocalPartitionBenchmark : public VectorTestBase {
+ public:
+  std::vector<RowVectorPtr> makeRows(
+      int32_t numVectors,
+      int32_t rowsPerVector,
+      bool dictionary) {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < numVectors; ++i) {
+      std::vector<VectorPtr> children = {
+          makeFlatVector<int64_t>(
+              rowsPerVector, [&](auto row) { return row * 7 + i; }),
+          makeFlatVector<int64_t>(rowsPerVector, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              rowsPerVector,
+              [](auto row) { return fmt::format("value-{}", row % 1'000); }),
+      };
+      if (dictionary) {
+        auto indices = makeIndicesInReverse(rowsPerVector);
+        for (auto& child : children) {
+          child = BaseVector::wrapInDictionary(
+              nullptr, indices, rowsPerVector, child);
+        }
+      }
+      vectors.push_back(makeRowVector(children));
+    }
+    return vectors;
+  }
+
+  void makeBenchmark(
+      const std::string& name,
+      int32_t numVectors,
+      int32_t rowsPerVector,
+      bool dictionary) {
+    auto rows = makeRows(numVectors, rowsPerVector, dictionary);
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .localPartition(
+                        {"c0"},
+                        {PlanBuilder(planNodeIdGenerator)
+                             .values(rows, true)
+                             .planNode()})
+                    .singleAggregation({}, {"count(1)", "max(c2)"})
+                    .planNode();
+    for (auto numDrivers : {2, 8, 32}) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format("{}_{}", name, numDrivers),
+          [plan, numDrivers, this]() {
+            AssertQueryBuilder(plan)
+                .maxDrivers(numDrivers)
+                .copyResults(pool_.get());
+            return 1;
+          });
+    }
+  }
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  LocalPartitionBenchmark bm;
+  bm.makeBenchmark("Flat_10K", 20, 10'000, false);
+  bm.makeBenchmark("Flat_100", 200, 100, false);
+  bm.makeBenchmark("Dict_10K", 20, 10'000, true);
+  bm.makeBenchmark("Dict_100", 200, 100, true);
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -15,6 +15,8 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
 #include <folly/init/Init.h>
 
 #include <gflags/gflags.h>
@@ -28,6 +30,42 @@ using namespace facebook::velox::exec::test;
 TestData narrow;
 TestData medium;
 TestData wide;
+std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+
+// Merges 'testData' in two levels like SpillPartition::mergeFiles(). Groups of
+// 'fanIn' sources are merged into new sources in parallel on 'executor' and
+// the merged sources are merged on the calling thread.
+void twoLevelMerge(const TestData& testData, int32_t fanIn) {
+  std::vector<folly::SemiFuture<std::unique_ptr<TestingStream>>> groups;
+  for (size_t start = 0; start < testData.sources.size(); start += fanIn) {
+    const auto end = std::min<size_t>(start + fanIn, testData.sources.size());
+    groups.push_back(
+        folly::via(executor.get(), [&testData, start, end]() {
+          std::vector<std::unique_ptr<TestingStream>> sources;
+          for (auto i = start; i < end; ++i) {
+            sources.push_back(
+                std::make_unique<TestingStream>(*testData.sources[i]));
+          }
+          TreeOfLosers<TestingStream> merge(std::move(sources));
+          std::vector<uint32_t> numbers;
+          while (auto* source = merge.next()) {
+            numbers.push_back(source->current()->value());
+            source->pop();
+          }
+          // TestingStream takes its values in descending order.
+          std::reverse(numbers.begin(), numbers.end());
+          return std::make_unique<TestingStream>(std::move(numbers));
+        }).semi());
+  }
+  std::vector<std::unique_ptr<TestingStream>> sources;
+  for (auto& group : groups) {
+    sources.push_back(std::move(group).get());
+  }
+  TreeOfLosers<TestingStream> merge(std::move(sources));
+  while (auto* source = merge.next()) {
+    source->pop();
+  }
+}
 
 BENCHMARK(narrowTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(narrow, false);
@@ -53,6 +91,10 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+BENCHMARK_RELATIVE(wideTwoLevel) {
+  twoLevelMerge(wide, 32);
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -61,6 +103,8 @@ int main(int argc, char* argv[]) {
   narrow = test.makeTestData(100'000'000, 7);
   medium = test.makeTestData(10'000'0000, 37);
   wide = test.makeTestData(10'000'0000, 1029);
+  executor = std::make_unique<folly::CPUThreadPoolExecutor>(
+      std::thread::hardware_concurrency());
   folly::runBenchmarks();
   return 0;
 }
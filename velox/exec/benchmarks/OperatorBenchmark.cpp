@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/String.h>
+#include <folly/hash/Hash.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <gflags/gflags.h>
+#include <fstream>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+
+DEFINE_int64(rows, 1'000'000, "Number of input rows of each benchmark");
+DEFINE_string(
+    cardinalities,
+    "1000,1000000",
+    "Comma separated numbers of distinct keys of the input");
+DEFINE_string(
+    null_ratios,
+    "0,0.2",
+    "Comma separated fractions of null keys and values of the input");
+DEFINE_bool(
+    skew,
+    true,
+    "Also run each benchmark on skewed keys, where 80% of the rows have 1% "
+    "of the keys");
+DEFINE_string(
+    operators,
+    "scan,filter,project,agg,join,sort,window,exchange",
+    "Comma separated operators to benchmark");
+DEFINE_int32(repeats, 3, "Number of runs of each benchmark");
+DEFINE_int32(num_drivers, 4, "Number of drivers of the parallel pipelines");
+DEFINE_string(
+    json_output,
+    "",
+    "File to write the results to. The results are printed to stdout if "
+    "empty");
+
+/// Runs microbenchmarks of the scan, filter, project, aggregation, join,
+/// sort, window and exchange operators over generated data of different key
+/// cardinality, key skew and null ratio, and reports the wall time, CPU time,
+/// peak memory and number of memory allocations of each as JSON. Each
+/// benchmark is run --repeats times and the run with the lowest wall time is
+/// reported, so that results of different builds can be compared to gate
+/// changes on performance.
+///
+/// The input has a BIGINT key 'k', a VARCHAR 's' derived from 'k' and too
+/// long to be inlined, a DOUBLE 'v' and an INTEGER 'n' in [0, 1000). 'k',
+/// 's' and 'v' are null at the null ratio. The join builds on a table with
+/// one row per key.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+struct DataSpec {
+  int64_t cardinality;
+  bool skewed;
+  double nullRatio;
+
+  std::string toString() const {
+    return fmt::format(
+        "card_{}{}_nulls_{}",
+        cardinality,
+        skewed ? "_skewed" : "",
+        static_cast<int32_t>(nullRatio * 100));
+  }
+};
+
+struct RunStats {
+  uint64_t wallMicros{0};
+  uint64_t cpuMicros{0};
+  uint64_t peakMemoryBytes{0};
+  uint64_t numMemoryAllocations{0};
+  uint64_t outputRows{0};
+};
+
+template <typename T>
+std::vector<T> parseList(const std::string& list) {
+  std::vector<T> values;
+  folly::split(',', list, values);
+  return values;
+}
+
+class OperatorBenchmark : public HiveConnectorTestBase {
+ public:
+  OperatorBenchmark() {
+    HiveConnectorTestBase::SetUp();
+    window::prestosql::registerAllWindowFunctions();
+  }
+
+  ~OperatorBenchmark() override {
+    HiveConnectorTestBase::TearDown();
+  }
+
+  void TestBody() override {}
+
+  // Runs the benchmarks of 'operators' on data generated as per 'spec' and
+  // appends their results to 'results'.
+  void run(
+      const DataSpec& spec,
+      const std::vector<std::string>& operators,
+      folly::dynamic& results) {
+    const auto data = makeData(spec);
+    std::shared_ptr<TempFilePath> file;
+    for (const auto& name : operators) {
+      core::PlanNodeId scanId;
+      core::PlanNodePtr plan;
+      int32_t numDrivers = 1;
+      if (name == "scan") {
+        if (!file) {
+          file = TempFilePath::create();
+          writeToFile(file->getPath(), data);
+        }
+        plan = PlanBuilder()
+                   .tableScan(asRowType(data[0]->type()))
+                   .capturePlanNodeId(scanId)
+                   .planNode();
+      } else if (name == "filter") {
+        plan = PlanBuilder().values(data).filter("n < 500").planNode();
+      } else if (name == "project") {
+        plan = PlanBuilder()
+                   .values(data)
+                   .project(
+                       {"k * 7 + n AS a",
+                        "v * 2.5 AS b",
+                        "concat(s, '-suffix') AS c"})
+                   .planNode();
+      } else if (name == "agg") {
+        plan = PlanBuilder()
+                   .values(data)
+                   .singleAggregation({"k"}, {"sum(v)", "count(s)"})
+                   .planNode();
+      } else if (name == "join") {
+        auto planNodeIdGenerator =
+            std::make_shared<core::PlanNodeIdGenerator>();
+        plan = PlanBuilder(planNodeIdGenerator)
+                   .values(data)
+                   .hashJoin(
+                       {"k"},
+                       {"b_k"},
+                       PlanBuilder(planNodeIdGenerator)
+                           .values(makeBuildData(spec.cardinality))
+                           .planNode(),
+                       "",
+                       {"k", "v", "b_w"})
+                   .planNode();
+      } else if (name == "sort") {
+        plan = PlanBuilder().values(data).orderBy({"k", "v"}, false).planNode();
+      } else if (name == "window") {
+        plan = PlanBuilder()
+                   .values(data)
+                   .window({"sum(v) over (partition by k order by n)"})
+                   .planNode();
+      } else if (name == "exchange") {
+        plan = PlanBuilder().values(data).localPartition({"k"}).planNode();
+        numDrivers = FLAGS_num_drivers;
+      } else {
+        VELOX_USER_FAIL("Unknown operator to benchmark: {}", name);
+      }
+
+      std::optional<RunStats> best;
+      for (auto i = 0; i < FLAGS_repeats; ++i) {
+        auto stats = runPlan(plan, numDrivers, scanId, file);
+        if (!best.has_value() || stats.wallMicros < best->wallMicros) {
+          best = stats;
+        }
+      }
+
+      folly::dynamic result = folly::dynamic::object;
+      result["name"] = fmt::format("{}/{}", name, spec.toString());
+      result["operator"] = name;
+      result["rows"] = FLAGS_rows;
+      result["cardinality"] = spec.cardinality;
+      result["skewed"] = spec.skewed;
+      result["nullRatio"] = spec.nullRatio;
+      result["drivers"] = numDrivers;
+      result["wallMicros"] = best->wallMicros;
+      result["cpuMicros"] = best->cpuMicros;
+      result["peakMemoryBytes"] = best->peakMemoryBytes;
+      result["numMemoryAllocations"] = best->numMemoryAllocations;
+      result["outputRows"] = best->outputRows;
+      LOG(INFO) << result["name"].asString() << ": "
+                << succinctMicros(best->wallMicros);
+      results.push_back(std::move(result));
+    }
+  }
+
+ private:
+  static constexpr vector_size_t kBatchSize = 10'000;
+
+  std::vector<RowVectorPtr> makeData(const DataSpec& spec) {
+    // Hot keys of skewed data.
+    const auto numHotKeys = std::max<int64_t>(1, spec.cardinality / 100);
+    const auto nullThreshold = static_cast<uint64_t>(spec.nullRatio * 1'000);
+    std::vector<RowVectorPtr> vectors;
+    for (int64_t firstRow = 0; firstRow < FLAGS_rows; firstRow += kBatchSize) {
+      const auto size = std::min<int64_t>(kBatchSize, FLAGS_rows - firstRow);
+      std::vector<uint64_t> hashes(size);
+      std::vector<int64_t> keys(size);
+      for (auto i = 0; i < size; ++i) {
+        hashes[i] = folly::hash::twang_mix64(firstRow + i);
+        const auto random = hashes[i] >> 8;
+        keys[i] = spec.skewed && hashes[i] % 100 < 80
+            ? random % numHotKeys
+            : random % spec.cardinality;
+      }
+      auto isNull = [&](auto row) {
+        return (hashes[row] >> 40) % 1'000 < nullThreshold;
+      };
+      vectors.push_back(makeRowVector(
+          {"k", "s", "v", "n"},
+          {makeFlatVector<int64_t>(
+               size, [&](auto row) { return keys[row]; }, isNull),
+           makeFlatVector<std::string>(
+               size,
+               [&](auto row) { return fmt::format("key-value-{}", keys[row]); },
+               isNull),
+           makeFlatVector<double>(
+               size,
+               [&](auto row) { return (hashes[row] >> 12) % 10'000 / 100.0; },
+               [&](auto row) {
+                 return (hashes[row] >> 24) % 1'000 < nullThreshold;
+               }),
+           makeFlatVector<int32_t>(
+               size, [&](auto row) { return (hashes[row] >> 20) % 1'000; })}));
+    }
+    return vectors;
+  }
+
+  // Returns one row per key in [0, cardinality).
+  std::vector<RowVectorPtr> makeBuildData(int64_t cardinality) {
+    std::vector<RowVectorPtr> vectors;
+    for (int64_t first = 0; first < cardinality; first += kBatchSize) {
+      const auto size = std::min<int64_t>(kBatchSize, cardinality - first);
+      vectors.push_back(makeRowVector(
+          {"b_k", "b_w"},
+          {makeFlatVector<int64_t>(
+               size, [&](auto row) { return first + row; }),
+           makeFlatVector<int64_t>(
+               size, [&](auto row) { return (first + row) * 3; })}));
+    }
+    return vectors;
+  }
+
+  RunStats runPlan(
+      const core::PlanNodePtr& plan,
+      int32_t numDrivers,
+      const core::PlanNodeId& scanId,
+      const std::shared_ptr<TempFilePath>& file) {
+    CursorParameters params;
+    params.planNode = plan;
+    params.maxDrivers = numDrivers;
+
+    RunStats stats;
+    std::shared_ptr<Task> task;
+    {
+      MicrosecondTimer timer(&stats.wallMicros);
+      auto cursor = TaskCursor::create(params);
+      task = cursor->task();
+      if (!scanId.empty()) {
+        task->addSplit(
+            scanId, Split(makeHiveConnectorSplit(file->getPath())));
+        task->noMoreSplits(scanId);
+      }
+      while (cursor->moveNext()) {
+        stats.outputRows += cursor->current()->size();
+      }
+      VELOX_CHECK(waitForTaskCompletion(task.get()));
+    }
+
+    const auto taskStats = task->taskStats();
+    for (const auto& [_, nodeStats] : toPlanStats(taskStats)) {
+      stats.cpuMicros += nodeStats.cpuWallTiming.cpuNanos / 1'000;
+      stats.numMemoryAllocations += nodeStats.numMemoryAllocations;
+    }
+    stats.peakMemoryBytes = task->pool()->peakBytes();
+    return stats;
+  }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  OperatorTestBase::SetUpTestCase();
+
+  const auto operators = parseList<std::string>(FLAGS_operators);
+  folly::dynamic results = folly::dynamic::array;
+  {
+    OperatorBenchmark benchmark;
+    for (const auto cardinality : parseList<int64_t>(FLAGS_cardinalities)) {
+      for (const auto nullRatio : parseList<double>(FLAGS_null_ratios)) {
+        for (const auto skewed : {false, true}) {
+          if (skewed && !FLAGS_skew) {
+            continue;
+          }
+          benchmark.run({cardinality, skewed, nullRatio}, operators, results);
+        }
+      }
+    }
+  }
+  OperatorTestBase::TearDownTestCase();
+
+  const auto json = folly::toPrettyJson(results);
+  if (FLAGS_json_output.empty()) {
+    std::cout << json << std::endl;
+  } else {
+    std::ofstream out(FLAGS_json_output);
+    out << json << std::endl;
+  }
+  return 0;
+}
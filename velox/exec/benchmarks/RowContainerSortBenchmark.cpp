@@ -156,6 +156,37 @@ void rowContainerTimSortBenchmark(uint32_t iterations, size_t cardinality) {
   }
 }
 
+template <typename T>
+void rowContainerKeyComparatorSortBenchmark(
+    uint32_t iterations,
+    size_t cardinality) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::memoryManager()->addLeafPool();
+  VectorMaker vectorMaker(pool.get());
+
+  for (size_t k = 0; k < iterations; ++k) {
+    auto data =
+        genTestData<T>(cardinality, CppToType<T>::create(), true, false, false);
+    auto vector =
+        vectorMaker.encodedVector<T>(VectorEncoding::Simple::FLAT, data.data());
+    DecodedVector decoded(*vector);
+    std::vector<TypePtr> types{vector->type()};
+    auto rowContainer =
+        std::make_unique<velox::exec::RowContainer>(types, pool.get());
+    int size = vector->size();
+    auto rows = store(*rowContainer, decoded, size);
+    suspender.dismiss();
+    velox::exec::SortKeyComparator comparator(
+        rowContainer.get(), std::vector<CompareFlags>{});
+    comparator.sort(
+        folly::Range<char**>(rows.data(), rows.size()),
+        [](auto begin, auto end, const auto& less) {
+          std::sort(begin, end, less);
+        });
+    suspender.rehire();
+  }
+}
+
 void BM_Int64_stdSort(uint32_t iterations, size_t cardinality) {
   rowContainerStdSortBenchmark<int64_t>(iterations, cardinality);
 }
@@ -164,6 +195,10 @@ void BM_Int64_timSort(uint32_t iterations, size_t cardinality) {
   rowContainerTimSortBenchmark<int64_t>(iterations, cardinality);
 }
 
+void BM_Int64_keyComparatorSort(uint32_t iterations, size_t cardinality) {
+  rowContainerKeyComparatorSortBenchmark<int64_t>(iterations, cardinality);
+}
+
 void BM_STR_stdSort(uint32_t iterations) {
   folly::BenchmarkSuspender suspender;
   auto pool = memory::memoryManager()->addLeafPool();
@@ -213,22 +248,63 @@ void BM_STR_timSort(uint32_t iterations) {
     suspender.rehire();
   }
 }
+
+void BM_STR_keyComparatorSort(uint32_t iterations) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::memoryManager()->addLeafPool();
+  VectorMaker vectorMaker(pool.get());
+  auto data = getDataFromFile();
+  auto vector =
+      vectorMaker.encodedVector<StringView>(VectorEncoding::Simple::FLAT, data);
+  DecodedVector decoded(*vector);
+  std::vector<TypePtr> types{vector->type()};
+  auto rowContainer =
+      std::make_unique<velox::exec::RowContainer>(types, pool.get());
+  int size = vector->size();
+  auto rows = store(*rowContainer, decoded, size);
+  velox::exec::SortKeyComparator comparator(
+      rowContainer.get(), std::vector<CompareFlags>{});
+  for (size_t k = 0; k < iterations; ++k) {
+    suspender.dismiss();
+    comparator.sort(
+        folly::Range<char**>(rows.data(), rows.size()),
+        [](auto begin, auto end, const auto& less) {
+          std::sort(begin, end, less);
+        });
+    suspender.rehire();
+  }
+}
 } // namespace
 
 BENCHMARK_NAMED_PARAM(BM_Int64_stdSort, 100k_uni_noseq, 100000);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_Int64_timSort, 100k_uni_noseq, 100000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    BM_Int64_keyComparatorSort,
+    100k_uni_noseq,
+    100000);
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK_NAMED_PARAM(BM_Int64_stdSort, 10k_uni_noseq, 10000);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_Int64_timSort, 10k_uni_noseq, 10000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    BM_Int64_keyComparatorSort,
+    10k_uni_noseq,
+    10000);
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK_NAMED_PARAM(BM_Int64_stdSort, 1k_uni_noseq, 1000);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_Int64_timSort, 1k_uni_noseq, 1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    BM_Int64_keyComparatorSort,
+    1k_uni_noseq,
+    1000);
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK_NAMED_PARAM(BM_STR_stdSort, RealWorldData_stdSort);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_STR_timSort, RealWorldData_timSort);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    BM_STR_keyComparatorSort,
+    RealWorldData_keyComparatorSort);
 BENCHMARK_DRAW_LINE();
 } // namespace facebook::velox::test
 
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+/// Benchmark for the Window operator over input sorted on the partition and
+/// order by keys. Compares ranking functions, aggregates over ROWS frames and
+/// aggregates over k RANGE frames, whose bounds are found by searching the
+/// order by column of the partition. Partitions are either small or span all
+/// 1M rows of the input.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::test;
+
+namespace {
+class WindowBenchmark : public VectorTestBase {
+ public:
+  // Returns 'numVectors' vectors of 10K rows sorted on partition key 'p' and
+  // order by key 's'. Each partition has 'partitionRows' rows. 's' has runs
+  // of 4 equal values.
+  std::vector<RowVectorPtr> makeData(
+      int32_t numVectors,
+      int64_t partitionRows) {
+    constexpr vector_size_t kVectorRows = 10'000;
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < numVectors; ++i) {
+      const int64_t firstRow = i * kVectorRows;
+      vectors.push_back(makeRowVector(
+          {"p", "s", "d"},
+          {makeFlatVector<int64_t>(
+               kVectorRows,
+               [&](auto row) { return (firstRow + row) / partitionRows; }),
+           makeFlatVector<int64_t>(
+               kVectorRows,
+               [&](auto row) { return (firstRow + row) % partitionRows / 4; }),
+           makeFlatVector<double>(
+               kVectorRows, [&](auto row) { return (firstRow + row) % 97; })}));
+    }
+    return vectors;
+  }
+
+  void makeBenchmark(const std::string& name, int64_t partitionRows) {
+    auto data = makeData(100, partitionRows);
+    const std::string over = "over (partition by p order by s";
+    addBenchmark(name + "_rank", data, {"rank() " + over + ")"});
+    addBenchmark(
+        name + "_rows",
+        data,
+        {"sum(d) " + over + " rows between 100 preceding and current row)"});
+    addBenchmark(
+        name + "_range",
+        data,
+        {"sum(d) " + over + " range between lo preceding and current row)"},
+        {"s - 25 AS lo"});
+    addBenchmark(
+        name + "_range_following",
+        data,
+        {"min(d) " + over + " range between lo preceding and hi following)"},
+        {"s - 2 AS lo", "s + 2 AS hi"});
+  }
+
+ private:
+  void addBenchmark(
+      const std::string& name,
+      const std::vector<RowVectorPtr>& data,
+      const std::vector<std::string>& functions,
+      const std::vector<std::string>& boundColumns = {}) {
+    std::vector<std::string> projections = {"p", "s", "d"};
+    projections.insert(
+        projections.end(), boundColumns.begin(), boundColumns.end());
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .project(projections)
+                    .streamingWindow(functions)
+                    .planNode();
+    folly::addBenchmark(__FILE__, name, [plan, this]() {
+      AssertQueryBuilder(plan).copyResults(pool_.get());
+      return 1;
+    });
+  }
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  window::prestosql::registerAllWindowFunctions();
+  parse::registerTypeResolver();
+
+  WindowBenchmark bm;
+  bm.makeBenchmark("Partitions_1K", 1'000);
+  bm.makeBenchmark("Partitions_1M", 1'000'000);
+
+  folly::runBenchmarks();
+  return 0;
+}
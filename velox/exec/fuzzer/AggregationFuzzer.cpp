@@ -470,6 +470,7 @@ void AggregationFuzzer::go() {
   stats_.print(iteration);
 
   printSignatureStats();
+  printPerformanceStats();
 }
 
 void makeAlternativePlansWithValues(
@@ -17,10 +17,12 @@
 
 #include <boost/random/uniform_int_distribution.hpp>
 #include "velox/common/base/Fs.h"
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/base/VeloxException.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/fuzzer/DuckQueryRunner.h"
 #include "velox/exec/fuzzer/PrestoQueryRunner.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
@@ -85,6 +87,34 @@ DEFINE_bool(
     "up after failures. Therefore, results are not compared when this is "
     "enabled. Note that this option only works in debug builds.");
 
+DEFINE_bool(
+    performance_mode,
+    false,
+    "When enabled, each generated plan is also executed with alternative "
+    "execution paths (spilling, hash mode hash tables and std::sort instead "
+    "of prefix sort) and the paths whose CPU time is abnormally different "
+    "from the default path are reported as performance anomalies.");
+
+DEFINE_double(
+    performance_anomaly_ratio,
+    10,
+    "Ratio of the CPU time of an alternative execution path to the CPU time "
+    "of the default path above which --performance_mode reports an "
+    "anomaly.");
+
+DEFINE_int32(
+    performance_anomaly_min_cpu_ms,
+    10,
+    "Plans whose CPU time is below this on all execution paths are not "
+    "reported as performance anomalies by --performance_mode, as their "
+    "timings are dominated by noise.");
+
+DEFINE_int32(
+    performance_repeats,
+    3,
+    "Number of times --performance_mode executes each plan on each path. "
+    "The lowest CPU time and peak memory are used.");
+
 namespace facebook::velox::exec::test {
 
 int32_t AggregationFuzzerBase::randInt(int32_t min, int32_t max) {
@@ -406,7 +436,9 @@ velox::fuzzer::ResultOrError AggregationFuzzerBase::execute(
     const std::vector<exec::Split>& splits,
     bool injectSpill,
     bool abandonPartial,
-    int32_t maxDrivers) {
+    int32_t maxDrivers,
+    const std::unordered_map<std::string, std::string>& extraConfigs,
+    ExecutionStats* executionStats) {
   LOG(INFO) << "Executing query plan: " << std::endl
             << plan->toString(true, true);
 
@@ -416,6 +448,7 @@ velox::fuzzer::ResultOrError AggregationFuzzerBase::execute(
     AssertQueryBuilder builder(plan);
 
     builder.configs(queryConfigs_);
+    builder.configs(extraConfigs);
 
     int32_t spillPct{0};
     if (injectSpill) {
@@ -447,8 +480,16 @@ velox::fuzzer::ResultOrError AggregationFuzzerBase::execute(
     }
 
     TestScopedSpillInjection scopedSpillInjection(spillPct);
+    std::shared_ptr<Task> task;
     resultOrError.result =
-        builder.maxDrivers(maxDrivers).copyResults(pool_.get());
+        builder.maxDrivers(maxDrivers).copyResults(pool_.get(), task);
+    if (executionStats != nullptr) {
+      executionStats->cpuNanos = 0;
+      for (const auto& [_, stats] : toPlanStats(task->taskStats())) {
+        executionStats->cpuNanos += stats.cpuWallTiming.cpuNanos;
+      }
+      executionStats->peakMemoryBytes = task->pool()->peakBytes();
+    }
   } catch (VeloxUserError&) {
     // NOTE: velox user exception is accepted as it is caused by the invalid
     // fuzzer test inputs.
@@ -535,6 +576,123 @@ void AggregationFuzzerBase::testPlan(
       abandonPartial,
       maxDrivers);
   compare(actual, customVerification, customVerifiers, expected);
+
+  if (FLAGS_performance_mode && !injectSpill && !abandonPartial) {
+    testPerformance(planWithSplits, maxDrivers);
+  }
+}
+
+std::optional<AggregationFuzzerBase::ExecutionStats>
+AggregationFuzzerBase::measure(
+    const PlanWithSplits& planWithSplits,
+    bool injectSpill,
+    const std::unordered_map<std::string, std::string>& extraConfigs,
+    int32_t maxDrivers) {
+  std::optional<ExecutionStats> best;
+  for (auto i = 0; i < FLAGS_performance_repeats; ++i) {
+    ExecutionStats stats;
+    auto resultOrError = execute(
+        planWithSplits.plan,
+        planWithSplits.splits,
+        injectSpill,
+        false /*abandonPartial*/,
+        maxDrivers,
+        extraConfigs,
+        &stats);
+    if (resultOrError.exceptionPtr) {
+      return std::nullopt;
+    }
+    if (!best.has_value()) {
+      best = stats;
+      continue;
+    }
+    best->cpuNanos = std::min(best->cpuNanos, stats.cpuNanos);
+    best->peakMemoryBytes =
+        std::min(best->peakMemoryBytes, stats.peakMemoryBytes);
+  }
+  return best;
+}
+
+void AggregationFuzzerBase::testPerformance(
+    const PlanWithSplits& planWithSplits,
+    int32_t maxDrivers) {
+  struct Alternative {
+    std::string name;
+    bool injectSpill;
+    std::unordered_map<std::string, std::string> configs;
+    // True if the path is expected to be about as fast as the default path,
+    // in which case being much faster than the default is an anomaly too.
+    bool similarCost;
+  };
+  static const std::vector<Alternative> kAlternatives = {
+      {"spilling", true, {}, false},
+      {"hash mode",
+       false,
+       {{core::QueryConfig::kHashAdaptivityEnabled, "false"}},
+       true},
+      {"std::sort",
+       false,
+       {{core::QueryConfig::kPrefixSortNormalizedKeyMaxBytes, "0"}},
+       true},
+  };
+
+  if (FLAGS_enable_oom_injection) {
+    return;
+  }
+
+  LOG(INFO) << "Measuring performance of the execution paths";
+  const auto baseline = measure(planWithSplits, false, {}, maxDrivers);
+  if (!baseline.has_value()) {
+    return;
+  }
+  ++numPerformanceTested_;
+
+  const uint64_t minCpuNanos =
+      FLAGS_performance_anomaly_min_cpu_ms * 1'000'000UL;
+  for (const auto& alternative : kAlternatives) {
+    const auto stats = measure(
+        planWithSplits,
+        alternative.injectSpill,
+        alternative.configs,
+        maxDrivers);
+    if (!stats.has_value() ||
+        std::max(stats->cpuNanos, baseline->cpuNanos) < minCpuNanos) {
+      continue;
+    }
+    const double ratio = static_cast<double>(stats->cpuNanos) /
+        std::max<uint64_t>(baseline->cpuNanos, 1);
+    if (ratio <= FLAGS_performance_anomaly_ratio &&
+        (!alternative.similarCost ||
+         ratio * FLAGS_performance_anomaly_ratio >= 1)) {
+      continue;
+    }
+    auto anomaly = fmt::format(
+        "Seed {}: {} took {} CPU and {} peak memory vs. {} CPU and {} peak "
+        "memory on the default path ({:.2f}x CPU) for plan:\n{}",
+        currentSeed_,
+        alternative.name,
+        succinctNanos(stats->cpuNanos),
+        succinctBytes(stats->peakMemoryBytes),
+        succinctNanos(baseline->cpuNanos),
+        succinctBytes(baseline->peakMemoryBytes),
+        ratio,
+        planWithSplits.plan->toString(true, true));
+    LOG(WARNING) << "Performance anomaly. " << anomaly;
+    performanceAnomalies_.push_back(std::move(anomaly));
+  }
+}
+
+void AggregationFuzzerBase::printPerformanceStats() const {
+  if (!FLAGS_performance_mode) {
+    return;
+  }
+  LOG(INFO) << "Total plans tested for performance anomalies: "
+            << numPerformanceTested_;
+  LOG(INFO) << "Total performance anomalies: "
+            << performanceAnomalies_.size();
+  for (const auto& anomaly : performanceAnomalies_) {
+    LOG(INFO) << anomaly;
+  }
 }
 
 void AggregationFuzzerBase::compare(
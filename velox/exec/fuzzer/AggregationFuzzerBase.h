@@ -46,6 +46,8 @@ DECLARE_bool(persist_and_run_once);
 
 DECLARE_bool(log_signature_stats);
 
+DECLARE_bool(performance_mode);
+
 namespace facebook::velox::exec::test {
 
 using facebook::velox::fuzzer::CallableSignature;
@@ -102,6 +104,12 @@ class AggregationFuzzerBase {
     size_t numFailed{0};
   };
 
+  /// CPU time and peak memory of one execution of a plan.
+  struct ExecutionStats {
+    uint64_t cpuNanos{0};
+    int64_t peakMemoryBytes{0};
+  };
+
   enum ReferenceQueryErrorCode {
     kSuccess,
     kReferenceQueryFail,
@@ -218,7 +226,9 @@ class AggregationFuzzerBase {
       const std::vector<exec::Split>& splits = {},
       bool injectSpill = false,
       bool abandonPartial = false,
-      int32_t maxDrivers = 2);
+      int32_t maxDrivers = 2,
+      const std::unordered_map<std::string, std::string>& extraConfigs = {},
+      ExecutionStats* executionStats = nullptr);
 
   // Will throw if referenceQueryRunner doesn't support
   // returning results as a vector.
@@ -255,8 +265,30 @@ class AggregationFuzzerBase {
       const velox::fuzzer::ResultOrError& expected,
       int32_t maxDrivers = 2);
 
+  // Runs 'planWithSplits' with the default configs and with each alternative
+  // execution path: spilling, hash mode instead of array or normalized key
+  // mode in the hash tables and std::sort instead of prefix sort. Records
+  // the alternatives whose CPU time is more than --performance_anomaly_ratio
+  // times that of the default path, or less than 1 / ratio of it for the
+  // paths that are expected to be as fast. Only used with --performance_mode.
+  void testPerformance(
+      const PlanWithSplits& planWithSplits,
+      int32_t maxDrivers);
+
+  // Returns the lowest CPU time and peak memory of --performance_repeats
+  // executions of 'planWithSplits', or std::nullopt if the plan fails.
+  std::optional<ExecutionStats> measure(
+      const PlanWithSplits& planWithSplits,
+      bool injectSpill,
+      const std::unordered_map<std::string, std::string>& extraConfigs,
+      int32_t maxDrivers);
+
   void printSignatureStats();
 
+  // Prints the number of plans tested in --performance_mode and the
+  // performance anomalies found.
+  void printPerformanceStats() const;
+
   const std::unordered_map<std::string, std::shared_ptr<ResultVerifier>>
       customVerificationFunctions_;
   const std::unordered_map<std::string, std::shared_ptr<InputGenerator>>
@@ -276,6 +308,12 @@ class AggregationFuzzerBase {
   // come before stats for 'signatureTemplates_'.
   std::vector<SignatureStats> signatureStats_;
 
+  // Number of plans tested in --performance_mode.
+  size_t numPerformanceTested_{0};
+
+  // Descriptions of the performance anomalies found in --performance_mode.
+  std::vector<std::string> performanceAnomalies_;
+
   FuzzerGenerator rng_;
   size_t currentSeed_{0};
 
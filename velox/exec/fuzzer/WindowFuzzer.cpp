@@ -283,6 +283,7 @@ void WindowFuzzer::go() {
 
   stats_.print(iteration);
   printSignatureStats();
+  printPerformanceStats();
 }
 
 void WindowFuzzer::go(const std::string& /*planPath*/) {
@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
+#include "velox/type/StringView.h"
 #include "velox/type/Timestamp.h"
 #include "velox/type/Type.h"
 
@@ -34,7 +35,7 @@ class PrefixSortEncoder {
       : ascending_(ascending), nullsFirst_(nullsFirst){};
 
   /// Encode native primitive types(such as uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp). TODO: Add support for strings.
+  /// int32_t, float, double, Timestamp). Strings use the overload below.
   /// 1. The first byte of the encoded result is null byte. The value is 0 if
   ///    (nulls first and value is null) or (nulls last and value is not null).
   ///    Otherwise, the value is 1.
@@ -53,8 +54,15 @@ class PrefixSortEncoder {
     }
   }
 
+  /// Encodes the first kStringPrefixSize bytes of a string after the null
+  /// byte. Strings with equal encodings may differ and are to be compared in
+  /// full. 'value' must be contiguous.
+  FOLLY_ALWAYS_INLINE void encode(std::optional<StringView> value, char* dest)
+      const;
+
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp. TODO Add support for int16_t, uint16_t.
+  /// int32_t, float, double, Timestamp, StringView. TODO Add support for
+  /// int16_t, uint16_t.
   template <typename T>
   FOLLY_ALWAYS_INLINE void encodeNoNulls(T value, char* dest) const;
 
@@ -86,11 +94,25 @@ class PrefixSortEncoder {
       case ::facebook::velox::TypeKind::TIMESTAMP: {
         return 17;
       }
+      case ::facebook::velox::TypeKind::VARCHAR:
+      case ::facebook::velox::TypeKind::VARBINARY: {
+        return 1 + kStringPrefixSize;
+      }
       default:
         return std::nullopt;
     }
   }
 
+  /// True if the encoding of 'typeKind' is a prefix of the value, i.e. values
+  /// with equal encodings are not necessarily equal.
+  static bool isPrefixEncoded(TypeKind typeKind) {
+    return typeKind == TypeKind::VARCHAR || typeKind == TypeKind::VARBINARY;
+  }
+
+  /// Number of leading bytes of a string that are encoded. Strings up to this
+  /// size are inlined in StringView.
+  static constexpr int32_t kStringPrefixSize = StringView::kInlineSize;
+
  private:
   const bool ascending_;
   const bool nullsFirst_;
@@ -228,4 +250,35 @@ FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
   encodeNoNulls(value.getNanos(), dest + 8);
 }
 
+/// Bytes of strings compare as unsigned bytes, so the leading bytes are
+/// copied as is and padded with zeros. A string that ends within the prefix
+/// is then less than the strings it is a prefix of unless these continue with
+/// zeros, in which case the encodings are equal. Bits are inverted for
+/// descending order.
+template <>
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encodeNoNulls(
+    StringView value,
+    char* dest) const {
+  const auto size = std::min<int32_t>(value.size(), kStringPrefixSize);
+  std::memcpy(dest, value.data(), size);
+  simd::memset(dest + size, 0, kStringPrefixSize - size);
+  if (!ascending_) {
+    for (auto i = 0; i < kStringPrefixSize; ++i) {
+      dest[i] = ~dest[i];
+    }
+  }
+}
+
+FOLLY_ALWAYS_INLINE void PrefixSortEncoder::encode(
+    std::optional<StringView> value,
+    char* dest) const {
+  if (value.has_value()) {
+    dest[0] = nullsFirst_ ? 1 : 0;
+    encodeNoNulls(value.value(), dest + 1);
+  } else {
+    dest[0] = nullsFirst_ ? 0 : 1;
+    simd::memset(dest + 1, 0, kStringPrefixSize);
+  }
+}
+
 } // namespace facebook::velox::exec::prefixsort
@@ -678,6 +678,183 @@ TEST_F(AggregationTest, multiKeyDistinct) {
   testMultiKey(vectors, true, true);
 }
 
+TEST_F(AggregationTest, partitionedMerge) {
+  auto vectors = makeVectors(rowType_, 10, 100);
+  // Each driver reads all of 'vectors', so the drivers see the same groups.
+  constexpr int32_t kNumDrivers = 4;
+  std::vector<RowVectorPtr> allVectors;
+  for (auto i = 0; i < kNumDrivers; ++i) {
+    allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(allVectors);
+
+  const std::string expected =
+      "SELECT c0, c6, sum(c1), count(c2), max(c3) FROM tmp GROUP BY 1, 2";
+  auto singlePlan =
+      PlanBuilder()
+          .values(vectors, true)
+          .singleAggregation(
+              {"c0", "c6"}, {"sum(c1)", "count(c2)", "max(c3)"})
+          .planNode();
+  auto finalPlan =
+      PlanBuilder()
+          .values(vectors, true)
+          .partialAggregation(
+              {"c0", "c6"}, {"sum(c1)", "count(c2)", "max(c3)"})
+          .finalAggregation()
+          .planNode();
+  for (const auto& plan : {singlePlan, finalPlan}) {
+    SCOPED_TRACE(plan->toString(true, true));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(QueryConfig::kHashAggregationPartitionedMerge, "true")
+        .maxDrivers(kNumDrivers)
+        .assertResults(expected);
+  }
+
+  // Fewer groups than drivers leaves some partitions empty.
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 1})});
+  auto plan = PlanBuilder()
+                  .values({data}, true)
+                  .singleAggregation({"c0"}, {"count(1)"})
+                  .planNode();
+  AssertQueryBuilder(plan)
+      .config(QueryConfig::kHashAggregationPartitionedMerge, "true")
+      .maxDrivers(kNumDrivers)
+      .assertResults(makeRowVector(
+          {makeFlatVector<int64_t>({1, 2}),
+           makeFlatVector<int64_t>({2 * kNumDrivers, kNumDrivers})}));
+}
+
+TEST_F(AggregationTest, partitionedMergeDriverWithoutInput) {
+  constexpr int32_t kNumDrivers = 4;
+  // Partitioning on 'p' sends all rows to at most 2 of the drivers. The others
+  // merge partitions of the groups of these without having seen input. The
+  // approx_percentile accumulators are in the arena of their driver and the
+  // percentile is set from the first input.
+  auto data = makeRowVector(
+      {"p", "c0", "c1"},
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 2; }),
+       makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; }),
+       makeFlatVector<double>(1'000, [](auto row) { return row; })});
+  const std::vector<std::string> aggregates{
+      "approx_percentile(c1, 0.5)", "approx_percentile(c1, 0.9)", "count(1)"};
+  auto singlePlan = PlanBuilder()
+                        .values({data})
+                        .localPartition({"p"})
+                        .singleAggregation({"c0"}, aggregates)
+                        .planNode();
+  auto finalPlan = PlanBuilder()
+                       .values({data})
+                       .localPartition({"p"})
+                       .partialAggregation({"c0"}, aggregates)
+                       .finalAggregation()
+                       .planNode();
+  for (const auto& plan : {singlePlan, finalPlan}) {
+    SCOPED_TRACE(plan->toString(true, true));
+    auto expected = AssertQueryBuilder(plan).maxDrivers(1).copyResults(pool());
+    AssertQueryBuilder(plan)
+        .config(QueryConfig::kHashAggregationPartitionedMerge, "true")
+        .maxDrivers(kNumDrivers)
+        .assertResults(expected);
+  }
+}
+
+TEST_F(AggregationTest, partitionedMergeGlobal) {
+  auto vectors = makeVectors(rowType_, 10, 100);
+  constexpr int32_t kNumDrivers = 4;
+  std::vector<RowVectorPtr> allVectors;
+  for (auto i = 0; i < kNumDrivers; ++i) {
+    allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(allVectors);
+
+  const std::string expected =
+      "SELECT sum(c1), count(c2), max(c3), min(c4) FROM tmp";
+  const std::vector<std::string> aggregates{
+      "sum(c1)", "count(c2)", "max(c3)", "min(c4)"};
+  auto singlePlan = PlanBuilder()
+                        .values(vectors, true)
+                        .singleAggregation({}, aggregates)
+                        .planNode();
+  auto finalPlan = PlanBuilder()
+                       .values(vectors, true)
+                       .partialAggregation({}, aggregates)
+                       .finalAggregation()
+                       .planNode();
+  for (const auto& plan : {singlePlan, finalPlan}) {
+    SCOPED_TRACE(plan->toString(true, true));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(QueryConfig::kHashAggregationPartitionedMerge, "true")
+            .maxDrivers(kNumDrivers)
+            .assertResults(expected);
+    const auto& stats =
+        toPlanStats(task->taskStats()).at(plan->id()).customStats;
+    ASSERT_EQ(stats.at("numMergedGlobalAggregations").sum, kNumDrivers - 1);
+  }
+
+  // Accumulators in external memory.
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  auto plan = PlanBuilder()
+                  .values({data}, true)
+                  .singleAggregation({}, {"sumnonpod(c0)", "count(1)"})
+                  .planNode();
+  AssertQueryBuilder(plan)
+      .config(QueryConfig::kHashAggregationPartitionedMerge, "true")
+      .maxDrivers(kNumDrivers)
+      .assertResults(makeRowVector(
+          {makeFlatVector<int64_t>({6 * kNumDrivers}),
+           makeFlatVector<int64_t>({3 * kNumDrivers})}));
+
+  // No driver gets input.
+  plan = PlanBuilder()
+             .values({data}, true)
+             .filter("c0 > 10")
+             .singleAggregation({}, {"sumnonpod(c0)", "count(1)"})
+             .planNode();
+  AssertQueryBuilder(plan)
+      .config(QueryConfig::kHashAggregationPartitionedMerge, "true")
+      .maxDrivers(kNumDrivers)
+      .assertResults(makeRowVector(
+          {makeNullableFlatVector<int64_t>({std::nullopt}),
+           makeFlatVector<int64_t>({0})}));
+
+  // Partitioning on 'p' sends all rows to at most 2 of the drivers, so the
+  // last driver, which merges the others, may have seen no input. The
+  // approx_percentile accumulators are in the arena of their driver and the
+  // percentile is set from the first input. With fewer values than the
+  // default k of the sketch the results are exact.
+  data = makeRowVector(
+      {"p", "c0"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row % 2; }),
+       makeFlatVector<double>(100, [](auto row) { return row; })});
+  const std::vector<std::string> percentiles{
+      "approx_percentile(c0, 0.5)", "approx_percentile(c0, 0.9)", "count(1)"};
+  auto singlePercentilePlan = PlanBuilder()
+                                  .values({data})
+                                  .localPartition({"p"})
+                                  .singleAggregation({}, percentiles)
+                                  .planNode();
+  auto finalPercentilePlan = PlanBuilder()
+                                 .values({data})
+                                 .localPartition({"p"})
+                                 .partialAggregation({}, percentiles)
+                                 .finalAggregation()
+                                 .planNode();
+  for (const auto& plan : {singlePercentilePlan, finalPercentilePlan}) {
+    SCOPED_TRACE(plan->toString(true, true));
+    auto expected = AssertQueryBuilder(plan).maxDrivers(1).copyResults(pool());
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(QueryConfig::kHashAggregationPartitionedMerge, "true")
+            .maxDrivers(kNumDrivers)
+            .assertResults(expected);
+    const auto& stats =
+        toPlanStats(task->taskStats()).at(plan->id()).customStats;
+    ASSERT_EQ(stats.at("numMergedGlobalAggregations").sum, kNumDrivers - 1);
+  }
+}
+
 TEST_F(AggregationTest, aggregateOfNulls) {
   auto rowVector = makeRowVector({
       BatchMaker::createVector<TypeKind::BIGINT>(
@@ -955,6 +1132,149 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, abandonPartialAggregationBySketch) {
+  // The sketch covers the first 2 of 4 batches with either unique keys or 10
+  // keys.
+  std::vector<RowVectorPtr> uniqueVectors;
+  std::vector<RowVectorPtr> fewKeyVectors;
+  for (auto i = 0; i < 4; ++i) {
+    uniqueVectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * 1'000 + row; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+    fewKeyVectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+
+  for (const auto& [vectors, abandoned] :
+       {std::pair{uniqueVectors, true}, std::pair{fewKeyVectors, false}}) {
+    SCOPED_TRACE(fmt::format("abandoned: {}", abandoned));
+    createDuckDbTable(vectors);
+    core::PlanNodeId partialAggId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationSketchRows, 2'000)
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                      .capturePlanNodeId(partialAggId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(
+                "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c0");
+    const auto stats = toPlanStats(task->taskStats()).at(partialAggId);
+    const auto sketchPct =
+        stats.customStats.at("partialAggregationSketchPct").sum;
+    if (abandoned) {
+      ASSERT_GE(sketchPct, 90);
+      ASSERT_EQ(stats.customStats.at("abandonedPartialAggregation").sum, 1);
+      ASSERT_EQ(stats.outputRows, 4'000);
+    } else {
+      ASSERT_LT(sketchPct, 10);
+      ASSERT_EQ(stats.customStats.count("abandonedPartialAggregation"), 0);
+    }
+  }
+}
+
+TEST_F(AggregationTest, partialAggregationClusteredFlush) {
+  // Each batch of the clustered input has its own 500 keys. The other input
+  // has the same keys in all batches.
+  std::vector<RowVectorPtr> clusteredVectors;
+  std::vector<RowVectorPtr> mixedVectors;
+  for (auto i = 0; i < 10; ++i) {
+    clusteredVectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            2'000, [&](auto row) { return i * 500 + row / 4; }),
+        makeFlatVector<int64_t>(2'000, [](auto row) { return row; }),
+    }));
+    mixedVectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(2'000, [](auto row) { return row % 500; }),
+        makeFlatVector<int64_t>(2'000, [](auto row) { return row; }),
+    }));
+  }
+
+  for (const auto& [vectors, clustered] :
+       {std::pair{clusteredVectors, true}, std::pair{mixedVectors, false}}) {
+    SCOPED_TRACE(fmt::format("clustered: {}", clustered));
+    createDuckDbTable(vectors);
+    core::PlanNodeId partialAggId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kPartialAggregationClusteredFlush, "true")
+            .config(QueryConfig::kPreferredOutputBatchRows, 400)
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                      .capturePlanNodeId(partialAggId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(
+                "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c0");
+    const auto stats = toPlanStats(task->taskStats()).at(partialAggId);
+    if (clustered) {
+      // The table is flushed every second batch, when it has the groups of
+      // the previous batch and the batch hit none of them.
+      const auto& flushPct = stats.customStats.at("clusteredFlushPct");
+      ASSERT_EQ(flushPct.count, 5);
+      ASSERT_EQ(flushPct.sum, 500);
+      ASSERT_EQ(stats.outputRows, 5'000);
+    } else {
+      ASSERT_EQ(stats.customStats.count("clusteredFlushPct"), 0);
+      ASSERT_EQ(stats.outputRows, 500);
+    }
+  }
+}
+
+TEST_F(AggregationTest, partialAggregationMemoryPressureFlush) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            10'000, [&](auto row) { return (i * 10'000 + row) % 30'000; }),
+        makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto flushPct : {0, 1}) {
+    SCOPED_TRACE(fmt::format("flushPct {}", flushPct));
+    auto queryCtx = core::QueryCtx::create(executor_.get());
+    queryCtx->testingOverrideMemoryPool(memory::memoryManager()->addRootPool(
+        queryCtx->queryId(), 64 << 20));
+    core::PlanNodeId partialAggId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .queryCtx(queryCtx)
+            .config(
+                QueryConfig::kPartialAggregationFlushQueryMemoryPct,
+                std::to_string(flushPct))
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                      .capturePlanNodeId(partialAggId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(
+                "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c0");
+    const auto stats = toPlanStats(task->taskStats()).at(partialAggId);
+    if (flushPct == 0) {
+      ASSERT_EQ(stats.customStats.count("memoryPressureFlushes"), 0);
+      ASSERT_EQ(stats.outputRows, 30'000);
+    } else {
+      // The query reserves more than 1% of 64MB once the table has groups,
+      // so the table is flushed before all the input for a key has arrived.
+      ASSERT_GT(stats.customStats.at("memoryPressureFlushes").sum, 1);
+      ASSERT_GT(stats.outputRows, 30'000);
+    }
+  }
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -1325,6 +1645,80 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsPreAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data});
+
+  core::PlanNodeId groupIdNodeId;
+  auto plan =
+      PlanBuilder()
+          .values({data})
+          .groupId({"k1", "k2"}, {{"k1", "k2"}, {"k1"}, {"k2"}, {}}, {"a", "b"})
+          .capturePlanNodeId(groupIdNodeId)
+          .singleAggregation(
+              {"k1", "k2", "group_id"},
+              {"count(1) as count_1",
+               "sum(a) as sum_a",
+               "max(b) as max_b",
+               "avg(a) as avg_a"})
+          .project({"k1", "k2", "count_1", "sum_a", "max_b", "avg_a"})
+          .planNode();
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kGroupingSetsPreAggregationEnabled, "true")
+          .assertResults(
+              "SELECT k1, k2, count(1), sum(a), max(b), avg(a) FROM tmp "
+              "GROUP BY CUBE (k1, k2)");
+
+  // GroupId replicates one row per distinct (k1, k2) instead of one per input
+  // row.
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(11 * 17, planStats.at(groupIdNodeId).inputRows);
+  ASSERT_EQ(4 * 11 * 17, planStats.at(groupIdNodeId).outputRows);
+
+  // Masks computed by a Project over the GroupId. The aggregation is not over
+  // the GroupId and still aggregates the replicated input rows.
+  plan = PlanBuilder()
+             .values({data})
+             .groupId({"k1", "k2"}, {{"k1"}, {"k2"}}, {"a", "b"})
+             .capturePlanNodeId(groupIdNodeId)
+             .project(
+                 {"k1",
+                  "k2",
+                  "group_id",
+                  "a",
+                  "b",
+                  "group_id = 0 as mask_a",
+                  "group_id = 1 as mask_b"})
+             .singleAggregation(
+                 {"k1", "k2", "group_id"},
+                 {"count(1) as count_1", "sum(a) as sum_a", "max(b) as max_b"},
+                 {"", "mask_a", "mask_b"})
+             .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+             .planNode();
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(
+                 core::QueryConfig::kGroupingSetsPreAggregationEnabled, "true")
+             .assertResults(
+                 "SELECT k1, null, count(1), sum(a), null FROM tmp GROUP BY k1 "
+                 "UNION ALL "
+                 "SELECT null, k2, count(1), null, max(b) FROM tmp GROUP BY k2");
+  planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(size, planStats.at(groupIdNodeId).inputRows);
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -1858,6 +2252,68 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, distinctDedup) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+
+  struct {
+    std::vector<std::string> keys;
+    std::vector<std::string> aggregates;
+    std::string sql;
+  } testSettings[] = {
+      {{"c1"},
+       {"count(DISTINCT c0)", "sum(DISTINCT c0)"},
+       "SELECT c1, count(DISTINCT c0), sum(DISTINCT c0) FROM tmp GROUP BY 1"},
+      {{"c0"},
+       {"count(DISTINCT c2)"},
+       "SELECT c0, count(DISTINCT c2) FROM tmp GROUP BY 1"},
+      {{},
+       {"count(DISTINCT c1)", "max(DISTINCT c1)"},
+       "SELECT count(DISTINCT c1), max(DISTINCT c1) FROM tmp"}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.sql);
+    core::PlanNodeId aggrNodeId;
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .singleAggregation(testData.keys, testData.aggregates)
+                    .capturePlanNodeId(aggrNodeId)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(QueryConfig::kHashAggregationDistinctDedup, "true")
+        .assertResults(testData.sql);
+
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .config(QueryConfig::kHashAggregationDistinctDedup, "true")
+                    .assertResults(testData.sql);
+    ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+
+  // Aggregates over different inputs keep a set of inputs per group.
+  auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .singleAggregation(
+              {"c1"}, {"count(DISTINCT c0)", "count(DISTINCT c2)"})
+          .planNode();
+  auto queryConfig = std::unordered_map<std::string, std::string>{
+      {QueryConfig::kHashAggregationDistinctDedup, "true"}};
+  ASSERT_FALSE(
+      std::dynamic_pointer_cast<const core::AggregationNode>(plan)
+          ->dedupsDistinctInputs(core::QueryConfig(queryConfig)));
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .configs(queryConfig)
+      .assertResults(
+          "SELECT c1, count(DISTINCT c0), count(DISTINCT c2) FROM tmp "
+          "GROUP BY 1");
+}
+
 TEST_F(AggregationTest, spillingForAggrsWithSorting) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
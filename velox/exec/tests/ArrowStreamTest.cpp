@@ -17,6 +17,8 @@
 #include "velox/vector/arrow/Bridge.h"
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/ArrowStream.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 
@@ -232,3 +234,44 @@ TEST_F(ArrowStreamTest, error) {
       AssertQueryBuilder(plan).copyResults(pool_.get()),
       "Failed to call get_schema on ArrowStream: get_schema failed.");
 }
+
+TEST_F(ArrowStreamTest, prefetch) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [&](auto row) { return i * 1'000 + row; }, nullEvery(7))}));
+  }
+  createDuckDbTable(vectors);
+  auto type = asRowType(vectors[0]->type());
+
+  for (const auto* prefetchBatches : {"1", "3", "20"}) {
+    SCOPED_TRACE(prefetchBatches);
+    struct ArrowArrayStream arrowStream;
+    exportArrowStream(
+        std::make_shared<ArrowReader>(pool_, vectors, type), &arrowStream);
+    auto plan = std::make_shared<core::ArrowStreamNode>(
+        "0", type, std::make_shared<ArrowArrayStream>(arrowStream));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kArrowStreamPrefetchBatches,
+                prefetchBatches)
+            .assertResults("SELECT * FROM tmp");
+    const auto& stats =
+        exec::toPlanStats(task->taskStats()).at(plan->id()).customStats;
+    ASSERT_EQ(stats.count(exec::ArrowStream::kProducerWallNanos), 1);
+  }
+
+  // Errors of the prefetch task are thrown on the driver thread.
+  struct ArrowArrayStream arrowStream;
+  exportArrowStream(
+      std::make_shared<ArrowReader>(pool_, vectors, type, true, false),
+      &arrowStream);
+  auto plan = std::make_shared<core::ArrowStreamNode>(
+      "0", type, std::make_shared<ArrowArrayStream>(arrowStream));
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kArrowStreamPrefetchBatches, "2")
+          .copyResults(pool_.get()),
+      "Failed to call get_next on ArrowStream: get_next failed.");
+}
@@ -305,6 +305,54 @@ TEST_F(ContainerRowSerdeTest, nested) {
   testRoundTrip(nestedArray);
 }
 
+TEST_F(ContainerRowSerdeTest, batch) {
+  std::vector<std::pair<std::string, std::optional<int64_t>>> map{
+      {"a", {1}}, {"b", {2}}, {"c", {3}}, {"d", {4}}};
+  std::vector<VectorPtr> vectors = {
+      makeFlatVector<int64_t>({1, 2, 3, 4}),
+      makeFlatVector<std::string>({"a", "", "Long test sentence ......"}),
+      makeRowVector(
+          {makeNullableFlatVector<int64_t>({1, std::nullopt, 3}),
+           makeNullableArrayVector<std::string>(
+               {{"a", std::nullopt, "c"}, {}, {"d"}})}),
+      makeNullableNestedArrayVector<std::string>(
+          {{{{{"1", "2"}}, {{"3", "4"}}}}, {{}}, {{std::nullopt, {}}}}),
+      makeArrayOfMapVector<std::string, int64_t>(
+          {{map, std::nullopt}, {std::nullopt}, {map}}),
+      makeMapVector<int64_t, std::string>(
+          {{{1, "x"}, {2, "y"}}, {}, {{3, "Long test sentence ......"}}}),
+  };
+
+  for (const auto& data : vectors) {
+    SCOPED_TRACE(data->type()->toString());
+    const auto size = data->size();
+    std::vector<vector_size_t> indices(size);
+    std::iota(indices.begin(), indices.end(), 0);
+
+    // All values serialized with one call are read back one by one.
+    ByteOutputStream out(&allocator_);
+    auto position = allocator_.newWrite(out);
+    ContainerRowSerde::serialize(*data, indices, out, {});
+    allocator_.finishWrite(out, 0);
+    test::assertEqualVectors(data, deserialize(position, data->type(), size));
+
+    // Values serialized one by one are read back with one call, in reverse
+    // order.
+    auto positions = serializeWithPositions(data);
+    std::vector<ByteInputStream> streams;
+    for (const auto& rowPosition : positions) {
+      streams.push_back(HashStringAllocator::prepareRead(rowPosition.header));
+    }
+    std::reverse(indices.begin(), indices.end());
+    auto copy = BaseVector::create(data->type(), size, pool());
+    ContainerRowSerde::deserialize(streams, indices, copy.get());
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_TRUE(copy->equalValueAt(data.get(), indices[i], i));
+    }
+    allocator_.clear();
+  }
+}
+
 TEST_F(ContainerRowSerdeTest, compareNullsInArrayVector) {
   auto data = makeNullableArrayVector<int64_t>({
       {1, 2},
@@ -19,8 +19,11 @@
 #include <memory>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/BatchSizeTuner.h"
+#include "velox/exec/DriverScheduler.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Values.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -1548,6 +1551,227 @@ DEBUG_ONLY_TEST_F(DriverTest, driverCpuTimeSlicingCheck) {
   }
 }
 
+TEST_F(DriverTest, multiLevelScheduler) {
+  auto scheduler = std::make_shared<MultiLevelDriverScheduler>(
+      driverExecutor_.get(), MultiLevelDriverScheduler::Options{{1, 10}, 0, 2});
+  ASSERT_EQ(3, scheduler->numLevels());
+  ASSERT_EQ(0, scheduler->level(0));
+  ASSERT_EQ(1, scheduler->level(1));
+  ASSERT_EQ(1, scheduler->level(9));
+  ASSERT_EQ(2, scheduler->level(1'000));
+  DriverScheduler::setInstance(scheduler);
+  SCOPE_EXIT {
+    DriverScheduler::setInstance(nullptr);
+  };
+
+  constexpr int32_t kNumBatches = 100;
+  constexpr int32_t kBatchSize = 1'000;
+  std::vector<RowVectorPtr> batches;
+  for (int32_t i = 0; i < kNumBatches; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+        kBatchSize, [](auto row) { return row; })}));
+  }
+  auto fragment = PlanBuilder()
+                      .values(batches, true)
+                      .filter("c0 % 2 = 0")
+                      .project({"c0 * 2"})
+                      .planFragment();
+
+  // Queries of different weights with a 1ms time slice, so that the drivers
+  // yield and move through the levels.
+  constexpr int32_t kNumTasks = 4;
+  constexpr int32_t kNumDrivers = 4;
+  std::atomic<int64_t> numRows{0};
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (int32_t i = 0; i < kNumTasks; ++i) {
+    std::unordered_map<std::string, std::string> queryConfig{
+        {core::QueryConfig::kDriverCpuTimeSliceLimitMs, "1"},
+        {core::QueryConfig::kDriverSchedulerWeight, std::to_string(i + 1)}};
+    auto task = Task::create(
+        fmt::format("t{}", i),
+        fragment,
+        0,
+        core::QueryCtx::create(
+            driverExecutor_.get(), core::QueryConfig{std::move(queryConfig)}),
+        Task::ExecutionMode::kParallel,
+        [&](RowVectorPtr output, ContinueFuture* /*unused*/) {
+          if (output != nullptr) {
+            numRows += output->size();
+          }
+          return exec::BlockingReason::kNotBlocked;
+        });
+    task->start(kNumDrivers, 1);
+    tasks.push_back(std::move(task));
+  }
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get(), 60'000'000));
+  }
+  ASSERT_EQ(kNumTasks * kNumDrivers * kNumBatches * kBatchSize / 2, numRows);
+  ASSERT_EQ(0, scheduler->numQueued());
+
+  // Queries on another executor are not scheduled by 'scheduler'.
+  folly::CPUThreadPoolExecutor otherExecutor(2);
+  auto task = Task::create(
+      "other",
+      fragment,
+      0,
+      core::QueryCtx::create(&otherExecutor),
+      Task::ExecutionMode::kParallel,
+      [](RowVectorPtr /*unused*/, ContinueFuture* /*unused*/) {
+        return exec::BlockingReason::kNotBlocked;
+      });
+  task->start(1, 1);
+  ASSERT_TRUE(waitForTaskCompletion(task.get(), 60'000'000));
+}
+
+TEST_F(DriverTest, blockingWaitInPlace) {
+  constexpr int32_t kNumBatches = 100;
+  std::vector<RowVectorPtr> batches;
+  for (int32_t i = 0; i < kNumBatches; ++i) {
+    batches.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(100, [](auto row) { return row; })}));
+  }
+  core::PlanNodeId exchangeId;
+  auto plan = PlanBuilder()
+                  .values(batches, true)
+                  .localPartition({"c0"})
+                  .capturePlanNodeId(exchangeId)
+                  .singleAggregation({}, {"count(1)", "sum(c0)"})
+                  .localPartition(std::vector<std::string>{})
+                  .singleAggregation({}, {"sum(a0)", "sum(a1)"})
+                  .planNode();
+  constexpr int32_t kNumDrivers = 4;
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>(
+           std::vector<int64_t>{kNumDrivers * kNumBatches * 100}),
+       makeFlatVector<int64_t>(
+           std::vector<int64_t>{kNumDrivers * kNumBatches * 4'950})});
+
+  for (const auto waitUs : {"0", "1000"}) {
+    SCOPED_TRACE(fmt::format("waitUs: {}", waitUs));
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kDriverBlockingWaitInPlaceUs, waitUs)
+            .maxDrivers(kNumDrivers)
+            .assertResults(expected);
+    auto stats = toPlanStats(task->taskStats()).at(exchangeId).customStats;
+    if (std::string(waitUs) == "0") {
+      ASSERT_EQ(0, stats.count("blockedWaitInPlaceTimes"));
+      ASSERT_EQ(0, stats.count("blockedWaitInPlaceMisses"));
+    }
+  }
+}
+
+TEST_F(DriverTest, perfCounterSampling) {
+  std::vector<RowVectorPtr> batches;
+  for (int32_t i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })}));
+  }
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .project({"c0 * 2"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kOperatorPerfCounterSamplingInterval, "2")
+      .copyResults(pool(), task);
+  auto stats = toPlanStats(task->taskStats()).at(projectId).customStats;
+  process::PerfCounts counts;
+  if (!process::readThreadPerfCounts(counts)) {
+    ASSERT_EQ(0, stats.count("perfSampledCalls"));
+    return;
+  }
+  // Half of the 10 addInput and of the at least 10 getOutput calls are
+  // sampled.
+  ASSERT_GE(stats.at("perfSampledCalls").sum, 10);
+  ASSERT_GT(stats.at("perfInstructions").sum, 0);
+  ASSERT_GT(stats.at("perfCycles").sum, 0);
+}
+
+TEST_F(DriverTest, batchSizeTuner) {
+  // Shift 2, i.e. 256 of 1024 rows, has the least cost per row.
+  const std::vector<uint64_t> nanosPerRow = {40, 30, 10, 20, 50};
+  BatchSizeTuner tuner;
+  uint64_t cpuNanos = 0;
+  int32_t numBatches = 0;
+  while (!tuner.converged()) {
+    const auto numRows = tuner.batchRows(1'024);
+    const auto shift = tuner.shift();
+    ASSERT_EQ(1'024 >> shift, numRows);
+    tuner.recordOutput(0, cpuNanos, numRows);
+    cpuNanos += numRows * nanosPerRow[shift];
+    ASSERT_LT(++numBatches, 100);
+  }
+  ASSERT_EQ(2, tuner.shift());
+  ASSERT_EQ(256, tuner.batchRows(1'024));
+  ASSERT_EQ(10, tuner.nanosPerRow(2));
+  ASSERT_EQ(40, tuner.nanosPerRow(0));
+
+  // Batches are not made smaller than kMinBatchRows and the time between
+  // different runs is not counted.
+  BatchSizeTuner smallTuner;
+  for (auto i = 0; !smallTuner.converged(); ++i) {
+    const auto numRows = smallTuner.batchRows(200);
+    ASSERT_GE(numRows, BatchSizeTuner::kMinBatchRows);
+    smallTuner.recordOutput(i / 2, i * 1'000, numRows);
+    ASSERT_LT(i, 100);
+  }
+  ASSERT_LE(smallTuner.shift(), 1);
+  ASSERT_EQ(200, BatchSizeTuner().batchRows(200));
+  ASSERT_EQ(10, BatchSizeTuner().batchRows(10));
+}
+
+TEST_F(DriverTest, adaptiveOutputBatchSize) {
+  std::vector<RowVectorPtr> probe;
+  for (int32_t i = 0; i < 100; ++i) {
+    probe.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'024, [](auto row) { return row % 100; })}));
+  }
+  auto build = makeRowVector(
+      {"u0"}, {makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probe)
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"c0", "u0"})
+                  .capturePlanNodeId(probeId)
+                  .project({"c0 + u0"})
+                  .planNode();
+  for (const bool adaptive : {false, true}) {
+    SCOPED_TRACE(fmt::format("adaptive {}", adaptive));
+    std::shared_ptr<Task> task;
+    auto result =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "1024")
+            .config(
+                core::QueryConfig::kAdaptiveOutputBatchSize,
+                adaptive ? "true" : "false")
+            .copyResults(pool(), task);
+    ASSERT_EQ(100 * 1'024, result->size());
+    auto stats = toPlanStats(task->taskStats()).at(probeId);
+    if (!adaptive) {
+      ASSERT_EQ(0, stats.customStats.count("adaptiveOutputBatchRows"));
+      ASSERT_EQ(100, stats.outputVectors);
+      continue;
+    }
+    const auto& rows = stats.customStats.at("adaptiveOutputBatchRows");
+    ASSERT_EQ(1, rows.count);
+    ASSERT_GE(rows.sum, 64);
+    ASSERT_LE(rows.sum, 1'024);
+    ASSERT_GT(stats.outputVectors, 100);
+  }
+}
+
 namespace {
 
 template <typename T>
@@ -266,6 +266,82 @@ TEST_F(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+TEST_F(ExchangeClientTest, sourceCredit) {
+  constexpr int32_t kNumSources = 4;
+  constexpr int32_t kPagesPerSource = 8;
+  common::testutil::TestValue::enable();
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+
+  auto page = toSerializedPage(data);
+
+  // Room for 16.5 pages. Each source may be asked for up to 4 pages at a time.
+  auto client = std::make_shared<ExchangeClient>(
+      "source.credit", 17, page->size() * 16.5, pool(), executor());
+
+  // Records the largest number of pages a source returned for one request.
+  std::mutex mutex;
+  std::unordered_map<void*, int64_t> numPages;
+  int64_t maxPagesPerResponse = 0;
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::test::LocalExchangeSource",
+      std::function<void(void*)>(([&](void* source) {
+        const auto total = static_cast<ExchangeSource*>(source)
+                               ->metrics()
+                               .at("localExchangeSource.numPages")
+                               .sum;
+        std::lock_guard<std::mutex> l(mutex);
+        maxPagesPerResponse =
+            std::max(maxPagesPerResponse, total - numPages[source]);
+        numPages[source] = total;
+      })));
+
+  auto plan = test::PlanBuilder()
+                  .values({data})
+                  .partitionedOutput({"c0"}, 100)
+                  .planNode();
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < kNumSources; ++i) {
+    auto taskId = fmt::format("local://t{}", i);
+    auto task = makeTask(taskId, plan);
+
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+
+    tasks.push_back(task);
+    client->addRemoteTaskId(taskId);
+  }
+
+  // Produce after all sources are known so that the credit is the same for all
+  // requests.
+  for (auto& task : tasks) {
+    for (auto j = 0; j < kPagesPerSource; ++j) {
+      enqueue(task->taskId(), 17, data);
+    }
+  }
+
+  fetchPages(*client, kNumSources * kPagesPerSource);
+
+  const auto stats = client->stats();
+  EXPECT_EQ(kNumSources * kPagesPerSource, stats.at("numReceivedPages").sum);
+  EXPECT_LE(stats.at("peakBytes").sum, page->size() * 17);
+#ifndef NDEBUG
+  {
+    std::lock_guard<std::mutex> l(mutex);
+    EXPECT_GT(maxPagesPerResponse, 0);
+    EXPECT_LE(maxPagesPerResponse, 4);
+  }
+#endif
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+
+  client->close();
+}
+
 TEST_F(ExchangeClientTest, largeSinglePage) {
   auto data = {
       makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+class FragmentResultCacheTest : public HiveConnectorTestBase {
+ protected:
+  // Returns splits of 'files' that have a modification time if
+  // 'immutable' is true.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> makeSplits(
+      const std::vector<std::shared_ptr<TempFilePath>>& files,
+      bool immutable) {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& file : files) {
+      auto split = HiveConnectorSplitBuilder(file->getPath()).build();
+      if (immutable) {
+        split->properties = FileProperties{std::nullopt, 1'000};
+      }
+      splits.push_back(split);
+    }
+    return splits;
+  }
+
+  static int64_t getStat(
+      const std::shared_ptr<exec::Task>& task,
+      const core::PlanNodeId& nodeId,
+      const std::string& name) {
+    auto stats = toPlanStats(task->taskStats()).at(nodeId).customStats;
+    return stats.count(name) == 0 ? 0 : stats.at(name).sum;
+  }
+};
+
+TEST_F(FragmentResultCacheTest, basic) {
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> files;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [&](auto row) { return i + row; }),
+         makeFlatVector<std::string>(
+             1'000, [](auto row) { return std::to_string(row); })}));
+    files.push_back(TempFilePath::create());
+    writeToFile(files.back()->getPath(), {vectors.back()});
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId cacheNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(vectors[0]->type()))
+                  .filter("c0 % 3 = 0")
+                  .project({"c0 * 2 AS a", "c1"})
+                  .fragmentResultCache()
+                  .capturePlanNodeId(cacheNodeId)
+                  .planNode();
+  const std::string sql = "SELECT c0 * 2, c1 FROM tmp WHERE c0 % 3 = 0";
+
+  // The first query caches the output of each split and the second one reads
+  // it from the cache.
+  for (auto [expectedHits, expectedMisses] :
+       std::vector<std::pair<int64_t, int64_t>>{{0, 3}, {3, 0}}) {
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .splits(makeSplits(files, true))
+                    .assertResults(sql);
+    ASSERT_EQ(
+        expectedHits, getStat(task, cacheNodeId, "fragmentResultCacheHits"));
+    ASSERT_EQ(
+        expectedMisses,
+        getStat(task, cacheNodeId, "fragmentResultCacheMisses"));
+  }
+
+  // Splits without a modification time are not cached.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .splits(makeSplits(files, false))
+                  .assertResults(sql);
+  ASSERT_EQ(0, getStat(task, cacheNodeId, "fragmentResultCacheHits"));
+  ASSERT_EQ(0, getStat(task, cacheNodeId, "fragmentResultCacheMisses"));
+}
+
+TEST_F(FragmentResultCacheTest, invalidSource) {
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  VELOX_ASSERT_THROW(
+      PlanBuilder().values({data}).fragmentResultCache().planNode(),
+      "The source of FragmentResultCacheNode must be a TableScanNode");
+}
@@ -191,6 +191,24 @@ TEST_F(FunctionResolutionTest, sameRank) {
   checkResults("f5", 5);
 }
 
+// Resolutions are cached and the cache is invalidated when a function is
+// registered.
+TEST_F(FunctionResolutionTest, resolutionCache) {
+  registerFunction<TestFunction, int32_t, Variadic<Any>>({"f6"});
+  checkResults("f6", 4);
+  const auto resolved =
+      simpleFunctions().resolveFunction("f6", {INTEGER(), INTEGER()});
+  ASSERT_TRUE(resolved.has_value());
+  ASSERT_EQ(*resolved->type(), *INTEGER());
+  ASSERT_GT(simpleFunctions().testingNumResolutions(), 0);
+  ASSERT_FALSE(
+      simpleFunctions().resolveFunction("f6_unknown", {INTEGER()}).has_value());
+
+  registerFunction<TestFunction, int32_t, int32_t, int32_t>({"f6"});
+  ASSERT_EQ(0, simpleFunctions().testingNumResolutions());
+  checkResults("f6", 1);
+}
+
 TEST_F(FunctionResolutionTest, vectorOverSimpleFunction) {
   functions::registerVectorFunctions();
 
@@ -754,6 +754,40 @@ TEST_F(GroupedExecutionTest, groupedExecution) {
   EXPECT_EQ(numRead, numSplits * 10'000);
 }
 
+TEST_F(GroupedExecutionTest, groupsFromBucketNumbers) {
+  auto vectors = makeVectors(2, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+
+  CursorParameters params;
+  params.planNode = tableScanNode(ROW({}, {}));
+  params.maxDrivers = 2;
+  params.executionStrategy = core::ExecutionStrategy::kGrouped;
+  params.groupedExecutionLeafNodeIds.emplace(params.planNode->id());
+  params.numSplitGroups = 3;
+  params.numConcurrentSplitGroups = 1;
+  auto cursor = TaskCursor::create(params);
+  auto task = cursor->task();
+
+  // Buckets 1 and 4 go to group 1, bucket 5 to group 2.
+  for (auto bucket : {1, 4, 5}) {
+    task->addSplit(
+        "0",
+        exec::Split(HiveConnectorSplitBuilder(filePath->getPath())
+                        .tableBucketNumber(bucket)
+                        .build()));
+  }
+  task->noMoreSplits("0");
+
+  int32_t numRead = 0;
+  while (cursor->moveNext()) {
+    numRead += cursor->current()->size();
+  }
+  EXPECT_EQ(exec::TaskState::kFinished, task->state());
+  EXPECT_EQ(std::unordered_set<int32_t>({1, 2}), getCompletedSplitGroups(task));
+  EXPECT_EQ(numRead, 3 * 2'000);
+}
+
 TEST_F(GroupedExecutionTest, allGroupSplitsReceivedBeforeTaskStart) {
   // Create source file - we will read from it in 6 splits.
   const size_t numSplits{6};
@@ -540,6 +540,90 @@ TEST_P(HashJoinBridgeTest, multiThreading) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, withSpillRestoreMerge) {
+  auto joinBridge = createJoinBridge();
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    joinBridge->addBuilder();
+  }
+  joinBridge->start();
+
+  // Four partitions of the first spill level and one of the next.
+  SpillPartitionSet spillPartitionSet;
+  for (int32_t partition = 0; partition < 4; ++partition) {
+    const SpillPartitionId id(0, partition);
+    spillPartitionSet.emplace(
+        id,
+        std::make_unique<SpillPartition>(
+            id, makeFakeSpillFiles(numSpillFilesPerPartition_)));
+  }
+  const SpillPartitionId nextLevelId(numPartitionBits_, 0);
+  spillPartitionSet.emplace(
+      nextLevelId,
+      std::make_unique<SpillPartition>(
+          nextLevelId, makeFakeSpillFiles(numSpillFilesPerPartition_)));
+  const uint64_t partitionSize = spillPartitionSet.begin()->second->size();
+  joinBridge->setHashTable(
+      createFakeHashTable(), std::move(spillPartitionSet), false);
+
+  struct {
+    SpillPartitionId restoredId;
+    std::vector<SpillPartitionId> mergedIds;
+  } expectedRestores[] = {
+      // A partition is not merged with a partition of another spill level.
+      {nextLevelId, {}},
+      {SpillPartitionId(0, 0), {SpillPartitionId(0, 1)}},
+      {SpillPartitionId(0, 2), {SpillPartitionId(0, 3)}}};
+  for (const auto& expected : expectedRestores) {
+    SCOPED_TRACE(expected.restoredId.toString());
+    // Two partitions fit within the limit but three do not.
+    ASSERT_TRUE(joinBridge->probeFinished(2 * partitionSize + 1));
+    uint32_t numFiles{0};
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      ContinueFuture future = ContinueFuture::makeEmpty();
+      auto spillInput = joinBridge->spillInputOrFuture(&future);
+      ASSERT_TRUE(spillInput.has_value());
+      ASSERT_NE(spillInput->spillPartition, nullptr);
+      ASSERT_EQ(spillInput->spillPartition->id(), expected.restoredId);
+      numFiles += spillInput->spillPartition->numFiles();
+    }
+    ASSERT_EQ(
+        numFiles, numSpillFilesPerPartition_ * (1 + expected.mergedIds.size()));
+
+    joinBridge->setHashTable(createFakeHashTable(), {}, false);
+    ContinueFuture future = ContinueFuture::makeEmpty();
+    auto buildResult = joinBridge->tableOrFuture(&future);
+    ASSERT_TRUE(buildResult.has_value());
+    ASSERT_EQ(buildResult->restoredPartitionId, expected.restoredId);
+    ASSERT_EQ(buildResult->mergedPartitionIds, expected.mergedIds);
+  }
+  ASSERT_FALSE(joinBridge->probeFinished(2 * partitionSize + 1));
+}
+
+TEST_P(HashJoinBridgeTest, skewedKeys) {
+  auto joinBridge = createJoinBridge();
+  joinBridge->start();
+  auto skewedKeyHashes = std::make_shared<SkewedKeyHashes>();
+  skewedKeyHashes->insert(17);
+  joinBridge->setHashTable(createFakeHashTable(), {}, false, skewedKeyHashes);
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  auto buildResult = joinBridge->tableOrFuture(&future);
+  ASSERT_TRUE(buildResult.has_value());
+  ASSERT_EQ(buildResult->skewedKeyHashes, skewedKeyHashes);
+
+  // The shared probe inputs are taken in the order in which they are added.
+  ASSERT_EQ(joinBridge->takeSkewedProbeInput(), nullptr);
+  std::vector<RowVectorPtr> inputs;
+  for (int32_t i = 0; i < 3; ++i) {
+    inputs.push_back(std::make_shared<RowVector>(
+        pool_.get(), ROW({}), nullptr, i + 1, std::vector<VectorPtr>{}));
+    joinBridge->addSkewedProbeInput(inputs.back());
+  }
+  for (const auto& input : inputs) {
+    ASSERT_EQ(joinBridge->takeSkewedProbeInput(), input);
+  }
+  ASSERT_EQ(joinBridge->takeSkewedProbeInput(), nullptr);
+}
+
 TEST_P(HashJoinBridgeTest, isHashJoinMemoryPools) {
   auto root = memory::memoryManager()->addRootPool("isHashBuildMemoryPool");
   struct {
@@ -574,6 +658,44 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
     HashJoinBridgeTest,
     testing::ValuesIn(HashJoinBridgeTest::getTestParams()));
 
+TEST(HashJoinBridgeTest, buildWorkQueue) {
+  auto queue = std::make_shared<JoinBuildWorkQueue>(nullptr);
+  auto bridge = std::make_shared<HashJoinBridge>();
+  ASSERT_EQ(bridge->buildWorkQueue(), nullptr);
+  bridge->setBuildWorkQueue(queue);
+  ASSERT_EQ(bridge->buildWorkQueue(), queue);
+
+  uint64_t numItems{0};
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_TRUE(queue->runOrWait(&future, numItems));
+  ASSERT_TRUE(future.valid());
+  ASSERT_FALSE(future.isReady());
+  ASSERT_EQ(numItems, 0);
+
+  // Queued items wake up the waiting helpers and run on the helper thread.
+  int32_t numRun{0};
+  queue->add([&]() { ++numRun; });
+  queue->add([&]() { ++numRun; });
+  ASSERT_TRUE(future.isReady());
+  ASSERT_EQ(numRun, 0);
+  future = ContinueFuture::makeEmpty();
+  ASSERT_TRUE(queue->runOrWait(&future, numItems));
+  ASSERT_EQ(numRun, 2);
+  ASSERT_EQ(numItems, 2);
+  ASSERT_FALSE(future.isReady());
+
+  queue->close();
+  ASSERT_TRUE(future.isReady());
+  future = ContinueFuture::makeEmpty();
+  ASSERT_FALSE(queue->runOrWait(&future, numItems));
+  ASSERT_FALSE(future.valid());
+
+  // Items added after close run inline.
+  queue->add([&]() { ++numRun; });
+  ASSERT_EQ(numRun, 3);
+  ASSERT_EQ(numItems, 2);
+}
+
 TEST(HashJoinBridgeTest, needRightSideJoin) {
   for (int i = 0; i < static_cast<int>(core::JoinType::kNumJoinTypes); ++i) {
     const core::JoinType joinType = static_cast<core::JoinType>(i);
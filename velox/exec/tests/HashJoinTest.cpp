@@ -25,6 +25,7 @@
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/SpillHistory.h"
 #include "velox/exec/tests/utils/ArbitratorTestUtil.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/Cursor.h"
@@ -4093,6 +4094,50 @@ TEST_F(HashJoinTest, lazyVectors) {
   }
 }
 
+TEST_F(HashJoinTest, lazyProbePayloadLoadedForMatchesOnly) {
+  // Of 1'000 probe rows, only every 100th has a match. The payload column is
+  // loaded for the matching rows only, also when the output of the batch is
+  // split into several batches.
+  constexpr vector_size_t kNumProbeRows = 1'000;
+  auto buildVector = makeRowVector(
+      {"u_c0", "u_c1"},
+      {makeFlatVector<int32_t>(10, [](auto row) { return row * 100; }),
+       makeFlatVector<int64_t>(10, folly::identity)});
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>(10, [](auto row) { return row * 1'000; }),
+       makeFlatVector<int64_t>(10, folly::identity)});
+
+  for (const auto outputBatchRows : {1'000, 3}) {
+    SCOPED_TRACE(fmt::format("outputBatchRows: {}", outputBatchRows));
+    auto probeVector = makeRowVector(
+        {makeFlatVector<int32_t>(kNumProbeRows, folly::identity),
+         makeLazyFlatVector<int64_t>(
+             kNumProbeRows,
+             [](auto row) { return row * 10; },
+             [](auto /*row*/) { return false; },
+             10,
+             [](auto index) { return index * 100; })});
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values({probeVector})
+                    .hashJoin(
+                        {"c0"},
+                        {"u_c0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values({buildVector})
+                            .planNode(),
+                        "",
+                        {"c1", "u_c1"})
+                    .planNode();
+    AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kPreferredOutputBatchRows,
+            std::to_string(outputBatchRows))
+        .assertResults(expected);
+  }
+}
+
 TEST_F(HashJoinTest, lazyVectorNotLoadedInFilter) {
   // Ensure that if lazy vectors are temporarily wrapped during a filter's
   // execution and remain unloaded, the temporary wrap is promptly
@@ -4774,6 +4819,124 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  const int32_t numSplits = 10;
+  const int32_t numRowsProbe = 3'000;
+  // More distinct keys than VectorHasher::kMaxDistinct so that the build side
+  // has no exact filter.
+  const int32_t numRowsBuild = 120'000;
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsProbe, [&](auto row) { return i * numRowsProbe + row; }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(
+            exec::Split(makeHiveConnectorSplit(file->getPath())));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  // Every third probe key has a match.
+  std::vector<RowVectorPtr> buildVectors{makeRowVector({
+      makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row * 3; }),
+  })};
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto probeType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .values(buildVectors)
+                       .project({"c0 AS u_c0"})
+                       .planNode();
+
+  for (const auto maxSize : {"0", "1MB"}) {
+    SCOPED_TRACE(fmt::format("maxSize: {}", maxSize));
+    const bool enabled = std::string(maxSize) != "0";
+    core::PlanNodeId probeScanId;
+    auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(probeType)
+                  .capturePlanNodeId(probeScanId)
+                  .hashJoin(
+                      {"c0"},
+                      {"u_c0"},
+                      buildSide,
+                      "",
+                      {"c0", "c1"},
+                      core::JoinType::kInner)
+                  .planNode();
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(op))
+        .makeInputSplits(makeInputSplits(probeScanId))
+        .config(
+            core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+            enabled ? "1048576" : "0")
+        .referenceQuery("SELECT t.c0, t.c1 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+          if (hasSpill || !enabled) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+          } else {
+            ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+            // A Bloom filter never replaces the join.
+            ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+            ASSERT_LT(
+                getInputPositions(task, 1), numRowsProbe * numSplits / 2);
+          }
+        })
+        .run();
+  }
+
+  // Merging with a probe side filter that has no exact combination with the
+  // Bloom filter keeps both.
+  core::PlanNodeId probeScanId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(probeType, {"c0 NOT IN (0, 3, 6)"})
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    buildSide,
+                    "",
+                    {"c0", "c1"},
+                    core::JoinType::kInner)
+                .planNode();
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .planNode(std::move(op))
+      .makeInputSplits(makeInputSplits(probeScanId))
+      .config(
+          core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize, "1048576")
+      .referenceQuery(
+          "SELECT t.c0, t.c1 FROM t, u "
+          "WHERE t.c0 = u.c0 AND t.c0 NOT IN (0, 3, 6)")
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        if (hasSpill) {
+          return;
+        }
+        ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+        ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits / 2);
+      })
+      .run();
+}
+
 TEST_F(HashJoinTest, dynamicFiltersStatsWithChainedJoins) {
   const int32_t numSplits = 10;
   const int32_t numProbeRows = 333;
@@ -6733,6 +6896,60 @@ TEST_F(HashJoinTest, maxSpillBytes) {
   }
 }
 
+TEST_F(HashJoinTest, spillHistory) {
+  const vector_size_t kNumRows = 1'000;
+  auto probe = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(kNumRows, [](auto row) { return row * 2; })});
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row * 3; }),
+       makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; })});
+  createDuckDbTable("t", {probe});
+  createDuckDbTable("u", {build});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"c1", "u1"})
+                  .planNode();
+  const auto fingerprint = SpillHistory::fingerprint(*plan);
+  SpillHistory::instance().clear();
+
+  auto runJoin = [&](int32_t maxSpillLevel) {
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(core::QueryConfig::kSpillEnabled, true)
+                    .config(core::QueryConfig::kJoinSpillEnabled, true)
+                    .config(core::QueryConfig::kSpillHistoryEnabled, true)
+                    .config(core::QueryConfig::kSpillNumPartitionBits, 1)
+                    .config(core::QueryConfig::kMaxSpillLevel, maxSpillLevel)
+                    .assertResults("SELECT c1, u1 FROM t, u WHERE c0 = u0");
+    return taskSpilledStats(*task).first;
+  };
+
+  // The first run spills its restored partitions again and needs 2 partition
+  // bits in total.
+  runJoin(1);
+  ASSERT_EQ(SpillHistory::instance().partitionBits(fingerprint), 2);
+
+  // The next run starts with 4 partitions.
+  const auto buildStats = runJoin(0);
+  ASSERT_EQ(buildStats.spilledPartitions, 4);
+  ASSERT_EQ(SpillHistory::instance().partitionBits(fingerprint), 2);
+  SpillHistory::instance().clear();
+}
+
 TEST_F(HashJoinTest, onlyHashBuildMaxSpillBytes) {
   const auto rowType =
       ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
@@ -7797,4 +8014,241 @@ DEBUG_ONLY_TEST_F(HashJoinTest, spillCheckOnLeftSemiFilterWithDynamicFilters) {
       })
       .run();
 }
+
+TEST_F(HashJoinTest, hashTableCache) {
+  auto probeVectors = makeBatches(3, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t_k", "t_v"},
+        {makeFlatVector<int32_t>(100, [](auto row) { return row % 23; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  });
+  auto buildVectors = makeBatches(2, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"u_k", "u_v"},
+        {makeFlatVector<int32_t>(50, [](auto row) { return row % 31; }),
+         makeFlatVector<int64_t>(50, [](auto row) { return row * 10; })});
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  // Both tasks run the same join. The probe side of the first one is a scan
+  // without splits, so it keeps the table it built until 'noMoreSplits'.
+  core::PlanNodeId scanNodeId;
+  core::PlanNodeId joinNodeId;
+  auto makePlan = [&](bool scanProbe) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    PlanBuilder probe(planNodeIdGenerator);
+    if (scanProbe) {
+      probe.tableScan(asRowType(probeVectors[0]->type()))
+          .capturePlanNodeId(scanNodeId);
+    } else {
+      probe.values(probeVectors);
+    }
+    return probe
+        .hashJoin(
+            {"t_k"},
+            {"u_k"},
+            PlanBuilder(planNodeIdGenerator).values(buildVectors).planNode(),
+            "",
+            {"t_k", "t_v", "u_v"},
+            core::JoinType::kInner,
+            false,
+            true)
+        .capturePlanNodeId(joinNodeId)
+        .planNode();
+  };
+
+  auto queryCtx = core::QueryCtx::create(
+      driverExecutor_.get(),
+      core::QueryConfig{{}},
+      {},
+      cache::AsyncDataCache::getInstance(),
+      nullptr,
+      nullptr,
+      "hashTableCache");
+  auto builderTask = Task::create(
+      "hashTableCache.builder",
+      core::PlanFragment{makePlan(true)},
+      0,
+      queryCtx,
+      Task::ExecutionMode::kParallel,
+      [](RowVectorPtr /*unused*/, ContinueFuture* /*unused*/) {
+        return BlockingReason::kNotBlocked;
+      });
+  builderTask->start(1);
+
+  auto task = AssertQueryBuilder(makePlan(false), duckDbQueryRunner_)
+                  .queryCtx(queryCtx)
+                  .assertResults(
+                      "SELECT t_k, t_v, u_v FROM t, u WHERE t_k = u_k");
+  auto planStats = toPlanStats(task->taskStats()).at(joinNodeId);
+  ASSERT_EQ(planStats.customStats.at("hashTableCacheHits").sum, 1);
+
+  builderTask->noMoreSplits(scanNodeId);
+  ASSERT_TRUE(waitForTaskCompletion(builderTask.get()));
+  planStats = toPlanStats(builderTask->taskStats()).at(joinNodeId);
+  ASSERT_EQ(planStats.customStats.count("hashTableCacheHits"), 0);
+  ASSERT_GT(planStats.customStats.count(BaseHashTable::kBuildWallNanos), 0);
+}
+
+TEST_F(HashJoinTest, parallelJoinBuildOnPeers) {
+  auto probeVectors = makeBatches(4, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t_k", "t_v"},
+        {makeFlatVector<int32_t>(1'000, [](auto row) { return row % 1'237; }),
+         makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  });
+  auto buildVectors = makeBatches(8, [&](int32_t batch) {
+    return makeRowVector(
+        {"u_k", "u_v"},
+        {makeFlatVector<int32_t>(
+             1'000, [&](auto row) { return (batch * 1'000 + row) * 3; }),
+         makeFlatVector<int64_t>(1'000, [](auto row) { return row * 10; })});
+  });
+  // Each of the 4 Drivers produces all the values.
+  createDuckDbTable("t", makeCopies(probeVectors, 4));
+  createDuckDbTable("u", makeCopies(buildVectors, 4));
+
+  for (const auto joinType :
+       {core::JoinType::kInner, core::JoinType::kLeftSemiFilter}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    core::PlanNodeId joinNodeId;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors, true)
+                    .hashJoin(
+                        {"t_k"},
+                        {"u_k"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors, true)
+                            .planNode(),
+                        "",
+                        joinType == core::JoinType::kInner
+                            ? std::vector<std::string>{"t_k", "t_v", "u_v"}
+                            : std::vector<std::string>{"t_k", "t_v"},
+                        joinType)
+                    .capturePlanNodeId(joinNodeId)
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kMinTableRowsForParallelJoinBuild, "0")
+            .maxDrivers(4)
+            .assertResults(
+                joinType == core::JoinType::kInner
+                    ? "SELECT t_k, t_v, u_v FROM t, u WHERE t_k = u_k"
+                    : "SELECT t_k, t_v FROM t "
+                      "WHERE t_k IN (SELECT u_k FROM u)");
+    auto planStats = toPlanStats(task->taskStats()).at(joinNodeId);
+    ASSERT_GT(planStats.customStats.count(BaseHashTable::kBuildWallNanos), 0);
+  }
+}
+
+TEST_F(HashJoinTest, spillRestoreMerge) {
+  auto probeVectors = makeBatches(4, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t_k", "t_v"},
+        {makeFlatVector<int32_t>(1'000, [](auto row) { return row % 1'237; }),
+         makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  });
+  auto buildVectors = makeBatches(8, [&](int32_t batch) {
+    return makeRowVector(
+        {"u_k", "u_v"},
+        {makeFlatVector<int32_t>(
+             1'000, [&](auto row) { return (batch * 1'000 + row) * 3; }),
+         makeFlatVector<int64_t>(1'000, [](auto row) { return row * 10; })});
+  });
+  // Each of the 4 Drivers produces all the values.
+  createDuckDbTable("t", makeCopies(probeVectors, 4));
+  createDuckDbTable("u", makeCopies(buildVectors, 4));
+
+  core::PlanNodeId joinNodeId;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors, true)
+                  .hashJoin(
+                      {"t_k"},
+                      {"u_k"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors, true)
+                          .planNode(),
+                      "",
+                      {"t_k", "t_v", "u_v"},
+                      core::JoinType::kInner)
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+
+  for (const uint64_t restoreMergeBytes : {0UL, 1UL << 30}) {
+    SCOPED_TRACE(fmt::format("restoreMergeBytes: {}", restoreMergeBytes));
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(core::QueryConfig::kSpillEnabled, true)
+            .config(core::QueryConfig::kJoinSpillEnabled, true)
+            .config(core::QueryConfig::kMaxSpillLevel, 0)
+            .config(
+                core::QueryConfig::kJoinSpillRestoreMergeBytes,
+                restoreMergeBytes)
+            .maxDrivers(4)
+            .assertResults("SELECT t_k, t_v, u_v FROM t, u WHERE t_k = u_k");
+    auto planStats = toPlanStats(task->taskStats()).at(joinNodeId);
+    ASSERT_GT(planStats.spilledPartitions, 0);
+    // All the spilled partitions fit in one restore with the large limit.
+    ASSERT_EQ(
+        planStats.customStats.count("spillRestoreMergedPartitions"),
+        restoreMergeBytes == 0 ? 0 : 1);
+  }
+}
+
+TEST_F(HashJoinTest, skewedKeySharing) {
+  // Key 0 has 100 rows in each build batch. The other keys are distinct.
+  auto buildVectors = makeBatches(2, [&](int32_t batch) {
+    return makeRowVector(
+        {"u_k", "u_v"},
+        {makeFlatVector<int32_t>(
+             200,
+             [&](auto row) { return row < 100 ? 0 : batch * 1'000 + row; }),
+         makeFlatVector<int64_t>(200, [](auto row) { return row; })});
+  });
+  auto probeVectors = makeBatches(4, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t_k", "t_v"},
+        {makeFlatVector<int32_t>(100, [](auto row) { return row % 20; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  });
+  // Each of the 4 Drivers produces all the values.
+  createDuckDbTable("t", makeCopies(probeVectors, 4));
+  createDuckDbTable("u", makeCopies(buildVectors, 4));
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    core::PlanNodeId joinNodeId;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors, true)
+                    .hashJoin(
+                        {"t_k"},
+                        {"u_k"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors, true)
+                            .planNode(),
+                        "",
+                        {"t_k", "t_v", "u_v"},
+                        joinType)
+                    .capturePlanNodeId(joinNodeId)
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kJoinSkewedKeyMinRows, 50)
+            .maxDrivers(4)
+            .assertResults(fmt::format(
+                "SELECT t_k, t_v, u_v FROM t {} JOIN u ON t_k = u_k",
+                joinType == core::JoinType::kInner ? "INNER" : "LEFT"));
+    auto planStats = toPlanStats(task->taskStats()).at(joinNodeId);
+    ASSERT_EQ(planStats.customStats.at("skewedBuildKeys").sum, 1);
+    // The 5 probe rows of key 0 in each of the 16 probe batches are shared.
+    ASSERT_EQ(planStats.customStats.at("sharedSkewedProbeRows").sum, 80);
+  }
+}
 } // namespace
@@ -619,6 +619,15 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, partitionedJoinProbe) {
+  // 5M distinct keys make a table of 8M slots, which is over
+  // kMinPartitionedProbeBytes, so that the probes are reordered by the range
+  // of the table they hit.
+  auto type = ROW({"k1", "k2", "k3"}, {BIGINT(), BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  testCycle(BaseHashTable::HashMode::kHash, 2'500'000, 2, type, 3);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -832,6 +841,39 @@ TEST_P(HashTableTest, checkSizeValidation) {
   ASSERT_EQ(table->capacity(), 512 << 10);
 }
 
+TEST_P(HashTableTest, parallelRehash) {
+  auto rowType = ROW({"a"}, {BIGINT()});
+  auto table = createHashTableForAggregation(rowType, 1);
+  table->setParallelRehash(executor_.get(), 1'000);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  auto testHelper = HashTableTestHelper<false>::create(table.get());
+  testHelper.setHashMode(BaseHashTable::HashMode::kHash, 0);
+
+  constexpr int32_t kBatchSize = 10'000;
+  std::vector<RowVectorPtr> batches;
+  std::vector<char*> allInserted;
+  for (auto i = 0; i < 50; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+        kBatchSize, [&](auto row) { return (i * kBatchSize + row) * 7; })}));
+    insertGroups(*batches.back(), *lookup, *table);
+    ASSERT_EQ(lookup->newGroups.size(), kBatchSize);
+    allInserted.insert(
+        allInserted.end(), lookup->hits.begin(), lookup->hits.end());
+  }
+  ASSERT_EQ(table->numDistinct(), 50 * kBatchSize);
+  ASSERT_GT(table->stats().numRehashes, 1);
+  table->checkConsistency();
+
+  // All the keys are found after the parallel rehashes.
+  for (auto i = 0; i < batches.size(); ++i) {
+    insertGroups(*batches[i], *lookup, *table);
+    ASSERT_TRUE(lookup->newGroups.empty());
+    for (auto row = 0; row < kBatchSize; ++row) {
+      ASSERT_EQ(lookup->hits[row], allInserted[i * kBatchSize + row]);
+    }
+  }
+}
+
 TEST_P(HashTableTest, listNullKeyRows) {
   VectorPtr keys = makeFlatVector<int64_t>(500, folly::identity);
   testListNullKeyRows(keys, BaseHashTable::HashMode::kArray);
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TestIndexConnector.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+class IndexLookupJoinTest : public HiveConnectorTestBase {
+ protected:
+  static constexpr const char* kIndexConnectorId = "test-index";
+  static constexpr const char* kAsyncIndexConnectorId = "test-index-async";
+
+  void SetUp() override {
+    HiveConnectorTestBase::SetUp();
+    connector::registerConnector(
+        std::make_shared<TestIndexConnector>(kIndexConnectorId));
+    connector::registerConnector(std::make_shared<TestIndexConnector>(
+        kAsyncIndexConnectorId, lookupExecutor_.get()));
+  }
+
+  void TearDown() override {
+    connector::unregisterConnector(kAsyncIndexConnectorId);
+    connector::unregisterConnector(kIndexConnectorId);
+    HiveConnectorTestBase::TearDown();
+  }
+
+  // Returns a TableScanNode that looks up the rows of 'table' with
+  // 'connectorId'.
+  std::shared_ptr<const core::TableScanNode> makeLookupSource(
+      const RowVectorPtr& table,
+      const std::string& connectorId = kIndexConnectorId) {
+    const auto& type = asRowType(table->type());
+    std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+        assignments;
+    for (const auto& name : type->names()) {
+      assignments[name] = std::make_shared<TestIndexColumnHandle>(name);
+    }
+    return std::make_shared<core::TableScanNode>(
+        "lookup",
+        type,
+        std::make_shared<TestIndexTableHandle>(connectorId, table),
+        assignments);
+  }
+
+  std::vector<RowVectorPtr> makeProbeVectors(
+      int32_t numVectors,
+      vector_size_t size) {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < numVectors; ++i) {
+      vectors.push_back(makeRowVector(
+          {"c0", "c1"},
+          {makeFlatVector<int64_t>(
+               size,
+               [](auto row) { return row % 523; },
+               [](auto row) { return row % 97 == 0; }),
+           makeFlatVector<int32_t>(
+               size, [i, size](auto row) { return i * size + row; })}));
+    }
+    return vectors;
+  }
+
+  // Returns a table with keys 0 to 399 where even keys have 2 rows.
+  RowVectorPtr makeTable() {
+    const vector_size_t size = 600;
+    return makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             size, [](auto row) { return row < 400 ? row : (row - 400) * 2; }),
+         makeFlatVector<int64_t>(size, [](auto row) { return row * 10; })});
+  }
+
+  std::unique_ptr<folly::CPUThreadPoolExecutor> lookupExecutor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(2)};
+};
+
+TEST_F(IndexLookupJoinTest, basic) {
+  auto probeVectors = makeProbeVectors(5, 1'000);
+  auto table = makeTable();
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", {table});
+
+  for (const auto& connectorId : {kIndexConnectorId, kAsyncIndexConnectorId}) {
+    SCOPED_TRACE(connectorId);
+    for (const auto& batchSize : {"1000", "7"}) {
+      SCOPED_TRACE(batchSize);
+      auto plan = PlanBuilder()
+                      .values(probeVectors)
+                      .indexLookupJoin(
+                          {"c0"},
+                          {"u0"},
+                          makeLookupSource(table, connectorId),
+                          {"c1", "u1", "c0"})
+                      .planNode();
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchRows, batchSize)
+          .assertResults("SELECT c1, u1, c0 FROM t, u WHERE c0 = u0");
+
+      plan = PlanBuilder()
+                 .values(probeVectors)
+                 .indexLookupJoin(
+                     {"c0"},
+                     {"u0"},
+                     makeLookupSource(table, connectorId),
+                     {"c0", "c1", "u1"},
+                     core::JoinType::kLeft)
+                 .planNode();
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchRows, batchSize)
+          .assertResults("SELECT c0, c1, u1 FROM t LEFT JOIN u ON c0 = u0");
+    }
+  }
+}
+
+TEST_F(IndexLookupJoinTest, multipleKeys) {
+  auto probe = makeRowVector(
+      {"c0", "c1", "c2"},
+      {makeFlatVector<int32_t>({1, 1, 2, 2, 3}),
+       makeFlatVector<StringView>({"a", "b", "a", "b", "a"}),
+       makeFlatVector<int64_t>({10, 11, 12, 13, 14})});
+  auto table = makeRowVector(
+      {"u0", "u1", "u2"},
+      {makeFlatVector<int32_t>({1, 2, 2, 3}),
+       makeFlatVector<StringView>({"b", "a", "a", "b"}),
+       makeFlatVector<int64_t>({100, 200, 201, 300})});
+
+  auto plan = PlanBuilder()
+                  .values({probe})
+                  .indexLookupJoin(
+                      {"c0", "c1"},
+                      {"u0", "u1"},
+                      makeLookupSource(table),
+                      {"c2", "u2"},
+                      core::JoinType::kLeft)
+                  .planNode();
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>({11, 12, 12, 10, 13, 14}),
+       makeNullableFlatVector<int64_t>(
+           {100, 200, 201, std::nullopt, std::nullopt, std::nullopt})});
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+TEST_F(IndexLookupJoinTest, stats) {
+  auto probeVectors = makeProbeVectors(3, 100);
+  auto plan = PlanBuilder()
+                  .values(probeVectors)
+                  .indexLookupJoin(
+                      {"c0"},
+                      {"u0"},
+                      makeLookupSource(makeTable()),
+                      {"u1"})
+                  .planNode();
+  std::shared_ptr<Task> joinTask;
+  AssertQueryBuilder(plan).copyResults(pool(), joinTask);
+  auto planStats = toPlanStats(joinTask->taskStats());
+  const auto& joinStats = planStats.at(plan->id());
+  ASSERT_EQ(joinStats.inputRows, 300);
+  ASSERT_EQ(joinStats.customStats.at("numLookups").sum, 3);
+}
+
+TEST_F(IndexLookupJoinTest, unsupportedConnector) {
+  auto lookupSource = std::dynamic_pointer_cast<const core::TableScanNode>(
+      PlanBuilder()
+          .tableScan(ROW({"u0", "u1"}, {BIGINT(), BIGINT()}))
+          .planNode());
+  auto plan = PlanBuilder()
+                  .values(makeProbeVectors(1, 10))
+                  .indexLookupJoin({"c0"}, {"u0"}, lookupSource, {"c1", "u1"})
+                  .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).copyResults(pool()),
+      "does not support index lookup");
+}
+
+TEST_F(IndexLookupJoinTest, planNode) {
+  auto table = makeTable();
+  auto lookupSource = makeLookupSource(table);
+
+  auto plan = PlanBuilder()
+                  .values(makeProbeVectors(1, 10))
+                  .indexLookupJoin(
+                      {"c0"},
+                      {"u0"},
+                      lookupSource,
+                      {"c1", "u1"},
+                      core::JoinType::kLeft)
+                  .planNode();
+  ASSERT_EQ("-- IndexLookupJoin[1]\n", plan->toString());
+  ASSERT_EQ(
+      "-- IndexLookupJoin[1][LEFT c0=u0, lookup table: test-index-table] "
+      "-> c1:INTEGER, u1:BIGINT\n",
+      plan->toString(true, false));
+
+  VELOX_ASSERT_THROW(
+      PlanBuilder()
+          .values(makeProbeVectors(1, 10))
+          .indexLookupJoin(
+              {"c0"},
+              {"u0"},
+              lookupSource,
+              {"c1", "u1"},
+              core::JoinType::kRight),
+      "IndexLookupJoin only supports inner and left join");
+  VELOX_ASSERT_THROW(
+      PlanBuilder()
+          .values(makeProbeVectors(1, 10))
+          .indexLookupJoin({"c1"}, {"u0"}, lookupSource, {"c1", "u1"}),
+      "Join key types on the left and right sides must match");
+}
+} // namespace
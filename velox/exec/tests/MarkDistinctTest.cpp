@@ -141,3 +141,25 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, sharedHashTable) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row % 1'237; }),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data});
+
+  // Each of the 4 drivers sees all of 'data'. With a shared hash table, each
+  // distinct key is marked once across the drivers.
+  auto plan = PlanBuilder()
+                  .values({data}, true)
+                  .markDistinct("c0_distinct", {"c0"})
+                  .filter("c0_distinct")
+                  .project({"c0"})
+                  .planNode();
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .maxDrivers(4)
+      .config(core::QueryConfig::kSharedHashTableEnabled, "true")
+      .assertResults("SELECT DISTINCT c0 FROM tmp");
+}
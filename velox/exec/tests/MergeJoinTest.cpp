@@ -16,9 +16,12 @@
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/Spill.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 #include "folly/experimental/EventCount.h"
 
@@ -206,6 +209,16 @@ TEST_F(MergeJoinTest, duplicateMatch) {
       [](auto row) { return row / 2; }, [](auto row) { return row / 3; });
 }
 
+TEST_F(MergeJoinTest, longRuns) {
+  // Long runs of left keys without a match on the right and long runs of
+  // duplicate keys.
+  testJoin<int32_t>(
+      [](auto row) { return row; }, [](auto row) { return row * 97; });
+  testJoin<int32_t>(
+      [](auto row) { return row / 300; },
+      [](auto row) { return row / 200 * 3; });
+}
+
 TEST_F(MergeJoinTest, allRowsMatch) {
   std::vector<VectorPtr> leftKeys = {
       makeFlatVector<int32_t>(2, [](auto /* row */) { return 5; }),
@@ -420,6 +433,87 @@ TEST_F(MergeJoinTest, leftJoinFilter) {
   }
 }
 
+TEST_F(MergeJoinTest, spill) {
+  // Key matches span several batches on both sides. Every other left key has
+  // no match on the right.
+  auto left = makeRowVector(
+      {"t_c0", "t_c1"},
+      {
+          makeFlatVector<int32_t>(600, [](auto row) { return row / 150; }),
+          makeFlatVector<int32_t>(600, [](auto row) { return row; }),
+      });
+  auto right = makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<int32_t>(400, [](auto row) { return row / 100 * 2; }),
+          makeFlatVector<int32_t>(400, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  struct {
+    core::JoinType joinType;
+    std::string filter;
+    std::string sql;
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "",
+       "SELECT t_c0, t_c1, u_c1 FROM t, u WHERE t_c0 = u_c0"},
+      {core::JoinType::kInner,
+       "(t_c1 + u_c1) % 3 = 0",
+       "SELECT t_c0, t_c1, u_c1 FROM t, u "
+       "WHERE t_c0 = u_c0 AND (t_c1 + u_c1) % 3 = 0"},
+      {core::JoinType::kLeft,
+       "",
+       "SELECT t_c0, t_c1, u_c1 FROM t LEFT JOIN u ON t_c0 = u_c0"},
+      {core::JoinType::kLeft,
+       "(t_c1 + u_c1) % 3 = 0",
+       "SELECT t_c0, t_c1, u_c1 FROM t LEFT JOIN u "
+       "ON t_c0 = u_c0 AND (t_c1 + u_c1) % 3 = 0"},
+  };
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(fmt::format(
+        "{} join, filter: {}",
+        core::joinTypeName(testData.joinType),
+        testData.filter));
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinId;
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values(split(left, 40))
+            .mergeJoin(
+                {"t_c0"},
+                {"u_c0"},
+                PlanBuilder(planNodeIdGenerator)
+                    .values(split(right, 30))
+                    .planNode(),
+                testData.filter,
+                {"t_c0", "t_c1", "u_c1"},
+                testData.joinType)
+            .capturePlanNodeId(joinId)
+            .planNode();
+
+    auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "64")
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kJoinSpillEnabled, "true")
+            .spillDirectory(spillDirectory->getPath())
+            .assertResults(testData.sql);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = taskStats.at(joinId);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledFiles, 0);
+  }
+}
+
 // Verify that both left-side and right-side pipelines feeding the merge join
 // always run single-threaded.
 TEST_F(MergeJoinTest, numDrivers) {
@@ -441,6 +441,56 @@ TEST_F(MultiFragmentTest, mergeExchange) {
   EXPECT_LT(0, mergeExchangeStats.rawInputBytes);
 }
 
+TEST_F(MultiFragmentTest, mergeExchangePrefetch) {
+  setupSources(8, 1000);
+  // Small output buffers make the sources send many pages.
+  configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] = "2048";
+  configSettings_[core::QueryConfig::kMergeExchangePrefetchSources] = "4";
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  std::vector<std::string> sortTaskIds;
+  RowTypePtr outputType;
+  for (auto i = 0; i < filePaths_.size(); ++i) {
+    auto sortTaskId = makeTaskId("orderby", tasks.size());
+    sortTaskIds.push_back(sortTaskId);
+    auto sortPlan = PlanBuilder()
+                        .tableScan(rowType_)
+                        .orderBy({"c0"}, false)
+                        .partitionedOutput({}, 1)
+                        .planNode();
+    auto sortTask = makeTask(sortTaskId, sortPlan);
+    tasks.push_back(sortTask);
+    sortTask->start(1);
+    addHiveSplits(sortTask, {filePaths_[i]});
+    outputType = sortPlan->outputType();
+  }
+
+  auto finalSortTaskId = makeTaskId("orderby", tasks.size());
+  core::PlanNodeId mergeExchangeId;
+  auto finalSortPlan = PlanBuilder()
+                           .mergeExchange(outputType, {"c0"})
+                           .capturePlanNodeId(mergeExchangeId)
+                           .partitionedOutput({}, 1)
+                           .planNode();
+  auto task = makeTask(finalSortTaskId, finalSortPlan);
+  tasks.push_back(task);
+  task->start(1);
+  addRemoteSplits(task, sortTaskIds);
+
+  auto op = PlanBuilder().exchange(outputType).planNode();
+  assertQueryOrdered(
+      op, {finalSortTaskId}, "SELECT * FROM tmp ORDER BY 1 NULLS LAST", {0});
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+
+  const auto finalSortStats = toPlanStats(task->taskStats());
+  const auto& mergeExchangeStats = finalSortStats.at(mergeExchangeId);
+  EXPECT_EQ(8'000, mergeExchangeStats.inputRows);
+  EXPECT_EQ(8'000, mergeExchangeStats.rawInputRows);
+}
+
 // Test reordering and dropping columns in PartitionedOutput operator.
 TEST_F(MultiFragmentTest, partitionedOutput) {
   setupSources(10, 1000);
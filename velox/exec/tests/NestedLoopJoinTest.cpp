@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -488,3 +489,132 @@ TEST_F(NestedLoopJoinTest, allTypes) {
       "SELECT t0, u0 FROM t {0} JOIN u ON t.t0 {1} u0 AND t1 {1} u1 AND t2 {1} u2 AND t3 {1} u3 AND t4 {1} u4 AND t5 {1} u5 AND t6 {1} u6");
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
+
+TEST_F(NestedLoopJoinTest, rangeJoin) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 4; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(
+             300,
+             [i](auto row) { return (row * 37 + i * 101) % 2'000; },
+             nullEvery(41)),
+         makeFlatVector<int32_t>(300, [](auto row) { return row % 7; })}));
+  }
+  // Intervals of up to 30 that start at multiples of 5, with some null
+  // bounds. The second vector starts in the middle of the first.
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 2; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1", "u2"},
+        {makeFlatVector<int64_t>(
+             400,
+             [i](auto row) { return ((row * 13) % 400 + i * 200) * 5; },
+             nullEvery(29)),
+         makeFlatVector<int64_t>(
+             400,
+             [i](auto row) {
+               return ((row * 13) % 400 + i * 200) * 5 + row % 31;
+             },
+             nullEvery(23)),
+         makeFlatVector<int32_t>(400, [](auto row) { return row % 5; })}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  const std::vector<std::string> conditions = {
+      "t0 BETWEEN u0 AND u1",
+      "t0 >= u0 AND t0 < u1 AND t1 <> u2",
+      "u0 <= t0 AND t1 = u2",
+  };
+  for (const auto& condition : conditions) {
+    for (const auto joinType : joinTypes_) {
+      SCOPED_TRACE(
+          fmt::format("{} joinType:{}", condition, joinTypeName(joinType)));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      core::PlanNodeId joinNodeId;
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values(probeVectors)
+                      .nestedLoopJoin(
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(buildVectors)
+                              .planNode(),
+                          condition,
+                          {"t0", "t1", "u0", "u1"},
+                          joinType)
+                      .capturePlanNodeId(joinNodeId)
+                      .planNode();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+              .assertResults(fmt::format(
+                  "SELECT t0, t1, u0, u1 FROM t {} JOIN u ON {}",
+                  joinTypeName(joinType),
+                  condition));
+
+      // The join condition is evaluated only for the rows within the bounds.
+      const auto stats = toPlanStats(task->taskStats()).at(joinNodeId);
+      ASSERT_LT(
+          stats.customStats.at("numRangeJoinCandidates").sum,
+          4 * 300 * 2 * 400);
+    }
+  }
+}
+
+TEST_F(NestedLoopJoinTest, buildCompression) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 3; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int64_t>(
+             200, [i](auto row) { return 1'000'000 + row * 3 + i; }),
+         makeFlatVector<int32_t>(200, [](auto row) { return row % 11; })}));
+  }
+  // 'u0' fits in 16 bits after biasing, 'u1' and 'u2' in 8 bits and 'u3'
+  // does not fit.
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 2; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1", "u2", "u3"},
+        {makeFlatVector<int64_t>(
+             300,
+             [i](auto row) { return 1'000'000 + row * 2 + i * 600; },
+             nullEvery(17)),
+         makeFlatVector<int32_t>(300, [](auto row) { return row % 11; }),
+         makeFlatVector<int16_t>(300, [](auto row) { return row % 7 - 3; }),
+         makeFlatVector<int64_t>(300, [](auto row) {
+           return row % 2 == 0 ? std::numeric_limits<int64_t>::max() : row;
+         })}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  const std::vector<std::string> conditions = {
+      "t0 BETWEEN u0 AND u0 + 10",
+      "t1 = u1 AND t0 < u0",
+  };
+  for (const auto& condition : conditions) {
+    for (const auto joinType : joinTypes_) {
+      SCOPED_TRACE(
+          fmt::format("{} joinType:{}", condition, joinTypeName(joinType)));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values(probeVectors)
+                      .nestedLoopJoin(
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(buildVectors)
+                              .planNode(),
+                          condition,
+                          {"t0", "u0", "u1", "u2", "u3"},
+                          joinType)
+                      .planNode();
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kNestedLoopJoinBuildCompression, "true")
+          .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+          .assertResults(fmt::format(
+              "SELECT t0, u0, u1, u2, u3 FROM t {} JOIN u ON {}",
+              joinTypeName(joinType),
+              condition));
+    }
+  }
+}
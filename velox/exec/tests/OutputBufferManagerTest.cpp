@@ -20,6 +20,7 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using namespace facebook::velox;
@@ -1396,6 +1397,128 @@ TEST_F(OutputBufferManagerTest, outOfOrderAcks) {
   bufferManager_->removeTask(taskId);
 }
 
+TEST_F(OutputBufferManagerTest, spill) {
+  const vector_size_t size = 100;
+  const std::string taskId = "t0";
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto planFragment = exec::test::PlanBuilder()
+                          .values({std::dynamic_pointer_cast<RowVector>(
+                              BatchMaker::createBatch(rowType_, 100, *pool_))})
+                          .planFragment();
+  auto queryCtx = core::QueryCtx::create(
+      executor_.get(),
+      core::QueryConfig(
+          {{core::QueryConfig::kMaxOutputBufferSize, "1000"},
+           {core::QueryConfig::kMaxOutputBufferSpillBytes, "1000000000"}}));
+  auto task = Task::create(
+      taskId,
+      std::move(planFragment),
+      0,
+      std::move(queryCtx),
+      Task::ExecutionMode::kParallel);
+  task->setSpillDirectory(spillDirectory->getPath());
+  bufferManager_->initializeTask(
+      task, PartitionedOutputNode::Kind::kPartitioned, 2, 1);
+
+  // Each page is over the buffer limit and is spilled instead of blocking the
+  // producer.
+  constexpr int32_t kNumPages = 10;
+  std::vector<std::string> expected;
+  for (auto i = 0; i < kNumPages; ++i) {
+    auto page = makeSerializedPage(rowType_, size);
+    expected.push_back(page->getIOBuf()->moveToFbString().toStdString());
+    ContinueFuture future;
+    ASSERT_FALSE(bufferManager_->enqueue(taskId, 0, std::move(page), &future));
+  }
+  noMoreData(taskId);
+
+  auto stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+  ASSERT_EQ(stats.bufferedPages, 0);
+  ASSERT_EQ(stats.spilledPages, kNumPages);
+  ASSERT_EQ(stats.totalSpilledPages, kNumPages);
+  ASSERT_EQ(stats.spilledBytes, stats.totalBytesSent);
+  ASSERT_EQ(stats.numSpillFiles, kNumPages);
+  ASSERT_EQ(stats.buffersStats[0].pagesBuffered, kNumPages);
+  ASSERT_EQ(stats.buffersStats[0].pagesSpilled, kNumPages);
+
+  // The spilled pages are read back in order, followed by the end marker.
+  for (auto i = 0; i < kNumPages; ++i) {
+    bool received = false;
+    ASSERT_TRUE(bufferManager_->getData(
+        taskId,
+        0,
+        1,
+        i,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t sequence,
+            std::vector<int64_t> remainingBytes) {
+          ASSERT_EQ(sequence, i);
+          ASSERT_EQ(pages.size(), 1);
+          ASSERT_EQ(remainingBytes.size(), kNumPages - i - 1);
+          ASSERT_EQ(pages[0]->moveToFbString().toStdString(), expected[i]);
+          received = true;
+        }));
+    ASSERT_TRUE(received);
+    acknowledge(taskId, 0, i + 1);
+  }
+  fetchEndMarker(taskId, 0, kNumPages);
+  fetchEndMarker(taskId, 1, 0);
+
+  stats = getStats(taskId);
+  ASSERT_EQ(stats.spilledBytes, 0);
+  ASSERT_EQ(stats.spilledPages, 0);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+  ASSERT_EQ(stats.totalPagesSent, kNumPages);
+  ASSERT_EQ(stats.buffersStats[0].pagesSent, kNumPages);
+
+  // The spill files are removed once read.
+  auto fs = filesystems::getFileSystem(spillDirectory->getPath(), nullptr);
+  ASSERT_TRUE(fs->list(spillDirectory->getPath()).empty());
+
+  bufferManager_->removeTask(taskId);
+}
+
+TEST_F(OutputBufferManagerTest, spillOverBudget) {
+  const std::string taskId = "t0";
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto planFragment = exec::test::PlanBuilder()
+                          .values({std::dynamic_pointer_cast<RowVector>(
+                              BatchMaker::createBatch(rowType_, 100, *pool_))})
+                          .planFragment();
+  auto queryCtx = core::QueryCtx::create(
+      executor_.get(),
+      core::QueryConfig(
+          {{core::QueryConfig::kMaxOutputBufferSize, "1000"},
+           {core::QueryConfig::kMaxOutputBufferSpillBytes, "10"}}));
+  auto task = Task::create(
+      taskId,
+      std::move(planFragment),
+      0,
+      std::move(queryCtx),
+      Task::ExecutionMode::kParallel);
+  task->setSpillDirectory(spillDirectory->getPath());
+  bufferManager_->initializeTask(
+      task, PartitionedOutputNode::Kind::kPartitioned, 1, 1);
+
+  // The pages do not fit in the spill budget. The producer is blocked and
+  // no spill file is created.
+  for (auto i = 0; i < 3; ++i) {
+    ContinueFuture future;
+    ASSERT_TRUE(bufferManager_->enqueue(
+        taskId, 0, makeSerializedPage(rowType_, 100), &future));
+  }
+  auto stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedPages, 3);
+  ASSERT_EQ(stats.spilledPages, 0);
+  ASSERT_EQ(stats.numSpillFiles, 0);
+  auto fs = filesystems::getFileSystem(spillDirectory->getPath(), nullptr);
+  ASSERT_TRUE(fs->list(spillDirectory->getPath()).empty());
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_F(OutputBufferManagerTest, errorInQueue) {
   auto queue = std::make_shared<ExchangeQueue>();
   queue->setError("Forced failure");
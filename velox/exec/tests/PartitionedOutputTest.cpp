@@ -15,6 +15,7 @@
  */
 #include "velox/exec/PartitionedOutput.h"
 #include <gtest/gtest.h>
+#include "velox/exec/ExchangeQueue.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -181,4 +182,123 @@ TEST_F(PartitionedOutputTest, keyChannelNotAtBeginningWithNulls) {
           .count()));
 }
 
+TEST_F(PartitionedOutputTest, manyDestinations) {
+  // Verifies that rows sorted by partition reach the right destinations when
+  // most destinations get a few rows per batch.
+  constexpr int32_t kNumDestinations = 1'000;
+  constexpr int32_t kNumBatches = 5;
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row % 3'001; }),
+       makeFlatVector<int64_t>(10'000, [](auto row) { return row; })});
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, kNumBatches)
+                  .partitionedOutput({"p1"}, kNumDestinations)
+                  .planNode();
+
+  auto taskId = "local://test-partitioned-output-many-destinations-0";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext({}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  auto rowType = asRowType(input->type());
+  std::unordered_map<int64_t, int32_t> keyDestinations;
+  int64_t numRows = 0;
+  for (auto destination = 0; destination < kNumDestinations; ++destination) {
+    for (auto& iobuf : getAllData(taskId, destination)) {
+      SerializedPage page(std::move(iobuf));
+      auto stream = page.prepareStreamForDeserialize();
+      while (!stream.atEnd()) {
+        RowVectorPtr data;
+        VectorStreamGroup::read(&stream, pool(), rowType, &data);
+        auto keys = data->childAt(0)->asFlatVector<int64_t>();
+        for (auto row = 0; row < data->size(); ++row) {
+          auto it = keyDestinations.emplace(keys->valueAt(row), destination);
+          ASSERT_EQ(it.first->second, destination);
+        }
+        numRows += data->size();
+      }
+    }
+  }
+  ASSERT_EQ(numRows, kNumBatches * input->size());
+  ASSERT_EQ(keyDestinations.size(), 3'001);
+
+  ASSERT_TRUE(waitForTaskCompletion(
+      task.get(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::seconds(10))
+          .count()));
+}
+
+TEST_F(PartitionedOutputTest, skewedPartition) {
+  // 90% of the rows have key 0. After the partition of key 0 is found to be
+  // skewed, its rows are spread over 4 destinations.
+  constexpr int32_t kNumDestinations = 8;
+  constexpr int32_t kReplicaGroupSize = 4;
+  constexpr int32_t kNumBatches = 20;
+  auto input = makeRowVector(
+      {"p1"},
+      {makeFlatVector<int64_t>(
+          10'000, [](auto row) { return row % 10 == 0 ? row : 0; })});
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, kNumBatches)
+                  .partitionedOutputSkewAware(
+                      {"p1"}, kNumDestinations, kReplicaGroupSize)
+                  .planNode();
+
+  auto taskId = "local://test-partitioned-output-skew-0";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext({}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  auto rowType = asRowType(input->type());
+  std::unordered_map<int64_t, std::unordered_set<int32_t>> keyDestinations;
+  int64_t numRows = 0;
+  for (auto destination = 0; destination < kNumDestinations; ++destination) {
+    for (auto& iobuf : getAllData(taskId, destination)) {
+      SerializedPage page(std::move(iobuf));
+      auto stream = page.prepareStreamForDeserialize();
+      while (!stream.atEnd()) {
+        RowVectorPtr data;
+        VectorStreamGroup::read(&stream, pool(), rowType, &data);
+        auto keys = data->childAt(0)->asFlatVector<int64_t>();
+        for (auto row = 0; row < data->size(); ++row) {
+          keyDestinations[keys->valueAt(row)].insert(destination);
+        }
+        numRows += data->size();
+      }
+    }
+  }
+  ASSERT_EQ(numRows, kNumBatches * input->size());
+  // Other keys of the skewed partition are spread over the same group.
+  const auto& skewedGroup = keyDestinations[0];
+  ASSERT_EQ(skewedGroup.size(), kReplicaGroupSize);
+  for (const auto& [key, destinations] : keyDestinations) {
+    if (destinations.size() > 1) {
+      for (auto destination : destinations) {
+        ASSERT_EQ(skewedGroup.count(destination), 1) << key;
+      }
+    }
+  }
+
+  ASSERT_TRUE(waitForTaskCompletion(
+      task.get(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::seconds(10))
+          .count()));
+  auto stats = task->taskStats().pipelineStats[0].operatorStats.back();
+  ASSERT_EQ(
+      stats.runtimeStats.at(PartitionedOutput::kSkewedPartitions).sum, 1);
+}
+
 } // namespace facebook::velox::exec::test
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/serialization/BinarySerialization.h"
 #include "velox/exec/PartitionFunction.h"
 #include "velox/exec/WindowFunction.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -61,6 +62,10 @@ class PlanNodeSerdeTest : public testing::Test,
         velox::ISerializable::deserialize<core::PlanNode>(serialized, pool());
 
     ASSERT_EQ(plan->toString(true, true), copy->toString(true, true));
+
+    auto binaryCopy = velox::ISerializable::deserialize<core::PlanNode>(
+        deserializeBinary(serializeBinary(serialized)), pool());
+    ASSERT_EQ(plan->toString(true, true), binaryCopy->toString(true, true));
   }
 
   std::vector<RowVectorPtr> data_;
@@ -331,6 +336,12 @@ TEST_F(PlanNodeSerdeTest, partitionedOutput) {
              .partitionedOutput({"c0"}, 50, {"c1", {"c2"}, "c0"})
              .planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .partitionedOutputSkewAware({"c0"}, 50, 4)
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, project) {
@@ -512,6 +523,25 @@ TEST_F(PlanNodeSerdeTest, scan) {
   testSerde(plan);
 }
 
+TEST_F(PlanNodeSerdeTest, indexLookupJoin) {
+  auto lookupSource = std::dynamic_pointer_cast<const core::TableScanNode>(
+      PlanBuilder(pool_.get())
+          .tableScan(ROW({"u0", "u1"}, {BIGINT(), INTEGER()}))
+          .planNode());
+  for (auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    auto plan = PlanBuilder()
+                    .values({data_})
+                    .indexLookupJoin(
+                        {"c0"},
+                        {"u0"},
+                        lookupSource,
+                        {"c0", "c1", "u1"},
+                        joinType)
+                    .planNode();
+    testSerde(plan);
+  }
+}
+
 TEST_F(PlanNodeSerdeTest, topNRowNumber) {
   auto plan = PlanBuilder()
                   .values({data_})
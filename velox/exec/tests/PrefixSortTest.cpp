@@ -217,6 +217,49 @@ TEST_F(PrefixSortTest, multipleKeys) {
   }
 }
 
+TEST_F(PrefixSortTest, stringPrefixes) {
+  // Strings that are equal, differ or end within and after the encoded prefix
+  // and continue with zero bytes.
+  const std::vector<std::optional<std::string>> strings = {
+      "abcdefghijklmnopq",
+      "abcdefghijklmnopp",
+      "abcdefghijkl",
+      "abcdefghijk",
+      std::string("abcdefghijk\0", 12),
+      std::string("abcdefghijkl\0\0", 14),
+      "abcdefghijklm",
+      std::nullopt,
+      "",
+      std::string("\0", 1),
+      "b",
+      "abcdefghijklmnopq",
+      "\xff\xfe",
+      std::nullopt,
+      "abcdefghijklz"};
+  std::vector<std::optional<StringView>> views;
+  for (const auto& string : strings) {
+    views.push_back(
+        string.has_value() ? std::optional(StringView(string.value()))
+                           : std::nullopt);
+  }
+  const auto numRows = views.size();
+  const auto varchars = makeNullableFlatVector<StringView>(views);
+  const auto varbinaries =
+      makeNullableFlatVector<StringView>(views, VARBINARY());
+  const auto ints = makeFlatVector<int32_t>(
+      numRows, [](vector_size_t row) { return row % 3; });
+
+  for (const auto& keys : {varchars, varbinaries}) {
+    testPrefixSort({kAsc}, makeRowVector({keys}));
+    testPrefixSort({kDesc}, makeRowVector({keys}));
+  }
+
+  // A key after the string key is compared by RowContainer.
+  testPrefixSort({kAsc, kAsc}, makeRowVector({varchars, ints}));
+  testPrefixSort({kDesc, kAsc}, makeRowVector({varchars, ints}));
+  testPrefixSort({kAsc, kDesc}, makeRowVector({ints, varchars}));
+}
+
 TEST_F(PrefixSortTest, fuzz) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
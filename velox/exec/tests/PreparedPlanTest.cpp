@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PreparedPlan.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/Task.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class PreparedPlanTest : public OperatorTestBase {
+ protected:
+  // Returns a function for PlanBuilder::addNode() that adds an InputNode.
+  std::function<core::PlanNodePtr(std::string, core::PlanNodePtr)>
+  inputNode() const {
+    return [rowType = rowType_](
+               std::string id, core::PlanNodePtr /* source */) {
+      return std::make_shared<PreparedPlan::InputNode>(id, rowType);
+    };
+  }
+
+  const RowTypePtr rowType_{ROW({"c0"}, {BIGINT()})};
+};
+
+TEST_F(PreparedPlanTest, filterProject) {
+  auto plan = PlanBuilder()
+                  .addNode(inputNode())
+                  .filter("c0 % 2 = 0")
+                  .project({"c0 * 10 AS p0"})
+                  .planNode();
+  auto prepared = PreparedPlan::create(plan, core::QueryCtx::create());
+  const auto* task = prepared->task().get();
+  for (auto i = 0; i < 100; ++i) {
+    auto results = prepared->execute(makeRowVector({makeFlatVector<int64_t>(
+        10, [&](auto row) { return i * 10 + row; })}));
+    ASSERT_EQ(1, results.size());
+    assertEqualVectors(
+        makeRowVector(
+            {"p0"},
+            {makeFlatVector<int64_t>(
+                5, [&](auto row) { return (i * 10 + row * 2) * 10; })}),
+        results[0]);
+  }
+  ASSERT_EQ(100, prepared->numExecutions());
+  ASSERT_EQ(task, prepared->task().get());
+  ASSERT_TRUE(task->isRunning());
+
+  // An input with no passing rows gives no results.
+  ASSERT_TRUE(prepared
+                  ->execute(makeRowVector({makeFlatVector<int64_t>({1, 3})}))
+                  .empty());
+
+  auto taskPtr = prepared->task();
+  prepared.reset();
+  ASSERT_TRUE(taskPtr->isFinished());
+}
+
+TEST_F(PreparedPlanTest, hashJoin) {
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(10, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(10, [](auto row) { return row * 100; })});
+  auto generator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId buildId;
+  auto buildPlan = PlanBuilder(generator)
+                       .values({build})
+                       .capturePlanNodeId(buildId)
+                       .planNode();
+  auto plan = PlanBuilder(generator)
+                  .addNode(inputNode())
+                  .hashJoin({"c0"}, {"u0"}, buildPlan, "", {"c0", "u1"})
+                  .planNode();
+  auto prepared = PreparedPlan::create(plan, core::QueryCtx::create());
+  for (auto i = 0; i < 20; ++i) {
+    // Keys 0, 2, ..., 18, of which 0 to 8 match.
+    auto results = prepared->execute(makeRowVector(
+        {makeFlatVector<int64_t>(10, [](auto row) { return row * 2; })}));
+    ASSERT_EQ(1, results.size());
+    assertEqualVectors(
+        makeRowVector(
+            {"c0", "u1"},
+            {makeFlatVector<int64_t>({0, 2, 4, 6, 8}),
+             makeFlatVector<int64_t>({0, 200, 400, 600, 800})}),
+        results[0]);
+  }
+  // The build side ran once.
+  auto stats = toPlanStats(prepared->task()->taskStats());
+  ASSERT_EQ(10, stats.at(buildId).outputRows);
+}
+
+TEST_F(PreparedPlanTest, emptyBuild) {
+  auto generator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildPlan =
+      PlanBuilder(generator)
+          .values({makeRowVector(
+              {"u0"}, {makeFlatVector<int64_t>(std::vector<int64_t>{})})})
+          .planNode();
+  auto plan = PlanBuilder(generator)
+                  .addNode(inputNode())
+                  .hashJoin({"c0"}, {"u0"}, buildPlan, "", {"c0", "u0"})
+                  .planNode();
+  auto prepared = PreparedPlan::create(plan, core::QueryCtx::create());
+  for (auto i = 0; i < 3; ++i) {
+    ASSERT_TRUE(
+        prepared->execute(makeRowVector({makeFlatVector<int64_t>({1, 2})}))
+            .empty());
+  }
+}
+
+TEST_F(PreparedPlanTest, unsupportedPlans) {
+  VELOX_ASSERT_THROW(
+      PreparedPlan::create(
+          PlanBuilder()
+              .addNode(inputNode())
+              .singleAggregation({}, {"sum(c0)"})
+              .planNode(),
+          core::QueryCtx::create()),
+      "Unsupported node in the output pipeline of a prepared plan");
+  VELOX_ASSERT_THROW(
+      PreparedPlan::create(
+          PlanBuilder()
+              .values({makeRowVector({makeFlatVector<int64_t>({1})})})
+              .planNode(),
+          core::QueryCtx::create()),
+      "Unsupported node in the output pipeline of a prepared plan");
+
+  auto generator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildPlan = PlanBuilder(generator)
+                       .values({makeRowVector(
+                           {"u0"}, {makeFlatVector<int64_t>({1, 2})})})
+                       .planNode();
+  VELOX_ASSERT_THROW(
+      PreparedPlan::create(
+          PlanBuilder(generator)
+              .addNode(inputNode())
+              .hashJoin(
+                  {"c0"},
+                  {"u0"},
+                  buildPlan,
+                  "",
+                  {"c0", "u0"},
+                  core::JoinType::kFull)
+              .planNode(),
+          core::QueryCtx::create()),
+      "Unsupported join type in a prepared plan");
+}
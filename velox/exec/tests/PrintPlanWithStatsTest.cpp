@@ -192,6 +192,8 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          ioWaitNanos      [ ]* sum: .+, count: .+ min: .+, max: .+"},
        {"          localReadBytes      [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          maxSingleIoWaitNanos[ ]*sum: .+, count: 1, min: .+, max: .+"},
+       {"          missedPreloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
+        true},
        {"          numLocalRead        [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          numPrefetch         [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          numRamRead          [ ]* sum: 40, count: 1, min: 40, max: 40"},
@@ -287,6 +289,8 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        ioWaitNanos      [ ]* sum: .+, count: .+ min: .+, max: .+"},
          {"        localReadBytes   [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
          {"        maxSingleIoWaitNanos[ ]*sum: .+, count: 1, min: .+, max: .+"},
+         {"        missedPreloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
+          true},
          {"        numLocalRead     [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        numPrefetch      [ ]* sum: .+, count: .+, min: .+, max: .+"},
          {"        numRamRead       [ ]* sum: 6, count: 1, min: 6, max: 6"},
@@ -311,3 +315,48 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        totalScanTime    [ ]* sum: .+, count: .+, min: .+, max: .+"}});
   }
 }
+
+TEST_F(PrintPlanWithStatsTest, exprStats) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+    }));
+  }
+
+  auto op = PlanBuilder().values(vectors).project({"c0 + c1 * c1"}).planNode();
+
+  std::shared_ptr<exec::Task> task;
+  AssertQueryBuilder(op)
+      .config(core::QueryConfig::kExprProfileSamplingInterval, "2")
+      .copyResults(pool(), task);
+  ensureTaskCompletion(task.get());
+  auto stats = exec::toPlanStats(task->taskStats());
+  const auto& exprStats = stats.at("1").exprStats;
+  ASSERT_FALSE(exprStats.empty());
+  ASSERT_EQ(exprStats[0].name, "plus");
+  ASSERT_EQ(exprStats[0].depth, 0);
+  ASSERT_EQ(exprStats[0].stats.numProcessedVectors, 10);
+  ASSERT_EQ(exprStats[0].stats.numProcessedRows, 10'000);
+  // Every other batch is timed.
+  ASSERT_EQ(exprStats[0].stats.numTimedVectors, 5);
+
+  compareOutputs(
+      ::testing::UnitTest::GetInstance()->current_test_info()->name(),
+      printPlanWithStats(*op, task->taskStats()),
+      {{"-- Project\\[1\\].+"},
+       {"   Output: 10000 rows .+"},
+       {"      plus \\[cpu time: .+, rows: 10000, batches: 10, timed batches: 5, peel cpu time: .+, allocated vectors: .+\\]"},
+       {"         .+"},
+       {"         multiply \\[cpu time: .+, rows: 10000, batches: 10, timed batches: 5, .+\\]"},
+       {"            .+"},
+       {"            .+"},
+       {"  -- Values\\[0\\].+"},
+       {"     .+"}});
+
+  // No expression statistics by default.
+  AssertQueryBuilder(op).copyResults(pool(), task);
+  ensureTaskCompletion(task.get());
+  ASSERT_TRUE(exec::toPlanStats(task->taskStats()).at("1").exprStats.empty());
+}
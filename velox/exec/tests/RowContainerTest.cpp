@@ -1729,6 +1729,72 @@ TEST_F(RowContainerTest, nans) {
   ASSERT_EQ(rowContainer->compare(rows[0], rows[1], 0, {}), 0);
 }
 
+TEST_F(RowContainerTest, sortKeyComparator) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          100, [](auto row) { return row % 7; }, nullEvery(11)),
+      makeFlatVector<StringView>(
+          100,
+          [](auto row) {
+            return StringView::makeInline(std::to_string(row % 13));
+          },
+          nullEvery(5)),
+      makeArrayVector<int32_t>(
+          100,
+          [](auto row) { return row % 3; },
+          [](auto row) { return row % 17; },
+          nullEvery(9)),
+  });
+  auto rowContainer = makeRowContainer(
+      {BIGINT(), VARCHAR(), ARRAY(INTEGER())}, {}, false);
+  auto rows = store(*rowContainer, data);
+
+  auto sign = [](int32_t result) { return result < 0 ? -1 : result > 0; };
+  auto compareRows = [&](const char* left,
+                         const char* right,
+                         const std::vector<CompareFlags>& flags) {
+    const auto numKeys = flags.empty() ? 3 : flags.size();
+    for (auto i = 0; i < numKeys; ++i) {
+      if (auto result = rowContainer->compare(
+              left, right, i, flags.empty() ? CompareFlags() : flags[i])) {
+        return result;
+      }
+    }
+    return 0;
+  };
+  const CompareFlags kAscNullsFirst{true, true};
+  const CompareFlags kAscNullsLast{false, true};
+  const CompareFlags kDescNullsFirst{true, false};
+  const CompareFlags kDescNullsLast{false, false};
+  const std::vector<std::vector<CompareFlags>> testFlags = {
+      {},
+      {kAscNullsFirst},
+      {kDescNullsLast},
+      {kDescNullsFirst, kAscNullsLast, kAscNullsFirst},
+      {kAscNullsLast, kDescNullsFirst, kDescNullsLast},
+  };
+  for (const auto& flags : testFlags) {
+    SortKeyComparator comparator(rowContainer.get(), flags);
+    for (auto i = 0; i < rows.size(); ++i) {
+      for (auto j = 0; j < rows.size(); j += 3) {
+        ASSERT_EQ(
+            sign(compareRows(rows[i], rows[j], flags)),
+            sign(comparator.compare(rows[i], rows[j])));
+      }
+    }
+
+    auto sortedRows = rows;
+    comparator.sort(
+        folly::Range<char**>(sortedRows.data(), sortedRows.size()),
+        [](auto begin, auto end, const auto& less) {
+          std::sort(begin, end, less);
+        });
+    for (auto i = 1; i < sortedRows.size(); ++i) {
+      ASSERT_LE(compareRows(sortedRows[i - 1], sortedRows[i], flags), 0);
+    }
+  }
+}
+
 TEST_F(RowContainerTest, toString) {
   std::vector<TypePtr> keyTypes = {BIGINT(), VARCHAR()};
   std::vector<TypePtr> dependentTypes = {TINYINT(), REAL(), ARRAY(BIGINT())};
@@ -2016,3 +2082,92 @@ TEST_F(RowContainerTest, hugeIntStoreWithNulls) {
   data->extractColumn(rows.data(), kNumRows, kColumnIndex, extracted);
   assertEqualVectors(source, extracted);
 }
+
+TEST_F(RowContainerTest, columnarDependents) {
+  constexpr int32_t kNumRows = 3'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return row * 3; }, nullEvery(7)),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return fmt::format("long string payload {}", row); },
+          nullEvery(5)),
+      makeArrayVector<int32_t>(
+          kNumRows,
+          [](auto row) { return row % 4; },
+          [](auto row, auto index) { return row + index; }),
+  });
+  const auto& rowType = asRowType(data->type());
+  auto container = std::make_unique<RowContainer>(
+      std::vector<TypePtr>{BIGINT()},
+      true, // nullableKeys
+      std::vector<Accumulator>{},
+      std::vector<TypePtr>{
+          rowType->childAt(1), rowType->childAt(2), rowType->childAt(3)},
+      false, // hasNext
+      false, // isJoinBuild
+      false, // hasProbedFlag
+      false, // hasNormalizedKey
+      pool_.get(),
+      nullptr, // stringAllocator
+      true); // columnarDependents
+  EXPECT_FALSE(container->isColumnar(0));
+  EXPECT_TRUE(container->isColumnar(1));
+  EXPECT_TRUE(container->isColumnar(2));
+  // Complex types stay in the row.
+  EXPECT_FALSE(container->isColumnar(3));
+
+  std::vector<char*> rows(kNumRows);
+  auto storeAll = [&]() {
+    for (auto i = 0; i < kNumRows; ++i) {
+      rows[i] = container->newRow();
+    }
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      DecodedVector decoded(*data->childAt(column));
+      for (auto i = 0; i < kNumRows; ++i) {
+        container->store(decoded, i, rows[i], column);
+      }
+    }
+  };
+  auto checkAll = [&]() {
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      auto result = BaseVector::create(rowType->childAt(column), 0, pool());
+      container->extractColumn(rows.data(), kNumRows, column, result);
+      assertEqualVectors(data->childAt(column), result);
+    }
+  };
+  storeAll();
+  checkAll();
+
+  // Reverses the rows through row numbers.
+  std::vector<vector_size_t> rowNumbers(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rowNumbers[i] = kNumRows - 1 - i;
+  }
+  auto reversed = BaseVector::create(VARCHAR(), 0, pool());
+  container->extractColumn(rows.data(), rowNumbers, 2, 0, reversed);
+  for (auto i = 0; i < kNumRows; ++i) {
+    ASSERT_TRUE(data->childAt(2)->equalValueAt(
+        reversed.get(), kNumRows - 1 - i, i));
+  }
+
+  // Erased rows keep their row numbers and are reused with new values.
+  container->eraseRows(folly::Range<char**>(rows.data(), kNumRows / 2));
+  container->checkConsistency();
+  std::vector<char*> remaining(rows.begin() + kNumRows / 2, rows.end());
+  auto tail = BaseVector::create(VARCHAR(), 0, pool());
+  container->extractColumn(remaining.data(), remaining.size(), 2, tail);
+  assertEqualVectors(
+      data->childAt(2)->slice(kNumRows / 2, remaining.size()), tail);
+  container->eraseRows(
+      folly::Range<char**>(remaining.data(), remaining.size()));
+  EXPECT_EQ(0, container->numRows());
+  storeAll();
+  checkAll();
+
+  container->clear();
+  EXPECT_EQ(0, container->numRows());
+  storeAll();
+  checkAll();
+}
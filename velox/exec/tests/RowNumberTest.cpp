@@ -190,6 +190,41 @@ TEST_F(RowNumberTest, largeInput) {
   testLimit(5'000);
 }
 
+TEST_F(RowNumberTest, sharedHashTable) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row % 7; }),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data, data, data, data});
+
+  // Each of the 4 drivers sees all of 'data'. With a shared hash table, the
+  // row numbers of each partition go from 1 to the number of rows of the
+  // partition across the drivers. The row numbers are assigned to the rows in
+  // any order, so the results only have the keys and the row numbers.
+  auto plan = PlanBuilder()
+                  .values({data}, true)
+                  .rowNumber({"c0"})
+                  .project({"c0", "row_number"})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .maxDrivers(4)
+      .config(core::QueryConfig::kSharedHashTableEnabled, "true")
+      .assertResults(
+          "SELECT c0, row_number() over (partition by c0) FROM tmp");
+
+  plan = PlanBuilder()
+             .values({data}, true)
+             .rowNumber({"c0"}, 100)
+             .project({"c0", "row_number"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .maxDrivers(4)
+      .config(core::QueryConfig::kSharedHashTableEnabled, "true")
+      .assertResults(
+          "SELECT * FROM (SELECT c0, row_number() over (partition by c0) as rn "
+          "FROM tmp) WHERE rn <= 100");
+}
+
 TEST_F(RowNumberTest, spill) {
   std::vector<RowVectorPtr> vectors = createVectors(8, rowType_, fuzzerOpts_);
   createDuckDbTable(vectors);
@@ -248,6 +283,46 @@ TEST_F(RowNumberTest, spill) {
   }
 }
 
+TEST_F(RowNumberTest, spillWithLimit) {
+  const int32_t kNumBatches = 8;
+  const vector_size_t kBatchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(kBatchSize, [](auto row) { return row % 10; }),
+        makeFlatVector<int64_t>(
+            kBatchSize, [&](auto row) { return i * kBatchSize + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+  const auto spillDirectory = exec::test::TempDirectoryPath::create();
+
+  TestScopedSpillInjection scopedSpillInjection(100);
+  core::PlanNodeId rowNumberPlanNodeId;
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->getPath())
+                  .config(core::QueryConfig::kSpillEnabled, true)
+                  .config(core::QueryConfig::kRowNumberSpillEnabled, true)
+                  .plan(PlanBuilder()
+                            .values(vectors)
+                            .rowNumber({"c0"}, 2, false)
+                            .capturePlanNodeId(rowNumberPlanNodeId)
+                            .singleAggregation({"c0"}, {"count(1)"})
+                            .planNode())
+                  .assertResults(
+                      "SELECT c0, least(count(*), 2) FROM tmp GROUP BY 1");
+
+  // Each batch spilled after the hash table has at most 2 rows per partition.
+  auto taskStats = toPlanStats(task->taskStats());
+  auto& planStats = taskStats.at(rowNumberPlanNodeId);
+  ASSERT_GT(planStats.spilledRows, 0);
+  ASSERT_LE(planStats.spilledRows, 10 + (kNumBatches - 1) * 10 * 2);
+  ASSERT_GT(planStats.customStats.at("spillTruncatedRows").sum, 0);
+
+  task.reset();
+  waitForAllTasksToBeDeleted();
+}
+
 TEST_F(RowNumberTest, maxSpillBytes) {
   const auto rowType =
       ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
@@ -29,6 +29,7 @@ namespace {
 const char* const kSimpleAvg = "simple_avg";
 const char* const kSimpleArrayAgg = "simple_array_agg";
 const char* const kSimpleCountNulls = "simple_count_nulls";
+const char* const kSimpleBatchSum = "simple_batch_sum";
 
 class SimpleAverageAggregationTest : public AggregationTestBase {
  protected:
@@ -469,5 +470,133 @@ TEST_F(SimpleCountNullsAggregationTest, basic) {
   testAggregations({vectors}, {}, {"simple_count_nulls(c2)"}, {expected});
 }
 
+// A testing aggregation function that sums its inputs and counts the calls of
+// the batched methods.
+class BatchSumAggregate {
+ public:
+  using InputType = Row<int64_t>;
+  using IntermediateType = int64_t;
+  using OutputType = int64_t;
+
+  static inline int64_t numBatches{0};
+  static inline int64_t numRows{0};
+
+  struct AccumulatorType {
+    int64_t sum_{0};
+
+    AccumulatorType() = delete;
+
+    explicit AccumulatorType(HashStringAllocator* /*allocator*/) {}
+
+    void addInput(HashStringAllocator* /*allocator*/, int64_t value) {
+      ++numRows;
+      sum_ += value;
+    }
+
+    void combine(HashStringAllocator* /*allocator*/, int64_t other) {
+      ++numRows;
+      sum_ += other;
+    }
+
+    void addInputBatch(
+        HashStringAllocator* /*allocator*/,
+        const int64_t* values,
+        const SelectivityVector& rows) {
+      ++numBatches;
+      rows.applyToSelected([&](auto row) { sum_ += values[row]; });
+    }
+
+    void combineBatch(
+        HashStringAllocator* allocator,
+        const int64_t* values,
+        const SelectivityVector& rows) {
+      addInputBatch(allocator, values, rows);
+    }
+
+    bool writeFinalResult(exec::out_type<OutputType>& out) {
+      out = sum_;
+      return true;
+    }
+
+    bool writeIntermediateResult(exec::out_type<IntermediateType>& out) {
+      out = sum_;
+      return true;
+    }
+  };
+};
+
+void registerSimpleBatchSumAggregate() {
+  std::vector<std::shared_ptr<exec::AggregateFunctionSignature>> signatures{
+      exec::AggregateFunctionSignatureBuilder()
+          .returnType("bigint")
+          .intermediateType("bigint")
+          .argumentType("bigint")
+          .build()};
+
+  exec::registerAggregateFunction(
+      kSimpleBatchSum,
+      std::move(signatures),
+      [](core::AggregationNode::Step /*step*/,
+         const std::vector<TypePtr>& /*argTypes*/,
+         const TypePtr& resultType,
+         const core::QueryConfig& /*config*/)
+          -> std::unique_ptr<exec::Aggregate> {
+        return std::make_unique<SimpleAggregateAdapter<BatchSumAggregate>>(
+            resultType);
+      },
+      false /*registerCompanionFunctions*/,
+      true /*overwrite*/);
+}
+
+class SimpleBatchSumAggregationTest : public AggregationTestBase {
+ protected:
+  SimpleBatchSumAggregationTest() {
+    registerSimpleBatchSumAggregate();
+  }
+};
+
+TEST_F(SimpleBatchSumAggregationTest, basic) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+       makeFlatVector<int64_t>(
+           1'000,
+           [](auto row) { return row; },
+           [](auto row) { return row % 11 == 0; })});
+  createDuckDbTable({data});
+
+  BatchSumAggregate::numBatches = 0;
+  testAggregations(
+      {data}, {}, {"simple_batch_sum(c1)"}, "SELECT sum(c1) FROM tmp");
+  ASSERT_GT(BatchSumAggregate::numBatches, 0);
+
+  // Grouped aggregation and dictionary-encoded input use addInput().
+  BatchSumAggregate::numBatches = 0;
+  BatchSumAggregate::numRows = 0;
+  AssertQueryBuilder(
+      PlanBuilder()
+          .values({data})
+          .singleAggregation({"c0"}, {"simple_batch_sum(c1)"})
+          .planNode(),
+      duckDbQueryRunner_)
+      .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY 1");
+  ASSERT_EQ(BatchSumAggregate::numBatches, 0);
+  ASSERT_GT(BatchSumAggregate::numRows, 0);
+
+  auto indices = makeIndicesInReverse(1'000);
+  auto dictionary = makeRowVector(
+      {wrapInDictionary(indices, data->childAt(0)),
+       wrapInDictionary(indices, data->childAt(1))});
+  BatchSumAggregate::numRows = 0;
+  AssertQueryBuilder(
+      PlanBuilder()
+          .values({dictionary})
+          .singleAggregation({}, {"simple_batch_sum(c1)"})
+          .planNode(),
+      duckDbQueryRunner_)
+      .assertResults("SELECT sum(c1) FROM tmp");
+  ASSERT_EQ(BatchSumAggregate::numBatches, 0);
+  ASSERT_GT(BatchSumAggregate::numRows, 0);
+}
+
 } // namespace
 } // namespace facebook::velox::aggregate::test
@@ -450,6 +450,114 @@ TEST_F(SortBufferTest, spill) {
   }
 }
 
+TEST_F(SortBufferTest, prefixSort) {
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::memoryManager()->addLeafPool("prefixSortSource");
+  VectorFuzzer fuzzer({.vectorSize = 1024}, fuzzerPool.get());
+  std::vector<RowVectorPtr> inputVectors;
+  for (int i = 0; i < 3; ++i) {
+    inputVectors.push_back(fuzzer.fuzzRow(inputType_));
+  }
+
+  const auto sortedOutput =
+      [&](const std::optional<PrefixSortConfig>& prefixSortConfig,
+          bool triggerSpill) {
+        auto spillDirectory = exec::test::TempDirectoryPath::create();
+        auto spillConfig = getSpillConfig(spillDirectory->getPath());
+        folly::Synchronized<common::SpillStats> spillStats;
+        auto sortBuffer = std::make_unique<SortBuffer>(
+            inputType_,
+            sortColumnIndices_,
+            sortCompareFlags_,
+            pool_.get(),
+            &nonReclaimableSection_,
+            triggerSpill ? &spillConfig : nullptr,
+            &spillStats,
+            prefixSortConfig);
+        TestScopedSpillInjection scopedSpillInjection(triggerSpill ? 100 : 0);
+        for (const auto& input : inputVectors) {
+          sortBuffer->addInput(input);
+        }
+        sortBuffer->noMoreInput();
+        EXPECT_EQ(spillStats.rlock()->empty(), !triggerSpill);
+
+        std::vector<RowVectorPtr> results;
+        while (auto output = sortBuffer->getOutput(1000)) {
+          // The output vector is reused across getOutput() calls.
+          results.push_back(std::static_pointer_cast<RowVector>(
+              BaseVector::copy(*output)));
+        }
+        return results;
+      };
+
+  for (bool triggerSpill : {false, true}) {
+    SCOPED_TRACE(fmt::format("triggerSpill {}", triggerSpill));
+    const auto expected = sortedOutput(std::nullopt, triggerSpill);
+    const auto actual = sortedOutput(PrefixSortConfig{128, 0}, triggerSpill);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (auto i = 0; i < expected.size(); ++i) {
+      // Only compare the sort key columns as the order of rows with equal keys
+      // is not deterministic.
+      for (const auto channel : sortColumnIndices_) {
+        facebook::velox::test::assertEqualVectors(
+            expected[i]->childAt(channel), actual[i]->childAt(channel));
+      }
+    }
+  }
+}
+
+TEST_F(SortBufferTest, columnarPayload) {
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::memoryManager()->addLeafPool("columnarPayloadSource");
+  VectorFuzzer fuzzer({.vectorSize = 1024}, fuzzerPool.get());
+  std::vector<RowVectorPtr> inputVectors;
+  for (int i = 0; i < 3; ++i) {
+    inputVectors.push_back(fuzzer.fuzzRow(inputType_));
+  }
+
+  const auto sortedOutput = [&](uint32_t columnarPayloadMinColumns,
+                                bool triggerSpill) {
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    auto spillConfig = getSpillConfig(spillDirectory->getPath());
+    folly::Synchronized<common::SpillStats> spillStats;
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        triggerSpill ? &spillConfig : nullptr,
+        &spillStats,
+        std::nullopt,
+        columnarPayloadMinColumns);
+    TestScopedSpillInjection scopedSpillInjection(triggerSpill ? 100 : 0);
+    for (const auto& input : inputVectors) {
+      sortBuffer->addInput(input);
+    }
+    sortBuffer->noMoreInput();
+    EXPECT_EQ(spillStats.rlock()->empty(), !triggerSpill);
+
+    std::vector<RowVectorPtr> results;
+    while (auto output = sortBuffer->getOutput(1000)) {
+      results.push_back(
+          std::static_pointer_cast<RowVector>(BaseVector::copy(*output)));
+    }
+    return results;
+  };
+
+  for (bool triggerSpill : {false, true}) {
+    SCOPED_TRACE(fmt::format("triggerSpill {}", triggerSpill));
+    // The rows are sorted the same way with either layout, so the payload
+    // columns of rows with equal keys come out in the same order.
+    const auto expected = sortedOutput(0, triggerSpill);
+    const auto actual = sortedOutput(1, triggerSpill);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (auto i = 0; i < expected.size(); ++i) {
+      facebook::velox::test::assertEqualVectors(expected[i], actual[i]);
+    }
+  }
+}
+
 TEST_F(SortBufferTest, emptySpill) {
   const std::shared_ptr<memory::MemoryPool> fuzzerPool =
       memory::memoryManager()->addLeafPool("emptySpillSource");
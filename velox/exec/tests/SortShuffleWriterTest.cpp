@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SortShuffleWriter.h"
+
+#include <folly/lang/Bits.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/serializers/UnsafeRowSerializer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+// Assigns row i to partition c0[i] % numPartitions.
+class ModPartitionFunction : public core::PartitionFunction {
+ public:
+  explicit ModPartitionFunction(uint32_t numPartitions)
+      : numPartitions_(numPartitions) {}
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override {
+    auto* keys = input.childAt(0)->asFlatVector<int64_t>();
+    partitions.resize(input.size());
+    for (auto i = 0; i < input.size(); ++i) {
+      partitions[i] = keys->valueAt(i) % numPartitions_;
+    }
+    return std::nullopt;
+  }
+
+ private:
+  const uint32_t numPartitions_;
+};
+
+class SortShuffleWriterTest : public testing::Test,
+                              public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+    filesystems::registerLocalFileSystem();
+  }
+
+  std::string readFile(const std::string& path) {
+    auto fs = filesystems::getFileSystem(path, nullptr);
+    auto file = fs->openFileForRead(path);
+    return file->pread(0, file->size());
+  }
+
+  RowVectorPtr deserialize(const RowTypePtr& type, std::string_view data) {
+    std::vector<ByteRange> ranges{
+        {reinterpret_cast<uint8_t*>(const_cast<char*>(data.data())),
+         static_cast<int32_t>(data.size()),
+         0}};
+    ByteInputStream stream(std::move(ranges));
+    RowVectorPtr result;
+    serializer::spark::UnsafeRowVectorSerde().deserialize(
+        &stream, pool(), type, &result, nullptr);
+    return result;
+  }
+
+  // Writes 'input' with 'maxBufferedBytes' and checks that each partition of
+  // the data file has the rows of 'input' of that partition in input order.
+  // Spills after every 'spillEvery' vectors if not 0.
+  void test(
+      const std::vector<RowVectorPtr>& input,
+      uint32_t numPartitions,
+      uint64_t maxBufferedBytes,
+      int32_t spillEvery,
+      bool expectSpill) {
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    SortShuffleWriter::Options options;
+    options.dataFilePath = tempDirectory->getPath() + "/shuffle.data";
+    options.indexFilePath = tempDirectory->getPath() + "/shuffle.index";
+    options.spillPathPrefix = tempDirectory->getPath() + "/run";
+    options.maxBufferedBytes = maxBufferedBytes;
+    SortShuffleWriter writer(
+        std::make_unique<ModPartitionFunction>(numPartitions),
+        numPartitions,
+        options,
+        pool());
+    for (auto i = 0; i < input.size(); ++i) {
+      writer.write(input[i]);
+      if (spillEvery > 0 && (i + 1) % spillEvery == 0) {
+        writer.spill();
+      }
+    }
+    ASSERT_EQ(expectSpill, writer.numSpillRuns() > 0);
+    const auto partitionSizes = writer.finish();
+    ASSERT_EQ(numPartitions, partitionSizes.size());
+
+    const auto data = readFile(options.dataFilePath);
+    const auto index = readFile(options.indexFilePath);
+    ASSERT_EQ((numPartitions + 1) * sizeof(int64_t), index.size());
+    const auto* offsets = reinterpret_cast<const int64_t*>(index.data());
+    ASSERT_EQ(0, offsets[0]);
+    ASSERT_EQ(data.size(), folly::Endian::big(offsets[numPartitions]));
+
+    const auto type = asRowType(input[0]->type());
+    for (auto partition = 0; partition < numPartitions; ++partition) {
+      SCOPED_TRACE(fmt::format("partition {}", partition));
+      const auto begin = folly::Endian::big(offsets[partition]);
+      const auto end = folly::Endian::big(offsets[partition + 1]);
+      ASSERT_EQ(end - begin, partitionSizes[partition]);
+      auto expected = BaseVector::create<RowVector>(type, 0, pool());
+      for (const auto& vector : input) {
+        auto* keys = vector->childAt(0)->asFlatVector<int64_t>();
+        for (auto row = 0; row < vector->size(); ++row) {
+          if (keys->valueAt(row) % numPartitions == partition) {
+            expected->append(vector->slice(row, 1).get());
+          }
+        }
+      }
+      if (begin == end) {
+        ASSERT_EQ(0, expected->size());
+        continue;
+      }
+      auto actual =
+          deserialize(type, std::string_view(data).substr(begin, end - begin));
+      test::assertEqualVectors(expected, actual);
+    }
+
+    // The spill runs are removed.
+    auto fs = filesystems::getFileSystem(tempDirectory->getPath(), nullptr);
+    ASSERT_EQ(2, fs->list(tempDirectory->getPath()).size());
+  }
+
+  std::vector<RowVectorPtr> makeInput(int32_t numVectors) {
+    std::vector<RowVectorPtr> input;
+    for (auto i = 0; i < numVectors; ++i) {
+      input.push_back(makeRowVector({
+          makeFlatVector<int64_t>(
+              1'000, [&](auto row) { return (row * 7 + i) % 101; }),
+          makeFlatVector<std::string>(
+              1'000,
+              [&](auto row) {
+                return std::string(row % 30, 'a' + (row + i) % 26);
+              }),
+          makeArrayVector<int32_t>(
+              1'000,
+              [](auto row) { return row % 4; },
+              [](auto row) { return row; },
+              nullEvery(7)),
+      }));
+    }
+    return input;
+  }
+};
+
+TEST_F(SortShuffleWriterTest, basic) {
+  test(makeInput(3), 7, 64 << 20, 0, false);
+  test(makeInput(1), 1, 64 << 20, 0, false);
+  // Some partitions are empty.
+  test(makeInput(2), 200, 64 << 20, 0, false);
+}
+
+TEST_F(SortShuffleWriterTest, spill) {
+  // Spills after every vector when over the limit.
+  test(makeInput(5), 13, 1, 0, true);
+  // Merges the runs with the rows that are still buffered.
+  test(makeInput(5), 13, 64 << 20, 2, true);
+}
+} // namespace
@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 
 #include "velox/common/base/RuntimeMetrics.h"
@@ -519,6 +522,482 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, rowFormat) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      compareFlags,
+      1024,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      "",
+      /*rowFormatEnabled=*/true);
+  state.setPartitionSpilled(0);
+
+  // Two sorted runs with interleaved keys.
+  const vector_size_t kNumRows = 1'000;
+  for (auto run = 0; run < 2; ++run) {
+    state.appendToPartition(
+        0,
+        makeRowVector({
+            makeFlatVector<int64_t>(
+                kNumRows, [&](auto row) { return row * 2 + run; }),
+            makeFlatVector<double>(
+                kNumRows,
+                [&](auto row) { return (row * 2 + run) * 0.5; },
+                nullEvery(7)),
+            makeFlatVector<bool>(
+                kNumRows, [&](auto row) { return (row + run) % 3 == 0; }),
+            makeFlatVector<Timestamp>(
+                kNumRows,
+                [&](auto row) { return Timestamp(row, row * 2 + run); },
+                nullEvery(5)),
+            makeFlatVector<int16_t>(
+                kNumRows, [&](auto row) { return row % 100; }),
+        }));
+    state.finishFile(0);
+  }
+
+  auto files = state.finish(0);
+  ASSERT_EQ(files.size(), 2);
+  for (const auto& file : files) {
+    ASSERT_TRUE(file.rowFormat);
+    ASSERT_EQ(file.compressionKind, common::CompressionKind_NONE);
+    ASSERT_EQ(file.size, kNumRows * SpillRowLayout(*file.type).rowSize());
+  }
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+  auto merge =
+      spillPartition.createOrderedReader(1 << 10, pool(), &spillStats_);
+  ASSERT_NE(merge, nullptr);
+  for (auto i = 0; i < 2 * kNumRows; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    const auto run = i % 2;
+    const auto row = i / 2;
+    const auto index = stream->currentIndex();
+    ASSERT_EQ(stream->decoded(0).valueAt<int64_t>(index), i);
+    ASSERT_EQ(stream->decoded(1).isNullAt(index), row % 7 == 0);
+    if (row % 7 != 0) {
+      ASSERT_EQ(stream->decoded(1).valueAt<double>(index), i * 0.5);
+    }
+    ASSERT_EQ(stream->decoded(2).valueAt<bool>(index), (row + run) % 3 == 0);
+    ASSERT_EQ(stream->decoded(3).isNullAt(index), row % 5 == 0);
+    if (row % 5 != 0) {
+      ASSERT_EQ(
+          stream->decoded(3).valueAt<Timestamp>(index), Timestamp(row, i));
+    }
+    ASSERT_EQ(stream->decoded(4).valueAt<int16_t>(index), row % 100);
+    stream->pop();
+  }
+  ASSERT_EQ(merge->next(), nullptr);
+
+  // Variable-width columns are not written in row format.
+  ASSERT_FALSE(SpillRowLayout::supports(*ROW({BIGINT(), VARCHAR()})));
+  ASSERT_FALSE(SpillRowLayout::supports(*ROW({ARRAY(BIGINT())})));
+  ASSERT_TRUE(SpillRowLayout::supports(*ROW({BIGINT(), DOUBLE()})));
+  ASSERT_EQ(SpillRowLayout(*ROW({BIGINT(), BOOLEAN()})).rowSize(), 10);
+}
+
+TEST_P(SpillTest, remoteTier) {
+  auto remoteDirectory = exec::test::TempDirectoryPath::create();
+  folly::CPUThreadPoolExecutor executor(2);
+  for (const bool async : {false, true}) {
+    SCOPED_TRACE(fmt::format("async {}", async));
+    auto localDirectory = exec::test::TempDirectoryPath::create();
+    const auto remotePath = fmt::format(
+        "{}/{}", remoteDirectory->getPath(), async ? "async" : "sync");
+    // The first file stays local and the rest go to 'remotePath'.
+    auto remoteTier = std::make_shared<common::SpillRemoteTier>(
+        remotePath, 1, async ? &executor : nullptr);
+    SpillState state(
+        [&]() -> const std::string& { return localDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        async ? "async" : "sync",
+        1,
+        0,
+        {},
+        1 << 20,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        "",
+        false,
+        remoteTier);
+    state.setPartitionSpilled(0);
+
+    const int kNumFiles = 4;
+    const vector_size_t kNumRows = 100;
+    for (auto i = 0; i < kNumFiles; ++i) {
+      state.appendToPartition(
+          0,
+          makeRowVector({makeFlatVector<int64_t>(
+              kNumRows, [&](auto row) { return i * kNumRows + row; })}));
+      state.finishFile(0);
+    }
+
+    auto files = state.finish(0);
+    ASSERT_EQ(files.size(), kNumFiles);
+    ASSERT_EQ(remoteTier->numMovedFiles, kNumFiles - 1);
+    ASSERT_EQ(files[0].path.find(remotePath), std::string::npos);
+    auto fs = filesystems::getFileSystem(remotePath, nullptr);
+    for (auto i = 1; i < kNumFiles; ++i) {
+      ASSERT_EQ(files[i].path.find(remotePath), 0);
+      ASSERT_TRUE(fs->exists(files[i].path));
+    }
+    ASSERT_EQ(fs->list(localDirectory->getPath()).size(), 1);
+
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+    auto reader =
+        spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+    RowVectorPtr output;
+    for (auto i = 0; i < kNumFiles; ++i) {
+      ASSERT_TRUE(reader->nextBatch(output));
+      ASSERT_EQ(output->size(), kNumRows);
+      for (auto row = 0; row < kNumRows; ++row) {
+        ASSERT_EQ(
+            output->childAt(0)->asFlatVector<int64_t>()->valueAt(row),
+            i * kNumRows + row);
+      }
+    }
+    ASSERT_FALSE(reader->nextBatch(output));
+  }
+}
+
+TEST_P(SpillTest, asyncWrite) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  folly::CPUThreadPoolExecutor executor(2);
+  const int kNumPartitions = 4;
+  // A small write buffer and target file size to have several writes per
+  // file and several files per partition.
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      kNumPartitions,
+      0,
+      {},
+      64 << 10,
+      1 << 10,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      "",
+      false,
+      nullptr,
+      &executor);
+
+  const int kNumBatches = 20;
+  const vector_size_t kNumRows = 1'000;
+  for (auto partition = 0; partition < kNumPartitions; ++partition) {
+    state.setPartitionSpilled(partition);
+  }
+  for (auto i = 0; i < kNumBatches; ++i) {
+    for (auto partition = 0; partition < kNumPartitions; ++partition) {
+      state.appendToPartition(
+          partition,
+          makeRowVector({makeFlatVector<int64_t>(kNumRows, [&](auto row) {
+            return (partition * kNumBatches + i) * kNumRows + row;
+          })}));
+    }
+  }
+
+  for (auto partition = 0; partition < kNumPartitions; ++partition) {
+    auto files = state.finish(partition);
+    ASSERT_GT(files.size(), 1);
+    SpillPartition spillPartition(
+        SpillPartitionId{0, partition}, std::move(files));
+    auto reader =
+        spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+    RowVectorPtr output;
+    for (auto i = 0; i < kNumBatches; ++i) {
+      ASSERT_TRUE(reader->nextBatch(output));
+      ASSERT_EQ(output->size(), kNumRows);
+      for (auto row = 0; row < kNumRows; ++row) {
+        ASSERT_EQ(
+            output->childAt(0)->asFlatVector<int64_t>()->valueAt(row),
+            (partition * kNumBatches + i) * kNumRows + row);
+      }
+    }
+    ASSERT_FALSE(reader->nextBatch(output));
+  }
+  ASSERT_EQ(spillStats_.rlock()->spillWrites, kNumPartitions * kNumBatches);
+}
+
+TEST_P(SpillTest, dictionaryEncoding) {
+  const vector_size_t kNumRows = 1'000;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) {
+            return fmt::format("a long string value number {}", row % 10);
+          },
+          nullEvery(7)),
+      // Too many distinct values to be encoded.
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) {
+            return fmt::format("another long string value {}", row);
+          }),
+  });
+
+  std::vector<uint64_t> fileSizes;
+  for (const bool dictionaryEncoding : {false, true}) {
+    SCOPED_TRACE(fmt::format("dictionaryEncoding {}", dictionaryEncoding));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        0,
+        {},
+        kGB,
+        1 << 20,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        "",
+        false,
+        nullptr,
+        nullptr,
+        dictionaryEncoding);
+    state.setPartitionSpilled(0);
+    for (auto i = 0; i < 4; ++i) {
+      state.appendToPartition(0, input);
+    }
+    auto files = state.finish(0);
+    ASSERT_EQ(files.size(), 1);
+    fileSizes.push_back(files[0].size);
+
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+    auto reader =
+        spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+    RowVectorPtr output;
+    ASSERT_TRUE(reader->nextBatch(output));
+    ASSERT_EQ(output->size(), 4 * kNumRows);
+    for (auto row = 0; row < output->size(); ++row) {
+      ASSERT_EQ(
+          0,
+          output->compare(input.get(), row, row % kNumRows, CompareFlags{}));
+    }
+    ASSERT_FALSE(reader->nextBatch(output));
+  }
+  if (compressionKind_ == common::CompressionKind_NONE) {
+    ASSERT_LT(fileSizes[1], fileSizes[0]);
+  }
+}
+
+TEST_P(SpillTest, checksum) {
+  const vector_size_t kNumRows = 1'000;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<double>(
+          kNumRows, [](auto row) { return row * 0.5; }, nullEvery(7)),
+  });
+  std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  for (const bool rowFormat : {false, true}) {
+    SCOPED_TRACE(fmt::format("rowFormat {}", rowFormat));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        1,
+        compareFlags,
+        kGB,
+        1 << 20,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        "",
+        rowFormat,
+        nullptr,
+        nullptr,
+        false,
+        /*checksumEnabled=*/true);
+    state.setPartitionSpilled(0);
+    state.appendToPartition(0, input);
+    const auto files = state.finish(0);
+    ASSERT_EQ(files.size(), 1);
+    ASSERT_TRUE(files[0].checksum);
+    ASSERT_EQ(files[0].rowFormat, rowFormat);
+    const auto path = files[0].path;
+    const auto size = files[0].size;
+
+    auto readAll = [&]() {
+      SpillPartition spillPartition(SpillPartitionId{0, 0}, files);
+      auto reader =
+          spillPartition.createUnorderedReader(1 << 10, pool(), &spillStats_);
+      vector_size_t numRows{0};
+      RowVectorPtr output;
+      while (reader->nextBatch(output)) {
+        numRows += output->size();
+      }
+      return numRows;
+    };
+    ASSERT_EQ(readAll(), kNumRows);
+
+    // Flips a byte in the middle of the file.
+    {
+      std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+      file.seekg(size / 2);
+      const char byte = file.get();
+      file.seekp(size / 2);
+      file.put(~byte);
+    }
+    VELOX_ASSERT_THROW(
+        readAll(),
+        rowFormat ? "has a wrong checksum"
+                  : "Received corrupted serialized page");
+
+    std::filesystem::resize_file(path, size - 1);
+    VELOX_ASSERT_THROW(readAll(), "bytes instead of");
+  }
+}
+
+TEST_P(SpillTest, adaptiveCompression) {
+  const vector_size_t kNumRows = 1'000;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) {
+            return fmt::format("a long string value number {}", row % 10);
+          }),
+  });
+
+  std::vector<uint64_t> fileSizes;
+  for (const bool adaptiveCompression : {false, true}) {
+    SCOPED_TRACE(fmt::format("adaptiveCompression {}", adaptiveCompression));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        0,
+        {},
+        kGB,
+        1 << 20,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        "",
+        false,
+        nullptr,
+        nullptr,
+        false,
+        false,
+        adaptiveCompression);
+    state.setPartitionSpilled(0);
+    for (auto i = 0; i < 4; ++i) {
+      state.appendToPartition(0, input);
+    }
+    auto files = state.finish(0);
+    ASSERT_EQ(files.size(), 1);
+    fileSizes.push_back(files[0].size);
+
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+    auto reader =
+        spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+    RowVectorPtr output;
+    ASSERT_TRUE(reader->nextBatch(output));
+    ASSERT_EQ(output->size(), 4 * kNumRows);
+    for (auto row = 0; row < output->size(); ++row) {
+      ASSERT_EQ(
+          0,
+          output->compare(input.get(), row, row % kNumRows, CompareFlags{}));
+    }
+    ASSERT_FALSE(reader->nextBatch(output));
+  }
+  // The string page is compressed even if the files are not.
+  if (compressionKind_ == common::CompressionKind_NONE) {
+    ASSERT_LT(fileSizes[1], fileSizes[0]);
+  }
+}
+
+TEST_P(SpillTest, mergeFiles) {
+  const int kNumRuns = 10;
+  const vector_size_t kNumRows = 500;
+  folly::CPUThreadPoolExecutor executor(4);
+  for (const bool parallel : {false, true}) {
+    SCOPED_TRACE(fmt::format("parallel {}", parallel));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    std::vector<CompareFlags> compareFlags{CompareFlags{}};
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        1,
+        compareFlags,
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_);
+    state.setPartitionSpilled(0);
+    // Sorted runs with interleaved keys.
+    for (auto run = 0; run < kNumRuns; ++run) {
+      state.appendToPartition(
+          0,
+          makeRowVector({
+              makeFlatVector<int64_t>(
+                  kNumRows, [&](auto row) { return row * kNumRuns + run; }),
+              makeFlatVector<std::string>(
+                  kNumRows,
+                  [&](auto row) {
+                    return fmt::format("{}", row * kNumRuns + run);
+                  }),
+          }));
+      state.finishFile(0);
+    }
+
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+    ASSERT_EQ(spillPartition.numFiles(), kNumRuns);
+    common::SpillConfig spillConfig;
+    spillConfig.getSpillDirPathCb = [&]() -> std::string_view {
+      return tempDirectory->getPath();
+    };
+    spillConfig.updateAndCheckSpillLimitCb = [](uint64_t) {};
+    spillConfig.fileNamePrefix = "test";
+    spillConfig.writeBufferSize = 1 << 10;
+    spillConfig.readBufferSize = 1 << 20;
+    spillConfig.executor = parallel ? &executor : nullptr;
+    // Merges 10 files into 4 and then 2.
+    spillPartition.mergeFiles(3, spillConfig, pool(), &spillStats_);
+    ASSERT_EQ(spillPartition.numFiles(), 2);
+    // Merging is a no-op once there are at most 'fanIn' files.
+    spillPartition.mergeFiles(3, spillConfig, pool(), &spillStats_);
+    ASSERT_EQ(spillPartition.numFiles(), 2);
+
+    auto merge =
+        spillPartition.createOrderedReader(1 << 20, pool(), &spillStats_);
+    for (auto i = 0; i < kNumRuns * kNumRows; ++i) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      const auto index = stream->currentIndex();
+      ASSERT_EQ(stream->decoded(0).valueAt<int64_t>(index), i);
+      ASSERT_EQ(
+          stream->decoded(1).valueAt<StringView>(index).str(),
+          fmt::format("{}", i));
+      stream->pop();
+    }
+    ASSERT_EQ(merge->next(), nullptr);
+  }
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -15,6 +15,7 @@
  */
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/core/Expressions.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -538,3 +539,42 @@ TEST_F(StreamingAggregationTest, distinctAggregations) {
   testMultiKeyDistinctAggregation(multiKeys, 1024);
   testMultiKeyDistinctAggregation(multiKeys, 3);
 }
+
+TEST_F(StreamingAggregationTest, recycleOutput) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 10; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return (i * 1'000 + row) / 10; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(data);
+
+  core::PlanNodeId aggNodeId;
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .partialStreamingAggregation({"c0"}, {"sum(c1)"})
+                  .capturePlanNodeId(aggNodeId)
+                  .singleAggregation({}, {"count(c0)", "sum(a0)"})
+                  .planNode();
+
+  for (const auto recycle : {false, true}) {
+    SCOPED_TRACE(fmt::format("recycle: {}", recycle));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "50")
+            .config(
+                core::QueryConfig::kOperatorOutputRecycleEnabled,
+                recycle ? "true" : "false")
+            .assertResults("SELECT count(c0), sum(s) FROM "
+                           "(SELECT c0, sum(c1) AS s FROM tmp GROUP BY 1)");
+    const auto stats = toPlanStats(task->taskStats()).at(aggNodeId);
+    if (recycle) {
+      ASSERT_GT(stats.customStats.at("vectorPoolReusedVectors").sum, 0);
+      ASSERT_GT(stats.customStats.at("vectorPoolReusedBytes").sum, 0);
+    } else {
+      ASSERT_EQ(stats.customStats.count("vectorPoolReusedVectors"), 0);
+    }
+  }
+}
@@ -614,6 +614,35 @@ TEST_F(TableScanTest, subfieldPruningRowType) {
   }
 }
 
+TEST_F(TableScanTest, subfieldPruningFromProject) {
+  auto columnType = ROW({"a", "b"}, {BIGINT(), VARCHAR()});
+  auto rowType = ROW({"e", "f"}, {columnType, columnType});
+  auto vectors = makeVectors(10, 1'000, rowType);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  // 'e' is only dereferenced and has 'b' pruned, 'f' is used as a whole.
+  auto plan = PlanBuilder()
+                  .tableScan(rowType)
+                  .filter("e.a % 3 <> 0")
+                  .project({"e.a + 1", "f"})
+                  .planNode();
+  uint64_t rawInputBytes[2];
+  for (auto pruning : {false, true}) {
+    SCOPED_TRACE(fmt::format("pruning: {}", pruning));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .split(makeHiveConnectorSplit(filePath->getPath()))
+            .config(
+                core::QueryConfig::kTableScanSubfieldPruningEnabled,
+                pruning ? "true" : "false")
+            .assertResults("SELECT e.a + 1, f FROM tmp WHERE e.a % 3 <> 0");
+    rawInputBytes[pruning] = getTableScanStats(task).rawInputBytes;
+  }
+  ASSERT_LT(rawInputBytes[1], rawInputBytes[0]);
+}
+
 TEST_F(TableScanTest, subfieldPruningRemainingFilterSubfieldsMissing) {
   auto columnType = ROW({"a", "b", "c"}, {BIGINT(), BIGINT(), BIGINT()});
   auto rowType = ROW({"e"}, {columnType});
@@ -1418,6 +1447,263 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, adaptiveSplitPreloadDepth) {
+  auto filePaths = makeFilePaths(50);
+  auto vectors = makeVectors(50, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto task = AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "8")
+                  .config(core::QueryConfig::kSplitPreloadTargetWaitMs, "1")
+                  .assertResults("SELECT * FROM tmp");
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(stats.count("splitPreloadDepth"), 1);
+  const auto& depth = stats.at("splitPreloadDepth");
+  ASSERT_EQ(depth.count, 50);
+  ASSERT_GE(depth.min, 1);
+  ASSERT_LE(depth.max, 8);
+}
+
+TEST_F(TableScanTest, dynamicDrivers) {
+  auto filePaths = makeFilePaths(40);
+  auto vectors = makeVectors(40, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // Drivers are added only while the executor has idle threads, so the
+  // queries run on an executor with more threads than they start drivers.
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(8);
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto scanPlan = [&]() {
+    return PlanBuilder(planNodeIdGenerator, pool_.get())
+        .tableScan(rowType_)
+        .filter("c1 % 3 = 0")
+        .project({"c0", "c2"})
+        .planNode();
+  };
+  // The scan pipeline feeds the task output.
+  auto outputPlan = scanPlan();
+  // The scan pipeline feeds a local exchange which gets producers added after
+  // noMoreProducers.
+  auto localPartitionPlan = PlanBuilder(planNodeIdGenerator, pool_.get())
+                                .localPartition({"c0"}, {scanPlan()})
+                                .planNode();
+
+  for (const auto& plan : {outputPlan, localPartitionPlan}) {
+    for (const auto maxDynamicDrivers : {0, 1, 4}) {
+      SCOPED_TRACE(fmt::format(
+          "{} maxDynamicDrivers {}", plan->toString(), maxDynamicDrivers));
+      auto queryCtx = core::QueryCtx::create(
+          executor.get(),
+          core::QueryConfig(
+              {{core::QueryConfig::kMaxDynamicDriversPerPipeline,
+                std::to_string(maxDynamicDrivers)}}));
+      auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                      .queryCtx(queryCtx)
+                      .maxDrivers(1)
+                      .splits(makeHiveConnectorSplits(filePaths))
+                      .assertResults("SELECT c0, c2 FROM tmp WHERE c1 % 3 = 0");
+      // One driver per pipeline to start with and up to 'maxDynamicDrivers'
+      // in the scan pipeline.
+      const auto numPipelines = plan == outputPlan ? 1 : 2;
+      if (maxDynamicDrivers > 1) {
+        ASSERT_GT(task->numTotalDrivers(), numPipelines);
+      } else {
+        ASSERT_EQ(task->numTotalDrivers(), numPipelines);
+      }
+      ASSERT_LE(
+          task->numTotalDrivers(),
+          numPipelines - 1 + std::max(1, maxDynamicDrivers));
+      ASSERT_EQ(task->numFinishedDrivers(), task->numTotalDrivers());
+    }
+  }
+}
+
+TEST_F(TableScanTest, dynamicDriversPartitionedOutput) {
+  auto filePaths = makeFilePaths(40);
+  auto vectors = makeVectors(40, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(8);
+  core::PlanNodeId scanNodeId;
+  auto leafPlan = PlanBuilder(pool_.get())
+                      .tableScan(rowType_)
+                      .capturePlanNodeId(scanNodeId)
+                      .filter("c1 % 3 = 0")
+                      .partitionedOutput({}, 1, {"c0", "c2"})
+                      .planNode();
+  for (const auto maxDynamicDrivers : {0, 4}) {
+    SCOPED_TRACE(fmt::format("maxDynamicDrivers {}", maxDynamicDrivers));
+    // The output buffer of the leaf task gets its new number of drivers
+    // through OutputBuffer::updateNumDrivers.
+    const auto leafTaskId =
+        fmt::format("local://leaf-dynamic-drivers-{}", maxDynamicDrivers);
+    auto leafTask = Task::create(
+        leafTaskId,
+        core::PlanFragment{leafPlan},
+        0,
+        core::QueryCtx::create(
+            executor.get(),
+            core::QueryConfig(
+                {{core::QueryConfig::kMaxDynamicDriversPerPipeline,
+                  std::to_string(maxDynamicDrivers)}})),
+        Task::ExecutionMode::kParallel);
+    leafTask->start(1);
+    for (auto& split : makeHiveConnectorSplits(filePaths)) {
+      leafTask->addSplit(scanNodeId, exec::Split(std::move(split)));
+    }
+    leafTask->noMoreSplits(scanNodeId);
+
+    auto plan = PlanBuilder(pool_.get())
+                    .exchange(leafPlan->outputType())
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .split(exec::Split(std::make_shared<RemoteConnectorSplit>(leafTaskId)))
+        .assertResults("SELECT c0, c2 FROM tmp WHERE c1 % 3 = 0");
+    ASSERT_TRUE(waitForTaskCompletion(leafTask.get()));
+    if (maxDynamicDrivers > 1) {
+      ASSERT_GT(leafTask->numTotalDrivers(), 1);
+    } else {
+      ASSERT_EQ(leafTask->numTotalDrivers(), 1);
+    }
+    ASSERT_LE(leafTask->numTotalDrivers(), std::max(1, maxDynamicDrivers));
+    ASSERT_EQ(leafTask->numFinishedDrivers(), leafTask->numTotalDrivers());
+  }
+}
+
+TEST_F(TableScanTest, dynamicDriversHashProbe) {
+  auto filePaths = makeFilePaths(40);
+  auto vectors = makeVectors(40, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable("t", vectors);
+
+  // Half of the build keys match probe rows. The others come out of right and
+  // full joins through the last prober, which Task::allPeersFinished() picks
+  // out of the drivers that are running when it is called.
+  auto probeKeys = vectors[0]->childAt(0)->as<SimpleVector<int64_t>>();
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(
+           200,
+           [&](auto row) {
+             return row >= 100 || probeKeys->isNullAt(row)
+                 ? row
+                 : probeKeys->valueAt(row);
+           }),
+       makeFlatVector<int32_t>(200, [](auto row) { return row; })});
+  createDuckDbTable("u", {build});
+
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(8);
+  for (const auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kRight,
+        core::JoinType::kFull}) {
+    const auto joinName = core::joinTypeName(joinType);
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId scanNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator, pool_.get())
+                    .tableScan(rowType_)
+                    .capturePlanNodeId(scanNodeId)
+                    .hashJoin(
+                        {"c0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator, pool_.get())
+                            .values({build})
+                            .planNode(),
+                        "",
+                        {"c2", "u1"},
+                        joinType)
+                    .planNode();
+    for (const auto maxDynamicDrivers : {0, 4}) {
+      SCOPED_TRACE(
+          fmt::format("{} maxDynamicDrivers {}", joinName, maxDynamicDrivers));
+      // Probes that finish early on an empty build do not get drivers added.
+      auto queryCtx = core::QueryCtx::create(
+          executor.get(),
+          core::QueryConfig(
+              {{core::QueryConfig::kMaxDynamicDriversPerPipeline,
+                std::to_string(maxDynamicDrivers)},
+               {core::QueryConfig::kHashProbeFinishEarlyOnEmptyBuild,
+                "false"}}));
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .queryCtx(queryCtx)
+              .maxDrivers(1)
+              .splits(scanNodeId, makeHiveConnectorSplits(filePaths))
+              .assertResults(fmt::format(
+                  "SELECT c2, u1 FROM t {} JOIN u ON c0 = u0", joinName));
+      // The build pipeline keeps its one driver.
+      if (maxDynamicDrivers > 1) {
+        ASSERT_GT(task->numTotalDrivers(), 2);
+      } else {
+        ASSERT_EQ(task->numTotalDrivers(), 2);
+      }
+      ASSERT_LE(task->numTotalDrivers(), 1 + std::max(1, maxDynamicDrivers));
+      ASSERT_EQ(task->numFinishedDrivers(), task->numTotalDrivers());
+    }
+  }
+}
+
+TEST_F(TableScanTest, splitAffinity) {
+  auto filePaths = makeFilePaths(4);
+  auto vectors = makeVectors(4, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // The splits of the files are interleaved. The splits of a file have the
+  // same cache affinity key.
+  std::vector<std::vector<std::shared_ptr<HiveConnectorSplit>>> fileSplits;
+  for (const auto& filePath : filePaths) {
+    fileSplits.push_back(makeHiveConnectorSplits(
+        filePath->getPath(), 8, dwio::common::FileFormat::DWRF));
+  }
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (auto i = 0; i < 8; ++i) {
+    for (const auto& splitsOfFile : fileSplits) {
+      ASSERT_EQ(
+          splitsOfFile[0]->cacheAffinityKey, splitsOfFile[i]->cacheAffinityKey);
+      splits.push_back(splitsOfFile[i]);
+    }
+  }
+  ASSERT_NE(
+      fileSplits[0][0]->cacheAffinityKey, fileSplits[1][0]->cacheAffinityKey);
+
+  for (const bool affinity : {false, true}) {
+    SCOPED_TRACE(fmt::format("affinity {}", affinity));
+    auto task =
+        AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kSplitAffinityScheduling,
+                affinity ? "true" : "false")
+            .maxDrivers(2)
+            .splits(splits)
+            .assertResults("SELECT * FROM tmp");
+    const auto stats = task->taskStats();
+    if (!affinity) {
+      ASSERT_EQ(0, stats.numAffinityTableScanSplits);
+      ASSERT_EQ(0, stats.numStolenTableScanSplits);
+      continue;
+    }
+    ASSERT_GT(stats.numAffinityTableScanSplits, 0);
+    ASSERT_LE(
+        stats.numAffinityTableScanSplits + stats.numStolenTableScanSplits,
+        splits.size());
+  }
+}
+
 TEST_F(TableScanTest, preloadingSplitClose) {
   auto filePaths = makeFilePaths(100);
   auto vectors = makeVectors(100, 100);
@@ -2402,6 +2688,61 @@ TEST_F(TableScanTest, statsBasedSkippingComplexTypes) {
 
 /// Test the interaction between stats-based and regular skipping for lists and
 /// maps.
+TEST_F(TableScanTest, splitMetadataBasedSkipping) {
+  // The splits point to a file that does not exist, so the scan only succeeds
+  // if they are skipped before the file is opened.
+  const auto missingPath =
+      TempDirectoryPath::create()->getPath() + "/missing.orc";
+  const auto outputType = ROW({"c0", "ds"}, {BIGINT(), VARCHAR()});
+  const ColumnHandleMap assignments = {
+      {"c0", regularColumn("c0", BIGINT())},
+      {"ds", partitionKey("ds", VARCHAR())}};
+  auto makeScan = [&](const std::string& column,
+                      std::unique_ptr<common::Filter> filter) {
+    SubfieldFilters filters;
+    filters[common::Subfield(column)] = std::move(filter);
+    return std::make_shared<TableScanNode>(
+        "0",
+        outputType,
+        std::make_shared<HiveTableHandle>(
+            "test-hive", "hive_table", true, std::move(filters), nullptr),
+        assignments);
+  };
+
+  // Filter on the partition key value.
+  auto split = HiveConnectorSplitBuilder(missingPath)
+                   .partitionKey("ds", "2021-12-02")
+                   .build();
+  std::shared_ptr<Task> task;
+  auto result =
+      AssertQueryBuilder(makeScan(
+                             "ds",
+                             std::make_unique<common::BytesValues>(
+                                 std::vector<std::string>{"2021-12-03"},
+                                 false)))
+          .split(split)
+          .copyResults(pool(), task);
+  ASSERT_EQ(result->size(), 0);
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+
+  // Filter on the file statistics carried by the split.
+  split = HiveConnectorSplitBuilder(missingPath)
+              .partitionKey("ds", "2021-12-02")
+              .build();
+  split->fileRowCount = 1'000;
+  split->fileStatistics["c0"] =
+      std::make_shared<dwio::common::IntegerColumnStatistics>(
+          1'000, false, std::nullopt, std::nullopt, 0, 999, std::nullopt);
+  result = AssertQueryBuilder(makeScan(
+                                  "c0",
+                                  std::make_unique<common::BigintRange>(
+                                      1'000, 2'000, false)))
+               .split(split)
+               .copyResults(pool(), task);
+  ASSERT_EQ(result->size(), 0);
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+}
+
 TEST_F(TableScanTest, statsBasedAndRegularSkippingComplexTypes) {
   const vector_size_t size = 31'234;
 
@@ -3368,6 +3709,47 @@ TEST_F(TableScanTest, structLazy) {
   assertQuery(op, {filePath}, "select c0 % 3 from tmp");
 }
 
+TEST_F(TableScanTest, lazyLoadPrefetch) {
+  auto vectors = makeVectors(rowType_, 10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  // c4 and c5 are used only by projections without conditionals and are
+  // loaded for the rows that pass the filter. c3 is loaded in an IF and c2 is
+  // projected as is, so neither is prefetched.
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .filter("c0 % 3 = 0")
+                  .project(
+                      {"c4 * 2.0",
+                       "concat(c5, 'x')",
+                       "if(c0 % 2 = 0, c3, -c3)",
+                       "c2"})
+                  .planNode();
+  auto prefetches = [&](bool enabled) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .connectorSessionProperty(
+                kHiveConnectorId,
+                connector::hive::HiveConfig::kLazyLoadPrefetchSession,
+                enabled ? "true" : "false")
+            .split(makeHiveConnectorSplit(filePath->getPath()))
+            .assertResults(
+                "SELECT c4 * 2.0, c5 || 'x', "
+                "CASE WHEN c0 % 2 = 0 THEN c3 ELSE -c3 END, c2 "
+                "FROM tmp WHERE c0 % 3 = 0");
+    auto stats = task->taskStats().pipelineStats[0].operatorStats[1];
+    auto it = stats.runtimeStats.find(LazyVector::kPrefetches);
+    return it == stats.runtimeStats.end() ? 0 : it->second.sum;
+  };
+  EXPECT_EQ(0, prefetches(false));
+  // Two columns are prefetched for each batch.
+  const auto numPrefetches = prefetches(true);
+  EXPECT_GT(numPrefetches, 0);
+  EXPECT_EQ(0, numPrefetches % 2);
+}
+
 TEST_F(TableScanTest, interleaveLazyEager) {
   constexpr int kSize = 1000;
   auto column = makeRowVector(
@@ -4431,3 +4813,29 @@ TEST_F(TableScanTest, noCacheRetention) {
     }
   }
 }
+
+TEST_F(TableScanTest, topNThresholdFilter) {
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000, [&](auto row) { return i * 1'000 + row; }),
+         makeFlatVector<double>(1'000, [](auto row) { return row * 0.1; })}));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), {vectors.back()});
+  }
+  createDuckDbTable(vectors);
+
+  // The first file gives the top 10 rows. The threshold filter set by TopN
+  // on c0 after that file drops the rows of the other files in the scan.
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(vectors[0]->type()))
+                  .topN({"c0"}, 10, false)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .assertResults("SELECT * FROM tmp ORDER BY c0 LIMIT 10");
+  ASSERT_LE(1, getTableScanRuntimeStats(task)["dynamicFiltersAccepted"].sum);
+  ASSERT_GT(10'000, getTableScanStats(task).outputRows);
+}
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/Task.h"
+#include <folly/json.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/future/VeloxPromise.h"
@@ -1617,6 +1618,54 @@ TEST_F(TaskTest, spillDirectoryLifecycleManagement) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(TaskTest, queryResourceUsage) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row % 3'000; }),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), {data});
+
+  core::PlanNodeId scanId;
+  CursorParameters params;
+  params.planNode = PlanBuilder()
+                        .tableScan(asRowType(data->type()))
+                        .capturePlanNodeId(scanId)
+                        .singleAggregation({"c0"}, {"sum(c1)"})
+                        .planNode();
+  params.queryCtx = core::QueryCtx::create(driverExecutor_.get());
+  params.queryCtx->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kSpillEnabled, "true"},
+       {core::QueryConfig::kAggregationSpillEnabled, "true"}});
+  params.maxDrivers = 1;
+
+  const auto initial = params.queryCtx->resourceUsageSnapshot();
+  ASSERT_EQ(initial.cpuNanos, 0);
+  ASSERT_EQ(initial.spilledBytes, 0);
+
+  auto cursor = TaskCursor::create(params);
+  auto task = cursor->task();
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  task->setSpillDirectory(spillDirectory->getPath());
+  task->addSplit(scanId, Split(makeHiveConnectorSplit(filePath->getPath())));
+  task->noMoreSplits(scanId);
+
+  TestScopedSpillInjection scopedSpillInjection(100);
+  while (cursor->moveNext()) {
+  }
+  ASSERT_TRUE(waitForTaskCompletion(task.get(), 5'000'000));
+
+  const auto usage = params.queryCtx->resourceUsageSnapshot();
+  ASSERT_GT(usage.cpuNanos, 0);
+  ASSERT_GT(usage.peakMemoryBytes, 0);
+  ASSERT_LE(usage.averageMemoryBytes, usage.peakMemoryBytes);
+  ASSERT_GT(
+      usage.ramReadBytes + usage.ssdReadBytes + usage.storageReadBytes, 0);
+  ASSERT_GT(usage.spilledBytes, 0);
+  ASSERT_EQ(usage.exchangeInputBytes, 0);
+  ASSERT_EQ(usage.exchangeOutputBytes, 0);
+}
+
 TEST_F(TaskTest, spillDirNotCreated) {
   // Verify that no spill directory is created if spilling is not engaged.
   const std::vector<RowVectorPtr> probeVectors = {makeRowVector(
@@ -2138,4 +2187,56 @@ DEBUG_ONLY_TEST_F(TaskTest, taskDeletionPromise) {
   ASSERT_TRUE(deleteFuture.wait().hasValue());
   queryThread.join();
 }
+
+TEST_F(TaskTest, timeline) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 17; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({data}, true)
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({data})
+                          .project({"c0 AS u0"})
+                          .planNode(),
+                      "",
+                      {"c0", "c1"},
+                      core::JoinType::kLeftSemiFilter)
+                  .planNode();
+
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan).maxDrivers(2).copyResults(pool(), task);
+  ASSERT_EQ(task->timeline(), nullptr);
+  ASSERT_TRUE(task->timelineChromeTrace().empty());
+
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kTaskTimelineCapacity, "10000")
+      .maxDrivers(2)
+      .copyResults(pool(), task);
+  ASSERT_NE(task->timeline(), nullptr);
+  ASSERT_EQ(task->timeline()->numDropped(), 0);
+
+  // The events are on a row per pipeline and Driver.
+  std::set<std::string> categories;
+  std::set<std::pair<int64_t, int64_t>> threads;
+  bool hasProbeCall{false};
+  auto trace = folly::parseJson(task->timelineChromeTrace());
+  for (const auto& event : trace["traceEvents"]) {
+    ASSERT_EQ(event["ph"], "X");
+    categories.insert(event["cat"].asString());
+    threads.emplace(event["pid"].asInt(), event["tid"].asInt());
+    if (event["name"] == "HashProbe.getOutput") {
+      hasProbeCall = true;
+    }
+  }
+  ASSERT_EQ(categories.count("driver"), 1);
+  ASSERT_EQ(categories.count("operator"), 1);
+  ASSERT_TRUE(hasProbeCall);
+  // 2 Drivers of the probe pipeline and 1 of the build pipeline.
+  ASSERT_EQ(threads.size(), 3);
+}
 } // namespace facebook::velox::exec::test
@@ -291,6 +291,40 @@ TEST_F(TopNRowNumberTest, abandonPartialEarly) {
   }
 }
 
+TEST_F(TopNRowNumberTest, prefixSort) {
+  const vector_size_t size = 10'000;
+  auto data = split(
+      makeRowVector({
+          // Partitioning key.
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          // Sorting keys.
+          makeFlatVector<int32_t>(
+              size, [](auto row) { return row % 5; }, nullEvery(7)),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return fmt::format("{}", row); }),
+          // Data.
+          makeFlatVector<double>(size, [](auto row) { return row * 0.1; }),
+      }),
+      10);
+
+  createDuckDbTable(data);
+
+  for (auto limit : {1, 10, 100}) {
+    SCOPED_TRACE(fmt::format("Limit: {}", limit));
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .topNRowNumber(
+                        {"c0"}, {"c1 DESC NULLS LAST", "c2"}, limit, true)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kTopNPrefixSortEnabled, "true")
+        .assertResults(fmt::format(
+            "SELECT * FROM (SELECT *, row_number() over (partition by c0 order by c1 DESC NULLS LAST, c2) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            limit));
+  }
+}
+
 TEST_F(TopNRowNumberTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b", "c", "d", "e"},
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -284,6 +285,41 @@ TEST_F(TopNTest, onlyKeys) {
   testTwoKeys(vectors, "c0", "c1", 200);
 }
 
+TEST_F(TopNTest, prefixSort) {
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize, [](vector_size_t row) { return row % 7; }, nullEvery(13));
+    auto c1 = makeFlatVector<std::string>(batchSize, [&](vector_size_t row) {
+      return fmt::format("{}", batchSize * i + row);
+    });
+    auto c2 = makeFlatVector<double>(
+        batchSize, [&](vector_size_t row) { return (batchSize * i + row) * 0.1; });
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  // The first key can be normalized. If the prefixes are equal, the second
+  // key falls back to the row comparator.
+  for (const auto& sortingKeys : std::vector<std::vector<std::string>>{
+           {"c0 NULLS LAST", "c1"},
+           {"c0 DESC NULLS FIRST", "c1 DESC"},
+           {"c2 DESC", "c0 NULLS LAST"},
+           {"c0 NULLS FIRST", "c2 DESC"}}) {
+    SCOPED_TRACE(folly::join(", ", sortingKeys));
+    auto plan =
+        PlanBuilder().values(vectors).topN(sortingKeys, 100, false).planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kTopNPrefixSortEnabled, "true")
+        .assertResults(
+            fmt::format(
+                "SELECT * FROM tmp ORDER BY {} LIMIT 100",
+                folly::join(", ", sortingKeys)),
+            std::vector<uint32_t>{0, 1, 2});
+  }
+}
+
 TEST_F(TopNTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b"},
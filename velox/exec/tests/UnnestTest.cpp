@@ -424,7 +424,7 @@ TEST_F(UnnestTest, batchSize) {
       makeFlatVector<int64_t>(10'000 * 3, [](auto row) { return 1 + row % 3; }),
   });
 
-  // 17 rows per output allows to unnest 6 input rows at a time.
+  // 17 rows per output splits every 6th input row across two outputs.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
@@ -432,10 +432,10 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(1 + 10'000 / 6, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(bits::divRoundUp(30'000, 17), stats.at(unnestId).outputVectors);
   }
 
-  // 2 rows per output allows to unnest 1 input row at a time.
+  // 2 rows per output splits every other input row across two outputs.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "2")
@@ -443,7 +443,7 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(10'000, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(15'000, stats.at(unnestId).outputVectors);
   }
 
   // 100K rows per output allows to unnest all at once.
@@ -458,3 +458,74 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(1, stats.at(unnestId).outputVectors);
   }
 }
+
+TEST_F(UnnestTest, splitLargeArrays) {
+  // Two large arrays next to each other in the elements, then a short array
+  // and an array that is shorter than the map in the same row, so that the
+  // unnested arrays are padded with nulls.
+  const std::vector<int32_t> arraySizes = {2'500, 3'000, 10, 1};
+  const std::vector<int32_t> mapSizes = {0, 0, 0, 5};
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4}),
+      makeArrayVector<int32_t>(
+          4,
+          [&](auto row) { return arraySizes[row]; },
+          [](auto index) { return index; }),
+      makeMapVector<int64_t, int64_t>(
+          4,
+          [&](auto row) { return mapSizes[row]; },
+          [](auto index) { return index; },
+          [](auto index) { return index * 2; }),
+  });
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .unnest({"c0"}, {"c1", "c2"}, "ordinal")
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+
+  std::vector<int64_t> parents;
+  std::vector<std::optional<int32_t>> elements;
+  std::vector<std::optional<int64_t>> keys;
+  std::vector<std::optional<int64_t>> values;
+  std::vector<int64_t> ordinals;
+  int32_t element = 0;
+  int32_t mapEntry = 0;
+  for (auto row = 0; row < 4; ++row) {
+    const auto numRows = std::max(arraySizes[row], mapSizes[row]);
+    for (auto i = 0; i < numRows; ++i) {
+      parents.push_back(row + 1);
+      if (i < arraySizes[row]) {
+        elements.push_back(element++);
+      } else {
+        elements.push_back(std::nullopt);
+      }
+      if (i < mapSizes[row]) {
+        keys.push_back(mapEntry);
+        values.push_back(mapEntry * 2);
+        ++mapEntry;
+      } else {
+        keys.push_back(std::nullopt);
+        values.push_back(std::nullopt);
+      }
+      ordinals.push_back(i + 1);
+    }
+  }
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(parents),
+      makeNullableFlatVector<int32_t>(elements),
+      makeNullableFlatVector<int64_t>(keys),
+      makeNullableFlatVector<int64_t>(values),
+      makeFlatVector<int64_t>(ordinals),
+  });
+
+  // The outputs have 1000 rows each except for the last, whatever the array
+  // boundaries are.
+  auto task = AssertQueryBuilder(plan)
+                  .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+                  .assertResults({expected});
+  auto stats = exec::toPlanStats(task->taskStats());
+  ASSERT_EQ(5'515, stats.at(unnestId).outputRows);
+  ASSERT_EQ(6, stats.at(unnestId).outputVectors);
+}
@@ -364,6 +364,37 @@ TEST_F(VectorHasherTest, dictionary) {
   }
 }
 
+TEST_F(VectorHasherTest, sequence) {
+  auto hasher = exec::VectorHasher::create(BIGINT(), 1);
+
+  // 10 runs of 10 rows each: 3 x 10, 4 x 10, .., 12 x 10.
+  auto vector = BaseVector::create(BIGINT(), 10, pool());
+  auto flatVector = vector->asFlatVector<int64_t>();
+  for (int32_t i = 0; i < 10; i++) {
+    flatVector->set(i, i + 3);
+  }
+  auto lengths = AlignedBuffer::allocate<SequenceLength>(10, pool(), 10);
+  auto sequenceVector = BaseVector::wrapInSequence(lengths, 100, vector);
+
+  raw_vector<uint64_t> hashes(100);
+  std::fill(hashes.begin(), hashes.end(), 0);
+  hasher->decode(*sequenceVector, oddRows_);
+  hasher->hash(oddRows_, false, hashes);
+  for (int32_t i = 0; i < 100; i++) {
+    if (i % 2 == 0) {
+      EXPECT_EQ(hashes[i], 0) << "at " << i;
+    } else {
+      EXPECT_EQ(hashes[i], folly::hasher<int64_t>()(i / 10 + 3)) << "at " << i;
+    }
+  }
+
+  hasher->decode(*sequenceVector, allRows_);
+  hasher->hash(allRows_, false, hashes);
+  for (int32_t i = 0; i < 100; i++) {
+    EXPECT_EQ(hashes[i], folly::hasher<int64_t>()(i / 10 + 3)) << "at " << i;
+  }
+}
+
 // Tests how strings are mapped to uint64_t (if they fit) and to
 // consecutive ids of distinct values for the general case.
 TEST_F(VectorHasherTest, stringIds) {
@@ -847,6 +878,165 @@ TEST_F(VectorHasherTest, computeValueIdsStrings) {
   }
 }
 
+TEST_F(VectorHasherTest, hashSharedDictionary) {
+  // The batches of a scan wrap the same dictionary, which is larger than a
+  // batch. The hashes kept for the dictionary are used when the next batch
+  // has the same base and dropped when the base changes.
+  auto makeBase = [&](int32_t seed) {
+    return makeFlatVector<std::string>(1'000, [seed](auto row) {
+      return fmt::format("dictionary value {}", row * seed);
+    });
+  };
+  constexpr vector_size_t kBatchSize = 100;
+  auto makeBatch = [&](const VectorPtr& base, vector_size_t batch) {
+    return BaseVector::wrapInDictionary(
+        makeNulls(kBatchSize, [](auto row) { return row % 11 == 0; }),
+        makeIndices(
+            kBatchSize,
+            [batch](auto row) { return (batch * 37 + row * 7) % 1'000; }),
+        kBatchSize,
+        base);
+  };
+
+  VectorHasher hasher(VARCHAR(), 0);
+  SelectivityVector rows(kBatchSize);
+  raw_vector<uint64_t> result(kBatchSize);
+  for (const auto seed : {1, 3}) {
+    auto base = makeBase(seed);
+    for (auto i = 0; i < 10; ++i) {
+      auto batch = makeBatch(base, i);
+      hasher.decode(*batch, rows);
+      hasher.hash(rows, false, result);
+      for (auto row = 0; row < kBatchSize; ++row) {
+        ASSERT_EQ(
+            result[row],
+            batch->isNullAt(row) ? VectorHasher::kNullHash
+                                 : batch->hashValueAt(row))
+            << "at " << row;
+      }
+    }
+  }
+}
+
+TEST_F(VectorHasherTest, complexTypes) {
+  // Complex type hashes are computed one child vector at a time and must
+  // match hashValueAt(), which hash tables use to rehash stored rows.
+  constexpr vector_size_t kSize = 200;
+  auto arrays = makeArrayVector<int64_t>(
+      kSize,
+      [](vector_size_t row) { return row % 5; },
+      [](vector_size_t index) { return index * 3; },
+      nullEvery(7),
+      nullEvery(4));
+  auto maps = makeMapVector<int32_t, std::string>(
+      kSize,
+      [](vector_size_t row) { return row % 4; },
+      [](vector_size_t index) { return index; },
+      [](vector_size_t index) { return fmt::format("value {}", index); },
+      nullEvery(9),
+      nullEvery(6));
+  auto nestedArrays =
+      makeArrayVector({0, 3, 3, 10, 50, 120}, arrays, /*nulls=*/{1});
+  auto rowVector = makeRowVector(
+      {arrays,
+       maps,
+       makeFlatVector<double>(
+           kSize, [](auto row) { return row / 3.0; }, nullEvery(8)),
+       makeRowVector(
+           {makeFlatVector<int16_t>(kSize, [](auto row) { return row; })},
+           nullEvery(10))},
+      nullEvery(13));
+  auto dictionary = wrapInDictionary(
+      makeIndices(kSize, [](auto row) { return (row * 11) % kSize; }),
+      kSize,
+      rowVector);
+  auto nullsInDictionary = BaseVector::wrapInDictionary(
+      makeNulls(kSize, [](auto row) { return row % 3 == 0; }),
+      makeIndices(kSize, [](auto row) { return kSize - row - 1; }),
+      kSize,
+      maps);
+
+  for (const auto& vector : std::vector<VectorPtr>{
+           arrays,
+           maps,
+           nestedArrays,
+           rowVector,
+           dictionary,
+           nullsInDictionary}) {
+    SCOPED_TRACE(vector->toString());
+    VectorHasher hasher(vector->type(), 0);
+    for (const auto& rows :
+         {SelectivityVector(vector->size()), makeOddRows(vector->size())}) {
+      raw_vector<uint64_t> result(vector->size());
+      hasher.decode(*vector, rows);
+      hasher.hash(rows, false, result);
+      rows.applyToSelected([&](auto row) {
+        ASSERT_EQ(result[row], vector->hashValueAt(row)) << "at " << row;
+      });
+
+      raw_vector<uint64_t> mixed(vector->size());
+      std::fill(mixed.begin(), mixed.end(), 1);
+      hasher.hash(rows, true, mixed);
+      rows.applyToSelected([&](auto row) {
+        ASSERT_EQ(mixed[row], bits::hashMix(1, vector->hashValueAt(row)))
+            << "at " << row;
+      });
+    }
+  }
+}
+
+TEST_F(VectorHasherTest, computeValueIdsSharedDictionary) {
+  // The batches of a scan wrap the same dictionary, which is larger than a
+  // batch.
+  auto base = makeFlatVector<std::string>(
+      1'000, [](auto row) { return fmt::format("dictionary value {}", row); });
+  constexpr vector_size_t kBatchSize = 100;
+  auto makeBatch = [&](vector_size_t batch) {
+    return BaseVector::wrapInDictionary(
+        BufferPtr(nullptr),
+        makeIndices(
+            kBatchSize,
+            [batch](auto row) { return (batch * 37 + row * 7) % 1'000; }),
+        kBatchSize,
+        base);
+  };
+
+  VectorHasher hasher(VARCHAR(), 0);
+  SelectivityVector rows(kBatchSize);
+  raw_vector<uint64_t> result(kBatchSize);
+  auto batch = makeBatch(0);
+  hasher.decode(*batch, rows);
+  ASSERT_FALSE(hasher.computeValueIds(rows, result));
+  hasher.enableValueIds(1, VectorHasher::kNoLimit);
+
+  // A value keeps its id over the batches, also when it comes from the ids
+  // kept for the dictionary.
+  std::unordered_map<std::string, uint64_t> ids;
+  std::unordered_set<uint64_t> distinctIds;
+  for (auto i = 0; i < 20; ++i) {
+    batch = makeBatch(i);
+    hasher.decode(*batch, rows);
+    ASSERT_TRUE(hasher.computeValueIds(rows, result));
+    auto* strings = batch->as<SimpleVector<StringView>>();
+    for (auto row = 0; row < kBatchSize; ++row) {
+      auto it = ids.emplace(strings->valueAt(row).str(), result[row]).first;
+      ASSERT_EQ(it->second, result[row]) << "at " << row;
+      distinctIds.insert(result[row]);
+    }
+  }
+  ASSERT_EQ(ids.size(), distinctIds.size());
+
+  // A new mapping does not use the ids of the old one.
+  hasher.enableValueIds(7, VectorHasher::kNoLimit);
+  std::fill(result.begin(), result.end(), 0);
+  hasher.decode(*batch, rows);
+  ASSERT_TRUE(hasher.computeValueIds(rows, result));
+  auto* strings = batch->as<SimpleVector<StringView>>();
+  for (auto row = 0; row < kBatchSize; ++row) {
+    ASSERT_EQ(result[row], 7 * ids[strings->valueAt(row).str()]);
+  }
+}
+
 namespace {
 
 // enum for marking special values to be tested in a type.
@@ -79,6 +79,57 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, spillStreamingWindow) {
+  const vector_size_t size = 1'000;
+  // Few large partitions and many small ones, so that spilled partitions are
+  // restored both after and before the next partition is received.
+  for (const int16_t numPartitions : {3, 50}) {
+    SCOPED_TRACE(fmt::format("numPartitions: {}", numPartitions));
+    auto data = makeRowVector(
+        {"d", "p", "s"},
+        {
+            // Payload.
+            makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+            // Partition key.
+            makeFlatVector<int16_t>(
+                size, [&](auto row) { return row % numPartitions; }),
+            // Sorting key.
+            makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+        });
+
+    createDuckDbTable({data});
+
+    core::PlanNodeId windowId;
+    auto plan = PlanBuilder()
+                    .values(split(data, 10))
+                    .orderBy({"p", "s"}, false)
+                    .streamingWindow(
+                        {"row_number() over (partition by p order by s)",
+                         "sum(d) over (partition by p order by s)"})
+                    .capturePlanNodeId(windowId)
+                    .planNode();
+
+    auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "32")
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kWindowSpillEnabled, "true")
+            .spillDirectory(spillDirectory->getPath())
+            .assertResults(
+                "SELECT *, row_number() over (partition by p order by s), "
+                "sum(d) over (partition by p order by s) FROM tmp");
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = taskStats.at(windowId);
+
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledFiles, 0);
+  }
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
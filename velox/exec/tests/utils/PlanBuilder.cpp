@@ -17,6 +17,7 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/TableHandle.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
 #include "velox/connectors/tpch/TpchConnector.h"
 #include "velox/duckdb/conversion/DuckParser.h"
 #include "velox/exec/Aggregate.h"
@@ -43,6 +44,7 @@ namespace {
 // TODO Avoid duplication.
 static const std::string kHiveConnectorId = "test-hive";
 static const std::string kTpchConnectorId = "test-tpch";
+static const std::string kTpcdsConnectorId = "test-tpcds";
 
 core::TypedExprPtr parseExpr(
     const std::string& text,
@@ -143,6 +145,32 @@ PlanBuilder& PlanBuilder::tpchTableScan(
       .endTableScan();
 }
 
+PlanBuilder& PlanBuilder::tpcdsTableScan(
+    tpcds::Table table,
+    std::vector<std::string>&& columnNames,
+    double scaleFactor) {
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      assignmentsMap;
+  std::vector<TypePtr> outputTypes;
+
+  assignmentsMap.reserve(columnNames.size());
+  outputTypes.reserve(columnNames.size());
+
+  for (const auto& columnName : columnNames) {
+    assignmentsMap.emplace(
+        columnName,
+        std::make_shared<connector::tpcds::TpcdsColumnHandle>(columnName));
+    outputTypes.emplace_back(resolveTpcdsColumn(table, columnName));
+  }
+  auto rowType = ROW(std::move(columnNames), std::move(outputTypes));
+  return TableScanBuilder(*this)
+      .outputType(rowType)
+      .tableHandle(std::make_shared<connector::tpcds::TpcdsTableHandle>(
+          kTpcdsConnectorId, table, scaleFactor))
+      .assignments(assignmentsMap)
+      .endTableScan();
+}
+
 core::PlanNodePtr PlanBuilder::TableScanBuilder::build(core::PlanNodeId id) {
   VELOX_CHECK_NOT_NULL(outputType_, "outputType must be specified");
   std::unordered_map<std::string, core::TypedExprPtr> typedMapping;
@@ -1041,6 +1069,12 @@ PlanBuilder& PlanBuilder::enforceSingleRow() {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::fragmentResultCache() {
+  planNode_ = std::make_shared<core::FragmentResultCacheNode>(
+      nextPlanNodeId(), planNode_);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::assignUniqueId(
     const std::string& idName,
     const int32_t taskUniqueId) {
@@ -1179,6 +1213,30 @@ PlanBuilder& PlanBuilder::partitionedOutput(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::partitionedOutputSkewAware(
+    const std::vector<std::string>& keys,
+    int numPartitions,
+    int32_t skewReplicaGroupSize,
+    const std::vector<std::string>& outputLayout) {
+  VELOX_CHECK_NOT_NULL(
+      planNode_, "PartitionedOutput cannot be the source node");
+  auto keyExprs = exprs(keys, planNode_->outputType());
+  auto outputType = outputLayout.empty()
+      ? planNode_->outputType()
+      : extract(planNode_->outputType(), outputLayout);
+  planNode_ = std::make_shared<core::PartitionedOutputNode>(
+      nextPlanNodeId(),
+      core::PartitionedOutputNode::Kind::kPartitioned,
+      keyExprs,
+      numPartitions,
+      false,
+      createPartitionFunctionSpec(planNode_->outputType(), keyExprs, pool_),
+      outputType,
+      planNode_,
+      skewReplicaGroupSize);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::partitionedOutputBroadcast(
     const std::vector<std::string>& outputLayout) {
   VELOX_CHECK_NOT_NULL(
@@ -1332,7 +1390,8 @@ PlanBuilder& PlanBuilder::hashJoin(
     const std::string& filter,
     const std::vector<std::string>& outputLayout,
     core::JoinType joinType,
-    bool nullAware) {
+    bool nullAware,
+    bool useHashTableCache) {
   VELOX_CHECK_NOT_NULL(planNode_, "HashJoin cannot be the source node");
   VELOX_CHECK_EQ(leftKeys.size(), rightKeys.size());
 
@@ -1373,7 +1432,8 @@ PlanBuilder& PlanBuilder::hashJoin(
       std::move(filterExpr),
       std::move(planNode_),
       build,
-      outputType);
+      outputType,
+      useHashTableCache);
   return *this;
 }
 
@@ -1441,6 +1501,32 @@ PlanBuilder& PlanBuilder::nestedLoopJoin(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::indexLookupJoin(
+    const std::vector<std::string>& leftKeys,
+    const std::vector<std::string>& rightKeys,
+    const std::shared_ptr<const core::TableScanNode>& lookupSource,
+    const std::vector<std::string>& outputLayout,
+    core::JoinType joinType) {
+  VELOX_CHECK_NOT_NULL(planNode_, "IndexLookupJoin cannot be the source node");
+  VELOX_CHECK_EQ(leftKeys.size(), rightKeys.size());
+
+  auto leftType = planNode_->outputType();
+  auto rightType = lookupSource->outputType();
+  auto outputType = extract(concat(leftType, rightType), outputLayout);
+  auto leftKeyFields = fields(leftType, leftKeys);
+  auto rightKeyFields = fields(rightType, rightKeys);
+
+  planNode_ = std::make_shared<core::IndexLookupJoinNode>(
+      nextPlanNodeId(),
+      joinType,
+      leftKeyFields,
+      rightKeyFields,
+      std::move(planNode_),
+      lookupSource,
+      outputType);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::unnest(
     const std::vector<std::string>& replicateColumns,
     const std::vector<std::string>& unnestColumns,
@@ -31,6 +31,10 @@ namespace facebook::velox::tpch {
 enum class Table : uint8_t;
 }
 
+namespace facebook::velox::tpcds {
+enum class Table : uint8_t;
+}
+
 namespace facebook::velox::exec::test {
 
 /// A builder class with fluent API for building query plans. Plans are built
@@ -164,6 +168,16 @@ class PlanBuilder {
       std::vector<std::string>&& columnNames,
       double scaleFactor = 1);
 
+  /// Add a TableScanNode to scan a TPC-DS table.
+  ///
+  /// @param table The TPC-DS table to scan.
+  /// @param columnNames The columns to be returned from that table.
+  /// @param scaleFactor The TPC-DS scale factor.
+  PlanBuilder& tpcdsTableScan(
+      tpcds::Table table,
+      std::vector<std::string>&& columnNames,
+      double scaleFactor = 1);
+
   /// Helper class to build a custom TableScanNode.
   /// Uses a planBuilder instance to get the next plan id, memory pool, and
   /// parse options.
@@ -713,6 +727,10 @@ class PlanBuilder {
   /// runtime.
   PlanBuilder& enforceSingleRow();
 
+  /// Add a FragmentResultCacheNode that caches the output of the current
+  /// plan, a table scan followed by filters and projections, by split.
+  PlanBuilder& fragmentResultCache();
+
   /// Add an AssignUniqueIdNode to add a column with query-scoped unique value
   /// per row.
   ///
@@ -760,6 +778,15 @@ class PlanBuilder {
       core::PartitionFunctionSpecPtr partitionFunctionSpec,
       const std::vector<std::string>& outputLayout = {});
 
+  /// Same as partitionedOutput() without replicated nulls, but spreads the
+  /// rows of skewed partitions round-robin over 'skewReplicaGroupSize'
+  /// destinations. See PartitionedOutputNode::skewReplicaGroupSize().
+  PlanBuilder& partitionedOutputSkewAware(
+      const std::vector<std::string>& keys,
+      int numPartitions,
+      int32_t skewReplicaGroupSize,
+      const std::vector<std::string>& outputLayout = {});
+
   /// Adds a PartitionedOutputNode to broadcast the input data.
   ///
   /// @param outputLayout Optional output layout in case it is different then
@@ -828,6 +855,9 @@ class PlanBuilder {
   /// @param joinType Type of the join: inner, left, right, full, semi, or anti.
   /// @param nullAware Applies to semi and anti joins. Indicates whether the
   /// join follows IN (null-aware) or EXISTS (regular) semantic.
+  /// @param useHashTableCache Makes the tasks of the query share one hash
+  /// table built from a broadcast build side. See
+  /// core::HashJoinNode::useHashTableCache().
   PlanBuilder& hashJoin(
       const std::vector<std::string>& leftKeys,
       const std::vector<std::string>& rightKeys,
@@ -835,7 +865,8 @@ class PlanBuilder {
       const std::string& filter,
       const std::vector<std::string>& outputLayout,
       core::JoinType joinType = core::JoinType::kInner,
-      bool nullAware = false);
+      bool nullAware = false,
+      bool useHashTableCache = false);
 
   /// Add a MergeJoinNode to join two inputs using one or more join keys and an
   /// optional filter. The caller is responsible to ensure that inputs are
@@ -881,6 +912,23 @@ class PlanBuilder {
       const std::vector<std::string>& outputLayout,
       core::JoinType joinType = core::JoinType::kInner);
 
+  /// Add an IndexLookupJoinNode to join the input with a table that is looked
+  /// up by keys instead of scanned.
+  ///
+  /// @param leftKeys Join keys from the input, one or more.
+  /// @param rightKeys Key columns of the table. Same number as leftKeys.
+  /// @param lookupSource TableScanNode of the table. Its connector must
+  /// support index lookup. It gets no splits.
+  /// @param outputLayout Output layout consisting of columns from the input
+  /// and the table.
+  /// @param joinType Type of the join: inner or left.
+  PlanBuilder& indexLookupJoin(
+      const std::vector<std::string>& leftKeys,
+      const std::vector<std::string>& rightKeys,
+      const std::shared_ptr<const core::TableScanNode>& lookupSource,
+      const std::vector<std::string>& outputLayout,
+      core::JoinType joinType = core::JoinType::kInner);
+
   /// Add an UnnestNode to unnest one or more columns of type array or map.
   ///
   /// The output will contain 'replicatedColumns' followed by unnested columns,
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/tests/utils/TestIndexConnector.h"
+
+#include <numeric>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+uint64_t hashKeys(
+    const std::vector<VectorPtr>& keys,
+    const std::vector<column_index_t>& channels,
+    vector_size_t row) {
+  uint64_t hash = 0;
+  for (auto i = 0; i < channels.size(); ++i) {
+    const auto keyHash = keys[channels[i]]->hashValueAt(row);
+    hash = i == 0 ? keyHash : bits::hashMix(hash, keyHash);
+  }
+  return hash;
+}
+
+class TestIndexResultIterator
+    : public connector::IndexSource::LookupResultIterator,
+      public std::enable_shared_from_this<TestIndexResultIterator> {
+ public:
+  TestIndexResultIterator(
+      std::shared_ptr<TestIndexSource::Index> index,
+      RowVectorPtr input,
+      memory::MemoryPool* pool,
+      folly::Executor* executor)
+      : index_(std::move(index)),
+        input_(std::move(input)),
+        pool_(pool),
+        executor_(executor) {}
+
+  std::optional<std::unique_ptr<connector::IndexSource::LookupResult>> next(
+      vector_size_t size,
+      ContinueFuture& future) override {
+    if (!started_) {
+      started_ = true;
+      if (executor_ != nullptr) {
+        auto [promise, lookupFuture] =
+            makeVeloxContinuePromiseContract("TestIndexResultIterator::next");
+        future = std::move(lookupFuture);
+        executor_->add([self = shared_from_this(),
+                        promise = std::move(promise)]() mutable {
+          self->findMatches();
+          promise.setValue();
+        });
+        return std::nullopt;
+      }
+      findMatches();
+    }
+
+    const vector_size_t numMatches = inputRows_.size();
+    if (offset_ == numMatches) {
+      return nullptr;
+    }
+    const auto numRows = std::min(size, numMatches - offset_);
+    auto inputHits = allocateIndices(numRows, pool_);
+    auto tableIndices = allocateIndices(numRows, pool_);
+    std::copy(
+        inputRows_.begin() + offset_,
+        inputRows_.begin() + offset_ + numRows,
+        inputHits->asMutable<vector_size_t>());
+    std::copy(
+        tableRows_.begin() + offset_,
+        tableRows_.begin() + offset_ + numRows,
+        tableIndices->asMutable<vector_size_t>());
+    offset_ += numRows;
+
+    std::vector<VectorPtr> children;
+    children.reserve(index_->outputChannels.size());
+    for (const auto channel : index_->outputChannels) {
+      children.push_back(BaseVector::wrapInDictionary(
+          nullptr, tableIndices, numRows, index_->table->childAt(channel)));
+    }
+    return std::make_unique<connector::IndexSource::LookupResult>(
+        std::move(inputHits),
+        std::make_shared<RowVector>(
+            pool_, index_->outputType, nullptr, numRows, std::move(children)));
+  }
+
+ private:
+  void findMatches() {
+    const auto& table = *index_->table;
+    const auto& keys = input_->children();
+    std::vector<column_index_t> inputChannels(keys.size());
+    std::iota(inputChannels.begin(), inputChannels.end(), 0);
+    for (vector_size_t row = 0; row < input_->size(); ++row) {
+      const bool hasNull =
+          std::any_of(keys.begin(), keys.end(), [&](const auto& key) {
+            return key->isNullAt(row);
+          });
+      if (hasNull) {
+        continue;
+      }
+      auto range = index_->rows.equal_range(hashKeys(keys, inputChannels, row));
+      for (auto it = range.first; it != range.second; ++it) {
+        bool match = true;
+        for (auto i = 0; i < keys.size() && match; ++i) {
+          match = table.childAt(index_->keyChannels[i])
+                      ->equalValueAt(keys[i].get(), it->second, row);
+        }
+        if (match) {
+          inputRows_.push_back(row);
+          tableRows_.push_back(it->second);
+        }
+      }
+    }
+  }
+
+  const std::shared_ptr<TestIndexSource::Index> index_;
+  const RowVectorPtr input_;
+  memory::MemoryPool* const pool_;
+  folly::Executor* const executor_;
+
+  bool started_{false};
+  // The matching input and table rows, in the order of the input rows.
+  std::vector<vector_size_t> inputRows_;
+  std::vector<vector_size_t> tableRows_;
+  vector_size_t offset_{0};
+};
+
+column_index_t tableChannel(
+    const RowVector& table,
+    const std::string& name,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles) {
+  auto it = columnHandles.find(name);
+  VELOX_CHECK(it != columnHandles.end(), "No column handle for {}", name);
+  auto handle = std::dynamic_pointer_cast<TestIndexColumnHandle>(it->second);
+  VELOX_CHECK_NOT_NULL(handle);
+  return table.type()->asRow().getChildIdx(handle->name());
+}
+} // namespace
+
+TestIndexSource::TestIndexSource(
+    const RowTypePtr& keyType,
+    const RowTypePtr& outputType,
+    const std::shared_ptr<TestIndexTableHandle>& tableHandle,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    memory::MemoryPool* pool,
+    folly::Executor* executor)
+    : index_(std::make_shared<Index>()), pool_(pool), executor_(executor) {
+  index_->table = tableHandle->data();
+  index_->outputType = outputType;
+  for (const auto& name : keyType->names()) {
+    index_->keyChannels.push_back(
+        tableChannel(*index_->table, name, columnHandles));
+  }
+  for (const auto& name : outputType->names()) {
+    index_->outputChannels.push_back(
+        tableChannel(*index_->table, name, columnHandles));
+  }
+
+  const auto& columns = index_->table->children();
+  for (vector_size_t row = 0; row < index_->table->size(); ++row) {
+    index_->rows.emplace(hashKeys(columns, index_->keyChannels, row), row);
+  }
+}
+
+std::shared_ptr<connector::IndexSource::LookupResultIterator>
+TestIndexSource::lookup(const LookupRequest& request) {
+  ++numLookups_;
+  return std::make_shared<TestIndexResultIterator>(
+      index_, request.input, pool_, executor_);
+}
+
+std::shared_ptr<connector::IndexSource> TestIndexConnector::createIndexSource(
+    const RowTypePtr& keyType,
+    const RowTypePtr& outputType,
+    const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    connector::ConnectorQueryCtx* connectorQueryCtx) {
+  auto indexTableHandle =
+      std::dynamic_pointer_cast<TestIndexTableHandle>(tableHandle);
+  VELOX_CHECK_NOT_NULL(indexTableHandle);
+  return std::make_shared<TestIndexSource>(
+      keyType,
+      outputType,
+      indexTableHandle,
+      columnHandles,
+      connectorQueryCtx->memoryPool(),
+      executor_);
+}
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Executor.h>
+
+#include "velox/connectors/Connector.h"
+
+namespace facebook::velox::exec::test {
+
+/// An in-memory table of TestIndexConnector. 'data' has all the rows.
+class TestIndexTableHandle : public connector::ConnectorTableHandle {
+ public:
+  TestIndexTableHandle(std::string connectorId, RowVectorPtr data)
+      : ConnectorTableHandle(std::move(connectorId)), data_(std::move(data)) {}
+
+  std::string toString() const override {
+    return "test-index-table";
+  }
+
+  const RowVectorPtr& data() const {
+    return data_;
+  }
+
+ private:
+  const RowVectorPtr data_;
+};
+
+/// Refers to a column of TestIndexTableHandle::data() by name.
+class TestIndexColumnHandle : public connector::ColumnHandle {
+ public:
+  explicit TestIndexColumnHandle(std::string name) : name_(std::move(name)) {}
+
+  const std::string& name() const {
+    return name_;
+  }
+
+ private:
+  const std::string name_;
+};
+
+/// Looks up the rows of a TestIndexTableHandle with a hash table on the key
+/// columns. Runs the lookups on 'executor' if it is set.
+class TestIndexSource : public connector::IndexSource {
+ public:
+  TestIndexSource(
+      const RowTypePtr& keyType,
+      const RowTypePtr& outputType,
+      const std::shared_ptr<TestIndexTableHandle>& tableHandle,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      memory::MemoryPool* pool,
+      folly::Executor* executor);
+
+  std::shared_ptr<LookupResultIterator> lookup(
+      const LookupRequest& request) override;
+
+  std::unordered_map<std::string, RuntimeCounter> runtimeStats() override {
+    return {{"numLookups", RuntimeCounter(numLookups_)}};
+  }
+
+  /// The table and its hash table on the key columns. Shared with the
+  /// iterators, which may run on the executor after 'this' is destroyed.
+  struct Index {
+    RowVectorPtr table;
+    // Channels of the key columns in 'table'.
+    std::vector<column_index_t> keyChannels;
+    // Channels of the output columns in 'table'.
+    std::vector<column_index_t> outputChannels;
+    RowTypePtr outputType;
+    // Hash of the keys to row number in 'table'.
+    std::unordered_multimap<uint64_t, vector_size_t> rows;
+  };
+
+ private:
+  std::shared_ptr<Index> index_;
+  memory::MemoryPool* const pool_;
+  folly::Executor* const executor_;
+  int64_t numLookups_{0};
+};
+
+/// A connector over in-memory tables that supports index lookups and no
+/// scans. Used to test IndexLookupJoin. If 'executor' is set, the lookups run
+/// on it and the join waits for them.
+class TestIndexConnector : public connector::Connector {
+ public:
+  explicit TestIndexConnector(
+      const std::string& id,
+      folly::Executor* executor = nullptr)
+      : Connector(id), executor_(executor) {}
+
+  std::unique_ptr<connector::DataSource> createDataSource(
+      const RowTypePtr& /*outputType*/,
+      const std::shared_ptr<connector::ConnectorTableHandle>& /*tableHandle*/,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& /*columnHandles*/,
+      connector::ConnectorQueryCtx* /*connectorQueryCtx*/) override {
+    VELOX_UNSUPPORTED("TestIndexConnector does not support scans");
+  }
+
+  bool supportsIndexLookup() const override {
+    return true;
+  }
+
+  std::shared_ptr<connector::IndexSource> createIndexSource(
+      const RowTypePtr& keyType,
+      const RowTypePtr& outputType,
+      const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
+      const std::unordered_map<
+          std::string,
+          std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      connector::ConnectorQueryCtx* connectorQueryCtx) override;
+
+  std::unique_ptr<connector::DataSink> createDataSink(
+      RowTypePtr /*inputType*/,
+      std::shared_ptr<
+          connector::ConnectorInsertTableHandle> /*insertTableHandle*/,
+      connector::ConnectorQueryCtx* /*connectorQueryCtx*/,
+      connector::CommitStrategy /*commitStrategy*/) override {
+    VELOX_UNSUPPORTED("TestIndexConnector does not support writes");
+  }
+
+  folly::Executor* executor() const override {
+    return executor_;
+  }
+
+ private:
+  folly::Executor* const executor_;
+};
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+using tpcds::Table;
+
+namespace {
+
+// Returns the grouping sets of ROLLUP('keys'): all the prefixes of 'keys',
+// longest first.
+std::vector<std::vector<std::string>> rollup(
+    const std::vector<std::string>& keys) {
+  std::vector<std::vector<std::string>> groupingSets;
+  for (auto size = keys.size() + 1; size > 0; --size) {
+    groupingSets.emplace_back(keys.begin(), keys.begin() + size - 1);
+  }
+  return groupingSets;
+}
+
+} // namespace
+
+const std::vector<int>& TpcdsQueryBuilder::getQueryIds() {
+  static const std::vector<int> kQueryIds = {3, 27, 67, 98};
+  return kQueryIds;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  switch (queryId) {
+    case 3:
+      return getQ3Plan();
+    case 27:
+      return getQ27Plan();
+    case 67:
+      return getQ67Plan();
+    case 98:
+      return getQ98Plan();
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+PlanBuilder TpcdsQueryBuilder::tableScan(
+    const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+    Table table,
+    std::vector<std::string>&& columns,
+    TpcdsPlan& plan) const {
+  core::PlanNodeId scanNodeId;
+  PlanBuilder builder(planNodeIdGenerator, pool_.get());
+  builder.tpcdsTableScan(table, std::move(columns), scaleFactor_)
+      .capturePlanNodeId(scanNodeId);
+  plan.scanTables.emplace(scanNodeId, table);
+  return builder;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ3Plan() const {
+  // SELECT d_year, i_brand_id brand_id, i_brand brand,
+  //     sum(ss_ext_sales_price) sum_agg
+  // FROM date_dim, store_sales, item
+  // WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk
+  //     AND i_manufact_id = 128 AND d_moy = 11
+  // GROUP BY d_year, i_brand, i_brand_id
+  // ORDER BY d_year, sum_agg DESC, brand_id
+  // LIMIT 100
+  TpcdsPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  auto dates = tableScan(
+                   planNodeIdGenerator,
+                   Table::TBL_DATE_DIM,
+                   {"d_date_sk", "d_year", "d_moy"},
+                   context)
+                   .filter("d_moy = 11")
+                   .planNode();
+
+  auto items = tableScan(
+                   planNodeIdGenerator,
+                   Table::TBL_ITEM,
+                   {"i_item_sk", "i_brand_id", "i_brand", "i_manufact_id"},
+                   context)
+                   .filter("i_manufact_id = 128")
+                   .planNode();
+
+  context.plan =
+      tableScan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+          context)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"d_year", "ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"d_year", "i_brand_id", "i_brand", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_brand", "i_brand_id"},
+              {"sum(ss_ext_sales_price) AS sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"d_year", "sum_agg DESC", "i_brand_id"}, 100, false)
+          .project(
+              {"d_year",
+               "i_brand_id AS brand_id",
+               "i_brand AS brand",
+               "sum_agg"})
+          .planNode();
+  return context;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ27Plan() const {
+  // SELECT i_item_id, s_state, grouping(s_state) g_state,
+  //     avg(ss_quantity) agg1, avg(ss_list_price) agg2,
+  //     avg(ss_coupon_amt) agg3, avg(ss_sales_price) agg4
+  // FROM store_sales, customer_demographics, date_dim, store, item
+  // WHERE ss_sold_date_sk = d_date_sk AND ss_item_sk = i_item_sk
+  //     AND ss_store_sk = s_store_sk AND ss_cdemo_sk = cd_demo_sk
+  //     AND cd_gender = 'M' AND cd_marital_status = 'S'
+  //     AND cd_education_status = 'College' AND d_year = 2002
+  //     AND s_state IN ('TN', 'SD', 'AL')
+  // GROUP BY ROLLUP (i_item_id, s_state)
+  // ORDER BY i_item_id, s_state
+  // LIMIT 100
+  TpcdsPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  auto demographics =
+      tableScan(
+          planNodeIdGenerator,
+          Table::TBL_CUSTOMER_DEMOGRAPHICS,
+          {"cd_demo_sk",
+           "cd_gender",
+           "cd_marital_status",
+           "cd_education_status"},
+          context)
+          .filter(
+              "cd_gender = 'M' AND cd_marital_status = 'S' "
+              "AND cd_education_status = 'College'")
+          .planNode();
+
+  auto dates = tableScan(
+                   planNodeIdGenerator,
+                   Table::TBL_DATE_DIM,
+                   {"d_date_sk", "d_year"},
+                   context)
+                   .filter("d_year = 2002")
+                   .planNode();
+
+  auto stores = tableScan(
+                    planNodeIdGenerator,
+                    Table::TBL_STORE,
+                    {"s_store_sk", "s_state"},
+                    context)
+                    .filter("s_state IN ('TN', 'SD', 'AL')")
+                    .planNode();
+
+  auto items = tableScan(
+                   planNodeIdGenerator,
+                   Table::TBL_ITEM,
+                   {"i_item_sk", "i_item_id"},
+                   context)
+                   .planNode();
+
+  const std::vector<std::string> measures = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+  auto withMeasures = [&](std::vector<std::string> columns) {
+    columns.insert(columns.end(), measures.begin(), measures.end());
+    return columns;
+  };
+
+  const std::vector<std::string> keys = {"i_item_id", "s_state"};
+  const std::vector<std::string> orderKeys = {"i_item_id", "s_state"};
+  context.plan =
+      tableScan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          withMeasures(
+              {"ss_sold_date_sk", "ss_item_sk", "ss_cdemo_sk", "ss_store_sk"}),
+          context)
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              withMeasures({"ss_sold_date_sk", "ss_item_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              withMeasures({"ss_item_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              withMeasures({"ss_item_sk", "s_state"}))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              withMeasures({"i_item_id", "s_state"}))
+          .groupId(keys, rollup(keys), measures)
+          .partialAggregation(
+              {"i_item_id", "s_state", "group_id"},
+              {"avg(ss_quantity) AS agg1",
+               "avg(ss_list_price) AS agg2",
+               "avg(ss_coupon_amt) AS agg3",
+               "avg(ss_sales_price) AS agg4"})
+          .localPartition({"i_item_id", "s_state", "group_id"})
+          .finalAggregation()
+          // Grouping set 0 is (i_item_id, s_state), the only one that groups
+          // by s_state.
+          .project(
+              {"i_item_id",
+               "s_state",
+               "if(group_id = 0, 0, 1) AS g_state",
+               "agg1",
+               "agg2",
+               "agg3",
+               "agg4"})
+          .topN(orderKeys, 100, true)
+          .localPartition(std::vector<std::string>{})
+          .topN(orderKeys, 100, false)
+          .planNode();
+  return context;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ67Plan() const {
+  // SELECT * FROM (
+  //     SELECT i_category, i_class, i_brand, i_product_name, d_year, d_qoy,
+  //         d_moy, s_store_id, sumsales,
+  //         rank() OVER (PARTITION BY i_category ORDER BY sumsales DESC) rk
+  //     FROM (
+  //         SELECT i_category, i_class, i_brand, i_product_name, d_year,
+  //             d_qoy, d_moy, s_store_id,
+  //             sum(coalesce(ss_sales_price * ss_quantity, 0)) sumsales
+  //         FROM store_sales, date_dim, store, item
+  //         WHERE ss_sold_date_sk = d_date_sk AND ss_item_sk = i_item_sk
+  //             AND ss_store_sk = s_store_sk
+  //             AND d_month_seq BETWEEN 1200 AND 1211
+  //         GROUP BY ROLLUP (i_category, i_class, i_brand, i_product_name,
+  //             d_year, d_qoy, d_moy, s_store_id)) dw1) dw2
+  // WHERE rk <= 100
+  // ORDER BY i_category, i_class, i_brand, i_product_name, d_year, d_qoy,
+  //     d_moy, s_store_id, sumsales, rk
+  // LIMIT 100
+  TpcdsPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  auto dates = tableScan(
+                   planNodeIdGenerator,
+                   Table::TBL_DATE_DIM,
+                   {"d_date_sk", "d_month_seq", "d_year", "d_qoy", "d_moy"},
+                   context)
+                   .filter("d_month_seq BETWEEN 1200 AND 1211")
+                   .planNode();
+
+  auto stores = tableScan(
+                    planNodeIdGenerator,
+                    Table::TBL_STORE,
+                    {"s_store_sk", "s_store_id"},
+                    context)
+                    .planNode();
+
+  auto items = tableScan(
+                   planNodeIdGenerator,
+                   Table::TBL_ITEM,
+                   {"i_item_sk",
+                    "i_category",
+                    "i_class",
+                    "i_brand",
+                    "i_product_name"},
+                   context)
+                   .planNode();
+
+  const std::vector<std::string> keys = {
+      "i_category",
+      "i_class",
+      "i_brand",
+      "i_product_name",
+      "d_year",
+      "d_qoy",
+      "d_moy",
+      "s_store_id"};
+  auto withKeys = [&](std::vector<std::string> columns) {
+    columns.insert(columns.begin(), keys.begin(), keys.end());
+    return columns;
+  };
+  auto orderKeys = keys;
+  orderKeys.push_back("sumsales");
+  orderKeys.push_back("rk");
+
+  context.plan =
+      tableScan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          {"ss_sold_date_sk",
+           "ss_item_sk",
+           "ss_store_sk",
+           "ss_sales_price",
+           "ss_quantity"},
+          context)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk",
+               "ss_store_sk",
+               "d_year",
+               "d_qoy",
+               "d_moy",
+               "ss_sales_price",
+               "ss_quantity"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"ss_item_sk",
+               "s_store_id",
+               "d_year",
+               "d_qoy",
+               "d_moy",
+               "ss_sales_price",
+               "ss_quantity"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              withKeys({"ss_sales_price", "ss_quantity"}))
+          .project(withKeys(
+              {"coalesce(ss_sales_price * cast(ss_quantity AS DOUBLE), 0.0) "
+               "AS sales"}))
+          .groupId(keys, rollup(keys), {"sales"})
+          .partialAggregation(
+              withKeys({"group_id"}), {"sum(sales) AS sumsales"})
+          .localPartition({"i_category"})
+          .finalAggregation()
+          .window(
+              {"rank() OVER (PARTITION BY i_category ORDER BY sumsales DESC) "
+               "AS rk"})
+          .filter("rk <= 100")
+          .project(withKeys({"sumsales", "rk"}))
+          .topN(orderKeys, 100, true)
+          .localPartition(std::vector<std::string>{})
+          .topN(orderKeys, 100, false)
+          .planNode();
+  return context;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ98Plan() const {
+  // SELECT i_item_id, i_item_desc, i_category, i_class, i_current_price,
+  //     sum(ss_ext_sales_price) AS itemrevenue,
+  //     sum(ss_ext_sales_price) * 100 / sum(sum(ss_ext_sales_price))
+  //         OVER (PARTITION BY i_class) AS revenueratio
+  // FROM store_sales, item, date_dim
+  // WHERE ss_item_sk = i_item_sk
+  //     AND i_category IN ('Sports', 'Books', 'Home')
+  //     AND ss_sold_date_sk = d_date_sk
+  //     AND d_date BETWEEN cast('1999-02-22' AS date)
+  //         AND (cast('1999-02-22' AS date) + INTERVAL '30' DAY)
+  // GROUP BY i_item_id, i_item_desc, i_category, i_class, i_current_price
+  // ORDER BY i_category, i_class, i_item_id, i_item_desc, revenueratio
+  TpcdsPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  auto dates =
+      tableScan(
+          planNodeIdGenerator,
+          Table::TBL_DATE_DIM,
+          {"d_date_sk", "d_date"},
+          context)
+          .filter("d_date BETWEEN '1999-02-22'::DATE AND '1999-03-24'::DATE")
+          .planNode();
+
+  const std::vector<std::string> keys = {
+      "i_item_id", "i_item_desc", "i_category", "i_class", "i_current_price"};
+  auto withKeys = [&](std::vector<std::string> columns) {
+    columns.insert(columns.begin(), keys.begin(), keys.end());
+    return columns;
+  };
+
+  auto items = tableScan(
+                   planNodeIdGenerator,
+                   Table::TBL_ITEM,
+                   withKeys({"i_item_sk"}),
+                   context)
+                   .filter("i_category IN ('Sports', 'Books', 'Home')")
+                   .planNode();
+
+  context.plan =
+      tableScan(
+          planNodeIdGenerator,
+          Table::TBL_STORE_SALES,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+          context)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              withKeys({"ss_ext_sales_price"}))
+          .partialAggregation(keys, {"sum(ss_ext_sales_price) AS itemrevenue"})
+          .localPartition({"i_class"})
+          .finalAggregation()
+          .window({"sum(itemrevenue) OVER (PARTITION BY i_class) AS revenue"})
+          .project(withKeys(
+              {"itemrevenue", "itemrevenue * 100.0 / revenue AS revenueratio"}))
+          .localPartition(std::vector<std::string>{})
+          .orderBy(
+              {"i_category",
+               "i_class",
+               "i_item_id",
+               "i_item_desc",
+               "revenueratio"},
+              false)
+          .planNode();
+  return context;
+}
+
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/tpcds/gen/TpcdsGen.h"
+
+namespace facebook::velox::exec::test {
+
+/// Contains the query plan and the TPC-DS table scanned by each source plan
+/// node, keyed on plan node ID.
+struct TpcdsPlan {
+  core::PlanNodePtr plan;
+  std::unordered_map<core::PlanNodeId, tpcds::Table> scanTables;
+};
+
+/// Builds plans for a subset of the TPC-DS queries that read generated data
+/// from the TPC-DS connector registered under the "test-tpcds" id. The subset
+/// covers the shapes TPC-H does not: star joins of store_sales with several
+/// dimensions, ROLLUP through GroupId and window functions over the
+/// aggregates. Scans are followed by filters since the connector does not
+/// support filter pushdown.
+class TpcdsQueryBuilder {
+ public:
+  explicit TpcdsQueryBuilder(double scaleFactor) : scaleFactor_(scaleFactor) {}
+
+  /// Get the query plan for a given TPC-DS query number. Throws if the query
+  /// is not one of getQueryIds().
+  /// @param queryId TPC-DS query number
+  TpcdsPlan getQueryPlan(int queryId) const;
+
+  /// Returns the TPC-DS query numbers that have a plan.
+  static const std::vector<int>& getQueryIds();
+
+ private:
+  TpcdsPlan getQ3Plan() const;
+  TpcdsPlan getQ27Plan() const;
+  TpcdsPlan getQ67Plan() const;
+  TpcdsPlan getQ98Plan() const;
+
+  // Returns a builder that scans 'columns' of 'table' and records the scan in
+  // 'plan'.
+  PlanBuilder tableScan(
+      const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+      tpcds::Table table,
+      std::vector<std::string>&& columns,
+      TpcdsPlan& plan) const;
+
+  const double scaleFactor_;
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::memoryManager()->addLeafPool();
+};
+
+} // namespace facebook::velox::exec::test
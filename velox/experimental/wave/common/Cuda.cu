@@ -99,6 +99,14 @@ GpuAllocator* getHostAllocator(Device* /*device*/) {
   return allocator;
 }
 
+void pinHostMemory(void* ptr, size_t size) {
+  CUDA_CHECK(cudaHostRegister(ptr, size, cudaHostRegisterDefault));
+}
+
+void unpinHostMemory(void* ptr) {
+  CUDA_CHECK(cudaHostUnregister(ptr));
+}
+
 // Always returns device 0.
 Device* getDevice(int32_t /*preferredDevice*/) {
   static Device device(0);
@@ -151,6 +151,14 @@ GpuAllocator* getDeviceAllocator(Device* device);
 /// Returns an allocator that produces pinned host memory.
 GpuAllocator* getHostAllocator(Device* device);
 
+/// Page-locks 'size' bytes of host memory at 'ptr' so that it can be the
+/// source or target of asynchronous copies. The memory is allocated by the
+/// caller and must be unpinned with unpinHostMemory() before being freed.
+void pinHostMemory(void* ptr, size_t size);
+
+/// Reverts pinHostMemory() of 'ptr'.
+void unpinHostMemory(void* ptr);
+
 class GpuAllocator::Deleter {
  public:
   Deleter() = default;
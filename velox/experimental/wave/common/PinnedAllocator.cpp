@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/common/PinnedAllocator.h"
+
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::wave {
+
+void* PinnedAllocator::allocate(size_t bytes) {
+  auto* ptr = allocator_->allocateBytes(bytes);
+  if (FOLLY_UNLIKELY(ptr == nullptr)) {
+    VELOX_MEM_ALLOC_ERROR(fmt::format(
+        "Failed to allocate {} bytes of pinned memory: {}",
+        bytes,
+        allocator_->getAndClearFailureMessage()));
+  }
+  pinHostMemory(ptr, bytes);
+  return ptr;
+}
+
+void PinnedAllocator::free(void* ptr, size_t bytes) {
+  unpinHostMemory(ptr);
+  allocator_->freeBytes(ptr, bytes);
+}
+
+} // namespace facebook::velox::wave
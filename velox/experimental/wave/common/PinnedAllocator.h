@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+
+namespace facebook::velox::memory {
+class MemoryAllocator;
+}
+
+namespace facebook::velox::wave {
+
+/// GpuAllocator that takes host memory from a MemoryAllocator and pins it for
+/// asynchronous copies to and from device. Unlike getHostAllocator(), the
+/// memory is accounted against the capacity of the MemoryAllocator. Pinning is
+/// expensive, so this is meant to back a GpuArena that allocates large slabs
+/// and reuses them.
+class PinnedAllocator : public GpuAllocator {
+ public:
+  explicit PinnedAllocator(memory::MemoryAllocator* allocator)
+      : allocator_(allocator) {}
+
+  void* allocate(size_t bytes) override;
+
+  void free(void* ptr, size_t bytes) override;
+
+ private:
+  memory::MemoryAllocator* const allocator_;
+};
+
+} // namespace facebook::velox::wave
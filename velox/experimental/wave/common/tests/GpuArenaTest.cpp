@@ -18,6 +18,8 @@
 #include <folly/Random.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/memory/MallocAllocator.h"
+#include "velox/experimental/wave/common/PinnedAllocator.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::wave;
@@ -175,3 +177,32 @@ TEST_F(GpuArenaTest, views) {
   // This is reference to freed but the header is still in the arena.
   EXPECT_EQ(0, raw->refCount());
 }
+
+TEST_F(GpuArenaTest, pinned) {
+  auto memoryAllocator =
+      std::make_shared<memory::MallocAllocator>(64 << 20, 0);
+  PinnedAllocator pinned(memoryAllocator.get());
+  auto arena = std::make_unique<GpuArena>(1 << 20, &pinned);
+  auto deviceArena =
+      std::make_unique<GpuArena>(1 << 20, getAllocator(getDevice()));
+  // The slab of the pinned arena counts against the MemoryAllocator.
+  EXPECT_LE(1 << 20, memoryAllocator->totalUsedBytes());
+
+  constexpr int32_t kSize = 10000;
+  auto host = arena->allocate<int32_t>(kSize);
+  auto device = deviceArena->allocate<int32_t>(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    host->as<int32_t>()[i] = i;
+  }
+  Stream stream;
+  stream.hostToDeviceAsync(
+      device->as<int32_t>(), host->as<int32_t>(), kSize * sizeof(int32_t));
+  stream.wait();
+  for (auto i = 0; i < kSize; ++i) {
+    ASSERT_EQ(i, device->as<int32_t>()[i]);
+  }
+
+  host = nullptr;
+  arena.reset();
+  EXPECT_EQ(0, memoryAllocator->totalUsedBytes());
+}
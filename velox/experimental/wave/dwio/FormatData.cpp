@@ -50,10 +50,18 @@ void SplitStaging::transfer(WaveStream& waveStream, Stream& stream) {
   deviceBuffer_ = waveStream.arena().allocate<char>(fill_);
   auto universal = deviceBuffer_->as<char>();
   for (auto i = 0; i < offsets_.size(); ++i) {
-    memcpy(universal + offsets_[i], staging_[i].hostData, staging_[i].size);
+    if (!staging_[i].pinned) {
+      memcpy(universal + offsets_[i], staging_[i].hostData, staging_[i].size);
+    }
   }
   stream.prefetch(
       getDevice(), deviceBuffer_->as<char>(), deviceBuffer_->size());
+  for (auto i = 0; i < offsets_.size(); ++i) {
+    if (staging_[i].pinned) {
+      stream.hostToDeviceAsync(
+          universal + offsets_[i], staging_[i].hostData, staging_[i].size);
+    }
+  }
   for (auto& pair : patch_) {
     *reinterpret_cast<int64_t*>(pair.second) +=
         reinterpret_cast<int64_t>(universal) + offsets_[pair.first];
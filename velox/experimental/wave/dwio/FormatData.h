@@ -34,8 +34,11 @@ class WaveStream;
 // Describes how a column is staged on GPU, for example, copy from host RAM,
 // direct read, already on device etc.
 struct Staging {
-  Staging(const void* hostData, int32_t size)
-      : hostData(hostData), size(size) {}
+  Staging(
+      const void* hostData,
+      int32_t size,
+      std::shared_ptr<const void> pinned = nullptr)
+      : hostData(hostData), size(size), pinned(std::move(pinned)) {}
 
   // Pointer to data in pageable host memory, if applicable.
   const void* hostData{nullptr};
@@ -43,6 +46,12 @@ struct Staging {
   //  Size in bytes.
   size_t size;
 
+  // Owner of 'hostData' if 'hostData' is in pinned host memory, e.g. from
+  // getHostAllocator(). Pinned data is copied to device with DMA on the
+  // transfer stream instead of by the host. Keeps 'hostData' alive until the
+  // staging is destroyed.
+  std::shared_ptr<const void> pinned;
+
   // Add members here to describe locations in storage for GPU direct transfer.
 };
 
@@ -93,9 +93,33 @@ enum class DecodeStep {
   kFlatMapNode,
   kRowCountNoFilter,
   kCountBits,
+  kParquetLevels,
+  kParquetValues,
   kUnsupported,
 };
 
+/// A run of values or definition levels in a Parquet column chunk. The runs of
+/// a column chunk are sorted on 'first' and the run of a value is found by
+/// binary search, so that the RLE/bit-packed hybrid and PLAIN encodings can be
+/// decoded at random positions.
+struct ParquetRun {
+  enum Kind : uint8_t { kRle, kBitpacked, kPlain };
+
+  /// Index of the first value of the run in the column chunk. Definition
+  /// levels are indexed by row, values by non-null value.
+  int32_t first;
+
+  Kind kind;
+
+  /// Bit width of kRle and kBitpacked values.
+  uint8_t bitWidth;
+
+  /// For kRle, the repeated value. For kBitpacked, the bit offset of the first
+  /// value from the start of the column chunk. For kPlain, the byte offset of
+  /// the first value.
+  int64_t value;
+};
+
 class ColumnReader;
 
 /// Describes a decoding loop's input and result disposition.
@@ -351,6 +375,23 @@ struct alignas(16) GpuDecode {
     uint8_t* sourceNull;
   };
 
+  struct Parquet {
+    // Runs of definition levels for kParquetLevels, of values for
+    // kParquetValues.
+    const ParquetRun* runs;
+    int32_t numRuns;
+    // Start of the column chunk. The offsets in 'runs' are relative to this.
+    const char* data;
+    // PLAIN encoded dictionary. The values of kRle and kBitpacked runs are
+    // indices into this for kParquetValues.
+    const char* dictionary;
+    // Number of rows for kParquetLevels.
+    int32_t numRows;
+    // Bitmap with a 1 for each row with a definition level > 0. Written by
+    // kParquetLevels. Has 'numRows' rounded up to 64 bits.
+    uint8_t* nulls;
+  };
+
   union {
     Trivial trivial;
     MainlyConstant mainlyConstant;
@@ -363,6 +404,7 @@ struct alignas(16) GpuDecode {
     RowCountNoFilter rowCountNoFilter;
     CountBits countBits;
     CompactValues compact;
+    Parquet parquet;
   } data;
 
   /// Returns the amount of int aligned global memory per TB needed in 'temp'
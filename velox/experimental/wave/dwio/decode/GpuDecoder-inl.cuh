@@ -509,9 +509,80 @@ __device__ void makeScatterIndices(GpuDecode::MakeScatterIndices& op) {
   }
 }
 
+// Returns the index of the run in 'runs' that contains 'idx'.
+inline __device__ int32_t
+findParquetRun(const ParquetRun* runs, int32_t numRuns, int32_t idx) {
+  int32_t lo = 0;
+  int32_t hi = numRuns;
+  while (hi - lo > 1) {
+    auto mid = (lo + hi) / 2;
+    if (runs[mid].first <= idx) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Returns the value at 'idx' of a kRle or kBitpacked run.
+inline __device__ uint32_t
+parquetRunValue(const ParquetRun& run, const char* data, int32_t idx) {
+  if (run.kind == ParquetRun::kRle) {
+    return run.value;
+  }
+  int64_t bit =
+      run.value + static_cast<int64_t>(idx - run.first) * run.bitWidth;
+  return loadBits32(data + (bit >> 3), bit & 7, run.bitWidth);
+}
+
+// Expands the definition levels of a flat column chunk into a bitmap of
+// non-null rows. Each lane makes 32 bits at a time, walking the runs from the
+// run of its first row.
+__device__ inline void decodeParquetLevels(GpuDecode::Parquet& op) {
+  auto* result = reinterpret_cast<uint32_t*>(op.nulls);
+  int32_t numWords = roundUp(op.numRows, 64) / 32;
+  for (int32_t word = threadIdx.x; word < numWords; word += blockDim.x) {
+    int32_t row = word * 32;
+    uint32_t bits = 0;
+    if (row < op.numRows) {
+      auto run = findParquetRun(op.runs, op.numRuns, row);
+      auto numBits = min(32, op.numRows - row);
+      for (auto i = 0; i < numBits; ++i, ++row) {
+        while (run + 1 < op.numRuns && op.runs[run + 1].first <= row) {
+          ++run;
+        }
+        if (parquetRunValue(op.runs[run], op.data, row) > 0) {
+          bits |= 1U << i;
+        }
+      }
+    }
+    result[word] = bits;
+  }
+  __syncthreads();
+}
+
 template <typename T>
 inline __device__ T randomAccessDecode(const GpuDecode* op, int32_t idx) {
   switch (op->encoding) {
+    case DecodeStep::kParquetValues: {
+      const auto& p = op->data.parquet;
+      const auto& run = p.runs[findParquetRun(p.runs, p.numRuns, idx)];
+      const char* value;
+      if (run.kind == ParquetRun::kPlain) {
+        value = p.data + run.value +
+            static_cast<int64_t>(idx - run.first) * sizeof(T);
+      } else {
+        // Dictionary indices.
+        value = p.dictionary +
+            static_cast<int64_t>(parquetRunValue(run, p.data, idx)) *
+                sizeof(T);
+      }
+      if (sizeof(T) == 4) {
+        return unalignedLoad32(value);
+      }
+      return unalignedLoad64(value);
+    }
     case DecodeStep::kDictionaryOnBitpack: {
       const auto& d = op->data.dictionaryOnBitpack;
       auto width = d.bitWidth;
@@ -901,6 +972,9 @@ __device__ void decodeSwitch(GpuDecode& op) {
     case DecodeStep::kRowCountNoFilter:
       detail::setRowCountNoFilter<kBlockSize>(op.data.rowCountNoFilter);
       break;
+    case DecodeStep::kParquetLevels:
+      detail::decodeParquetLevels(op.data.parquet);
+      break;
     default:
       if (threadIdx.x == 0) {
         printf("ERROR: Unsupported DecodeStep (with shared memory)\n");
@@ -926,6 +1000,7 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kCountBits:
     case DecodeStep::kSparseBool:
     case DecodeStep::kRowCountNoFilter:
+    case DecodeStep::kParquetLevels:
       return 0;
       break;
 
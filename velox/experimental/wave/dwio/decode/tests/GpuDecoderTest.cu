@@ -581,6 +581,99 @@ class GpuDecoderTest : public ::testing::Test {
     }
   }
 
+  // Decodes a nullable Parquet column chunk whose first half is dictionary
+  // encoded with bit-packed definition levels and whose second half is PLAIN
+  // with RLE definition levels. The indices, dictionary and PLAIN values are
+  // not aligned.
+  void testParquet(int32_t numRows) {
+    constexpr int32_t kBitWidth = 5;
+    constexpr int32_t kDictSize = 1 << kBitWidth;
+    const int32_t half = numRows / 2;
+    int32_t numDictValues = 0;
+    for (auto row = 0; row < half; ++row) {
+      numDictValues += row % 7 != 0;
+    }
+    const int64_t indexOffset = roundUp(half, 64) / 8 + 1;
+    const int64_t dictOffset =
+        indexOffset + roundUp(numDictValues * kBitWidth, 8) / 8 + 8;
+    const int64_t plainOffset = dictOffset + kDictSize * sizeof(int64_t) + 3;
+    const int64_t size = plainOffset + (numRows - half) * sizeof(int64_t) + 8;
+    auto data = allocate<char>(size);
+    memset(data.get(), 0, size);
+    auto* levelBits = reinterpret_cast<uint8_t*>(data.get());
+    for (auto row = 0; row < half; ++row) {
+      setBit(levelBits, row, row % 7 != 0);
+    }
+    auto* indexBits = reinterpret_cast<uint8_t*>(data.get() + indexOffset);
+    for (auto i = 0; i < numDictValues; ++i) {
+      for (auto bit = 0; bit < kBitWidth; ++bit) {
+        setBit(indexBits, i * kBitWidth + bit, ((i % 23) >> bit) & 1);
+      }
+    }
+    for (int64_t i = 0; i < kDictSize; ++i) {
+      int64_t value = i * 1000 + 3;
+      memcpy(data.get() + dictOffset + i * sizeof(int64_t), &value, 8);
+    }
+    for (int64_t i = 0; i < numRows - half; ++i) {
+      int64_t value = i * 11;
+      memcpy(data.get() + plainOffset + i * sizeof(int64_t), &value, 8);
+    }
+    auto levelRuns = allocate<ParquetRun>(2);
+    levelRuns[0] = {0, ParquetRun::kBitpacked, 1, 0};
+    levelRuns[1] = {half, ParquetRun::kRle, 1, 1};
+    auto valueRuns = allocate<ParquetRun>(2);
+    valueRuns[0] = {0, ParquetRun::kBitpacked, kBitWidth, indexOffset * 8};
+    valueRuns[1] = {numDictValues, ParquetRun::kPlain, 0, plainOffset};
+
+    auto nulls = allocate<uint8_t>(roundUp(numRows, 64) / 8);
+    auto result = allocate<int64_t>(numRows);
+    auto resultNulls = allocate<uint8_t>(numRows);
+    DecodePrograms programs;
+    programs.programs.emplace_back();
+    auto& program = programs.programs.back();
+    program.push_back(std::make_unique<GpuDecode>());
+    auto* levels = program.back().get();
+    levels->step = DecodeStep::kParquetLevels;
+    levels->data.parquet.runs = levelRuns.get();
+    levels->data.parquet.numRuns = 2;
+    levels->data.parquet.data = data.get();
+    levels->data.parquet.numRows = numRows;
+    levels->data.parquet.nulls = nulls.get();
+    program.push_back(std::make_unique<GpuDecode>());
+    auto* values = program.back().get();
+    values->step = DecodeStep::kSelective64;
+    values->encoding = DecodeStep::kParquetValues;
+    values->dataType = WaveTypeKind::BIGINT;
+    values->nullMode = NullMode::kDenseNullable;
+    values->nulls = reinterpret_cast<char*>(nulls.get());
+    values->numRowsPerThread = roundUp(numRows, kBlockSize) / kBlockSize;
+    values->maxRow = numRows;
+    values->result = result.get();
+    values->resultNulls = resultNulls.get();
+    values->data.parquet.runs = valueRuns.get();
+    values->data.parquet.numRuns = 2;
+    values->data.parquet.data = data.get();
+    values->data.parquet.dictionary = data.get() + dictOffset;
+    auto temp = allocate<int32_t>(values->tempSize() / sizeof(int32_t));
+    levels->temp = temp.get();
+    values->temp = temp.get();
+    auto stream = std::make_unique<Stream>();
+    WaveBufferPtr extra;
+    launchDecode(programs, arena_.get(), extra, stream.get());
+    stream->wait();
+    int32_t nthValue = 0;
+    for (auto row = 0; row < numRows; ++row) {
+      if (row < half && row % 7 == 0) {
+        ASSERT_EQ(kNull, resultNulls[row]) << row;
+        continue;
+      }
+      ASSERT_EQ(kNotNull, resultNulls[row]) << row;
+      auto expected =
+          row < half ? (nthValue++ % 23) * 1000 + 3 : (row - half) * 11;
+      ASSERT_EQ(expected, result[row]) << row;
+    }
+  }
+
  private:
   std::unique_ptr<GpuArena> arena_;
 
@@ -632,6 +725,11 @@ TEST_F(GpuDecoderTest, countBits) {
   testCountBits(100000, 2048);
 }
 
+TEST_F(GpuDecoderTest, parquet) {
+  testParquet(1000);
+  testParquet(100'003);
+}
+
 TEST_F(GpuDecoderTest, streamApi) {
   //  One call with few blocks, another with many, to cover inlined and out of
   //  line params.
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/parquet/ParquetColumnChunk.h"
+
+#include <thrift/protocol/TCompactProtocol.h> // @manual
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+#include "velox/experimental/wave/vector/WaveVector.h"
+
+namespace facebook::velox::wave {
+
+namespace thrift = facebook::velox::parquet::thrift;
+
+namespace {
+uint32_t readVarint(const char* data, int64_t& pos, int64_t end) {
+  uint32_t result = 0;
+  for (auto shift = 0; shift < 32; shift += 7) {
+    VELOX_CHECK_LT(pos, end, "Truncated Parquet run header");
+    auto byte = static_cast<uint8_t>(data[pos++]);
+    result |= static_cast<uint32_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return result;
+    }
+  }
+  VELOX_FAIL("Bad varint in Parquet run header");
+}
+
+// Returns the number of set bits in the first 'numBits' bits at 'bits'.
+int32_t countBits(const char* bits, int32_t numBits) {
+  int32_t count = 0;
+  auto* bytes = reinterpret_cast<const uint8_t*>(bits);
+  for (auto i = 0; i < numBits / 8; ++i) {
+    count += __builtin_popcount(bytes[i]);
+  }
+  if (numBits % 8) {
+    count +=
+        __builtin_popcount(bytes[numBits / 8] & bits::lowMask(numBits % 8));
+  }
+  return count;
+}
+} // namespace
+
+// static
+std::shared_ptr<ParquetColumnChunk> ParquetColumnChunk::create(
+    WaveTypeKind kind,
+    int32_t numRows,
+    uint32_t maxDefine,
+    std::shared_ptr<char> pinned,
+    int64_t size) {
+  VELOX_CHECK_LE(maxDefine, 1, "Wave reads only flat Parquet columns");
+  VELOX_CHECK_LE(
+      size,
+      std::numeric_limits<int32_t>::max(),
+      "Parquet column chunk too large for Wave");
+  auto chunk = std::make_shared<ParquetColumnChunk>();
+  chunk->kind = kind;
+  chunk->numRows = numRows;
+  chunk->data = std::move(pinned);
+  chunk->size = size;
+  const char* data = chunk->data.get();
+  int64_t offset = 0;
+  int32_t row = 0;
+  while (row < numRows) {
+    VELOX_CHECK_LT(offset, size, "Parquet column chunk ends before its rows");
+    auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+        data + offset, size - offset);
+    apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+        protocol(transport);
+    thrift::PageHeader header;
+    offset += header.read(&protocol);
+    const int64_t pageEnd = offset + header.compressed_page_size;
+    VELOX_CHECK_LE(pageEnd, size, "Parquet page extends past column chunk");
+    switch (header.type) {
+      case thrift::PageType::DICTIONARY_PAGE: {
+        auto encoding = header.dictionary_page_header.encoding;
+        VELOX_CHECK(
+            encoding == thrift::Encoding::PLAIN ||
+                encoding == thrift::Encoding::PLAIN_DICTIONARY,
+            "Unsupported Parquet dictionary encoding {}",
+            static_cast<int32_t>(encoding));
+        chunk->dictionaryOffset = offset;
+        break;
+      }
+      case thrift::PageType::DATA_PAGE: {
+        const auto& page = header.data_page_header;
+        auto numNonNull = page.num_values;
+        auto pos = offset;
+        if (maxDefine > 0) {
+          uint32_t length;
+          VELOX_CHECK_LE(pos + sizeof(length), pageEnd);
+          memcpy(&length, data + pos, sizeof(length));
+          pos += sizeof(length);
+          numNonNull = chunk->addHybridRuns(
+              pos, pos + length, 1, page.num_values, row, true, chunk->levels);
+          pos += length;
+        }
+        chunk->addValueRuns(page.encoding, pos, pageEnd, numNonNull);
+        row += page.num_values;
+        break;
+      }
+      case thrift::PageType::DATA_PAGE_V2: {
+        const auto& page = header.data_page_header_v2;
+        VELOX_CHECK_EQ(page.repetition_levels_byte_length, 0);
+        auto pos = offset;
+        if (maxDefine > 0) {
+          chunk->addHybridRuns(
+              pos,
+              pos + page.definition_levels_byte_length,
+              1,
+              page.num_values,
+              row,
+              false,
+              chunk->levels);
+        }
+        pos += page.definition_levels_byte_length;
+        chunk->addValueRuns(
+            page.encoding, pos, pageEnd, page.num_values - page.num_nulls);
+        row += page.num_values;
+        break;
+      }
+      default:
+        // Index pages and extensions carry no values.
+        break;
+    }
+    offset = pageEnd;
+  }
+  chunk->hasNulls = chunk->numValues_ < numRows;
+  if (!chunk->hasNulls) {
+    chunk->levels.clear();
+  }
+  return chunk;
+}
+
+// static
+std::shared_ptr<ParquetColumnChunk> ParquetColumnChunk::createConstant(
+    WaveTypeKind kind,
+    int32_t numRows,
+    bool isNull,
+    std::shared_ptr<char> pinned) {
+  auto chunk = std::make_shared<ParquetColumnChunk>();
+  chunk->kind = kind;
+  chunk->numRows = numRows;
+  chunk->data = std::move(pinned);
+  chunk->size = sizeof(int64_t);
+  chunk->dictionaryOffset = 0;
+  chunk->values.push_back(ParquetRun{
+      .first = 0, .kind = ParquetRun::kRle, .bitWidth = 0, .value = 0});
+  if (isNull) {
+    // All definition levels are 0.
+    chunk->hasNulls = true;
+    chunk->levels.push_back(ParquetRun{
+        .first = 0, .kind = ParquetRun::kRle, .bitWidth = 1, .value = 0});
+  }
+  return chunk;
+}
+
+int32_t ParquetColumnChunk::addHybridRuns(
+    int64_t begin,
+    int64_t end,
+    uint8_t bitWidth,
+    int32_t numValues,
+    int32_t first,
+    bool countNonZero,
+    std::vector<ParquetRun>& runs) {
+  VELOX_CHECK_LE(bitWidth, 32);
+  const char* bytes = data.get();
+  int32_t count = 0;
+  int32_t nonZero = 0;
+  auto pos = begin;
+  while (count < numValues) {
+    auto header = readVarint(bytes, pos, end);
+    ParquetRun run;
+    run.first = first + count;
+    run.bitWidth = bitWidth;
+    int32_t runValues;
+    if (header & 1) {
+      // Bit-packed groups of 8 values. The last group of a page may be padded.
+      auto numGroups = header >> 1;
+      run.kind = ParquetRun::kBitpacked;
+      run.value = pos * 8;
+      runValues = std::min<int64_t>(numGroups * 8, numValues - count);
+      VELOX_CHECK_LE(pos + numGroups * bitWidth, end);
+      if (countNonZero) {
+        nonZero += countBits(bytes + pos, runValues);
+      }
+      pos += numGroups * bitWidth;
+    } else {
+      auto valueBytes = bits::roundUp(bitWidth, 8) / 8;
+      VELOX_CHECK_LE(pos + valueBytes, end);
+      run.kind = ParquetRun::kRle;
+      run.value = 0;
+      memcpy(&run.value, bytes + pos, valueBytes);
+      runValues = std::min<int64_t>(header >> 1, numValues - count);
+      if (countNonZero && run.value != 0) {
+        nonZero += runValues;
+      }
+      pos += valueBytes;
+    }
+    if (runValues > 0) {
+      runs.push_back(run);
+      count += runValues;
+    }
+  }
+  return nonZero;
+}
+
+void ParquetColumnChunk::addValueRuns(
+    int32_t encoding,
+    int64_t begin,
+    int64_t end,
+    int32_t numPageValues) {
+  if (numPageValues == 0) {
+    return;
+  }
+  switch (encoding) {
+    case thrift::Encoding::PLAIN: {
+      ParquetRun run;
+      run.first = numValues_;
+      run.kind = ParquetRun::kPlain;
+      run.bitWidth = 0;
+      run.value = begin;
+      VELOX_CHECK_LE(
+          begin + static_cast<int64_t>(numPageValues) * waveTypeKindSize(kind),
+          end);
+      values.push_back(run);
+      break;
+    }
+    case thrift::Encoding::PLAIN_DICTIONARY:
+    case thrift::Encoding::RLE_DICTIONARY: {
+      VELOX_CHECK_GE(
+          dictionaryOffset, 0, "Dictionary encoded page without dictionary");
+      VELOX_CHECK_LT(begin, end);
+      uint8_t bitWidth = data.get()[begin];
+      addHybridRuns(
+          begin + 1, end, bitWidth, numPageValues, numValues_, false, values);
+      break;
+    }
+    default:
+      VELOX_NYI("Unsupported Parquet encoding for Wave: {}", encoding);
+  }
+  numValues_ += numPageValues;
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/dwio/common/TypeWithId.h"
+#include "velox/experimental/wave/dwio/decode/DecodeStep.h"
+
+namespace facebook::velox::wave {
+
+/// A Parquet column chunk prepared for decoding on device. The bytes of the
+/// chunk are read into pinned host memory and move to device as is. The host
+/// parses the page headers and the headers of the runs of the RLE/bit-packed
+/// hybrid encoding into ParquetRuns that locate the definition levels and the
+/// values inside the chunk. The levels and values themselves are only decoded
+/// on device. Supports flat columns of fixed width types in uncompressed
+/// PLAIN or dictionary encoded pages.
+struct ParquetColumnChunk {
+  /// Makes a column chunk of 'numRows' rows of 'kind' from the 'size' bytes
+  /// of pinned host memory at 'pinned'. 'maxDefine' is the maximum definition
+  /// level of the column, 0 if the column is not nullable.
+  static std::shared_ptr<ParquetColumnChunk> create(
+      WaveTypeKind kind,
+      int32_t numRows,
+      uint32_t maxDefine,
+      std::shared_ptr<char> pinned,
+      int64_t size);
+
+  /// Makes a column chunk of 'numRows' copies of a constant of 'kind'. The
+  /// value is in the first 8 bytes of pinned host memory at 'pinned' and is
+  /// ignored if 'isNull'. The value is a dictionary of one entry that all rows
+  /// refer to, so that it is decoded like any other column chunk.
+  static std::shared_ptr<ParquetColumnChunk> createConstant(
+      WaveTypeKind kind,
+      int32_t numRows,
+      bool isNull,
+      std::shared_ptr<char> pinned);
+
+  WaveTypeKind kind;
+
+  int32_t numRows{0};
+
+  // True if some definition level is 0.
+  bool hasNulls{false};
+
+  // The bytes of the column chunk in pinned host memory.
+  std::shared_ptr<char> data;
+
+  int64_t size{0};
+
+  // Byte offset of the PLAIN encoded dictionary in 'data', -1 if no dictionary
+  // page.
+  int64_t dictionaryOffset{-1};
+
+  // Runs of definition levels, indexed by row. Empty if no nulls.
+  std::vector<ParquetRun> levels;
+
+  // Runs of values, indexed by non-null value.
+  std::vector<ParquetRun> values;
+
+ private:
+  // Adds the runs of 'numValues' RLE/bit-packed hybrid encoded values of
+  // 'bitWidth' bits from 'begin' to 'end' in 'data' to 'runs'. The first value
+  // gets index 'first'. Returns the number of non-zero values if
+  // 'countNonZero' is true, otherwise 0.
+  int32_t addHybridRuns(
+      int64_t begin,
+      int64_t end,
+      uint8_t bitWidth,
+      int32_t numValues,
+      int32_t first,
+      bool countNonZero,
+      std::vector<ParquetRun>& runs);
+
+  // Adds the runs of the 'numValues' values of a data page from 'begin' to
+  // 'end' in 'data'. 'encoding' is the Parquet encoding of the values.
+  void addValueRuns(
+      int32_t encoding,
+      int64_t begin,
+      int64_t end,
+      int32_t numValues);
+
+  // Number of non-null values in the pages parsed so far.
+  int32_t numValues_{0};
+};
+
+/// The column chunks read from one row group, keyed on the id of the column in
+/// the file schema. Constant columns, e.g. partition keys, are keyed on name.
+struct ParquetRowGroup {
+  /// Returns the chunk of the column given by 'type' or nullptr if the column
+  /// was not read.
+  std::shared_ptr<const ParquetColumnChunk> findChunk(
+      const dwio::common::TypeWithId& type) const {
+    auto it = chunks.find(type.id());
+    return it == chunks.end() ? nullptr : it->second;
+  }
+
+  /// Returns the chunk of the constant column 'name'. Throws if not found.
+  std::shared_ptr<const ParquetColumnChunk> findConstant(
+      const std::string& name) const {
+    auto it = constants.find(name);
+    VELOX_CHECK(it != constants.end(), "No constant column {}", name);
+    return it->second;
+  }
+
+  int32_t numRows{0};
+
+  folly::F14FastMap<uint32_t, std::shared_ptr<const ParquetColumnChunk>>
+      chunks;
+
+  folly::F14FastMap<std::string, std::shared_ptr<const ParquetColumnChunk>>
+      constants;
+};
+
+} // namespace facebook::velox::wave
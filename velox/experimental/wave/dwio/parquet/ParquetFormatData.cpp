@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/parquet/ParquetFormatData.h"
+#include "velox/experimental/wave/dwio/StructColumnReader.h"
+
+DECLARE_int32(wave_reader_rows_per_tb);
+
+namespace facebook::velox::wave {
+
+using common::Subfield;
+
+std::unique_ptr<FormatData> ParquetFormatParams::toFormatData(
+    const std::shared_ptr<const dwio::common::TypeWithId>& type,
+    const velox::common::ScanSpec& scanSpec,
+    OperandId operand) {
+  if (scanSpec.isConstant()) {
+    return std::make_unique<ParquetFormatData>(
+        operand,
+        rowGroup_->numRows,
+        rowGroup_->findConstant(scanSpec.fieldName()));
+  }
+  auto chunk = type->id() == 0 ? nullptr : rowGroup_->findChunk(*type);
+  return std::make_unique<ParquetFormatData>(
+      operand, rowGroup_->numRows, std::move(chunk));
+}
+
+bool ParquetFormatData::stageChunk(SplitStaging& staging) {
+  if (staged_) {
+    return false;
+  }
+  staged_ = true;
+  Staging data(chunk_->data.get(), chunk_->size, chunk_->data);
+  dataId_ = staging.add(data);
+  staging.registerPointer(dataId_, &deviceData_, true);
+  Staging values(
+      chunk_->values.data(), chunk_->values.size() * sizeof(ParquetRun));
+  valuesId_ = staging.add(values);
+  staging.registerPointer(valuesId_, &deviceValues_, true);
+  if (chunk_->hasNulls) {
+    Staging levels(
+        chunk_->levels.data(), chunk_->levels.size() * sizeof(ParquetRun));
+    levelsId_ = staging.add(levels);
+  }
+  return true;
+}
+
+BufferId ParquetFormatData::addLevelsStep(
+    ResultStaging& deviceStaging,
+    SplitStaging& staging,
+    std::vector<std::unique_ptr<GpuDecode>>& program) {
+  VELOX_CHECK(!nullsDecoded_);
+  VELOX_CHECK_NE(levelsId_, kNoBufferId);
+  nullsDecoded_ = true;
+  auto step = std::make_unique<GpuDecode>();
+  step->step = DecodeStep::kParquetLevels;
+  auto& levels = step->data.parquet;
+  levels.numRows = chunk_->numRows;
+  levels.numRuns = chunk_->levels.size();
+  levels.dictionary = nullptr;
+  staging.registerPointer(dataId_, &levels.data, true);
+  staging.registerPointer(levelsId_, &levels.runs, true);
+  auto id = deviceStaging.reserve(
+      bits::nwords(chunk_->numRows) * sizeof(uint64_t));
+  deviceStaging.registerPointer(id, &levels.nulls, true);
+  deviceStaging.registerPointer(id, &grid_.nulls, true);
+  program.push_back(std::move(step));
+  return id;
+}
+
+void ParquetFormatData::griddize(
+    int32_t blockSize,
+    int32_t numBlocks,
+    ResultStaging& deviceStaging,
+    ResultStaging& resultStaging,
+    SplitStaging& staging,
+    DecodePrograms& programs,
+    ReadStream& stream) {
+  griddized_ = true;
+  if (!chunk_) {
+    return;
+  }
+  stageChunk(staging);
+  if (!chunk_->hasNulls || nullsDecoded_) {
+    return;
+  }
+  // The bitmap is made and counted by consecutive steps of the same TB.
+  programs.programs.emplace_back();
+  auto& program = programs.programs.back();
+  auto nullsId = addLevelsStep(deviceStaging, staging, program);
+  auto count = std::make_unique<GpuDecode>();
+  deviceStaging.registerPointer(nullsId, &count->data.countBits.bits, true);
+  auto resultId = deviceStaging.reserve(sizeof(int32_t) * numBlocks);
+  deviceStaging.registerPointer(resultId, &count->result, true);
+  deviceStaging.registerPointer(resultId, &grid_.numNonNull, true);
+  count->step = DecodeStep::kCountBits;
+  count->data.countBits.numBits = chunk_->numRows;
+  count->data.countBits.resultStride = FLAGS_wave_reader_rows_per_tb;
+  program.push_back(std::move(count));
+}
+
+void ParquetFormatData::setValues(
+    GpuDecode& step,
+    bool staged,
+    SplitStaging& staging) {
+  step.encoding = DecodeStep::kParquetValues;
+  auto& values = step.data.parquet;
+  values.numRuns = chunk_->values.size();
+  values.numRows = 0;
+  values.nulls = nullptr;
+  if (staged) {
+    staging.registerPointer(dataId_, &values.data, true);
+    staging.registerPointer(valuesId_, &values.runs, true);
+    values.dictionary = nullptr;
+    if (chunk_->dictionaryOffset >= 0) {
+      values.dictionary =
+          reinterpret_cast<const char*>(chunk_->dictionaryOffset);
+      staging.registerPointer(dataId_, &values.dictionary, false);
+    }
+  } else {
+    values.data = deviceData_;
+    values.runs = deviceValues_;
+    values.dictionary = chunk_->dictionaryOffset >= 0
+        ? deviceData_ + chunk_->dictionaryOffset
+        : nullptr;
+  }
+}
+
+void ParquetFormatData::startOp(
+    ColumnOp& op,
+    const ColumnOp* previousFilter,
+    ResultStaging& deviceStaging,
+    ResultStaging& resultStaging,
+    SplitStaging& splitStaging,
+    DecodePrograms& program,
+    ReadStream& stream) {
+  VELOX_CHECK_NOT_NULL(chunk_);
+  auto staged = stageChunk(splitStaging);
+  auto rowsPerBlock = FLAGS_wave_reader_rows_per_tb;
+  int32_t numBlocks =
+      bits::roundUp(op.rows.size(), rowsPerBlock) / rowsPerBlock;
+  if (numBlocks > 1) {
+    VELOX_CHECK(griddized_);
+  }
+  VELOX_CHECK_LT(numBlocks, 256);
+  for (auto blockIdx = 0; blockIdx < numBlocks; ++blockIdx) {
+    std::vector<std::unique_ptr<GpuDecode>>* steps;
+    // Programs are parallel after filters
+    if (stream.filtersDone() || !previousFilter) {
+      program.programs.emplace_back();
+      steps = &program.programs.back();
+    } else {
+      steps = &program.programs[blockIdx];
+    }
+    auto step = makeStep(
+        op, previousFilter, deviceStaging, stream, chunk_->kind, blockIdx);
+    if (chunk_->hasNulls && !nullsDecoded_) {
+      // Not griddized. The single TB makes the null bitmap before decoding.
+      auto nullsId = addLevelsStep(deviceStaging, splitStaging, *steps);
+      deviceStaging.registerPointer(nullsId, &step->nulls, true);
+      step->nullMode = step->nullMode == NullMode::kDenseNonNull
+          ? NullMode::kDenseNullable
+          : NullMode::kSparseNullable;
+    }
+    setValues(*step, staged, splitStaging);
+    op.isFinal = true;
+    steps->push_back(std::move(step));
+  }
+}
+
+class ParquetStructColumnReader : public StructColumnReader {
+ public:
+  ParquetStructColumnReader(
+      const TypePtr& requestedType,
+      const std::shared_ptr<const dwio::common::TypeWithId>& fileType,
+      ParquetFormatParams& params,
+      common::ScanSpec& scanSpec,
+      std::vector<std::unique_ptr<Subfield::PathElement>>& path,
+      const DefinesMap& defines,
+      bool isRoot)
+      : StructColumnReader(
+            requestedType,
+            fileType,
+            pathToOperand(defines, path),
+            params,
+            scanSpec,
+            isRoot) {
+    auto& childSpecs = scanSpec.stableChildren();
+    for (auto i = 0; i < childSpecs.size(); ++i) {
+      auto childSpec = childSpecs[i];
+      auto childRequestedType = requestedType_->as<TypeKind::ROW>().findChild(
+          folly::StringPiece(childSpec->fieldName()));
+      path.push_back(std::make_unique<common::Subfield::NestedField>(
+          childSpec->fieldName()));
+      if (isChildConstant(*childSpec)) {
+        // The split reader made a column chunk for the constant. Missing
+        // fields of nested structs are not supported.
+        VELOX_CHECK(
+            childSpec->isConstant(),
+            "Wave Parquet reader does not support missing struct field {}",
+            childSpec->fieldName());
+        addChild(std::make_unique<ColumnReader>(
+            childRequestedType,
+            nullptr,
+            pathToOperand(defines, path),
+            params,
+            *childSpec));
+      } else {
+        auto childFileType = fileType_->childByName(childSpec->fieldName());
+        addChild(ParquetFormatReader::build(
+            childRequestedType,
+            childFileType,
+            params,
+            *childSpec,
+            path,
+            defines));
+      }
+      path.pop_back();
+      childSpec->setSubscript(children_.size() - 1);
+    }
+  }
+};
+
+// static
+std::unique_ptr<ColumnReader> ParquetFormatReader::build(
+    const TypePtr& requestedType,
+    const std::shared_ptr<const dwio::common::TypeWithId>& fileType,
+    ParquetFormatParams& params,
+    common::ScanSpec& scanSpec,
+    std::vector<std::unique_ptr<Subfield::PathElement>>& path,
+    const DefinesMap& defines,
+    bool isRoot) {
+  switch (fileType->type()->kind()) {
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return std::make_unique<ColumnReader>(
+          requestedType,
+          fileType,
+          pathToOperand(defines, path),
+          params,
+          scanSpec);
+
+    case TypeKind::ROW:
+      return std::make_unique<ParquetStructColumnReader>(
+          requestedType, fileType, params, scanSpec, path, defines, isRoot);
+    default:
+      VELOX_NYI(
+          "Wave Parquet reader does not support {}",
+          fileType->type()->toString());
+  }
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/dwio/ColumnReader.h"
+#include "velox/experimental/wave/dwio/parquet/ParquetColumnChunk.h"
+#include "velox/type/Subfield.h"
+
+namespace facebook::velox::wave {
+
+/// FormatData for a column chunk of a Parquet row group. The chunk and its runs
+/// are staged on device on first use. Nullable columns expand their
+/// definition levels into a null bitmap on device before the values are
+/// decoded.
+class ParquetFormatData : public FormatData {
+ public:
+  /// 'chunk' is nullptr for structs.
+  ParquetFormatData(
+      OperandId operand,
+      int32_t totalRows,
+      std::shared_ptr<const ParquetColumnChunk> chunk)
+      : operand_(operand), totalRows_(totalRows), chunk_(std::move(chunk)) {}
+
+  bool hasNulls() const override {
+    return chunk_ && chunk_->hasNulls;
+  }
+
+  int32_t totalRows() const override {
+    return totalRows_;
+  }
+
+  void newBatch(int32_t startRow) override {
+    currentRow_ = startRow;
+  }
+
+  void griddize(
+      int32_t blockSize,
+      int32_t numBlocks,
+      ResultStaging& deviceStaging,
+      ResultStaging& resultStaging,
+      SplitStaging& staging,
+      DecodePrograms& programs,
+      ReadStream& stream) override;
+
+  void startOp(
+      ColumnOp& op,
+      const ColumnOp* previousFilter,
+      ResultStaging& deviceStaging,
+      ResultStaging& resultStaging,
+      SplitStaging& staging,
+      DecodePrograms& program,
+      ReadStream& stream) override;
+
+ private:
+  // Stages the column chunk and its runs on device on the first call. Returns
+  // true if staged by this call. The ids in 'staging' are then in
+  // 'dataId_', 'levelsId_' and 'valuesId_'.
+  bool stageChunk(SplitStaging& staging);
+
+  // Adds a step to 'program' that expands the definition levels into
+  // 'grid_.nulls'. Must be called in the same read as the staging. Returns the
+  // id of the bitmap in 'deviceStaging'.
+  BufferId addLevelsStep(
+      ResultStaging& deviceStaging,
+      SplitStaging& staging,
+      std::vector<std::unique_ptr<GpuDecode>>& program);
+
+  // Sets the pointers of a kParquetValues step.
+  void setValues(GpuDecode& step, bool staged, SplitStaging& staging);
+
+  const OperandId operand_;
+  const int32_t totalRows_;
+  const std::shared_ptr<const ParquetColumnChunk> chunk_;
+
+  bool staged_{false};
+  bool nullsDecoded_{false};
+
+  // Ids of the chunk and its runs in the SplitStaging of the read that staged
+  // them.
+  BufferId dataId_{kNoBufferId};
+  BufferId levelsId_{kNoBufferId};
+  BufferId valuesId_{kNoBufferId};
+
+  // The device side chunk and value runs, set after the staged transfer is
+  // done.
+  const char* deviceData_{nullptr};
+  const ParquetRun* deviceValues_{nullptr};
+};
+
+class ParquetFormatParams : public FormatParams {
+ public:
+  ParquetFormatParams(
+      memory::MemoryPool& pool,
+      dwio::common::ColumnReaderStatistics& stats,
+      const ParquetRowGroup* rowGroup)
+      : FormatParams(pool, stats), rowGroup_(rowGroup) {}
+
+  std::unique_ptr<FormatData> toFormatData(
+      const std::shared_ptr<const dwio::common::TypeWithId>& type,
+      const velox::common::ScanSpec& scanSpec,
+      OperandId operand) override;
+
+ private:
+  const ParquetRowGroup* rowGroup_;
+};
+
+/// Builds a tree of Wave column readers for a Parquet row group.
+class ParquetFormatReader {
+ public:
+  static std::unique_ptr<ColumnReader> build(
+      const TypePtr& requestedType,
+      const std::shared_ptr<const dwio::common::TypeWithId>& fileType,
+      ParquetFormatParams& params,
+      common::ScanSpec& scanSpec,
+      std::vector<std::unique_ptr<common::Subfield::PathElement>>& path,
+      const DefinesMap& defines,
+      bool isRoot = false);
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/parquet/WaveParquetSplitReader.h"
+
+#include <folly/Conv.h>
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/dwio/StructColumnReader.h"
+#include "velox/experimental/wave/dwio/parquet/ParquetFormatData.h"
+
+namespace facebook::velox::wave {
+
+using common::Subfield;
+
+namespace {
+WaveTypeKind checkLeafType(const parquet::ParquetTypeWithId& type) {
+  auto kind = type.type()->kind();
+  auto parquetType = type.parquetType_;
+  bool supported = false;
+  if (parquetType.has_value()) {
+    switch (kind) {
+      case TypeKind::INTEGER:
+        supported = parquetType == parquet::thrift::Type::INT32;
+        break;
+      case TypeKind::BIGINT:
+        supported = parquetType == parquet::thrift::Type::INT64;
+        break;
+      case TypeKind::REAL:
+        supported = parquetType == parquet::thrift::Type::FLOAT;
+        break;
+      case TypeKind::DOUBLE:
+        supported = parquetType == parquet::thrift::Type::DOUBLE;
+        break;
+      default:
+        break;
+    }
+  }
+  if (!supported || type.maxRepeat_ > 0) {
+    VELOX_NYI(
+        "Wave Parquet reader does not support column {} of type {}",
+        type.name_,
+        type.type()->toString());
+  }
+  return static_cast<WaveTypeKind>(kind);
+}
+
+template <typename T>
+VectorPtr makeConstant(
+    const TypePtr& type,
+    const std::optional<std::string>& value,
+    memory::MemoryPool* pool) {
+  if (!value.has_value()) {
+    return BaseVector::createNullConstant(type, 1, pool);
+  }
+  return std::make_shared<ConstantVector<T>>(
+      pool, 1, false, type, folly::to<T>(value.value()));
+}
+
+// Makes a constant vector of 'type' from the string form of a partition key
+// value. std::nullopt is a null partition key.
+VectorPtr makePartitionConstant(
+    const std::string& name,
+    const TypePtr& type,
+    const std::optional<std::string>& value,
+    memory::MemoryPool* pool) {
+  switch (type->kind()) {
+    case TypeKind::INTEGER:
+      return makeConstant<int32_t>(type, value, pool);
+    case TypeKind::BIGINT:
+      return makeConstant<int64_t>(type, value, pool);
+    case TypeKind::REAL:
+      return makeConstant<float>(type, value, pool);
+    case TypeKind::DOUBLE:
+      return makeConstant<double>(type, value, pool);
+    default:
+      VELOX_NYI(
+          "Wave Parquet reader does not support partition key {} of type {}",
+          name,
+          type->toString());
+  }
+}
+
+template <typename T>
+void storeConstant(const BaseVector& constant, char* data) {
+  auto value = constant.as<ConstantVector<T>>()->valueAt(0);
+  std::memcpy(data, &value, sizeof(T));
+}
+
+// Makes a column chunk that decodes to 'numRows' copies of 'constant'. The
+// value is copied to pinned host memory and is moved to device with the
+// other chunks of the row group.
+std::shared_ptr<ParquetColumnChunk> makeConstantChunk(
+    const std::string& name,
+    const BaseVector& constant,
+    int32_t numRows,
+    GpuAllocator* allocator) {
+  constexpr int32_t kSize = sizeof(int64_t);
+  std::shared_ptr<char> data(
+      reinterpret_cast<char*>(allocator->allocate(kSize)),
+      [allocator](char* ptr) { allocator->free(ptr, kSize); });
+  std::memset(data.get(), 0, kSize);
+  const bool isNull = constant.isNullAt(0);
+  switch (constant.typeKind()) {
+    case TypeKind::INTEGER:
+      if (!isNull) {
+        storeConstant<int32_t>(constant, data.get());
+      }
+      break;
+    case TypeKind::BIGINT:
+      if (!isNull) {
+        storeConstant<int64_t>(constant, data.get());
+      }
+      break;
+    case TypeKind::REAL:
+      if (!isNull) {
+        storeConstant<float>(constant, data.get());
+      }
+      break;
+    case TypeKind::DOUBLE:
+      if (!isNull) {
+        storeConstant<double>(constant, data.get());
+      }
+      break;
+    default:
+      VELOX_NYI(
+          "Wave Parquet reader does not support constant column {} of type {}",
+          name,
+          constant.type()->toString());
+  }
+  return ParquetColumnChunk::createConstant(
+      static_cast<WaveTypeKind>(constant.typeKind()),
+      numRows,
+      isNull,
+      std::move(data));
+}
+} // namespace
+
+WaveParquetSplitReader::WaveParquetSplitReader(
+    const std::shared_ptr<connector::ConnectorSplit>& split,
+    const SplitReaderParams& params,
+    const DefinesMap* defines)
+    : split_(std::dynamic_pointer_cast<connector::hive::HiveConnectorSplit>(
+          split)),
+      params_(params),
+      defines_(defines) {
+  VELOX_CHECK_NOT_NULL(split_);
+  fileHandle_ = params_.fileHandleFactory->generate(
+      split_->filePath,
+      split_->properties.has_value() ? &*split_->properties : nullptr);
+  VELOX_CHECK_NOT_NULL(fileHandle_.get());
+  auto* pool = params_.connectorQueryCtx->memoryPool();
+  dwio::common::ReaderOptions options(pool);
+  options.setFileFormat(dwio::common::FileFormat::PARQUET);
+  reader_ = std::make_unique<parquet::ParquetReader>(
+      std::make_unique<dwio::common::BufferedInput>(
+          fileHandle_->file, *pool),
+      options);
+  adaptColumns();
+  auto metadata = reader_->fileMetaData();
+  const uint64_t end = split_->length == std::numeric_limits<uint64_t>::max()
+      ? split_->length
+      : split_->start + split_->length;
+  for (auto i = 0; i < metadata.numRowGroups(); ++i) {
+    auto rowGroup = metadata.rowGroup(i);
+    if (rowGroup.numRows() == 0) {
+      continue;
+    }
+    int64_t offset;
+    if (rowGroup.hasFileOffset()) {
+      offset = rowGroup.fileOffset();
+    } else {
+      auto column = rowGroup.columnChunk(0);
+      offset = column.hasDictionaryPageOffset()
+          ? column.dictionaryPageOffset()
+          : column.dataPageOffset();
+    }
+    if (offset >= split_->start && offset < end) {
+      rowGroupIds_.push_back(i);
+    }
+  }
+}
+
+void WaveParquetSplitReader::adaptColumns() {
+  auto* pool = params_.connectorQueryCtx->memoryPool();
+  auto& fileType = reader_->rowType();
+  for (auto& childSpec : params_.scanSpec->children()) {
+    const auto& name = childSpec->fieldName();
+    if (auto it = split_->partitionKeys.find(name);
+        it != split_->partitionKeys.end()) {
+      auto handle = params_.partitionKeys->find(name);
+      VELOX_CHECK(
+          handle != params_.partitionKeys->end(),
+          "ColumnHandle is missing for partition key {}",
+          name);
+      childSpec->setConstantValue(makePartitionConstant(
+          name, handle->second->dataType(), it->second, pool));
+    } else if (!fileType->containsChild(name)) {
+      // Column is missing from the file, most likely due to schema
+      // evolution.
+      auto& tableSchema = params_.hiveTableHandle->dataColumns();
+      VELOX_CHECK_NOT_NULL(tableSchema);
+      childSpec->setConstantValue(BaseVector::createNullConstant(
+          tableSchema->findChild(name), 1, pool));
+    } else {
+      childSpec->setConstantValue(nullptr);
+    }
+  }
+  params_.scanSpec->resetCachedValues(false);
+}
+
+bool WaveParquetSplitReader::loadNextRowGroup() {
+  if (nextRowGroup_ >= rowGroupIds_.size()) {
+    return false;
+  }
+  auto metadata =
+      reader_->fileMetaData().rowGroup(rowGroupIds_[nextRowGroup_++]);
+  auto rowGroup = std::make_unique<ParquetRowGroup>();
+  rowGroup->numRows = metadata.numRows();
+  auto* allocator = getHostAllocator(getDevice());
+  auto& fileType = reader_->typeWithId();
+  for (auto& childSpec : params_.scanSpec->stableChildren()) {
+    if (childSpec->isConstant()) {
+      rowGroup->constants[childSpec->fieldName()] = makeConstantChunk(
+          childSpec->fieldName(),
+          *childSpec->constantValue(),
+          rowGroup->numRows,
+          allocator);
+      continue;
+    }
+    auto child = fileType->childByName(childSpec->fieldName());
+    auto& leaf = *reinterpret_cast<const parquet::ParquetTypeWithId*>(
+        child.get());
+    auto kind = checkLeafType(leaf);
+    auto column = metadata.columnChunk(leaf.column());
+    if (column.compression() != common::CompressionKind_NONE) {
+      VELOX_NYI(
+          "Wave Parquet reader supports only uncompressed column chunks: {}",
+          leaf.name_);
+    }
+    int64_t offset = column.dataPageOffset();
+    if (column.hasDictionaryPageOffset()) {
+      offset = std::min(offset, column.dictionaryPageOffset());
+    }
+    int64_t size = column.totalCompressedSize();
+    std::shared_ptr<char> data(
+        reinterpret_cast<char*>(allocator->allocate(size)),
+        [allocator, size](char* ptr) { allocator->free(ptr, size); });
+    fileHandle_->file->pread(offset, size, data.get());
+    completedBytes_ += size;
+    rowGroup->chunks[leaf.id()] = ParquetColumnChunk::create(
+        kind, rowGroup->numRows, leaf.maxDefine_, std::move(data), size);
+  }
+
+  ParquetFormatParams formatParams(
+      *params_.connectorQueryCtx->memoryPool(), readerStats_, rowGroup.get());
+  std::vector<std::unique_ptr<Subfield::PathElement>> empty;
+  columnReader_ = ParquetFormatReader::build(
+      params_.readerOutputType,
+      fileType,
+      formatParams,
+      *params_.scanSpec,
+      empty,
+      *defines_,
+      true);
+  rowGroup_ = std::move(rowGroup);
+  nextRow_ = 0;
+  return true;
+}
+
+int32_t WaveParquetSplitReader::canAdvance(WaveStream& stream) {
+  if (available() == 0 && !loadNextRowGroup()) {
+    return 0;
+  }
+  return available();
+}
+
+void WaveParquetSplitReader::schedule(
+    WaveStream& waveStream,
+    int32_t maxRows) {
+  auto numRows = std::min<int32_t>(maxRows, available());
+  scheduledRows_ = numRows;
+  auto rowSet = folly::Range<const int32_t*>(iota(numRows, rows_), numRows);
+  auto readStream = std::make_unique<ReadStream>(
+      reinterpret_cast<StructColumnReader*>(columnReader_.get()),
+      0,
+      rowSet,
+      waveStream);
+  ReadStream::launch(std::move(readStream));
+  nextRow_ += scheduledRows_;
+  completedRows_ += scheduledRows_;
+}
+
+vector_size_t WaveParquetSplitReader::outputSize(WaveStream& stream) const {
+  return scheduledRows_;
+}
+
+bool WaveParquetSplitReader::isFinished() const {
+  return available() == 0 && nextRowGroup_ >= rowGroupIds_.size();
+}
+
+namespace {
+class WaveParquetSplitReaderFactory : public WaveSplitReaderFactory {
+ public:
+  std::unique_ptr<WaveSplitReader> create(
+      const std::shared_ptr<connector::ConnectorSplit>& split,
+      const SplitReaderParams& params,
+      const DefinesMap* defines) override {
+    auto hiveSplit =
+        dynamic_cast<connector::hive::HiveConnectorSplit*>(split.get());
+    if (!hiveSplit ||
+        hiveSplit->fileFormat != dwio::common::FileFormat::PARQUET) {
+      return nullptr;
+    }
+    return std::make_unique<WaveParquetSplitReader>(split, params, defines);
+  }
+};
+} // namespace
+
+// static
+void WaveParquetSplitReader::registerParquetSplitReader() {
+  static bool registered = false;
+  if (registered) {
+    return;
+  }
+  registered = true;
+  WaveSplitReader::registerFactory(
+      std::make_unique<WaveParquetSplitReaderFactory>());
+}
+
+} // namespace facebook::velox::wave
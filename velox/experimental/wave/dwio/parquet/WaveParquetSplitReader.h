@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/experimental/wave/dwio/ColumnReader.h"
+#include "velox/experimental/wave/dwio/parquet/ParquetColumnChunk.h"
+#include "velox/experimental/wave/exec/WaveSplitReader.h"
+
+namespace facebook::velox::wave {
+
+/// A WaveSplitReader for Parquet files. Reads one row group at a time. The
+/// footer and the page headers are read on the host. The column chunks are
+/// read into pinned host memory, copied to device with DMA and decoded there.
+class WaveParquetSplitReader : public WaveSplitReader {
+ public:
+  WaveParquetSplitReader(
+      const std::shared_ptr<connector::ConnectorSplit>& split,
+      const SplitReaderParams& params,
+      const DefinesMap* defines);
+
+  bool emptySplit() override {
+    return rowGroupIds_.empty();
+  }
+
+  int32_t canAdvance(WaveStream& stream) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows = 0) override;
+
+  vector_size_t outputSize(WaveStream& stream) const override;
+
+  bool isFinished() const override;
+
+  uint64_t getCompletedBytes() override {
+    return completedBytes_;
+  }
+
+  uint64_t getCompletedRows() override {
+    return completedRows_;
+  }
+
+  std::unordered_map<std::string, RuntimeCounter> runtimeStats() override {
+    return {};
+  }
+
+  /// Registers a WaveSplitReaderFactory for Hive splits of Parquet files.
+  /// Must be called by the embedding application since the Wave exec
+  /// library does not depend on the Parquet reader. Repeated calls are
+  /// no-ops.
+  static void registerParquetSplitReader();
+
+ private:
+  int32_t available() const {
+    return rowGroup_ ? rowGroup_->numRows - nextRow_ : 0;
+  }
+
+  // Sets the constant values of partition keys and of columns missing from
+  // the file in the ScanSpec.
+  void adaptColumns();
+
+  // Reads the column chunks of the next row group of the split and makes a
+  // column reader tree for them. Returns false if no row group is left.
+  bool loadNextRowGroup();
+
+  std::shared_ptr<connector::hive::HiveConnectorSplit> split_;
+  SplitReaderParams params_;
+  const DefinesMap* defines_;
+  FileHandleCachedPtr fileHandle_;
+  std::unique_ptr<parquet::ParquetReader> reader_;
+
+  // Row groups in the range of the split.
+  std::vector<int32_t> rowGroupIds_;
+  // Index of the next row group in 'rowGroupIds_'.
+  int32_t nextRowGroup_{0};
+  std::unique_ptr<ParquetRowGroup> rowGroup_;
+  std::unique_ptr<ColumnReader> columnReader_;
+
+  // First unscheduled row of 'rowGroup_'.
+  int32_t nextRow_{0};
+  int32_t scheduledRows_{0};
+  uint64_t completedRows_{0};
+  uint64_t completedBytes_{0};
+  dwio::common::ColumnReaderStatistics readerStats_;
+  raw_vector<int32_t> rows_;
+};
+
+} // namespace facebook::velox::wave
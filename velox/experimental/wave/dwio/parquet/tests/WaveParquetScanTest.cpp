@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cuda_runtime.h> // @manual
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+#include "velox/experimental/wave/dwio/parquet/WaveParquetSplitReader.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/WaveHiveDataSource.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class WaveParquetScanTest : public HiveConnectorTestBase {
+ protected:
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+    HiveConnectorTestBase::SetUp();
+    wave::registerWave();
+    wave::WaveHiveDataSource::registerConnector();
+    wave::WaveParquetSplitReader::registerParquetSplitReader();
+  }
+
+  // Writes 'vectors' to an uncompressed Parquet file.
+  std::shared_ptr<TempFilePath> writeParquet(
+      const std::vector<RowVectorPtr>& vectors) {
+    auto file = TempFilePath::create();
+    parquet::WriterOptions options;
+    options.memoryPool = pool_.get();
+    auto writer = std::make_unique<parquet::Writer>(
+        std::make_unique<dwio::common::LocalFileSink>(
+            file->getPath(),
+            dwio::common::FileSink::Options{.pool = pool_.get()}),
+        options,
+        rootPool_,
+        asRowType(vectors[0]->type()));
+    for (auto& vector : vectors) {
+      writer->write(vector);
+    }
+    writer->close();
+    return file;
+  }
+
+  std::vector<RowVectorPtr> makeVectors(
+      int32_t numVectors,
+      int32_t rowsPerVector) {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < numVectors; ++i) {
+      const int64_t base = i * rowsPerVector;
+      vectors.push_back(makeRowVector(
+          {"c0", "c1", "c2", "c3"},
+          {makeFlatVector<int64_t>(
+               rowsPerVector, [&](auto row) { return base + row; }),
+           makeFlatVector<int32_t>(
+               rowsPerVector,
+               [&](auto row) { return (base + row) % 1'000; },
+               nullEvery(7)),
+           makeFlatVector<double>(
+               rowsPerVector,
+               [&](auto row) { return (base + row) * 0.5; },
+               nullEvery(5)),
+           makeFlatVector<float>(
+               rowsPerVector,
+               [&](auto row) { return (base + row) * 0.25; },
+               nullEvery(11))}));
+    }
+    return vectors;
+  }
+
+  std::shared_ptr<connector::ConnectorSplit> makeSplit(
+      const std::string& path,
+      const std::optional<std::string>& partitionValue = std::nullopt) {
+    HiveConnectorSplitBuilder builder(path);
+    builder.fileFormat(dwio::common::FileFormat::PARQUET);
+    if (partitionValue.has_value()) {
+      builder.partitionKey("pkey", partitionValue);
+    }
+    return builder.build();
+  }
+};
+
+TEST_F(WaveParquetScanTest, scan) {
+  auto vectors = makeVectors(4, 2'000);
+  auto file = writeParquet(vectors);
+  createDuckDbTable(vectors);
+
+  auto rowType = asRowType(vectors[0]->type());
+  auto plan = PlanBuilder().tableScan(rowType).planNode();
+  assertQuery(plan, {makeSplit(file->getPath())}, "SELECT * FROM tmp");
+
+  plan = PlanBuilder()
+             .tableScan(ROW({"c3", "c0"}, {REAL(), BIGINT()}))
+             .planNode();
+  assertQuery(plan, {makeSplit(file->getPath())}, "SELECT c3, c0 FROM tmp");
+}
+
+TEST_F(WaveParquetScanTest, constantColumns) {
+  auto vectors = makeVectors(2, 1'000);
+  auto file = writeParquet(vectors);
+  createDuckDbTable(vectors);
+
+  // 'pkey' is a partition key and 'c4' is in the table schema but not in
+  // the file. Both are read as constants.
+  auto dataColumns = ROW(
+      {"c0", "c1", "c2", "c3", "c4"},
+      {BIGINT(), INTEGER(), DOUBLE(), REAL(), BIGINT()});
+  ColumnHandleMap assignments = {
+      {"pkey", partitionKey("pkey", INTEGER())},
+      {"c0", regularColumn("c0", BIGINT())},
+      {"c2", regularColumn("c2", DOUBLE())},
+      {"c4", regularColumn("c4", BIGINT())}};
+  auto plan =
+      PlanBuilder()
+          .startTableScan()
+          .outputType(ROW(
+              {"c0", "pkey", "c4", "c2"},
+              {BIGINT(), INTEGER(), BIGINT(), DOUBLE()}))
+          .dataColumns(dataColumns)
+          .assignments(assignments)
+          .endTableScan()
+          .planNode();
+  assertQuery(
+      plan,
+      {makeSplit(file->getPath(), "17")},
+      "SELECT c0, 17, null::BIGINT, c2 FROM tmp");
+
+  // The same scan with a null partition key.
+  HiveConnectorSplitBuilder builder(file->getPath());
+  auto split = builder.fileFormat(dwio::common::FileFormat::PARQUET)
+                   .partitionKey("pkey", std::nullopt)
+                   .build();
+  assertQuery(
+      plan, {split}, "SELECT c0, null::INTEGER, null::BIGINT, c2 FROM tmp");
+}
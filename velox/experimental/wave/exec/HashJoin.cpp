@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoin.h"
+
+#include "velox/exec/Task.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+DECLARE_int64(velox_wave_arena_unit_size);
+
+namespace facebook::velox::wave {
+
+namespace {
+
+bool isWaveKeyType(const TypePtr& type) {
+  return type->kind() == TypeKind::INTEGER || type->kind() == TypeKind::BIGINT;
+}
+
+bool isWaveColumnType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// True if 'node' is a TableScan or Values with Filters and Projects on top. If
+// 'allowJoin' is true, the chain may also end in a Wave hash join.
+bool isWaveJoinSource(const core::PlanNodePtr& node, bool allowJoin) {
+  for (auto* current = node.get();;) {
+    if (dynamic_cast<const core::TableScanNode*>(current) ||
+        dynamic_cast<const core::ValuesNode*>(current)) {
+      return true;
+    }
+    if (allowJoin) {
+      if (auto* join = dynamic_cast<const core::HashJoinNode*>(current)) {
+        return isWaveHashJoin(*join);
+      }
+    }
+    if (!dynamic_cast<const core::FilterNode*>(current) &&
+        !dynamic_cast<const core::ProjectNode*>(current)) {
+      return false;
+    }
+    current = current->sources()[0].get();
+  }
+}
+
+// Returns the names of the build side columns in the output of 'node'. These
+// are the dependent columns of the build side rows, in this order.
+std::vector<std::string> buildColumnNames(const core::HashJoinNode& node) {
+  auto& probeType = node.sources()[0]->outputType();
+  std::vector<std::string> names;
+  for (auto& name : node.outputType()->names()) {
+    if (!probeType->containsChild(name)) {
+      names.push_back(name);
+    }
+  }
+  return names;
+}
+
+join::RowLayout makeLayout(const core::HashJoinNode& node) {
+  join::RowLayout layout;
+  layout.numKeys = node.rightKeys().size();
+  layout.numColumns = buildColumnNames(node).size();
+  VELOX_CHECK_LE(layout.numColumns, join::RowLayout::kMaxColumns);
+  layout.rowSize = sizeof(int64_t) * (1 + layout.numKeys + layout.numColumns);
+  return layout;
+}
+
+std::shared_ptr<WaveHashJoinBridge> getBridge(
+    CompileState& state,
+    const core::PlanNodeId& planNodeId) {
+  auto* driverCtx = state.driver().driverCtx();
+  return WaveHashJoinBridge::get(
+      driverCtx->task->taskId(), driverCtx->splitGroupId, planNodeId);
+}
+
+join::Column toColumn(const WaveVector& vector, Operand* operand) {
+  vector.toOperand(operand);
+  return {operand, static_cast<int32_t>(vector.type()->cppSizeInBytes())};
+}
+
+} // namespace
+
+bool isWaveHashJoin(const core::HashJoinNode& node) {
+  if (!node.isInnerJoin() || node.filter()) {
+    return false;
+  }
+  auto numColumns = buildColumnNames(node).size();
+  if (numColumns > join::RowLayout::kMaxColumns) {
+    return false;
+  }
+  for (auto i = 0; i < node.leftKeys().size(); ++i) {
+    auto& probeKey = node.leftKeys()[i]->type();
+    auto& buildKey = node.rightKeys()[i]->type();
+    if (!isWaveKeyType(probeKey) || probeKey->kind() != buildKey->kind()) {
+      return false;
+    }
+  }
+  for (auto& type : node.outputType()->children()) {
+    if (!isWaveColumnType(type)) {
+      return false;
+    }
+  }
+  return isWaveJoinSource(node.sources()[0], true) &&
+      isWaveJoinSource(node.sources()[1], false);
+}
+
+WaveHashJoinBridge::WaveHashJoinBridge()
+    : arena_(std::make_unique<GpuArena>(
+          FLAGS_velox_wave_arena_unit_size,
+          getAllocator(getDevice()))) {}
+
+// static
+std::shared_ptr<WaveHashJoinBridge> WaveHashJoinBridge::get(
+    const std::string& taskId,
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  static std::mutex mutex;
+  static folly::F14FastMap<std::string, std::weak_ptr<WaveHashJoinBridge>>
+      bridges;
+  auto key = fmt::format("{}/{}/{}", taskId, splitGroupId, planNodeId);
+  std::lock_guard<std::mutex> l(mutex);
+  for (auto it = bridges.begin(); it != bridges.end();) {
+    if (it->second.expired() && it->first != key) {
+      it = bridges.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto& weak = bridges[key];
+  auto bridge = weak.lock();
+  if (!bridge) {
+    bridge = std::make_shared<WaveHashJoinBridge>();
+    weak = bridge;
+  }
+  return bridge;
+}
+
+void WaveHashJoinBridge::addBuilder() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_EQ(numFinished_, 0);
+  ++numBuilders_;
+}
+
+bool WaveHashJoinBridge::addRows(WaveBufferPtr rows, int32_t numRows) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_LT(numFinished_, numBuilders_);
+  rows_.emplace_back(std::move(rows), numRows);
+  return ++numFinished_ == numBuilders_;
+}
+
+void WaveHashJoinBridge::buildTable(
+    Stream& stream,
+    const join::RowLayout& layout) {
+  std::vector<std::pair<WaveBufferPtr, int32_t>> rows;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_EQ(numFinished_, numBuilders_);
+    VELOX_CHECK(!built_);
+    rows = rows_;
+  }
+  int64_t numRows = 0;
+  for (auto& [buffer, size] : rows) {
+    numRows += size;
+  }
+  auto numBuckets = join::numBuckets(numRows);
+  auto* table = arena_->allocate<GpuHashTableBase>(1, table_);
+  auto* buckets = arena_->allocate<GpuBucketMembers>(numBuckets, buckets_);
+  memset(buckets, 0, numBuckets * sizeof(GpuBucketMembers));
+  table->buckets = reinterpret_cast<GpuBucket*>(buckets);
+  table->sizeMask = numBuckets - 1;
+  table->partitionMask = 0;
+  table->partitionShift = 0;
+  table->allocators = nullptr;
+  std::vector<WaveBufferPtr> builds;
+  for (auto& [buffer, size] : rows) {
+    if (size == 0) {
+      continue;
+    }
+    auto* build = arena_->allocate<join::Build>(1, builds.emplace_back());
+    build->table = table;
+    build->layout = layout;
+    build->numRows = size;
+    build->keys = nullptr;
+    build->columns = nullptr;
+    build->rows = buffer->as<char>();
+    join::insertRows(stream, build);
+  }
+  stream.wait();
+  VLOG(1) << "Built hash table with " << numRows << " rows in " << numBuckets
+          << " buckets";
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    built_ = true;
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+GpuHashTableBase* WaveHashJoinBridge::table(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (built_) {
+    return table_->as<GpuHashTableBase>();
+  }
+  promises_.emplace_back("WaveHashJoinBridge::table");
+  *future = promises_.back().getSemiFuture();
+  return nullptr;
+}
+
+HashBuild::HashBuild(CompileState& state, const core::HashJoinNode& node)
+    : WaveOperator(state, ROW({}, {}), node.id()),
+      bridge_(getBridge(state, node.id())),
+      layout_(makeLayout(node)) {
+  bridge_->addBuilder();
+  auto& buildType = node.sources()[1]->outputType();
+  for (auto& key : node.rightKeys()) {
+    keyChannels_.push_back(buildType->getChildIdx(key->name()));
+  }
+  for (auto& name : buildColumnNames(node)) {
+    columnChannels_.push_back(buildType->getChildIdx(name));
+  }
+}
+
+HashBuild::~HashBuild() {
+  if (stream_) {
+    WaveStream::releaseStream(std::move(stream_));
+  }
+}
+
+void HashBuild::flush(bool noMoreInput) {
+  if (!noMoreInput || noMoreInput_) {
+    return;
+  }
+  noMoreInput_ = true;
+  stream_ = WaveStream::streamFromReserve();
+  addRows();
+  finished_ = true;
+}
+
+void HashBuild::addRows() {
+  int64_t numRows = 0;
+  for (auto& input : buffered_) {
+    numRows += input->size();
+  }
+  auto& arena = bridge_->arena();
+  auto rows = arena.allocateBytes(
+      std::max<int64_t>(1, numRows) * layout_.rowSize);
+  std::vector<WaveBufferPtr> builds;
+  int64_t offset = 0;
+  for (auto& input : buffered_) {
+    if (input->size() == 0) {
+      continue;
+    }
+    auto numColumns = keyChannels_.size() + columnChannels_.size();
+    auto* build = arena.allocate<join::Build>(1, builds.emplace_back());
+    auto* columns =
+        arena.allocate<join::Column>(numColumns, builds.emplace_back());
+    auto* operands = arena.allocate<Operand>(numColumns, builds.emplace_back());
+    for (auto i = 0; i < keyChannels_.size(); ++i) {
+      columns[i] = toColumn(input->childAt(keyChannels_[i]), &operands[i]);
+    }
+    for (auto i = 0; i < columnChannels_.size(); ++i) {
+      auto j = i + keyChannels_.size();
+      columns[j] = toColumn(input->childAt(columnChannels_[i]), &operands[j]);
+    }
+    build->table = nullptr;
+    build->layout = layout_;
+    build->numRows = input->size();
+    build->keys = columns;
+    build->columns = columns + keyChannels_.size();
+    build->rows = rows->as<char>() + offset * layout_.rowSize;
+    join::packRows(*stream_, build);
+    offset += input->size();
+  }
+  stream_->wait();
+  buffered_.clear();
+  if (bridge_->addRows(std::move(rows), numRows)) {
+    bridge_->buildTable(*stream_, layout_);
+  }
+}
+
+HashProbe::HashProbe(CompileState& state, const core::HashJoinNode& node)
+    : WaveOperator(state, node.outputType(), node.id()),
+      arena_(&state.arena()),
+      bridge_(getBridge(state, node.id())),
+      layout_(makeLayout(node)) {
+  isExpanding_ = true;
+  auto& probeType = node.sources()[0]->outputType();
+  for (auto& key : node.leftKeys()) {
+    keyChannels_.push_back(probeType->getChildIdx(key->name()));
+  }
+  auto buildColumns = buildColumnNames(node);
+  for (auto& name : outputType_->names()) {
+    if (auto channel = probeType->getChildIdxIfExists(name)) {
+      outputColumns_.push_back({true, static_cast<int32_t>(*channel), -1});
+      continue;
+    }
+    auto it = std::find(buildColumns.begin(), buildColumns.end(), name);
+    VELOX_CHECK(it != buildColumns.end());
+    outputColumns_.push_back(
+        {false, static_cast<int32_t>(it - buildColumns.begin()), -1});
+  }
+}
+
+HashProbe::~HashProbe() {
+  if (stream_) {
+    WaveStream::releaseStream(std::move(stream_));
+  }
+}
+
+exec::BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
+  if (!table_) {
+    table_ = bridge_->table(future);
+  }
+  return table_ ? exec::BlockingReason::kNotBlocked
+                : exec::BlockingReason::kWaitForJoinBuild;
+}
+
+join::Column* HashProbe::toColumns(const std::vector<int32_t>& channels) {
+  auto numColumns = channels.size();
+  auto* columns =
+      arena_->allocate<join::Column>(numColumns, probeData_.emplace_back());
+  auto* operands =
+      arena_->allocate<Operand>(numColumns, probeData_.emplace_back());
+  for (auto i = 0; i < channels.size(); ++i) {
+    columns[i] = toColumn(current_->childAt(channels[i]), &operands[i]);
+  }
+  return columns;
+}
+
+int32_t HashProbe::canAdvance(WaveStream& /*stream*/) {
+  VELOX_CHECK_NULL(current_);
+  if (!table_) {
+    return 0;
+  }
+  if (!stream_) {
+    stream_ = WaveStream::streamFromReserve();
+  }
+  while (!buffered_.empty()) {
+    current_ = std::move(buffered_.front());
+    buffered_.erase(buffered_.begin());
+    auto numRows = current_->size();
+    if (numRows == 0) {
+      current_.reset();
+      continue;
+    }
+    probeData_.clear();
+    probe_ = arena_->allocate<join::Probe>(1, probeData_.emplace_back());
+    probe_->table = table_;
+    probe_->layout = layout_;
+    probe_->numRows = numRows;
+    probe_->keys = toColumns(keyChannels_);
+    probe_->counts =
+        arena_->allocate<int32_t>(numRows, probeData_.emplace_back());
+    probe_->offsets =
+        arena_->allocate<int32_t>(numRows, probeData_.emplace_back());
+    join::countMatches(*stream_, probe_);
+    auto tempBytes = join::offsetsTempBytes(numRows);
+    auto temp = arena_->allocateBytes(std::max<size_t>(1, tempBytes));
+    join::offsets(*stream_, probe_, temp->as<char>(), tempBytes);
+    probeData_.push_back(std::move(temp));
+    stream_->wait();
+    numOutputRows_ =
+        probe_->offsets[numRows - 1] + probe_->counts[numRows - 1];
+    if (numOutputRows_ > 0) {
+      VLOG(1) << "Probe " << numRows << " rows with " << numOutputRows_
+              << " matches";
+      return numOutputRows_;
+    }
+    current_.reset();
+    probeData_.clear();
+    probe_ = nullptr;
+  }
+  return 0;
+}
+
+void HashProbe::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK_NOT_NULL(current_);
+  auto exec = std::make_unique<Executable>();
+  auto numBlocks = bits::roundUp(maxRows, kBlockSize) / kBlockSize;
+  auto* rowStatus =
+      arena_->allocate<BlockStatus>(numBlocks, exec->deviceData.emplace_back());
+  bzero(rowStatus, numBlocks * sizeof(BlockStatus));
+  for (auto i = 0; i < numBlocks; ++i) {
+    rowStatus[i].numRows =
+        i == numBlocks - 1 ? maxRows - kBlockSize * i : kBlockSize;
+  }
+  auto numOutputs = outputIds_.size();
+  exec->operands =
+      arena_->allocate<Operand>(numOutputs, exec->deviceData.emplace_back());
+  exec->outputOperands = outputIds_;
+  exec->firstOutputOperandIdx = 0;
+  exec->output.resize(numOutputs);
+
+  auto numColumns = outputColumns_.size();
+  auto allocateColumns = [&]() {
+    return arena_->allocate<join::Column>(
+        numColumns, exec->deviceData.emplace_back());
+  };
+  auto* probeInputs = allocateColumns();
+  auto* probeOutputs = allocateColumns();
+  auto* buildOutputs = allocateColumns();
+  auto* buildSlots =
+      arena_->allocate<int32_t>(numColumns, exec->deviceData.emplace_back());
+  auto* inputOperands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  int32_t numProbeColumns = 0;
+  int32_t numBuildColumns = 0;
+  for (auto i = 0; i < numColumns; ++i) {
+    auto& column = outputColumns_[i];
+    if (column.ordinal < 0) {
+      auto* operand = defines(Value(subfields_[i]));
+      VELOX_CHECK_NOT_NULL(operand);
+      column.ordinal = outputIds_.ordinal(operand->id);
+    }
+    auto vector = WaveVector::create(outputType_->childAt(i), *arena_);
+    vector->resize(maxRows, true);
+    auto result = toColumn(*vector, &exec->operands[column.ordinal]);
+    if (column.fromProbe) {
+      probeInputs[numProbeColumns] = toColumn(
+          current_->childAt(column.channel), &inputOperands[numProbeColumns]);
+      probeOutputs[numProbeColumns++] = result;
+    } else {
+      buildSlots[numBuildColumns] = column.channel;
+      buildOutputs[numBuildColumns++] = result;
+    }
+    exec->output[column.ordinal] = std::move(vector);
+  }
+  auto* probe = probe_;
+  probe->numProbeColumns = numProbeColumns;
+  probe->probeInputs = probeInputs;
+  probe->probeOutputs = probeOutputs;
+  probe->numBuildColumns = numBuildColumns;
+  probe->buildSlots = buildSlots;
+  probe->buildOutputs = buildOutputs;
+
+  // The input and the counts and offsets are needed until the expand arrives.
+  exec->intermediates.push_back(std::move(current_));
+  for (auto& buffer : probeData_) {
+    exec->deviceData.push_back(std::move(buffer));
+  }
+  probeData_.clear();
+  probe_ = nullptr;
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        auto control = std::make_unique<LaunchControl>(id_, maxRows);
+        control->status = rowStatus;
+        waveStream.addLaunchControl(id_, std::move(control));
+        join::expand(*stream, probe);
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+}
+
+} // namespace facebook::velox::wave
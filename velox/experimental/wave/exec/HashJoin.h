@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Returns true if 'node' can run as a Wave HashBuild and HashProbe. The
+/// decision depends on the plan only, so that the build and probe Drivers of
+/// a join agree on whether both sides are on Wave. Requires an inner join
+/// without filter on INTEGER or BIGINT keys, fixed width columns and build
+/// and probe sides that are scans or values with filters and projections on
+/// top.
+bool isWaveHashJoin(const core::HashJoinNode& node);
+
+/// Hands off the build side rows of a Wave hash join from the HashBuilds of a
+/// Task to its HashProbes. The last HashBuild to finish makes the table.
+class WaveHashJoinBridge {
+ public:
+  WaveHashJoinBridge();
+
+  /// Returns the bridge for the join 'planNodeId' in 'splitGroupId' of task
+  /// 'taskId'. The bridge lives as long as there is a HashBuild or HashProbe
+  /// referencing it.
+  static std::shared_ptr<WaveHashJoinBridge> get(
+      const std::string& taskId,
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
+  /// Registers a HashBuild. All HashBuilds are registered before any calls
+  /// addRows().
+  void addBuilder();
+
+  /// Adds 'numRows' rows in 'rows' from a HashBuild that has no more input.
+  /// Returns true if this is the last HashBuild, which must then call
+  /// buildTable().
+  bool addRows(WaveBufferPtr rows, int32_t numRows);
+
+  /// Inserts all added rows into a new table on 'stream' and waits for the
+  /// table. Realizes the futures of HashProbes waiting for the table.
+  void buildTable(Stream& stream, const join::RowLayout& layout);
+
+  /// Returns the table or nullptr and sets 'future' if the table is not
+  /// built.
+  GpuHashTableBase* table(ContinueFuture* future);
+
+  /// Memory for the rows and the table. Outlives the HashBuilds.
+  GpuArena& arena() {
+    return *arena_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unique_ptr<GpuArena> arena_;
+  int32_t numBuilders_{0};
+  int32_t numFinished_{0};
+  std::vector<std::pair<WaveBufferPtr, int32_t>> rows_;
+  WaveBufferPtr table_;
+  WaveBufferPtr buckets_;
+  bool built_{false};
+  std::vector<ContinuePromise> promises_;
+};
+
+class HashBuild : public WaveOperator {
+ public:
+  HashBuild(CompileState& state, const core::HashJoinNode& node);
+
+  ~HashBuild() override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override {
+    VELOX_UNREACHABLE("HashBuild produces no output");
+  }
+
+  bool isFinished() const override {
+    return finished_;
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return 0;
+  }
+
+  std::string toString() const override {
+    return "HashBuild";
+  }
+
+ private:
+  // Packs 'buffered_' into rows in memory of the bridge and adds them to the
+  // bridge.
+  void addRows();
+
+  std::shared_ptr<WaveHashJoinBridge> bridge_;
+  join::RowLayout layout_;
+  std::vector<int32_t> keyChannels_;
+  std::vector<int32_t> columnChannels_;
+  std::vector<WaveVectorPtr> buffered_;
+  std::unique_ptr<Stream> stream_;
+  bool noMoreInput_{false};
+  bool finished_{false};
+};
+
+class HashProbe : public WaveOperator {
+ public:
+  HashProbe(CompileState& state, const core::HashJoinNode& node);
+
+  ~HashProbe() override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override {
+    noMoreInput_ |= noMoreInput;
+  }
+
+  /// Counts the matches of the next buffered batch and returns the number of
+  /// result rows.
+  int32_t canAdvance(WaveStream& stream) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return noMoreInput_ && buffered_.empty() && !current_;
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return numOutputRows_;
+  }
+
+  std::string toString() const override {
+    return "HashProbe";
+  }
+
+ private:
+  // A probe side column or a build side dependent column copied to the
+  // result.
+  struct OutputColumn {
+    bool fromProbe;
+    // Channel in the probe input or slot in the build side row.
+    int32_t channel;
+    // Index in 'outputIds_'.
+    int32_t ordinal;
+  };
+
+  // Returns Columns for 'channels' of 'current_'. The memory is added to
+  // 'probeData_'.
+  join::Column* toColumns(const std::vector<int32_t>& channels);
+
+  GpuArena* arena_;
+  std::shared_ptr<WaveHashJoinBridge> bridge_;
+  GpuHashTableBase* table_{nullptr};
+  join::RowLayout layout_;
+  std::vector<int32_t> keyChannels_;
+  std::vector<OutputColumn> outputColumns_;
+  std::vector<WaveVectorPtr> buffered_;
+  std::unique_ptr<Stream> stream_;
+
+  // The batch being probed and the counts and offsets of its matches.
+  WaveVectorPtr current_;
+  join::Probe* probe_{nullptr};
+  std::vector<WaveBufferPtr> probeData_;
+  int32_t numOutputRows_{0};
+  bool noMoreInput_{false};
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+
+#include <cub/cub.cuh> // @manual
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/Hash.h"
+#include "velox/experimental/wave/common/HashTable.cuh"
+
+namespace facebook::velox::wave::join {
+
+namespace {
+
+__device__ inline int32_t rowIndex(const Operand* op, int32_t i) {
+  if (auto indices = op->indices) {
+    if (indices[0]) {
+      return indices[0][i];
+    }
+  }
+  return i;
+}
+
+__device__ inline bool isNull(const Operand* op, int32_t i) {
+  return op->nulls && op->nulls[rowIndex(op, i)] == kNull;
+}
+
+// Returns the value at row 'i' of 'column' in a 64 bit slot.
+__device__ inline int64_t loadSlot(const Column& column, int32_t i) {
+  auto index = rowIndex(column.operand, i);
+  if (column.size == 4) {
+    return reinterpret_cast<const int32_t*>(column.operand->base)[index];
+  }
+  return reinterpret_cast<const int64_t*>(column.operand->base)[index];
+}
+
+// Sets row 'i' of 'column' to the value in 'slot' or to null.
+__device__ inline void
+storeSlot(const Column& column, int32_t i, int64_t slot, bool null) {
+  auto* op = column.operand;
+  if (op->nulls) {
+    op->nulls[i] = null ? kNull : kNotNull;
+  }
+  if (null) {
+    return;
+  }
+  if (column.size == 4) {
+    reinterpret_cast<int32_t*>(op->base)[i] = static_cast<int32_t>(slot);
+  } else {
+    reinterpret_cast<int64_t*>(op->base)[i] = slot;
+  }
+}
+
+__device__ inline int64_t* rowAt(char* rows, const RowLayout& layout, int i) {
+  return reinterpret_cast<int64_t*>(
+      rows + static_cast<int64_t>(i) * layout.rowSize);
+}
+
+__device__ inline uint64_t hashRowKeys(const int64_t* row, int32_t numKeys) {
+  uint64_t hash = 1;
+  for (auto k = 0; k < numKeys; ++k) {
+    hash = hashMix(hash, row[1 + k]);
+  }
+  return hash;
+}
+
+// Returns the hash of the keys of probe row 'i' or sets 'null' if a key is
+// null.
+__device__ inline uint64_t
+hashProbeKeys(const Probe* probe, int32_t i, bool& null) {
+  uint64_t hash = 1;
+  for (auto k = 0; k < probe->layout.numKeys; ++k) {
+    if (isNull(probe->keys[k].operand, i)) {
+      null = true;
+      return 0;
+    }
+    hash = hashMix(hash, loadSlot(probe->keys[k], i));
+  }
+  null = false;
+  return hash;
+}
+
+__device__ inline bool
+keysEqual(const Probe* probe, int32_t i, const int64_t* row) {
+  for (auto k = 0; k < probe->layout.numKeys; ++k) {
+    if (row[1 + k] != loadSlot(probe->keys[k], i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Calls 'func' with each build side row that matches probe row 'i' with hash
+// number 'hash'. Equal keys are in separate entries, so probing continues
+// until a bucket with an empty slot.
+template <typename Func>
+__device__ void
+forEachMatch(const Probe* probe, int32_t i, uint64_t hash, Func func) {
+  auto* table = reinterpret_cast<GpuHashTable*>(probe->table);
+  uint32_t tagWord = hashTag(hash);
+  tagWord |= tagWord << 8;
+  tagWord |= tagWord << 16;
+  auto bucketIdx = hash & table->sizeMask;
+  for (;;) {
+    auto* bucket = table->buckets + bucketIdx;
+    auto tags = bucket->tags;
+    auto hits = __vcmpeq4(tags, tagWord) & 0x01010101;
+    while (hits) {
+      auto hitIdx = (__ffs(hits) - 1) / 8;
+      auto* row = bucket->load<int64_t>(hitIdx);
+      if (keysEqual(probe, i, row)) {
+        func(row);
+      }
+      hits &= hits - 1;
+    }
+    if (__vcmpeq4(tags, 0)) {
+      return;
+    }
+    bucketIdx = (bucketIdx + 1) & table->sizeMask;
+  }
+}
+
+__global__ void packRowsKernel(Build* build) {
+  int32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= build->numRows) {
+    return;
+  }
+  auto& layout = build->layout;
+  auto* row = rowAt(build->rows, layout, i);
+  uint64_t nulls = 0;
+  for (auto k = 0; k < layout.numKeys; ++k) {
+    if (isNull(build->keys[k].operand, i)) {
+      nulls |= RowLayout::kNullKeyBit;
+    } else {
+      row[1 + k] = loadSlot(build->keys[k], i);
+    }
+  }
+  for (auto c = 0; c < layout.numColumns; ++c) {
+    if (isNull(build->columns[c].operand, i)) {
+      nulls |= 1ULL << c;
+    } else {
+      row[1 + layout.numKeys + c] = loadSlot(build->columns[c], i);
+    }
+  }
+  row[0] = nulls;
+}
+
+__global__ void insertRowsKernel(Build* build) {
+  int32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= build->numRows) {
+    return;
+  }
+  auto* row = rowAt(build->rows, build->layout, i);
+  if (row[0] & RowLayout::kNullKeyBit) {
+    return;
+  }
+  auto* table = reinterpret_cast<GpuHashTable*>(build->table);
+  auto hash = hashRowKeys(row, build->layout.numKeys);
+  auto tag = hashTag(hash);
+  auto bucketIdx = hash & table->sizeMask;
+  for (;;) {
+    auto* bucket = table->buckets + bucketIdx;
+    auto tags = asDeviceAtomic<uint32_t>(&bucket->tags)
+                    ->load(cuda::memory_order_consume);
+    auto misses = __vcmpeq4(tags, 0);
+    if (!misses) {
+      bucketIdx = (bucketIdx + 1) & table->sizeMask;
+      continue;
+    }
+    auto missShift = __ffs(misses) - 1;
+    if (bucket->addNewTag(tag, tags, missShift)) {
+      bucket->store(missShift / 8, row);
+      return;
+    }
+    // Another thread took the slot. Retry the same bucket.
+  }
+}
+
+__global__ void countMatchesKernel(Probe* probe) {
+  int32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= probe->numRows) {
+    return;
+  }
+  bool null;
+  auto hash = hashProbeKeys(probe, i, null);
+  int32_t count = 0;
+  if (!null) {
+    forEachMatch(probe, i, hash, [&](const int64_t*) { ++count; });
+  }
+  probe->counts[i] = count;
+}
+
+__global__ void expandKernel(Probe* probe) {
+  int32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= probe->numRows || probe->counts[i] == 0) {
+    return;
+  }
+  bool null;
+  auto hash = hashProbeKeys(probe, i, null);
+  auto numKeys = probe->layout.numKeys;
+  auto out = probe->offsets[i];
+  forEachMatch(probe, i, hash, [&](const int64_t* row) {
+    for (auto c = 0; c < probe->numProbeColumns; ++c) {
+      auto& input = probe->probeInputs[c];
+      storeSlot(
+          probe->probeOutputs[c],
+          out,
+          loadSlot(input, i),
+          isNull(input.operand, i));
+    }
+    for (auto c = 0; c < probe->numBuildColumns; ++c) {
+      auto slot = probe->buildSlots[c];
+      storeSlot(
+          probe->buildOutputs[c],
+          out,
+          row[1 + numKeys + slot],
+          (row[0] >> slot) & 1);
+    }
+    ++out;
+  });
+}
+
+int32_t numBlocks(int32_t numRows) {
+  return (numRows + kBlockSize - 1) / kBlockSize;
+}
+
+} // namespace
+
+int32_t numBuckets(int64_t numRows) {
+  // 4 slots per bucket.
+  int64_t buckets = 1;
+  while (buckets * 2 < numRows) {
+    buckets *= 2;
+  }
+  return buckets;
+}
+
+void packRows(Stream& stream, Build* build) {
+  packRowsKernel<<<
+      numBlocks(build->numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(build);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void insertRows(Stream& stream, Build* build) {
+  insertRowsKernel<<<
+      numBlocks(build->numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(build);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void countMatches(Stream& stream, Probe* probe) {
+  countMatchesKernel<<<
+      numBlocks(probe->numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(probe);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+size_t offsetsTempBytes(int32_t numRows) {
+  size_t bytes = 0;
+  CUDA_CHECK(cub::DeviceScan::ExclusiveSum(
+      nullptr,
+      bytes,
+      static_cast<int32_t*>(nullptr),
+      static_cast<int32_t*>(nullptr),
+      numRows));
+  return bytes;
+}
+
+void offsets(Stream& stream, Probe* probe, void* temp, size_t tempBytes) {
+  CUDA_CHECK(cub::DeviceScan::ExclusiveSum(
+      temp,
+      tempBytes,
+      probe->counts,
+      probe->offsets,
+      probe->numRows,
+      stream.stream()->stream));
+}
+
+void expand(Stream& stream, Probe* probe) {
+  expandKernel<<<
+      numBlocks(probe->numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(probe);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::join
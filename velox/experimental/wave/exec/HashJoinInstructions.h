@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/HashTable.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+/// Kernels for building and probing the GPU hash table of an inner equi join.
+/// Can be included in both Velox .cpp and .cu.
+namespace facebook::velox::wave::join {
+
+/// Layout of a build side row. A row is a 64 bit word of null flags followed
+/// by 'numKeys' 64 bit key slots and 'numColumns' 64 bit slots for the
+/// dependent columns. Bit i of the null flags is set if dependent column i is
+/// null and kNullKeyBit is set if any key is null. Values of 4 bytes are sign
+/// extended to their slot.
+struct RowLayout {
+  static constexpr uint64_t kNullKeyBit = 1ULL << 63;
+  static constexpr int32_t kMaxColumns = 63;
+
+  int32_t numKeys;
+  int32_t numColumns;
+  int32_t rowSize;
+};
+
+/// A column of probe or build side input or of the join result.
+struct Column {
+  Operand* operand;
+  /// Size of a value in bytes, 4 or 8.
+  int32_t size;
+};
+
+/// Arguments for packing a batch of build side input into rows and inserting
+/// the rows into the table.
+struct Build {
+  GpuHashTableBase* table;
+  RowLayout layout;
+  int32_t numRows;
+  /// 'layout.numKeys' key columns.
+  Column* keys;
+  /// 'layout.numColumns' dependent columns.
+  Column* columns;
+  /// 'numRows' rows of 'layout.rowSize' bytes.
+  char* rows;
+};
+
+/// Arguments for probing the table with a batch of probe side input.
+struct Probe {
+  GpuHashTableBase* table;
+  RowLayout layout;
+  int32_t numRows;
+  /// 'layout.numKeys' probe side key columns.
+  Column* keys;
+  /// Number of matching build side rows for each probe row.
+  int32_t* counts;
+  /// Position of the first result row of each probe row. Exclusive sum of
+  /// 'counts'.
+  int32_t* offsets;
+  /// The probe side columns copied to the result and their result columns.
+  int32_t numProbeColumns;
+  Column* probeInputs;
+  Column* probeOutputs;
+  /// The dependent columns of the build side rows copied to the result. The
+  /// slot in the row of each and the result columns.
+  int32_t numBuildColumns;
+  int32_t* buildSlots;
+  Column* buildOutputs;
+};
+
+/// Returns the number of buckets of a table for 'numRows' build side rows.
+/// Leaves at least half of the slots empty.
+int32_t numBuckets(int64_t numRows);
+
+/// Writes the rows of 'build' from its key and dependent columns.
+void packRows(Stream& stream, Build* build);
+
+/// Inserts the rows of 'build' into 'build->table'. Rows with a null key are
+/// not inserted. Rows with equal keys are inserted as separate entries.
+void insertRows(Stream& stream, Build* build);
+
+/// Sets 'probe->counts' to the number of matches of each probe row.
+void countMatches(Stream& stream, Probe* probe);
+
+/// Returns the size of the temporary device memory for offsets().
+size_t offsetsTempBytes(int32_t numRows);
+
+/// Sets 'probe->offsets' to the exclusive sum of 'probe->counts'. 'temp' has
+/// offsetsTempBytes() bytes of device memory.
+void offsets(Stream& stream, Probe* probe, void* temp, size_t tempBytes);
+
+/// Writes a result row for each match of each probe row to the probe and
+/// build side result columns of 'probe', starting at 'probe->offsets'.
+void expand(Stream& stream, Probe* probe);
+
+} // namespace facebook::velox::wave::join
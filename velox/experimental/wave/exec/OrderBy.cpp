@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/OrderBy.h"
+
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+
+bool isWaveOrderBy(const core::OrderByNode& node) {
+  for (auto& type : node.outputType()->children()) {
+    switch (type->kind()) {
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+OrderBy::OrderBy(CompileState& state, const core::OrderByNode& node)
+    : WaveOperator(state, node.outputType(), node.id()),
+      arena_(&state.arena()) {
+  for (auto i = 0; i < node.sortingKeys().size(); ++i) {
+    auto channel = outputType_->getChildIdx(node.sortingKeys()[i]->name());
+    auto& order = node.sortingOrders()[i];
+    keyChannels_.push_back(channel);
+    keys_.push_back(
+        {nullptr,
+         fromCpuType(*outputType_->childAt(channel)).kind,
+         order.isAscending(),
+         order.isNullsFirst()});
+  }
+}
+
+OrderBy::~OrderBy() {
+  if (stream_) {
+    WaveStream::releaseStream(std::move(stream_));
+  }
+}
+
+void OrderBy::flush(bool noMoreInput) {
+  if (!noMoreInput || noMoreInput_) {
+    return;
+  }
+  noMoreInput_ = true;
+  sort();
+  sorted_ = true;
+}
+
+void OrderBy::sort() {
+  for (auto& input : buffered_) {
+    numRows_ += input->size();
+  }
+  if (numRows_ == 0) {
+    buffered_.clear();
+    return;
+  }
+  stream_ = WaveStream::streamFromReserve();
+  // Operands and buffers needed until the sort is done.
+  std::vector<WaveBufferPtr> temp;
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    auto& type = outputType_->childAt(i);
+    bool nullable = false;
+    for (auto& input : buffered_) {
+      nullable |= input->childAt(i).mayHaveNulls();
+    }
+    auto column = WaveVector::create(type, *arena_);
+    column->resize(numRows_, nullable);
+    auto* target = arena_->allocate<Operand>(1, temp.emplace_back());
+    column->toOperand(target);
+    int32_t offset = 0;
+    for (auto& input : buffered_) {
+      if (input->size() == 0) {
+        continue;
+      }
+      auto* source = arena_->allocate<Operand>(1, temp.emplace_back());
+      input->childAt(i).toOperand(source);
+      sort::copyColumn(
+          *stream_,
+          source,
+          input->size(),
+          type->cppSizeInBytes(),
+          target,
+          offset);
+      offset += input->size();
+    }
+    columns_.push_back(std::move(column));
+  }
+
+  sort::SortBuffers buffers;
+  for (auto i = 0; i < 2; ++i) {
+    buffers.keys[i] = arena_->allocate<uint64_t>(numRows_, temp.emplace_back());
+    buffers.flags[i] = arena_->allocate<uint8_t>(numRows_, temp.emplace_back());
+    buffers.indices[i] =
+        arena_->allocate<int32_t>(numRows_, sortData_.emplace_back());
+  }
+  buffers.tempBytes = sort::sortTempBytes(numRows_);
+  temp.push_back(arena_->allocateBytes(std::max<size_t>(1, buffers.tempBytes)));
+  buffers.temp = temp.back()->as<char>();
+  sort::initIndices(*stream_, numRows_, buffers);
+  for (int32_t i = keys_.size() - 1; i >= 0; --i) {
+    auto key = keys_[i];
+    key.operand = arena_->allocate<Operand>(1, temp.emplace_back());
+    columns_[keyChannels_[i]]->toOperand(key.operand);
+    sort::sortIndices(*stream_, key, numRows_, buffers);
+  }
+  stream_->wait();
+  indices_ = buffers.indices[0];
+  buffered_.clear();
+  VLOG(1) << "Sorted " << numRows_ << " rows";
+}
+
+int32_t OrderBy::canAdvance(WaveStream& /*stream*/) {
+  if (!sorted_ || nextRow_ == numRows_) {
+    return 0;
+  }
+  return std::min(kOutputBatchRows, numRows_ - nextRow_);
+}
+
+void OrderBy::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK(sorted_);
+  auto numColumns = outputType_->size();
+  if (ordinals_.empty()) {
+    for (auto i = 0; i < numColumns; ++i) {
+      auto* operand = defines(Value(subfields_[i]));
+      VELOX_CHECK_NOT_NULL(operand);
+      ordinals_.push_back(outputIds_.ordinal(operand->id));
+    }
+  }
+  auto exec = std::make_unique<Executable>();
+  auto numBlocks = bits::roundUp(maxRows, kBlockSize) / kBlockSize;
+  auto* rowStatus =
+      arena_->allocate<BlockStatus>(numBlocks, exec->deviceData.emplace_back());
+  bzero(rowStatus, numBlocks * sizeof(BlockStatus));
+  for (auto i = 0; i < numBlocks; ++i) {
+    rowStatus[i].numRows =
+        i == numBlocks - 1 ? maxRows - kBlockSize * i : kBlockSize;
+  }
+  exec->operands = arena_->allocate<Operand>(
+      outputIds_.size(), exec->deviceData.emplace_back());
+  exec->outputOperands = outputIds_;
+  exec->firstOutputOperandIdx = 0;
+  exec->output.resize(outputIds_.size());
+  auto* sources =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  for (auto i = 0; i < numColumns; ++i) {
+    columns_[i]->toOperand(&sources[i]);
+    auto vector = WaveVector::create(outputType_->childAt(i), *arena_);
+    vector->resize(maxRows, columns_[i]->mayHaveNulls());
+    vector->toOperand(&exec->operands[ordinals_[i]]);
+    exec->output[ordinals_[i]] = std::move(vector);
+  }
+  auto* results = exec->operands;
+  auto* indices = indices_ + nextRow_;
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        auto control = std::make_unique<LaunchControl>(id_, maxRows);
+        control->status = rowStatus;
+        waveStream.addLaunchControl(id_, std::move(control));
+        for (auto i = 0; i < numColumns; ++i) {
+          sort::gather(
+              *stream,
+              &sources[i],
+              indices,
+              maxRows,
+              outputType_->childAt(i)->cppSizeInBytes(),
+              &results[ordinals_[i]]);
+        }
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+  nextRow_ += maxRows;
+  lastBatchRows_ = maxRows;
+}
+
+} // namespace facebook::velox::wave
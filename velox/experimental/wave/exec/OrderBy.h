@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/experimental/wave/exec/SortInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Returns true if 'node' can run as a Wave OrderBy. Requires fixed width
+/// columns.
+bool isWaveOrderBy(const core::OrderByNode& node);
+
+/// Sorts all input on device with radix sorts of the row numbers by each key,
+/// starting with the last key, and produces the result in batches gathered in
+/// the sorted order.
+class OrderBy : public WaveOperator {
+ public:
+  OrderBy(CompileState& state, const core::OrderByNode& node);
+
+  ~OrderBy() override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  int32_t canAdvance(WaveStream& stream) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return sorted_ && nextRow_ == numRows_;
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return lastBatchRows_;
+  }
+
+  std::string toString() const override {
+    return "OrderBy";
+  }
+
+ private:
+  static constexpr int32_t kOutputBatchRows = 16 << 10;
+
+  // Concatenates 'buffered_' into 'columns_' and sorts 'indices_'.
+  void sort();
+
+  GpuArena* arena_;
+  std::vector<sort::SortKey> keys_;
+  std::vector<int32_t> keyChannels_;
+
+  // Index in 'outputIds_' of each column. Set at first schedule().
+  std::vector<int32_t> ordinals_;
+
+  std::vector<WaveVectorPtr> buffered_;
+  std::unique_ptr<Stream> stream_;
+
+  // All input rows and the row numbers in sorted order.
+  std::vector<WaveVectorPtr> columns_;
+  std::vector<WaveBufferPtr> sortData_;
+  int32_t* indices_{nullptr};
+
+  int32_t numRows_{0};
+  int32_t nextRow_{0};
+  int32_t lastBatchRows_{0};
+  bool noMoreInput_{false};
+  bool sorted_{false};
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/Placement.h"
+
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <limits>
+
+DEFINE_double(
+    velox_wave_cpu_row_nanos,
+    20,
+    "Default CPU time per row of an operator without observed stats");
+DEFINE_double(
+    velox_wave_row_nanos,
+    0.5,
+    "Default Wave device time per row of an operator without observed stats");
+DEFINE_double(
+    velox_wave_launch_nanos,
+    5'000,
+    "Fixed cost of a kernel launch or transfer per batch on Wave");
+DEFINE_double(
+    velox_wave_transfer_byte_nanos,
+    0.1,
+    "Time per byte of copying data between host and device");
+DEFINE_int64(
+    velox_wave_min_observed_rows,
+    100'000,
+    "Rows an operator type must have been seen for before its observed cost "
+    "replaces the default");
+
+namespace facebook::velox::wave {
+
+PlacementStats& PlacementStats::instance() {
+  static PlacementStats stats;
+  return stats;
+}
+
+void PlacementStats::record(
+    const std::string& operatorType,
+    bool onWave,
+    int64_t rows,
+    int64_t nanos) {
+  if (rows <= 0) {
+    return;
+  }
+  observed_.withWLock([&](auto& observed) {
+    auto& entry = observed[operatorType];
+    if (onWave) {
+      entry.waveRows += rows;
+      entry.waveNanos += nanos;
+    } else {
+      entry.cpuRows += rows;
+      entry.cpuNanos += nanos;
+    }
+  });
+}
+
+void PlacementStats::recordTaskStats(const exec::TaskStats& stats) {
+  for (auto& pipeline : stats.pipelineStats) {
+    for (auto& op : pipeline.operatorStats) {
+      if (op.operatorType == "Wave") {
+        // Recorded per replaced operator by WaveDriver.
+        continue;
+      }
+      auto nanos = op.addInputTiming.cpuNanos + op.getOutputTiming.cpuNanos +
+          op.finishTiming.cpuNanos;
+      record(
+          op.operatorType,
+          false,
+          std::max(op.inputPositions, op.outputPositions),
+          nanos);
+    }
+  }
+}
+
+OperatorCost PlacementStats::cost(const std::string& operatorType) const {
+  OperatorCost cost{FLAGS_velox_wave_cpu_row_nanos, FLAGS_velox_wave_row_nanos};
+  observed_.withRLock([&](const auto& observed) {
+    auto it = observed.find(operatorType);
+    if (it == observed.end()) {
+      return;
+    }
+    auto& entry = it->second;
+    if (entry.cpuRows >= FLAGS_velox_wave_min_observed_rows) {
+      cost.cpuNanosPerRow = static_cast<double>(entry.cpuNanos) / entry.cpuRows;
+    }
+    if (entry.waveRows >= FLAGS_velox_wave_min_observed_rows) {
+      cost.waveNanosPerRow =
+          static_cast<double>(entry.waveNanos) / entry.waveRows;
+    }
+  });
+  return cost;
+}
+
+void PlacementStats::clear() {
+  observed_.wlock()->clear();
+}
+
+std::vector<std::pair<int32_t, int32_t>> placeOnWave(
+    const std::vector<PlacementInfo>& infos,
+    int32_t batchRows) {
+  constexpr double kInfinity = std::numeric_limits<double>::infinity();
+  // Cost of a required operator on CPU. Finite, so that there is a placement
+  // if the operator can not be on Wave.
+  constexpr double kRequiredCpuCost = 1e18;
+  const double rows = std::max(1, batchRows);
+  auto transferCost = [&](int32_t rowBytes) {
+    return FLAGS_velox_wave_launch_nanos +
+        rowBytes * rows * FLAGS_velox_wave_transfer_byte_nanos;
+  };
+  const auto numOps = infos.size();
+  // Lowest cost of the operators up to and including 'i' with 'i' on CPU and
+  // on Wave, and whether the operator before 'i' is on Wave in each case.
+  std::vector<double> cpuCost(numOps);
+  std::vector<double> waveCost(numOps);
+  std::vector<bool> cpuAfterWave(numOps, false);
+  std::vector<bool> waveAfterWave(numOps, false);
+  for (auto i = 0; i < numOps; ++i) {
+    auto& info = infos[i];
+    const double onCpu = info.supported && info.required
+        ? kRequiredCpuCost
+        : info.cost.cpuNanosPerRow * rows;
+    const double onWave = info.supported
+        ? FLAGS_velox_wave_launch_nanos + info.cost.waveNanosPerRow * rows
+        : kInfinity;
+    const double start = info.isSource ? 0
+        : info.canStart               ? transferCost(info.inputRowBytes)
+                                      : kInfinity;
+    if (i == 0) {
+      cpuCost[i] = onCpu;
+      waveCost[i] = onWave + start;
+      continue;
+    }
+    const double toHost = transferCost(infos[i - 1].outputRowBytes);
+    cpuAfterWave[i] = waveCost[i - 1] + toHost < cpuCost[i - 1];
+    cpuCost[i] = onCpu +
+        (cpuAfterWave[i] ? waveCost[i - 1] + toHost : cpuCost[i - 1]);
+    waveAfterWave[i] = waveCost[i - 1] <= cpuCost[i - 1] + start;
+    waveCost[i] =
+        onWave + (waveAfterWave[i] ? waveCost[i - 1] : cpuCost[i - 1] + start);
+  }
+
+  std::vector<std::pair<int32_t, int32_t>> ranges;
+  if (numOps == 0) {
+    return ranges;
+  }
+  bool onWave = waveCost[numOps - 1] +
+          transferCost(infos[numOps - 1].outputRowBytes) <
+      cpuCost[numOps - 1];
+  int32_t end = numOps;
+  for (int32_t i = numOps - 1; i >= 0; --i) {
+    const bool previousOnWave =
+        i > 0 && (onWave ? waveAfterWave[i] : cpuAfterWave[i]);
+    if (onWave && !previousOnWave) {
+      ranges.emplace_back(i, end);
+    } else if (!onWave && previousOnWave) {
+      end = i;
+    }
+    onWave = previousOnWave;
+  }
+  std::reverse(ranges.begin(), ranges.end());
+  return ranges;
+}
+
+int32_t estimateRowBytes(const RowType& type) {
+  // Variable width values are assumed to average 32 bytes.
+  constexpr int32_t kVariableWidthBytes = 32;
+  int32_t bytes = 0;
+  for (auto& child : type.children()) {
+    if (child->isFixedWidth()) {
+      bytes += child->cppSizeInBytes();
+    } else if (child->kind() == TypeKind::ROW) {
+      bytes += estimateRowBytes(child->asRow());
+    } else {
+      bytes += kVariableWidthBytes;
+    }
+  }
+  return bytes;
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/exec/TaskStats.h"
+#include "velox/type/Type.h"
+
+namespace facebook::velox::wave {
+
+/// Estimated cost of processing one row in an operator on CPU and on Wave.
+struct OperatorCost {
+  double cpuNanosPerRow;
+  double waveNanosPerRow;
+};
+
+/// Process-wide record of the per-row cost of operators, by operator type, as
+/// observed on CPU and Wave. CPU costs come from the TaskStats of completed
+/// Tasks, Wave costs from the device time of completed WaveDrivers. Types
+/// without observations get the defaults from the velox_wave_* flags.
+class PlacementStats {
+ public:
+  static PlacementStats& instance();
+
+  /// Adds 'nanos' of processing for 'rows' of an operator of 'operatorType'.
+  void record(
+      const std::string& operatorType,
+      bool onWave,
+      int64_t rows,
+      int64_t nanos);
+
+  /// Records the CPU time of the operators in 'stats'.
+  void recordTaskStats(const exec::TaskStats& stats);
+
+  OperatorCost cost(const std::string& operatorType) const;
+
+  /// Forgets all observations.
+  void clear();
+
+ private:
+  struct Observed {
+    int64_t cpuRows{0};
+    int64_t cpuNanos{0};
+    int64_t waveRows{0};
+    int64_t waveNanos{0};
+  };
+
+  folly::Synchronized<folly::F14FastMap<std::string, Observed>> observed_;
+};
+
+/// Describes one Operator of a Driver for deciding where it runs.
+struct PlacementInfo {
+  /// True if the operator has a Wave implementation.
+  bool supported{false};
+
+  /// True if the operator must run on Wave if supported and placeable, e.g.
+  /// one side of a hash join whose other side runs on Wave.
+  bool required{false};
+
+  /// True if the operator produces its data. A source does not need a host to
+  /// device transfer to be on Wave.
+  bool isSource{false};
+
+  /// True if a range on Wave can start at the operator, i.e. its input can be
+  /// copied to device.
+  bool canStart{false};
+
+  OperatorCost cost;
+
+  /// Estimated bytes per row of the operator's input and output.
+  int32_t inputRowBytes{0};
+  int32_t outputRowBytes{0};
+};
+
+/// Returns the [begin, end) ranges of the operators described by 'infos' that
+/// have the lowest estimated total cost on Wave for batches of 'batchRows'.
+/// Each range on Wave costs a kernel launch per operator and a copy of its
+/// input to device unless it starts at a source, and a copy of its output to
+/// host. The ranges are in increasing order.
+std::vector<std::pair<int32_t, int32_t>> placeOnWave(
+    const std::vector<PlacementInfo>& infos,
+    int32_t batchRows);
+
+/// Returns an estimate of the bytes per row of 'type'.
+int32_t estimateRowBytes(const RowType& type);
+
+} // namespace facebook::velox::wave
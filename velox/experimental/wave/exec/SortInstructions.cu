@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/experimental/wave/exec/SortInstructions.h"
+
+#include <cub/cub.cuh> // @manual
+#include <math_constants.h>
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+
+namespace facebook::velox::wave::sort {
+
+namespace {
+
+int32_t numBlocks(int32_t numRows) {
+  return (numRows + kBlockSize - 1) / kBlockSize;
+}
+
+__device__ inline int32_t rowIndex(const Operand* op, int32_t i) {
+  if (auto indices = op->indices) {
+    if (indices[0]) {
+      return indices[0][i];
+    }
+  }
+  return i;
+}
+
+__device__ inline bool isNull(const Operand* op, int32_t i) {
+  return op->nulls && op->nulls[i] == kNull;
+}
+
+template <typename T>
+__device__ inline void copyValue(
+    const Operand* source,
+    int32_t from,
+    Operand* target,
+    int32_t to) {
+  if (target->nulls) {
+    target->nulls[to] = isNull(source, from) ? kNull : kNotNull;
+  }
+  reinterpret_cast<T*>(target->base)[to] =
+      reinterpret_cast<const T*>(source->base)[from];
+}
+
+template <typename T>
+__global__ void copyColumnKernel(
+    Operand* source,
+    int32_t numRows,
+    Operand* target,
+    int32_t offset) {
+  int32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < numRows) {
+    copyValue<T>(source, rowIndex(source, i), target, offset + i);
+  }
+}
+
+template <typename T>
+__global__ void gatherKernel(
+    Operand* source,
+    const int32_t* indices,
+    int32_t numRows,
+    Operand* result) {
+  int32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < numRows) {
+    copyValue<T>(source, indices[i], result, i);
+  }
+}
+
+__global__ void initIndicesKernel(int32_t* indices, int32_t numRows) {
+  int32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < numRows) {
+    indices[i] = i;
+  }
+}
+
+// Returns an unsigned integer with the order of 'value' in the low
+// 8 * sizeof(T) bits.
+template <typename T>
+__device__ inline uint64_t toKey(T value) {
+  if constexpr (std::is_same_v<T, float>) {
+    if (isnan(value)) {
+      value = CUDART_NAN_F;
+    } else if (value == 0) {
+      value = 0;
+    }
+    auto bits = __float_as_uint(value);
+    return (bits & (1U << 31)) ? ~bits : bits | (1U << 31);
+  } else if constexpr (std::is_same_v<T, double>) {
+    if (isnan(value)) {
+      value = CUDART_NAN;
+    } else if (value == 0) {
+      value = 0;
+    }
+    auto bits = static_cast<uint64_t>(__double_as_longlong(value));
+    return (bits & (1ULL << 63)) ? ~bits : bits | (1ULL << 63);
+  } else {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(value) ^ (U(1) << (sizeof(T) * 8 - 1));
+  }
+}
+
+template <typename T>
+__global__ void makeKeysKernel(
+    SortKey key,
+    const int32_t* indices,
+    int32_t numRows,
+    uint64_t* keys) {
+  int32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= numRows) {
+    return;
+  }
+  auto row = indices[i];
+  uint64_t result = 0;
+  if (!isNull(key.operand, row)) {
+    result = toKey(reinterpret_cast<const T*>(key.operand->base)[row]);
+    if (!key.ascending) {
+      result = ~result;
+      if constexpr (sizeof(T) == 4) {
+        result &= 0xffffffff;
+      }
+    }
+  }
+  keys[i] = result;
+}
+
+// Sets 'flags' to 0 for the rows that go first and 1 for the others.
+__global__ void makeFlagsKernel(
+    SortKey key,
+    const int32_t* indices,
+    int32_t numRows,
+    uint8_t* flags) {
+  int32_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < numRows) {
+    flags[i] = isNull(key.operand, indices[i]) != key.nullsFirst;
+  }
+}
+
+template <typename T>
+void makeKeys(
+    Stream& stream,
+    const SortKey& key,
+    int32_t numRows,
+    SortBuffers& buffers) {
+  makeKeysKernel<T>
+      <<<numBlocks(numRows), kBlockSize, 0, stream.stream()->stream>>>(
+          key, buffers.indices[0], numRows, buffers.keys[0]);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+// Sorts 'buffers.indices[0]' by 'keys[0]' and swaps the buffers so that the
+// result is in 'indices[0]'.
+template <typename K>
+void sortPairs(
+    Stream& stream,
+    K** keys,
+    int32_t numRows,
+    int32_t numBits,
+    SortBuffers& buffers) {
+  auto tempBytes = buffers.tempBytes;
+  CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+      buffers.temp,
+      tempBytes,
+      keys[0],
+      keys[1],
+      buffers.indices[0],
+      buffers.indices[1],
+      numRows,
+      0,
+      numBits,
+      stream.stream()->stream));
+  std::swap(keys[0], keys[1]);
+  std::swap(buffers.indices[0], buffers.indices[1]);
+}
+
+} // namespace
+
+size_t sortTempBytes(int32_t numRows) {
+  size_t keyBytes = 0;
+  CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+      nullptr,
+      keyBytes,
+      static_cast<uint64_t*>(nullptr),
+      static_cast<uint64_t*>(nullptr),
+      static_cast<int32_t*>(nullptr),
+      static_cast<int32_t*>(nullptr),
+      numRows));
+  size_t flagBytes = 0;
+  CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+      nullptr,
+      flagBytes,
+      static_cast<uint8_t*>(nullptr),
+      static_cast<uint8_t*>(nullptr),
+      static_cast<int32_t*>(nullptr),
+      static_cast<int32_t*>(nullptr),
+      numRows));
+  return std::max(keyBytes, flagBytes);
+}
+
+void copyColumn(
+    Stream& stream,
+    Operand* source,
+    int32_t numRows,
+    int32_t size,
+    Operand* target,
+    int32_t offset) {
+  auto blocks = numBlocks(numRows);
+  auto cudaStream = stream.stream()->stream;
+  if (size == 4) {
+    copyColumnKernel<int32_t><<<blocks, kBlockSize, 0, cudaStream>>>(
+        source, numRows, target, offset);
+  } else {
+    copyColumnKernel<int64_t><<<blocks, kBlockSize, 0, cudaStream>>>(
+        source, numRows, target, offset);
+  }
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void initIndices(Stream& stream, int32_t numRows, SortBuffers& buffers) {
+  initIndicesKernel<<<
+      numBlocks(numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(buffers.indices[0], numRows);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void sortIndices(
+    Stream& stream,
+    const SortKey& key,
+    int32_t numRows,
+    SortBuffers& buffers) {
+  int32_t numBits = 64;
+  switch (key.kind) {
+    case PhysicalType::kInt32:
+      makeKeys<int32_t>(stream, key, numRows, buffers);
+      numBits = 32;
+      break;
+    case PhysicalType::kFloat32:
+      makeKeys<float>(stream, key, numRows, buffers);
+      numBits = 32;
+      break;
+    case PhysicalType::kFloat64:
+      makeKeys<double>(stream, key, numRows, buffers);
+      break;
+    default:
+      makeKeys<int64_t>(stream, key, numRows, buffers);
+      break;
+  }
+  sortPairs(stream, buffers.keys, numRows, numBits, buffers);
+  if (!key.operand->nulls) {
+    return;
+  }
+  // Null rows have key 0. Moves them first or last, keeping the order of the
+  // non-null rows.
+  makeFlagsKernel<<<
+      numBlocks(numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(
+      key, buffers.indices[0], numRows, buffers.flags[0]);
+  CUDA_CHECK(cudaGetLastError());
+  sortPairs(stream, buffers.flags, numRows, 1, buffers);
+}
+
+void gather(
+    Stream& stream,
+    Operand* source,
+    const int32_t* indices,
+    int32_t numRows,
+    int32_t size,
+    Operand* result) {
+  auto blocks = numBlocks(numRows);
+  auto cudaStream = stream.stream()->stream;
+  if (size == 4) {
+    gatherKernel<int32_t><<<blocks, kBlockSize, 0, cudaStream>>>(
+        source, indices, numRows, result);
+  } else {
+    gatherKernel<int64_t><<<blocks, kBlockSize, 0, cudaStream>>>(
+        source, indices, numRows, result);
+  }
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::sort
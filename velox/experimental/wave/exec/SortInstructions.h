@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/Type.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+/// Kernels for sorting and reordering fixed width columns. Can be included in
+/// both Velox .cpp and .cu.
+namespace facebook::velox::wave::sort {
+
+/// A sorting key column and its order. 'kind' is one of kInt32, kInt64,
+/// kFloat32 and kFloat64.
+struct SortKey {
+  Operand* operand;
+  PhysicalType::Kind kind;
+  bool ascending;
+  bool nullsFirst;
+};
+
+/// Device memory for sortIndices() of up to 'numRows' rows. Allocated by the
+/// caller, with 'tempBytes' = sortTempBytes(numRows).
+struct SortBuffers {
+  uint64_t* keys[2];
+  uint8_t* flags[2];
+  /// The row numbers in sorted order are in 'indices[0]'.
+  int32_t* indices[2];
+  void* temp;
+  size_t tempBytes;
+};
+
+/// Returns the size of the temporary device memory for sortIndices().
+size_t sortTempBytes(int32_t numRows);
+
+/// Copies 'numRows' values of 'size' bytes with their nulls from 'source' to
+/// 'target', starting at row 'offset' of 'target'.
+void copyColumn(
+    Stream& stream,
+    Operand* source,
+    int32_t numRows,
+    int32_t size,
+    Operand* target,
+    int32_t offset);
+
+/// Sets 'buffers.indices[0]' to 0, 1, ... 'numRows' - 1.
+void initIndices(Stream& stream, int32_t numRows, SortBuffers& buffers);
+
+/// Stably sorts 'buffers.indices[0]' by the values of 'key' at the rows in
+/// 'buffers.indices[0]'. Sorting by several keys is done by sorting by each
+/// key from the last to the first. Floating point values are ordered like
+/// Velox: NaN is larger than all other values and -0.0 is equal to 0.0.
+void sortIndices(
+    Stream& stream,
+    const SortKey& key,
+    int32_t numRows,
+    SortBuffers& buffers);
+
+/// Sets rows 0 to 'numRows' - 1 of 'result' to the rows of 'source' at
+/// indices[0] to indices['numRows' - 1]. Values are of 'size' bytes.
+void gather(
+    Stream& stream,
+    Operand* source,
+    const int32_t* indices,
+    int32_t numRows,
+    int32_t size,
+    Operand* result);
+
+} // namespace facebook::velox::wave::sort
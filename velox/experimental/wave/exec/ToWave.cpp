@@ -16,7 +16,11 @@
 
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
+#include "velox/exec/Task.h"
 #include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/HashJoin.h"
+#include "velox/experimental/wave/exec/OrderBy.h"
+#include "velox/experimental/wave/exec/Placement.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/TableScan.h"
 #include "velox/experimental/wave/exec/Values.h"
@@ -438,6 +442,31 @@ bool CompileState::addOperator(
     operators_.push_back(
         std::make_unique<TableScan>(*this, operators_.size(), *scan));
     outputType = scan->outputType();
+  } else if (name == "HashBuild" || name == "HashProbe") {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    VELOX_CHECK_NOT_NULL(node);
+    // The build and probe Drivers decide the same way from the plan. A side
+    // can not run on Wave without the other.
+    if (!isWaveHashJoin(*node) || !reserveMemory()) {
+      return false;
+    }
+    if (name == "HashBuild") {
+      operators_.push_back(std::make_unique<HashBuild>(*this, *node));
+      outputType = ROW({}, {});
+    } else {
+      operators_.push_back(std::make_unique<HashProbe>(*this, *node));
+      outputType = node->outputType();
+    }
+  } else if (name == "OrderBy") {
+    auto* node = dynamic_cast<const core::OrderByNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    VELOX_CHECK_NOT_NULL(node);
+    if (!isWaveOrderBy(*node) || !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<OrderBy>(*this, *node));
+    outputType = node->outputType();
   } else {
     return false;
   }
@@ -457,19 +486,39 @@ bool isProjectedThrough(
   return false;
 }
 
-bool CompileState::compile() {
+void CompileState::addToDevice(
+    const RowTypePtr& inputType,
+    const core::PlanNodeId& id) {
+  reserveMemory();
+  operators_.push_back(std::make_unique<ToDevice>(*this, inputType, id));
+  auto& op = operators_.back();
+  for (auto i = 0; i < inputType->size(); ++i) {
+    auto& name = inputType->nameOf(i);
+    auto operand =
+        op->definesSubfield(*this, inputType->childAt(i), name, true);
+    op->addOutputId(operand->id);
+    definedBy_[Value(toSubfield(name))] = operand;
+    operandOperatorIndex_[operand] = 0;
+  }
+}
+
+bool CompileState::compile(int32_t begin, int32_t end, int32_t nodeIndex) {
   auto operators = driver_.operators();
-  auto& nodes = driverFactory_.planNodes;
 
-  int32_t first = 0;
-  int32_t operatorIndex = 0;
-  int32_t nodeIndex = 0;
+  int32_t first = begin;
+  int32_t operatorIndex = begin;
   RowTypePtr outputType;
   // Make sure operator states are initialized.  We will need to inspect some of
   // them during the transformation.
   driver_.initializeOperators();
   RowTypePtr inputType;
-  for (; operatorIndex < operators.size(); ++operatorIndex) {
+  if (begin > 0) {
+    VELOX_CHECK_GT(nodeIndex, 0);
+    inputType = driverFactory_.planNodes[nodeIndex - 1]->outputType();
+    addToDevice(inputType, operators[begin]->planNodeId());
+    outputType = inputType;
+  }
+  for (; operatorIndex < end; ++operatorIndex) {
     int32_t previousNumOperators = operators_.size();
     auto& identity = operators[operatorIndex]->identityProjections();
     // The columns that are projected through are renamed. They may also get an
@@ -487,11 +536,17 @@ bool CompileState::compile() {
     ++nodeIndex;
     for (auto newIndex = previousNumOperators; newIndex < operators_.size();
          ++newIndex) {
+      // A blocking operator like a hash probe makes new vectors for the
+      // columns that the replaced Operator projects through.
+      bool blocking = !operators_[newIndex]->isStreaming();
+      if (blocking) {
+        identityProjected.clear();
+      }
       for (auto i = 0; i < outputType->size(); ++i) {
         auto& name = outputType->nameOf(i);
         Value value = Value(toSubfield(name));
         int32_t inputChannel;
-        if (isProjectedThrough(identity, i, inputChannel)) {
+        if (!blocking && isProjectedThrough(identity, i, inputChannel)) {
           continue;
         }
         auto operand = operators_[newIndex]->defines(value);
@@ -515,7 +570,7 @@ bool CompileState::compile() {
     }
     inputType = outputType;
   }
-  if (operators_.empty()) {
+  if (operatorIndex == first) {
     return false;
   }
   for (auto& op : operators_) {
@@ -546,15 +601,141 @@ bool CompileState::compile() {
   return true;
 }
 
+namespace {
+bool isWaveExpr(const Expr& expr) {
+  if (dynamic_cast<const exec::FieldReference*>(&expr) ||
+      dynamic_cast<const exec::ConstantExpr*>(&expr)) {
+    return true;
+  }
+  if (dynamic_cast<const exec::SpecialForm*>(&expr) ||
+      !binaryOpCode(expr).has_value() || expr.inputs().size() != 2) {
+    return false;
+  }
+  return isWaveExpr(*expr.inputs()[0]) && isWaveExpr(*expr.inputs()[1]);
+}
+
+// Returns the index in 'nodes' of the first plan node of 'op', or -1 if 'op'
+// does not come from 'nodes', e.g. a consumer added by the DriverFactory.
+int32_t planNodeIndex(
+    const std::vector<core::PlanNodePtr>& nodes,
+    exec::Operator* op) {
+  for (auto i = 0; i < nodes.size(); ++i) {
+    if (nodes[i]->id() != op->planNodeId()) {
+      continue;
+    }
+    // A FilterProject for a filter and a project has the id of the project.
+    if (i > 0 && op->operatorType() == "FilterProject" &&
+        dynamic_cast<const core::ProjectNode*>(nodes[i].get()) &&
+        dynamic_cast<const core::FilterNode*>(nodes[i - 1].get())) {
+      return i - 1;
+    }
+    return i;
+  }
+  return -1;
+}
+
+// Returns true if CompileState::addOperator() converts 'op', whose plan node
+// is 'node'.
+bool isWaveOperator(exec::Operator* op, const core::PlanNode* node) {
+  auto& name = op->operatorType();
+  if (name == "Values" || name == "TableScan" || name == "Aggregation") {
+    return true;
+  }
+  if (name == "FilterProject") {
+    auto data = reinterpret_cast<exec::FilterProject*>(op)
+                    ->exprsAndProjection();
+    for (auto& expr : data.exprs->exprs()) {
+      if (!isWaveExpr(*expr)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (name == "HashBuild" || name == "HashProbe") {
+    auto* join = dynamic_cast<const core::HashJoinNode*>(node);
+    return join && isWaveHashJoin(*join);
+  }
+  if (name == "OrderBy") {
+    auto* orderBy = dynamic_cast<const core::OrderByNode*>(node);
+    return orderBy && isWaveOrderBy(*orderBy);
+  }
+  return false;
+}
+
+bool isFixedWidth(const RowType& type) {
+  for (auto& child : type.children()) {
+    if (!child->isFixedWidth()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Feeds the CPU time of the Operators of completed Tasks to PlacementStats.
+class PlacementTaskListener : public exec::TaskListener {
+ public:
+  void onTaskCompletion(
+      const std::string& /*taskUuid*/,
+      const std::string& /*taskId*/,
+      exec::TaskState state,
+      std::exception_ptr /*error*/,
+      exec::TaskStats stats) override {
+    if (state == exec::TaskState::kFinished) {
+      PlacementStats::instance().recordTaskStats(stats);
+    }
+  }
+};
+} // namespace
+
 bool waveDriverAdapter(
     const exec::DriverFactory& factory,
     exec::Driver& driver) {
-  CompileState state(factory, driver);
-  return state.compile();
+  auto operators = driver.operators();
+  auto& nodes = factory.planNodes;
+  driver.initializeOperators();
+  std::vector<int32_t> nodeIndices(operators.size());
+  std::vector<PlacementInfo> infos(operators.size());
+  for (auto i = 0; i < operators.size(); ++i) {
+    auto* op = operators[i];
+    nodeIndices[i] = planNodeIndex(nodes, op);
+    auto& info = infos[i];
+    info.cost = PlacementStats::instance().cost(op->operatorType());
+    if (nodeIndices[i] < 0) {
+      continue;
+    }
+    auto& node = nodes[nodeIndices[i]];
+    // The output of the Operator is that of the plan node with its id. This
+    // is the project after the filter of a FilterProject.
+    auto& outputNode =
+        node->id() == op->planNodeId() ? node : nodes[nodeIndices[i] + 1];
+    info.supported = isWaveOperator(op, node.get());
+    info.required = op->operatorType() == "HashBuild" ||
+        op->operatorType() == "HashProbe";
+    info.isSource = i == 0;
+    info.outputRowBytes = estimateRowBytes(*outputNode->outputType());
+    if (i > 0) {
+      info.inputRowBytes = infos[i - 1].outputRowBytes;
+      info.canStart = nodeIndices[i] > 0 &&
+          isFixedWidth(*nodes[nodeIndices[i] - 1]->outputType());
+    }
+  }
+  auto batchRows =
+      driver.driverCtx()->queryConfig().preferredOutputBatchRows();
+  auto ranges = placeOnWave(infos, batchRows);
+  // Replaces from last to first so that the indices of the earlier ranges
+  // stay valid.
+  bool changed = false;
+  for (auto it = ranges.rbegin(); it != ranges.rend(); ++it) {
+    CompileState state(factory, driver);
+    changed |= state.compile(it->first, it->second, nodeIndices[it->first]);
+  }
+  return changed;
 }
 
 void registerWave() {
   exec::DriverAdapter waveAdapter{"Wave", {}, waveDriverAdapter};
   exec::DriverFactory::registerAdapter(waveAdapter);
+  static auto listener = std::make_shared<PlacementTaskListener>();
+  exec::registerTaskListener(listener);
 }
 } // namespace facebook::velox::wave
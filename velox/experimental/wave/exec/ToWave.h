@@ -35,9 +35,13 @@ class CompileState {
     return driver_;
   }
 
-  // Replaces sequences of Operators in the Driver given at construction with
-  // Wave equivalents. Returns true if the Driver was changed.
-  bool compile();
+  // Replaces the Operators in [begin, end) of the Driver given at
+  // construction with a WaveDriver. 'nodeIndex' is the index in the
+  // DriverFactory's plan nodes of the Operator at 'begin'. If 'begin' is not
+  // the source of the Driver, the WaveDriver takes the output of the Operator
+  // before 'begin' as input. Stops at the first Operator without a Wave
+  // equivalent. Returns true if the Driver was changed.
+  bool compile(int32_t begin, int32_t end, int32_t nodeIndex);
 
   common::Subfield* toSubfield(const exec::Expr& expr);
 
@@ -91,6 +95,9 @@ class CompileState {
 
   bool reserveMemory();
 
+  // Adds a ToDevice source for the columns of 'inputType'.
+  void addToDevice(const RowTypePtr& inputType, const core::PlanNodeId& id);
+
   // Adds 'instruction' to the suitable program and records the result
   // of the instruction to the right program. The set of programs
   // 'instruction's operands depend is in 'programs'. If 'instruction'
@@ -35,25 +35,21 @@ int32_t Values::canAdvance(WaveStream& stream) {
   return 0;
 }
 
-void Values::schedule(WaveStream& stream, int32_t maxRows) {
-  RowVectorPtr data;
-  if (current_ == values_.size()) {
-    VELOX_CHECK_GE(roundsLeft_, 1);
-    current_ = 1;
-    data = values_[0];
-    --roundsLeft_;
-
-  } else {
-    data = values_[current_++];
-  }
-  VELOX_CHECK_LE(data->size(), maxRows);
-
+namespace {
+// Schedules the copy of 'data' to device as the output of the source
+// operator 'id' with 'outputIds'.
+void scheduleVectors(
+    WaveStream& stream,
+    int32_t id,
+    const RowVectorPtr& data,
+    int32_t numSubfields,
+    const OperandSet& outputIds) {
   std::vector<const BaseVector*> sources;
-  for (auto i = 0; i < subfields_.size(); ++i) {
+  for (auto i = 0; i < numSubfields; ++i) {
     sources.push_back(data->childAt(i).get());
   }
   int32_t counter = 0;
-  outputIds_.forEach([&](auto id) {
+  outputIds.forEach([&](auto id) {
     stream.setNullable(*stream.operandAt(id), sources[counter]->mayHaveNulls());
     ++counter;
   });
@@ -61,13 +57,61 @@ void Values::schedule(WaveStream& stream, int32_t maxRows) {
   auto numBlocks = bits::roundUp(data->size(), kBlockSize) / kBlockSize;
   stream.setNumRows(data->size());
   stream.prepareProgramLaunch(
-      id_, data->size(), empty, numBlocks, nullptr, nullptr);
+      id, data->size(), empty, numBlocks, nullptr, nullptr);
   vectorsToDevice(
-      folly::Range(sources.data(), sources.size()), outputIds_, stream);
+      folly::Range(sources.data(), sources.size()), outputIds, stream);
+}
+} // namespace
+
+void Values::schedule(WaveStream& stream, int32_t maxRows) {
+  RowVectorPtr data;
+  if (current_ == values_.size()) {
+    VELOX_CHECK_GE(roundsLeft_, 1);
+    current_ = 1;
+    data = values_[0];
+    --roundsLeft_;
+
+  } else {
+    data = values_[current_++];
+  }
+  VELOX_CHECK_LE(data->size(), maxRows);
+  scheduleVectors(stream, id_, data, subfields_.size(), outputIds_);
 }
 
 std::string Values::toString() const {
   return "Values";
 }
 
+void ToDevice::addInput(RowVectorPtr input) {
+  VELOX_CHECK(!noMoreInput_);
+  if (input->size() == 0) {
+    return;
+  }
+  // The transfer copies flat buffers. Loads lazies and flattens encodings.
+  std::vector<VectorPtr> children;
+  for (auto& child : input->children()) {
+    children.push_back(BaseVector::loadedVectorShared(child));
+    BaseVector::flattenVector(children.back());
+  }
+  input_.push_back(std::make_shared<RowVector>(
+      input->pool(),
+      input->type(),
+      BufferPtr(nullptr),
+      input->size(),
+      std::move(children)));
+}
+
+void ToDevice::schedule(WaveStream& stream, int32_t maxRows) {
+  VELOX_CHECK(!input_.empty());
+  auto data = std::move(input_.front());
+  input_.pop_front();
+  VELOX_CHECK_LE(data->size(), maxRows);
+  lastSize_ = data->size();
+  scheduleVectors(stream, id_, data, subfields_.size(), outputIds_);
+}
+
+std::string ToDevice::toString() const {
+  return "ToDevice";
+}
+
 } // namespace facebook::velox::wave
@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <deque>
 #include "velox/core/PlanNode.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
@@ -50,4 +51,57 @@ class Values : public WaveSourceOperator {
   size_t roundsLeft_ = 1;
 };
 
+/// Source of a Wave segment that starts in the middle of a Driver. Takes the
+/// output of the preceding CPU Operator from WaveDriver::addInput() and copies
+/// it to device, one batch per WaveStream.
+class ToDevice : public WaveSourceOperator {
+ public:
+  ToDevice(
+      CompileState& state,
+      const RowTypePtr& inputType,
+      const std::string& planNodeId)
+      : WaveSourceOperator(state, inputType, planNodeId) {}
+
+  /// Max number of batches queued for transfer. The next batch is taken from
+  /// the CPU Operator while the previous ones are on device.
+  static constexpr int32_t kMaxQueued = 2;
+
+  bool needsInput() const {
+    return !noMoreInput_ && input_.size() < kMaxQueued;
+  }
+
+  void addInput(RowVectorPtr input);
+
+  void noMoreInput() {
+    noMoreInput_ = true;
+  }
+
+  int32_t canAdvance(WaveStream& stream) override {
+    return input_.empty() ? 0 : input_.front()->size();
+  }
+
+  bool isStreaming() const override {
+    return true;
+  }
+
+  void schedule(WaveStream& stream, int32_t maxRows = 0) override;
+
+  bool isFinished() const override {
+    return noMoreInput_ && input_.empty();
+  }
+
+  vector_size_t outputSize(WaveStream& stream) const override {
+    // Must not be called before schedule().
+    VELOX_CHECK_GT(lastSize_, 0);
+    return lastSize_;
+  }
+
+  std::string toString() const override;
+
+ private:
+  std::deque<RowVectorPtr> input_;
+  bool noMoreInput_{false};
+  vector_size_t lastSize_{0};
+};
+
 } // namespace facebook::velox::wave
@@ -38,6 +38,8 @@ void WaveStats::add(const WaveStats& other) {
   hostOnlyTime += other.hostOnlyTime;
   hostParallelTime += other.hostParallelTime;
   waitTime += other.waitTime;
+  transferTime += other.transferTime;
+  kernelTime += other.kernelTime;
 }
 
 const SubfieldMap*& threadSubfieldMap() {
@@ -251,13 +253,29 @@ void WaveStream::resultToHost() {
 }
 
 namespace {
-// Copies from pageable host to unified address. Multithreaded memcpy is
-// probably best.
-void copyData(std::vector<Transfer>& transfers) {
+// Copies the pageable host sources of 'transfers' into a pinned buffer from
+// 'hostArena' and points the transfers to their copies. Copies from pinned
+// memory are asynchronous and overlap with kernels on other streams, so the
+// transfer for the next batch runs while the previous batch is computed.
+WaveBufferPtr stageTransfers(
+    std::vector<Transfer>& transfers,
+    GpuArena& hostArena) {
+  int64_t size = 0;
+  for (auto& transfer : transfers) {
+    size += bits::roundUp(transfer.size, 8);
+  }
+  if (size == 0) {
+    return nullptr;
+  }
+  auto staging = hostArena.allocate<char>(size);
+  auto* data = staging->as<char>();
   // TODO: Put memcpys or ppieces of them on AsyncSource if large enough.
   for (auto& transfer : transfers) {
-    ::memcpy(transfer.to, transfer.from, transfer.size);
+    ::memcpy(data, transfer.from, transfer.size);
+    transfer.from = data;
+    data += bits::roundUp(transfer.size, 8);
   }
+  return staging;
 }
 } // namespace
 
@@ -277,13 +295,12 @@ void Executable::startTransfer(
   exe->deviceData.push_back(waveStream.arena().allocate<char>(info.totalBytes));
   auto start = exe->deviceData[0]->as<char>();
   exe->operands = waveStream.fillOperands(*exe, start, info)[0];
-  copyData(exe->transfers);
-  auto* device = waveStream.device();
+  exe->staging = stageTransfers(exe->transfers, waveStream.hostArena());
   waveStream.installExecutables(
       folly::Range(&exe, 1),
       [&](Stream* stream, folly::Range<Executable**> executables) {
         for (auto& transfer : executables[0]->transfers) {
-          stream->prefetch(device, transfer.to, transfer.size);
+          stream->hostToDeviceAsync(transfer.to, transfer.from, transfer.size);
           waveStream.stats().bytesToDevice += transfer.size;
         }
         waveStream.markLaunch(*stream, *executables[0]);
@@ -323,6 +340,19 @@ void WaveStream::installExecutables(
     });
   }
 
+  // Brackets 'launch' with timing events for WaveStats::transferTime and
+  // WaveStats::kernelTime.
+  auto timedLaunch = [&](Stream* stream, folly::Range<Executable**> exes) {
+    LaunchTiming timing;
+    timing.start = std::make_unique<Event>(true);
+    timing.end = std::make_unique<Event>(true);
+    timing.isTransfer = !exes[0]->transfers.empty();
+    timing.start->record(*stream);
+    launch(stream, exes);
+    timing.end->record(*stream);
+    launchTimings_.push_back(std::move(timing));
+  };
+
   // exes with no dependences go on a new stream. Streams with dependent compute
   // get an event. The dependent computes go on new streams that first wait for
   // the events.
@@ -332,12 +362,12 @@ void WaveStream::installExecutables(
     std::vector<Stream*> required;
     ids.forEach([&](int32_t id) { required.push_back(streams_[id].get()); });
     if (required.size() == 1) {
-      launch(required[0], exes);
+      timedLaunch(required[0], exes);
       continue;
     }
     if (required.empty()) {
       auto stream = newStream();
-      launch(stream, exes);
+      timedLaunch(stream, exes);
     } else {
       for (auto* req : required) {
         auto id = reinterpret_cast<uintptr_t>(req->userData());
@@ -350,9 +380,25 @@ void WaveStream::installExecutables(
       }
       auto launchStream = newStream();
       ids.forEach([&](int32_t id) { streamEvents[id]->wait(*launchStream); });
-      launch(launchStream, exes);
+      timedLaunch(launchStream, exes);
+    }
+  }
+}
+
+void WaveStream::collectDeviceTimes() {
+  for (auto& timing : launchTimings_) {
+    if (!timing.end->query()) {
+      continue;
+    }
+    WaveTime time;
+    time.micros = timing.end->elapsedTime(*timing.start) * 1000;
+    if (timing.isTransfer) {
+      stats_.transferTime += time;
+    } else {
+      stats_.kernelTime += time;
     }
   }
+  launchTimings_.clear();
 }
 
 bool WaveStream::isArrived(
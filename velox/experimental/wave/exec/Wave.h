@@ -97,6 +97,12 @@ struct WaveStats {
   WaveTime hostParallelTime;
   /// Time a host thread waits for device.
   WaveTime waitTime;
+  /// Device time of host to device copies, measured with events on the
+  /// copying streams. Overlaps with 'kernelTime' of other streams.
+  WaveTime transferTime;
+  /// Device time of kernel launches, measured with events on the launching
+  /// streams.
+  WaveTime kernelTime;
 
   void add(const WaveStats& other);
 };
@@ -268,6 +274,10 @@ struct Executable {
   // If this represents data transfer, the ranges to transfer.
   std::vector<Transfer> transfers;
 
+  // Pinned host memory from which 'transfers' are copied asynchronously.
+  // Must stay live until the copies have arrived.
+  WaveBufferPtr staging;
+
   // The stream on which this is enqueued. Set by
   // WaveStream::installExecutables(). Cleared after the kernel containing this
   // is seen to realize dependent event.
@@ -466,6 +476,12 @@ class WaveStream {
     return arena_;
   }
 
+  /// Pinned host memory for staging host to device copies and for returning
+  /// results to host.
+  GpuArena& hostArena() {
+    return hostArena_;
+  }
+
   /// Sets nullability of a source column. This is runtime, since may depend on
   /// the actual presence of nulls in the source, e.g. file. Nullability
   /// defaults to nullable.
@@ -631,6 +647,10 @@ class WaveStream {
     return stats_;
   }
 
+  /// Adds the device time of the arrived transfers and kernel launches of
+  /// 'this' to stats(). Launches that have not arrived are not counted.
+  void collectDeviceTimes();
+
  private:
   // true if 'op' is nullable in the context of 'this'.
   bool isNullable(const AbstractOperand& op) const;
@@ -676,6 +696,16 @@ class WaveStream {
   // back to reserve from here.
   folly::F14FastSet<Event*> allEvents_;
 
+  // Timing events recorded before and after each launch given to the
+  // callback of installExecutables().
+  struct LaunchTiming {
+    std::unique_ptr<Event> start;
+    std::unique_ptr<Event> end;
+    // True if the launch is a host to device copy.
+    bool isTransfer;
+  };
+  std::vector<LaunchTiming> launchTimings_;
+
   // invocation record with return status blocks for programs. Used for getting
   // errors and filter cardinalities on return of  specific exes.
   folly::F14FastMap<int32_t, std::vector<std::unique_ptr<LaunchControl>>>
@@ -16,6 +16,8 @@
 
 #include "velox/experimental/wave/exec/WaveDriver.h"
 #include "velox/experimental/wave/exec/Instruction.h"
+#include "velox/experimental/wave/exec/Placement.h"
+#include "velox/experimental/wave/exec/Values.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
 namespace facebook::velox::wave {
@@ -30,20 +32,18 @@ WaveDriver::WaveDriver(
     std::vector<OperandId> resultOrder,
     SubfieldMap subfields,
     std::vector<std::unique_ptr<AbstractOperand>> operands)
-    : exec::SourceOperator(
-          driverCtx,
-          outputType,
-          operatorId,
-          planNodeId,
-          "Wave"),
+    : exec::Operator(driverCtx, outputType, operatorId, planNodeId, "Wave"),
       arena_(std::move(arena)),
       resultOrder_(std::move(resultOrder)),
       subfields_(std::move(subfields)),
       operands_(std::move(operands)) {
   VELOX_CHECK(!waveOperators.empty());
-  auto returnBatchSize = 10000 * outputType_->size() * 10;
-  hostArena_ = std::make_unique<GpuArena>(
-      returnBatchSize * 10, getHostAllocator(getDevice()));
+  auto returnBatchSize =
+      10000 * std::max<int32_t>(1, outputType_->size()) * 10;
+  pinnedAllocator_ =
+      std::make_unique<PinnedAllocator>(memory::memoryManager()->allocator());
+  hostArena_ =
+      std::make_unique<GpuArena>(returnBatchSize * 10, pinnedAllocator_.get());
   pipelines_.emplace_back();
   for (auto& op : waveOperators) {
     op->setDriver(this);
@@ -53,6 +53,22 @@ WaveDriver::WaveDriver(
     pipelines_.back().operators.push_back(std::move(op));
   }
   pipelines_.back().needStatus = true;
+  hostInput_ = dynamic_cast<ToDevice*>(pipelines_[0].operators[0].get());
+}
+
+bool WaveDriver::needsInput() const {
+  return hostInput_ && hostInput_->needsInput();
+}
+
+void WaveDriver::addInput(RowVectorPtr input) {
+  VELOX_CHECK_NOT_NULL(hostInput_, "Wave source does not support addInput()");
+  hostInput_->addInput(std::move(input));
+}
+
+void WaveDriver::noMoreInput() {
+  VELOX_CHECK_NOT_NULL(hostInput_, "Wave source does not support addInput()");
+  Operator::noMoreInput();
+  hostInput_->noMoreInput();
 }
 
 RowVectorPtr WaveDriver::getOutput() {
@@ -85,6 +101,7 @@ RowVectorPtr WaveDriver::getOutput() {
           VLOG(1) << "Final output size: " << result->size();
         }
         if (streamAtEnd(*stream)) {
+          stream->collectDeviceTimes();
           waveStats_.add(stream->stats());
           it = streams.erase(it);
         } else {
@@ -96,11 +113,23 @@ RowVectorPtr WaveDriver::getOutput() {
         }
       }
       if (i + 1 < pipelines_.size()) {
-        pipelines_[i + 1].operators[0]->flush(
+        flush(
+            i + 1,
             streams.empty() && pipelines_[i].operators[0]->isFinished());
       }
       running = true;
     }
+    if (!running && blockingFuture_.valid()) {
+      VLOG(1) << "Blocked";
+      return nullptr;
+    }
+    if (!running && hostInput_ && !hostInput_->isFinished()) {
+      VLOG(1) << "Needs input";
+      return nullptr;
+    }
+    if (!running && flushNextPipeline()) {
+      continue;
+    }
     if (!running) {
       VLOG(1) << "No more output";
       updateStats();
@@ -110,6 +139,21 @@ RowVectorPtr WaveDriver::getOutput() {
   }
 }
 
+void WaveDriver::flush(int32_t pipeline, bool noMoreInput) {
+  pipelines_[pipeline].operators[0]->flush(noMoreInput);
+  pipelines_[pipeline].noMoreInput |= noMoreInput;
+}
+
+bool WaveDriver::flushNextPipeline() {
+  for (auto i = 1; i < pipelines_.size(); ++i) {
+    if (!pipelines_[i].noMoreInput) {
+      flush(i, true);
+      return true;
+    }
+  }
+  return false;
+}
+
 bool WaveDriver::streamAtEnd(WaveStream& stream) {
   return true;
 }
@@ -151,8 +195,14 @@ RowVectorPtr WaveDriver::makeResult(
 }
 
 void WaveDriver::startMore() {
+  if (blockingFuture_.valid()) {
+    return;
+  }
   for (int i = 0; i < pipelines_.size(); ++i) {
     auto& ops = pipelines_[i].operators;
+    if (pipelines_[i].streams.size() >= kMaxStreamsPerPipeline) {
+      continue;
+    }
     blockingReason_ = ops[0]->isBlocked(&blockingFuture_);
     if (blockingReason_ != exec::BlockingReason::kNotBlocked) {
       return;
@@ -163,6 +213,9 @@ void WaveDriver::startMore() {
 
     if (auto rows = ops[0]->canAdvance(*stream)) {
       VLOG(1) << "Advance " << rows << " rows in pipeline " << i;
+      if (i == 0) {
+        numInputRows_ += rows;
+      }
       stream->setNumRows(rows);
       if (i == pipelines_.size() - 1) {
         for (auto i : resultOrder_) {
@@ -215,6 +268,17 @@ std::string WaveDriver::toString() const {
 }
 
 void WaveDriver::updateStats() {
+  // Attributes the device time evenly to the replaced Operators for the
+  // placement of later Drivers.
+  if (!cpuOperators_.empty()) {
+    auto nanos = (waveStats_.kernelTime.micros +
+                  waveStats_.transferTime.micros) *
+        1000 / cpuOperators_.size();
+    for (auto& op : cpuOperators_) {
+      PlacementStats::instance().record(
+          op->operatorType(), true, numInputRows_, nanos);
+    }
+  }
   auto lockedStats = stats_.wlock();
   lockedStats->addRuntimeStat(
       "wave.numWaves", RuntimeCounter(waveStats_.numWaves));
@@ -247,6 +311,15 @@ void WaveDriver::updateStats() {
       "wave.waitTime",
       RuntimeCounter(
           waveStats_.waitTime.micros * 1000, RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      "wave.transferTime",
+      RuntimeCounter(
+          waveStats_.transferTime.micros * 1000,
+          RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      "wave.kernelTime",
+      RuntimeCounter(
+          waveStats_.kernelTime.micros * 1000, RuntimeCounter::Unit::kNanos));
 }
 
 } // namespace facebook::velox::wave
@@ -18,11 +18,17 @@
 
 #include "velox/exec/Driver.h"
 #include "velox/exec/Operator.h"
+#include "velox/experimental/wave/common/PinnedAllocator.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
 namespace facebook::velox::wave {
 
-class WaveDriver : public exec::SourceOperator {
+class ToDevice;
+
+/// Runs a range of the Operators of a Driver on Wave. If the range starts at
+/// the Driver's source, 'this' is a source. Otherwise this takes the output of
+/// the previous CPU Operator as input and copies it to device.
+class WaveDriver : public exec::Operator {
  public:
   WaveDriver(
       exec::DriverCtx* driverCtx,
@@ -35,6 +41,12 @@ class WaveDriver : public exec::SourceOperator {
       SubfieldMap subfields,
       std::vector<std::unique_ptr<AbstractOperand>> operands);
 
+  bool needsInput() const override;
+
+  void addInput(RowVectorPtr input) override;
+
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   exec::BlockingReason isBlocked(ContinueFuture* future) override {
@@ -89,6 +101,14 @@ class WaveDriver : public exec::SourceOperator {
   }
 
  private:
+  // Flushes the input of the first operator of 'pipeline'.
+  void flush(int32_t pipeline, bool noMoreInput);
+
+  // Flushes the first pipeline after the first that has not been told there
+  // is no more input. Returns false if there is no such pipeline. Called when
+  // nothing is running, so that the previous pipelines are at end.
+  bool flushNextPipeline();
+
   // True if all output from 'stream' is fetched.
   bool streamAtEnd(WaveStream& stream);
 
@@ -101,6 +121,11 @@ class WaveDriver : public exec::SourceOperator {
       WaveStream& stream,
       const OperandSet& lastSet);
 
+  // Max number of WaveStreams in flight per Pipeline. With two, the host side
+  // staging and copy of the next batch overlap the kernels of the current
+  // batch, while the pinned staging memory stays bounded.
+  static constexpr int32_t kMaxStreamsPerPipeline = 2;
+
   // Starts another WaveStream if the source operator indicates it has more data
   // and there is space in the arena.
   void startMore();
@@ -109,6 +134,9 @@ class WaveDriver : public exec::SourceOperator {
 
   std::unique_ptr<GpuArena> arena_;
   std::unique_ptr<GpuArena> deviceArena_;
+
+  // Pinned host memory from the process MemoryAllocator. Backs 'hostArena_'.
+  std::unique_ptr<PinnedAllocator> pinnedAllocator_;
   std::unique_ptr<GpuArena> hostArena_;
 
   ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
@@ -130,10 +158,19 @@ class WaveDriver : public exec::SourceOperator {
     /// returns vectors to host or if can produce multiple batches of output for
     /// one input.
     bool needStatus{false};
+
+    /// True after the first operator has been flushed with no more input.
+    bool noMoreInput{false};
   };
 
   std::vector<Pipeline> pipelines_;
 
+  // The first WaveOperator if it takes input from a CPU Operator.
+  ToDevice* hostInput_{nullptr};
+
+  // Rows started in the first pipeline. Used for recording per-row costs.
+  int64_t numInputRows_{0};
+
   // The replaced Operators from the Driver. Can be used for a CPU fallback.
   std::vector<std::unique_ptr<exec::Operator>> cpuOperators_;
 
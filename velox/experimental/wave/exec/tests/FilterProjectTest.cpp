@@ -132,3 +132,32 @@ TEST_F(FilterProjectTest, filterProject) {
       std::vector<std::string>{"c0", "c1", "c1 + c0 as s", "c2", "c3"},
       vectors);
 }
+
+TEST_F(FilterProjectTest, waveAfterCpu) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 100, *pool_));
+    makeNotNull(vector, 1000000000);
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  // Multiply has no Wave equivalent. The filter and project after it run in a
+  // WaveDriver that takes the output of the CPU project as input.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0 * 2 as m", "c1"})
+                  .filter("m < 400000000")
+                  .project({"m", "m + c1 as s"})
+                  .planNode();
+  auto task = assertQuery(
+      plan, "SELECT c0 * 2, c0 * 2 + c1 FROM tmp WHERE c0 * 2 < 400000000");
+  // The source may or may not run on Wave. The CPU project is second either
+  // way.
+  auto taskStats = task->taskStats();
+  auto& operatorStats = taskStats.pipelineStats[0].operatorStats;
+  ASSERT_LE(3, operatorStats.size());
+  EXPECT_EQ("FilterProject", operatorStats[1].operatorType);
+  EXPECT_EQ("Wave", operatorStats[2].operatorType);
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+  }
+
+  // Returns 'numKeys' distinct build side keys, each 'numDuplicates' times,
+  // and a payload that identifies the row.
+  RowVectorPtr makeBuild(int32_t numKeys, int32_t numDuplicates) {
+    auto size = numKeys * numDuplicates;
+    return makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(size, [&](auto i) { return i % numKeys; }),
+         makeFlatVector<double>(size, [](auto i) { return i * 0.5; })});
+  }
+};
+
+TEST_F(HashJoinTest, innerJoin) {
+  constexpr int32_t kProbeSize = 1'000;
+  constexpr int32_t kNumKeys = 50;
+  constexpr int32_t kNumDuplicates = 3;
+  auto probe = makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>(kProbeSize, [](auto i) { return i % 100; }),
+       makeFlatVector<int32_t>(kProbeSize, folly::identity)});
+  auto build = makeBuild(kNumKeys, kNumDuplicates);
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"t0", "t1", "u1"})
+                  .planNode();
+
+  std::vector<int64_t> keys;
+  std::vector<int32_t> probeValues;
+  std::vector<double> buildValues;
+  for (auto i = 0; i < kProbeSize; ++i) {
+    auto key = i % 100;
+    if (key >= kNumKeys) {
+      continue;
+    }
+    for (auto j = 0; j < kNumDuplicates; ++j) {
+      keys.push_back(key);
+      probeValues.push_back(i);
+      buildValues.push_back((key + j * kNumKeys) * 0.5);
+    }
+  }
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>(keys),
+       makeFlatVector<int32_t>(probeValues),
+       makeFlatVector<double>(buildValues)});
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+TEST_F(HashJoinTest, nullKeys) {
+  auto probe = makeRowVector(
+      {"t0", "t1"},
+      {makeNullableFlatVector<int64_t>({0, std::nullopt, 2, 3, std::nullopt}),
+       makeFlatVector<int64_t>({10, 11, 12, 13, 14})});
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {makeNullableFlatVector<int64_t>({std::nullopt, 2, 0, 5}),
+       makeNullableFlatVector<int64_t>({100, std::nullopt, 102, 103})});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"t1", "u1"})
+                  .planNode();
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>({10, 12}),
+       makeNullableFlatVector<int64_t>({102, std::nullopt})});
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+TEST_F(HashJoinTest, joinAggregation) {
+  constexpr int32_t kProbeSize = 10'000;
+  constexpr int32_t kNumKeys = 10;
+  auto probe = makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>(kProbeSize, [](auto i) { return i % 20; }),
+       makeFlatVector<int64_t>(kProbeSize, [](auto i) { return i % 7; })});
+  auto build = makeBuild(kNumKeys, 2);
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe}, false, 3)
+                  .filter("t1 < 5")
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"t0", "u1"})
+                  .singleAggregation({"t0"}, {"sum(u1)", "count(u1)"})
+                  .planNode();
+
+  std::vector<double> sums(kNumKeys);
+  std::vector<int64_t> counts(kNumKeys);
+  for (auto i = 0; i < kProbeSize; ++i) {
+    auto key = i % 20;
+    if (i % 7 >= 5 || key >= kNumKeys) {
+      continue;
+    }
+    for (auto j = 0; j < 2; ++j) {
+      sums[key] += 3 * (key + j * kNumKeys) * 0.5;
+      counts[key] += 3;
+    }
+  }
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>(kNumKeys, folly::identity),
+       makeFlatVector<double>(sums),
+       makeFlatVector<int64_t>(counts)});
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+} // namespace
+} // namespace facebook::velox::wave
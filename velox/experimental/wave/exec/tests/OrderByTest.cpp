@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class OrderByTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+  }
+};
+
+TEST_F(OrderByTest, singleKey) {
+  constexpr int32_t kSize = 1'000;
+  auto vector = makeRowVector(
+      {makeFlatVector<int64_t>(
+           kSize, [](auto i) { return (i * 7919) % kSize; }),
+       makeFlatVector<double>(kSize, [](auto i) { return -i; })});
+  auto plan = PlanBuilder()
+                  .values({vector}, false, 40)
+                  .orderBy({"c0 DESC"}, false)
+                  .planNode();
+  auto result = AssertQueryBuilder(plan).copyResults(pool());
+  ASSERT_EQ(result->size(), kSize * 40);
+  auto keys = result->childAt(0)->asFlatVector<int64_t>();
+  for (auto i = 0; i < result->size(); ++i) {
+    ASSERT_EQ(keys->valueAt(i), kSize - 1 - i / 40) << i;
+  }
+}
+
+TEST_F(OrderByTest, multipleKeysWithNulls) {
+  auto vector = makeRowVector({
+      makeNullableFlatVector<int32_t>(
+          {2, std::nullopt, 1, 2, 1, std::nullopt, 2}),
+      makeNullableFlatVector<double>(
+          {0.5, 1.0, std::nullopt, -0.5, 3.0, -1.0, std::nan("")}),
+      makeFlatVector<int64_t>({0, 1, 2, 3, 4, 5, 6}),
+  });
+  auto plan = PlanBuilder()
+                  .values({vector})
+                  .orderBy({"c0 ASC NULLS LAST", "c1 DESC NULLS FIRST"}, false)
+                  .planNode();
+  auto expected = makeRowVector({
+      makeNullableFlatVector<int32_t>(
+          {1, 1, 2, 2, 2, std::nullopt, std::nullopt}),
+      makeNullableFlatVector<double>(
+          {std::nullopt, 3.0, std::nan(""), 0.5, -0.5, 1.0, -1.0}),
+      makeFlatVector<int64_t>({2, 4, 6, 0, 3, 1, 5}),
+  });
+  auto result = AssertQueryBuilder(plan).copyResults(pool());
+  assertEqualVectors(expected, result);
+}
+
+} // namespace
+} // namespace facebook::velox::wave
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include "velox/experimental/wave/exec/Placement.h"
+
+DECLARE_double(velox_wave_launch_nanos);
+DECLARE_double(velox_wave_transfer_byte_nanos);
+
+using namespace facebook::velox::wave;
+
+namespace {
+
+using Ranges = std::vector<std::pair<int32_t, int32_t>>;
+
+constexpr int32_t kBatchRows = 10'000;
+
+class PlacementTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    // Placement depends on the cost flags, fix them for the test.
+    FLAGS_velox_wave_launch_nanos = 5'000;
+    FLAGS_velox_wave_transfer_byte_nanos = 0.1;
+  }
+
+  static PlacementInfo cpuOnly(double cpuNanosPerRow, bool isSource = false) {
+    PlacementInfo info;
+    info.isSource = isSource;
+    info.cost = {cpuNanosPerRow, 0};
+    info.inputRowBytes = 8;
+    info.outputRowBytes = 8;
+    return info;
+  }
+
+  static PlacementInfo supported(
+      double cpuNanosPerRow,
+      double waveNanosPerRow,
+      int32_t rowBytes = 8) {
+    PlacementInfo info;
+    info.supported = true;
+    info.canStart = true;
+    info.cost = {cpuNanosPerRow, waveNanosPerRow};
+    info.inputRowBytes = rowBytes;
+    info.outputRowBytes = rowBytes;
+    return info;
+  }
+
+  gflags::FlagSaver flagSaver_;
+};
+
+TEST_F(PlacementTest, empty) {
+  EXPECT_EQ(placeOnWave({}, kBatchRows), Ranges{});
+}
+
+TEST_F(PlacementTest, rangeStartsMidDriver) {
+  // A CPU source followed by 2 operators that are much faster on Wave and a
+  // CPU sink. The Wave range starts after the source.
+  std::vector<PlacementInfo> infos = {
+      cpuOnly(10, true), supported(100, 1), supported(100, 1), cpuOnly(10)};
+  EXPECT_EQ(placeOnWave(infos, kBatchRows), (Ranges{{1, 3}}));
+
+  // The same operators after a Wave source run in one range from the source.
+  infos[0] = supported(10, 1);
+  infos[0].isSource = true;
+  EXPECT_EQ(placeOnWave(infos, kBatchRows), (Ranges{{0, 3}}));
+}
+
+TEST_F(PlacementTest, requiredHashJoin) {
+  // A HashBuild whose probe is on Wave must be on Wave even if its source is
+  // as fast on CPU. Starting the range at the source saves the copy to device.
+  auto source = supported(1, 1);
+  source.isSource = true;
+  auto build = supported(1, 1);
+  build.required = true;
+  EXPECT_EQ(placeOnWave({source, build}, kBatchRows), (Ranges{{0, 2}}));
+
+  // Without 'required' the cheap operators stay on CPU.
+  build.required = false;
+  EXPECT_EQ(placeOnWave({source, build}, kBatchRows), Ranges{});
+
+  // A required HashProbe after a CPU source starts the range. The cheap
+  // operator after it ends the range since it is faster on CPU than the
+  // launch on Wave.
+  auto probe = supported(1, 1);
+  probe.required = true;
+  EXPECT_EQ(
+      placeOnWave({cpuOnly(10, true), probe, supported(1, 1)}, kBatchRows),
+      (Ranges{{1, 2}}));
+}
+
+TEST_F(PlacementTest, unsupported) {
+  auto source = supported(100, 1);
+  source.isSource = true;
+  // An unsupported operator splits the Wave operators in 2 ranges. Being
+  // required has no effect on an unsupported operator.
+  auto unsupported = cpuOnly(10);
+  unsupported.required = true;
+  std::vector<PlacementInfo> infos = {
+      source,
+      supported(100, 1),
+      unsupported,
+      supported(100, 1),
+      supported(100, 1)};
+  EXPECT_EQ(placeOnWave(infos, kBatchRows), (Ranges{{0, 2}, {3, 5}}));
+
+  // An operator whose input can not be copied to device can not start a range
+  // after an unsupported operator, so the second range starts after it.
+  infos[3].canStart = false;
+  EXPECT_EQ(placeOnWave(infos, kBatchRows), (Ranges{{0, 2}, {4, 5}}));
+}
+
+TEST_F(PlacementTest, transferCost) {
+  // 10x faster on Wave and the copies to and from device are cheap for narrow
+  // rows.
+  std::vector<PlacementInfo> infos = {
+      cpuOnly(10, true), supported(100, 10), cpuOnly(10)};
+  EXPECT_EQ(placeOnWave(infos, kBatchRows), (Ranges{{1, 2}}));
+
+  // Copying wide rows to device and back costs more than the speedup.
+  infos[0].outputRowBytes = 10'000;
+  infos[1] = supported(100, 10, 10'000);
+  EXPECT_EQ(placeOnWave(infos, kBatchRows), Ranges{});
+
+  // A faster transfer makes Wave worth it again.
+  FLAGS_velox_wave_transfer_byte_nanos = 0.001;
+  EXPECT_EQ(placeOnWave(infos, kBatchRows), (Ranges{{1, 2}}));
+}
+
+} // namespace
@@ -32,6 +32,20 @@ BooleanMix refineBooleanMixNonNull(
   }
   return BooleanMix::kMixNonNull;
 }
+
+// Sets '*raw' to space for 'size' bits in 'buffer' or, if 'buffer' is
+// nullptr, in the scratch arena of 'context'.
+void ensureBits(
+    vector_size_t size,
+    EvalCtx& context,
+    BufferPtr* buffer,
+    uint64_t** raw) {
+  if (buffer == nullptr) {
+    *raw = context.scratchArena().allocate<uint64_t>(bits::nwords(size));
+    return;
+  }
+  BaseVector::ensureBuffer<bool>(size, context.pool(), buffer, raw);
+}
 } // namespace
 
 // Return a BooleanMix representing the status of boolean values in vector. If
@@ -60,8 +74,7 @@ BooleanMix getFlatBool(
       auto nulls = vector->rawNulls();
       if (nulls && mergeNullsToValues) {
         uint64_t* mergedValues;
-        BaseVector::ensureBuffer<bool>(
-            size, context.pool(), tempValues, &mergedValues);
+        ensureBits(size, context, tempValues, &mergedValues);
 
         // NOTE: false bit in 'nulls' indicate null.
         bits::andBits(
@@ -95,12 +108,10 @@ BooleanMix getFlatBool(
       uint64_t* nullsToSet = nullptr;
       uint64_t* valuesToSet = nullptr;
       if (vector->mayHaveNulls() && !mergeNullsToValues) {
-        BaseVector::ensureBuffer<bool>(
-            size, context.pool(), tempNulls, &nullsToSet);
+        ensureBits(size, context, tempNulls, &nullsToSet);
         memset(nullsToSet, bits::kNotNullByte, bits::nbytes(size));
       }
-      BaseVector::ensureBuffer<bool>(
-          size, context.pool(), tempValues, &valuesToSet);
+      ensureBits(size, context, tempValues, &valuesToSet);
       memset(valuesToSet, 0, bits::nbytes(size));
       DecodedVector decoded(*vector, activeRows);
       auto values = decoded.data<uint64_t>();
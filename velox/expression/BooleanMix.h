@@ -21,6 +21,10 @@ namespace facebook::velox::exec {
 
 enum class BooleanMix { kAllTrue, kAllFalse, kAllNull, kMixNonNull, kMix };
 
+/// Returns the BooleanMix of 'vector' in 'activeRows'. Flattened values and
+/// nulls are written into 'tempValues' and 'tempNulls'. If these are nullptr,
+/// the flattened bits are allocated from context.scratchArena() instead and
+/// stay valid until 'context' is destroyed.
 BooleanMix getFlatBool(
     BaseVector* vector,
     const SelectivityVector& activeRows,
@@ -326,7 +326,7 @@ void propagateErrorsOrSetNulls(
     bool setNullInResultAtError,
     EvalCtx& context,
     const SelectivityVector& nestedRows,
-    const BufferPtr& elementToTopLevelRows,
+    const vector_size_t* elementToTopLevelRows,
     VectorPtr& result,
     EvalErrorsPtr& oldErrors) {
   if (context.errors()) {
@@ -367,12 +367,13 @@ VectorPtr CastExpr::applyMap(
   auto mapValues = input->mapValues();
 
   SelectivityVector nestedRows;
-  BufferPtr elementToTopLevelRows;
+  const vector_size_t* elementToTopLevelRows = nullptr;
   if (fromType.keyType() != toType.keyType() ||
       fromType.valueType() != toType.valueType()) {
     nestedRows = functions::toElementRows(mapKeys->size(), rows, input);
+    // The mapping is only used to propagate errors below.
     elementToTopLevelRows = functions::getElementToTopLevelRows(
-        mapKeys->size(), rows, input, context.pool());
+        mapKeys->size(), rows, input, context.scratchArena());
   }
 
   EvalErrorsPtr oldErrors;
@@ -467,8 +468,8 @@ VectorPtr CastExpr::applyArray(
 
   auto nestedRows =
       functions::toElementRows(arrayElements->size(), rows, input);
-  auto elementToTopLevelRows = functions::getElementToTopLevelRows(
-      arrayElements->size(), rows, input, context.pool());
+  auto* elementToTopLevelRows = functions::getElementToTopLevelRows(
+      arrayElements->size(), rows, input, context.scratchArena());
 
   EvalErrorsPtr oldErrors;
   context.swapErrors(oldErrors);
@@ -179,22 +179,24 @@ void ConjunctExpr::evalSpecialForm(
 }
 
 void ConjunctExpr::maybeReorderInputs() {
-  bool reorder = false;
-  for (auto i = 1; i < inputs_.size(); ++i) {
-    if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
-        selectivity_[inputOrder_[i]].timeToDropValue()) {
-      reorder = true;
-      break;
+  // Inputs are reordered only within runs of deterministic inputs so that a
+  // non-deterministic input sees the same rows as in the written order.
+  auto byTimeToDropValue = [this](int32_t left, int32_t right) {
+    return selectivity_[left].timeToDropValue() <
+        selectivity_[right].timeToDropValue();
+  };
+  int32_t runStart = 0;
+  for (auto i = 0; i <= inputs_.size(); ++i) {
+    if (i < inputs_.size() && inputs_[inputOrder_[i]]->isDeterministic()) {
+      continue;
     }
-  }
-  if (reorder) {
-    std::sort(
-        inputOrder_.begin(),
-        inputOrder_.end(),
-        [this](size_t left, size_t right) {
-          return selectivity_[left].timeToDropValue() <
-              selectivity_[right].timeToDropValue();
-        });
+    auto begin = inputOrder_.begin() + runStart;
+    auto end = inputOrder_.begin() + i;
+    if (!std::is_sorted(begin, end, byTimeToDropValue)) {
+      // Stable to keep the written order of inputs with the same cost.
+      std::stable_sort(begin, end, byTimeToDropValue);
+    }
+    runStart = i + 1;
   }
 }
 
@@ -64,6 +64,11 @@ class ConjunctExpr : public SpecialForm {
     return selectivity_[inputOrder_[index]];
   }
 
+  /// The indices of the inputs in the order of evaluation.
+  const std::vector<int32_t>& inputOrder() const {
+    return inputOrder_;
+  }
+
   std::string toSql(
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
@@ -74,6 +79,9 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
+  // Orders deterministic inputs by the time they take to decide the result
+  // of a row. Called after each batch if adaptive filter reordering is
+  // enabled.
   void maybeReorderInputs();
 
   void updateResult(
@@ -35,7 +35,8 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx, ExprSet* exprSet, const RowVector* row)
               ? execCtx->queryCtx()
                     ->queryConfig()
                     .maxSharedSubexprResultsCached()
-              : core::QueryConfig({}).maxSharedSubexprResultsCached()) {
+              : core::QueryConfig({}).maxSharedSubexprResultsCached()),
+      scratchArenaMark_(execCtx->scratchArena().mark()) {
   // TODO Change the API to replace raw pointers with non-const references.
   // Sanity check inputs to prevent crashes.
   VELOX_CHECK_NOT_NULL(execCtx);
@@ -62,10 +63,19 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx)
               ? execCtx->queryCtx()
                     ->queryConfig()
                     .maxSharedSubexprResultsCached()
-              : core::QueryConfig({}).maxSharedSubexprResultsCached()) {
+              : core::QueryConfig({}).maxSharedSubexprResultsCached()),
+      scratchArenaMark_(execCtx->scratchArena().mark()) {
   VELOX_CHECK_NOT_NULL(execCtx);
 }
 
+EvalCtx::~EvalCtx() {
+  if (scratchArenaMark_.isStart()) {
+    execCtx_->scratchArena().reset();
+  } else {
+    execCtx_->scratchArena().rewind(scratchArenaMark_);
+  }
+}
+
 void EvalCtx::saveAndReset(ContextSaver& saver, const SelectivityVector& rows) {
   if (saver.context) {
     return;
@@ -247,22 +257,20 @@ void EvalCtx::setErrors(
 
 void EvalCtx::addElementErrorsToTopLevel(
     const SelectivityVector& elementRows,
-    const BufferPtr& elementToTopLevelRows,
+    const vector_size_t* elementToTopLevelRows,
     EvalErrorsPtr& topLevelErrors) {
   if (!errors_) {
     return;
   }
 
-  const auto* rawElementToTopLevelRows =
-      elementToTopLevelRows->as<vector_size_t>();
   elementRows.applyToSelected([&](auto row) {
-    copyError(*errors_, row, topLevelErrors, rawElementToTopLevelRows[row]);
+    copyError(*errors_, row, topLevelErrors, elementToTopLevelRows[row]);
   });
 }
 
 void EvalCtx::convertElementErrorsToTopLevelNulls(
     const SelectivityVector& elementRows,
-    const BufferPtr& elementToTopLevelRows,
+    const vector_size_t* elementToTopLevelRows,
     VectorPtr& result) {
   if (!errors_) {
     return;
@@ -270,11 +278,9 @@ void EvalCtx::convertElementErrorsToTopLevelNulls(
 
   auto rawNulls = result->mutableRawNulls();
 
-  const auto* rawElementToTopLevelRows =
-      elementToTopLevelRows->as<vector_size_t>();
   elementRows.applyToSelected([&](auto row) {
     if (errors_->hasErrorAt(row)) {
-      bits::setNull(rawNulls, rawElementToTopLevelRows[row], true);
+      bits::setNull(rawNulls, elementToTopLevelRows[row], true);
     }
   });
 }
@@ -224,6 +224,10 @@ class EvalCtx {
   /// For testing only.
   explicit EvalCtx(core::ExecCtx* execCtx);
 
+  /// Releases the allocations made from scratchArena() during the lifetime of
+  /// 'this'.
+  ~EvalCtx();
+
   const RowVector* row() const {
     return row_;
   }
@@ -326,6 +330,18 @@ class EvalCtx {
   void addElementErrorsToTopLevel(
       const SelectivityVector& elementRows,
       const BufferPtr& elementToTopLevelRows,
+      EvalErrorsPtr& topLevelErrors) {
+    addElementErrorsToTopLevel(
+        elementRows,
+        elementToTopLevelRows->as<vector_size_t>(),
+        topLevelErrors);
+  }
+
+  /// Like above, but with the mapping in a raw array, e.g. one allocated from
+  /// scratchArena().
+  void addElementErrorsToTopLevel(
+      const SelectivityVector& elementRows,
+      const vector_size_t* elementToTopLevelRows,
       EvalErrorsPtr& topLevelErrors);
 
   // Given a mapping from element rows to top-level rows, set errors in
@@ -333,6 +349,15 @@ class EvalCtx {
   void convertElementErrorsToTopLevelNulls(
       const SelectivityVector& elementRows,
       const BufferPtr& elementToTopLevelRows,
+      VectorPtr& result) {
+    convertElementErrorsToTopLevelNulls(
+        elementRows, elementToTopLevelRows->as<vector_size_t>(), result);
+  }
+
+  /// Like above, but with the mapping in a raw array.
+  void convertElementErrorsToTopLevelNulls(
+      const SelectivityVector& elementRows,
+      const vector_size_t* elementToTopLevelRows,
       VectorPtr& result);
 
   void deselectErrors(SelectivityVector& rows) const;
@@ -492,6 +517,13 @@ class EvalCtx {
     return execCtx_->releaseVectors(vectors);
   }
 
+  /// Returns the arena for temporaries that do not outlive the evaluation,
+  /// e.g. row numbers or flattened bits. The allocations are not accounted in
+  /// pool() and are released when 'this' is destroyed.
+  ScratchArena& scratchArena() const {
+    return execCtx_->scratchArena();
+  }
+
   /// Makes 'result' writable for 'rows'. Allocates or reuses a vector from the
   /// pool of 'execCtx_' if needed.
   void ensureWritable(
@@ -518,6 +550,17 @@ class EvalCtx {
     return maxSharedSubexprResultsCached_;
   }
 
+  /// Returns true if the current batch is sampled for profiling. Expressions
+  /// then record CPU time and decoding overhead as if
+  /// QueryConfig.exprTrackCpuUsage() was set.
+  bool profiling() const {
+    return profiling_;
+  }
+
+  void setProfiling(bool profiling) {
+    profiling_ = profiling;
+  }
+
  private:
   void ensureErrorsVectorSize(EvalErrorsPtr& errors, vector_size_t size) const;
 
@@ -539,6 +582,8 @@ class EvalCtx {
   const RowVector* row_;
   const bool cacheEnabled_;
   const uint32_t maxSharedSubexprResultsCached_;
+  // Position of the scratch arena of 'execCtx_' at construction.
+  const ScratchArena::Mark scratchArenaMark_;
   bool inputFlatNoNulls_;
 
   // Corresponds 1:1 to children of 'row_'. Set to an inner vector
@@ -557,6 +602,8 @@ class EvalCtx {
 
   bool captureErrorDetails_{true};
 
+  bool profiling_{false};
+
   // True if the current set of rows will not grow, e.g. not under and IF or OR.
   bool isFinalSelection_{true};
 
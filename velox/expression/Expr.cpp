@@ -1060,6 +1060,7 @@ void Expr::evalEncodings(
         LocalSelectivityVector newRowsHolder(context);
         LocalSelectivityVector finalRowsHolder(context);
         LocalDecodedVector decodedHolder(context);
+        auto timer = peelTimer(context);
         auto peelEncodingsResult = peelEncodings(
             context,
             saveContext,
@@ -1067,6 +1068,7 @@ void Expr::evalEncodings(
             decodedHolder,
             newRowsHolder,
             finalRowsHolder);
+        timer.reset();
         auto* newRows = peelEncodingsResult.newRows;
         if (newRows) {
           VectorPtr peeledResult;
@@ -1076,6 +1078,8 @@ void Expr::evalEncodings(
           if (newRows->hasSelections()) {
             if (peelEncodingsResult.mayCache) {
               evalWithMemo(*newRows, context, peeledResult);
+            } else if (valueCache_ && context.cacheEnabled()) {
+              evalWithValueCache(*newRows, context, peeledResult);
             } else {
               evalWithNulls(*newRows, context, peeledResult);
             }
@@ -1091,6 +1095,10 @@ void Expr::evalEncodings(
       }
     }
   }
+  if (valueCache_ && context.cacheEnabled()) {
+    evalWithValueCache(rows, context, result);
+    return;
+  }
   evalWithNulls(rows, context, result);
 }
 
@@ -1264,6 +1272,82 @@ void Expr::evalWithMemo(
   context.releaseVector(base);
 }
 
+bool Expr::supportsValueCache() const {
+  if (specialForm_ || !vectorFunction_ || !deterministic_ ||
+      distinctFields_.size() != 1 || !type()->isPrimitiveType()) {
+    return false;
+  }
+  const auto& fieldType = distinctFields_[0]->type();
+  return fieldType->kind() == TypeKind::VARCHAR ||
+      fieldType->kind() == TypeKind::VARBINARY;
+}
+
+void Expr::enableValueCache(uint32_t maxEntries, uint64_t maxBytes) {
+  VELOX_CHECK(supportsValueCache(), "Cannot cache the results of {}", name_);
+  valueCache_ = std::make_unique<ExprValueCache>(maxEntries, maxBytes);
+}
+
+void Expr::evalWithValueCache(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  VectorPtr input;
+  distinctFields_[0]->evalSpecialForm(rows, context, input);
+  LocalDecodedVector decodedHolder(context, *input, rows);
+  auto* decoded = decodedHolder.get();
+  valueCache_->initialize(type(), context.pool());
+  const auto& values = valueCache_->values();
+
+  LocalSelectivityVector uncachedHolder(context, rows);
+  auto* uncached = uncachedHolder.get();
+  bool ensuredWritable = false;
+  uint64_t numHits = 0;
+  rows.applyToSelected([&](vector_size_t row) {
+    if (decoded->isNullAt(row)) {
+      return;
+    }
+    const auto value = decoded->valueAt<StringView>(row);
+    const auto cachedRow =
+        valueCache_->find(std::string_view(value.data(), value.size()));
+    if (!cachedRow.has_value()) {
+      return;
+    }
+    if (!ensuredWritable) {
+      context.ensureWritable(rows, type(), result);
+      ensuredWritable = true;
+    }
+    result->copy(values.get(), row, cachedRow.value(), 1);
+    uncached->setValid(row, false);
+    ++numHits;
+  });
+  uncached->updateBounds();
+  stats_.numValueCacheHits += numHits;
+
+  if (uncached->hasSelections()) {
+    // Keep the cached rows copied into 'result' above.
+    ScopedFinalSelectionSetter scopedFinalSelectionSetter(
+        context, &rows, numHits > 0);
+
+    evalWithNulls(*uncached, context, result);
+    context.deselectErrors(*uncached);
+    context.exprSet()->addToMemo(this);
+    uncached->applyToSelected([&](vector_size_t row) {
+      if (decoded->isNullAt(row)) {
+        return;
+      }
+      ++stats_.numValueCacheMisses;
+      const auto value = decoded->valueAt<StringView>(row);
+      const auto cachedRow =
+          valueCache_->insert(std::string_view(value.data(), value.size()));
+      if (cachedRow.has_value()) {
+        values->copy(result.get(), cachedRow.value(), row, 1);
+      }
+    });
+    valueCache_->checkSize();
+  }
+  context.releaseVector(input);
+}
+
 void Expr::setAllNulls(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1353,6 +1437,7 @@ inline bool isPeelable(VectorEncoding::Simple encoding) {
   switch (encoding) {
     case VectorEncoding::Simple::CONSTANT:
     case VectorEncoding::Simple::DICTIONARY:
+    case VectorEncoding::Simple::SEQUENCE:
       return true;
     default:
       return false;
@@ -1498,13 +1583,14 @@ void Expr::applyFunction(
     VectorPtr& result) {
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
-  auto timer = cpuWallTimer();
+  auto timer = cpuWallTimer(context);
 
   computeIsAsciiForInputs(vectorFunction_.get(), inputValues_, rows);
   auto isAscii = type()->isVarchar()
       ? computeIsAsciiForResult(vectorFunction_.get(), inputValues_, rows)
       : std::nullopt;
 
+  const bool hadResult = result != nullptr;
   try {
     vectorFunction_->apply(rows, inputValues_, type(), context, result);
   } catch (const VeloxException&) {
@@ -1512,6 +1598,9 @@ void Expr::applyFunction(
   } catch (const std::exception& e) {
     VELOX_USER_FAIL(e.what());
   }
+  if (!hadResult && result != nullptr) {
+    ++stats_.numAllocatedVectors;
+  }
 
   if (!result) {
     MutableRemainingRows remainingRows(rows, context);
@@ -1546,7 +1635,7 @@ void Expr::evalSpecialFormWithStats(
     VectorPtr& result) {
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
-  auto timer = cpuWallTimer();
+  auto timer = cpuWallTimer(context);
 
   evalSpecialForm(rows, context, result);
 }
@@ -1739,7 +1828,11 @@ ExprSet::ExprSet(
     const std::vector<core::TypedExprPtr>& sources,
     core::ExecCtx* execCtx,
     bool enableConstantFolding)
-    : execCtx_(execCtx) {
+    : execCtx_(execCtx),
+      profileSamplingInterval_(
+          execCtx->queryCtx()
+              ? execCtx->queryCtx()->queryConfig().exprProfileSamplingInterval()
+              : 0) {
   exprs_ = compileExpressions(sources, execCtx, this, enableConstantFolding);
   std::vector<FieldReference*> allDistinctFields;
   for (auto& expr : exprs_) {
@@ -1786,6 +1879,63 @@ std::unordered_map<std::string, exec::ExprStats> ExprSet::stats() const {
   return stats;
 }
 
+namespace {
+void addNodeStats(
+    const exec::Expr& expr,
+    uint32_t depth,
+    std::vector<ExprNodeStats>& stats,
+    std::unordered_set<const exec::Expr*>& uniqueExprs) {
+  ExprNodeStats node;
+  node.name = expr.name();
+  node.depth = depth;
+  if (!uniqueExprs.insert(&expr).second) {
+    // Common sub-expression. Skip to avoid double counting.
+    node.isDuplicate = true;
+    stats.push_back(std::move(node));
+    return;
+  }
+  node.stats = expr.stats();
+  stats.push_back(std::move(node));
+  for (const auto& input : expr.inputs()) {
+    addNodeStats(*input, depth + 1, stats, uniqueExprs);
+  }
+}
+} // namespace
+
+std::vector<ExprNodeStats> ExprSet::statsTree() const {
+  std::vector<ExprNodeStats> stats;
+  std::unordered_set<const exec::Expr*> uniqueExprs;
+  for (const auto& expr : exprs()) {
+    addNodeStats(*expr, 0, stats, uniqueExprs);
+  }
+  return stats;
+}
+
+std::string printExprNodeStats(
+    const std::vector<ExprNodeStats>& stats,
+    const std::string& indentation) {
+  std::stringstream out;
+  for (auto i = 0; i < stats.size(); ++i) {
+    const auto& node = stats[i];
+    if (i > 0) {
+      out << std::endl;
+    }
+    out << indentation << std::string(3 * node.depth, ' ') << node.name;
+    if (node.isDuplicate) {
+      out << " [CSE]";
+      continue;
+    }
+    const auto& nodeStats = node.stats;
+    out << " [cpu time: " << succinctNanos(nodeStats.timing.cpuNanos)
+        << ", rows: " << nodeStats.numProcessedRows
+        << ", batches: " << nodeStats.numProcessedVectors
+        << ", timed batches: " << nodeStats.numTimedVectors
+        << ", peel cpu time: " << succinctNanos(nodeStats.peelTiming.cpuNanos)
+        << ", allocated vectors: " << nodeStats.numAllocatedVectors << "]";
+  }
+  return out.str();
+}
+
 ExprSet::~ExprSet() {
   exprSetListeners().withRLock([&](auto& listeners) {
     if (!listeners.empty()) {
@@ -1884,7 +2034,10 @@ void ExprSet::eval(
   result.resize(exprs_.size());
   if (initialize) {
     clearSharedSubexprs();
+    profileBatch_ = profileSamplingInterval_ > 0 &&
+        numBatches_++ % profileSamplingInterval_ == 0;
   }
+  context.setProfiling(profileBatch_);
 
   // Make sure LazyVectors, referenced by multiple expressions, are loaded
   // for all the "rows".
@@ -25,6 +25,8 @@
 #include "velox/core/Expressions.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/expression/EvalCtx.h"
+#include "velox/expression/ExprStats.h"
+#include "velox/expression/ExprValueCache.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Subfield.h"
 #include "velox/vector/SimpleVector.h"
@@ -48,32 +50,6 @@ class ExprSet;
 class FieldReference;
 class VectorFunction;
 
-struct ExprStats {
-  /// Requires QueryConfig.exprTrackCpuUsage() to be 'true'.
-  CpuWallTiming timing;
-
-  /// Number of processed rows.
-  uint64_t numProcessedRows{0};
-
-  /// Number of processed vectors / batches. Allows to compute average batch
-  /// size.
-  uint64_t numProcessedVectors{0};
-
-  void add(const ExprStats& other) {
-    timing.add(other.timing);
-    numProcessedRows += other.numProcessedRows;
-    numProcessedVectors += other.numProcessedVectors;
-  }
-
-  std::string toString() const {
-    return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
-        timing.toString(),
-        numProcessedRows,
-        numProcessedVectors);
-  }
-};
-
 /// Maintains a set of rows for evaluation and removes rows with
 /// nulls or errors as needed. Helps to avoid copying SelectivityVector in cases
 /// when evaluation doesn't encounter nulls or errors.
@@ -257,6 +233,23 @@ class Expr {
     baseOfDictionaryRawPtr_ = nullptr;
     dictionaryCache_ = nullptr;
     cachedDictionaryIndices_ = nullptr;
+    if (valueCache_) {
+      valueCache_->clear();
+    }
+  }
+
+  /// True if the results of 'this' can be cached across batches by the value
+  /// of its input, i.e. 'this' is a deterministic function call that depends
+  /// only on one string column and returns a primitive type.
+  bool supportsValueCache() const;
+
+  /// Caches the results for up to 'maxEntries' distinct values of the input
+  /// column across batches. The cache is cleared when the results retain
+  /// more than 'maxBytes'.
+  void enableValueCache(uint32_t maxEntries, uint64_t maxBytes);
+
+  const ExprValueCache* valueCache() const {
+    return valueCache_.get();
   }
 
   const TypePtr& type() const {
@@ -328,6 +321,12 @@ class Expr {
     return distinctFields_;
   }
 
+  // True if this or a sub-expression is an IF, AND or OR. If false, eval()
+  // loads all 'distinctFields()' for all its rows before evaluating.
+  bool hasConditionals() const {
+    return hasConditionals_;
+  }
+
   static bool isSameFields(
       const std::vector<FieldReference*>& fields1,
       const std::vector<FieldReference*>& fields2);
@@ -428,6 +427,14 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Copies the cached results for the values of the input column and
+  // evaluates the remaining rows with evalWithNulls(), adding their results to
+  // 'valueCache_'.
+  void evalWithValueCache(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
   void evalWithNulls(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -546,9 +553,18 @@ class Expr {
 
   /// Returns an instance of CpuWallTimer if cpu usage tracking is enabled. Null
   /// otherwise.
-  std::unique_ptr<CpuWallTimer> cpuWallTimer() {
-    return trackCpuUsage_ ? std::make_unique<CpuWallTimer>(stats_.timing)
-                          : nullptr;
+  std::unique_ptr<CpuWallTimer> cpuWallTimer(const EvalCtx& context) {
+    if (!trackCpuUsage_ && !context.profiling()) {
+      return nullptr;
+    }
+    ++stats_.numTimedVectors;
+    return std::make_unique<CpuWallTimer>(stats_.timing);
+  }
+
+  std::unique_ptr<CpuWallTimer> peelTimer(const EvalCtx& context) {
+    return (trackCpuUsage_ || context.profiling())
+        ? std::make_unique<CpuWallTimer>(stats_.peelTiming)
+        : nullptr;
   }
 
   // Should be called only after computeMetadata() has been called on 'inputs_'.
@@ -638,6 +654,10 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // Results by the value of the single input column, kept across batches. Set
+  // by enableValueCache().
+  std::unique_ptr<ExprValueCache> valueCache_;
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
@@ -737,6 +757,10 @@ class ExprSet {
   /// evaluated.
   std::unordered_map<std::string, exec::ExprStats> stats() const;
 
+  /// Returns evaluation statistics for each node of the expression trees in
+  /// pre-order. Unlike stats(), keeps the calls of the same function apart.
+  std::vector<ExprNodeStats> statsTree() const;
+
  protected:
   void clearSharedSubexprs();
 
@@ -755,6 +779,16 @@ class ExprSet {
   // Exprs which retain memoized state, e.g. from running over dictionaries.
   std::unordered_set<Expr*> memoizingExprs_;
   core::ExecCtx* const execCtx_;
+
+  // Profile every so many batches. 0 if sampling is disabled. See
+  // QueryConfig::kExprProfileSamplingInterval.
+  const uint32_t profileSamplingInterval_;
+
+  // Number of batches evaluated so far. Used for sampling.
+  uint64_t numBatches_{0};
+
+  // True if the current batch is sampled.
+  bool profileBatch_{false};
 };
 
 class ExprSetSimplified : public ExprSet {
@@ -21,6 +21,7 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -85,6 +86,11 @@ struct Scope {
 
   std::vector<TypedExprPtr> rewrittenExpressions;
 
+  // Compiled calls of commutative functions keyed on the name and the compiled
+  // inputs, so that a call with swapped inputs reuses the first one.
+  std::map<std::tuple<std::string, const Expr*, const Expr*>, ExprPtr>
+      commutativeCalls;
+
   Scope(std::vector<std::string>&& _locals, Scope* _parent, ExprSet* _exprSet)
       : locals(_locals), parent(_parent), exprSet(_exprSet) {}
 
@@ -162,6 +168,27 @@ ExprPtr getAlreadyCompiled(const ITypedExpr* expr, ExprDedupMap* visited) {
   return iter == visited->end() ? nullptr : iter->second;
 }
 
+// Marks 'expr' as a common subexpression that is reset between batches.
+void setMultiplyReferenced(const ExprPtr& expr, Scope* scope) {
+  if (!expr->isMultiplyReferenced()) {
+    scope->exprSet->addToReset(expr);
+    expr->setMultiplyReferenced();
+    // A property of this expression changed, namely isMultiplyReferenced_,
+    // that affects metadata, so we re-compute it.
+    expr->clearMetaData();
+    expr->computeMetadata();
+  }
+}
+
+// Returns true if 'expr' is a deterministic call of a commutative function
+// with two inputs of the same type.
+bool isCommutativeCall(const Expr& expr) {
+  const auto& metadata = expr.vectorFunctionMetadata();
+  return !expr.isSpecialForm() && expr.inputs().size() == 2 &&
+      metadata.commutative && metadata.deterministic &&
+      expr.inputs()[0]->type()->equivalent(*expr.inputs()[1]->type());
+}
+
 ExprPtr compileExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -365,14 +392,7 @@ ExprPtr compileRewrittenExpression(
     bool enableConstantFolding) {
   ExprPtr alreadyCompiled = getAlreadyCompiled(expr.get(), &scope->visited);
   if (alreadyCompiled) {
-    if (!alreadyCompiled->isMultiplyReferenced()) {
-      scope->exprSet->addToReset(alreadyCompiled);
-      alreadyCompiled->setMultiplyReferenced();
-      // A property of this expression changed, namely isMultiplyReferenced_,
-      // that affects metadata, so we re-compute it.
-      alreadyCompiled->clearMetaData();
-      alreadyCompiled->computeMetadata();
-    }
+    setMultiplyReferenced(alreadyCompiled, scope);
     return alreadyCompiled;
   }
 
@@ -508,16 +528,103 @@ ExprPtr compileRewrittenExpression(
     VELOX_UNSUPPORTED("Unknown typed expression");
   }
 
+  // f(b, a) of a commutative f is the same as an already compiled f(a, b).
+  std::optional<std::tuple<std::string, const Expr*, const Expr*>>
+      commutativeKey;
+  if (dynamic_cast<const core::CallTypedExpr*>(expr.get()) &&
+      isCommutativeCall(*result)) {
+    const auto& inputs = result->inputs();
+    auto it = scope->commutativeCalls.find(
+        {result->name(), inputs[1].get(), inputs[0].get()});
+    if (it != scope->commutativeCalls.end() &&
+        *it->second->type() == *result->type()) {
+      setMultiplyReferenced(it->second, scope);
+      scope->visited[expr.get()] = it->second;
+      return it->second;
+    }
+    commutativeKey.emplace(result->name(), inputs[0].get(), inputs[1].get());
+  }
+
   result->computeMetadata();
 
   // If the expression is constant folding it is redundant.
   auto folded = enableConstantFolding && !isConstantExpr
       ? tryFoldIfConstant(result, scope)
       : result;
+  if (config.exprFusedKernelsEnabled() && !folded->is<ConstantExpr>()) {
+    if (auto fused = FusedExpr::tryFuse(folded, trackCpuUsage)) {
+      folded = std::move(fused);
+    }
+  }
   scope->visited[expr.get()] = folded;
+  if (commutativeKey.has_value()) {
+    scope->commutativeCalls[*commutativeKey] = folded;
+  }
   return folded;
 }
 
+// Returns the width in bytes of TINYINT, SMALLINT, INTEGER and BIGINT, 0 for
+// other types, including logical types such as DATE.
+int32_t integerWidth(const TypePtr& type) {
+  if (*type == *TINYINT()) {
+    return 1;
+  }
+  if (*type == *SMALLINT()) {
+    return 2;
+  }
+  if (*type == *INTEGER()) {
+    return 4;
+  }
+  if (*type == *BIGINT()) {
+    return 8;
+  }
+  return 0;
+}
+
+// Rewrites cast(cast(x AS t1) AS t2) into cast(x AS t2) when both produce
+// the same values, so that the chain runs as one conversion, over the peeled
+// base of a dictionary input, without intermediate vectors. x must be an
+// integer and the inner cast must keep its value, i.e. widen it to a larger
+// integer or format it as a varchar that the outer cast parses back into a
+// number. Returns nullptr if 'expr' is not such a chain.
+TypedExprPtr fuseCastChain(const TypedExprPtr& expr) {
+  auto* outer = dynamic_cast<const core::CastTypedExpr*>(expr.get());
+  if (outer == nullptr) {
+    return nullptr;
+  }
+  const auto& toType = outer->type();
+  const bool toNumber = integerWidth(toType) > 0 || toType->isReal() ||
+      toType->isDouble();
+  const bool toScalar =
+      toNumber || toType->isVarchar() || toType->isBoolean();
+
+  auto input = outer->inputs()[0];
+  bool fused = false;
+  while (auto* inner = dynamic_cast<const core::CastTypedExpr*>(input.get())) {
+    const auto fromWidth = integerWidth(inner->inputs()[0]->type());
+    if (fromWidth == 0) {
+      break;
+    }
+    const auto& viaType = inner->type();
+    const bool widening = integerWidth(viaType) >= fromWidth && toScalar;
+    const bool viaVarchar = viaType->isVarchar() && toNumber;
+    if (!widening && !viaVarchar) {
+      break;
+    }
+    input = inner->inputs()[0];
+    fused = true;
+  }
+
+  if (!fused) {
+    return nullptr;
+  }
+  if (*input->type() == *toType) {
+    return input;
+  }
+  return std::make_shared<core::CastTypedExpr>(
+      toType, input, outer->nullOnFailure());
+}
+
 ExprPtr compileExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -526,6 +633,9 @@ ExprPtr compileExpression(
     const std::unordered_set<std::string>& flatteningCandidates,
     bool enableConstantFolding) {
   auto rewritten = rewriteExpression(expr);
+  if (auto fused = fuseCastChain(rewritten)) {
+    rewritten = fused;
+  }
   if (rewritten.get() != expr.get()) {
     scope->rewrittenExpressions.push_back(rewritten);
   }
@@ -574,6 +684,21 @@ std::unordered_set<std::string> collectFlatteningCandidates(
     return flatteningCandidates;
   });
 }
+
+// Enables the cache of results across batches on the topmost expressions that
+// support it. Caching a subtree of a cached expression would be redundant.
+void enableValueCaches(const ExprPtr& expr, const core::QueryConfig& config) {
+  if (expr->supportsValueCache()) {
+    if (!expr->valueCache()) {
+      expr->enableValueCache(
+          config.exprValueCacheMaxEntries(), config.exprValueCacheMaxBytes());
+    }
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    enableValueCaches(input, config);
+  }
+}
 } // namespace
 
 std::vector<std::shared_ptr<Expr>> compileExpressions(
@@ -598,6 +723,13 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
         flatteningCandidates,
         enableConstantFolding));
   }
+
+  const auto& config = execCtx->queryCtx()->queryConfig();
+  if (config.exprValueCacheMaxEntries() > 0) {
+    for (const auto& expr : exprs) {
+      enableValueCaches(expr, config);
+    }
+  }
   return exprs;
 }
 
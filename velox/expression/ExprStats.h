@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <fmt/format.h>
+
+#include <string>
+#include <vector>
+
+#include "velox/common/time/CpuWallTimer.h"
+
+namespace facebook::velox::exec {
+
+struct ExprStats {
+  /// Requires QueryConfig.exprTrackCpuUsage() to be 'true' or
+  /// QueryConfig.exprProfileSamplingInterval() to be > 0.
+  CpuWallTiming timing;
+
+  /// Number of processed rows.
+  uint64_t numProcessedRows{0};
+
+  /// Number of processed vectors / batches. Allows to compute average batch
+  /// size.
+  uint64_t numProcessedVectors{0};
+
+  /// Number of rows whose result was found in the cache of results across
+  /// batches. See QueryConfig::kExprValueCacheMaxEntries.
+  uint64_t numValueCacheHits{0};
+
+  /// Number of rows that were evaluated and added to the cache of results
+  /// across batches.
+  uint64_t numValueCacheMisses{0};
+
+  /// Time spent peeling the encodings of the inputs. Recorded only for the
+  /// batches that are timed.
+  CpuWallTiming peelTiming;
+
+  /// Number of batches for which 'timing' was recorded. Equals
+  /// numProcessedVectors if QueryConfig.exprTrackCpuUsage() is 'true'.
+  /// Otherwise, 'timing' covers only the batches sampled because of
+  /// QueryConfig.exprProfileSamplingInterval().
+  uint64_t numTimedVectors{0};
+
+  /// Number of times a function allocated a new result vector instead of
+  /// writing into an existing one.
+  uint64_t numAllocatedVectors{0};
+
+  void add(const ExprStats& other) {
+    timing.add(other.timing);
+    peelTiming.add(other.peelTiming);
+    numTimedVectors += other.numTimedVectors;
+    numAllocatedVectors += other.numAllocatedVectors;
+    numProcessedRows += other.numProcessedRows;
+    numProcessedVectors += other.numProcessedVectors;
+    numValueCacheHits += other.numValueCacheHits;
+    numValueCacheMisses += other.numValueCacheMisses;
+  }
+
+  std::string toString() const {
+    return fmt::format(
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numValueCacheHits: {}, numValueCacheMisses: {}, peelTiming: {}, "
+        "numTimedVectors: {}, numAllocatedVectors: {}",
+        timing.toString(),
+        numProcessedRows,
+        numProcessedVectors,
+        numValueCacheHits,
+        numValueCacheMisses,
+        peelTiming.toString(),
+        numTimedVectors,
+        numAllocatedVectors);
+  }
+};
+
+/// Statistics of one node of a compiled expression tree. A tree is
+/// represented as a list of nodes in pre-order, each with its depth.
+struct ExprNodeStats {
+  /// Name of the function or special form, e.g. 'plus' or 'cast'.
+  std::string name;
+
+  /// Depth of the node. Top-level expressions have depth 0.
+  uint32_t depth{0};
+
+  /// True if the node is a common subexpression that appears earlier in the
+  /// tree. The statistics are only reported for the first occurrence and the
+  /// inputs of the node are omitted.
+  bool isDuplicate{false};
+
+  ExprStats stats;
+};
+
+/// Adds the statistics of 'other' to 'stats' node by node. Trees of different
+/// shape, e.g. from expressions compiled differently, are not merged. If
+/// 'stats' is empty, copies 'other'.
+inline void addExprNodeStats(
+    std::vector<ExprNodeStats>& stats,
+    const std::vector<ExprNodeStats>& other) {
+  if (stats.empty()) {
+    stats = other;
+    return;
+  }
+  if (stats.size() != other.size()) {
+    return;
+  }
+  for (auto i = 0; i < stats.size(); ++i) {
+    if (stats[i].name != other[i].name || stats[i].depth != other[i].depth) {
+      return;
+    }
+  }
+  for (auto i = 0; i < stats.size(); ++i) {
+    stats[i].stats.add(other[i].stats);
+  }
+}
+
+/// Returns a tree of expression nodes with their statistics, one node per
+/// line, each line prefixed with 'indentation'.
+std::string printExprNodeStats(
+    const std::vector<ExprNodeStats>& stats,
+    const std::string& indentation);
+
+} // namespace facebook::velox::exec
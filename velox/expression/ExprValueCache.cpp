@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/ExprValueCache.h"
+
+namespace facebook::velox::exec {
+
+ExprValueCache::ExprValueCache(uint32_t maxEntries, uint64_t maxBytes)
+    : maxEntries_(maxEntries), maxBytes_(maxBytes) {
+  VELOX_CHECK_GT(maxEntries_, 0);
+}
+
+void ExprValueCache::initialize(
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  if (values_ == nullptr) {
+    values_ = BaseVector::create(type, maxEntries_, pool);
+    resetEntries();
+  }
+}
+
+std::optional<vector_size_t> ExprValueCache::find(std::string_view key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->row;
+}
+
+std::optional<vector_size_t> ExprValueCache::insert(std::string_view key) {
+  if (key.size() > kMaxKeySize || entries_.count(key) > 0) {
+    return std::nullopt;
+  }
+  vector_size_t row;
+  if (!freeRows_.empty()) {
+    row = freeRows_.back();
+    freeRows_.pop_back();
+  } else {
+    auto& last = lru_.back();
+    row = last.row;
+    entries_.erase(std::string_view(last.key));
+    lru_.pop_back();
+  }
+  lru_.push_front(Entry{std::string(key), row});
+  entries_.emplace(std::string_view(lru_.front().key), lru_.begin());
+  return row;
+}
+
+void ExprValueCache::checkSize() {
+  if (values_ != nullptr && values_->retainedSize() > maxBytes_) {
+    // Dropping the vector releases the string buffers shared with the inputs.
+    clear();
+  }
+}
+
+void ExprValueCache::clear() {
+  values_.reset();
+  resetEntries();
+}
+
+void ExprValueCache::resetEntries() {
+  entries_.clear();
+  lru_.clear();
+  freeRows_.resize(maxEntries_);
+  for (auto i = 0; i < maxEntries_; ++i) {
+    freeRows_[i] = maxEntries_ - 1 - i;
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <list>
+#include <optional>
+#include <string_view>
+
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::exec {
+
+/// LRU cache of the results of a deterministic expression over a single
+/// string column, keyed by the value of the column. Unlike the memo of
+/// dictionary encoded inputs, the cache is kept across batches with
+/// different base vectors. The results are kept in a vector allocated from
+/// the memory pool of the evaluation, one row per cached value. Not thread
+/// safe.
+class ExprValueCache {
+ public:
+  /// Values longer than this are not cached.
+  static constexpr size_t kMaxKeySize = 256;
+
+  ExprValueCache(uint32_t maxEntries, uint64_t maxBytes);
+
+  /// Makes sure that the vector of results exists.
+  void initialize(const TypePtr& type, memory::MemoryPool* pool);
+
+  /// Returns the row of 'key' in values() and marks it as most recently used.
+  std::optional<vector_size_t> find(std::string_view key);
+
+  /// Adds 'key' and returns the row in values() that its result must be
+  /// copied to. Evicts the least recently used value if the cache is full.
+  /// Returns std::nullopt if 'key' is already cached or too long.
+  std::optional<vector_size_t> insert(std::string_view key);
+
+  /// Clears the cache if the results retain more than the maximum size.
+  void checkSize();
+
+  /// Drops all values and the vector of results.
+  void clear();
+
+  const VectorPtr& values() const {
+    return values_;
+  }
+
+  size_t size() const {
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    vector_size_t row;
+  };
+
+  void resetEntries();
+
+  const uint32_t maxEntries_;
+  const uint64_t maxBytes_;
+
+  // Most recently used first.
+  std::list<Entry> lru_;
+
+  // Maps a key to its entry. The key points to Entry::key.
+  folly::F14FastMap<std::string_view, std::list<Entry>::iterator> entries_;
+
+  // Rows in 'values_' that are not used by an entry.
+  std::vector<vector_size_t> freeRows_;
+
+  VectorPtr values_;
+};
+
+} // namespace facebook::velox::exec
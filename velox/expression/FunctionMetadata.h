@@ -40,6 +40,11 @@ struct VectorFunctionMetadata {
   /// In this case, 'rows' in VectorFunction::apply will point only to positions
   /// for which all arguments are not null.
   bool defaultNullBehavior{true};
+
+  /// True if the function of two arguments of the same type returns the same
+  /// result for swapped arguments, e.g. plus(a, b) and plus(b, a). Calls that
+  /// differ only by the order of such arguments are evaluated once.
+  bool commutative{false};
 };
 
 class VectorFunctionMetadataBuilder {
@@ -59,6 +64,11 @@ class VectorFunctionMetadataBuilder {
     return *this;
   }
 
+  VectorFunctionMetadataBuilder& commutative(bool commutative) {
+    metadata_.commutative = commutative;
+    return *this;
+  }
+
   const VectorFunctionMetadata& build() const {
     return metadata_;
   }
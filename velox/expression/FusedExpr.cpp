@@ -0,0 +1,546 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedExpr.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+#include "velox/expression/FunctionSignature.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+using FusedFunctionMap = folly::F14FastMap<
+    std::string,
+    std::vector<std::pair<TypePtr, FusedOp>>>;
+
+folly::Synchronized<FusedFunctionMap>& fusedFunctions() {
+  static folly::Synchronized<FusedFunctionMap> functions;
+  return functions;
+}
+
+bool isComparison(FusedOp op) {
+  switch (op) {
+    case FusedOp::kEq:
+    case FusedOp::kNeq:
+    case FusedOp::kLt:
+    case FusedOp::kLte:
+    case FusedOp::kGt:
+    case FusedOp::kGte:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int32_t numArgs(FusedOp op) {
+  return op == FusedOp::kNegate ? 1 : 2;
+}
+
+bool isSupportedKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int32_t kindWidth(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return 1;
+    case TypeKind::SMALLINT:
+      return 2;
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+      return 4;
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      return 8;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename Func>
+void dispatchKind(TypeKind kind, Func&& func) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      func(int8_t{});
+      break;
+    case TypeKind::SMALLINT:
+      func(int16_t{});
+      break;
+    case TypeKind::INTEGER:
+      func(int32_t{});
+      break;
+    case TypeKind::BIGINT:
+      func(int64_t{});
+      break;
+    case TypeKind::REAL:
+      func(float{});
+      break;
+    case TypeKind::DOUBLE:
+      func(double{});
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+void arithmetic(FusedOp op, const T* a, const T* b, T* out, int32_t size) {
+  switch (op) {
+    case FusedOp::kPlus:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] + b[i];
+      }
+      break;
+    case FusedOp::kMinus:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] - b[i];
+      }
+      break;
+    case FusedOp::kMultiply:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] * b[i];
+      }
+      break;
+    case FusedOp::kDivide:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] / b[i];
+      }
+      break;
+    case FusedOp::kNegate:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = -a[i];
+      }
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+void compare(FusedOp op, const T* a, const T* b, uint8_t* out, int32_t size) {
+  switch (op) {
+    case FusedOp::kEq:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] == b[i];
+      }
+      break;
+    case FusedOp::kNeq:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] != b[i];
+      }
+      break;
+    case FusedOp::kLt:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] < b[i];
+      }
+      break;
+    case FusedOp::kLte:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] <= b[i];
+      }
+      break;
+    case FusedOp::kGt:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] > b[i];
+      }
+      break;
+    case FusedOp::kGte:
+      for (auto i = 0; i < size; ++i) {
+        out[i] = a[i] >= b[i];
+      }
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Builds the program of a FusedExpr from an Expr tree.
+class FusedExprBuilder {
+ public:
+  // Returns the operand that holds the value of 'expr' or std::nullopt if
+  // 'expr' cannot be fused.
+  std::optional<FusedExpr::Operand> add(const ExprPtr& expr, bool isRoot) {
+    if (auto* fused = expr->as<FusedExpr>()) {
+      return add(fused->source(), isRoot);
+    }
+    if (!isRoot) {
+      if (expr->is<FieldReference>()) {
+        return addField(expr);
+      }
+      if (expr->is<ConstantExpr>()) {
+        return addConstant(*expr->as<ConstantExpr>());
+      }
+    }
+    return addCall(expr, isRoot);
+  }
+
+  int32_t numCalls() const {
+    return program_.size();
+  }
+
+  std::vector<ExprPtr> fields_;
+  std::vector<FusedExpr::Instruction> program_;
+  std::vector<std::vector<int64_t>> constants_;
+
+ private:
+  std::optional<FusedExpr::Operand> addField(const ExprPtr& expr) {
+    // Only top level columns.
+    if (!expr->inputs().empty() || !isSupportedKind(expr->type()->kind())) {
+      return std::nullopt;
+    }
+    for (auto i = 0; i < fields_.size(); ++i) {
+      if (fields_[i].get() == expr.get()) {
+        return FusedExpr::Operand{FusedExpr::Operand::Kind::kInput, i};
+      }
+    }
+    fields_.push_back(expr);
+    return FusedExpr::Operand{
+        FusedExpr::Operand::Kind::kInput,
+        static_cast<int32_t>(fields_.size() - 1)};
+  }
+
+  std::optional<FusedExpr::Operand> addConstant(const ConstantExpr& expr) {
+    const auto& value = expr.value();
+    const auto kind = value->typeKind();
+    if (!isSupportedKind(kind) || value->isNullAt(0)) {
+      return std::nullopt;
+    }
+    std::vector<int64_t> block(FusedExpr::kBlockSize);
+    dispatchKind(kind, [&](auto dummy) {
+      using T = decltype(dummy);
+      const auto constant = value->as<SimpleVector<T>>()->valueAt(0);
+      std::fill_n(
+          reinterpret_cast<T*>(block.data()), FusedExpr::kBlockSize, constant);
+    });
+    constants_.push_back(std::move(block));
+    return FusedExpr::Operand{
+        FusedExpr::Operand::Kind::kConstant,
+        static_cast<int32_t>(constants_.size() - 1)};
+  }
+
+  std::optional<FusedExpr::Operand> addCall(const ExprPtr& expr, bool isRoot) {
+    const auto& inputs = expr->inputs();
+    if (expr->isSpecialForm() || expr->vectorFunction() == nullptr ||
+        !expr->isDeterministic() || inputs.empty() || inputs.size() > 2) {
+      return std::nullopt;
+    }
+    const auto& argType = inputs[0]->type();
+    for (const auto& input : inputs) {
+      if (*input->type() != *argType) {
+        return std::nullopt;
+      }
+    }
+    const auto op = fusedFunctionOp(expr->name(), argType);
+    if (!op.has_value() || numArgs(op.value()) != inputs.size()) {
+      return std::nullopt;
+    }
+    if (isComparison(op.value())) {
+      // A boolean can only be the result.
+      if (!isRoot || expr->type()->kind() != TypeKind::BOOLEAN) {
+        return std::nullopt;
+      }
+    } else if (*expr->type() != *argType) {
+      return std::nullopt;
+    }
+
+    FusedExpr::Instruction instruction{
+        op.value(), argType->kind(), static_cast<int32_t>(inputs.size())};
+    for (auto i = 0; i < inputs.size(); ++i) {
+      auto arg = add(inputs[i], false);
+      if (!arg.has_value()) {
+        return std::nullopt;
+      }
+      instruction.args[i] = arg.value();
+    }
+    instruction.result = program_.size();
+    program_.push_back(instruction);
+    return FusedExpr::Operand{
+        FusedExpr::Operand::Kind::kTemp, instruction.result};
+  }
+};
+
+} // namespace
+
+void registerFusedFunction(
+    const std::string& name,
+    FusedOp op,
+    const std::vector<TypePtr>& types) {
+  auto functions = fusedFunctions().wlock();
+  auto& entries = (*functions)[sanitizeName(name)];
+  for (const auto& type : types) {
+    VELOX_CHECK(
+        isSupportedKind(type->kind()),
+        "Fused kernels do not support {}",
+        type->toString());
+    // Integer arithmetic can overflow or divide by zero, which the functions
+    // of the engines report as errors.
+    VELOX_CHECK(
+        isComparison(op) || type->kind() == TypeKind::REAL ||
+            type->kind() == TypeKind::DOUBLE,
+        "Fused arithmetic is only supported for floating point types: {}",
+        type->toString());
+    auto it = std::find_if(entries.begin(), entries.end(), [&](auto& entry) {
+      return *entry.first == *type;
+    });
+    if (it != entries.end()) {
+      it->second = op;
+    } else {
+      entries.emplace_back(type, op);
+    }
+  }
+}
+
+std::optional<FusedOp> fusedFunctionOp(
+    const std::string& name,
+    const TypePtr& type) {
+  auto functions = fusedFunctions().rlock();
+  auto it = functions->find(sanitizeName(name));
+  if (it == functions->end()) {
+    return std::nullopt;
+  }
+  for (const auto& [registeredType, op] : it->second) {
+    if (*registeredType == *type) {
+      return op;
+    }
+  }
+  return std::nullopt;
+}
+
+FusedExpr::FusedExpr(
+    TypePtr type,
+    std::vector<ExprPtr>&& fields,
+    ExprPtr source,
+    std::vector<Instruction>&& program,
+    std::vector<std::vector<int64_t>>&& constants,
+    bool trackCpuUsage)
+    : SpecialForm(
+          std::move(type),
+          std::move(fields),
+          "fused",
+          false /* supportsFlatNoNullsFastPath */,
+          trackCpuUsage),
+      source_(std::move(source)),
+      program_(std::move(program)),
+      constants_(std::move(constants)),
+      temps_(program_.size() * kBlockSize) {}
+
+// static
+ExprPtr FusedExpr::tryFuse(const ExprPtr& expr, bool trackCpuUsage) {
+  if (expr->is<FusedExpr>()) {
+    return nullptr;
+  }
+  FusedExprBuilder builder;
+  if (!builder.add(expr, true).has_value() || builder.numCalls() < 2) {
+    return nullptr;
+  }
+  auto fused = std::shared_ptr<FusedExpr>(new FusedExpr(
+      expr->type(),
+      std::move(builder.fields_),
+      expr,
+      std::move(builder.program_),
+      std::move(builder.constants_),
+      trackCpuUsage));
+  fused->computeMetadata();
+  return fused;
+}
+
+void FusedExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  inputValues_.resize(inputs_.size());
+  std::vector<const void*> rawInputs(inputs_.size());
+  bool allFlat = true;
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputs_[i]->eval(rows, context, inputValues_[i]);
+    if (!inputValues_[i]->isFlatEncoding()) {
+      allFlat = false;
+      break;
+    }
+    rawInputs[i] = inputValues_[i]->valuesAsVoid();
+  }
+  if (!allFlat) {
+    context.releaseVectors(inputValues_);
+    inputValues_.clear();
+    ++numFallbacks_;
+    source_->eval(rows, context, result);
+    return;
+  }
+
+  context.ensureWritable(rows, type(), result);
+  auto* rawResult = result->values()->asMutable<char>();
+  for (auto begin = rows.begin(); begin < rows.end(); begin += kBlockSize) {
+    evalBlock(
+        rows,
+        begin,
+        std::min(begin + kBlockSize, rows.end()),
+        rawInputs,
+        rawResult);
+  }
+  setNulls(rows, inputValues_, *result);
+  context.releaseVectors(inputValues_);
+  inputValues_.clear();
+}
+
+void FusedExpr::evalSpecialFormSimplified(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  source_->evalSimplified(rows, context, result);
+}
+
+const void* FusedExpr::operandValues(
+    const Operand& operand,
+    TypeKind kind,
+    vector_size_t begin,
+    const std::vector<const void*>& inputValues) const {
+  switch (operand.kind) {
+    case Operand::Kind::kInput:
+      return static_cast<const char*>(inputValues[operand.index]) +
+          static_cast<int64_t>(begin) * kindWidth(kind);
+    case Operand::Kind::kConstant:
+      return constants_[operand.index].data();
+    case Operand::Kind::kTemp:
+      return temps_.data() + operand.index * kBlockSize;
+  }
+  VELOX_UNREACHABLE();
+}
+
+void FusedExpr::evalBlock(
+    const SelectivityVector& rows,
+    vector_size_t begin,
+    vector_size_t end,
+    const std::vector<const void*>& inputValues,
+    void* rawResult) {
+  const auto size = end - begin;
+  const bool allSelected = bits::isAllSet(rows.asRange().bits(), begin, end);
+  const bool isBoolean = type()->kind() == TypeKind::BOOLEAN;
+  const auto width = isBoolean ? 0 : kindWidth(type()->kind());
+  for (auto i = 0; i < program_.size(); ++i) {
+    const auto& instruction = program_[i];
+    const auto* a = operandValues(
+        instruction.args[0], instruction.kind, begin, inputValues);
+    const auto* b = instruction.numArgs > 1
+        ? operandValues(
+              instruction.args[1], instruction.kind, begin, inputValues)
+        : a;
+    void* out = temp(instruction.result);
+    if (i == program_.size() - 1 && allSelected && !isBoolean) {
+      // Writes the result in place.
+      out = static_cast<char*>(rawResult) + static_cast<int64_t>(begin) * width;
+    }
+    dispatchKind(instruction.kind, [&](auto dummy) {
+      using T = decltype(dummy);
+      if (isComparison(instruction.op)) {
+        compare<T>(
+            instruction.op,
+            static_cast<const T*>(a),
+            static_cast<const T*>(b),
+            static_cast<uint8_t*>(out),
+            size);
+      } else {
+        arithmetic<T>(
+            instruction.op,
+            static_cast<const T*>(a),
+            static_cast<const T*>(b),
+            static_cast<T*>(out),
+            size);
+      }
+    });
+  }
+
+  const auto* last = temp(program_.back().result);
+  if (isBoolean) {
+    auto* rawBits = static_cast<uint64_t*>(rawResult);
+    const auto* values = reinterpret_cast<const uint8_t*>(last);
+    if (allSelected) {
+      for (auto row = begin; row < end; ++row) {
+        bits::setBit(rawBits, row, values[row - begin]);
+      }
+    } else {
+      bits::forEachSetBit(
+          rows.asRange().bits(), begin, end, [&](vector_size_t row) {
+            bits::setBit(rawBits, row, values[row - begin]);
+          });
+    }
+    return;
+  }
+  if (allSelected) {
+    return;
+  }
+  dispatchKind(type()->kind(), [&](auto dummy) {
+    using T = decltype(dummy);
+    auto* values = static_cast<T*>(rawResult);
+    const auto* blockValues = reinterpret_cast<const T*>(last);
+    bits::forEachSetBit(
+        rows.asRange().bits(), begin, end, [&](vector_size_t row) {
+          values[row] = blockValues[row - begin];
+        });
+  });
+}
+
+// static
+void FusedExpr::setNulls(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& inputs,
+    BaseVector& result) {
+  bool mayHaveNulls = false;
+  for (const auto& input : inputs) {
+    mayHaveNulls |= input->mayHaveNulls();
+  }
+  if (!mayHaveNulls) {
+    if (result.mayHaveNulls()) {
+      result.clearNulls(rows);
+    }
+    return;
+  }
+  auto* rawNulls = result.mutableRawNulls();
+  rows.applyToSelected([&](vector_size_t row) {
+    bool isNull = false;
+    for (const auto& input : inputs) {
+      isNull |= input->isNullAt(row);
+    }
+    bits::setNull(rawNulls, row, isNull);
+  });
+}
+
+std::string FusedExpr::toString(bool recursive) const {
+  if (recursive) {
+    return fmt::format("{}({})", name(), source_->toString(recursive));
+  }
+  return name();
+}
+
+std::string FusedExpr::toSql(std::vector<VectorPtr>* complexConstants) const {
+  return source_->toSql(complexConstants);
+}
+
+} // namespace facebook::velox::exec
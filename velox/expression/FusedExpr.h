@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// Operations that have a precompiled fused kernel.
+enum class FusedOp : uint8_t {
+  kPlus,
+  kMinus,
+  kMultiply,
+  kDivide,
+  kNegate,
+  kEq,
+  kNeq,
+  kLt,
+  kLte,
+  kGt,
+  kGte,
+};
+
+/// Declares that the scalar function 'name' computes 'op' with the C++
+/// semantics of the operator for arguments of each of 'types'. The function
+/// must be deterministic, have default null behavior and never throw for these
+/// types. Arithmetic ops return their argument type and comparisons return
+/// BOOLEAN.
+void registerFusedFunction(
+    const std::string& name,
+    FusedOp op,
+    const std::vector<TypePtr>& types);
+
+/// Returns the op of 'name' for arguments of 'type' or std::nullopt if the
+/// function has not been registered for 'type'.
+std::optional<FusedOp> fusedFunctionOp(
+    const std::string& name,
+    const TypePtr& type);
+
+/// Evaluates a tree of functions registered with registerFusedFunction() over
+/// top level columns and constants. The rows are processed in blocks of
+/// kBlockSize, evaluating the whole tree for a block before moving to the
+/// next. The intermediate results are in small buffers that stay in cache
+/// instead of a vector per function call. If an input is not flat, evaluates
+/// the original tree instead.
+class FusedExpr : public SpecialForm {
+ public:
+  static constexpr int32_t kBlockSize = 1024;
+
+  /// Returns a FusedExpr that evaluates 'expr' or nullptr if 'expr' does not
+  /// qualify. 'expr' qualifies if it is a tree of at least two calls of fused
+  /// functions whose leaves are top level columns or non-null constants. Only
+  /// the root may be a comparison. Subtrees that are FusedExprs are absorbed.
+  static ExprPtr tryFuse(const ExprPtr& expr, bool trackCpuUsage);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  void evalSpecialFormSimplified(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  std::string toString(bool recursive = true) const override;
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override;
+
+  /// The interpreted tree that is evaluated when the inputs are not flat.
+  const ExprPtr& source() const {
+    return source_;
+  }
+
+  /// Number of batches evaluated by the original tree.
+  uint64_t numFallbacks() const {
+    return numFallbacks_;
+  }
+
+  // An argument of an instruction.
+  struct Operand {
+    enum class Kind : uint8_t { kInput, kConstant, kTemp };
+    Kind kind;
+    // Index into 'inputs_', 'constants_' or the temporaries.
+    int32_t index;
+  };
+
+  // Computes 'op' over 'args' of 'kind' into temporary 'result'.
+  struct Instruction {
+    FusedOp op;
+    TypeKind kind;
+    int32_t numArgs;
+    Operand args[2];
+    int32_t result;
+  };
+
+ private:
+  FusedExpr(
+      TypePtr type,
+      std::vector<ExprPtr>&& fields,
+      ExprPtr source,
+      std::vector<Instruction>&& program,
+      std::vector<std::vector<int64_t>>&& constants,
+      bool trackCpuUsage);
+
+  void computePropagatesNulls() override {
+    propagatesNulls_ = true;
+  }
+
+  // Evaluates the program for the rows of 'rows' in [begin, end) into
+  // 'rawResult'.
+  void evalBlock(
+      const SelectivityVector& rows,
+      vector_size_t begin,
+      vector_size_t end,
+      const std::vector<const void*>& inputValues,
+      void* rawResult);
+
+  // Returns the values of 'operand' of 'kind' for the block that starts at
+  // 'begin'.
+  const void* operandValues(
+      const Operand& operand,
+      TypeKind kind,
+      vector_size_t begin,
+      const std::vector<const void*>& inputValues) const;
+
+  int64_t* temp(int32_t index) {
+    return temps_.data() + index * kBlockSize;
+  }
+
+  // Sets the nulls of 'result' for 'rows' from 'inputs'.
+  static void setNulls(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& inputs,
+      BaseVector& result);
+
+  const ExprPtr source_;
+
+  // Postorder. The last instruction computes the result.
+  const std::vector<Instruction> program_;
+
+  // Blocks of kBlockSize copies of each constant.
+  const std::vector<std::vector<int64_t>> constants_;
+
+  // kBlockSize values for each temporary.
+  std::vector<int64_t> temps_;
+
+  uint64_t numFallbacks_{0};
+};
+
+} // namespace facebook::velox::exec
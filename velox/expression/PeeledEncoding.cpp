@@ -16,6 +16,7 @@
 
 #include "velox/expression/PeeledEncoding.h"
 
+#include "velox/common/base/HotCounters.h"
 #include "velox/expression/EvalCtx.h"
 
 namespace facebook::velox::exec {
@@ -33,8 +34,10 @@ namespace facebook::velox::exec {
           decodedVector,
           canPeelsHaveNulls,
           peeledVectors)) {
+    VELOX_HOT_COUNTER_INC(kPeelSuccess);
     return peeledEncoding;
   }
+  VELOX_HOT_COUNTER_INC(kPeelFailure);
   return nullptr;
 }
 
@@ -155,7 +158,11 @@ bool PeeledEncoding::peelInternal(
       }
       nonConstant = true;
       auto encoding = leaf->encoding();
-      if (encoding == VectorEncoding::Simple::DICTIONARY) {
+      // A sequence vector is peeled like a dictionary whose indices are the
+      // runs. Its wrapInfo() is the run lengths. The peeled vector has one
+      // row per run.
+      if (encoding == VectorEncoding::Simple::DICTIONARY ||
+          encoding == VectorEncoding::Simple::SEQUENCE) {
         if (!canPeelsHaveNulls && leaf->rawNulls()) {
           // A dictionary that adds nulls over an Expr that is not null for a
           // null argument cannot be peeled.
@@ -166,7 +173,7 @@ bool PeeledEncoding::peelInternal(
         if (!firstIndices) {
           firstIndices = std::move(indices);
         } else if (indices != firstIndices) {
-          // different fields use different dictionaries
+          // different fields use different dictionaries or runs
           peeled = false;
           break;
         }
@@ -100,6 +100,12 @@ class LocalSelectivityVector;
 ///    Peeled Vectors: DictWithNulls(Flat1), Const1,
 ///                    DictWithNulls(Dict3(Flat2))
 ///    peel: DictNoNulls
+///
+/// 10. Sequence layers with the same run lengths are peeled like dictionary
+///    layers and the expression is evaluated once per run.
+///    Input Vectors: Seq1(Flat1), Seq1(Flat2)
+///    Peeled Vectors: Flat1, Flat2
+///    peel: Seq1 => turned into a dictionary over the runs
 class PeeledEncoding {
  public:
   /// Factory method for constructing a PeeledEncoding object only if peeling
@@ -90,6 +90,28 @@ class SimpleFunctionAdapter : public VectorFunction {
       SimpleTypeTrait<arg_at<POSITION>>::isPrimitiveType &&
       SimpleTypeTrait<arg_at<POSITION>>::typeKind != TypeKind::BOOLEAN;
 
+  // Check that the argument at POSITION can be passed to callBatch() as an
+  // array of values.
+  template <int32_t POSITION>
+  static constexpr bool isArgBatchEligible =
+      !isVariadicType<arg_at<POSITION>>::value &&
+      SimpleTypeTrait<arg_at<POSITION>>::isPrimitiveType &&
+      SimpleTypeTrait<arg_at<POSITION>>::isFixedWidth &&
+      SimpleTypeTrait<arg_at<POSITION>>::typeKind != TypeKind::BOOLEAN;
+
+  template <size_t... Is>
+  static constexpr bool allArgsBatchEligibleImpl(std::index_sequence<Is...>) {
+    return (isArgBatchEligible<Is> && ...);
+  }
+
+  // Whether the UDF provides callBatch() and the return and argument types
+  // allow calling it on the raw values of flat vectors.
+  static constexpr bool batchIteration = FUNC::udf_has_callBatch &&
+      fastPathIteration &&
+      return_type_traits::typeKind != TypeKind::BOOLEAN &&
+      FUNC::is_default_null_behavior && !FUNC::can_produce_null_output &&
+      allArgsBatchEligibleImpl(std::make_index_sequence<FUNC::num_args>());
+
   constexpr int32_t reuseStringsFromArgValue() const {
     return udf_reuse_strings_from_arg<typename FUNC::udf_struct_t>();
   }
@@ -361,6 +383,18 @@ class SimpleFunctionAdapter : public VectorFunction {
       }
     }
 
+    if constexpr (batchIteration) {
+      if (callBatch(
+              applyContext,
+              args,
+              std::make_index_sequence<FUNC::num_args>())) {
+        if (isResultReused) {
+          result = std::move(*reusableResult);
+        }
+        return;
+      }
+    }
+
     std::vector<std::optional<LocalDecodedVector>> decoded;
     if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
@@ -468,6 +502,31 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  // Calls callBatch() of the UDF if all rows are selected and all arguments
+  // are flat without nulls. Returns false if the rows were not processed.
+  template <size_t... Is>
+  bool callBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    const auto& rows = *applyContext.rows;
+    if (!rows.isAllSelected()) {
+      return false;
+    }
+    for (const auto& arg : args) {
+      if (!arg->isFlatEncoding() || arg->mayHaveNulls()) {
+        return false;
+      }
+    }
+    (*fn_).callBatch(
+        applyContext.resultWriter.data_,
+        args[Is]
+            ->template asUnchecked<FlatVector<exec_arg_at<Is>>>()
+            ->rawValues()...,
+        rows.end());
+    return true;
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/core/SimpleFunctionMetadata.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
@@ -104,7 +106,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      resolutions_.wlock()->clear();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -136,7 +141,8 @@ class SimpleFunctionRegistry {
       return VectorFunctionMetadata{
           false,
           functionEntry_.getMetadata().isDeterministic(),
-          functionEntry_.getMetadata().defaultNullBehavior()};
+          functionEntry_.getMetadata().defaultNullBehavior(),
+          functionEntry_.getMetadata().isCommutative()};
     }
 
    private:
@@ -144,11 +150,41 @@ class SimpleFunctionRegistry {
     const TypePtr type_;
   };
 
+  /// Returns the function to use for 'name' with 'argTypes' and its return
+  /// type. The result of each (name, argument types) pair is cached until the
+  /// registry changes, so that wide projections with repeated calls do not
+  /// bind every signature of the function again for every call.
   std::optional<ResolvedSimpleFunction> resolveFunction(
       const std::string& name,
       const std::vector<TypePtr>& argTypes) const;
 
+  /// Returns the number of cached resolutions. Used in tests.
+  size_t testingNumResolutions() const {
+    return resolutions_.rlock()->size();
+  }
+
  private:
+  // Maximum number of cached resolutions. The cache is cleared when full.
+  static constexpr size_t kMaxResolutions = 10'000;
+
+  struct ResolutionKey {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+
+    bool operator==(const ResolutionKey& other) const;
+  };
+
+  struct ResolutionKeyHasher {
+    size_t operator()(const ResolutionKey& key) const;
+  };
+
+  // The result of resolveFunction(). 'entry' is nullptr if no function
+  // matched.
+  struct Resolution {
+    const FunctionEntry* entry;
+    TypePtr type;
+  };
+
   template <typename T>
   static std::unique_ptr<T> CreateUdf() {
     return std::make_unique<T>();
@@ -167,6 +203,13 @@ class SimpleFunctionRegistry {
       bool overwrite);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // Cached results of resolveFunction(). Updated while holding a read lock on
+  // 'registeredFunctions_' and cleared while holding the write lock, so that
+  // no entry outlives a change of the registry.
+  mutable folly::Synchronized<
+      folly::F14FastMap<ResolutionKey, Resolution, ResolutionKeyHasher>>
+      resolutions_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
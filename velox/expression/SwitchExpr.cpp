@@ -104,11 +104,13 @@ void SwitchExpr::evalSpecialForm(
       }
     }
 
+    // The flattened condition is only needed until the next case, so it is
+    // allocated from the scratch arena of 'context'.
     const auto booleanMix = getFlatBool(
         condition.get(),
         *remainingRows.get(),
         context,
-        &tempValues_,
+        nullptr,
         nullptr,
         true,
         &values,
@@ -59,7 +59,6 @@ class SwitchExpr : public SpecialForm {
 
   const size_t numCases_;
   const bool hasElseClause_;
-  BufferPtr tempValues_;
 
   friend class SwitchCallToSpecialForm;
 };
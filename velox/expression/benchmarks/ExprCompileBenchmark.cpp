@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+// Measures the construction of ExprSets for wide projections. The typed
+// expressions are built once. Each iteration compiles them into a new ExprSet,
+// which resolves every call against the function registries.
+
+using namespace facebook::velox;
+
+namespace {
+class ExprCompileBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  ExprCompileBenchmark() : FunctionBenchmarkBase() {
+    functions::prestosql::registerAllScalarFunctions();
+  }
+
+  // Returns 'numExprs' typed expressions over 10 columns of each of bigint,
+  // double, varchar and array(bigint), cycling through functions with fixed
+  // and generic signatures.
+  std::vector<core::TypedExprPtr> makeExprs(int32_t numExprs) {
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (auto i = 0; i < 10; ++i) {
+      names.push_back(fmt::format("b{}", i));
+      types.push_back(BIGINT());
+      names.push_back(fmt::format("d{}", i));
+      types.push_back(DOUBLE());
+      names.push_back(fmt::format("s{}", i));
+      types.push_back(VARCHAR());
+      names.push_back(fmt::format("a{}", i));
+      types.push_back(ARRAY(BIGINT()));
+    }
+    const auto rowType = ROW(std::move(names), std::move(types));
+
+    const std::vector<std::string> templates = {
+        "b{0} + b{1} * 2",
+        "round(d{0} / (d{1} + 1.0), 2)",
+        "concat(lower(s{0}), '_', s{1})",
+        "contains(a{0}, b{1})",
+        "cardinality(array_distinct(a{0}))",
+        "coalesce(element_at(a{0}, 1), b{1})",
+        "if(b{0} > b{1}, s{0}, s{1})",
+        "length(substr(s{0}, 1, 3)) + b{1}",
+    };
+    std::vector<core::TypedExprPtr> exprs;
+    for (auto i = 0; i < numExprs; ++i) {
+      const auto text = fmt::format(
+          fmt::runtime(templates[i % templates.size()]), i % 10, (i + 3) % 10);
+      exprs.push_back(core::Expressions::inferTypes(
+          parse::parseExpr(text, options_), rowType, execCtx_.pool()));
+    }
+    return exprs;
+  }
+
+  void run(int32_t numExprs, int32_t iterations) {
+    folly::BenchmarkSuspender suspender;
+    const auto exprs = makeExprs(numExprs);
+    suspender.dismiss();
+
+    for (auto i = 0; i < iterations; ++i) {
+      exec::ExprSet exprSet(exprs, &execCtx_);
+      folly::doNotOptimizeAway(exprSet.size());
+    }
+  }
+};
+
+std::unique_ptr<ExprCompileBenchmark> benchmark;
+
+BENCHMARK(compile100, n) {
+  benchmark->run(100, n);
+}
+
+BENCHMARK(compile1K, n) {
+  benchmark->run(1'000, n);
+}
+
+BENCHMARK(compile10K, n) {
+  benchmark->run(10'000, n);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<ExprCompileBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
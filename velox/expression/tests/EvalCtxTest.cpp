@@ -107,6 +107,27 @@ TEST_F(EvalCtxTest, vectorRecycler) {
   ASSERT_NE(vector.get(), newVector.get());
 }
 
+TEST_F(EvalCtxTest, scratchArena) {
+  auto& arena = execCtx_.scratchArena();
+  {
+    EvalCtx context(&execCtx_);
+    auto* outer = context.scratchArena().allocate<int64_t>(100);
+    const auto mark = arena.mark();
+    {
+      // A nested context releases only its own allocations.
+      EvalCtx nested(&execCtx_);
+      nested.scratchArena().allocate<int64_t>(100);
+      ASSERT_NE(mark.offset, arena.mark().offset);
+    }
+    ASSERT_EQ(mark.chunk, arena.mark().chunk);
+    ASSERT_EQ(mark.offset, arena.mark().offset);
+    ASSERT_EQ(outer + 100, context.scratchArena().allocate<int64_t>(1));
+  }
+  // The memory is kept for the next batch.
+  ASSERT_TRUE(arena.mark().isStart());
+  ASSERT_EQ(ScratchArena::kMinChunkSize, arena.retainedSize());
+}
+
 TEST_F(EvalCtxTest, ensureErrorsVectorSize) {
   EvalCtx context(&execCtx_);
   context.ensureErrorsVectorSize(10);
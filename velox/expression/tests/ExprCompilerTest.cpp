@@ -15,6 +15,7 @@
  */
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/expression/CastExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -311,6 +312,36 @@ TEST_F(ExprCompilerTest, eliminateUnnecessaryCast) {
   ASSERT_TRUE(dynamic_cast<const FieldReference*>(exprSet->expr(0).get()));
 }
 
+TEST_F(ExprCompilerTest, fuseCastChain) {
+  auto rowType = ROW({"c0", "c1", "c2"}, {TINYINT(), INTEGER(), BIGINT()});
+
+  // Returns true if 'expr' compiles to a single cast of a column.
+  auto isFused = [&](const std::string& expr) {
+    auto exprSet = compile(makeTypedExpr(expr, rowType));
+    auto* cast = dynamic_cast<const CastExpr*>(exprSet->expr(0).get());
+    return cast != nullptr &&
+        dynamic_cast<const FieldReference*>(cast->inputs()[0].get()) !=
+        nullptr;
+  };
+
+  ASSERT_TRUE(isFused("cast(cast(c1 as varchar) as bigint)"));
+  ASSERT_TRUE(isFused("cast(cast(c0 as integer) as double)"));
+  ASSERT_TRUE(
+      isFused("cast(cast(cast(c0 as smallint) as bigint) as varchar)"));
+  ASSERT_TRUE(isFused("try_cast(cast(c1 as varchar) as smallint)"));
+
+  // Narrowing, non-integer inputs and strings parsed into other types are
+  // kept.
+  ASSERT_FALSE(isFused("cast(cast(c2 as integer) as bigint)"));
+  ASSERT_FALSE(isFused("cast(cast(c1 as varchar) as boolean)"));
+  ASSERT_FALSE(isFused("cast(cast(cast(c1 as double) as real) as bigint)"));
+
+  // A chain back to the type of the column is the column itself.
+  auto exprSet = compile(
+      makeTypedExpr("cast(cast(c1 as varchar) as integer)", rowType));
+  ASSERT_TRUE(dynamic_cast<const FieldReference*>(exprSet->expr(0).get()));
+}
+
 TEST_F(ExprCompilerTest, lambdaExpr) {
   // Ensure that metadata computation correctly pulls in distinct fields from
   // captured columns.
@@ -474,6 +474,38 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+TEST_P(ParameterizedExprTest, reorderDeterministicOnly) {
+  constexpr int32_t kTestSize = 20'000;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kTestSize, [](auto row) { return row; })});
+  // The expensive filter is written first in each run of deterministic
+  // filters. rand() < 2.0 is always true and is not moved.
+  auto exprSet = compileExpression(
+      "if (length(cast(c0 as varchar)) > 0 and c0 % 7 < 1 and rand() < 2.0 "
+      "and length(cast(c0 as varchar)) > 0 and c0 % 5 < 1, 1, 2)",
+      asRowType(data->type()));
+  for (auto i = 0; i < 10; ++i) {
+    auto result = evaluate(exprSet.get(), data);
+    assertEqualVectors(
+        makeFlatVector<int64_t>(
+            kTestSize,
+            [](auto row) { return row % 7 == 0 && row % 5 == 0 ? 1 : 2; }),
+        result);
+  }
+
+  auto condition = std::dynamic_pointer_cast<exec::ConjunctExpr>(
+      exprSet->expr(0)->inputs()[0]);
+  ASSERT_TRUE(condition != nullptr);
+  const auto& order = condition->inputOrder();
+  ASSERT_EQ(order.size(), 5);
+  ASSERT_EQ(order[2], 2);
+  ASSERT_EQ(order[0], 1);
+  ASSERT_EQ(order[1], 0);
+  ASSERT_EQ(order[3], 4);
+  ASSERT_EQ(order[4], 3);
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -4105,6 +4137,70 @@ TEST_P(ParameterizedExprTest, cseOverDictionaryAcrossMultipleExpressions) {
   }
 }
 
+TEST_P(ParameterizedExprTest, cseCommutative) {
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5}),
+      makeFlatVector<int64_t>({8, 9, 10, 11, 12}),
+  });
+
+  // Calls of commutative functions with swapped arguments are evaluated once.
+  auto exprSet = compileMultiple(
+      {"c0 + c1",
+       "c1 + c0",
+       "(c1 + c0) * 2::bigint",
+       "2::bigint * (c0 + c1)"},
+      asRowType(input->type()));
+  ASSERT_EQ(exprSet->expr(0), exprSet->expr(1));
+  ASSERT_EQ(exprSet->expr(2), exprSet->expr(3));
+
+  auto [results, stats] = evaluateMultipleWithStats(
+      {"c0 + c1", "c1 + c0", "c0 = c1 + 7::bigint", "c1 + 7::bigint = c0"},
+      input);
+  assertEqualVectors(results[0], results[1]);
+  assertEqualVectors(results[2], results[3]);
+  EXPECT_EQ(5, stats.at("plus").numProcessedRows);
+  EXPECT_EQ(5, stats.at("eq").numProcessedRows);
+
+  // Non-commutative functions are not deduplicated.
+  std::tie(results, stats) =
+      evaluateMultipleWithStats({"c0 - c1", "c1 - c0"}, input);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(5, [](auto /*row*/) { return -7; }), results[0]);
+  EXPECT_EQ(10, stats.at("minus").numProcessedRows);
+}
+
+TEST_P(ParameterizedExprTest, cseFromFilterInProjection) {
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(100, [](auto row) { return row % 7; }),
+  });
+
+  // Evaluates a filter and then the projections on the rows that pass, like
+  // FilterProject. The projections reuse the values of the shared
+  // subexpressions computed by the filter, including ones with swapped
+  // arguments.
+  auto exprSet = compileMultiple(
+      {"c0 * c1 > 100::bigint", "c1 * c0", "c0 * c1 + 1::bigint"},
+      asRowType(input->type()));
+  exec::EvalCtx context(execCtx_.get(), exprSet.get(), input.get());
+  SelectivityVector rows(input->size());
+  std::vector<VectorPtr> results;
+  exprSet->eval(0, 1, true, rows, context, results);
+
+  auto* passed = results[0]->asFlatVector<bool>();
+  SelectivityVector passedRows(input->size(), false);
+  rows.applyToSelected(
+      [&](auto row) { passedRows.setValid(row, passed->valueAt(row)); });
+  passedRows.updateBounds();
+  ASSERT_LT(passedRows.countSelected(), input->size());
+  exprSet->eval(1, 3, false, passedRows, context, results);
+
+  auto expected = makeFlatVector<int64_t>(
+      100, [](auto row) { return row * (row % 7); });
+  assertEqualVectors(expected, results[1], passedRows);
+  EXPECT_EQ(100, exprSet->stats().at("multiply").numProcessedRows);
+}
+
 TEST_P(ParameterizedExprTest, smallerWrappedBaseVector) {
   // This test verifies that in the case that wrapping the
   // result of a peeledResult (i.e result which is computed after
@@ -4503,6 +4599,8 @@ TEST_P(ParameterizedExprTest, extractSubfields) {
   validate("c0[1].c0c1['foo'] > 0", {"c0[1].c0c1[\"foo\"]"});
   validate("c0[1].c0c0[c1[1]] > 0", {"c0[1].c0c0", "c1[1]"});
   validate("element_at(c1, -1)", {"c1"});
+  validate("element_at(c0[1].c0c1, 'foo') > 0", {"c0[1].c0c1[\"foo\"]"});
+  validate("element_at(c0[1].c0c0, 2) > 0", {"c0[1].c0c0[2]"});
   validate("transform(c0, x -> x.c0c0[0] + c1[1])", {"c0", "c1[1]"});
   validate("transform(c0, c1 -> c1.c0c0[0])", {"c0"});
   validate("reduce(c1, 0, (c0, c3) -> c0 + c3, c2 -> c2)", {"c1"});
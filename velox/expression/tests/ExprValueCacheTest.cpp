@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/ExprValueCache.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class ExprValueCacheTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setMaxEntries(uint32_t maxEntries) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprValueCacheMaxEntries,
+         std::to_string(maxEntries)},
+    });
+  }
+
+  // Returns a batch of 'size' URLs over 20 hosts, every 7th null.
+  VectorPtr makeUrls(vector_size_t size) {
+    return makeFlatVector<std::string>(
+        size,
+        [&](auto row) {
+          return fmt::format("https://host{}.example.com/index.html", row % 20);
+        },
+        nullEvery(7));
+  }
+};
+
+TEST_F(ExprValueCacheTest, lru) {
+  ExprValueCache cache(2, 1 << 20);
+  cache.initialize(BIGINT(), pool());
+  ASSERT_EQ(cache.values()->size(), 2);
+
+  ASSERT_FALSE(cache.find("a").has_value());
+  auto a = cache.insert("a");
+  ASSERT_TRUE(a.has_value());
+  ASSERT_FALSE(cache.insert("a").has_value());
+  auto b = cache.insert("b");
+  ASSERT_TRUE(b.has_value());
+  ASSERT_NE(a.value(), b.value());
+  ASSERT_EQ(cache.find("a"), a);
+
+  // 'b' is the least recently used.
+  auto c = cache.insert("c");
+  ASSERT_EQ(c, b);
+  ASSERT_FALSE(cache.find("b").has_value());
+  ASSERT_EQ(cache.find("a"), a);
+  ASSERT_EQ(cache.size(), 2);
+
+  ASSERT_FALSE(
+      cache.insert(std::string(ExprValueCache::kMaxKeySize + 1, 'x'))
+          .has_value());
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_EQ(cache.values(), nullptr);
+}
+
+TEST_F(ExprValueCacheTest, acrossBatches) {
+  const std::string expression =
+      "regexp_extract(c0, '//([^/]+)/', 1) || '-suffix'";
+  auto rowType = ROW({"c0"}, {VARCHAR()});
+
+  setMaxEntries(0);
+  auto uncachedSet = compileExpression(expression, rowType);
+  ASSERT_EQ(uncachedSet->expr(0)->valueCache(), nullptr);
+
+  setMaxEntries(100);
+  auto exprSet = compileExpression(expression, rowType);
+  // The cache is on the topmost expression that depends on c0 only.
+  ASSERT_NE(exprSet->expr(0)->valueCache(), nullptr);
+  for (const auto& input : exprSet->expr(0)->inputs()) {
+    ASSERT_EQ(input->valueCache(), nullptr);
+  }
+
+  for (auto i = 0; i < 3; ++i) {
+    // Different vectors with the same values.
+    auto data = makeRowVector({makeUrls(1'000)});
+    auto expected = evaluate(*uncachedSet, data);
+    auto result = evaluate(*exprSet, data);
+    assertEqualVectors(expected, result);
+
+    // Partial selection.
+    SelectivityVector rows(data->size());
+    rows.setValidRange(0, data->size() / 2, false);
+    rows.updateBounds();
+    assertEqualVectors(
+        evaluate(*uncachedSet, data, rows),
+        evaluate(*exprSet, data, rows),
+        rows);
+  }
+
+  // The first batch has 857 non-null rows, all of which are misses. The
+  // second half of a batch has 429 non-null rows.
+  const auto& stats = exprSet->expr(0)->stats();
+  ASSERT_EQ(stats.numValueCacheMisses, 857);
+  ASSERT_EQ(stats.numValueCacheHits, 429 + 2 * (857 + 429));
+  ASSERT_EQ(exprSet->expr(0)->valueCache()->size(), 20);
+
+  auto statsByName = exprSet->stats();
+  ASSERT_EQ(
+      statsByName.at("concat").numValueCacheHits, stats.numValueCacheHits);
+
+  // More distinct values than entries.
+  setMaxEntries(5);
+  exprSet = compileExpression(expression, rowType);
+  auto data = makeRowVector({makeUrls(1'000)});
+  assertEqualVectors(evaluate(*uncachedSet, data), evaluate(*exprSet, data));
+  ASSERT_EQ(exprSet->expr(0)->valueCache()->size(), 5);
+}
+
+TEST_F(ExprValueCacheTest, unsupported) {
+  setMaxEntries(100);
+  auto rowType = ROW({"c0", "c1"}, {VARCHAR(), BIGINT()});
+
+  // Depends on two columns.
+  auto exprSet = compileExpression("substr(c0, c1)", rowType);
+  ASSERT_EQ(exprSet->expr(0)->valueCache(), nullptr);
+
+  // Not a string column.
+  exprSet = compileExpression("c1 + 1", rowType);
+  ASSERT_EQ(exprSet->expr(0)->valueCache(), nullptr);
+
+  // Complex type result.
+  exprSet = compileExpression("split(c0, '/')", rowType);
+  ASSERT_EQ(exprSet->expr(0)->valueCache(), nullptr);
+
+  // Special forms.
+  exprSet = compileExpression("coalesce(c0, 'x')", rowType);
+  ASSERT_EQ(exprSet->expr(0)->valueCache(), nullptr);
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedExpr.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class FusedExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setFusedKernels(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFusedKernelsEnabled,
+         enabled ? "true" : "false"},
+    });
+  }
+
+  // Evaluates 'expression' with and without fused kernels and checks that the
+  // results match. Returns the fused expression.
+  std::shared_ptr<Expr> testFused(
+      const std::string& expression,
+      const RowVectorPtr& data,
+      const SelectivityVector& rows) {
+    setFusedKernels(false);
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    EXPECT_FALSE(exprSet->expr(0)->is<FusedExpr>());
+    auto expected = evaluate(*exprSet, data, rows);
+
+    setFusedKernels(true);
+    auto fusedSet = compileExpression(expression, asRowType(data->type()));
+    EXPECT_TRUE(fusedSet->expr(0)->is<FusedExpr>()) << fusedSet->toString();
+    auto result = evaluate(*fusedSet, data, rows);
+    assertEqualVectors(expected, result, rows);
+    return fusedSet->expr(0);
+  }
+
+  bool isFused(const std::string& expression, const RowTypePtr& rowType) {
+    setFusedKernels(true);
+    return compileExpression(expression, rowType)->expr(0)->is<FusedExpr>();
+  }
+
+  RowVectorPtr makeData(vector_size_t size) {
+    return makeRowVector({
+        makeFlatVector<double>(
+            size, [](auto row) { return row * 0.5; }, nullEvery(7)),
+        makeFlatVector<double>(
+            size, [](auto row) { return 1000 - row; }, nullEvery(11)),
+        makeFlatVector<double>(size, [](auto row) { return row % 13; }),
+    });
+  }
+};
+
+TEST_F(FusedExprTest, arithmetic) {
+  // Several blocks with a partial last block.
+  auto data = makeData(3 * FusedExpr::kBlockSize + 17);
+  SelectivityVector allRows(data->size());
+  auto fused = testFused("c0 * c1 + c0 / 2.0 - (-c2)", data, allRows);
+  ASSERT_EQ(fused->inputs().size(), 3);
+  ASSERT_EQ(fused->as<FusedExpr>()->numFallbacks(), 0);
+
+  SelectivityVector someRows(data->size());
+  for (auto i = 0; i < data->size(); i += 3) {
+    someRows.setValid(i, false);
+  }
+  // A fully selected block.
+  someRows.setValidRange(
+      FusedExpr::kBlockSize, 2 * FusedExpr::kBlockSize, true);
+  someRows.updateBounds();
+  testFused("c0 * c1 + c0 / 2.0 - (-c2)", data, someRows);
+
+  // Columns that are used more than once are read once.
+  fused = testFused("(c0 + c0) * c0", data, allRows);
+  ASSERT_EQ(fused->inputs().size(), 1);
+}
+
+TEST_F(FusedExprTest, comparison) {
+  auto data = makeData(2 * FusedExpr::kBlockSize + 100);
+  SelectivityVector rows(data->size());
+  testFused("c0 + c1 > c2 * 100.0", data, rows);
+
+  rows.setValidRange(10, 1500, false);
+  rows.updateBounds();
+  testFused("c0 - c2 <= c1", data, rows);
+
+  auto integers = makeRowVector({
+      makeFlatVector<int64_t>(1000, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(1000, [](auto row) { return 1000 - row; }),
+  });
+  // Integer arithmetic is not fused.
+  ASSERT_FALSE(isFused("c0 + c1 = 500", asRowType(integers->type())));
+}
+
+TEST_F(FusedExprTest, encodedInput) {
+  auto data = makeData(1000);
+  auto indices = makeIndicesInReverse(1000);
+  auto encoded = makeRowVector({
+      wrapInDictionary(indices, data->childAt(0)),
+      BaseVector::wrapInConstant(1000, 5, data->childAt(1)),
+      data->childAt(2),
+  });
+  SelectivityVector rows(encoded->size());
+  testFused("c0 * c1 + c2 * c2", encoded, rows);
+}
+
+TEST_F(FusedExprTest, notFused) {
+  auto rowType = ROW({"c0", "c1", "c2"}, {DOUBLE(), DOUBLE(), BIGINT()});
+
+  // A single call.
+  ASSERT_FALSE(isFused("c0 + c1", rowType));
+  // Casts are not fused.
+  ASSERT_FALSE(isFused("c0 + c1 > cast(c2 as double) * 2.0", rowType));
+  // Comparisons are only fused at the root.
+  ASSERT_FALSE(isFused("(c0 > c1) = (c1 > c0)", rowType));
+  // Functions that are not registered as fused.
+  ASSERT_FALSE(isFused("sqrt(c0) + c1", rowType));
+
+  setFusedKernels(false);
+  ASSERT_FALSE(
+      compileExpression("c0 * c1 + c0", rowType)->expr(0)->is<FusedExpr>());
+}
+
+TEST_F(FusedExprTest, toString) {
+  setFusedKernels(true);
+  auto rowType = ROW({"c0", "c1"}, {DOUBLE(), DOUBLE()});
+  auto exprSet = compileExpression("c0 * c1 + c0", rowType);
+  const auto& fused = exprSet->expr(0);
+  ASSERT_EQ(fused->toString(), "fused(plus(multiply(c0, c1), c0))");
+  ASSERT_EQ(fused->toSql(), fused->as<FusedExpr>()->source()->toSql());
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
@@ -507,3 +507,46 @@ TEST_F(PeeledEncodingTest, peelingFails) {
     ASSERT_TRUE(!peeledEncoding);
   }
 }
+
+TEST_F(PeeledEncodingTest, sequence) {
+  // Sequence vectors with the same run lengths are peeled to their runs.
+  //    Input Vectors: Seq1(Flat1), Seq1(Flat2), Const1
+  //    Peeled Vectors: Flat1, Flat2, Const1
+  //    peel: Seq1 as a dictionary over the runs
+  auto lengths = allocateIndices(3, pool());
+  auto* rawLengths = lengths->asMutable<vector_size_t>();
+  rawLengths[0] = 4;
+  rawLengths[1] = 1;
+  rawLengths[2] = 5;
+  auto flat1 = makeFlatVector<int32_t>({1, 2, 3});
+  auto flat2 = makeNullableFlatVector<int64_t>({10, std::nullopt, 30});
+  auto const1 = makeConstant<int32_t>(7, 10);
+  auto input1 = BaseVector::wrapInSequence(lengths, 10, flat1);
+  auto input2 = BaseVector::wrapInSequence(lengths, 10, flat2);
+
+  SelectivityVector rows(10);
+  LocalDecodedVector localDecodedVector(execCtx_);
+  std::vector<VectorPtr> peeledVectors;
+  auto peeledEncoding = PeeledEncoding::peel(
+      {input1, input2, const1}, rows, localDecodedVector, true, peeledVectors);
+  ASSERT_TRUE(peeledEncoding);
+  ASSERT_EQ(peeledEncoding->wrapEncoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(peeledVectors.size(), 3);
+  ASSERT_EQ(peeledVectors[0], flat1);
+  ASSERT_EQ(peeledVectors[1], flat2);
+
+  LocalSelectivityVector innerRowsHolder(execCtx_);
+  auto innerRows = peeledEncoding->translateToInnerRows(rows, innerRowsHolder);
+  ASSERT_EQ(innerRows->countSelected(), 3);
+
+  auto wrapped = peeledEncoding->wrap(INTEGER(), pool(), flat1, rows);
+  assertEqualVectors(input1, wrapped);
+
+  // Sequences with different run lengths are not peeled.
+  auto otherLengths = AlignedBuffer::copy(pool(), lengths);
+  auto input3 = BaseVector::wrapInSequence(otherLengths, 10, flat1);
+  peeledVectors.clear();
+  peeledEncoding = PeeledEncoding::peel(
+      {input1, input3}, rows, localDecodedVector, true, peeledVectors);
+  ASSERT_FALSE(peeledEncoding);
+}
@@ -681,6 +681,62 @@ TEST_F(SimpleFunctionTest, templatedCall) {
   assertEqualVectors(expected, result);
 }
 
+// Returns a different result from callBatch() to show which one was called.
+template <typename T>
+struct BatchPlusFunction {
+  FOLLY_ALWAYS_INLINE void call(int64_t& out, int64_t a, int32_t b) {
+    out = a + b;
+  }
+
+  FOLLY_ALWAYS_INLINE void
+  callBatch(int64_t* out, const int64_t* a, const int32_t* b, int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      out[i] = a[i] + b[i] + 1'000;
+    }
+  }
+};
+
+TEST_F(SimpleFunctionTest, callBatch) {
+  registerFunction<BatchPlusFunction, int64_t, int64_t, int32_t>(
+      {"batch_plus"});
+
+  const vector_size_t size = 100;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row * 2; }),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row * 2; }, nullEvery(5)),
+  });
+
+  // All rows selected, flat inputs without nulls.
+  auto result = evaluate("batch_plus(c0, c1)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 3 + 1'000; }),
+      result);
+
+  // Nulls in an input.
+  result = evaluate("batch_plus(c0, c2)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 3; }, nullEvery(5)),
+      result);
+
+  // Not all rows selected.
+  SelectivityVector rows(size);
+  rows.setValid(10, false);
+  rows.updateBounds();
+  result = evaluate("batch_plus(c0, c1)", data, rows);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 3; }),
+      result,
+      rows);
+
+  // Constant input.
+  result = evaluate("batch_plus(c0, cast(1 as integer))", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, [](auto row) { return row + 1; }), result);
+}
+
 // Function that takes a map as input.
 template <typename T>
 struct MapReaderFunction {
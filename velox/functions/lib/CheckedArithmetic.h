@@ -25,6 +25,8 @@ namespace facebook::velox::functions {
 
 template <typename T>
 struct CheckedPlusFunction {
+  static constexpr bool is_commutative = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
@@ -43,6 +45,8 @@ struct CheckedMinusFunction {
 
 template <typename T>
 struct CheckedMultiplyFunction {
+  static constexpr bool is_commutative = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
@@ -26,6 +26,7 @@ namespace facebook::velox::functions::kll {
 namespace detail {
 
 constexpr uint8_t kMaxLevel = 60;
+constexpr uint8_t kMinBufferWidth = 8;
 
 // Current version number for the serialzation format.  Everytime the
 // serialization format changes, this needs to be increased and a new
@@ -329,64 +330,69 @@ uint32_t KllSketch<T, A, C>::insertPosition() {
       addEmptyTopLevelToCompletelyFullSketch();
     }
 
-    const uint32_t rawBeg = levels_[level];
-    const uint32_t rawLim = levels_[level + 1];
-    // +2 is OK because we already added a new top level if necessary.
-    const uint32_t popAbove = levels_[level + 2] - rawLim;
-    const uint32_t rawPop = rawLim - rawBeg;
-    const bool oddPop = rawPop & 1;
-    const uint32_t adjBeg = rawBeg + oddPop;
-    const uint32_t adjPop = rawPop - oddPop;
-    const uint32_t halfAdjPop = adjPop / 2;
-
-    // Level zero might not be sorted, so we must sort it if we wish
-    // to compact it.
-    if (level == 0 && !isLevelZeroSorted_) {
-      std::sort(items_.data() + adjBeg, items_.data() + adjBeg + adjPop, C());
-    }
-    if (popAbove == 0) {
-      detail::randomlyHalveUp(items_.data(), adjBeg, adjPop, randomBit_);
-    } else {
-      detail::randomlyHalveDown(items_.data(), adjBeg, adjPop, randomBit_);
-      detail::mergeOverlap(
-          items_.data(),
-          adjBeg,
-          halfAdjPop,
-          rawLim,
-          popAbove,
-          adjBeg + halfAdjPop,
-          C());
-    }
-    levels_[level + 1] -= halfAdjPop; // Adjust boundaries of the level above.
-    if (oddPop) {
-      // The current level now contains one item.
-      levels_[level] = levels_[level + 1] - 1;
-      if (levels_[level] != rawBeg) {
-        // Namely this leftover guy.
-        items_[levels_[level]] = std::move(items_[rawBeg]);
-      }
-    } else {
-      levels_[level] = levels_[level + 1]; // The current level is now empty.
+    compactLevel(level);
+  }
+  return --levels_[0];
+}
+
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::compactLevel(uint8_t level) {
+  const uint32_t rawBeg = levels_[level];
+  const uint32_t rawLim = levels_[level + 1];
+  // +2 is OK because the caller added a new top level if necessary.
+  const uint32_t popAbove = levels_[level + 2] - rawLim;
+  const uint32_t rawPop = rawLim - rawBeg;
+  const bool oddPop = rawPop & 1;
+  const uint32_t adjBeg = rawBeg + oddPop;
+  const uint32_t adjPop = rawPop - oddPop;
+  const uint32_t halfAdjPop = adjPop / 2;
+
+  // Level zero might not be sorted, so we must sort it if we wish
+  // to compact it.
+  if (level == 0 && !isLevelZeroSorted_) {
+    std::sort(items_.data() + adjBeg, items_.data() + adjBeg + adjPop, C());
+  }
+  if (popAbove == 0) {
+    detail::randomlyHalveUp(items_.data(), adjBeg, adjPop, randomBit_);
+  } else {
+    detail::randomlyHalveDown(items_.data(), adjBeg, adjPop, randomBit_);
+    detail::mergeOverlap(
+        items_.data(),
+        adjBeg,
+        halfAdjPop,
+        rawLim,
+        popAbove,
+        adjBeg + halfAdjPop,
+        C());
+  }
+  levels_[level + 1] -= halfAdjPop; // Adjust boundaries of the level above.
+  if (oddPop) {
+    // The current level now contains one item.
+    levels_[level] = levels_[level + 1] - 1;
+    if (levels_[level] != rawBeg) {
+      // Namely this leftover guy.
+      items_[levels_[level]] = std::move(items_[rawBeg]);
     }
+  } else {
+    levels_[level] = levels_[level + 1]; // The current level is now empty.
+  }
 
-    // Verify that we freed up halfAdjPop array slots just below the
-    // current level.
-    VELOX_DCHECK_EQ(levels_[level], rawBeg + halfAdjPop);
-
-    // Finally, we need to shift up the data in the levels below
-    // so that the freed-up space can be used by level zero.
-    if (level > 0) {
-      const uint32_t amount = rawBeg - levels_[0];
-      std::move_backward(
-          items_.data() + levels_[0],
-          items_.data() + levels_[0] + amount,
-          items_.data() + levels_[0] + halfAdjPop + amount);
-      for (uint8_t lvl = 0; lvl < level; lvl++) {
-        levels_[lvl] += halfAdjPop;
-      }
+  // Verify that we freed up halfAdjPop array slots just below the
+  // current level.
+  VELOX_DCHECK_EQ(levels_[level], rawBeg + halfAdjPop);
+
+  // Finally, we need to shift up the data in the levels below
+  // so that the freed-up space can be used by level zero.
+  if (level > 0) {
+    const uint32_t amount = rawBeg - levels_[0];
+    std::move_backward(
+        items_.data() + levels_[0],
+        items_.data() + levels_[0] + amount,
+        items_.data() + levels_[0] + halfAdjPop + amount);
+    for (uint8_t lvl = 0; lvl < level; lvl++) {
+      levels_[lvl] += halfAdjPop;
     }
   }
-  return --levels_[0];
 }
 
 template <typename T, typename A, typename C>
@@ -466,9 +472,57 @@ void KllSketch<T, A, C>::compact() {
   }
   VELOX_DCHECK_LE(k, items_.size());
   items_.resize(k);
+  items_.shrink_to_fit();
   VELOX_DCHECK_EQ(items_.size(), levels_.back());
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::compact(size_t maxBytes) {
+  compact();
+  // Slots freed by compactLevel() are at the bottom and dropped at the end.
+  auto byteSize = [&] {
+    return serializedByteSize() - sizeof(T) * levels_[0];
+  };
+  if (byteSize() <= maxBytes) {
+    return;
+  }
+  // Lower k so that the capacity the sketch grows back to when inserting
+  // fits in maxBytes, otherwise the next inserts undo the down-sampling.
+  const size_t fixedBytes = serializedByteSize() - sizeof(T) * items_.size();
+  const uint64_t maxItems =
+      maxBytes > fixedBytes ? (maxBytes - fixedBytes) / sizeof(T) : 0;
+  const uint32_t capacity = detail::computeTotalCapacity(k_, numLevels());
+  if (capacity > maxItems) {
+    k_ = std::max<uint64_t>(
+        detail::kMinBufferWidth, k_ * maxItems / capacity);
+  }
+  // Halve the lowest level holding at least 2 items into the level above, as
+  // insert does when a level is full.  Lower levels carry the lowest weights
+  // so halving them first loses the least accuracy.
+  while (byteSize() > maxBytes) {
+    uint8_t level = 0;
+    while (level < numLevels() && safeLevelSize(level) < 2) {
+      ++level;
+    }
+    if (level == numLevels()) {
+      // Every level holds at most one item, nothing left to halve.
+      break;
+    }
+    if (level + 1 == numLevels()) {
+      levels_.push_back(levels_.back());
+    }
+    compactLevel(level);
+  }
+  if (const auto freed = levels_[0]; freed > 0) {
+    items_.erase(items_.begin(), items_.begin() + freed);
+    for (auto& boundary : levels_) {
+      boundary -= freed;
+    }
+    items_.shrink_to_fit();
+  }
+  VELOX_DCHECK_EQ(detail::sumSampleWeights(numLevels(), levels_.data()), n_);
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::finish() {
   if (!isLevelZeroSorted_) {
@@ -26,8 +26,6 @@ namespace detail {
 
 namespace {
 
-constexpr uint8_t kMinBufferWidth = 8;
-
 double powerOfTwoThirds(int n) {
   static const auto kMemo = [] {
     std::array<double, kMaxLevel> memo;
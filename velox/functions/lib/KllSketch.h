@@ -60,9 +60,18 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
-  /// Call this before serialization can optimize the space used.
+  /// Call this before serialization can optimize the space used. Also
+  /// releases the unused capacity of the items. Values can still be inserted
+  /// and merged after compaction.
   void compact();
 
+  /// Like compact(), and then down-samples the sketch until its serialized
+  /// size is at most `maxBytes`, or every level holds at most one item.
+  /// Unlike compact() this loses accuracy: k is lowered so that later inserts
+  /// stay within the budget, and the lowest levels are randomly halved into
+  /// the levels above them.
+  void compact(size_t maxBytes);
+
   /// Merge this sketch with values from multiple other sketches.
   /// @tparam Iter Iterator type dereferenceable to the same type as this sketch
   ///  (KllSketch<T, Allocator, Compare>)
@@ -102,6 +111,12 @@ struct KllSketch {
     return n_;
   }
 
+  /// The bytes of memory held by the sketch, including unused capacity.
+  size_t memoryUsage() const {
+    return items_.capacity() * sizeof(T) +
+        levels_.capacity() * sizeof(uint32_t);
+  }
+
   /// Calculate the size needed for serialization.
   size_t serializedByteSize() const;
 
@@ -172,6 +187,7 @@ struct KllSketch {
   void doInsert(T);
   uint32_t insertPosition();
   int findLevelToCompact() const;
+  void compactLevel(uint8_t level);
   void addEmptyTopLevelToCompletelyFullSketch();
   void shiftItems(uint32_t delta);
 
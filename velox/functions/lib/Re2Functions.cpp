@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -35,6 +36,69 @@ re2::StringPiece toStringPiece(const T& s) {
 
 namespace detail {
 
+// static
+SharedReCache& SharedReCache::instance() {
+  static SharedReCache cache;
+  return cache;
+}
+
+std::shared_ptr<RE2> SharedReCache::findOrCompile(
+    std::string_view pattern,
+    bool dotNl) {
+  std::string key;
+  key.reserve(pattern.size() + 1);
+  key.push_back(dotNl ? '1' : '0');
+  key.append(pattern);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+      ++numHits_;
+      return it->second.re;
+    }
+  }
+
+  // Compile outside of the lock. If another thread compiles the same pattern
+  // meanwhile, the first one to finish is kept.
+  RE2::Options options{RE2::Quiet};
+  options.set_dot_nl(dotNl);
+  auto re = std::make_shared<RE2>(toStringPiece(pattern), options);
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    return it->second.re;
+  }
+  if (maxEntries_ == 0) {
+    return re;
+  }
+  if (entries_.size() >= maxEntries_) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  lru_.push_front(key);
+  entries_.emplace(std::move(key), Entry{re, lru_.begin()});
+  return re;
+}
+
+size_t SharedReCache::size() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return entries_.size();
+}
+
+uint64_t SharedReCache::numHits() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numHits_;
+}
+
+void SharedReCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  numHits_ = 0;
+}
+
 Expected<RE2*> ReCache::tryFindOrCompile(const StringView& pattern) {
   const std::string key = pattern;
 
@@ -48,7 +112,8 @@ Expected<RE2*> ReCache::tryFindOrCompile(const StringView& pattern) {
         Status::UserError("Max number of regex reached"));
   }
 
-  auto re = std::make_unique<RE2>(toStringPiece(pattern), RE2::Quiet);
+  auto re = SharedReCache::instance().findOrCompile(
+      std::string_view(pattern), false /*dotNl*/);
   if (!re->ok()) {
     return folly::makeUnexpected(
         Status::UserError("invalid regular expression:{}", re->error()));
@@ -209,7 +274,9 @@ template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public exec::VectorFunction {
  public:
   explicit Re2MatchConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(detail::SharedReCache::instance().findOrCompile(
+            std::string_view(pattern),
+            false /*dotNl*/)) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -221,19 +288,19 @@ class Re2MatchConstantPattern final : public exec::VectorFunction {
     FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
     exec::LocalDecodedVector toSearch(context, *args[0], rows);
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception&) {
       context.setErrors(rows, std::current_exception());
       return;
     }
 
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-      result.set(i, Fn(toSearch->valueAt<StringView>(i), re_));
+      result.set(i, Fn(toSearch->valueAt<StringView>(i), *re_));
     });
   }
 
  private:
-  RE2 re_;
+  std::shared_ptr<RE2> re_;
 };
 
 template <bool (*Fn)(StringView, const RE2&)>
@@ -277,7 +344,10 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
   explicit Re2SearchAndExtractConstantPattern(
       StringView pattern,
       bool emptyNoMatch)
-      : re_(toStringPiece(pattern), RE2::Quiet), emptyNoMatch_(emptyNoMatch) {}
+      : re_(detail::SharedReCache::instance().findOrCompile(
+            std::string_view(pattern),
+            false /*dotNl*/)),
+        emptyNoMatch_(emptyNoMatch) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -292,7 +362,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
 
     // apply() will not be invoked if the selection is empty.
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception&) {
       context.setErrors(rows, std::current_exception());
       return;
@@ -306,7 +376,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         mustRefSourceStrings |=
-            re2Extract(result, i, re_, toSearch, groups, 0, emptyNoMatch_);
+            re2Extract(result, i, *re_, toSearch, groups, 0, emptyNoMatch_);
       });
       if (mustRefSourceStrings) {
         result.acquireSharedStringBuffers(toSearch->base());
@@ -316,7 +386,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
 
     if (const auto groupId = getIfConstant<T>(*args[2])) {
       try {
-        checkForBadGroupId(*groupId, re_);
+        checkForBadGroupId(*groupId, *re_);
       } catch (const std::exception&) {
         context.setErrors(rows, std::current_exception());
         return;
@@ -325,7 +395,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
       groups.resize(*groupId + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         mustRefSourceStrings |= re2Extract(
-            result, i, re_, toSearch, groups, *groupId, emptyNoMatch_);
+            result, i, *re_, toSearch, groups, *groupId, emptyNoMatch_);
       });
       if (mustRefSourceStrings) {
         result.acquireSharedStringBuffers(toSearch->base());
@@ -337,12 +407,12 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
     // number of capturing groups + 1.
     exec::LocalDecodedVector groupIds(context, *args[2], rows);
 
-    groups.resize(re_.NumberOfCapturingGroups() + 1);
+    groups.resize(re_->NumberOfCapturingGroups() + 1);
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
       T group = groupIds->valueAt<T>(i);
-      checkForBadGroupId(group, re_);
+      checkForBadGroupId(group, *re_);
       mustRefSourceStrings |=
-          re2Extract(result, i, re_, toSearch, groups, group, emptyNoMatch_);
+          re2Extract(result, i, *re_, toSearch, groups, group, emptyNoMatch_);
     });
     if (mustRefSourceStrings) {
       result.acquireSharedStringBuffers(toSearch->base());
@@ -350,7 +420,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
   }
 
  private:
-  RE2 re_;
+  std::shared_ptr<RE2> re_;
   const bool emptyNoMatch_;
 };
 
@@ -642,12 +712,14 @@ bool matchSuffixPattern(
           length) == 0;
 }
 
+// Matches LIKE '%foo%'. Scans 'input' for the first and last byte of the
+// pattern a SIMD batch of positions at a time.
 bool matchSubstringPattern(
     const StringView& input,
     const std::string& fixedPattern) {
-  return (
-      std::string_view(input).find(std::string_view(fixedPattern)) !=
-      std::string::npos);
+  return simd::findSubstring(
+             std::string_view(input), std::string_view(fixedPattern)) !=
+      std::string_view::npos;
 }
 
 // Return true if the input VARCHAR argument is all-ASCII for the specified
@@ -805,11 +877,8 @@ class OptimizedLike final : public exec::VectorFunction {
 class LikeWithRe2 final : public exec::VectorFunction {
  public:
   LikeWithRe2(StringView pattern, std::optional<char> escapeChar) {
-    RE2::Options opt{RE2::Quiet};
-    opt.set_dot_nl(true);
-    re_.emplace(
-        toStringPiece(likePatternToRe2(pattern, escapeChar, validPattern_)),
-        opt);
+    re_ = detail::SharedReCache::instance().findOrCompile(
+        likePatternToRe2(pattern, escapeChar, validPattern_), true /*dotNl*/);
   }
 
   void apply(
@@ -861,7 +930,7 @@ class LikeWithRe2 final : public exec::VectorFunction {
   }
 
  private:
-  std::optional<RE2> re_;
+  std::shared_ptr<RE2> re_;
   bool validPattern_;
 };
 
@@ -997,9 +1066,8 @@ class LikeGeneric final : public exec::VectorFunction {
         validEscapeUsage,
         "Escape character must be followed by '%', '_' or the escape character itself");
 
-    RE2::Options opt{RE2::Quiet};
-    opt.set_dot_nl(true);
-    auto re = std::make_unique<RE2>(toStringPiece(regex), opt);
+    auto re =
+        detail::SharedReCache::instance().findOrCompile(regex, true /*dotNl*/);
     checkForBadPattern(*re);
 
     auto [it, inserted] =
@@ -1011,7 +1079,7 @@ class LikeGeneric final : public exec::VectorFunction {
 
   mutable folly::F14FastMap<
       std::pair<std::string, std::optional<char>>,
-      std::unique_ptr<RE2>>
+      std::shared_ptr<RE2>>
       compiledRegularExpressions_;
 };
 
@@ -1052,7 +1120,9 @@ template <typename T>
 class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
  public:
   explicit Re2ExtractAllConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(detail::SharedReCache::instance().findOrCompile(
+            std::string_view(pattern),
+            false /*dotNl*/)) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -1062,7 +1132,7 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
       VectorPtr& resultRef) const final {
     VELOX_CHECK(args.size() == 2 || args.size() == 3);
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception&) {
       context.setErrors(rows, std::current_exception());
       return;
@@ -1081,13 +1151,13 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
       //
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, 0);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, 0);
       });
     } else if (const auto _groupId = getIfConstant<T>(*args[2])) {
       // Case 2: Constant groupId
       //
       try {
-        checkForBadGroupId(*_groupId, re_);
+        checkForBadGroupId(*_groupId, *re_);
       } catch (const std::exception&) {
         context.setErrors(rows, std::current_exception());
         return;
@@ -1095,18 +1165,18 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
 
       groups.resize(*_groupId + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, *_groupId);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, *_groupId);
       });
     } else {
       // Case 3: Variable groupId, so resize the groups vector to accommodate
       // number of capturing groups + 1.
       exec::LocalDecodedVector groupIds(context, *args[2], rows);
 
-      groups.resize(re_.NumberOfCapturingGroups() + 1);
+      groups.resize(re_->NumberOfCapturingGroups() + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
         const T groupId = groupIds->valueAt<T>(row);
-        checkForBadGroupId(groupId, re_);
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, groupId);
+        checkForBadGroupId(groupId, *re_);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, groupId);
       });
     }
 
@@ -1119,7 +1189,7 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
   }
 
  private:
-  RE2 re_;
+  std::shared_ptr<RE2> re_;
 };
 
 template <typename T>
@@ -1422,8 +1492,7 @@ class RegexpReplaceWithLambdaFunction : public exec::VectorFunction {
   // sizes   = [3, 4, 3, 7]
   struct Matches {
     // Number of matches per top-level row. Each match has one row in 'matches'
-    // vector.
-    BufferPtr numMatches;
+    // vector. Allocated from the scratch arena of the EvalCtx.
     vector_size_t* rawNumMatches;
 
     // Each row correctsponds to a single match in a top-level row and contains
@@ -1440,7 +1509,10 @@ class RegexpReplaceWithLambdaFunction : public exec::VectorFunction {
     BufferPtr sizes;
     vector_size_t* rawSizes;
 
-    Matches(vector_size_t maxInputStrings, memory::MemoryPool* pool) {
+    Matches(
+        vector_size_t maxInputStrings,
+        memory::MemoryPool* pool,
+        ScratchArena& arena) {
       // Each input string may have 0..N matches. Each match has 0..M matching
       // groups. This array has one row per match (N rows), each row is an array
       // of 0..M matching groups. When regex is non-constant, the number of
@@ -1453,8 +1525,8 @@ class RegexpReplaceWithLambdaFunction : public exec::VectorFunction {
       matches = BaseVector::create<ArrayVector>(
           ARRAY(VARCHAR()), initialNumMatches, pool);
 
-      numMatches = allocateSizes(maxInputStrings, pool);
-      rawNumMatches = numMatches->asMutable<vector_size_t>();
+      rawNumMatches = arena.allocate<vector_size_t>(maxInputStrings);
+      std::fill(rawNumMatches, rawNumMatches + maxInputStrings, 0);
 
       offsets = allocateOffsets(initialNumMatches, pool);
       rawOffsets = offsets->asMutable<vector_size_t>();
@@ -1492,7 +1564,7 @@ class RegexpReplaceWithLambdaFunction : public exec::VectorFunction {
       exec::EvalCtx& context) const {
     auto* pool = context.pool();
 
-    Matches matches(rows.end(), pool);
+    Matches matches(rows.end(), pool, context.scratchArena());
 
     exec::VectorWriter<Array<Varchar>> matchesArrayWriter;
     matchesArrayWriter.init(*matches.matches);
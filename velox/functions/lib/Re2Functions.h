@@ -15,7 +15,9 @@
  */
 #pragma once
 
+#include <list>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <re2/re2.h>
@@ -239,8 +241,56 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> re2ExtractAllSignatures();
 
 namespace detail {
 
-// A cache of compiled regular expressions (RE2 instances). Allows up to
-// 'kMaxCompiledRegexes' different expressions.
+// A process-wide cache of compiled regular expressions shared by all function
+// instances and threads of execution. Keyed by the pattern and the options the
+// functions in this file compile with. Keeps up to 'maxEntries' expressions and
+// evicts the least recently used ones. Evicted expressions stay valid as long
+// as a function instance holds on to them. RE2 instances are thread-safe, so
+// the same instance can be used by several drivers at once.
+//
+// Invalid patterns are cached as well. Callers check RE2::ok().
+class SharedReCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 1'000;
+
+  explicit SharedReCache(size_t maxEntries = kDefaultMaxEntries)
+      : maxEntries_(maxEntries) {}
+
+  static SharedReCache& instance();
+
+  // Returns the compiled 'pattern'. If 'dotNl' is true, '.' also matches a new
+  // line, as in the translation of a LIKE pattern.
+  std::shared_ptr<RE2> findOrCompile(std::string_view pattern, bool dotNl);
+
+  size_t size() const;
+
+  // Number of calls to findOrCompile() that did not compile.
+  uint64_t numHits() const;
+
+  void clear();
+
+ private:
+  struct Entry {
+    std::shared_ptr<RE2> re;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  const size_t maxEntries_;
+
+  mutable std::mutex mutex_;
+
+  // Keys, most recently used first.
+  std::list<std::string> lru_;
+
+  folly::F14FastMap<std::string, Entry> entries_;
+
+  uint64_t numHits_{0};
+};
+
+// A cache of compiled regular expressions (RE2 instances) used by one function
+// instance. Allows up to 'kMaxCompiledRegexes' different expressions. Compiled
+// expressions come from SharedReCache, so the same pattern is compiled once
+// for all instances.
 //
 // Compiling regular expressions is expensive. It can take up to 200 times
 // more CPU time to compile a regex vs. evaluate it.
@@ -251,7 +301,7 @@ class ReCache {
   Expected<RE2*> tryFindOrCompile(const StringView& pattern);
 
  private:
-  folly::F14FastMap<std::string, std::unique_ptr<RE2>> cache_;
+  folly::F14FastMap<std::string, std::shared_ptr<RE2>> cache_;
 };
 
 } // namespace detail
@@ -282,7 +332,8 @@ struct Re2RegexpReplace {
       const arg_type<Varchar>* replacement) {
     if (pattern != nullptr) {
       const auto processedPattern = prepareRegexpPattern(*pattern);
-      re_.emplace(processedPattern, RE2::Quiet);
+      re_ = detail::SharedReCache::instance().findOrCompile(
+          processedPattern, false /*dotNl*/);
       VELOX_USER_CHECK(
           re_->ok(),
           "Invalid regular expression {}: {}.",
@@ -294,7 +345,7 @@ struct Re2RegexpReplace {
       // Constant 'replacement' with non-constant 'pattern' needs to be
       // processed separately for each row.
       if (pattern != nullptr) {
-        ensureProcessedReplacement(re_.value(), *replacement);
+        ensureProcessedReplacement(*re_, *replacement);
         constantReplacement_ = true;
       }
     }
@@ -325,11 +376,11 @@ struct Re2RegexpReplace {
 
  private:
   RE2& ensurePattern(const arg_type<Varchar>& pattern) {
-    if (!re_.has_value()) {
+    if (re_ == nullptr) {
       auto processedPattern = prepareRegexpPattern(pattern);
       return *cache_.findOrCompile(StringView(processedPattern));
     } else {
-      return re_.value();
+      return *re_;
     }
   }
 
@@ -344,7 +395,7 @@ struct Re2RegexpReplace {
   }
 
   // Used when pattern is constant.
-  std::optional<RE2> re_;
+  std::shared_ptr<RE2> re_;
 
   // True if replacement is constant.
   bool constantReplacement_{false};
@@ -25,7 +25,21 @@ BufferPtr getElementToTopLevelRows(
     const uint64_t* rawNulls,
     memory::MemoryPool* pool) {
   auto toTopLevelRows = allocateIndices(numElements, pool);
-  auto rawToTopLevelRows = toTopLevelRows->asMutable<vector_size_t>();
+  getElementToTopLevelRows(
+      topLevelRows,
+      rawOffsets,
+      rawSizes,
+      rawNulls,
+      toTopLevelRows->asMutable<vector_size_t>());
+  return toTopLevelRows;
+}
+
+void getElementToTopLevelRows(
+    const SelectivityVector& topLevelRows,
+    const vector_size_t* rawOffsets,
+    const vector_size_t* rawSizes,
+    const uint64_t* rawNulls,
+    vector_size_t* result) {
   topLevelRows.applyToSelected([&](vector_size_t row) {
     if (rawNulls && bits::isBitNull(rawNulls, row)) {
       return;
@@ -33,10 +47,9 @@ BufferPtr getElementToTopLevelRows(
     auto size = rawSizes[row];
     auto offset = rawOffsets[row];
     for (int i = 0; i < size; ++i) {
-      rawToTopLevelRows[offset + i] = row;
+      result[offset + i] = row;
     }
   });
-  return toTopLevelRows;
 }
 
 } // namespace facebook::velox::functions
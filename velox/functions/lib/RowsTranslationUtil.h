@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/common/base/Nulls.h"
+#include "velox/common/base/Scratch.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/SelectivityVector.h"
 
@@ -63,6 +64,16 @@ BufferPtr getElementToTopLevelRows(
     const uint64_t* rawNulls,
     memory::MemoryPool* pool);
 
+/// Like above, but writes the mapping into 'result', which has space for
+/// 'numElements' entries. Entries of elements outside of 'topLevelRows' are
+/// left unchanged.
+void getElementToTopLevelRows(
+    const SelectivityVector& topLevelRows,
+    const vector_size_t* rawOffsets,
+    const vector_size_t* rawSizes,
+    const uint64_t* rawNulls,
+    vector_size_t* result);
+
 template <typename T>
 BufferPtr getElementToTopLevelRows(
     vector_size_t numElements,
@@ -77,4 +88,24 @@ BufferPtr getElementToTopLevelRows(
       numElements, topLevelRows, rawOffsets, rawSizes, rawNulls, pool);
 }
 
+/// Returns the mapping from the elements of 'topLevelVector' to its rows in
+/// space allocated from 'arena'. The mapping is valid until 'arena' is
+/// rewound. Only the entries of the elements of 'topLevelRows' are set. Used
+/// for temporary mappings to avoid allocating from a pool.
+template <typename T>
+const vector_size_t* getElementToTopLevelRows(
+    vector_size_t numElements,
+    const SelectivityVector& topLevelRows,
+    const T* topLevelVector,
+    ScratchArena& arena) {
+  auto* result = arena.allocate<vector_size_t>(numElements);
+  getElementToTopLevelRows(
+      topLevelRows,
+      topLevelVector->rawOffsets(),
+      topLevelVector->rawSizes(),
+      topLevelVector->rawNulls(),
+      result);
+  return result;
+}
+
 } // namespace facebook::velox::functions
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::functions {
+
+/// True if T is a fixed-width type that SegmentedRadixSort can sort by its
+/// bytes.
+template <typename T>
+inline constexpr bool kRadixSortable =
+    (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+    std::is_same_v<T, int128_t> || std::is_floating_point_v<T>;
+
+/// Sorts the elements of all the arrays of a vector together instead of
+/// sorting each array on its own, which is dominated by per-array setup for
+/// vectors of many short arrays. The non-null elements of the selected arrays
+/// are flattened in row order, radix sorted by value across arrays with one
+/// stable pass per byte of the value, skipping the bytes that are the same
+/// for all elements, and grouped back by array with one more stable pass.
+///
+/// The non-null elements are identified by their position in the flattened
+/// order. The positions of the elements of 'row' are [start(row), end(row))
+/// and are in the order of the elements in the array. After sorting,
+/// sortedPositions()[start(row)...end(row)) are the same positions in the
+/// order of their values. Equal values keep the order of their positions.
+///
+/// Floating point values are ordered like NaNAwareLessThan: NaNs are equal to
+/// each other and larger than all the other values. -0.0 is equal to 0.0.
+template <typename T>
+class SegmentedRadixSort {
+ public:
+  static_assert(
+      kRadixSortable<T>,
+      "SegmentedRadixSort requires a fixed-width type");
+
+  /// Unsigned integer of the same size as T whose order is the order of T.
+  using Key = std::conditional_t<
+      sizeof(T) == 1,
+      uint8_t,
+      std::conditional_t<
+          sizeof(T) == 2,
+          uint16_t,
+          std::conditional_t<
+              sizeof(T) == 4,
+              uint32_t,
+              std::conditional_t<sizeof(T) == 8, uint64_t, uint128_t>>>>;
+
+  /// Sorts the non-null elements of the arrays of 'arrays' in 'rows' by
+  /// value. 'elements' is the decoded elements of 'arrays'. The sort is
+  /// descending if 'ascending' is false.
+  void sort(
+      const SelectivityVector& rows,
+      const ArrayVector& arrays,
+      DecodedVector& elements,
+      bool ascending) {
+    sort(rows, arrays, elements, ascending, [](auto row) { return row; });
+  }
+
+  /// Same as above for arrays that are referenced through a dictionary, e.g.
+  /// decoded arrays. 'arrayIndex' maps a row to the index of its array in
+  /// 'arrays'.
+  template <typename TArrayIndex>
+  void sort(
+      const SelectivityVector& rows,
+      const ArrayVector& arrays,
+      DecodedVector& elements,
+      bool ascending,
+      TArrayIndex arrayIndex) {
+    const auto numRows = rows.end();
+    vector_size_t maxPositions = 0;
+    rows.applyToSelected(
+        [&](auto row) { maxPositions += arrays.sizeAt(arrayIndex(row)); });
+
+    starts_.resize(numRows + 1);
+    elementIndices_.resize(maxPositions);
+    positionRows_.resize(maxPositions);
+    keys_.resize(maxPositions);
+
+    vector_size_t numPositions = 0;
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      starts_[row] = numPositions;
+      if (!rows.isValid(row)) {
+        continue;
+      }
+      const auto array = arrayIndex(row);
+      const auto offset = arrays.offsetAt(array);
+      const auto size = arrays.sizeAt(array);
+      for (auto i = offset; i < offset + size; ++i) {
+        if (elements.isNullAt(i)) {
+          continue;
+        }
+        const auto key = toKey(elements.valueAt<T>(i));
+        keys_[numPositions] = ascending ? key : static_cast<Key>(~key);
+        elementIndices_[numPositions] = i;
+        positionRows_[numPositions] = row;
+        ++numPositions;
+      }
+    }
+    starts_[numRows] = numPositions;
+
+    sortKeys(numPositions);
+  }
+
+  /// Returns the first position of 'row'.
+  vector_size_t start(vector_size_t row) const {
+    return starts_[row];
+  }
+
+  /// Returns the position after the last position of 'row'.
+  vector_size_t end(vector_size_t row) const {
+    return starts_[row + 1];
+  }
+
+  /// Returns the number of positions of all rows.
+  vector_size_t numPositions() const {
+    return starts_.back();
+  }
+
+  /// Returns the index in the elements vector of the element at 'position'.
+  vector_size_t elementIndex(vector_size_t position) const {
+    return elementIndices_[position];
+  }
+
+  /// Returns the positions of each row in the order of their values.
+  const vector_size_t* sortedPositions() const {
+    return sortedPositions_.data();
+  }
+
+  /// Returns the keys of the values at sortedPositions(). Equal keys mean
+  /// equal values.
+  const Key* sortedKeys() const {
+    return sortedKeys_.data();
+  }
+
+  /// Sets the bits in 'distinct' of the positions of 'row' whose value does
+  /// not appear at an earlier position of 'row'.
+  void markDistinct(vector_size_t row, uint64_t* distinct) const {
+    for (auto i = start(row); i < end(row); ++i) {
+      if (i == start(row) || sortedKeys_[i] != sortedKeys_[i - 1]) {
+        bits::setBit(distinct, sortedPositions_[i]);
+      }
+    }
+  }
+
+  /// Converts 'value' to an unsigned integer with the same order.
+  static Key toKey(T value) {
+    constexpr Key kSignBit = Key(1) << (sizeof(Key) * 8 - 1);
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) {
+        value = std::numeric_limits<T>::quiet_NaN();
+      } else if (value == 0) {
+        value = 0;
+      }
+      Key bits;
+      std::memcpy(&bits, &value, sizeof(T));
+      return (bits & kSignBit) ? static_cast<Key>(~bits) : bits | kSignBit;
+    } else if constexpr (std::is_signed_v<T> || std::is_same_v<T, int128_t>) {
+      return static_cast<Key>(value) ^ kSignBit;
+    } else {
+      return static_cast<Key>(value);
+    }
+  }
+
+ private:
+  static constexpr int32_t kNumBytes = sizeof(Key);
+
+  // Sorts 'keys_' and the positions of the keys by key with one stable
+  // counting sort per byte, least significant byte first, then by row with
+  // one more stable counting sort.
+  void sortKeys(vector_size_t numPositions) {
+    sortedPositions_.resize(numPositions);
+    sortedKeys_.resize(numPositions);
+    if (numPositions == 0) {
+      return;
+    }
+
+    std::vector<vector_size_t> counts(kNumBytes * 256, 0);
+    for (auto i = 0; i < numPositions; ++i) {
+      auto key = keys_[i];
+      for (auto byte = 0; byte < kNumBytes; ++byte) {
+        ++counts[byte * 256 + static_cast<uint8_t>(key >> (byte * 8))];
+      }
+    }
+
+    std::vector<vector_size_t> positions(numPositions);
+    for (auto i = 0; i < numPositions; ++i) {
+      positions[i] = i;
+    }
+    std::vector<vector_size_t> otherPositions(numPositions);
+    std::vector<Key> otherKeys(numPositions);
+    for (auto byte = 0; byte < kNumBytes; ++byte) {
+      auto* byteCounts = &counts[byte * 256];
+      const auto shift = byte * 8;
+      if (byteCounts[static_cast<uint8_t>(keys_[0] >> shift)] ==
+          numPositions) {
+        // All keys have the same value of this byte.
+        continue;
+      }
+      vector_size_t offset = 0;
+      for (auto i = 0; i < 256; ++i) {
+        const auto count = byteCounts[i];
+        byteCounts[i] = offset;
+        offset += count;
+      }
+      for (auto i = 0; i < numPositions; ++i) {
+        const auto bucket = static_cast<uint8_t>(keys_[i] >> shift);
+        const auto target = byteCounts[bucket]++;
+        otherKeys[target] = keys_[i];
+        otherPositions[target] = positions[i];
+      }
+      std::swap(positions, otherPositions);
+      std::swap(keys_, otherKeys);
+    }
+
+    // Groups the sorted positions by row. The positions of a row start at
+    // starts_[row].
+    std::vector<vector_size_t> cursors(starts_.begin(), starts_.end() - 1);
+    for (auto i = 0; i < numPositions; ++i) {
+      const auto target = cursors[positionRows_[positions[i]]]++;
+      sortedPositions_[target] = positions[i];
+      sortedKeys_[target] = keys_[i];
+    }
+  }
+
+  // The first position of each row. Has one more entry than the number of
+  // rows.
+  std::vector<vector_size_t> starts_;
+
+  // The index in the elements vector and the row of each position.
+  std::vector<vector_size_t> elementIndices_;
+  std::vector<vector_size_t> positionRows_;
+
+  // The key of each position.
+  std::vector<Key> keys_;
+
+  std::vector<vector_size_t> sortedPositions_;
+  std::vector<Key> sortedKeys_;
+};
+
+} // namespace facebook::velox::functions
@@ -47,9 +47,14 @@ getSeconds(Timestamp timestamp, const date::time_zone* timeZone) {
   }
 }
 
-FOLLY_ALWAYS_INLINE
-std::tm getDateTime(Timestamp timestamp, const date::time_zone* timeZone) {
-  int64_t seconds = getSeconds(timestamp, timeZone);
+/// Same as above, but converts with the offsets cached in 'timeZone'.
+FOLLY_ALWAYS_INLINE int64_t
+getSeconds(Timestamp timestamp, TimeZoneOffsetCache& timeZone) {
+  timeZone.toTimezone(timestamp);
+  return timestamp.getSeconds();
+}
+
+FOLLY_ALWAYS_INLINE std::tm getDateTimeFromSeconds(int64_t seconds) {
   std::tm dateTime;
   VELOX_USER_CHECK(
       Timestamp::epochToCalendarUtc(seconds, dateTime),
@@ -58,6 +63,17 @@ std::tm getDateTime(Timestamp timestamp, const date::time_zone* timeZone) {
   return dateTime;
 }
 
+FOLLY_ALWAYS_INLINE
+std::tm getDateTime(Timestamp timestamp, const date::time_zone* timeZone) {
+  return getDateTimeFromSeconds(getSeconds(timestamp, timeZone));
+}
+
+/// Same as above, but converts with the offsets cached in 'timeZone'.
+FOLLY_ALWAYS_INLINE
+std::tm getDateTime(Timestamp timestamp, TimeZoneOffsetCache& timeZone) {
+  return getDateTimeFromSeconds(getSeconds(timestamp, timeZone));
+}
+
 // days is the number of days since Epoch.
 FOLLY_ALWAYS_INLINE
 std::tm getDateTime(int32_t days) {
@@ -96,12 +112,14 @@ template <typename T>
 struct InitSessionTimezone {
   VELOX_DEFINE_FUNCTION_TYPES(T);
   const date::time_zone* timeZone_{nullptr};
+  TimeZoneOffsetCache timeZoneCache_;
 
   FOLLY_ALWAYS_INLINE void initialize(
       const std::vector<TypePtr>& /*inputTypes*/,
       const core::QueryConfig& config,
       const arg_type<Timestamp>* /*timestamp*/) {
     timeZone_ = getTimeZoneFromConfig(config);
+    timeZoneCache_ = TimeZoneOffsetCache(timeZone_);
   }
 };
 } // namespace facebook::velox::functions
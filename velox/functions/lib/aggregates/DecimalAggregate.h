@@ -138,10 +138,15 @@ class DecimalAggregate : public exec::Aggregate {
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
       LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
+      if (rows.isAllSelected()) {
+        accumulator.overflow = DecimalUtil::sumWithOverflow(
+            accumulator.sum, data + rows.begin(), rows.end() - rows.begin());
+      } else {
+        rows.applyToSelected([&](vector_size_t i) {
+          accumulator.overflow += DecimalUtil::addWithOverflow(
+              accumulator.sum, data[i], accumulator.sum);
+        });
+      }
       accumulator.count = rows.countSelected();
       char rawData[LongDecimalWithOverflowState::serializedSize()];
       StringView serialized(
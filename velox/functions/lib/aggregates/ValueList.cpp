@@ -61,19 +61,37 @@ void ValueList::appendNonNull(
     vector_size_t index,
     HashStringAllocator* allocator) {
   prepareAppend(allocator);
+  writeNonNulls(values, folly::Range(&index, 1), allocator);
+}
+
+void ValueList::writeNonNulls(
+    const BaseVector& values,
+    folly::Range<const vector_size_t*> indices,
+    HashStringAllocator* allocator) {
+  auto* const lastHeader = dataCurrent_.header;
   ByteOutputStream stream(allocator);
   allocator->extendWrite(dataCurrent_, stream);
   // The stream may have a tail of a previous write.
   const auto initialSize = stream.size();
   static const exec::ContainerRowSerdeOptions options{};
-  exec::ContainerRowSerde::serialize(values, index, stream, options);
-  ++size_;
+  exec::ContainerRowSerde::serialize(values, indices, stream, options);
+  size_ += indices.size();
   bytes_ += stream.size() - initialSize;
 
   // Leave space up to half the size appended so far, at least 24 but no more
   // than 1024.
-  dataCurrent_ =
-      allocator->finishWrite(stream, std::clamp(bytes_ / 2, 24, 1024)).second;
+  const auto reserve = std::clamp(bytes_ / 2, 24, 1024);
+  dataCurrent_ = allocator->finishWrite(stream, reserve).second;
+
+  // A new part may come from a small free block. Small lists are copied into
+  // one block when they grow a new part so that they do not end up as chains
+  // of tiny fragments. The reserve grows with the list, so the copies are
+  // amortized over the appends.
+  if (dataCurrent_.header != lastHeader && bytes_ <= kMaxCompactBytes) {
+    const auto offset = HashStringAllocator::offset(dataBegin_, dataCurrent_);
+    dataBegin_ = allocator->compact(dataBegin_, offset, reserve);
+    dataCurrent_ = HashStringAllocator::Position::atOffset(dataBegin_, offset);
+  }
 }
 
 void ValueList::appendValue(
@@ -93,12 +111,24 @@ void ValueList::appendRange(
     vector_size_t offset,
     vector_size_t size,
     HashStringAllocator* allocator) {
-  for (auto index = offset; index < offset + size; ++index) {
+  const auto end = offset + size;
+  std::vector<vector_size_t> indices;
+  for (auto index = offset; index < end;) {
     if (vector->isNullAt(index)) {
       appendNull(allocator);
-    } else {
-      appendNonNull(*vector, index, allocator);
+      ++index;
+      continue;
+    }
+    // Appends the run of non-null values up to the next null or to the end
+    // of the current word of null flags with one write.
+    prepareAppend(allocator);
+    const auto maxRun = 64 - size_ % 64;
+    indices.clear();
+    while (index < end && indices.size() < maxRun &&
+           !vector->isNullAt(index)) {
+      indices.push_back(index++);
     }
+    writeNonNulls(*vector, indices, allocator);
   }
 }
 
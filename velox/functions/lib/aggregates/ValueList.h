@@ -86,6 +86,10 @@ class ValueList {
   // sizes for lots of small arrays.
   static constexpr int kInitialSize = 44;
 
+  // Data allocations up to this size are compacted into a single block when
+  // they grow a new part.
+  static constexpr int32_t kMaxCompactBytes = HashStringAllocator::kMaxAlloc;
+
   void appendNull(HashStringAllocator* allocator);
 
   void appendNonNull(
@@ -93,6 +97,14 @@ class ValueList {
       vector_size_t index,
       HashStringAllocator* allocator);
 
+  // Writes the non-null values of 'vector' at 'indices' to the 'data' block.
+  // The values must fit in the current word of null flags. prepareAppend()
+  // must be called before.
+  void writeNonNulls(
+      const BaseVector& vector,
+      folly::Range<const vector_size_t*> indices,
+      HashStringAllocator* allocator);
+
   void prepareAppend(HashStringAllocator* allocator);
 
   // Writes lastNulls_ word to the 'nulls' block.
@@ -141,3 +141,34 @@ TEST_F(ValueListTest, arrays) {
     }
   }
 }
+
+TEST_F(ValueListTest, compact) {
+  // Appends to many lists in turn, as an aggregation does, after leaving small
+  // free blocks in the allocator. Small lists stay in one block.
+  std::vector<HashStringAllocator::Header*> blocks;
+  for (auto i = 0; i < 1'000; ++i) {
+    blocks.push_back(allocator()->allocate(HashStringAllocator::kMinAlloc));
+  }
+  for (auto i = 0; i < blocks.size(); i += 2) {
+    allocator()->free(blocks[i]);
+  }
+
+  constexpr int32_t kNumLists = 10;
+  constexpr vector_size_t kSize = 200;
+  auto data =
+      makeFlatVector<int64_t>(kNumLists * kSize, [](auto row) { return row; });
+  std::vector<aggregate::ValueList> lists(kNumLists);
+  for (auto i = 0; i < kSize; ++i) {
+    for (auto j = 0; j < kNumLists; ++j) {
+      lists[j].appendRange(data, j * kSize + i, 1, allocator());
+    }
+  }
+  allocator()->checkConsistency();
+
+  for (auto j = 0; j < kNumLists; ++j) {
+    ASSERT_FALSE(lists[j].dataBegin()->isContinued());
+    assertEqualVectors(
+        data->slice(j * kSize, kSize), read(lists[j], BIGINT(), kSize));
+    lists[j].free(allocator());
+  }
+}
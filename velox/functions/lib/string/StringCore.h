@@ -48,7 +48,25 @@ namespace stringCore {
 static bool isAscii(const char* str, size_t length);
 
 FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
+  // Tests the high bits of 32 bytes at a time, then of 8 bytes at a time.
+  // The loads are done with memcpy since 'str' may not be aligned.
+  constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    uint64_t words[4];
+    std::memcpy(words, str + i, sizeof(words));
+    if ((words[0] | words[1] | words[2] | words[3]) & kHighBits) {
+      return false;
+    }
+  }
+  for (; i + 8 <= length; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, str + i, sizeof(word));
+    if (word & kHighBits) {
+      return false;
+    }
+  }
+  for (; i < length; i++) {
     if (str[i] & 0x80) {
       return false;
     }
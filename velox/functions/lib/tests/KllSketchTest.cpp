@@ -306,6 +306,68 @@ TEST_F(KllSketchTest, compact) {
   }
 }
 
+TEST_F(KllSketchTest, compactMemoryUsage) {
+  KllSketch<double> kll(kFromEpsilon(0.001), {}, 0);
+  for (int i = 0; i < 1e5; ++i) {
+    kll.insert(i % 100);
+  }
+  auto memoryUsage = kll.memoryUsage();
+  auto q = linspace(11);
+  kll.finish();
+  auto v = kll.estimateQuantiles(folly::Range(q.begin(), q.end()));
+
+  kll.compact();
+  EXPECT_LT(kll.memoryUsage(), memoryUsage / 4);
+  EXPECT_EQ(v, kll.estimateQuantiles(folly::Range(q.begin(), q.end())));
+
+  // The compacted sketch keeps accepting values.
+  for (int i = 0; i < 1e5; ++i) {
+    kll.insert(i % 100);
+  }
+  kll.finish();
+  EXPECT_EQ(kll.totalCount(), 2e5);
+  auto v2 = kll.estimateQuantiles(folly::Range(q.begin(), q.end()));
+  for (int i = 0; i < q.size(); ++i) {
+    EXPECT_NEAR(v[i], v2[i], 1);
+  }
+}
+
+TEST_F(KllSketchTest, compactMaxBytes) {
+  constexpr int N = 1e5;
+  constexpr int M = 101;
+  constexpr size_t kMaxBytes = 8 << 10;
+  KllSketch<double> kll(kFromEpsilon(0.001), {}, 0);
+  for (int i = 0; i < N; ++i) {
+    kll.insert(i);
+  }
+  // Distinct values cannot be merged losslessly.
+  auto kll2 = kll;
+  kll2.compact();
+  EXPECT_GT(kll2.serializedByteSize(), 4 * kMaxBytes);
+
+  kll.compact(kMaxBytes);
+  EXPECT_LE(kll.serializedByteSize(), kMaxBytes);
+  EXPECT_EQ(kll.totalCount(), N);
+  auto q = linspace(M);
+  auto v = kll.estimateQuantiles(folly::Range(q.begin(), q.end()));
+  ASSERT_TRUE(std::is_sorted(std::begin(v), std::end(v)));
+  for (int i = 0; i < M; ++i) {
+    EXPECT_NEAR(q[i], v[i] / N, 2 * kEpsilon);
+  }
+
+  // The down-sampled sketch keeps accepting values.
+  for (int i = N; i < 2 * N; ++i) {
+    kll.insert(i);
+  }
+  kll.compact(kMaxBytes);
+  EXPECT_LE(kll.serializedByteSize(), kMaxBytes);
+  EXPECT_EQ(kll.totalCount(), 2 * N);
+  v = kll.estimateQuantiles(folly::Range(q.begin(), q.end()));
+  for (int i = 0; i < M; ++i) {
+    EXPECT_NEAR(q[i], v[i] / (2 * N), 2 * kEpsilon);
+  }
+}
+
 TEST_F(KllSketchTest, growCompacted) {
   constexpr int N = 1000;
   constexpr int M = 101;
@@ -916,6 +916,16 @@ TEST_F(Re2FunctionsTest, likeSubstringPattern) {
       generateString(kAnyWildcardCharacter) + input +
           generateString(kAnyWildcardCharacter),
       true);
+
+  // Inputs longer than a SIMD batch with the match at different offsets and
+  // partial matches that share the first and last character.
+  auto data = makeRowVector({makeFlatVector<std::string>(100, [](auto row) {
+    return std::string(row, 'n') + (row % 3 == 0 ? "needle" : "neeeee") +
+        std::string(row % 50, 'e');
+  })});
+  assertEqualVectors(
+      makeFlatVector<bool>(100, [](auto row) { return row % 3 == 0; }),
+      evaluate("like(c0, '%needle%')", data));
 }
 
 TEST_F(Re2FunctionsTest, nullConstantPatternOrEscape) {
@@ -1500,5 +1510,44 @@ TEST_F(Re2FunctionsTest, split) {
   assertEqualVectors(expected, result);
 }
 
+TEST_F(Re2FunctionsTest, sharedReCache) {
+  detail::SharedReCache cache(2);
+  auto a = cache.findOrCompile("a+", false);
+  ASSERT_TRUE(a->ok());
+  ASSERT_EQ(cache.findOrCompile("a+", false), a);
+  ASSERT_EQ(cache.numHits(), 1);
+
+  // Options are part of the key.
+  auto aDotNl = cache.findOrCompile("a+", true);
+  ASSERT_NE(aDotNl, a);
+  ASSERT_TRUE(aDotNl->options().dot_nl());
+  ASSERT_EQ(cache.size(), 2);
+
+  // Evicts the least recently used entry. Evicted expressions stay valid.
+  ASSERT_EQ(cache.findOrCompile("a+", false), a);
+  auto invalid = cache.findOrCompile("(", false);
+  ASSERT_FALSE(invalid->ok());
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_NE(cache.findOrCompile("a+", true), aDotNl);
+  ASSERT_TRUE(RE2::FullMatch("aa", *aDotNl));
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_EQ(cache.numHits(), 0);
+}
+
+TEST_F(Re2FunctionsTest, sharedReCacheAcrossInstances) {
+  auto& cache = detail::SharedReCache::instance();
+  auto data = makeRowVector({makeFlatVector<std::string>({"ab", "abab", "b"})});
+  const auto expected = makeFlatVector<bool>({true, true, false});
+
+  // Each evaluation creates a new function instance. The pattern is compiled
+  // only for the first one.
+  assertEqualVectors(expected, evaluate("re2_match(c0, '(ab)+')", data));
+  const auto numHits = cache.numHits();
+  assertEqualVectors(expected, evaluate("re2_match(c0, '(ab)+')", data));
+  ASSERT_GT(cache.numHits(), numHits);
+}
+
 } // namespace
 } // namespace facebook::velox::functions
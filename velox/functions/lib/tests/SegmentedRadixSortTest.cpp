@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/functions/lib/SegmentedRadixSort.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::functions::test {
+namespace {
+
+class SegmentedRadixSortTest : public testing::Test,
+                               public facebook::velox::test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Sorts the arrays of 'arrays' and returns the sorted non-null values of
+  // each array.
+  template <typename T>
+  std::vector<std::vector<T>> sort(
+      const VectorPtr& arrays,
+      bool ascending = true) {
+    auto* arrayVector = arrays->as<ArrayVector>();
+    SelectivityVector rows(arrays->size());
+    DecodedVector elements(*arrayVector->elements());
+    SegmentedRadixSort<T> sorter;
+    sorter.sort(rows, *arrayVector, elements, ascending);
+
+    std::vector<std::vector<T>> result(arrays->size());
+    for (auto row = 0; row < arrays->size(); ++row) {
+      for (auto i = sorter.start(row); i < sorter.end(row); ++i) {
+        result[row].push_back(elements.valueAt<T>(
+            sorter.elementIndex(sorter.sortedPositions()[i])));
+      }
+    }
+    return result;
+  }
+};
+
+TEST_F(SegmentedRadixSortTest, integers) {
+  auto arrays = makeNullableArrayVector<int64_t>(
+      {{3, -1, std::nullopt, 1'000'000'000'000, -5},
+       {},
+       {std::nullopt},
+       {7},
+       {2, 2, -2, 0, std::numeric_limits<int64_t>::min()}});
+
+  using Values = std::vector<std::vector<int64_t>>;
+  ASSERT_EQ(
+      sort<int64_t>(arrays),
+      (Values{
+          {-5, -1, 3, 1'000'000'000'000},
+          {},
+          {},
+          {7},
+          {std::numeric_limits<int64_t>::min(), -2, 0, 2, 2}}));
+  ASSERT_EQ(
+      sort<int64_t>(arrays, false),
+      (Values{
+          {1'000'000'000'000, 3, -1, -5},
+          {},
+          {},
+          {7},
+          {2, 2, 0, -2, std::numeric_limits<int64_t>::min()}}));
+
+  auto tinyints = makeArrayVector<int8_t>({{5, -128, 127, 0, -1}, {1, 1}});
+  ASSERT_EQ(
+      sort<int8_t>(tinyints),
+      (std::vector<std::vector<int8_t>>{{-128, -1, 0, 5, 127}, {1, 1}}));
+}
+
+TEST_F(SegmentedRadixSortTest, manyArrays) {
+  // Values that differ in all bytes and arrays of varying size.
+  auto arrays = makeArrayVector<int32_t>(
+      1'000,
+      [](vector_size_t row) { return row % 13; },
+      [](vector_size_t index) {
+        return static_cast<int32_t>((index * 2'654'435'761U) ^ 0x5bd1e995);
+      });
+
+  auto sorted = sort<int32_t>(arrays);
+  auto* arrayVector = arrays->as<ArrayVector>();
+  auto* elements = arrayVector->elements()->asFlatVector<int32_t>();
+  for (auto row = 0; row < arrays->size(); ++row) {
+    std::vector<int32_t> expected;
+    for (auto i = 0; i < arrayVector->sizeAt(row); ++i) {
+      expected.push_back(elements->valueAt(arrayVector->offsetAt(row) + i));
+    }
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(sorted[row], expected) << "row " << row;
+  }
+}
+
+TEST_F(SegmentedRadixSortTest, floatingPoint) {
+  constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+  constexpr double kInf = std::numeric_limits<double>::infinity();
+  auto arrays = makeArrayVector<double>(
+      {{1.5, kNaN, -kInf, -0.0, 0.0, kInf, -2.5}, {kNaN, -1.0}});
+
+  auto sorted = sort<double>(arrays);
+  ASSERT_EQ(sorted[0].size(), 7);
+  ASSERT_EQ(sorted[0][0], -kInf);
+  ASSERT_EQ(sorted[0][1], -2.5);
+  // -0.0 and 0.0 are equal and keep their order.
+  ASSERT_TRUE(std::signbit(sorted[0][2]));
+  ASSERT_FALSE(std::signbit(sorted[0][3]));
+  ASSERT_EQ(sorted[0][4], 1.5);
+  ASSERT_EQ(sorted[0][5], kInf);
+  ASSERT_TRUE(std::isnan(sorted[0][6]));
+  ASSERT_EQ(sorted[1][0], -1.0);
+  ASSERT_TRUE(std::isnan(sorted[1][1]));
+
+  sorted = sort<double>(arrays, false);
+  ASSERT_TRUE(std::isnan(sorted[0][0]));
+  ASSERT_EQ(sorted[0][6], -kInf);
+}
+
+TEST_F(SegmentedRadixSortTest, distinct) {
+  auto arrays = makeNullableArrayVector<int32_t>(
+      {{4, 1, 4, std::nullopt, 1, 2}, {3, 3, 3}, {}});
+  auto* arrayVector = arrays->as<ArrayVector>();
+  SelectivityVector rows(arrays->size());
+  DecodedVector elements(*arrayVector->elements());
+  SegmentedRadixSort<int32_t> sorter;
+  sorter.sort(rows, *arrayVector, elements, true);
+
+  std::vector<uint64_t> distinct(bits::nwords(sorter.numPositions()));
+  for (auto row = 0; row < arrays->size(); ++row) {
+    sorter.markDistinct(row, distinct.data());
+  }
+
+  // Positions skip the null element. The first occurrences are 4, 1 and 2 of
+  // the first array and the first 3 of the second array.
+  ASSERT_EQ(sorter.numPositions(), 8);
+  std::vector<bool> expected{
+      true, true, false, false, true, true, false, false};
+  for (auto i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(bits::isBitSet(distinct.data(), i), expected[i]) << i;
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::functions::test
@@ -250,7 +250,11 @@ void registerNtile(const std::string& name, const std::string& type) {
           const core::QueryConfig& /*queryConfig*/)
           -> std::unique_ptr<exec::WindowFunction> {
         return std::make_unique<NtileFunction<TResult>>(args, resultType, pool);
-      });
+      },
+      exec::WindowFunction::Metadata{
+          /*frameBoundedAccess=*/false,
+          /*usesFrames=*/false,
+          /*usesPeerGroups=*/false});
 }
 
 void registerNtileBigint(const std::string& name) {
@@ -109,7 +109,11 @@ void registerRankInternal(
           const core::QueryConfig& /*queryConfig*/)
           -> std::unique_ptr<exec::WindowFunction> {
         return std::make_unique<RankFunction<TRank, TResult>>(resultType);
-      });
+      },
+      exec::WindowFunction::Metadata{
+          /*frameBoundedAccess=*/false,
+          /*usesFrames=*/false,
+          /*usesPeerGroups=*/true});
 }
 
 void registerRankBigint(const std::string& name) {
@@ -84,7 +84,11 @@ void registerRowNumber(const std::string& name, TypeKind resultTypeKind) {
           const core::QueryConfig& /*queryConfig*/)
           -> std::unique_ptr<exec::WindowFunction> {
         return std::make_unique<RowNumberFunction>(resultType);
-      });
+      },
+      exec::WindowFunction::Metadata{
+          /*frameBoundedAccess=*/true,
+          /*usesFrames=*/false,
+          /*usesPeerGroups=*/false});
 }
 
 void registerRowNumberInteger(const std::string& name) {
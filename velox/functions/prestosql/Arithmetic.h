@@ -48,11 +48,24 @@ namespace {
 
 template <typename T>
 struct PlusFunction {
+  static constexpr bool is_commutative = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
     result = plus(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = plus(a[i], b[i]);
+    }
+  }
 };
 
 template <typename T>
@@ -62,15 +75,39 @@ struct MinusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = minus(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = minus(a[i], b[i]);
+    }
+  }
 };
 
 template <typename T>
 struct MultiplyFunction {
+  static constexpr bool is_commutative = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
     result = multiply(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = multiply(a[i], b[i]);
+    }
+  }
 };
 
 // Multiply function for IntervalDayTime * Double and Double * IntervalDayTime.
@@ -121,6 +158,17 @@ struct DivideFunction {
   {
     result = a / b;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = divide(a[i], b[i]);
+    }
+  }
 };
 
 template <typename T>
@@ -213,6 +261,14 @@ struct NegateFunction {
   FOLLY_ALWAYS_INLINE void call(TInput& result, const TInput& a) {
     result = negate(a);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(TInput* result, const TInput* a, int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = negate(a[i]);
+    }
+  }
 };
 
 template <typename T>
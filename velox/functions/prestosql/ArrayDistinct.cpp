@@ -18,6 +18,7 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/SegmentedRadixSort.h"
 #include "velox/type/FloatingPointUtil.h"
 
 namespace facebook::velox::functions {
@@ -94,7 +95,72 @@ class ArrayDistinctFunction : public exec::VectorFunction {
     auto* rawNewSizes = newLengths->asMutable<vector_size_t>();
     auto* rawNewOffsets = newOffsets->asMutable<vector_size_t>();
 
-    // Process the rows: store unique values in the hash table.
+    if constexpr (kRadixSortable<T>) {
+      // Sorts the elements of all arrays together and keeps the first
+      // occurrence of each run of equal values.
+      SegmentedRadixSort<T> sorter;
+      sorter.sort(rows, *arrayVector, *elements, true);
+      std::vector<uint64_t> distinct(bits::nwords(sorter.numPositions()));
+      rows.applyToSelected([&](vector_size_t row) {
+        sorter.markDistinct(row, distinct.data());
+      });
+
+      rows.applyToSelected([&](vector_size_t row) {
+        auto size = arrayVector->sizeAt(row);
+        auto offset = arrayVector->offsetAt(row);
+
+        rawNewOffsets[row] = indicesCursor;
+        bool hasNulls = false;
+        auto position = sorter.start(row);
+        for (vector_size_t i = offset; i < offset + size; ++i) {
+          if (elements->isNullAt(i)) {
+            if (!hasNulls) {
+              hasNulls = true;
+              rawNewIndices[indicesCursor++] = i;
+            }
+          } else if (bits::isBitSet(distinct.data(), position++)) {
+            rawNewIndices[indicesCursor++] = i;
+          }
+        }
+        rawNewSizes[row] = indicesCursor - rawNewOffsets[row];
+      });
+    } else {
+      processRowsWithSet(
+          rows,
+          arrayVector,
+          elements.get(),
+          indicesCursor,
+          rawNewIndices,
+          rawNewSizes,
+          rawNewOffsets);
+    }
+
+    newIndices->setSize(indicesCursor * sizeof(vector_size_t));
+    auto newElements =
+        BaseVector::transpose(newIndices, std::move(elementsVector));
+
+    return std::make_shared<ArrayVector>(
+        pool,
+        arrayVector->type(),
+        nullptr,
+        rowCount,
+        std::move(newOffsets),
+        std::move(newLengths),
+        std::move(newElements),
+        0);
+  }
+
+ private:
+  // Keeps the first occurrence of each value of each array by inserting the
+  // values of the array in a hash set.
+  void processRowsWithSet(
+      const SelectivityVector& rows,
+      const ArrayVector* arrayVector,
+      DecodedVector* elements,
+      vector_size_t& indicesCursor,
+      vector_size_t* rawNewIndices,
+      vector_size_t* rawNewSizes,
+      vector_size_t* rawNewOffsets) const {
     util::floating_point::HashSetNaNAware<T> uniqueSet;
 
     rows.applyToSelected([&](vector_size_t row) {
@@ -121,20 +187,6 @@ class ArrayDistinctFunction : public exec::VectorFunction {
       uniqueSet.clear();
       rawNewSizes[row] = indicesCursor - rawNewOffsets[row];
     });
-
-    newIndices->setSize(indicesCursor * sizeof(vector_size_t));
-    auto newElements =
-        BaseVector::transpose(newIndices, std::move(elementsVector));
-
-    return std::make_shared<ArrayVector>(
-        pool,
-        arrayVector->type(),
-        nullptr,
-        rowCount,
-        std::move(newOffsets),
-        std::move(newLengths),
-        std::move(newElements),
-        0);
   }
 };
 
@@ -16,6 +16,7 @@
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/SegmentedRadixSort.h"
 #include "velox/type/FloatingPointUtil.h"
 
 namespace facebook::velox::functions {
@@ -112,6 +113,13 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
   /// Next the `lengths` and `offsets` vectors that control where output arrays
   /// start and end are wrapped into the output ArrayVector.
   ///
+  /// Sorted merge:
+  ///
+  /// For fixed-width types, unless the rhs is constant, the elements of all
+  /// left and right-hand side arrays are sorted together with
+  /// SegmentedRadixSort instead of building sets for each row. The sorted
+  /// arrays of each row are then merged to find the elements to add.
+  ///
   /// Constant optimization:
   ///
   /// If the rhs values passed to either array_intersect() or array_except()
@@ -162,80 +170,134 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
     vector_size_t indicesCursor = 0;
 
     // Lambda that process each row. This is detached from the code so we can
-    // apply it differently based on whether the right-hand side set is constant
-    // or not.
-    auto processRow = [&](vector_size_t row,
-                          const SetWithNull<T>& rightSet,
-                          SetWithNull<T>& outputSet) {
-      auto idx = decodedLeftArray->index(row);
-      auto size = baseLeftArray->sizeAt(idx);
-      auto offset = baseLeftArray->offsetAt(idx);
-
-      outputSet.reset();
-      rawNewOffsets[row] = indicesCursor;
-      // Scans the array elements on the left-hand side.
-      for (vector_size_t i = offset; i < (offset + size); ++i) {
-        if (decodedLeftElements->isNullAt(i)) {
-          // For a NULL value not added to the output row yet, insert in
-          // array_intersect if it was found on the rhs (and not found in the
-          // case of array_except).
-          if (!outputSet.hasNull) {
-            bool setNull = false;
-            if constexpr (isIntersect) {
-              setNull = rightSet.hasNull;
-            } else {
-              setNull = !rightSet.hasNull;
-            }
-            if (setNull) {
-              bits::setNull(rawNewElementNulls, indicesCursor++, true);
-              outputSet.hasNull = true;
-            }
-          }
-        } else {
-          auto val = decodedLeftElements->valueAt<T>(i);
-          // For array_intersect, add the element if it is found (not found
-          // for array_except) in the right-hand side, and wasn't added already
-          // (check outputSet).
-          bool addValue = false;
-          if constexpr (isIntersect) {
-            addValue = rightSet.set.count(val) > 0;
-          } else {
-            addValue = rightSet.set.count(val) == 0;
-          }
-          if (addValue) {
-            auto it = outputSet.set.insert(val);
-            if (it.second) {
+    // apply it differently based on whether the right-hand side is a set or
+    // sorted. 'addValue' is called with the non-null elements of the
+    // left-hand side array in order and returns true if the element should be
+    // added to the output.
+    auto processRow =
+        [&](vector_size_t row, bool rightHasNull, auto&& addValue) {
+          auto idx = decodedLeftArray->index(row);
+          auto size = baseLeftArray->sizeAt(idx);
+          auto offset = baseLeftArray->offsetAt(idx);
+
+          bool outputHasNull = false;
+          rawNewOffsets[row] = indicesCursor;
+          // Scans the array elements on the left-hand side.
+          for (vector_size_t i = offset; i < (offset + size); ++i) {
+            if (decodedLeftElements->isNullAt(i)) {
+              // For a NULL value not added to the output row yet, insert in
+              // array_intersect if it was found on the rhs (and not found in
+              // the case of array_except).
+              if (!outputHasNull) {
+                bool setNull = false;
+                if constexpr (isIntersect) {
+                  setNull = rightHasNull;
+                } else {
+                  setNull = !rightHasNull;
+                }
+                if (setNull) {
+                  bits::setNull(rawNewElementNulls, indicesCursor++, true);
+                  outputHasNull = true;
+                }
+              }
+            } else if (addValue(i)) {
               rawNewIndices[indicesCursor++] = i;
             }
           }
-        }
-      }
-      rawNewLengths[row] = indicesCursor - rawNewOffsets[row];
-    };
+          rawNewLengths[row] = indicesCursor - rawNewOffsets[row];
+        };
 
+    // For array_intersect, adds the element if it is found (not found for
+    // array_except) in the right-hand side set, and wasn't added already
+    // (check outputSet).
     SetWithNull<T> outputSet;
+    auto processRowWithSet = [&](vector_size_t row,
+                                 const SetWithNull<T>& rightSet) {
+      outputSet.reset();
+      processRow(row, rightSet.hasNull, [&](vector_size_t i) {
+        auto val = decodedLeftElements->valueAt<T>(i);
+        bool addValue = false;
+        if constexpr (isIntersect) {
+          addValue = rightSet.set.count(val) > 0;
+        } else {
+          addValue = rightSet.set.count(val) == 0;
+        }
+        return addValue && outputSet.set.insert(val).second;
+      });
+    };
 
     // Optimized case when the right-hand side array is constant.
     if (constantSet_.has_value()) {
       rows.applyToSelected([&](vector_size_t row) {
-        processRow(row, *constantSet_, outputSet);
+        processRowWithSet(row, *constantSet_);
       });
     }
-    // General case when no arrays are constant and both sets need to be
-    // computed for each row.
+    // General case when no arrays are constant and both sides need to be
+    // processed for each row.
     else {
       exec::LocalDecodedVector rightHolder(context, *right, rows);
       // Decode and acquire array elements vector.
       exec::LocalDecodedVector rightElementsHolder(context);
       auto decodedRightElements =
           decodeArrayElements(rightHolder, rightElementsHolder, rows);
-      SetWithNull<T> rightSet;
       auto rightArrayVector = rightHolder.get()->base()->as<ArrayVector>();
-      rows.applyToSelected([&](vector_size_t row) {
-        auto idx = rightHolder.get()->index(row);
-        generateSet<T>(rightArrayVector, decodedRightElements, idx, rightSet);
-        processRow(row, rightSet, outputSet);
-      });
+      if constexpr (kRadixSortable<T>) {
+        // Sorts the elements of all arrays on both sides together and merges
+        // the sorted left and right-hand side arrays of each row.
+        SegmentedRadixSort<T> leftSorter;
+        leftSorter.sort(
+            rows,
+            *baseLeftArray,
+            *decodedLeftElements,
+            true,
+            [&](auto row) { return decodedLeftArray->index(row); });
+        SegmentedRadixSort<T> rightSorter;
+        rightSorter.sort(
+            rows,
+            *rightArrayVector,
+            *decodedRightElements,
+            true,
+            [&](auto row) { return rightHolder.get()->index(row); });
+
+        std::vector<uint64_t> added(bits::nwords(leftSorter.numPositions()));
+        const auto* leftPositions = leftSorter.sortedPositions();
+        const auto* leftKeys = leftSorter.sortedKeys();
+        const auto* rightKeys = rightSorter.sortedKeys();
+        rows.applyToSelected([&](vector_size_t row) {
+          auto r = rightSorter.start(row);
+          const auto rightEnd = rightSorter.end(row);
+          const auto leftStart = leftSorter.start(row);
+          for (auto l = leftStart; l < leftSorter.end(row); ++l) {
+            if (l > leftStart && leftKeys[l] == leftKeys[l - 1]) {
+              // Only the first occurrence of a value is added.
+              continue;
+            }
+            while (r < rightEnd && rightKeys[r] < leftKeys[l]) {
+              ++r;
+            }
+            const bool found = r < rightEnd && rightKeys[r] == leftKeys[l];
+            if (found == isIntersect) {
+              bits::setBit(added.data(), leftPositions[l]);
+            }
+          }
+
+          const auto rightSize =
+              rightArrayVector->sizeAt(rightHolder.get()->index(row));
+          const bool rightHasNull =
+              rightSize > rightEnd - rightSorter.start(row);
+          auto position = leftStart;
+          processRow(row, rightHasNull, [&](vector_size_t /*i*/) {
+            return bits::isBitSet(added.data(), position++);
+          });
+        });
+      } else {
+        SetWithNull<T> rightSet;
+        rows.applyToSelected([&](vector_size_t row) {
+          auto idx = rightHolder.get()->index(row);
+          generateSet<T>(rightArrayVector, decodedRightElements, idx, rightSet);
+          processRowWithSet(row, rightSet);
+        });
+      }
     }
 
     auto newElements = BaseVector::wrapInDictionary(
@@ -21,6 +21,7 @@
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/SegmentedRadixSort.h"
 #include "velox/functions/prestosql/SimpleComparisonMatcher.h"
 #include "velox/type/FloatingPointUtil.h"
 
@@ -138,6 +139,33 @@ void applyScalarType(
   // practice.
   resultElements =
       BaseVector::create(inputElements->type(), elementsCount, context.pool());
+
+  if constexpr (kRadixSortable<T>) {
+    // Sorts the elements of all arrays together and writes them in sorted
+    // order, followed by the nulls of each array.
+    exec::LocalDecodedVector decodedElements(
+        context, *inputElements, inputElementRows);
+    SegmentedRadixSort<T> sorter;
+    sorter.sort(rows, *inputArray, *decodedElements, ascending);
+
+    auto* flatResults = resultElements->asFlatVector<T>();
+    const auto* sortedPositions = sorter.sortedPositions();
+    rows.applyToSelected([&](vector_size_t row) {
+      auto index = inputArray->offsetAt(row);
+      const auto end = index + inputArray->sizeAt(row);
+      for (auto i = sorter.start(row); i < sorter.end(row); ++i) {
+        flatResults->set(
+            index++,
+            decodedElements->valueAt<T>(
+                sorter.elementIndex(sortedPositions[i])));
+      }
+      for (; index < end; ++index) {
+        flatResults->setNull(index, true);
+      }
+    });
+    return;
+  }
+
   resultElements->copy(
       inputElements.get(), inputElementRows, /*toSourceRow=*/nullptr);
 
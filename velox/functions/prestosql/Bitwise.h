@@ -21,9 +21,16 @@ namespace facebook::velox::functions {
 template <typename T>
 struct BitwiseAndFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE bool call(int64_t& result, TInput a, TInput b) {
+  FOLLY_ALWAYS_INLINE void call(int64_t& result, TInput a, TInput b) {
     result = a & b;
-    return true;
+  }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(int64_t* result, const TInput* a, const TInput* b, int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = a[i] & b[i];
+    }
   }
 };
 
@@ -53,27 +60,48 @@ struct BitCountFunction {
 template <typename T>
 struct BitwiseNotFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE bool call(int64_t& result, TInput a) {
+  FOLLY_ALWAYS_INLINE void call(int64_t& result, TInput a) {
     result = ~a;
-    return true;
+  }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(int64_t* result, const TInput* a, int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = ~a[i];
+    }
   }
 };
 
 template <typename T>
 struct BitwiseOrFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE bool call(int64_t& result, TInput a, TInput b) {
+  FOLLY_ALWAYS_INLINE void call(int64_t& result, TInput a, TInput b) {
     result = a | b;
-    return true;
+  }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(int64_t* result, const TInput* a, const TInput* b, int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = a[i] | b[i];
+    }
   }
 };
 
 template <typename T>
 struct BitwiseXorFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE bool call(int64_t& result, TInput a, TInput b) {
+  FOLLY_ALWAYS_INLINE void call(int64_t& result, TInput a, TInput b) {
     result = a ^ b;
-    return true;
+  }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(int64_t* result, const TInput* a, const TInput* b, int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = a[i] ^ b[i];
+    }
   }
 };
 
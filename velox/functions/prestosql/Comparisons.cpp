@@ -250,14 +250,16 @@ class ComparisonSimdFunction : public exec::VectorFunction {
 
 } // namespace
 
-VELOX_DECLARE_VECTOR_FUNCTION(
+VELOX_DECLARE_VECTOR_FUNCTION_WITH_METADATA(
     udf_simd_comparison_eq,
     (ComparisonSimdFunction<std::equal_to<>>::signatures()),
+    exec::VectorFunctionMetadataBuilder().commutative(true).build(),
     (std::make_unique<ComparisonSimdFunction<std::equal_to<>>>()));
 
-VELOX_DECLARE_VECTOR_FUNCTION(
+VELOX_DECLARE_VECTOR_FUNCTION_WITH_METADATA(
     udf_simd_comparison_neq,
     (ComparisonSimdFunction<std::not_equal_to<>>::signatures()),
+    exec::VectorFunctionMetadataBuilder().commutative(true).build(),
     (std::make_unique<ComparisonSimdFunction<std::not_equal_to<>>>()));
 
 VELOX_DECLARE_VECTOR_FUNCTION(
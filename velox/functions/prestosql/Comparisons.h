@@ -115,6 +115,8 @@ template <typename T>
 struct EqFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  static constexpr bool is_commutative = true;
+
   // Used for primitive inputs.
   template <typename TInput>
   void call(bool& out, const TInput& lhs, const TInput& rhs) {
@@ -155,6 +157,8 @@ template <typename T>
 struct NeqFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  static constexpr bool is_commutative = true;
+
   // Used for primitive inputs.
   template <typename TInput>
   void call(bool& out, const TInput& lhs, const TInput& rhs) {
@@ -196,7 +196,7 @@ struct WeekFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getWeek(getDateTime(timestamp, this->timeZone_));
+    result = getWeek(getDateTime(timestamp, this->timeZoneCache_));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -223,7 +223,7 @@ struct YearFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getYear(getDateTime(timestamp, this->timeZone_));
+    result = getYear(getDateTime(timestamp, this->timeZoneCache_));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -261,7 +261,7 @@ struct QuarterFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getQuarter(getDateTime(timestamp, this->timeZone_));
+    result = getQuarter(getDateTime(timestamp, this->timeZoneCache_));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -288,7 +288,7 @@ struct MonthFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getMonth(getDateTime(timestamp, this->timeZone_));
+    result = getMonth(getDateTime(timestamp, this->timeZoneCache_));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -322,7 +322,7 @@ struct DayFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_mday;
+    result = getDateTime(timestamp, this->timeZoneCache_).tm_mday;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -356,7 +356,7 @@ struct LastDayOfMonthFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       out_type<Date>& result,
       const arg_type<Timestamp>& timestamp) {
-    auto dt = getDateTime(timestamp, this->timeZone_);
+    auto dt = getDateTime(timestamp, this->timeZoneCache_);
     int64_t daysSinceEpochFromDate;
     auto status =
         util::lastDayOfMonthSinceEpochFromDate(dt, daysSinceEpochFromDate);
@@ -600,7 +600,7 @@ struct DayOfWeekFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDayOfWeek(getDateTime(timestamp, this->timeZone_));
+    result = getDayOfWeek(getDateTime(timestamp, this->timeZoneCache_));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -627,7 +627,7 @@ struct DayOfYearFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDayOfYear(getDateTime(timestamp, this->timeZone_));
+    result = getDayOfYear(getDateTime(timestamp, this->timeZoneCache_));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -671,7 +671,7 @@ struct YearOfWeekFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = computeYearOfWeek(getDateTime(timestamp, this->timeZone_));
+    result = computeYearOfWeek(getDateTime(timestamp, this->timeZoneCache_));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -694,7 +694,7 @@ struct HourFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_hour;
+    result = getDateTime(timestamp, this->timeZoneCache_).tm_hour;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -728,7 +728,7 @@ struct MinuteFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_min;
+    result = getDateTime(timestamp, this->timeZoneCache_).tm_min;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -916,6 +916,7 @@ struct DateTruncFunction : public TimestampWithTimezoneSupport<T> {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
   const date::time_zone* timeZone_ = nullptr;
+  TimeZoneOffsetCache timeZoneCache_;
   std::optional<DateTimeUnit> unit_;
 
   FOLLY_ALWAYS_INLINE void initialize(
@@ -924,6 +925,7 @@ struct DateTruncFunction : public TimestampWithTimezoneSupport<T> {
       const arg_type<Varchar>* unitString,
       const arg_type<Timestamp>* /*timestamp*/) {
     timeZone_ = getTimeZoneFromConfig(config);
+    timeZoneCache_ = TimeZoneOffsetCache(timeZone_);
 
     if (unitString != nullptr) {
       unit_ = getTimestampUnit(*unitString);
@@ -1034,23 +1036,22 @@ struct DateTruncFunction : public TimestampWithTimezoneSupport<T> {
         result = Timestamp(timestamp.getSeconds(), 0);
         return;
       case DateTimeUnit::kMinute:
-        result = adjustEpoch(getSeconds(timestamp, timeZone_), 60);
+        result = adjustEpoch(getSeconds(timestamp, timeZoneCache_), 60);
         break;
       case DateTimeUnit::kHour:
-        result = adjustEpoch(getSeconds(timestamp, timeZone_), 60 * 60);
+        result = adjustEpoch(getSeconds(timestamp, timeZoneCache_), 60 * 60);
         break;
       case DateTimeUnit::kDay:
-        result = adjustEpoch(getSeconds(timestamp, timeZone_), 24 * 60 * 60);
+        result =
+            adjustEpoch(getSeconds(timestamp, timeZoneCache_), 24 * 60 * 60);
         break;
       default:
-        auto dateTime = getDateTime(timestamp, timeZone_);
+        auto dateTime = getDateTime(timestamp, timeZoneCache_);
         adjustDateTime(dateTime, unit);
         result = Timestamp(Timestamp::calendarUtcToEpoch(dateTime), 0);
     }
 
-    if (timeZone_ != nullptr) {
-      result.toGMT(*timeZone_);
-    }
+    timeZoneCache_.toGMT(result);
   }
 
   FOLLY_ALWAYS_INLINE void call(
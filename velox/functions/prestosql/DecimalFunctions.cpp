@@ -50,12 +50,16 @@ struct DecimalPlusFunction {
 #endif
 #endif
   {
-    int128_t aRescaled;
-    int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
+    int128_t aRescaled = a;
+    int128_t bRescaled = b;
+    // Only the argument with the smaller scale is rescaled. The common case
+    // of equal scales has no multiplication.
+    if ((aRescale_ != 0 &&
+         __builtin_mul_overflow(
+             a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled)) ||
+        (bRescale_ != 0 &&
+         __builtin_mul_overflow(
+             b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled))) {
       VELOX_ARITHMETIC_ERROR("Decimal overflow: {} + {}", a, b);
     }
     out = checkedPlus<R>(R(aRescaled), R(bRescaled));
@@ -99,12 +103,16 @@ struct DecimalMinusFunction {
 #endif
 #endif
   {
-    int128_t aRescaled;
-    int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
+    int128_t aRescaled = a;
+    int128_t bRescaled = b;
+    // Only the argument with the smaller scale is rescaled. The common case
+    // of equal scales has no multiplication.
+    if ((aRescale_ != 0 &&
+         __builtin_mul_overflow(
+             a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled)) ||
+        (bRescale_ != 0 &&
+         __builtin_mul_overflow(
+             b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled))) {
       VELOX_ARITHMETIC_ERROR("Decimal overflow: {} - {}", a, b);
     }
     out = checkedMinus<R>(R(aRescaled), R(bRescaled));
@@ -128,7 +136,7 @@ struct DecimalMultiplyFunction {
 
   template <typename R, typename A, typename B>
   void call(R& out, const A& a, const B& b) {
-    out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
+    out = checkedMultiply<R>(R(a), R(b));
     DecimalUtil::valueInRange(out);
   }
 };
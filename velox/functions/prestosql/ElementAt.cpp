@@ -35,7 +35,18 @@ class ElementAtFunction : public SubscriptImpl<
                               /* allowOutOfBound */ true,
                               /* indexStartsAtOne */ true> {
  public:
-  explicit ElementAtFunction(bool allowcaching) : SubscriptImpl(allowcaching) {}
+  ElementAtFunction(bool allowcaching, bool isMap)
+      : SubscriptImpl(allowcaching), isMap_(isMap) {}
+
+  /// A map key that is not read is missing from the map and element_at
+  /// returns null for it, so only the keys used need to be read. A negative
+  /// array index counts from the end, which the readers do not support.
+  bool canPushdown() const override {
+    return isMap_;
+  }
+
+ private:
+  const bool isMap_;
 };
 } // namespace
 
@@ -50,12 +61,13 @@ void registerElementAtFunction(
           const std::vector<exec::VectorFunctionArg>& inputArgs,
           const velox::core::QueryConfig& config) {
         static const auto kSubscriptStateLess =
-            std::make_shared<ElementAtFunction>(false);
+            std::make_shared<ElementAtFunction>(false, false);
         if (inputArgs[0].type->isArray()) {
           return kSubscriptStateLess;
         } else {
           return std::make_shared<ElementAtFunction>(
-              enableCaching && config.isExpressionEvaluationCacheEnabled());
+              enableCaching && config.isExpressionEvaluationCacheEnabled(),
+              true);
         }
       });
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/core/QueryConfig.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
@@ -197,6 +198,14 @@ template <typename T>
 struct JsonExtractScalarFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& config,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* /*jsonPath*/) {
+    documentCacheMaxBytes_ = config.jsonDocumentCacheMaxBytes();
+  }
+
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Json>& json,
@@ -245,7 +254,8 @@ struct JsonExtractScalarFunction {
     };
 
     auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
-    SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
+    SIMDJSON_TRY(simdJsonExtract(
+        json, extractor, consumer, documentCacheMaxBytes_));
 
     if (resultStr.has_value()) {
       result.copy_from(*resultStr);
@@ -254,12 +264,22 @@ struct JsonExtractScalarFunction {
       return simdjson::NO_SUCH_FIELD;
     }
   }
+
+  uint64_t documentCacheMaxBytes_{0};
 };
 
 template <typename T>
 struct JsonExtractFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& config,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* /*jsonPath*/) {
+    documentCacheMaxBytes_ = config.jsonDocumentCacheMaxBytes();
+  }
+
   bool call(
       out_type<Json>& result,
       const arg_type<Json>& json,
@@ -312,7 +332,8 @@ struct JsonExtractFunction {
     };
 
     auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
-    SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
+    SIMDJSON_TRY(simdJsonExtract(
+        json, extractor, consumer, documentCacheMaxBytes_));
 
     if (resultSize == 0) {
       if (extractor.isDefinitePath()) {
@@ -334,12 +355,22 @@ struct JsonExtractFunction {
     }
     return simdjson::SUCCESS;
   }
+
+  uint64_t documentCacheMaxBytes_{0};
 };
 
 template <typename T>
 struct JsonSizeFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& config,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* /*jsonPath*/) {
+    documentCacheMaxBytes_ = config.jsonDocumentCacheMaxBytes();
+  }
+
   FOLLY_ALWAYS_INLINE bool call(
       int64_t& result,
       const arg_type<Json>& json,
@@ -383,7 +414,8 @@ struct JsonSizeFunction {
     };
 
     auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
-    SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
+    SIMDJSON_TRY(simdJsonExtract(
+        json, extractor, consumer, documentCacheMaxBytes_));
 
     if (resultCount == 0) {
       // If the path didn't map to anything in the JSON object, return null.
@@ -394,6 +426,8 @@ struct JsonSizeFunction {
 
     return simdjson::SUCCESS;
   }
+
+  uint64_t documentCacheMaxBytes_{0};
 };
 
 } // namespace facebook::velox::functions
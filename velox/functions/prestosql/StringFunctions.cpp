@@ -75,6 +75,102 @@ class UpperLowerTemplateFunction : public exec::VectorFunction {
     });
   }
 
+  // Returns the index in 'buffers' of the buffer that holds the data of
+  // 'string' or -1 if no buffer does. Tries 'hint' first since consecutive
+  // strings are usually in the same buffer.
+  static int32_t findStringBuffer(
+      const std::vector<BufferPtr>& buffers,
+      const StringView& string,
+      int32_t hint) {
+    auto contains = [&](int32_t i) {
+      const auto* begin = buffers[i]->as<char>();
+      return string.data() >= begin &&
+          string.data() + string.size() <= begin + buffers[i]->size();
+    };
+    if (hint >= 0 && contains(hint)) {
+      return hint;
+    }
+    for (auto i = 0; i < buffers.size(); ++i) {
+      if (contains(i)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // Converts ascii strings by converting each string buffer of 'input' as a
+  // whole into a new buffer of 'results' and pointing the results at the
+  // same offsets in the new buffers, instead of converting and copying one
+  // string at a time. Returns false without changing 'results' if a selected
+  // string is not in the string buffers of 'input' or if the selected strings
+  // use less than half of the bytes of the buffers.
+  bool applyAsciiBuffers(
+      const SelectivityVector& rows,
+      const FlatVector<StringView>& input,
+      FlatVector<StringView>* results,
+      memory::MemoryPool* pool) const {
+    const auto& buffers = input.stringBuffers();
+    const auto* values = input.rawValues();
+    uint64_t stringBytes = 0;
+    int32_t hint = -1;
+    const bool allInBuffers = rows.testSelected([&](auto row) {
+      if (values[row].isInline()) {
+        return true;
+      }
+      hint = findStringBuffer(buffers, values[row], hint);
+      stringBytes += values[row].size();
+      return hint >= 0;
+    });
+    if (!allInBuffers) {
+      return false;
+    }
+    uint64_t bufferBytes = 0;
+    for (const auto& buffer : buffers) {
+      bufferBytes += buffer->size();
+    }
+    if (stringBytes * 2 < bufferBytes) {
+      return false;
+    }
+
+    std::vector<BufferPtr> newBuffers;
+    newBuffers.reserve(buffers.size());
+    for (const auto& buffer : buffers) {
+      auto newBuffer = AlignedBuffer::allocate<char>(buffer->size(), pool);
+      if constexpr (isLower) {
+        lowerAscii(
+            newBuffer->asMutable<char>(), buffer->as<char>(), buffer->size());
+      } else {
+        upperAscii(
+            newBuffer->asMutable<char>(), buffer->as<char>(), buffer->size());
+      }
+      newBuffers.push_back(std::move(newBuffer));
+    }
+
+    hint = -1;
+    rows.applyToSelected([&](auto row) {
+      const auto& string = values[row];
+      if (string.isInline()) {
+        char converted[StringView::kInlineSize];
+        if constexpr (isLower) {
+          lowerAscii(converted, string.data(), string.size());
+        } else {
+          upperAscii(converted, string.data(), string.size());
+        }
+        results->setNoCopy(row, StringView(converted, string.size()));
+        return;
+      }
+      hint = findStringBuffer(buffers, string, hint);
+      const auto offset = string.data() - buffers[hint]->as<char>();
+      results->setNoCopy(
+          row,
+          StringView(newBuffers[hint]->as<char>() + offset, string.size()));
+    });
+    for (const auto& buffer : newBuffers) {
+      results->addStringBuffer(buffer);
+    }
+    return true;
+  }
+
  public:
   void apply(
       const SelectivityVector& rows,
@@ -110,6 +206,15 @@ class UpperLowerTemplateFunction : public exec::VectorFunction {
     prepareFlatResultsVector(result, rows, context, emptyVectorPtr);
     auto* resultFlatVector = result->as<FlatVector<StringView>>();
 
+    if (tryInplace &&
+        applyAsciiBuffers(
+            rows,
+            *inputStringsVector->asUnchecked<FlatVector<StringView>>(),
+            resultFlatVector,
+            context.pool())) {
+      return;
+    }
+
     StringEncodingTemplateWrapper<ApplyInternal>::apply(
         ascii, rows, decodedInput, resultFlatVector);
   }
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/theta/ThetaSketch.h"
+#include "velox/functions/Macros.h"
+
+namespace facebook::velox::functions {
+
+template <typename T>
+struct ThetaSketchEstimateFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE bool call(
+      double& result,
+      const arg_type<Varbinary>& sketch) {
+    result = common::theta::ThetaSketch::estimate(sketch);
+    return true;
+  }
+};
+
+/// Applies 'operation' to two serialized theta sketches.
+template <typename T, common::theta::ThetaSketch::SetOperation operation>
+struct ThetaSetOperationFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE bool call(
+      out_type<Varbinary>& result,
+      const arg_type<Varbinary>& left,
+      const arg_type<Varbinary>& right) {
+    const auto serialized =
+        common::theta::ThetaSketch::combine(operation, left, right);
+    result.resize(serialized.size());
+    memcpy(result.data(), serialized.data(), serialized.size());
+    return true;
+  }
+};
+
+template <typename T>
+using ThetaUnionFunction = ThetaSetOperationFunction<
+    T,
+    common::theta::ThetaSketch::SetOperation::kUnion>;
+
+template <typename T>
+using ThetaIntersectionFunction = ThetaSetOperationFunction<
+    T,
+    common::theta::ThetaSketch::SetOperation::kIntersection>;
+
+template <typename T>
+using ThetaDifferenceFunction = ThetaSetOperationFunction<
+    T,
+    common::theta::ThetaSketch::SetOperation::kDifference>;
+
+} // namespace facebook::velox::functions
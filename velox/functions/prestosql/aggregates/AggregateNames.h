@@ -68,6 +68,9 @@ const char* const kStdDev = "stddev"; // Alias for stddev_samp.
 const char* const kStdDevPop = "stddev_pop";
 const char* const kStdDevSamp = "stddev_samp";
 const char* const kSum = "sum";
+const char* const kThetaIntersectionAgg = "theta_intersection_agg";
+const char* const kThetaSketchAgg = "theta_sketch_agg";
+const char* const kThetaUnionAgg = "theta_union_agg";
 const char* const kVariance = "variance"; // Alias for var_samp.
 const char* const kVarPop = "var_pop";
 const char* const kVarSamp = "var_samp";
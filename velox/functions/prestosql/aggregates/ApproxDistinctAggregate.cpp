@@ -54,11 +54,25 @@ struct HllAccumulator {
     }
   }
 
+  void append(const uint64_t* hashes, int32_t numHashes) {
+    int32_t i = 0;
+    while (isSparse_ && i < numHashes) {
+      const auto batchSize = std::min(numHashes - i, kSparseBatchSize);
+      if (sparseHll_.insertHashes(hashes + i, batchSize)) {
+        toDense();
+      }
+      i += batchSize;
+    }
+    for (; i < numHashes; ++i) {
+      denseHll_.insertHash(hashes[i]);
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
 
-  void mergeWith(StringView serialized, HashStringAllocator* allocator) {
+  void mergeWith(StringView serialized) {
     auto input = serialized.data();
     if (SparseHll::canDeserialize(input)) {
       if (isSparse_) {
@@ -70,8 +84,7 @@ struct HllAccumulator {
           toDense();
         }
       } else {
-        SparseHll other{input, allocator};
-        other.toDense(denseHll_);
+        SparseHll::toDense(input, denseHll_);
       }
     } else if (DenseHll::canDeserialize(input)) {
       if (isSparse_) {
@@ -96,6 +109,10 @@ struct HllAccumulator {
   }
 
  private:
+  // Maximum number of hashes inserted into 'sparseHll_' at once. Bounds the
+  // number of entries past the soft memory limit before converting to dense.
+  static constexpr int32_t kSparseBatchSize = 1'024;
+
   void toDense() {
     isSparse_ = false;
     denseHll_.initialize(indexBitLength_);
@@ -254,7 +271,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       auto serialized = decodedHll_.valueAt<StringView>(row);
 
       auto accumulator = value<HllAccumulator>(group);
-      accumulator->mergeWith(serialized, allocator_);
+      accumulator->mergeWith(serialized);
     });
   }
 
@@ -269,18 +286,20 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
+      hashes_.clear();
       rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
+        if (!decodedValue_.isNullAt(row)) {
+          hashes_.push_back(hashOne(decodedValue_.valueAt<T>(row)));
         }
-
-        auto accumulator = value<HllAccumulator>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
       });
+      if (hashes_.empty()) {
+        return;
+      }
+
+      auto accumulator = value<HllAccumulator>(group);
+      clearNull(group);
+      accumulator->setIndexBitLength(indexBitLength_);
+      accumulator->append(hashes_.data(), hashes_.size());
     }
   }
 
@@ -302,7 +321,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       auto serialized = decodedHll_.valueAt<StringView>(row);
 
       auto accumulator = value<HllAccumulator>(group);
-      accumulator->mergeWith(serialized, allocator_);
+      accumulator->mergeWith(serialized);
     });
   }
 
@@ -423,6 +442,9 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+
+  /// Reusable buffer for the hashes of the input of a single group.
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
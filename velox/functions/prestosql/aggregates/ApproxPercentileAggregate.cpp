@@ -32,9 +32,14 @@ template <typename T>
 using KllSketch = functions::kll::KllSketch<T, StlAllocator<T>>;
 
 // Accumulator to buffer large count values in addition to the KLL
-// sketch itself.
+// sketch itself. The buffer is flushed and the sketch is down-sampled to at
+// most kMaxBytes when the memory of the accumulator exceeds the compaction
+// threshold, so that aggregations over many groups hold a bounded size per
+// group.
 template <typename T>
 struct KllSketchAccumulator {
+  static constexpr size_t kMaxBytes = 8 << 10;
+
   explicit KllSketchAccumulator(HashStringAllocator* allocator)
       : allocator_(allocator),
         sketch_(
@@ -50,6 +55,7 @@ struct KllSketchAccumulator {
 
   void append(T value) {
     sketch_.insert(value);
+    maybeCompact();
   }
 
   void append(T value, int64_t count) {
@@ -65,21 +71,21 @@ struct KllSketchAccumulator {
         flush();
       }
     }
+    maybeCompact();
   }
 
   void append(const typename KllSketch<T>::View& view) {
     sketch_.mergeViews(folly::Range(&view, 1));
+    maybeCompact();
   }
 
   void append(const std::vector<typename KllSketch<T>::View>& views) {
     sketch_.mergeViews(views);
+    maybeCompact();
   }
 
   void finalize() {
-    if (!largeCountValues_.empty()) {
-      flush();
-    }
-    sketch_.compact();
+    compact();
   }
 
   const KllSketch<T>& getSketch() const {
@@ -87,11 +93,35 @@ struct KllSketchAccumulator {
   }
 
  private:
-  uint16_t k_;
+  uint16_t k_{functions::kll::kDefaultK};
   HashStringAllocator* allocator_;
   KllSketch<T> sketch_;
   std::vector<std::pair<T, int64_t>, StlAllocator<std::pair<T, int64_t>>>
       largeCountValues_;
+  // Compacts the accumulator when its memory exceeds this.
+  size_t compactionThreshold_{kMaxBytes};
+
+  size_t memoryUsage() const {
+    return sketch_.memoryUsage() +
+        largeCountValues_.capacity() * sizeof(std::pair<T, int64_t>);
+  }
+
+  void maybeCompact() {
+    if (FOLLY_UNLIKELY(memoryUsage() > compactionThreshold_)) {
+      compact();
+    }
+  }
+
+  void compact() {
+    if (!largeCountValues_.empty()) {
+      flush();
+    }
+    largeCountValues_.shrink_to_fit();
+    sketch_.compact(kMaxBytes);
+    // Wait for the accumulator to double before compacting again, so that
+    // appends to a sketch near kMaxBytes do not compact every time.
+    compactionThreshold_ = std::max(kMaxBytes, 2 * memoryUsage());
+  }
 
   void flush() {
     std::vector<KllSketch<T>> sketches;
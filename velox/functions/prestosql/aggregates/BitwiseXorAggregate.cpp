@@ -52,6 +52,20 @@ class BitwiseXorAggregate {
       xor_ ^= other;
     }
 
+    void addInputBatch(
+        HashStringAllocator* /*allocator*/,
+        const T* values,
+        const SelectivityVector& rows) {
+      rows.applyToSelected([&](auto row) { xor_ ^= values[row]; });
+    }
+
+    void combineBatch(
+        HashStringAllocator* allocator,
+        const T* values,
+        const SelectivityVector& rows) {
+      addInputBatch(allocator, values, rows);
+    }
+
     bool writeFinalResult(exec::out_type<OutputType>& out) {
       out = xor_;
       return true;
@@ -137,6 +137,10 @@ extern void registerSumAggregate(
     const std::string& prefix,
     bool withCompanionFunctions,
     bool overwrite);
+extern void registerThetaSketchAggregates(
+    const std::string& prefix,
+    bool withCompanionFunctions,
+    bool overwrite);
 extern void registerVarianceAggregates(
     const std::string& prefix,
     bool withCompanionFunctions,
@@ -181,6 +185,7 @@ void registerAllAggregateFunctions(
   registerSetAggAggregate(prefix, withCompanionFunctions, overwrite);
   registerSetUnionAggregate(prefix, withCompanionFunctions, overwrite);
   registerSumAggregate(prefix, withCompanionFunctions, overwrite);
+  registerThetaSketchAggregates(prefix, withCompanionFunctions, overwrite);
   registerVarianceAggregates(prefix, withCompanionFunctions, overwrite);
 }
 
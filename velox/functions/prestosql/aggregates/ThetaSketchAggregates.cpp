@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/common/memory/HashStringAllocator.h"
+#include "velox/common/theta/ThetaSketch.h"
+#include "velox/exec/Aggregate.h"
+#include "velox/expression/FunctionSignature.h"
+#include "velox/functions/prestosql/aggregates/AggregateNames.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+using facebook::velox::common::theta::ThetaSketch;
+
+namespace facebook::velox::aggregate::prestosql {
+
+namespace {
+
+template <typename T>
+inline uint64_t hashOne(T value) {
+  return XXH64(&value, sizeof(T), 0);
+}
+
+// Use timestamp.toMillis() to compute hash value.
+template <>
+inline uint64_t hashOne<Timestamp>(Timestamp value) {
+  return hashOne(value.toMillis());
+}
+
+template <>
+inline uint64_t hashOne<StringView>(StringView value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+// The sketch of a group. Empty until the group receives its first value or
+// sketch.
+using ThetaAccumulator = std::optional<ThetaSketch>;
+
+// Aggregates values into a theta sketch, or merges theta sketches with a
+// union or an intersection. The intermediate and final results are the
+// serialized sketches.
+template <typename T>
+class ThetaSketchAggregate : public exec::Aggregate {
+ public:
+  ThetaSketchAggregate(
+      const TypePtr& resultType,
+      bool sketchAsRawInput,
+      ThetaSketch::SetOperation mergeOperation)
+      : exec::Aggregate(resultType),
+        sketchAsRawInput_{sketchAsRawInput},
+        mergeOperation_{mergeOperation} {}
+
+  int32_t accumulatorFixedWidthSize() const override {
+    return sizeof(ThetaAccumulator);
+  }
+
+  int32_t accumulatorAlignmentSize() const override {
+    return alignof(ThetaAccumulator);
+  }
+
+  bool isFixedSize() const override {
+    return false;
+  }
+
+  bool supportsToIntermediate() const final {
+    return sketchAsRawInput_;
+  }
+
+  void toIntermediate(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      VectorPtr& result) const final {
+    singleInputAsIntermediate(rows, args, result);
+  }
+
+  void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
+      override {
+    extractAccumulators(groups, numGroups, result);
+  }
+
+  void extractAccumulators(char** groups, int32_t numGroups, VectorPtr* result)
+      override {
+    VELOX_CHECK(result);
+    auto* flatResult = (*result)->asFlatVector<StringView>();
+    flatResult->resize(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      char* group = groups[i];
+      if (isNull(group)) {
+        flatResult->setNull(i, true);
+        continue;
+      }
+      // Serialized sketches have a 14 byte header, so they are never inlined.
+      auto& sketch = value<ThetaAccumulator>(group)->value();
+      const auto size = sketch.serializedSize();
+      char* buffer = flatResult->getRawStringBufferWithSpace(size);
+      sketch.serialize(buffer);
+      flatResult->setNoCopy(i, StringView(buffer, size));
+    }
+  }
+
+  void addRawInput(
+      char** groups,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    if (sketchAsRawInput_) {
+      addIntermediateResults(groups, rows, args, false /*unused*/);
+      return;
+    }
+    decodeArguments(rows, args);
+    rows.applyToSelected([&](auto row) {
+      if (decodedValue_.isNullAt(row)) {
+        return;
+      }
+      auto group = groups[row];
+      auto tracker = trackRowSize(group);
+      addValue(group, row);
+    });
+  }
+
+  void addIntermediateResults(
+      char** groups,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    decodedSketch_.decode(*args[0], rows, true);
+    rows.applyToSelected([&](auto row) {
+      if (decodedSketch_.isNullAt(row)) {
+        return;
+      }
+      auto group = groups[row];
+      auto tracker = trackRowSize(group);
+      mergeSketch(group, decodedSketch_.valueAt<StringView>(row));
+    });
+  }
+
+  void addSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    if (sketchAsRawInput_) {
+      addSingleGroupIntermediateResults(group, rows, args, false /*unused*/);
+      return;
+    }
+    decodeArguments(rows, args);
+    auto tracker = trackRowSize(group);
+    rows.applyToSelected([&](auto row) {
+      if (!decodedValue_.isNullAt(row)) {
+        addValue(group, row);
+      }
+    });
+  }
+
+  void addSingleGroupIntermediateResults(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    decodedSketch_.decode(*args[0], rows, true);
+    auto tracker = trackRowSize(group);
+    rows.applyToSelected([&](auto row) {
+      if (!decodedSketch_.isNullAt(row)) {
+        mergeSketch(group, decodedSketch_.valueAt<StringView>(row));
+      }
+    });
+  }
+
+ protected:
+  void initializeNewGroupsInternal(
+      char** groups,
+      folly::Range<const vector_size_t*> indices) override {
+    setAllNulls(groups, indices);
+    for (auto i : indices) {
+      new (groups[i] + offset_) ThetaAccumulator();
+    }
+  }
+
+  void destroyInternal(folly::Range<char**> groups) override {
+    destroyAccumulators<ThetaAccumulator>(groups);
+  }
+
+ private:
+  void addValue(char* group, vector_size_t row) {
+    clearNull(group);
+    auto* accumulator = value<ThetaAccumulator>(group);
+    if (!accumulator->has_value()) {
+      accumulator->emplace(lgK_, allocator_);
+    }
+    (*accumulator)->insertHash(hashOne(decodedValue_.valueAt<T>(row)));
+  }
+
+  // Merges 'serialized' into the sketch of 'group'. The first sketch merged
+  // into a group becomes its sketch, so that intersections start from it.
+  void mergeSketch(char* group, StringView serialized) {
+    clearNull(group);
+    auto* accumulator = value<ThetaAccumulator>(group);
+    ThetaSketch other(serialized, allocator_);
+    if (!accumulator->has_value()) {
+      accumulator->emplace(std::move(other));
+    } else {
+      (*accumulator)->combine(mergeOperation_, other);
+    }
+  }
+
+  void decodeArguments(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    decodedValue_.decode(*args[0], rows, true);
+    if (args.size() > 1) {
+      decodedLgK_.decode(*args[1], rows, true);
+      VELOX_USER_CHECK(
+          decodedLgK_.isConstantMapping(),
+          "Theta sketch lgK argument must be constant for all input rows");
+      VELOX_USER_CHECK(
+          !decodedLgK_.isNullAt(rows.begin()),
+          "Theta sketch lgK argument cannot be null");
+      const auto lgK = decodedLgK_.valueAt<int64_t>(rows.begin());
+      ThetaSketch::checkLgK(lgK);
+      lgK_ = lgK;
+    }
+  }
+
+  // True if raw input contains serialized sketches rather than the elements
+  // of the set.
+  const bool sketchAsRawInput_;
+
+  // Combines the sketches of intermediate results, and of the raw input if
+  // 'sketchAsRawInput_'.
+  const ThetaSketch::SetOperation mergeOperation_;
+
+  int8_t lgK_{ThetaSketch::kDefaultLgK};
+  DecodedVector decodedValue_;
+  DecodedVector decodedLgK_;
+  DecodedVector decodedSketch_;
+};
+
+template <TypeKind kind>
+std::unique_ptr<exec::Aggregate> createThetaSketchAggregate(
+    const TypePtr& resultType,
+    bool sketchAsRawInput,
+    ThetaSketch::SetOperation mergeOperation) {
+  using T = typename TypeTraits<kind>::NativeType;
+  return std::make_unique<ThetaSketchAggregate<T>>(
+      resultType, sketchAsRawInput, mergeOperation);
+}
+
+exec::AggregateRegistrationResult registerThetaSketchAggregate(
+    const std::string& name,
+    bool sketchAsRawInput,
+    ThetaSketch::SetOperation mergeOperation,
+    bool withCompanionFunctions,
+    bool overwrite) {
+  std::vector<std::shared_ptr<exec::AggregateFunctionSignature>> signatures;
+  if (sketchAsRawInput) {
+    signatures.push_back(exec::AggregateFunctionSignatureBuilder()
+                             .returnType("varbinary")
+                             .intermediateType("varbinary")
+                             .argumentType("varbinary")
+                             .build());
+  } else {
+    for (const auto& inputType :
+         {"boolean",
+          "tinyint",
+          "smallint",
+          "integer",
+          "bigint",
+          "real",
+          "double",
+          "varchar",
+          "varbinary",
+          "timestamp",
+          "date"}) {
+      signatures.push_back(exec::AggregateFunctionSignatureBuilder()
+                               .returnType("varbinary")
+                               .intermediateType("varbinary")
+                               .argumentType(inputType)
+                               .build());
+      signatures.push_back(exec::AggregateFunctionSignatureBuilder()
+                               .returnType("varbinary")
+                               .intermediateType("varbinary")
+                               .argumentType(inputType)
+                               .constantArgumentType("bigint")
+                               .build());
+    }
+  }
+
+  return exec::registerAggregateFunction(
+      name,
+      std::move(signatures),
+      [sketchAsRawInput, mergeOperation](
+          core::AggregationNode::Step /*step*/,
+          const std::vector<TypePtr>& argTypes,
+          const TypePtr& resultType,
+          const core::QueryConfig& /*config*/)
+          -> std::unique_ptr<exec::Aggregate> {
+        return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+            createThetaSketchAggregate,
+            argTypes[0]->kind(),
+            resultType,
+            sketchAsRawInput,
+            mergeOperation);
+      },
+      withCompanionFunctions,
+      overwrite);
+}
+
+} // namespace
+
+void registerThetaSketchAggregates(
+    const std::string& prefix,
+    bool withCompanionFunctions,
+    bool overwrite) {
+  registerThetaSketchAggregate(
+      prefix + kThetaSketchAgg,
+      false,
+      ThetaSketch::SetOperation::kUnion,
+      withCompanionFunctions,
+      overwrite);
+  // theta_union_agg and theta_intersection_agg are their own companion
+  // functions. Don't register companion functions for them.
+  registerThetaSketchAggregate(
+      prefix + kThetaUnionAgg,
+      true,
+      ThetaSketch::SetOperation::kUnion,
+      false,
+      overwrite);
+  registerThetaSketchAggregate(
+      prefix + kThetaIntersectionAgg,
+      true,
+      ThetaSketch::SetOperation::kIntersection,
+      false,
+      overwrite);
+}
+
+} // namespace facebook::velox::aggregate::prestosql
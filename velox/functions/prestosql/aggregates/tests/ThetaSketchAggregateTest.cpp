@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/lib/aggregates/tests/utils/AggregationTestBase.h"
+
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::functions::aggregate::test;
+
+namespace facebook::velox::aggregate::test {
+namespace {
+class ThetaSketchAggregateTest : public AggregationTestBase {
+ protected:
+  // Returns users 0-199 on day 0, 100-299 on day 1 and 150-349 on day 2.
+  RowVectorPtr makeVisits() {
+    std::vector<int32_t> days;
+    std::vector<int64_t> users;
+    for (auto [day, firstUser] : {std::pair{0, 0}, {1, 100}, {2, 150}}) {
+      for (auto user = firstUser; user < firstUser + 200; ++user) {
+        // Each user visits twice a day.
+        for (auto i = 0; i < 2; ++i) {
+          days.push_back(day);
+          users.push_back(user);
+        }
+      }
+    }
+    return makeRowVector(
+        {"day", "user"},
+        {makeFlatVector<int32_t>(days), makeFlatVector<int64_t>(users)});
+  }
+};
+
+TEST_F(ThetaSketchAggregateTest, estimate) {
+  auto data = makeRowVector(
+      {makeFlatVector<int32_t>(1'000, [](auto row) { return row % 2; }),
+       makeFlatVector<int64_t>(
+           1'000, [](auto row) { return row % 300; }, nullEvery(7)),
+       makeFlatVector<std::string>(
+           1'000, [](auto row) { return fmt::format("s{}", row % 50); })});
+
+  auto expected = makeRowVector(
+      {makeFlatVector<double>({300}), makeFlatVector<double>({50})});
+  testAggregations(
+      {data},
+      {},
+      {"theta_sketch_agg(c1)", "theta_sketch_agg(c2)"},
+      {"theta_sketch_estimate(a0)", "theta_sketch_estimate(a1)"},
+      {expected});
+
+  expected = makeRowVector(
+      {makeFlatVector<int32_t>({0, 1}), makeFlatVector<double>({150, 150})});
+  testAggregations(
+      {data},
+      {"c0"},
+      {"theta_sketch_agg(c1)"},
+      {"c0", "theta_sketch_estimate(a0)"},
+      {expected});
+
+  // With K = 16, the 300 distinct values are estimated within 3 standard
+  // errors.
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .singleAggregation({}, {"theta_sketch_agg(c1, 4)"})
+                  .project({"theta_sketch_estimate(a0)"})
+                  .planNode();
+  auto estimate = AssertQueryBuilder(plan).copyResults(pool());
+  ASSERT_NEAR(
+      estimate->childAt(0)->asFlatVector<double>()->valueAt(0), 300, 225);
+
+  plan = PlanBuilder()
+             .values({data})
+             .singleAggregation({}, {"theta_sketch_agg(c1, 3)"})
+             .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).copyResults(pool()),
+      "Theta sketch lgK must be in [4, 20] range: 3");
+}
+
+TEST_F(ThetaSketchAggregateTest, nullInput) {
+  auto data = makeRowVector(
+      {makeFlatVector<int32_t>({0, 1, 0}),
+       makeNullableFlatVector<int64_t>({std::nullopt, 1, std::nullopt})});
+  auto expected = makeRowVector(
+      {makeFlatVector<int32_t>({0, 1}),
+       makeNullableFlatVector<double>({std::nullopt, 1})});
+  testAggregations(
+      {data},
+      {"c0"},
+      {"theta_sketch_agg(c1)"},
+      {"c0", "theta_sketch_estimate(a0)"},
+      {expected});
+}
+
+TEST_F(ThetaSketchAggregateTest, setOperations) {
+  auto visits = makeVisits();
+
+  // Daily sketches, as a rollup job would store them.
+  auto plan = PlanBuilder()
+                  .values({visits})
+                  .singleAggregation({"day"}, {"theta_sketch_agg(user)"})
+                  .planNode();
+  auto daily = AssertQueryBuilder(plan).copyResults(pool());
+
+  // Users that visited on any day and on every day.
+  auto expected = makeRowVector(
+      {makeFlatVector<double>({350}), makeFlatVector<double>({50})});
+  testAggregations(
+      {daily},
+      {},
+      {"theta_union_agg(a0)", "theta_intersection_agg(a0)"},
+      {"theta_sketch_estimate(a0)", "theta_sketch_estimate(a1)"},
+      {expected});
+
+  // Users that visited on day 0 and day 1, on either day and on day 0 only.
+  plan = PlanBuilder()
+             .values({visits})
+             .project(
+                 {"if(day = 0, user, null) AS d0",
+                  "if(day = 1, user, null) AS d1"})
+             .singleAggregation(
+                 {}, {"theta_sketch_agg(d0)", "theta_sketch_agg(d1)"})
+             .project(
+                 {"theta_sketch_estimate(theta_intersection(a0, a1))",
+                  "theta_sketch_estimate(theta_union(a0, a1))",
+                  "theta_sketch_estimate(theta_difference(a0, a1))"})
+             .planNode();
+  AssertQueryBuilder(plan).assertResults(makeRowVector(
+      {makeFlatVector<double>({100}),
+       makeFlatVector<double>({300}),
+       makeFlatVector<double>({100})}));
+}
+
+TEST_F(ThetaSketchAggregateTest, invalidSketch) {
+  auto data = makeRowVector({makeFlatVector<StringView>(
+      {"not a sketch"}, VARBINARY())});
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .singleAggregation({}, {"theta_union_agg(c0)"})
+                  .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).copyResults(pool()),
+      "Invalid theta sketch: too short");
+}
+} // namespace
+} // namespace facebook::velox::aggregate::test
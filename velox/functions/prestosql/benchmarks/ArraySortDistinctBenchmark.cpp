@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/container/F14Set.h>
+#include <folly/init/Init.h>
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/functions/Macros.h"
+#include "velox/functions/Registerer.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+// Sorts each array on its own.
+template <typename TExec>
+struct udf_array_sort {
+  VELOX_DEFINE_FUNCTION_TYPES(TExec);
+
+  void call(
+      out_type<Array<int64_t>>& out,
+      const arg_type<Array<int64_t>>& array) {
+    values_.clear();
+    vector_size_t numNulls = 0;
+    for (const auto& item : array) {
+      if (item.has_value()) {
+        values_.push_back(*item);
+      } else {
+        ++numNulls;
+      }
+    }
+    std::sort(values_.begin(), values_.end());
+    out.reserve(array.size());
+    for (auto value : values_) {
+      out.push_back(value);
+    }
+    for (auto i = 0; i < numNulls; ++i) {
+      out.add_null();
+    }
+  }
+
+  std::vector<int64_t> values_;
+};
+
+// Builds a hash set for each array.
+template <typename TExec>
+struct udf_array_distinct {
+  VELOX_DEFINE_FUNCTION_TYPES(TExec);
+
+  void call(
+      out_type<Array<int64_t>>& out,
+      const arg_type<Array<int64_t>>& array) {
+    set_.clear();
+    bool hasNull = false;
+    for (const auto& item : array) {
+      if (!item.has_value()) {
+        if (!hasNull) {
+          hasNull = true;
+          out.add_null();
+        }
+      } else if (set_.insert(*item).second) {
+        out.push_back(*item);
+      }
+    }
+  }
+
+  folly::F14FastSet<int64_t> set_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerArrayFunctions();
+
+  registerFunction<udf_array_sort, Array<int64_t>, Array<int64_t>>(
+      {"array_sort_alt"});
+  registerFunction<udf_array_distinct, Array<int64_t>, Array<int64_t>>(
+      {"array_distinct_alt"});
+
+  ExpressionBenchmarkBuilder benchmarkBuilder;
+  auto inputType = ROW({"c0", "c1"}, {ARRAY(BIGINT()), ARRAY(BIGINT())});
+
+  for (size_t length : {5, 50}) {
+    benchmarkBuilder
+        .addBenchmarkSet(fmt::format("array_sort_{}", length), inputType)
+        .withFuzzerOptions(
+            {.vectorSize = 1000, .nullRatio = 0.01, .containerLength = length})
+        .addExpression("vector", "array_sort(c0)")
+        .addExpression("simple", "array_sort_alt(c0)");
+
+    benchmarkBuilder
+        .addBenchmarkSet(fmt::format("array_distinct_{}", length), inputType)
+        .withFuzzerOptions(
+            {.vectorSize = 1000, .nullRatio = 0.01, .containerLength = length})
+        .addExpression("vector", "array_distinct(c0)")
+        .addExpression("simple", "array_distinct_alt(c0)");
+
+    benchmarkBuilder
+        .addBenchmarkSet(fmt::format("array_intersect_{}", length), inputType)
+        .withFuzzerOptions(
+            {.vectorSize = 1000, .nullRatio = 0.01, .containerLength = length})
+        .addExpression("intersect", "array_intersect(c0, c1)")
+        .addExpression("except", "array_except(c0, c1)")
+        .disableTesting();
+  }
+
+  benchmarkBuilder.registerBenchmarks();
+  // Make sure all expressions within benchmarkSets have the same results.
+  benchmarkBuilder.testBenchmarks();
+  folly::runBenchmarks();
+  return 0;
+}
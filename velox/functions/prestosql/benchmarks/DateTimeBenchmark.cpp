@@ -124,6 +124,23 @@ class DateTimeBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, data);
   }
 
+  // Runs 'expression' on timestamps a few seconds apart, like the
+  // timestamps of log records, with a session time zone.
+  void runWithSessionTimezone(const std::string& expression) {
+    folly::BenchmarkSuspender suspender;
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kSessionTimezone, "America/Los_Angeles"},
+        {core::QueryConfig::kAdjustTimestampToTimezone, "true"},
+    });
+    auto timestamps = vectorMaker_.flatVector<Timestamp>(
+        10'000, [](auto row) { return Timestamp(1'700'000'000 + row * 7, 0); });
+    auto data = vectorMaker_.rowVector({timestamps});
+    auto exprSet = compileExpression(expression, data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
   void doRun(exec::ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -163,6 +180,31 @@ BENCHMARK(truncSecond) {
   benchmark.runDateTrunc("second");
 }
 
+BENCHMARK(truncDaySessionTimezone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runWithSessionTimezone("date_trunc('day', c0)");
+}
+
+BENCHMARK(truncHourSessionTimezone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runWithSessionTimezone("date_trunc('hour', c0)");
+}
+
+BENCHMARK(daySessionTimezone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runWithSessionTimezone("day(c0)");
+}
+
+BENCHMARK(hourSessionTimezone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runWithSessionTimezone("hour(c0)");
+}
+
+BENCHMARK_RELATIVE(hourVectorSessionTimezone) {
+  DateTimeBenchmark benchmark;
+  benchmark.runWithSessionTimezone("hour_vector(c0)");
+}
+
 BENCHMARK(year) {
   DateTimeBenchmark benchmark;
   benchmark.run("year");
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/type/DecimalUtil.h"
+
+/// Benchmarks for decimal arithmetic on short and long decimals with equal
+/// and different scales, and for summing long decimals with one
+/// DecimalUtil::addWithOverflow per value or with
+/// DecimalUtil::sumWithOverflow.
+
+using namespace facebook::velox;
+
+namespace {
+
+class DecimalBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  DecimalBenchmark() {
+    functions::prestosql::registerArithmeticFunctions();
+  }
+
+  void run(
+      const std::string& function,
+      const TypePtr& leftType,
+      const TypePtr& rightType) {
+    folly::BenchmarkSuspender suspender;
+    // Small values so that no result overflows.
+    auto makeInput = [&](const TypePtr& type) -> VectorPtr {
+      constexpr vector_size_t kSize = 10'000;
+      if (type->isShortDecimal()) {
+        return vectorMaker_.flatVector<int64_t>(
+            kSize, [](auto row) { return row * 7 - 30'000; }, nullptr, type);
+      }
+      return vectorMaker_.flatVector<int128_t>(
+          kSize, [](auto row) { return row * 7 - 30'000; }, nullptr, type);
+    };
+    auto rowVector = vectorMaker_.rowVector(
+        {makeInput(leftType), makeInput(rightType)});
+    auto exprSet = compileExpression(
+        fmt::format("{}(c0, c1)", function), rowVector->type());
+    suspender.dismiss();
+
+    uint32_t cnt = 0;
+    for (auto i = 0; i < 100; i++) {
+      cnt += evaluate(exprSet, rowVector)->size();
+    }
+    folly::doNotOptimizeAway(cnt);
+  }
+};
+
+std::unique_ptr<DecimalBenchmark> benchmark;
+
+const auto kShort = DECIMAL(18, 2);
+const auto kShortScale4 = DECIMAL(18, 4);
+const auto kLong = DECIMAL(38, 2);
+const auto kLongScale4 = DECIMAL(38, 4);
+
+BENCHMARK(plusShort) {
+  benchmark->run("plus", kShort, kShort);
+}
+
+BENCHMARK_RELATIVE(plusShortRescale) {
+  benchmark->run("plus", kShort, kShortScale4);
+}
+
+BENCHMARK(plusLong) {
+  benchmark->run("plus", kLong, kLong);
+}
+
+BENCHMARK_RELATIVE(plusLongRescale) {
+  benchmark->run("plus", kLong, kLongScale4);
+}
+
+BENCHMARK(minusLong) {
+  benchmark->run("minus", kLong, kLong);
+}
+
+BENCHMARK_RELATIVE(minusLongRescale) {
+  benchmark->run("minus", kLong, kLongScale4);
+}
+
+BENCHMARK(multiplyShort) {
+  benchmark->run("multiply", DECIMAL(9, 2), DECIMAL(9, 2));
+}
+
+BENCHMARK(multiplyLong) {
+  benchmark->run("multiply", kLong, kShort);
+}
+
+BENCHMARK_DRAW_LINE();
+
+std::vector<int128_t> makeLongValues() {
+  std::vector<int128_t> values(10'000);
+  folly::Random::DefaultGenerator rng(1);
+  for (auto& value : values) {
+    value = HugeInt::build(
+                folly::Random::rand64(rng), folly::Random::rand64(rng)) %
+        DecimalUtil::kLongDecimalMax;
+  }
+  return values;
+}
+
+BENCHMARK(sumAddWithOverflow, n) {
+  folly::BenchmarkSuspender suspender;
+  const auto values = makeLongValues();
+  suspender.dismiss();
+
+  for (auto i = 0; i < n; ++i) {
+    int128_t sum = 0;
+    int64_t overflow = 0;
+    for (auto value : values) {
+      overflow += DecimalUtil::addWithOverflow(sum, sum, value);
+    }
+    folly::doNotOptimizeAway(sum);
+    folly::doNotOptimizeAway(overflow);
+  }
+}
+
+BENCHMARK_RELATIVE(sumWithOverflow, n) {
+  folly::BenchmarkSuspender suspender;
+  const auto values = makeLongValues();
+  suspender.dismiss();
+
+  for (auto i = 0; i < n; ++i) {
+    int128_t sum = 0;
+    const auto overflow =
+        DecimalUtil::sumWithOverflow(sum, values.data(), values.size());
+    folly::doNotOptimizeAway(sum);
+    folly::doNotOptimizeAway(overflow);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<DecimalBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
@@ -270,6 +270,42 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     doRun(iter, exprSet, rowVector);
   }
 
+  // Extracts 'numPaths' fields from the same column of distinct documents,
+  // with or without the document cache.
+  void runWithMultiPathExtract(
+      int iter,
+      int vectorSize,
+      int jsonSize,
+      int numPaths,
+      bool documentCache) {
+    folly::BenchmarkSuspender suspender;
+
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kJsonDocumentCacheMaxBytes,
+         documentCache ? "16777216" : "0"},
+    });
+    auto json = prepareData(jsonSize);
+    auto jsonVector = vectorMaker_.flatVector<std::string>(
+        vectorSize,
+        [&](auto row) {
+          return fmt::format(R"({{"id": {}, {})", row, json.substr(1));
+        },
+        nullptr,
+        JSON());
+    auto rowVector = vectorMaker_.rowVector({jsonVector});
+
+    std::vector<core::TypedExprPtr> expressions;
+    for (auto i = 0; i < numPaths; ++i) {
+      auto untyped = parse::parseExpr(
+          fmt::format("json_extract_scalar(c0, '$.key[{}].k1')", i), options_);
+      expressions.push_back(core::Expressions::inferTypes(
+          untyped, rowVector->type(), execCtx_.pool()));
+    }
+    exec::ExprSet exprSet(expressions, &execCtx_);
+    suspender.dismiss();
+    doRun(iter, exprSet, rowVector);
+  }
+
   void doRun(
       const int iter,
       velox::exec::ExprSet& exprSet,
@@ -384,6 +420,23 @@ void SIMDJsonSize(int iter, int vectorSize, int jsonSize) {
   benchmark.runWithJsonExtract(iter, vectorSize, "json_size", json, "$.key");
 }
 
+void SIMDJsonExtractScalarMultiPath(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  suspender.dismiss();
+  benchmark.runWithMultiPathExtract(iter, vectorSize, jsonSize, 8, false);
+}
+
+void SIMDJsonExtractScalarMultiPathCached(
+    int iter,
+    int vectorSize,
+    int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  suspender.dismiss();
+  benchmark.runWithMultiPathExtract(iter, vectorSize, jsonSize, 8, true);
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK_NAMED_PARAM(FollyIsJsonScalar, 100_iters_10bytes_size, 100, 10);
@@ -607,6 +660,31 @@ BENCHMARK_RELATIVE_NAMED_PARAM(
     10000);
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarMultiPath,
+    100_iters_100bytes_size,
+    100,
+    100);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarMultiPathCached,
+    100_iters_100bytes_size,
+    100,
+    100);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarMultiPath,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarMultiPathCached,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_DRAW_LINE();
+
 } // namespace
 } // namespace facebook::velox::functions::prestosql
 
@@ -116,6 +116,9 @@ int main(int argc, char** argv) {
       "max_data_size_for_stats",
       "map_union_sum",
       "approx_set",
+      "theta_sketch_agg",
+      "theta_union_agg",
+      "theta_intersection_agg",
       "min_by",
       "max_by",
       "any_value",
@@ -150,6 +153,9 @@ int main(int argc, char** argv) {
           // Order-dependent functions.
           {"approx_distinct", std::make_shared<ApproxDistinctResultVerifier>()},
           {"approx_set", nullptr},
+          {"theta_sketch_agg", nullptr},
+          {"theta_union_agg", nullptr},
+          {"theta_intersection_agg", nullptr},
           {"approx_percentile",
            std::make_shared<ApproxPercentileResultVerifier>()},
           {"arbitrary", std::make_shared<ArbitraryResultVerifier>()},
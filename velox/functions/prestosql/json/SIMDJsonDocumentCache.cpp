@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/json/SIMDJsonDocumentCache.h"
+
+#include <cstring>
+
+namespace facebook::velox::functions {
+
+// static
+SIMDJsonDocumentCache& SIMDJsonDocumentCache::instance() {
+  thread_local SIMDJsonDocumentCache cache;
+  return cache;
+}
+
+simdjson::error_code SIMDJsonDocumentCache::get(
+    std::string_view json,
+    uint64_t maxBytes,
+    simdjson::ondemand::document*& document) {
+  document = nullptr;
+  if (json.size() > kMaxDocumentSize || entryBytes(json.size()) > maxBytes) {
+    return simdjson::SUCCESS;
+  }
+
+  const Key key{json.data(), json.size()};
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    auto& entry = *it->second;
+    if (std::memcmp(entry.json.data(), json.data(), json.size()) == 0) {
+      ++numHits_;
+      entry.document.rewind();
+      document = &entry.document;
+      return simdjson::SUCCESS;
+    }
+    // The buffer was reused for another document.
+    bytes_ -= entryBytes(json.size());
+    entries_.erase(it);
+  }
+
+  if (bytes_ + entryBytes(json.size()) > maxBytes) {
+    clear();
+  }
+
+  auto entry = std::make_unique<Entry>();
+  entry->json = simdjson::padded_string(json.data(), json.size());
+  SIMDJSON_ASSIGN_OR_RAISE(entry->document, entry->parser.iterate(entry->json));
+  document = &entry->document;
+  bytes_ += entryBytes(json.size());
+  entries_.emplace(key, std::move(entry));
+  return simdjson::SUCCESS;
+}
+
+void SIMDJsonDocumentCache::erase(std::string_view json) {
+  if (entries_.erase(Key{json.data(), json.size()}) > 0) {
+    bytes_ -= entryBytes(json.size());
+  }
+}
+
+void SIMDJsonDocumentCache::clear() {
+  entries_.clear();
+  bytes_ = 0;
+}
+
+} // namespace facebook::velox::functions
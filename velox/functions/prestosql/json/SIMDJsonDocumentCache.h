@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <memory>
+#include <string_view>
+
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
+
+namespace facebook::velox::functions {
+
+/// Thread local cache of JSON documents indexed by the simdjson on-demand
+/// parser. Each json function call over a column evaluates the whole vector, so
+/// a projection with several json_extract calls on the same column parses
+/// every document once per call. The cache keeps the parsed documents of the
+/// input vector and rewinds them on the later calls, which then only navigate
+/// to their paths.
+///
+/// Documents are keyed by the address and size of the input string and the
+/// cached copy is compared with the input on lookup, so a buffer that is reused
+/// for different contents misses. The cache is cleared when it is full, which
+/// drops the documents of the previous vectors in one go instead of evicting
+/// the documents of the current vector one at a time. Not thread safe.
+class SIMDJsonDocumentCache {
+ public:
+  /// Documents larger than this are not cached.
+  static constexpr size_t kMaxDocumentSize = 16 << 10;
+
+  /// Returns the cache of the calling thread.
+  static SIMDJsonDocumentCache& instance();
+
+  /// Sets 'document' to the cached document for 'json', rewound to its start.
+  /// Parses and caches 'json' on a miss. Sets 'document' to nullptr if 'json'
+  /// is not cacheable, in which case the caller parses it. The memory of all
+  /// documents is kept under 'maxBytes'. Returns the parse error if 'json'
+  /// could not be indexed.
+  simdjson::error_code get(
+      std::string_view json,
+      uint64_t maxBytes,
+      simdjson::ondemand::document*& document);
+
+  /// Drops the document for 'json'. Must be called after navigating the
+  /// document fails since on-demand documents keep their errors.
+  void erase(std::string_view json);
+
+  void clear();
+
+  size_t size() const {
+    return entries_.size();
+  }
+
+  uint64_t bytes() const {
+    return bytes_;
+  }
+
+  uint64_t numHits() const {
+    return numHits_;
+  }
+
+ private:
+  struct Entry {
+    simdjson::padded_string json;
+    simdjson::ondemand::parser parser;
+    simdjson::ondemand::document document;
+  };
+
+  using Key = std::pair<const char*, size_t>;
+
+  // Approximate memory of an entry for a document of 'size' bytes. The parser
+  // keeps 4 bytes of structural index and close to 2 bytes of string buffer
+  // per input byte.
+  static uint64_t entryBytes(size_t size) {
+    return sizeof(Entry) + 7 * size + simdjson::SIMDJSON_PADDING;
+  }
+
+  folly::F14FastMap<Key, std::unique_ptr<Entry>> entries_;
+  uint64_t bytes_{0};
+  uint64_t numHits_{0};
+};
+
+} // namespace facebook::velox::functions
@@ -22,6 +22,7 @@
 #include "folly/dynamic.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
+#include "velox/functions/prestosql/json/SIMDJsonDocumentCache.h"
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/type/StringView.h"
 
@@ -127,6 +128,25 @@ simdjson::error_code SIMDJsonExtractor::extract(
   return consumer(input);
 };
 
+namespace detail {
+
+template <typename TConsumer>
+simdjson::error_code extractFromDocument(
+    simdjson::ondemand::document& jsonDoc,
+    SIMDJsonExtractor& extractor,
+    TConsumer& consumer) {
+  if (extractor.isRootOnlyPath()) {
+    // If the path is just to return the original object, call consumer on the
+    // document.  Note, we cannot convert this to a value as this is not
+    // supported if the object is a scalar.
+    return consumer(jsonDoc);
+  }
+  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
+  return extractor.extract(value, consumer);
+}
+
+} // namespace detail
+
 /**
  * Extract element(s) from a JSON object using the given path.
  * @param json: A JSON object
@@ -142,6 +162,9 @@ simdjson::error_code SIMDJsonExtractor::extract(
  *                  Note that once consumer returns, it should be assumed that
  *                  the argument passed in is no longer valid, so do not attempt
  *                  to store it as is in the consumer.
+ * @param documentCacheMaxBytes: If > 0, the parsed document is kept in the
+ *                  thread local SIMDJsonDocumentCache of at most so many bytes
+ *                  and reused by later calls on the same input.
  * @return Return simdjson::SUCCESS on success.
  *         If any errors are encountered parsing the JSON, returns the error.
  */
@@ -149,18 +172,26 @@ template <typename TConsumer>
 simdjson::error_code simdJsonExtract(
     const velox::StringView& json,
     SIMDJsonExtractor& extractor,
-    TConsumer&& consumer) {
+    TConsumer&& consumer,
+    uint64_t documentCacheMaxBytes = 0) {
+  // Inlined strings are too small to be worth caching.
+  if (documentCacheMaxBytes > 0 && !json.isInline()) {
+    auto& cache = SIMDJsonDocumentCache::instance();
+    const std::string_view input(json.data(), json.size());
+    simdjson::ondemand::document* cachedDoc;
+    SIMDJSON_TRY(cache.get(input, documentCacheMaxBytes, cachedDoc));
+    if (cachedDoc != nullptr) {
+      auto error = detail::extractFromDocument(*cachedDoc, extractor, consumer);
+      if (error != simdjson::SUCCESS) {
+        cache.erase(input);
+      }
+      return error;
+    }
+  }
+
   simdjson::padded_string paddedJson(json.data(), json.size());
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
-
-  if (extractor.isRootOnlyPath()) {
-    // If the path is just to return the original object, call consumer on the
-    // document.  Note, we cannot convert this to a value as this is not
-    // supported if the object is a scalar.
-    return consumer(jsonDoc);
-  }
-  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
-  return extractor.extract(value, std::forward<TConsumer>(consumer));
+  return detail::extractFromDocument(jsonDoc, extractor, consumer);
 }
 
 } // namespace facebook::velox::functions
@@ -548,5 +548,70 @@ TEST_F(SIMDJsonExtractorTest, invalidJson) {
   EXPECT_NE(simdJsonExtract(json, "$.foo[0]", consumer), simdjson::SUCCESS);
 }
 
+TEST_F(SIMDJsonExtractorTest, documentCache) {
+  auto& cache = SIMDJsonDocumentCache::instance();
+  cache.clear();
+  const auto numHits = cache.numHits();
+
+  std::string ret;
+  auto consumer = [&ret](auto& v) {
+    SIMDJSON_ASSIGN_OR_RAISE(ret, simdjson::to_json_string(v));
+    return simdjson::SUCCESS;
+  };
+  auto extract = [&](const std::string& json,
+                     const std::string& path,
+                     uint64_t maxBytes = 1 << 20)
+      -> std::optional<std::string> {
+    auto& extractor = SIMDJsonExtractor::getInstance(path);
+    if (simdJsonExtract(StringView(json), extractor, consumer, maxBytes) !=
+        simdjson::SUCCESS) {
+      return std::nullopt;
+    }
+    return ret;
+  };
+
+  // Several paths on the same document parse it once.
+  std::string json = R"({"a": 1, "b": {"c": [10, 20]}, "d": "x"})";
+  EXPECT_EQ(extract(json, "$.a"), "1");
+  EXPECT_EQ(extract(json, "$.b.c[1]"), "20");
+  EXPECT_EQ(extract(json, "$.d"), "\"x\"");
+  EXPECT_EQ(extract(json, "$.a"), "1");
+  EXPECT_EQ(extract(json, "$"), json);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.numHits() - numHits, 4);
+
+  // The same buffer with different contents.
+  json[6] = '2';
+  EXPECT_EQ(extract(json, "$.a"), "2");
+  EXPECT_EQ(cache.size(), 1);
+
+  // A document that fails while navigating is dropped so that its error does
+  // not stick to later paths.
+  std::string invalid = R"({"a": 1 "b": 2})";
+  EXPECT_EQ(extract(invalid, "$.b"), std::nullopt);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(extract(invalid, "$.a"), "1");
+
+  // Documents that cannot be indexed are not cached.
+  cache.clear();
+  std::string unterminated = R"({"a": 1, "b": "x)";
+  EXPECT_EQ(extract(unterminated, "$.a"), std::nullopt);
+  EXPECT_EQ(cache.size(), 0);
+
+  // Large documents are parsed without the cache.
+  std::string large = fmt::format(
+      R"({{"a": "{}"}})",
+      std::string(SIMDJsonDocumentCache::kMaxDocumentSize, 'x'));
+  EXPECT_EQ(extract(large, "$.a")->size(), large.size() - 7);
+  EXPECT_EQ(cache.size(), 0);
+
+  // The cache is cleared when it is full.
+  EXPECT_EQ(extract(json, "$.a"), "2");
+  const auto maxBytes = cache.bytes() + 10;
+  EXPECT_EQ(extract(invalid, "$.a", maxBytes), "1");
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_LE(cache.bytes(), maxBytes);
+}
+
 } // namespace
 } // namespace facebook::velox::functions
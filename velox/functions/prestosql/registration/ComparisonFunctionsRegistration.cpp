@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Comparisons.h"
@@ -118,6 +119,15 @@ void registerComparisonFunctions(const std::string& prefix) {
       ShortDecimal<P1, S1>,
       ShortDecimal<P1, S1>,
       ShortDecimal<P1, S1>>({prefix + "between"});
+
+  const std::vector<TypePtr> fusedTypes = {
+      TINYINT(), SMALLINT(), INTEGER(), BIGINT(), REAL(), DOUBLE()};
+  exec::registerFusedFunction(prefix + "eq", exec::FusedOp::kEq, fusedTypes);
+  exec::registerFusedFunction(prefix + "neq", exec::FusedOp::kNeq, fusedTypes);
+  exec::registerFusedFunction(prefix + "lt", exec::FusedOp::kLt, fusedTypes);
+  exec::registerFusedFunction(prefix + "lte", exec::FusedOp::kLte, fusedTypes);
+  exec::registerFusedFunction(prefix + "gt", exec::FusedOp::kGt, fusedTypes);
+  exec::registerFusedFunction(prefix + "gte", exec::FusedOp::kGte, fusedTypes);
 }
 
 } // namespace facebook::velox::functions
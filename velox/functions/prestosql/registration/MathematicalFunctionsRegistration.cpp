@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Arithmetic.h"
@@ -37,6 +38,8 @@ void registerMathFunctions(const std::string& prefix) {
       ShortDecimal<P1, S1>>({prefix + "abs"});
 
   registerUnaryFloatingPoint<NegateFunction>({prefix + "negate"});
+  exec::registerFusedFunction(
+      prefix + "negate", exec::FusedOp::kNegate, {REAL(), DOUBLE()});
   registerFunction<NegateFunction, LongDecimal<P1, S1>, LongDecimal<P1, S1>>(
       {prefix + "negate"});
   registerFunction<NegateFunction, ShortDecimal<P1, S1>, ShortDecimal<P1, S1>>(
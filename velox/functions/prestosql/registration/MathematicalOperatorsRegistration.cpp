@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Arithmetic.h"
@@ -56,6 +57,16 @@ void registerMathOperators(const std::string& prefix = "") {
       IntervalDayTime,
       double>({prefix + "divide"});
   registerBinaryFloatingPoint<ModulusFunction>({prefix + "mod"});
+
+  const std::vector<TypePtr> floatingPointTypes = {REAL(), DOUBLE()};
+  exec::registerFusedFunction(
+      prefix + "plus", exec::FusedOp::kPlus, floatingPointTypes);
+  exec::registerFusedFunction(
+      prefix + "minus", exec::FusedOp::kMinus, floatingPointTypes);
+  exec::registerFusedFunction(
+      prefix + "multiply", exec::FusedOp::kMultiply, floatingPointTypes);
+  exec::registerFusedFunction(
+      prefix + "divide", exec::FusedOp::kDivide, floatingPointTypes);
 }
 
 } // namespace
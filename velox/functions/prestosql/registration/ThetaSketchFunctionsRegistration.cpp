@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/Registerer.h"
+#include "velox/functions/prestosql/ThetaSketchFunctions.h"
+
+namespace facebook::velox::functions {
+
+void registerThetaSketchFunctions(const std::string& prefix) {
+  registerFunction<ThetaSketchEstimateFunction, double, Varbinary>(
+      {prefix + "theta_sketch_estimate"});
+  registerFunction<ThetaUnionFunction, Varbinary, Varbinary, Varbinary>(
+      {prefix + "theta_union"});
+  registerFunction<
+      ThetaIntersectionFunction,
+      Varbinary,
+      Varbinary,
+      Varbinary>({prefix + "theta_intersection"});
+  registerFunction<ThetaDifferenceFunction, Varbinary, Varbinary, Varbinary>(
+      {prefix + "theta_difference"});
+}
+} // namespace facebook::velox::functions
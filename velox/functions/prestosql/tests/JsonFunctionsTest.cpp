@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/json/SIMDJsonDocumentCache.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
@@ -689,6 +690,65 @@ TEST_F(JsonFunctionsTest, jsonExtract) {
   VELOX_ASSERT_THROW(jsonExtract(kJson, "$.store.keys()"), "Invalid JSON path");
 }
 
+TEST_F(JsonFunctionsTest, documentCache) {
+  auto data = makeRowVector({makeFlatVector<std::string>(
+      1'000,
+      [](auto row) {
+        if (row % 17 == 0) {
+          // Fails while navigating to "b".
+          return fmt::format(R"({{"a": {} "b": [1, 2]}})", row);
+        }
+        return fmt::format(
+            R"({{"a": {}, "b": [{}, "x{}"], "c": {{"d": {}}}}})",
+            row,
+            row % 5,
+            row,
+            row * 2);
+      },
+      nullEvery(11),
+      JSON())});
+
+  const std::vector<std::string> expressions = {
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract(c0, '$.b')",
+      "json_extract_scalar(c0, '$.b[1]')",
+      "json_size(c0, '$.c')",
+      "json_extract(c0, '$')",
+  };
+
+  auto setMaxBytes = [&](uint64_t maxBytes) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kJsonDocumentCacheMaxBytes,
+         std::to_string(maxBytes)},
+    });
+  };
+
+  setMaxBytes(0);
+  std::vector<VectorPtr> expected;
+  for (const auto& expression : expressions) {
+    expected.push_back(evaluate(expression, data));
+  }
+
+  auto& cache = SIMDJsonDocumentCache::instance();
+  cache.clear();
+  setMaxBytes(16 << 20);
+  const auto numHits = cache.numHits();
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    assertEqualVectors(expected[i], evaluate(expressions[i], data));
+  }
+  // Each expression after the first finds the documents of the first.
+  EXPECT_GT(cache.numHits() - numHits, 3 * 900);
+
+  // A budget smaller than the vector clears the cache as it fills up.
+  setMaxBytes(32 << 10);
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    assertEqualVectors(expected[i], evaluate(expressions[i], data));
+  }
+  EXPECT_LE(cache.bytes(), 32 << 10);
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -714,6 +714,55 @@ TEST_F(StringFunctionsTest, lower) {
   }
 }
 
+// Test upper and lower of ascii strings that are not converted in place.
+TEST_F(StringFunctionsTest, upperLowerAsciiNotInPlace) {
+  auto input = makeFlatVector<std::string>(
+      {"abc",
+       "Mixed Case Ascii String",
+       "",
+       "ALL UPPER CASE STRING 123",
+       "short MiX",
+       "all lower case string 456"});
+  auto data = makeRowVector({input});
+
+  auto expected = makeFlatVector<std::string>(
+      {"ABC",
+       "MIXED CASE ASCII STRING",
+       "",
+       "ALL UPPER CASE STRING 123",
+       "SHORT MIX",
+       "ALL LOWER CASE STRING 456"});
+  assertEqualVectors(expected, evaluate("upper(c0)", data));
+
+  expected = makeFlatVector<std::string>(
+      {"abc",
+       "mixed case ascii string",
+       "",
+       "all upper case string 123",
+       "short mix",
+       "all lower case string 456"});
+  assertEqualVectors(expected, evaluate("lower(c0)", data));
+
+  // A subset of the rows.
+  expected = makeNullableFlatVector<std::string>(
+      {std::nullopt,
+       "MIXED CASE ASCII STRING",
+       std::nullopt,
+       "ALL UPPER CASE STRING 123",
+       std::nullopt,
+       "ALL LOWER CASE STRING 456"});
+  assertEqualVectors(
+      expected, evaluate("if(length(c0) > 20, upper(c0), null)", data));
+
+  // Strings that are not in the string buffers of the vector.
+  std::string external = "not in the string buffers";
+  auto externalInput = makeFlatVector<std::string>({"in the string buffers"});
+  externalInput->setNoCopy(0, StringView(external));
+  assertEqualVectors(
+      makeFlatVector<std::string>({"NOT IN THE STRING BUFFERS"}),
+      evaluate("upper(c0)", makeRowVector({externalInput})));
+}
+
 // Test concat vector function
 TEST_F(StringFunctionsTest, concat) {
   size_t maxArgsCount = 10; // cols
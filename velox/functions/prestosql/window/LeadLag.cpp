@@ -434,7 +434,11 @@ void registerLag(const std::string& name) {
           -> std::unique_ptr<exec::WindowFunction> {
         return std::make_unique<LeadLagFunction<true>>(
             args, resultType, ignoreNulls, pool);
-      });
+      },
+      exec::WindowFunction::Metadata{
+          /*frameBoundedAccess=*/false,
+          /*usesFrames=*/false,
+          /*usesPeerGroups=*/false});
 }
 
 void registerLead(const std::string& name) {
@@ -451,6 +455,10 @@ void registerLead(const std::string& name) {
           -> std::unique_ptr<exec::WindowFunction> {
         return std::make_unique<LeadLagFunction<false>>(
             args, resultType, ignoreNulls, pool);
-      });
+      },
+      exec::WindowFunction::Metadata{
+          /*frameBoundedAccess=*/false,
+          /*usesFrames=*/false,
+          /*usesPeerGroups=*/false});
 }
 } // namespace facebook::velox::window::prestosql
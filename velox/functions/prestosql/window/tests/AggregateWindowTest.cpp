@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/functions/lib/window/tests/WindowTestBase.h"
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
@@ -388,5 +390,46 @@ TEST_F(AggregateWindowTest, integerOverflowRowsFrame) {
       expected);
 }
 
+// Tests sliding frames over partitions large enough for several levels of
+// the segment tree against the aggregation of all the rows of each frame.
+TEST_F(AggregateWindowTest, segmentTree) {
+  const vector_size_t size = 5'000;
+  auto input = makeRowVector(
+      {makeFlatVector<int64_t>(size, [](auto row) { return row % 3; }),
+       makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+       makeFlatVector<double>(
+           size, [](auto row) { return row % 101 * 0.5; }, nullEvery(7)),
+       makeFlatVector<int64_t>(size, [](auto row) { return row % 37; })});
+
+  const std::vector<std::string> frames = {
+      "rows between 100 preceding and current row",
+      "rows between 700 preceding and 30 following",
+      "rows between 5 following and 1000 following",
+      "rows between c3 preceding and c3 following",
+  };
+  for (const auto& function :
+       {"sum(c2)", "min(c2)", "count(c2)", "avg(c2)", "array_agg(c2)"}) {
+    for (const auto& frame : frames) {
+      SCOPED_TRACE(fmt::format("{} {}", function, frame));
+      auto plan =
+          PlanBuilder()
+              .values({input})
+              .window({fmt::format(
+                  "{} over (partition by c0 order by c1 {})", function, frame)})
+              .planNode();
+      auto expected =
+          AssertQueryBuilder(plan)
+              .config(
+                  core::QueryConfig::kWindowAggregateSegmentTreeEnabled,
+                  "false")
+              .copyResults(pool());
+      AssertQueryBuilder(plan)
+          .config(
+              core::QueryConfig::kWindowAggregateSegmentTreeEnabled, "true")
+          .assertResults(expected);
+    }
+  }
+}
+
 }; // namespace
 }; // namespace facebook::velox::window::test
@@ -16,7 +16,11 @@
 
 #include "velox/functions/remote/client/Remote.h"
 
+#include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
+
+#include <deque>
+
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/remote/client/ThriftClient.h"
@@ -33,6 +37,8 @@ std::string serializeType(const TypePtr& type) {
   return type::fbhive::HiveTypeSerializer::serialize(type);
 }
 
+using ResponseFuture = folly::SemiFuture<remote::RemoteFunctionResponse>;
+
 class RemoteFunction : public exec::VectorFunction {
  public:
   RemoteFunction(
@@ -43,7 +49,10 @@ class RemoteFunction : public exec::VectorFunction {
         location_(metadata.location),
         thriftClient_(getThriftClient(location_, &eventBase_)),
         serdeFormat_(metadata.serdeFormat),
-        serde_(getSerde(serdeFormat_)) {
+        serde_(getSerde(serdeFormat_)),
+        maxRequestPayloadBytes_(metadata.maxRequestPayloadBytes),
+        maxRequestsInFlight_(
+            std::max<uint32_t>(1, metadata.maxRequestsInFlight)) {
     std::vector<TypePtr> types;
     types.reserve(inputArgs.size());
     serializedInputTypes_.reserve(inputArgs.size());
@@ -85,8 +94,74 @@ class RemoteFunction : public exec::VectorFunction {
         rows.end(),
         std::move(args));
 
-    // Send to remote server.
-    remote::RemoteFunctionResponse remoteResponse;
+    const auto rowsPerRequest = computeRowsPerRequest(remoteRowVector);
+    if (rowsPerRequest >= rows.end()) {
+      // TODO: serialize only active rows.
+      auto response = waitForResponse(
+          sendRequest(remoteRowVector, rows.end(), outputType, context));
+      result = deserializeResult(response, outputType, context);
+      return;
+    }
+
+    // Splits the batch into ranges of 'rowsPerRequest' rows and keeps up to
+    // 'maxRequestsInFlight_' requests outstanding. Waiting for the oldest
+    // request runs the event base, which sends the queued requests and
+    // receives the responses of the others meanwhile.
+    result = BaseVector::create(outputType, rows.end(), context.pool());
+    std::deque<std::pair<vector_size_t, ResponseFuture>> inFlight;
+    auto processOldest = [&]() {
+      auto [offset, future] = std::move(inFlight.front());
+      inFlight.pop_front();
+      auto response = waitForResponse(std::move(future));
+      auto chunk = deserializeResult(response, outputType, context);
+      result->copy(chunk.get(), offset, 0, chunk->size());
+    };
+
+    const auto* bits = rows.asRange().bits();
+    for (vector_size_t offset = 0; offset < rows.end();
+         offset += rowsPerRequest) {
+      const auto size = std::min(rowsPerRequest, rows.end() - offset);
+      if (bits::findFirstBit(bits, offset, offset + size) < 0) {
+        continue;
+      }
+      if (inFlight.size() >= maxRequestsInFlight_) {
+        processOldest();
+      }
+      inFlight.emplace_back(
+          offset,
+          sendRequest(
+              std::dynamic_pointer_cast<RowVector>(
+                  remoteRowVector->slice(offset, size)),
+              size,
+              outputType,
+              context));
+    }
+    while (!inFlight.empty()) {
+      processOldest();
+    }
+  }
+
+  // Returns the number of rows to send per request so that the serialized
+  // input of a request is about 'maxRequestPayloadBytes_'.
+  vector_size_t computeRowsPerRequest(const RowVectorPtr& input) const {
+    if (maxRequestPayloadBytes_ == 0 || input->size() == 0) {
+      return input->size();
+    }
+    const auto bytesPerRow =
+        std::max<uint64_t>(1, input->estimateFlatSize() / input->size());
+    return std::max<uint64_t>(
+        1,
+        std::min<uint64_t>(
+            input->size(), maxRequestPayloadBytes_ / bytesPerRow));
+  }
+
+  // Serializes the first 'size' rows of 'input' and starts a request for
+  // them. The request is sent when the event base runs.
+  ResponseFuture sendRequest(
+      const RowVectorPtr& input,
+      vector_size_t size,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     remote::RemoteFunctionRequest request;
     request.throwOnError_ref() = context.throwOnError();
 
@@ -96,15 +171,18 @@ class RemoteFunction : public exec::VectorFunction {
     functionHandle->argumentTypes_ref() = serializedInputTypes_;
 
     auto requestInputs = request.inputs_ref();
-    requestInputs->rowCount_ref() = remoteRowVector->size();
+    requestInputs->rowCount_ref() = size;
     requestInputs->pageFormat_ref() = serdeFormat_;
+    requestInputs->payload_ref() =
+        rowVectorToIOBuf(input, size, *context.pool(), serde_.get());
 
-    // TODO: serialize only active rows.
-    requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
+    return thriftClient_->semifuture_invokeFunction(request);
+  }
 
+  // Runs the event base until 'future' is complete.
+  remote::RemoteFunctionResponse waitForResponse(ResponseFuture future) const {
     try {
-      thriftClient_->sync_invokeFunction(remoteResponse, request);
+      return std::move(future).via(&eventBase_).getVia(&eventBase_);
     } catch (const std::exception& e) {
       VELOX_FAIL(
           "Error while executing remote function '{}' at '{}': {}",
@@ -112,22 +190,31 @@ class RemoteFunction : public exec::VectorFunction {
           location_.describe(),
           e.what());
     }
+  }
 
+  VectorPtr deserializeResult(
+      const remote::RemoteFunctionResponse& response,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     auto outputRowVector = IOBufToRowVector(
-        remoteResponse.get_result().get_payload(),
+        response.get_result().get_payload(),
         ROW({outputType}),
         *context.pool(),
         serde_.get());
-    result = outputRowVector->childAt(0);
+    return outputRowVector->childAt(0);
   }
 
   const std::string functionName_;
   folly::SocketAddress location_;
 
-  folly::EventBase eventBase_;
+  // Runs the requests of the thread that evaluates the function. Driven only
+  // while waiting for responses.
+  mutable folly::EventBase eventBase_;
   std::unique_ptr<RemoteFunctionClient> thriftClient_;
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
+  const uint64_t maxRequestPayloadBytes_;
+  const uint32_t maxRequestsInFlight_;
 
   // Structures we construct once to cache:
   RowTypePtr remoteInputType_;
@@ -30,6 +30,15 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
 
   /// The serialization format to be used
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Approximate maximum size in bytes of the input payload of a single
+  /// request. Larger batches are split into several requests that are sent
+  /// concurrently. 0 means that each batch is sent in a single request.
+  uint64_t maxRequestPayloadBytes{0};
+
+  /// Maximum number of requests in flight per function instance when a batch
+  /// is split.
+  uint32_t maxRequestsInFlight{4};
 };
 
 /// Registers a new remote function. It will use the meatadata defined in
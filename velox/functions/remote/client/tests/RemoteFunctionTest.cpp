@@ -62,6 +62,14 @@ class RemoteFunctionTest
                                .build()};
     registerRemoteFunction("remote_plus", plusSignatures, metadata);
 
+    // Splits batches into requests of about 1KB.
+    RemoteVectorFunctionMetadata splitMetadata = metadata;
+    splitMetadata.maxRequestPayloadBytes = 1'024;
+    splitMetadata.maxRequestsInFlight = 3;
+    registerRemoteFunction("remote_plus_split", plusSignatures, splitMetadata);
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {remotePrefix_ + ".remote_plus_split"});
+
     RemoteVectorFunctionMetadata wrongMetadata = metadata;
     wrongMetadata.location = folly::SocketAddress(); // empty address.
     registerRemoteFunction("remote_wrong_port", plusSignatures, wrongMetadata);
@@ -140,6 +148,26 @@ TEST_P(RemoteFunctionTest, simple) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, splitRequests) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          10'000, [](auto row) { return row * 2; }, nullEvery(5)),
+  });
+  auto expected = makeFlatVector<int64_t>(
+      10'000, [](auto row) { return row * 3; }, nullEvery(5));
+  assertEqualVectors(expected, evaluate("remote_plus_split(c0, c1)", data));
+
+  // Ranges with no selected rows are not sent.
+  auto exprSet = compileExpression(
+      "remote_plus_split(c0, c1)", asRowType(data->type()));
+  SelectivityVector rows(data->size(), false);
+  rows.setValidRange(100, 200, true);
+  rows.setValidRange(9'000, 9'500, true);
+  rows.updateBounds();
+  assertEqualVectors(expected, evaluate(*exprSet, data, rows), rows);
+}
+
 TEST_P(RemoteFunctionTest, string) {
   auto inputVector =
       makeFlatVector<StringView>({"hello", "my", "remote", "world"});
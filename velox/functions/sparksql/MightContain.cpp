@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/sparksql/MightContain.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/expression/DecodedArgs.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+
+class BloomFilterMightContainFunction : public exec::VectorFunction {
+ public:
+  // 'serialized' is the constant bloom filter argument or nullptr if the
+  // argument is not constant.
+  explicit BloomFilterMightContainFunction(const BaseVector* serialized)
+      : constantBloomFilter_(serialized != nullptr) {
+    if (serialized != nullptr && !serialized->isNullAt(0)) {
+      bloomFilter_.merge(serialized->as<ConstantVector<StringView>>()
+                             ->valueAt(0)
+                             .data());
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /*outputType*/,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    context.ensureWritable(rows, BOOLEAN(), result);
+    auto* flatResult = result->asFlatVector<bool>();
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto* values = decodedArgs.at(1);
+
+    if (!constantBloomFilter_) {
+      auto* serialized = decodedArgs.at(0);
+      rows.applyToSelected([&](auto row) {
+        BloomFilter<> bloomFilter;
+        bloomFilter.merge(serialized->valueAt<StringView>(row).data());
+        flatResult->set(
+            row,
+            bloomFilter.isSet() &&
+                bloomFilter.mayContain(
+                    folly::hasher<int64_t>()(values->valueAt<int64_t>(row))));
+      });
+      return;
+    }
+
+    if (!bloomFilter_.isSet()) {
+      rows.applyToSelected([&](auto row) { flatResult->set(row, false); });
+      return;
+    }
+
+    std::vector<uint64_t> hashes;
+    hashes.reserve(rows.countSelected());
+    rows.applyToSelected([&](auto row) {
+      hashes.push_back(folly::hasher<int64_t>()(values->valueAt<int64_t>(row)));
+    });
+    std::vector<uint64_t> contained(bits::nwords(hashes.size()));
+    bloomFilter_.mayContain(hashes.data(), hashes.size(), contained.data());
+    vector_size_t i = 0;
+    rows.applyToSelected([&](auto row) {
+      flatResult->set(row, bits::isBitSet(contained.data(), i++));
+    });
+  }
+
+ private:
+  const bool constantBloomFilter_;
+  BloomFilter<> bloomFilter_;
+};
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> mightContainSignatures() {
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varbinary")
+              .argumentType("bigint")
+              .build()};
+}
+
+std::shared_ptr<exec::VectorFunction> makeMightContain(
+    const std::string& /*name*/,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_USER_CHECK_EQ(inputArgs.size(), 2);
+  return std::make_shared<BloomFilterMightContainFunction>(
+      inputArgs[0].constantValue.get());
+}
+
+} // namespace facebook::velox::functions::sparksql
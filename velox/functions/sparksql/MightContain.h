@@ -13,37 +13,21 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include "velox/common/base/BloomFilter.h"
-#include "velox/core/QueryConfig.h"
-#include "velox/functions/Macros.h"
 
-namespace facebook::velox::functions::sparksql {
-
-template <typename T>
-struct BloomFilterMightContainFunction {
-  VELOX_DEFINE_FUNCTION_TYPES(T);
+#pragma once
 
-  using Allocator = std::allocator<uint64_t>;
+#include "velox/expression/VectorFunction.h"
 
-  void initialize(
-      const std::vector<TypePtr>& /*inputTypes*/,
-      const core::QueryConfig&,
-      const arg_type<Varbinary>* serialized,
-      const arg_type<int64_t>*) {
-    if (serialized != nullptr) {
-      bloomFilter_.merge(serialized->str().c_str());
-    }
-  }
+namespace facebook::velox::functions::sparksql {
 
-  FOLLY_ALWAYS_INLINE void
-  call(bool& result, const arg_type<Varbinary>&, const int64_t& input) {
-    result = bloomFilter_.isSet()
-        ? bloomFilter_.mayContain(folly::hasher<int64_t>()(input))
-        : false;
-  }
+/// might_contain(bloomFilter, value) returns whether 'value' may be in the
+/// bloom filter produced by bloom_filter_agg. The values of a vector are
+/// hashed first and then probed together against a constant bloom filter.
+std::vector<std::shared_ptr<exec::FunctionSignature>> mightContainSignatures();
 
- private:
-  BloomFilter<Allocator> bloomFilter_;
-};
+std::shared_ptr<exec::VectorFunction> makeMightContain(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
 
 } // namespace facebook::velox::functions::sparksql
@@ -47,7 +47,7 @@ struct BloomFilterAccumulator {
 
   void init(int32_t capacity) {
     if (!bloomFilter.isSet()) {
-      bloomFilter.reset(capacity);
+      bloomFilter.reset(capacity, /*splitBlock=*/true);
     }
   }
 
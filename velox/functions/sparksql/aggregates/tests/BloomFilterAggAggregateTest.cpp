@@ -33,7 +33,7 @@ class BloomFilterAggAggregateTest
 
   VectorPtr getSerializedBloomFilter(int32_t capacity) {
     BloomFilter bloomFilter;
-    bloomFilter.reset(capacity);
+    bloomFilter.reset(capacity, /*splitBlock=*/true);
     for (auto i = 0; i < 9; ++i) {
       bloomFilter.insert(folly::hasher<int64_t>()(i));
     }
@@ -51,9 +51,11 @@ class MightContainTest : public SparkFunctionBaseTest {
     velox::test::assertEqualVectors(expected, results[0]);
   }
 
-  std::string getSerializedBloomFilter(int32_t kSize) {
+  std::string getSerializedBloomFilter(
+      int32_t kSize,
+      bool splitBlock = false) {
     BloomFilter bloomFilter;
-    bloomFilter.reset(kSize);
+    bloomFilter.reset(kSize, splitBlock);
     for (auto i = 0; i < kSize; ++i) {
       bloomFilter.insert(folly::hasher<int64_t>()(i));
     }
@@ -84,6 +86,20 @@ TEST_F(MightContainTest, basic) {
   testMightContain(serialized, values, expected);
 }
 
+TEST_F(MightContainTest, splitBlock) {
+  constexpr int32_t kSize = 1'000;
+  auto serialized = getSerializedBloomFilter(kSize, true);
+  auto value =
+      makeFlatVector<int64_t>(kSize, [](vector_size_t row) { return row; });
+  testMightContain(serialized, value, makeConstant(true, kSize));
+
+  auto values = makeNullableFlatVector<int64_t>(
+      {1, 2, std::nullopt, 123451, 999, 23456, std::nullopt});
+  auto expected = makeNullableFlatVector<bool>(
+      {true, true, std::nullopt, false, true, false, std::nullopt});
+  testMightContain(serialized, values, expected);
+}
+
 TEST_F(MightContainTest, nullBloomFilter) {
   auto value = makeFlatVector<int64_t>({2, 4});
   auto expected = makeNullConstant(TypeKind::BOOLEAN, value->size());
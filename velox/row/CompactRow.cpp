@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/row/CompactRow.h"
+#include "velox/common/base/RawVector.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::row {
@@ -420,6 +421,65 @@ int32_t CompactRow::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void CompactRow::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    vector_size_t* sizes) {
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + size, fixedSize);
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    for (auto row = 0; row < size; ++row) {
+      const auto childIndex = decoded_.index(offset + row);
+      if (!child.isNullAt(childIndex)) {
+        sizes[row] += child.variableWidthRowSize(childIndex);
+      }
+    }
+  }
+}
+
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  raw_vector<vector_size_t> childIndices(size);
+  for (auto row = 0; row < size; ++row) {
+    childIndices[row] = decoded_.index(offset + row);
+  }
+  const folly::Range<const vector_size_t*> indices(
+      childIndices.data(), childIndices.size());
+
+  // Offset of the next field in each row.
+  std::vector<int64_t> valuesOffsets(size, rowNullBytes_);
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    if (childIsFixedWidth_[i]) {
+      child.serializeFixedWidth(
+          indices, i, valuesOffsets.data(), bufferOffsets, buffer);
+      continue;
+    }
+    for (auto row = 0; row < size; ++row) {
+      auto* rowBuffer = buffer + bufferOffsets[row];
+      if (child.isNullAt(indices[row])) {
+        bits::setBit(reinterpret_cast<uint8_t*>(rowBuffer), i, true);
+        continue;
+      }
+      valuesOffsets[row] += child.serializeVariableWidth(
+          indices[row], rowBuffer + valuesOffsets[row]);
+    }
+  }
+}
+
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -453,6 +513,67 @@ void CompactRow::serializeFixedWidth(
   }
 }
 
+void CompactRow::serializeFixedWidth(
+    folly::Range<const vector_size_t*> indices,
+    int32_t field,
+    int64_t* valuesOffsets,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  // decoded_.data<char>() can be null if all values are null.
+  if (supportsBulkCopy_ && decoded_.data<char>()) {
+    switch (valueBytes_) {
+      case 1:
+        return copyFixedWidth<int8_t>(
+            indices, field, valuesOffsets, bufferOffsets, buffer);
+      case 2:
+        return copyFixedWidth<int16_t>(
+            indices, field, valuesOffsets, bufferOffsets, buffer);
+      case 4:
+        return copyFixedWidth<int32_t>(
+            indices, field, valuesOffsets, bufferOffsets, buffer);
+      case 8:
+        return copyFixedWidth<int64_t>(
+            indices, field, valuesOffsets, bufferOffsets, buffer);
+      case 16:
+        return copyFixedWidth<int128_t>(
+            indices, field, valuesOffsets, bufferOffsets, buffer);
+      default:
+        break;
+    }
+  }
+  for (auto row = 0; row < indices.size(); ++row) {
+    auto* rowBuffer = buffer + bufferOffsets[row];
+    if (isNullAt(indices[row])) {
+      bits::setBit(reinterpret_cast<uint8_t*>(rowBuffer), field, true);
+    } else if (valueBytes_ > 0) {
+      serializeFixedWidth(indices[row], rowBuffer + valuesOffsets[row]);
+    }
+    valuesOffsets[row] += valueBytes_;
+  }
+}
+
+template <typename T>
+void CompactRow::copyFixedWidth(
+    folly::Range<const vector_size_t*> indices,
+    int32_t field,
+    int64_t* valuesOffsets,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  // 'supportsBulkCopy_' implies that 'indices' are indices into the values.
+  const auto* values = decoded_.data<T>();
+  const bool mayHaveNulls = decoded_.mayHaveNulls();
+  for (auto row = 0; row < indices.size(); ++row) {
+    auto* rowBuffer = buffer + bufferOffsets[row];
+    if (mayHaveNulls && isNullAt(indices[row])) {
+      bits::setBit(reinterpret_cast<uint8_t*>(rowBuffer), field, true);
+    } else {
+      memcpy(rowBuffer + valuesOffsets[row], values + indices[row], sizeof(T));
+    }
+    valuesOffsets[row] += sizeof(T);
+  }
+}
+
 int32_t CompactRow::serializeVariableWidth(vector_size_t index, char* buffer) {
   switch (typeKind_) {
     case TypeKind::VARCHAR:
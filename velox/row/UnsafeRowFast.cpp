@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/row/UnsafeRowFast.h"
+#include "velox/common/base/RawVector.h"
 
 namespace facebook::velox::row {
 
@@ -155,6 +156,66 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void UnsafeRowFast::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    vector_size_t* sizes) {
+  const int32_t fixedSize = rowNullBytes_ + kFieldWidth * children_.size();
+  std::fill(sizes, sizes + size, fixedSize);
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    for (auto row = 0; row < size; ++row) {
+      const auto childIndex = decoded_.index(offset + row);
+      if (!child.isNullAt(childIndex)) {
+        sizes[row] += alignBytes(child.variableWidthRowSize(childIndex));
+      }
+    }
+  }
+}
+
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  raw_vector<vector_size_t> childIndices(size);
+  for (auto row = 0; row < size; ++row) {
+    childIndices[row] = decoded_.index(offset + row);
+  }
+  const folly::Range<const vector_size_t*> indices(
+      childIndices.data(), childIndices.size());
+
+  // Offset of the next variable-width value in each row.
+  std::vector<int64_t> variableWidthOffsets(
+      size, rowNullBytes_ + kFieldWidth * children_.size());
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    const int32_t fieldOffset = rowNullBytes_ + i * kFieldWidth;
+    if (childIsFixedWidth_[i]) {
+      child.serializeFixedWidth(indices, i, fieldOffset, bufferOffsets, buffer);
+      continue;
+    }
+    for (auto row = 0; row < size; ++row) {
+      auto* rowBuffer = buffer + bufferOffsets[row];
+      if (child.isNullAt(indices[row])) {
+        bits::setBit(rowBuffer, i, true);
+        continue;
+      }
+      auto& variableWidthOffset = variableWidthOffsets[row];
+      const auto valueSize = child.serializeVariableWidth(
+          indices[row], rowBuffer + variableWidthOffset);
+      // Write size and offset.
+      uint64_t sizeAndOffset = variableWidthOffset << 32 | valueSize;
+      *reinterpret_cast<uint64_t*>(rowBuffer + fieldOffset) = sizeAndOffset;
+      variableWidthOffset += alignBytes(valueSize);
+    }
+  }
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -187,6 +248,70 @@ void UnsafeRowFast::serializeFixedWidth(
   }
 }
 
+void UnsafeRowFast::serializeFixedWidth(
+    folly::Range<const vector_size_t*> indices,
+    int32_t field,
+    int32_t fieldOffset,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  // decoded_.data<char>() can be null if all values are null.
+  if (supportsBulkCopy_ && decoded_.data<char>()) {
+    switch (valueBytes_) {
+      case 1:
+        return copyFixedWidth<int8_t>(
+            indices, field, fieldOffset, bufferOffsets, buffer);
+      case 2:
+        return copyFixedWidth<int16_t>(
+            indices, field, fieldOffset, bufferOffsets, buffer);
+      case 4:
+        return copyFixedWidth<int32_t>(
+            indices, field, fieldOffset, bufferOffsets, buffer);
+      case 8:
+        return copyFixedWidth<int64_t>(
+            indices, field, fieldOffset, bufferOffsets, buffer);
+      default:
+        break;
+    }
+  }
+  for (auto row = 0; row < indices.size(); ++row) {
+    auto* rowBuffer = buffer + bufferOffsets[row];
+    if (isNullAt(indices[row])) {
+      bits::setBit(rowBuffer, field, true);
+    } else {
+      serializeFixedWidth(indices[row], rowBuffer + fieldOffset);
+    }
+  }
+}
+
+template <typename T>
+void UnsafeRowFast::copyFixedWidth(
+    folly::Range<const vector_size_t*> indices,
+    int32_t field,
+    int32_t fieldOffset,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  // 'supportsBulkCopy_' implies that 'indices' are indices into the values.
+  const auto* values = decoded_.data<T>();
+  if (!decoded_.mayHaveNulls()) {
+    for (auto row = 0; row < indices.size(); ++row) {
+      memcpy(
+          buffer + bufferOffsets[row] + fieldOffset,
+          values + indices[row],
+          sizeof(T));
+    }
+    return;
+  }
+  for (auto row = 0; row < indices.size(); ++row) {
+    auto* rowBuffer = buffer + bufferOffsets[row];
+    if (isNullAt(indices[row])) {
+      bits::setBit(rowBuffer, field, true);
+    } else {
+      memcpy(rowBuffer + fieldOffset, values + indices[row], sizeof(T));
+    }
+  }
+}
+
 int32_t UnsafeRowFast::serializeVariableWidth(
     vector_size_t index,
     char* buffer) {
@@ -36,6 +36,22 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Sets 'sizes[i]' to the serialized size of row 'offset + i' for 'size'
+  /// rows. Walks one column at a time, which is faster than rowSize() for
+  /// wide rows. Use only if 'fixedRowSize' returned std::nullopt.
+  void rowSizes(vector_size_t offset, vector_size_t size, vector_size_t* sizes);
+
+  /// Serializes 'size' rows starting at 'offset'. Row 'offset + i' is written
+  /// at 'buffer + bufferOffsets[i]', which must have sufficient capacity and
+  /// be set to all zeros. Writes each fixed-width column into all rows before
+  /// moving to the next column, so that the type of a column is dispatched
+  /// once per batch instead of once per row.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -57,6 +73,16 @@ class UnsafeRowFast {
   void
   serializeFixedWidth(vector_size_t offset, vector_size_t size, char* buffer);
 
+  /// Writes the fixed-width values at 'indices' into the field at
+  /// 'fieldOffset' of the rows at 'buffer + bufferOffsets[i]'. Sets the null
+  /// flag 'field' of the rows with null values.
+  void serializeFixedWidth(
+      folly::Range<const vector_size_t*> indices,
+      int32_t field,
+      int32_t fieldOffset,
+      const size_t* bufferOffsets,
+      char* buffer);
+
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index);
 
@@ -101,6 +127,16 @@ class UnsafeRowFast {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
+  /// Copies flat values of type T for serializeFixedWidth() over a range of
+  /// rows.
+  template <typename T>
+  void copyFixedWidth(
+      folly::Range<const vector_size_t*> indices,
+      int32_t field,
+      int32_t fieldOffset,
+      const size_t* bufferOffsets,
+      char* buffer);
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
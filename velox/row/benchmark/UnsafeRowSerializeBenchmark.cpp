@@ -40,6 +40,21 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeUnsafeBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    std::vector<vector_size_t> rowSizes(data->size());
+    if (auto fixedRowSize = UnsafeRowFast::fixedRowSize(rowType)) {
+      std::fill(rowSizes.begin(), rowSizes.end(), fixedRowSize.value());
+    } else {
+      fast.rowSizes(0, data->size(), rowSizes.data());
+    }
+    serializeBatch(fast, rowSizes);
+  }
+
   void deserializeUnsafe(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -65,6 +80,21 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeCompactBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    std::vector<vector_size_t> rowSizes(data->size());
+    if (auto fixedRowSize = CompactRow::fixedRowSize(rowType)) {
+      std::fill(rowSizes.begin(), rowSizes.end(), fixedRowSize.value());
+    } else {
+      compact.rowSizes(0, data->size(), rowSizes.data());
+    }
+    serializeBatch(compact, rowSizes);
+  }
+
   void deserializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -184,6 +214,21 @@ class SerializeBenchmark {
     return serialized;
   }
 
+  // Serializes all rows of 'row' with one call. 'rowSizes' are the sizes of
+  // the rows.
+  template <typename Row>
+  void serializeBatch(Row& row, const std::vector<vector_size_t>& rowSizes) {
+    std::vector<size_t> bufferOffsets(rowSizes.size());
+    size_t totalSize = 0;
+    for (auto i = 0; i < rowSizes.size(); ++i) {
+      bufferOffsets[i] = totalSize;
+      totalSize += rowSizes[i];
+    }
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    row.serialize(
+        0, rowSizes.size(), bufferOffsets.data(), buffer->asMutable<char>());
+  }
+
   HashStringAllocator::Position serialize(
       const RowVectorPtr& data,
       HashStringAllocator& allocator) {
@@ -205,35 +250,45 @@ class SerializeBenchmark {
       memory::memoryManager()->addLeafPool()};
 };
 
-#define SERDE_BENCHMARKS(name, rowType)      \
-  BENCHMARK(unsafe_serialize_##name) {       \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeUnsafe(rowType);      \
-  }                                          \
-                                             \
-  BENCHMARK(compact_serialize_##name) {      \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeCompact(rowType);     \
-  }                                          \
-                                             \
-  BENCHMARK(container_serialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeContainer(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(unsafe_deserialize_##name) {     \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeUnsafe(rowType);    \
-  }                                          \
-                                             \
-  BENCHMARK(compact_deserialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeCompact(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(container_deserialize_##name) {  \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeContainer(rowType); \
+#define SERDE_BENCHMARKS(name, rowType)       \
+  BENCHMARK(unsafe_serialize_##name) {        \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeUnsafe(rowType);       \
+  }                                           \
+                                              \
+  BENCHMARK(unsafe_serialize_batch_##name) {  \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeUnsafeBatch(rowType);  \
+  }                                           \
+                                              \
+  BENCHMARK(compact_serialize_##name) {       \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeCompact(rowType);      \
+  }                                           \
+                                              \
+  BENCHMARK(compact_serialize_batch_##name) { \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeCompactBatch(rowType); \
+  }                                           \
+                                              \
+  BENCHMARK(container_serialize_##name) {     \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeContainer(rowType);    \
+  }                                           \
+                                              \
+  BENCHMARK(unsafe_deserialize_##name) {      \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeUnsafe(rowType);     \
+  }                                           \
+                                              \
+  BENCHMARK(compact_deserialize_##name) {     \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeCompact(rowType);    \
+  }                                           \
+                                              \
+  BENCHMARK(container_deserialize_##name) {   \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeContainer(rowType);  \
   }
 
 SERDE_BENCHMARKS(
@@ -286,6 +341,18 @@ SERDE_BENCHMARKS(
         VARCHAR(),
     }));
 
+// Wide rows as in Spark shuffles: 200 columns, one in 4 a string.
+RowTypePtr makeWideRowType() {
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < 200; ++i) {
+    types.push_back(
+        i % 4 == 3 ? VARCHAR() : (i % 4 == 2 ? DOUBLE() : BIGINT()));
+  }
+  return ROW(std::move(types));
+}
+
+SERDE_BENCHMARKS(wide200, makeWideRowType());
+
 SERDE_BENCHMARKS(arrays, ROW({BIGINT(), ARRAY(BIGINT())}));
 
 SERDE_BENCHMARKS(nestedArrays, ROW({BIGINT(), ARRAY(ARRAY(BIGINT()))}));
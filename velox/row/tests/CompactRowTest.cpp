@@ -78,6 +78,36 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
+
+    testBatch(row, rowType, numRows, rawBuffer, serialized);
+  }
+
+  // Verifies that serializing all rows in one call produces the same bytes
+  // as serializing one row at a time.
+  void testBatch(
+      CompactRow& row,
+      const RowTypePtr& rowType,
+      vector_size_t numRows,
+      const char* expected,
+      const std::vector<std::string_view>& expectedRows) {
+    std::vector<vector_size_t> rowSizes(numRows);
+    if (auto fixedRowSize = CompactRow::fixedRowSize(rowType)) {
+      std::fill(rowSizes.begin(), rowSizes.end(), fixedRowSize.value());
+    } else {
+      row.rowSizes(0, numRows, rowSizes.data());
+    }
+
+    std::vector<size_t> bufferOffsets(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(rowSizes[i], expectedRows[i].size());
+      bufferOffsets[i] = totalSize;
+      totalSize += rowSizes[i];
+    }
+
+    BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    row.serialize(0, numRows, bufferOffsets.data(), buffer->asMutable<char>());
+    ASSERT_EQ(0, std::memcmp(buffer->as<char>(), expected, totalSize));
   }
 };
 
@@ -177,6 +177,27 @@ TEST_F(UnsafeRowFuzzTests, fast) {
     }
     return serialized;
   });
+
+  // Serializes all rows in one call.
+  doTest(rowType, [&](const RowVectorPtr& data) {
+    UnsafeRowFast fast(data);
+    std::vector<vector_size_t> rowSizes(data->size());
+    fast.rowSizes(0, data->size(), rowSizes.data());
+    std::vector<size_t> bufferOffsets(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      VELOX_CHECK_LE(rowSizes[i], kBufferSize);
+      EXPECT_EQ(rowSizes[i], fast.rowSize(i)) << i << ", " << data->toString(i);
+      bufferOffsets[i] = i * kBufferSize;
+    }
+    fast.serialize(0, data->size(), bufferOffsets.data(), buffers_[0]);
+
+    std::vector<std::optional<std::string_view>> serialized;
+    serialized.reserve(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      serialized.push_back(std::string_view(buffers_[i], rowSizes[i]));
+    }
+    return serialized;
+  });
 }
 
 } // namespace
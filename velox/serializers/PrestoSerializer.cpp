@@ -17,11 +17,13 @@
 
 #include <optional>
 
+#include <folly/Random.h>
 #include <folly/lang/Bits.h>
 
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/RawVector.h"
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/Timer.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DictionaryVector.h"
@@ -36,6 +38,11 @@ namespace {
 constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
+// Bits 3-5 of the codec marker hold the CompressionKind of a page compressed
+// with adaptive compression. Zero means the codec is given by the options of
+// the deserializer, as in Presto.
+constexpr int8_t kCodecKindShift = 3;
+constexpr int8_t kCodecKindMask = 7 << kCodecKindShift;
 // uncompressed size comes after the number of rows and the codec
 constexpr int32_t kSizeInBytesOffset{4 + 1};
 // There header for a page is:
@@ -134,6 +141,11 @@ bool isChecksumBitSet(int8_t codec) {
   return (codec & kCheckSumBitMask) == kCheckSumBitMask;
 }
 
+common::CompressionKind recordedCompressionKind(int8_t codec) {
+  return static_cast<common::CompressionKind>(
+      (codec & kCodecKindMask) >> kCodecKindShift);
+}
+
 std::string_view typeToEncodingName(const TypePtr& type) {
   switch (type->kind()) {
     case TypeKind::BOOLEAN:
@@ -524,6 +536,62 @@ vector_size_t readNulls(
       nulls, resultOffset, resultOffset + numNewValues);
 }
 
+// Keeps the input of a zero-copy deserialization alive for as long as a
+// view on it is referenced.
+class ZeroCopyReleaser {
+ public:
+  explicit ZeroCopyReleaser(std::shared_ptr<const void> input)
+      : input_(std::move(input)) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  const std::shared_ptr<const void> input_;
+};
+
+// Sets 'result' to a flat vector of 'size' values that are a view on the
+// input if the values have no nulls and are contiguous and aligned in
+// 'source'. Returns false and leaves 'source' unchanged otherwise.
+template <typename T>
+bool tryReadZeroCopy(
+    ByteInputStream* source,
+    const TypePtr& type,
+    int32_t size,
+    velox::memory::MemoryPool* pool,
+    const SerdeOpts& opts,
+    VectorPtr& result) {
+  if constexpr (
+      std::is_same_v<T, bool> || std::is_same_v<T, Timestamp> ||
+      std::is_same_v<T, int128_t> || std::is_same_v<T, UnknownValue>) {
+    return false;
+  } else {
+    if (size == 0) {
+      return false;
+    }
+    const auto position = source->tellp();
+    if (source->readByte() != 0) {
+      source->seekp(position);
+      return false;
+    }
+    const auto numBytes = size * sizeof(T);
+    const auto view = source->nextView(numBytes);
+    if (view.size() != numBytes ||
+        reinterpret_cast<uintptr_t>(view.data()) % alignof(T) != 0) {
+      source->seekp(position);
+      return false;
+    }
+    auto values = BufferView<ZeroCopyReleaser>::create(
+        reinterpret_cast<const uint8_t*>(view.data()),
+        numBytes,
+        ZeroCopyReleaser(opts.zeroCopyInput));
+    result = std::make_shared<FlatVector<T>>(
+        pool, type, nullptr, size, std::move(values), std::vector<BufferPtr>{});
+    return true;
+  }
+}
+
 template <typename T>
 void read(
     ByteInputStream* source,
@@ -535,6 +603,11 @@ void read(
     const SerdeOpts& opts,
     VectorPtr& result) {
   const int32_t size = source->read<int32_t>();
+  if (opts.zeroCopyInput != nullptr && resultOffset == 0 &&
+      incomingNulls == nullptr && !type->isLongDecimal() &&
+      tryReadZeroCopy<T>(source, type, size, pool, opts, result)) {
+    return;
+  }
   const auto numNewValues = sizeWithIncomingNulls(size, numIncomingNulls);
   result->resize(resultOffset + numNewValues);
 
@@ -715,9 +788,16 @@ void readDictionaryVector(
         indices->asMutable<char>(), numNewValues * sizeof(int32_t));
   }
 
-  // Skip 3 * 8 bytes of 'instance id'. Velox doesn't use 'instance id' for
-  // dictionary vectors.
-  source->skip(24);
+  // Read 3 * 8 bytes of 'instance id'. Dictionaries with the same non-zero id
+  // share the base vector if the caller provided a cache.
+  PrestoDictionaryCache::DictionaryId id;
+  std::get<0>(id) = source->read<int64_t>();
+  std::get<1>(id) = source->read<int64_t>();
+  std::get<2>(id) = source->read<int64_t>();
+  if (opts.dictionaryCache != nullptr &&
+      id != PrestoDictionaryCache::DictionaryId{}) {
+    children[0] = opts.dictionaryCache->share(id, children[0]);
+  }
 
   BufferPtr incomingNullsBuffer = nullptr;
   if (incomingNulls) {
@@ -1594,6 +1674,11 @@ class VectorStream {
     return isConstantStream_;
   }
 
+  void setDictionaryId(const PrestoDictionaryCache::DictionaryId& id) {
+    VELOX_CHECK(isDictionaryStream_);
+    dictionaryId_ = id;
+  }
+
   VectorStream* childAt(int32_t index) {
     return children_[index].get();
   }
@@ -1630,10 +1715,9 @@ class VectorStream {
           values_.flush(out);
 
           // Write 24 bytes of 'instance id'.
-          int64_t unused{0};
-          writeInt64(out, unused);
-          writeInt64(out, unused);
-          writeInt64(out, unused);
+          writeInt64(out, std::get<0>(dictionaryId_));
+          writeInt64(out, std::get<1>(dictionaryId_));
+          writeInt64(out, std::get<2>(dictionaryId_));
           return;
         }
         default:
@@ -1711,6 +1795,7 @@ class VectorStream {
 
   void clear() {
     encoding_ = std::nullopt;
+    dictionaryId_ = {};
     initializeHeader(typeToEncodingName(type_), *streamArena_);
     nonNullCount_ = 0;
     nullCount_ = 0;
@@ -1797,6 +1882,8 @@ class VectorStream {
   std::vector<std::unique_ptr<VectorStream>> children_;
   bool isDictionaryStream_{false};
   bool isConstantStream_{false};
+  // Written as the 'instance id' of a dictionary stream.
+  PrestoDictionaryCache::DictionaryId dictionaryId_{};
 };
 
 template <>
@@ -3580,9 +3667,10 @@ FlushSizes flushCompressed(
     folly::io::Codec& codec,
     int32_t numRows,
     float minCompressionRatio,
+    common::CompressionKind recordedKind,
     OutputStream* output,
     PrestoOutputStreamListener* listener) {
-  char codecMask = kCompressedBitMask;
+  char codecMask = kCompressedBitMask | (recordedKind << kCodecKindShift);
   if (listener) {
     codecMask |= kCheckSumBitMask;
   }
@@ -3614,7 +3702,7 @@ FlushSizes flushCompressed(
         numRows,
         uncompressedSize,
         uncompressedSize,
-        codecMask & ~kCompressedBitMask,
+        codecMask & ~(kCompressedBitMask | kCodecKindMask),
         iobuf,
         output,
         listener);
@@ -3637,7 +3725,8 @@ FlushSizes flushStreams(
     const StreamArena& arena,
     folly::io::Codec& codec,
     float minCompressionRatio,
-    OutputStream* out) {
+    OutputStream* out,
+    common::CompressionKind recordedKind = common::CompressionKind_NONE) {
   auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
   // Reset CRC computation
   if (listener) {
@@ -3649,7 +3738,14 @@ FlushSizes flushStreams(
     return {size, size};
   } else {
     return flushCompressed(
-        streams, arena, codec, numRows, minCompressionRatio, out, listener);
+        streams,
+        arena,
+        codec,
+        numRows,
+        minCompressionRatio,
+        recordedKind,
+        out,
+        listener);
   }
 }
 
@@ -3738,12 +3834,38 @@ void estimateDictionarySerializedSize(
       scratch);
 }
 
+// Serializes the rows of dictionary 'vector' in 'ranges' with all values of
+// its base vector, so that the serialized dictionary is the same for all
+// batches over the base vector.
+void serializeWholeDictionary(
+    const VectorPtr& vector,
+    const folly::Range<const IndexRange*>& ranges,
+    VectorStream* stream,
+    Scratch& scratch) {
+  VELOX_CHECK(stream->isDictionaryStream());
+  const auto& base = vector->valueVector();
+  const IndexRange allValues{0, base->size()};
+  serializeColumn(
+      base, folly::Range(&allValues, 1), stream->childAt(0), scratch);
+
+  stream->appendNonNull(rangesTotalSize(ranges));
+  auto* indices = vector->wrapInfo()->as<vector_size_t>();
+  for (const auto& range : ranges) {
+    for (auto i = 0; i < range.size; ++i) {
+      stream->appendOne(indices[range.begin + i]);
+    }
+  }
+}
+
 class PrestoBatchVectorSerializer : public BatchVectorSerializer {
  public:
   PrestoBatchVectorSerializer(memory::MemoryPool* pool, const SerdeOpts& opts)
       : pool_(pool),
         codec_(common::compressionKindToCodec(opts.compressionKind)),
-        opts_(opts) {}
+        opts_(opts),
+        instanceId_{
+            static_cast<int64_t>(folly::Random::rand64()),
+            static_cast<int64_t>(folly::Random::rand64())} {}
 
   void serialize(
       const RowVectorPtr& vector,
@@ -3765,7 +3887,16 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
           numRows,
           opts_);
 
-      if (numRows > 0) {
+      if (numRows == 0) {
+        continue;
+      }
+      const auto dictionaryId =
+          sharedDictionaryId(i, vector->childAt(i), *streams[i], numRows);
+      if (dictionaryId.has_value()) {
+        serializeWholeDictionary(
+            vector->childAt(i), ranges, streams[i].get(), scratch);
+        streams[i]->setDictionaryId(dictionaryId.value());
+      } else {
         serializeColumn(vector->childAt(i), ranges, streams[i].get(), scratch);
       }
     }
@@ -3912,9 +4043,46 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
     }
   }
 
+  // Returns the dictionary id to serialize column 'column' with if it is a
+  // dictionary to share between batches. The id changes when the base vector
+  // changes. Keeps the last base vector of each column alive, so that an
+  // equal address means the same values.
+  std::optional<PrestoDictionaryCache::DictionaryId> sharedDictionaryId(
+      column_index_t column,
+      const VectorPtr& vector,
+      const VectorStream& stream,
+      vector_size_t numRows) {
+    if (!opts_.shareDictionaries || !stream.isDictionaryStream() ||
+        vector->encoding() != VectorEncoding::Simple::DICTIONARY ||
+        vector->rawNulls() != nullptr ||
+        vector->valueVector()->size() > numRows) {
+      return std::nullopt;
+    }
+    if (column >= sharedDictionaries_.size()) {
+      sharedDictionaries_.resize(column + 1);
+    }
+    auto& shared = sharedDictionaries_[column];
+    if (shared.base != vector->valueVector()) {
+      shared.base = vector->valueVector();
+      shared.sequenceId = ++lastSequenceId_;
+    }
+    return PrestoDictionaryCache::DictionaryId{
+        instanceId_.first, instanceId_.second, shared.sequenceId};
+  }
+
+  struct SharedDictionary {
+    VectorPtr base;
+    int64_t sequenceId{0};
+  };
+
   memory::MemoryPool* pool_;
   const std::unique_ptr<folly::io::Codec> codec_;
   SerdeOpts opts_;
+
+  // Random id of 'this' written in the dictionary ids.
+  const std::pair<int64_t, int64_t> instanceId_;
+  int64_t lastSequenceId_{0};
+  std::vector<SharedDictionary> sharedDictionaries_;
 };
 
 class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
@@ -3934,6 +4102,16 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     for (int i = 0; i < numTypes; ++i) {
       streams_[i] = std::make_unique<VectorStream>(
           types[i], std::nullopt, std::nullopt, streamArena, numRows, opts);
+      if (types[i]->kind() == TypeKind::VARCHAR ||
+          types[i]->kind() == TypeKind::VARBINARY) {
+        stringColumns_.push_back(i);
+      }
+    }
+    if (opts_.adaptiveCompression) {
+      lz4Codec_ =
+          common::compressionKindToCodec(common::CompressionKind_LZ4);
+      zstdCodec_ =
+          common::compressionKindToCodec(common::CompressionKind_ZSTD);
     }
   }
 
@@ -3971,6 +4149,12 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       dataSize += stream->serializedSize();
     }
 
+    if (opts_.adaptiveCompression) {
+      return kHeaderSize +
+          std::max(
+                 lz4Codec_->maxCompressedLength(dataSize),
+                 zstdCodec_->maxCompressedLength(dataSize));
+    }
     auto compressedSize = needCompression(*codec_)
         ? codec_->maxCompressedLength(dataSize)
         : dataSize;
@@ -3981,7 +4165,10 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   // numRows(4) | codec(1) | uncompressedSize(4) | compressedSize(4) |
   // checksum(8) | data
   void flush(OutputStream* out) override {
-    constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
+    if (opts_.adaptiveCompression) {
+      flushAdaptive(out);
+      return;
+    }
     if (!needCompression(*codec_)) {
       flushStreams(
           streams_,
@@ -4017,6 +4204,61 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     }
   }
 
+  // Compresses pages where string columns hold most of the bytes with ZSTD
+  // and other pages with LZ4. ZSTD is replaced by LZ4 when its observed CPU
+  // cost exceeds opts_.maxCompressionNanosPerByte. Pages of a kind that did
+  // not compress to opts_.minCompressionRatio are sent uncompressed for a
+  // while, which covers payloads that are already encoded. The codec is
+  // recorded in the page header.
+  void flushAdaptive(OutputStream* out) {
+    const bool stringPage = isStringPage();
+    auto& state = adaptiveStates_[stringPage ? 1 : 0];
+    if (state.numCompressionToSkip > 0) {
+      const auto noCompressionCodec = common::compressionKindToCodec(
+          common::CompressionKind::CompressionKind_NONE);
+      auto [size, ignore] = flushStreams(
+          streams_, numRows_, *streamArena_, *noCompressionCodec, 1, out);
+      stats_.compressionSkippedBytes += size;
+      --state.numCompressionToSkip;
+      ++state.numCompressionSkipped;
+      ++stats_.numCompressionSkipped;
+      return;
+    }
+
+    bool zstd = stringPage;
+    if (zstd && zstdOverBudget(state)) {
+      zstd = false;
+      ++stats_.numZstdOverBudget;
+    }
+    uint64_t micros{0};
+    FlushSizes sizes;
+    {
+      MicrosecondTimer timer(&micros);
+      sizes = flushStreams(
+          streams_,
+          numRows_,
+          *streamArena_,
+          zstd ? *zstdCodec_ : *lz4Codec_,
+          opts_.minCompressionRatio,
+          out,
+          zstd ? common::CompressionKind_ZSTD : common::CompressionKind_LZ4);
+    }
+    const auto [size, compressedSize] = sizes;
+    stats_.compressionInputBytes += size;
+    stats_.compressedBytes += compressedSize;
+    if (zstd) {
+      state.zstdInputBytes += size;
+      state.zstdMicros += micros;
+      stats_.zstdInputBytes += size;
+    } else {
+      stats_.lz4InputBytes += size;
+    }
+    if (compressedSize > size * opts_.minCompressionRatio) {
+      state.numCompressionToSkip = std::min<int64_t>(
+          kMaxCompressionAttemptsToSkip, 1 + state.numCompressionSkipped);
+    }
+  }
+
   std::unordered_map<std::string, RuntimeCounter> runtimeStats() override {
     std::unordered_map<std::string, RuntimeCounter> map;
     map.insert(
@@ -4028,6 +4270,16 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
          {"compressionSkippedBytes",
           RuntimeCounter(
               stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)}});
+    if (opts_.adaptiveCompression) {
+      map.insert(
+          {{"compressionLz4InputBytes",
+            RuntimeCounter(stats_.lz4InputBytes, RuntimeCounter::Unit::kBytes)},
+           {"compressionZstdInputBytes",
+            RuntimeCounter(
+                stats_.zstdInputBytes, RuntimeCounter::Unit::kBytes)},
+           {"compressionZstdOverBudget",
+            RuntimeCounter(stats_.numZstdOverBudget)}});
+    }
     return map;
   }
 
@@ -4052,8 +4304,50 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     // Bytes for which compression was not attempted because of past
     // non-performance.
     int64_t compressionSkippedBytes{0};
+
+    // Uncompressed bytes of the pages compressed with LZ4 and ZSTD by
+    // adaptive compression.
+    int64_t lz4InputBytes{0};
+    int64_t zstdInputBytes{0};
+
+    // Number of string pages compressed with LZ4 because ZSTD was over the
+    // CPU budget.
+    int64_t numZstdOverBudget{0};
+  };
+
+  // Adaptive compression state of one kind of page.
+  struct AdaptiveState {
+    // Count of forthcoming compressions to skip.
+    int32_t numCompressionToSkip{0};
+
+    // Number of times compression was not attempted.
+    int32_t numCompressionSkipped{0};
+
+    // Uncompressed bytes compressed with ZSTD and the time it took.
+    int64_t zstdInputBytes{0};
+    uint64_t zstdMicros{0};
   };
 
+  static constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
+
+  bool isStringPage() const {
+    int64_t stringBytes = 0;
+    for (auto column : stringColumns_) {
+      stringBytes += streams_[column]->serializedSize();
+    }
+    int64_t totalBytes = 0;
+    for (auto& stream : streams_) {
+      totalBytes += stream->serializedSize();
+    }
+    return stringBytes * 2 > totalBytes;
+  }
+
+  bool zstdOverBudget(const AdaptiveState& state) const {
+    return opts_.maxCompressionNanosPerByte > 0 && state.zstdInputBytes > 0 &&
+        state.zstdMicros * 1'000.0 >
+        opts_.maxCompressionNanosPerByte * state.zstdInputBytes;
+  }
+
   const SerdeOpts opts_;
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
@@ -4064,6 +4358,15 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   // Count of forthcoming compressions to skip.
   int32_t numCompressionToSkip_{0};
   CompressionStats stats_;
+
+  // Indices of the VARCHAR and VARBINARY columns.
+  std::vector<int32_t> stringColumns_;
+
+  // Codecs and state of adaptive compression for pages of mostly numeric and
+  // mostly string columns.
+  std::unique_ptr<folly::io::Codec> lz4Codec_;
+  std::unique_ptr<folly::io::Codec> zstdCodec_;
+  std::array<AdaptiveState, 2> adaptiveStates_;
 };
 } // namespace
 
@@ -4094,6 +4397,22 @@ PrestoVectorSerde::createIterativeSerializer(
       type, numRows, streamArena, prestoOptions);
 }
 
+VectorPtr PrestoDictionaryCache::share(
+    const DictionaryId& id,
+    const VectorPtr& values) {
+  auto it = dictionaries_.find(id);
+  if (it != dictionaries_.end() && *it->second->type() == *values->type() &&
+      it->second->size() == values->size()) {
+    ++numHits_;
+    return it->second;
+  }
+  if (it == dictionaries_.end() && dictionaries_.size() >= kMaxEntries) {
+    dictionaries_.clear();
+  }
+  dictionaries_[id] = values;
+  return values;
+}
+
 std::unique_ptr<BatchVectorSerializer> PrestoVectorSerde::createBatchSerializer(
     memory::MemoryPool* pool,
     const Options* options) {
@@ -4178,9 +4497,12 @@ void PrestoVectorSerde::deserialize(
     vector_size_t resultOffset,
     const Options* options) {
   const auto prestoOptions = toPrestoOptions(options);
-  const auto codec =
-      common::compressionKindToCodec(prestoOptions.compressionKind);
   auto const header = PrestoHeader::read(source);
+  const auto recordedKind = recordedCompressionKind(header.pageCodecMarker);
+  const auto codec = common::compressionKindToCodec(
+      recordedKind != common::CompressionKind_NONE
+          ? recordedKind
+          : prestoOptions.compressionKind);
 
   int64_t actualCheckSum = 0;
   if (isChecksumBitSet(header.pageCodecMarker)) {
@@ -4220,12 +4542,25 @@ void PrestoVectorSerde::deserialize(
     auto compressBuf = folly::IOBuf::create(header.compressedSize);
     source->readBytes(compressBuf->writableData(), header.compressedSize);
     compressBuf->append(header.compressedSize);
-    auto uncompress =
+    std::shared_ptr<folly::IOBuf> uncompress =
         codec->uncompress(compressBuf.get(), header.uncompressedSize);
     ByteRange byteRange{
         uncompress->writableData(), (int32_t)uncompress->length(), 0};
     ByteInputStream uncompressedSource({byteRange});
 
+    if (prestoOptions.zeroCopyInput != nullptr) {
+      // Views are on the uncompressed copy, not on the input.
+      auto uncompressedOptions = prestoOptions;
+      uncompressedOptions.zeroCopyInput = uncompress;
+      readTopColumns(
+          uncompressedSource,
+          type,
+          pool,
+          *result,
+          resultOffset,
+          uncompressedOptions);
+      return;
+    }
     readTopColumns(
         uncompressedSource, type, pool, *result, resultOffset, prestoOptions);
   }
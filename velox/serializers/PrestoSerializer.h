@@ -15,7 +15,9 @@
  */
 #pragma once
 
+#include <map>
 #include <string_view>
+#include <tuple>
 
 #include "velox/common/base/Crc.h"
 #include "velox/common/compression/Compression.h"
@@ -23,6 +25,38 @@
 
 namespace facebook::velox::serializer::presto {
 
+/// Base vectors of the DICTIONARY columns deserialized from a stream of
+/// pages, keyed by their dictionary id. Pages serialized with
+/// PrestoOptions::shareDictionaries repeat the id of a dictionary whose base
+/// vector is shared between batches, and the deserializer returns
+/// dictionaries over the cached base vector for them. Not thread safe.
+class PrestoDictionaryCache {
+ public:
+  /// The 'instance id' of a dictionary in the PrestoPage format: two halves
+  /// of a serializer-unique id and a sequence number. All zeros for
+  /// dictionaries without an id.
+  using DictionaryId = std::tuple<int64_t, int64_t, int64_t>;
+
+  /// The cache is cleared when it has this many entries.
+  static constexpr size_t kMaxEntries = 64;
+
+  /// Returns the cached base vector for 'id' if it has the type and size of
+  /// 'values'. Otherwise caches and returns 'values'.
+  VectorPtr share(const DictionaryId& id, const VectorPtr& values);
+
+  size_t size() const {
+    return dictionaries_.size();
+  }
+
+  uint64_t numHits() const {
+    return numHits_;
+  }
+
+ private:
+  std::map<DictionaryId, VectorPtr> dictionaries_;
+  uint64_t numHits_{0};
+};
+
 /// There are two ways to serialize data using PrestoVectorSerde:
 ///
 /// 1. In order to append multiple RowVectors into the same serialized payload,
@@ -72,6 +106,37 @@ class PrestoVectorSerde : public VectorSerde {
     /// than this causes subsequent compression attempts to be skipped. The more
     /// times compression misses the target the less frequently it is tried.
     float minCompressionRatio{0.8};
+
+    /// Makes an IterativeVectorSerializer pick the codec of each page instead
+    /// of using 'compressionKind': ZSTD for pages made mostly of string
+    /// columns, LZ4 for other pages and no compression for pages that missed
+    /// 'minCompressionRatio'. The codec is recorded in the page header, which
+    /// only Velox deserializers read. Presto cannot read these pages.
+    bool adaptiveCompression{false};
+
+    /// CPU budget of adaptive compression. String pages are compressed with
+    /// LZ4 once ZSTD took more than this many nanoseconds per input byte. 0
+    /// means no limit.
+    float maxCompressionNanosPerByte{0};
+
+    /// Makes a BatchVectorSerializer write top level dictionaries without
+    /// nulls whose base vector is no larger than the batch with all their
+    /// base values, tagged with an id that is the same for all batches over
+    /// the same base vector. A deserializer with a 'dictionaryCache' then
+    /// shares one base vector between the pages, so the encoding survives
+    /// the exchange and consumers can reuse work done on the base values.
+    bool shareDictionaries{false};
+
+    /// Base vectors of dictionaries deserialized from earlier pages of the
+    /// same stream. Dictionary ids are ignored if not set.
+    std::shared_ptr<PrestoDictionaryCache> dictionaryCache;
+
+    /// Owner of the memory being deserialized. If set, the values of
+    /// fixed-width flat columns without nulls are returned as views on the
+    /// input instead of being copied, and the views keep 'zeroCopyInput'
+    /// alive. Columns whose values are not contiguous and aligned in the
+    /// input are copied as usual.
+    std::shared_ptr<const void> zeroCopyInput;
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
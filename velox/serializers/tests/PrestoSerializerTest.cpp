@@ -844,6 +844,80 @@ TEST_P(PrestoSerializerTest, serializeNoRowsSelected) {
   assertEqualVectors(deserialized, expected);
 }
 
+TEST_P(PrestoSerializerTest, adaptiveCompression) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto numbers = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row % 10; }),
+       makeFlatVector<std::string>(10'000, [](auto) { return "a"; })});
+  auto strings = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+       makeFlatVector<std::string>(1'000, [](auto row) {
+         return fmt::format("a long and repetitive string {}", row % 10);
+       })});
+  folly::Random::DefaultGenerator rng(1);
+  auto random = makeRowVector(
+      {makeFlatVector<int64_t>(
+           1'000, [&](auto) { return folly::Random::rand64(rng); }),
+       makeFlatVector<std::string>(1'000, [&](auto) {
+         std::string value(16, '\0');
+         for (auto& c : value) {
+           c = folly::Random::rand32(256, rng);
+         }
+         return value;
+       })});
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.adaptiveCompression = true;
+  auto arena = std::make_unique<StreamArena>(pool_.get());
+  auto serializer =
+      serde_->createIterativeSerializer(rowType, 10'000, arena.get(), &options);
+
+  // Serializes 'data' and returns the codec recorded in the page.
+  auto serialize = [&](const RowVectorPtr& data) {
+    std::ostringstream out;
+    serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream output(&out, &listener);
+    const IndexRange allRows{0, data->size()};
+    serializer->append(data, folly::Range(&allRows, 1));
+    serializer->flush(&output);
+    serializer->clear();
+
+    // The deserializer does not need to know the codec.
+    const auto serialized = out.str();
+    auto byteStream = toByteStream(serialized);
+    RowVectorPtr deserialized;
+    serde_->deserialize(
+        &byteStream, pool_.get(), rowType, &deserialized, 0, nullptr);
+    assertEqualVectors(data, deserialized);
+    const auto marker = serialized[4];
+    return static_cast<common::CompressionKind>((marker >> 3) & 7);
+  };
+
+  ASSERT_EQ(serialize(numbers), common::CompressionKind_LZ4);
+  ASSERT_EQ(serialize(strings), common::CompressionKind_ZSTD);
+  // Random strings do not compress and the next string page is not
+  // compressed. Numeric pages are still compressed.
+  ASSERT_EQ(serialize(random), common::CompressionKind_NONE);
+  ASSERT_EQ(serialize(strings), common::CompressionKind_NONE);
+  ASSERT_EQ(serialize(numbers), common::CompressionKind_LZ4);
+  ASSERT_EQ(serialize(strings), common::CompressionKind_ZSTD);
+
+  auto stats = serializer->runtimeStats();
+  ASSERT_LT(0, stats.at("compressionLz4InputBytes").value);
+  ASSERT_LT(0, stats.at("compressionZstdInputBytes").value);
+  ASSERT_LT(0, stats.at("compressionSkippedBytes").value);
+  ASSERT_EQ(0, stats.at("compressionZstdOverBudget").value);
+
+  // ZSTD is over any budget after the first page.
+  options.maxCompressionNanosPerByte = 1e-9;
+  serializer =
+      serde_->createIterativeSerializer(rowType, 10'000, arena.get(), &options);
+  ASSERT_EQ(serialize(strings), common::CompressionKind_ZSTD);
+  ASSERT_EQ(serialize(strings), common::CompressionKind_LZ4);
+  stats = serializer->runtimeStats();
+  ASSERT_EQ(1, stats.at("compressionZstdOverBudget").value);
+}
+
 TEST_P(PrestoSerializerTest, emptyArray) {
   auto arrayVector = makeArrayVector<int32_t>(
       1'000,
@@ -1137,6 +1211,116 @@ TEST_P(PrestoSerializerTest, dictionaryEncodingTurnedOff) {
   ASSERT_EQ(deserialized->childAt(9)->encoding(), VectorEncoding::Simple::FLAT);
 }
 
+TEST_P(PrestoSerializerTest, sharedDictionaries) {
+  auto base = makeFlatVector<std::string>(
+      8, [](auto row) { return fmt::format("shared value {}", row); });
+  auto otherBase = makeFlatVector<std::string>(
+      8, [](auto row) { return fmt::format("other value {}", row); });
+
+  auto serializeOptions = getParamSerdeOptions(nullptr);
+  serializeOptions.shareDictionaries = true;
+  auto batchSerializer =
+      serde_->createBatchSerializer(pool_.get(), &serializeOptions);
+
+  auto dictionaryCache =
+      std::make_shared<serializer::presto::PrestoDictionaryCache>();
+  auto deserializeOptions = getParamSerdeOptions(nullptr);
+  deserializeOptions.dictionaryCache = dictionaryCache;
+
+  // The first two batches share their base vector.
+  std::vector<VectorPtr> deserializedBases;
+  for (auto i = 0; i < 3; ++i) {
+    auto indices = makeIndices(32, [i](auto row) { return (row + i) % 4; });
+    auto data = makeRowVector({BaseVector::wrapInDictionary(
+        nullptr, indices, 32, i < 2 ? base : otherBase)});
+
+    std::ostringstream output;
+    serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    batchSerializer->serialize(data, &out);
+
+    auto serialized = output.str();
+    auto byteStream = toByteStream(serialized);
+    RowVectorPtr result;
+    serde_->deserialize(
+        &byteStream,
+        pool_.get(),
+        asRowType(data->type()),
+        &result,
+        0,
+        &deserializeOptions);
+    assertEqualVectors(data, result);
+    ASSERT_EQ(
+        result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+    // All base values are serialized, not only the 4 that are used.
+    ASSERT_EQ(result->childAt(0)->valueVector()->size(), 8);
+    deserializedBases.push_back(result->childAt(0)->valueVector());
+  }
+  ASSERT_EQ(deserializedBases[0], deserializedBases[1]);
+  ASSERT_NE(deserializedBases[1], deserializedBases[2]);
+  ASSERT_EQ(dictionaryCache->numHits(), 1);
+  ASSERT_EQ(dictionaryCache->size(), 2);
+}
+
+TEST_P(PrestoSerializerTest, zeroCopy) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row * 3; }),
+      makeFlatVector<int8_t>(100, [](auto row) { return row % 7; }),
+      makeFlatVector<double>(
+          100, [](auto row) { return row * 0.5; }, nullEvery(5)),
+  });
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions serializeOptions;
+  auto batchSerializer =
+      serde_->createBatchSerializer(pool_.get(), &serializeOptions);
+  std::ostringstream output;
+  serializer::presto::PrestoOutputStreamListener listener;
+  OStreamOutputStream out(&output, &listener);
+  batchSerializer->serialize(data, &out);
+  const auto serialized = output.str();
+
+  // The bigint values are aligned for one of 8 consecutive start addresses
+  // of the page.
+  int32_t numAlignedViews = 0;
+  for (auto shift = 0; shift < 8; ++shift) {
+    auto input = std::make_shared<std::vector<int64_t>>(
+        bits::nwords(serialized.size() * 8) + 1);
+    auto* start = reinterpret_cast<char*>(input->data()) + shift;
+    std::memcpy(start, serialized.data(), serialized.size());
+    ByteInputStream byteStream({ByteRange{
+        reinterpret_cast<uint8_t*>(start), (int32_t)serialized.size(), 0}});
+
+    serializer::presto::PrestoVectorSerde::PrestoOptions deserializeOptions;
+    deserializeOptions.zeroCopyInput = input;
+    RowVectorPtr result;
+    serde_->deserialize(
+        &byteStream,
+        pool_.get(),
+        asRowType(data->type()),
+        &result,
+        0,
+        &deserializeOptions);
+    assertEqualVectors(data, result);
+
+    const auto& bigints = result->childAt(0)->values();
+    if (bigints->isView()) {
+      ++numAlignedViews;
+      ASSERT_EQ(
+          reinterpret_cast<uintptr_t>(bigints->as<int64_t>()) %
+              alignof(int64_t),
+          0);
+    }
+    // Tinyint values are always aligned. Values with nulls are copied.
+    ASSERT_TRUE(result->childAt(1)->values()->isView());
+    ASSERT_FALSE(result->childAt(2)->values()->isView());
+
+    // The views keep the input alive.
+    input.reset();
+    assertEqualVectors(data, result);
+  }
+  ASSERT_EQ(numAlignedViews, 1);
+}
+
 TEST_P(PrestoSerializerTest, emptyVectorBatchVectorSerializer) {
   // Serialize an empty RowVector.
   auto rowVector = makeEmptyTestVector();
@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/substrait/SubstraitPlanCache.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+namespace facebook::velox::substrait {
+namespace {
+
+using Literal = ::substrait::Expression::Literal;
+
+// Adds the literals in 'message' to 'slots' in the order of the fields.
+// Does not look into the literals themselves, so a list literal is one slot.
+void collectLiterals(
+    const google::protobuf::Message& message,
+    std::vector<const Literal*>& slots) {
+  if (auto* literal = dynamic_cast<const Literal*>(&message)) {
+    slots.push_back(literal);
+    return;
+  }
+  const auto* reflection = message.GetReflection();
+  std::vector<const google::protobuf::FieldDescriptor*> fields;
+  reflection->ListFields(message, &fields);
+  for (const auto* field : fields) {
+    if (field->cpp_type() !=
+        google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+      continue;
+    }
+    if (field->is_repeated()) {
+      const auto size = reflection->FieldSize(message, field);
+      for (auto i = 0; i < size; ++i) {
+        collectLiterals(
+            reflection->GetRepeatedMessage(message, field, i), slots);
+      }
+    } else {
+      collectLiterals(reflection->GetMessage(message, field), slots);
+    }
+  }
+}
+
+// Adds the parameter slots of 'rel' and its inputs to 'slots'. These are the
+// literals of the expressions that SubstraitVeloxPlanConverter translates
+// into Filter, Project and Aggregation nodes. Sort and Fetch are passed
+// through. Reads and the other relations end the walk.
+void collectSlots(
+    const ::substrait::Rel& rel,
+    std::vector<const Literal*>& slots) {
+  switch (rel.rel_type_case()) {
+    case ::substrait::Rel::RelTypeCase::kFilter:
+      collectLiterals(rel.filter().condition(), slots);
+      collectSlots(rel.filter().input(), slots);
+      break;
+    case ::substrait::Rel::RelTypeCase::kProject:
+      for (const auto& expr : rel.project().expressions()) {
+        collectLiterals(expr, slots);
+      }
+      collectSlots(rel.project().input(), slots);
+      break;
+    case ::substrait::Rel::RelTypeCase::kAggregate:
+      for (const auto& measure : rel.aggregate().measures()) {
+        collectLiterals(measure.measure(), slots);
+      }
+      collectSlots(rel.aggregate().input(), slots);
+      break;
+    case ::substrait::Rel::RelTypeCase::kSort:
+      collectSlots(rel.sort().input(), slots);
+      break;
+    case ::substrait::Rel::RelTypeCase::kFetch:
+      collectSlots(rel.fetch().input(), slots);
+      break;
+    default:
+      break;
+  }
+}
+
+std::vector<const Literal*> collectSlots(const ::substrait::Plan& plan) {
+  std::vector<const Literal*> slots;
+  if (plan.relations_size() != 1) {
+    return slots;
+  }
+  const auto& rel = plan.relations(0);
+  if (rel.has_root()) {
+    collectSlots(rel.root().input(), slots);
+  } else if (rel.has_rel()) {
+    collectSlots(rel.rel(), slots);
+  }
+  return slots;
+}
+
+// Serializes 'message' with map entries in a stable order.
+std::string serializeDeterministic(const google::protobuf::Message& message) {
+  std::string bytes;
+  {
+    google::protobuf::io::StringOutputStream stream(&bytes);
+    google::protobuf::io::CodedOutputStream output(&stream);
+    output.SetSerializationDeterministic(true);
+    message.SerializeToCodedStream(&output);
+  }
+  return bytes;
+}
+
+// Replaces constants in a Velox plan converted from Substrait. Visits the
+// same nodes as collectSlots(): the expressions of Filter, Project and
+// Aggregation nodes, looking through calls and casts, and the inputs of
+// these and of OrderBy, TopN and Limit nodes. Records the constants it
+// visits so that the caller can tell whether a constant can be replaced.
+class ConstantBinder {
+ public:
+  explicit ConstantBinder(
+      std::unordered_map<const core::ITypedExpr*, core::TypedExprPtr>
+          constants)
+      : constants_(std::move(constants)) {}
+
+  core::PlanNodePtr bind(const core::PlanNodePtr& node) {
+    if (auto* filter = dynamic_cast<const core::FilterNode*>(node.get())) {
+      auto condition = bind(filter->filter());
+      auto source = bind(node->sources()[0]);
+      if (condition == filter->filter() && source == node->sources()[0]) {
+        return node;
+      }
+      return std::make_shared<core::FilterNode>(node->id(), condition, source);
+    }
+    if (auto* project = dynamic_cast<const core::ProjectNode*>(node.get())) {
+      bool changed = false;
+      auto projections = bind(project->projections(), changed);
+      auto source = bind(node->sources()[0]);
+      if (!changed && source == node->sources()[0]) {
+        return node;
+      }
+      return std::make_shared<core::ProjectNode>(
+          node->id(), project->names(), projections, source);
+    }
+    if (auto* aggregation =
+            dynamic_cast<const core::AggregationNode*>(node.get())) {
+      bool changed = false;
+      auto aggregates = aggregation->aggregates();
+      for (auto& aggregate : aggregates) {
+        auto call = bind(aggregate.call);
+        if (call != aggregate.call) {
+          aggregate.call =
+              std::dynamic_pointer_cast<const core::CallTypedExpr>(call);
+          changed = true;
+        }
+      }
+      auto source = bind(node->sources()[0]);
+      if (!changed && source == node->sources()[0]) {
+        return node;
+      }
+      return std::make_shared<core::AggregationNode>(
+          node->id(),
+          aggregation->step(),
+          aggregation->groupingKeys(),
+          aggregation->preGroupedKeys(),
+          aggregation->aggregateNames(),
+          aggregates,
+          aggregation->globalGroupingSets(),
+          aggregation->groupId(),
+          aggregation->ignoreNullKeys(),
+          source);
+    }
+    if (auto* orderBy = dynamic_cast<const core::OrderByNode*>(node.get())) {
+      auto source = bind(node->sources()[0]);
+      if (source == node->sources()[0]) {
+        return node;
+      }
+      return std::make_shared<core::OrderByNode>(
+          node->id(),
+          orderBy->sortingKeys(),
+          orderBy->sortingOrders(),
+          orderBy->isPartial(),
+          source);
+    }
+    if (auto* topN = dynamic_cast<const core::TopNNode*>(node.get())) {
+      auto source = bind(node->sources()[0]);
+      if (source == node->sources()[0]) {
+        return node;
+      }
+      return std::make_shared<core::TopNNode>(
+          node->id(),
+          topN->sortingKeys(),
+          topN->sortingOrders(),
+          topN->count(),
+          topN->isPartial(),
+          source);
+    }
+    if (auto* limit = dynamic_cast<const core::LimitNode*>(node.get())) {
+      auto source = bind(node->sources()[0]);
+      if (source == node->sources()[0]) {
+        return node;
+      }
+      return std::make_shared<core::LimitNode>(
+          node->id(),
+          limit->offset(),
+          limit->count(),
+          limit->isPartial(),
+          source);
+    }
+    return node;
+  }
+
+  const std::unordered_set<const core::ITypedExpr*>& visited() const {
+    return visited_;
+  }
+
+ private:
+  core::TypedExprPtr bind(const core::TypedExprPtr& expr) {
+    if (dynamic_cast<const core::ConstantTypedExpr*>(expr.get())) {
+      visited_.insert(expr.get());
+      auto it = constants_.find(expr.get());
+      return it == constants_.end() ? expr : it->second;
+    }
+    auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+    auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get());
+    if (!call && !cast) {
+      return expr;
+    }
+    bool changed = false;
+    auto inputs = bind(expr->inputs(), changed);
+    if (!changed) {
+      return expr;
+    }
+    if (cast) {
+      return std::make_shared<core::CastTypedExpr>(
+          expr->type(), inputs, cast->nullOnFailure());
+    }
+    return std::make_shared<core::CallTypedExpr>(
+        expr->type(), std::move(inputs), call->name());
+  }
+
+  std::vector<core::TypedExprPtr> bind(
+      const std::vector<core::TypedExprPtr>& exprs,
+      bool& changed) {
+    std::vector<core::TypedExprPtr> bound;
+    bound.reserve(exprs.size());
+    for (const auto& expr : exprs) {
+      bound.push_back(bind(expr));
+      changed |= bound.back() != expr;
+    }
+    return bound;
+  }
+
+  const std::unordered_map<const core::ITypedExpr*, core::TypedExprPtr>
+      constants_;
+  std::unordered_set<const core::ITypedExpr*> visited_;
+};
+
+// Returns a copy of 'splitInfos' that does not share the SplitInfo objects.
+SubstraitPlanCache::SplitInfos copySplitInfos(
+    const SubstraitPlanCache::SplitInfos& splitInfos) {
+  SubstraitPlanCache::SplitInfos copy;
+  for (const auto& [id, splitInfo] : splitInfos) {
+    copy[id] =
+        std::make_shared<SubstraitVeloxPlanConverter::SplitInfo>(*splitInfo);
+  }
+  return copy;
+}
+
+} // namespace
+
+SubstraitPlanCache::SubstraitPlanCache(
+    std::shared_ptr<memory::MemoryPool> pool,
+    size_t maxEntries)
+    : pool_(std::move(pool)), cache_(maxEntries) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+core::PlanNodePtr SubstraitPlanCache::toVeloxPlan(
+    const ::substrait::Plan& substraitPlan,
+    SplitInfos* splitInfos) {
+  const auto slots = collectSlots(substraitPlan);
+
+  // The key is the plan with the slots cleared followed by the types of the
+  // slots, which decide the function signatures the plan resolves to.
+  ::substrait::Plan shape = substraitPlan;
+  for (const auto* literal : collectSlots(shape)) {
+    // 'shape' is a local copy, so its literals may be modified.
+    const_cast<Literal*>(literal)->Clear();
+  }
+  auto key = serializeDeterministic(shape);
+
+  SubstraitVeloxExprConverter literalConverter(pool_.get(), {});
+  std::vector<core::TypedExprPtr> constants;
+  constants.reserve(slots.size());
+  for (const auto* literal : slots) {
+    constants.push_back(literalConverter.toVeloxExpr(*literal));
+    key.append(";").append(constants.back()->type()->toString());
+  }
+
+  std::shared_ptr<const Entry> entry;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (auto* cached = cache_.get(key)) {
+      entry = *cached;
+      cache_.release(key);
+      ++numHits_;
+    } else {
+      ++numMisses_;
+    }
+  }
+
+  if (entry != nullptr) {
+    std::unordered_map<const core::ITypedExpr*, core::TypedExprPtr> rebound;
+    for (auto i = 0; i < slots.size(); ++i) {
+      for (const auto* constant : entry->slotConstants[i]) {
+        rebound[constant] = constants[i];
+      }
+    }
+    if (splitInfos != nullptr) {
+      *splitInfos = copySplitInfos(entry->splitInfos);
+    }
+    return ConstantBinder(std::move(rebound)).bind(entry->plan);
+  }
+
+  bool cacheable;
+  entry = convert(substraitPlan, slots, cacheable);
+  if (splitInfos != nullptr) {
+    *splitInfos = copySplitInfos(entry->splitInfos);
+  }
+  if (cacheable) {
+    auto* value = new std::shared_ptr<const Entry>(entry);
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!cache_.add(key, value, 1)) {
+      // Added by another thread converting the same shape.
+      delete value;
+    }
+  }
+  return entry->plan;
+}
+
+std::shared_ptr<const SubstraitPlanCache::Entry> SubstraitPlanCache::convert(
+    const ::substrait::Plan& substraitPlan,
+    const std::vector<const Literal*>& slots,
+    bool& cacheable) {
+  std::unordered_map<const Literal*, size_t> slotIndices;
+  for (auto i = 0; i < slots.size(); ++i) {
+    slotIndices[slots[i]] = i;
+  }
+
+  auto entry = std::make_shared<Entry>();
+  entry->slotConstants.resize(slots.size());
+  SubstraitVeloxPlanConverter converter(pool_.get());
+  converter.setLiteralObserver(
+      [&](const Literal& literal,
+          const std::shared_ptr<const core::ConstantTypedExpr>& constant) {
+        auto it = slotIndices.find(&literal);
+        if (it != slotIndices.end()) {
+          entry->slotConstants[it->second].push_back(constant.get());
+        }
+      });
+  entry->plan = converter.toVeloxPlan(substraitPlan);
+  entry->splitInfos = converter.splitInfos();
+
+  // A slot can be rebound if the binder reaches all the constants made from
+  // its literal. The literals the converter copied before translating them
+  // have no constants recorded and make the plan uncacheable.
+  ConstantBinder binder({});
+  binder.bind(entry->plan);
+  cacheable = true;
+  for (const auto& constants : entry->slotConstants) {
+    if (constants.empty()) {
+      cacheable = false;
+    }
+    for (const auto* constant : constants) {
+      if (binder.visited().count(constant) == 0) {
+        cacheable = false;
+      }
+    }
+  }
+  return entry;
+}
+
+SubstraitPlanCache::Stats SubstraitPlanCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.numEntries = cache_.stats().numElements;
+  return stats;
+}
+
+} // namespace facebook::velox::substrait
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/substrait/SubstraitToVeloxPlan.h"
+
+namespace facebook::velox::substrait {
+
+/// Caches the Velox plans converted from Substrait plans so that queries of
+/// the same shape pay for the conversion, including the function lookups,
+/// once. Plans are keyed by their structure with the literals of filter,
+/// project and aggregation expressions taken out as parameter slots. A plan
+/// that differs from a cached one only in the values of these literals reuses
+/// the cached Velox plan with the new constants bound in. Literals elsewhere,
+/// e.g. in the filters pushed into scans or in virtual tables, remain part of
+/// the key. Thread-safe.
+class SubstraitPlanCache {
+ public:
+  using SplitInfos = std::unordered_map<
+      core::PlanNodeId,
+      std::shared_ptr<SubstraitVeloxPlanConverter::SplitInfo>>;
+
+  struct Stats {
+    /// Number of plans served from the cache.
+    uint64_t numHits{0};
+
+    /// Number of plans converted from scratch.
+    uint64_t numMisses{0};
+
+    /// Number of plans in the cache.
+    size_t numEntries{0};
+  };
+
+  /// @param pool Memory pool for the constants of the cached plans. Kept
+  /// alive for as long as the cache.
+  /// @param maxEntries Maximum number of cached plans.
+  SubstraitPlanCache(
+      std::shared_ptr<memory::MemoryPool> pool,
+      size_t maxEntries);
+
+  /// Returns the Velox plan for 'substraitPlan', converting it if no plan of
+  /// the same shape is cached. Sets 'splitInfos' to the split infos of the
+  /// scans in the plan if not null.
+  core::PlanNodePtr toVeloxPlan(
+      const ::substrait::Plan& substraitPlan,
+      SplitInfos* splitInfos = nullptr);
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    core::PlanNodePtr plan;
+
+    // The Velox constants of each parameter slot in 'plan'. A slot may have
+    // more than one if the converter translated its literal more than once.
+    std::vector<std::vector<const core::ITypedExpr*>> slotConstants;
+
+    SplitInfos splitInfos;
+  };
+
+  // Converts 'substraitPlan' into a new entry. 'slots' are the parameter
+  // slots of 'substraitPlan'. Sets 'cacheable' to false if the constants of
+  // some slot cannot be rebound in the converted plan.
+  std::shared_ptr<const Entry> convert(
+      const ::substrait::Plan& substraitPlan,
+      const std::vector<const ::substrait::Expression::Literal*>& slots,
+      bool& cacheable);
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, std::shared_ptr<const Entry>> cache_;
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+};
+
+} // namespace facebook::velox::substrait
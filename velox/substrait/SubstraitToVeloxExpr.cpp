@@ -204,6 +204,16 @@ core::TypedExprPtr SubstraitVeloxExprConverter::toVeloxExpr(
 std::shared_ptr<const core::ConstantTypedExpr>
 SubstraitVeloxExprConverter::toVeloxExpr(
     const ::substrait::Expression::Literal& substraitLit) {
+  auto constant = toConstant(substraitLit);
+  if (literalObserver_) {
+    literalObserver_(substraitLit, constant);
+  }
+  return constant;
+}
+
+std::shared_ptr<const core::ConstantTypedExpr>
+SubstraitVeloxExprConverter::toConstant(
+    const ::substrait::Expression::Literal& substraitLit) {
   auto typeCase = substraitLit.literal_type_case();
   switch (typeCase) {
     case ::substrait::Expression_Literal::LiteralTypeCase::kBoolean:
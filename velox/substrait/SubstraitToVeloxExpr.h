@@ -27,6 +27,11 @@ namespace facebook::velox::substrait {
 /// expressions.
 class SubstraitVeloxExprConverter {
  public:
+  /// Called with each Substrait literal and the constant it was converted to.
+  using LiteralObserver = std::function<void(
+      const ::substrait::Expression::Literal&,
+      const std::shared_ptr<const core::ConstantTypedExpr>&)>;
+
   /// subParser: A Substrait parser used to convert Substrait representations
   /// into recognizable representations. functionMap: A pre-constructed map
   /// storing the relations between the function id and the function name.
@@ -35,6 +40,11 @@ class SubstraitVeloxExprConverter {
       const std::unordered_map<uint64_t, std::string>& functionMap)
       : pool_(pool), functionMap_(functionMap) {}
 
+  /// Sets a callback that sees every literal converted by toVeloxExpr().
+  void setLiteralObserver(LiteralObserver observer) {
+    literalObserver_ = std::move(observer);
+  }
+
   /// Convert Substrait Field into Velox Field Expression.
   std::shared_ptr<const core::FieldAccessTypedExpr> toVeloxExpr(
       const ::substrait::Expression::FieldReference& substraitField,
@@ -69,6 +79,11 @@ class SubstraitVeloxExprConverter {
   ArrayVectorPtr literalsToArrayVector(
       const ::substrait::Expression::Literal& listLiteral);
 
+  /// Convert Substrait Literal into Velox constant without notifying the
+  /// observer.
+  std::shared_ptr<const core::ConstantTypedExpr> toConstant(
+      const ::substrait::Expression::Literal& substraitLit);
+
   /// Memory pool.
   memory::MemoryPool* pool_;
 
@@ -79,6 +94,9 @@ class SubstraitVeloxExprConverter {
   /// The map storing the relations between the function id and the function
   /// name.
   std::unordered_map<uint64_t, std::string> functionMap_;
+
+  /// Optional callback invoked for each converted literal.
+  LiteralObserver literalObserver_;
 };
 
 } // namespace facebook::velox::substrait
@@ -194,7 +194,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   auto childNode = convertSingleInput<::substrait::ProjectRel>(projectRel);
 
   // Construct Velox Expressions.
-  auto projectExprs = projectRel.expressions();
+  const auto& projectExprs = projectRel.expressions();
   std::vector<std::string> projectNames;
   std::vector<core::TypedExprPtr> expressions;
   projectNames.reserve(projectExprs.size());
@@ -254,7 +254,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   auto childNode = convertSingleInput<::substrait::SortRel>(sortRel);
 
   auto [sortingKeys, sortingOrders] =
-      processSortField(sortRel.sorts(), childNode->outputType());
+      processSortField(sortRel->sorts(), childNode->outputType());
 
   return std::make_shared<core::OrderByNode>(
       nextPlanNodeId(),
@@ -314,13 +314,13 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   core::PlanNodePtr childNode;
   // Check the input of fetchRel, if it's sortRel, convert them into
   // topNNode. otherwise, to limitNode.
-  ::substrait::SortRel sortRel;
+  const ::substrait::SortRel* sortRel = nullptr;
   bool topNFlag;
   if (fetchRel.has_input()) {
     topNFlag = fetchRel.input().has_sort();
     if (topNFlag) {
-      sortRel = fetchRel.input().sort();
-      childNode = toVeloxPlan(sortRel.input());
+      sortRel = &fetchRel.input().sort();
+      childNode = toVeloxPlan(sortRel->input());
     } else {
       childNode = toVeloxPlan(fetchRel.input());
     }
@@ -330,7 +330,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
   if (topNFlag) {
     auto [sortingKeys, sortingOrders] =
-        processSortField(sortRel.sorts(), childNode->outputType());
+        processSortField(sortRel->sorts(), childNode->outputType());
 
     VELOX_CHECK_EQ(fetchRel.offset(), 0);
 
@@ -564,6 +564,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   // Construct the expression converter.
   exprConverter_ =
       std::make_shared<SubstraitVeloxExprConverter>(pool_, functionMap_);
+  exprConverter_->setLiteralObserver(literalObserver_);
 
   // In fact, only one RelRoot or Rel is expected here.
   VELOX_CHECK_EQ(substraitPlan.relations_size(), 1);
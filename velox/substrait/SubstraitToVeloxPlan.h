@@ -109,6 +109,13 @@ class SubstraitVeloxPlanConverter {
   /// name>:<arg_type0>_<arg_type1>_..._<arg_typeN>
   const std::string& findFunction(uint64_t id) const;
 
+  /// Sets a callback that sees every literal converted into a Velox constant
+  /// by the next toVeloxPlan(const ::substrait::Plan&) call.
+  void setLiteralObserver(
+      SubstraitVeloxExprConverter::LiteralObserver observer) {
+    literalObserver_ = std::move(observer);
+  }
+
   /// Integrate Substrait emit feature. Here a given 'substrait::RelCommon'
   /// is passed and check if emit is defined for this relation. Basically a
   /// ProjectNode is added on top of 'noEmitNode' to represent output order
@@ -157,6 +164,9 @@ class SubstraitVeloxPlanConverter {
   /// Velox expressions.
   std::shared_ptr<SubstraitVeloxExprConverter> exprConverter_;
 
+  /// Passed to 'exprConverter_' when it is created.
+  SubstraitVeloxExprConverter::LiteralObserver literalObserver_;
+
   /// The unique identification for each PlanNode.
   int planNodeId_ = 0;
 
@@ -173,7 +183,7 @@ class SubstraitVeloxPlanConverter {
 
   /// Helper function to convert the input of Substrait Rel to Velox Node.
   template <typename T>
-  core::PlanNodePtr convertSingleInput(T rel) {
+  core::PlanNodePtr convertSingleInput(const T& rel) {
     VELOX_CHECK(rel.has_input(), "Child Rel is expected here.");
     return toVeloxPlan(rel.input());
   }
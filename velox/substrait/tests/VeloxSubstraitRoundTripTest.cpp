@@ -21,6 +21,7 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
 
+#include "velox/substrait/SubstraitPlanCache.h"
 #include "velox/substrait/SubstraitToVeloxPlan.h"
 #include "velox/substrait/VeloxToSubstraitPlan.h"
 
@@ -507,6 +508,48 @@ TEST_F(VeloxSubstraitRoundTripTest, dateType) {
   assertPlanConversion(plan, "SELECT * FROM tmp WHERE c > DATE '1992-01-01'");
 }
 
+TEST_F(VeloxSubstraitRoundTripTest, planCache) {
+  auto vectors = makeVectors(3, 4, 2);
+  createDuckDbTable(vectors);
+
+  SubstraitPlanCache cache(pool_, 10);
+  auto makeSubstraitPlan = [&](google::protobuf::Arena& arena,
+                               const std::string& filter,
+                               const std::string& projection) {
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .filter(filter)
+                    .project({projection})
+                    .planNode();
+    return veloxConvertor_->toSubstrait(arena, plan);
+  };
+
+  google::protobuf::Arena arena;
+  auto plan = cache.toVeloxPlan(
+      makeSubstraitPlan(arena, "c0 > 500000000", "c1 + 5"));
+  assertQuery(plan, "SELECT c1 + 5 FROM tmp WHERE c0 > 500000000");
+  ASSERT_EQ(cache.stats().numMisses, 1);
+  ASSERT_EQ(cache.stats().numEntries, 1);
+
+  // Same shape with different literals reuses the cached plan.
+  plan = cache.toVeloxPlan(
+      makeSubstraitPlan(arena, "c0 > 600000000", "c1 + 7"));
+  assertQuery(plan, "SELECT c1 + 7 FROM tmp WHERE c0 > 600000000");
+  ASSERT_EQ(cache.stats().numHits, 1);
+
+  plan = cache.toVeloxPlan(
+      makeSubstraitPlan(arena, "c0 > 500000000", "c1 + 5"));
+  assertQuery(plan, "SELECT c1 + 5 FROM tmp WHERE c0 > 500000000");
+  ASSERT_EQ(cache.stats().numHits, 2);
+
+  // Another function is another shape.
+  plan = cache.toVeloxPlan(
+      makeSubstraitPlan(arena, "c0 > 500000000", "c1 - 5"));
+  assertQuery(plan, "SELECT c1 - 5 FROM tmp WHERE c0 > 500000000");
+  ASSERT_EQ(cache.stats().numMisses, 2);
+  ASSERT_EQ(cache.stats().numEntries, 2);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   folly::Init init{&argc, &argv, false};
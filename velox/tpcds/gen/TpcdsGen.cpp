@@ -0,0 +1,693 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/tpcds/gen/TpcdsGen.h"
+
+#include <array>
+#include <cmath>
+#include <ctime>
+
+#include "velox/type/Timestamp.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::tpcds {
+
+namespace {
+
+// d_date_sk of the first row of date_dim, the Julian day number of
+// 1900-01-02.
+constexpr int64_t kFirstDateSk = 2'415'022;
+
+// Days from 1970-01-01 to 1900-01-02.
+constexpr int32_t kFirstDate = -25'566;
+
+constexpr size_t kDateDimRowCount = 73'049;
+
+// d_date_sk of the first and the last days of sales, 1998-01-02 and
+// 2003-01-02.
+constexpr int64_t kFirstSalesDateSk = 2'450'816;
+constexpr int64_t kLastSalesDateSk = 2'452'642;
+
+constexpr size_t kStoreSalesRowCount = 2'880'404;
+
+// Number of consecutive store_sales rows that belong to the same ticket.
+constexpr size_t kLinesPerTicket = 12;
+
+const std::array<std::string_view, 10> kCategories = {
+    "Women",
+    "Men",
+    "Children",
+    "Shoes",
+    "Music",
+    "Jewelry",
+    "Home",
+    "Sports",
+    "Books",
+    "Electronics"};
+
+constexpr int32_t kClassesPerCategory = 4;
+
+const std::array<std::array<std::string_view, kClassesPerCategory>, 10>
+    kClasses = {{
+        {"dresses", "fragrances", "maternity", "swimwear"},
+        {"accessories", "pants", "shirts", "sports-apparel"},
+        {"infants", "newborn", "school-uniforms", "toddlers"},
+        {"athletic", "kids", "mens", "womens"},
+        {"classical", "country", "pop", "rock"},
+        {"birdal", "costume", "diamonds", "rings"},
+        {"bedding", "furniture", "kids", "lighting"},
+        {"baseball", "camping", "fitness", "golf"},
+        {"arts", "cooking", "fiction", "history"},
+        {"audio", "cameras", "monitors", "televisions"},
+    }};
+
+constexpr int32_t kBrandsPerClass = 10;
+
+const std::array<std::string_view, 10> kBrandPrefixes = {
+    "amalg",
+    "edu pack",
+    "export",
+    "import",
+    "scholar",
+    "brand",
+    "corp",
+    "univ",
+    "maxi",
+    "namelessname"};
+
+const std::array<std::string_view, kClassesPerCategory> kBrandSuffixes =
+    {"importo", "scholar", "univ", "maxi"};
+
+// The syllables that the spec composes names from, one per digit.
+const std::array<std::string_view, 10> kSyllables = {
+    "ought",
+    "able",
+    "pri",
+    "ese",
+    "anti",
+    "cally",
+    "ation",
+    "eing",
+    "n st",
+    "bar"};
+
+const std::array<std::string_view, 8> kWords = {
+    "quiet",
+    "large",
+    "new",
+    "simple",
+    "modern",
+    "classic",
+    "small",
+    "bright"};
+
+const std::array<std::string_view, 8> kStates =
+    {"TN", "TN", "TN", "SD", "AL", "GA", "SC", "MI"};
+
+const std::array<std::string_view, 7> kDayNames = {
+    "Sunday",
+    "Monday",
+    "Tuesday",
+    "Wednesday",
+    "Thursday",
+    "Friday",
+    "Saturday"};
+
+const std::array<std::string_view, 2> kGenders = {"M", "F"};
+
+const std::array<std::string_view, 5> kMaritalStatuses =
+    {"M", "S", "D", "W", "U"};
+
+const std::array<std::string_view, 7> kEducationStatuses = {
+    "Primary",
+    "Secondary",
+    "College",
+    "2 yr Degree",
+    "4 yr Degree",
+    "Advanced Degree",
+    "Unknown"};
+
+constexpr int32_t kNumPurchaseEstimates = 20;
+
+const std::array<std::string_view, 4> kCreditRatings =
+    {"Good", "High Risk", "Low Risk", "Unknown"};
+
+constexpr int32_t kNumDepCounts = 7;
+
+// The spec has two more dependent counts of 7 values each in the cross
+// product of customer_demographics.
+constexpr size_t kCustomerDemographicsRowCount = kGenders.size() *
+    kMaritalStatuses.size() * kEducationStatuses.size() *
+    kNumPurchaseEstimates * kCreditRatings.size() * kNumDepCounts *
+    kNumDepCounts * kNumDepCounts;
+
+// Returns a pseudo random number that depends only on 'table', 'column' and
+// 'row', so that any range of rows can be generated on its own.
+uint64_t random(Table table, int32_t column, uint64_t row) {
+  uint64_t x = row * 0x9e3779b97f4a7c15ULL +
+      ((static_cast<uint64_t>(table) << 8) + column + 1) *
+          0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// Returns a pseudo random integer in [min, max].
+int64_t
+randomInt(Table table, int32_t column, uint64_t row, int64_t min, int64_t max) {
+  return min + random(table, column, row) % (max - min + 1);
+}
+
+double roundToCents(double value) {
+  return std::round(value * 100) / 100;
+}
+
+// Returns the 16 character business key of 'key', e.g. i_item_id, encoding
+// each 4 bits as a letter like dsdgen does.
+std::string makeBusinessKey(uint64_t key) {
+  std::string result(16, 'A');
+  for (auto i = 15; i >= 0 && key != 0; --i) {
+    result[i] = 'A' + (key & 0xf);
+    key >>= 4;
+  }
+  return result;
+}
+
+// Returns a name made of one syllable per decimal digit of 'number'.
+std::string makeWord(uint64_t number) {
+  std::string result;
+  do {
+    result.insert(0, kSyllables[number % 10]);
+    number /= 10;
+  } while (number != 0);
+  return result;
+}
+
+// Interpolates linearly between the row counts 'counts' that the spec gives
+// for the scale factors 1, 10, 100 and 1000. Row counts are proportional to
+// the scale factor below 1 and constant above 1000.
+size_t interpolateRowCount(
+    double scaleFactor,
+    const std::array<size_t, 4>& counts) {
+  static constexpr std::array<double, 4> kScaleFactors = {1, 10, 100, 1000};
+  if (scaleFactor == 0) {
+    return 0;
+  }
+  if (scaleFactor <= kScaleFactors[0]) {
+    return std::max<size_t>(1, counts[0] * scaleFactor);
+  }
+  for (auto i = 1; i < kScaleFactors.size(); ++i) {
+    if (scaleFactor <= kScaleFactors[i]) {
+      const auto ratio = (scaleFactor - kScaleFactors[i - 1]) /
+          (kScaleFactors[i] - kScaleFactors[i - 1]);
+      return counts[i - 1] + ratio * (counts[i] - counts[i - 1]);
+    }
+  }
+  return counts.back();
+}
+
+size_t getVectorSize(size_t rowCount, size_t maxRows, size_t offset) {
+  if (offset >= rowCount) {
+    return 0;
+  }
+  return std::min(rowCount - offset, maxRows);
+}
+
+std::vector<VectorPtr> allocateVectors(
+    const RowTypePtr& type,
+    size_t vectorSize,
+    memory::MemoryPool* pool) {
+  std::vector<VectorPtr> vectors;
+  vectors.reserve(type->size());
+
+  for (const auto& childType : type->children()) {
+    vectors.emplace_back(BaseVector::create(childType, vectorSize, pool));
+  }
+  return vectors;
+}
+
+} // namespace
+
+std::string_view toTableName(Table table) {
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      return "date_dim";
+    case Table::TBL_ITEM:
+      return "item";
+    case Table::TBL_STORE:
+      return "store";
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      return "customer_demographics";
+    case Table::TBL_STORE_SALES:
+      return "store_sales";
+  }
+  return ""; // make gcc happy.
+}
+
+Table fromTableName(std::string_view tableName) {
+  static std::unordered_map<std::string_view, Table> map{
+      {"date_dim", Table::TBL_DATE_DIM},
+      {"item", Table::TBL_ITEM},
+      {"store", Table::TBL_STORE},
+      {"customer_demographics", Table::TBL_CUSTOMER_DEMOGRAPHICS},
+      {"store_sales", Table::TBL_STORE_SALES},
+  };
+
+  auto it = map.find(tableName);
+  if (it != map.end()) {
+    return it->second;
+  }
+  throw std::invalid_argument(
+      fmt::format("Invalid TPC-DS table name: '{}'", tableName));
+}
+
+size_t getRowCount(Table table, double scaleFactor) {
+  VELOX_CHECK_GE(scaleFactor, 0, "Tpcds scale factor must be non-negative");
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      return kDateDimRowCount;
+    case Table::TBL_ITEM:
+      return interpolateRowCount(
+          scaleFactor, {18'000, 102'000, 204'000, 300'000});
+    case Table::TBL_STORE:
+      return interpolateRowCount(scaleFactor, {12, 102, 402, 1'002});
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      return kCustomerDemographicsRowCount;
+    case Table::TBL_STORE_SALES:
+      return kStoreSalesRowCount * scaleFactor;
+  }
+  return 0; // make gcc happy.
+}
+
+RowTypePtr getTableSchema(Table table) {
+  switch (table) {
+    case Table::TBL_DATE_DIM: {
+      static RowTypePtr type = ROW(
+          {
+              "d_date_sk",
+              "d_date",
+              "d_month_seq",
+              "d_year",
+              "d_moy",
+              "d_dom",
+              "d_qoy",
+              "d_day_name",
+          },
+          {
+              BIGINT(),
+              DATE(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              VARCHAR(),
+          });
+      return type;
+    }
+
+    case Table::TBL_ITEM: {
+      static RowTypePtr type = ROW(
+          {
+              "i_item_sk",
+              "i_item_id",
+              "i_item_desc",
+              "i_current_price",
+              "i_brand_id",
+              "i_brand",
+              "i_class_id",
+              "i_class",
+              "i_category_id",
+              "i_category",
+              "i_manufact_id",
+              "i_product_name",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              DOUBLE(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+          });
+      return type;
+    }
+
+    case Table::TBL_STORE: {
+      static RowTypePtr type = ROW(
+          {
+              "s_store_sk",
+              "s_store_id",
+              "s_store_name",
+              "s_state",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+          });
+      return type;
+    }
+
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS: {
+      static RowTypePtr type = ROW(
+          {
+              "cd_demo_sk",
+              "cd_gender",
+              "cd_marital_status",
+              "cd_education_status",
+              "cd_purchase_estimate",
+              "cd_credit_rating",
+              "cd_dep_count",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+          });
+      return type;
+    }
+
+    case Table::TBL_STORE_SALES: {
+      static RowTypePtr type = ROW(
+          {
+              "ss_sold_date_sk",
+              "ss_item_sk",
+              "ss_cdemo_sk",
+              "ss_store_sk",
+              "ss_ticket_number",
+              "ss_quantity",
+              "ss_list_price",
+              "ss_sales_price",
+              "ss_ext_sales_price",
+              "ss_coupon_amt",
+              "ss_net_profit",
+          },
+          {
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              INTEGER(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+          });
+      return type;
+    }
+  }
+  return nullptr; // make gcc happy.
+}
+
+TypePtr resolveTpcdsColumn(Table table, const std::string& columnName) {
+  return getTableSchema(table)->findChild(columnName);
+}
+
+RowVectorPtr genTpcdsDateDim(
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  // Create schema and allocate vectors.
+  auto dateDimRowType = getTableSchema(Table::TBL_DATE_DIM);
+  size_t vectorSize = getVectorSize(
+      getRowCount(Table::TBL_DATE_DIM, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(dateDimRowType, vectorSize, pool);
+
+  auto dateSkVector = children[0]->asFlatVector<int64_t>();
+  auto dateVector = children[1]->asFlatVector<int32_t>();
+  auto monthSeqVector = children[2]->asFlatVector<int32_t>();
+  auto yearVector = children[3]->asFlatVector<int32_t>();
+  auto moyVector = children[4]->asFlatVector<int32_t>();
+  auto domVector = children[5]->asFlatVector<int32_t>();
+  auto qoyVector = children[6]->asFlatVector<int32_t>();
+  auto dayNameVector = children[7]->asFlatVector<StringView>();
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const int32_t date = kFirstDate + i + offset;
+    std::tm tm;
+    VELOX_CHECK(Timestamp::epochToCalendarUtc(date * 86'400LL, tm));
+    const auto year = tm.tm_year + 1900;
+    const auto month = tm.tm_mon + 1;
+
+    dateSkVector->set(i, kFirstDateSk + i + offset);
+    dateVector->set(i, date);
+    monthSeqVector->set(i, (year - 1900) * 12 + month - 1);
+    yearVector->set(i, year);
+    moyVector->set(i, month);
+    domVector->set(i, tm.tm_mday);
+    qoyVector->set(i, (month - 1) / 3 + 1);
+    dayNameVector->set(i, StringView(kDayNames[tm.tm_wday]));
+  }
+  return std::make_shared<RowVector>(
+      pool,
+      dateDimRowType,
+      BufferPtr(nullptr),
+      vectorSize,
+      std::move(children));
+}
+
+RowVectorPtr genTpcdsItem(
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  // Create schema and allocate vectors.
+  auto itemRowType = getTableSchema(Table::TBL_ITEM);
+  size_t vectorSize = getVectorSize(
+      getRowCount(Table::TBL_ITEM, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(itemRowType, vectorSize, pool);
+
+  auto itemSkVector = children[0]->asFlatVector<int64_t>();
+  auto itemIdVector = children[1]->asFlatVector<StringView>();
+  auto descVector = children[2]->asFlatVector<StringView>();
+  auto priceVector = children[3]->asFlatVector<double>();
+  auto brandIdVector = children[4]->asFlatVector<int32_t>();
+  auto brandVector = children[5]->asFlatVector<StringView>();
+  auto classIdVector = children[6]->asFlatVector<int32_t>();
+  auto classVector = children[7]->asFlatVector<StringView>();
+  auto categoryIdVector = children[8]->asFlatVector<int32_t>();
+  auto categoryVector = children[9]->asFlatVector<StringView>();
+  auto manufactIdVector = children[10]->asFlatVector<int32_t>();
+  auto productNameVector = children[11]->asFlatVector<StringView>();
+
+  constexpr auto kTable = Table::TBL_ITEM;
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const uint64_t row = i + offset;
+    const int64_t itemSk = row + 1;
+    const auto categoryId = randomInt(kTable, 8, row, 1, kCategories.size());
+    const auto classId = randomInt(kTable, 6, row, 1, kClassesPerCategory);
+    const auto brandNumber = randomInt(kTable, 4, row, 1, kBrandsPerClass);
+
+    // Two versions of each item share the business key.
+    const auto itemId = makeBusinessKey((itemSk + 1) / 2);
+    const auto desc = fmt::format(
+        "{} {} {}",
+        kWords[randomInt(kTable, 2, row, 0, kWords.size() - 1)],
+        kWords[randomInt(kTable, 2, row + 1, 0, kWords.size() - 1)],
+        kClasses[categoryId - 1][classId - 1]);
+    const auto brand = fmt::format(
+        "{}{} #{}",
+        kBrandPrefixes[categoryId - 1],
+        kBrandSuffixes[classId - 1],
+        brandNumber);
+    const auto productName = makeWord(itemSk);
+
+    itemSkVector->set(i, itemSk);
+    itemIdVector->set(i, StringView(itemId));
+    descVector->set(i, StringView(desc));
+    priceVector->set(i, randomInt(kTable, 3, row, 9, 9'999) / 100.0);
+    brandIdVector->set(
+        i, categoryId * 1'000'000 + classId * 1'000 + brandNumber);
+    brandVector->set(i, StringView(brand));
+    classIdVector->set(i, classId);
+    classVector->set(i, StringView(kClasses[categoryId - 1][classId - 1]));
+    categoryIdVector->set(i, categoryId);
+    categoryVector->set(i, StringView(kCategories[categoryId - 1]));
+    manufactIdVector->set(i, randomInt(kTable, 10, row, 1, 1'000));
+    productNameVector->set(i, StringView(productName));
+  }
+  return std::make_shared<RowVector>(
+      pool, itemRowType, BufferPtr(nullptr), vectorSize, std::move(children));
+}
+
+RowVectorPtr genTpcdsStore(
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  // Create schema and allocate vectors.
+  auto storeRowType = getTableSchema(Table::TBL_STORE);
+  size_t vectorSize = getVectorSize(
+      getRowCount(Table::TBL_STORE, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(storeRowType, vectorSize, pool);
+
+  auto storeSkVector = children[0]->asFlatVector<int64_t>();
+  auto storeIdVector = children[1]->asFlatVector<StringView>();
+  auto nameVector = children[2]->asFlatVector<StringView>();
+  auto stateVector = children[3]->asFlatVector<StringView>();
+
+  constexpr auto kTable = Table::TBL_STORE;
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const uint64_t row = i + offset;
+    const auto storeId = makeBusinessKey(row + 1);
+    storeSkVector->set(i, row + 1);
+    storeIdVector->set(i, StringView(storeId));
+    nameVector->set(
+        i,
+        StringView(
+            kSyllables[randomInt(kTable, 2, row, 0, kSyllables.size() - 1)]));
+    stateVector->set(
+        i,
+        StringView(kStates[randomInt(kTable, 3, row, 0, kStates.size() - 1)]));
+  }
+  return std::make_shared<RowVector>(
+      pool, storeRowType, BufferPtr(nullptr), vectorSize, std::move(children));
+}
+
+RowVectorPtr genTpcdsCustomerDemographics(
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  // Create schema and allocate vectors.
+  auto demographicsRowType = getTableSchema(Table::TBL_CUSTOMER_DEMOGRAPHICS);
+  size_t vectorSize = getVectorSize(
+      getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, scaleFactor),
+      maxRows,
+      offset);
+  auto children = allocateVectors(demographicsRowType, vectorSize, pool);
+
+  auto demoSkVector = children[0]->asFlatVector<int64_t>();
+  auto genderVector = children[1]->asFlatVector<StringView>();
+  auto maritalStatusVector = children[2]->asFlatVector<StringView>();
+  auto educationStatusVector = children[3]->asFlatVector<StringView>();
+  auto purchaseEstimateVector = children[4]->asFlatVector<int32_t>();
+  auto creditRatingVector = children[5]->asFlatVector<StringView>();
+  auto depCountVector = children[6]->asFlatVector<int32_t>();
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    // The row number in the cross product of the column domains, the first
+    // column varying the fastest.
+    uint64_t row = i + offset;
+    demoSkVector->set(i, row + 1);
+    genderVector->set(i, StringView(kGenders[row % kGenders.size()]));
+    row /= kGenders.size();
+    maritalStatusVector->set(
+        i, StringView(kMaritalStatuses[row % kMaritalStatuses.size()]));
+    row /= kMaritalStatuses.size();
+    educationStatusVector->set(
+        i, StringView(kEducationStatuses[row % kEducationStatuses.size()]));
+    row /= kEducationStatuses.size();
+    purchaseEstimateVector->set(i, (row % kNumPurchaseEstimates + 1) * 500);
+    row /= kNumPurchaseEstimates;
+    creditRatingVector->set(
+        i, StringView(kCreditRatings[row % kCreditRatings.size()]));
+    row /= kCreditRatings.size();
+    depCountVector->set(i, row % kNumDepCounts);
+  }
+  return std::make_shared<RowVector>(
+      pool,
+      demographicsRowType,
+      BufferPtr(nullptr),
+      vectorSize,
+      std::move(children));
+}
+
+RowVectorPtr genTpcdsStoreSales(
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  // Create schema and allocate vectors.
+  auto storeSalesRowType = getTableSchema(Table::TBL_STORE_SALES);
+  size_t vectorSize = getVectorSize(
+      getRowCount(Table::TBL_STORE_SALES, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(storeSalesRowType, vectorSize, pool);
+
+  auto soldDateSkVector = children[0]->asFlatVector<int64_t>();
+  auto itemSkVector = children[1]->asFlatVector<int64_t>();
+  auto cdemoSkVector = children[2]->asFlatVector<int64_t>();
+  auto storeSkVector = children[3]->asFlatVector<int64_t>();
+  auto ticketNumberVector = children[4]->asFlatVector<int64_t>();
+  auto quantityVector = children[5]->asFlatVector<int32_t>();
+  auto listPriceVector = children[6]->asFlatVector<double>();
+  auto salesPriceVector = children[7]->asFlatVector<double>();
+  auto extSalesPriceVector = children[8]->asFlatVector<double>();
+  auto couponAmtVector = children[9]->asFlatVector<double>();
+  auto netProfitVector = children[10]->asFlatVector<double>();
+
+  const int64_t numItems = getRowCount(Table::TBL_ITEM, scaleFactor);
+  const int64_t numStores = getRowCount(Table::TBL_STORE, scaleFactor);
+  constexpr auto kTable = Table::TBL_STORE_SALES;
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const uint64_t row = i + offset;
+    // The columns of the ticket are a function of the ticket number.
+    const uint64_t ticketNumber = row / kLinesPerTicket + 1;
+    soldDateSkVector->set(
+        i,
+        randomInt(
+            kTable, 0, ticketNumber, kFirstSalesDateSk, kLastSalesDateSk));
+    itemSkVector->set(i, randomInt(kTable, 1, row, 1, numItems));
+    cdemoSkVector->set(
+        i,
+        randomInt(kTable, 2, ticketNumber, 1, kCustomerDemographicsRowCount));
+    storeSkVector->set(i, randomInt(kTable, 3, ticketNumber, 1, numStores));
+    ticketNumberVector->set(i, ticketNumber);
+
+    const auto quantity = randomInt(kTable, 5, row, 1, 100);
+    const auto wholesaleCost = randomInt(kTable, 6, row, 100, 10'000) / 100.0;
+    const auto listPrice = roundToCents(
+        wholesaleCost * (1 + randomInt(kTable, 6, row + 1, 0, 200) / 100.0));
+    const auto salesPrice = roundToCents(
+        listPrice * (1 - randomInt(kTable, 7, row, 0, 100) / 100.0));
+    const auto extSalesPrice = roundToCents(salesPrice * quantity);
+    // One in five sales uses a coupon.
+    const auto couponAmt = random(kTable, 9, row) % 5 == 0
+        ? roundToCents(
+              extSalesPrice * randomInt(kTable, 9, row + 1, 0, 100) / 100.0)
+        : 0.0;
+    quantityVector->set(i, quantity);
+    listPriceVector->set(i, listPrice);
+    salesPriceVector->set(i, salesPrice);
+    extSalesPriceVector->set(i, extSalesPrice);
+    couponAmtVector->set(i, couponAmt);
+    netProfitVector->set(
+        i, roundToCents(extSalesPrice - couponAmt - wholesaleCost * quantity));
+  }
+  return std::make_shared<RowVector>(
+      pool,
+      storeSalesRowType,
+      BufferPtr(nullptr),
+      vectorSize,
+      std::move(children));
+}
+
+} // namespace facebook::velox::tpcds
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/memory/Memory.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::tpcds {
+
+/// This file generates TPC-DS data encoded using Velox Vectors.
+///
+/// The API follows the TPC-H generator in velox/tpch/gen: the input is the
+/// TPC-DS table name (the Table enum), the scale factor, the maximum batch
+/// size, and the offset. Successive calls advance the offset until all
+/// records were read, and different slices of the range
+/// "[0, getRowCount(Table, scaleFactor)[" can be generated by different
+/// threads.
+///
+/// The generator covers the tables and columns used by star joins over
+/// store_sales. It is not a port of dsdgen and does not reproduce its values.
+/// Each value is a deterministic function of the table, column and row
+/// number drawn from the domains of the TPC-DS spec, available at:
+///
+///  https://www.tpc.org/tpcds/
+///
+/// Row counts follow the spec, and so do the key relationships and the
+/// cardinalities of the attributes that queries group by, which are what
+/// drive the joins, aggregations and window functions of the benchmark
+/// queries. Decimal columns are generated as DOUBLE, like in the TPC-H
+/// generator.
+///
+/// Data is always returned in a RowVector.
+
+enum class Table : uint8_t {
+  TBL_DATE_DIM,
+  TBL_ITEM,
+  TBL_STORE,
+  TBL_CUSTOMER_DEMOGRAPHICS,
+  TBL_STORE_SALES,
+};
+
+static constexpr auto tables = {
+    tpcds::Table::TBL_DATE_DIM,
+    tpcds::Table::TBL_ITEM,
+    tpcds::Table::TBL_STORE,
+    tpcds::Table::TBL_CUSTOMER_DEMOGRAPHICS,
+    tpcds::Table::TBL_STORE_SALES};
+
+/// Returns table name as a string.
+std::string_view toTableName(Table table);
+
+/// Returns the table enum value given a table name.
+Table fromTableName(std::string_view tableName);
+
+/// Returns the row count for a particular TPC-DS table given a scale factor.
+/// The counts of the spec are used for the scale factors it defines. The
+/// dimensions that grow sublinearly are interpolated between these.
+size_t getRowCount(Table table, double scaleFactor);
+
+/// Returns the schema (RowType) for a particular TPC-DS table.
+RowTypePtr getTableSchema(Table table);
+
+/// Returns the type of a particular table:column pair. Throws if `columnName`
+/// does not exist in `table`.
+TypePtr resolveTpcdsColumn(Table table, const std::string& columnName);
+
+/// Returns a row vector containing at most `maxRows` rows of the "date_dim"
+/// table, starting at `offset`. The table has one row per day from
+/// 1900-01-02 and does not depend on the scale factor. The row vector
+/// returned has the following schema:
+///
+///  d_date_sk: BIGINT
+///  d_date: DATE
+///  d_month_seq: INTEGER
+///  d_year: INTEGER
+///  d_moy: INTEGER
+///  d_dom: INTEGER
+///  d_qoy: INTEGER
+///  d_day_name: VARCHAR
+///
+RowVectorPtr genTpcdsDateDim(
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+/// Returns a row vector containing at most `maxRows` rows of the "item"
+/// table, starting at `offset`, and given the scale factor. Like in the spec,
+/// item is a slowly changing dimension: two consecutive rows share an
+/// i_item_id. The row vector returned has the following schema:
+///
+///  i_item_sk: BIGINT
+///  i_item_id: VARCHAR
+///  i_item_desc: VARCHAR
+///  i_current_price: DOUBLE
+///  i_brand_id: INTEGER
+///  i_brand: VARCHAR
+///  i_class_id: INTEGER
+///  i_class: VARCHAR
+///  i_category_id: INTEGER
+///  i_category: VARCHAR
+///  i_manufact_id: INTEGER
+///  i_product_name: VARCHAR
+///
+RowVectorPtr genTpcdsItem(
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+/// Returns a row vector containing at most `maxRows` rows of the "store"
+/// table, starting at `offset`, and given the scale factor. The row vector
+/// returned has the following schema:
+///
+///  s_store_sk: BIGINT
+///  s_store_id: VARCHAR
+///  s_store_name: VARCHAR
+///  s_state: VARCHAR
+///
+RowVectorPtr genTpcdsStore(
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+/// Returns a row vector containing at most `maxRows` rows of the
+/// "customer_demographics" table, starting at `offset`. Like in the spec, the
+/// table is the cross product of the domains of its columns and does not
+/// depend on the scale factor. The row vector returned has the following
+/// schema:
+///
+///  cd_demo_sk: BIGINT
+///  cd_gender: VARCHAR
+///  cd_marital_status: VARCHAR
+///  cd_education_status: VARCHAR
+///  cd_purchase_estimate: INTEGER
+///  cd_credit_rating: VARCHAR
+///  cd_dep_count: INTEGER
+///
+RowVectorPtr genTpcdsCustomerDemographics(
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+/// Returns a row vector containing at most `maxRows` rows of the
+/// "store_sales" table, starting at `offset`, and given the scale factor.
+/// Sales are grouped in tickets of consecutive rows that share the date, the
+/// store and the customer demographics. Sale dates are between 1998-01-02 and
+/// 2003-01-02. The row vector returned has the following schema:
+///
+///  ss_sold_date_sk: BIGINT
+///  ss_item_sk: BIGINT
+///  ss_cdemo_sk: BIGINT
+///  ss_store_sk: BIGINT
+///  ss_ticket_number: BIGINT
+///  ss_quantity: INTEGER
+///  ss_list_price: DOUBLE
+///  ss_sales_price: DOUBLE
+///  ss_ext_sales_price: DOUBLE
+///  ss_coupon_amt: DOUBLE
+///  ss_net_profit: DOUBLE
+///
+RowVectorPtr genTpcdsStoreSales(
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+} // namespace facebook::velox::tpcds
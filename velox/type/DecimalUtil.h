@@ -351,6 +351,44 @@ class DecimalUtil {
     return overflow;
   }
 
+  /// Adds 'numValues' 'values' to 'result' and returns the overflow like
+  /// addWithOverflow. The upper and lower 64 bits of the values are summed
+  /// separately into 128-bit sums that cannot overflow for less than 2^63
+  /// values, so that the loop has no branches and the overflow is found once
+  /// at the end instead of once per value.
+  template <typename T>
+  inline static int64_t
+  sumWithOverflow(int128_t& result, const T* values, int32_t numValues) {
+    if constexpr (std::is_same_v<T, int64_t>) {
+      int128_t sum = 0;
+      for (auto i = 0; i < numValues; ++i) {
+        sum += values[i];
+      }
+      return addWithOverflow(result, result, sum);
+    } else {
+      static_assert(std::is_same_v<T, int128_t>);
+      int128_t upperSum = 0;
+      __uint128_t lowerSum = 0;
+      for (auto i = 0; i < numValues; ++i) {
+        upperSum += static_cast<int64_t>(values[i] >> 64);
+        lowerSum += static_cast<uint64_t>(values[i]);
+      }
+      // The total is upper * 2^64 + the lower 64 bits of 'lowerSum'. This is
+      // overflow * 2^127 + sum with 0 <= sum < 2^127.
+      const int128_t upper = upperSum + static_cast<int128_t>(lowerSum >> 64);
+      auto overflow = static_cast<int64_t>(upper >> 63);
+      int128_t sum = (upper & std::numeric_limits<int64_t>::max()) << 64 |
+          static_cast<uint64_t>(lowerSum);
+      if (overflow < 0 && sum != 0) {
+        // Moves one 2^127 from the overflow to the sum so that a negative
+        // total has no overflow if it fits, like with addWithOverflow.
+        sum = static_cast<int128_t>(sum | kOverflowMultiplier);
+        ++overflow;
+      }
+      return overflow + addWithOverflow(result, result, sum);
+    }
+  }
+
   /// Corrects the sum result calculated using addWithOverflow. Since the sum
   /// calculated by addWithOverflow only retains the lower 127 bits,
   /// it may miss one calculation of +(1 << 127) or -(1 << 127).
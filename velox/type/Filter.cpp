@@ -21,6 +21,7 @@
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +95,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +135,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -190,6 +196,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -489,6 +497,59 @@ bool NegatedBigintValuesUsingBitmask::testingEquals(const Filter& other) const {
       nonNegated_->testingEquals(*(otherNegatedBigintValues->nonNegated_));
 }
 
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  obj["bloomFilter"] = encoding::Base64::encode(bits);
+  if (conjunct_) {
+    obj["conjunct"] = conjunct_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto bits = encoding::Base64::decode(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(bits.data());
+  std::shared_ptr<const Filter> conjunct;
+  if (obj.count("conjunct")) {
+    conjunct = ISerializable::deserialize<Filter>(obj["conjunct"]);
+  }
+
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed, std::move(conjunct));
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloom = dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  if (otherBloom == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloom->min_ || max_ != otherBloom->max_) {
+    return false;
+  }
+  if ((conjunct_ == nullptr) != (otherBloom->conjunct_ == nullptr) ||
+      (conjunct_ && !conjunct_->testingEquals(*otherBloom->conjunct_))) {
+    return false;
+  }
+  if (bloomFilter_ == otherBloom->bloomFilter_) {
+    return true;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloom->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string bits(size, '\0');
+  std::string otherBits(size, '\0');
+  bloomFilter_->serialize(bits.data());
+  otherBloom->bloomFilter_->serialize(otherBits.data());
+  return bits == otherBits;
+}
+
 template <>
 folly::dynamic FloatingPointRange<float>::serialize() const {
   auto obj = AbstractRange::serializeBase("FloatRange");
@@ -807,6 +868,40 @@ bool BigintValuesUsingBitmask::testInt64Range(
   return !(min > max_ || max < min_);
 }
 
+BigintValuesUsingBloomFilter::BigintValuesUsingBloomFilter(
+    int64_t min,
+    int64_t max,
+    std::shared_ptr<const BloomFilter<>> bloomFilter,
+    bool nullAllowed,
+    std::shared_ptr<const Filter> conjunct)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)),
+      conjunct_(std::move(conjunct)) {
+  VELOX_CHECK_LE(min_, max_, "min must be less than or equal to max");
+  VELOX_CHECK_NOT_NULL(bloomFilter_);
+  VELOX_CHECK(bloomFilter_->isSet(), "Bloom filter must be initialized");
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  if (min > max_ || max < min_) {
+    return false;
+  }
+  return !conjunct_ || conjunct_->testInt64Range(min, max, false);
+}
+
 BigintValuesUsingHashTable::BigintValuesUsingHashTable(
     int64_t min,
     int64_t max,
@@ -846,6 +941,14 @@ BigintValuesUsingHashTable::BigintValuesUsingHashTable(
   for (auto i = 0; i < kPaddingElements; ++i) {
     hashTable_[sizeMask_ + 1 + i] = hashTable_[sizeMask_];
   }
+  if (size >= kMinSizeForHomeBits) {
+    homeBits_.resize(bits::nwords(size));
+    for (auto value : values) {
+      if (value != kEmptyMarker) {
+        bits::setBit(homeBits_.data(), (value * M) & sizeMask_);
+      }
+    }
+  }
   std::sort(values_.begin(), values_.end());
 }
 
@@ -857,6 +960,9 @@ bool BigintValuesUsingHashTable::testInt64(int64_t value) const {
     return false;
   }
   uint32_t pos = (value * M) & sizeMask_;
+  if (!homeBits_.empty() && !bits::isBitSet(homeBits_.data(), pos)) {
+    return false;
+  }
   for (auto i = pos; i <= pos + sizeMask_; i++) {
     int32_t idx = i & sizeMask_;
     int64_t l = hashTable_[idx];
@@ -884,12 +990,27 @@ xsimd::batch_bool<int64_t> BigintValuesUsingHashTable::testValues(
   // Temporarily casted to unsigned to suppress overflow error.
   auto indices = simd::reinterpretBatch<int64_t>(
       simd::reinterpretBatch<uint64_t>(x) * M & sizeMask_);
+  auto candidates = ~outOfRange;
+  if (!homeBits_.empty()) {
+    // Drops the lanes whose first probe is not the first probe of any value.
+    auto words = simd::reinterpretBatch<uint64_t>(simd::maskGather(
+        xsimd::broadcast<int64_t>(0),
+        candidates,
+        reinterpret_cast<const int64_t*>(homeBits_.data()),
+        indices >> 6));
+    auto homeBits = simd::reinterpretBatch<int64_t>(
+        (words >> simd::reinterpretBatch<uint64_t>(indices & 63)) & 1);
+    candidates = candidates & (homeBits != xsimd::broadcast<int64_t>(0));
+    if (simd::toBitMask(candidates) == 0) {
+      return xsimd::batch_bool<int64_t>(false);
+    }
+  }
   auto data =
-      simd::maskGather(allEmpty, ~outOfRange, hashTable_.data(), indices);
+      simd::maskGather(allEmpty, candidates, hashTable_.data(), indices);
   // The lanes with kEmptyMarker missed, the lanes matching x hit and the other
   // lanes must check next positions.
 
-  auto result = x == data;
+  auto result = (x == data) & candidates;
   auto resultBits = simd::toBitMask(result);
   auto missed = simd::toBitMask(data == allEmpty);
   static_assert(decltype(result)::size <= 16);
@@ -1840,6 +1961,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
@@ -1970,6 +2092,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     }
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kNegatedBigintValuesUsingHashTable:
     case FilterKind::kNegatedBigintValuesUsingBitmask: {
@@ -2051,7 +2174,8 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     }
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kNegatedBigintValuesUsingBitmask:
-    case FilterKind::kNegatedBigintValuesUsingHashTable: {
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return mergeWith(min_, max_, other);
     }
     default:
@@ -2144,7 +2268,8 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     }
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kNegatedBigintValuesUsingBitmask:
-    case FilterKind::kNegatedBigintValuesUsingHashTable: {
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return mergeWith(min_, max_, other);
     }
     default:
@@ -2167,6 +2292,63 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this, false);
+    case FilterKind::kBigintRange: {
+      auto otherRange = static_cast<const BigintRange*>(other);
+      return mergeWith(
+          std::max(min_, otherRange->lower()),
+          std::min(max_, otherRange->upper()),
+          other,
+          conjunct_);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask:
+      return other->mergeWith(this);
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      // The Bloom filter of 'other' becomes part of the conjunct.
+      auto otherBloom = static_cast<const BigintValuesUsingBloomFilter*>(other);
+      return mergeWith(
+          std::max(min_, otherBloom->min_),
+          std::min(max_, otherBloom->max_),
+          other,
+          conjunct_ ? conjunct_->mergeWith(other) : other->clone());
+    }
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kBigintMultiRange:
+      // There is no exact combination. Values must pass both filters.
+      return mergeWith(
+          min_,
+          max_,
+          other,
+          conjunct_ ? conjunct_->mergeWith(other) : other->clone());
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    int64_t min,
+    int64_t max,
+    const Filter* other,
+    std::shared_ptr<const Filter> conjunct) const {
+  bool bothNullAllowed = nullAllowed_ && other->testNull();
+  if (max < min) {
+    return nullOrFalse(bothNullAllowed);
+  }
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, bloomFilter_, bothNullAllowed, std::move(conjunct));
+}
+
 std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     const Filter* other) const {
   // Rules of NegatedBigintValuesUsingHashTable with IsNull/IsNotNull
@@ -2187,7 +2369,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintRange:
-    case FilterKind::kBigintMultiRange: {
+    case FilterKind::kBigintMultiRange:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return other->mergeWith(this);
     }
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
@@ -2227,7 +2410,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintRange:
     case FilterKind::kNegatedBigintRange:
-    case FilterKind::kBigintMultiRange: {
+    case FilterKind::kBigintMultiRange:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return other->mergeWith(this);
     }
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
@@ -2267,7 +2451,8 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kBigintRange:
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintValuesUsingBitmask:
-    case FilterKind::kBigintValuesUsingHashTable: {
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return other->mergeWith(this);
     }
     case FilterKind::kBigintMultiRange: {
@@ -24,7 +24,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -925,7 +928,8 @@ class BigintValuesUsingHashTable final : public Filter {
         hashTable_(other.hashTable_),
         containsEmptyMarker_(other.containsEmptyMarker_),
         values_(other.values_),
-        sizeMask_(other.sizeMask_) {}
+        sizeMask_(other.sizeMask_),
+        homeBits_(other.homeBits_) {}
 
   folly::dynamic serialize() const override;
 
@@ -984,6 +988,8 @@ class BigintValuesUsingHashTable final : public Filter {
   static constexpr int64_t kEmptyMarker = 0xdeadbeefbadefeedL;
   // from Murmur hash
   static constexpr uint64_t M = 0xc6a4a7935bd1e995L;
+  // Hash tables with at least this many slots, i.e. 32KB, get 'homeBits_'.
+  static constexpr int32_t kMinSizeForHomeBits = 1 << 12;
 
   const int64_t min_;
   const int64_t max_;
@@ -991,6 +997,10 @@ class BigintValuesUsingHashTable final : public Filter {
   bool containsEmptyMarker_ = false;
   std::vector<int64_t> values_;
   int32_t sizeMask_;
+  // One bit per slot of 'hashTable_', set if the slot is the first probe of a
+  // value. Lets large IN-lists reject most misses from a bitmap 64x smaller
+  // than the table before touching the table. Empty for small tables.
+  std::vector<uint64_t> homeBits_;
 };
 
 /// IN-list filter for int128_t data type, implemented as a hash table.
@@ -1090,6 +1100,102 @@ class BigintValuesUsingBitmask final : public Filter {
   const int64_t max_;
 };
 
+/// IN-list filter for integral data types with false positives. Values are
+/// tested against a Bloom filter of their folly::hasher<int64_t> hashes and
+/// against the range of the values. Made from a hash join build side when the
+/// keys are too many or too spread out for an exact IN-list. Since the filter
+/// may pass values that are not in the list, it must only be used where
+/// passing extra rows is harmless, e.g. as a dynamic filter in front of the
+/// join that made it. Merging with a filter that cannot be combined exactly,
+/// e.g. a NOT IN-list or another Bloom filter, keeps that filter as a
+/// conjunct that values must pass as well.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter of the hashes of the values.
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param conjunct Optional filter that non-null values must pass too.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed,
+      std::shared_ptr<const Filter> conjunct = nullptr);
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_),
+        conjunct_(other.conjunct_) {}
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<BigintValuesUsingBloomFilter>(
+        *this, nullAllowed.value_or(nullAllowed_));
+  }
+
+  static uint64_t hash(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  bool testInt64(int64_t value) const final {
+    return value >= min_ && value <= max_ &&
+        bloomFilter_->mayContain(hash(value)) &&
+        (!conjunct_ || conjunct_->testInt64(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  /// Returns the filter that values must pass in addition to the Bloom
+  /// filter or nullptr if there is none.
+  const std::shared_ptr<const Filter>& conjunct() const {
+    return conjunct_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {}{}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls",
+        conjunct_ ? " AND " + conjunct_->toString() : "");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  std::unique_ptr<Filter> mergeWith(
+      int64_t min,
+      int64_t max,
+      const Filter* other,
+      std::shared_ptr<const Filter> conjunct) const;
+
+  const int64_t min_;
+  const int64_t max_;
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+  // Filter that values must pass in addition to 'bloomFilter_'. Set when
+  // merging with a filter that has no exact combination with this one.
+  const std::shared_ptr<const Filter> conjunct_;
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -1871,6 +1977,18 @@ class BytesValues final : public Filter {
 
     lower_ = *std::min_element(values_.begin(), values_.end());
     upper_ = *std::max_element(values_.begin(), values_.end());
+
+    if (values_.size() >= kMinValuesForHashBits) {
+      const auto numBits =
+          bits::nextPowerOfTwo(values_.size() * kHashBitsPerValue);
+      hashBits_.resize(bits::nwords(numBits));
+      hashMask_ = numBits - 1;
+      for (const auto& value : values_) {
+        bits::setBit(
+            hashBits_.data(),
+            quickHash(value.data(), value.size()) & hashMask_);
+      }
+    }
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
@@ -1878,7 +1996,9 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        hashBits_(other.hashBits_),
+        hashMask_(other.hashMask_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1898,8 +2018,19 @@ class BytesValues final : public Filter {
   }
 
   bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+    if (!lengths_.contains(length)) {
+      return false;
+    }
+    if (!hashBits_.empty() && !isHashBitSet(value, length)) {
+      return false;
+    }
+    return values_.contains(std::string_view(value, length));
+  }
+
+  /// Returns false if 'value' is rejected by the bitmap in front of the hash
+  /// set. Always true for small lists, which have no bitmap. Used in tests.
+  bool testingHashBitSet(std::string_view value) const {
+    return hashBits_.empty() || isHashBitSet(value.data(), value.size());
   }
 
   bool testBytesRange(
@@ -1916,10 +2047,36 @@ class BytesValues final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Lists with at least this many values get 'hashBits_'.
+  static constexpr int32_t kMinValuesForHashBits = 64;
+  static constexpr int32_t kHashBitsPerValue = 8;
+
+  // Hashes the length and the first and last 8 bytes of a value. Values that
+  // share a prefix and a length, e.g. zero-padded keys, usually differ in
+  // their last bytes.
+  static uint64_t quickHash(const char* value, int32_t length) {
+    uint64_t prefix = 0;
+    uint64_t suffix = 0;
+    const auto numBytes = std::min<int32_t>(length, sizeof(prefix));
+    memcpy(&prefix, value, numBytes);
+    memcpy(&suffix, value + length - numBytes, numBytes);
+    return folly::hash::hash_128_to_64(
+        folly::hash::hash_128_to_64(prefix, length), suffix);
+  }
+
+  bool isHashBitSet(const char* value, int32_t length) const {
+    return bits::isBitSet(
+        hashBits_.data(), quickHash(value, length) & hashMask_);
+  }
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+  // Bitmap of the quickHash() of 'values_'. Rejects most misses of large
+  // IN-lists without hashing the whole value. Empty for small lists.
+  std::vector<uint64_t> hashBits_;
+  uint64_t hashMask_{0};
 };
 
 /// Represents a combination of two of more range filters on integral types with
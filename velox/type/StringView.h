@@ -153,6 +153,22 @@ struct StringView {
     return !(*this == other);
   }
 
+  /// Compares the first kPrefixSize bytes of 'this' and 'other' as unsigned
+  /// bytes, padding strings shorter than the prefix with zeros. Returns 0 if
+  /// the prefixes are equal, in which case the strings may still differ. Does
+  /// not access the data of out of line strings.
+  int32_t comparePrefix(const StringView& other) const {
+    if (prefixAsInt() == other.prefixAsInt()) {
+      return 0;
+    }
+    // The prefix is a little endian integer. Swapping its bytes orders it
+    // like memcmp.
+    return __builtin_bswap32(prefixAsInt()) <
+            __builtin_bswap32(other.prefixAsInt())
+        ? -1
+        : 1;
+  }
+
   // Returns 0, if this == other
   //       < 0, if this < other
   //       > 0, if this > other
@@ -145,6 +145,34 @@ void Timestamp::toTimezone(int16_t tzID) {
   }
 }
 
+namespace {
+// The largest change of the offset of a zone at a transition is a day, e.g.
+// Pacific/Apia in 2011. Local times closer than this to a transition may be
+// ambiguous or not exist, so they are not resolved from the cached interval.
+constexpr int64_t kMaxTransitionSeconds = 2 * 24 * 60 * 60;
+} // namespace
+
+void TimeZoneOffsetCache::toTimezoneSlow(Timestamp& timestamp) {
+  const auto seconds = timestamp.getSeconds();
+  timestamp.toTimezone(*zone_);
+  const auto info =
+      zone_->get_info(date::sys_seconds(std::chrono::seconds(seconds)));
+  gmtBegin_ = info.begin.time_since_epoch().count();
+  gmtEnd_ = info.end.time_since_epoch().count();
+  gmtOffset_ = info.offset.count();
+}
+
+void TimeZoneOffsetCache::toGMTSlow(Timestamp& timestamp) {
+  timestamp.toGMT(*zone_);
+  const auto info = zone_->get_info(
+      date::sys_seconds(std::chrono::seconds(timestamp.getSeconds())));
+  const auto begin = info.begin.time_since_epoch().count();
+  const auto end = info.end.time_since_epoch().count();
+  localOffset_ = info.offset.count();
+  localBegin_ = begin + localOffset_ + kMaxTransitionSeconds;
+  localEnd_ = end + localOffset_ - kMaxTransitionSeconds;
+}
+
 const date::time_zone& Timestamp::defaultTimezone() {
   static const date::time_zone* kDefault = ({
     // TODO: We are hard-coding PST/PDT here to be aligned with the current
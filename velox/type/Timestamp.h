@@ -431,6 +431,63 @@ struct Timestamp {
   uint64_t nanos_;
 };
 
+/// Converts timestamps between GMT and the time at one zone like
+/// Timestamp::toTimezone() and Timestamp::toGMT(), but remembers the
+/// interval between two transitions of the zone that the last converted
+/// timestamp fell in, together with the offset of the zone in that interval.
+/// Timestamps in the same interval, e.g. the timestamps of a batch that are
+/// not years apart, are converted by adding or subtracting the offset
+/// without looking up the zone. Not thread-safe. A cache without a zone
+/// leaves the timestamps unchanged.
+class TimeZoneOffsetCache {
+ public:
+  explicit TimeZoneOffsetCache(const date::time_zone* zone = nullptr)
+      : zone_(zone) {}
+
+  const date::time_zone* zone() const {
+    return zone_;
+  }
+
+  /// Same as timestamp.toTimezone(*zone()).
+  void toTimezone(Timestamp& timestamp) {
+    const auto seconds = timestamp.getSeconds();
+    if (seconds >= gmtBegin_ && seconds < gmtEnd_) {
+      timestamp = Timestamp(seconds + gmtOffset_, timestamp.getNanos());
+    } else if (zone_ != nullptr) {
+      toTimezoneSlow(timestamp);
+    }
+  }
+
+  /// Same as timestamp.toGMT(*zone()).
+  void toGMT(Timestamp& timestamp) {
+    const auto seconds = timestamp.getSeconds();
+    if (seconds >= localBegin_ && seconds < localEnd_) {
+      timestamp = Timestamp(seconds - localOffset_, timestamp.getNanos());
+    } else if (zone_ != nullptr) {
+      toGMTSlow(timestamp);
+    }
+  }
+
+ private:
+  // Converts with 'zone_' and remembers the interval of the result.
+  void toTimezoneSlow(Timestamp& timestamp);
+  void toGMTSlow(Timestamp& timestamp);
+
+  const date::time_zone* zone_;
+
+  // The GMT seconds [gmtBegin_, gmtEnd_) that are at 'gmtOffset_' seconds
+  // from the time at 'zone_'. Empty until the first lookup.
+  int64_t gmtBegin_{0};
+  int64_t gmtEnd_{0};
+  int64_t gmtOffset_{0};
+
+  // The local seconds [localBegin_, localEnd_) that are each the time at
+  // 'zone_' of exactly one GMT time, 'localOffset_' seconds before it.
+  int64_t localBegin_{0};
+  int64_t localEnd_{0};
+  int64_t localOffset_{0};
+};
+
 void parseTo(folly::StringPiece in, ::facebook::velox::Timestamp& out);
 
 template <typename T>
@@ -342,6 +342,58 @@ TEST(DecimalAggregateTest, adjustSumForOverflow) {
   EXPECT_FALSE(accumulator.adjustedSum().has_value());
 }
 
+TEST(DecimalTest, sumWithOverflow) {
+  auto test = [](const std::vector<int128_t>& values) {
+    SCOPED_TRACE(fmt::format("{} values", values.size()));
+    int128_t expectedSum = 0;
+    int64_t expectedOverflow = 0;
+    for (auto value : values) {
+      expectedOverflow +=
+          DecimalUtil::addWithOverflow(expectedSum, expectedSum, value);
+    }
+    int128_t sum = 0;
+    const auto overflow =
+        DecimalUtil::sumWithOverflow(sum, values.data(), values.size());
+    EXPECT_EQ(
+        DecimalUtil::adjustSumForOverflow(sum, overflow),
+        DecimalUtil::adjustSumForOverflow(expectedSum, expectedOverflow));
+    int128_t avg;
+    int128_t expectedAvg;
+    DecimalUtil::computeAverage(avg, sum, values.size(), overflow);
+    DecimalUtil::computeAverage(
+        expectedAvg, expectedSum, values.size(), expectedOverflow);
+    EXPECT_EQ(avg, expectedAvg);
+  };
+
+  test({1, -2, 3});
+  test({-1, -2, -3});
+  test({DecimalUtil::kLongDecimalMax, DecimalUtil::kLongDecimalMax});
+  test({DecimalUtil::kLongDecimalMin, DecimalUtil::kLongDecimalMin});
+  // The running sum overflows in both directions but the total fits.
+  test(
+      {DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMin,
+       DecimalUtil::kLongDecimalMin,
+       DecimalUtil::kLongDecimalMin,
+       -1});
+
+  std::vector<int128_t> values;
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(
+        i % 3 == 0 ? DecimalUtil::kLongDecimalMin / (i + 1)
+                   : DecimalUtil::kLongDecimalMax / (i % 7 + 1));
+  }
+  test(values);
+
+  std::vector<int64_t> shortValues(1'000, -1'000'000'000'000'000);
+  int128_t sum = 0;
+  ASSERT_EQ(
+      DecimalUtil::sumWithOverflow(sum, shortValues.data(), shortValues.size()),
+      0);
+  ASSERT_EQ(sum, -1'000 * (int128_t)1'000'000'000'000'000);
+}
+
 TEST(DecimalTest, rescaleDouble) {
   assertRescaleDouble(-3333.03, DECIMAL(10, 4), -33'330'300);
   assertRescaleDouble(-3333.03, DECIMAL(20, 1), -33'330);
@@ -30,46 +30,71 @@ using namespace facebook::velox::common;
 
 std::vector<int64_t> sparseValues;
 std::vector<int64_t> denseValues;
+std::vector<std::string> stringValues;
 std::unique_ptr<BigintValuesUsingHashTable> filter;
+// 50K values. Large enough to check the bitmap of first probes.
+std::unique_ptr<BigintValuesUsingHashTable> largeFilter;
+std::unique_ptr<BytesValues> bytesFilter;
 
-int32_t run1x64(const std::vector<int64_t>& data) {
+int32_t run1x64(const Filter& filter, const std::vector<int64_t>& data) {
   int32_t count = 0;
   for (auto i = 0; i < data.size(); ++i) {
-    count += filter->testInt64(data[i]);
+    count += filter.testInt64(data[i]);
   }
   return count;
 }
 
-int32_t run4x64(const std::vector<int64_t>& data) {
+int32_t run4x64(const Filter& filter, const std::vector<int64_t>& data) {
   constexpr int kStep = xsimd::batch<int64_t>::size;
   int32_t count = 0;
   assert(data.size() % kStep == 0);
   for (auto i = 0; i < data.size(); i += kStep) {
-    auto result = filter->testValues(xsimd::load_unaligned(data.data() + i));
+    auto result = filter.testValues(xsimd::load_unaligned(data.data() + i));
     count += __builtin_popcount(simd::toBitMask(result));
   }
   return count;
 }
 
+int32_t runBytes(const Filter& filter, const std::vector<std::string>& data) {
+  int32_t count = 0;
+  for (const auto& value : data) {
+    count += filter.testBytes(value.data(), value.size());
+  }
+  return count;
+}
+
 BENCHMARK(scalarDense) {
-  folly::doNotOptimizeAway(run1x64(denseValues));
+  folly::doNotOptimizeAway(run1x64(*filter, denseValues));
 }
 
 BENCHMARK_RELATIVE(simdDense) {
-  folly::doNotOptimizeAway(run4x64(denseValues));
+  folly::doNotOptimizeAway(run4x64(*filter, denseValues));
 }
 
 BENCHMARK(scalarSparse) {
-  folly::doNotOptimizeAway(run1x64(sparseValues));
+  folly::doNotOptimizeAway(run1x64(*filter, sparseValues));
 }
 
 BENCHMARK_RELATIVE(simdSparse) {
-  folly::doNotOptimizeAway(run4x64(sparseValues));
+  folly::doNotOptimizeAway(run4x64(*filter, sparseValues));
+}
+
+BENCHMARK(scalarLargeSparse) {
+  folly::doNotOptimizeAway(run1x64(*largeFilter, sparseValues));
+}
+
+BENCHMARK_RELATIVE(simdLargeSparse) {
+  folly::doNotOptimizeAway(run4x64(*largeFilter, sparseValues));
+}
+
+BENCHMARK(bytesValuesLarge) {
+  folly::doNotOptimizeAway(runBytes(*bytesFilter, stringValues));
 }
 
 int32_t main(int32_t argc, char* argv[]) {
   constexpr int32_t kNumValues = 1000000;
   constexpr int32_t kFilterValues = 1000;
+  constexpr int32_t kLargeFilterValues = 50000;
   folly::Init init{&argc, &argv};
 
   std::vector<int64_t> filterValues;
@@ -79,15 +104,36 @@ int32_t main(int32_t argc, char* argv[]) {
   }
   filter = std::make_unique<BigintValuesUsingHashTable>(
       filterValues.front(), filterValues.back(), filterValues, false);
+  std::vector<int64_t> largeFilterValues;
+  std::vector<std::string> bytesFilterValues;
+  for (auto i = 0; i < kLargeFilterValues; ++i) {
+    largeFilterValues.push_back(i * 2000);
+    bytesFilterValues.push_back(fmt::format("customer#{:09}", i * 2));
+  }
+  largeFilter = std::make_unique<BigintValuesUsingHashTable>(
+      largeFilterValues.front(),
+      largeFilterValues.back(),
+      largeFilterValues,
+      false);
+  bytesFilter = std::make_unique<BytesValues>(bytesFilterValues, false);
   denseValues.resize(kNumValues);
   sparseValues.resize(kNumValues);
+  stringValues.resize(kNumValues);
   for (auto i = 0; i < kNumValues; ++i) {
     denseValues[i] = (folly::Random::rand32() % 3000) * 1000;
     sparseValues[i] = (folly::Random::rand32() % 100000) * 1000;
+    // 19 of 20 probes miss. They have the prefix and length of the values of
+    // 'bytesFilter', so only the bitmap of hashes rejects them early.
+    stringValues[i] = fmt::format(
+        "customer#{:09}", folly::Random::rand32() % (20 * kLargeFilterValues));
   }
 
-  VELOX_CHECK_EQ(run1x64(denseValues), run4x64(denseValues));
-  VELOX_CHECK_EQ(run1x64(sparseValues), run4x64(sparseValues));
+  VELOX_CHECK_EQ(run1x64(*filter, denseValues), run4x64(*filter, denseValues));
+  VELOX_CHECK_EQ(
+      run1x64(*filter, sparseValues), run4x64(*filter, sparseValues));
+  VELOX_CHECK_EQ(
+      run1x64(*largeFilter, sparseValues), run4x64(*largeFilter, sparseValues));
+  VELOX_CHECK_LT(runBytes(*bytesFilter, stringValues), kNumValues / 10);
   folly::runBenchmarks();
   return 0;
 }
@@ -106,6 +106,21 @@ TEST_F(FilterSerDeTest, valuesFilters) {
 
       testSerde(HugeintValuesUsingHashTable(
           lowerHugeint, upperHugeint, valuesHugeint, nullAllowed));
+
+      auto bloomFilter = std::make_shared<BloomFilter<>>();
+      bloomFilter->reset(values.size());
+      for (auto value : values) {
+        bloomFilter->insert(BigintValuesUsingBloomFilter::hash(value));
+      }
+      testSerde(
+          BigintValuesUsingBloomFilter(lower, upper, bloomFilter, nullAllowed));
+      testSerde(BigintValuesUsingBloomFilter(
+          lower,
+          upper,
+          bloomFilter,
+          nullAllowed,
+          std::make_shared<NegatedBigintValuesUsingHashTable>(
+              lower, upper, values, false)));
     }
   }
 }
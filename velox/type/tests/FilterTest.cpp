@@ -396,6 +396,24 @@ TEST(FilterTest, bigintValuesUsingHashTableSimd) {
   checkSimd(filter.get(), values, verify);
 }
 
+TEST(FilterTest, largeBigintValuesUsingHashTable) {
+  // Large lists check a bitmap of first probes before the hash table.
+  std::vector<int64_t> numbers;
+  folly::F14FastSet<int64_t> expected;
+  for (auto i = 0; i < 50'000; ++i) {
+    numbers.push_back(i * 7'919);
+    expected.insert(i * 7'919);
+  }
+  auto filter = createBigintValues(numbers, false);
+  ASSERT_TRUE(dynamic_cast<BigintValuesUsingHashTable*>(filter.get()));
+  auto verify = [&](int64_t x) { return expected.contains(x); };
+  for (auto i = -10; i < 100'000; ++i) {
+    ASSERT_EQ(filter->testInt64(i * 3'331), verify(i * 3'331)) << i;
+  }
+  applySimdTestToVector(numbers, *filter, verify);
+  applySimdTestToVector(numbers, *filter->clone(), verify);
+}
+
 TEST(FilterTest, negatedBigintValuesUsingHashTableSimd) {
   std::vector<int64_t> numbers;
   // make a worst case filter where every item falls on the same slot.
@@ -454,6 +472,102 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hash(i * 7));
+  }
+  BigintValuesUsingBloomFilter filter(0, 999 * 7, bloomFilter, false);
+
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 7'000; ++i) {
+    if (i % 7 == 0) {
+      EXPECT_TRUE(filter.testInt64(i));
+    } else if (filter.testInt64(i)) {
+      ++numFalsePositives;
+    }
+  }
+  EXPECT_LT(numFalsePositives, 6'000 / 10);
+  EXPECT_FALSE(filter.testNull());
+  EXPECT_FALSE(filter.testInt64(-7));
+  EXPECT_FALSE(filter.testInt64(1'000 * 7));
+
+  EXPECT_TRUE(filter.testInt64Range(5, 50, false));
+  EXPECT_TRUE(filter.testInt64Range(14, 14, false));
+  EXPECT_FALSE(filter.testInt64Range(-10, -5, false));
+  EXPECT_FALSE(filter.testInt64Range(7'000, 8'000, false));
+
+  // Merging with a range narrows the range of the Bloom filter.
+  auto merged = filter.mergeWith(BigintRange(100, 200, false).clone().get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(105));
+  EXPECT_FALSE(merged->testInt64(98));
+  EXPECT_FALSE(merged->testInt64(203));
+
+  // Merging with an IN-list keeps values of the list only.
+  auto values = createBigintValues({3, 7, 14, 15, 21}, false);
+  merged = filter.mergeWith(values.get());
+  auto mergedBack = values->mergeWith(&filter);
+  for (const auto* result : {merged.get(), mergedBack.get()}) {
+    EXPECT_TRUE(result->testInt64(7));
+    EXPECT_TRUE(result->testInt64(14));
+    EXPECT_TRUE(result->testInt64(21));
+    EXPECT_FALSE(result->testInt64(8));
+  }
+
+  // Merging with a filter that can not be combined exactly keeps both
+  // filters.
+  auto negated = createNegatedBigintValues({14, 21}, false);
+  merged = filter.mergeWith(negated.get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(7));
+  EXPECT_TRUE(merged->testInt64(28));
+  EXPECT_FALSE(merged->testInt64(14));
+  EXPECT_FALSE(merged->testInt64(7'000));
+  mergedBack = negated->mergeWith(&filter);
+  EXPECT_TRUE(mergedBack->testingEquals(*merged));
+
+  std::vector<std::unique_ptr<BigintRange>> ranges;
+  ranges.push_back(std::make_unique<BigintRange>(0, 10, false));
+  ranges.push_back(std::make_unique<BigintRange>(100, 200, false));
+  BigintMultiRange multiRange(std::move(ranges), false);
+  merged = filter.mergeWith(&multiRange);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(7));
+  EXPECT_TRUE(merged->testInt64(105));
+  EXPECT_FALSE(merged->testInt64(14));
+  EXPECT_FALSE(merged->testInt64Range(20, 90, false));
+  EXPECT_TRUE(merged->testInt64Range(5, 50, false));
+
+  // Merging with a negated filter again extends the conjunct.
+  auto negated2 = createNegatedBigintValues({105}, false);
+  merged = merged->mergeWith(negated2.get());
+  EXPECT_TRUE(merged->testInt64(7));
+  EXPECT_FALSE(merged->testInt64(105));
+  EXPECT_FALSE(merged->testInt64(14));
+
+  // Merging two Bloom filters keeps both.
+  auto otherBloomFilter = std::make_shared<BloomFilter<>>();
+  otherBloomFilter->reset(1'000);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    otherBloomFilter->insert(BigintValuesUsingBloomFilter::hash(i * 3));
+  }
+  BigintValuesUsingBloomFilter otherFilter(
+      0, 999 * 3, otherBloomFilter, false);
+  merged = filter.mergeWith(&otherFilter);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  int32_t numPassed = 0;
+  for (int64_t i = 0; i < 7'000; ++i) {
+    if (i % 21 == 0 && i <= 999 * 3) {
+      EXPECT_TRUE(merged->testInt64(i));
+    }
+    numPassed += merged->testInt64(i);
+  }
+  EXPECT_LT(numPassed, 1'000);
+  EXPECT_FALSE(merged->testInt64(3'500));
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -950,6 +1064,35 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, largeBytesValues) {
+  // Large lists check a bitmap of hashes before the hash set. The values share
+  // a prefix and a length, so only their last bytes tell them apart.
+  std::vector<std::string> values;
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(fmt::format("customer#{:09}", i * 10));
+  }
+  auto filter = in(values);
+  auto cloned = filter->clone();
+  // 9 of 10 probes miss. With 8 bits per value, the bitmap rejects most of
+  // them.
+  int32_t numMisses = 0;
+  int32_t numBitmapMisses = 0;
+  for (auto i = 0; i < 100'000; ++i) {
+    auto value = fmt::format("customer#{:09}", i);
+    ASSERT_EQ(filter->testBytes(value.data(), value.size()), i % 10 == 0);
+    ASSERT_EQ(cloned->testBytes(value.data(), value.size()), i % 10 == 0);
+    if (i % 10 == 0) {
+      ASSERT_TRUE(filter->testingHashBitSet(value));
+    } else {
+      ++numMisses;
+      numBitmapMisses += !filter->testingHashBitSet(value);
+    }
+  }
+  EXPECT_GT(numBitmapMisses, numMisses * 3 / 4);
+  EXPECT_FALSE(filter->testBytes("customer", 8));
+  EXPECT_FALSE(filter->testBytes("", 0));
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
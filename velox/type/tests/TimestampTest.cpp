@@ -390,6 +390,47 @@ TEST(TimestampTest, outOfRange) {
       "Unable to convert timezone 'America/Los_Angeles' past");
 }
 
+TEST(TimestampTest, timeZoneOffsetCache) {
+  for (const auto* name :
+       {"America/Los_Angeles", "Asia/Kolkata", "Pacific/Apia", "UTC"}) {
+    SCOPED_TRACE(name);
+    auto* zone = date::locate_zone(name);
+    TimeZoneOffsetCache cache(zone);
+    // 2011-01-01 to 2012-06-01 with the DST transitions of both years and
+    // the day that Pacific/Apia skipped.
+    for (int64_t seconds = 1'293'840'000; seconds < 1'338'508'800;
+         seconds += 997) {
+      Timestamp expected(seconds, 123);
+      expected.toTimezone(*zone);
+      Timestamp timestamp(seconds, 123);
+      cache.toTimezone(timestamp);
+      ASSERT_EQ(expected, timestamp);
+
+      expected = Timestamp(seconds, 123);
+      bool nonexistent = false;
+      try {
+        expected.toGMT(*zone);
+      } catch (const VeloxUserError&) {
+        nonexistent = true;
+      }
+      timestamp = Timestamp(seconds, 123);
+      if (nonexistent) {
+        ASSERT_THROW(cache.toGMT(timestamp), VeloxUserError);
+      } else {
+        cache.toGMT(timestamp);
+        ASSERT_EQ(expected, timestamp);
+      }
+    }
+  }
+
+  // A cache without a zone does not convert.
+  TimeZoneOffsetCache noZone;
+  Timestamp timestamp(1'000, 1);
+  noZone.toTimezone(timestamp);
+  noZone.toGMT(timestamp);
+  EXPECT_EQ(Timestamp(1'000, 1), timestamp);
+}
+
 // In debug mode, Timestamp constructor will throw exception if range check
 // fails.
 #ifdef NDEBUG
@@ -16,7 +16,9 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/HotCounters.h"
 #include "velox/vector/BaseVector.h"
+#include "velox/vector/BiasVector.h"
 #include "velox/vector/LazyVector.h"
 
 namespace facebook::velox {
@@ -31,6 +33,22 @@ std::vector<vector_size_t> makeConsecutiveIndices(size_t size) {
   }
   return consecutiveIndices;
 }
+
+// Sets 'indices[i]' to the run of 'sequenceVector' that index i falls in, for
+// i in [0, size).
+void expandRuns(
+    const BaseVector& sequenceVector,
+    vector_size_t size,
+    vector_size_t* indices) {
+  const auto* lengths = sequenceVector.wrapInfo()->as<vector_size_t>();
+  const auto numRuns = sequenceVector.valueVector()->size();
+  vector_size_t begin = 0;
+  for (vector_size_t run = 0; run < numRuns && begin < size; ++run) {
+    const auto end = std::min(size, begin + lengths[run]);
+    std::fill(indices + begin, indices + end, run);
+    begin = end;
+  }
+}
 } // namespace
 
 const std::vector<vector_size_t>& DecodedVector::consecutiveIndices() {
@@ -66,10 +84,12 @@ void DecodedVector::decode(
     case VectorEncoding::Simple::ARRAY:
     case VectorEncoding::Simple::MAP:
     case VectorEncoding::Simple::LAZY:
+      VELOX_HOT_COUNTER_INC(kDecodeFlat);
       isIdentityMapping_ = true;
       setBaseData(vector, rows);
       return;
     case VectorEncoding::Simple::CONSTANT: {
+      VELOX_HOT_COUNTER_INC(kDecodeConstant);
       isConstantMapping_ = true;
       if (isLazyNotLoaded(vector)) {
         baseVector_ = vector.valueVector().get();
@@ -82,6 +102,7 @@ void DecodedVector::decode(
     }
     case VectorEncoding::Simple::DICTIONARY:
     case VectorEncoding::Simple::SEQUENCE: {
+      VELOX_HOT_COUNTER_INC(kDecodeWrapped);
       combineWrappers(&vector, rows);
       break;
     }
@@ -147,6 +168,13 @@ void DecodedVector::combineWrappers(
       hasExtraNulls_ = true;
       mayHaveNulls_ = true;
     }
+  } else if (topEncoding == VectorEncoding::Simple::SEQUENCE) {
+    // A sequence vector does not add nulls. The values of a run are at the
+    // index of the run in the sequence values.
+    copiedIndices_.resize(size_ > 0 ? size_ : 1);
+    expandRuns(*vector, size_, copiedIndices_.data());
+    indices_ = copiedIndices_.data();
+    values = vector->valueVector().get();
   } else {
     VELOX_FAIL(
         "Unsupported wrapper encoding: {}",
@@ -177,10 +205,17 @@ void DecodedVector::combineWrappers(
         setBaseData(*values, rows);
         return;
       case VectorEncoding::Simple::DICTIONARY: {
+        VELOX_HOT_COUNTER_INC(kDecodeNestedWrapper);
         applyDictionaryWrapper(*values, rows);
         values = values->valueVector().get();
         break;
       }
+      case VectorEncoding::Simple::SEQUENCE: {
+        VELOX_HOT_COUNTER_INC(kDecodeNestedWrapper);
+        applySequenceWrapper(*values, rows);
+        values = values->valueVector().get();
+        break;
+      }
       default:
         VELOX_CHECK(false, "Unsupported vector encoding");
     }
@@ -226,6 +261,29 @@ void DecodedVector::applyDictionaryWrapper(
   });
 }
 
+void DecodedVector::applySequenceWrapper(
+    const BaseVector& sequenceVector,
+    const SelectivityVector* rows) {
+  if (size_ == 0 || (rows && !rows->hasSelections())) {
+    // No further processing is needed.
+    return;
+  }
+
+  std::vector<vector_size_t> runs(sequenceVector.size());
+  expandRuns(sequenceVector, sequenceVector.size(), runs.data());
+  auto currentIndices = indices_;
+  if (indicesNotCopied()) {
+    copiedIndices_.resize(size_);
+    indices_ = copiedIndices_.data();
+  }
+
+  applyToRows(rows, [&](vector_size_t row) {
+    if (!nulls_ || !bits::isBitNull(nulls_, row)) {
+      copiedIndices_[row] = runs[currentIndices[row]];
+    }
+  });
+}
+
 void DecodedVector::fillInIndices() {
   if (isConstantMapping_) {
     if (size_ > zeroIndices().size() || constantIndex_ != 0) {
@@ -298,6 +356,23 @@ void DecodedVector::setBaseData(
       setFlatNulls(vector, rows);
       break;
     }
+    case VectorEncoding::Simple::BIASED: {
+      switch (vector.typeKind()) {
+        case TypeKind::BIGINT:
+          setBiasedValues<int64_t>(vector, rows);
+          break;
+        case TypeKind::INTEGER:
+          setBiasedValues<int32_t>(vector, rows);
+          break;
+        case TypeKind::SMALLINT:
+          setBiasedValues<int16_t>(vector, rows);
+          break;
+        default:
+          VELOX_UNREACHABLE();
+      }
+      setFlatNulls(vector, rows);
+      break;
+    }
     case VectorEncoding::Simple::ROW:
     case VectorEncoding::Simple::ARRAY:
     case VectorEncoding::Simple::MAP: {
@@ -313,6 +388,27 @@ void DecodedVector::setBaseData(
   }
 }
 
+template <typename T>
+void DecodedVector::setBiasedValues(
+    const BaseVector& vector,
+    const SelectivityVector* rows) {
+  const auto& biased = *vector.asUnchecked<BiasVector<T>>();
+  biasedValues_.resize(
+      bits::roundUp(vector.size() * sizeof(T), sizeof(int64_t)) /
+      sizeof(int64_t));
+  auto* values = reinterpret_cast<T*>(biasedValues_.data());
+  if (isIdentityMapping_) {
+    applyToRows(rows, [&](vector_size_t row) {
+      values[row] = biased.valueAtFast(row);
+    });
+  } else {
+    for (vector_size_t i = 0; i < vector.size(); ++i) {
+      values[i] = biased.valueAtFast(i);
+    }
+  }
+  data_ = values;
+}
+
 void DecodedVector::setBaseDataForConstant(
     const BaseVector& vector,
     const SelectivityVector* rows) {
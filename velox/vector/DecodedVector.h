@@ -339,12 +339,24 @@ class DecodedVector {
       const BaseVector& dictionaryVector,
       const SelectivityVector* rows);
 
+  // Maps the indices of 'rows' into 'sequenceVector' to the runs of
+  // 'sequenceVector' that they fall in.
+  void applySequenceWrapper(
+      const BaseVector& sequenceVector,
+      const SelectivityVector* rows);
+
   void copyNulls(vector_size_t size);
 
   void fillInIndices();
 
   void setBaseData(const BaseVector& vector, const SelectivityVector* rows);
 
+  // Decompresses the values of the BiasVector 'vector' into 'biasedValues_'
+  // and points 'data_' to them. Only 'rows' are decompressed if the rows map
+  // to themselves, otherwise all the values are.
+  template <typename T>
+  void setBiasedValues(const BaseVector& vector, const SelectivityVector* rows);
+
   void setBaseDataForConstant(
       const BaseVector& vector,
       const SelectivityVector* rows);
@@ -425,6 +437,9 @@ class DecodedVector {
   // dictionary and base values.
   std::vector<uint64_t> copiedNulls_;
 
+  // Holds the decompressed values of a BiasVector.
+  std::vector<int64_t> biasedValues_;
+
   // Used as 'nulls_' for a null constant vector.
   static uint64_t constantNullMask_;
 };
@@ -128,6 +128,55 @@ bool FlatVector<T>::useSimdEquality(size_t numCmpVals) const {
   }
 }
 
+namespace detail {
+
+/// Sets target[i] = source[indices[i]] for i in [0, size). 4 and 8 byte
+/// values are gathered with SIMD. When 'source' is larger than the cache,
+/// the values of the next block of indices are prefetched while the current
+/// block is gathered, so that the random loads overlap.
+template <typename T>
+void gatherValues(
+    const T* source,
+    vector_size_t sourceSize,
+    const vector_size_t* indices,
+    vector_size_t size,
+    T* target) {
+  constexpr vector_size_t kBlockSize = 64;
+  constexpr int64_t kMinPrefetchBytes = 1 << 20;
+  constexpr bool kSimdGather = Buffer::is_pod_like_v<T> &&
+      !std::is_same_v<T, bool> && (sizeof(T) == 4 || sizeof(T) == 8);
+  using TGather = std::conditional_t<sizeof(T) == 4, int32_t, int64_t>;
+
+  const bool prefetch =
+      static_cast<int64_t>(sourceSize) * sizeof(T) > kMinPrefetchBytes;
+  for (vector_size_t start = 0; start < size; start += kBlockSize) {
+    const auto end = std::min(start + kBlockSize, size);
+    if (prefetch) {
+      const auto nextEnd = std::min(end + kBlockSize, size);
+      for (auto i = end; i < nextEnd; ++i) {
+        __builtin_prefetch(source + indices[i]);
+      }
+    }
+    auto i = start;
+    if constexpr (kSimdGather) {
+      // Gathers whole batches only. simd::transpose reads a full batch of
+      // indices for a partial one.
+      constexpr vector_size_t kBatch = xsimd::batch<TGather>::size;
+      const auto numGathered = (end - start) / kBatch * kBatch;
+      simd::transpose(
+          reinterpret_cast<const TGather*>(source),
+          folly::Range<const vector_size_t*>(indices + start, numGathered),
+          reinterpret_cast<TGather*>(target + start));
+      i += numGathered;
+    }
+    for (; i < end; ++i) {
+      target[i] = source[indices[i]];
+    }
+  }
+}
+
+} // namespace detail
+
 template <typename T>
 void FlatVector<T>::copyValuesAndNulls(
     const BaseVector* source,
@@ -189,11 +238,20 @@ void FlatVector<T>::copyValuesAndNulls(
     } else {
       auto* sourceValues = flatSource->rawValues();
       if (toSourceRow) {
-        rows.applyToSelected([&](auto row) {
-          auto sourceRow = toSourceRow[row];
-          VELOX_DCHECK_GT(source->size(), sourceRow);
-          rawValues_[row] = sourceValues[sourceRow];
-        });
+        if (rows.countSelected() == rows.end() - rows.begin()) {
+          detail::gatherValues(
+              sourceValues,
+              source->size(),
+              toSourceRow + rows.begin(),
+              rows.end() - rows.begin(),
+              rawValues_ + rows.begin());
+        } else {
+          rows.applyToSelected([&](auto row) {
+            auto sourceRow = toSourceRow[row];
+            VELOX_DCHECK_GT(source->size(), sourceRow);
+            rawValues_[row] = sourceValues[sourceRow];
+          });
+        }
       } else {
         rows.applyToSelected(
             [&](auto row) { rawValues_[row] = sourceValues[row]; });
@@ -242,16 +300,34 @@ void FlatVector<T>::copyValuesAndNulls(
   } else {
     DecodedVector decoded(*source);
     if (toSourceRow == nullptr) {
-      rows.applyToSelected([&](auto row) {
-        if (!decoded.isNullAt(row)) {
-          if constexpr (std::is_same_v<T, bool>) {
-            auto* rawValues = reinterpret_cast<uint64_t*>(rawValues_);
-            bits::setBit(rawValues, row, decoded.valueAt<T>(row));
-          } else {
-            rawValues_[row] = decoded.valueAt<T>(row);
-          }
+      bool gathered = false;
+      if constexpr (!std::is_same_v<T, bool>) {
+        // Gathers the values of a contiguous range of rows of a dictionary
+        // without nulls in bulk.
+        if (!decoded.isIdentityMapping() && !decoded.isConstantMapping() &&
+            !decoded.mayHaveNulls() &&
+            rows.countSelected() == rows.end() - rows.begin()) {
+          detail::gatherValues(
+              decoded.data<T>(),
+              decoded.base()->size(),
+              decoded.indices() + rows.begin(),
+              rows.end() - rows.begin(),
+              rawValues_ + rows.begin());
+          gathered = true;
         }
-      });
+      }
+      if (!gathered) {
+        rows.applyToSelected([&](auto row) {
+          if (!decoded.isNullAt(row)) {
+            if constexpr (std::is_same_v<T, bool>) {
+              auto* rawValues = reinterpret_cast<uint64_t*>(rawValues_);
+              bits::setBit(rawValues, row, decoded.valueAt<T>(row));
+            } else {
+              rawValues_[row] = decoded.valueAt<T>(row);
+            }
+          }
+        });
+      }
 
       if (rawNulls != nullptr) {
         auto* sourceNulls = decoded.nulls();
@@ -391,6 +467,39 @@ void FlatVector<T>::copyRanges(
     if (rawNulls) {
       BaseVector::setNulls(rawNulls, ranges, false);
     }
+  } else if (
+      !std::is_same_v<T, bool> &&
+      source->encoding() == VectorEncoding::Simple::DICTIONARY &&
+      source->rawNulls() == nullptr &&
+      source->valueVector()->isFlatEncoding() &&
+      source->valueVector()->values() != nullptr) {
+    // Gathers the values of each range from the base of a dictionary over a
+    // flat vector in bulk instead of one virtual valueAt() per row.
+    const auto& base = source->valueVector();
+    const T* baseValues = base->asUnchecked<FlatVector<T>>()->rawValues();
+    const auto* indices = source->wrapInfo()->as<vector_size_t>();
+    applyToEachRange(
+        ranges, [&](auto targetIndex, auto sourceIndex, auto count) {
+          detail::gatherValues(
+              baseValues,
+              base->size(),
+              indices + sourceIndex,
+              count,
+              rawValues_ + targetIndex);
+        });
+    if (rawNulls) {
+      const auto* baseNulls = base->rawNulls();
+      if (baseNulls) {
+        applyToEachRow(ranges, [&](auto targetIndex, auto sourceIndex) {
+          bits::setNull(
+              rawNulls,
+              targetIndex,
+              bits::isBitNull(baseNulls, indices[sourceIndex]));
+        });
+      } else {
+        BaseVector::setNulls(rawNulls, ranges, false);
+      }
+    }
   } else {
     auto* sourceVector = source->asUnchecked<SimpleVector<T>>();
     uint64_t* rawBoolValues = nullptr;
@@ -101,6 +101,60 @@ void FlatVector<StringView>::prepareForReuse() {
   }
 }
 
+template <>
+bool FlatVector<StringView>::compactStringBuffers(double maxLiveFraction) {
+  if (stringBuffers_.empty()) {
+    return false;
+  }
+  if (rawValues_ == nullptr) {
+    // All values are null.
+    clearStringBuffers();
+    return true;
+  }
+
+  uint64_t retainedBytes = 0;
+  for (const auto& buffer : stringBuffers_) {
+    retainedBytes += buffer->capacity();
+  }
+  uint64_t liveBytes = 0;
+  for (auto i = 0; i < BaseVector::length_; ++i) {
+    if (!BaseVector::isNullAt(i) && !rawValues_[i].isInline()) {
+      liveBytes += rawValues_[i].size();
+    }
+  }
+  if (liveBytes > retainedBytes * maxLiveFraction) {
+    return false;
+  }
+
+  if (!values_->isMutable()) {
+    values_ = AlignedBuffer::copy(pool(), values_);
+    rawValues_ = values_->asMutable<StringView>();
+  }
+  BufferPtr buffer;
+  char* rawBuffer = nullptr;
+  if (liveBytes > 0) {
+    buffer = AlignedBuffer::allocate<char>(liveBytes, pool());
+    rawBuffer = buffer->asMutable<char>();
+  }
+  for (auto i = 0; i < BaseVector::length_; ++i) {
+    if (BaseVector::isNullAt(i)) {
+      // Null rows may reference the released buffers.
+      rawValues_[i] = StringView();
+    } else if (!rawValues_[i].isInline()) {
+      const auto size = rawValues_[i].size();
+      memcpy(rawBuffer, rawValues_[i].data(), size);
+      rawValues_[i] = StringView(rawBuffer, size);
+      rawBuffer += size;
+    }
+  }
+  if (buffer) {
+    setStringBuffers({std::move(buffer)});
+  } else {
+    clearStringBuffers();
+  }
+  return true;
+}
+
 template <>
 void FlatVector<StringView>::set(vector_size_t idx, StringView value) {
   VELOX_DCHECK_LT(idx, BaseVector::length_);
@@ -487,6 +487,17 @@ class FlatVector final : public SimpleVector<T> {
     return nullptr;
   }
 
+  /// This API is available only for string vectors (T = StringView).
+  ///
+  /// Copies the strings that are not inlined into one new string buffer and
+  /// releases the current string buffers if the strings take at most
+  /// 'maxLiveFraction' of the capacity of the string buffers, e.g. when the
+  /// strings are substrings of or a few rows out of much larger strings.
+  /// Returns true if the string buffers were replaced.
+  bool compactStringBuffers(double /*maxLiveFraction*/) {
+    return false;
+  }
+
   void ensureWritable(const SelectivityVector& rows) override;
 
   bool isWritable() const override {
@@ -614,6 +625,9 @@ char* FlatVector<StringView>::getRawStringBufferWithSpace(
 template <>
 void FlatVector<StringView>::prepareForReuse();
 
+template <>
+bool FlatVector<StringView>::compactStringBuffers(double maxLiveFraction);
+
 template <typename T>
 using FlatVectorPtr = std::shared_ptr<FlatVector<T>>;
 
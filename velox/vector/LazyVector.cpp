@@ -271,6 +271,20 @@ void LazyVector::load(RowSet rows, ValueHook* hook) const {
   }
 }
 
+bool LazyVector::prefetch(const SelectivityVector& rows) const {
+  if (allLoaded_ || !rows.hasSelections()) {
+    return false;
+  }
+  raw_vector<vector_size_t> rowNumbers(rows.countSelected());
+  vector_size_t numRows = 0;
+  rows.applyToSelected([&](auto row) { rowNumbers[numRows++] = row; });
+  if (!loader_->prefetch(rowNumbers, size())) {
+    return false;
+  }
+  addThreadLocalRuntimeStat(kPrefetches, RuntimeCounter(1));
+  return true;
+}
+
 void LazyVector::loadVectorInternal() const {
   if (!allLoaded_) {
     if (!vector_) {
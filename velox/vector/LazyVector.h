@@ -99,6 +99,15 @@ class VectorLoader {
       vector_size_t resultSize,
       VectorPtr* result);
 
+  /// Hints that 'rows' are about to be loaded. The loader may start producing
+  /// their values in the background, in which case the load() that follows
+  /// waits for them. After this returns true, the values may only be loaded
+  /// without a ValueHook and for a subset of 'rows'. The default does nothing
+  /// and returns false.
+  virtual bool prefetch(RowSet /*rows*/, vector_size_t /*resultSize*/) {
+    return false;
+  }
+
  protected:
   virtual void loadInternal(
       RowSet rows,
@@ -128,6 +137,8 @@ class LazyVector : public BaseVector {
  public:
   static constexpr const char* kCpuNanos = "dataSourceLazyCpuNanos";
   static constexpr const char* kWallNanos = "dataSourceLazyWallNanos";
+  /// Runtime stat counting the prefetch() calls that started a load.
+  static constexpr const char* kPrefetches = "lazyVectorPrefetches";
   LazyVector(
       velox::memory::MemoryPool* pool,
       TypePtr type,
@@ -162,6 +173,14 @@ class LazyVector : public BaseVector {
   // logically not a mutation.
   void load(RowSet rows, ValueHook* hook) const;
 
+  /// Hints that 'rows' are about to be loaded, e.g. by an operator that has
+  /// evaluated a filter and will evaluate projections on the passing rows.
+  /// The loader may then produce the values in the background while the
+  /// caller does other work. If this returns true, 'this' must be loaded only
+  /// for a subset of 'rows' and without a ValueHook. Has no effect and
+  /// returns false if 'this' is loaded or the loader does not prefetch.
+  bool prefetch(const SelectivityVector& rows) const;
+
   std::optional<int32_t> compare(
       const BaseVector* other,
       vector_size_t index,
@@ -54,6 +54,35 @@ std::string SelectivityVector::toString(
   return out.str();
 }
 
+void SelectivityVector::chooseSelection() const {
+  // Below this many rows between begin_ and end_ the bitmap is scanned in a
+  // few words and is not worth counting.
+  constexpr vector_size_t kMinRowsToCount = 256;
+  // The selected rows are listed if at most 1 in this many rows between
+  // begin_ and end_ is selected.
+  constexpr vector_size_t kMaxSparseRatio = 32;
+
+  const auto numRows = end_ - begin_;
+  if (numRows < kMinRowsToCount) {
+    selection_ = isAllSelected() ? Selection::kRange : Selection::kBitmap;
+    return;
+  }
+  const auto numSelected = bits::countBits(bits_.data(), begin_, end_);
+  allSelected_ = numSelected == size_;
+  if (numSelected == numRows) {
+    selection_ = Selection::kRange;
+  } else if (numSelected <= numRows / kMaxSparseRatio) {
+    selectedRows_.resize(numSelected);
+    auto* rawSelectedRows = selectedRows_.data();
+    bits::forEachSetBit(bits_.data(), begin_, end_, [&](auto row) {
+      *rawSelectedRows++ = row;
+    });
+    selection_ = Selection::kRows;
+  } else {
+    selection_ = Selection::kBitmap;
+  }
+}
+
 void SelectivityVector::copyNulls(uint64_t* dest, const uint64_t* src) const {
   if (isAllSelected()) {
     bits::copyBits(src, 0, dest, 0, size_);
@@ -46,6 +46,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = allSelected ? size_ : 0;
     allSelected_ = allSelected;
+    selection_ = Selection::kRange;
   }
 
   // Returns a statically allocated reference to an empty selectivity vector
@@ -88,6 +89,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = value ? size_ : 0;
     allSelected_ = value;
+    selection_ = Selection::kRange;
   }
 
   /**
@@ -99,6 +101,7 @@ class SelectivityVector {
     VELOX_DCHECK_LT(idx, bits_.size() * sizeof(bits_[0]) * 8);
     bits::setBit(bits_.data(), idx, valid);
     allSelected_.reset();
+    selection_ = Selection::kUnknown;
   }
 
   /**
@@ -114,6 +117,7 @@ class SelectivityVector {
     VELOX_DCHECK_LE(end, bits_.size() * sizeof(bits_[0]) * 8);
     bits::fillBits(bits_.data(), begin, end, valid);
     allSelected_.reset();
+    selection_ = Selection::kUnknown;
   }
 
   /**
@@ -157,6 +161,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = 0;
     allSelected_ = false;
+    selection_ = Selection::kRange;
   }
 
   /**
@@ -167,6 +172,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = size_;
     allSelected_ = true;
+    selection_ = Selection::kRange;
   }
 
   void setFromBits(const uint64_t* bits, int32_t size) {
@@ -288,16 +294,22 @@ class SelectivityVector {
       begin_ = 0;
       end_ = 0;
       allSelected_ = false;
+      selection_ = Selection::kRange;
       return;
     }
     end_ = bits::findLastBit(bits_.data(), begin_, size_) + 1;
     allSelected_.reset();
+    selection_ = Selection::kUnknown;
   }
 
   bool isAllSelected() const {
     if (allSelected_.has_value()) {
       return allSelected_.value();
     }
+    if (selection_ == Selection::kRange) {
+      allSelected_ = begin_ == 0 && end_ == size_;
+      return allSelected_.value();
+    }
     allSelected_ = begin_ == 0 && end_ == size_ &&
         bits::isAllSet(bits_.data(), 0, size_, true);
     return allSelected_.value();
@@ -309,6 +321,12 @@ class SelectivityVector {
     if (allSelected_.has_value() && *allSelected_) {
       return size();
     }
+    if (selection_ == Selection::kRange) {
+      return end_ - begin_;
+    }
+    if (selection_ == Selection::kRows) {
+      return selectedRows_.size();
+    }
     auto count = bits::countBits(bits_.data(), begin_, end_);
     allSelected_ = count == size();
     return count;
@@ -385,6 +403,29 @@ class SelectivityVector {
 
   mutable std::optional<bool> allSelected_;
 
+  // How applyToSelected() and testSelected() iterate over the selected rows.
+  // Chosen on first use after the selection changes. kRange when all the
+  // rows in [begin_, end_) are selected, kRows when few of the rows in
+  // [begin_, end_) are selected and their numbers are in 'selectedRows_',
+  // kBitmap otherwise.
+  enum class Selection : int8_t { kUnknown, kRange, kBitmap, kRows };
+
+  // Sets 'selection_' and 'selectedRows_' for the current bits.
+  void chooseSelection() const;
+
+  Selection selection() const {
+    if (selection_ == Selection::kUnknown) {
+      chooseSelection();
+    }
+    return selection_;
+  }
+
+  mutable Selection selection_ = Selection::kRange;
+
+  // The selected rows in ascending order if 'selection_' is kRows. Keeps its
+  // capacity when the selection changes.
+  mutable std::vector<vector_size_t> selectedRows_;
+
   friend class SelectivityIterator;
 };
 
@@ -432,26 +473,43 @@ class SelectivityIterator {
 
 template <typename Callable>
 inline void SelectivityVector::applyToSelected(Callable func) const {
-  if (isAllSelected()) {
-    for (vector_size_t row = begin_; row < end_; ++row) {
-      func(row);
-    }
-  } else {
-    bits::forEachSetBit(bits_.data(), begin_, end_, func);
+  switch (selection()) {
+    case Selection::kRange:
+      for (vector_size_t row = begin_; row < end_; ++row) {
+        func(row);
+      }
+      break;
+    case Selection::kRows:
+      for (auto row : selectedRows_) {
+        func(row);
+      }
+      break;
+    default:
+      bits::forEachSetBit(bits_.data(), begin_, end_, func);
+      break;
   }
 }
 
 template <typename Callable>
 inline bool SelectivityVector::testSelected(Callable func) const {
-  if (isAllSelected()) {
-    for (vector_size_t row = begin_; row < end_; ++row) {
-      if (!func(row)) {
-        return false;
+  switch (selection()) {
+    case Selection::kRange:
+      for (vector_size_t row = begin_; row < end_; ++row) {
+        if (!func(row)) {
+          return false;
+        }
       }
-    }
-    return true;
+      return true;
+    case Selection::kRows:
+      for (auto row : selectedRows_) {
+        if (!func(row)) {
+          return false;
+        }
+      }
+      return true;
+    default:
+      return bits::testSetBits(bits_.data(), begin_, end_, func);
   }
-  return bits::testSetBits(bits_.data(), begin_, end_, func);
 }
 
 void translateToInnerRows(
@@ -120,6 +120,38 @@ std::unique_ptr<SimpleVector<uint64_t>> SequenceVector<T>::hashAll() const {
       0 /* nullSequenceCount */);
 }
 
+template <typename T>
+VectorPtr SequenceVector<T>::slice(vector_size_t offset, vector_size_t length)
+    const {
+  VELOX_CHECK_GE(offset, 0);
+  VELOX_CHECK_LE(offset + length, BaseVector::length_);
+  if (length == 0) {
+    return sequenceValues_->slice(0, 0);
+  }
+  vector_size_t firstRun = 0;
+  vector_size_t runBegin = 0;
+  while (runBegin + lengths_[firstRun] <= offset) {
+    runBegin += lengths_[firstRun];
+    ++firstRun;
+  }
+  const auto end = offset + length;
+  auto lengths =
+      AlignedBuffer::allocate<vector_size_t>(numSequences(), BaseVector::pool_);
+  auto* rawLengths = lengths->asMutable<vector_size_t>();
+  vector_size_t numRuns = 0;
+  for (auto run = firstRun; runBegin < end; ++run) {
+    const auto runEnd = runBegin + lengths_[run];
+    rawLengths[numRuns++] = std::min(runEnd, end) - std::max(runBegin, offset);
+    runBegin = runEnd;
+  }
+  lengths->setSize(BaseVector::byteSize<SequenceLength>(numRuns));
+  return std::make_shared<SequenceVector<T>>(
+      BaseVector::pool_,
+      length,
+      sequenceValues_->slice(firstRun, numRuns),
+      std::move(lengths));
+}
+
 template <typename T>
 xsimd::batch<T> SequenceVector<T>::loadSIMDValueBufferAt(
     size_t byteOffset) const {
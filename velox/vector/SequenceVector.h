@@ -190,9 +190,9 @@ class SequenceVector : public SimpleVector<T> {
     return out.str();
   }
 
-  VectorPtr slice(vector_size_t, vector_size_t) const override {
-    VELOX_NYI();
-  }
+  /// Returns the runs that overlap [offset, offset + length), with the first
+  /// and last runs cut to the range.
+  VectorPtr slice(vector_size_t offset, vector_size_t length) const override;
 
   bool isNullsWritable() const override {
     return false;
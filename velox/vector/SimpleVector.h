@@ -287,14 +287,32 @@ class SimpleVector : public BaseVector {
       return asciiInfo.isAllAscii();
     }
     ensureIsAsciiCapacity();
-    bool isAllAscii = true;
-    rows.template applyToSelected([&](auto row) {
-      if (!isNullAt(row)) {
-        auto string = valueAt(row);
-        isAllAscii &=
-            functions::stringCore::isAscii(string.data(), string.size());
+    // Strings that are next to each other in memory, e.g. the strings that a
+    // reader or a function wrote in row order, are checked together as one
+    // run of bytes. Stops at the first non-ascii string.
+    const char* runBegin = nullptr;
+    const char* runEnd = nullptr;
+    bool isAllAscii = rows.testSelected([&](auto row) {
+      if (isNullAt(row)) {
+        return true;
       }
+      const auto string = valueAt(row);
+      if (string.isInline()) {
+        // The data of an inline string is in the local copy.
+        return functions::stringCore::isAscii(string.data(), string.size());
+      }
+      if (string.data() != runEnd) {
+        if (!functions::stringCore::isAscii(runBegin, runEnd - runBegin)) {
+          return false;
+        }
+        runBegin = string.data();
+      }
+      runEnd = string.data() + string.size();
+      return true;
     });
+    if (isAllAscii) {
+      isAllAscii = functions::stringCore::isAscii(runBegin, runEnd - runBegin);
+    }
 
     // Set isAllAscii flag, it will unset if we encounter any utf.
     auto wlockedAsciiComputedRows = asciiInfo.writeLockedAsciiComputedRows();
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/vector/VectorCompression.h"
+
+#include "velox/vector/BiasVector.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+#include "velox/vector/LazyVector.h"
+
+namespace facebook::velox {
+namespace {
+
+template <typename T, typename TDelta>
+BufferPtr biasValues(
+    const FlatVector<T>& flat,
+    T bias,
+    memory::MemoryPool* pool) {
+  const auto size = flat.size();
+  auto values = AlignedBuffer::allocate<TDelta>(size, pool, 0);
+  auto* rawValues = values->asMutable<TDelta>();
+  const auto* rawFlat = flat.rawValues();
+  for (vector_size_t i = 0; i < size; ++i) {
+    if (!flat.isNullAt(i)) {
+      rawValues[i] = static_cast<TDelta>(
+          static_cast<int64_t>(rawFlat[i]) - static_cast<int64_t>(bias));
+    }
+  }
+  return values;
+}
+
+template <typename T>
+VectorPtr compressFlat(const VectorPtr& vector, memory::MemoryPool* pool) {
+  const auto& flat = *vector->asUnchecked<FlatVector<T>>();
+  const auto* rawValues = flat.rawValues();
+  if (rawValues == nullptr) {
+    return vector;
+  }
+  T min = std::numeric_limits<T>::max();
+  T max = std::numeric_limits<T>::min();
+  bool hasValues = false;
+  for (vector_size_t i = 0; i < flat.size(); ++i) {
+    if (!flat.isNullAt(i)) {
+      min = std::min(min, rawValues[i]);
+      max = std::max(max, rawValues[i]);
+      hasValues = true;
+    }
+  }
+  if (!hasValues) {
+    return vector;
+  }
+
+  // Check BiasVector.h for the calculation of the bias. The delta does not
+  // overflow since max >= min.
+  const uint64_t delta =
+      static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+  auto bias = [&]() {
+    return static_cast<T>(
+        static_cast<int64_t>(min) + static_cast<int64_t>((delta + 1) / 2));
+  };
+
+  BufferPtr values;
+  TypeKind valueType;
+  if (delta <= std::numeric_limits<uint8_t>::max()) {
+    values = biasValues<T, int8_t>(flat, bias(), pool);
+    valueType = TypeKind::TINYINT;
+  } else if (
+      sizeof(T) > sizeof(int16_t) &&
+      delta <= std::numeric_limits<uint16_t>::max()) {
+    values = biasValues<T, int16_t>(flat, bias(), pool);
+    valueType = TypeKind::SMALLINT;
+  } else if (
+      sizeof(T) > sizeof(int32_t) &&
+      delta <= std::numeric_limits<uint32_t>::max()) {
+    values = biasValues<T, int32_t>(flat, bias(), pool);
+    valueType = TypeKind::INTEGER;
+  } else {
+    return vector;
+  }
+
+  return std::make_shared<BiasVector<T>>(
+      pool,
+      vector->nulls(),
+      vector->size(),
+      valueType,
+      std::move(values),
+      bias(),
+      SimpleVectorStats<T>{},
+      std::nullopt,
+      vector->getNullCount());
+}
+
+template <typename T>
+VectorPtr decompressBiased(const VectorPtr& vector, memory::MemoryPool* pool) {
+  const auto& biased = *vector->asUnchecked<BiasVector<T>>();
+  auto values = AlignedBuffer::allocate<T>(vector->size(), pool);
+  auto* rawValues = values->asMutable<T>();
+  for (vector_size_t i = 0; i < vector->size(); ++i) {
+    rawValues[i] = biased.valueAtFast(i);
+  }
+  return std::make_shared<FlatVector<T>>(
+      pool,
+      vector->type(),
+      vector->nulls(),
+      vector->size(),
+      std::move(values),
+      std::vector<BufferPtr>{},
+      SimpleVectorStats<T>{},
+      std::nullopt,
+      vector->getNullCount());
+}
+
+// Applies 'func' to the children of the ROW vector 'vector'. Returns
+// 'vector' if 'func' returns all the children as they are.
+template <typename Func>
+VectorPtr transformChildren(
+    const VectorPtr& vector,
+    memory::MemoryPool* pool,
+    Func func) {
+  const auto& row = *vector->asUnchecked<RowVector>();
+  std::vector<VectorPtr> children(row.childrenSize());
+  bool changed = false;
+  for (auto i = 0; i < row.childrenSize(); ++i) {
+    children[i] = func(row.childAt(i), pool);
+    changed |= children[i] != row.childAt(i);
+  }
+  if (!changed) {
+    return vector;
+  }
+  return std::make_shared<RowVector>(
+      pool,
+      row.type(),
+      row.nulls(),
+      row.size(),
+      std::move(children),
+      row.getNullCount());
+}
+
+} // namespace
+
+VectorPtr compressIntegers(const VectorPtr& vector, memory::MemoryPool* pool) {
+  if (vector == nullptr) {
+    return vector;
+  }
+  if (vector->encoding() == VectorEncoding::Simple::ROW) {
+    return transformChildren(vector, pool, compressIntegers);
+  }
+  // A loaded lazy vector is compressed as its loaded vector.
+  const auto& loaded = vector->isLazy() &&
+          vector->asUnchecked<LazyVector>()->isLoaded()
+      ? BaseVector::loadedVectorShared(vector)
+      : vector;
+  if (loaded->encoding() != VectorEncoding::Simple::FLAT) {
+    return vector;
+  }
+  const auto& type = *loaded->type();
+  if (type == *BIGINT()) {
+    return compressFlat<int64_t>(loaded, pool);
+  }
+  if (type == *INTEGER()) {
+    return compressFlat<int32_t>(loaded, pool);
+  }
+  if (type == *SMALLINT()) {
+    return compressFlat<int16_t>(loaded, pool);
+  }
+  return vector;
+}
+
+VectorPtr decompress(const VectorPtr& vector, memory::MemoryPool* pool) {
+  if (vector == nullptr) {
+    return vector;
+  }
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::ROW:
+      return transformChildren(vector, pool, decompress);
+    case VectorEncoding::Simple::BIASED:
+      switch (vector->typeKind()) {
+        case TypeKind::BIGINT:
+          return decompressBiased<int64_t>(vector, pool);
+        case TypeKind::INTEGER:
+          return decompressBiased<int32_t>(vector, pool);
+        case TypeKind::SMALLINT:
+          return decompressBiased<int16_t>(vector, pool);
+        default:
+          VELOX_UNREACHABLE();
+      }
+    default:
+      return vector;
+  }
+}
+
+VectorPtr compactStrings(
+    const VectorPtr& vector,
+    memory::MemoryPool* pool,
+    double maxLiveFraction) {
+  if (vector == nullptr) {
+    return vector;
+  }
+  if (vector->encoding() == VectorEncoding::Simple::ROW) {
+    return transformChildren(
+        vector, pool, [&](const VectorPtr& child, memory::MemoryPool* pool) {
+          return compactStrings(child, pool, maxLiveFraction);
+        });
+  }
+  const auto kind = vector->typeKind();
+  if (kind != TypeKind::VARCHAR && kind != TypeKind::VARBINARY) {
+    return vector;
+  }
+  const auto& loaded = vector->isLazy() &&
+          vector->asUnchecked<LazyVector>()->isLoaded()
+      ? BaseVector::loadedVectorShared(vector)
+      : vector;
+  if (loaded->isLazy()) {
+    return vector;
+  }
+
+  DecodedVector decoded(*loaded);
+  if (!decoded.base()->isFlatEncoding()) {
+    return vector;
+  }
+  uint64_t retainedBytes = 0;
+  for (const auto& buffer :
+       decoded.base()->asUnchecked<FlatVector<StringView>>()->stringBuffers()) {
+    retainedBytes += buffer->capacity();
+  }
+  uint64_t liveBytes = 0;
+  for (vector_size_t i = 0; i < loaded->size(); ++i) {
+    if (!decoded.isNullAt(i)) {
+      const auto value = decoded.valueAt<StringView>(i);
+      if (!value.isInline()) {
+        liveBytes += value.size();
+      }
+    }
+  }
+  if (retainedBytes == 0 || liveBytes > retainedBytes * maxLiveFraction) {
+    return vector;
+  }
+
+  // The copy references the string buffers of 'loaded'. It is not shared, so
+  // it can be compacted in place.
+  auto flat = BaseVector::create<FlatVector<StringView>>(
+      loaded->type(), loaded->size(), pool);
+  flat->copy(loaded.get(), 0, 0, loaded->size());
+  flat->compactStringBuffers(maxLiveFraction);
+  return flat;
+}
+
+} // namespace facebook::velox
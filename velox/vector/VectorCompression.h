@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox {
+
+/// Returns 'vector' with its flat BIGINT, INTEGER and SMALLINT vectors
+/// replaced by BiasVectors with 8, 16 or 32 bit values when the range of
+/// their non-null values fits. Recurses into the children of ROW vectors.
+/// Returns 'vector' itself if nothing is compressed. Meant for operators that
+/// hold large inputs in memory for a long time. DecodedVector decodes the
+/// result, but operators should call decompress() before producing output
+/// from it since not all code paths handle BiasVectors.
+VectorPtr compressIntegers(const VectorPtr& vector, memory::MemoryPool* pool);
+
+/// Returns 'vector' with the BiasVectors made by compressIntegers() replaced
+/// by flat vectors. Returns 'vector' itself if it has no BiasVectors.
+VectorPtr decompress(const VectorPtr& vector, memory::MemoryPool* pool);
+
+/// Returns 'vector' with the VARCHAR and VARBINARY vectors whose strings take
+/// at most 'maxLiveFraction' of the string buffers they reference replaced by
+/// flat vectors with the strings copied into compact buffers. This happens
+/// when a filter, substr() or split() leaves a few short strings of a large
+/// batch. Dictionaries over flat vectors are flattened. Recurses into the
+/// children of ROW vectors. Returns 'vector' itself if nothing is compacted.
+/// Meant for operators that hold inputs in memory for a long time.
+VectorPtr compactStrings(
+    const VectorPtr& vector,
+    memory::MemoryPool* pool,
+    double maxLiveFraction = 0.125);
+
+} // namespace facebook::velox
@@ -47,12 +47,22 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+FOLLY_ALWAYS_INLINE bool isComplexKind(TypeKind kind) {
+  return kind == TypeKind::ARRAY || kind == TypeKind::MAP ||
+      kind == TypeKind::ROW;
+}
 } // namespace
 
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    auto cacheIndex = toCacheIndex(type);
+    if (cacheIndex >= 0) {
+      return vectors_[cacheIndex].pop(type, size, *pool_, stats_);
+    }
+    if (isComplexKind(type->kind())) {
+      return getComplex(type, size);
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
@@ -61,12 +71,16 @@ bool VectorPool::release(VectorPtr& vector) {
   if (FOLLY_UNLIKELY(vector == nullptr)) {
     return false;
   }
-  if (!vector.unique() || vector->size() > kMaxRecycleSize) {
+  if (!vector.unique() || vector->size() > kMaxRecycleSize ||
+      vector->pool() != pool_) {
     return false;
   }
 
   auto cacheIndex = toCacheIndex(vector->type());
   if (cacheIndex < 0) {
+    if (isComplexKind(vector->typeKind())) {
+      return releaseComplex(vector);
+    }
     return false;
   }
   return vectors_[cacheIndex].maybePushBack(vector);
@@ -84,6 +98,40 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
   return numReleased;
 }
 
+VectorPtr VectorPool::getComplex(const TypePtr& type, vector_size_t size) {
+  ++stats_.numGets;
+  for (auto i = 0; i < complexVectors_.size(); ++i) {
+    if (*complexVectors_[i]->type() != *type) {
+      continue;
+    }
+    auto result = std::move(complexVectors_[i]);
+    complexVectors_[i] = std::move(complexVectors_.back());
+    complexVectors_.pop_back();
+    ++stats_.numReused;
+    stats_.reusedBytes += result->retainedSize();
+    // The children of a recycled vector are empty, see
+    // BaseVector::prepareForReuse(). Growing from zero sets all rows not null
+    // and makes a RowVector resize its children.
+    result->resize(0);
+    result->resize(size);
+    return result;
+  }
+  return BaseVector::create(type, size, pool_);
+}
+
+bool VectorPool::releaseComplex(VectorPtr& vector) {
+  if (complexVectors_.size() >= kNumPerType || !vector->isWritable() ||
+      !(vector->encoding() == VectorEncoding::Simple::ARRAY ||
+        vector->encoding() == VectorEncoding::Simple::MAP ||
+        vector->encoding() == VectorEncoding::Simple::ROW)) {
+    return false;
+  }
+
+  vector->prepareForReuse();
+  complexVectors_.push_back(std::move(vector));
+  return true;
+}
+
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
   // values Buffer and an uninitialized or unique and mutable nulls Buffer.
@@ -102,9 +150,13 @@ bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
 VectorPtr VectorPool::TypePool::pop(
     const TypePtr& type,
     vector_size_t vectorSize,
-    memory::MemoryPool& pool) {
+    memory::MemoryPool& pool,
+    Stats& stats) {
+  ++stats.numGets;
   if (size) {
     auto result = std::move(vectors[--size]);
+    ++stats.numReused;
+    stats.reusedBytes += result->retainedSize();
     if (UNLIKELY(result->rawNulls() != nullptr)) {
       // This is a recyclable vector, no need to check uniqueness.
       simd::memset(
@@ -20,28 +20,47 @@
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
-/// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// A thread-level cache of pre-allocated vectors of different types.
+/// Keeps up to 10 recyclable flat vectors of each singleton built-in type and
+/// up to 10 recyclable ARRAY, MAP and ROW vectors in total. A vector is
+/// recyclable if it is flat or complex with recyclable children, recursively
+/// singly-referenced and allocated from the pool of 'this'. Flat string
+/// vectors keep their first string buffer for reuse. Decimal types,
+/// fixed-size array type and custom types are not supported. Calling 'get'
+/// for an unsupported type already returns a newly allocated vector. Calling
+/// 'release' for an unsupported type is a no-op.
 class VectorPool {
  public:
+  /// Counts the vectors 'this' hands out and how many of them are recycled.
+  struct Stats {
+    /// Number of calls to get() for a supported type and size.
+    uint64_t numGets{0};
+
+    /// Number of calls to get() that returned a recycled vector.
+    uint64_t numReused{0};
+
+    /// Retained bytes of the recycled vectors returned by get(). This is the
+    /// memory that would otherwise have been allocated.
+    uint64_t reusedBytes{0};
+  };
+
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
-  /// 'pool_' if no pre-allocated vector or type is a complex type.
+  /// 'pool_' if no pre-allocated vector or type is not supported.
   VectorPtr get(const TypePtr& type, vector_size_t size);
 
-  /// Moves vector into 'this' if it is flat, recursively singly referenced and
-  /// there is space. The function returns true if 'vector' is not null and has
-  /// been returned back to this pool, otherwise returns false.
+  /// Moves vector into 'this' if it is recyclable and there is space. The
+  /// function returns true if 'vector' is not null and has been returned back
+  /// to this pool, otherwise returns false.
   bool release(VectorPtr& vector);
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  const Stats& stats() const {
+    return stats_;
+  }
+
  private:
   /// Max number of elements for a vector to be recyclable. The larger
   /// the batch the less the win from recycling.
@@ -57,9 +76,18 @@ class VectorPool {
     VectorPtr pop(
         const TypePtr& type,
         vector_size_t vectorSize,
-        memory::MemoryPool& pool);
+        memory::MemoryPool& pool,
+        Stats& stats);
   };
 
+  // Returns a recycled ARRAY, MAP or ROW vector of 'type' and 'size' or a
+  // newly allocated one if there is none.
+  VectorPtr getComplex(const TypePtr& type, vector_size_t size);
+
+  // Moves a complex 'vector' into 'complexVectors_' if it is writable and
+  // there is space.
+  bool releaseComplex(VectorPtr& vector);
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -67,6 +95,12 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  // Pre-allocated ARRAY, MAP and ROW vectors of any type. Complex types are
+  // not singletons, so these are matched by type equality on get().
+  std::vector<VectorPtr> complexVectors_;
+
+  Stats stats_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
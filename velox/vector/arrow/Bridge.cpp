@@ -30,19 +30,17 @@ namespace facebook::velox {
 
 namespace {
 
-// The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
+// Most supported conversions use one buffer for nulls (0), one for values
+// (1), and one for offsets (2). String views use a variable number of
+// buffers.
 static constexpr size_t kMaxBuffers{3};
 
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
 // carried by ArrowArray.private_data
 class VeloxToArrowBridgeHolder {
  public:
-  VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
-    }
-  }
+  VeloxToArrowBridgeHolder()
+      : buffers_(kMaxBuffers, nullptr), bufferPtrs_(kMaxBuffers) {}
 
   // Acquires a buffer at index `idx`.
   void setBuffer(size_t idx, const BufferPtr& buffer) {
@@ -58,7 +56,14 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
+  }
+
+  // Allocates space for `numBuffers` buffers. Invalidates the pointer
+  // returned by getArrowBuffers().
+  void resizeBuffers(size_t numBuffers) {
+    buffers_.resize(std::max(numBuffers, kMaxBuffers), nullptr);
+    bufferPtrs_.resize(buffers_.size());
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -89,11 +94,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -249,9 +254,9 @@ const char* exportArrowFormatStr(
     // We always map VARCHAR and VARBINARY to the "small" version (lower case
     // format string), which uses 32 bit offsets.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
     case TypeKind::UNKNOWN:
       return "n"; // NullType
     case TypeKind::TIMESTAMP:
@@ -270,7 +275,7 @@ const char* exportArrowFormatStr(
     // Complex/nested types.
     case TypeKind::ARRAY:
       static_assert(sizeof(vector_size_t) == 4);
-      return "+l"; // list
+      return options.exportToListView ? "+vl" : "+l"; // list
     case TypeKind::MAP:
       return "+m"; // map
     case TypeKind::ROW:
@@ -548,6 +553,83 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Imports Arrow Utf8View or BinaryView. Inlined views have the same layout as
+// StringView, so the views buffer is used as is if all the views are inlined.
+// Otherwise the pointers of the non-inlined views are computed from their
+// data buffer index and offset. The data buffers are never copied.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  static_assert(sizeof(StringView) == 16);
+  const auto length = arrowArray.length;
+  const auto* views = static_cast<const char*>(arrowArray.buffers[1]);
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* dataBuffers = arrowArray.buffers + 2;
+  const auto* dataSizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+
+  auto viewSize = [&](int64_t i) {
+    int32_t size;
+    memcpy(&size, views + i * sizeof(StringView), sizeof(int32_t));
+    return size;
+  };
+  bool allInline = true;
+  for (int64_t i = 0; i < length; ++i) {
+    if (!(rawNulls && bits::isBitNull(rawNulls, i)) &&
+        viewSize(i) > StringView::kInlineSize) {
+      allInline = false;
+      break;
+    }
+  }
+
+  BufferPtr stringViews;
+  std::vector<BufferPtr> stringViewBuffers;
+  if (allInline) {
+    stringViews = wrapInBufferView(views, length * sizeof(StringView));
+  } else {
+    stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+    auto* rawStringViews = stringViews->asMutable<StringView>();
+    for (int64_t i = 0; i < length; ++i) {
+      const auto* view = views + i * sizeof(StringView);
+      const auto size = viewSize(i);
+      if (rawNulls && bits::isBitNull(rawNulls, i)) {
+        rawStringViews[i] = StringView();
+      } else if (size <= StringView::kInlineSize) {
+        memcpy(&rawStringViews[i], view, sizeof(StringView));
+      } else {
+        int32_t bufferIndex;
+        int32_t offset;
+        memcpy(&bufferIndex, view + 8, sizeof(int32_t));
+        memcpy(&offset, view + 12, sizeof(int32_t));
+        VELOX_USER_CHECK_LT(bufferIndex, numDataBuffers);
+        VELOX_USER_CHECK_LE(offset + size, dataSizes[bufferIndex]);
+        rawStringViews[i] = StringView(
+            static_cast<const char*>(dataBuffers[bufferIndex]) + offset, size);
+      }
+    }
+    stringViewBuffers.reserve(numDataBuffers);
+    for (int64_t i = 0; i < numDataBuffers; ++i) {
+      stringViewBuffers.emplace_back(
+          wrapInBufferView(dataBuffers[i], dataSizes[i]));
+    }
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringViewBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 // This functions does two things: (a) sets the value of null_count, and (b)
 // the validity buffer (if there is at least one null row).
 void exportValidityBitmap(
@@ -664,6 +746,89 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Exports strings as Arrow Utf8View or BinaryView. The views have the same
+// layout as StringView except that the pointer of a non-inlined string is
+// replaced by the index of its data buffer and its offset in that buffer. The
+// string buffers of 'vec' are exported as the data buffers, so no string is
+// copied unless it is outside of the string buffers.
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto& stringBuffers = vec.stringBuffers();
+
+  // The start address and index of the string buffers, by address.
+  std::vector<std::pair<const char*, int32_t>> bufferStarts;
+  bufferStarts.reserve(stringBuffers.size());
+  for (int32_t i = 0; i < stringBuffers.size(); ++i) {
+    bufferStarts.emplace_back(stringBuffers[i]->as<char>(), i);
+  }
+  std::sort(bufferStarts.begin(), bufferStarts.end());
+
+  // Strings that are not in any string buffer are copied here.
+  std::string extraStrings;
+  const int32_t extraIndex = stringBuffers.size();
+
+  auto views = AlignedBuffer::allocate<StringView>(out.length, pool);
+  auto* rawViews = views->asMutable<char>();
+  vector_size_t j = 0;
+  rows.apply([&](vector_size_t i) {
+    auto* view = rawViews + j++ * sizeof(StringView);
+    if (vec.isNullAt(i)) {
+      memset(view, 0, sizeof(StringView));
+      return;
+    }
+    const auto value = vec.valueAtFast(i);
+    memcpy(view, &value, sizeof(StringView));
+    if (value.isInline()) {
+      return;
+    }
+    int32_t bufferIndex = extraIndex;
+    int32_t offset;
+    auto it = std::upper_bound(
+        bufferStarts.begin(),
+        bufferStarts.end(),
+        std::make_pair(value.data(), std::numeric_limits<int32_t>::max()));
+    if (it != bufferStarts.begin()) {
+      --it;
+      const auto& buffer = *stringBuffers[it->second];
+      if (value.data() + value.size() <= it->first + buffer.size()) {
+        bufferIndex = it->second;
+        offset = value.data() - it->first;
+      }
+    }
+    if (bufferIndex == extraIndex) {
+      offset = extraStrings.size();
+      extraStrings.append(value.data(), value.size());
+    }
+    memcpy(view + 8, &bufferIndex, sizeof(int32_t));
+    memcpy(view + 12, &offset, sizeof(int32_t));
+  });
+
+  const auto numDataBuffers = stringBuffers.size() + !extraStrings.empty();
+  // Nulls, views, the data buffers and the sizes of the data buffers.
+  out.n_buffers = 3 + numDataBuffers;
+  holder.resizeBuffers(out.n_buffers);
+  out.buffers = holder.getArrowBuffers();
+  holder.setBuffer(1, views);
+  auto sizes = AlignedBuffer::allocate<int64_t>(numDataBuffers, pool);
+  auto* rawSizes = sizes->asMutable<int64_t>();
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    holder.setBuffer(2 + i, stringBuffers[i]);
+    rawSizes[i] = stringBuffers[i]->size();
+  }
+  if (!extraStrings.empty()) {
+    auto extra = AlignedBuffer::allocate<char>(extraStrings.size(), pool);
+    memcpy(
+        extra->asMutable<char>(), extraStrings.data(), extraStrings.size());
+    holder.setBuffer(2 + extraIndex, extra);
+    rawSizes[extraIndex] = extraStrings.size();
+  }
+  holder.setBuffer(2 + numDataBuffers, sizes);
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
@@ -688,8 +853,21 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      if (options.exportToStringView) {
+        exportStringViews(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      } else {
+        exportStrings(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      }
       break;
     default:
       VELOX_NYI(
@@ -799,6 +977,49 @@ void exportArrays(
   out.children = holder.getChildrenArrays();
 }
 
+// Exports arrays as Arrow ListView, which has offsets and sizes like
+// ArrayVector. The offsets, sizes and elements are exported without copying
+// if all the rows are exported and there are no nulls. Otherwise the offsets
+// and sizes of the exported rows are gathered, with empty null arrays, and
+// all the elements are still exported.
+void exportArrayViews(
+    const ArrayVector& vec,
+    const Selection& rows,
+    const ArrowOptions& options,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  out.n_buffers = 3;
+  if (!rows.changed() && !vec.mayHaveNulls()) {
+    holder.setBuffer(1, vec.offsets());
+    holder.setBuffer(2, vec.sizes());
+  } else {
+    auto offsets = AlignedBuffer::allocate<vector_size_t>(out.length, pool);
+    auto sizes = AlignedBuffer::allocate<vector_size_t>(out.length, pool);
+    auto* rawOffsets = offsets->asMutable<vector_size_t>();
+    auto* rawSizes = sizes->asMutable<vector_size_t>();
+    vector_size_t j = 0;
+    rows.apply([&](vector_size_t i) {
+      const bool isNull = vec.isNullAt(i);
+      rawOffsets[j] = isNull ? 0 : vec.offsetAt(i);
+      rawSizes[j] = isNull ? 0 : vec.sizeAt(i);
+      ++j;
+    });
+    holder.setBuffer(1, offsets);
+    holder.setBuffer(2, sizes);
+  }
+  holder.resizeChildren(1);
+  const auto& elements = *vec.elements()->loadedVector();
+  exportToArrowImpl(
+      elements,
+      Selection(elements.size()),
+      options,
+      *holder.allocateChild(0),
+      pool);
+  out.n_children = 1;
+  out.children = holder.getChildrenArrays();
+}
+
 void exportMaps(
     const MapVector& vec,
     const Selection& rows,
@@ -924,6 +1145,28 @@ void exportConstantValue(
   exportToArrowImpl(*valuesVector, selection, options, out, pool);
 }
 
+// Exports the first 'numRuns' int32 run ends in 'runsBuffer' as the
+// `run_ends` child of an Arrow REE.
+void exportRunEnds(
+    BufferPtr runsBuffer,
+    vector_size_t numRuns,
+    ArrowArray& out) {
+  auto holder = std::make_unique<VeloxToArrowBridgeHolder>();
+
+  out.buffers = holder->getArrowBuffers();
+  out.length = numRuns;
+  out.offset = 0;
+  out.null_count = 0;
+  out.n_buffers = 2;
+  out.n_children = 0;
+  out.children = nullptr;
+  out.dictionary = nullptr;
+  holder->setBuffer(1, runsBuffer);
+
+  out.private_data = holder.release();
+  out.release = releaseArrowArray;
+}
+
 // Velox constant vectors are exported as Arrow REE containing a single run
 // equals to the vector size.
 void exportConstant(
@@ -943,26 +1186,63 @@ void exportConstant(
   out.children = holder.getChildrenArrays();
   exportConstantValue(vec, options, *holder.allocateChild(1), pool);
 
-  // Create the run ends child.
-  auto* runEnds = holder.allocateChild(0);
-  auto runEndsHolder = std::make_unique<VeloxToArrowBridgeHolder>();
-
-  runEnds->buffers = runEndsHolder->getArrowBuffers();
-  runEnds->length = 1;
-  runEnds->offset = 0;
-  runEnds->null_count = 0;
-  runEnds->n_buffers = 2;
-  runEnds->n_children = 0;
-  runEnds->children = nullptr;
-  runEnds->dictionary = nullptr;
-
   // Allocate single runs buffer with the run set as size.
   auto runsBuffer = AlignedBuffer::allocate<int32_t>(1, pool);
   runsBuffer->asMutable<int32_t>()[0] = vec.size();
-  runEndsHolder->setBuffer(1, runsBuffer);
+  exportRunEnds(std::move(runsBuffer), 1, *holder.allocateChild(0));
+}
+
+// Velox sequence vectors are exported as Arrow REE with one run for each run
+// of consecutive selected rows that are in the same sequence.
+void exportSequence(
+    const BaseVector& vec,
+    const Selection& rows,
+    const ArrowOptions& options,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  out.n_buffers = 0;
+  out.buffers = nullptr;
+
+  out.n_children = 2;
+  holder.resizeChildren(2);
+  out.children = holder.getChildrenArrays();
 
-  runEnds->private_data = runEndsHolder.release();
-  runEnds->release = releaseArrowArray;
+  const auto& values = *vec.valueVector()->loadedVector();
+  const auto numRuns = values.size();
+  const auto* lengths = vec.wrapInfo()->as<vector_size_t>();
+  std::vector<vector_size_t> ends(numRuns);
+  vector_size_t end = 0;
+  for (auto i = 0; i < numRuns; ++i) {
+    end += lengths[i];
+    ends[i] = end;
+  }
+
+  auto runsBuffer = AlignedBuffer::allocate<int32_t>(out.length, pool);
+  auto* rawRuns = runsBuffer->asMutable<int32_t>();
+  Selection valueRows(numRuns);
+  valueRows.clearAll();
+  vector_size_t numExportedRuns = 0;
+  vector_size_t numRows = 0;
+  vector_size_t lastRun = -1;
+  rows.apply([&](vector_size_t row) {
+    const vector_size_t run =
+        std::upper_bound(ends.begin(), ends.end(), row) - ends.begin();
+    if (run != lastRun) {
+      valueRows.addRange(run, 1);
+      lastRun = run;
+      ++numExportedRuns;
+    }
+    rawRuns[numExportedRuns - 1] = ++numRows;
+  });
+
+  if (!rows.changed() && numExportedRuns == numRuns) {
+    // All the runs are exported as is.
+    valueRows = Selection(numRuns);
+  }
+  exportToArrowImpl(values, valueRows, options, *holder.allocateChild(1), pool);
+  exportRunEnds(
+      std::move(runsBuffer), numExportedRuns, *holder.allocateChild(0));
 }
 
 void exportToArrowImpl(
@@ -987,8 +1267,21 @@ void exportToArrowImpl(
           *vec.asUnchecked<RowVector>(), rows, options, out, pool, *holder);
       break;
     case VectorEncoding::Simple::ARRAY:
-      exportArrays(
-          *vec.asUnchecked<ArrayVector>(), rows, options, out, pool, *holder);
+      options.exportToListView
+          ? exportArrayViews(
+                *vec.asUnchecked<ArrayVector>(),
+                rows,
+                options,
+                out,
+                pool,
+                *holder)
+          : exportArrays(
+                *vec.asUnchecked<ArrayVector>(),
+                rows,
+                options,
+                out,
+                pool,
+                *holder);
       break;
     case VectorEncoding::Simple::MAP:
       exportMaps(
@@ -1004,6 +1297,9 @@ void exportToArrowImpl(
           ? exportFlattenedVector(vec, rows, options, out, pool, *holder)
           : exportConstant(vec, rows, options, out, pool, *holder);
       break;
+    case VectorEncoding::Simple::SEQUENCE:
+      exportSequence(vec, rows, options, out, pool, *holder);
+      break;
     default:
       VELOX_NYI("{} cannot be exported to Arrow yet.", vec.encoding());
   }
@@ -1082,6 +1378,16 @@ TypePtr importFromArrowImpl(
     case 'Z':
       return VARBINARY();
 
+    // Utf8View and BinaryView.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       if (format[1] == 's') {
         return TIMESTAMP();
@@ -1107,6 +1413,15 @@ TypePtr importFromArrowImpl(
           VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
           return ARRAY(importFromArrow(*arrowSchema.children[0]));
 
+        // ListView, only with 32 bit offsets and sizes.
+        case 'v':
+          if (format[2] == 'l') {
+            VELOX_CHECK_EQ(arrowSchema.n_children, 1);
+            VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
+            return ARRAY(importFromArrow(*arrowSchema.children[0]));
+          }
+          break;
+
         // Map.
         case 'm': {
           VELOX_CHECK_EQ(arrowSchema.n_children, 1);
@@ -1202,8 +1517,9 @@ void exportToArrow(
       exportToArrow(vec->valueVector(), *arrowSchema.dictionary, options);
     }
   } else if (
-      vec->encoding() == VectorEncoding::Simple::CONSTANT &&
-      !options.flattenConstant) {
+      (vec->encoding() == VectorEncoding::Simple::CONSTANT &&
+       !options.flattenConstant) ||
+      vec->encoding() == VectorEncoding::Simple::SEQUENCE) {
     // Arrow REE spec available in
     //  https://arrow.apache.org/docs/format/Columnar.html#run-end-encoded-layout
     arrowSchema.format = "+r";
@@ -1418,6 +1734,36 @@ ArrayVectorPtr createArrayVector(
       optionalNullCount(arrowArray.null_count));
 }
 
+// Imports Arrow ListView. The offsets and sizes have the same layout as the
+// ones of ArrayVector and are used without copying.
+ArrayVectorPtr createArrayVectorFromListView(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer,
+    WrapInBufferViewFunc wrapInBufferView) {
+  static_assert(sizeof(vector_size_t) == sizeof(int32_t));
+  VELOX_CHECK_EQ(arrowArray.n_buffers, 3);
+  VELOX_CHECK_EQ(arrowArray.n_children, 1);
+  auto offsets = wrapInBufferView(
+      arrowArray.buffers[1], arrowArray.length * sizeof(vector_size_t));
+  auto sizes = wrapInBufferView(
+      arrowArray.buffers[2], arrowArray.length * sizeof(vector_size_t));
+  auto elements = importFromArrowImpl(
+      *arrowSchema.children[0], *arrowArray.children[0], pool, isViewer);
+  return std::make_shared<ArrayVector>(
+      pool,
+      type,
+      std::move(nulls),
+      arrowArray.length,
+      std::move(offsets),
+      std::move(sizes),
+      std::move(elements),
+      optionalNullCount(arrowArray.null_count));
+}
+
 MapVectorPtr createMapVector(
     memory::MemoryPool* pool,
     const TypePtr& type,
@@ -1498,7 +1844,7 @@ VectorPtr createVectorFromReeArray(
       TypeKind::INTEGER,
       "Only int32 run lengths are supported for REE arrow conversion.");
 
-  // If there is more than one run, we turn it into a dictionary.
+  // If there is more than one run, we turn it into a sequence vector.
   if (values->size() > 1) {
     const auto& runsArray = *arrowArray.children[0];
     VELOX_CHECK_EQ(runsArray.n_buffers, 2);
@@ -1508,18 +1854,22 @@ VectorPtr createVectorFromReeArray(
 
     const auto* runsBuffer = static_cast<const int32_t*>(runsArray.buffers[1]);
     VELOX_CHECK_NOT_NULL(runsBuffer);
+    VELOX_CHECK_EQ(runsArray.length, values->size());
 
-    auto indices = allocateIndices(arrowArray.length, pool);
-    auto rawIndices = indices->asMutable<vector_size_t>();
-
-    size_t cursor = 0;
+    auto lengths =
+        AlignedBuffer::allocate<SequenceLength>(runsArray.length, pool);
+    auto* rawLengths = lengths->asMutable<SequenceLength>();
+    int32_t previousEnd = 0;
     for (size_t i = 0; i < runsArray.length; ++i) {
-      while (cursor < runsBuffer[i]) {
-        rawIndices[cursor++] = i;
-      }
+      VELOX_CHECK_GT(runsBuffer[i], previousEnd, "REE run ends must increase");
+      rawLengths[i] = runsBuffer[i] - previousEnd;
+      previousEnd = runsBuffer[i];
     }
-    return BaseVector::wrapInDictionary(
-        nullptr, indices, arrowArray.length, values);
+    // The last run may end after the end of the array.
+    VELOX_CHECK_GE(previousEnd, arrowArray.length);
+    rawLengths[runsArray.length - 1] -= previousEnd - arrowArray.length;
+    return BaseVector::wrapInSequence(
+        std::move(lengths), arrowArray.length, std::move(values));
   }
   // Otherwise (single or zero runs), turn it into a constant.
   else if (values->size() == 1) {
@@ -1660,6 +2010,14 @@ bool isREE(const ArrowSchema& arrowSchema) {
   return arrowSchema.format[0] == '+' && arrowSchema.format[1] == 'r';
 }
 
+bool isStringView(const ArrowSchema& arrowSchema) {
+  return arrowSchema.format[0] == 'v';
+}
+
+bool isListView(const ArrowSchema& arrowSchema) {
+  return arrowSchema.format[0] == '+' && arrowSchema.format[1] == 'v';
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1712,7 +2070,15 @@ VectorPtr importFromArrowImpl(
   }
 
   // String data types (VARCHAR and VARBINARY).
-  if (type->isVarchar() || type->isVarbinary()) {
+  if ((type->isVarchar() || type->isVarbinary()) &&
+      isStringView(arrowSchema)) {
+    VELOX_USER_CHECK_GE(
+        arrowArray.n_buffers,
+        3,
+        "Expecting at least three buffers as input for string view types.");
+    return createStringViewFlatVector(
+        pool, type, nulls, arrowArray, wrapInBufferView);
+  } else if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
         3,
@@ -1752,6 +2118,9 @@ VectorPtr importFromArrowImpl(
         arrowSchema,
         arrowArray,
         isViewer);
+  } else if (type->isArray() && isListView(arrowSchema)) {
+    return createArrayVectorFromListView(
+        pool, type, nulls, arrowSchema, arrowArray, isViewer, wrapInBufferView);
   } else if (type->isArray()) {
     return createArrayVector(
         pool, type, nulls, arrowSchema, arrowArray, isViewer, wrapInBufferView);
@@ -36,6 +36,13 @@ struct ArrowOptions {
   bool flattenDictionary{false};
   bool flattenConstant{false};
   TimestampUnit timestampUnit = TimestampUnit::kNano;
+  /// Export VARCHAR and VARBINARY as the Arrow Utf8View and BinaryView
+  /// layouts, whose views have the same layout as StringView. The string
+  /// buffers are exported without copying the strings.
+  bool exportToStringView{false};
+  /// Export ARRAY as the Arrow ListView layout, which has offsets and sizes
+  /// like ArrayVector, instead of the List layout.
+  bool exportToListView{false};
 };
 
 namespace facebook::velox {
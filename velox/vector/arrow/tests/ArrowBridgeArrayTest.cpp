@@ -1023,6 +1023,100 @@ TEST_F(ArrowBridgeArrayExportTest, constantCrossValidate) {
   EXPECT_EQ(runEndsArray.Value(0), 100);
 }
 
+TEST_F(ArrowBridgeArrayExportTest, sequenceCrossValidate) {
+  auto vector = BaseVector::wrapInSequence(
+      makeBuffer<SequenceLength>({3, 1, 2, 4}),
+      10,
+      vectorMaker_.flatVectorNullable<int64_t>({1, 2, std::nullopt, 3}));
+  auto array = toArrow(vector, options_, pool_.get());
+
+  ASSERT_OK(array->ValidateFull());
+  ASSERT_EQ(
+      *array->type(), *arrow::run_end_encoded(arrow::int32(), arrow::int64()));
+  const auto& reeArray = static_cast<const arrow::RunEndEncodedArray&>(*array);
+  const auto& runEndsArray =
+      static_cast<const arrow::Int32Array&>(*reeArray.run_ends());
+  const auto& valuesArray =
+      static_cast<const arrow::Int64Array&>(*reeArray.values());
+
+  ASSERT_EQ(runEndsArray.length(), 4);
+  ASSERT_EQ(valuesArray.length(), 4);
+  const std::vector<int32_t> expectedRunEnds = {3, 4, 6, 10};
+  for (auto i = 0; i < 4; ++i) {
+    EXPECT_EQ(runEndsArray.Value(i), expectedRunEnds[i]);
+  }
+  EXPECT_EQ(valuesArray.Value(0), 1);
+  EXPECT_EQ(valuesArray.Value(1), 2);
+  EXPECT_TRUE(valuesArray.IsNull(2));
+  EXPECT_EQ(valuesArray.Value(3), 3);
+}
+
+TEST_F(ArrowBridgeArrayExportTest, stringViewCrossValidate) {
+  options_.exportToStringView = true;
+  const std::vector<std::optional<std::string>> data = {
+      "short",
+      std::nullopt,
+      "a string that is too long to be inlined",
+      "",
+      "another string that is not inlined",
+  };
+  auto vector = vectorMaker_.flatVectorNullable(data);
+  auto array = toArrow(vector, options_, pool_.get());
+
+  ASSERT_OK(array->ValidateFull());
+  ASSERT_EQ(*array->type(), *arrow::utf8_view());
+  const auto& views = static_cast<const arrow::StringViewArray&>(*array);
+  ASSERT_EQ(views.length(), data.size());
+  for (auto i = 0; i < data.size(); ++i) {
+    if (data[i].has_value()) {
+      EXPECT_EQ(views.GetView(i), data[i].value()) << "at " << i;
+    } else {
+      EXPECT_TRUE(views.IsNull(i)) << "at " << i;
+    }
+  }
+
+  // The non-inlined strings are not copied.
+  EXPECT_EQ(
+      views.GetView(2).data(),
+      vector->asFlatVector<StringView>()->valueAt(2).data());
+
+  // Flattening the dictionary makes StringViews that are not in the string
+  // buffers of the flat vector. These strings are copied.
+  auto sliced = toArrow(
+      BaseVector::wrapInDictionary(
+          nullptr, makeBuffer<vector_size_t>({4, 2}), 2, vector),
+      ArrowOptions{.flattenDictionary = true, .exportToStringView = true},
+      pool_.get());
+  ASSERT_OK(sliced->ValidateFull());
+  const auto& slicedViews = static_cast<const arrow::StringViewArray&>(*sliced);
+  EXPECT_EQ(slicedViews.GetView(0), data[4].value());
+  EXPECT_EQ(slicedViews.GetView(1), data[2].value());
+}
+
+TEST_F(ArrowBridgeArrayExportTest, listViewCrossValidate) {
+  options_.exportToListView = true;
+  auto vector = vectorMaker_.arrayVectorNullable<int64_t>(
+      {{{1, 2, 3}},
+       std::nullopt,
+       {{4, 5}},
+       std::vector<std::optional<int64_t>>{}});
+  auto array = toArrow(vector, options_, pool_.get());
+
+  ASSERT_OK(array->ValidateFull());
+  ASSERT_EQ(*array->type(), *arrow::list_view(arrow::int64()));
+  const auto& listViews = static_cast<const arrow::ListViewArray&>(*array);
+  ASSERT_EQ(listViews.length(), 4);
+  EXPECT_TRUE(listViews.IsNull(1));
+  const std::vector<int32_t> expectedSizes = {3, 0, 2, 0};
+  for (auto i = 0; i < 4; ++i) {
+    EXPECT_EQ(listViews.value_length(i), expectedSizes[i]) << "at " << i;
+  }
+  const auto& values =
+      static_cast<const arrow::Int64Array&>(*listViews.values());
+  EXPECT_EQ(values.Value(listViews.value_offset(0)), 1);
+  EXPECT_EQ(values.Value(listViews.value_offset(2) + 1), 5);
+}
+
 class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
  protected:
   // Used by this base test class to import Arrow data and create Velox Vector.
@@ -1505,6 +1599,51 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
     });
   }
 
+  void testImportStringView() {
+    options_.exportToStringView = true;
+    arrow::StringViewBuilder builder;
+    ASSERT_OK(builder.Append("hello"));
+    ASSERT_OK(builder.AppendNull());
+    ASSERT_OK(builder.Append("larger string which should not be inlined..."));
+    ASSERT_OK(builder.Append(""));
+    ASSERT_OK_AND_ASSIGN(auto array, builder.Finish());
+    testArrowRoundTrip(*array, [](const BaseVector& vec) {
+      ASSERT_EQ(*vec.type(), *VARCHAR());
+      ASSERT_EQ(vec.size(), 4);
+      const auto& strings = *vec.asFlatVector<StringView>();
+      EXPECT_EQ(strings.valueAt(0), StringView("hello"));
+      EXPECT_TRUE(strings.isNullAt(1));
+      EXPECT_EQ(
+          strings.valueAt(2),
+          StringView("larger string which should not be inlined..."));
+      EXPECT_EQ(strings.valueAt(3), StringView(""));
+    });
+  }
+
+  void testImportListView() {
+    options_.exportToListView = true;
+    auto vb = std::make_shared<arrow::Int32Builder>();
+    arrow::ListViewBuilder lb(arrow::default_memory_pool(), vb);
+    ASSERT_OK(lb.Append(true, 1));
+    ASSERT_OK(vb->Append(1));
+    ASSERT_OK(lb.AppendNull());
+    ASSERT_OK(lb.Append(true, 2));
+    ASSERT_OK(vb->Append(2));
+    ASSERT_OK(vb->Append(3));
+    ASSERT_OK(lb.AppendEmptyValue());
+    ASSERT_OK_AND_ASSIGN(auto array, lb.Finish());
+    testArrowRoundTrip(*array, [](const BaseVector& vec) {
+      ASSERT_EQ(*vec.type(), *ARRAY(INTEGER()));
+      ASSERT_EQ(vec.size(), 4);
+      const auto& arrays = *vec.as<ArrayVector>();
+      EXPECT_EQ(arrays.sizeAt(0), 1);
+      EXPECT_TRUE(arrays.isNullAt(1));
+      EXPECT_EQ(arrays.offsetAt(2), 1);
+      EXPECT_EQ(arrays.sizeAt(2), 2);
+      EXPECT_EQ(arrays.sizeAt(3), 0);
+    });
+  }
+
   void testImportMap() {
     auto kb = std::make_shared<arrow::Int32Builder>(); // key builder
     auto ib = std::make_shared<arrow::Int32Builder>(); // item builder
@@ -1643,7 +1782,7 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
     toVeloxVector(*array, vector);
 
     ASSERT_EQ(*vector->type(), *INTEGER());
-    EXPECT_EQ(vector->encoding(), VectorEncoding::Simple::DICTIONARY);
+    EXPECT_EQ(vector->encoding(), VectorEncoding::Simple::SEQUENCE);
     EXPECT_EQ(vector->size(), 62);
 
     DecodedVector decoded(*vector);
@@ -1760,6 +1899,14 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, array) {
   testImportArray();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, stringView) {
+  testImportStringView();
+}
+
+TEST_F(ArrowBridgeArrayImportAsViewerTest, listView) {
+  testImportListView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, map) {
   testImportMap();
 }
@@ -1813,6 +1960,14 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, array) {
   testImportArray();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringView) {
+  testImportStringView();
+}
+
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, listView) {
+  testImportListView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, map) {
   testImportMap();
 }
@@ -360,6 +360,76 @@ BENCHMARK_MULTI(copyStructNonContiguous) {
   return kIter * kSize;
 }
 
+// Copies a dictionary of 'size' rows over a flat vector of 'baseSize' rows.
+// The indices are scattered over the base vector.
+template <typename T>
+size_t copyDictionaryEncoded(
+    vector_size_t size,
+    vector_size_t baseSize,
+    std::function<T(vector_size_t)> valueAt) {
+  folly::BenchmarkSuspender suspender;
+  std::shared_ptr<memory::MemoryPool> pool{
+      memory::memoryManager()->addLeafPool()};
+  test::VectorMaker vectorMaker{pool.get()};
+
+  auto base = vectorMaker.flatVector<T>(baseSize, valueAt);
+  auto indices = makeIndices(size, pool.get(), [baseSize](auto row) {
+    return static_cast<vector_size_t>((row * 7'919LL) % baseSize);
+  });
+  auto dictionary =
+      BaseVector::wrapInDictionary(BufferPtr(nullptr), indices, size, base);
+  SelectivityVector selected(size);
+  suspender.dismiss();
+
+  return runBenchmark(dictionary, selected, base->type(), pool.get());
+}
+
+BENCHMARK_MULTI(copyBigintDictionaryEncoded) {
+  return copyDictionaryEncoded<int64_t>(
+      10'000, 1'000, [](auto row) { return row; });
+}
+
+BENCHMARK_MULTI(copyDoubleDictionaryEncoded) {
+  return copyDictionaryEncoded<double>(
+      10'000, 1'000, [](auto row) { return row * 0.1; });
+}
+
+BENCHMARK_MULTI(copyIntegerDictionaryEncodedLargeBase) {
+  return copyDictionaryEncoded<int32_t>(
+      10'000, 4'000'000, [](auto row) { return row; });
+}
+
+BENCHMARK_MULTI(copyVarcharDictionaryEncoded) {
+  return copyDictionaryEncoded<StringView>(10'000, 1'000, [](auto row) {
+    return StringView(
+        row % 2 ? "a short string" : "a string that is not inlined");
+  });
+}
+
+BENCHMARK_MULTI(copyBigintScattered) {
+  folly::BenchmarkSuspender suspender;
+  std::shared_ptr<memory::MemoryPool> pool{
+      memory::memoryManager()->addLeafPool()};
+  test::VectorMaker vectorMaker{pool.get()};
+
+  constexpr vector_size_t kSize = 10'000;
+  constexpr vector_size_t kSourceSize = 1'000'000;
+  auto source = vectorMaker.flatVector<int64_t>(kSourceSize, folly::identity);
+  std::vector<vector_size_t> toSourceRow(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    toSourceRow[i] = (i * 7'919LL) % kSourceSize;
+  }
+  SelectivityVector selected(kSize);
+  auto target = BaseVector::create(BIGINT(), kSize, pool.get());
+  suspender.dismiss();
+
+  constexpr int kIter = 100;
+  for (int i = 0; i < kIter; ++i) {
+    target->copy(source.get(), selected, toSourceRow.data());
+  }
+  return kIter * kSize;
+}
+
 } // namespace
 } // namespace facebook::velox
 
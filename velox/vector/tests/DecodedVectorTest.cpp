@@ -577,6 +577,48 @@ TEST_F(DecodedVectorTest, dictionary) {
       1000, [](vector_size_t i) { return std::make_shared<int>(i % 5); });
 }
 
+TEST_F(DecodedVectorTest, sequence) {
+  auto lengths = allocateIndices(4, pool());
+  auto* rawLengths = lengths->asMutable<vector_size_t>();
+  rawLengths[0] = 3;
+  rawLengths[1] = 1;
+  rawLengths[2] = 2;
+  rawLengths[3] = 4;
+  auto values = makeNullableFlatVector<int32_t>({10, std::nullopt, 30, 40});
+  auto sequence = BaseVector::wrapInSequence(lengths, 10, values);
+  auto expected = makeNullableFlatVector<int32_t>(
+      {10, 10, 10, std::nullopt, 30, 30, 40, 40, 40, 40});
+
+  auto check = [&](const BaseVector& vector,
+                   const std::function<vector_size_t(vector_size_t)>& row) {
+    SelectivityVector rows(vector.size());
+    DecodedVector decoded(vector, rows);
+    EXPECT_FALSE(decoded.isIdentityMapping());
+    EXPECT_EQ(decoded.base(), values.get());
+    for (auto i = 0; i < vector.size(); ++i) {
+      ASSERT_EQ(decoded.isNullAt(i), expected->isNullAt(row(i))) << i;
+      if (!decoded.isNullAt(i)) {
+        ASSERT_EQ(decoded.valueAt<int32_t>(i), expected->valueAt(row(i)))
+            << i;
+      }
+    }
+  };
+
+  check(*sequence, [](auto row) { return row; });
+
+  // A dictionary over a sequence.
+  auto dictionary = wrapInDictionary(makeIndicesInReverse(10), 10, sequence);
+  check(*dictionary, [](auto row) { return 9 - row; });
+
+  // A slice cuts the first and last runs.
+  auto slice = sequence->slice(2, 6);
+  ASSERT_EQ(slice->encoding(), VectorEncoding::Simple::SEQUENCE);
+  ASSERT_EQ(slice->size(), 6);
+  for (auto i = 0; i < slice->size(); ++i) {
+    ASSERT_TRUE(slice->equalValueAt(expected.get(), i, i + 2)) << i;
+  }
+}
+
 TEST_F(DecodedVectorTest, dictionaryOverLazy) {
   constexpr vector_size_t size = 1000;
   auto lazyVector = vectorMaker_.lazyFlatVector<int32_t>(
@@ -619,4 +619,60 @@ TEST(SelectivityVectorTest, copyNulls) {
   }
 }
 
+TEST(SelectivityVectorTest, sparseAndContiguous) {
+  constexpr vector_size_t kSize = 10'000;
+  auto selected = [](const SelectivityVector& rows) {
+    std::vector<vector_size_t> result;
+    rows.applyToSelected([&](auto row) { result.push_back(row); });
+    return result;
+  };
+
+  // Few rows selected.
+  SelectivityVector rows(kSize, false);
+  std::vector<vector_size_t> expected;
+  for (auto i = 3; i < kSize; i += 997) {
+    rows.setValid(i, true);
+    expected.push_back(i);
+  }
+  rows.updateBounds();
+  ASSERT_EQ(expected, selected(rows));
+  ASSERT_EQ(expected.size(), static_cast<size_t>(rows.countSelected()));
+  ASSERT_FALSE(rows.isAllSelected());
+  std::vector<vector_size_t> tested;
+  rows.testSelected([&](auto row) {
+    tested.push_back(row);
+    return tested.size() < 3;
+  });
+  ASSERT_EQ(
+      std::vector<vector_size_t>(expected.begin(), expected.begin() + 3),
+      tested);
+
+  // Changing the selection makes the listed rows stale.
+  rows.setValid(expected[1], false);
+  rows.setValid(5'000, true);
+  rows.updateBounds();
+  expected.erase(expected.begin() + 1);
+  expected.insert(
+      std::lower_bound(expected.begin(), expected.end(), 5'000), 5'000);
+  ASSERT_EQ(expected, selected(rows));
+  ASSERT_EQ(expected.size(), static_cast<size_t>(rows.countSelected()));
+
+  // A contiguous range of rows.
+  rows.clearAll();
+  rows.setValidRange(1'000, 9'000, true);
+  rows.updateBounds();
+  expected.clear();
+  for (auto i = 1'000; i < 9'000; ++i) {
+    expected.push_back(i);
+  }
+  ASSERT_EQ(expected, selected(rows));
+  ASSERT_EQ(8'000, rows.countSelected());
+  ASSERT_FALSE(rows.isAllSelected());
+
+  rows.setValidRange(0, kSize, true);
+  rows.updateBounds();
+  ASSERT_EQ(static_cast<size_t>(kSize), selected(rows).size());
+  ASSERT_TRUE(rows.isAllSelected());
+}
+
 } // namespace facebook::velox
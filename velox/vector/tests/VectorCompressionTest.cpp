@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/vector/BiasVector.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/VectorCompression.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox {
+namespace {
+
+class VectorCompressionTest : public testing::Test,
+                              public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Compresses 'vector', checks that it is compressed with 'valueType' values
+  // and that it decodes and decompresses to 'vector'.
+  template <typename T>
+  void testCompress(const VectorPtr& vector, TypeKind valueType) {
+    auto compressed = compressIntegers(vector, pool());
+    ASSERT_EQ(compressed->encoding(), VectorEncoding::Simple::BIASED);
+    EXPECT_EQ(compressed->as<BiasVector<T>>()->valueType(), valueType);
+    EXPECT_LT(compressed->retainedSize(), vector->retainedSize());
+    test::assertEqualVectors(vector, compressed);
+
+    SelectivityVector rows(vector->size());
+    DecodedVector decoded(*compressed, rows);
+    for (auto i = 0; i < vector->size(); ++i) {
+      ASSERT_EQ(decoded.isNullAt(i), vector->isNullAt(i)) << "at " << i;
+      if (!vector->isNullAt(i)) {
+        ASSERT_EQ(
+            decoded.valueAt<T>(i),
+            vector->asFlatVector<T>()->valueAt(i))
+            << "at " << i;
+      }
+    }
+
+    auto decompressed = decompress(compressed, pool());
+    ASSERT_TRUE(decompressed->isFlatEncoding());
+    test::assertEqualVectors(vector, decompressed);
+  }
+};
+
+TEST_F(VectorCompressionTest, integers) {
+  testCompress<int64_t>(
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return -1'000'000 + row % 200; }, nullEvery(7)),
+      TypeKind::TINYINT);
+  testCompress<int64_t>(
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return 1LL << 40 | row * 50; }),
+      TypeKind::SMALLINT);
+  testCompress<int64_t>(
+      makeFlatVector<int64_t>(
+          1'000,
+          [](auto row) {
+            return row % 2 ? std::numeric_limits<int64_t>::max()
+                           : std::numeric_limits<int64_t>::max() - (1LL << 31);
+          }),
+      TypeKind::INTEGER);
+  testCompress<int32_t>(
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row * 60 - 100; }),
+      TypeKind::SMALLINT);
+  testCompress<int16_t>(
+      makeFlatVector<int16_t>(1'000, [](auto row) { return row % 256 - 128; }),
+      TypeKind::TINYINT);
+}
+
+TEST_F(VectorCompressionTest, notCompressed) {
+  // Ranges that do not fit a narrower type, all nulls, other types and
+  // encodings are returned as is.
+  std::vector<VectorPtr> vectors = {
+      makeFlatVector<int64_t>(
+          {std::numeric_limits<int64_t>::min(),
+           std::numeric_limits<int64_t>::max()}),
+      makeFlatVector<int32_t>({0, 1 << 20}),
+      makeFlatVector<int16_t>({0, 1'000}),
+      makeNullableFlatVector<int64_t>({std::nullopt, std::nullopt}),
+      makeFlatVector<double>({1, 2}),
+      makeFlatVector<std::string>({"a", "b"}),
+      makeConstant<int64_t>(1, 10),
+      makeFlatVector<int32_t>({1, 2}, DATE()),
+  };
+  for (const auto& vector : vectors) {
+    EXPECT_EQ(compressIntegers(vector, pool()), vector) << vector->toString();
+    EXPECT_EQ(decompress(vector, pool()), vector) << vector->toString();
+  }
+}
+
+TEST_F(VectorCompressionTest, rows) {
+  auto row = makeRowVector(
+      {makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+       makeFlatVector<std::string>(
+           100, [](auto row) { return std::string(row % 20, 'x'); }),
+       makeFlatVector<int32_t>(100, [](auto row) { return row * 1'000; })});
+  auto compressed = std::dynamic_pointer_cast<RowVector>(
+      compressIntegers(row, pool()));
+  ASSERT_NE(compressed, row);
+  EXPECT_EQ(compressed->childAt(0)->encoding(), VectorEncoding::Simple::BIASED);
+  EXPECT_EQ(compressed->childAt(1), row->childAt(1));
+  EXPECT_EQ(compressed->childAt(2)->encoding(), VectorEncoding::Simple::BIASED);
+  test::assertEqualVectors(row, compressed);
+
+  // Decoding a dictionary over a compressed vector decompresses all the
+  // values.
+  auto dictionary = BaseVector::wrapInDictionary(
+      nullptr, makeIndicesInReverse(100), 100, compressed->childAt(0));
+  SelectivityVector rows(100);
+  DecodedVector decodedDictionary(*dictionary, rows);
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(decodedDictionary.valueAt<int64_t>(i), 99 - i);
+  }
+
+  auto decompressed = decompress(compressed, pool());
+  EXPECT_TRUE(decompressed->as<RowVector>()->childAt(0)->isFlatEncoding());
+  EXPECT_EQ(decompressed->as<RowVector>()->childAt(1), row->childAt(1));
+  test::assertEqualVectors(row, decompressed);
+}
+
+TEST_F(VectorCompressionTest, strings) {
+  auto base = makeFlatVector<std::string>(
+      1'000,
+      [](auto row) {
+        return std::string(100, 'a' + row % 26) + "-" + std::to_string(row);
+      },
+      nullEvery(7));
+  // All the strings are live.
+  EXPECT_EQ(compactStrings(base, pool()), base);
+
+  // A few rows of 'base' keep all of its strings alive.
+  auto dictionary = wrapInDictionary(
+      makeIndices(20, [](auto row) { return row * 37; }), 20, base);
+  auto compacted = compactStrings(dictionary, pool());
+  ASSERT_TRUE(compacted->isFlatEncoding());
+  test::assertEqualVectors(dictionary, compacted);
+  const auto& buffers =
+      compacted->asFlatVector<StringView>()->stringBuffers();
+  ASSERT_EQ(buffers.size(), 1);
+  EXPECT_LT(buffers[0]->capacity() * 10, base->retainedSize());
+
+  // Short strings are inlined and need no compacting.
+  auto inlined = makeFlatVector<std::string>(
+      20, [](auto row) { return std::to_string(row); });
+  EXPECT_EQ(compactStrings(inlined, pool()), inlined);
+
+  auto row = makeRowVector(
+      {makeFlatVector<int64_t>(20, [](auto row) { return row; }),
+       dictionary,
+       inlined});
+  auto compactedRow =
+      std::dynamic_pointer_cast<RowVector>(compactStrings(row, pool()));
+  ASSERT_NE(compactedRow, row);
+  EXPECT_EQ(compactedRow->childAt(0), row->childAt(0));
+  EXPECT_TRUE(compactedRow->childAt(1)->isFlatEncoding());
+  EXPECT_EQ(compactedRow->childAt(2), row->childAt(2));
+  test::assertEqualVectors(row, compactedRow);
+}
+
+} // namespace
+} // namespace facebook::velox
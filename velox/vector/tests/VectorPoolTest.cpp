@@ -151,4 +151,78 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_EQ(1'000, vector->size());
   ASSERT_TRUE(isJsonType(vector->type()));
 }
+
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  auto rowType = ROW({"a", "b"}, {BIGINT(), ARRAY(VARCHAR())});
+  auto vector = vectorPool.get(rowType, 1'000);
+  ASSERT_EQ(1'000, vector->size());
+  auto* row = vector->as<RowVector>();
+  ASSERT_EQ(1'000, row->childAt(0)->size());
+  ASSERT_EQ(1'000, row->childAt(1)->size());
+  vector->setNull(10, true);
+  row->childAt(0)->setNull(20, true);
+
+  auto* rawVector = vector.get();
+  ASSERT_TRUE(vectorPool.release(vector));
+  ASSERT_EQ(vector, nullptr);
+
+  // A vector of a different type is not recycled.
+  auto otherVector =
+      vectorPool.get(ROW({"a", "c"}, {BIGINT(), ARRAY(VARCHAR())}), 500);
+  ASSERT_NE(rawVector, otherVector.get());
+  ASSERT_EQ(0, vectorPool.stats().numReused);
+
+  auto recycledVector = vectorPool.get(rowType, 2'000);
+  ASSERT_EQ(rawVector, recycledVector.get());
+  ASSERT_EQ(2'000, recycledVector->size());
+  row = recycledVector->as<RowVector>();
+  ASSERT_EQ(2'000, row->childAt(0)->size());
+  ASSERT_EQ(2'000, row->childAt(1)->size());
+  ASSERT_FALSE(recycledVector->isNullAt(10));
+  ASSERT_FALSE(row->childAt(0)->isNullAt(20));
+  ASSERT_EQ(1, vectorPool.stats().numReused);
+  ASSERT_GT(vectorPool.stats().reusedBytes, 0);
+
+  // A vector with a shared child is not recyclable.
+  auto child = row->childAt(0);
+  ASSERT_FALSE(vectorPool.release(recycledVector));
+  child.reset();
+  ASSERT_TRUE(vectorPool.release(recycledVector));
+
+  // A vector from another pool is not recyclable.
+  auto otherPool = rootPool_->addLeafChild("other");
+  VectorPtr otherPoolVector = BaseVector::create(rowType, 100, otherPool.get());
+  ASSERT_FALSE(vectorPool.release(otherPoolVector));
+
+  auto mapVector = vectorPool.get(MAP(INTEGER(), VARCHAR()), 100);
+  ASSERT_EQ(100, mapVector->size());
+  rawVector = mapVector.get();
+  ASSERT_TRUE(vectorPool.release(mapVector));
+  ASSERT_EQ(rawVector, vectorPool.get(MAP(INTEGER(), VARCHAR()), 10).get());
+  ASSERT_EQ(2, vectorPool.stats().numReused);
+}
+
+TEST_F(VectorPoolTest, stringBuffers) {
+  VectorPool vectorPool(pool());
+
+  auto vector = vectorPool.get(VARCHAR(), 100);
+  auto* flat = vector->asFlatVector<StringView>();
+  for (auto i = 0; i < 100; ++i) {
+    flat->set(i, StringView(std::string(50, 'a' + i % 26)));
+  }
+  ASSERT_EQ(1, flat->stringBuffers().size());
+  auto* stringBuffer = flat->stringBuffers()[0].get();
+
+  ASSERT_TRUE(vectorPool.release(vector));
+  vector = vectorPool.get(VARCHAR(), 100);
+  flat = vector->asFlatVector<StringView>();
+  ASSERT_EQ(1, flat->stringBuffers().size());
+  ASSERT_EQ(stringBuffer, flat->stringBuffers()[0].get());
+  ASSERT_EQ(0, stringBuffer->size());
+  for (auto i = 0; i < 100; ++i) {
+    ASSERT_EQ(0, flat->valueAt(i).size());
+  }
+}
 } // namespace facebook::velox::test
@@ -1788,6 +1788,53 @@ TEST_F(VectorTest, copyNoRows) {
   }
 }
 
+TEST_F(VectorTest, copyGather) {
+  constexpr vector_size_t kSize = 1'000;
+  auto testGather = [&](const VectorPtr& base) {
+    SCOPED_TRACE(base->toString());
+    auto indices = makeIndices(
+        kSize, [&](auto row) { return (row * 7) % base->size(); });
+    auto dictionary = wrapInDictionary(indices, kSize, base);
+    SelectivityVector allRows(kSize);
+
+    auto target = BaseVector::create(base->type(), kSize, pool());
+    target->copy(dictionary.get(), allRows, nullptr);
+    test::assertEqualVectors(dictionary, target);
+
+    std::vector<vector_size_t> toSourceRow(kSize);
+    for (auto i = 0; i < kSize; ++i) {
+      toSourceRow[i] = (i * 7) % base->size();
+    }
+    target = BaseVector::create(base->type(), kSize, pool());
+    target->copy(base.get(), allRows, toSourceRow.data());
+    test::assertEqualVectors(dictionary, target);
+
+    target = BaseVector::create(base->type(), kSize, pool());
+    std::vector<BaseVector::CopyRange> ranges = {
+        {0, 0, 3}, {10, 5, 100}, {200, 105, kSize - 200}};
+    target->copyRanges(
+        dictionary.get(), folly::Range(ranges.data(), ranges.size()));
+    for (const auto& range : ranges) {
+      for (auto i = 0; i < range.count; ++i) {
+        ASSERT_TRUE(target->equalValueAt(
+            dictionary.get(), range.targetIndex + i, range.sourceIndex + i));
+      }
+    }
+  };
+
+  testGather(makeFlatVector<int64_t>(301, [](auto row) { return row * 3; }));
+  testGather(makeFlatVector<int32_t>(
+      301, [](auto row) { return row; }, nullEvery(5)));
+  testGather(makeFlatVector<double>(301, [](auto row) { return row * 0.5; }));
+  testGather(makeFlatVector<int16_t>(301, [](auto row) { return row; }));
+  testGather(makeFlatVector<StringView>(
+      301,
+      [](auto row) {
+        return StringView(row % 2 ? "short" : "a string that is not inlined");
+      },
+      nullEvery(7)));
+}
+
 TEST_F(VectorTest, copyAscii) {
   std::vector<std::string> stringData = {"a", "b", "c"};
   auto source = makeFlatVector(stringData);